@@ -18,6 +18,7 @@
 #include <chrono>  // NOLINT
 #include <cstddef>
 #include <cstdint>
+#include <ratio>  // NOLINT
 #include <string>
 
 #include "absl/strings/str_format.h"  // from @com_google_absl
@@ -82,6 +83,8 @@ enum class RunStatus {
   kError,
   // The runs failed due to timeout.
   kTimeout,
+  // The runs completed successfully, but slower than the baseline.
+  kPerfRegression,
 };
 
 enum class CompilationStatus {
@@ -102,6 +105,14 @@ using Clock = std::chrono::steady_clock;
 using TimePoint = Clock::time_point;
 using Microseconds = uint64_t;
 
+// Time elapsed since `start`.
+inline Microseconds MicrosecondsSince(const TimePoint& start) {
+  return std::chrono::duration_cast<
+             std::chrono::duration<Microseconds, std::micro>>(Clock::now() -
+                                                              start)
+      .count();
+}
+
 // Which backend to use as the "actual".
 enum class ExecutionBackend { kCpu, kGpu, kNpu };
 
@@ -152,6 +163,9 @@ void AbslStringify(Sink& sink, const RunStatus& status) {
     case RunStatus::kTimeout:
       sink.Append("timeout");
       break;
+    case RunStatus::kPerfRegression:
+      sink.Append("perf_regression");
+      break;
   }
 }
 
@@ -30,6 +30,7 @@
 #include "absl/strings/str_split.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/ats/common.h"
+#include "litert/ats/perf_baseline.h"
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
 #include "litert/cc/litert_common.h"
@@ -114,6 +115,24 @@ ABSL_FLAG(std::string, soc_model, "",
           "The SOC model to target for compilation. Only relevant for "
           "NPU compilation.");
 
+ABSL_FLAG(std::string, perf_baseline, "",
+          "CSV report of a previous run, written with --csv, to compare the "
+          "compile time, latencies and peak memory of each test against. "
+          "Tests that regress over the tolerances fail.");
+
+ABSL_FLAG(double, perf_latency_tolerance, 0.1,
+          "Allowed relative regression of the first run and steady state "
+          "latencies.");
+
+ABSL_FLAG(double, perf_compile_time_tolerance, 0.25,
+          "Allowed relative regression of the compile time.");
+
+ABSL_FLAG(double, perf_memory_tolerance, 0.1,
+          "Allowed relative regression of the peak memory.");
+
+ABSL_FLAG(int64_t, perf_min_regression_us, 100,
+          "Time regressions at or below this many microseconds are ignored.");
+
 namespace litert::testing {
 
 namespace {
@@ -218,6 +237,16 @@ Expected<AtsConf> AtsConf::ParseFlagsAndDoSetup() {
   auto limit = absl::GetFlag(FLAGS_limit);
   auto soc_manufacturer = absl::GetFlag(FLAGS_soc_manufacturer);
   auto soc_model = absl::GetFlag(FLAGS_soc_model);
+  std::optional<PerfBaseline> baseline;
+  if (const auto path = absl::GetFlag(FLAGS_perf_baseline); !path.empty()) {
+    LITERT_ASSIGN_OR_RETURN(baseline, PerfBaseline::Load(path));
+  }
+  PerfTolerances tolerances;
+  tolerances.latency = absl::GetFlag(FLAGS_perf_latency_tolerance);
+  tolerances.compile_time = absl::GetFlag(FLAGS_perf_compile_time_tolerance);
+  tolerances.memory = absl::GetFlag(FLAGS_perf_memory_tolerance);
+  tolerances.min_regression_us =
+      std::max<int64_t>(absl::GetFlag(FLAGS_perf_min_regression_us), 0);
   LITERT_ASSIGN_OR_RETURN(auto target_options, ParseOptions(backend));
   LITERT_ASSIGN_OR_RETURN(auto reference_options, Options::Create());
   reference_options.SetHardwareAccelerators(HwAccelerators::kCpu);
@@ -230,7 +259,8 @@ Expected<AtsConf> AtsConf::ParseFlagsAndDoSetup() {
               fail_on_timeout, dump_report, std::move(csv), compile_mode,
               std::move(models_out), limit, std::move(plugin),
               std::move(soc_manufacturer), std::move(soc_model),
-              std::move(target_options), std::move(reference_options));
+              std::move(baseline), tolerances, std::move(target_options),
+              std::move(reference_options));
   Setup(res);
   return res;
 }
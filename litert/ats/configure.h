@@ -26,6 +26,7 @@
 #include "absl/flags/declare.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/ats/common.h"
+#include "litert/ats/perf_baseline.h"
 #include "litert/cc/internal/litert_rng.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_options.h"
@@ -97,6 +98,21 @@ ABSL_DECLARE_FLAG(std::string, soc_manufacturer);
 // compilation.
 ABSL_DECLARE_FLAG(std::string, soc_model);
 
+// CSV report of a previous run to compare the performance against.
+ABSL_DECLARE_FLAG(std::string, perf_baseline);
+
+// Allowed relative regression of the first run and steady state latencies.
+ABSL_DECLARE_FLAG(double, perf_latency_tolerance);
+
+// Allowed relative regression of the compile time.
+ABSL_DECLARE_FLAG(double, perf_compile_time_tolerance);
+
+// Allowed relative regression of the peak memory.
+ABSL_DECLARE_FLAG(double, perf_memory_tolerance);
+
+// Time regressions at or below this many microseconds are ignored.
+ABSL_DECLARE_FLAG(int64_t, perf_min_regression_us);
+
 namespace litert::testing {
 
 class AtsConf {
@@ -232,6 +248,12 @@ class AtsConf {
   // compilation.
   const std::string& SocModel() const { return soc_model_; }
 
+  // Performance of a previous run to compare against, if provided.
+  const std::optional<PerfBaseline>& Baseline() const { return baseline_; }
+
+  // Allowed performance regressions relative to the baseline.
+  const PerfTolerances& Tolerances() const { return tolerances_; }
+
   // Litert options to use for the target backend.
   const Options& TargetOptions() const { return target_options_; }
 
@@ -255,7 +277,9 @@ class AtsConf {
                    bool compile_mode, std::string models_out, int32_t limit,
                    std::optional<internal::CompilerPlugin> plugin,
                    std::string soc_manufacturer, std::string soc_model,
-                   Options&& target_options, Options&& reference_options)
+                   std::optional<PerfBaseline> baseline,
+                   PerfTolerances tolerances, Options&& target_options,
+                   Options&& reference_options)
       : seeds_for_params_(std::move(seeds_for_params)),
         backend_(backend),
         quiet_(quiet),
@@ -276,6 +300,8 @@ class AtsConf {
         plugin_(std::move(plugin)),
         soc_manufacturer_(std::move(soc_manufacturer)),
         soc_model_(std::move(soc_model)),
+        baseline_(std::move(baseline)),
+        tolerances_(tolerances),
         target_options_(std::move(target_options)),
         reference_options_(std::move(reference_options)) {
     // For now, we will provide default settings for data generation.
@@ -304,6 +330,8 @@ class AtsConf {
   std::optional<internal::CompilerPlugin> plugin_;
   std::string soc_manufacturer_;
   std::string soc_model_;
+  std::optional<PerfBaseline> baseline_;
+  PerfTolerances tolerances_;
   Options target_options_;
   Options reference_options_;
 
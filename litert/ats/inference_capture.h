@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <chrono>  // NOLINT
+#include <cmath>
 #include <cstddef>
 #include <ctime>
 #include <functional>
@@ -28,6 +29,7 @@
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/ats/capture_common.h"
 #include "litert/ats/common.h"
+#include "litert/ats/perf_baseline.h"
 #include "litert/ats/print.h"
 #include "litert/cc/internal/litert_detail.h"
 
@@ -58,9 +60,7 @@ class Latency
 
   // Stop timing and record the latency.
   void Stop(const TimePoint& start) {
-    const auto micro = std::chrono::duration_cast<
-        std::chrono::duration<Microseconds, std::micro>>(Clock::now() - start);
-    latencies_.push_back(micro.count());
+    latencies_.push_back(MicrosecondsSince(start));
   }
 
   // Average latency.
@@ -87,6 +87,9 @@ class Latency
   // Number of samples.
   size_t NumSamples() const { return latencies_.size(); }
 
+  // All samples, in the order they were recorded.
+  const std::vector<Microseconds>& Samples() const { return latencies_; }
+
   Latency()
       : Printable("Latency", "avg_latency(us)", "max_latency(us)",
                   "min_latency(us)", "num_samples") {}
@@ -99,6 +102,49 @@ class Latency
   std::vector<Microseconds> latencies_;
 };
 
+// Performance of the test case, compared against the baseline if any.
+class Performance
+    : public Printable<Microseconds, Microseconds, Microseconds, Microseconds,
+                       Microseconds, double> {
+ public:
+  PerfMetrics metrics = {};  // NOLINT
+
+  // Split the recorded latencies into the first run and the steady state.
+  void SetLatencies(const Latency& latency) {
+    const auto& samples = latency.Samples();
+    if (samples.empty()) {
+      return;
+    }
+    metrics.first_run = samples.front();
+    std::vector<Microseconds> steady(samples.begin() + 1, samples.end());
+    if (steady.empty()) {
+      return;
+    }
+    std::sort(steady.begin(), steady.end());
+    // Nearest rank.
+    auto at = [&steady](double fraction) {
+      const size_t rank =
+          static_cast<size_t>(std::ceil(fraction * steady.size()));
+      return steady[std::max<size_t>(rank, 1) - 1];
+    };
+    metrics.p50 = at(0.50);
+    metrics.p90 = at(0.90);
+    metrics.p99 = at(0.99);
+  }
+
+  Performance()
+      : Printable("Performance", PerfMetrics::kCompileTimeKey,
+                  PerfMetrics::kFirstRunKey, PerfMetrics::kP50Key,
+                  PerfMetrics::kP90Key, PerfMetrics::kP99Key,
+                  PerfMetrics::kPeakMemKey) {}
+
+ private:
+  Fields GetFields() const override {
+    return Fields{metrics.compile_time, metrics.first_run, metrics.p50,
+                  metrics.p90,          metrics.p99,       metrics.peak_mem_mb};
+  }
+};
+
 // Information about the numerics of the execution.
 class Numerics : public Printable<ReferenceType, double> {
  public:
@@ -135,22 +181,25 @@ struct RunDetail : public Printable<size_t, RunStatus> {
 
 // Type to hold all of the capturable information related to a single test case.
 struct InferenceCaptureEntry
-    : public PrintableRow<ModelDetail, AcceleratorDetail, Latency, Numerics,
-                          RunDetail, CompilationDetail> {
+    : public PrintableRow<ModelDetail, AcceleratorDetail, Latency,
+                          Performance, Numerics, RunDetail,
+                          CompilationDetail> {
   InferenceCaptureEntry() = default;
 
   ModelDetail model = {};
   AcceleratorDetail accelerator = {};
   Latency latency = {};
+  Performance performance = {};
   Numerics numerics = {};
   RunDetail run = {};
   CompilationDetail compilation = {};
 
  private:
   Printables GetPrintables() const override {
-    return Printables{std::cref(model),   std::cref(accelerator),
-                      std::cref(latency), std::cref(numerics),
-                      std::cref(run),     std::cref(compilation)};
+    return Printables{std::cref(model),       std::cref(accelerator),
+                      std::cref(latency),     std::cref(performance),
+                      std::cref(numerics),    std::cref(run),
+                      std::cref(compilation)};
   }
 
   std::string Name() const override { return model.name; }
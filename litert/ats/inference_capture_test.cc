@@ -27,6 +27,28 @@ TEST(AtsCaptureTest, LatencyRow) {
   EXPECT_EQ(l.Avg(), l.Max());
 }
 
+TEST(AtsCaptureTest, PerformanceSplitsFirstRun) {
+  Latency l;
+  for (int i = 0; i < 5; ++i) {
+    l.Stop(l.Start());
+  }
+  Performance p;
+  p.SetLatencies(l);
+  EXPECT_EQ(p.metrics.first_run, l.Samples().front());
+  EXPECT_LE(p.metrics.p50, p.metrics.p90);
+  EXPECT_LE(p.metrics.p90, p.metrics.p99);
+  EXPECT_LE(p.metrics.p99, l.Max());
+}
+
+TEST(AtsCaptureTest, PerformanceSingleRun) {
+  Latency l;
+  l.Stop(l.Start());
+  Performance p;
+  p.SetLatencies(l);
+  EXPECT_EQ(p.metrics.first_run, l.Max());
+  EXPECT_EQ(p.metrics.p50, 0);
+}
+
 TEST(AtsCaptureTest, Numerics) {
   Numerics n;
   n.NewMse(2.0);
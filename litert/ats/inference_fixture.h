@@ -43,6 +43,7 @@
 #include "litert/test/matchers.h"
 #include "litert/test/rng_fixture.h"
 #include "litert/test/simple_buffer.h"
+#include "tflite/profiling/memory_usage_monitor.h"
 
 namespace litert::testing {
 
@@ -72,6 +73,7 @@ class AtsInferenceTest : public RngTest {
   }
 
   void SetUp() override {
+    memory_monitor_.Start();
     ASSERT_EQ(Graph().NumSubgraphs(), 1);
     ASSERT_EQ(Graph().MainSubgraph()->NumOutputs(), 1);
     LITERT_LOG(LITERT_INFO, "Setting up test for %s",
@@ -84,7 +86,9 @@ class AtsInferenceTest : public RngTest {
 
   void TestBody() override {
     auto device = this->TracedDevice(conf_.DataSeed());
+    const auto compile_start = Clock::now();
     LITERT_ASSERT_OK_AND_ASSIGN(auto exec, MakeExecutor());
+    cap_.performance.metrics.compile_time = MicrosecondsSince(compile_start);
     for (auto _ : this->FuzzBlock(conf_.ItersPerTest(), conf_.MaxMsPerTest())) {
       LITERT_ASSERT_OK_AND_ASSIGN(auto inputs, MakeInputs(device));
       LITERT_ASSERT_OK_AND_ASSIGN(auto ref, Reference(inputs));
@@ -103,16 +107,37 @@ class AtsInferenceTest : public RngTest {
       }
     }
 
+    memory_monitor_.Stop();
+    cap_.performance.metrics.peak_mem_mb =
+        memory_monitor_.GetPeakInUseMemoryInMB();
+    cap_.performance.SetLatencies(cap_.latency);
+
     if (HasFailure()) {
       cap_.run.status = RunStatus::kError;
     } else if (TimedOut()) {
       cap_.run.status = RunStatus::kTimeout;
-    } else {
+    } else if (CheckPerformance()) {
       cap_.run.status = RunStatus::kOk;
+    } else {
+      cap_.run.status = RunStatus::kPerfRegression;
     }
   }
 
  private:
+  // Fails the test if it regressed over the baseline.
+  bool CheckPerformance() {
+    if (!conf_.Baseline()) {
+      return true;
+    }
+    const auto regressions = conf_.Baseline()->Regressions(
+        cap_.model.name, conf_.Backend(), cap_.performance.metrics,
+        conf_.Tolerances());
+    for (const auto& regression : regressions) {
+      ADD_FAILURE() << regression;
+    }
+    return regressions.empty();
+  }
+
   Expected<CompiledModelExecutor::Ptr> MakeExecutor() {
     CompiledModelExecutor::Ptr exec;
     if (conf_.IsNpu()) {
@@ -197,6 +222,11 @@ class AtsInferenceTest : public RngTest {
                    const TestNames& names, typename Capture::Entry& cap)
       : graph_(std::move(graph)), conf_(conf), names_(names), cap_(cap) {}
 
+  // Samples the heap every few milliseconds from set up to tear down.
+  static constexpr int kMemorySamplingMs = 5;
+  tflite::profiling::memory::MemoryUsageMonitor memory_monitor_{
+      kMemorySamplingMs};
+
   TestGraph::Ptr graph_;
   const AtsConf& conf_;
   TestNames names_;
@@ -0,0 +1,182 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/ats/perf_baseline.h"
+
+#include <cstddef>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/strings/numbers.h"  // from @com_google_absl
+#include "absl/strings/str_cat.h"  // from @com_google_absl
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/str_split.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "litert/ats/common.h"
+#include "litert/c/litert_common.h"
+#include "litert/cc/litert_expected.h"
+
+namespace litert::testing {
+namespace {
+
+std::string Key(absl::string_view backend, absl::string_view name) {
+  return absl::StrCat(backend, "/", name);
+}
+
+std::string Key(ExecutionBackend backend, absl::string_view name) {
+  return Key(absl::StrFormat("%v", backend), name);
+}
+
+// Whether `actual` regressed over `baseline` by more than `tolerance` and
+// `min_regression`.
+template <typename T>
+bool Regressed(T actual, T baseline, double tolerance, T min_regression) {
+  return actual > baseline && actual - baseline > min_regression &&
+         actual > baseline * (1.0 + tolerance);
+}
+
+}  // namespace
+
+Expected<PerfBaseline> PerfBaseline::Load(absl::string_view path) {
+  std::ifstream in((std::string(path)));
+  if (!in) {
+    return Error(kLiteRtStatusErrorFileIO,
+                 absl::StrFormat("Failed to open perf baseline %s", path));
+  }
+  std::stringstream contents;
+  contents << in.rdbuf();
+  return Parse(contents.str());
+}
+
+Expected<PerfBaseline> PerfBaseline::Parse(absl::string_view csv) {
+  std::vector<absl::string_view> lines =
+      absl::StrSplit(csv, '\n', absl::SkipWhitespace());
+  if (lines.empty()) {
+    return Error(kLiteRtStatusErrorInvalidArgument, "Empty perf baseline");
+  }
+  const std::vector<absl::string_view> header = absl::StrSplit(lines[0], ',');
+  absl::flat_hash_map<absl::string_view, size_t> columns;
+  // Keeps the first of duplicate keys, the run status comes before the
+  // compilation status.
+  for (size_t i = 0; i < header.size(); ++i) {
+    columns.emplace(header[i], i);
+  }
+  for (auto key : {absl::string_view("name"), absl::string_view("backend"),
+                   absl::string_view("status"), PerfMetrics::kCompileTimeKey,
+                   PerfMetrics::kFirstRunKey, PerfMetrics::kP50Key,
+                   PerfMetrics::kP90Key, PerfMetrics::kP99Key,
+                   PerfMetrics::kPeakMemKey}) {
+    if (!columns.contains(key)) {
+      return Error(kLiteRtStatusErrorInvalidArgument,
+                   absl::StrFormat("Perf baseline has no %s column", key));
+    }
+  }
+
+  PerfBaseline baseline;
+  for (size_t l = 1; l < lines.size(); ++l) {
+    const std::vector<absl::string_view> fields =
+        absl::StrSplit(lines[l], ',');
+    if (fields.size() < header.size()) {
+      return Error(kLiteRtStatusErrorInvalidArgument,
+                   absl::StrFormat("Malformed perf baseline row %d", l));
+    }
+    // The report does not quote its fields and the model description may hold
+    // commas, so the columns after the name are indexed from the end.
+    auto field = [&](absl::string_view key) {
+      const size_t column = columns[key];
+      return column == 0 ? fields[0]
+                         : fields[fields.size() - header.size() + column];
+    };
+    if (field("status") != absl::StrFormat("%v", RunStatus::kOk)) {
+      continue;
+    }
+    PerfMetrics metrics;
+    if (!absl::SimpleAtoi(field(PerfMetrics::kCompileTimeKey),
+                          &metrics.compile_time) ||
+        !absl::SimpleAtoi(field(PerfMetrics::kFirstRunKey),
+                          &metrics.first_run) ||
+        !absl::SimpleAtoi(field(PerfMetrics::kP50Key), &metrics.p50) ||
+        !absl::SimpleAtoi(field(PerfMetrics::kP90Key), &metrics.p90) ||
+        !absl::SimpleAtoi(field(PerfMetrics::kP99Key), &metrics.p99) ||
+        !absl::SimpleAtod(field(PerfMetrics::kPeakMemKey),
+                          &metrics.peak_mem_mb)) {
+      return Error(kLiteRtStatusErrorInvalidArgument,
+                   absl::StrFormat("Malformed perf baseline row %d", l));
+    }
+    baseline.metrics_[Key(field("backend"), field("name"))] = metrics;
+  }
+  return baseline;
+}
+
+std::optional<PerfMetrics> PerfBaseline::Find(absl::string_view name,
+                                              ExecutionBackend backend) const {
+  auto it = metrics_.find(Key(backend, name));
+  if (it == metrics_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+std::vector<std::string> PerfBaseline::Regressions(
+    absl::string_view name, ExecutionBackend backend,
+    const PerfMetrics& actual, const PerfTolerances& tolerances) const {
+  std::vector<std::string> res;
+  const auto baseline = Find(name, backend);
+  if (!baseline) {
+    return res;
+  }
+  auto check_time = [&](absl::string_view key, Microseconds actual_us,
+                        Microseconds baseline_us, double tolerance) {
+    // Not recorded by the baseline, e.g. the steady state of a single run.
+    if (baseline_us == 0) {
+      return;
+    }
+    if (Regressed(actual_us, baseline_us, tolerance,
+                  tolerances.min_regression_us)) {
+      res.push_back(absl::StrFormat("%s regressed from %d to %d (+%.1f%%)",
+                                    key, baseline_us, actual_us,
+                                    100.0 * (actual_us - baseline_us) /
+                                        baseline_us));
+    }
+  };
+  check_time(PerfMetrics::kCompileTimeKey, actual.compile_time,
+             baseline->compile_time, tolerances.compile_time);
+  check_time(PerfMetrics::kFirstRunKey, actual.first_run, baseline->first_run,
+             tolerances.latency);
+  check_time(PerfMetrics::kP50Key, actual.p50, baseline->p50,
+             tolerances.latency);
+  check_time(PerfMetrics::kP90Key, actual.p90, baseline->p90,
+             tolerances.latency);
+  check_time(PerfMetrics::kP99Key, actual.p99, baseline->p99,
+             tolerances.latency);
+
+  // Memory is only comparable when both runs could sample it.
+  if (actual.peak_mem_mb >= 0 && baseline->peak_mem_mb > 0 &&
+      Regressed(actual.peak_mem_mb, baseline->peak_mem_mb, tolerances.memory,
+                0.0)) {
+    res.push_back(absl::StrFormat(
+        "%s regressed from %.2f to %.2f (+%.1f%%)", PerfMetrics::kPeakMemKey,
+        baseline->peak_mem_mb, actual.peak_mem_mb,
+        100.0 * (actual.peak_mem_mb - baseline->peak_mem_mb) /
+            baseline->peak_mem_mb));
+  }
+  return res;
+}
+
+}  // namespace litert::testing
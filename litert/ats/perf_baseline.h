@@ -0,0 +1,96 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_ODML_LITERT_LITERT_ATS_PERF_BASELINE_H_
+#define THIRD_PARTY_ODML_LITERT_LITERT_ATS_PERF_BASELINE_H_
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "litert/ats/common.h"
+#include "litert/cc/litert_expected.h"
+
+namespace litert::testing {
+
+// Performance of a single test case on the accelerator under test.
+struct PerfMetrics {
+  // CSV report columns.
+  static constexpr absl::string_view kCompileTimeKey = "compile_time(us)";
+  static constexpr absl::string_view kFirstRunKey = "first_run(us)";
+  static constexpr absl::string_view kP50Key = "p50_latency(us)";
+  static constexpr absl::string_view kP90Key = "p90_latency(us)";
+  static constexpr absl::string_view kP99Key = "p99_latency(us)";
+  static constexpr absl::string_view kPeakMemKey = "peak_mem(mb)";
+
+  // Time to create the compiled model, including any JIT compilation.
+  Microseconds compile_time = 0;
+
+  // Latency of the first run, which pays for lazy allocations and warm up.
+  Microseconds first_run = 0;
+
+  // Latency percentiles of the steady state, the runs after the first one.
+  Microseconds p50 = 0;
+  Microseconds p90 = 0;
+  Microseconds p99 = 0;
+
+  // Peak heap memory in use by the process during the test, negative if the
+  // platform does not support sampling it.
+  double peak_mem_mb = -1.0;
+};
+
+// Allowed regressions relative to the baseline.
+struct PerfTolerances {
+  // Latencies, both first run and steady state.
+  double latency = 0.1;
+  double compile_time = 0.25;
+  double memory = 0.1;
+  // Time regressions at or below this are noise whatever their ratio.
+  Microseconds min_regression_us = 100;
+};
+
+// Metrics of a previous run of the suite, read from its CSV report.
+class PerfBaseline {
+ public:
+  // Loads the CSV report written with --csv by a previous run.
+  static Expected<PerfBaseline> Load(absl::string_view path);
+
+  // Parses the contents of a CSV report. Only the rows that ran successfully
+  // are kept.
+  static Expected<PerfBaseline> Parse(absl::string_view csv);
+
+  // The baseline of the test with the given report id on the given backend.
+  std::optional<PerfMetrics> Find(absl::string_view name,
+                                  ExecutionBackend backend) const;
+
+  // Human readable descriptions of the metrics in `actual` that regressed
+  // over `tolerances`. Empty if there is no baseline for the test.
+  std::vector<std::string> Regressions(absl::string_view name,
+                                       ExecutionBackend backend,
+                                       const PerfMetrics& actual,
+                                       const PerfTolerances& tolerances) const;
+
+  // Number of tests in the baseline.
+  size_t Size() const { return metrics_.size(); }
+
+ private:
+  absl::flat_hash_map<std::string, PerfMetrics> metrics_;
+};
+
+}  // namespace litert::testing
+
+#endif  // THIRD_PARTY_ODML_LITERT_LITERT_ATS_PERF_BASELINE_H_
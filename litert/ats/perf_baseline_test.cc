@@ -0,0 +1,100 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/ats/perf_baseline.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "litert/ats/common.h"
+#include "litert/test/matchers.h"
+
+namespace litert::testing {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+
+// Same layout as the report of the inference tests.
+constexpr absl::string_view kReport =
+    "name,desc,precompiled,backend,soc_man,soc_model,avg_latency(us),"
+    "max_latency(us),min_latency(us),num_samples,compile_time(us),"
+    "first_run(us),p50_latency(us),p90_latency(us),p99_latency(us),"
+    "peak_mem(mb),reference_type,avg_mse,num_iterations,status,status\n"
+    "add,[tfl.add, tfl.mul],0,cpu,n/a,n/a,10,20,5,3,1000,20,8,9,10,2.5,cpu,0,"
+    "3,ok,not_requested\n"
+    "sub,tfl.sub,0,npu,Example,n/a,10,20,5,3,5000,20,8,9,10,4,cpu,0,3,ok,"
+    "fully_compiled\n"
+    "mul,tfl.mul,0,cpu,n/a,n/a,10,20,5,3,1000,20,8,9,10,2.5,cpu,0,3,error,"
+    "not_requested\n";
+
+TEST(PerfBaselineTest, Parse) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto baseline, PerfBaseline::Parse(kReport));
+  EXPECT_EQ(baseline.Size(), 2);
+
+  auto add = baseline.Find("add", ExecutionBackend::kCpu);
+  ASSERT_TRUE(add);
+  EXPECT_EQ(add->compile_time, 1000);
+  EXPECT_EQ(add->first_run, 20);
+  EXPECT_EQ(add->p50, 8);
+  EXPECT_EQ(add->p90, 9);
+  EXPECT_EQ(add->p99, 10);
+  EXPECT_DOUBLE_EQ(add->peak_mem_mb, 2.5);
+
+  EXPECT_TRUE(baseline.Find("sub", ExecutionBackend::kNpu));
+  EXPECT_FALSE(baseline.Find("sub", ExecutionBackend::kCpu));
+  // Failed runs are not a baseline.
+  EXPECT_FALSE(baseline.Find("mul", ExecutionBackend::kCpu));
+}
+
+TEST(PerfBaselineTest, ParseMissingColumns) {
+  EXPECT_FALSE(PerfBaseline::Parse("name,backend,status\nadd,cpu,ok\n"));
+  EXPECT_FALSE(PerfBaseline::Parse(""));
+}
+
+TEST(PerfBaselineTest, Regressions) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto baseline, PerfBaseline::Parse(kReport));
+  PerfTolerances tolerances;
+  tolerances.latency = 0.1;
+  tolerances.compile_time = 0.5;
+  tolerances.memory = 0.1;
+  tolerances.min_regression_us = 5;
+
+  PerfMetrics same = *baseline.Find("add", ExecutionBackend::kCpu);
+  EXPECT_THAT(baseline.Regressions("add", ExecutionBackend::kCpu, same,
+                                   tolerances),
+              IsEmpty());
+
+  PerfMetrics slower = same;
+  // Over the ratio but under the absolute minimum.
+  slower.p50 = 12;
+  // Over both.
+  slower.p99 = 20;
+  // Under the compile time tolerance.
+  slower.compile_time = 1400;
+  slower.peak_mem_mb = 3.0;
+  EXPECT_THAT(
+      baseline.Regressions("add", ExecutionBackend::kCpu, slower, tolerances),
+      ElementsAre(HasSubstr("p99_latency(us) regressed from 10 to 20"),
+                  HasSubstr("peak_mem(mb)")));
+
+  // No baseline for the test.
+  EXPECT_THAT(
+      baseline.Regressions("add", ExecutionBackend::kNpu, slower, tolerances),
+      IsEmpty());
+}
+
+}  // namespace
+}  // namespace litert::testing
@@ -0,0 +1,192 @@
+# Copyright 2025 Google LLC.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Generates the registrations of the builtin ops used by .tflite models, like
+# //tflite/tools:generate_op_registrations with --builtin_ops_only, without a
+# host tool so that it also works when cross compiling. Only the operator codes
+# of the models are read, not their weights.
+#
+# Usage:
+#   cmake -DMODELS=<model.tflite>[,<model.tflite>...] -DSCHEMA=<schema.fbs>
+#         -DKERNELS_LIST=<builtin_ops_list.inc> -DOUTPUT=<registration.cc>
+#         -P gen_selected_ops.cmake
+
+cmake_minimum_required(VERSION 3.20)
+
+# Sets `out` to the little endian unsigned integer of `size` bytes at `offset`
+# in `model`.
+function(_litert_read_uint model offset size out)
+  file(READ "${model}" hex OFFSET ${offset} LIMIT ${size} HEX)
+  string(LENGTH "${hex}" hex_length)
+  math(EXPR expected_length "${size} * 2")
+  if(NOT hex_length EQUAL expected_length)
+    message(FATAL_ERROR "${model} is not a valid model: truncated at ${offset}")
+  endif()
+  set(big_endian "")
+  math(EXPR last "${size} - 1")
+  foreach(i RANGE ${last})
+    math(EXPR begin "${i} * 2")
+    string(SUBSTRING "${hex}" ${begin} 2 byte)
+    set(big_endian "${byte}${big_endian}")
+  endforeach()
+  math(EXPR value "0x${big_endian}")
+  set(${out} ${value} PARENT_SCOPE)
+endfunction()
+
+# Same as above for a signed integer.
+function(_litert_read_int model offset size out)
+  _litert_read_uint("${model}" ${offset} ${size} value)
+  math(EXPR sign_bit "1 << (${size} * 8 - 1)")
+  if(value GREATER_EQUAL sign_bit)
+    math(EXPR value "${value} - 2 * ${sign_bit}")
+  endif()
+  set(${out} ${value} PARENT_SCOPE)
+endfunction()
+
+# Sets `out` to the position the offset at `pos` points to.
+function(_litert_deref model pos out)
+  _litert_read_uint("${model}" ${pos} 4 offset)
+  math(EXPR target "${pos} + ${offset}")
+  set(${out} ${target} PARENT_SCOPE)
+endfunction()
+
+# Sets `out` to the position of the field `index` of the flatbuffer table at
+# `table`, or to 0 if the field is not set.
+function(_litert_field_pos model table index out)
+  _litert_read_int("${model}" ${table} 4 vtable_offset)
+  math(EXPR vtable "${table} - ${vtable_offset}")
+  _litert_read_uint("${model}" ${vtable} 2 vtable_size)
+  math(EXPR entry "4 + 2 * ${index}")
+  set(pos 0)
+  if(entry LESS vtable_size)
+    math(EXPR entry_pos "${vtable} + ${entry}")
+    _litert_read_uint("${model}" ${entry_pos} 2 field_offset)
+    if(field_offset GREATER 0)
+      math(EXPR pos "${table} + ${field_offset}")
+    endif()
+  endif()
+  set(${out} ${pos} PARENT_SCOPE)
+endfunction()
+
+# Sets `out` to the value of the integer field `index` of the table at
+# `table`, or to `default` if the field is not set.
+function(_litert_read_field model table index size default out)
+  _litert_field_pos("${model}" ${table} ${index} pos)
+  set(value ${default})
+  if(pos GREATER 0)
+    _litert_read_int("${model}" ${pos} ${size} value)
+  endif()
+  set(${out} ${value} PARENT_SCOPE)
+endfunction()
+
+# Names of the BuiltinOperator values.
+file(STRINGS "${SCHEMA}" schema_lines)
+set(in_builtin_operator FALSE)
+foreach(line IN LISTS schema_lines)
+  if(line MATCHES "^enum BuiltinOperator ")
+    set(in_builtin_operator TRUE)
+  elseif(in_builtin_operator)
+    if(line MATCHES "^}")
+      break()
+    elseif(line MATCHES "^ *([A-Z0-9_]+) = ([0-9]+)")
+      set(op_name_${CMAKE_MATCH_2} ${CMAKE_MATCH_1})
+    endif()
+  endif()
+endforeach()
+
+# Ops with a builtin kernel.
+file(STRINGS "${KERNELS_LIST}" kernel_lines REGEX "^TFLITE_OP\\(Register_")
+foreach(line IN LISTS kernel_lines)
+  if(line MATCHES "^TFLITE_OP\\(Register_([A-Z0-9_]+)\\)")
+    set(has_kernel_${CMAKE_MATCH_1} TRUE)
+  endif()
+endforeach()
+
+set(ops "")
+string(REPLACE "," ";" models "${MODELS}")
+foreach(model IN LISTS models)
+  _litert_deref("${model}" 0 root)
+  # Model.operator_codes
+  _litert_field_pos("${model}" ${root} 1 op_codes_field)
+  if(op_codes_field EQUAL 0)
+    continue()
+  endif()
+  _litert_deref("${model}" ${op_codes_field} op_codes)
+  _litert_read_uint("${model}" ${op_codes} 4 num_op_codes)
+  if(num_op_codes EQUAL 0)
+    continue()
+  endif()
+  math(EXPR last "${num_op_codes} - 1")
+  foreach(i RANGE ${last})
+    math(EXPR element "${op_codes} + 4 + 4 * ${i}")
+    _litert_deref("${model}" ${element} op_code)
+    # OperatorCode.deprecated_builtin_code, version and builtin_code.
+    _litert_read_field("${model}" ${op_code} 0 1 0 deprecated_code)
+    _litert_read_field("${model}" ${op_code} 2 4 1 version)
+    _litert_read_field("${model}" ${op_code} 3 4 0 code)
+    if(deprecated_code GREATER code)
+      set(code ${deprecated_code})
+    endif()
+    if(NOT DEFINED op_name_${code})
+      message(WARNING "${model} uses the unknown builtin op ${code}")
+      continue()
+    endif()
+    set(name ${op_name_${code}})
+    if(name STREQUAL "CUSTOM")
+      # Custom ops are registered by the runtime.
+      continue()
+    endif()
+    if(NOT has_kernel_${name})
+      message(STATUS "${model} uses ${name}, which has no builtin kernel")
+      continue()
+    endif()
+    if(NOT DEFINED min_version_${name} OR version LESS min_version_${name})
+      set(min_version_${name} ${version})
+    endif()
+    if(NOT DEFINED max_version_${name} OR version GREATER max_version_${name})
+      set(max_version_${name} ${version})
+    endif()
+    list(APPEND ops ${name})
+  endforeach()
+endforeach()
+list(REMOVE_DUPLICATES ops)
+list(SORT ops)
+
+set(content "// Generated by gen_selected_ops.cmake. DO NOT EDIT.\n")
+if(ops)
+  string(APPEND content "#include \"tflite/kernels/builtin_op_kernels.h\"\n")
+endif()
+string(APPEND content "#include \"tflite/mutable_op_resolver.h\"\n")
+string(APPEND content "#include \"tflite/schema/schema_generated.h\"\n\n")
+string(APPEND content
+       "void RegisterSelectedOps(::tflite::MutableOpResolver* resolver) {\n")
+foreach(name IN LISTS ops)
+  string(APPEND content "  resolver->AddBuiltin(::tflite::BuiltinOperator_"
+         "${name}, ::tflite::ops::builtin::Register_${name}()")
+  if(NOT min_version_${name} EQUAL 1 OR NOT max_version_${name} EQUAL 1)
+    string(APPEND content
+           ", ${min_version_${name}}, ${max_version_${name}}")
+  endif()
+  string(APPEND content ");\n")
+endforeach()
+string(APPEND content "}\n")
+
+# Keep the timestamp of an unchanged file to not rebuild the runtime.
+set(previous_content "")
+if(EXISTS "${OUTPUT}")
+  file(READ "${OUTPUT}" previous_content)
+endif()
+if(NOT content STREQUAL previous_content)
+  file(WRITE "${OUTPUT}" "${content}")
+endif()
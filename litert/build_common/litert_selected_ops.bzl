@@ -0,0 +1,88 @@
+# Copyright 2025 Google LLC.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Generates an op resolver with only the builtin kernels used by models."""
+
+load("@rules_cc//cc:cc_library.bzl", "cc_library")
+
+def _litert_selected_ops_registration_impl(ctx):
+    args = ctx.actions.args()
+    args.add(ctx.outputs.output, format = "--output_registration=%s")
+    args.add("--tflite_path=tflite")
+    args.add("--builtin_ops_only")
+    args.add_joined(
+        ctx.files.models,
+        join_with = ",",
+        format_joined = "--input_models=%s",
+    )
+    ctx.actions.run(
+        outputs = [ctx.outputs.output],
+        inputs = ctx.files.models,
+        arguments = [args],
+        executable = ctx.executable._generate_op_registrations,
+        mnemonic = "LiteRtOpRegistration",
+        progress_message = "Generating the op registrations of %s" % ctx.label,
+    )
+
+_litert_selected_ops_registration = rule(
+    implementation = _litert_selected_ops_registration_impl,
+    attrs = {
+        "models": attr.label_list(allow_files = [".tflite"], mandatory = True),
+        "output": attr.output(),
+        "_generate_op_registrations": attr.label(
+            executable = True,
+            default = Label("//tflite/tools:generate_op_registrations"),
+            cfg = "exec",
+        ),
+    },
+)
+
+def litert_selected_ops(name, models, **kwargs):
+    """Defines an op resolver with the builtin kernels used by `models` only.
+
+    The custom ops, e.g. the NPU dispatch op, are registered by the runtime
+    itself and are not part of the resolver. Build the runtime with it using
+
+        --define=litert_builtin_ops=selected --//litert:selected_ops=<label>
+
+    so that the kernels of the other ops, and their static initializers, are
+    not linked in.
+
+    Args:
+      name: name of the cc_library defining `tflite::CreateOpResolver()`.
+      models: list of the .tflite models the runtime must be able to run.
+      **kwargs: additional arguments for the cc_library.
+    """
+    _litert_selected_ops_registration(
+        name = name + "_registration",
+        models = models,
+        output = name + "_registration.cc",
+        testonly = kwargs.get("testonly", False),
+    )
+    cc_library(
+        name = name,
+        srcs = [
+            ":" + name + "_registration",
+            "//tflite:create_op_resolver_with_selected_ops.cc",
+        ],
+        hdrs = ["//tflite:create_op_resolver.h"],
+        deps = [
+            "//tflite:mutable_op_resolver",
+            "//tflite:op_resolver",
+            "//tflite/core:private_create_op_resolver_header",
+            "//tflite/kernels:builtin_ops",
+        ],
+        **kwargs
+    )
@@ -30,6 +30,8 @@ LiteRtStatus LiteRtGetNumAccelerators(LiteRtEnvironment environment,
   if (!environment || !num_accelerators) {
     return kLiteRtStatusErrorInvalidArgument;
   }
+  // Listing the accelerators requires loading the lazily registered ones.
+  environment->GetAcceleratorRegistry().LoadAllAccelerators();
   *num_accelerators = environment->GetAcceleratorRegistry().size();
   return kLiteRtStatusOk;
 }
@@ -42,6 +44,7 @@ LiteRtStatus LiteRtGetAccelerator(LiteRtEnvironment environment,
   if (!environment || !accelerator) {
     return kLiteRtStatusErrorInvalidArgument;
   }
+  environment->GetAcceleratorRegistry().LoadAllAccelerators();
   litert::Expected<LiteRtAccelerator> registered_accelerator =
       environment->GetAcceleratorRegistry().Get(index);
   if (!registered_accelerator.HasValue()) {
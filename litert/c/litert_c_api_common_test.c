@@ -35,6 +35,7 @@
 #include "litert/c/litert_options.h"         // NOLINT
 #include "litert/c/litert_profiler.h"        // NOLINT
 #include "litert/c/litert_profiler_event.h"  // NOLINT
+#include "litert/c/litert_telemetry.h"       // NOLINT
 #include "litert/c/litert_tensor_buffer.h"   // NOLINT
 #include "litert/c/litert_tensor_buffer_requirements.h"  // NOLINT
 #include "litert/c/internal/litert_accelerator.h"  // NOLINT
@@ -66,6 +66,9 @@ LITERT_DEFINE_HANDLE(LiteRtAccelerator);
 LITERT_DEFINE_HANDLE(LiteRtDelegateWrapper);
 // LiteRT CompiledModel object. (litert_compiled_model.h)
 LITERT_DEFINE_HANDLE(LiteRtCompiledModel);
+// A set of tensor buffers pre-bound to a CompiledModel signature.
+// (litert_compiled_model.h)
+LITERT_DEFINE_HANDLE(LiteRtExecutionPlan);
 // LiteRT Environment object. (litert_environment.h)
 LITERT_DEFINE_HANDLE(LiteRtEnvironment);
 // LiteRT EnvironmentOptions object. (litert_environment_options.h)
@@ -348,6 +351,17 @@ typedef enum LiteRtErrorReporterMode {
   kLiteRtErrorReporterModeBuffer = 2,
 } LiteRtErrorReporterMode;
 
+// Priority of the runs of a compiled model on the device it runs on. The runs
+// with a priority are ordered by the environment per device, higher priorities
+// first, see LiteRtSetRuntimeOptionsRunPriority(). The runs without one are
+// not ordered.
+typedef enum LiteRtRunPriority {
+  kLiteRtRunPriorityNone = 0,
+  kLiteRtRunPriorityLow = 1,
+  kLiteRtRunPriorityNormal = 2,
+  kLiteRtRunPriorityHigh = 3,
+} LiteRtRunPriority;
+
 // A bit field of `LiteRtHwAccelerators` values.
 typedef int LiteRtHwAcceleratorSet;
 
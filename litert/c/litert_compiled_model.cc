@@ -15,6 +15,7 @@
 #include "litert/c/litert_compiled_model.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <cstdarg>
 #include <cstdio>
@@ -23,7 +24,10 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "absl/time/time.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
@@ -55,6 +59,31 @@ LiteRtStatus LiteRtCreateCompiledModel(LiteRtEnvironment environment,
   return kLiteRtStatusOk;
 }
 
+LiteRtStatus LiteRtCreateModelFromFileWithEnvironment(
+    LiteRtEnvironment environment, const char* filename, LiteRtModel* model) {
+  if (!environment || !filename || !model) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  LITERT_ASSIGN_OR_RETURN(
+      auto new_model,
+      LiteRtCompiledModelT::LoadModelFile(*environment, filename));
+  *model = new_model.release();
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtCreateSharedCompiledModel(
+    LiteRtCompiledModel primary, LiteRtOptions compilation_options,
+    LiteRtCompiledModel* compiled_model) {
+  if (!primary || !compilation_options || !compiled_model) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  LITERT_ASSIGN_OR_RETURN(
+      auto created_compiled_model,
+      LiteRtCompiledModelT::CreateShared(*primary, compilation_options));
+  *compiled_model = created_compiled_model.release();
+  return kLiteRtStatusOk;
+}
+
 LiteRtStatus LiteRtGetCompiledModelInputBufferRequirements(
     LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index,
     LiteRtParamIndex input_index,
@@ -177,6 +206,62 @@ LiteRtStatus LiteRtRunCompiledModelAsync(LiteRtCompiledModel compiled_model,
   return kLiteRtStatusOk;
 }
 
+LiteRtStatus LiteRtCreateCompiledModelExecutionPlan(
+    LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index,
+    size_t num_input_buffers, LiteRtTensorBuffer* input_buffers,
+    size_t num_output_buffers, LiteRtTensorBuffer* output_buffers,
+    LiteRtExecutionPlan* execution_plan) {
+  if (!compiled_model || (num_input_buffers > 0 && !input_buffers) ||
+      (num_output_buffers > 0 && !output_buffers) || !execution_plan) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  auto plan = compiled_model->CreateExecutionPlan(
+      signature_index, absl::MakeConstSpan(input_buffers, num_input_buffers),
+      absl::MakeConstSpan(output_buffers, num_output_buffers));
+  if (!plan) {
+    LITERT_LOG(LITERT_ERROR, "%s", plan.Error().Message().c_str());
+    return plan.Error().Status();
+  }
+  *execution_plan = plan->release();
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtRunExecutionPlan(LiteRtExecutionPlan execution_plan) {
+  if (!execution_plan) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  bool async = false;
+  auto res = execution_plan->CompiledModel()->RunExecutionPlan(*execution_plan,
+                                                               async);
+  if (!res) {
+    LITERT_LOG(LITERT_ERROR, "%s", res.Error().Message().c_str());
+    return res.Error().Status();
+  }
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtRunExecutionPlanAsync(LiteRtExecutionPlan execution_plan,
+                                         bool* async) {
+  if (!execution_plan) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  bool async_ = true;
+  auto res = execution_plan->CompiledModel()->RunExecutionPlan(*execution_plan,
+                                                               async_);
+  if (async) {
+    *async = async_;
+  }
+  if (!res) {
+    LITERT_LOG(LITERT_ERROR, "%s", res.Error().Message().c_str());
+    return res.Error().Status();
+  }
+  return kLiteRtStatusOk;
+}
+
+void LiteRtDestroyExecutionPlan(LiteRtExecutionPlan execution_plan) {
+  delete execution_plan;
+}
+
 LiteRtStatus LiteRtSetCompiledModelCancellationFunction(
     LiteRtCompiledModel compiled_model, void* data,
     bool (*check_cancelled_func)(void*)) {
@@ -188,6 +273,19 @@ LiteRtStatus LiteRtSetCompiledModelCancellationFunction(
   return kLiteRtStatusOk;
 }
 
+LiteRtStatus LiteRtSetCompiledModelRunPriority(
+    LiteRtCompiledModel compiled_model, LiteRtRunPriority priority,
+    int64_t deadline_ms) {
+  LITERT_RETURN_IF_ERROR(compiled_model != nullptr,
+                         kLiteRtStatusErrorInvalidArgument);
+  LITERT_RETURN_IF_ERROR(
+      priority >= kLiteRtRunPriorityNone && priority <= kLiteRtRunPriorityHigh,
+      kLiteRtStatusErrorInvalidArgument);
+  LITERT_RETURN_IF_ERROR(deadline_ms >= 0, kLiteRtStatusErrorInvalidArgument);
+  compiled_model->SetRunPriority(priority, absl::Milliseconds(deadline_ms));
+  return kLiteRtStatusOk;
+}
+
 void LiteRtDestroyCompiledModel(LiteRtCompiledModel compiled_model) {
   delete compiled_model;
 }
@@ -242,6 +340,33 @@ LiteRtStatus LiteRtCompiledModelResizeInputTensor(
   return kLiteRtStatusOk;
 }
 
+LiteRtStatus LiteRtCompiledModelSetInputShapeBuckets(
+    LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index,
+    LiteRtParamIndex input_index, const int* bucket_dims, size_t num_buckets,
+    size_t rank) {
+  LITERT_RETURN_IF_ERROR(compiled_model != nullptr,
+                         kLiteRtStatusErrorInvalidArgument);
+  LITERT_RETURN_IF_ERROR(bucket_dims != nullptr || num_buckets == 0,
+                         kLiteRtStatusErrorInvalidArgument);
+  std::vector<std::vector<int>> buckets;
+  buckets.reserve(num_buckets);
+  for (size_t i = 0; i < num_buckets; ++i) {
+    buckets.emplace_back(bucket_dims + i * rank, bucket_dims + (i + 1) * rank);
+  }
+  LITERT_RETURN_IF_ERROR(compiled_model->SetInputShapeBuckets(
+      signature_index, input_index, std::move(buckets)));
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtCompiledModelReleaseSignatureMemory(
+    LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index) {
+  LITERT_RETURN_IF_ERROR(compiled_model != nullptr,
+                         kLiteRtStatusErrorInvalidArgument);
+  LITERT_RETURN_IF_ERROR(
+      compiled_model->ReleaseSignatureMemory(signature_index));
+  return kLiteRtStatusOk;
+}
+
 LiteRtStatus LiteRtCompiledModelSetDispatchAnnotation(
     LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index,
     const char* key, const char* value) {
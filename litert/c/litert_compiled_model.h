@@ -16,6 +16,7 @@
 #define ODML_LITERT_LITERT_C_LITERT_COMPILED_MODEL_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_layout.h"
@@ -52,6 +53,31 @@ LiteRtStatus LiteRtCreateCompiledModel(LiteRtEnvironment environment,
                                        LiteRtOptions compilation_options,
                                        LiteRtCompiledModel* compiled_model);
 
+// Loads the model file at `filename` to be compiled with `environment`. Unlike
+// LiteRtCreateModelFromFile(), when the environment has a compiler cache
+// directory the flatbuffer is verified before the model is unpacked. The result
+// is recorded in the directory, so that the file is not verified again.
+//
+// Caller owns the returned LiteRtModel. The owner is responsible for calling
+// LiteRtDestroyModel() to release the object.
+LiteRtStatus LiteRtCreateModelFromFileWithEnvironment(
+    LiteRtEnvironment environment, const char* filename, LiteRtModel* model);
+
+// Creates a LiteRtCompiledModel which shares the model of `primary`, i.e. its
+// weights and any dispatch bytecode, as compiled by `primary`, but owns its own
+// interpreter, delegates and activation memory. The shared compiled model can
+// be run concurrently with `primary` and with the other compiled models shared
+// from it. Parameter `compilation_options` selects the accelerators and is
+// owned by the caller.
+//
+// Note: `primary` must outlive the returned object.
+//
+// Caller owns the returned LiteRtCompiledModel. The owner is responsible for
+// calling LiteRtDestroyCompiledModel() to release the object.
+LiteRtStatus LiteRtCreateSharedCompiledModel(
+    LiteRtCompiledModel primary, LiteRtOptions compilation_options,
+    LiteRtCompiledModel* compiled_model);
+
 // Returns the buffer requirements for the given n-th input tensor. The returned
 // LiteRtTensorBufferRequirements is used to create the input tensor
 // buffer.
@@ -164,6 +190,40 @@ LiteRtStatus LiteRtRunCompiledModelAsync(
     size_t num_input_buffers, LiteRtTensorBuffer* input_buffers,
     size_t num_output_buffers, LiteRtTensorBuffer* output_buffers, bool* async);
 
+// Binds the provided input/output LiteRtTensorBuffers to the given signature
+// and returns an execution plan. Running the plan repeatedly with the same
+// bindings skips the per-call signature lookup and buffer registration done by
+// LiteRtRunCompiledModel. The plan keeps a reference to every bound buffer
+// until it is destroyed, and must be destroyed before the compiled model.
+//
+// A nullptr input buffer means the input is bound to an external buffer.
+//
+// Parameters:
+// - compiled_model: the target `LiteRtCompiledModel` object.
+// - signature_index: the index of the signature in `LiteRtModel`.
+// - num_input_buffers: the number of input `LiteRtTensorBuffer`.
+// - input_buffers: the array of input `LiteRtTensorBuffer`.
+// - num_output_buffers: the number of output `LiteRtTensorBuffer`.
+// - output_buffers: the array of output LiteRtTensorBuffer.
+// - execution_plan: the created `LiteRtExecutionPlan`, owned by the caller.
+LiteRtStatus LiteRtCreateCompiledModelExecutionPlan(
+    LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index,
+    size_t num_input_buffers, LiteRtTensorBuffer* input_buffers,
+    size_t num_output_buffers, LiteRtTensorBuffer* output_buffers,
+    LiteRtExecutionPlan* execution_plan);
+
+// Runs the execution plan synchronously.
+LiteRtStatus LiteRtRunExecutionPlan(LiteRtExecutionPlan execution_plan);
+
+// Runs the execution plan asynchronously, if possible. The semantics of
+// parameter `async` are the same as for LiteRtRunCompiledModelAsync.
+LiteRtStatus LiteRtRunExecutionPlanAsync(LiteRtExecutionPlan execution_plan,
+                                         bool* async);
+
+// Destroys an owned LiteRtExecutionPlan object and releases the references to
+// its bound buffers.
+void LiteRtDestroyExecutionPlan(LiteRtExecutionPlan execution_plan);
+
 // Sets a callback function that will be called periodically during model
 // execution to check if the execution should be cancelled.
 //
@@ -180,6 +240,15 @@ LiteRtStatus LiteRtSetCompiledModelCancellationFunction(
     LiteRtCompiledModel compiled_model, void* data,
     bool (*check_cancelled_func)(void*));
 
+// Sets the priority of the next runs of the compiled model on their device,
+// and the time after their start by which they should complete, in
+// milliseconds, or 0 for no deadline. Overrides the values of the runtime
+// options, see LiteRtSetRuntimeOptionsRunPriority(). Must not be called while
+// the compiled model runs.
+LiteRtStatus LiteRtSetCompiledModelRunPriority(
+    LiteRtCompiledModel compiled_model, LiteRtRunPriority priority,
+    int64_t deadline_ms);
+
 // Destroy a owned LiteRtCompiledModel object.
 void LiteRtDestroyCompiledModel(LiteRtCompiledModel compiled_model);
 
@@ -228,6 +297,38 @@ LiteRtStatus LiteRtCompiledModelResizeInputTensor(
     LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index,
     LiteRtParamIndex input_index, const int* dims, size_t dims_size);
 
+// Sets the shapes the specified input tensor can be resized to.
+//
+// Once set, LiteRtCompiledModelResizeInputTensor resizes the input to the
+// smallest bucket whose dimensions are all at least the requested ones, and
+// does nothing if the input already has that shape. A model seeing many input
+// sizes, e.g. audio lengths, is then only planned again for a few shapes. The
+// caller pads its data to the bucket shape, which is reflected in the input
+// buffer requirements.
+//
+// Parameters:
+// - bucket_dims: `num_buckets` shapes of `rank` dimensions each, one after the
+//   other. `rank` must be the rank of the input.
+// - num_buckets: number of shapes. 0 removes the buckets.
+//
+// Returns:
+// - kLiteRtStatusOk: Success.
+// - kLiteRtStatusErrorInvalidArgument: A bucket doesn't match the input
+//   shape signature.
+LiteRtStatus LiteRtCompiledModelSetInputShapeBuckets(
+    LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index,
+    LiteRtParamIndex input_index, const int* bucket_dims, size_t num_buckets,
+    size_t rank);
+
+// Releases the memory holding the intermediate tensors of the given signature,
+// e.g. while the signature is idle. The memory is allocated again the next
+// time the signature runs. Weights and other persistent tensors are kept.
+//
+// See LiteRtSetRuntimeOptionsLazySignatureAllocation() to only allocate the
+// memory of a signature when it first runs.
+LiteRtStatus LiteRtCompiledModelReleaseSignatureMemory(
+    LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index);
+
 // Sets a dispatch annotation on the compiled model. These annotations will be
 // propagated to dispatch graphs when they are created during model execution.
 // The annotations provide runtime hints and metadata that can be used by
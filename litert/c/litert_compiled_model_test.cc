@@ -162,6 +162,108 @@ TEST(CompiledModelTest, Basic) {
   }
 }
 
+TEST(CompiledModelTest, CreateShared) {
+  auto path = testing::GetTestFilePath(kModelFileName);
+
+  LiteRtModel model;
+  LITERT_ASSERT_OK(LiteRtCreateModelFromFile(path.c_str(), &model));
+
+  LiteRtOptions jit_compilation_options;
+  LITERT_ASSERT_OK(LiteRtCreateOptions(&jit_compilation_options));
+  LITERT_ASSERT_OK(LiteRtSetOptionsHardwareAccelerators(
+      jit_compilation_options, kLiteRtHwAcceleratorCpu));
+
+  LiteRtEnvironment environment;
+  LiteRtEnvOption options = {};
+  LITERT_ASSERT_OK(
+      LiteRtCreateEnvironment(/*num_options=*/0, &options, &environment));
+
+  LiteRtCompiledModel compiled_model;
+  LITERT_ASSERT_OK(LiteRtCreateCompiledModel(
+      environment, model, jit_compilation_options, &compiled_model));
+
+  EXPECT_EQ(LiteRtCreateSharedCompiledModel(compiled_model,
+                                            jit_compilation_options, nullptr),
+            kLiteRtStatusErrorInvalidArgument);
+
+  LiteRtCompiledModel shared_compiled_model;
+  LITERT_ASSERT_OK(LiteRtCreateSharedCompiledModel(
+      compiled_model, jit_compilation_options, &shared_compiled_model));
+  ASSERT_NE(shared_compiled_model, compiled_model);
+
+  LiteRtDestroyOptions(jit_compilation_options);
+
+  // The shared compiled model has its own buffers and runs on its own.
+  std::vector<LiteRtTensorBuffer> input_tensor_buffers;
+  for (auto i = 0; i < 2; ++i) {
+    LiteRtTensorBufferRequirements tensor_buffer_requirements;
+    LITERT_ASSERT_OK(LiteRtGetCompiledModelInputBufferRequirements(
+        shared_compiled_model, /*signature_index=*/0, i,
+        &tensor_buffer_requirements));
+    LiteRtTensorBufferType tensor_buffer_type;
+    LITERT_ASSERT_OK(LiteRtGetTensorBufferRequirementsSupportedTensorBufferType(
+        tensor_buffer_requirements, /*type_index=*/0, &tensor_buffer_type));
+    size_t tensor_buffer_size;
+    LITERT_ASSERT_OK(LiteRtGetTensorBufferRequirementsBufferSize(
+        tensor_buffer_requirements, &tensor_buffer_size));
+    LiteRtTensorBuffer tensor_buffer;
+    LITERT_ASSERT_OK(LiteRtCreateManagedTensorBuffer(
+        environment, tensor_buffer_type, &kInput0TensorType, tensor_buffer_size,
+        &tensor_buffer));
+    input_tensor_buffers.push_back(tensor_buffer);
+  }
+
+  LiteRtTensorBufferRequirements output_buffer_requirements;
+  LITERT_ASSERT_OK(LiteRtGetCompiledModelOutputBufferRequirements(
+      shared_compiled_model, /*signature_index=*/0, /*output_index=*/0,
+      &output_buffer_requirements));
+  LiteRtTensorBufferType output_buffer_type;
+  LITERT_ASSERT_OK(LiteRtGetTensorBufferRequirementsSupportedTensorBufferType(
+      output_buffer_requirements, /*type_index=*/0, &output_buffer_type));
+  size_t output_buffer_size;
+  LITERT_ASSERT_OK(LiteRtGetTensorBufferRequirementsBufferSize(
+      output_buffer_requirements, &output_buffer_size));
+  LiteRtTensorBuffer output_tensor_buffer;
+  LITERT_ASSERT_OK(LiteRtCreateManagedTensorBuffer(
+      environment, output_buffer_type, &kInput0TensorType, output_buffer_size,
+      &output_tensor_buffer));
+
+  void* host_mem_addr;
+  LITERT_ASSERT_OK(LiteRtLockTensorBuffer(input_tensor_buffers[0],
+                                          &host_mem_addr,
+                                          kLiteRtTensorBufferLockModeWrite));
+  std::memcpy(host_mem_addr, kTestInput0Tensor, sizeof(kTestInput0Tensor));
+  LITERT_ASSERT_OK(LiteRtUnlockTensorBuffer(input_tensor_buffers[0]));
+  LITERT_ASSERT_OK(LiteRtLockTensorBuffer(input_tensor_buffers[1],
+                                          &host_mem_addr,
+                                          kLiteRtTensorBufferLockModeWrite));
+  std::memcpy(host_mem_addr, kTestInput1Tensor, sizeof(kTestInput1Tensor));
+  LITERT_ASSERT_OK(LiteRtUnlockTensorBuffer(input_tensor_buffers[1]));
+
+  LITERT_ASSERT_OK(LiteRtRunCompiledModel(
+      shared_compiled_model, /*signature_index=*/0, input_tensor_buffers.size(),
+      input_tensor_buffers.data(), /*num_output_buffers=*/1,
+      &output_tensor_buffer));
+
+  LITERT_ASSERT_OK(LiteRtLockTensorBuffer(
+      output_tensor_buffer, &host_mem_addr, kLiteRtTensorBufferLockModeRead));
+  auto output = absl::MakeSpan(static_cast<const float*>(host_mem_addr),
+                               kTestOutputSize);
+  EXPECT_THAT(output, Pointwise(FloatNear(1e-3), kTestOutputTensor));
+  LITERT_ASSERT_OK(LiteRtUnlockTensorBuffer(output_tensor_buffer));
+
+  // Cleanup
+  LiteRtDestroyCompiledModel(shared_compiled_model);
+  LiteRtDestroyCompiledModel(compiled_model);
+  LiteRtDestroyModel(model);
+  LiteRtDestroyEnvironment(environment);
+
+  for (auto tensor_buffer : input_tensor_buffers) {
+    LiteRtDestroyTensorBuffer(tensor_buffer);
+  }
+  LiteRtDestroyTensorBuffer(output_tensor_buffer);
+}
+
 TEST(CompiledModelTest, ResizeInputTensorWithDynamicModel) {
   // Use the dynamic model for testing resize functionality
   auto path = testing::GetTestFilePath(kDynamicModelFileName);
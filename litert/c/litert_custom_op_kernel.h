@@ -34,10 +34,23 @@ typedef struct {
                                    const LiteRtLayout* input_layouts,
                                    size_t num_outputs,
                                    LiteRtLayout* output_layouts);
+  // Runs the op synchronously. Locking the input buffers waits for their
+  // events.
   LiteRtStatus (*Run)(void* user_data, size_t num_inputs,
                       const LiteRtTensorBuffer* inputs, size_t num_outputs,
                       LiteRtTensorBuffer* outputs);
   LiteRtStatus (*Destroy)(void* user_data);
+  // Optional, used instead of Run() when not NULL. Runs the op on the tensor
+  // buffers in their native buffer type (e.g. OpenCL or AHWB buffers bound by
+  // the application or by other accelerators) without waiting on them: the
+  // input buffers may have events (LiteRtHasTensorBufferEvent()) that the op
+  // must wait on, for instance by enqueuing the wait on its own GPU queue, and
+  // the op may set an event on its outputs (LiteRtSetTensorBufferEvent())
+  // instead of waiting for its own completion. The runtime waits for the
+  // output events the next ops can't wait on.
+  LiteRtStatus (*RunAsync)(void* user_data, size_t num_inputs,
+                           const LiteRtTensorBuffer* inputs,
+                           size_t num_outputs, LiteRtTensorBuffer* outputs);
   // NOLINTEND(*-readability-class-member-naming)
 } LiteRtCustomOpKernel;
 
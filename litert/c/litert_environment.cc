@@ -15,12 +15,14 @@
 #include "litert/c/litert_environment.h"
 
 #include <algorithm>
-#include <array>
 #include <utility>
 
+#include "absl/time/clock.h"  // from @com_google_absl
+#include "absl/time/time.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_environment_options.h"
+#include "litert/c/litert_telemetry.h"
 #include "litert/cc/litert_macros.h"
 #include "litert/core/environment.h"
 #include "litert/runtime/accelerators/auto_registration.h"
@@ -41,27 +43,29 @@ LiteRtStatus LiteRtCreateEnvironment(int num_options,
   auto options_span = absl::MakeSpan(options, num_options);
   LITERT_ASSIGN_OR_RETURN(auto env,
                           LiteRtEnvironmentT::CreateWithOptions(options_span));
+  const absl::Time registration_start = absl::Now();
   litert::TriggerAcceleratorAutomaticRegistration(*env);
+  env->SetAcceleratorRegistrationTime(absl::Now() - registration_start);
 
-  // Check if any GPU-related options are present using modern C++ algorithms
-  constexpr std::array<LiteRtEnvOptionTag, 7> kGpuOptionTags = {
-      kLiteRtEnvOptionTagOpenClDeviceId, kLiteRtEnvOptionTagOpenClPlatformId,
-      kLiteRtEnvOptionTagOpenClContext,  kLiteRtEnvOptionTagOpenClCommandQueue,
-      kLiteRtEnvOptionTagEglContext,     kLiteRtEnvOptionTagEglDisplay,
-      kLiteRtEnvOptionTagMetalDevice};
-
-  const bool has_gpu_options = std::any_of(
-      options_span.begin(), options_span.end(),
-      [&kGpuOptionTags](const LiteRtEnvOption& option) {
-        return std::find(kGpuOptionTags.begin(), kGpuOptionTags.end(),
-                         option.tag) != kGpuOptionTags.end();
-      });
-
-  if (has_gpu_options) {
-    LITERT_ASSIGN_OR_RETURN(
-        auto gpu_env, litert::internal::GpuEnvironment::Create(env.get()));
-    LITERT_RETURN_IF_ERROR(env->SetGpuEnvironment(std::move(gpu_env)));
+#if !defined(LITERT_DISABLE_GPU)
+  // The GPU environment is created from the GPU options, including the
+  // contexts and queues shared by the application, the first time it is
+  // needed.
+  env->SetGpuEnvironmentFactory(&litert::internal::GpuEnvironment::Create);
+
+  // A CL context shared with a GL context is only checked against the EGL
+  // context current on the thread creating the environment.
+  const auto has_option = [&options_span](LiteRtEnvOptionTag tag) {
+    return std::any_of(options_span.begin(), options_span.end(),
+                       [tag](const LiteRtEnvOption& option) {
+                         return option.tag == tag;
+                       });
+  };
+  if (has_option(kLiteRtEnvOptionTagOpenClContext) &&
+      has_option(kLiteRtEnvOptionTagEglContext)) {
+    LITERT_RETURN_IF_ERROR(env->GetGpuEnvironment());
   }
+#endif  // !defined(LITERT_DISABLE_GPU)
 
   *environment = env.release();
   return kLiteRtStatusOk;
@@ -113,6 +117,14 @@ LiteRtStatus LiteRtGpuEnvironmentCreate(LiteRtEnvironment environment,
                                         const LiteRtEnvOption* options) {
   LITERT_RETURN_IF_ERROR(
       environment->AddOptions(absl::MakeSpan(options, num_options)));
+  if (environment->HasGpuEnvironment()) {
+    // The GPU environment was already created when it was first needed.
+    LITERT_ASSIGN_OR_RETURN(litert::internal::GpuEnvironment * gpu_env,
+                            environment->GetGpuEnvironment());
+    LITERT_RETURN_IF_ERROR(gpu_env->AddEnvironmentOptions(
+        absl::MakeSpan(options, num_options)));
+    return kLiteRtStatusOk;
+  }
   LITERT_ASSIGN_OR_RETURN(
       auto gpu_env, litert::internal::GpuEnvironment::Create(environment));
   LITERT_RETURN_IF_ERROR(environment->SetGpuEnvironment(std::move(gpu_env)));
@@ -152,6 +164,44 @@ void LiteRtEnvironmentHasGpuEnvironment(LiteRtEnvironment environment,
   *has_gpu_environment = environment->HasGpuEnvironment();
 }
 
+LiteRtStatus LiteRtSetEnvironmentTelemetrySink(LiteRtEnvironment environment,
+                                               LiteRtTelemetrySink sink,
+                                               void* user_data) {
+  LITERT_RETURN_IF_ERROR(environment != nullptr)
+      << "Environment pointer is null.";
+  environment->SetTelemetrySink(sink, user_data);
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetEnvironmentRunQueueStats(LiteRtEnvironment environment,
+                                               LiteRtHwAccelerators device,
+                                               LiteRtRunQueueStats* stats) {
+  LITERT_RETURN_IF_ERROR(environment != nullptr)
+      << "Environment pointer is null.";
+  LITERT_RETURN_IF_ERROR(stats != nullptr) << "Stats pointer is null.";
+  const auto device_stats =
+      environment->GetRunScheduler().GetDeviceStats(device);
+  stats->queue_depth = device_stats.queue_depth;
+  stats->num_preemptions = device_stats.num_preemptions;
+  stats->num_missed_deadlines = device_stats.num_missed_deadlines;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtEnvironmentTrimMemory(LiteRtEnvironment environment,
+                                         LiteRtTrimMemoryLevel level,
+                                         size_t* num_freed_bytes) {
+  LITERT_RETURN_IF_ERROR(environment != nullptr)
+      << "Environment pointer is null.";
+  LITERT_RETURN_IF_ERROR(level == kLiteRtTrimMemoryLevelModerate ||
+                         level == kLiteRtTrimMemoryLevelCritical)
+      << "Invalid trim memory level.";
+  const size_t freed = environment->TrimMemory(level);
+  if (num_freed_bytes != nullptr) {
+    *num_freed_bytes = freed;
+  }
+  return kLiteRtStatusOk;
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -15,8 +15,12 @@
 #ifndef ODML_LITERT_LITERT_C_LITERT_ENVIRONMENT_H_
 #define ODML_LITERT_LITERT_C_LITERT_ENVIRONMENT_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_environment_options.h"
+#include "litert/c/litert_telemetry.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -51,7 +55,13 @@ LiteRtStatus LiteRtAddEnvironmentOptions(LiteRtEnvironment environment,
 // Create a LiteRT GPU environment with options.
 // The given `environment` takes ownership of the created GPU environment.
 // This API is usually called by the GPU accelerator implementation to set GPU
-// environment options which affect the entire LiteRT runtime.
+// environment options which affect the entire LiteRT runtime. If the GPU
+// environment was already created, the options are added to it.
+//
+// Otherwise, the GPU environment is created the first time a GPU buffer, event
+// or model needs it, from the GPU options of the environment. The OpenCL,
+// EGL, WebGPU, Metal or Vulkan objects set in these options are shared with
+// the application instead of creating new ones.
 //
 // Note: In most cases, users should not call this API directly.
 LiteRtStatus LiteRtGpuEnvironmentCreate(LiteRtEnvironment environment,
@@ -70,10 +80,56 @@ LiteRtStatus LiteRtEnvironmentSupportsAhwbClInterop(
 LiteRtStatus LiteRtEnvironmentSupportsAhwbGlInterop(
     LiteRtEnvironment environment, bool* is_supported);
 
-// Returns whether the environment has a GPU environment.
+// Returns whether the environment has created its GPU environment.
 void LiteRtEnvironmentHasGpuEnvironment(LiteRtEnvironment environment,
                                         bool* has_gpu_environment);
 
+// Sets the sink that the compiled models of the environment report each of
+// their runs to, with `user_data`, or clears it if `sink` is null. The runs
+// are only measured while a sink is set. See LiteRtRunTelemetry.
+LiteRtStatus LiteRtSetEnvironmentTelemetrySink(LiteRtEnvironment environment,
+                                               LiteRtTelemetrySink sink,
+                                               void* user_data);
+
+// The runs with a priority on a device of an environment, see
+// LiteRtSetRuntimeOptionsRunPriority().
+typedef struct LiteRtRunQueueStats {
+  // The number of runs waiting for or using the device.
+  size_t queue_depth;
+  // The number of times a run yielded the device to a run of higher priority.
+  uint64_t num_preemptions;
+  // The number of runs that completed after their deadline.
+  uint64_t num_missed_deadlines;
+} LiteRtRunQueueStats;
+
+// Gets the statistics of the runs with a priority on `device`, one of
+// kLiteRtHwAcceleratorCpu, kLiteRtHwAcceleratorGpu or kLiteRtHwAcceleratorNpu.
+LiteRtStatus LiteRtGetEnvironmentRunQueueStats(LiteRtEnvironment environment,
+                                               LiteRtHwAccelerators device,
+                                               LiteRtRunQueueStats* stats);
+
+// How much memory LiteRtEnvironmentTrimMemory() releases. On Android,
+// TRIM_MEMORY_RUNNING_LOW and TRIM_MEMORY_UI_HIDDEN map to the moderate level,
+// TRIM_MEMORY_RUNNING_CRITICAL and TRIM_MEMORY_COMPLETE to the critical one.
+typedef enum LiteRtTrimMemoryLevel {
+  // Frees the tensor buffers kept in the pool of the environment.
+  kLiteRtTrimMemoryLevelModerate = 1,
+  // Also releases the memory holding the intermediate tensors of the idle
+  // compiled models of the environment, as
+  // LiteRtCompiledModelReleaseSignatureMemory() does. It is allocated again the
+  // next time the signatures run.
+  kLiteRtTrimMemoryLevelCritical = 2,
+} LiteRtTrimMemoryLevel;
+
+// Releases the memory of the environment and its compiled models that can be
+// allocated again on demand, e.g. in response to system memory pressure. Can be
+// called from any thread, also while compiled models run, in which case their
+// memory is kept. Writes the number of bytes freed to `num_freed_bytes`, if not
+// null.
+LiteRtStatus LiteRtEnvironmentTrimMemory(LiteRtEnvironment environment,
+                                         LiteRtTrimMemoryLevel level,
+                                         size_t* num_freed_bytes);
+
 #ifdef __cplusplus
 }
 #endif  // __cplusplus
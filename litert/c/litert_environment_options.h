@@ -51,6 +51,17 @@ typedef enum {
   // Dawn procedure table pointer for shared libraries to populate their tables
   // with the shared procedures instead of their own procedures.
   kLiteRtEnvOptionTagWebGpuProcs = 20,
+  // Byte budget of the compilation cache in the compiler cache dir. The least
+  // recently used models are evicted to stay under the budget.
+  kLiteRtEnvOptionTagCompilerCacheMaxSize = 21,
+  // Byte budget of the pool recycling the managed tensor buffers destroyed by
+  // the user. 0, the default, disables the pool. When it is enabled, the tensor
+  // buffers must be destroyed before the environment.
+  kLiteRtEnvOptionTagTensorBufferPoolMaxSize = 22,
+  // Pointer to a `tflite::TfLiteCpuThreadPool` running the parallel tasks of
+  // the CPU kernels of all the compiled models, instead of each model creating
+  // its own threads. It must outlive the compiled models.
+  kLiteRtEnvOptionTagCpuThreadPool = 23,
 } LiteRtEnvOptionTag;
 
 typedef struct {
@@ -140,6 +140,12 @@ LiteRtStatus LiteRtSignalEvent(LiteRtEvent event) {
   return kLiteRtStatusOk;
 }
 
+LiteRtStatus LiteRtSignalEventWithStatus(LiteRtEvent event,
+                                         LiteRtStatus status) {
+  LITERT_RETURN_IF_ERROR(event->Signal(status));
+  return kLiteRtStatusOk;
+}
+
 LiteRtStatus LiteRtIsEventSignaled(LiteRtEvent event, bool* is_signaled) {
   LITERT_ASSIGN_OR_RETURN(auto is_signaled_res, event->IsSignaled());
   *is_signaled = is_signaled_res;
@@ -77,6 +77,12 @@ LiteRtStatus LiteRtWaitEvent(LiteRtEvent event, int64_t timeout_in_ms);
 // Signal the event to notify the waiters.
 LiteRtStatus LiteRtSignalEvent(LiteRtEvent event);
 
+// Signal the event with the `status` of the operation it tracks, so that
+// waiting on it returns `status`. Only host events can be signaled with an
+// error.
+LiteRtStatus LiteRtSignalEventWithStatus(LiteRtEvent event,
+                                         LiteRtStatus status);
+
 // Return true if the event is signaled.
 LiteRtStatus LiteRtIsEventSignaled(LiteRtEvent event, bool* is_signaled);
 
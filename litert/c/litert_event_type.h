@@ -25,6 +25,8 @@ typedef enum {
   LiteRtEventTypeOpenCl = 2,
   LiteRtEventTypeEglSyncFence = 3,
   LiteRtEventTypeEglNativeSyncFence = 4,
+  // An event signaled by a host thread, e.g. by an asynchronous CPU execution.
+  LiteRtEventTypeHost = 5,
 } LiteRtEventType;
 
 #ifdef __cplusplus
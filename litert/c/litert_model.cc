@@ -55,6 +55,20 @@ LiteRtStatus LiteRtCreateModelFromFile(const char* filename,
   return kLiteRtStatusOk;
 }
 
+LiteRtStatus LiteRtCreateModelFromFileDescriptor(int fd, size_t offset,
+                                                 size_t length,
+                                                 LiteRtModel* model) {
+  if (fd < 0 || !length || !model) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+
+  LITERT_ASSIGN_OR_RETURN(
+      LiteRtModelT::Ptr new_model,
+      litert::internal::LoadModelFromFileDescriptor(fd, offset, length));
+  *model = new_model.release();
+  return kLiteRtStatusOk;
+}
+
 LiteRtStatus LiteRtCreateModelFromBuffer(const void* buffer_addr,
                                          size_t buffer_size,
                                          LiteRtModel* model) {
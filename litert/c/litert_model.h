@@ -213,6 +213,13 @@ LiteRtStatus LiteRtGetSignatureOutputTensorByIndex(LiteRtSignature signature,
 
 LiteRtStatus LiteRtCreateModelFromFile(const char* filename,
                                        LiteRtModel* model);
+// Creates a model from `length` bytes of the file `fd` starting at `offset`,
+// e.g. an uncompressed entry of an APK or another archive. The model is mapped
+// read-only without being copied. `fd` is duplicated and can be closed once
+// this returns.
+LiteRtStatus LiteRtCreateModelFromFileDescriptor(int fd, size_t offset,
+                                                 size_t length,
+                                                 LiteRtModel* model);
 // The caller must ensure that the buffer remains valid for the lifetime of
 // the model.
 LiteRtStatus LiteRtCreateModelFromBuffer(const void* buffer_addr,
@@ -69,6 +69,21 @@ LiteRtStatus LiteRtGetOptionsHardwareAccelerators(
   return kLiteRtStatusOk;
 }
 
+LiteRtStatus LiteRtSetOptionsAutoHardwareAccelerators(LiteRtOptions options,
+                                                      bool enabled) {
+  LRT_CHECK_NON_NULL(options);
+  options->auto_hardware_accelerators = enabled;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetOptionsAutoHardwareAccelerators(LiteRtOptions options,
+                                                      bool* enabled) {
+  LRT_CHECK_NON_NULL(options);
+  LRT_CHECK_NON_NULL(enabled);
+  *enabled = options->auto_hardware_accelerators;
+  return kLiteRtStatusOk;
+}
+
 LiteRtStatus LiteRtAddOpaqueOptions(LiteRtOptions options,
                                     LiteRtOpaqueOptions opaque_options) {
   LRT_CHECK_NON_NULL(options);
@@ -36,6 +36,25 @@ LiteRtStatus LiteRtSetOptionsHardwareAccelerators(
 LiteRtStatus LiteRtGetOptionsHardwareAccelerators(
     LiteRtOptions options, LiteRtHwAcceleratorSet* hardware_accelerators);
 
+// Sets whether the compiled model selects its hardware accelerators itself.
+//
+// The first compiled model of a model on a device starts benchmarking the
+// model on the accelerators in the background, and runs on the accelerators
+// set with `LiteRtSetOptionsHardwareAccelerators`, or on the CPU if none are.
+// The next ones run on the fastest accelerators found, which are stored in the
+// compiler cache directory of the environment for the model, the device and
+// its drivers.
+//
+// Note: The benchmark requires the compiler cache directory environment option
+// and a model loaded from a file, and runs only if the TFLite mini-benchmark
+// implementation is linked in.
+LiteRtStatus LiteRtSetOptionsAutoHardwareAccelerators(LiteRtOptions options,
+                                                      bool enabled);
+
+// Gets whether the compiled model selects its hardware accelerators itself.
+LiteRtStatus LiteRtGetOptionsAutoHardwareAccelerators(LiteRtOptions options,
+                                                      bool* enabled);
+
 // Adds compilation options for a specific accelerator to the accelerator
 // compilation option list.
 //
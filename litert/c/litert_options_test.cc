@@ -82,6 +82,29 @@ TEST(LiteRtCompiledModelOptionsTest, SetAndGetHardwareAcceleratorsWorks) {
   LiteRtDestroyOptions(options);
 }
 
+TEST(LiteRtCompiledModelOptionsTest, SetAndGetAutoHardwareAcceleratorsWorks) {
+  LiteRtOptions options;
+  ASSERT_EQ(LiteRtCreateOptions(&options), kLiteRtStatusOk);
+
+  bool enabled = true;
+  EXPECT_EQ(LiteRtGetOptionsAutoHardwareAccelerators(options, &enabled),
+            kLiteRtStatusOk);
+  EXPECT_FALSE(enabled);
+
+  EXPECT_EQ(LiteRtSetOptionsAutoHardwareAccelerators(options, true),
+            kLiteRtStatusOk);
+  EXPECT_EQ(LiteRtGetOptionsAutoHardwareAccelerators(options, &enabled),
+            kLiteRtStatusOk);
+  EXPECT_TRUE(enabled);
+
+  EXPECT_EQ(LiteRtSetOptionsAutoHardwareAccelerators(nullptr, true),
+            kLiteRtStatusErrorInvalidArgument);
+  EXPECT_EQ(LiteRtGetOptionsAutoHardwareAccelerators(options, nullptr),
+            kLiteRtStatusErrorInvalidArgument);
+
+  LiteRtDestroyOptions(options);
+}
+
 struct DummyAcceleratorCompilationOptions {
   static constexpr const char* const kIdentifier = "dummy-accelerator";
 
@@ -14,6 +14,8 @@
 
 #include "litert/c/litert_profiler.h"
 
+#include <cstdint>
+
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_profiler_event.h"
 #include "litert/cc/litert_macros.h"
@@ -97,4 +99,62 @@ LiteRtStatus LiteRtGetProfilerEvents(LiteRtProfiler profiler, int num_events,
   }
   return kLiteRtStatusOk;
 }
+
+LiteRtStatus LiteRtSetProfilerSampling(LiteRtProfiler profiler,
+                                       int sample_every_n_runs,
+                                       uint64_t latency_threshold_us) {
+  LITERT_RETURN_IF_ERROR(profiler,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "profiler is null.";
+  LITERT_RETURN_IF_ERROR(sample_every_n_runs >= 0,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "sample_every_n_runs is negative.";
+  profiler->SetSampling(sample_every_n_runs, latency_threshold_us);
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetProfilerRunStats(LiteRtProfiler profiler,
+                                       LiteRtProfilerRunStats* run_stats) {
+  LITERT_RETURN_IF_ERROR(profiler,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "profiler is null.";
+  LITERT_RETURN_IF_ERROR(run_stats,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "run_stats is null.";
+  *run_stats = profiler->GetRunStats();
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetNumProfilerOpStats(LiteRtProfiler profiler,
+                                         int* num_op_stats) {
+  LITERT_RETURN_IF_ERROR(profiler,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "profiler is null.";
+  LITERT_RETURN_IF_ERROR(num_op_stats,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "num_op_stats is null.";
+  *num_op_stats = profiler->GetOpStats().size();
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetProfilerOpStats(LiteRtProfiler profiler,
+                                      int num_op_stats,
+                                      LiteRtProfilerOpStats* op_stats) {
+  LITERT_RETURN_IF_ERROR(profiler,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "profiler is null.";
+  LITERT_RETURN_IF_ERROR(op_stats,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "op_stats is null.";
+  const auto internal_op_stats = profiler->GetOpStats();
+  LITERT_RETURN_IF_ERROR(num_op_stats >= 0 &&
+                             num_op_stats >= internal_op_stats.size(),
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "the size: " << num_op_stats
+      << " is not enough to hold all op stats: " << internal_op_stats.size();
+  for (int i = 0; i < internal_op_stats.size(); ++i) {
+    op_stats[i] = internal_op_stats[i];
+  }
+  return kLiteRtStatusOk;
+}
 }  // extern "C"
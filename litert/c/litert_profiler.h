@@ -15,6 +15,8 @@
 #ifndef THIRD_PARTY_ODML_LITERT_LITERT_C_LITERT_PROFILER_H_
 #define THIRD_PARTY_ODML_LITERT_LITERT_C_LITERT_PROFILER_H_
 
+#include <stdint.h>
+
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_profiler_event.h"
 
@@ -51,6 +53,32 @@ LiteRtStatus LiteRtGetNumProfilerEvents(LiteRtProfiler profiler,
 LiteRtStatus LiteRtGetProfilerEvents(LiteRtProfiler profiler, int num_events,
                                      ProfiledEventData* events);
 
+// Switches the profiler to the sampling mode, meant to stay on in production,
+// if `sample_every_n_runs` or `latency_threshold_us` is positive. Every run is
+// timed, but only the ops of 1 in `sample_every_n_runs` runs and of the runs
+// that take at least `latency_threshold_us` are profiled, and only their
+// latency histograms are kept instead of the events. Setting both to 0
+// switches back to recording all the events. Clears all previously collected
+// profiling data.
+LiteRtStatus LiteRtSetProfilerSampling(LiteRtProfiler profiler,
+                                       int sample_every_n_runs,
+                                       uint64_t latency_threshold_us);
+
+// Gets the latencies of the runs seen in the sampling mode.
+LiteRtStatus LiteRtGetProfilerRunStats(LiteRtProfiler profiler,
+                                       LiteRtProfilerRunStats* run_stats);
+
+// Gets the number of ops profiled in the sampling mode.
+LiteRtStatus LiteRtGetNumProfilerOpStats(LiteRtProfiler profiler,
+                                         int* num_op_stats);
+
+// Gets the latencies of the ops profiled in the sampling mode. The stats are
+// copied to the provided buffer, caller is responsible to allocate the buffer
+// and provide the size of the buffer (num_op_stats).
+LiteRtStatus LiteRtGetProfilerOpStats(LiteRtProfiler profiler,
+                                      int num_op_stats,
+                                      LiteRtProfilerOpStats* op_stats);
+
 #ifdef __cplusplus
 }
 #endif  // __cplusplus
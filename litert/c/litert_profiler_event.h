@@ -29,6 +29,8 @@ enum class ProfiledEventSource {
   LITERT,
   TFLITE_INTERPRETER,
   TFLITE_DELEGATE,
+  // The kernels of the GPU, timed on the device.
+  GPU,
 };
 
 struct ProfiledEventData {
@@ -103,6 +105,8 @@ typedef enum ProfiledEventSource {
   LITERT,
   TFLITE_INTERPRETER,
   TFLITE_DELEGATE,
+  // The kernels of the GPU, timed on the device.
+  GPU,
 } ProfiledEventSource;
 
 // The C version of the struct uses only pure C types.
@@ -122,4 +126,44 @@ typedef struct ProfiledEventData {
 
 #endif  // __cplusplus
 
+// =========================================================================
+//  Common to C and C++
+// =========================================================================
+
+// The number of buckets of the latency histograms of the sampling profiler.
+#define LITERT_PROFILER_NUM_LATENCY_BUCKETS 24
+
+// The latencies aggregated by the sampling profiler. Bucket 0 counts the
+// latencies under 1 us, and bucket i > 0 the latencies in [2^(i-1), 2^i) us.
+// The last bucket also counts all the longer latencies.
+typedef struct LiteRtProfilerLatencyStats {
+  uint64_t count;
+  uint64_t total_time_us;
+  uint64_t min_time_us;
+  uint64_t max_time_us;
+  uint64_t buckets[LITERT_PROFILER_NUM_LATENCY_BUCKETS];
+} LiteRtProfilerLatencyStats;
+
+// The latencies of the runs of a model seen by the sampling profiler.
+typedef struct LiteRtProfilerRunStats {
+  // The latencies of all the runs.
+  LiteRtProfilerLatencyStats latency;
+  // The number of runs whose ops were profiled, because they were sampled or
+  // over the latency threshold.
+  uint64_t num_profiled_runs;
+  // The number of runs over the latency threshold.
+  uint64_t num_slow_runs;
+} LiteRtProfilerRunStats;
+
+// The latencies of one op over the profiled runs.
+typedef struct LiteRtProfilerOpStats {
+  const char* tag;  // The tag of the op events, owned by the profiler.
+  ProfiledEventSource event_source;
+  // The metadata of the op events, e.g. the node and the subgraph index of
+  // OPERATOR_INVOKE_EVENT.
+  uint64_t event_metadata1;
+  uint64_t event_metadata2;
+  LiteRtProfilerLatencyStats latency;
+} LiteRtProfilerOpStats;
+
 #endif  // THIRD_PARTY_ODML_LITERT_LITERT_C_LITERT_PROFILER_EVENT_H_
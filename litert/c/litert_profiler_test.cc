@@ -117,4 +117,43 @@ TEST(LiteRtProfilerTest, PassNullToOutputPointers) {
             kLiteRtStatusOk);
   LiteRtDestroyProfiler(profiler);
 }
+
+TEST(LiteRtProfilerTest, SamplingStatsWhenEmpty) {
+  EXPECT_EQ(LiteRtCreateProfiler(10, &profiler), kLiteRtStatusOk);
+  EXPECT_EQ(LiteRtSetProfilerSampling(profiler, /*sample_every_n_runs=*/100,
+                                      /*latency_threshold_us=*/50000),
+            kLiteRtStatusOk);
+  EXPECT_EQ(LiteRtStartProfiler(profiler), kLiteRtStatusOk);
+
+  LiteRtProfilerRunStats run_stats;
+  EXPECT_EQ(LiteRtGetProfilerRunStats(profiler, &run_stats), kLiteRtStatusOk);
+  EXPECT_EQ(run_stats.latency.count, 0);
+  EXPECT_EQ(run_stats.num_profiled_runs, 0);
+  int num_op_stats = -1;
+  EXPECT_EQ(LiteRtGetNumProfilerOpStats(profiler, &num_op_stats),
+            kLiteRtStatusOk);
+  EXPECT_EQ(num_op_stats, 0);
+  LiteRtProfilerOpStats op_stats[1];
+  EXPECT_EQ(LiteRtGetProfilerOpStats(profiler, 1, op_stats), kLiteRtStatusOk);
+  LiteRtDestroyProfiler(profiler);
+}
+
+TEST(LiteRtProfilerErrorTest, SamplingWithInvalidArguments) {
+  EXPECT_EQ(LiteRtCreateProfiler(10, &profiler), kLiteRtStatusOk);
+  LiteRtProfilerRunStats run_stats;
+  LiteRtProfilerOpStats op_stats[1];
+  int num_op_stats = 0;
+
+  EXPECT_NE(LiteRtSetProfilerSampling(nullptr, 1, 0), kLiteRtStatusOk);
+  EXPECT_NE(LiteRtSetProfilerSampling(profiler, -1, 0), kLiteRtStatusOk);
+  EXPECT_NE(LiteRtGetProfilerRunStats(nullptr, &run_stats), kLiteRtStatusOk);
+  EXPECT_NE(LiteRtGetProfilerRunStats(profiler, nullptr), kLiteRtStatusOk);
+  EXPECT_NE(LiteRtGetNumProfilerOpStats(nullptr, &num_op_stats),
+            kLiteRtStatusOk);
+  EXPECT_NE(LiteRtGetNumProfilerOpStats(profiler, nullptr), kLiteRtStatusOk);
+  EXPECT_NE(LiteRtGetProfilerOpStats(nullptr, 1, op_stats), kLiteRtStatusOk);
+  EXPECT_NE(LiteRtGetProfilerOpStats(profiler, 1, nullptr), kLiteRtStatusOk);
+  EXPECT_NE(LiteRtGetProfilerOpStats(profiler, -1, op_stats), kLiteRtStatusOk);
+  LiteRtDestroyProfiler(profiler);
+}
 }  // namespace
@@ -0,0 +1,64 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_C_LITERT_TELEMETRY_H_
+#define ODML_LITERT_LITERT_C_LITERT_TELEMETRY_H_
+
+#include <stdbool.h>  // NOLINT: To use bool type in C
+#include <stdint.h>
+
+#include "litert/c/litert_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+// The record of one run of a compiled model, reported to the telemetry sink
+// of its environment once the run completed.
+typedef struct LiteRtRunTelemetry {
+  // The key of the signature that ran. Only valid during the callback.
+  const char* signature_key;
+  // The accelerators the compiled model runs on.
+  LiteRtHwAcceleratorSet accelerators;
+  // The status of the run.
+  LiteRtStatus status;
+  // True if the run was asynchronous, i.e. completed after the run call
+  // returned or left events on its outputs.
+  bool async;
+  // Microseconds from the run call to the start of the invocation: waiting
+  // for the previous asynchronous run and the inputs, and binding the
+  // buffers.
+  uint64_t queue_time_us;
+  // Microseconds of the invocation of the model.
+  uint64_t run_time_us;
+  // Microseconds waiting for the events of the outputs after the invocation.
+  uint64_t sync_time_us;
+  int32_t num_inputs;
+  int32_t num_outputs;
+  // The types of the input and output buffers, as a bit set of
+  // `1 << LiteRtTensorBufferType`.
+  uint64_t input_buffer_types;
+  uint64_t output_buffer_types;
+} LiteRtRunTelemetry;
+
+// Called on the thread that completes the run. It must not block, and should
+// copy the record out and return, since it delays the run.
+typedef void (*LiteRtTelemetrySink)(void* user_data,
+                                    const LiteRtRunTelemetry* record);
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+#endif  // ODML_LITERT_LITERT_C_LITERT_TELEMETRY_H_
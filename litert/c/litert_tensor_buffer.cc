@@ -353,6 +353,23 @@ LiteRtStatus LiteRtGetTensorBufferWebGpuBuffer(
 #endif  // LITERT_HAS_WEBGPU_SUPPORT
 
 #if LITERT_HAS_VULKAN_SUPPORT
+LiteRtStatus LiteRtCreateTensorBufferFromVulkanMemory(
+    LiteRtEnvironment env, const LiteRtRankedTensorType* tensor_type,
+    LiteRtTensorBufferType buffer_type, HwMemoryHandle vulkan_memory,
+    size_t vulkan_memory_size, LiteRtVulkanMemoryDeallocator deallocator,
+    LiteRtTensorBuffer* tensor_buffer) {
+  if (!tensor_type || !tensor_buffer || !vulkan_memory) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  LITERT_ASSIGN_OR_RETURN(
+      auto created_tensor_buffer,
+      LiteRtTensorBufferT::CreateFromVulkanMemory(
+          env, *tensor_type, buffer_type, vulkan_memory, vulkan_memory_size,
+          deallocator));
+  *tensor_buffer = created_tensor_buffer.release();
+  return kLiteRtStatusOk;
+}
+
 LiteRtStatus LiteRtGetTensorBufferVulkanMemory(
     LiteRtTensorBuffer tensor_buffer, HwMemoryHandle* hw_memory_handle) {
   if (!tensor_buffer || !hw_memory_handle) {
@@ -480,6 +497,8 @@ LiteRtStatus LiteRtGetTensorBufferHostMemory(LiteRtTensorBuffer tensor_buffer,
   }
 
   LITERT_ASSIGN_OR_RETURN(auto host_buffer, tensor_buffer->GetHostBuffer());
+  // The caller may write through the returned address without locking.
+  tensor_buffer->MarkContentModified();
   *host_memory_addr = host_buffer;
   return kLiteRtStatusOk;
 }
@@ -533,6 +552,21 @@ LiteRtStatus LiteRtLockTensorBuffer(LiteRtTensorBuffer tensor_buffer,
   return kLiteRtStatusOk;
 }
 
+LiteRtStatus LiteRtLockTensorBufferRange(LiteRtTensorBuffer tensor_buffer,
+                                         size_t offset, size_t size,
+                                         void** host_mem_addr,
+                                         LiteRtTensorBufferLockMode mode) {
+  if (!tensor_buffer || !host_mem_addr) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+
+  LITERT_ASSIGN_OR_RETURN(auto mapped_addr,
+                          tensor_buffer->Lock(mode, offset, size));
+
+  *host_mem_addr = mapped_addr;
+  return kLiteRtStatusOk;
+}
+
 LiteRtStatus LiteRtUnlockTensorBuffer(LiteRtTensorBuffer tensor_buffer) {
   if (!tensor_buffer) {
     return kLiteRtStatusErrorInvalidArgument;
@@ -544,7 +578,7 @@ LiteRtStatus LiteRtUnlockTensorBuffer(LiteRtTensorBuffer tensor_buffer) {
 
 void LiteRtDestroyTensorBuffer(LiteRtTensorBuffer tensor_buffer) {
   if (tensor_buffer->Unref()) {
-    delete tensor_buffer;
+    LiteRtTensorBufferT::Destroy(tensor_buffer);
   }
 }
 
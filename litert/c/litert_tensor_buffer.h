@@ -222,6 +222,23 @@ LiteRtStatus LiteRtGetTensorBufferMetalMemory(LiteRtTensorBuffer tensor_buffer,
 #endif  // LITERT_HAS_METAL_SUPPORT
 
 #if LITERT_HAS_VULKAN_SUPPORT
+// Create a tensor buffer from an existing Vulkan memory of a given size, with
+// optional Vulkan memory deallocator (it can be NULL). The Vulkan memory can be
+// imported by the caller from an AHardwareBuffer or a DMA-BUF so that the
+// tensor buffer shares it with other APIs without a copy. Work on the memory
+// by other APIs can be ordered with a sync fence fd event attached to the
+// tensor buffer.
+//
+// Caller owns the returned LiteRtTensorBuffer. The owner is responsible for
+// releasing the object. NULL deallocator means that the Vulkan memory is not
+// managed by the tensor buffer and therefore must be released separately by the
+// caller.
+LiteRtStatus LiteRtCreateTensorBufferFromVulkanMemory(
+    LiteRtEnvironment env, const LiteRtRankedTensorType* tensor_type,
+    LiteRtTensorBufferType buffer_type, HwMemoryHandle vulkan_memory,
+    size_t vulkan_memory_size, LiteRtVulkanMemoryDeallocator deallocator,
+    LiteRtTensorBuffer* tensor_buffer);
+
 // Return an error if the backing buffer is not a Vulkan device memory.
 LiteRtStatus LiteRtGetTensorBufferVulkanMemory(
     LiteRtTensorBuffer tensor_buffer, HwMemoryHandle* hw_memory_handle);
@@ -293,10 +310,22 @@ LiteRtStatus LiteRtClearTensorBufferEvent(LiteRtTensorBuffer tensor_buffer);
 // NOTE: If the underlying H/W buffer has a stride the data will be converted to
 // the packed buffer.
 // TODO b/413449050 - Update behavior to return raw H/W buffer as it is.
+//
+// Read locks are shared: a buffer can be read locked several times, e.g. by
+// several consumers of the same output, and each lock must be unlocked.
 LiteRtStatus LiteRtLockTensorBuffer(LiteRtTensorBuffer tensor_buffer,
                                     void** host_mem_addr,
                                     LiteRtTensorBufferLockMode lock_mode);
 
+// Same as LiteRtLockTensorBuffer() but locks the `size` bytes starting at
+// `offset` of the host memory and returns the address of the first one. When
+// locked for writing, only this range is synchronized back to the H/W buffer
+// on unlock.
+LiteRtStatus LiteRtLockTensorBufferRange(LiteRtTensorBuffer tensor_buffer,
+                                         size_t offset, size_t size,
+                                         void** host_mem_addr,
+                                         LiteRtTensorBufferLockMode lock_mode);
+
 // Unlock a tensor buffer and (potentially) unmap it from host memory.
 //
 // NOTE: If the underlying H/W buffer has a stride the data will be converted to
@@ -68,6 +68,15 @@ LiteRtStatus LiteRtGetTensorBufferRequirementsAlignment(
 
 // Join requirements from two sources and return an error if the join returns an
 // empty set of requirements.
+//
+// The supported buffer types of the joined requirements are the ones common to
+// both sources, device buffer types first and then in the order of
+// `src_requirements_1`. The buffer size and alignment are the largest of the
+// two, and sources without strides accept the strides of the other one. This
+// is typically used to negotiate a buffer passed from a producer (e.g. the
+// output of a model) to a consumer (e.g. the input of the next model), and
+// the shared buffer can then be allocated with
+// LiteRtCreateManagedTensorBufferFromRequirements().
 LiteRtStatus LiteRtJoinTensorBufferRequirements(
     LiteRtTensorBufferRequirements src_requirements_1,
     LiteRtTensorBufferRequirements src_requirements_2,
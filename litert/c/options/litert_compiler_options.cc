@@ -25,6 +25,10 @@
 struct LiteRtCompilerOptionsT {
   LiteRtCompilerOptionsPartitionStrategy partition_strategy =
       kLiteRtCompilerOptionsPartitionStrategyDefault;
+  double partition_op_gain = 1.0;
+  double partition_transfer_cost_per_byte = 0.0;
+  double partition_dispatch_cost = 0.0;
+  uint32_t min_partition_size = 1;
   bool dummy_option = false;
 };
 
@@ -44,7 +48,11 @@ LiteRtStatus LiteRtCreateCompilerOptions(LiteRtOpaqueOptions* options) {
     const LiteRtCompilerOptionsT* options =
         reinterpret_cast<const LiteRtCompilerOptionsT*>(payload);
     uint64_t ans = 0;
-    litert::HashCombine(ans, options->dummy_option);
+    litert::HashCombine(ans, options->dummy_option,
+                        options->partition_op_gain,
+                        options->partition_transfer_cost_per_byte,
+                        options->partition_dispatch_cost,
+                        options->min_partition_size);
     return ans;
   };
   LITERT_RETURN_IF_ERROR(LiteRtSetOpaqueOptionsHash(*options, compiler_hash));
@@ -88,6 +96,78 @@ LiteRtStatus LiteRtGetCompilerOptionsPartitionStrategy(
   return kLiteRtStatusOk;
 }
 
+LiteRtStatus LiteRtSetCompilerOptionsPartitionOpGain(
+    LiteRtCompilerOptions options, double op_gain) {
+  if (options == nullptr) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  options->partition_op_gain = op_gain;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetCompilerOptionsPartitionOpGain(
+    LiteRtCompilerOptionsConst options, double* op_gain) {
+  if (options == nullptr || op_gain == nullptr) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  *op_gain = options->partition_op_gain;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtSetCompilerOptionsPartitionTransferCostPerByte(
+    LiteRtCompilerOptions options, double transfer_cost_per_byte) {
+  if (options == nullptr) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  options->partition_transfer_cost_per_byte = transfer_cost_per_byte;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetCompilerOptionsPartitionTransferCostPerByte(
+    LiteRtCompilerOptionsConst options, double* transfer_cost_per_byte) {
+  if (options == nullptr || transfer_cost_per_byte == nullptr) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  *transfer_cost_per_byte = options->partition_transfer_cost_per_byte;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtSetCompilerOptionsPartitionDispatchCost(
+    LiteRtCompilerOptions options, double dispatch_cost) {
+  if (options == nullptr) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  options->partition_dispatch_cost = dispatch_cost;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetCompilerOptionsPartitionDispatchCost(
+    LiteRtCompilerOptionsConst options, double* dispatch_cost) {
+  if (options == nullptr || dispatch_cost == nullptr) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  *dispatch_cost = options->partition_dispatch_cost;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtSetCompilerOptionsMinPartitionSize(
+    LiteRtCompilerOptions options, uint32_t min_partition_size) {
+  if (options == nullptr) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  options->min_partition_size = min_partition_size;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetCompilerOptionsMinPartitionSize(
+    LiteRtCompilerOptionsConst options, uint32_t* min_partition_size) {
+  if (options == nullptr || min_partition_size == nullptr) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  *min_partition_size = options->min_partition_size;
+  return kLiteRtStatusOk;
+}
+
 LiteRtStatus LiteRtSetDummyCompilerOptions(LiteRtCompilerOptions options,
                                            bool dummy_option) {
   if (options == nullptr) {
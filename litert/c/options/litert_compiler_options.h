@@ -61,6 +61,44 @@ LiteRtStatus LiteRtGetCompilerOptionsPartitionStrategy(
     LiteRtCompilerOptionsConst options,
     LiteRtCompilerOptionsPartitionStrategy* partition_strategy);
 
+// Partition cost model.
+//
+// Each partition found by the partition strategy is estimated to save
+// `op_gain` per op by running on the accelerator, minus `dispatch_cost` for
+// the dispatch and `transfer_cost_per_byte` for each byte of the non-constant
+// tensors crossing its boundary. Partitions with a non-positive gain, or with
+// fewer than `min_partition_size` ops, stay on the host. The defaults (a gain
+// of 1 per op, no costs and a minimum size of 1) offload every partition.
+
+// Sets the estimated time saved by running one op on the accelerator.
+LiteRtStatus LiteRtSetCompilerOptionsPartitionOpGain(
+    LiteRtCompilerOptions options, double op_gain);
+
+LiteRtStatus LiteRtGetCompilerOptionsPartitionOpGain(
+    LiteRtCompilerOptionsConst options, double* op_gain);
+
+// Sets the estimated time to move one byte between the host and the
+// accelerator.
+LiteRtStatus LiteRtSetCompilerOptionsPartitionTransferCostPerByte(
+    LiteRtCompilerOptions options, double transfer_cost_per_byte);
+
+LiteRtStatus LiteRtGetCompilerOptionsPartitionTransferCostPerByte(
+    LiteRtCompilerOptionsConst options, double* transfer_cost_per_byte);
+
+// Sets the estimated fixed time of each dispatch to the accelerator.
+LiteRtStatus LiteRtSetCompilerOptionsPartitionDispatchCost(
+    LiteRtCompilerOptions options, double dispatch_cost);
+
+LiteRtStatus LiteRtGetCompilerOptionsPartitionDispatchCost(
+    LiteRtCompilerOptionsConst options, double* dispatch_cost);
+
+// Sets the minimum number of ops of an offloaded partition.
+LiteRtStatus LiteRtSetCompilerOptionsMinPartitionSize(
+    LiteRtCompilerOptions options, uint32_t min_partition_size);
+
+LiteRtStatus LiteRtGetCompilerOptionsMinPartitionSize(
+    LiteRtCompilerOptionsConst options, uint32_t* min_partition_size);
+
 // Dummy options for testing.
 LiteRtStatus LiteRtSetDummyCompilerOptions(LiteRtCompilerOptions options,
                                            bool dummy_option);
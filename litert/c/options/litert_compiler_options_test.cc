@@ -89,6 +89,53 @@ TEST(LiteRtCompilerOptionsTest, SetAndGetWCPartitionStrategy) {
   LiteRtDestroyOpaqueOptions(options);
 }
 
+TEST(LiteRtCompilerOptionsTest, SetAndGetPartitionCostModel) {
+  LiteRtOpaqueOptions options;
+  LITERT_ASSERT_OK(LiteRtCreateCompilerOptions(&options));
+  LiteRtCompilerOptions compiler_options;
+  LITERT_ASSERT_OK(LiteRtFindCompilerOptions(options, &compiler_options));
+
+  double op_gain;
+  double transfer_cost_per_byte;
+  double dispatch_cost;
+  uint32_t min_partition_size;
+  LITERT_ASSERT_OK(
+      LiteRtGetCompilerOptionsPartitionOpGain(compiler_options, &op_gain));
+  LITERT_ASSERT_OK(LiteRtGetCompilerOptionsPartitionTransferCostPerByte(
+      compiler_options, &transfer_cost_per_byte));
+  LITERT_ASSERT_OK(LiteRtGetCompilerOptionsPartitionDispatchCost(
+      compiler_options, &dispatch_cost));
+  LITERT_ASSERT_OK(LiteRtGetCompilerOptionsMinPartitionSize(
+      compiler_options, &min_partition_size));
+  EXPECT_EQ(op_gain, 1.0);
+  EXPECT_EQ(transfer_cost_per_byte, 0.0);
+  EXPECT_EQ(dispatch_cost, 0.0);
+  EXPECT_EQ(min_partition_size, 1);
+
+  LITERT_ASSERT_OK(
+      LiteRtSetCompilerOptionsPartitionOpGain(compiler_options, 2.5));
+  LITERT_ASSERT_OK(LiteRtSetCompilerOptionsPartitionTransferCostPerByte(
+      compiler_options, 0.01));
+  LITERT_ASSERT_OK(
+      LiteRtSetCompilerOptionsPartitionDispatchCost(compiler_options, 4.0));
+  LITERT_ASSERT_OK(
+      LiteRtSetCompilerOptionsMinPartitionSize(compiler_options, 3));
+  LITERT_ASSERT_OK(
+      LiteRtGetCompilerOptionsPartitionOpGain(compiler_options, &op_gain));
+  LITERT_ASSERT_OK(LiteRtGetCompilerOptionsPartitionTransferCostPerByte(
+      compiler_options, &transfer_cost_per_byte));
+  LITERT_ASSERT_OK(LiteRtGetCompilerOptionsPartitionDispatchCost(
+      compiler_options, &dispatch_cost));
+  LITERT_ASSERT_OK(LiteRtGetCompilerOptionsMinPartitionSize(
+      compiler_options, &min_partition_size));
+  EXPECT_EQ(op_gain, 2.5);
+  EXPECT_EQ(transfer_cost_per_byte, 0.01);
+  EXPECT_EQ(dispatch_cost, 4.0);
+  EXPECT_EQ(min_partition_size, 3);
+
+  LiteRtDestroyOpaqueOptions(options);
+}
+
 TEST(LiteRtCompilerOptionsTest, Hash) {
   LiteRtOpaqueOptions options1;
   LITERT_ASSERT_OK(LiteRtCreateCompilerOptions(&options1));
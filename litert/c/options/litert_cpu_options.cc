@@ -20,6 +20,7 @@
 
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_opaque_options.h"
+#include "litert/c/options/litert_cpu_options_type.h"
 #include "litert/cc/litert_macros.h"
 #include "litert/runtime/litert_cpu_options.h"
 #include "tflite/delegates/xnnpack/xnnpack_delegate.h"
@@ -128,3 +129,21 @@ LiteRtStatus LiteRtGetCpuOptionsXnnPackWeightCacheFileDescriptor(
   *fd = options->xnn.weight_cache_file_descriptor;
   return kLiteRtStatusOk;
 }
+
+LiteRtStatus LiteRtSetCpuOptionsAffinityPolicy(LiteRtCpuOptions options,
+                                               LiteRtCpuAffinityPolicy policy) {
+  LITERT_RETURN_IF_ERROR(options, litert::ErrorStatusBuilder::InvalidArgument())
+      << "options is null.";
+  options->affinity_policy = policy;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetCpuOptionsAffinityPolicy(
+    LiteRtCpuOptionsConst options, LiteRtCpuAffinityPolicy* const policy) {
+  LITERT_RETURN_IF_ERROR(options, litert::ErrorStatusBuilder::InvalidArgument())
+      << "options is null.";
+  LITERT_RETURN_IF_ERROR(policy, litert::ErrorStatusBuilder::InvalidArgument())
+      << "policy is null.";
+  *policy = options->affinity_policy;
+  return kLiteRtStatusOk;
+}
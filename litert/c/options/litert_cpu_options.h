@@ -19,6 +19,7 @@
 
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_opaque_options.h"
+#include "litert/c/options/litert_cpu_options_type.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -74,6 +75,16 @@ LiteRtStatus LiteRtSetCpuOptionsXnnPackWeightCacheFileDescriptor(
 LiteRtStatus LiteRtGetCpuOptionsXnnPackWeightCacheFileDescriptor(
     LiteRtCpuOptionsConst options, int* fd);
 
+// Sets the cores the CPU accelerator runs on. The threads of XNNPack and of
+// the built-in kernels, and the thread running the model, are pinned to them
+// on Linux and Android. A number of threads of 0 then defaults to the number
+// of these cores.
+LiteRtStatus LiteRtSetCpuOptionsAffinityPolicy(LiteRtCpuOptions options,
+                                               LiteRtCpuAffinityPolicy policy);
+
+// Gets the cores the CPU accelerator runs on.
+LiteRtStatus LiteRtGetCpuOptionsAffinityPolicy(
+    LiteRtCpuOptionsConst options, LiteRtCpuAffinityPolicy* policy);
 
 #ifdef __cplusplus
 }  // extern "C"
@@ -24,6 +24,7 @@
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_opaque_options.h"
+#include "litert/c/options/litert_cpu_options_type.h"
 #include "litert/cc/litert_macros.h"
 #include "litert/test/matchers.h"
 
@@ -236,4 +237,29 @@ TEST_F(LiteRtCpuOptionsFieldsTest,
       IsError(kLiteRtStatusErrorInvalidArgument));
 }
 
+TEST_F(LiteRtCpuOptionsFieldsTest, SetAndGetAffinityPolicy) {
+  LiteRtCpuAffinityPolicy policy = kLiteRtCpuAffinityPolicyLittleCores;
+
+  // Avoid a no-op test.
+  LITERT_EXPECT_OK(LiteRtGetCpuOptionsAffinityPolicy(cpu_options_, &policy));
+  ASSERT_EQ(policy, kLiteRtCpuAffinityPolicyNone);
+
+  // Actual test.
+  LITERT_EXPECT_OK(LiteRtSetCpuOptionsAffinityPolicy(
+      cpu_options_, kLiteRtCpuAffinityPolicyPrimeCores));
+  LITERT_EXPECT_OK(LiteRtGetCpuOptionsAffinityPolicy(cpu_options_, &policy));
+  ASSERT_EQ(policy, kLiteRtCpuAffinityPolicyPrimeCores);
+}
+
+TEST_F(LiteRtCpuOptionsFieldsTest, AffinityPolicyFailsWithInvalidArgument) {
+  LiteRtCpuAffinityPolicy policy;
+  EXPECT_THAT(LiteRtSetCpuOptionsAffinityPolicy(
+                  /*options=*/nullptr, kLiteRtCpuAffinityPolicyBigCores),
+              IsError(kLiteRtStatusErrorInvalidArgument));
+  EXPECT_THAT(LiteRtGetCpuOptionsAffinityPolicy(/*options=*/nullptr, &policy),
+              IsError(kLiteRtStatusErrorInvalidArgument));
+  EXPECT_THAT(LiteRtGetCpuOptionsAffinityPolicy(cpu_options_, nullptr),
+              IsError(kLiteRtStatusErrorInvalidArgument));
+}
+
 }  // namespace
@@ -0,0 +1,32 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_ODML_LITERT_LITERT_C_OPTIONS_LITERT_CPU_OPTIONS_TYPE_H_
+#define THIRD_PARTY_ODML_LITERT_LITERT_C_OPTIONS_LITERT_CPU_OPTIONS_TYPE_H_
+
+// affinity_policy -------------------------------------------------------------
+
+// The cores of big.LITTLE CPUs the CPU accelerator runs on.
+typedef enum LiteRtCpuAffinityPolicy {
+  // Runs on any core, as scheduled by the OS.
+  kLiteRtCpuAffinityPolicyNone = 0,
+  // Runs on the big cores, e.g. for the latency of foreground models.
+  kLiteRtCpuAffinityPolicyBigCores = 1,
+  // Runs on the big cores with the largest max frequency only.
+  kLiteRtCpuAffinityPolicyPrimeCores = 2,
+  // Runs on the little cores, e.g. to save energy on background work.
+  kLiteRtCpuAffinityPolicyLittleCores = 3,
+} LiteRtCpuAffinityPolicy;
+
+#endif  // THIRD_PARTY_ODML_LITERT_LITERT_C_OPTIONS_LITERT_CPU_OPTIONS_TYPE_H_
@@ -35,6 +35,7 @@ struct LiteRtIntelOpenVinoOptionsT {
       kLiteRtIntelOpenVinoPerformanceModeLatency;
   // Store custom configuration options as key-value pairs
   std::vector<std::pair<std::string, std::string>> configs_map_options;
+  int num_infer_requests = 0;
 };
 
 LiteRtStatus LiteRtIntelOpenVinoOptionsCreate(LiteRtOpaqueOptions* options) {
@@ -55,7 +56,8 @@ LiteRtStatus LiteRtIntelOpenVinoOptionsCreate(LiteRtOpaqueOptions* options) {
     const LiteRtIntelOpenVinoOptionsT* opts =
         reinterpret_cast<const LiteRtIntelOpenVinoOptionsT*>(payload);
     uint64_t ans = 0;
-    litert::HashCombine(ans, opts->device_type, opts->performance_mode);
+    litert::HashCombine(ans, opts->device_type, opts->performance_mode,
+                        opts->num_infer_requests);
     // Hash the configs_map_options
     for (const auto& pair : opts->configs_map_options) {
       litert::HashCombine(ans, pair.first, pair.second);
@@ -176,3 +178,24 @@ LiteRtStatus LiteRtIntelOpenVinoOptionsGetConfigsMapOption(
   *value = pair.second.c_str();
   return kLiteRtStatusOk;
 }
+
+// RUNTIME OPTIONS /////////////////////////////////////////////////////////////
+
+// num_infer_requests ---------------------------------------------------------
+LiteRtStatus LiteRtIntelOpenVinoOptionsSetNumInferRequests(
+    LiteRtIntelOpenVinoOptions options, int num_infer_requests) {
+  if (options == nullptr || num_infer_requests < 0) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  options->num_infer_requests = num_infer_requests;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtIntelOpenVinoOptionsGetNumInferRequests(
+    LiteRtIntelOpenVinoOptions options, int* num_infer_requests) {
+  if (options == nullptr || num_infer_requests == nullptr) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  *num_infer_requests = options->num_infer_requests;
+  return kLiteRtStatusOk;
+}
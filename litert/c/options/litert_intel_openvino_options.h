@@ -98,6 +98,21 @@ LiteRtStatus LiteRtIntelOpenVinoOptionsGetConfigsMapOption(
     LiteRtIntelOpenVinoOptions options, int index, const char** key,
     const char** value);
 
+// RUNTIME OPTIONS /////////////////////////////////////////////////////////////
+
+// num_infer_requests ---------------------------------------------------------
+
+// Number of inference requests the dispatch runtime keeps per compiled model.
+// Concurrent invocations run on different requests, which lets throughput
+// performance modes fill the parallel execution streams of the device. By
+// default (0), the number of requests is the one reported as optimal by the
+// compiled model.
+LiteRtStatus LiteRtIntelOpenVinoOptionsSetNumInferRequests(
+    LiteRtIntelOpenVinoOptions options, int num_infer_requests);
+
+LiteRtStatus LiteRtIntelOpenVinoOptionsGetNumInferRequests(
+    LiteRtIntelOpenVinoOptions options, int* num_infer_requests);
+
 #ifdef __cplusplus
 
 }  // extern "C"
@@ -38,6 +38,7 @@ struct LiteRtQualcommOptionsT {
   bool use_fold_relu = true;
   LiteRtQualcommOptionsHtpPerformanceMode htp_performance_mode =
       kLiteRtQualcommHtpPerformanceModeDefault;
+  std::uint32_t htp_latency_slo_us = 0;
   std::vector<std::int32_t> dump_tensor_ids;
   std::string ir_json_dir;
   std::uint32_t vtcm_size = 0;
@@ -68,7 +69,7 @@ LiteRtStatus LiteRtQualcommOptionsCreate(LiteRtOpaqueOptions* options) {
         ans, options->log_level, options->profiling,
         options->use_htp_preference, options->use_qint16_as_quint16,
         options->enable_weight_sharing, options->htp_performance_mode,
-        options->ir_json_dir, options->vtcm_size, options->num_hvx_threads,
+        options->htp_latency_slo_us, options->ir_json_dir, options->vtcm_size, options->num_hvx_threads,
         options->optimization_level);
     return ans;
   };
@@ -314,6 +315,28 @@ LiteRtStatus LiteRtQualcommOptionsGetHtpPerformanceMode(
   return kLiteRtStatusOk;
 }
 
+LiteRtStatus LiteRtQualcommOptionsSetHtpLatencySloUs(
+    LiteRtQualcommOptions options, std::uint32_t htp_latency_slo_us) {
+  if (options == nullptr) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+
+  options->htp_latency_slo_us = htp_latency_slo_us;
+
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtQualcommOptionsGetHtpLatencySloUs(
+    LiteRtQualcommOptions options, std::uint32_t* htp_latency_slo_us) {
+  if (options == nullptr || htp_latency_slo_us == nullptr) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+
+  *htp_latency_slo_us = options->htp_latency_slo_us;
+
+  return kLiteRtStatusOk;
+}
+
 LiteRtStatus LiteRtQualcommOptionsSetIrJsonDir(LiteRtQualcommOptions options,
                                                const char* ir_json_dir) {
   if (options == nullptr) {
@@ -158,6 +158,21 @@ LiteRtStatus LiteRtQualcommOptionsGetHtpPerformanceMode(
     LiteRtQualcommOptions options,
     LiteRtQualcommOptionsHtpPerformanceMode* htp_performance_mode);
 
+// htp_latency_slo_us
+
+// Target latency of one invocation, in microseconds. When set, the HTP backend
+// stops holding the performance mode for the whole session: it drops to the
+// power saving profile of the mode between bursts of invocations and votes
+// for the performance profile before invocations that arrive back to back or
+// that would otherwise miss the target. Has no effect with the default
+// performance mode. Defaults to 0 (disabled).
+
+LiteRtStatus LiteRtQualcommOptionsSetHtpLatencySloUs(
+    LiteRtQualcommOptions options, uint32_t htp_latency_slo_us);
+
+LiteRtStatus LiteRtQualcommOptionsGetHtpLatencySloUs(
+    LiteRtQualcommOptions options, uint32_t* htp_latency_slo_us);
+
 // profiling
 
 // This option controls the profiling level. A higher level results in a more
@@ -135,6 +135,27 @@ TEST(LiteRtQualcommOptionsTest, HtpPerformanceMode) {
   LiteRtDestroyOpaqueOptions(options);
 }
 
+TEST(LiteRtQualcommOptionsTest, HtpLatencySloUs) {
+  LiteRtOpaqueOptions options;
+  LITERT_ASSERT_OK(LiteRtQualcommOptionsCreate(&options));
+
+  LiteRtQualcommOptions qualcomm_options;
+  LITERT_ASSERT_OK(LiteRtQualcommOptionsGet(options, &qualcomm_options));
+
+  uint32_t htp_latency_slo_us;
+  LITERT_ASSERT_OK(LiteRtQualcommOptionsGetHtpLatencySloUs(
+      qualcomm_options, &htp_latency_slo_us));
+  EXPECT_EQ(htp_latency_slo_us, 0);
+
+  LITERT_ASSERT_OK(
+      LiteRtQualcommOptionsSetHtpLatencySloUs(qualcomm_options, 8000));
+  LITERT_ASSERT_OK(LiteRtQualcommOptionsGetHtpLatencySloUs(
+      qualcomm_options, &htp_latency_slo_us));
+  EXPECT_EQ(htp_latency_slo_us, 8000);
+
+  LiteRtDestroyOpaqueOptions(options);
+}
+
 TEST(LiteRtQualcommOptionsTest, Profiling) {
   LiteRtOpaqueOptions options;
   LITERT_ASSERT_OK(LiteRtQualcommOptionsCreate(&options));
@@ -305,6 +326,10 @@ TEST(QualcommOptionsTest, CppApi) {
   EXPECT_EQ(options->GetHtpPerformanceMode(),
             QualcommOptions::HtpPerformanceMode::kBurst);
 
+  EXPECT_EQ(options->GetHtpLatencySloUs(), 0);
+  options->SetHtpLatencySloUs(8000);
+  EXPECT_EQ(options->GetHtpLatencySloUs(), 8000);
+
   EXPECT_EQ(options->GetProfiling(), QualcommOptions::Profiling::kOff);
   options->SetProfiling(QualcommOptions::Profiling::kDetailed);
   EXPECT_EQ(options->GetProfiling(), QualcommOptions::Profiling::kDetailed);
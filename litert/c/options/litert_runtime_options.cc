@@ -14,6 +14,7 @@
 
 #include "litert/c/options/litert_runtime_options.h"
 
+#include <cstdint>
 #include <memory>
 
 #include "litert/c/litert_common.h"
@@ -106,3 +107,108 @@ LiteRtStatus LiteRtGetRuntimeOptionsErrorReporterMode(
   *error_reporter_mode = options->error_reporter_mode;
   return kLiteRtStatusOk;
 }
+
+LiteRtStatus LiteRtSetRuntimeOptionsBackgroundJitCompilation(
+    LiteRtRuntimeOptions options, bool background_jit_compilation) {
+  LITERT_RETURN_IF_ERROR(options, litert::ErrorStatusBuilder::InvalidArgument())
+      << "options is null.";
+  options->background_jit_compilation = background_jit_compilation;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetRuntimeOptionsBackgroundJitCompilation(
+    LiteRtRuntimeOptions options, bool* background_jit_compilation) {
+  LITERT_RETURN_IF_ERROR(options, litert::ErrorStatusBuilder::InvalidArgument())
+      << "options is null.";
+  LITERT_RETURN_IF_ERROR(background_jit_compilation,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "background_jit_compilation is null.";
+  *background_jit_compilation = options->background_jit_compilation;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtSetRuntimeOptionsLazySignatureAllocation(
+    LiteRtRuntimeOptions options, bool lazy_signature_allocation) {
+  LITERT_RETURN_IF_ERROR(options, litert::ErrorStatusBuilder::InvalidArgument())
+      << "options is null.";
+  options->lazy_signature_allocation = lazy_signature_allocation;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetRuntimeOptionsLazySignatureAllocation(
+    LiteRtRuntimeOptions options, bool* lazy_signature_allocation) {
+  LITERT_RETURN_IF_ERROR(options, litert::ErrorStatusBuilder::InvalidArgument())
+      << "options is null.";
+  LITERT_RETURN_IF_ERROR(lazy_signature_allocation,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "lazy_signature_allocation is null.";
+  *lazy_signature_allocation = options->lazy_signature_allocation;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtSetRuntimeOptionsNumDispatchInvocationContexts(
+    LiteRtRuntimeOptions options, int num_dispatch_invocation_contexts) {
+  LITERT_RETURN_IF_ERROR(options, litert::ErrorStatusBuilder::InvalidArgument())
+      << "options is null.";
+  LITERT_RETURN_IF_ERROR(num_dispatch_invocation_contexts >= 1,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "num_dispatch_invocation_contexts must be at least 1.";
+  options->num_dispatch_invocation_contexts = num_dispatch_invocation_contexts;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetRuntimeOptionsNumDispatchInvocationContexts(
+    LiteRtRuntimeOptions options, int* num_dispatch_invocation_contexts) {
+  LITERT_RETURN_IF_ERROR(options, litert::ErrorStatusBuilder::InvalidArgument())
+      << "options is null.";
+  LITERT_RETURN_IF_ERROR(num_dispatch_invocation_contexts,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "num_dispatch_invocation_contexts is null.";
+  *num_dispatch_invocation_contexts = options->num_dispatch_invocation_contexts;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtSetRuntimeOptionsRunPriority(LiteRtRuntimeOptions options,
+                                                LiteRtRunPriority priority) {
+  LITERT_RETURN_IF_ERROR(options, litert::ErrorStatusBuilder::InvalidArgument())
+      << "options is null.";
+  LITERT_RETURN_IF_ERROR(priority >= kLiteRtRunPriorityNone &&
+                             priority <= kLiteRtRunPriorityHigh,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "Invalid run priority.";
+  options->run_priority = priority;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetRuntimeOptionsRunPriority(LiteRtRuntimeOptions options,
+                                                LiteRtRunPriority* priority) {
+  LITERT_RETURN_IF_ERROR(options, litert::ErrorStatusBuilder::InvalidArgument())
+      << "options is null.";
+  LITERT_RETURN_IF_ERROR(priority,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "priority is null.";
+  *priority = options->run_priority;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtSetRuntimeOptionsRunDeadlineMs(LiteRtRuntimeOptions options,
+                                                  int64_t deadline_ms) {
+  LITERT_RETURN_IF_ERROR(options, litert::ErrorStatusBuilder::InvalidArgument())
+      << "options is null.";
+  LITERT_RETURN_IF_ERROR(deadline_ms >= 0,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "deadline_ms must not be negative.";
+  options->run_deadline_ms = deadline_ms;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetRuntimeOptionsRunDeadlineMs(LiteRtRuntimeOptions options,
+                                                  int64_t* deadline_ms) {
+  LITERT_RETURN_IF_ERROR(options, litert::ErrorStatusBuilder::InvalidArgument())
+      << "options is null.";
+  LITERT_RETURN_IF_ERROR(deadline_ms,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "deadline_ms is null.";
+  *deadline_ms = options->run_deadline_ms;
+  return kLiteRtStatusOk;
+}
@@ -41,6 +41,8 @@
 #ifndef THIRD_PARTY_ODML_LITERT_LITERT_C_OPTIONS_LITERT_RUNTIME_OPTIONS_H_
 #define THIRD_PARTY_ODML_LITERT_LITERT_C_OPTIONS_LITERT_RUNTIME_OPTIONS_H_
 
+#include <stdint.h>
+
 #include "litert/c/litert_common.h"
 #ifdef __cplusplus
 extern "C" {
@@ -88,6 +90,74 @@ LiteRtStatus LiteRtSetRuntimeOptionsErrorReporterMode(
 LiteRtStatus LiteRtGetRuntimeOptionsErrorReporterMode(
     LiteRtRuntimeOptions options, LiteRtErrorReporterMode* error_reporter_mode);
 
+// Sets the background JIT compilation flag in runtime options. When set, a
+// compiled model needing NPU JIT compilation is created right away with the CPU
+// accelerators, compiles the model on a background thread and switches to the
+// compiled model at the first Run() after compilation completed. The
+// compilation options must then stay valid until the compiled model is
+// destroyed.
+LiteRtStatus LiteRtSetRuntimeOptionsBackgroundJitCompilation(
+    LiteRtRuntimeOptions options, bool background_jit_compilation);
+
+// Gets the background JIT compilation flag from runtime options. Reads the
+// value from the options and writes it to the pointer.
+LiteRtStatus LiteRtGetRuntimeOptionsBackgroundJitCompilation(
+    LiteRtRuntimeOptions options, bool* background_jit_compilation);
+
+// Sets the lazy signature allocation flag in runtime options. When set, the
+// compiled model releases the tensor arena of every signature once it is
+// created and allocates it again the first time the signature runs.
+// LiteRtCompiledModelReleaseSignatureMemory() releases it again once the
+// signature is idle.
+LiteRtStatus LiteRtSetRuntimeOptionsLazySignatureAllocation(
+    LiteRtRuntimeOptions options, bool lazy_signature_allocation);
+
+// Gets the lazy signature allocation flag from runtime options. Reads the value
+// from the options and writes it to the pointer.
+LiteRtStatus LiteRtGetRuntimeOptionsLazySignatureAllocation(
+    LiteRtRuntimeOptions options, bool* lazy_signature_allocation);
+
+// Sets the number of invocation contexts each dispatch delegate kernel keeps.
+// Asynchronous executions rotate through them, so a later execution can be
+// scheduled on the NPU while the previous ones are still running on their own
+// invocation contexts. Defaults to 1. The additional invocation contexts are
+// created the first time they are needed.
+LiteRtStatus LiteRtSetRuntimeOptionsNumDispatchInvocationContexts(
+    LiteRtRuntimeOptions options, int num_dispatch_invocation_contexts);
+
+// Gets the number of invocation contexts each dispatch delegate kernel keeps.
+// Reads the value from the options and writes it to the pointer.
+LiteRtStatus LiteRtGetRuntimeOptionsNumDispatchInvocationContexts(
+    LiteRtRuntimeOptions options, int* num_dispatch_invocation_contexts);
+
+// Sets the priority of the runs of the compiled model. The environment runs
+// the runs with a priority one at a time on each device: the NPU or the GPU if
+// the compiled model uses one, the CPU otherwise. The waiting runs of higher
+// priority go first, and a running one yields the device between the nodes of
+// its graph, e.g. between the partitions delegated to an accelerator, while a
+// run of higher priority waits. Defaults to kLiteRtRunPriorityNone, whose runs
+// are not ordered. See LiteRtGetEnvironmentRunQueueStats() for the metrics.
+LiteRtStatus LiteRtSetRuntimeOptionsRunPriority(LiteRtRuntimeOptions options,
+                                                LiteRtRunPriority priority);
+
+// Gets the priority of the runs of the compiled model. Reads the value from the
+// options and writes it to the pointer.
+LiteRtStatus LiteRtGetRuntimeOptionsRunPriority(LiteRtRuntimeOptions options,
+                                                LiteRtRunPriority* priority);
+
+// Sets the time after their start by which the runs of the compiled model
+// should complete, in milliseconds. Among the waiting runs of the same
+// priority, those with the earliest deadline go first. Defaults to 0, for no
+// deadline.
+LiteRtStatus LiteRtSetRuntimeOptionsRunDeadlineMs(LiteRtRuntimeOptions options,
+                                                  int64_t deadline_ms);
+
+// Gets the time after their start by which the runs of the compiled model
+// should complete, in milliseconds. Reads the value from the options and
+// writes it to the pointer.
+LiteRtStatus LiteRtGetRuntimeOptionsRunDeadlineMs(LiteRtRuntimeOptions options,
+                                                  int64_t* deadline_ms);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -14,6 +14,8 @@
 
 #include "litert/c/options/litert_runtime_options.h"
 
+#include <cstdint>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "litert/c/litert_common.h"
@@ -66,4 +68,112 @@ TEST(LiteRtRuntimeOptionsFieldsTest, SetGetShloCompositeInlining) {
   LiteRtDestroyOpaqueOptions(opaque_options);
 }
 
+TEST(LiteRtRuntimeOptionsFieldsTest, SetGetBackgroundJitCompilation) {
+  LiteRtOpaqueOptions opaque_options = nullptr;
+  LITERT_ASSERT_OK(LiteRtCreateRuntimeOptions(&opaque_options));
+  LiteRtRuntimeOptions runtime_options = nullptr;
+  LITERT_ASSERT_OK(LiteRtFindRuntimeOptions(opaque_options, &runtime_options));
+
+  bool background_jit_compilation = true;
+  LITERT_ASSERT_OK(LiteRtGetRuntimeOptionsBackgroundJitCompilation(
+      runtime_options, &background_jit_compilation));
+  EXPECT_EQ(background_jit_compilation, false);
+
+  LITERT_ASSERT_OK(
+      LiteRtSetRuntimeOptionsBackgroundJitCompilation(runtime_options, true));
+  LITERT_ASSERT_OK(LiteRtGetRuntimeOptionsBackgroundJitCompilation(
+      runtime_options, &background_jit_compilation));
+  EXPECT_EQ(background_jit_compilation, true);
+
+  EXPECT_THAT(
+      LiteRtGetRuntimeOptionsBackgroundJitCompilation(runtime_options, nullptr),
+      IsError(kLiteRtStatusErrorInvalidArgument));
+
+  LiteRtDestroyOpaqueOptions(opaque_options);
+}
+
+TEST(LiteRtRuntimeOptionsFieldsTest, SetGetLazySignatureAllocation) {
+  LiteRtOpaqueOptions opaque_options = nullptr;
+  LITERT_ASSERT_OK(LiteRtCreateRuntimeOptions(&opaque_options));
+  LiteRtRuntimeOptions runtime_options = nullptr;
+  LITERT_ASSERT_OK(LiteRtFindRuntimeOptions(opaque_options, &runtime_options));
+
+  bool lazy_signature_allocation = true;
+  LITERT_ASSERT_OK(LiteRtGetRuntimeOptionsLazySignatureAllocation(
+      runtime_options, &lazy_signature_allocation));
+  EXPECT_EQ(lazy_signature_allocation, false);
+
+  LITERT_ASSERT_OK(
+      LiteRtSetRuntimeOptionsLazySignatureAllocation(runtime_options, true));
+  LITERT_ASSERT_OK(LiteRtGetRuntimeOptionsLazySignatureAllocation(
+      runtime_options, &lazy_signature_allocation));
+  EXPECT_EQ(lazy_signature_allocation, true);
+
+  EXPECT_THAT(
+      LiteRtGetRuntimeOptionsLazySignatureAllocation(runtime_options, nullptr),
+      IsError(kLiteRtStatusErrorInvalidArgument));
+
+  LiteRtDestroyOpaqueOptions(opaque_options);
+}
+
+TEST(LiteRtRuntimeOptionsFieldsTest, SetGetNumDispatchInvocationContexts) {
+  LiteRtOpaqueOptions opaque_options = nullptr;
+  LITERT_ASSERT_OK(LiteRtCreateRuntimeOptions(&opaque_options));
+  LiteRtRuntimeOptions runtime_options = nullptr;
+  LITERT_ASSERT_OK(LiteRtFindRuntimeOptions(opaque_options, &runtime_options));
+
+  int num_dispatch_invocation_contexts = 0;
+  LITERT_ASSERT_OK(LiteRtGetRuntimeOptionsNumDispatchInvocationContexts(
+      runtime_options, &num_dispatch_invocation_contexts));
+  EXPECT_EQ(num_dispatch_invocation_contexts, 1);
+
+  LITERT_ASSERT_OK(
+      LiteRtSetRuntimeOptionsNumDispatchInvocationContexts(runtime_options, 2));
+  LITERT_ASSERT_OK(LiteRtGetRuntimeOptionsNumDispatchInvocationContexts(
+      runtime_options, &num_dispatch_invocation_contexts));
+  EXPECT_EQ(num_dispatch_invocation_contexts, 2);
+
+  EXPECT_THAT(
+      LiteRtSetRuntimeOptionsNumDispatchInvocationContexts(runtime_options, 0),
+      IsError(kLiteRtStatusErrorInvalidArgument));
+  EXPECT_THAT(LiteRtGetRuntimeOptionsNumDispatchInvocationContexts(
+                  runtime_options, nullptr),
+              IsError(kLiteRtStatusErrorInvalidArgument));
+
+  LiteRtDestroyOpaqueOptions(opaque_options);
+}
+
+TEST(LiteRtRuntimeOptionsFieldsTest, SetGetRunPriorityAndDeadline) {
+  LiteRtOpaqueOptions opaque_options = nullptr;
+  LITERT_ASSERT_OK(LiteRtCreateRuntimeOptions(&opaque_options));
+  LiteRtRuntimeOptions runtime_options = nullptr;
+  LITERT_ASSERT_OK(LiteRtFindRuntimeOptions(opaque_options, &runtime_options));
+
+  LiteRtRunPriority priority = kLiteRtRunPriorityHigh;
+  LITERT_ASSERT_OK(
+      LiteRtGetRuntimeOptionsRunPriority(runtime_options, &priority));
+  EXPECT_EQ(priority, kLiteRtRunPriorityNone);
+  LITERT_ASSERT_OK(LiteRtSetRuntimeOptionsRunPriority(runtime_options,
+                                                      kLiteRtRunPriorityLow));
+  LITERT_ASSERT_OK(
+      LiteRtGetRuntimeOptionsRunPriority(runtime_options, &priority));
+  EXPECT_EQ(priority, kLiteRtRunPriorityLow);
+  EXPECT_THAT(LiteRtSetRuntimeOptionsRunPriority(
+                  runtime_options, static_cast<LiteRtRunPriority>(7)),
+              IsError(kLiteRtStatusErrorInvalidArgument));
+
+  int64_t deadline_ms = -1;
+  LITERT_ASSERT_OK(
+      LiteRtGetRuntimeOptionsRunDeadlineMs(runtime_options, &deadline_ms));
+  EXPECT_EQ(deadline_ms, 0);
+  LITERT_ASSERT_OK(LiteRtSetRuntimeOptionsRunDeadlineMs(runtime_options, 16));
+  LITERT_ASSERT_OK(
+      LiteRtGetRuntimeOptionsRunDeadlineMs(runtime_options, &deadline_ms));
+  EXPECT_EQ(deadline_ms, 16);
+  EXPECT_THAT(LiteRtSetRuntimeOptionsRunDeadlineMs(runtime_options, -1),
+              IsError(kLiteRtStatusErrorInvalidArgument));
+
+  LiteRtDestroyOpaqueOptions(opaque_options);
+}
+
 }  // namespace
@@ -0,0 +1,306 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/cc/litert_chunked_prefill.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+#include "litert/cc/litert_compiled_model.h"
+#include "litert/cc/litert_element_type.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_layout.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/cc/litert_ranked_tensor_type.h"
+#include "litert/cc/litert_tensor_buffer.h"
+
+namespace litert {
+
+namespace {
+
+// Writes `size` consecutive positions starting at `position` to `buffer`.
+template <typename T>
+Expected<void> WritePositions(TensorBuffer& buffer, size_t size,
+                              int64_t position) {
+  LITERT_ASSIGN_OR_RETURN(auto lock_and_addr,
+                          TensorBufferScopedLock::Create<T>(
+                              buffer, TensorBuffer::LockMode::kWrite));
+  std::iota(lock_and_addr.second, lock_and_addr.second + size,
+            static_cast<T>(position));
+  return {};
+}
+
+// Returns the number of elements of `type` if it has a static shape.
+Expected<size_t> StaticNumElements(const RankedTensorType& type,
+                                   absl::string_view name) {
+  for (auto dim : type.Layout().Dimensions()) {
+    if (dim <= 0) {
+      return Unexpected(
+          kLiteRtStatusErrorInvalidArgument,
+          absl::StrFormat("Input %s of the prefill signature must have a "
+                          "static shape",
+                          name));
+    }
+  }
+  return type.Layout().NumElements();
+}
+
+}  // namespace
+
+Expected<ChunkedPrefill> ChunkedPrefill::Create(
+    const CompiledModel& compiled_model, absl::string_view signature_key,
+    Options options,
+    absl::flat_hash_map<std::string, TensorBuffer> bound_inputs,
+    absl::flat_hash_map<std::string, TensorBuffer> bound_outputs) {
+  if (options.tokens_input.empty()) {
+    return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                      "The token input of the prefill signature is not set");
+  }
+  LITERT_ASSIGN_OR_RETURN(size_t signature_index,
+                          compiled_model.GetSignatureIndex(signature_key));
+  ChunkedPrefill prefill(&compiled_model, signature_index, std::move(options));
+  const Options& opts = prefill.options_;
+
+  LITERT_ASSIGN_OR_RETURN(
+      auto input_names, compiled_model.GetSignatureInputNames(signature_index));
+  for (size_t i = 0; i < input_names.size(); ++i) {
+    const absl::string_view name = input_names[i];
+    if (name == opts.tokens_input) {
+      prefill.tokens_index_ = static_cast<int>(i);
+    } else if (name == opts.positions_input) {
+      prefill.positions_index_ = static_cast<int>(i);
+    } else if (name == opts.mask_input) {
+      prefill.mask_index_ = static_cast<int>(i);
+    }
+    if (auto it = bound_inputs.find(name); it != bound_inputs.end()) {
+      prefill.inputs_.push_back(std::move(it->second));
+      bound_inputs.erase(it);
+      continue;
+    }
+    if (name != opts.tokens_input && name != opts.positions_input &&
+        name != opts.mask_input) {
+      return Unexpected(
+          kLiteRtStatusErrorInvalidArgument,
+          absl::StrFormat("Input %s of the prefill signature is not bound",
+                          name));
+    }
+    LITERT_ASSIGN_OR_RETURN(TensorBuffer buffer,
+                            compiled_model.CreateInputBuffer(signature_key,
+                                                             name));
+    prefill.inputs_.push_back(std::move(buffer));
+  }
+  if (!bound_inputs.empty()) {
+    return Unexpected(
+        kLiteRtStatusErrorInvalidArgument,
+        absl::StrFormat("%s is not an input of the prefill signature",
+                        bound_inputs.begin()->first));
+  }
+
+  // The chunk size is given by the token input.
+  if (prefill.tokens_index_ < 0) {
+    return Unexpected(
+        kLiteRtStatusErrorInvalidArgument,
+        absl::StrFormat("The prefill signature has no input %s",
+                        opts.tokens_input));
+  }
+  LITERT_ASSIGN_OR_RETURN(RankedTensorType tokens_type,
+                          compiled_model.GetInputTensorType(
+                              signature_index, prefill.tokens_index_));
+  const auto tokens_dims = tokens_type.Layout().Dimensions();
+  if (tokens_type.ElementType() != ElementType::Int32 ||
+      tokens_dims.empty() || tokens_dims.size() > 2 ||
+      (tokens_dims.size() == 2 && tokens_dims[0] != 1)) {
+    return Unexpected(
+        kLiteRtStatusErrorInvalidArgument,
+        absl::StrFormat("Input %s of the prefill signature must be an int32 "
+                        "tensor of shape [chunk_size] or [1, chunk_size]",
+                        opts.tokens_input));
+  }
+  LITERT_ASSIGN_OR_RETURN(prefill.chunk_size_,
+                          StaticNumElements(tokens_type, opts.tokens_input));
+
+  if (!opts.positions_input.empty()) {
+    if (prefill.positions_index_ < 0) {
+      return Unexpected(
+          kLiteRtStatusErrorInvalidArgument,
+          absl::StrFormat("The prefill signature has no input %s",
+                          opts.positions_input));
+    }
+    LITERT_ASSIGN_OR_RETURN(RankedTensorType positions_type,
+                            compiled_model.GetInputTensorType(
+                                signature_index, prefill.positions_index_));
+    LITERT_ASSIGN_OR_RETURN(
+        size_t num_positions,
+        StaticNumElements(positions_type, opts.positions_input));
+    prefill.positions_type_ = positions_type.ElementType();
+    if ((prefill.positions_type_ != ElementType::Int32 &&
+         prefill.positions_type_ != ElementType::Int64) ||
+        num_positions != prefill.chunk_size_) {
+      return Unexpected(
+          kLiteRtStatusErrorInvalidArgument,
+          absl::StrFormat("Input %s of the prefill signature must hold one "
+                          "int32 or int64 position per token",
+                          opts.positions_input));
+    }
+  }
+
+  if (!opts.mask_input.empty()) {
+    if (prefill.mask_index_ < 0) {
+      return Unexpected(
+          kLiteRtStatusErrorInvalidArgument,
+          absl::StrFormat("The prefill signature has no input %s",
+                          opts.mask_input));
+    }
+    LITERT_ASSIGN_OR_RETURN(RankedTensorType mask_type,
+                            compiled_model.GetInputTensorType(
+                                signature_index, prefill.mask_index_));
+    LITERT_ASSIGN_OR_RETURN(size_t mask_size,
+                            StaticNumElements(mask_type, opts.mask_input));
+    const auto mask_dims = mask_type.Layout().Dimensions();
+    if (mask_type.ElementType() != ElementType::Float32 ||
+        mask_dims.size() < 2 ||
+        static_cast<size_t>(mask_dims[mask_dims.size() - 2]) !=
+            prefill.chunk_size_) {
+      return Unexpected(
+          kLiteRtStatusErrorInvalidArgument,
+          absl::StrFormat("Input %s of the prefill signature must be a float32 "
+                          "tensor of shape [..., chunk_size, kv_cache_size]",
+                          opts.mask_input));
+    }
+    prefill.mask_kv_size_ = mask_dims.back();
+    prefill.mask_repeats_ =
+        mask_size / (prefill.chunk_size_ * prefill.mask_kv_size_);
+  }
+
+  LITERT_ASSIGN_OR_RETURN(
+      auto output_names,
+      compiled_model.GetSignatureOutputNames(signature_index));
+  for (const absl::string_view name : output_names) {
+    prefill.output_names_.emplace_back(name);
+    if (auto it = bound_outputs.find(name); it != bound_outputs.end()) {
+      prefill.outputs_.push_back(std::move(it->second));
+      bound_outputs.erase(it);
+      continue;
+    }
+    LITERT_ASSIGN_OR_RETURN(TensorBuffer buffer,
+                            compiled_model.CreateOutputBuffer(signature_key,
+                                                              name));
+    prefill.outputs_.push_back(std::move(buffer));
+  }
+  if (!bound_outputs.empty()) {
+    return Unexpected(
+        kLiteRtStatusErrorInvalidArgument,
+        absl::StrFormat("%s is not an output of the prefill signature",
+                        bound_outputs.begin()->first));
+  }
+  return prefill;
+}
+
+Expected<int64_t> ChunkedPrefill::Run(absl::Span<const int32_t> tokens,
+                                      int64_t start_position) {
+  if (start_position < 0) {
+    return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                      "The start position of the prefill can not be negative");
+  }
+  // Every entry of the last chunk, padding included, must be in the mask.
+  if (mask_index_ >= 0 &&
+      start_position + NumChunks(tokens.size()) * chunk_size_ >
+          mask_kv_size_) {
+    return Unexpected(
+        kLiteRtStatusErrorInvalidArgument,
+        absl::StrFormat("%d tokens at position %d do not fit in the %d "
+                        "entries of the attention mask",
+                        tokens.size(), start_position, mask_kv_size_));
+  }
+
+  int64_t position = start_position;
+  for (size_t begin = 0; begin < tokens.size(); begin += chunk_size_) {
+    const auto chunk = tokens.subspan(begin, chunk_size_);
+    LITERT_RETURN_IF_ERROR(WriteChunk(chunk, position));
+    LITERT_RETURN_IF_ERROR(
+        compiled_model_->Run(signature_index_, inputs_, outputs_));
+    position += chunk.size();
+  }
+  return position;
+}
+
+Expected<TensorBuffer> ChunkedPrefill::GetOutputBuffer(
+    absl::string_view output_name) const {
+  for (size_t i = 0; i < output_names_.size(); ++i) {
+    if (output_names_[i] == output_name) {
+      return outputs_[i].Duplicate();
+    }
+  }
+  return Unexpected(
+      kLiteRtStatusErrorNotFound,
+      absl::StrFormat("%s is not an output of the prefill signature",
+                      output_name));
+}
+
+Expected<void> ChunkedPrefill::WriteChunk(absl::Span<const int32_t> tokens,
+                                          int64_t position) {
+  {
+    LITERT_ASSIGN_OR_RETURN(
+        auto lock_and_addr,
+        TensorBufferScopedLock::Create<int32_t>(
+            inputs_[tokens_index_], TensorBuffer::LockMode::kWrite));
+    int32_t* data = lock_and_addr.second;
+    std::copy(tokens.begin(), tokens.end(), data);
+    std::fill(data + tokens.size(), data + chunk_size_, options_.pad_token);
+  }
+
+  if (positions_index_ >= 0) {
+    TensorBuffer& positions = inputs_[positions_index_];
+    if (positions_type_ == ElementType::Int64) {
+      LITERT_RETURN_IF_ERROR(
+          WritePositions<int64_t>(positions, chunk_size_, position));
+    } else {
+      LITERT_RETURN_IF_ERROR(
+          WritePositions<int32_t>(positions, chunk_size_, position));
+    }
+  }
+
+  if (mask_index_ >= 0) {
+    LITERT_ASSIGN_OR_RETURN(
+        auto lock_and_addr,
+        TensorBufferScopedLock::Create<float>(inputs_[mask_index_],
+                                              TensorBuffer::LockMode::kWrite));
+    float* mask = lock_and_addr.second;
+    // The token of row `row` sees the keys up to its own position.
+    for (size_t row = 0; row < chunk_size_; ++row) {
+      float* row_data = mask + row * mask_kv_size_;
+      const size_t num_visible = position + row + 1;
+      std::fill(row_data, row_data + num_visible, 0.0f);
+      std::fill(row_data + num_visible, row_data + mask_kv_size_,
+                options_.mask_value);
+    }
+    const size_t matrix_size = chunk_size_ * mask_kv_size_;
+    for (size_t i = 1; i < mask_repeats_; ++i) {
+      std::copy(mask, mask + matrix_size, mask + i * matrix_size);
+    }
+  }
+  return {};
+}
+
+}  // namespace litert
@@ -0,0 +1,151 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_CC_LITERT_CHUNKED_PREFILL_H_
+#define ODML_LITERT_LITERT_CC_LITERT_CHUNKED_PREFILL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/cc/litert_compiled_model.h"
+#include "litert/cc/litert_element_type.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_tensor_buffer.h"
+
+namespace litert {
+
+// ChunkedPrefill runs the prefill of a long prompt through a prefill signature
+// of static chunk size, one chunk per invocation, so the activation memory is
+// bounded by the chunk size rather than by the prompt length.
+//
+// Each chunk is written to the token input at increasing positions. The KV
+// cache is carried from one chunk to the next either by the stateful genai
+// `kvcache` op, or by external KV cache buffers bound with `bound_inputs` and
+// `bound_outputs` (typically the same buffer bound to the cache input and
+// output of each layer). All the buffers are allocated once, in Create(), and
+// reused for every chunk.
+//
+// The tokens of the last chunk past the end of the prompt are set to
+// `pad_token`, and their KV cache entries are overwritten by the next decode
+// step written at the position following the prompt.
+//
+// Example user flow:
+//
+// 1. Create a ChunkedPrefill for the prefill signature of a CompiledModel
+// 2. Call Run() with the prompt tokens
+// 3. Read the logits of the last prompt token from GetOutputBuffer(), at row
+//    LastTokenRow() of the last chunk
+//
+// Note: ChunkedPrefill is not thread safe.
+class ChunkedPrefill {
+ public:
+  struct Options {
+    // The int32 token input, of static shape [chunk_size] or [1, chunk_size].
+    std::string tokens_input;
+    // The optional int32 or int64 position input, with one position per token.
+    std::string positions_input;
+    // The optional float32 attention mask input, whose two innermost
+    // dimensions are [chunk_size, kv_cache_size]. Key `j` is visible to the
+    // token at position `p` iff j <= p. Outer dimensions are broadcast.
+    std::string mask_input;
+    // The value of the masked out entries of the attention mask.
+    float mask_value = std::numeric_limits<float>::lowest();
+    // The token id used to pad the last chunk.
+    int32_t pad_token = 0;
+  };
+
+  // Creates a chunked prefill for the signature `signature_key` of
+  // `compiled_model`, which must outlive it. The inputs and outputs of the
+  // signature other than those of `options` must either be given by
+  // `bound_inputs` and `bound_outputs`, or, for the outputs only, are
+  // allocated by the chunked prefill.
+  static Expected<ChunkedPrefill> Create(
+      const CompiledModel& compiled_model, absl::string_view signature_key,
+      Options options,
+      absl::flat_hash_map<std::string, TensorBuffer> bound_inputs = {},
+      absl::flat_hash_map<std::string, TensorBuffer> bound_outputs = {});
+
+  ChunkedPrefill(ChunkedPrefill&&) = default;
+  ChunkedPrefill& operator=(ChunkedPrefill&&) = default;
+  ChunkedPrefill(const ChunkedPrefill&) = delete;
+  ChunkedPrefill& operator=(const ChunkedPrefill&) = delete;
+
+  // The number of tokens processed by each invocation of the signature.
+  size_t ChunkSize() const { return chunk_size_; }
+
+  // The number of invocations needed to prefill `num_tokens` tokens.
+  size_t NumChunks(size_t num_tokens) const {
+    return (num_tokens + chunk_size_ - 1) / chunk_size_;
+  }
+
+  // The row of the last of `num_tokens` tokens in the outputs of the last
+  // chunk.
+  size_t LastTokenRow(size_t num_tokens) const {
+    return num_tokens == 0 ? 0 : (num_tokens - 1) % chunk_size_;
+  }
+
+  // Prefills `tokens`, the first one being at `start_position`, e.g. the
+  // number of tokens already in the KV cache. Returns the position of the
+  // next token.
+  Expected<int64_t> Run(absl::Span<const int32_t> tokens,
+                        int64_t start_position = 0);
+
+  // Returns the buffer bound to `output_name`. After Run(), it holds the
+  // output of the last chunk.
+  Expected<TensorBuffer> GetOutputBuffer(absl::string_view output_name) const;
+
+ private:
+  ChunkedPrefill(const CompiledModel* compiled_model, size_t signature_index,
+                 Options options)
+      : compiled_model_(compiled_model),
+        signature_index_(signature_index),
+        options_(std::move(options)) {}
+
+  // Writes the tokens, positions and mask of the chunk of `tokens` starting at
+  // `position`.
+  Expected<void> WriteChunk(absl::Span<const int32_t> tokens,
+                            int64_t position);
+
+  const CompiledModel* compiled_model_;
+  size_t signature_index_;
+  Options options_;
+  size_t chunk_size_ = 0;
+
+  // Buffers indexed by signature input / output index.
+  std::vector<TensorBuffer> inputs_;
+  std::vector<TensorBuffer> outputs_;
+  std::vector<std::string> output_names_;
+
+  // The indices in `inputs_` of the inputs written for each chunk, -1 if the
+  // signature has no such input.
+  int tokens_index_ = -1;
+  int positions_index_ = -1;
+  int mask_index_ = -1;
+  ElementType positions_type_ = ElementType::Int32;
+  // The size of the innermost dimension of the mask, and the number of
+  // [chunk_size, mask_kv_size] matrices it holds.
+  size_t mask_kv_size_ = 0;
+  size_t mask_repeats_ = 0;
+};
+
+}  // namespace litert
+
+#endif  // ODML_LITERT_LITERT_CC_LITERT_CHUNKED_PREFILL_H_
@@ -0,0 +1,136 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/cc/litert_chunked_prefill.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/cc/litert_common.h"
+#include "litert/cc/litert_compiled_model.h"
+#include "litert/cc/litert_environment.h"
+#include "litert/cc/litert_tensor_buffer.h"
+#include "litert/test/common.h"
+#include "litert/test/matchers.h"
+#include "litert/test/testdata/simple_model_test_vectors.h"
+
+namespace litert {
+namespace {
+
+using ::testing::litert::IsError;
+
+// Takes a [5] int32 token input and returns its [5, 1, 2] embeddings.
+constexpr absl::string_view kEmbeddingModelFileName =
+    "simple_embedding_lookup_op.tflite";
+
+TEST(ChunkedPrefillTest, RunsPromptInChunks) {
+  LITERT_ASSERT_OK_AND_ASSIGN(Environment env, Environment::Create({}));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      CompiledModel compiled_model,
+      CompiledModel::Create(env,
+                            testing::GetTestFilePath(kEmbeddingModelFileName),
+                            HwAccelerators::kCpu));
+  LITERT_ASSERT_OK_AND_ASSIGN(auto input_names,
+                              compiled_model.GetSignatureInputNames());
+  LITERT_ASSERT_OK_AND_ASSIGN(auto output_names,
+                              compiled_model.GetSignatureOutputNames());
+
+  ChunkedPrefill::Options options;
+  options.tokens_input = std::string(input_names[0]);
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      ChunkedPrefill prefill,
+      ChunkedPrefill::Create(compiled_model,
+                             CompiledModel::DefaultSignatureKey(), options));
+  EXPECT_EQ(prefill.ChunkSize(), 5);
+  EXPECT_EQ(prefill.NumChunks(12), 3);
+  EXPECT_EQ(prefill.LastTokenRow(12), 1);
+
+  std::vector<int32_t> tokens(12);
+  std::iota(tokens.begin(), tokens.end(), 0);
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      int64_t next_position,
+      prefill.Run(absl::MakeConstSpan(tokens), /*start_position=*/3));
+  EXPECT_EQ(next_position, 15);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(TensorBuffer output,
+                              prefill.GetOutputBuffer(output_names[0]));
+  LITERT_ASSERT_OK_AND_ASSIGN(size_t output_size, output.PackedSize());
+  EXPECT_EQ(output_size, 5 * 2 * sizeof(float));
+  EXPECT_THAT(prefill.GetOutputBuffer("unknown"), IsError());
+}
+
+TEST(ChunkedPrefillTest, RejectsMissingInputs) {
+  LITERT_ASSERT_OK_AND_ASSIGN(Environment env, Environment::Create({}));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      CompiledModel compiled_model,
+      CompiledModel::Create(env,
+                            testing::GetTestFilePath(kEmbeddingModelFileName),
+                            HwAccelerators::kCpu));
+  LITERT_ASSERT_OK_AND_ASSIGN(auto input_names,
+                              compiled_model.GetSignatureInputNames());
+
+  ChunkedPrefill::Options options;
+  EXPECT_THAT(ChunkedPrefill::Create(compiled_model,
+                                     CompiledModel::DefaultSignatureKey(),
+                                     options),
+              IsError());
+
+  options.tokens_input = std::string(input_names[0]);
+  options.positions_input = "input_pos";
+  EXPECT_THAT(ChunkedPrefill::Create(compiled_model,
+                                     CompiledModel::DefaultSignatureKey(),
+                                     options),
+              IsError());
+}
+
+TEST(ChunkedPrefillTest, RejectsUnboundAndNonTokenInputs) {
+  LITERT_ASSERT_OK_AND_ASSIGN(Environment env, Environment::Create({}));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      CompiledModel compiled_model,
+      CompiledModel::Create(env, testing::GetTestFilePath(kModelFileName),
+                            HwAccelerators::kCpu));
+  LITERT_ASSERT_OK_AND_ASSIGN(auto input_names,
+                              compiled_model.GetSignatureInputNames());
+
+  // The second input of the simple model is neither written nor bound.
+  ChunkedPrefill::Options options;
+  options.tokens_input = std::string(input_names[0]);
+  EXPECT_THAT(ChunkedPrefill::Create(compiled_model,
+                                     CompiledModel::DefaultSignatureKey(),
+                                     options),
+              IsError());
+
+  // The inputs of the simple model are float32, not token ids.
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      TensorBuffer input1,
+      compiled_model.CreateInputBuffer(input_names[1]));
+  absl::flat_hash_map<std::string, TensorBuffer> bound_inputs;
+  bound_inputs.emplace(std::string(input_names[1]), std::move(input1));
+  EXPECT_THAT(ChunkedPrefill::Create(compiled_model,
+                                     CompiledModel::DefaultSignatureKey(),
+                                     options, std::move(bound_inputs)),
+              IsError());
+}
+
+}  // namespace
+}  // namespace litert
@@ -103,7 +103,9 @@ class CompiledModel
   //
   // The model is loaded into memory and the caller takes ownership of the
   // returned CompiledModel object. The caller should keep the model alive
-  // until the CompiledModel is destroyed.
+  // until the CompiledModel is destroyed. If the environment has a compiler
+  // cache directory, the model flatbuffer is verified before it is loaded,
+  // unless the directory records that the file was already verified.
   // The given `compilation_options` is used for the compilation of the model.
   // And compilation_options.hardware_accelerators is used to select the
   // accelerator to use regardless of whether the model is AOT compiled or
@@ -119,8 +121,8 @@ class CompiledModel
                                         Options& compilation_options) {
     LITERT_RETURN_IF_ERROR(compilation_options.Build());
     LiteRtModel litert_model;
-    if (auto status =
-            LiteRtCreateModelFromFile(model_filename.c_str(), &litert_model);
+    if (auto status = LiteRtCreateModelFromFileWithEnvironment(
+            env.Get(), model_filename.c_str(), &litert_model);
         status != kLiteRtStatusOk) {
       return Unexpected(status, "Failed to load model from file");
     }
@@ -185,6 +187,24 @@ class CompiledModel
     return Create(env, model_buffer, compilation_options);
   }
 
+  // Creates a CompiledModel which shares the model of `primary`, i.e. its
+  // weights and any dispatch bytecode, but owns its own interpreter, delegates
+  // and activation memory. Run() can be called concurrently on `primary` and
+  // on every CompiledModel shared from it, each with its own buffers.
+  // compilation_options.hardware_accelerators selects the accelerators.
+  //
+  // Note: `primary` must outlive the returned CompiledModel.
+  static Expected<CompiledModel> CreateShared(const CompiledModel& primary,
+                                              Options& compilation_options) {
+    LITERT_RETURN_IF_ERROR(compilation_options.Build());
+    LiteRtCompiledModel compiled_model;
+    LITERT_RETURN_IF_ERROR(LiteRtCreateSharedCompiledModel(
+        primary.Get(), compilation_options.Get(), &compiled_model));
+    return CompiledModel(primary.model_.Get(), /*model_owned=*/OwnHandle::kNo,
+                         compiled_model,
+                         /*owned=*/OwnHandle::kYes);
+  }
+
   // Get input buffer requirements for the given signature and input name.
   Expected<TensorBufferRequirements> GetInputBufferRequirements(
       absl::string_view signature_name, absl::string_view input_name) {
@@ -559,6 +579,63 @@ class CompiledModel
     return ResizeInputTensor(/*signature_index=*/0, input_name, dims);
   }
 
+  // Sets the shapes ResizeInputTensor resizes the specified input tensor to:
+  // the smallest bucket holding the requested shape is used, and resizing to
+  // the current bucket does nothing. The caller pads the input data to the
+  // bucket shape. An empty list removes the buckets.
+  Expected<void> SetInputShapeBuckets(
+      size_t signature_index, size_t input_index,
+      const std::vector<std::vector<int>>& buckets) {
+    const size_t rank = buckets.empty() ? 0 : buckets.front().size();
+    std::vector<int> bucket_dims;
+    bucket_dims.reserve(buckets.size() * rank);
+    for (const auto& bucket : buckets) {
+      if (bucket.size() != rank) {
+        return Unexpected(Status::kErrorInvalidArgument,
+                          "Shape buckets must have the same rank");
+      }
+      bucket_dims.insert(bucket_dims.end(), bucket.begin(), bucket.end());
+    }
+    LITERT_RETURN_IF_ERROR(LiteRtCompiledModelSetInputShapeBuckets(
+        Get(), signature_index, input_index, bucket_dims.data(),
+        buckets.size(), rank));
+    return {};
+  }
+
+  // Sets the shape buckets of an input of the default signature by name.
+  Expected<void> SetInputShapeBuckets(
+      absl::string_view input_name,
+      const std::vector<std::vector<int>>& buckets) {
+    LITERT_ASSIGN_OR_RETURN(size_t input_index,
+                            FindInputIndex(/*signature_index=*/0, input_name));
+    return SetInputShapeBuckets(/*signature_index=*/0, input_index, buckets);
+  }
+
+  // Releases the memory holding the intermediate tensors of the given
+  // signature. It is allocated again the next time the signature runs.
+  Expected<void> ReleaseSignatureMemory(size_t signature_index) {
+    LITERT_RETURN_IF_ERROR(
+        LiteRtCompiledModelReleaseSignatureMemory(Get(), signature_index));
+    return {};
+  }
+
+  // Releases the memory of the given signature by name.
+  Expected<void> ReleaseSignatureMemory(absl::string_view signature_name) {
+    LITERT_ASSIGN_OR_RETURN(size_t signature_index,
+                            model_.GetSignatureIndex(signature_name));
+    return ReleaseSignatureMemory(signature_index);
+  }
+
+  // Sets the priority of the next runs on their device, and the time after
+  // their start by which they should complete, in milliseconds, or 0 for no
+  // deadline. See LiteRtSetCompiledModelRunPriority().
+  Expected<void> SetRunPriority(LiteRtRunPriority priority,
+                                int64_t deadline_ms = 0) {
+    LITERT_RETURN_IF_ERROR(
+        LiteRtSetCompiledModelRunPriority(Get(), priority, deadline_ms));
+    return {};
+  }
+
   // Reports an error to the compiled model's error reporter.
   // Supports printf-style formatting for error messages.
   template <typename... Args>
@@ -735,6 +812,10 @@ class CompiledModel
   /// Note: The given environment must outlive the compiled model and any
   /// execution running it.
   ///
+  /// Note: If background JIT compilation is enabled in the runtime options,
+  /// the compilation keeps reading `model` after this function returned, so
+  /// releasing the model early is never safe.
+  ///
   /// Note: Even if the model is fully AOT compiled for NPU, you should specify
   /// NPU accelerator in `hardware_accelerators` to use NPU properly.
   static Expected<CompiledModel> Create(litert::Environment& env,
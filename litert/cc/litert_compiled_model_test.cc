@@ -14,7 +14,9 @@
 
 #include "litert/cc/litert_compiled_model.h"
 
+#include <algorithm>
 #include <cstring>
+#include <iterator>
 #include <string>
 #include <utility>
 #include <vector>
@@ -486,6 +488,52 @@ TEST(CompiledModelTest, WithProfiler) {
     EXPECT_THAT(output, Pointwise(FloatNear(1e-5), kTestOutputTensor));
   }
 }
+TEST(CompiledModelTest, ResizeInputTensorToShapeBuckets) {
+  LITERT_ASSERT_OK_AND_ASSIGN(Environment env, litert::Environment::Create({}));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      CompiledModel compiled_model,
+      CompiledModel::Create(env,
+                            testing::GetTestFilePath(kDynamicModelFileName),
+                            HwAccelerators::kCpu));
+
+  // Buckets must match the (?, 2, 3) signature of the input.
+  EXPECT_FALSE(compiled_model.SetInputShapeBuckets("arg0", {{2, 2, 4}}));
+  LITERT_ASSERT_OK(
+      compiled_model.SetInputShapeBuckets("arg0", {{4, 2, 3}, {2, 2, 3}}));
+
+  auto input_buffer_size = [&]() -> size_t {
+    auto requirements =
+        compiled_model.GetInputBufferRequirements(/*input_name=*/"arg0");
+    if (!requirements) {
+      return 0;
+    }
+    auto buffer_size = requirements->BufferSize();
+    return buffer_size ? *buffer_size : 0;
+  };
+
+  // Shapes are rounded up to the smallest bucket holding them.
+  const std::vector<int> dims1 = {1, 2, 3};
+  LITERT_ASSERT_OK(compiled_model.ResizeInputTensor(
+      /*input_name=*/"arg0", absl::MakeConstSpan(dims1)));
+  EXPECT_EQ(input_buffer_size(), 2 * 2 * 3 * sizeof(float));
+
+  const std::vector<int> dims3 = {3, 2, 3};
+  LITERT_ASSERT_OK(compiled_model.ResizeInputTensor(
+      /*input_name=*/"arg0", absl::MakeConstSpan(dims3)));
+  EXPECT_EQ(input_buffer_size(), 4 * 2 * 3 * sizeof(float));
+
+  // No bucket is large enough.
+  const std::vector<int> dims5 = {5, 2, 3};
+  EXPECT_FALSE(compiled_model.ResizeInputTensor(/*input_name=*/"arg0",
+                                                absl::MakeConstSpan(dims5)));
+
+  // Without buckets, the exact shape is used.
+  LITERT_ASSERT_OK(compiled_model.SetInputShapeBuckets("arg0", {}));
+  LITERT_ASSERT_OK(compiled_model.ResizeInputTensor(
+      /*input_name=*/"arg0", absl::MakeConstSpan(dims5)));
+  EXPECT_EQ(input_buffer_size(), 5 * 2 * 3 * sizeof(float));
+}
+
 TEST(CompiledModelTest, ResizeInputTensorWithDynamicModel) {
   // Environment setup.
   LITERT_ASSERT_OK_AND_ASSIGN(Environment env, litert::Environment::Create({}));
@@ -632,6 +680,42 @@ TEST(CompiledModelTest, ResizeInputTensorWithDynamicModel) {
   }
 }
 // Test error reporter with BufferErrorReporter mode
+TEST(CompiledModelTest, LazySignatureAllocation) {
+  LITERT_ASSERT_OK_AND_ASSIGN(Environment env, litert::Environment::Create({}));
+
+  LITERT_ASSERT_OK_AND_ASSIGN(Options compilation_options, Options::Create());
+  compilation_options.SetHardwareAccelerators(HwAccelerators::kCpu);
+  LITERT_ASSERT_OK_AND_ASSIGN(auto runtime_options, RuntimeOptions::Create());
+  LITERT_ASSERT_OK(runtime_options.SetLazySignatureAllocation(true));
+  LITERT_ASSERT_OK(
+      compilation_options.AddOpaqueOptions(std::move(runtime_options)));
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      CompiledModel compiled_model,
+      CompiledModel::Create(env, testing::GetTestFilePath(kModelFileName),
+                            compilation_options));
+  LITERT_ASSERT_OK_AND_ASSIGN(std::vector<TensorBuffer> input_buffers,
+                              compiled_model.CreateInputBuffers());
+  LITERT_ASSERT_OK_AND_ASSIGN(std::vector<TensorBuffer> output_buffers,
+                              compiled_model.CreateOutputBuffers());
+  ASSERT_TRUE(input_buffers[0].Write<float>(
+      absl::MakeConstSpan(kTestInput0Tensor, kTestInput0Size)));
+  ASSERT_TRUE(input_buffers[1].Write<float>(
+      absl::MakeConstSpan(kTestInput1Tensor, kTestInput1Size)));
+
+  // The signature is allocated by its first run and again after its memory
+  // was released.
+  for (int i = 0; i < 2; ++i) {
+    LITERT_ASSERT_OK(compiled_model.Run(input_buffers, output_buffers));
+    std::vector<float> output(kTestOutputSize);
+    LITERT_ASSERT_OK(output_buffers[0].Read<float>(absl::MakeSpan(output)));
+    EXPECT_THAT(output, Pointwise(FloatNear(1e-5), kTestOutputTensor));
+    LITERT_ASSERT_OK(
+        compiled_model.ReleaseSignatureMemory(/*signature_index=*/0));
+  }
+  EXPECT_FALSE(compiled_model.ReleaseSignatureMemory(/*signature_index=*/1));
+}
+
 TEST(CompiledModelTest, ErrorReporterBufferMode) {
   // Environment setup.
   LITERT_ASSERT_OK_AND_ASSIGN(Environment env, litert::Environment::Create({}));
@@ -915,6 +999,79 @@ TEST(CompiledModelTest, ConstantOutputTensor) {
                             FloatNear(3.0f, 1e-5), FloatNear(4.0f, 1e-5)))
         << "Constant output should not change with different inputs";
   }
+
+  // Overwrite the constant output buffer and verify the next run refills it.
+  const float garbage[] = {0.0f, 0.0f, 0.0f, 0.0f};
+  ASSERT_TRUE(output_buffers[constant_output_idx].Write<float>(
+      absl::MakeConstSpan(garbage, 4)));
+  LITERT_ASSERT_OK(
+      compiled_model.Run(signature_index, input_buffers, output_buffers));
+  {
+    LITERT_ASSERT_OK_AND_ASSIGN(
+        auto lock_and_addr, litert::TensorBufferScopedLock::Create<const float>(
+                                output_buffers[constant_output_idx],
+                                TensorBuffer::LockMode::kRead));
+    auto output = absl::MakeSpan(lock_and_addr.second, 4);
+    EXPECT_THAT(output,
+                ElementsAre(FloatNear(1.0f, 1e-5), FloatNear(2.0f, 1e-5),
+                            FloatNear(3.0f, 1e-5), FloatNear(4.0f, 1e-5)))
+        << "Constant output should be restored after the buffer is written";
+  }
+}
+
+TEST(CompiledModelTest, ConstantOutputTensorInWrappedHostMemory) {
+  LITERT_ASSERT_OK_AND_ASSIGN(Environment env, litert::Environment::Create({}));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      CompiledModel compiled_model,
+      CompiledModel::Create(
+          env, testing::GetTestFilePath(kConstantOutputTensorModelFileName),
+          HwAccelerators::kCpu));
+  size_t signature_index = 0;
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<TensorBuffer> input_buffers,
+      compiled_model.CreateInputBuffers(signature_index));
+  const float input_data[] = {5.0f, 10.0f};
+  ASSERT_TRUE(
+      input_buffers[0].Write<float>(absl::MakeConstSpan(input_data, 2)));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<TensorBuffer> output_buffers,
+      compiled_model.CreateOutputBuffers(signature_index));
+  ASSERT_EQ(output_buffers.size(), 2);
+  int constant_output_idx = -1;
+  for (int i = 0; i < 2; i++) {
+    LITERT_ASSERT_OK_AND_ASSIGN(auto size, output_buffers[i].Size());
+    if (size == 4 * sizeof(float)) {
+      constant_output_idx = i;
+    }
+  }
+  ASSERT_NE(constant_output_idx, -1) << "Could not find constant output";
+
+  // The constant output goes to memory of the caller.
+  alignas(LITERT_HOST_MEMORY_BUFFER_ALIGNMENT) float constant_output[4] = {};
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      RankedTensorType constant_output_type,
+      output_buffers[constant_output_idx].TensorType());
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      output_buffers[constant_output_idx],
+      TensorBuffer::CreateFromHostMemory(env, constant_output_type,
+                                         constant_output,
+                                         sizeof(constant_output)));
+  LITERT_ASSERT_OK(
+      compiled_model.Run(signature_index, input_buffers, output_buffers));
+  EXPECT_THAT(constant_output,
+              ElementsAre(FloatNear(1.0f, 1e-5), FloatNear(2.0f, 1e-5),
+                          FloatNear(3.0f, 1e-5), FloatNear(4.0f, 1e-5)));
+
+  // Overwrite the memory directly, without going through the buffer, and
+  // verify the next run refills it.
+  std::fill(std::begin(constant_output), std::end(constant_output), 0.0f);
+  LITERT_ASSERT_OK(
+      compiled_model.Run(signature_index, input_buffers, output_buffers));
+  EXPECT_THAT(constant_output,
+              ElementsAre(FloatNear(1.0f, 1e-5), FloatNear(2.0f, 1e-5),
+                          FloatNear(3.0f, 1e-5), FloatNear(4.0f, 1e-5)))
+      << "Constant output should be restored after its memory is written";
 }
 
 TEST(CompiledModelTest, ExternalTensorBinding) {
@@ -25,6 +25,20 @@
 #include "litert/cc/litert_tensor_buffer.h"
 
 namespace litert {
+namespace {
+
+std::vector<TensorBuffer> WrapTensorBuffers(
+    size_t num_buffers, const LiteRtTensorBuffer* buffers) {
+  std::vector<TensorBuffer> tensor_buffers;
+  tensor_buffers.reserve(num_buffers);
+  for (auto i = 0; i < num_buffers; ++i) {
+    tensor_buffers.push_back(
+        TensorBuffer::WrapCObject(buffers[i], OwnHandle::kNo));
+  }
+  return tensor_buffers;
+}
+
+}  // namespace
 
 LiteRtStatus CustomOpKernel::InitHelper(void* user_data, const void* init_data,
                                         size_t init_data_size) {
@@ -68,19 +82,27 @@ LiteRtStatus CustomOpKernel::RunHelper(void* user_data, size_t num_inputs,
                                        LiteRtTensorBuffer* outputs) {
   auto* self = static_cast<CustomOpKernel*>(user_data);
 
-  std::vector<TensorBuffer> inputs_;
-  inputs_.reserve(num_inputs);
-  for (auto i = 0; i < num_inputs; ++i) {
-    inputs_.push_back(TensorBuffer::WrapCObject(inputs[i], OwnHandle::kNo));
-  }
+  std::vector<TensorBuffer> inputs_ = WrapTensorBuffers(num_inputs, inputs);
+  std::vector<TensorBuffer> outputs_ = WrapTensorBuffers(num_outputs, outputs);
 
-  std::vector<TensorBuffer> outputs_;
-  outputs_.reserve(num_outputs);
-  for (auto i = 0; i < num_outputs; ++i) {
-    outputs_.push_back(TensorBuffer::WrapCObject(outputs[i], OwnHandle::kNo));
+  if (auto status = self->Run(inputs_, outputs_); !status) {
+    LITERT_LOG(LITERT_ERROR, "%s", status.Error().Message().c_str());
+    return status.Error().Status();
   }
 
-  if (auto status = self->Run(inputs_, outputs_); !status) {
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus CustomOpKernel::RunAsyncHelper(void* user_data, size_t num_inputs,
+                                            const LiteRtTensorBuffer* inputs,
+                                            size_t num_outputs,
+                                            LiteRtTensorBuffer* outputs) {
+  auto* self = static_cast<CustomOpKernel*>(user_data);
+
+  std::vector<TensorBuffer> inputs_ = WrapTensorBuffers(num_inputs, inputs);
+  std::vector<TensorBuffer> outputs_ = WrapTensorBuffers(num_outputs, outputs);
+
+  if (auto status = self->RunAsync(inputs_, outputs_); !status) {
     LITERT_LOG(LITERT_ERROR, "%s", status.Error().Message().c_str());
     return status.Error().Status();
   }
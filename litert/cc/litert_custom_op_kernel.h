@@ -43,6 +43,16 @@ class CustomOpKernel {
   virtual Expected<void> Run(const std::vector<TensorBuffer>& inputs,
                              std::vector<TensorBuffer>& outputs) = 0;
 
+  // Runs the op on buffers in their native buffer type, without waiting on
+  // them. Inputs may have events (TensorBuffer::HasEvent()) that the op must
+  // wait on, and the op may set events on its outputs instead of waiting for
+  // its own completion, so that GPU or DSP ops stay asynchronous. The default
+  // implementation calls Run(), whose buffer locks wait on the input events.
+  virtual Expected<void> RunAsync(const std::vector<TensorBuffer>& inputs,
+                                  std::vector<TensorBuffer>& outputs) {
+    return Run(inputs, outputs);
+  }
+
   virtual Expected<void> Destroy() = 0;
 
  protected:
@@ -51,6 +61,7 @@ class CustomOpKernel {
     custom_op_kernel_.GetOutputLayouts = GetOutputLayoutsHelper;
     custom_op_kernel_.Run = RunHelper;
     custom_op_kernel_.Destroy = DestroyHelper;
+    custom_op_kernel_.RunAsync = RunAsyncHelper;
   }
 
  private:
@@ -65,6 +76,10 @@ class CustomOpKernel {
                                 size_t num_outputs,
                                 LiteRtTensorBuffer* outputs);
   static LiteRtStatus DestroyHelper(void* user_data);
+  static LiteRtStatus RunAsyncHelper(void* user_data, size_t num_inputs,
+                                     const LiteRtTensorBuffer* inputs,
+                                     size_t num_outputs,
+                                     LiteRtTensorBuffer* outputs);
 
   LiteRtCustomOpKernel custom_op_kernel_;
 };
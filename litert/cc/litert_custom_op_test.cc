@@ -99,6 +99,27 @@ class MyCustomOpKernel : public CustomOpKernel {
   const std::string kOpName = "MyCustomOp";
 };
 
+// Records the calls to RunAsync(), which the dispatcher prefers over Run().
+class MyAsyncCustomOpKernel : public MyCustomOpKernel {
+ public:
+  Expected<void> RunAsync(const std::vector<TensorBuffer>& inputs,
+                          std::vector<TensorBuffer>& outputs) override {
+    ++num_async_runs_;
+    for (const auto& input : inputs) {
+      if (input.HasEvent()) {
+        return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                          "Unexpected input event");
+      }
+    }
+    return Run(inputs, outputs);
+  }
+
+  int num_async_runs() const { return num_async_runs_; }
+
+ private:
+  int num_async_runs_ = 0;
+};
+
 TEST(CompiledModelTest, CustomOp) {
   // Environment setup.
   LITERT_ASSERT_OK_AND_ASSIGN(Environment env, litert::Environment::Create({}));
@@ -144,5 +165,39 @@ TEST(CompiledModelTest, CustomOp) {
   }
 }
 
+TEST(CompiledModelTest, AsyncCustomOp) {
+  LITERT_ASSERT_OK_AND_ASSIGN(Environment env, litert::Environment::Create({}));
+
+  LITERT_ASSERT_OK_AND_ASSIGN(Options options, Options::Create());
+  options.SetHardwareAccelerators(HwAccelerators::kCpu);
+
+  MyAsyncCustomOpKernel my_custom_op_kernel;
+  ASSERT_TRUE(options.AddCustomOpKernel(my_custom_op_kernel));
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      CompiledModel compiled_model,
+      CompiledModel::Create(env, testing::GetTestFilePath(kModelFileName),
+                            options));
+
+  LITERT_ASSERT_OK_AND_ASSIGN(std::vector<TensorBuffer> input_buffers,
+                              compiled_model.CreateInputBuffers());
+  LITERT_ASSERT_OK_AND_ASSIGN(std::vector<TensorBuffer> output_buffers,
+                              compiled_model.CreateOutputBuffers());
+  ASSERT_TRUE(input_buffers[0].Write<float>(
+      absl::MakeConstSpan(kTestInput0Tensor, kTestInput0Size)));
+  ASSERT_TRUE(input_buffers[1].Write<float>(
+      absl::MakeConstSpan(kTestInput1Tensor, kTestInput1Size)));
+
+  ASSERT_TRUE(compiled_model.Run(input_buffers, output_buffers));
+  EXPECT_EQ(my_custom_op_kernel.num_async_runs(), 1);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto lock_and_addr,
+      litert::TensorBufferScopedLock::Create<const float>(
+          output_buffers[0], TensorBuffer::LockMode::kRead));
+  auto output = absl::MakeSpan(lock_and_addr.second, kTestOutputSize);
+  EXPECT_THAT(output, Pointwise(FloatNear(1e-5), kTestOutputTensor));
+}
+
 }  // namespace
 }  // namespace litert
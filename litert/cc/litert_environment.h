@@ -15,6 +15,7 @@
 #ifndef ODML_LITERT_LITERT_CC_LITERT_ENVIRONMENT_H_
 #define ODML_LITERT_LITERT_CC_LITERT_ENVIRONMENT_H_
 
+#include <cstddef>
 #include <vector>
 
 #include "absl/types/span.h"  // from @com_google_absl
@@ -56,6 +57,9 @@ class Environment
     CompilerCacheDir = kLiteRtEnvOptionTagCompilerCacheDir,
     WebGpuInstance = kLiteRtEnvOptionTagWebGpuInstance,
     WebGpuProcs = kLiteRtEnvOptionTagWebGpuProcs,
+    CompilerCacheMaxSize = kLiteRtEnvOptionTagCompilerCacheMaxSize,
+    TensorBufferPoolMaxSize = kLiteRtEnvOptionTagTensorBufferPoolMaxSize,
+    CpuThreadPool = kLiteRtEnvOptionTagCpuThreadPool,
   };
 
   struct Option {
@@ -117,6 +121,16 @@ class Environment
     return is_supported;
   }
 
+  // Releases the memory that the environment and its compiled models can
+  // rebuild on demand, in response to a memory pressure signal of the system.
+  // Returns the number of bytes freed.
+  Expected<size_t> TrimMemory(LiteRtTrimMemoryLevel level) {
+    size_t num_freed_bytes = 0;
+    LITERT_RETURN_IF_ERROR(
+        LiteRtEnvironmentTrimMemory(Get(), level, &num_freed_bytes));
+    return num_freed_bytes;
+  }
+
   ///  \internal Wraps a LiteRtEnvironment C object in a Environment C++ object.
   ///
   /// Warning: This is internal use only.
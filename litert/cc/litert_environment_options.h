@@ -63,6 +63,9 @@ class EnvironmentOptions
     // Dawn procedure table pointer for shared libraries to populate their
     // tables with the shared procedures instead of their own procedures.
     kWebGpuProcs = kLiteRtEnvOptionTagWebGpuProcs,
+    kCompilerCacheMaxSize = kLiteRtEnvOptionTagCompilerCacheMaxSize,
+    kTensorBufferPoolMaxSize = kLiteRtEnvOptionTagTensorBufferPoolMaxSize,
+    kCpuThreadPool = kLiteRtEnvOptionTagCpuThreadPool,
   };
 
   Expected<LiteRtVariant> GetOption(Tag tag) const {
@@ -77,8 +77,9 @@ class Event : public internal::Handle<LiteRtEvent, LiteRtDestroyEvent> {
     return Event(event, OwnHandle::kYes);
   }
 
-  // Creates a managed event of the given `type`. Currently only
-  // LiteRtEventTypeOpenCl is supported.
+  // Creates a managed event of the given `type`. Currently
+  // LiteRtEventTypeOpenCl, LiteRtEventTypeEglSyncFence,
+  // LiteRtEventTypeEglNativeSyncFence and LiteRtEventTypeHost are supported.
   static Expected<Event> CreateManaged(LiteRtEnvironment env,
                                        LiteRtEventType type) {
     LiteRtEvent event;
@@ -118,6 +119,14 @@ class Event : public internal::Handle<LiteRtEvent, LiteRtDestroyEvent> {
     return {};
   }
 
+  // Signals the event with the `status` of the operation it tracks, which
+  // waiting on it then returns.
+  // Note: Only host events can be signaled with an error.
+  Expected<void> Signal(LiteRtStatus status) {
+    LITERT_RETURN_IF_ERROR(LiteRtSignalEventWithStatus(Get(), status));
+    return {};
+  }
+
   // Returns true if the event is signaled.
   // Note: This is only supported for sync fence events.
   Expected<bool> IsSignaled() {
@@ -15,6 +15,7 @@
 #include "litert/cc/litert_event.h"
 
 #include <gtest/gtest.h>
+#include "litert/c/litert_common.h"
 #include "litert/c/litert_event_type.h"
 #include "litert/cc/internal/litert_platform_support.h"
 #include "litert/cc/litert_environment.h"
@@ -61,5 +62,37 @@ TEST(Event, CreateManagedEglNativeSyncFence) {
   EXPECT_EQ(event.Type(), LiteRtEventTypeEglNativeSyncFence);
 }
 
+TEST(Event, CreateManagedHost) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto env, litert::Environment::Create({}));
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      Event event, Event::CreateManaged(env.Get(), LiteRtEventTypeHost));
+  EXPECT_EQ(event.Type(), LiteRtEventTypeHost);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(bool is_signaled, event.IsSignaled());
+  EXPECT_FALSE(is_signaled);
+  EXPECT_FALSE(event.Wait(/*timeout_in_ms=*/1));
+
+  LITERT_ASSERT_OK(event.Signal());
+  LITERT_ASSERT_OK_AND_ASSIGN(is_signaled, event.IsSignaled());
+  EXPECT_TRUE(is_signaled);
+  LITERT_EXPECT_OK(event.Wait());
+  // A host event can only be signaled once.
+  EXPECT_FALSE(event.Signal());
+}
+
+TEST(Event, SignalHostWithError) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto env, litert::Environment::Create({}));
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      Event event, Event::CreateManaged(env.Get(), LiteRtEventTypeHost));
+  LITERT_ASSERT_OK(event.Signal(kLiteRtStatusErrorRuntimeFailure));
+  LITERT_ASSERT_OK_AND_ASSIGN(bool is_signaled, event.IsSignaled());
+  EXPECT_TRUE(is_signaled);
+  auto result = event.Wait();
+  ASSERT_FALSE(result);
+  EXPECT_EQ(result.Error().Status(), kLiteRtStatusErrorRuntimeFailure);
+}
+
 }  // namespace
 }  // namespace litert
@@ -201,6 +201,19 @@ class Model : public internal::Handle<LiteRtModel, LiteRtDestroyModel> {
     return CreateFromOwnedHandle(model);
   }
 
+  // Maps `length` bytes of `fd` starting at `offset` without copying them.
+  // `fd` can be closed once this returns.
+  static Expected<Model> CreateFromFileDescriptor(int fd, size_t offset,
+                                                  size_t length) {
+    LiteRtModel model;
+    if (auto status =
+            LiteRtCreateModelFromFileDescriptor(fd, offset, length, &model);
+        status != kLiteRtStatusOk) {
+      return Unexpected(status, "Failed to load model from file descriptor");
+    }
+    return CreateFromOwnedHandle(model);
+  }
+
   // The caller must ensure that the buffer remains valid for the lifetime of
   // the model.
   static Expected<Model> CreateFromBuffer(BufferRef<uint8_t> buffer) {
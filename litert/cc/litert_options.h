@@ -75,6 +75,21 @@ class Options : public internal::Handle<LiteRtOptions, LiteRtDestroyOptions> {
     return accelerators;
   }
 
+  // Lets the compiled model select its hardware accelerators, see
+  // `LiteRtSetOptionsAutoHardwareAccelerators`.
+  Expected<void> SetAutoHardwareAccelerators(bool enabled) {
+    LITERT_RETURN_IF_ERROR(
+        LiteRtSetOptionsAutoHardwareAccelerators(Get(), enabled));
+    return {};
+  }
+
+  Expected<bool> GetAutoHardwareAccelerators() {
+    bool enabled;
+    LITERT_RETURN_IF_ERROR(
+        LiteRtGetOptionsAutoHardwareAccelerators(Get(), &enabled));
+    return enabled;
+  }
+
   [[deprecated("Use the GetXXXOptions() methods instead.")]]
   Expected<void> AddOpaqueOptions(OpaqueOptions&& options) {
     LITERT_RETURN_IF_ERROR(LiteRtAddOpaqueOptions(Get(), options.Release()));
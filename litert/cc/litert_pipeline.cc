@@ -0,0 +1,367 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/cc/litert_pipeline.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "litert/c/internal/litert_logging.h"
+#include "litert/c/litert_common.h"
+#include "litert/cc/litert_compiled_model.h"
+#include "litert/cc/litert_environment.h"
+#include "litert/cc/litert_event.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/cc/litert_ranked_tensor_type.h"
+#include "litert/cc/litert_tensor_buffer.h"
+#include "litert/cc/litert_tensor_buffer_requirements.h"
+#include "litert/cc/litert_tensor_buffer_types.h"
+
+namespace litert {
+
+namespace {
+
+// Creates the buffer of an output consumed by the inputs in `consumers`, of a
+// type supported by the producer and by all the consumers.
+Expected<TensorBuffer> CreateSharedBuffer(
+    const Environment& env, const Pipeline::Stage& producer,
+    size_t producer_output, const std::vector<Pipeline::Stage>& stages,
+    const std::vector<Pipeline::Connection>& consumers) {
+  const CompiledModel& model = *producer.compiled_model;
+  LITERT_ASSIGN_OR_RETURN(
+      TensorBufferRequirements producer_requirements,
+      model.GetOutputBufferRequirements(producer.signature_index,
+                                        producer_output));
+  LITERT_ASSIGN_OR_RETURN(std::vector<TensorBufferType> types,
+                          producer_requirements.SupportedTypesCC());
+  LITERT_ASSIGN_OR_RETURN(size_t buffer_size,
+                          producer_requirements.BufferSize());
+
+  for (const auto& connection : consumers) {
+    const auto& consumer = stages[connection.consumer_stage];
+    LITERT_ASSIGN_OR_RETURN(
+        TensorBufferRequirements consumer_requirements,
+        consumer.compiled_model->GetInputBufferRequirements(
+            consumer.signature_index, connection.consumer_input));
+    LITERT_ASSIGN_OR_RETURN(std::vector<TensorBufferType> consumer_types,
+                            consumer_requirements.SupportedTypesCC());
+    LITERT_ASSIGN_OR_RETURN(size_t consumer_size,
+                            consumer_requirements.BufferSize());
+    buffer_size = std::max(buffer_size, consumer_size);
+    auto is_unsupported = [&consumer_types](TensorBufferType type) {
+      return std::find(consumer_types.begin(), consumer_types.end(), type) ==
+             consumer_types.end();
+    };
+    types.erase(std::remove_if(types.begin(), types.end(), is_unsupported),
+                types.end());
+  }
+  if (types.empty()) {
+    return Unexpected(
+        kLiteRtStatusErrorUnsupported,
+        absl::StrFormat("Output %d of a stage has no buffer type supported by "
+                        "all its consumers",
+                        producer_output));
+  }
+
+  LITERT_ASSIGN_OR_RETURN(
+      RankedTensorType tensor_type,
+      model.GetOutputTensorType(producer.signature_index, producer_output));
+  return TensorBuffer::CreateManaged(env, types[0], tensor_type, buffer_size);
+}
+
+// Waits for the events attached to `buffers`, if any.
+Expected<void> WaitForEvents(const std::vector<TensorBuffer>& buffers) {
+  for (const auto& buffer : buffers) {
+    if (buffer.HasEvent()) {
+      LITERT_ASSIGN_OR_RETURN(Event event, buffer.GetEvent());
+      LITERT_RETURN_IF_ERROR(event.Wait());
+    }
+  }
+  return {};
+}
+
+}  // namespace
+
+Expected<Pipeline> Pipeline::Create(const Environment& env,
+                                    std::vector<Stage> stages,
+                                    const std::vector<Connection>& connections,
+                                    size_t frames_in_flight) {
+  if (stages.empty()) {
+    return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                      "A pipeline needs at least one stage");
+  }
+  if (frames_in_flight == 0) {
+    return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                      "A pipeline needs at least one frame in flight");
+  }
+
+  std::vector<size_t> num_inputs(stages.size());
+  std::vector<size_t> num_outputs(stages.size());
+  for (size_t i = 0; i < stages.size(); ++i) {
+    const auto& stage = stages[i];
+    if (stage.compiled_model == nullptr) {
+      return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                        "A pipeline stage has no compiled model");
+    }
+    LITERT_ASSIGN_OR_RETURN(
+        auto input_names,
+        stage.compiled_model->GetSignatureInputNames(stage.signature_index));
+    LITERT_ASSIGN_OR_RETURN(
+        auto output_names,
+        stage.compiled_model->GetSignatureOutputNames(stage.signature_index));
+    num_inputs[i] = input_names.size();
+    num_outputs[i] = output_names.size();
+  }
+
+  // The connection feeding each input, if any, and the connections fed by
+  // each output.
+  std::vector<std::vector<std::optional<Connection>>> input_sources(
+      stages.size());
+  std::vector<std::vector<std::vector<Connection>>> output_consumers(
+      stages.size());
+  for (size_t i = 0; i < stages.size(); ++i) {
+    input_sources[i].resize(num_inputs[i]);
+    output_consumers[i].resize(num_outputs[i]);
+  }
+  for (const auto& connection : connections) {
+    if (connection.consumer_stage >= stages.size() ||
+        connection.producer_stage >= connection.consumer_stage) {
+      return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                        "A connection must go from a stage to a later one");
+    }
+    if (connection.producer_output >= num_outputs[connection.producer_stage] ||
+        connection.consumer_input >= num_inputs[connection.consumer_stage]) {
+      return Unexpected(kLiteRtStatusErrorIndexOOB,
+                        "Connection tensor index is out of range");
+    }
+    auto& source =
+        input_sources[connection.consumer_stage][connection.consumer_input];
+    if (source.has_value()) {
+      return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                        "An input can only be connected once");
+    }
+    source = connection;
+    output_consumers[connection.producer_stage][connection.producer_output]
+        .push_back(connection);
+  }
+
+  Pipeline pipeline(std::move(stages));
+  pipeline.slots_.resize(frames_in_flight);
+  for (auto& slot : pipeline.slots_) {
+    const size_t num_stages = pipeline.stages_.size();
+    slot.inputs.resize(num_stages);
+    slot.outputs.resize(num_stages);
+    slot.start_times.resize(num_stages);
+    slot.end_times.resize(num_stages);
+    slot.async.resize(num_stages);
+    for (size_t i = 0; i < num_stages; ++i) {
+      const auto& stage = pipeline.stages_[i];
+      LITERT_ASSIGN_OR_RETURN(
+          slot.outputs[i],
+          stage.compiled_model->CreateOutputBuffers(stage.signature_index));
+      for (size_t j = 0; j < num_outputs[i]; ++j) {
+        if (!output_consumers[i][j].empty()) {
+          LITERT_ASSIGN_OR_RETURN(
+              slot.outputs[i][j],
+              CreateSharedBuffer(env, stage, j, pipeline.stages_,
+                                 output_consumers[i][j]));
+        }
+      }
+      LITERT_ASSIGN_OR_RETURN(
+          slot.inputs[i],
+          stage.compiled_model->CreateInputBuffers(stage.signature_index));
+      for (size_t j = 0; j < num_inputs[i]; ++j) {
+        if (const auto& source = input_sources[i][j]; source.has_value()) {
+          LITERT_ASSIGN_OR_RETURN(
+              slot.inputs[i][j],
+              slot.outputs[source->producer_stage][source->producer_output]
+                  .Duplicate());
+        }
+      }
+    }
+  }
+  pipeline.stats_.stages.resize(pipeline.stages_.size());
+  pipeline.last_end_times_.resize(pipeline.stages_.size());
+  return pipeline;
+}
+
+Pipeline::~Pipeline() {
+  // The buffers must not be released while a stage may still use them.
+  for (auto& slot : slots_) {
+    if (slot.state == SlotState::kSubmitted) {
+      if (auto res = Complete(slot); !res) {
+        LITERT_LOG(LITERT_ERROR, "Failed to complete frame %d: %s",
+                   static_cast<int>(slot.frame), res.Error().Message().c_str());
+      }
+    }
+  }
+}
+
+Expected<uint64_t> Pipeline::BeginFrame() {
+  const uint64_t frame = next_frame_;
+  FrameSlot& slot = slots_[frame % slots_.size()];
+  if (slot.state == SlotState::kAcquired) {
+    return Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                      "The previous frame of the slot was never submitted");
+  }
+  if (slot.state == SlotState::kSubmitted) {
+    LITERT_RETURN_IF_ERROR(Complete(slot));
+  }
+  // Stages refuse output buffers with events attached, and the events of the
+  // previous frame are all signaled by now.
+  for (auto* buffers : {&slot.inputs, &slot.outputs}) {
+    for (auto& stage_buffers : *buffers) {
+      for (auto& buffer : stage_buffers) {
+        if (buffer.HasEvent()) {
+          LITERT_RETURN_IF_ERROR(buffer.ClearEvent());
+        }
+      }
+    }
+  }
+  slot.frame = frame;
+  slot.state = SlotState::kAcquired;
+  ++next_frame_;
+  return frame;
+}
+
+Expected<TensorBuffer> Pipeline::GetInputBuffer(uint64_t frame, size_t stage,
+                                                size_t input_index) const {
+  LITERT_ASSIGN_OR_RETURN(const FrameSlot* slot, GetSlot(frame));
+  if (stage >= slot->inputs.size() ||
+      input_index >= slot->inputs[stage].size()) {
+    return Unexpected(kLiteRtStatusErrorIndexOOB,
+                      "Input index is out of range");
+  }
+  return slot->inputs[stage][input_index].Duplicate();
+}
+
+Expected<TensorBuffer> Pipeline::GetOutputBuffer(uint64_t frame, size_t stage,
+                                                 size_t output_index) const {
+  LITERT_ASSIGN_OR_RETURN(const FrameSlot* slot, GetSlot(frame));
+  if (stage >= slot->outputs.size() ||
+      output_index >= slot->outputs[stage].size()) {
+    return Unexpected(kLiteRtStatusErrorIndexOOB,
+                      "Output index is out of range");
+  }
+  return slot->outputs[stage][output_index].Duplicate();
+}
+
+Expected<void> Pipeline::Submit(uint64_t frame) {
+  LITERT_ASSIGN_OR_RETURN(FrameSlot * slot,
+                          GetSlot(frame, SlotState::kAcquired));
+  for (size_t i = 0; i < stages_.size(); ++i) {
+    const auto& stage = stages_[i];
+    bool async = true;
+    slot->start_times[i] = Clock::now();
+    if (!started_) {
+      started_ = true;
+      first_start_ = slot->start_times[i];
+    }
+    auto res = stage.compiled_model->RunAsync(
+        stage.signature_index, slot->inputs[i], slot->outputs[i], async);
+    if (!res) {
+      // Let the stages already running finish before the buffers can be
+      // reused by another frame.
+      for (size_t j = 0; j < i; ++j) {
+        if (slot->async[j]) {
+          LITERT_RETURN_IF_ERROR(WaitForEvents(slot->outputs[j]));
+        }
+      }
+      slot->state = SlotState::kFree;
+      return res;
+    }
+    slot->async[i] = async;
+    if (!async) {
+      slot->end_times[i] = Clock::now();
+    }
+  }
+  slot->state = SlotState::kSubmitted;
+  return {};
+}
+
+Expected<void> Pipeline::Wait(uint64_t frame) {
+  LITERT_ASSIGN_OR_RETURN(FrameSlot * slot,
+                          GetSlot(frame, SlotState::kSubmitted));
+  return Complete(*slot);
+}
+
+Pipeline::Stats Pipeline::GetStats() const {
+  Stats stats = stats_;
+  stats.wall_time = started_ ? last_end_ - first_start_ : Clock::duration{};
+  if (stats.wall_time > Clock::duration::zero()) {
+    for (auto& stage : stats.stages) {
+      stage.occupancy =
+          std::chrono::duration<double>(stage.busy_time).count() /
+          std::chrono::duration<double>(stats.wall_time).count();
+    }
+  }
+  return stats;
+}
+
+Expected<Pipeline::FrameSlot*> Pipeline::GetSlot(uint64_t frame,
+                                                 SlotState state) {
+  FrameSlot& slot = slots_[frame % slots_.size()];
+  if (slot.frame != frame || slot.state != state) {
+    return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                      absl::StrFormat("Frame %d is not in the expected state",
+                                      frame));
+  }
+  return &slot;
+}
+
+Expected<const Pipeline::FrameSlot*> Pipeline::GetSlot(uint64_t frame) const {
+  const FrameSlot& slot = slots_[frame % slots_.size()];
+  if (slot.frame != frame || slot.state == SlotState::kFree) {
+    return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                      absl::StrFormat("Frame %d is not in flight", frame));
+  }
+  return &slot;
+}
+
+Expected<void> Pipeline::Complete(FrameSlot& slot) {
+  // The slot is released even on failure, so that it can be reused.
+  slot.state = SlotState::kFree;
+  Clock::time_point frame_end = slot.start_times[0];
+  for (size_t i = 0; i < stages_.size(); ++i) {
+    if (slot.async[i]) {
+      LITERT_RETURN_IF_ERROR(WaitForEvents(slot.outputs[i]));
+      // Events are waited for in stage order, so this is an upper bound of
+      // the completion time of the stage.
+      slot.end_times[i] = Clock::now();
+    }
+    auto& stage_stats = stats_.stages[i];
+    const Clock::time_point busy_start =
+        std::max(slot.start_times[i], last_end_times_[i]);
+    if (slot.end_times[i] > busy_start) {
+      stage_stats.busy_time += slot.end_times[i] - busy_start;
+    }
+    last_end_times_[i] = std::max(last_end_times_[i], slot.end_times[i]);
+    ++stage_stats.num_runs;
+    stage_stats.num_async_runs += slot.async[i] ? 1 : 0;
+    frame_end = std::max(frame_end, slot.end_times[i]);
+  }
+  ++stats_.num_frames;
+  stats_.total_latency += frame_end - slot.start_times[0];
+  last_end_ = std::max(last_end_, frame_end);
+  return {};
+}
+
+}  // namespace litert
@@ -0,0 +1,169 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_CC_LITERT_PIPELINE_H_
+#define ODML_LITERT_LITERT_CC_LITERT_PIPELINE_H_
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "litert/cc/litert_compiled_model.h"
+#include "litert/cc/litert_environment.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_tensor_buffer.h"
+
+namespace litert {
+
+// The Pipeline chains several CompiledModels, e.g. detector -> crop ->
+// recognizer, and keeps several frames in flight.
+//
+// The output TensorBuffers of a stage are passed as is to the connected inputs
+// of the following stages, so no copy through host memory happens between the
+// stages. All the stages are run with RunAsync(): the synchronization events
+// attached by a stage to its outputs are consumed by the next stage, which
+// lets GPU and NPU stages be chained without blocking the caller.
+//
+// Each of the `frames_in_flight` frame slots owns a full set of buffers, so
+// the caller can prepare the inputs of a frame while the previous ones are
+// still running.
+//
+// Example user flow:
+//
+// 1. Create a Pipeline from the CompiledModels and their connections
+// 2. Call BeginFrame() to get the next frame
+// 3. Fill the unconnected inputs returned by GetInputBuffer()
+// 4. Call Submit() to run all the stages of the frame
+// 5. Call Wait() and read the outputs returned by GetOutputBuffer()
+//
+// Note: The Pipeline is not thread safe.
+class Pipeline {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // A stage of the pipeline. The compiled model must outlive the pipeline.
+  struct Stage {
+    const CompiledModel* compiled_model;
+    size_t signature_index = 0;
+  };
+
+  // Connects an output of a stage to an input of a later stage.
+  struct Connection {
+    size_t producer_stage;
+    size_t producer_output;
+    size_t consumer_stage;
+    size_t consumer_input;
+  };
+
+  struct StageStats {
+    // Number of completed runs.
+    size_t num_runs = 0;
+    // Number of completed runs that were executed asynchronously.
+    size_t num_async_runs = 0;
+    // Time the stage spent running frames, without overlaps between frames.
+    Clock::duration busy_time = Clock::duration::zero();
+    // Ratio of `busy_time` over the wall time of the pipeline.
+    double occupancy = 0.0;
+  };
+
+  struct Stats {
+    // Number of completed frames.
+    size_t num_frames = 0;
+    // Time from the first submission to the last completion.
+    Clock::duration wall_time = Clock::duration::zero();
+    // Sum of the submission to completion time of all the frames.
+    Clock::duration total_latency = Clock::duration::zero();
+    std::vector<StageStats> stages;
+  };
+
+  // Creates a pipeline of `stages` linked by `connections`. A connection must
+  // go from a stage to a later one and each input can be connected once.
+  static Expected<Pipeline> Create(const Environment& env,
+                                   std::vector<Stage> stages,
+                                   const std::vector<Connection>& connections,
+                                   size_t frames_in_flight = 2);
+
+  Pipeline(Pipeline&&) = default;
+  Pipeline& operator=(Pipeline&&) = default;
+  Pipeline(const Pipeline&) = delete;
+  Pipeline& operator=(const Pipeline&) = delete;
+  ~Pipeline();
+
+  size_t NumStages() const { return stages_.size(); }
+  size_t FramesInFlight() const { return slots_.size(); }
+
+  // Reserves the slot of the next frame and returns the frame id. If the frame
+  // previously using the slot is still running, waits for it to complete.
+  Expected<uint64_t> BeginFrame();
+
+  // Returns the buffer bound to the given input of `stage` for `frame`. Inputs
+  // connected to a previous stage are written by the pipeline.
+  Expected<TensorBuffer> GetInputBuffer(uint64_t frame, size_t stage,
+                                        size_t input_index) const;
+
+  // Returns the buffer bound to the given output of `stage` for `frame`. Its
+  // content is only valid once Wait() returned.
+  Expected<TensorBuffer> GetOutputBuffer(uint64_t frame, size_t stage,
+                                         size_t output_index) const;
+
+  // Runs all the stages of `frame`, in order, asynchronously if possible.
+  Expected<void> Submit(uint64_t frame);
+
+  // Blocks until all the stages of `frame` have completed.
+  Expected<void> Wait(uint64_t frame);
+
+  // Returns the statistics of the completed frames.
+  Stats GetStats() const;
+
+ private:
+  enum class SlotState { kFree, kAcquired, kSubmitted };
+
+  struct FrameSlot {
+    uint64_t frame = 0;
+    SlotState state = SlotState::kFree;
+    // Buffers indexed by stage, then by signature input / output index.
+    std::vector<std::vector<TensorBuffer>> inputs;
+    std::vector<std::vector<TensorBuffer>> outputs;
+    // Per stage timing of the current frame.
+    std::vector<Clock::time_point> start_times;
+    std::vector<Clock::time_point> end_times;
+    std::vector<bool> async;
+  };
+
+  explicit Pipeline(std::vector<Stage> stages) : stages_(std::move(stages)) {}
+
+  // Returns the slot of `frame` if it is in the given state.
+  Expected<FrameSlot*> GetSlot(uint64_t frame, SlotState state);
+  Expected<const FrameSlot*> GetSlot(uint64_t frame) const;
+
+  // Waits for the outputs of every stage of `slot` and updates the stats.
+  Expected<void> Complete(FrameSlot& slot);
+
+  std::vector<Stage> stages_;
+  std::vector<FrameSlot> slots_;
+  uint64_t next_frame_ = 0;
+
+  Stats stats_;
+  // The completion time of the last frame run by each stage.
+  std::vector<Clock::time_point> last_end_times_;
+  bool started_ = false;
+  Clock::time_point first_start_;
+  Clock::time_point last_end_;
+};
+
+}  // namespace litert
+
+#endif  // ODML_LITERT_LITERT_CC_LITERT_PIPELINE_H_
@@ -0,0 +1,163 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/cc/litert_pipeline.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+#include "litert/cc/litert_common.h"
+#include "litert/cc/litert_compiled_model.h"
+#include "litert/cc/litert_environment.h"
+#include "litert/cc/litert_tensor_buffer.h"
+#include "litert/test/common.h"
+#include "litert/test/matchers.h"
+#include "litert/test/testdata/simple_model_test_vectors.h"
+
+namespace litert {
+namespace {
+
+using ::testing::FloatNear;
+using ::testing::Pointwise;
+using ::testing::litert::IsError;
+
+// Writes `scale` times the test inputs of the simple model to the unconnected
+// inputs of `frame`: both inputs of stage 0 and the second input of stage 1.
+void WriteInputs(const Pipeline& pipeline, uint64_t frame, float scale) {
+  std::vector<float> input0(kTestInput0Tensor,
+                            kTestInput0Tensor + kTestInput0Size);
+  std::vector<float> input1(kTestInput1Tensor,
+                            kTestInput1Tensor + kTestInput1Size);
+  for (auto& v : input0) v *= scale;
+  for (auto& v : input1) v *= scale;
+  LITERT_ASSERT_OK_AND_ASSIGN(TensorBuffer stage0_input0,
+                              pipeline.GetInputBuffer(frame, 0, 0));
+  LITERT_ASSERT_OK(stage0_input0.Write<float>(absl::MakeConstSpan(input0)));
+  LITERT_ASSERT_OK_AND_ASSIGN(TensorBuffer stage0_input1,
+                              pipeline.GetInputBuffer(frame, 0, 1));
+  LITERT_ASSERT_OK(stage0_input1.Write<float>(absl::MakeConstSpan(input1)));
+  LITERT_ASSERT_OK_AND_ASSIGN(TensorBuffer stage1_input1,
+                              pipeline.GetInputBuffer(frame, 1, 1));
+  LITERT_ASSERT_OK(stage1_input1.Write<float>(absl::MakeConstSpan(input1)));
+}
+
+// Checks that stage 1 computed (input0 + input1) + input1.
+void CheckOutput(const Pipeline& pipeline, uint64_t frame, float scale) {
+  std::vector<float> expected(kTestOutputSize);
+  for (size_t i = 0; i < kTestOutputSize; ++i) {
+    expected[i] = (kTestOutputTensor[i] + kTestInput1Tensor[i]) * scale;
+  }
+  LITERT_ASSERT_OK_AND_ASSIGN(TensorBuffer output,
+                              pipeline.GetOutputBuffer(frame, 1, 0));
+  std::vector<float> output_data(kTestOutputSize);
+  LITERT_ASSERT_OK(output.Read<float>(absl::MakeSpan(output_data)));
+  EXPECT_THAT(output_data, Pointwise(FloatNear(1e-5), expected));
+}
+
+TEST(PipelineTest, ChainsStagesWithFramesInFlight) {
+  LITERT_ASSERT_OK_AND_ASSIGN(Environment env, Environment::Create({}));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      CompiledModel first,
+      CompiledModel::Create(env, testing::GetTestFilePath(kModelFileName),
+                            HwAccelerators::kCpu));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      CompiledModel second,
+      CompiledModel::Create(env, testing::GetTestFilePath(kModelFileName),
+                            HwAccelerators::kCpu));
+
+  // The output of the first model is the first input of the second one.
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      Pipeline pipeline,
+      Pipeline::Create(env, {{&first}, {&second}},
+                       {{/*producer_stage=*/0, /*producer_output=*/0,
+                         /*consumer_stage=*/1, /*consumer_input=*/0}},
+                       /*frames_in_flight=*/2));
+  EXPECT_EQ(pipeline.NumStages(), 2);
+  EXPECT_EQ(pipeline.FramesInFlight(), 2);
+
+  constexpr int kNumFrames = 4;
+  std::vector<uint64_t> frames;
+  for (int i = 0; i < kNumFrames; ++i) {
+    // Once two frames are in flight, the oldest one must complete first.
+    if (frames.size() == 2) {
+      LITERT_ASSERT_OK(pipeline.Wait(frames.front()));
+      CheckOutput(pipeline, frames.front(), frames.front() + 1);
+      frames.erase(frames.begin());
+    }
+    LITERT_ASSERT_OK_AND_ASSIGN(uint64_t frame, pipeline.BeginFrame());
+    EXPECT_EQ(frame, static_cast<uint64_t>(i));
+    WriteInputs(pipeline, frame, frame + 1);
+    LITERT_ASSERT_OK(pipeline.Submit(frame));
+    frames.push_back(frame);
+  }
+  for (uint64_t frame : frames) {
+    LITERT_ASSERT_OK(pipeline.Wait(frame));
+    CheckOutput(pipeline, frame, frame + 1);
+  }
+
+  Pipeline::Stats stats = pipeline.GetStats();
+  EXPECT_EQ(stats.num_frames, kNumFrames);
+  ASSERT_EQ(stats.stages.size(), 2);
+  for (const auto& stage : stats.stages) {
+    EXPECT_EQ(stage.num_runs, kNumFrames);
+    EXPECT_GE(stage.occupancy, 0.0);
+    EXPECT_LE(stage.occupancy, 1.0);
+  }
+}
+
+TEST(PipelineTest, RejectsInvalidConnections) {
+  LITERT_ASSERT_OK_AND_ASSIGN(Environment env, Environment::Create({}));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      CompiledModel model,
+      CompiledModel::Create(env, testing::GetTestFilePath(kModelFileName),
+                            HwAccelerators::kCpu));
+
+  EXPECT_THAT(Pipeline::Create(env, {}, {}),
+              IsError(kLiteRtStatusErrorInvalidArgument));
+  // Connections must go forward.
+  EXPECT_THAT(Pipeline::Create(env, {{&model}, {&model}}, {{1, 0, 0, 0}}),
+              IsError(kLiteRtStatusErrorInvalidArgument));
+  // Tensor indices must be in range.
+  EXPECT_THAT(Pipeline::Create(env, {{&model}, {&model}}, {{0, 1, 1, 0}}),
+              IsError(kLiteRtStatusErrorIndexOOB));
+  // An input can only have one producer.
+  EXPECT_THAT(Pipeline::Create(env, {{&model}, {&model}, {&model}},
+                               {{0, 0, 2, 0}, {1, 0, 2, 0}}),
+              IsError(kLiteRtStatusErrorInvalidArgument));
+}
+
+TEST(PipelineTest, FramesMustBeInFlight) {
+  LITERT_ASSERT_OK_AND_ASSIGN(Environment env, Environment::Create({}));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      CompiledModel model,
+      CompiledModel::Create(env, testing::GetTestFilePath(kModelFileName),
+                            HwAccelerators::kCpu));
+  LITERT_ASSERT_OK_AND_ASSIGN(Pipeline pipeline,
+                              Pipeline::Create(env, {{&model}}, {}));
+
+  EXPECT_FALSE(pipeline.GetInputBuffer(/*frame=*/0, 0, 0));
+  LITERT_ASSERT_OK_AND_ASSIGN(uint64_t frame, pipeline.BeginFrame());
+  // The frame has not been submitted yet.
+  EXPECT_FALSE(pipeline.Wait(frame));
+  LITERT_ASSERT_OK(pipeline.Submit(frame));
+  EXPECT_FALSE(pipeline.Submit(frame));
+  LITERT_ASSERT_OK(pipeline.Wait(frame));
+}
+
+}  // namespace
+}  // namespace litert
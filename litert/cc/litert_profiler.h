@@ -14,6 +14,7 @@
 
 #ifndef THIRD_PARTY_ODML_LITERT_LITERT_CC_LITERT_PROFILER_H_
 #define THIRD_PARTY_ODML_LITERT_LITERT_CC_LITERT_PROFILER_H_
+#include <cstdint>
 #include <vector>
 
 #include "litert/c/litert_common.h"
@@ -76,6 +77,37 @@ class Profiler
     return {};
   }
 
+  // Switch to the sampling mode, which only keeps the latency histograms of
+  // the ops of 1 in `sample_every_n_runs` runs and of the runs that take at
+  // least `latency_threshold_us`. Both 0 switch back to recording all events.
+  Expected<void> SetSampling(int sample_every_n_runs,
+                             uint64_t latency_threshold_us) {
+    LITERT_RETURN_IF_ERROR(LiteRtSetProfilerSampling(
+        Get(), sample_every_n_runs, latency_threshold_us));
+    return {};
+  }
+
+  // Get the latencies of the runs seen in the sampling mode.
+  Expected<LiteRtProfilerRunStats> GetRunStats() const {
+    LiteRtProfilerRunStats run_stats;
+    LITERT_RETURN_IF_ERROR(LiteRtGetProfilerRunStats(Get(), &run_stats));
+    return run_stats;
+  }
+
+  // Get the latencies of the ops profiled in the sampling mode.
+  Expected<std::vector<LiteRtProfilerOpStats>> GetOpStats() const {
+    int num_op_stats = -1;
+    LITERT_RETURN_IF_ERROR(LiteRtGetNumProfilerOpStats(Get(), &num_op_stats));
+    if (num_op_stats == 0) {
+      return std::vector<LiteRtProfilerOpStats>();
+    }
+
+    std::vector<LiteRtProfilerOpStats> op_stats(num_op_stats);
+    LITERT_RETURN_IF_ERROR(
+        LiteRtGetProfilerOpStats(Get(), num_op_stats, op_stats.data()));
+    return op_stats;
+  }
+
   // Set the current event source. ProfiledEventSource is used to determine
   // the source of the event [LiteRT, TFLite delegate, TFlite interpreter]
   Expected<void> SetCurrentEventSource(ProfiledEventSource event_source) {
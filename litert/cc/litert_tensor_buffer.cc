@@ -26,6 +26,7 @@
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
 #include "litert/cc/litert_ranked_tensor_type.h"
+#include "litert/cc/litert_tensor_buffer_requirements.h"
 #include "litert/cc/litert_tensor_buffer_types.h"
 
 #if LITERT_HAS_OPENCL_SUPPORT
@@ -62,6 +63,16 @@ Expected<TensorBuffer> TensorBuffer::CreateManaged(
   return TensorBuffer(tensor_buffer, OwnHandle::kYes);
 }
 
+Expected<TensorBuffer> TensorBuffer::CreateManagedFromRequirements(
+    const Environment& env, const RankedTensorType& tensor_type,
+    const TensorBufferRequirements& requirements) {
+  LiteRtTensorBuffer tensor_buffer;
+  auto litert_tensor_type = static_cast<LiteRtRankedTensorType>(tensor_type);
+  LITERT_RETURN_IF_ERROR(LiteRtCreateManagedTensorBufferFromRequirements(
+      env.Get(), &litert_tensor_type, requirements.Get(), &tensor_buffer));
+  return TensorBuffer(tensor_buffer, OwnHandle::kYes);
+}
+
 Expected<TensorBuffer> TensorBuffer::CreateManagedHostMemory(
     const RankedTensorType& tensor_type, size_t buffer_size) {
   LiteRtTensorBuffer tensor_buffer;
@@ -206,6 +217,21 @@ Expected<TensorBuffer> TensorBuffer::CreateFromMetalBuffer(
 }
 #endif  // LITERT_HAS_METAL_SUPPORT
 
+#if LITERT_HAS_VULKAN_SUPPORT
+Expected<TensorBuffer> TensorBuffer::CreateFromVulkanMemory(
+    const Environment& env, const RankedTensorType& tensor_type,
+    TensorBufferType buffer_type, HwMemoryHandle vulkan_memory,
+    size_t size_bytes) {
+  LiteRtTensorBuffer tensor_buffer;
+  auto litert_tensor_type = static_cast<LiteRtRankedTensorType>(tensor_type);
+  LITERT_RETURN_IF_ERROR(LiteRtCreateTensorBufferFromVulkanMemory(
+      env.Get(), &litert_tensor_type,
+      static_cast<LiteRtTensorBufferType>(buffer_type), vulkan_memory,
+      size_bytes, /*deallocator=*/nullptr, &tensor_buffer));
+  return TensorBuffer(tensor_buffer, OwnHandle::kYes);
+}
+#endif  // LITERT_HAS_VULKAN_SUPPORT
+
 bool TensorBuffer::IsOpenClMemory() const {
   LiteRtTensorBufferType tensor_buffer_type;
   if (auto status = LiteRtGetTensorBufferType(Get(), &tensor_buffer_type);
@@ -35,6 +35,7 @@
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
 #include "litert/cc/litert_ranked_tensor_type.h"
+#include "litert/cc/litert_tensor_buffer_requirements.h"
 #include "litert/cc/litert_tensor_buffer_types.h"
 
 #if LITERT_HAS_OPENCL_SUPPORT
@@ -60,6 +61,15 @@ class TensorBuffer
       const Environment& env, TensorBufferType buffer_type,
       const RankedTensorType& tensor_type, size_t buffer_size);
 
+  // Creates a managed TensorBuffer object of the first buffer type supported
+  // by `requirements`, with its buffer size, strides and alignment. Together
+  // with Join(), this allocates a buffer shared by a producer and a consumer,
+  // e.g. the output of a model and the input of the next one. The returned
+  // object is owned by the caller.
+  static Expected<TensorBuffer> CreateManagedFromRequirements(
+      const Environment& env, const RankedTensorType& tensor_type,
+      const TensorBufferRequirements& requirements);
+
   // Creates a managed host memory TensorBuffer object using the
   // default environment (if applicable). The returned object is owned by the
   // caller.
@@ -197,6 +207,16 @@ class TensorBuffer
   }
 #endif  // LITERT_HAS_METAL_SUPPORT
 
+#if LITERT_HAS_VULKAN_SUPPORT
+  // Creates a tensor buffer sharing a Vulkan memory created by the caller, e.g.
+  // imported from an AHardwareBuffer or a DMA-BUF. The caller keeps ownership
+  // of the Vulkan memory.
+  static Expected<TensorBuffer> CreateFromVulkanMemory(
+      const Environment& env, const RankedTensorType& tensor_type,
+      TensorBufferType buffer_type, HwMemoryHandle vulkan_memory,
+      size_t size_bytes);
+#endif  // LITERT_HAS_VULKAN_SUPPORT
+
   // Creates a duplicate of the current TensorBuffer object. The returned
   // object is reference counted so the underlying LiteRtTensorBuffer handle is
   // not released with the destructor until the last reference is removed.
@@ -428,6 +448,16 @@ class TensorBuffer
     return host_mem_addr;
   }
 
+  // Locks the `size` bytes starting at `offset` and returns the address of the
+  // first one. A write lock only syncs back this range to the H/W buffer.
+  Expected<void*> LockRange(size_t offset, size_t size,
+                            LockMode mode = LockMode::kWrite) {
+    void* host_mem_addr;
+    LITERT_RETURN_IF_ERROR(LiteRtLockTensorBufferRange(
+        Get(), offset, size, &host_mem_addr, ToLiteRtLockMode(mode)));
+    return host_mem_addr;
+  }
+
   Expected<void> Unlock() {
     LITERT_RETURN_IF_ERROR(LiteRtUnlockTensorBuffer(Get()));
     return {};
@@ -183,6 +183,59 @@ TEST(TensorBufferRequirements, JoinFailure) {
   ASSERT_FALSE(joint_requirements);
 }
 
+TEST(TensorBufferRequirements, JoinPrefersDeviceBufferTypes) {
+  constexpr const std::array kSupportedTensorBufferTypes1 = {
+      litert::TensorBufferType::kHostMemory,
+      litert::TensorBufferType::kAhwb,
+  };
+  constexpr const std::array kSupportedTensorBufferTypes2 = {
+      litert::TensorBufferType::kAhwb,
+      litert::TensorBufferType::kHostMemory,
+  };
+
+  auto src_requirements_1 = litert::TensorBufferRequirements::Create(
+      absl::MakeSpan(kSupportedTensorBufferTypes1.data(),
+                     kSupportedTensorBufferTypes1.size()),
+      kBufferSize);
+  ASSERT_TRUE(src_requirements_1);
+  auto src_requirements_2 = litert::TensorBufferRequirements::Create(
+      absl::MakeSpan(kSupportedTensorBufferTypes2.data(),
+                     kSupportedTensorBufferTypes2.size()),
+      kBufferSize);
+  ASSERT_TRUE(src_requirements_2);
+
+  auto joint_requirements =
+      litert::Join(*src_requirements_1, *src_requirements_2);
+  ASSERT_TRUE(joint_requirements);
+  auto supported_types = joint_requirements->SupportedTypesCC();
+  ASSERT_TRUE(supported_types);
+  ASSERT_EQ(supported_types->size(), 2);
+  ASSERT_EQ((*supported_types)[0], litert::TensorBufferType::kAhwb);
+  ASSERT_EQ((*supported_types)[1], litert::TensorBufferType::kHostMemory);
+}
+
+TEST(TensorBufferRequirements, JoinAcceptsMissingStrides) {
+  constexpr std::array<uint32_t, 2> kStrides = {100, 4};
+
+  auto req1 = litert::TensorBufferRequirements::Create(
+      absl::MakeSpan(kSupportedTensorBufferTypes,
+                     kNumSupportedTensorBufferTypes),
+      kBufferSize);
+  ASSERT_TRUE(req1);
+  auto req2 = litert::TensorBufferRequirements::Create(
+      absl::MakeSpan(kSupportedTensorBufferTypes,
+                     kNumSupportedTensorBufferTypes),
+      kBufferSize, absl::MakeSpan(kStrides.data(), kStrides.size()));
+  ASSERT_TRUE(req2);
+
+  auto joined = litert::Join(*req1, *req2);
+  ASSERT_TRUE(joined);
+  auto strides = joined->Strides();
+  ASSERT_TRUE(strides);
+  ASSERT_EQ(std::vector<uint32_t>(strides->begin(), strides->end()),
+            std::vector<uint32_t>(kStrides.begin(), kStrides.end()));
+}
+
 TEST(TensorBufferRequirements, CreateWithAlignment) {
   constexpr size_t kCustomAlignment = 256;
   constexpr std::array<uint32_t, 2> kStrides = {100, 4};
@@ -15,6 +15,7 @@
 #include "litert/c/litert_tensor_buffer.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <memory>  // NOLINT: Used for OpenCL logic.
@@ -40,6 +41,7 @@
 #include "litert/cc/litert_macros.h"
 #include "litert/cc/litert_ranked_tensor_type.h"
 #include "litert/cc/litert_tensor_buffer.h"
+#include "litert/cc/litert_tensor_buffer_requirements.h"
 #include "litert/cc/litert_tensor_buffer_types.h"
 #include "litert/runtime/tensor_buffer.h"
 #include "litert/test/matchers.h"
@@ -317,6 +319,41 @@ TEST(TensorBuffer, HostMemory) {
   }
 }
 
+TEST(TensorBuffer, HostMemoryFromJoinedRequirements) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto env, litert::Environment::Create({}));
+  const RankedTensorType kTensorType(kTestTensorType);
+  constexpr TensorBufferType kProducerBufferTypes[] = {
+      TensorBufferType::kHostMemory};
+  constexpr TensorBufferType kConsumerBufferTypes[] = {
+      TensorBufferType::kAhwb, TensorBufferType::kHostMemory};
+  constexpr size_t kConsumerBufferSize = sizeof(kTensorData) + 16;
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto producer_requirements,
+      TensorBufferRequirements::Create(kProducerBufferTypes,
+                                       sizeof(kTensorData)));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto consumer_requirements,
+      TensorBufferRequirements::CreateWithAlignment(
+          kConsumerBufferTypes, kConsumerBufferSize, /*alignment=*/128));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto requirements, Join(producer_requirements, consumer_requirements));
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto tensor_buffer, TensorBuffer::CreateManagedFromRequirements(
+                              env, kTensorType, requirements));
+  LITERT_ASSERT_OK_AND_ASSIGN(auto tensor_buffer_type,
+                              tensor_buffer.BufferTypeCC());
+  EXPECT_EQ(tensor_buffer_type, TensorBufferType::kHostMemory);
+  LITERT_ASSERT_OK_AND_ASSIGN(auto size, tensor_buffer.Size());
+  EXPECT_EQ(size, kConsumerBufferSize);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto lock_and_addr, TensorBufferScopedLock::Create(
+                              tensor_buffer, TensorBuffer::LockMode::kRead));
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(lock_and_addr.second) % 128, 0);
+}
+
 bool CanLoadOpenCl() {
 #if LITERT_HAS_OPENCL_SUPPORT
   return tflite::gpu::cl::LoadOpenCL().ok();
@@ -833,6 +870,67 @@ TEST(TensorBuffer, ReadWriteBasic) {
   ASSERT_EQ(std::memcmp(read_data, kTensorData, sizeof(kTensorData)), 0);
 }
 
+TEST(TensorBuffer, SharedReadLocks) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto env, litert::Environment::Create({}));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      TensorBuffer tensor_buffer,
+      TensorBuffer::CreateManaged(env, TensorBufferType::kHostMemory,
+                                  RankedTensorType(kTestTensorType),
+                                  sizeof(kTensorData)));
+  LITERT_ASSERT_OK(tensor_buffer.Write<float>(absl::MakeSpan(
+      kTensorData, sizeof(kTensorData) / sizeof(kTensorData[0]))));
+
+  // Several readers can hold the lock at the same time.
+  LITERT_ASSERT_OK_AND_ASSIGN(void* first_reader,
+                              tensor_buffer.Lock(TensorBuffer::LockMode::kRead));
+  LITERT_ASSERT_OK_AND_ASSIGN(void* second_reader,
+                              tensor_buffer.Lock(TensorBuffer::LockMode::kRead));
+  EXPECT_EQ(first_reader, second_reader);
+  EXPECT_EQ(std::memcmp(second_reader, kTensorData, sizeof(kTensorData)), 0);
+  // Writers are excluded while the buffer is read locked.
+  EXPECT_FALSE(tensor_buffer.Lock(TensorBuffer::LockMode::kWrite));
+
+  LITERT_ASSERT_OK(tensor_buffer.Unlock());
+  EXPECT_FALSE(tensor_buffer.Lock(TensorBuffer::LockMode::kWrite));
+  LITERT_ASSERT_OK(tensor_buffer.Unlock());
+  EXPECT_FALSE(tensor_buffer.Unlock());
+
+  LITERT_ASSERT_OK(tensor_buffer.Lock(TensorBuffer::LockMode::kWrite));
+  // Readers are excluded while the buffer is write locked.
+  EXPECT_FALSE(tensor_buffer.Lock(TensorBuffer::LockMode::kRead));
+  LITERT_ASSERT_OK(tensor_buffer.Unlock());
+}
+
+TEST(TensorBuffer, LockRange) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto env, litert::Environment::Create({}));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      TensorBuffer tensor_buffer,
+      TensorBuffer::CreateManaged(env, TensorBufferType::kHostMemory,
+                                  RankedTensorType(kTestTensorType),
+                                  sizeof(kTensorData)));
+  LITERT_ASSERT_OK(tensor_buffer.Write<float>(absl::MakeSpan(
+      kTensorData, sizeof(kTensorData) / sizeof(kTensorData[0]))));
+
+  {
+    LITERT_ASSERT_OK_AND_ASSIGN(
+        void* host_memory,
+        tensor_buffer.LockRange(/*offset=*/sizeof(float),
+                                /*size=*/sizeof(float)));
+    *static_cast<float*>(host_memory) = 42;
+    LITERT_ASSERT_OK(tensor_buffer.Unlock());
+  }
+  float read_data[sizeof(kTensorData) / sizeof(kTensorData[0])];
+  LITERT_ASSERT_OK(tensor_buffer.Read<float>(absl::MakeSpan(read_data)));
+  EXPECT_EQ(read_data[0], kTensorData[0]);
+  EXPECT_EQ(read_data[1], 42);
+  EXPECT_EQ(read_data[2], kTensorData[2]);
+
+  // The range must be in the buffer.
+  EXPECT_THAT(tensor_buffer.LockRange(/*offset=*/sizeof(float),
+                                      /*size=*/sizeof(kTensorData)),
+              IsError(kLiteRtStatusErrorIndexOOB));
+}
+
 TEST(TensorBuffer, ReadWriteBufferSizeMismatch) {
   LITERT_ASSERT_OK_AND_ASSIGN(auto env, litert::Environment::Create({}));
   LITERT_ASSERT_OK_AND_ASSIGN(
@@ -1192,6 +1290,47 @@ TEST(TensorBuffer, ClBufferWriteOnReadLockIsNoOp) {
   }
 }
 
+TEST(TensorBuffer, ClBufferLockRangeKeepsTheRestOfTheBuffer) {
+  if (!HasOpenClSupport()) {
+    GTEST_SKIP() << "OpenCL buffers are not supported on this platform; "
+                    "skipping the test";
+  }
+  if (!CanLoadOpenCl()) {
+    GTEST_SKIP() << "OpenCL library could not be loaded; skipping the test";
+  }
+  auto user_gpu_env = UserGpuEnvironment::Create(/*create_gl_env=*/false);
+
+  for (auto buffer_type : {TensorBufferType::kOpenClBuffer,
+                           TensorBufferType::kOpenClBufferPacked}) {
+    LITERT_ASSERT_OK_AND_ASSIGN(
+        auto tensor_buffer,
+        TensorBuffer::CreateManaged(user_gpu_env->GetEnvironment(),
+                                    buffer_type,
+                                    RankedTensorType(kTestTensorType),
+                                    sizeof(kTensorData)));
+    LITERT_ASSERT_OK(tensor_buffer.Write<float>(absl::MakeSpan(
+        kTensorData, sizeof(kTensorData) / sizeof(kTensorData[0]))));
+
+    // Write only the second element.
+    {
+      LITERT_ASSERT_OK_AND_ASSIGN(
+          void* host_memory,
+          tensor_buffer.LockRange(/*offset=*/sizeof(float),
+                                  /*size=*/sizeof(float)));
+      *static_cast<float*>(host_memory) = 42;
+      LITERT_ASSERT_OK(tensor_buffer.Unlock());
+    }
+
+    float read_data[sizeof(kTensorData) / sizeof(kTensorData[0])];
+    LITERT_ASSERT_OK(tensor_buffer.Read<float>(absl::MakeSpan(read_data)));
+    EXPECT_EQ(read_data[0], kTensorData[0]);
+    EXPECT_EQ(read_data[1], 42);
+    for (size_t i = 2; i < sizeof(read_data) / sizeof(read_data[0]); ++i) {
+      EXPECT_EQ(read_data[i], kTensorData[i]);
+    }
+  }
+}
+
 TEST(TensorBuffer, ClBufferReadOnWriteLockIsInvalid) {
   if (!HasOpenClSupport()) {
     GTEST_SKIP() << "OpenCL buffers are not supported on this platform; "
@@ -16,6 +16,8 @@
 
 #include "litert/cc/options/compiler_options.h"
 
+#include <cstdint>
+
 #include "litert/c/litert_common.h"
 #include "litert/c/options/litert_compiler_options.h"
 #include "litert/cc/internal/litert_handle.h"
@@ -60,6 +62,76 @@ CompilerOptions::GetPartitionStrategy() const {
   return partition_strategy;
 }
 
+Expected<void> CompilerOptions::SetPartitionOpGain(double op_gain) {
+  LiteRtCompilerOptions compiler_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindCompilerOptions(Get(), &compiler_options));
+  LITERT_RETURN_IF_ERROR(
+      LiteRtSetCompilerOptionsPartitionOpGain(compiler_options, op_gain));
+  return {};
+}
+
+Expected<double> CompilerOptions::GetPartitionOpGain() const {
+  LiteRtCompilerOptions compiler_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindCompilerOptions(Get(), &compiler_options));
+  double op_gain;
+  LITERT_RETURN_IF_ERROR(
+      LiteRtGetCompilerOptionsPartitionOpGain(compiler_options, &op_gain));
+  return op_gain;
+}
+
+Expected<void> CompilerOptions::SetPartitionTransferCostPerByte(
+    double transfer_cost_per_byte) {
+  LiteRtCompilerOptions compiler_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindCompilerOptions(Get(), &compiler_options));
+  LITERT_RETURN_IF_ERROR(LiteRtSetCompilerOptionsPartitionTransferCostPerByte(
+      compiler_options, transfer_cost_per_byte));
+  return {};
+}
+
+Expected<double> CompilerOptions::GetPartitionTransferCostPerByte() const {
+  LiteRtCompilerOptions compiler_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindCompilerOptions(Get(), &compiler_options));
+  double transfer_cost_per_byte;
+  LITERT_RETURN_IF_ERROR(LiteRtGetCompilerOptionsPartitionTransferCostPerByte(
+      compiler_options, &transfer_cost_per_byte));
+  return transfer_cost_per_byte;
+}
+
+Expected<void> CompilerOptions::SetPartitionDispatchCost(double dispatch_cost) {
+  LiteRtCompilerOptions compiler_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindCompilerOptions(Get(), &compiler_options));
+  LITERT_RETURN_IF_ERROR(LiteRtSetCompilerOptionsPartitionDispatchCost(
+      compiler_options, dispatch_cost));
+  return {};
+}
+
+Expected<double> CompilerOptions::GetPartitionDispatchCost() const {
+  LiteRtCompilerOptions compiler_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindCompilerOptions(Get(), &compiler_options));
+  double dispatch_cost;
+  LITERT_RETURN_IF_ERROR(LiteRtGetCompilerOptionsPartitionDispatchCost(
+      compiler_options, &dispatch_cost));
+  return dispatch_cost;
+}
+
+Expected<void> CompilerOptions::SetMinPartitionSize(
+    uint32_t min_partition_size) {
+  LiteRtCompilerOptions compiler_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindCompilerOptions(Get(), &compiler_options));
+  LITERT_RETURN_IF_ERROR(LiteRtSetCompilerOptionsMinPartitionSize(
+      compiler_options, min_partition_size));
+  return {};
+}
+
+Expected<uint32_t> CompilerOptions::GetMinPartitionSize() const {
+  LiteRtCompilerOptions compiler_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindCompilerOptions(Get(), &compiler_options));
+  uint32_t min_partition_size;
+  LITERT_RETURN_IF_ERROR(LiteRtGetCompilerOptionsMinPartitionSize(
+      compiler_options, &min_partition_size));
+  return min_partition_size;
+}
+
 Expected<void> CompilerOptions::SetDummyOption(bool dummy_option) {
   LiteRtCompilerOptions compiler_options;
   LITERT_RETURN_IF_ERROR(LiteRtFindCompilerOptions(Get(), &compiler_options));
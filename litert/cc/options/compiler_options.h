@@ -15,6 +15,8 @@
 #ifndef THIRD_PARTY_ODML_LITERT_LITERT_CC_OPTIONS_COMPILER_OPTIONS_H_
 #define THIRD_PARTY_ODML_LITERT_LITERT_CC_OPTIONS_COMPILER_OPTIONS_H_
 
+#include <cstdint>
+
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/c/options/litert_compiler_options.h"
 #include "litert/cc/litert_expected.h"
@@ -37,6 +39,19 @@ class CompilerOptions : public OpaqueOptions {
       LiteRtCompilerOptionsPartitionStrategy partition_strategy);
   Expected<LiteRtCompilerOptionsPartitionStrategy> GetPartitionStrategy() const;
 
+  // Partition cost model, see LiteRtSetCompilerOptionsPartitionOpGain().
+  Expected<void> SetPartitionOpGain(double op_gain);
+  Expected<double> GetPartitionOpGain() const;
+
+  Expected<void> SetPartitionTransferCostPerByte(double transfer_cost_per_byte);
+  Expected<double> GetPartitionTransferCostPerByte() const;
+
+  Expected<void> SetPartitionDispatchCost(double dispatch_cost);
+  Expected<double> GetPartitionDispatchCost() const;
+
+  Expected<void> SetMinPartitionSize(uint32_t min_partition_size);
+  Expected<uint32_t> GetMinPartitionSize() const;
+
   Expected<void> SetDummyOption(bool dummy_option);
   Expected<bool> GetDummyOption() const;
 };
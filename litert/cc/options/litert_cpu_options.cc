@@ -19,6 +19,7 @@
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/c/litert_opaque_options.h"
 #include "litert/c/options/litert_cpu_options.h"
+#include "litert/c/options/litert_cpu_options_type.h"
 #include "litert/cc/internal/litert_handle.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
@@ -113,4 +114,21 @@ Expected<int> CpuOptions::GetXNNPackWeightCacheFileDescriptor() const {
   return fd;
 }
 
+Expected<void> CpuOptions::SetAffinityPolicy(LiteRtCpuAffinityPolicy policy) {
+  LiteRtCpuOptions cpu_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindCpuOptions(Get(), &cpu_options));
+  LITERT_RETURN_IF_ERROR(
+      LiteRtSetCpuOptionsAffinityPolicy(cpu_options, policy));
+  return {};
+}
+
+Expected<LiteRtCpuAffinityPolicy> CpuOptions::GetAffinityPolicy() const {
+  LiteRtCpuOptions cpu_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindCpuOptions(Get(), &cpu_options));
+  LiteRtCpuAffinityPolicy policy;
+  LITERT_RETURN_IF_ERROR(
+      LiteRtGetCpuOptionsAffinityPolicy(cpu_options, &policy));
+  return policy;
+}
+
 }  // namespace litert
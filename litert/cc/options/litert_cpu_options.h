@@ -18,6 +18,7 @@
 #include <cstdint>
 
 #include "absl/strings/string_view.h"  // from @com_google_absl
+#include "litert/c/options/litert_cpu_options_type.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_opaque_options.h"
 
@@ -43,6 +44,9 @@ class CpuOptions : public OpaqueOptions {
 
   Expected<void> SetXNNPackWeightCacheFileDescriptor(int fd);
   Expected<int> GetXNNPackWeightCacheFileDescriptor() const;
+
+  Expected<void> SetAffinityPolicy(LiteRtCpuAffinityPolicy policy);
+  Expected<LiteRtCpuAffinityPolicy> GetAffinityPolicy() const;
 };
 
 }  // namespace litert
@@ -20,6 +20,7 @@
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_opaque_options.h"
 #include "litert/c/options/litert_cpu_options.h"
+#include "litert/c/options/litert_cpu_options_type.h"
 #include "litert/cc/internal/litert_handle.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
@@ -125,6 +126,20 @@ TEST(CpuOptions, SetAndGetXNNPackFlagsWorks) {
   EXPECT_THAT(options.GetXNNPackFlags(), IsOkAndHolds(3));
 }
 
+TEST(CpuOptions, CheckAffinityPolicyDefaultValue) {
+  LITERT_ASSERT_OK_AND_ASSIGN(CpuOptions options, CpuOptions::Create());
+  EXPECT_THAT(options.GetAffinityPolicy(),
+              IsOkAndHolds(kLiteRtCpuAffinityPolicyNone));
+}
+
+TEST(CpuOptions, SetAndGetAffinityPolicyWorks) {
+  LITERT_ASSERT_OK_AND_ASSIGN(CpuOptions options, CpuOptions::Create());
+
+  LITERT_EXPECT_OK(options.SetAffinityPolicy(kLiteRtCpuAffinityPolicyBigCores));
+  EXPECT_THAT(options.GetAffinityPolicy(),
+              IsOkAndHolds(kLiteRtCpuAffinityPolicyBigCores));
+}
+
 TEST(CpuOptions, GetXNNPackFlagsFailsIfErroneousCast) {
   LITERT_ASSERT_OK_AND_ASSIGN(NotCpuOptions original_options,
                               NotCpuOptions::Create());
@@ -103,6 +103,18 @@ std::pair<std::string, std::string> IntelOpenVinoOptions::GetConfigsMapOption(
   return std::make_pair(std::string(key), std::string(value));
 }
 
+void IntelOpenVinoOptions::SetNumInferRequests(int num_infer_requests) {
+  LITERT_ABORT_IF_ERROR(LiteRtIntelOpenVinoOptionsSetNumInferRequests(
+      Data(), num_infer_requests));
+}
+
+int IntelOpenVinoOptions::GetNumInferRequests() const {
+  int num_infer_requests;
+  LITERT_ABORT_IF_ERROR(LiteRtIntelOpenVinoOptionsGetNumInferRequests(
+      Data(), &num_infer_requests));
+  return num_infer_requests;
+}
+
 LiteRtIntelOpenVinoOptions IntelOpenVinoOptions::Data() const {
   LiteRtIntelOpenVinoOptions options_data;
   LITERT_ABORT_IF_ERROR(LiteRtIntelOpenVinoOptionsGet(Get(), &options_data));
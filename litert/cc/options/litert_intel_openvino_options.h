@@ -51,6 +51,10 @@ class IntelOpenVinoOptions : public OpaqueOptions {
 
   std::pair<std::string, std::string> GetConfigsMapOption(int index) const;
 
+  void SetNumInferRequests(int num_infer_requests);
+
+  int GetNumInferRequests() const;
+
  private:
   LiteRtIntelOpenVinoOptions Data() const;
 };
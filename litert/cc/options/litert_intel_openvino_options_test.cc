@@ -44,6 +44,7 @@ TEST_F(IntelOpenVinoOptionsTest, DefaultValues) {
   EXPECT_EQ(options_->GetDeviceType(), kLiteRtIntelOpenVinoDeviceTypeNPU);
   EXPECT_EQ(options_->GetPerformanceMode(),
             kLiteRtIntelOpenVinoPerformanceModeLatency);
+  EXPECT_EQ(options_->GetNumInferRequests(), 0);
 }
 
 TEST_F(IntelOpenVinoOptionsTest, SetAndGetDeviceType) {
@@ -68,6 +69,20 @@ TEST_F(IntelOpenVinoOptionsTest, SetAndGetPerformanceMode) {
             kLiteRtIntelOpenVinoPerformanceModeCumulativeThroughput);
 }
 
+TEST_F(IntelOpenVinoOptionsTest, SetAndGetNumInferRequests) {
+  options_->SetNumInferRequests(4);
+  EXPECT_EQ(options_->GetNumInferRequests(), 4);
+}
+
+TEST_F(IntelOpenVinoOptionsTest, RejectsNegativeNumInferRequests) {
+  LiteRtIntelOpenVinoOptions options_data;
+  ASSERT_EQ(LiteRtIntelOpenVinoOptionsGet(options_->Get(), &options_data),
+            kLiteRtStatusOk);
+  EXPECT_EQ(LiteRtIntelOpenVinoOptionsSetNumInferRequests(options_data, -1),
+            kLiteRtStatusErrorInvalidArgument);
+  EXPECT_EQ(options_->GetNumInferRequests(), 0);
+}
+
 TEST_F(IntelOpenVinoOptionsTest, SetAndGetConfigsMapOption) {
   // Define expected config options
   std::map<std::string, std::string> expected_configs = {
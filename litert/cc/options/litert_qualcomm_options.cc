@@ -72,6 +72,18 @@ QualcommOptions::HtpPerformanceMode QualcommOptions::GetHtpPerformanceMode() {
   return static_cast<QualcommOptions::HtpPerformanceMode>(htp_performance_mode);
 }
 
+void QualcommOptions::SetHtpLatencySloUs(std::uint32_t htp_latency_slo_us) {
+  internal::AssertOk(LiteRtQualcommOptionsSetHtpLatencySloUs, Data(),
+                     htp_latency_slo_us);
+}
+
+std::uint32_t QualcommOptions::GetHtpLatencySloUs() {
+  std::uint32_t htp_latency_slo_us;
+  internal::AssertOk(LiteRtQualcommOptionsGetHtpLatencySloUs, Data(),
+                     &htp_latency_slo_us);
+  return htp_latency_slo_us;
+}
+
 void QualcommOptions::SetEnableWeightSharing(bool weight_sharing_enabled) {
   internal::AssertOk(LiteRtQualcommOptionsSetEnableWeightSharing, Data(),
                      weight_sharing_enabled);
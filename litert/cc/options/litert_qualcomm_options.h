@@ -74,6 +74,12 @@ class QualcommOptions : public OpaqueOptions {
   void SetHtpPerformanceMode(HtpPerformanceMode htp_performance_mode);
   HtpPerformanceMode GetHtpPerformanceMode();
 
+  // Target latency of one invocation, in microseconds. When set, performance
+  // votes follow the invocation pattern instead of being held for the whole
+  // session. Defaults to 0 (disabled).
+  void SetHtpLatencySloUs(std::uint32_t htp_latency_slo_us);
+  std::uint32_t GetHtpLatencySloUs();
+
   void SetUseHtpPreference(bool use_htp_preference);
   bool GetUseHtpPreference();
 
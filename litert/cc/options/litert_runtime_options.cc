@@ -14,6 +14,8 @@
 
 #include "litert/cc/options/litert_runtime_options.h"
 
+#include <cstdint>
+
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/c/options/litert_runtime_options.h"
@@ -87,4 +89,92 @@ Expected<LiteRtErrorReporterMode> RuntimeOptions::GetErrorReporterMode() const {
   return error_reporter_mode;
 }
 
+Expected<void> RuntimeOptions::SetBackgroundJitCompilation(
+    bool background_jit_compilation) {
+  LiteRtRuntimeOptions runtime_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindRuntimeOptions(Get(), &runtime_options));
+  LITERT_RETURN_IF_ERROR(LiteRtSetRuntimeOptionsBackgroundJitCompilation(
+      runtime_options, background_jit_compilation));
+  return {};
+}
+
+Expected<bool> RuntimeOptions::GetBackgroundJitCompilation() const {
+  LiteRtRuntimeOptions runtime_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindRuntimeOptions(Get(), &runtime_options));
+  bool background_jit_compilation;
+  LITERT_RETURN_IF_ERROR(LiteRtGetRuntimeOptionsBackgroundJitCompilation(
+      runtime_options, &background_jit_compilation));
+  return background_jit_compilation;
+}
+
+Expected<void> RuntimeOptions::SetLazySignatureAllocation(
+    bool lazy_signature_allocation) {
+  LiteRtRuntimeOptions runtime_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindRuntimeOptions(Get(), &runtime_options));
+  LITERT_RETURN_IF_ERROR(LiteRtSetRuntimeOptionsLazySignatureAllocation(
+      runtime_options, lazy_signature_allocation));
+  return {};
+}
+
+Expected<bool> RuntimeOptions::GetLazySignatureAllocation() const {
+  LiteRtRuntimeOptions runtime_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindRuntimeOptions(Get(), &runtime_options));
+  bool lazy_signature_allocation;
+  LITERT_RETURN_IF_ERROR(LiteRtGetRuntimeOptionsLazySignatureAllocation(
+      runtime_options, &lazy_signature_allocation));
+  return lazy_signature_allocation;
+}
+
+Expected<void> RuntimeOptions::SetNumDispatchInvocationContexts(
+    int num_dispatch_invocation_contexts) {
+  LiteRtRuntimeOptions runtime_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindRuntimeOptions(Get(), &runtime_options));
+  LITERT_RETURN_IF_ERROR(LiteRtSetRuntimeOptionsNumDispatchInvocationContexts(
+      runtime_options, num_dispatch_invocation_contexts));
+  return {};
+}
+
+Expected<int> RuntimeOptions::GetNumDispatchInvocationContexts() const {
+  LiteRtRuntimeOptions runtime_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindRuntimeOptions(Get(), &runtime_options));
+  int num_dispatch_invocation_contexts;
+  LITERT_RETURN_IF_ERROR(LiteRtGetRuntimeOptionsNumDispatchInvocationContexts(
+      runtime_options, &num_dispatch_invocation_contexts));
+  return num_dispatch_invocation_contexts;
+}
+
+Expected<void> RuntimeOptions::SetRunPriority(LiteRtRunPriority priority) {
+  LiteRtRuntimeOptions runtime_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindRuntimeOptions(Get(), &runtime_options));
+  LITERT_RETURN_IF_ERROR(
+      LiteRtSetRuntimeOptionsRunPriority(runtime_options, priority));
+  return {};
+}
+
+Expected<LiteRtRunPriority> RuntimeOptions::GetRunPriority() const {
+  LiteRtRuntimeOptions runtime_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindRuntimeOptions(Get(), &runtime_options));
+  LiteRtRunPriority priority;
+  LITERT_RETURN_IF_ERROR(
+      LiteRtGetRuntimeOptionsRunPriority(runtime_options, &priority));
+  return priority;
+}
+
+Expected<void> RuntimeOptions::SetRunDeadlineMs(int64_t deadline_ms) {
+  LiteRtRuntimeOptions runtime_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindRuntimeOptions(Get(), &runtime_options));
+  LITERT_RETURN_IF_ERROR(
+      LiteRtSetRuntimeOptionsRunDeadlineMs(runtime_options, deadline_ms));
+  return {};
+}
+
+Expected<int64_t> RuntimeOptions::GetRunDeadlineMs() const {
+  LiteRtRuntimeOptions runtime_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindRuntimeOptions(Get(), &runtime_options));
+  int64_t deadline_ms;
+  LITERT_RETURN_IF_ERROR(
+      LiteRtGetRuntimeOptionsRunDeadlineMs(runtime_options, &deadline_ms));
+  return deadline_ms;
+}
+
 }  // namespace litert
@@ -15,6 +15,8 @@
 #ifndef THIRD_PARTY_ODML_LITERT_LITERT_CC_OPTIONS_LITERT_RUNTIME_OPTIONS_H_
 #define THIRD_PARTY_ODML_LITERT_LITERT_CC_OPTIONS_LITERT_RUNTIME_OPTIONS_H_
 
+#include <cstdint>
+
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/cc/litert_expected.h"
@@ -44,6 +46,22 @@ class RuntimeOptions : public OpaqueOptions {
   Expected<void> SetErrorReporterMode(
       LiteRtErrorReporterMode error_reporter_mode);
   Expected<LiteRtErrorReporterMode> GetErrorReporterMode() const;
+  // See LiteRtSetRuntimeOptionsBackgroundJitCompilation().
+  Expected<void> SetBackgroundJitCompilation(bool background_jit_compilation);
+  Expected<bool> GetBackgroundJitCompilation() const;
+  // See LiteRtSetRuntimeOptionsLazySignatureAllocation().
+  Expected<void> SetLazySignatureAllocation(bool lazy_signature_allocation);
+  Expected<bool> GetLazySignatureAllocation() const;
+  // See LiteRtSetRuntimeOptionsNumDispatchInvocationContexts().
+  Expected<void> SetNumDispatchInvocationContexts(
+      int num_dispatch_invocation_contexts);
+  Expected<int> GetNumDispatchInvocationContexts() const;
+  // See LiteRtSetRuntimeOptionsRunPriority().
+  Expected<void> SetRunPriority(LiteRtRunPriority priority);
+  Expected<LiteRtRunPriority> GetRunPriority() const;
+  // See LiteRtSetRuntimeOptionsRunDeadlineMs().
+  Expected<void> SetRunDeadlineMs(int64_t deadline_ms);
+  Expected<int64_t> GetRunDeadlineMs() const;
 };
 
 }  // namespace litert
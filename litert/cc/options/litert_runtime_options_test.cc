@@ -45,5 +45,43 @@ TEST(RuntimeOptions, SetAndGetNumThreadsWorks) {
   EXPECT_THAT(options.GetShloCompositeInlining(), IsOkAndHolds(true));
 }
 
+TEST(RuntimeOptions, SetAndGetBackgroundJitCompilationWorks) {
+  LITERT_ASSERT_OK_AND_ASSIGN(RuntimeOptions options, RuntimeOptions::Create());
+  EXPECT_THAT(options.GetBackgroundJitCompilation(), IsOkAndHolds(false));
+
+  LITERT_EXPECT_OK(options.SetBackgroundJitCompilation(true));
+  EXPECT_THAT(options.GetBackgroundJitCompilation(), IsOkAndHolds(true));
+}
+
+TEST(RuntimeOptions, SetAndGetLazySignatureAllocationWorks) {
+  LITERT_ASSERT_OK_AND_ASSIGN(RuntimeOptions options, RuntimeOptions::Create());
+  EXPECT_THAT(options.GetLazySignatureAllocation(), IsOkAndHolds(false));
+
+  LITERT_EXPECT_OK(options.SetLazySignatureAllocation(true));
+  EXPECT_THAT(options.GetLazySignatureAllocation(), IsOkAndHolds(true));
+}
+
+TEST(RuntimeOptions, SetAndGetNumDispatchInvocationContextsWorks) {
+  LITERT_ASSERT_OK_AND_ASSIGN(RuntimeOptions options, RuntimeOptions::Create());
+  EXPECT_THAT(options.GetNumDispatchInvocationContexts(), IsOkAndHolds(1));
+
+  LITERT_EXPECT_OK(options.SetNumDispatchInvocationContexts(3));
+  EXPECT_THAT(options.GetNumDispatchInvocationContexts(), IsOkAndHolds(3));
+
+  EXPECT_FALSE(options.SetNumDispatchInvocationContexts(0));
+  EXPECT_THAT(options.GetNumDispatchInvocationContexts(), IsOkAndHolds(3));
+}
+
+TEST(RuntimeOptions, SetAndGetRunPriorityAndDeadlineWorks) {
+  LITERT_ASSERT_OK_AND_ASSIGN(RuntimeOptions options, RuntimeOptions::Create());
+  EXPECT_THAT(options.GetRunPriority(), IsOkAndHolds(kLiteRtRunPriorityNone));
+  EXPECT_THAT(options.GetRunDeadlineMs(), IsOkAndHolds(0));
+
+  LITERT_EXPECT_OK(options.SetRunPriority(kLiteRtRunPriorityHigh));
+  LITERT_EXPECT_OK(options.SetRunDeadlineMs(16));
+  EXPECT_THAT(options.GetRunPriority(), IsOkAndHolds(kLiteRtRunPriorityHigh));
+  EXPECT_THAT(options.GetRunDeadlineMs(), IsOkAndHolds(16));
+}
+
 }  // namespace
 }  // namespace litert
@@ -14,6 +14,9 @@
 
 #include "litert/compiler/plugin/algo.h"
 
+#include <cstddef>
+#include <numeric>
+#include <optional>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -30,10 +33,56 @@
 #include "litert/cc/litert_macros.h"
 #include "litert/core/insert_order_map.h"
 #include "litert/core/model/model.h"
+#include "litert/core/model/subgraph_adjacency.h"
+#include "litert/core/util/tensor_type_util.h"
 
 namespace litert::internal {
 namespace {
 
+//
+// partition cost estimation
+//===----------------------------------------------------------------------===//
+
+// Size of the tensor data, 0 if it is not statically known.
+size_t TensorBytes(const LiteRtTensorT& tensor) {
+  const auto& [type_id, type] = tensor.Type();
+  if (type_id != kLiteRtRankedTensorType) {
+    return 0;
+  }
+  auto num_bytes = GetNumPackedBytes(type.ranked_tensor_type);
+  return num_bytes ? *num_bytes : 0;
+}
+
+// Bytes of the non-constant tensors that cross the partition boundary: inputs
+// defined outside of the partition and outputs used outside of it (or not used
+// at all, i.e. subgraph outputs).
+size_t BoundaryBytes(const std::vector<LiteRtOp>& partition) {
+  const absl::flat_hash_set<LiteRtOp> ops(partition.cbegin(), partition.cend());
+  absl::flat_hash_set<LiteRtTensor> boundary;
+  for (auto* op : partition) {
+    for (auto* input : op->Inputs()) {
+      if (input != nullptr && !IsConstant(*input) &&
+          !ops.contains(input->DefiningOp())) {
+        boundary.insert(input);
+      }
+    }
+    for (auto* output : op->Outputs()) {
+      bool used_outside = output->Users().empty();
+      for (auto* user : output->Users()) {
+        used_outside |= !ops.contains(user);
+      }
+      if (used_outside) {
+        boundary.insert(output);
+      }
+    }
+  }
+  size_t num_bytes = 0;
+  for (auto* tensor : boundary) {
+    num_bytes += TensorBytes(*tensor);
+  }
+  return num_bytes;
+}
+
 //
 // flatlist to partition(s)
 //===----------------------------------------------------------------------===//
@@ -192,6 +241,66 @@ LiteRtOp DisjointSets::GetBucket(LiteRtOp op) {
   return parent;
 }
 
+// Same grouping as DisjointSets, run on the index based adjacency of the
+// subgraph instead of maps keyed by op pointers. Buckets are in the order of
+// their first op in "ops", and the ops of a bucket in the order of "ops".
+// Returns nothing if an op is not in the subgraph or is selected twice.
+std::optional<std::vector<std::vector<LiteRtOp>>> GroupPartitionsByAdjacency(
+    const std::vector<LiteRtOpWithPartitionIndex>& ops,
+    const SubgraphAdjacency& adjacency) {
+  using Index = SubgraphAdjacency::Index;
+  constexpr Index kNone = SubgraphAdjacency::kNone;
+  const Index num_selected = ops.size();
+
+  // The position in "ops" of each op of the subgraph, kNone if not selected.
+  std::vector<Index> selected(adjacency.NumOps(), kNone);
+  std::vector<Index> op_indices(num_selected);
+  for (Index i = 0; i < num_selected; ++i) {
+    const Index op = adjacency.OpIndex(ops[i].first);
+    if (op == kNone || selected[op] != kNone) {
+      return std::nullopt;
+    }
+    selected[op] = i;
+    op_indices[i] = op;
+  }
+
+  // Union-find over the positions in "ops", with path halving.
+  std::vector<Index> parents(num_selected);
+  std::iota(parents.begin(), parents.end(), 0);
+  auto find = [&parents](Index i) {
+    while (parents[i] != i) {
+      parents[i] = parents[parents[i]];
+      i = parents[i];
+    }
+    return i;
+  };
+  for (Index i = 0; i < num_selected; ++i) {
+    adjacency.ForEachSuccessor(op_indices[i], [&](Index user) {
+      const Index j = selected[user];
+      if (j == kNone || ops[j].second != ops[i].second) {
+        return;
+      }
+      const Index root = find(i);
+      const Index user_root = find(j);
+      if (root != user_root) {
+        parents[root] = user_root;
+      }
+    });
+  }
+
+  std::vector<Index> bucket_of_root(num_selected, kNone);
+  std::vector<std::vector<LiteRtOp>> buckets;
+  for (Index i = 0; i < num_selected; ++i) {
+    Index& bucket = bucket_of_root[find(i)];
+    if (bucket == kNone) {
+      bucket = buckets.size();
+      buckets.emplace_back();
+    }
+    buckets[bucket].push_back(ops[i].first);
+  }
+  return buckets;
+}
+
 //
 // slice partitions out of a subgraph (into new subgraphs)
 //===----------------------------------------------------------------------===//
@@ -399,6 +508,12 @@ std::vector<std::vector<LiteRtOp>> GetPartitionsFromFlatListV2(
 std::vector<std::vector<LiteRtOp>> GroupPartitions(
     const std::vector<LiteRtOpWithPartitionIndex>& ops,
     LiteRtSubgraph subgraph) {
+  if (subgraph != nullptr) {
+    auto buckets = GroupPartitionsByAdjacency(ops, subgraph->Adjacency());
+    if (buckets) {
+      return *std::move(buckets);
+    }
+  }
   return DisjointSets::GetPartitionsFromFlatList(ops);
 }
 
@@ -408,6 +523,42 @@ std::vector<std::vector<LiteRtOp>> GroupPartitionsV2(
   return GetPartitionsFromFlatListV2(ops, subgraph);
 }
 
+PartitionEstimate EstimatePartition(const std::vector<LiteRtOp>& partition,
+                                    const PartitionCostModel& cost_model) {
+  PartitionEstimate estimate;
+  estimate.num_ops = partition.size();
+  estimate.boundary_bytes = BoundaryBytes(partition);
+  for (const auto* op : partition) {
+    estimate.gain += cost_model.op_gain ? cost_model.op_gain(*op) : 1.0;
+  }
+  estimate.gain -= cost_model.dispatch_cost +
+                   cost_model.transfer_cost_per_byte * estimate.boundary_bytes;
+  estimate.offload = estimate.num_ops >= cost_model.min_partition_size &&
+                     estimate.gain > 0.0;
+  return estimate;
+}
+
+std::vector<PartitionEstimate> SelectPartitionsByCost(
+    std::vector<std::vector<LiteRtOp>>& partitions,
+    const PartitionCostModel& cost_model) {
+  std::vector<PartitionEstimate> estimates;
+  estimates.reserve(partitions.size());
+  std::vector<std::vector<LiteRtOp>> selected;
+  for (auto& partition : partitions) {
+    const auto& estimate =
+        estimates.emplace_back(EstimatePartition(partition, cost_model));
+    LITERT_LOG(LITERT_VERBOSE,
+               "Partition of %lu ops, %lu boundary bytes, gain %f: %s",
+               estimate.num_ops, estimate.boundary_bytes, estimate.gain,
+               estimate.offload ? "offloaded" : "kept on host");
+    if (estimate.offload) {
+      selected.push_back(std::move(partition));
+    }
+  }
+  partitions = std::move(selected);
+  return estimates;
+}
+
 LiteRtOp OutlinePartition(LiteRtSubgraphT& root, LiteRtSubgraph slice,
                           std::vector<LiteRtOp>& partition) {
   return GraphSlicer::SlicePartitionFromGraph(root, slice, partition);
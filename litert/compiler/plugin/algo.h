@@ -15,6 +15,8 @@
 #ifndef ODML_LITERT_LITERT_COMPILER_PLUGIN_ALGO_H_
 #define ODML_LITERT_LITERT_COMPILER_PLUGIN_ALGO_H_
 
+#include <cstddef>
+#include <functional>
 #include <vector>
 
 #include "litert/c/litert_common.h"
@@ -39,6 +41,43 @@ std::vector<std::vector<LiteRtOp>> GroupPartitionsV2(
     const std::vector<LiteRtOpWithPartitionIndex>& ops,
     LiteRtSubgraph subgraph);
 
+// Estimates used to decide whether offloading a partition reduces the end to
+// end latency.
+struct PartitionCostModel {
+  // Estimated time saved by running "op" on the accelerator instead of the
+  // host. If unset, every op saves 1.
+  std::function<double(const LiteRtOpT&)> op_gain;
+  // Estimated time to move one byte between the host and the accelerator.
+  double transfer_cost_per_byte = 0.0;
+  // Estimated fixed time of each dispatch to the accelerator.
+  double dispatch_cost = 0.0;
+  // Partitions with fewer ops are never offloaded.
+  size_t min_partition_size = 1;
+};
+
+struct PartitionEstimate {
+  size_t num_ops = 0;
+  // Size of the non-constant tensors entering or leaving the partition.
+  size_t boundary_bytes = 0;
+  // Estimated time saved by offloading the partition, negative if it is
+  // slower than running on the host.
+  double gain = 0.0;
+  // Whether the partition is worth offloading.
+  bool offload = false;
+};
+
+// Estimates the gain of offloading "partition", which must be one of the
+// results of GroupPartitions or GroupPartitionsV2.
+PartitionEstimate EstimatePartition(const std::vector<LiteRtOp>& partition,
+                                    const PartitionCostModel& cost_model);
+
+// Removes the partitions that are not estimated to pay for their transfers
+// and dispatch, or are smaller than the minimum size, so that their ops stay
+// on the host. Returns the estimate of each original partition, in order.
+std::vector<PartitionEstimate> SelectPartitionsByCost(
+    std::vector<std::vector<LiteRtOp>>& partitions,
+    const PartitionCostModel& cost_model);
+
 // Outlines "partition" from "root" into the empty subgraph "slice". Assumes
 // the partition is a valid sub-DAG, and replaces it with a single
 // tfl.custom_op in "root". A reference to that op is returned.
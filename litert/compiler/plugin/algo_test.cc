@@ -310,6 +310,62 @@ TEST_P(PartitionTest, PartitionWithIndex) {
   }
 }
 
+TEST(PartitionCostModelTest, DropsPartitionsThatDoNotPayOff) {
+  auto model = litert::testing::LoadTestFileModel("simple_multi_op.tflite");
+  auto subgraph = model.MainSubgraph();
+  EXPECT_TRUE(subgraph);
+
+  auto ops = subgraph->Ops();
+
+  // func.func @main(arg0)
+  //   0 = tfl.add arg0, arg0
+  //   1 = tfl.mul 0, 0
+  //   2 = tfl.mul 1, 1
+  //   3 = tfl.add 2, 2
+  //   return 3
+  std::vector<LiteRtOpWithPartitionIndex> selected_ops;
+  selected_ops.push_back({ops.at(0).Get(), 0});
+  selected_ops.push_back({ops.at(2).Get(), 0});
+  selected_ops.push_back({ops.at(3).Get(), 0});
+
+  {
+    // Both partitions move one tensor in and one out.
+    auto partitions = GroupPartitionsV2(selected_ops, subgraph->Get());
+    ASSERT_EQ(partitions.size(), 2);
+    PartitionCostModel cost_model;
+    cost_model.min_partition_size = 2;
+    auto estimates = SelectPartitionsByCost(partitions, cost_model);
+    ASSERT_EQ(estimates.size(), 2);
+    EXPECT_GT(estimates.front().boundary_bytes, 0);
+    EXPECT_EQ(estimates.front().boundary_bytes,
+              estimates.back().boundary_bytes);
+    EXPECT_FALSE(estimates.front().offload);
+    EXPECT_TRUE(estimates.back().offload);
+    EXPECT_DOUBLE_EQ(estimates.back().gain, 2.0);
+
+    // Only the largest partition is kept.
+    ASSERT_EQ(partitions.size(), 1);
+    EXPECT_EQ(partitions.front().size(), 2);
+  }
+
+  {
+    // The transfers cost as much as the ops save.
+    auto partitions = GroupPartitionsV2(selected_ops, subgraph->Get());
+    const auto boundary_bytes =
+        EstimatePartition(partitions.back(), {}).boundary_bytes;
+    PartitionCostModel cost_model;
+    cost_model.op_gain = [](const LiteRtOpT& op) {
+      return op.OpCode() == kLiteRtOpCodeTflMul ? 2.0 : 1.0;
+    };
+    cost_model.transfer_cost_per_byte = 3.0 / boundary_bytes;
+    auto estimates = SelectPartitionsByCost(partitions, cost_model);
+    EXPECT_FALSE(estimates.front().offload);
+    EXPECT_NEAR(estimates.back().gain, 0.0, 1e-9);
+    EXPECT_FALSE(estimates.back().offload);
+    EXPECT_TRUE(partitions.empty());
+  }
+}
+
 TEST(TestCompositeInlining, inlineSimpleComposite) {
   auto model_wrap = testing::LoadTestFileModel("rms_norm_composite.tflite");
   ASSERT_TRUE(model_wrap);
@@ -24,6 +24,7 @@
 #include <optional>
 #include <queue>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
@@ -48,6 +49,7 @@
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
 #include "litert/compiler/plugin/algo.h"
+#include "litert/compiler/plugin/rewrites.h"
 #include "litert/core/build_stamp.h"
 #include "litert/core/dynamic_loading.h"
 #include "litert/core/environment.h"
@@ -460,7 +462,8 @@ LiteRtStatus PartitionSubgraph(
     std::vector<LiteRtOpWithPartitionIndex> selected_ops,
     LiteRtSubgraphT& subgraph, std::vector<LiteRtOp>& res_ops,
     LiteRtModelT& model,
-    LiteRtCompilerOptionsPartitionStrategy partition_strategy_option) {
+    LiteRtCompilerOptionsPartitionStrategy partition_strategy_option,
+    const PartitionCostModel& cost_model) {
   // Pick partition strategy based on compiler options.
   std::vector<std::vector<LiteRtOp>> (*partition_strategy_func)(
       const std::vector<LiteRtOpWithPartitionIndex>&, LiteRtSubgraph) =
@@ -476,6 +479,22 @@ LiteRtStatus PartitionSubgraph(
     return kLiteRtStatusOk;
   }
 
+  // Leave the islands that are not worth offloading on the host.
+  const auto estimates = SelectPartitionsByCost(islands, cost_model);
+  for (size_t i = 0; i < estimates.size(); ++i) {
+    const auto& estimate = estimates[i];
+    if (!estimate.offload) {
+      LITERT_LOG(LITERT_INFO,
+                 "Keeping partition %lu on the host: %lu ops, %lu boundary "
+                 "bytes, estimated gain %f.",
+                 i, estimate.num_ops, estimate.boundary_bytes, estimate.gain);
+    }
+  }
+  if (islands.size() != estimates.size()) {
+    LITERT_LOG(LITERT_INFO, "Offloading %lu of %lu partitions.",
+               islands.size(), estimates.size());
+  }
+
   // For each connected island, slice into new subgraph and replace use with
   // single dispatch op.
   for (auto& island : islands) {
@@ -487,6 +506,30 @@ LiteRtStatus PartitionSubgraph(
   return kLiteRtStatusOk;
 }
 
+// Reads the partition cost model from the compiler options of the plugin,
+// falling back to the defaults, which offload every partition.
+Expected<PartitionCostModel> GetPartitionCostModel(
+    const CompilerPlugin& compiler_plugin) {
+  PartitionCostModel cost_model;
+  auto compiler_options = compiler_plugin.CompilerOptions();
+  if (!compiler_options) {
+    return cost_model;
+  }
+  double op_gain;
+  LITERT_RETURN_IF_ERROR(
+      LiteRtGetCompilerOptionsPartitionOpGain(*compiler_options, &op_gain));
+  cost_model.op_gain = [op_gain](const LiteRtOpT&) { return op_gain; };
+  LITERT_RETURN_IF_ERROR(LiteRtGetCompilerOptionsPartitionTransferCostPerByte(
+      *compiler_options, &cost_model.transfer_cost_per_byte));
+  LITERT_RETURN_IF_ERROR(LiteRtGetCompilerOptionsPartitionDispatchCost(
+      *compiler_options, &cost_model.dispatch_cost));
+  uint32_t min_partition_size;
+  LITERT_RETURN_IF_ERROR(LiteRtGetCompilerOptionsMinPartitionSize(
+      *compiler_options, &min_partition_size));
+  cost_model.min_partition_size = min_partition_size;
+  return cost_model;
+}
+
 }  // namespace
 
 Expected<PartitionResult> PartitionModel(
@@ -636,8 +679,11 @@ Expected<PartitionResult> PartitionModel(
             status, "Failed to get partition strategy from compiler options.");
       }
     }
-    LITERT_RETURN_IF_ERROR(PartitionSubgraph(
-        std::move(*selected_ops), *subgraph, dispatch_ops, model, strategy));
+    LITERT_ASSIGN_OR_RETURN(auto cost_model,
+                            GetPartitionCostModel(compiler_plugin));
+    LITERT_RETURN_IF_ERROR(
+        PartitionSubgraph(std::move(*selected_ops), *subgraph, dispatch_ops,
+                          model, strategy, cost_model));
     num_partitions = dispatch_ops.size() - num_partitions;
     LITERT_LOG(LITERT_INFO,
                "Partitioned subgraph<%d>, selected %lu "
@@ -696,7 +742,8 @@ Expected<PartitionResult> PartitionModelDirect(
   std::vector<LiteRtOp> dispatch_ops;
   LITERT_RETURN_IF_ERROR(PartitionSubgraph(
       std::move(selected_ops), *subgraph, dispatch_ops, model,
-      kLiteRtCompilerOptionsPartitionStrategyWeaklyConnected));
+      kLiteRtCompilerOptionsPartitionStrategyWeaklyConnected,
+      PartitionCostModel()));
   ABSL_DCHECK_EQ(dispatch_ops.size(), model.NumSubgraphs() - 1);
 
   std::vector<size_t> decomps_to_compile;
@@ -709,22 +756,16 @@ Expected<PartitionResult> PartitionModelDirect(
   return PartitionResult{std::move(dispatch_ops), std::move(new_model)};
 }
 
-Expected<void> ApplyPluginWithPartition(CompilerPlugin& compiler_plugin,
-                                        LiteRtModelT& model,
-                                        PartitionResult partitions,
-                                        absl::string_view soc_model) {
-  auto& dispatch_ops = partitions.first;
-  auto& sliced_model = partitions.second;
-
-  // Pass sliced subgraphs to plugin for compilation.
-  auto compiled_result = compiler_plugin.Compile(&sliced_model, soc_model);
-  if (!compiled_result) {
-    return compiled_result.Error();
-  }
+namespace {
 
+// Copies the byte code of "compiled_result" into "model" and attaches it to
+// the dispatch ops, where dispatch_ops[i] is the ith call of the result.
+Expected<void> InternalizeCompiledResult(
+    const CompiledResult& compiled_result,
+    absl::Span<const LiteRtOp> dispatch_ops, LiteRtModelT& model) {
   // Register byte code buffers as external buffers. Map the byte code indices
   // to the registered buffer ids.
-  auto num_byte_code = compiled_result->NumByteCodeModules();
+  auto num_byte_code = compiled_result.NumByteCodeModules();
   if (!num_byte_code) {
     return num_byte_code.Error();
   }
@@ -732,7 +773,7 @@ Expected<void> ApplyPluginWithPartition(CompilerPlugin& compiler_plugin,
   std::vector<LiteRtParamIndex> byte_code_idx_to_buf_id(*num_byte_code);
 
   for (auto i = 0; i < *num_byte_code; ++i) {
-    auto byte_code = compiled_result->ByteCode(i);
+    auto byte_code = compiled_result.ByteCode(i);
     if (!byte_code) {
       return byte_code.Error();
     }
@@ -750,7 +791,7 @@ Expected<void> ApplyPluginWithPartition(CompilerPlugin& compiler_plugin,
   for (auto i = 0; i < dispatch_ops.size(); ++i) {
     auto* dispatch_op = dispatch_ops.at(i);
 
-    auto call_info = compiled_result->CallInfo(i);
+    auto call_info = compiled_result.CallInfo(i);
     if (!call_info) {
       return call_info.Error();
     }
@@ -760,6 +801,83 @@ Expected<void> ApplyPluginWithPartition(CompilerPlugin& compiler_plugin,
     model.AttachAssetToOp(dispatch_op, buf_id, std::string(name));
   }
 
+  return {};
+}
+
+// Compiles each partition with its own plugin call, with up to "num_threads"
+// calls in flight. The results of a batch are copied into "model", in
+// partition order, before the next batch starts, so that at most
+// "num_threads" compiled results are alive at any time.
+Expected<void> CompilePartitionsInParallel(CompilerPlugin& compiler_plugin,
+                                           LiteRtModelT& model,
+                                           PartitionResult& partitions,
+                                           absl::string_view soc_model,
+                                           size_t num_threads) {
+  auto& dispatch_ops = partitions.first;
+  auto& sliced_model = partitions.second;
+
+  for (size_t begin = 0; begin < dispatch_ops.size(); begin += num_threads) {
+    const auto batch_size = std::min(num_threads, dispatch_ops.size() - begin);
+
+    // The partitions already compiled have been yanked, so the partitions of
+    // the batch are always the first subgraphs of the sliced model.
+    std::vector<LiteRtModelT> batch_models;
+    batch_models.reserve(batch_size);
+    for (size_t i = 0; i < batch_size; ++i) {
+      batch_models.push_back(sliced_model.Yank({0}));
+    }
+
+    std::vector<std::optional<Expected<CompiledResult>>> results(batch_size);
+    {
+      std::vector<std::thread> workers;
+      workers.reserve(batch_size - 1);
+      for (size_t i = 1; i < batch_size; ++i) {
+        workers.emplace_back([&, i]() {
+          results[i] = compiler_plugin.Compile(&batch_models[i], soc_model);
+        });
+      }
+      results[0] = compiler_plugin.Compile(&batch_models[0], soc_model);
+      for (auto& worker : workers) {
+        worker.join();
+      }
+    }
+
+    for (size_t i = 0; i < batch_size; ++i) {
+      if (!*results[i]) {
+        return results[i]->Error();
+      }
+      LITERT_RETURN_IF_ERROR(InternalizeCompiledResult(
+          **results[i], absl::MakeConstSpan(&dispatch_ops[begin + i], 1),
+          model));
+    }
+  }
+
+  return {};
+}
+
+}  // namespace
+
+Expected<void> ApplyPluginWithPartition(CompilerPlugin& compiler_plugin,
+                                        LiteRtModelT& model,
+                                        PartitionResult partitions,
+                                        absl::string_view soc_model,
+                                        size_t num_compile_threads) {
+  auto& dispatch_ops = partitions.first;
+  auto& sliced_model = partitions.second;
+
+  if (num_compile_threads > 1 && dispatch_ops.size() > 1) {
+    LITERT_RETURN_IF_ERROR(CompilePartitionsInParallel(
+        compiler_plugin, model, partitions, soc_model, num_compile_threads));
+  } else {
+    // Pass sliced subgraphs to plugin for compilation.
+    auto compiled_result = compiler_plugin.Compile(&sliced_model, soc_model);
+    if (!compiled_result) {
+      return compiled_result.Error();
+    }
+    LITERT_RETURN_IF_ERROR(
+        InternalizeCompiledResult(*compiled_result, dispatch_ops, model));
+  }
+
   // Tag the model with make/model from the plugin.
   auto build_stamp =
       MakeBuildStamp(compiler_plugin.SocManufacturer(), soc_model);
@@ -779,6 +897,8 @@ Expected<void> ApplyPluginWithPartition(CompilerPlugin& compiler_plugin,
 Expected<void> TransformModel(CompilerPlugin& compiler_plugin,
                               LiteRtModelT& model,
                               absl::string_view soc_model) {
+  ApplyBuiltinRewrites(model);
+
   auto status = compiler_plugin.RegisterAllTransformations();
   if (!status) {
     return status;
@@ -798,7 +918,8 @@ Expected<void> TransformModel(CompilerPlugin& compiler_plugin,
 Expected<void> ApplyPlugin(
     CompilerPlugin& compiler_plugin, LiteRtModelT& model,
     absl::string_view soc_model,
-    const absl::flat_hash_set<uint32_t>& subgraphs_to_partition) {
+    const absl::flat_hash_set<uint32_t>& subgraphs_to_partition,
+    size_t num_compile_threads) {
   // Compiler Plugin: Transformation, apply transformations to model.
   auto status = TransformModel(compiler_plugin, model, soc_model);
   if (!status) {
@@ -814,7 +935,8 @@ Expected<void> ApplyPlugin(
 
   // Compiler Plugin: Compilation, compile partitions and apply to model.
   return ApplyPluginWithPartition(compiler_plugin, model,
-                                  std::move(*partitions), soc_model);
+                                  std::move(*partitions), soc_model,
+                                  num_compile_threads);
 }
 
 Expected<ApplyPluginsResult> ApplyPlugins(
@@ -205,13 +205,22 @@ Expected<PartitionResult> PartitionModelDirect(
 Expected<void> ApplyPlugin(
     CompilerPlugin& compiler_plugin, LiteRtModelT& model,
     absl::string_view soc_model = "",
-    const absl::flat_hash_set<uint32_t>& subgraphs_to_partition = {});
+    const absl::flat_hash_set<uint32_t>& subgraphs_to_partition = {},
+    size_t num_compile_threads = 1);
 
 // Applies the compilation step to the model given a predetermined partition.
+//
+// By default all the partitions are compiled by a single plugin call. If
+// "num_compile_threads" is greater than 1, each partition is compiled by its
+// own call instead, with up to "num_compile_threads" concurrent calls, which
+// requires the plugin to support concurrent compilation. The byte code is
+// added to the model in partition order either way, and at most
+// "num_compile_threads" compiled results are kept in memory at once.
 Expected<void> ApplyPluginWithPartition(CompilerPlugin& compiler_plugin,
                                         LiteRtModelT& model,
                                         PartitionResult partitions,
-                                        absl::string_view soc_model = "");
+                                        absl::string_view soc_model = "",
+                                        size_t num_compile_threads = 1);
 
 // Applies the transformation registered by vendor plugin to the model.
 Expected<void> TransformModel(CompilerPlugin& compiler_plugin,
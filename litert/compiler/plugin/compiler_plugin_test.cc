@@ -418,6 +418,31 @@ TEST(ApplyTest, MultiSubgraph) {
   EXPECT_TRUE(model.FindMetadata(kLiteRtBuildStampKey));
 }
 
+TEST(ApplyTest, CompilesPartitionsInParallel) {
+  auto plugins =
+      CompilerPlugin::LoadPlugins({GetLiteRtPath(kTestPluginSearchPath)});
+  ASSERT_EQ(plugins->size(), 1);
+  auto model_wrap = testing::LoadTestFileModel("multi_subgraph_mul.tflite");
+  ASSERT_TRUE(model_wrap);
+  auto& model = *model_wrap.Get();
+
+  ASSERT_TRUE(ApplyPlugin(plugins->front(), model, /*soc_model=*/"",
+                          /*subgraphs_to_partition=*/{},
+                          /*num_compile_threads=*/2));
+  ASSERT_EQ(model.NumSubgraphs(), 2);
+
+  // Each partition gets the byte code of its own compilation.
+  auto* op0 = model.Subgraph(0).Ops().front();
+  auto* op1 = model.Subgraph(1).Ops().front();
+  auto asset0 = model.FindOpAsset(op0);
+  auto asset1 = model.FindOpAsset(op1);
+  ASSERT_TRUE(asset0);
+  ASSERT_TRUE(asset1);
+  EXPECT_NE(asset0->first, asset1->first);
+
+  EXPECT_TRUE(model.FindMetadata(kLiteRtBuildStampKey));
+}
+
 TEST(ApplyTest, ApplyPlugins) {
   auto model_wrap = testing::LoadTestFileModel("mul_simple.tflite");
   ASSERT_TRUE(model_wrap);
@@ -721,5 +746,34 @@ TEST(PartitionModelTest, PartitionIsland) {
   EXPECT_EQ(new_model.Subgraphs().at(1)->Ops().size(), 1);
 }
 
+TEST(PartitionModelTest, SmallPartitionStaysOnHost) {
+  auto model_wrap = testing::LoadTestFileModel("island_partial.tflite");
+  auto& model = *model_wrap.Get();
+
+  auto litert_options = Options::Create();
+  auto compiler_options = CompilerOptions::Create();
+  ASSERT_TRUE(compiler_options->SetMinPartitionSize(2));
+  litert_options->AddOpaqueOptions(std::move(*compiler_options));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto plugin,
+      CompilerPlugin::FindPlugin(kTestManufacturer,
+                                 {GetLiteRtPath(kTestPluginSearchPath)},
+                                 /*env=*/nullptr, litert_options->Get()));
+
+  const auto num_ops = model.Subgraphs().front()->Ops().size();
+  auto partition_result = PartitionModel(plugin, model);
+  ASSERT_TRUE(partition_result);
+  ASSERT_EQ(model.NumSubgraphs(), 1);
+
+  const auto& [ops, new_model] = *partition_result;
+
+  // Only the partition of 3 ops is offloaded, the single op stays in place.
+  EXPECT_EQ(ops.size(), 1);
+  EXPECT_EQ(model.Subgraphs().front()->Ops().size(), num_ops - 3 + 1);
+
+  EXPECT_EQ(new_model.NumSubgraphs(), 1);
+  EXPECT_EQ(new_model.Subgraphs().at(0)->Ops().size(), 3);
+}
+
 }  // namespace
 }  // namespace litert::internal
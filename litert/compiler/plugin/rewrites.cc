@@ -0,0 +1,333 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/compiler/plugin/rewrites.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "fp16.h"  // from @FP16
+#include "litert/c/internal/litert_logging.h"
+#include "litert/c/litert_model_types.h"
+#include "litert/c/litert_op_code.h"
+#include "litert/cc/litert_buffer_ref.h"
+#include "litert/core/model/model.h"
+#include "litert/core/util/flatbuffer_tools.h"
+#include "tflite/schema/schema_generated.h"
+
+namespace litert::internal {
+namespace {
+
+// Whether `a` and `b` have the same ranked type with a fully static shape.
+bool HaveSameStaticType(const LiteRtTensorT& a, const LiteRtTensorT& b) {
+  auto a_type = a.Ranked();
+  auto b_type = b.Ranked();
+  if (!a_type || !b_type || a_type->element_type != b_type->element_type ||
+      a_type->layout.rank != b_type->layout.rank) {
+    return false;
+  }
+  for (auto i = 0; i < a_type->layout.rank; ++i) {
+    if (a_type->layout.dimensions[i] < 0 ||
+        a_type->layout.dimensions[i] != b_type->layout.dimensions[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HaveSameQuantization(const LiteRtTensorT& a, const LiteRtTensorT& b) {
+  const auto& [a_type, a_detail] = a.Qparams();
+  const auto& [b_type, b_detail] = b.Qparams();
+  if (a_type != b_type) {
+    return false;
+  }
+  switch (a_type) {
+    case kLiteRtQuantizationNone:
+      return true;
+    case kLiteRtQuantizationPerTensor:
+      return a_detail.per_tensor.scale == b_detail.per_tensor.scale &&
+             a_detail.per_tensor.zero_point == b_detail.per_tensor.zero_point;
+    default:
+      // Conservatively consider other quantizations as different.
+      return false;
+  }
+}
+
+bool IsFloat32(const LiteRtTensorT& tensor) {
+  auto type = tensor.Ranked();
+  return type && type->element_type == kLiteRtElementTypeFloat32 &&
+         tensor.Qparams().first == kLiteRtQuantizationNone;
+}
+
+// Makes the users of `from` use `to` instead.
+void ReplaceAllUses(LiteRtTensorT& from, LiteRtTensorT& to) {
+  while (from.NumUses() > 0) {
+    auto [user, arg_ind] = from.GetUse(0);
+    user->Inputs()[arg_ind] = &to;
+    to.Users().push_back(user);
+    to.UserArgInds().push_back(arg_ind);
+    from.RemoveUse(0);
+  }
+}
+
+template <typename T>
+std::vector<T> CopyWeights(const LiteRtTensorT& tensor) {
+  auto buffer = tensor.Weights().Buffer();
+  std::vector<T> values(buffer.Size() / sizeof(T));
+  std::memcpy(values.data(), buffer.Data(), values.size() * sizeof(T));
+  return values;
+}
+
+bool IsIdentityPermutation(const LiteRtTensorT& perm) {
+  if (!IsConstant(perm)) {
+    return false;
+  }
+  auto type = perm.Ranked();
+  if (!type) {
+    return false;
+  }
+  std::vector<int64_t> values;
+  if (type->element_type == kLiteRtElementTypeInt32) {
+    for (auto value : CopyWeights<int32_t>(perm)) {
+      values.push_back(value);
+    }
+  } else if (type->element_type == kLiteRtElementTypeInt64) {
+    values = CopyWeights<int64_t>(perm);
+  } else {
+    return false;
+  }
+  for (auto i = 0; i < values.size(); ++i) {
+    if (values[i] != i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+std::optional<std::vector<float>> DequantizeInts(const LiteRtTensorT& tensor) {
+  const std::vector<T> values = CopyWeights<T>(tensor);
+  std::vector<float> result(values.size());
+  const auto& [quantization_type, quantization] = tensor.Qparams();
+  if (quantization_type == kLiteRtQuantizationPerTensor) {
+    for (auto i = 0; i < values.size(); ++i) {
+      result[i] = (values[i] - quantization.per_tensor.zero_point) *
+                  quantization.per_tensor.scale;
+    }
+    return result;
+  }
+  if (quantization_type != kLiteRtQuantizationPerChannel) {
+    return std::nullopt;
+  }
+
+  const auto& per_channel = quantization.per_channel;
+  const auto& layout = tensor.Ranked()->layout;
+  if (per_channel.quantized_dimension < 0 ||
+      per_channel.quantized_dimension >= layout.rank ||
+      layout.dimensions[per_channel.quantized_dimension] !=
+          per_channel.num_channels) {
+    return std::nullopt;
+  }
+  size_t inner_size = 1;
+  for (auto d = per_channel.quantized_dimension + 1; d < layout.rank; ++d) {
+    inner_size *= layout.dimensions[d];
+  }
+  for (auto i = 0; i < values.size(); ++i) {
+    const size_t channel = (i / inner_size) % per_channel.num_channels;
+    result[i] = (values[i] - per_channel.zero_points[channel]) *
+                per_channel.scales[channel];
+  }
+  return result;
+}
+
+std::optional<std::vector<float>> Dequantize(const LiteRtTensorT& tensor) {
+  switch (tensor.Ranked()->element_type) {
+    case kLiteRtElementTypeFloat16: {
+      const std::vector<uint16_t> values = CopyWeights<uint16_t>(tensor);
+      std::vector<float> result(values.size());
+      for (auto i = 0; i < values.size(); ++i) {
+        result[i] = fp16_ieee_to_fp32_value(values[i]);
+      }
+      return result;
+    }
+    case kLiteRtElementTypeInt8:
+      return DequantizeInts<int8_t>(tensor);
+    case kLiteRtElementTypeInt16:
+      return DequantizeInts<int16_t>(tensor);
+    default:
+      return std::nullopt;
+  }
+}
+
+// Returns the fused activation of the options of the ops that support one,
+// null otherwise.
+tflite::ActivationFunctionType* GetFusedActivation(TflOptions& options) {
+  switch (options.type) {
+    case tflite::BuiltinOptions_AddOptions:
+      return &options.AsAddOptions()->fused_activation_function;
+    case tflite::BuiltinOptions_SubOptions:
+      return &options.AsSubOptions()->fused_activation_function;
+    case tflite::BuiltinOptions_MulOptions:
+      return &options.AsMulOptions()->fused_activation_function;
+    case tflite::BuiltinOptions_Conv2DOptions:
+      return &options.AsConv2DOptions()->fused_activation_function;
+    case tflite::BuiltinOptions_DepthwiseConv2DOptions:
+      return &options.AsDepthwiseConv2DOptions()->fused_activation_function;
+    case tflite::BuiltinOptions_FullyConnectedOptions:
+      return &options.AsFullyConnectedOptions()->fused_activation_function;
+    default:
+      return nullptr;
+  }
+}
+
+std::optional<tflite::ActivationFunctionType> GetActivation(
+    LiteRtOpCode op_code) {
+  switch (op_code) {
+    case kLiteRtOpCodeTflRelu:
+      return tflite::ActivationFunctionType_RELU;
+    case kLiteRtOpCodeTflRelu6:
+      return tflite::ActivationFunctionType_RELU6;
+    case kLiteRtOpCodeTflReluN1To1:
+      return tflite::ActivationFunctionType_RELU_N1_TO_1;
+    default:
+      return std::nullopt;
+  }
+}
+
+}  // namespace
+
+size_t RemoveNoOpReshapesAndTransposes(LiteRtSubgraphT& subgraph) {
+  size_t num_removed = 0;
+  const std::vector<LiteRtOp> ops(subgraph.Ops().begin(), subgraph.Ops().end());
+  for (LiteRtOp op : ops) {
+    if (op->OpCode() != kLiteRtOpCodeTflReshape &&
+        op->OpCode() != kLiteRtOpCodeTflTranspose) {
+      continue;
+    }
+    if (op->NumInputs() < 1 || op->NumOutputs() != 1) {
+      continue;
+    }
+    auto& input = op->Input(0);
+    auto& output = op->Output(0);
+    if (IsIO(subgraph, output) || !HaveSameStaticType(input, output) ||
+        !HaveSameQuantization(input, output)) {
+      continue;
+    }
+    if (op->OpCode() == kLiteRtOpCodeTflTranspose &&
+        (op->NumInputs() != 2 || !IsIdentityPermutation(op->Input(1)))) {
+      continue;
+    }
+    ReplaceAllUses(output, input);
+    Drop(*op);
+    ++num_removed;
+  }
+  if (num_removed > 0) {
+    DCE(subgraph);
+  }
+  return num_removed;
+}
+
+size_t FoldConstantDequantize(LiteRtSubgraphT& subgraph) {
+  size_t num_folded = 0;
+  const std::vector<LiteRtOp> ops(subgraph.Ops().begin(), subgraph.Ops().end());
+  for (LiteRtOp op : ops) {
+    if (op->OpCode() != kLiteRtOpCodeTflDequantize || op->NumInputs() != 1 ||
+        op->NumOutputs() != 1) {
+      continue;
+    }
+    auto& input = op->Input(0);
+    auto& output = op->Output(0);
+    if (!IsConstant(input) || !input.Ranked() || IsIO(subgraph, output) ||
+        !IsFloat32(output) || input.NumElements() != output.NumElements()) {
+      continue;
+    }
+    auto values = Dequantize(input);
+    if (!values || values->size() != output.NumElements()) {
+      continue;
+    }
+
+    Drop(*op);
+    output.Weights().SetBufferManager(input.Weights().GetBufferManager());
+    SetWeightsFromOwnedBuffer(
+        output.Weights(),
+        OwningBufferRef<uint8_t>(
+            reinterpret_cast<const uint8_t*>(values->data()),
+            values->size() * sizeof(float)));
+    ++num_folded;
+  }
+  if (num_folded > 0) {
+    DCE(subgraph);
+  }
+  return num_folded;
+}
+
+size_t FuseActivations(LiteRtSubgraphT& subgraph) {
+  size_t num_fused = 0;
+  const std::vector<LiteRtOp> ops(subgraph.Ops().begin(), subgraph.Ops().end());
+  for (LiteRtOp activation_op : ops) {
+    const auto activation = GetActivation(activation_op->OpCode());
+    if (!activation || activation_op->NumInputs() != 1 ||
+        activation_op->NumOutputs() != 1) {
+      continue;
+    }
+    auto& input = activation_op->Input(0);
+    auto& output = activation_op->Output(0);
+    LiteRtOp producer = input.DefiningOp();
+    if (producer == nullptr || producer->NumOutputs() != 1 ||
+        input.NumUses() != 1 || IsIO(subgraph, input) || !IsFloat32(input) ||
+        !IsFloat32(output)) {
+      continue;
+    }
+
+    TflOptions options = TakeTflOptions(*producer);
+    auto* fused_activation = GetFusedActivation(options);
+    const bool fusable =
+        fused_activation != nullptr &&
+        *fused_activation == tflite::ActivationFunctionType_NONE;
+    if (fusable) {
+      *fused_activation = *activation;
+    }
+    SetTflOptions(*producer, std::move(options));
+    if (!fusable) {
+      continue;
+    }
+
+    DisconnectOutput(*producer, 0);
+    Drop(*activation_op);
+    AttachOutput(&output, *producer);
+    ++num_fused;
+  }
+  if (num_fused > 0) {
+    DCE(subgraph);
+  }
+  return num_fused;
+}
+
+size_t ApplyBuiltinRewrites(LiteRtModelT& model) {
+  size_t num_rewritten = 0;
+  for (auto* subgraph : model.Subgraphs()) {
+    num_rewritten += RemoveNoOpReshapesAndTransposes(*subgraph);
+    num_rewritten += FoldConstantDequantize(*subgraph);
+    num_rewritten += FuseActivations(*subgraph);
+  }
+  LITERT_LOG(LITERT_INFO, "Built-in rewrites removed or rewrote %zu ops.",
+             num_rewritten);
+  return num_rewritten;
+}
+
+}  // namespace litert::internal
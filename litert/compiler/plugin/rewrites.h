@@ -0,0 +1,49 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_COMPILER_PLUGIN_REWRITES_H_
+#define ODML_LITERT_LITERT_COMPILER_PLUGIN_REWRITES_H_
+
+#include <cstddef>
+
+#include "litert/core/model/model.h"
+
+namespace litert::internal {
+
+// Built-in rewrites applied to the model before the transformations and the
+// partitioning of the compiler plugins, so that every backend sees the same
+// simplified graph, including for models from older converters. Each rewrite
+// returns the number of ops it removed or rewrote, and leaves the subgraph IO
+// untouched.
+
+// Removes the RESHAPE ops whose output has the same static shape as their
+// input, and the TRANSPOSE ops with an identity permutation.
+size_t RemoveNoOpReshapesAndTransposes(LiteRtSubgraphT& subgraph);
+
+// Replaces the DEQUANTIZE ops of constant float16, int8 or int16 tensors with
+// the equivalent float32 constants.
+size_t FoldConstantDequantize(LiteRtSubgraphT& subgraph);
+
+// Fuses the RELU, RELU6 and RELU_N1_TO_1 ops into the fused activation of the
+// float ADD, SUB, MUL, CONV_2D, DEPTHWISE_CONV_2D or FULLY_CONNECTED op that
+// produces their input.
+size_t FuseActivations(LiteRtSubgraphT& subgraph);
+
+// Applies all the rewrites above to every subgraph of `model`. Returns the
+// number of ops removed or rewritten.
+size_t ApplyBuiltinRewrites(LiteRtModelT& model);
+
+}  // namespace litert::internal
+
+#endif  // ODML_LITERT_LITERT_COMPILER_PLUGIN_REWRITES_H_
@@ -0,0 +1,226 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/compiler/plugin/rewrites.h"
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_model_types.h"
+#include "litert/c/litert_op_code.h"
+#include "litert/cc/litert_buffer_ref.h"
+#include "litert/core/model/model.h"
+#include "litert/core/util/flatbuffer_tools.h"
+#include "tflite/schema/schema_generated.h"
+
+namespace litert::internal {
+namespace {
+
+using ::testing::ElementsAre;
+
+LiteRtTensorT& MakeTensor(LiteRtSubgraphT& subgraph,
+                          LiteRtElementType element_type,
+                          std::initializer_list<int32_t> dims) {
+  auto& tensor = subgraph.EmplaceTensor();
+  tensor.SetType(MakeRankedTensorType(
+      element_type, absl::MakeConstSpan(dims.begin(), dims.size())));
+  return tensor;
+}
+
+template <typename T>
+LiteRtTensorT& MakeConstant(LiteRtSubgraphT& subgraph,
+                            LiteRtElementType element_type,
+                            const std::vector<T>& values) {
+  auto& tensor = MakeTensor(subgraph, element_type,
+                            {static_cast<int32_t>(values.size())});
+  SetWeightsFromOwnedBuffer(
+      tensor.Weights(),
+      OwningBufferRef<uint8_t>(reinterpret_cast<const uint8_t*>(values.data()),
+                               values.size() * sizeof(T)));
+  return tensor;
+}
+
+LiteRtOpT& MakeOp(LiteRtSubgraphT& subgraph, LiteRtOpCode op_code,
+                  std::vector<LiteRtTensor> inputs,
+                  std::vector<LiteRtTensor> outputs) {
+  auto& op = subgraph.EmplaceOp();
+  op.SetOpCode(op_code);
+  for (auto* input : inputs) {
+    AttachInput(input, op);
+  }
+  for (auto* output : outputs) {
+    AttachOutput(output, op);
+  }
+  return op;
+}
+
+LiteRtOpT& MakeAdd(LiteRtSubgraphT& subgraph, LiteRtTensorT& lhs,
+                   LiteRtTensorT& rhs, LiteRtTensorT& output) {
+  auto& add = MakeOp(subgraph, kLiteRtOpCodeTflAdd, {&lhs, &rhs}, {&output});
+  TflOptions options;
+  options.Set(tflite::AddOptionsT());
+  SetTflOptions(add, std::move(options));
+  return add;
+}
+
+std::vector<float> GetFloats(const LiteRtTensorT& tensor) {
+  auto buffer = tensor.Weights().Buffer();
+  std::vector<float> values(buffer.Size() / sizeof(float));
+  std::memcpy(values.data(), buffer.Data(), buffer.Size());
+  return values;
+}
+
+TEST(RewritesTest, RemovesNoOpReshape) {
+  LiteRtSubgraphT subgraph;
+  auto& input = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2, 3});
+  auto& shape = MakeConstant<int32_t>(subgraph, kLiteRtElementTypeInt32,
+                                      {2, 3});
+  auto& reshaped = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2, 3});
+  auto& output = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2, 3});
+  MakeOp(subgraph, kLiteRtOpCodeTflReshape, {&input, &shape}, {&reshaped});
+  auto& add = MakeAdd(subgraph, reshaped, reshaped, output);
+  subgraph.Inputs().push_back(&input);
+  subgraph.Outputs().push_back(&output);
+
+  EXPECT_EQ(RemoveNoOpReshapesAndTransposes(subgraph), 1);
+  ASSERT_EQ(subgraph.Ops().size(), 1);
+  EXPECT_EQ(subgraph.Ops()[0], &add);
+  EXPECT_THAT(add.Inputs(), ElementsAre(&input, &input));
+  EXPECT_EQ(input.NumUses(), 2);
+  EXPECT_EQ(subgraph.Tensors().size(), 2);
+}
+
+TEST(RewritesTest, KeepsReshapeChangingShape) {
+  LiteRtSubgraphT subgraph;
+  auto& input = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2, 3});
+  auto& shape = MakeConstant<int32_t>(subgraph, kLiteRtElementTypeInt32,
+                                      {3, 2});
+  auto& reshaped = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {3, 2});
+  auto& output = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {3, 2});
+  MakeOp(subgraph, kLiteRtOpCodeTflReshape, {&input, &shape}, {&reshaped});
+  MakeAdd(subgraph, reshaped, reshaped, output);
+  subgraph.Inputs().push_back(&input);
+  subgraph.Outputs().push_back(&output);
+
+  EXPECT_EQ(RemoveNoOpReshapesAndTransposes(subgraph), 0);
+  EXPECT_EQ(subgraph.Ops().size(), 2);
+}
+
+TEST(RewritesTest, RemovesIdentityTransposeOnly) {
+  LiteRtSubgraphT subgraph;
+  auto& input = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2, 2});
+  auto& identity = MakeConstant<int32_t>(subgraph, kLiteRtElementTypeInt32,
+                                         {0, 1});
+  auto& swap = MakeConstant<int32_t>(subgraph, kLiteRtElementTypeInt32,
+                                     {1, 0});
+  auto& transposed = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2, 2});
+  auto& output = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2, 2});
+  MakeOp(subgraph, kLiteRtOpCodeTflTranspose, {&input, &identity},
+         {&transposed});
+  auto& swap_op = MakeOp(subgraph, kLiteRtOpCodeTflTranspose,
+                         {&transposed, &swap}, {&output});
+  subgraph.Inputs().push_back(&input);
+  subgraph.Outputs().push_back(&output);
+
+  EXPECT_EQ(RemoveNoOpReshapesAndTransposes(subgraph), 1);
+  ASSERT_EQ(subgraph.Ops().size(), 1);
+  EXPECT_EQ(subgraph.Ops()[0], &swap_op);
+  EXPECT_EQ(&swap_op.Input(0), &input);
+}
+
+TEST(RewritesTest, FoldsFloat16Dequantize) {
+  LiteRtSubgraphT subgraph;
+  auto& input = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2});
+  // 1.0 and -2.0 in float16.
+  auto& weights = MakeConstant<uint16_t>(subgraph, kLiteRtElementTypeFloat16,
+                                         {0x3C00, 0xC000});
+  auto& dequantized = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2});
+  auto& output = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2});
+  MakeOp(subgraph, kLiteRtOpCodeTflDequantize, {&weights}, {&dequantized});
+  auto& add = MakeAdd(subgraph, input, dequantized, output);
+  subgraph.Inputs().push_back(&input);
+  subgraph.Outputs().push_back(&output);
+
+  EXPECT_EQ(FoldConstantDequantize(subgraph), 1);
+  ASSERT_EQ(subgraph.Ops().size(), 1);
+  EXPECT_EQ(subgraph.Ops()[0], &add);
+  EXPECT_EQ(&add.Input(1), &dequantized);
+  EXPECT_TRUE(IsConstant(dequantized));
+  EXPECT_EQ(dequantized.DefiningOp(), nullptr);
+  EXPECT_THAT(GetFloats(dequantized), ElementsAre(1.0f, -2.0f));
+}
+
+TEST(RewritesTest, FoldsPerTensorInt8Dequantize) {
+  LiteRtSubgraphT subgraph;
+  auto& input = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {3});
+  auto& weights = MakeConstant<int8_t>(subgraph, kLiteRtElementTypeInt8,
+                                       {-1, 1, 5});
+  weights.SetQarams(MakePerTensorQuantization(/*scale=*/0.5f,
+                                              /*zero_point=*/1));
+  auto& dequantized = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {3});
+  auto& output = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {3});
+  MakeOp(subgraph, kLiteRtOpCodeTflDequantize, {&weights}, {&dequantized});
+  MakeAdd(subgraph, input, dequantized, output);
+  subgraph.Inputs().push_back(&input);
+  subgraph.Outputs().push_back(&output);
+
+  EXPECT_EQ(FoldConstantDequantize(subgraph), 1);
+  EXPECT_EQ(subgraph.Ops().size(), 1);
+  EXPECT_THAT(GetFloats(dequantized), ElementsAre(-1.0f, 0.0f, 2.0f));
+}
+
+TEST(RewritesTest, FusesRelu) {
+  LiteRtSubgraphT subgraph;
+  auto& input = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2});
+  auto& sum = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2});
+  auto& output = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2});
+  auto& add = MakeAdd(subgraph, input, input, sum);
+  MakeOp(subgraph, kLiteRtOpCodeTflRelu, {&sum}, {&output});
+  subgraph.Inputs().push_back(&input);
+  subgraph.Outputs().push_back(&output);
+
+  EXPECT_EQ(FuseActivations(subgraph), 1);
+  ASSERT_EQ(subgraph.Ops().size(), 1);
+  EXPECT_EQ(subgraph.Ops()[0], &add);
+  EXPECT_EQ(output.DefiningOp(), &add);
+  EXPECT_THAT(add.Outputs(), ElementsAre(&output));
+  EXPECT_EQ(GetTflOptions(add).AsAddOptions()->fused_activation_function,
+            tflite::ActivationFunctionType_RELU);
+}
+
+TEST(RewritesTest, KeepsActivationOfSharedOutput) {
+  LiteRtSubgraphT subgraph;
+  auto& input = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2});
+  auto& sum = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2});
+  auto& output = MakeTensor(subgraph, kLiteRtElementTypeFloat32, {2});
+  auto& add = MakeAdd(subgraph, input, input, sum);
+  MakeOp(subgraph, kLiteRtOpCodeTflRelu6, {&sum}, {&output});
+  subgraph.Inputs().push_back(&input);
+  subgraph.Outputs().push_back(&sum);
+  subgraph.Outputs().push_back(&output);
+
+  EXPECT_EQ(FuseActivations(subgraph), 0);
+  EXPECT_EQ(subgraph.Ops().size(), 2);
+  EXPECT_EQ(GetTflOptions(add).AsAddOptions()->fused_activation_function,
+            tflite::ActivationFunctionType_NONE);
+}
+
+}  // namespace
+}  // namespace litert::internal
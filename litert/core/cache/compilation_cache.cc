@@ -14,13 +14,13 @@
 
 #include "litert/core/cache/compilation_cache.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
-#include <functional>
-#include <ios>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -28,8 +28,11 @@
 #include <sys/system_properties.h>
 #endif  // __ANDROID__
 
+#include "absl/strings/numbers.h"  // from @com_google_absl
 #include "absl/strings/str_cat.h"  // from @com_google_absl
+#include "absl/strings/str_split.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/strings/strip.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_opaque_options.h"
@@ -48,10 +51,49 @@ namespace litert::internal {
 
 namespace {
 
+constexpr absl::string_view kModelFileExtension = ".tflite";
+
+// First line of the manifest. Bump the version when the format of the
+// manifest or the way the model hashes are computed changes.
+constexpr absl::string_view kManifestHeader = "litert_compilation_cache v2";
+
+// Seed of the checksum of the cached files, so that it is independent of the
+// model hash.
+constexpr uint64_t kChecksumSeed = 0x6c69746572742d63ULL;
+
+// Seed of the digest of the source models, so that it is independent of both
+// the model hash and the checksum.
+constexpr uint64_t kSourceDigestSeed = 0x6c69746572742d73ULL;
+
 std::string GetCachedModelFilePath(absl::string_view cache_root_path,
                                    uint64_t model_hash) {
   return litert::internal::Join(
-      {cache_root_path, absl::StrCat(model_hash, ".tflite")});
+      {cache_root_path, absl::StrCat(model_hash, kModelFileExtension)});
+}
+
+std::string GetManifestFilePath(absl::string_view cache_root_path) {
+  return litert::internal::Join(
+      {cache_root_path, CompilationCache::kManifestFileName});
+}
+
+uint64_t GetChecksum(const void* data, size_t size) {
+  return StableHash(data, size, kChecksumSeed);
+}
+
+// Parses a '<hash> <size> <checksum> <source size> <source hash> <last_use>'
+// manifest line.
+bool ParseManifestLine(absl::string_view line, uint64_t& model_hash,
+                       uint64_t& size, uint64_t& checksum,
+                       CompilationCache::SourceDigest& source,
+                       uint64_t& last_use) {
+  std::vector<absl::string_view> fields =
+      absl::StrSplit(line, ' ', absl::SkipEmpty());
+  return fields.size() == 6 && absl::SimpleAtoi(fields[0], &model_hash) &&
+         absl::SimpleAtoi(fields[1], &size) &&
+         absl::SimpleAtoi(fields[2], &checksum) &&
+         absl::SimpleAtoi(fields[3], &source.size) &&
+         absl::SimpleAtoi(fields[4], &source.hash) &&
+         absl::SimpleAtoi(fields[5], &last_use);
 }
 
 Expected<std::vector<litert::internal::CompilationCache::CompilerPluginInfo>>
@@ -82,6 +124,13 @@ uint64_t GetHash(const LiteRtOptionsT& options) {
   );
 
   for (LiteRtOpaqueOptions it = options.options; it;) {
+    // The identifier is always part of the hash, so that adding or removing
+    // the options of a vendor changes the hash even if they can't be hashed.
+    const char* identifier = nullptr;
+    if (LiteRtGetOpaqueOptionsIdentifier(it, &identifier) == kLiteRtStatusOk &&
+        identifier != nullptr) {
+      HashCombine(seed, std::string_view(identifier));
+    }
     uint64_t opaque_hash = 0;
     // It's fine if an opaque option doesn't implement hashing; we skip it.
     if (LiteRtGetOpaqueOptionsHash(it, &opaque_hash) == kLiteRtStatusOk) {
@@ -94,10 +143,7 @@ uint64_t GetHash(const LiteRtOptionsT& options) {
 }
 
 uint64_t GetHash(const LiteRtApiVersion& api_version) {
-  std::string_view api_version_str(reinterpret_cast<const char*>(&api_version),
-                                   sizeof(api_version));
-  std::hash<std::string_view> hasher;
-  return hasher(api_version_str);
+  return StableHash(&api_version, sizeof(api_version));
 }
 
 uint64_t GetHash(
@@ -108,6 +154,23 @@ uint64_t GetHash(
   return ans;
 }
 
+uint64_t GetHash(const LiteRtTensorT& tensor) {
+  uint64_t seed = 0;
+  const TensorType& type = tensor.Type();
+  HashCombine(seed, type.first);
+  if (type.first == kLiteRtRankedTensorType) {
+    const LiteRtRankedTensorType& ranked = type.second.ranked_tensor_type;
+    HashCombine(seed, ranked.element_type,
+                static_cast<uint32_t>(ranked.layout.rank));
+    for (int i = 0; i < ranked.layout.rank; ++i) {
+      HashCombine(seed, ranked.layout.dimensions[i]);
+    }
+  } else {
+    HashCombine(seed, type.second.unranked_tensor_type.element_type);
+  }
+  return seed;
+}
+
 Expected<uint64_t> GetHash(const LiteRtModelT& model) {
   const ::litert::internal::FlatbufferWrapper& tfl_wrapper =
       litert::internal::GetTflFlatbuffer(model);
@@ -116,21 +179,64 @@ Expected<uint64_t> GetHash(const LiteRtModelT& model) {
     return Unexpected(kLiteRtStatusErrorNotFound, "Model buffer is null");
   }
 
-  std::string_view tfl_buf_str(reinterpret_cast<const char*>(tfl_buf.StrData()),
-                               tfl_buf.Size());
-  std::hash<std::string_view> hasher;
-  const uint64_t model_hash = hasher(tfl_buf_str);
+  uint64_t model_hash = StableHash(tfl_buf.Data(), tfl_buf.Size());
+  // The shapes of the subgraph inputs and outputs may have been changed at
+  // runtime, without being reflected in the serialized buffer yet.
+  for (const LiteRtSubgraph subgraph : model.Subgraphs()) {
+    for (const LiteRtTensor tensor : subgraph->Inputs()) {
+      HashCombine(model_hash, GetHash(*tensor));
+    }
+    for (const LiteRtTensor tensor : subgraph->Outputs()) {
+      HashCombine(model_hash, GetHash(*tensor));
+    }
+  }
   return model_hash;
 }
 }  // namespace
 
 Expected<CompilationCache> CompilationCache::Create(
-    absl::string_view cache_root_path) {
+    absl::string_view cache_root_path, size_t max_size_bytes) {
   if (!Exists(cache_root_path)) {
     return Unexpected(kLiteRtStatusErrorNotFound,
                       "Cache root path does not exist");
   }
-  return CompilationCache(cache_root_path);
+  CompilationCache cache(cache_root_path, max_size_bytes);
+  cache.SyncManifest();
+
+  // Account for the cached models without a manifest entry as the least
+  // recently used ones, so that they count towards the budget.
+  LITERT_ASSIGN_OR_RETURN(std::vector<std::string> files,
+                          ListDir(cache_root_path));
+  for (const std::string& file : files) {
+    LITERT_ASSIGN_OR_RETURN(std::string file_name, Filename(file));
+    absl::string_view name = file_name;
+    uint64_t model_hash;
+    if (!absl::ConsumeSuffix(&name, kModelFileExtension) ||
+        !absl::SimpleAtoi(name, &model_hash) ||
+        cache.entries_.contains(model_hash)) {
+      continue;
+    }
+    if (auto size = Size(file); size) {
+      cache.entries_[model_hash] = {.size = *size};
+    }
+  }
+  const size_t num_entries = cache.entries_.size();
+  cache.Evict(/*incoming_size=*/0);
+  if (cache.entries_.size() != num_entries) {
+    if (auto status = cache.WriteManifest(); !status) {
+      LITERT_LOG(LITERT_WARNING, "Failed to update the cache manifest: %s",
+                 status.Error().Message().c_str());
+    }
+  }
+  return cache;
+}
+
+size_t CompilationCache::SizeBytes() const {
+  size_t size = 0;
+  for (const auto& [model_hash, entry] : entries_) {
+    size += entry.size;
+  }
+  return size;
 }
 
 Expected<uint64_t> CompilationCache::GetModelHash(
@@ -182,55 +288,194 @@ litert::Expected<uint64_t> CompilationCache::TryGetModelHash(
       model, *options, compiler_plugin_infos);
 }
 
+Expected<CompilationCache::SourceDigest> CompilationCache::GetSourceDigest(
+    const LiteRtModelT& model) {
+  const litert::BufferRef<uint8_t>& tfl_buf =
+      litert::internal::GetTflFlatbuffer(model).Buf();
+  if (tfl_buf.Data() == nullptr || tfl_buf.Size() == 0) {
+    return Unexpected(kLiteRtStatusErrorNotFound, "Model buffer is null");
+  }
+  return SourceDigest{
+      .size = tfl_buf.Size(),
+      .hash = StableHash(tfl_buf.Data(), tfl_buf.Size(), kSourceDigestSeed),
+  };
+}
+
 Expected<void> CompilationCache::SaveModel(const LiteRtModelT& model,
-                                           uint64_t model_hash) {
+                                           uint64_t model_hash,
+                                           const SourceDigest& source_digest) {
   const ::litert::internal::FlatbufferWrapper& tfl_wrapper =
       litert::internal::GetTflFlatbuffer(model);
   const litert::BufferRef<uint8_t>& tfl_buf = tfl_wrapper.Buf();
-  return SaveModel(tfl_buf, model_hash);
+  return SaveModel(tfl_buf, model_hash, source_digest);
 }
 
 Expected<void> CompilationCache::SaveModel(
-    const litert::BufferRef<uint8_t>& model_buffer, uint64_t model_hash) {
-  const std::string cached_model_file_path =
-      GetCachedModelFilePath(cache_root_path_, model_hash);
-  std::ofstream output_file(cached_model_file_path,
-                            std::ios::out | std::ios::binary);
-  if (!output_file.is_open()) {
-    LITERT_LOG(LITERT_ERROR, "Failed to open cache file for writing: %s",
-               cached_model_file_path.c_str());
-    return Unexpected(kLiteRtStatusErrorFileIO,
-                      "Failed to open cache file for writing");
+    const litert::BufferRef<uint8_t>& model_buffer, uint64_t model_hash,
+    const SourceDigest& source_digest) {
+  const size_t size = model_buffer.Size();
+  if (size > max_size_bytes_) {
+    LITERT_LOG(LITERT_INFO,
+               "Model of %zu bytes exceeds the cache budget, not caching it",
+               size);
+    return {};
   }
 
-  size_t data_size = model_buffer.Size();
-  const char* data = reinterpret_cast<const char*>(model_buffer.Data());
-  output_file.write(data, data_size);
+  SyncManifest();
+  // The entry, if any, is replaced by the new model.
+  entries_.erase(model_hash);
+  Evict(size);
 
-  if (!output_file.good()) {
-    LITERT_LOG(LITERT_ERROR, "Failed to write all data to cache file: %s",
-               cached_model_file_path.c_str());
-    return Unexpected(kLiteRtStatusErrorFileIO,
-                      "Failed to write all data to cache file");
-  }
-  return Expected<void>();
+  const std::string cached_model_file_path =
+      GetCachedModelFilePath(cache_root_path_, model_hash);
+  LITERT_RETURN_IF_ERROR(WriteFileAtomically(
+      cached_model_file_path,
+      absl::string_view(model_buffer.StrData(), model_buffer.Size())));
+  entries_[model_hash] = {
+      .size = size,
+      .checksum = GetChecksum(model_buffer.Data(), size),
+      .source = source_digest,
+      .last_use = ++clock_,
+  };
+  return WriteManifest();
 }
 
 Expected<std::optional<LiteRtModelT::Ptr>> CompilationCache::TryLoadModel(
-    uint64_t model_hash) {
-  std::string expected_model_file_path =
+    uint64_t model_hash, const SourceDigest& source_digest) {
+  auto it = entries_.find(model_hash);
+  if (it == entries_.end()) {
+    return Expected<std::optional<LiteRtModelT::Ptr>>(std::nullopt);
+  }
+  if (it->second.source.size == 0) {
+    // Nothing tells which source model the file was compiled from.
+    LITERT_LOG(LITERT_INFO, "Dropping cached model %llu of unknown source",
+               static_cast<unsigned long long>(model_hash));  // NOLINT
+    RemoveEntry(model_hash);
+    WriteManifest();
+    return Expected<std::optional<LiteRtModelT::Ptr>>(std::nullopt);
+  }
+  if (it->second.source != source_digest) {
+    // The hash collides with the one of another model. The entry stays, and
+    // is replaced if the caller saves its own compiled model.
+    LITERT_LOG(LITERT_WARNING,
+               "Cached model %llu was compiled from another source model",
+               static_cast<unsigned long long>(model_hash));  // NOLINT
+    return Expected<std::optional<LiteRtModelT::Ptr>>(std::nullopt);
+  }
+
+  const std::string cached_model_file_path =
       GetCachedModelFilePath(cache_root_path_, model_hash);
-  if (!Exists(expected_model_file_path)) {
+  Expected<size_t> file_size = Size(cached_model_file_path);
+  if (!file_size) {
+    // The model was removed, e.g. evicted by another process.
+    entries_.erase(it);
     return Expected<std::optional<LiteRtModelT::Ptr>>(std::nullopt);
   }
 
-  LITERT_ASSIGN_OR_RETURN(
-      LiteRtModelT::Ptr cached_model,
-      litert::internal::LoadModelFromFile(expected_model_file_path));
+  // The file is memory mapped: the weights and the NPU bytecode are
+  // registered in the BufferManager of the model as non-owned views of the
+  // mapping, so they go from the page cache to the dispatch API without a
+  // heap copy. The mapping stays valid if the file is later replaced or
+  // evicted, since both unlink the file instead of truncating it.
+  Entry& entry = it->second;
+  LiteRtModelT::Ptr cached_model;
+  if (*file_size == entry.size) {
+    auto model = litert::internal::LoadModelFromFile(cached_model_file_path);
+    if (model) {
+      cached_model = std::move(*model);
+    }
+  }
+  uint64_t checksum = 0;
+  if (cached_model) {
+    const BufferRef<uint8_t> model_buffer =
+        GetTflFlatbuffer(*cached_model).Buf();
+    checksum = GetChecksum(model_buffer.Data(), model_buffer.Size());
+  }
+  if (!cached_model || (entry.checksum != 0 && checksum != entry.checksum)) {
+    LITERT_LOG(LITERT_WARNING, "Dropping corrupted cached model: %s",
+               cached_model_file_path.c_str());
+    cached_model.reset();
+    RemoveEntry(model_hash);
+    WriteManifest();
+    return Expected<std::optional<LiteRtModelT::Ptr>>(std::nullopt);
+  }
+  entry.checksum = checksum;
+  entry.last_use = ++clock_;
+  SyncManifest();
+  if (auto status = WriteManifest(); !status) {
+    LITERT_LOG(LITERT_WARNING, "Failed to update the cache manifest: %s",
+               status.Error().Message().c_str());
+  }
   return std::make_optional(std::move(cached_model));
 }
 
-CompilationCache::CompilationCache(absl::string_view cache_root_path)
-    : cache_root_path_(cache_root_path) {}
+void CompilationCache::SyncManifest() {
+  std::ifstream manifest(GetManifestFilePath(cache_root_path_));
+  std::string line;
+  if (manifest && std::getline(manifest, line) && line == kManifestHeader) {
+    while (std::getline(manifest, line)) {
+      uint64_t model_hash;
+      Entry entry;
+      if (!ParseManifestLine(line, model_hash, entry.size, entry.checksum,
+                             entry.source, entry.last_use)) {
+        LITERT_LOG(LITERT_WARNING, "Ignoring invalid cache manifest line: %s",
+                   line.c_str());
+        continue;
+      }
+      // Keep the most recently used version of the entry.
+      auto [it, inserted] = entries_.try_emplace(model_hash, entry);
+      if (!inserted && entry.last_use > it->second.last_use) {
+        it->second = entry;
+      }
+      clock_ = std::max(clock_, entry.last_use);
+    }
+  }
+
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (!Exists(GetCachedModelFilePath(cache_root_path_, it->first))) {
+      entries_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+Expected<void> CompilationCache::WriteManifest() const {
+  std::string manifest = absl::StrCat(kManifestHeader, "\n");
+  for (const auto& [model_hash, entry] : entries_) {
+    absl::StrAppend(&manifest, model_hash, " ", entry.size, " ",
+                    entry.checksum, " ", entry.source.size, " ",
+                    entry.source.hash, " ", entry.last_use, "\n");
+  }
+  return WriteFileAtomically(GetManifestFilePath(cache_root_path_), manifest);
+}
+
+void CompilationCache::Evict(size_t incoming_size) {
+  size_t size = SizeBytes();
+  while (!entries_.empty() && size + incoming_size > max_size_bytes_) {
+    auto lru = std::min_element(entries_.begin(), entries_.end(),
+                                [](const auto& a, const auto& b) {
+                                  return a.second.last_use < b.second.last_use;
+                                });
+    LITERT_LOG(LITERT_INFO, "Evicting cached model %llu of %llu bytes",
+               static_cast<unsigned long long>(lru->first),  // NOLINT
+               static_cast<unsigned long long>(lru->second.size));  // NOLINT
+    size -= lru->second.size;
+    RemoveEntry(lru->first);
+  }
+}
+
+void CompilationCache::RemoveEntry(uint64_t model_hash) {
+  const std::string cached_model_file_path =
+      GetCachedModelFilePath(cache_root_path_, model_hash);
+  if (auto status = Remove(cached_model_file_path); !status) {
+    LITERT_LOG(LITERT_WARNING, "%s", status.Error().Message().c_str());
+  }
+  entries_.erase(model_hash);
+}
+
+CompilationCache::CompilationCache(absl::string_view cache_root_path,
+                                   size_t max_size_bytes)
+    : cache_root_path_(cache_root_path), max_size_bytes_(max_size_bytes) {}
 
 }  // namespace litert::internal
@@ -15,12 +15,15 @@
 #ifndef THIRD_PARTY_ODML_LITERT_LITERT_CORE_CACHE_COMPILATION_CACHE_H_
 #define THIRD_PARTY_ODML_LITERT_LITERT_CORE_CACHE_COMPILATION_CACHE_H_
 
+#include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/cc/litert_buffer_ref.h"
@@ -31,6 +34,17 @@
 
 namespace litert::internal {
 
+// A persistent cache of compiled models.
+//
+// The cached models are stored as '<hash>.tflite' files under the cache root
+// path. A manifest file in the same directory indexes the entries with their
+// size, checksum, source model digest and last use, so that lookups don't need
+// to probe the filesystem and the least recently used entries can be evicted
+// once the cache exceeds its byte budget.
+//
+// All the files are written to a temporary file first and then renamed, so
+// processes sharing the cache directory never observe a partially written
+// model or manifest.
 class CompilationCache {
  public:
   // Subset of compiler plugin information relevant to generate the hash.
@@ -40,18 +54,46 @@ class CompilationCache {
     std::string_view manufacturer;
   };
 
+  // Identifies the source model of a cached model independently of the model
+  // hash, so that a model whose hash collides with the one of another model
+  // doesn't get the compiled model of the other one.
+  struct SourceDigest {
+    // Size of the serialized source model, 0 if unknown.
+    uint64_t size = 0;
+    // StableHash of the serialized source model, with a seed independent of
+    // the model hash.
+    uint64_t hash = 0;
+
+    bool operator==(const SourceDigest& other) const {
+      return size == other.size && hash == other.hash;
+    }
+    bool operator!=(const SourceDigest& other) const {
+      return !(*this == other);
+    }
+  };
+
+  static constexpr size_t kUnlimitedSize = std::numeric_limits<size_t>::max();
+
+  // Name of the manifest file in the cache root path.
+  static constexpr absl::string_view kManifestFileName =
+      "litert_cache_manifest";
+
   // Creates a compilation cache instance that uses the provided
   // 'cache_root_path' as the filesystem location to store and load models.
+  // The cached models are evicted, least recently used first, to keep their
+  // total size under 'max_size_bytes'.
   // Returns an error if the cache path does not exist in the filesystem.
-  static Expected<CompilationCache> Create(absl::string_view cache_root_path);
+  static Expected<CompilationCache> Create(
+      absl::string_view cache_root_path,
+      size_t max_size_bytes = kUnlimitedSize);
 
   // Returns the hash associated with the provided 'model'. The hash is
-  // computed as the combined 'std::hash' of the following properties:
+  // computed as the combined 'StableHash' of the following properties:
   // - the serialized model buffer
-  // - the options used to compile the model
+  // - the element types and shapes of the subgraph inputs and outputs
+  // - the options used to compile the model, including the identifier and
+  //   hash of every opaque vendor option
   // - the compiler plugin information
-  // - TODO(b/414861277): Take runtime shapes into account
-  // - TODO(b/414861277): Take opaque vendor options into account
   static Expected<uint64_t> GetModelHash(
       const LiteRtModelT& model, const LiteRtOptionsT& options,
       const CompilerPluginInfo& compiler_plugin_info);
@@ -65,28 +107,80 @@ class CompilationCache {
       litert::Expected<std::vector<litert::internal::CompilerPlugin>>&
           compiler_plugins);
 
-  // Saves the provided 'model' in the cache, associated with the 'model_hash'.
-  // The overload taking a 'model_buffer' assumes the caller already
-  // has obtained the serialized representation of the LiteRtModelT.
-  Expected<void> SaveModel(const LiteRtModelT& model, uint64_t model_hash);
+  // Returns the digest of the source 'model', which must be computed before
+  // the compiler plugins are applied to it.
+  static Expected<SourceDigest> GetSourceDigest(const LiteRtModelT& model);
+
+  // Saves the provided 'model' in the cache, associated with the 'model_hash'
+  // and the 'source_digest' of the model it was compiled from. The overload
+  // taking a 'model_buffer' assumes the caller already has obtained the
+  // serialized representation of the LiteRtModelT.
+  //
+  // Evicts the least recently used models if the cache would exceed its byte
+  // budget. A model larger than the whole budget is not cached.
+  Expected<void> SaveModel(const LiteRtModelT& model, uint64_t model_hash,
+                           const SourceDigest& source_digest);
   Expected<void> SaveModel(const litert::BufferRef<uint8_t>& model_buffer,
-                           uint64_t model_hash);
+                           uint64_t model_hash,
+                           const SourceDigest& source_digest);
 
   // Tries to load a model associated with the 'model_hash' from the cache.
   //
   // - Returns an empty optional if no such model can be found, i.e. a cache
-  //   miss occured.
+  //   miss occured. A cached model compiled from a source model other than
+  //   the one of 'source_digest', i.e. whose hash collides, is reported as a
+  //   miss. A cached model that fails to load, whose size or checksum doesn't
+  //   match the manifest, or whose source model is unknown, is dropped from
+  //   the cache and reported as a miss.
   // - Returns an optional of value 'LiteRtModelT::Ptr' if a cache hit occured.
-  // - Returns a failure status if an error occurred trying to load the model.
-  Expected<std::optional<LiteRtModelT::Ptr>> TryLoadModel(uint64_t model_hash);
+  //   The model is memory mapped from the cached file rather than copied.
+  Expected<std::optional<LiteRtModelT::Ptr>> TryLoadModel(
+      uint64_t model_hash, const SourceDigest& source_digest);
+
+  // Returns the number of cached models.
+  size_t NumEntries() const { return entries_.size(); }
+
+  // Returns the total size of the cached models in bytes.
+  size_t SizeBytes() const;
 
  private:
+  // A cached model, as recorded in the manifest.
+  struct Entry {
+    uint64_t size = 0;
+    // StableHash of the file content. 0 if unknown, e.g. for model files that
+    // were found in the cache directory without a manifest entry.
+    uint64_t checksum = 0;
+    // The source model the entry was compiled from. Unknown for model files
+    // that were found in the cache directory without a manifest entry.
+    SourceDigest source;
+    // Logical time of the last save or load, used for LRU eviction.
+    uint64_t last_use = 0;
+  };
+
   // Creates a compilation cache instance that uses the provided
   // 'cache_root_path' as the filesystem location to store and load models.
-  explicit CompilationCache(absl::string_view cache_root_path);
+  CompilationCache(absl::string_view cache_root_path, size_t max_size_bytes);
+
+  // Loads the manifest from disk and merges it into 'entries_'. Entries whose
+  // model file no longer exists, e.g. evicted by another process, are dropped.
+  void SyncManifest();
+
+  // Writes 'entries_' to the manifest file.
+  Expected<void> WriteManifest() const;
+
+  // Removes the least recently used entries until 'incoming_size' more bytes
+  // fit in the budget.
+  void Evict(size_t incoming_size);
+
+  // Removes an entry and its model file.
+  void RemoveEntry(uint64_t model_hash);
 
   // The cache root path.
   std::string cache_root_path_;
+  size_t max_size_bytes_;
+  absl::flat_hash_map<uint64_t, Entry> entries_;
+  // The logical clock used for the 'last_use' of the entries.
+  uint64_t clock_ = 0;
 };
 
 }  // namespace litert::internal
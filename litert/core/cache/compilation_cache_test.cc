@@ -15,20 +15,28 @@
 #include "litert/core/cache/compilation_cache.h"
 
 #include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ios>
 #include <memory>
 #include <optional>
 #include <string>
 
 #include <gtest/gtest.h>
+#include "absl/strings/match.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_opaque_options.h"
 #include "litert/c/options/litert_google_tensor_options.h"
 #include "litert/cc/litert_macros.h"
+#include "litert/core/filesystem.h"
 #include "litert/core/model/model.h"
 #include "litert/core/model/model_load.h"
 #include "litert/core/options.h"
+#include "litert/core/util/flatbuffer_tools.h"
 #include "litert/test/common.h"
 #include "litert/test/testdata/simple_model_test_vectors.h"
+#include "tflite/converter/allocation.h"
 
 namespace litert::internal {
 
@@ -47,6 +55,21 @@ LiteRtOptionsT GetTestOptions() {
   };
 }
 
+CompilationCache::SourceDigest GetTestSourceDigest(const LiteRtModelT& model) {
+  LITERT_ASSIGN_OR_ABORT(CompilationCache::SourceDigest source_digest,
+                         CompilationCache::GetSourceDigest(model));
+  return source_digest;
+}
+
+// Returns a new empty cache directory, so that the test doesn't see the
+// entries of the other tests.
+std::string MakeEmptyCacheDir(absl::string_view name) {
+  const std::string dir = Join({::testing::TempDir(), name});
+  LITERT_ABORT_IF_ERROR(RmDir(dir));
+  LITERT_ABORT_IF_ERROR(MkDir(dir));
+  return dir;
+}
+
 TEST(CompilationCacheTest, CacheMiss) {
   // GIVEN: a compilation cache and a model
   const std::string cache_root_path = ::testing::TempDir();
@@ -55,6 +78,8 @@ TEST(CompilationCacheTest, CacheMiss) {
   LITERT_ASSIGN_OR_ABORT(
       std::unique_ptr<LiteRtModelT> model,
       LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  const CompilationCache::SourceDigest source_digest =
+      GetTestSourceDigest(*model);
 
   // WHEN: the model has not been saved to the cache
   LITERT_ASSIGN_OR_ABORT(
@@ -63,8 +88,9 @@ TEST(CompilationCacheTest, CacheMiss) {
                                      GetTestCompilerPluginInfo()));
 
   // THEN: the model is not found in the cache
-  LITERT_ASSIGN_OR_ABORT(std::optional<LiteRtModelT::Ptr> cache_miss,
-                         compilation_cache.TryLoadModel(model_hash));
+  LITERT_ASSIGN_OR_ABORT(
+      std::optional<LiteRtModelT::Ptr> cache_miss,
+      compilation_cache.TryLoadModel(model_hash, source_digest));
   EXPECT_FALSE(cache_miss.has_value());
 }
 
@@ -76,20 +102,48 @@ TEST(CompilationCacheTest, CacheHit) {
   LITERT_ASSIGN_OR_ABORT(
       std::unique_ptr<LiteRtModelT> model,
       LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  const CompilationCache::SourceDigest source_digest =
+      GetTestSourceDigest(*model);
 
   // WHEN: the model is saved to the cache
   LITERT_ASSIGN_OR_ABORT(
       const std::size_t model_hash,
       CompilationCache::GetModelHash(*model, GetTestOptions(),
                                      GetTestCompilerPluginInfo()));
-  LITERT_ABORT_IF_ERROR(compilation_cache.SaveModel(*model, model_hash));
+  LITERT_ABORT_IF_ERROR(
+      compilation_cache.SaveModel(*model, model_hash, source_digest));
 
   // THEN: the model can be found in the cache
-  LITERT_ASSIGN_OR_ABORT(std::optional<LiteRtModelT::Ptr> cache_hit,
-                         compilation_cache.TryLoadModel(model_hash));
+  LITERT_ASSIGN_OR_ABORT(
+      std::optional<LiteRtModelT::Ptr> cache_hit,
+      compilation_cache.TryLoadModel(model_hash, source_digest));
   EXPECT_TRUE(cache_hit.has_value());
 }
 
+TEST(CompilationCacheTest, CacheHitIsMemoryMapped) {
+  if (!tflite::MMAPAllocation::IsSupported()) {
+    GTEST_SKIP() << "mmap is not supported on this platform";
+  }
+  const std::string cache_root_path = MakeEmptyCacheDir("mmap");
+  LITERT_ASSIGN_OR_ABORT(CompilationCache compilation_cache,
+                         CompilationCache::Create(cache_root_path));
+  LITERT_ASSIGN_OR_ABORT(
+      std::unique_ptr<LiteRtModelT> model,
+      LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  const CompilationCache::SourceDigest source_digest =
+      GetTestSourceDigest(*model);
+  LITERT_ABORT_IF_ERROR(compilation_cache.SaveModel(*model, 1, source_digest));
+
+  LITERT_ASSIGN_OR_ABORT(std::optional<LiteRtModelT::Ptr> cache_hit,
+                         compilation_cache.TryLoadModel(1, source_digest));
+  ASSERT_TRUE(cache_hit.has_value());
+  // The model references the mapped file instead of a heap copy.
+  const tflite::Allocation* allocation =
+      GetTflFlatbuffer(**cache_hit).FlatbufferModel().allocation();
+  ASSERT_NE(allocation, nullptr);
+  EXPECT_EQ(allocation->type(), tflite::Allocation::Type::kMMap);
+}
+
 TEST(CompilationCacheTest, CompilerPluginVersionChange_CacheMiss) {
   // GIVEN: a compilation cache and a model, saved to the cache
   const std::string cache_root_path = ::testing::TempDir();
@@ -98,6 +152,8 @@ TEST(CompilationCacheTest, CompilerPluginVersionChange_CacheMiss) {
   LITERT_ASSIGN_OR_ABORT(
       std::unique_ptr<LiteRtModelT> model,
       LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  const CompilationCache::SourceDigest source_digest =
+      GetTestSourceDigest(*model);
 
   CompilationCache::CompilerPluginInfo compiler_plugin_info =
       GetTestCompilerPluginInfo();
@@ -105,7 +161,8 @@ TEST(CompilationCacheTest, CompilerPluginVersionChange_CacheMiss) {
   LITERT_ASSIGN_OR_ABORT(const std::size_t model_hash,
                          CompilationCache::GetModelHash(
                              *model, GetTestOptions(), compiler_plugin_info));
-  LITERT_ABORT_IF_ERROR(compilation_cache.SaveModel(*model, model_hash));
+  LITERT_ABORT_IF_ERROR(
+      compilation_cache.SaveModel(*model, model_hash, source_digest));
 
   // WHEN: the vendor plugin API version has been updated.
   compiler_plugin_info.api_version.minor++;
@@ -117,7 +174,8 @@ TEST(CompilationCacheTest, CompilerPluginVersionChange_CacheMiss) {
   // THEN: the model can not be loaded from the cache
   LITERT_ASSIGN_OR_ABORT(
       std::optional<LiteRtModelT::Ptr> cache_hit,
-      compilation_cache.TryLoadModel(model_hash_with_updated_api_version));
+      compilation_cache.TryLoadModel(model_hash_with_updated_api_version,
+                                     source_digest));
   EXPECT_FALSE(cache_hit.has_value());
 }
 
@@ -169,13 +227,16 @@ TEST(CompilationCacheTest, DifferentLiteRtOptions_CacheMiss) {
   LITERT_ASSIGN_OR_ABORT(
       std::unique_ptr<LiteRtModelT> model,
       LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  const CompilationCache::SourceDigest source_digest =
+      GetTestSourceDigest(*model);
 
   LiteRtOptionsT options = GetTestOptions();
 
   LITERT_ASSIGN_OR_ABORT(const std::size_t model_hash,
                          CompilationCache::GetModelHash(
                              *model, options, GetTestCompilerPluginInfo()));
-  LITERT_ABORT_IF_ERROR(compilation_cache.SaveModel(*model, model_hash));
+  LITERT_ABORT_IF_ERROR(
+      compilation_cache.SaveModel(*model, model_hash, source_digest));
 
   // WHEN: LiteRT's major version has been updated.
   options.version.major++;
@@ -187,7 +248,8 @@ TEST(CompilationCacheTest, DifferentLiteRtOptions_CacheMiss) {
   // THEN: the model can not be loaded from the cache.
   LITERT_ASSIGN_OR_ABORT(
       std::optional<LiteRtModelT::Ptr> cache_hit,
-      compilation_cache.TryLoadModel(model_hash_with_updated_api_version));
+      compilation_cache.TryLoadModel(model_hash_with_updated_api_version,
+                                     source_digest));
   EXPECT_FALSE(cache_hit.has_value());
 }
 
@@ -319,4 +381,223 @@ TEST(CompilationCacheTest, TestSameAndDifferentLinkedListOfOpaqueOptions) {
   LiteRtDestroyOpaqueOptions(options2.options);
 }
 
+TEST(CompilationCacheTest, RuntimeShapesChangeHash) {
+  LITERT_ASSIGN_OR_ABORT(
+      std::unique_ptr<LiteRtModelT> model,
+      LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  LITERT_ASSIGN_OR_ABORT(
+      const uint64_t model_hash1,
+      CompilationCache::GetModelHash(*model, GetTestOptions(),
+                                     GetTestCompilerPluginInfo()));
+
+  // WHEN: an input is resized without reserializing the model.
+  LiteRtTensorT& input = model->Subgraph(0).Input(0);
+  ASSERT_EQ(input.Type().first, kLiteRtRankedTensorType);
+  const LiteRtRankedTensorType& ranked = input.Type().second.ranked_tensor_type;
+  input.SetType(MakeRankedTensorType(ranked.element_type, {4, 2}));
+  LITERT_ASSIGN_OR_ABORT(
+      const uint64_t model_hash2,
+      CompilationCache::GetModelHash(*model, GetTestOptions(),
+                                     GetTestCompilerPluginInfo()));
+
+  // THEN: the hashes are different.
+  EXPECT_NE(model_hash1, model_hash2);
+}
+
+TEST(CompilationCacheTest, ManifestPersistsAcrossInstances) {
+  const std::string cache_root_path = MakeEmptyCacheDir("persist");
+  LITERT_ASSIGN_OR_ABORT(
+      std::unique_ptr<LiteRtModelT> model,
+      LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  const CompilationCache::SourceDigest source_digest =
+      GetTestSourceDigest(*model);
+  {
+    LITERT_ASSIGN_OR_ABORT(CompilationCache compilation_cache,
+                           CompilationCache::Create(cache_root_path));
+    LITERT_ABORT_IF_ERROR(
+        compilation_cache.SaveModel(*model, 1, source_digest));
+  }
+  EXPECT_TRUE(
+      Exists(Join({cache_root_path, CompilationCache::kManifestFileName})));
+
+  // A new instance, e.g. in another process, finds the saved model.
+  LITERT_ASSIGN_OR_ABORT(CompilationCache compilation_cache,
+                         CompilationCache::Create(cache_root_path));
+  EXPECT_EQ(compilation_cache.NumEntries(), 1);
+  LITERT_ASSIGN_OR_ABORT(std::optional<LiteRtModelT::Ptr> cache_hit,
+                         compilation_cache.TryLoadModel(1, source_digest));
+  EXPECT_TRUE(cache_hit.has_value());
+}
+
+TEST(CompilationCacheTest, EvictsLeastRecentlyUsed) {
+  const std::string cache_root_path = MakeEmptyCacheDir("lru");
+  LITERT_ASSIGN_OR_ABORT(
+      std::unique_ptr<LiteRtModelT> model,
+      LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  const CompilationCache::SourceDigest source_digest =
+      GetTestSourceDigest(*model);
+  const size_t model_size = GetTflFlatbuffer(*model).Buf().Size();
+
+  // GIVEN: a cache with room for two models, holding models 1 and 2.
+  LITERT_ASSIGN_OR_ABORT(
+      CompilationCache compilation_cache,
+      CompilationCache::Create(cache_root_path, 2 * model_size + 1));
+  LITERT_ABORT_IF_ERROR(compilation_cache.SaveModel(*model, 1, source_digest));
+  LITERT_ABORT_IF_ERROR(compilation_cache.SaveModel(*model, 2, source_digest));
+  // Model 1 is now the most recently used one.
+  LITERT_ASSIGN_OR_ABORT(std::optional<LiteRtModelT::Ptr> hit,
+                         compilation_cache.TryLoadModel(1, source_digest));
+  ASSERT_TRUE(hit.has_value());
+
+  // WHEN: a third model is saved.
+  LITERT_ABORT_IF_ERROR(compilation_cache.SaveModel(*model, 3, source_digest));
+
+  // THEN: model 2 is evicted.
+  EXPECT_EQ(compilation_cache.NumEntries(), 2);
+  EXPECT_LE(compilation_cache.SizeBytes(), 2 * model_size + 1);
+  LITERT_ASSIGN_OR_ABORT(std::optional<LiteRtModelT::Ptr> evicted,
+                         compilation_cache.TryLoadModel(2, source_digest));
+  EXPECT_FALSE(evicted.has_value());
+  EXPECT_FALSE(Exists(Join({cache_root_path, "2.tflite"})));
+  LITERT_ASSIGN_OR_ABORT(hit, compilation_cache.TryLoadModel(1, source_digest));
+  EXPECT_TRUE(hit.has_value());
+  LITERT_ASSIGN_OR_ABORT(hit, compilation_cache.TryLoadModel(3, source_digest));
+  EXPECT_TRUE(hit.has_value());
+}
+
+TEST(CompilationCacheTest, ModelLargerThanBudgetIsNotCached) {
+  const std::string cache_root_path = MakeEmptyCacheDir("too_large");
+  LITERT_ASSIGN_OR_ABORT(
+      std::unique_ptr<LiteRtModelT> model,
+      LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  const CompilationCache::SourceDigest source_digest =
+      GetTestSourceDigest(*model);
+  LITERT_ASSIGN_OR_ABORT(CompilationCache compilation_cache,
+                         CompilationCache::Create(cache_root_path, 16));
+  LITERT_ABORT_IF_ERROR(compilation_cache.SaveModel(*model, 1, source_digest));
+  EXPECT_EQ(compilation_cache.NumEntries(), 0);
+}
+
+TEST(CompilationCacheTest, CorruptedModel_CacheMiss) {
+  const std::string cache_root_path = MakeEmptyCacheDir("corrupted");
+  LITERT_ASSIGN_OR_ABORT(
+      std::unique_ptr<LiteRtModelT> model,
+      LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  const CompilationCache::SourceDigest source_digest =
+      GetTestSourceDigest(*model);
+  LITERT_ASSIGN_OR_ABORT(CompilationCache compilation_cache,
+                         CompilationCache::Create(cache_root_path));
+  LITERT_ABORT_IF_ERROR(compilation_cache.SaveModel(*model, 1, source_digest));
+
+  // WHEN: the cached file is overwritten with content of the same size.
+  const std::string cached_file = Join({cache_root_path, "1.tflite"});
+  LITERT_ASSIGN_OR_ABORT(const size_t size, Size(cached_file));
+  {
+    std::ofstream file(cached_file, std::ios::binary | std::ios::trunc);
+    file << std::string(size, 'x');
+  }
+
+  // THEN: the model is dropped instead of being loaded.
+  LITERT_ASSIGN_OR_ABORT(std::optional<LiteRtModelT::Ptr> cache_miss,
+                         compilation_cache.TryLoadModel(1, source_digest));
+  EXPECT_FALSE(cache_miss.has_value());
+  EXPECT_EQ(compilation_cache.NumEntries(), 0);
+  EXPECT_FALSE(Exists(cached_file));
+}
+
+TEST(CompilationCacheTest, OtherSourceModelWithSameHash_CacheMiss) {
+  const std::string cache_root_path = MakeEmptyCacheDir("collision");
+  LITERT_ASSIGN_OR_ABORT(
+      std::unique_ptr<LiteRtModelT> model,
+      LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  const CompilationCache::SourceDigest source_digest =
+      GetTestSourceDigest(*model);
+  LITERT_ASSIGN_OR_ABORT(CompilationCache compilation_cache,
+                         CompilationCache::Create(cache_root_path));
+  LITERT_ABORT_IF_ERROR(compilation_cache.SaveModel(*model, 1, source_digest));
+
+  // WHEN: a model of the same size but other content has the same hash.
+  CompilationCache::SourceDigest other_source_digest = source_digest;
+  ++other_source_digest.hash;
+
+  // THEN: it doesn't get the compiled model of the first one, which stays.
+  LITERT_ASSIGN_OR_ABORT(
+      std::optional<LiteRtModelT::Ptr> cache_miss,
+      compilation_cache.TryLoadModel(1, other_source_digest));
+  EXPECT_FALSE(cache_miss.has_value());
+  LITERT_ASSIGN_OR_ABORT(std::optional<LiteRtModelT::Ptr> cache_hit,
+                         compilation_cache.TryLoadModel(1, source_digest));
+  EXPECT_TRUE(cache_hit.has_value());
+}
+
+TEST(CompilationCacheTest, ModelOfUnknownSource_CacheMiss) {
+  const std::string cache_root_path = MakeEmptyCacheDir("unknown_source");
+  LITERT_ASSIGN_OR_ABORT(
+      std::unique_ptr<LiteRtModelT> model,
+      LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  const CompilationCache::SourceDigest source_digest =
+      GetTestSourceDigest(*model);
+  {
+    LITERT_ASSIGN_OR_ABORT(CompilationCache compilation_cache,
+                           CompilationCache::Create(cache_root_path));
+    LITERT_ABORT_IF_ERROR(
+        compilation_cache.SaveModel(*model, 1, source_digest));
+  }
+
+  // WHEN: the manifest is lost.
+  LITERT_ABORT_IF_ERROR(
+      Remove(Join({cache_root_path, CompilationCache::kManifestFileName})));
+
+  // THEN: the model file can't be attributed to a source model and is dropped.
+  LITERT_ASSIGN_OR_ABORT(CompilationCache compilation_cache,
+                         CompilationCache::Create(cache_root_path));
+  EXPECT_EQ(compilation_cache.NumEntries(), 1);
+  LITERT_ASSIGN_OR_ABORT(std::optional<LiteRtModelT::Ptr> cache_miss,
+                         compilation_cache.TryLoadModel(1, source_digest));
+  EXPECT_FALSE(cache_miss.has_value());
+  EXPECT_EQ(compilation_cache.NumEntries(), 0);
+  EXPECT_FALSE(Exists(Join({cache_root_path, "1.tflite"})));
+}
+
+TEST(CompilationCacheTest, EvictionOnCreatePersists) {
+  const std::string cache_root_path = MakeEmptyCacheDir("evict_on_create");
+  LITERT_ASSIGN_OR_ABORT(
+      std::unique_ptr<LiteRtModelT> model,
+      LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  const CompilationCache::SourceDigest source_digest =
+      GetTestSourceDigest(*model);
+  const size_t model_size = GetTflFlatbuffer(*model).Buf().Size();
+  {
+    LITERT_ASSIGN_OR_ABORT(CompilationCache compilation_cache,
+                           CompilationCache::Create(cache_root_path));
+    LITERT_ABORT_IF_ERROR(
+        compilation_cache.SaveModel(*model, 1, source_digest));
+    LITERT_ABORT_IF_ERROR(
+        compilation_cache.SaveModel(*model, 2, source_digest));
+  }
+
+  // WHEN: the cache is opened with room for a single model.
+  {
+    LITERT_ASSIGN_OR_ABORT(
+        CompilationCache compilation_cache,
+        CompilationCache::Create(cache_root_path, model_size));
+    EXPECT_EQ(compilation_cache.NumEntries(), 1);
+  }
+
+  // THEN: the evicted model is not in the manifest anymore.
+  std::ifstream manifest(
+      Join({cache_root_path, CompilationCache::kManifestFileName}));
+  std::string line;
+  ASSERT_TRUE(std::getline(manifest, line));
+  while (std::getline(manifest, line)) {
+    EXPECT_FALSE(absl::StartsWith(line, "1 ")) << line;
+  }
+  LITERT_ASSIGN_OR_ABORT(CompilationCache compilation_cache,
+                         CompilationCache::Create(cache_root_path));
+  EXPECT_EQ(compilation_cache.NumEntries(), 1);
+  LITERT_ASSIGN_OR_ABORT(std::optional<LiteRtModelT::Ptr> cache_hit,
+                         compilation_cache.TryLoadModel(2, source_digest));
+  EXPECT_TRUE(cache_hit.has_value());
+}
+
 }  // namespace litert::internal
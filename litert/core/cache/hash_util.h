@@ -15,17 +15,81 @@
 #ifndef THIRD_PARTY_ODML_LITERT_LITERT_CORE_CACHE_HASH_UTIL_H_
 #define THIRD_PARTY_ODML_LITERT_LITERT_CORE_CACHE_HASH_UTIL_H_
 
+#include <cstddef>
 #include <cstdint>
-#include <functional>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
 
 namespace litert {
 
+// Returns the 64-bit MurmurHash64A of the `size` bytes at `data`. Unlike
+// std::hash, the value does not depend on the standard library nor on the
+// process, so it can be used for keys that are persisted on disk.
+inline uint64_t StableHash(const void* data, size_t size, uint64_t seed = 0) {
+  constexpr uint64_t kMul = 0xc6a4a7935bd1e995ULL;
+  constexpr int kShift = 47;
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  uint64_t h = seed ^ (size * kMul);
+  const size_t num_words = size / 8;
+  for (size_t i = 0; i < num_words; ++i) {
+    uint64_t k;
+    std::memcpy(&k, bytes + i * 8, sizeof(k));
+    k *= kMul;
+    k ^= k >> kShift;
+    k *= kMul;
+    h ^= k;
+    h *= kMul;
+  }
+  const unsigned char* tail = bytes + num_words * 8;
+  switch (size & 7) {
+    case 7:
+      h ^= uint64_t{tail[6]} << 48;
+      [[fallthrough]];
+    case 6:
+      h ^= uint64_t{tail[5]} << 40;
+      [[fallthrough]];
+    case 5:
+      h ^= uint64_t{tail[4]} << 32;
+      [[fallthrough]];
+    case 4:
+      h ^= uint64_t{tail[3]} << 24;
+      [[fallthrough]];
+    case 3:
+      h ^= uint64_t{tail[2]} << 16;
+      [[fallthrough]];
+    case 2:
+      h ^= uint64_t{tail[1]} << 8;
+      [[fallthrough]];
+    case 1:
+      h ^= uint64_t{tail[0]};
+      h *= kMul;
+  }
+  h ^= h >> kShift;
+  h *= kMul;
+  h ^= h >> kShift;
+  return h;
+}
+
+// Returns the stable hash of a string or of a scalar value.
+template <typename T>
+inline uint64_t StableHashValue(const T& v) {
+  if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+    const std::string_view str(v);
+    return StableHash(str.data(), str.size());
+  } else {
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>,
+                  "Only strings and scalars can be hashed");
+    return StableHash(&v, sizeof(v));
+  }
+}
+
 inline void HashCombine(uint64_t& seed) {}  // NOLINT
 
 template <typename T, typename... Rest>
-inline void HashCombine(uint64_t& seed, const T& v, Rest... rest) {
-  std::hash<T> hasher;
-  seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+inline void HashCombine(uint64_t& seed, const T& v, const Rest&... rest) {
+  seed ^= StableHashValue(v) + 0x9e3779b97f4a7c15ULL + (seed << 6) +
+          (seed >> 2);
   HashCombine(seed, rest...);
 }
 
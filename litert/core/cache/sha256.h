@@ -0,0 +1,39 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_ODML_LITERT_LITERT_CORE_CACHE_SHA256_H_
+#define THIRD_PARTY_ODML_LITERT_LITERT_CORE_CACHE_SHA256_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace litert {
+
+// A SHA-256 digest.
+using Sha256Digest = std::array<uint8_t, 32>;
+
+// Returns the SHA-256 digest of the `size` bytes at `data`. Unlike StableHash,
+// it is collision resistant, so it can identify content that may have been
+// crafted to collide with trusted content.
+Sha256Digest Sha256(const void* data, size_t size);
+
+// Returns the SHA-256 digest of the `size` bytes at `data` as 64 lowercase
+// hexadecimal digits.
+std::string Sha256Hex(const void* data, size_t size);
+
+}  // namespace litert
+
+#endif  // THIRD_PARTY_ODML_LITERT_LITERT_CORE_CACHE_SHA256_H_
@@ -0,0 +1,170 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "litert/core/cache/verification_cache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "absl/strings/numbers.h"  // from @com_google_absl
+#include "absl/strings/str_cat.h"  // from @com_google_absl
+#include "absl/strings/str_split.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "litert/c/internal/litert_logging.h"
+#include "litert/c/litert_common.h"
+#include "litert/cc/litert_buffer_ref.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/core/cache/sha256.h"
+#include "litert/core/filesystem.h"
+#include "litert/core/util/flatbuffer_tools.h"
+
+namespace litert::internal {
+
+namespace {
+
+// First line of the records file. Bump the version when the format of the
+// records or the way the content hashes are computed changes.
+constexpr absl::string_view kRecordsHeader = "litert_verification_cache v2";
+
+// Number of hexadecimal digits of a SHA-256 digest.
+constexpr size_t kContentHashSize = 64;
+
+// Same limit as FlatbufferWrapper::CreateFromBuffer.
+constexpr size_t kMaxVerifiableSize = 2e+9;
+
+std::string GetRecordsFilePath(absl::string_view cache_root_path) {
+  return Join({cache_root_path, VerificationCache::kFileName});
+}
+
+// Parses a '<size> <last_write_time> <content_hash> <path>' record. The path
+// is last since it may contain spaces.
+bool ParseRecord(absl::string_view line, std::string& path, uint64_t& size,
+                 int64_t& last_write_time, std::string& content_hash) {
+  std::vector<absl::string_view> fields =
+      absl::StrSplit(line, absl::MaxSplits(' ', 3));
+  if (fields.size() != 4 || fields[3].empty() ||
+      !absl::SimpleAtoi(fields[0], &size) ||
+      !absl::SimpleAtoi(fields[1], &last_write_time) ||
+      fields[2].size() != kContentHashSize) {
+    return false;
+  }
+  content_hash = std::string(fields[2]);
+  path = std::string(fields[3]);
+  return true;
+}
+
+}  // namespace
+
+Expected<VerificationCache> VerificationCache::Create(
+    absl::string_view cache_root_path) {
+  if (!Exists(cache_root_path)) {
+    return Unexpected(kLiteRtStatusErrorNotFound,
+                      "Cache root path does not exist");
+  }
+  VerificationCache cache(cache_root_path);
+  cache.SyncRecords();
+  return cache;
+}
+
+Expected<void> VerificationCache::Verify(absl::string_view path,
+                                         BufferRef<uint8_t> buffer) {
+  if (buffer.Size() >= kMaxVerifiableSize) {
+    return {};
+  }
+
+  // Another process may have verified the file since the last sync.
+  SyncRecords();
+  Expected<int64_t> last_write_time = LastWriteTime(path);
+  const std::string key(path);
+  auto it = entries_.find(key);
+  if (last_write_time.HasValue() && it != entries_.end() &&
+      it->second.size == buffer.Size() &&
+      it->second.last_write_time == *last_write_time) {
+    LITERT_LOG(LITERT_VERBOSE, "Model file %s was already verified",
+               key.c_str());
+    return {};
+  }
+
+  Entry entry;
+  entry.size = buffer.Size();
+  entry.content_hash = Sha256Hex(buffer.Data(), buffer.Size());
+  bool verified = false;
+  for (const auto& [unused_path, other] : entries_) {
+    if (other.size == entry.size && other.content_hash == entry.content_hash) {
+      verified = true;
+      break;
+    }
+  }
+  if (!verified) {
+    ++num_verifications_;
+    if (!VerifyFlatbuffer(buffer.Data(), buffer.Size())) {
+      if (it != entries_.end()) {
+        entries_.erase(it);
+        WriteRecords();
+      }
+      return Unexpected(kLiteRtStatusErrorInvalidFlatbuffer,
+                        "Invalid flatbuffer");
+    }
+  }
+
+  // A file whose last write time is unknown can't be trusted later on.
+  if (!last_write_time) {
+    return {};
+  }
+  entry.last_write_time = *last_write_time;
+  entries_[key] = entry;
+  if (auto status = WriteRecords(); !status) {
+    LITERT_LOG(LITERT_WARNING, "Failed to write the verification cache: %s",
+               status.Error().Message().c_str());
+  }
+  return {};
+}
+
+void VerificationCache::SyncRecords() {
+  std::ifstream records(GetRecordsFilePath(cache_root_path_));
+  std::string line;
+  if (!records || !std::getline(records, line) || line != kRecordsHeader) {
+    return;
+  }
+  while (std::getline(records, line)) {
+    std::string path;
+    Entry entry;
+    if (!ParseRecord(line, path, entry.size, entry.last_write_time,
+                     entry.content_hash)) {
+      LITERT_LOG(LITERT_WARNING,
+                 "Ignoring invalid verification cache record: %s",
+                 line.c_str());
+      continue;
+    }
+    entries_[path] = entry;
+  }
+}
+
+Expected<void> VerificationCache::WriteRecords() const {
+  std::string records = absl::StrCat(kRecordsHeader, "\n");
+  for (const auto& [path, entry] : entries_) {
+    absl::StrAppend(&records, entry.size, " ", entry.last_write_time, " ",
+                    entry.content_hash, " ", path, "\n");
+  }
+  return WriteFileAtomically(GetRecordsFilePath(cache_root_path_), records);
+}
+
+VerificationCache::VerificationCache(absl::string_view cache_root_path)
+    : cache_root_path_(cache_root_path) {}
+
+}  // namespace litert::internal
@@ -0,0 +1,93 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef THIRD_PARTY_ODML_LITERT_LITERT_CORE_CACHE_VERIFICATION_CACHE_H_
+#define THIRD_PARTY_ODML_LITERT_LITERT_CORE_CACHE_VERIFICATION_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "litert/cc/litert_buffer_ref.h"
+#include "litert/cc/litert_expected.h"
+
+namespace litert::internal {
+
+// A persistent record of the model files that passed the flatbuffer
+// verification, so that large models are not verified again at every launch.
+//
+// The records are stored in a file under the cache root path, usually the
+// compilation cache directory, with the size, last write time and content
+// hash of each verified file:
+// - a file whose size and last write time match its record is trusted
+//   without being read.
+// - otherwise its content is hashed with SHA-256, and a file with the same
+//   size and hash as a verified file, e.g. a copy or a touched file, is
+//   trusted as well.
+// - any other file is verified, so a modified model is always caught unless
+//   its last write time was forged to the recorded one.
+class VerificationCache {
+ public:
+  // Name of the records file in the cache root path.
+  static constexpr absl::string_view kFileName = "litert_verification_cache";
+
+  // Creates a verification cache that stores its records under
+  // 'cache_root_path'. Returns an error if the cache path does not exist in
+  // the filesystem.
+  static Expected<VerificationCache> Create(absl::string_view cache_root_path);
+
+  // Verifies 'buffer', the content of the model file at 'path', unless the
+  // cache shows that it was already verified. Returns an error if the buffer
+  // is not a valid model flatbuffer. Like FlatbufferWrapper::CreateFromBuffer,
+  // buffers of 2GB or more, which the flatbuffer verifier can't handle, are
+  // accepted without verification.
+  Expected<void> Verify(absl::string_view path, BufferRef<uint8_t> buffer);
+
+  // Returns the number of files recorded as verified.
+  size_t NumEntries() const { return entries_.size(); }
+
+  // Returns the number of buffers verified by this instance, i.e. that were
+  // not trusted from the records.
+  size_t NumVerifications() const { return num_verifications_; }
+
+ private:
+  // A verified file, as recorded in the records file.
+  struct Entry {
+    uint64_t size = 0;
+    int64_t last_write_time = 0;
+    // SHA-256 of the file content, in hexadecimal.
+    std::string content_hash;
+  };
+
+  explicit VerificationCache(absl::string_view cache_root_path);
+
+  // Loads the records from disk and merges them into 'entries_'.
+  void SyncRecords();
+
+  // Writes 'entries_' to the records file.
+  Expected<void> WriteRecords() const;
+
+  // The cache root path.
+  std::string cache_root_path_;
+  // The verified files, by path.
+  absl::flat_hash_map<std::string, Entry> entries_;
+  size_t num_verifications_ = 0;
+};
+
+}  // namespace litert::internal
+
+#endif  // THIRD_PARTY_ODML_LITERT_LITERT_CORE_CACHE_VERIFICATION_CACHE_H_
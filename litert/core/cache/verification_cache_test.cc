@@ -0,0 +1,116 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "litert/core/cache/verification_cache.h"
+
+#include <cstdint>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "litert/cc/litert_buffer_ref.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/core/filesystem.h"
+#include "litert/test/common.h"
+#include "litert/test/matchers.h"
+#include "litert/test/testdata/simple_model_test_vectors.h"
+
+namespace litert::internal {
+namespace {
+
+// Returns a new empty cache directory, so that the test doesn't see the
+// records of the other tests.
+std::string MakeEmptyCacheDir(absl::string_view name) {
+  const std::string dir = Join({::testing::TempDir(), name});
+  LITERT_ABORT_IF_ERROR(RmDir(dir));
+  LITERT_ABORT_IF_ERROR(MkDir(dir));
+  return dir;
+}
+
+// Writes 'buffer' to the file at 'path' and returns its content.
+OwningBufferRef<uint8_t> WriteModelFile(absl::string_view path,
+                                        BufferRef<uint8_t> buffer) {
+  LITERT_ABORT_IF_ERROR(WriteFileAtomically(path, buffer.StrView()));
+  LITERT_ASSIGN_OR_ABORT(auto content, LoadBinaryFile(path));
+  return content;
+}
+
+TEST(VerificationCacheTest, TrustsUnchangedFile) {
+  const std::string cache_root_path = MakeEmptyCacheDir("trusts_unchanged");
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto model,
+      LoadBinaryFile(litert::testing::GetTestFilePath(kModelFileName)));
+  const std::string path = Join({cache_root_path, "model.tflite"});
+  auto buffer = WriteModelFile(path, model);
+
+  {
+    LITERT_ASSERT_OK_AND_ASSIGN(auto cache,
+                                VerificationCache::Create(cache_root_path));
+    LITERT_EXPECT_OK(cache.Verify(path, buffer));
+    EXPECT_EQ(cache.NumVerifications(), 1);
+    EXPECT_EQ(cache.NumEntries(), 1);
+  }
+
+  // A new instance, e.g. in the next launch, reads the records.
+  LITERT_ASSERT_OK_AND_ASSIGN(auto cache,
+                              VerificationCache::Create(cache_root_path));
+  EXPECT_EQ(cache.NumEntries(), 1);
+  LITERT_EXPECT_OK(cache.Verify(path, buffer));
+  EXPECT_EQ(cache.NumVerifications(), 0);
+}
+
+TEST(VerificationCacheTest, TrustsCopyOfVerifiedFile) {
+  const std::string cache_root_path = MakeEmptyCacheDir("trusts_copy");
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto model,
+      LoadBinaryFile(litert::testing::GetTestFilePath(kModelFileName)));
+  const std::string path = Join({cache_root_path, "model.tflite"});
+  const std::string copy_path = Join({cache_root_path, "copy.tflite"});
+  auto buffer = WriteModelFile(path, model);
+  auto copy_buffer = WriteModelFile(copy_path, model);
+  LITERT_ASSERT_OK_AND_ASSIGN(auto cache,
+                              VerificationCache::Create(cache_root_path));
+
+  LITERT_EXPECT_OK(cache.Verify(path, buffer));
+  LITERT_EXPECT_OK(cache.Verify(copy_path, copy_buffer));
+
+  EXPECT_EQ(cache.NumVerifications(), 1);
+  EXPECT_EQ(cache.NumEntries(), 2);
+}
+
+TEST(VerificationCacheTest, VerifiesModifiedFile) {
+  const std::string cache_root_path = MakeEmptyCacheDir("verifies_modified");
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto model,
+      LoadBinaryFile(litert::testing::GetTestFilePath(kModelFileName)));
+  const std::string path = Join({cache_root_path, "model.tflite"});
+  auto buffer = WriteModelFile(path, model);
+  LITERT_ASSERT_OK_AND_ASSIGN(auto cache,
+                              VerificationCache::Create(cache_root_path));
+  LITERT_EXPECT_OK(cache.Verify(path, buffer));
+
+  // Trailing bytes keep the flatbuffer valid but change the content.
+  std::string modified(model.StrView());
+  modified.append(16, '\0');
+  auto modified_buffer = WriteModelFile(
+      path, BufferRef<uint8_t>(modified.data(), modified.size()));
+  LITERT_EXPECT_OK(cache.Verify(path, modified_buffer));
+
+  EXPECT_EQ(cache.NumVerifications(), 2);
+  EXPECT_EQ(cache.NumEntries(), 1);
+}
+
+}  // namespace
+}  // namespace litert::internal
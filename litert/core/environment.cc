@@ -14,11 +14,19 @@
 
 #include "litert/core/environment.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
 
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
+#include "litert/c/litert_any.h"
 #include "litert/c/litert_common.h"
+#include "litert/c/litert_environment.h"
 #include "litert/c/litert_environment_options.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
@@ -31,6 +39,7 @@ litert::Expected<LiteRtEnvironmentT::Ptr> LiteRtEnvironmentT::CreateWithOptions(
   for (const auto& opt : options) {
     env->options_.SetOption(opt);
   }
+  env->ConfigureTensorBufferPool();
 
   return env;
 }
@@ -41,9 +50,85 @@ litert::Expected<void> LiteRtEnvironmentT::AddOptions(
   for (const auto& opt : options) {
     LITERT_RETURN_IF_ERROR(options_.SetOption(opt, overwrite));
   }
+  ConfigureTensorBufferPool();
   return {};
 }
 
+size_t LiteRtEnvironmentT::TrimMemory(LiteRtTrimMemoryLevel level) {
+  auto& buffer_pool = tensor_buffer_registry_.GetBufferPool();
+  size_t num_freed_bytes = buffer_pool.GetStats().pooled_bytes;
+  buffer_pool.Clear();
+  {
+    absl::MutexLock lock(memory_trimmers_mutex_);
+    for (auto& [owner, trimmer] : memory_trimmers_) {
+      num_freed_bytes += trimmer(level);
+    }
+  }
+  LITERT_LOG(LITERT_INFO, "Trimming memory at level %d freed %zu bytes.",
+             static_cast<int>(level), num_freed_bytes);
+  return num_freed_bytes;
+}
+
+void LiteRtEnvironmentT::AddMemoryTrimmer(const void* owner,
+                                          MemoryTrimmer trimmer) {
+  absl::MutexLock lock(memory_trimmers_mutex_);
+  memory_trimmers_.emplace_back(owner, std::move(trimmer));
+}
+
+void LiteRtEnvironmentT::RemoveMemoryTrimmer(const void* owner) {
+  absl::MutexLock lock(memory_trimmers_mutex_);
+  memory_trimmers_.erase(std::remove_if(memory_trimmers_.begin(),
+                                        memory_trimmers_.end(),
+                                        [owner](const auto& entry) {
+                                          return entry.first == owner;
+                                        }),
+                         memory_trimmers_.end());
+}
+
+litert::Expected<void> LiteRtEnvironmentT::SetGpuEnvironment(
+    std::unique_ptr<litert::internal::GpuEnvironment> gpu_env) {
+  absl::MutexLock lock(gpu_env_mutex_);
+  if (gpu_env_) {
+    return litert::Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                              "GPU environment is already set.");
+  }
+  gpu_env_ = std::move(gpu_env);
+  return {};
+}
+
+litert::Expected<litert::internal::GpuEnvironment*>
+LiteRtEnvironmentT::GetGpuEnvironment() {
+  absl::MutexLock lock(gpu_env_mutex_);
+  if (!gpu_env_ && gpu_env_factory_ != nullptr) {
+    // The GPU environment is only created once, even if it fails.
+    GpuEnvironmentFactory factory = gpu_env_factory_;
+    gpu_env_factory_ = nullptr;
+    LITERT_ASSIGN_OR_RETURN(gpu_env_, factory(this));
+  }
+  if (!gpu_env_) {
+    return litert::Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                              "GPU environment is not set.");
+  }
+  return gpu_env_.get();
+}
+
+void LiteRtEnvironmentT::ConfigureTensorBufferPool() {
+  std::optional<LiteRtAny> max_size =
+      GetOption(kLiteRtEnvOptionTagTensorBufferPoolMaxSize);
+  if (!max_size.has_value()) {
+    return;
+  }
+  if (max_size->type != kLiteRtAnyTypeInt || max_size->int_value < 0) {
+    LITERT_LOG(LITERT_WARNING,
+               "Ignoring invalid tensor buffer pool max size option");
+    return;
+  }
+  LITERT_LOG(LITERT_INFO, "Tensor buffer pool max size: %lld bytes",
+             static_cast<long long>(max_size->int_value));  // NOLINT
+  tensor_buffer_registry_.GetBufferPool().SetMaxPooledBytes(
+      static_cast<size_t>(max_size->int_value));
+}
+
 // C API to workaround Windows build issue.
 // This function is only used in tensor_buffer.cc.
 extern "C" litert::internal::GpuEnvironment* LiteRtGetGpuEnvironment(
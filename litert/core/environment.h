@@ -15,31 +15,49 @@
 #ifndef ODML_LITERT_LITERT_CORE_ENVIRONMENT_H_
 #define ODML_LITERT_LITERT_CORE_ENVIRONMENT_H_
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <utility>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"  // from @com_google_absl
+#include "absl/functional/any_invocable.h"  // from @com_google_absl
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
+#include "absl/time/time.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/litert_any.h"
 #include "litert/c/litert_common.h"
+#include "litert/c/litert_environment.h"
 #include "litert/c/litert_environment_options.h"
+#include "litert/c/litert_telemetry.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/core/environment_options.h"
 #include "litert/runtime/accelerator_registry.h"
 #include "litert/runtime/gpu_environment.h"
+#include "litert/runtime/run_scheduler.h"
 #include "litert/runtime/tensor_buffer_registry.h"
 
 // A singleton class that contains global LiteRT environment options.
 class LiteRtEnvironmentT {
  public:
   using Ptr = std::unique_ptr<LiteRtEnvironmentT>;
+  using GpuEnvironmentFactory =
+      litert::Expected<std::unique_ptr<litert::internal::GpuEnvironment>> (*)(
+          LiteRtEnvironmentT* environment);
+  // Releases memory for TrimMemory() and returns the number of bytes freed.
+  using MemoryTrimmer = absl::AnyInvocable<size_t(LiteRtTrimMemoryLevel)>;
 
   LiteRtEnvironmentT() = default;
   // Create an environment instance with options.
   static litert::Expected<Ptr> CreateWithOptions(
       absl::Span<const LiteRtEnvOption> options);
 
-  ~LiteRtEnvironmentT() = default;
+  ~LiteRtEnvironmentT() {
+    // Pooled GPU buffers must be freed while the GPU environment is alive.
+    tensor_buffer_registry_.GetBufferPool().Clear();
+  }
 
   std::optional<LiteRtAny> GetOption(LiteRtEnvOptionTag tag) const {
     auto opt = options_.GetOption(tag);
@@ -64,47 +82,117 @@ class LiteRtEnvironmentT {
     return tensor_buffer_registry_;
   }
 
+  // Releases the pooled tensor buffers and, depending on `level`, calls the
+  // memory trimmers. Returns the number of bytes freed. Thread safe.
+  size_t TrimMemory(LiteRtTrimMemoryLevel level);
+
+  // Adds `trimmer`, called by TrimMemory() until RemoveMemoryTrimmer() is
+  // called with the same `owner`.
+  void AddMemoryTrimmer(const void* owner, MemoryTrimmer trimmer);
+
+  // Removes the memory trimmer of `owner`, if any. Blocks while TrimMemory()
+  // runs, so that the trimmer is not called anymore once this returns.
+  void RemoveMemoryTrimmer(const void* owner);
+
+  // Returns the scheduler ordering the runs of the compiled models of the
+  // environment on each device.
+  litert::internal::RunScheduler& GetRunScheduler() { return run_scheduler_; }
+
   // Sets the GPU environment. The owner of the GPU environment is transferred
   // to the environment.
   litert::Expected<void> SetGpuEnvironment(
-      std::unique_ptr<litert::internal::GpuEnvironment> gpu_env) {
-    if (gpu_env_) {
-      return litert::Unexpected(kLiteRtStatusErrorRuntimeFailure,
-                                "GPU environment is already set.");
-    }
-    gpu_env_ = std::move(gpu_env);
-    return {};
+      std::unique_ptr<litert::internal::GpuEnvironment> gpu_env);
+
+  // Sets the function creating the GPU environment from the environment
+  // options, the first time a GPU buffer, event or model needs it. This saves
+  // initializing OpenCL and GL in the applications that only use the CPU.
+  void SetGpuEnvironmentFactory(GpuEnvironmentFactory factory) {
+    absl::MutexLock lock(gpu_env_mutex_);
+    gpu_env_factory_ = factory;
   }
 
-  // Returns the GPU environment object.
-  litert::Expected<litert::internal::GpuEnvironment*> GetGpuEnvironment() {
-    if (!HasGpuEnvironment()) {
-      return litert::Unexpected(kLiteRtStatusErrorRuntimeFailure,
-                                "GPU environment is not set.");
-    }
-    return gpu_env_.get();
-  }
+  // Returns the GPU environment object, creating it if needed.
+  litert::Expected<litert::internal::GpuEnvironment*> GetGpuEnvironment();
 
-  // Returns true if the GPU environment is set.
-  bool HasGpuEnvironment() { return gpu_env_ != nullptr; }
+  // Returns true if the GPU environment has been created.
+  bool HasGpuEnvironment() {
+    absl::MutexLock lock(gpu_env_mutex_);
+    return gpu_env_ != nullptr;
+  }
 
   bool SupportsClGlInterop() {
-    return gpu_env_ != nullptr && gpu_env_->SupportsClGlInterop();
+    auto gpu_env = GetGpuEnvironment();
+    return gpu_env && (*gpu_env)->SupportsClGlInterop();
   }
 
   bool SupportsAhwbClInterop() {
-    return gpu_env_ != nullptr && gpu_env_->SupportsAhwbClInterop();
+    auto gpu_env = GetGpuEnvironment();
+    return gpu_env && (*gpu_env)->SupportsAhwbClInterop();
   }
 
   bool SupportsAhwbGlInterop() {
-    return gpu_env_ != nullptr && gpu_env_->SupportsAhwbGlInterop();
+    auto gpu_env = GetGpuEnvironment();
+    return gpu_env && (*gpu_env)->SupportsAhwbGlInterop();
+  }
+
+  // Sets the sink the compiled models report their runs to, or clears it if
+  // `sink` is null.
+  void SetTelemetrySink(LiteRtTelemetrySink sink, void* user_data) {
+    absl::MutexLock lock(telemetry_mutex_);
+    telemetry_sink_ = sink;
+    telemetry_user_data_ = user_data;
+    has_telemetry_sink_.store(sink != nullptr, std::memory_order_release);
+  }
+
+  // The time spent registering the accelerators when the environment was
+  // created. The accelerators registered lazily are loaded later, see
+  // LiteRtCompiledModelT::GetStartupTimings().
+  absl::Duration GetAcceleratorRegistrationTime() const {
+    return accelerator_registration_time_;
+  }
+  void SetAcceleratorRegistrationTime(absl::Duration time) {
+    accelerator_registration_time_ = time;
+  }
+
+  // Returns true if runs should be measured for the telemetry sink.
+  bool HasTelemetrySink() const {
+    return has_telemetry_sink_.load(std::memory_order_acquire);
+  }
+
+  // Passes `record` to the telemetry sink, if any. The sink may be called from
+  // several threads at once.
+  void ReportRunTelemetry(const LiteRtRunTelemetry& record) {
+    absl::ReaderMutexLock lock(telemetry_mutex_);
+    if (telemetry_sink_ != nullptr) {
+      telemetry_sink_(telemetry_user_data_, &record);
+    }
   }
 
  private:
+  // Applies the tensor buffer pool budget option, if set.
+  void ConfigureTensorBufferPool();
+
   litert::internal::AcceleratorRegistry accelerators_;
   litert::internal::TensorBufferRegistry tensor_buffer_registry_;
   LiteRtEnvironmentOptionsT options_;
-  std::unique_ptr<litert::internal::GpuEnvironment> gpu_env_;
+  litert::internal::RunScheduler run_scheduler_;
+  absl::Duration accelerator_registration_time_;
+
+  absl::Mutex memory_trimmers_mutex_;
+  std::vector<std::pair<const void*, MemoryTrimmer>> memory_trimmers_
+      ABSL_GUARDED_BY(memory_trimmers_mutex_);
+
+  absl::Mutex gpu_env_mutex_;
+  std::unique_ptr<litert::internal::GpuEnvironment> gpu_env_
+      ABSL_GUARDED_BY(gpu_env_mutex_);
+  GpuEnvironmentFactory gpu_env_factory_ ABSL_GUARDED_BY(gpu_env_mutex_) =
+      nullptr;
+
+  absl::Mutex telemetry_mutex_;
+  LiteRtTelemetrySink telemetry_sink_ ABSL_GUARDED_BY(telemetry_mutex_) =
+      nullptr;
+  void* telemetry_user_data_ ABSL_GUARDED_BY(telemetry_mutex_) = nullptr;
+  std::atomic<bool> has_telemetry_sink_ = false;
 };
 
 #endif  // ODML_LITERT_LITERT_CORE_ENVIRONMENT_H_
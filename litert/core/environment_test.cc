@@ -16,17 +16,28 @@
 
 #include <any>
 #include <array>
+#include <memory>
 #include <utility>
 
 #include <gtest/gtest.h>
 #include "litert/c/litert_any.h"
 #include "litert/c/litert_environment.h"
 #include "litert/cc/litert_any.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/runtime/gpu_environment.h"
 #include "litert/test/matchers.h"
 
 namespace litert::internal {
 namespace {
 
+int num_gpu_environments_created = 0;
+
+Expected<std::unique_ptr<GpuEnvironment>> CreateEmptyGpuEnvironment(
+    LiteRtEnvironmentT* environment) {
+  ++num_gpu_environments_created;
+  return std::make_unique<GpuEnvironment>();
+}
+
 TEST(LiteRtEnvironmentT, CreateWithOptions) {
   LITERT_ASSERT_OK_AND_ASSIGN(
       LiteRtAny any_path, ToLiteRtAny(litert::LiteRtVariant("sample path")));
@@ -69,5 +80,24 @@ TEST(LiteRtEnvironmentT, CheckStringCopy) {
   ASSERT_STREQ(option->str_value, "sample path");
 }
 
+TEST(LiteRtEnvironmentT, CreatesGpuEnvironmentWhenFirstNeeded) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto env,
+                              LiteRtEnvironmentT::CreateWithOptions({}));
+  EXPECT_FALSE(env->GetGpuEnvironment());
+
+  num_gpu_environments_created = 0;
+  env->SetGpuEnvironmentFactory(&CreateEmptyGpuEnvironment);
+  EXPECT_FALSE(env->HasGpuEnvironment());
+  EXPECT_EQ(num_gpu_environments_created, 0);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(GpuEnvironment * gpu_env,
+                              env->GetGpuEnvironment());
+  EXPECT_TRUE(env->HasGpuEnvironment());
+  LITERT_ASSERT_OK_AND_ASSIGN(GpuEnvironment * same_gpu_env,
+                              env->GetGpuEnvironment());
+  EXPECT_EQ(gpu_env, same_gpu_env);
+  EXPECT_EQ(num_gpu_environments_created, 1);
+}
+
 }  // namespace
 }  // namespace litert::internal
@@ -18,6 +18,8 @@
 #include <cstdint>
 #include <filesystem>  // NOLINT
 #include <fstream>
+#include <ios>
+#include <random>
 #include <string>
 #include <system_error> // NOLINT
 #include <vector>
@@ -89,6 +91,18 @@ Expected<size_t> Size(absl::string_view path) {
   return StdSize(std_path);
 }
 
+Expected<int64_t> LastWriteTime(absl::string_view path) {
+  std::error_code error_code;
+  const auto time =
+      std::filesystem::last_write_time(MakeStdPath(path), error_code);
+  if (error_code) {
+    return Error(kLiteRtStatusErrorFileIO,
+                 absl::StrFormat("Could not stat: %s, error: %s",
+                                 std::string(path), error_code.message()));
+  }
+  return static_cast<int64_t>(time.time_since_epoch().count());
+}
+
 Expected<OwningBufferRef<uint8_t>> LoadBinaryFile(absl::string_view path) {
   auto std_path = MakeStdPath(path);
 
@@ -186,4 +200,59 @@ Expected<void> RmDir(std::string path_to_remove) {
   }
 }
 
+Expected<void> Rename(absl::string_view from, absl::string_view to) {
+  std::error_code error_code;
+  std::filesystem::rename(MakeStdPath(from), MakeStdPath(to), error_code);
+  if (error_code) {
+    return Error(kLiteRtStatusErrorFileIO,
+                 absl::StrFormat("Could not rename: %s to %s, error: %s",
+                                 std::string(from), std::string(to),
+                                 error_code.message()));
+  }
+  return {};
+}
+
+Expected<void> Remove(absl::string_view path) {
+  std::error_code error_code;
+  std::filesystem::remove(MakeStdPath(path), error_code);
+  if (error_code) {
+    return Error(kLiteRtStatusErrorFileIO,
+                 absl::StrFormat("Could not remove: %s, error: %s",
+                                 std::string(path), error_code.message()));
+  }
+  return {};
+}
+
+Expected<void> WriteFileAtomically(absl::string_view path,
+                                   absl::string_view data) {
+  std::random_device random_device;
+  const uint64_t suffix =
+      (static_cast<uint64_t>(random_device()) << 32) | random_device();
+  const std::string tmp_path =
+      absl::StrFormat("%s.tmp.%016x", std::string(path), suffix);
+  {
+    std::ofstream output_file(tmp_path, std::ios::out | std::ios::binary);
+    if (!output_file.is_open()) {
+      LITERT_LOG(LITERT_ERROR, "Failed to open file for writing: %s",
+                 tmp_path.c_str());
+      return Error(kLiteRtStatusErrorFileIO,
+                   "Failed to open file for writing");
+    }
+    output_file.write(data.data(), data.size());
+    output_file.close();
+    if (!output_file.good()) {
+      LITERT_LOG(LITERT_ERROR, "Failed to write all data to file: %s",
+                 tmp_path.c_str());
+      Remove(tmp_path);
+      return Error(kLiteRtStatusErrorFileIO,
+                   "Failed to write all data to file");
+    }
+  }
+  if (auto status = Rename(tmp_path, path); !status) {
+    Remove(tmp_path);
+    return status;
+  }
+  return {};
+}
+
 }  // namespace litert::internal
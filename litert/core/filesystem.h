@@ -47,6 +47,11 @@ bool IsDir(absl::string_view path);
 // Get size of file.
 Expected<size_t> Size(absl::string_view path);
 
+// Get the last modification time of the file, in the ticks of an unspecified
+// clock. Only meant to be compared with other values returned by this function
+// to detect that a file changed.
+Expected<int64_t> LastWriteTime(absl::string_view path);
+
 // Load the bytes of the file at given path.
 Expected<OwningBufferRef<uint8_t>> LoadBinaryFile(absl::string_view path);
 
@@ -64,6 +69,18 @@ Expected<std::string> Parent(absl::string_view path);
 
 Expected<void> RmDir(std::string path_to_remove);
 
+// Atomically replace the file at `to` with the file at `from`. Concurrent
+// readers of `to` see either the old or the new file, never a partial one.
+Expected<void> Rename(absl::string_view from, absl::string_view to);
+
+// Remove the file at the given path. It is not an error if it does not exist.
+Expected<void> Remove(absl::string_view path);
+
+// Write `data` to a uniquely named temporary file next to `path` and rename it
+// to `path`, so that readers never see a partially written file.
+Expected<void> WriteFileAtomically(absl::string_view path,
+                                   absl::string_view data);
+
 }  // namespace litert::internal
 
 #endif  // ODML_LITERT_LITERT_CORE_FILESYSTEM_H_
@@ -139,6 +139,27 @@ TEST(FilesystemTest, RmDir) {
   EXPECT_FALSE(Exists(dir));
 }
 
+TEST(FilesystemTest, RenameReplaces) {
+  const std::string from = Join({::testing::TempDir(), "rename_from"});
+  const std::string to = Join({::testing::TempDir(), "rename_to"});
+  WriteFile(from, "new");
+  WriteFile(to, "old content");
+  ASSERT_TRUE(Rename(from, to));
+  EXPECT_FALSE(Exists(from));
+  auto size = Size(to);
+  ASSERT_TRUE(size);
+  EXPECT_EQ(*size, 3);
+}
+
+TEST(FilesystemTest, Remove) {
+  const std::string file = Join({::testing::TempDir(), "remove_test"});
+  Touch(file);
+  ASSERT_TRUE(Remove(file));
+  EXPECT_FALSE(Exists(file));
+  // Removing a missing file is not an error.
+  EXPECT_TRUE(Remove(file));
+}
+
 }  // namespace
 }  // namespace litert::internal
 
@@ -17,6 +17,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -24,6 +25,9 @@
 #include <variant>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/hash/hash.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/cc/litert_buffer_ref.h"
 #include "litert/cc/litert_expected.h"
@@ -68,6 +72,36 @@ class BufferManager {
     return buffers_.size() - 1;
   }
 
+  // Register a buffer that is not owned by the model, unless a buffer with the
+  // same content and context was registered through this function before, in
+  // which case the id of that buffer is returned. Contents are only hashed
+  // when another buffer of the same size was registered.
+  BufferId RegisterDedupedNonOwnedBuffer(
+      BufferRef<uint8_t> buffer,
+      std::optional<BufferContext> context = std::nullopt) {
+    auto&& ctx = context.has_value() ? std::move(*context) : BufferContext{};
+    auto& same_size_ids = deduped_ids_by_size_[buffer.Size()];
+    if (!same_size_ids.empty()) {
+      const auto hash = ContentHash(buffer.StrView());
+      for (const auto id : same_size_ids) {
+        const auto& [other, other_ctx] = buffers_[id];
+        if (other_ctx.should_append != ctx.should_append ||
+            ContentHash(id) != hash) {
+          continue;
+        }
+        const auto other_view = GetView(other);
+        if (std::memcmp(other_view.Data(), buffer.Data(), buffer.Size()) ==
+            0) {
+          num_deduped_bytes_ += buffer.Size();
+          return id;
+        }
+      }
+    }
+    const auto id = RegisterNonOwnedBuffer(buffer, std::move(ctx));
+    same_size_ids.push_back(id);
+    return id;
+  }
+
   // Get a view of the buffer at the given id.
   Expected<BufferRef<uint8_t>> GetBuffer(BufferId id) {
     if (id >= buffers_.size()) {
@@ -87,6 +121,10 @@ class BufferManager {
   // Number of buffers. Ids will be 0 <-> num - 1.
   size_t NumBuffers() const { return buffers_.size(); }
 
+  // Number of bytes that did not need another buffer because
+  // RegisterDedupedNonOwnedBuffer found an identical one.
+  size_t NumDedupedBytes() const { return num_deduped_bytes_; }
+
   BufferManager() {
     // Zero is reserved for empty buffers.
     buffers_.emplace_back(
@@ -107,7 +145,25 @@ class BufferManager {
     return res;
   }
 
+  static size_t ContentHash(absl::string_view content) {
+    return absl::HashOf(content);
+  }
+
+  // Hash of a deduplicated buffer, computed on first use.
+  size_t ContentHash(BufferId id) {
+    auto [it, inserted] = content_hashes_.try_emplace(id, 0);
+    if (inserted) {
+      it->second = ContentHash(GetView(buffers_[id].first).StrView());
+    }
+    return it->second;
+  }
+
   std::vector<BufferWithContext> buffers_;
+
+  // Deduplicated buffers by size, and their content hashes.
+  absl::flat_hash_map<size_t, std::vector<BufferId>> deduped_ids_by_size_;
+  absl::flat_hash_map<BufferId, size_t> content_hashes_;
+  size_t num_deduped_bytes_ = 0;
 };
 
 }  // namespace litert::internal
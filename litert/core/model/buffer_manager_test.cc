@@ -73,6 +73,23 @@ TEST(BufferManagerTest, RegisterWithContext) {
   EXPECT_EQ(managed_context.get().should_append, true);
 }
 
+TEST(BufferManagerTest, RegisterDedupedNonOwnedBuffer) {
+  BufferManager manager;
+
+  OwningBufferRef<uint8_t> buffer(kData);
+  OwningBufferRef<uint8_t> same_buffer(kData);
+  OwningBufferRef<uint8_t> other_buffer("bar");
+  const auto id = manager.RegisterDedupedNonOwnedBuffer(buffer);
+  EXPECT_EQ(manager.RegisterDedupedNonOwnedBuffer(same_buffer), id);
+  EXPECT_NE(manager.RegisterDedupedNonOwnedBuffer(other_buffer), id);
+  EXPECT_EQ(manager.NumDedupedBytes(), kData.size());
+
+  // Buffers serialized differently are not shared.
+  BufferContext context = {true};
+  EXPECT_NE(manager.RegisterDedupedNonOwnedBuffer(same_buffer, context), id);
+  EXPECT_EQ(manager.NumBuffers(), 4);
+}
+
 }  // namespace
 
 }  // namespace litert::internal
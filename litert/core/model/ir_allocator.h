@@ -18,9 +18,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <functional>
-#include <iterator>
-#include <list>
 #include <memory>
+#include <new>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -32,32 +31,55 @@ namespace litert::internal {
 // A list of IR objects scoped to the same block (subgraph) that provides
 // pointer stability. Facilitates management of memory and c-like access
 // to elements.
+//
+// Objects are constructed in place in chunks of slots that are allocated
+// with a growing capacity, so that appending is O(1) and neighbouring
+// objects share cache lines. Each slot remembers its chunk and a chunk is
+// freed once all its objects are destroyed. Objects can therefore be
+// transferred between allocators by moving their pointers only.
 template <class Ir>
 class IrAllocator {
  private:
-  using Storage = std::list<Ir>;
   using Refs = std::vector<Ir*>;
 
+  struct Chunk;
+
+  struct Slot {
+    Chunk* chunk;
+    alignas(Ir) unsigned char value[sizeof(Ir)];
+  };
+
+  struct Chunk {
+    explicit Chunk(size_t capacity)
+        : capacity(capacity), slots(new Slot[capacity]) {}
+
+    const size_t capacity;
+    // Number of slots handed out.
+    size_t num_used = 0;
+    // Number of objects constructed in the chunk which are not destroyed.
+    size_t num_live = 0;
+    // Whether an allocator may still construct objects in the chunk.
+    bool is_open = true;
+    std::unique_ptr<Slot[]> slots;
+  };
+
+  static constexpr size_t kMinChunkCapacity = 4;
+  static constexpr size_t kMaxChunkCapacity = 256;
+
  public:
   // Emplace a new element onto the list.
   template <class... Args>
   Ir& EmplaceBack(Args&&... args) {
-    return EmplaceAt(Size(), std::forward<Args>(args)...);
+    Ir* ir = Construct(std::forward<Args>(args)...);
+    refs_->push_back(ir);
+    return *ir;
   }
 
   template <class... Args>
   Ir& EmplaceAt(int index, Args&&... args) {
-    auto storage_it = storage_.begin();
-    std::advance(storage_it, index);
-
-    auto emp_iter = storage_.emplace(storage_it, std::forward<Args>(args)...);
-
-    auto refs_it = refs_->begin();
-    std::advance(refs_it, index);
-
-    refs_->insert(refs_it, &(*emp_iter));
-
-    return *emp_iter;
+    Ir* ir = Construct(std::forward<Args>(args)...);
+    refs_->insert(refs_->begin() + index, ir);
+    return *ir;
   }
 
   // Get the array of (stable) pointers to underlying elements. Suitable
@@ -72,18 +94,16 @@ class IrAllocator {
   // Remove elements from the allocator if they match the predicate.
   // Returns the number of elements removed.
   size_t RemoveIf(std::function<bool(const Ir& ir)> pred) {
-    auto ref_it = refs_->begin();
-    for (auto it = storage_.begin(); it != storage_.end();) {
-      if (!pred(*it)) {
-        *ref_it = &*it;
-        ++ref_it;
-        ++it;
+    auto kept_it = refs_->begin();
+    for (Ir* ir : *refs_) {
+      if (!pred(*ir)) {
+        *kept_it++ = ir;
         continue;
       }
-      it = storage_.erase(it);
+      Destroy(ir);
     }
-    const size_t removed = refs_->end() - ref_it;
-    refs_->resize(refs_->size() - removed);
+    const size_t removed = refs_->end() - kept_it;
+    refs_->erase(kept_it, refs_->end());
     return removed;
   }
 
@@ -93,7 +113,9 @@ class IrAllocator {
     if (size >= Size()) {
       return;
     }
-    storage_.resize(size);
+    for (auto it = refs_->begin() + size; it != refs_->end(); ++it) {
+      Destroy(*it);
+    }
     refs_->resize(size);
   }
 
@@ -102,46 +124,30 @@ class IrAllocator {
   void TransferFrom(IrAllocator& other,
                     std::optional<std::vector<size_t>> indices = std::nullopt) {
     if (!indices) {
-      storage_.splice(storage_.cend(), other.storage_);
       refs_->insert(refs_->end(), other.refs_->cbegin(), other.refs_->cend());
-      other.ResetRefs();
+      other.refs_->clear();
       return;
     }
 
     auto& inds = *indices;
     std::sort(inds.begin(), inds.end());
-    std::vector<typename Storage::iterator> its;
-    auto i = 0;
-    auto it = other.storage_.begin();
+    refs_->reserve(refs_->size() + inds.size());
     for (auto ind : inds) {
-      std::advance(it, ind - i);
-      i = ind;
-      its.push_back(it);
+      refs_->push_back(other.refs_->at(ind));
+      // Marks the elements left to the other allocator.
+      other.refs_->at(ind) = nullptr;
     }
-    for (auto it : its) {
-      storage_.splice(storage_.cend(), other.storage_, it);
-    }
-
-    ResetRefs();
-    other.ResetRefs();
+    other.refs_->erase(
+        std::remove(other.refs_->begin(), other.refs_->end(), nullptr),
+        other.refs_->end());
   }
 
   // Transfers ownership of the given object to this allocator with at specified
   // index of this allocator.
   void TransferFrom(IrAllocator& other, size_t index) {
-    auto storage_it = storage_.begin();
-    std::advance(storage_it, index);
-    storage_.splice(storage_it, other.storage_);
-
-    auto refs_it = refs_->begin();
-    std::advance(refs_it, index);
-    for (auto it = std::prev(storage_it, other.storage_.size());
-         it != storage_.end(); ++it) {
-      refs_->insert(refs_it, &*it);
-    }
-
-    other.ResetRefs();
-    ResetRefs();
+    refs_->insert(refs_->begin() + index, other.refs_->cbegin(),
+                  other.refs_->cend());
+    other.refs_->clear();
   }
 
   // Override for rvalues.
@@ -154,29 +160,84 @@ class IrAllocator {
   }
 
   // Number of elements stored by this allocator.
-  size_t Size() const { return storage_.size(); }
+  size_t Size() const { return refs_ ? refs_->size() : 0; }
 
   IrAllocator() { refs_ = std::make_unique<Refs>(); }
 
+  ~IrAllocator() { Clear(); }
+
   // IR is generally semantically movable (without reference invalidation)
-  // but not copyable. IrAllocators reflect that, note moving lists
+  // but not copyable. IrAllocators reflect that, note moving the allocator
   // does not invalidate references.
   IrAllocator(const IrAllocator& other) = delete;
   IrAllocator& operator=(const IrAllocator& other) = delete;
-  IrAllocator(IrAllocator&& other) = default;
-  IrAllocator& operator=(IrAllocator&& other) = default;
+  IrAllocator(IrAllocator&& other)
+      : refs_(std::move(other.refs_)),
+        open_chunk_(std::exchange(other.open_chunk_, nullptr)) {}
+  IrAllocator& operator=(IrAllocator&& other) {
+    if (this != &other) {
+      Clear();
+      refs_ = std::move(other.refs_);
+      open_chunk_ = std::exchange(other.open_chunk_, nullptr);
+    }
+    return *this;
+  }
 
  private:
-  void ResetRefs() {
-    refs_->resize(storage_.size());
-    auto it = storage_.begin();
-    for (auto i = 0; i < storage_.size(); ++i, ++it) {
-      refs_->at(i) = &*it;
+  static Slot* SlotOf(Ir* ir) {
+    return reinterpret_cast<Slot*>(reinterpret_cast<unsigned char*>(ir) -
+                                   offsetof(Slot, value));
+  }
+
+  static void ReleaseChunkIfUnused(Chunk* chunk) {
+    if (chunk->num_live == 0 && !chunk->is_open) {
+      delete chunk;
+    }
+  }
+
+  template <class... Args>
+  Ir* Construct(Args&&... args) {
+    if (open_chunk_ == nullptr ||
+        open_chunk_->num_used == open_chunk_->capacity) {
+      CloseChunk();
+      open_chunk_ = new Chunk(
+          std::clamp(Size(), kMinChunkCapacity, kMaxChunkCapacity));
+    }
+    Slot& slot = open_chunk_->slots[open_chunk_->num_used++];
+    slot.chunk = open_chunk_;
+    Ir* ir = new (slot.value) Ir(std::forward<Args>(args)...);
+    ++open_chunk_->num_live;
+    return ir;
+  }
+
+  static void Destroy(Ir* ir) {
+    Chunk* chunk = SlotOf(ir)->chunk;
+    ir->~Ir();
+    --chunk->num_live;
+    ReleaseChunkIfUnused(chunk);
+  }
+
+  void CloseChunk() {
+    if (open_chunk_ != nullptr) {
+      open_chunk_->is_open = false;
+      ReleaseChunkIfUnused(std::exchange(open_chunk_, nullptr));
+    }
+  }
+
+  void Clear() {
+    if (refs_) {
+      for (Ir* ir : *refs_) {
+        Destroy(ir);
+      }
+      refs_->clear();
     }
+    CloseChunk();
   }
 
-  Storage storage_;
   std::unique_ptr<Refs> refs_;
+  // The chunk new elements are constructed in. Chunks are shared by all the
+  // allocators holding one of their elements.
+  Chunk* open_chunk_ = nullptr;
 };
 
 }  // namespace litert::internal
@@ -167,5 +167,32 @@ TEST(IrAllocatorTest, TransferAtStart) {
   EXPECT_EQ(root_ops.Elements().at(1), &op1);
 }
 
+TEST(IrAllocatorTest, TransferredElementsOutliveSource) {
+  IrAllocator<LiteRtOpT> ops;
+  std::vector<LiteRtOp> expected;
+  {
+    IrAllocator<LiteRtOpT> other_ops;
+    // Span several chunks.
+    for (int i = 0; i < 100; ++i) {
+      other_ops.EmplaceBack().SetOpCode(i % 2 ? kCustomOpCode
+                                              : kNonCustomOpCode);
+    }
+    std::vector<size_t> indices;
+    for (size_t i = 1; i < 100; i += 2) {
+      indices.push_back(i);
+      expected.push_back(other_ops.Elements().at(i));
+    }
+    ops.TransferFrom(other_ops, std::move(indices));
+    EXPECT_EQ(other_ops.Size(), 50);
+  }
+
+  EXPECT_THAT(ops.Elements(), ElementsAreArray(expected));
+  for (auto* op : ops.Elements()) {
+    EXPECT_EQ(op->OpCode(), kCustomOpCode);
+  }
+  ops.ResizeDown(10);
+  EXPECT_EQ(ops.Size(), 10);
+}
+
 }  // namespace
 }  // namespace litert::internal
@@ -35,6 +35,7 @@
 #include "litert/cc/litert_buffer_ref.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/core/build_stamp.h"
+#include "litert/core/model/subgraph_adjacency.h"
 #include "litert/core/util/flatbuffer_tools.h"
 
 using ::litert::internal::AttachInput;
@@ -126,6 +127,17 @@ LiteRtSignatureT MakeDefaultSignature(LiteRtSubgraph subgraph) {
                           std::move(output_tensors), std::move(name));
 }
 
+const ::litert::internal::SubgraphAdjacency& LiteRtSubgraphT::Adjacency()
+    const {
+  const uint64_t epoch = ::litert::internal::GraphEditEpoch();
+  if (adjacency_ == nullptr || adjacency_epoch_ != epoch) {
+    adjacency_ =
+        std::make_unique<::litert::internal::SubgraphAdjacency>(*this);
+    adjacency_epoch_ = epoch;
+  }
+  return *adjacency_;
+}
+
 ::litert::Expected<LiteRtSubgraph> LookupSubgraph(
     const LiteRtModelT& model, absl::string_view signature_key) {
   auto sig = model.FindSignature(signature_key);
@@ -486,6 +498,7 @@ void AttachInput(LiteRtTensor tensor, LiteRtOpT& op) {
   op.Inputs().push_back(tensor);
   tensor->Users().push_back(&op);
   tensor->UserArgInds().push_back(op.Inputs().size() - 1);
+  MarkGraphEdited();
 }
 
 void AttachOutput(LiteRtTensor tensor, LiteRtOpT& op) {
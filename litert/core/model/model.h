@@ -48,6 +48,7 @@
 #include "litert/core/build_stamp.h"
 #include "litert/core/model/buffer_manager.h"
 #include "litert/core/model/ir_allocator.h"
+#include "litert/core/model/subgraph_adjacency.h"
 #include "litert/core/util/flatbuffer_tools.h"
 #include "tflite/schema/schema_generated.h"
 
@@ -322,6 +323,7 @@ class LiteRtTensorT {
   void RemoveUse(size_t ind) {
     users_.erase(users_.begin() + ind);
     user_arg_inds_.erase(user_arg_inds_.begin() + ind);
+    ::litert::internal::MarkGraphEdited();
   }
 
   // Get the op that outputs this tensor, null if constant or subgraph input.
@@ -336,12 +338,14 @@ class LiteRtTensorT {
   void SetDefiningOp(LiteRtOpT& defining_op, LiteRtParamIndex out_ind) {
     defining_op_ = &defining_op;
     defining_op_out_ind_ = out_ind;
+    ::litert::internal::MarkGraphEdited();
   }
 
   // Set the defining op to none.
   void ClearDefiningOp() {
     defining_op_ = nullptr;
     defining_op_out_ind_ = 0;
+    ::litert::internal::MarkGraphEdited();
   }
 
   // Any constant data associated with this tensor.
@@ -490,10 +494,16 @@ class LiteRtOpT {
   const LiteRtTensorT& Output(size_t ind) const { return *Outputs().at(ind); }
 
   // Remove the ith entry of input list.
-  void RemoveInput(size_t ind) { inputs_.erase(inputs_.begin() + ind); }
+  void RemoveInput(size_t ind) {
+    inputs_.erase(inputs_.begin() + ind);
+    ::litert::internal::MarkGraphEdited();
+  }
 
   // Remove the ith entry of output list.
-  void RemoveOutput(size_t ind) { outputs_.erase(outputs_.begin() + ind); }
+  void RemoveOutput(size_t ind) {
+    outputs_.erase(outputs_.begin() + ind);
+    ::litert::internal::MarkGraphEdited();
+  }
 
   // Get any custom options attached to this op. Empty if there are none.
   litert::BufferRef<uint8_t> CustomOptions() const { return custom_options_; }
@@ -654,6 +664,7 @@ class LiteRtSubgraphT {
   // reference to it.
   template <class... Args>
   LiteRtTensorT& EmplaceTensor(Args&&... args) {
+    ::litert::internal::MarkGraphEdited();
     if (buffer_manager_ == nullptr) {
       return tensors_.EmplaceBack(std::forward<Args>(args)...);
     } else {
@@ -666,6 +677,7 @@ class LiteRtSubgraphT {
   // reference to it.
   template <class... Args>
   LiteRtOpT& EmplaceOp(Args&&... args) {
+    ::litert::internal::MarkGraphEdited();
     return ops_.EmplaceBack(std::forward<Args>(args)...);
   }
 
@@ -673,34 +685,49 @@ class LiteRtSubgraphT {
   // reference to it.
   template <class... Args>
   LiteRtOpT& EmplaceOpAt(int index, Args&&... args) {
+    ::litert::internal::MarkGraphEdited();
     return ops_.EmplaceAt(index, std::forward<Args>(args)...);
   }
 
   // De-allocates ops that pass given predicate. Returns number of ops removed.
   size_t RemoveOpIf(std::function<bool(const LiteRtOpT& op)> pred) {
+    ::litert::internal::MarkGraphEdited();
     return ops_.RemoveIf(pred);
   }
 
   // De-allocates tensors that pass given predicate. Returns number of tensors
   // removed.
   size_t RemoveTensorIf(std::function<bool(const LiteRtTensorT& tensor)> pred) {
+    ::litert::internal::MarkGraphEdited();
     return tensors_.RemoveIf(pred);
   }
 
   // Transfers the ownership of ops from the given allocator to this subgraph.
   // Ops are appended in order.
   void TransferOpsFrom(LiteRtOpT::Alloc& other, size_t index) {
+    ::litert::internal::MarkGraphEdited();
     ops_.TransferFrom(other, index);
   }
   // Transfers the ownership of tensors from the given allocator to this
   // subgraph. Tensors are appended in order.
   void TransferTensorsFrom(LiteRtTensorT::Alloc& other) {
+    ::litert::internal::MarkGraphEdited();
     tensors_.TransferFrom(other);
   }
 
   LiteRtOpT::Alloc& OpsAllocation() { return ops_; }
   LiteRtTensorT::Alloc& TensorsAllocation() { return tensors_; }
 
+  // Returns the index based adjacency of the ops and tensors of this subgraph,
+  // built on the first call after an edit of the IR, see MarkGraphEdited().
+  // The edits made directly on the vectors of the IR objects, e.g.
+  // Inputs().push_back(), must be followed by InvalidateAdjacency(). The
+  // returned reference is valid until the next edit.
+  const ::litert::internal::SubgraphAdjacency& Adjacency() const;
+
+  // Drops the adjacency, so that the next call to Adjacency() rebuilds it.
+  void InvalidateAdjacency() const { adjacency_.reset(); }
+
   // IR is generally, default constructible and movable but not copyable.
   LiteRtSubgraphT() = default;
   LiteRtSubgraphT(::litert::internal::BufferManager* buffer_manager)
@@ -725,6 +752,10 @@ class LiteRtSubgraphT {
 
   std::vector<LiteRtTensor> inputs_;
   std::vector<LiteRtTensor> outputs_;
+
+  // Built on demand by Adjacency(), at `adjacency_epoch_`.
+  mutable std::unique_ptr<::litert::internal::SubgraphAdjacency> adjacency_;
+  mutable uint64_t adjacency_epoch_ = 0;
 };
 
 //
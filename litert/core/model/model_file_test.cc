@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -19,6 +22,9 @@
 #include <filesystem>  // NOLINT
 #include <fstream>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -56,6 +62,7 @@
 #include "litert/test/common.h"
 #include "litert/test/matchers.h"
 #include "litert/test/test_models.h"
+#include "tflite/core/api/profiler.h"
 #include "tflite/schema/mutable/schema_generated.h"
 
 namespace litert::internal {
@@ -171,6 +178,228 @@ TEST(ModelLoadTest, BadFileData) {
   // NOLINTEND
 }
 
+TEST(ModelLoadTest, FromFileDescriptorAtOffset) {
+  // Store the model in the middle of a larger file, like an archive entry.
+  std::ifstream model_file(GetTestFilePath(kAddSimple), std::ios::binary);
+  std::string model_data((std::istreambuf_iterator<char>(model_file)),
+                         std::istreambuf_iterator<char>());
+  ASSERT_FALSE(model_data.empty());
+  constexpr size_t kOffset = 64;
+
+  std::filesystem::path archive_path(::testing::TempDir());
+  archive_path.append("archive.bin");
+  {
+    std::ofstream archive(archive_path, std::ios::binary);
+    archive << std::string(kOffset, '\0') << model_data << "trailing data";
+  }
+
+  int fd = open(archive_path.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  LiteRtModel model = nullptr;
+  LITERT_ASSERT_OK(LiteRtCreateModelFromFileDescriptor(
+      fd, kOffset, model_data.size(), &model));
+  // The model keeps its own reference to the file.
+  close(fd);
+
+  EXPECT_EQ(model->MainSubgraph()->Ops().size(), 1);
+  auto signature = model->FindSignature(LiteRtSignatureT::kDefaultSignatureKey);
+  ASSERT_TRUE(signature);
+  EXPECT_EQ(signature->get().InputNames().size(), 1);
+  LiteRtDestroyModel(model);
+
+  // The range must be inside the file.
+  fd = open(archive_path.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  EXPECT_THAT(LiteRtCreateModelFromFileDescriptor(
+                  fd, kOffset, 2 * model_data.size(), &model),
+              IsError(kLiteRtStatusErrorFileIO));
+  close(fd);
+}
+
+// Records the tags of the begun events.
+class RecordingProfiler : public tflite::Profiler {
+ public:
+  uint32_t BeginEvent(const char* tag, EventType event_type,
+                      int64_t event_metadata1,
+                      int64_t event_metadata2) override {
+    tags_.push_back(tag);
+    return tags_.size();
+  }
+  void EndEvent(uint32_t event_handle) override { ++num_ended_; }
+
+  const std::vector<std::string>& tags() const { return tags_; }
+  size_t num_ended() const { return num_ended_; }
+
+ private:
+  std::vector<std::string> tags_;
+  size_t num_ended_ = 0;
+};
+
+TEST(ModelLoadTest, ProfilesConversionPhases) {
+  RecordingProfiler profiler;
+  ModelLoadOptions options;
+  options.num_threads = 4;
+  options.profiler = &profiler;
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto model, LoadModelFromFile(GetTestFilePath(kAddSimple),
+                                    /*allow_modifications=*/false, options));
+  EXPECT_EQ(model->MainSubgraph()->Ops().size(), 1);
+
+  EXPECT_THAT(profiler.tags(),
+              ::testing::ElementsAre(
+                  "LiteRT::LoadModel", "LiteRT::LoadModel[allocate IR]",
+                  "LiteRT::LoadModel[unpack tensors and ops]",
+                  "LiteRT::LoadModel[link IR]",
+                  "LiteRT::LoadModel[model metadata]"));
+  EXPECT_EQ(profiler.num_ended(), profiler.tags().size());
+}
+
+TEST(ModelLoadTest, ParallelLoadMatchesSerialLoad) {
+  // Chain enough adds that the tensors and ops are unpacked on 4 threads.
+  static constexpr size_t kNumAdds = 600;
+  static constexpr size_t kNumThreads = 4;
+
+  auto flatbuffer =
+      FlatbufferWrapper::CreateFromTflFile(GetTestFilePath(kAddSimple));
+  ASSERT_TRUE(flatbuffer);
+  auto tfl_model = flatbuffer->get()->Unpack();
+  auto& tfl_subgraph = *tfl_model->subgraphs[0];
+  const auto& tfl_add = *tfl_subgraph.operators[0];
+  for (size_t i = 0; i < kNumAdds; ++i) {
+    const int32_t input = tfl_subgraph.outputs[0];
+    const auto& tfl_input = *tfl_subgraph.tensors[input];
+    auto tfl_output = std::make_unique<TflTensor>();
+    tfl_output->shape = tfl_input.shape;
+    tfl_output->type = tfl_input.type;
+    tfl_output->buffer = tfl_input.buffer;
+    tfl_output->name = "add_" + std::to_string(i);
+    tfl_subgraph.tensors.push_back(std::move(tfl_output));
+
+    auto tfl_op = std::make_unique<TflOp>();
+    tfl_op->opcode_index = tfl_add.opcode_index;
+    tfl_op->inputs = {input, input};
+    tfl_op->outputs = {static_cast<int32_t>(tfl_subgraph.tensors.size() - 1)};
+    tfl_op->builtin_options = tfl_add.builtin_options;
+    tfl_subgraph.operators.push_back(std::move(tfl_op));
+    tfl_subgraph.outputs = tfl_subgraph.operators.back()->outputs;
+  }
+  auto model_buf = SerializeFlatbuffer(*tfl_model);
+
+  ModelLoadOptions serial_options;
+  serial_options.num_threads = 1;
+  LITERT_ASSERT_OK_AND_ASSIGN(auto serial,
+                              LoadModelFromBuffer(model_buf, serial_options));
+  ModelLoadOptions parallel_options;
+  parallel_options.num_threads = kNumThreads;
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto parallel, LoadModelFromBuffer(model_buf, parallel_options));
+  ASSERT_GE(tfl_subgraph.tensors.size() + tfl_subgraph.operators.size(),
+            kNumThreads * 256);
+
+  const auto& serial_subgraph = serial->Subgraph(0);
+  const auto& parallel_subgraph = parallel->Subgraph(0);
+  ASSERT_EQ(parallel_subgraph.Tensors().size(),
+            serial_subgraph.Tensors().size());
+  ASSERT_EQ(parallel_subgraph.Ops().size(), kNumAdds + 1);
+  ASSERT_EQ(parallel_subgraph.Ops().size(), serial_subgraph.Ops().size());
+  for (size_t i = 0; i < serial_subgraph.Tensors().size(); ++i) {
+    const auto& serial_tensor = serial_subgraph.Tensor(i);
+    const auto& parallel_tensor = parallel_subgraph.Tensor(i);
+    EXPECT_EQ(parallel_tensor.Name(), serial_tensor.Name());
+    EXPECT_EQ(parallel_tensor.TensorIndex(), serial_tensor.TensorIndex());
+    EXPECT_EQ(parallel_tensor.NumUses(), serial_tensor.NumUses());
+  }
+  auto tensor_indices = [](const std::vector<LiteRtTensor>& tensors) {
+    std::vector<uint32_t> indices;
+    for (const auto* tensor : tensors) {
+      indices.push_back(tensor->TensorIndex());
+    }
+    return indices;
+  };
+  for (size_t i = 0; i < serial_subgraph.Ops().size(); ++i) {
+    const auto& serial_op = serial_subgraph.Op(i);
+    const auto& parallel_op = parallel_subgraph.Op(i);
+    EXPECT_EQ(parallel_op.OpCode(), kLiteRtOpCodeTflAdd);
+    EXPECT_EQ(parallel_op.OpCode(), serial_op.OpCode());
+    EXPECT_EQ(tensor_indices(parallel_op.Inputs()),
+              tensor_indices(serial_op.Inputs()));
+    EXPECT_EQ(tensor_indices(parallel_op.Outputs()),
+              tensor_indices(serial_op.Outputs()));
+  }
+
+  LITERT_ASSERT_OK_AND_ASSIGN(auto serial_serialized,
+                              SerializeModel(std::move(*serial)));
+  LITERT_ASSERT_OK_AND_ASSIGN(auto parallel_serialized,
+                              SerializeModel(std::move(*parallel)));
+  EXPECT_EQ(parallel_serialized.StrView(), serial_serialized.StrView());
+}
+
+TEST(ModelLoadTest, VerifiesFileBeforeUnpacking) {
+  const std::string path = GetTestFilePath(kAddSimple);
+  ModelLoadOptions options;
+  std::string verified_path;
+  options.verify_file = [&](absl::string_view file_path,
+                            BufferRef<uint8_t> buffer) -> Expected<void> {
+    verified_path = std::string(file_path);
+    EXPECT_GT(buffer.Size(), 0);
+    return {};
+  };
+  LITERT_ASSERT_OK(
+      LoadModelFromFile(path, /*allow_modifications=*/false, options));
+  EXPECT_EQ(verified_path, path);
+
+  // A failed verification fails the load.
+  options.verify_file = [](absl::string_view,
+                           BufferRef<uint8_t>) -> Expected<void> {
+    return Unexpected(kLiteRtStatusErrorInvalidFlatbuffer, "Invalid model");
+  };
+  EXPECT_THAT(LoadModelFromFile(path, /*allow_modifications=*/false, options),
+              IsError(kLiteRtStatusErrorInvalidFlatbuffer));
+}
+
+TEST(ModelLoadTest, DedupesIdenticalWeights) {
+  // Give the constant of the second subgraph its own copy of the weights.
+  auto flatbuffer =
+      FlatbufferWrapper::CreateFromTflFile(GetTestFilePath(kCstMultiSubgraph));
+  ASSERT_TRUE(flatbuffer);
+  auto tfl_model = flatbuffer->get()->Unpack();
+  auto& tfl_subgraph = *tfl_model->subgraphs[1];
+  auto& tfl_cst = *tfl_subgraph.tensors[tfl_subgraph.operators[0]->inputs[1]];
+  const auto& shared_data = tfl_model->buffers[tfl_cst.buffer]->data;
+  const auto weights_size = shared_data.size();
+  auto& copy = tfl_model->buffers.emplace_back(std::make_unique<TflBuffer>());
+  copy->data = shared_data;
+  tfl_cst.buffer = tfl_model->buffers.size() - 1;
+  auto model_buf = SerializeFlatbuffer(*tfl_model);
+
+  auto cst_buffer_id = [](const LiteRtModelT& model, size_t subgraph) {
+    return model.Subgraph(subgraph).Op(0).Input(1).Weights().GetBufferId();
+  };
+
+  LITERT_ASSERT_OK_AND_ASSIGN(auto model, LoadModelFromBuffer(model_buf));
+  EXPECT_NE(cst_buffer_id(*model, 0), cst_buffer_id(*model, 1));
+  EXPECT_EQ(model->Buffers()->NumDedupedBytes(), 0);
+
+  ModelLoadOptions options;
+  options.dedupe_weights = true;
+  LITERT_ASSERT_OK_AND_ASSIGN(auto deduped,
+                              LoadModelFromBuffer(model_buf, options));
+  EXPECT_EQ(cst_buffer_id(*deduped, 0), cst_buffer_id(*deduped, 1));
+  EXPECT_EQ(deduped->Buffers()->NumDedupedBytes(), weights_size);
+
+  // The shared weights are serialized once.
+  auto num_tfl_buffers = [](BufferRef<uint8_t> serialized) {
+    auto fb = FlatbufferWrapper::CreateFromBuffer(serialized);
+    return fb ? fb->get()->Unpack()->buffers.size() : 0;
+  };
+  LITERT_ASSERT_OK_AND_ASSIGN(auto serialized,
+                              SerializeModel(std::move(*model)));
+  LITERT_ASSERT_OK_AND_ASSIGN(auto serialized_deduped,
+                              SerializeModel(std::move(*deduped)));
+  EXPECT_EQ(num_tfl_buffers(serialized_deduped),
+            num_tfl_buffers(serialized) - 1);
+}
+
 TEST(ModelLoadTest, GetCustomOpCode) {
   auto model = litert::testing::LoadTestFileModel("simple_model_npu.tflite");
   ASSERT_TRUE(model);
@@ -694,6 +923,63 @@ TEST(ModelSerializeTest, WithOffsetTensorBufferAndOpAssetHasAlignment) {
   }
 }
 
+// Builds a model with one inline constant tensor and one op asset.
+void MakeModelWithWeightsAndOpAsset(LiteRtModelT& root,
+                                    absl::string_view tensor_data,
+                                    absl::string_view byte_code) {
+  auto& sg = root.EmplaceSubgraph();
+  auto& op = sg.EmplaceOp();
+  auto& tensor = sg.EmplaceTensor();
+  tensor.SetType(MakeRankedTensorType(kLiteRtElementTypeFloat32, {}));
+  auto& weights = tensor.Weights();
+  weights.SetBufferManager(root.Buffers());
+  SetWeightsFromOwnedBuffer(weights, OwningBufferRef<uint8_t>(tensor_data));
+
+  OwningBufferRef<uint8_t> buffer(byte_code);
+  const auto buf_id = root.Buffers()->RegisterOwnedBuffer(std::move(buffer));
+  root.AttachAssetToOp(&op, buf_id, "name");
+}
+
+TEST(ModelSerializeTest, AppendsLargeWeightsAndStreams) {
+  static constexpr absl::string_view kTensorData =
+      "SOME_TENSOR_DATA_LARGE_ENOUGH_TO_APPEND";
+  static constexpr absl::string_view kByteCode = "SOME_BYTE_CODE";
+
+  SerializationOptions options;
+  options.bytecode_alignment = 8;
+  options.min_appended_weights_size = 16;
+
+  LiteRtModelT root;
+  MakeModelWithWeightsAndOpAsset(root, kTensorData, kByteCode);
+  auto serialized = SerializeModel(std::move(root), options);
+  ASSERT_TRUE(serialized);
+
+  auto fb = FlatbufferWrapper::CreateFromBuffer(*serialized);
+  ASSERT_TRUE(fb);
+  auto tfl = fb->get()->Unpack();
+
+  // The weights are kept out of the flatbuffer.
+  const auto& tfl_buffer = tfl->buffers[tfl->subgraphs[0]->tensors[0]->buffer];
+  EXPECT_TRUE(tfl_buffer->data.empty());
+  EXPECT_EQ(tfl_buffer->offset % 16, 0);
+  EXPECT_EQ(serialized->StrView().substr(tfl_buffer->offset, tfl_buffer->size),
+            kTensorData);
+
+  // Streaming writes the same bytes.
+  LiteRtModelT other;
+  MakeModelWithWeightsAndOpAsset(other, kTensorData, kByteCode);
+  std::ostringstream out;
+  EXPECT_THAT(SerializeModelTo(std::move(other), out, options),
+              IsOkAndHolds(serialized->Size()));
+  EXPECT_EQ(out.str(), serialized->StrView());
+
+  // The weights are loaded back from the appended section.
+  auto model = LoadModelFromBuffer(*serialized);
+  ASSERT_TRUE(model);
+  EXPECT_EQ(model->get()->Subgraph(0).Tensor(0).Weights().Buffer().StrView(),
+            kTensorData);
+}
+
 TEST(ModelSerializeTest, TransferAndSerializeNoConstants) {
   LiteRtModelT root;
   auto& sg = root.EmplaceSubgraph();
@@ -15,14 +15,17 @@
 #include "litert/core/model/model_load.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/functional/function_ref.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
@@ -34,6 +37,7 @@
 #include "litert/core/model/flatbuffer_to_litert.h"
 #include "litert/core/model/model.h"
 #include "litert/core/util/flatbuffer_tools.h"
+#include "tflite/core/api/profiler.h"
 #include "tflite/schema/schema_generated.h"
 
 namespace litert::internal {
@@ -89,24 +93,10 @@ class FlatbufferContext {
   BufferIdMap registered_tfl_buffer_ids_;
 };
 
-LiteRtStatus UnpackOp(FlatbufferContext& context, LiteRtSubgraphT& parent,
-                      const TflPackedOp& tfl_op, LiteRtOpT& litert_op,
-                      size_t op_index) {
-  // I/O TENSORS
-
-  if (tfl_op.intermediates() && tfl_op.intermediates()->size() != 0) {
-    // TODO: b/365299994 - Support intermediates.
-    LITERT_LOG(LITERT_ERROR, "Intermediate tensors not yet supported.");
-    return kLiteRtStatusErrorUnsupported;
-  }
-
-  if (tfl_op.mutating_variable_inputs() &&
-      tfl_op.mutating_variable_inputs()->size() != 0) {
-    // TODO: b/365299994 - Support mutating variable inputs.
-    LITERT_LOG(LITERT_ERROR, "Mutating variable inputs not yet supported.");
-    return kLiteRtStatusErrorUnsupported;
-  }
-
+// Attaches the I/O tensors of `litert_op`. This updates the users of the
+// tensors, so ops of the same subgraph must be connected sequentially.
+void ConnectOp(LiteRtSubgraphT& parent, const TflPackedOp& tfl_op,
+               LiteRtOpT& litert_op) {
   const auto num_inputs = tfl_op.inputs()->size();
   for (auto i = 0; i < num_inputs; ++i) {
     const auto input_ind = tfl_op.inputs()->Get(i);
@@ -122,6 +112,26 @@ LiteRtStatus UnpackOp(FlatbufferContext& context, LiteRtSubgraphT& parent,
     const auto output_ind = tfl_op.outputs()->Get(i);
     AttachOutput(&parent.Tensor(output_ind), litert_op);
   }
+}
+
+// Unpacks everything but the I/O tensors of `litert_op`. Only touches
+// `litert_op`, so different ops can be unpacked concurrently.
+LiteRtStatus UnpackOp(FlatbufferContext& context, const TflPackedOp& tfl_op,
+                      LiteRtOpT& litert_op, size_t op_index) {
+  // I/O TENSORS
+
+  if (tfl_op.intermediates() && tfl_op.intermediates()->size() != 0) {
+    // TODO: b/365299994 - Support intermediates.
+    LITERT_LOG(LITERT_ERROR, "Intermediate tensors not yet supported.");
+    return kLiteRtStatusErrorUnsupported;
+  }
+
+  if (tfl_op.mutating_variable_inputs() &&
+      tfl_op.mutating_variable_inputs()->size() != 0) {
+    // TODO: b/365299994 - Support mutating variable inputs.
+    LITERT_LOG(LITERT_ERROR, "Mutating variable inputs not yet supported.");
+    return kLiteRtStatusErrorUnsupported;
+  }
 
   // OPTIONS
 
@@ -187,29 +197,46 @@ Expected<TflBufferContext> ReadBuffer(FlatbufferContext& context,
   }
 }
 
-LiteRtStatus UnpackTensor(FlatbufferContext& context,
-                          const TflPackedTensor& tfl_tensor,
-                          LiteRtTensorT& litert_tensor) {
+// Registers the weights of `litert_tensor` with the buffer manager. Buffer ids
+// are assigned in call order, so tensors must be registered sequentially. If
+// `dedupe_weights` is set, tensors with identical weights share one buffer.
+LiteRtStatus RegisterWeights(FlatbufferContext& context,
+                             const TflPackedTensor& tfl_tensor,
+                             LiteRtTensorT& litert_tensor,
+                             bool dedupe_weights) {
   const auto buffer_ind = tfl_tensor.buffer();
-  if (buffer_ind != 0) {
-    auto buffer = ReadBuffer(context, buffer_ind);
-    if (!buffer) {
-      return buffer.Error().Status();
-    }
+  if (buffer_ind == 0) {
+    return kLiteRtStatusOk;
+  }
+  auto buffer = ReadBuffer(context, buffer_ind);
+  if (!buffer) {
+    return buffer.Error().Status();
+  }
 
-    auto it = context.RegisteredTflBufferIds().find(buffer_ind);
-    if (it != context.RegisteredTflBufferIds().end()) {
-      litert_tensor.Weights().SetBufferId(it->second);
+  auto it = context.RegisteredTflBufferIds().find(buffer_ind);
+  if (it != context.RegisteredTflBufferIds().end()) {
+    litert_tensor.Weights().SetBufferId(it->second);
+  } else {
+    BufferContext lrt_buf_ctx;
+    lrt_buf_ctx.should_append = buffer->is_external;
+    auto& weights = litert_tensor.Weights();
+    if (dedupe_weights) {
+      weights.SetBufferId(
+          weights.GetBufferManager()->RegisterDedupedNonOwnedBuffer(
+              buffer->buffer, lrt_buf_ctx));
     } else {
-      BufferContext lrt_buf_ctx;
-      lrt_buf_ctx.should_append = buffer->is_external;
-      SetWeightsFromUnownedBuffer(litert_tensor.Weights(), buffer->buffer,
-                                  lrt_buf_ctx);
-      context.RegisteredTflBufferIds()[buffer_ind] =
-          litert_tensor.Weights().GetBufferId();
+      SetWeightsFromUnownedBuffer(weights, buffer->buffer, lrt_buf_ctx);
     }
+    context.RegisteredTflBufferIds()[buffer_ind] =
+        litert_tensor.Weights().GetBufferId();
   }
+  return kLiteRtStatusOk;
+}
 
+// Unpacks everything but the weights of `litert_tensor`. Only touches
+// `litert_tensor`, so different tensors can be unpacked concurrently.
+LiteRtStatus UnpackTensor(const TflPackedTensor& tfl_tensor,
+                          LiteRtTensorT& litert_tensor) {
   // TENSOR TYPE
 
   TflTensorType tfl_tensor_type(tfl_tensor.type(), TflShapeInfo(tfl_tensor));
@@ -259,38 +286,145 @@ LiteRtStatus UnpackTensor(FlatbufferContext& context,
   return kLiteRtStatusOk;
 }
 
-LiteRtStatus UnpackSubgraph(FlatbufferContext& context,
-                            const TflPackedSubgraph& tfl_subgraph,
-                            LiteRtSubgraphT& litert_subgraph) {
-  // Unpack tensors.
-  const auto num_tensors = tfl_subgraph.tensors()->size();
-  for (auto i = 0; i < num_tensors; ++i) {
-    const auto* tfl_tensor = tfl_subgraph.tensors()->Get(i);
-    auto& litert_tensor = litert_subgraph.EmplaceTensor();
-    LITERT_RETURN_IF_ERROR(UnpackTensor(context, *tfl_tensor, litert_tensor));
-    litert_tensor.SetTensorIndex(i);
-  }
-
-  // Unpack ops, pass litert_subgraph so they can look up the new litert
-  // tensors.
-  const auto num_ops = tfl_subgraph.operators()->size();
-  for (auto i = 0; i < num_ops; ++i) {
-    const auto* tfl_op = tfl_subgraph.operators()->Get(i);
-    LITERT_RETURN_IF_ERROR(UnpackOp(context, litert_subgraph, *tfl_op,
-                                    litert_subgraph.EmplaceOp(), i));
-  }
-
-  // Update subgraph I/O.
-  const auto num_inputs = tfl_subgraph.inputs()->size();
-  for (auto i = 0; i < num_inputs; ++i) {
-    const auto tfl_input_ind = tfl_subgraph.inputs()->Get(i);
-    litert_subgraph.Inputs().push_back(&litert_subgraph.Tensor(tfl_input_ind));
+// Number of tensors and ops below which a thread isn't worth starting.
+constexpr size_t kMinItemsPerThread = 256;
+
+// Calls `fn` on [0, num_items) from up to `num_threads` threads, including the
+// calling one. Returns the error of the lowest failed item so that the result
+// doesn't depend on scheduling.
+LiteRtStatus ParallelFor(size_t num_items, size_t num_threads,
+                         absl::FunctionRef<LiteRtStatus(size_t)> fn) {
+  num_threads = std::min(num_threads, num_items / kMinItemsPerThread);
+  if (num_threads <= 1) {
+    for (size_t i = 0; i < num_items; ++i) {
+      LITERT_RETURN_IF_ERROR(fn(i));
+    }
+    return kLiteRtStatusOk;
   }
-  const auto num_outputs = tfl_subgraph.outputs()->size();
-  for (auto i = 0; i < num_outputs; ++i) {
-    const auto tfl_output_ind = tfl_subgraph.outputs()->Get(i);
-    litert_subgraph.Outputs().push_back(
-        &litert_subgraph.Tensor(tfl_output_ind));
+
+  std::atomic<size_t> next_item = 0;
+  std::atomic<size_t> first_failed_item = num_items;
+  std::vector<LiteRtStatus> statuses(num_items, kLiteRtStatusOk);
+  auto worker = [&]() {
+    for (size_t i = next_item++; i < num_items; i = next_item++) {
+      // Items after a failure are skipped.
+      if (i > first_failed_item.load(std::memory_order_relaxed)) {
+        continue;
+      }
+      if (auto status = fn(i); status != kLiteRtStatusOk) {
+        statuses[i] = status;
+        size_t failed = first_failed_item.load(std::memory_order_relaxed);
+        while (i < failed && !first_failed_item.compare_exchange_weak(
+                                 failed, i, std::memory_order_relaxed)) {
+        }
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const size_t failed = first_failed_item.load();
+  return failed < num_items ? statuses[failed] : kLiteRtStatusOk;
+}
+
+// Converts all the subgraphs of the model. The IR objects are first allocated,
+// then the tensors and ops, which are independent of each other, are unpacked
+// in parallel. Finally the steps with side effects on shared state, i.e.
+// connecting the ops and registering the weights, run in model order so that
+// the result is the same as a sequential conversion.
+LiteRtStatus UnpackSubgraphs(FlatbufferContext& context,
+                             LiteRtModelT& litert_model,
+                             const ModelLoadOptions& options) {
+  const auto* tfl_subgraphs = context.PackedModel()->subgraphs();
+  if (tfl_subgraphs == nullptr) {
+    return kLiteRtStatusOk;
+  }
+
+  // A tensor or op to unpack.
+  struct Item {
+    const TflPackedSubgraph* tfl_subgraph;
+    LiteRtSubgraphT* litert_subgraph;
+    size_t index;
+    bool is_tensor;
+  };
+  std::vector<Item> items;
+  {
+    TFLITE_SCOPED_TAGGED_DEFAULT_PROFILE(options.profiler,
+                                         "LiteRT::LoadModel[allocate IR]");
+    for (auto* tfl_subgraph : *tfl_subgraphs) {
+      auto& litert_subgraph = litert_model.EmplaceSubgraph();
+      const auto num_tensors = tfl_subgraph->tensors()->size();
+      const auto num_ops = tfl_subgraph->operators()->size();
+      items.reserve(items.size() + num_tensors + num_ops);
+      for (size_t i = 0; i < num_tensors; ++i) {
+        litert_subgraph.EmplaceTensor().SetTensorIndex(i);
+        items.push_back({tfl_subgraph, &litert_subgraph, i, true});
+      }
+      for (size_t i = 0; i < num_ops; ++i) {
+        litert_subgraph.EmplaceOp();
+        items.push_back({tfl_subgraph, &litert_subgraph, i, false});
+      }
+    }
+  }
+
+  {
+    TFLITE_SCOPED_TAGGED_DEFAULT_PROFILE(
+        options.profiler, "LiteRT::LoadModel[unpack tensors and ops]");
+    const size_t num_threads = options.num_threads > 0
+                                   ? options.num_threads
+                                   : std::thread::hardware_concurrency();
+    LITERT_RETURN_IF_ERROR(
+        ParallelFor(items.size(), num_threads, [&](size_t i) {
+          const auto& item = items[i];
+          if (item.is_tensor) {
+            return UnpackTensor(*item.tfl_subgraph->tensors()->Get(item.index),
+                                item.litert_subgraph->Tensor(item.index));
+          }
+          return UnpackOp(context,
+                          *item.tfl_subgraph->operators()->Get(item.index),
+                          item.litert_subgraph->Op(item.index), item.index);
+        }));
+  }
+
+  TFLITE_SCOPED_TAGGED_DEFAULT_PROFILE(options.profiler,
+                                       "LiteRT::LoadModel[link IR]");
+  for (auto i = 0; i < tfl_subgraphs->size(); ++i) {
+    const auto& tfl_subgraph = *tfl_subgraphs->Get(i);
+    auto& litert_subgraph = *litert_model.Subgraphs()[i];
+
+    const auto num_tensors = tfl_subgraph.tensors()->size();
+    for (auto j = 0; j < num_tensors; ++j) {
+      LITERT_RETURN_IF_ERROR(RegisterWeights(
+          context, *tfl_subgraph.tensors()->Get(j), litert_subgraph.Tensor(j),
+          options.dedupe_weights));
+    }
+
+    // Connect ops, looking up the new litert tensors.
+    const auto num_ops = tfl_subgraph.operators()->size();
+    for (auto j = 0; j < num_ops; ++j) {
+      ConnectOp(litert_subgraph, *tfl_subgraph.operators()->Get(j),
+                litert_subgraph.Op(j));
+    }
+
+    // Update subgraph I/O.
+    const auto num_inputs = tfl_subgraph.inputs()->size();
+    for (auto j = 0; j < num_inputs; ++j) {
+      const auto tfl_input_ind = tfl_subgraph.inputs()->Get(j);
+      litert_subgraph.Inputs().push_back(
+          &litert_subgraph.Tensor(tfl_input_ind));
+    }
+    const auto num_outputs = tfl_subgraph.outputs()->size();
+    for (auto j = 0; j < num_outputs; ++j) {
+      const auto tfl_output_ind = tfl_subgraph.outputs()->Get(j);
+      litert_subgraph.Outputs().push_back(
+          &litert_subgraph.Tensor(tfl_output_ind));
+    }
   }
 
   return kLiteRtStatusOk;
@@ -372,22 +506,19 @@ LiteRtStatus UnpackSignatures(std::vector<TflSignaturePtr>& tfl_signatures,
   return kLiteRtStatusOk;
 }
 
-Expected<LiteRtModelT::Ptr> UnpackModel(FlatbufferWrapper&& flatbuffer) {
+Expected<LiteRtModelT::Ptr> UnpackModel(FlatbufferWrapper&& flatbuffer,
+                                        const ModelLoadOptions& options) {
+  TFLITE_SCOPED_TAGGED_DEFAULT_PROFILE(options.profiler, "LiteRT::LoadModel");
   auto litert_model = std::make_unique<LiteRtModelT>(std::move(flatbuffer));
 
   FlatbufferContext context(litert::internal::GetTflFlatbuffer(*litert_model),
                             litert_model->Buffers());
   const auto* packed_model = context.PackedModel();
 
-  if (packed_model->subgraphs()) {
-    const auto num_subgraphs = packed_model->subgraphs()->size();
-    for (auto i = 0; i < num_subgraphs; ++i) {
-      const auto* tfl_subgraph = packed_model->subgraphs()->Get(i);
-      LITERT_RETURN_IF_ERROR(UnpackSubgraph(context, *tfl_subgraph,
-                                            litert_model->EmplaceSubgraph()));
-    }
-  }
+  LITERT_RETURN_IF_ERROR(UnpackSubgraphs(context, *litert_model, options));
 
+  TFLITE_SCOPED_TAGGED_DEFAULT_PROFILE(options.profiler,
+                                       "LiteRT::LoadModel[model metadata]");
   // TODO Figure out how to load signatures in packed flatbuffer.
   if (packed_model->signature_defs()) {
     std::vector<TflSignaturePtr> tfl_signatures;
@@ -433,30 +564,44 @@ Expected<LiteRtModelT::Ptr> UnpackModel(FlatbufferWrapper&& flatbuffer) {
 }  // namespace
 
 Expected<LiteRtModelT::Ptr> LoadModelFromBuffer(
-    OwningBufferRef<uint8_t>&& buffer) {
+    OwningBufferRef<uint8_t>&& buffer, const ModelLoadOptions& options) {
   auto flatbuffer = FlatbufferWrapper::CreateFromBuffer(std::move(buffer));
   if (!flatbuffer) {
     return flatbuffer.Error();
   }
-  return UnpackModel(std::move(**flatbuffer));
+  return UnpackModel(std::move(**flatbuffer), options);
 }
 
-Expected<LiteRtModelT::Ptr> LoadModelFromBuffer(BufferRef<uint8_t> buffer) {
+Expected<LiteRtModelT::Ptr> LoadModelFromBuffer(
+    BufferRef<uint8_t> buffer, const ModelLoadOptions& options) {
   auto flatbuffer = FlatbufferWrapper::CreateFromBuffer(buffer);
   if (!flatbuffer) {
     return flatbuffer.Error();
   }
-  return UnpackModel(std::move(**flatbuffer));
+  return UnpackModel(std::move(**flatbuffer), options);
+}
+
+Expected<LiteRtModelT::Ptr> LoadModelFromFileDescriptor(
+    int fd, size_t offset, size_t length, const ModelLoadOptions& options) {
+  LITERT_ASSIGN_OR_RETURN(
+      auto flatbuffer,
+      FlatbufferWrapper::CreateFromFileDescriptor(fd, offset, length));
+  return UnpackModel(std::move(*flatbuffer), options);
 }
 
 Expected<LiteRtModelT::Ptr> LoadModelFromFile(absl::string_view filename,
-                                              bool allow_modifications) {
+                                              bool allow_modifications,
+                                              const ModelLoadOptions& options) {
   auto flatbuffer =
       FlatbufferWrapper::CreateFromTflFile(filename, allow_modifications);
   if (!flatbuffer) {
     return flatbuffer.Error();
   }
-  LITERT_ASSIGN_OR_RETURN(auto model, UnpackModel(std::move(**flatbuffer)));
+  if (options.verify_file) {
+    LITERT_RETURN_IF_ERROR(options.verify_file(filename, (*flatbuffer)->Buf()));
+  }
+  LITERT_ASSIGN_OR_RETURN(auto model,
+                          UnpackModel(std::move(**flatbuffer), options));
   model->SetSourcePath(std::string(filename));
   return std::move(model);
 }
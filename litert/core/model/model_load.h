@@ -15,27 +15,58 @@
 #ifndef ODML_LITERT_LITERT_CORE_MODEL_MODEL_LOAD_H_
 #define ODML_LITERT_LITERT_CORE_MODEL_MODEL_LOAD_H_
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/cc/litert_buffer_ref.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/core/model/model.h"
+#include "tflite/core/api/profiler.h"
 
 namespace litert::internal {
 
+// Options controlling the conversion of a flatbuffer to the LiteRT IR.
+struct ModelLoadOptions {
+  // Maximum number of threads unpacking tensors and ops, including the calling
+  // thread. 0 uses the number of hardware threads. Small models are always
+  // converted on the calling thread.
+  size_t num_threads = 0;
+  // If set, receives an event for each phase of the conversion.
+  tflite::Profiler* profiler = nullptr;
+  // Whether constant tensors with byte-identical weights, e.g. embeddings
+  // shared by several signatures, are backed by one buffer. This hashes the
+  // weights that have the same size as others, so it reads them at load time.
+  // The bytes saved are reported by BufferManager::NumDedupedBytes().
+  bool dedupe_weights = false;
+  // If set, called by LoadModelFromFile() with the path and the flatbuffer of
+  // the file before the model is unpacked. An error fails the load, e.g. for a
+  // file that doesn't pass the flatbuffer verification.
+  std::function<Expected<void>(absl::string_view path,
+                               BufferRef<uint8_t> buffer)>
+      verify_file;
+};
+
 // Loads a model from a file. If allow_modifications is true, then the model
 // can be modified in place, for example, model would be mmap'ed with writable
 // flag and private mapping (not to update the model file on disk).
 Expected<std::unique_ptr<LiteRtModelT>> LoadModelFromFile(
-    absl::string_view filename, bool allow_modifications = false);
+    absl::string_view filename, bool allow_modifications = false,
+    const ModelLoadOptions& options = {});
+
+// Loads a model stored in `length` bytes of `fd` starting at `offset`, e.g.
+// an uncompressed entry of an archive. The model is mmap'ed read-only, the
+// weights reference the mapping and are paged in on first access.
+Expected<std::unique_ptr<LiteRtModelT>> LoadModelFromFileDescriptor(
+    int fd, size_t offset, size_t length, const ModelLoadOptions& options = {});
 
 Expected<std::unique_ptr<LiteRtModelT>> LoadModelFromBuffer(
-    BufferRef<uint8_t> buffer);
+    BufferRef<uint8_t> buffer, const ModelLoadOptions& options = {});
 
 Expected<std::unique_ptr<LiteRtModelT>> LoadModelFromBuffer(
-    OwningBufferRef<uint8_t>&& buffer);
+    OwningBufferRef<uint8_t>&& buffer, const ModelLoadOptions& options = {});
 
 }  // namespace litert::internal
 
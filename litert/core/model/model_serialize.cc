@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <ostream>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -75,11 +76,12 @@ class SerializationContext {
 
   explicit SerializationContext(uint32_t dispatch_op_code_ind,
                                 LiteRtModelT& litert_model,
-                                size_t bytecode_alignment)
+                                const SerializationOptions& options)
       : tfl_model_(std::make_unique<TflModel>()),
         dispatch_op_code_ind_(dispatch_op_code_ind),
         litert_model_(litert_model),
-        bytecode_alignment_(bytecode_alignment) {
+        bytecode_alignment_(options.bytecode_alignment),
+        min_appended_weights_size_(options.min_appended_weights_size) {
     // Tfl expects empty buffer 0.
     tfl_model_->buffers.push_back(std::make_unique<TflBuffer>());
   }
@@ -117,7 +119,12 @@ class SerializationContext {
           tfl_model_->buffers.emplace_back(std::make_unique<TflBuffer>());
       tfl_buffer_ind = tfl_model_->buffers.size() - 1;
 
-      if (litert_buf_ctx->get().should_append) {
+      // Large weights are appended after the flatbuffer, where they are
+      // written straight from the source buffer.
+      const bool append_weights =
+          min_appended_weights_size_ != 0 &&
+          litert_buf->Size() >= min_appended_weights_size_;
+      if (litert_buf_ctx->get().should_append || append_weights) {
         tfl_buffer->offset = 1;
         tfl_buffer->size = 1;
         offset_tensor_map_.emplace(tfl_buffer_ind, litert_buf_id);
@@ -175,6 +182,7 @@ class SerializationContext {
   TflOffsetTensorMap offset_tensor_map_;
   TflBufferIdMap buffer_id_map_;
   size_t bytecode_alignment_ = 0;
+  size_t min_appended_weights_size_ = 0;
 };
 
 LiteRtStatus PackOp(SerializationContext& builder, LiteRtOpT& litert_op,
@@ -350,20 +358,37 @@ Expected<TflModelPtr> PackAsTflite(SerializationContext& builder) {
   return std::move(builder).Release();
 }
 
-// Appends external buffers to the back of the serialized tflite model. Updates
-// the ops that references them with the correct offset and size in-place.
-Expected<OwningBufferRef<uint8_t>> SerializeWithAppendedBuffers(
-    SerializationContext& builder, OwningBufferRef<uint8_t> serialized_tfl,
-    LiteRtModelT& litert_model) {
+// Minimum alignment of the constant tensor buffers appended to the model.
+constexpr size_t kOffsetTensorAlignment = 16;
+
+// A buffer to write after the serialized tflite model.
+struct AppendedBuffer {
+  // Offset from the start of the model.
+  size_t offset;
+  BufferRef<uint8_t> data;
+};
+
+// Lays out the external buffers after the serialized tflite model and updates
+// the ops and buffers that reference them with the correct offset and size
+// in-place. Returns the buffers to append by increasing offset and sets
+// `model_size` to the size of the whole model.
+Expected<std::vector<AppendedBuffer>> LayoutAppendedBuffers(
+    SerializationContext& builder, MutableBufferRef<uint8_t> serialized_tfl,
+    LiteRtModelT& litert_model, size_t& model_size) {
+  model_size = serialized_tfl.Size();
+  std::vector<AppendedBuffer> appended_buffers;
   if (builder.OpAssetMap().empty() && builder.OffsetTensorMap().empty()) {
-    return serialized_tfl;
+    return appended_buffers;
   }
 
-  const auto align = builder.BytecodeAlignment();
   // Pad the original model to the next multiple of the alignment.
-  auto align_offset = [align](size_t& cur_offset) {
+  auto align_offset_to = [](size_t& cur_offset, size_t align) {
     cur_offset = (cur_offset + align - 1) & ~(align - 1);
   };
+  const auto align = builder.BytecodeAlignment();
+  auto align_offset = [&](size_t& cur_offset) {
+    align_offset_to(cur_offset, align);
+  };
 
   size_t cur_offset = serialized_tfl.Size();
   align_offset(cur_offset);
@@ -401,6 +426,7 @@ Expected<OwningBufferRef<uint8_t>> SerializeWithAppendedBuffers(
     if (offset_tensor_offsets.Contains(tfl_buffer_ind)) {
       continue;
     }
+    align_offset_to(cur_offset, std::max(align, kOffsetTensorAlignment));
     offset_tensor_offsets.InsertOrAssign(tfl_buffer_ind,
                                          {cur_offset, litert_buf->Size()});
     cur_offset += litert_buf->Size();
@@ -473,14 +499,9 @@ Expected<OwningBufferRef<uint8_t>> SerializeWithAppendedBuffers(
     }
   }
 
-  // Allocate buffer enough for original model and appendd buffers and copy.
-  OwningBufferRef<uint8_t> final_model(cur_offset);
-
-  // Copy serialized tflite model.
-  uint8_t* const start = final_model.Data();
-  std::memcpy(start, serialized_tfl.Data(), serialized_tfl.Size());
-
-  // Copy asset buffers (aligned).
+  // Collect the asset buffers and the offset tensor buffers.
+  appended_buffers.reserve(asset_buffer_offsets.Size() +
+                           offset_tensor_offsets.Size());
   for (auto it = asset_buffer_offsets.Begin(); it != asset_buffer_offsets.End();
        ++it) {
     const auto buf_id = it->first;
@@ -490,40 +511,37 @@ Expected<OwningBufferRef<uint8_t>> SerializeWithAppendedBuffers(
       LITERT_LOG(LITERT_ERROR, "Failed to find asset buffer");
       return asset_buf.Error();
     }
-    uint8_t* const offset = start + it->second.first;
-    std::memcpy(offset, asset_buf->Data(), asset_buf->Size());
+    appended_buffers.push_back({it->second.first, *asset_buf});
   }
-
-  // Copy offset tensor buffers.
   for (auto it = offset_tensor_offsets.Begin();
        it != offset_tensor_offsets.End(); ++it) {
-    const auto buf_id = it->first;
+    const auto tfl_buffer_ind = it->first;
+    const auto litert_buf_id = builder.OffsetTensorMap().at(tfl_buffer_ind);
 
-    auto offset_buf = litert_model.Buffers()->GetBuffer(buf_id);
+    auto offset_buf = litert_model.Buffers()->GetBuffer(litert_buf_id);
     if (!offset_buf) {
       LITERT_LOG(LITERT_ERROR, "Failed to find offset tensor buffer");
       return offset_buf.Error();
     }
-
-    uint8_t* const offset = start + it->second.first;
-    std::memcpy(offset, offset_buf->Data(), offset_buf->Size());
+    appended_buffers.push_back({it->second.first, *offset_buf});
   }
 
-  return final_model;
+  model_size = cur_offset;
+  return appended_buffers;
 }
 
-}  // namespace
-
-Expected<OwningBufferRef<uint8_t>> SerializeModel(LiteRtModelT&& model,
-                                                  size_t bytecode_alignment) {
+// Packs the model and serializes it as a flatbuffer, without the appended
+// buffers. Also returns the layout of the appended buffers.
+Expected<OwningBufferRef<uint8_t>> SerializeFlatbufferPart(
+    LiteRtModelT& model, const SerializationOptions& options,
+    std::vector<AppendedBuffer>& appended_buffers, size_t& model_size) {
   // Pass the op code list through that was saved during loading. Add one more
   // op code for the dispatch ops
   auto tfl_op_codes = litert::internal::TakeTflOpCodes(model);
   tfl_op_codes.push_back(
       MakeCustomOpCode(std::string(kLiteRtDispatchOpCustomName)));
 
-  SerializationContext builder(tfl_op_codes.size() - 1, model,
-                               bytecode_alignment);
+  SerializationContext builder(tfl_op_codes.size() - 1, model, options);
   builder.Model().operator_codes = std::move(tfl_op_codes);
 
   auto tfl_model = PackAsTflite(builder);
@@ -533,19 +551,90 @@ Expected<OwningBufferRef<uint8_t>> SerializeModel(LiteRtModelT&& model,
   }
 
   auto serialized_tfl = SerializeFlatbuffer(**tfl_model);
-  auto serialized_with_buffers =
-      SerializeWithAppendedBuffers(builder, std::move(serialized_tfl), model);
-  if (!serialized_with_buffers) {
-    LITERT_LOG(LITERT_ERROR, "Failed to serialize with appended buffers");
-    return serialized_with_buffers.Error();
+  auto layout = LayoutAppendedBuffers(builder, serialized_tfl, model,
+                                      model_size);
+  if (!layout) {
+    LITERT_LOG(LITERT_ERROR, "Failed to lay out appended buffers");
+    return layout.Error();
+  }
+  appended_buffers = std::move(*layout);
+  return serialized_tfl;
+}
+
+}  // namespace
+
+Expected<OwningBufferRef<uint8_t>> SerializeModel(LiteRtModelT&& model,
+                                                  size_t bytecode_alignment) {
+  SerializationOptions options;
+  options.bytecode_alignment = bytecode_alignment;
+  return SerializeModel(std::move(model), options);
+}
+
+Expected<OwningBufferRef<uint8_t>> SerializeModel(
+    LiteRtModelT&& model, const SerializationOptions& options) {
+  std::vector<AppendedBuffer> appended_buffers;
+  size_t model_size;
+  LITERT_ASSIGN_OR_RETURN(
+      auto serialized_tfl,
+      SerializeFlatbufferPart(model, options, appended_buffers, model_size));
+
+  OwningBufferRef<uint8_t> serialized = std::move(serialized_tfl);
+  if (!appended_buffers.empty()) {
+    // Allocate buffer enough for original model and appended buffers and
+    // copy.
+    OwningBufferRef<uint8_t> final_model(model_size);
+    uint8_t* const start = final_model.Data();
+    std::memcpy(start, serialized.Data(), serialized.Size());
+    for (const auto& appended_buffer : appended_buffers) {
+      std::memcpy(start + appended_buffer.offset, appended_buffer.data.Data(),
+                  appended_buffer.data.Size());
+    }
+    serialized = std::move(final_model);
+  }
+
+  if (!VerifyFlatbuffer(serialized.Span())) {
+    LITERT_LOG(LITERT_ERROR, "Failed to verify flatbuffer");
+    return Error(kLiteRtStatusErrorInvalidFlatbuffer);
   }
 
-  if (!VerifyFlatbuffer(serialized_with_buffers->Span())) {
+  return serialized;
+}
+
+Expected<size_t> SerializeModelTo(LiteRtModelT&& model, std::ostream& out,
+                                  const SerializationOptions& options) {
+  std::vector<AppendedBuffer> appended_buffers;
+  size_t model_size;
+  LITERT_ASSIGN_OR_RETURN(
+      auto serialized_tfl,
+      SerializeFlatbufferPart(model, options, appended_buffers, model_size));
+
+  // The appended buffers lie outside of the flatbuffer, which can be verified
+  // on its own.
+  if (!VerifyFlatbuffer(serialized_tfl.Span())) {
     LITERT_LOG(LITERT_ERROR, "Failed to verify flatbuffer");
     return Error(kLiteRtStatusErrorInvalidFlatbuffer);
   }
 
-  return serialized_with_buffers;
+  out.write(reinterpret_cast<const char*>(serialized_tfl.Data()),
+            serialized_tfl.Size());
+  size_t cur_offset = serialized_tfl.Size();
+  for (const auto& appended_buffer : appended_buffers) {
+    // Alignment padding.
+    for (; cur_offset < appended_buffer.offset; ++cur_offset) {
+      out.put(0);
+    }
+    out.write(reinterpret_cast<const char*>(appended_buffer.data.Data()),
+              appended_buffer.data.Size());
+    cur_offset += appended_buffer.data.Size();
+  }
+  // Trailing padding after the last asset, if any.
+  for (; cur_offset < model_size; ++cur_offset) {
+    out.put(0);
+  }
+  if (!out) {
+    return Error(kLiteRtStatusErrorFileIO, "Failed to write the model");
+  }
+  return model_size;
 }
 
 }  // namespace litert::internal
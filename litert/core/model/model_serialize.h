@@ -15,15 +15,36 @@
 #ifndef ODML_LITERT_LITERT_CORE_MODEL_MODEL_SERIALIZE_H_
 #define ODML_LITERT_LITERT_CORE_MODEL_MODEL_SERIALIZE_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
 #include "litert/c/litert_model.h"
 #include "litert/cc/litert_buffer_ref.h"
 #include "litert/cc/litert_expected.h"
 
 namespace litert::internal {
 
+struct SerializationOptions {
+  // Alignment of the op assets (e.g. NPU bytecode) appended to the model.
+  size_t bytecode_alignment = 1;
+  // Weights of at least this many bytes are appended after the flatbuffer
+  // instead of being copied into it. 0 keeps all the weights inline.
+  size_t min_appended_weights_size = 0;
+};
+
 Expected<OwningBufferRef<uint8_t>> SerializeModel(
     LiteRtModelT&& model, size_t bytecode_alignment = 1);
 
+Expected<OwningBufferRef<uint8_t>> SerializeModel(
+    LiteRtModelT&& model, const SerializationOptions& options);
+
+// Serializes `model` to `out` and returns the number of bytes written. Unlike
+// SerializeModel, the appended weights and op assets are written directly
+// from their buffers, without assembling the whole model in memory.
+Expected<size_t> SerializeModelTo(LiteRtModelT&& model, std::ostream& out,
+                                  const SerializationOptions& options = {});
+
 }  // namespace litert::internal
 
 #endif  // ODML_LITERT_LITERT_CORE_MODEL_MODEL_SERIALIZE_H_
@@ -0,0 +1,110 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/core/model/subgraph_adjacency.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "litert/c/litert_common.h"
+#include "litert/core/model/model.h"
+
+namespace litert::internal {
+namespace {
+
+std::atomic<uint64_t> graph_edit_epoch = 1;
+
+}  // namespace
+
+void MarkGraphEdited() {
+  graph_edit_epoch.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t GraphEditEpoch() {
+  return graph_edit_epoch.load(std::memory_order_relaxed);
+}
+
+SubgraphAdjacency::SubgraphAdjacency(const LiteRtSubgraphT& subgraph)
+    : ops_(subgraph.Ops().begin(), subgraph.Ops().end()),
+      tensors_(subgraph.Tensors().begin(), subgraph.Tensors().end()) {
+  op_indices_.reserve(ops_.size());
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    op_indices_.emplace(ops_[i], i);
+  }
+  tensor_indices_.reserve(tensors_.size());
+  for (size_t i = 0; i < tensors_.size(); ++i) {
+    tensor_indices_.emplace(tensors_[i], i);
+  }
+
+  // The op tables, and the number of consumers of each tensor.
+  producers_.assign(tensors_.size(), kNone);
+  std::vector<Index> num_consumers(tensors_.size(), 0);
+  op_input_offsets_.reserve(ops_.size() + 1);
+  op_output_offsets_.reserve(ops_.size() + 1);
+  op_input_offsets_.push_back(0);
+  op_output_offsets_.push_back(0);
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    for (LiteRtTensor input : ops_[i]->Inputs()) {
+      const Index tensor = TensorIndex(input);
+      op_inputs_.push_back(tensor);
+      if (tensor != kNone) {
+        ++num_consumers[tensor];
+      }
+    }
+    for (LiteRtTensor output : ops_[i]->Outputs()) {
+      const Index tensor = TensorIndex(output);
+      op_outputs_.push_back(tensor);
+      if (tensor != kNone) {
+        producers_[tensor] = i;
+      }
+    }
+    op_input_offsets_.push_back(op_inputs_.size());
+    op_output_offsets_.push_back(op_outputs_.size());
+  }
+
+  // The consumers of each tensor, filled in execution order.
+  consumer_offsets_.resize(tensors_.size() + 1);
+  consumer_offsets_[0] = 0;
+  for (size_t i = 0; i < tensors_.size(); ++i) {
+    consumer_offsets_[i + 1] = consumer_offsets_[i] + num_consumers[i];
+  }
+  consumers_.resize(consumer_offsets_.back());
+  std::vector<Index> next_consumer(consumer_offsets_.begin(),
+                                   consumer_offsets_.end() - 1);
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    for (Index tensor : OpInputs(i)) {
+      if (tensor != kNone) {
+        consumers_[next_consumer[tensor]++] = i;
+      }
+    }
+  }
+}
+
+SubgraphAdjacency::Index SubgraphAdjacency::OpIndex(LiteRtOpConst op) const {
+  auto it = op_indices_.find(op);
+  return it == op_indices_.end() ? kNone : it->second;
+}
+
+SubgraphAdjacency::Index SubgraphAdjacency::TensorIndex(
+    LiteRtTensorConst tensor) const {
+  if (tensor == nullptr) {
+    return kNone;
+  }
+  auto it = tensor_indices_.find(tensor);
+  return it == tensor_indices_.end() ? kNone : it->second;
+}
+
+}  // namespace litert::internal
@@ -0,0 +1,132 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_CORE_MODEL_SUBGRAPH_ADJACENCY_H_
+#define ODML_LITERT_LITERT_CORE_MODEL_SUBGRAPH_ADJACENCY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+
+namespace litert::internal {
+
+// Incremented by every edit of the ops, tensors and edges of the IR done
+// through the methods of LiteRtSubgraphT, LiteRtOpT and LiteRtTensorT and the
+// graph editing functions, e.g. AttachInput(). An adjacency built at an older
+// epoch may be stale.
+void MarkGraphEdited();
+uint64_t GraphEditEpoch();
+
+// Index based adjacency of the ops and tensors of a subgraph, held in
+// compressed sparse row (CSR) tables. Passes that visit the producers and
+// consumers of many ops, e.g. partitioning, read contiguous arrays of indices
+// instead of chasing the pointers of the IR objects scattered in memory.
+//
+// Ops and tensors are identified by their position in LiteRtSubgraphT::Ops()
+// and LiteRtSubgraphT::Tensors(). kNone stands for an op or a tensor that is
+// not in the subgraph, e.g. the producer of a subgraph input, or an omitted
+// optional input.
+//
+// The adjacency is a snapshot, see LiteRtSubgraphT::Adjacency() for one kept
+// in sync with the subgraph.
+class SubgraphAdjacency {
+ public:
+  using Index = int32_t;
+  static constexpr Index kNone = -1;
+
+  explicit SubgraphAdjacency(const LiteRtSubgraphT& subgraph);
+
+  SubgraphAdjacency(const SubgraphAdjacency&) = delete;
+  SubgraphAdjacency& operator=(const SubgraphAdjacency&) = delete;
+
+  size_t NumOps() const { return ops_.size(); }
+  size_t NumTensors() const { return tensors_.size(); }
+
+  // The op or tensor at `index`.
+  LiteRtOp Op(Index index) const { return ops_[index]; }
+  LiteRtTensor Tensor(Index index) const { return tensors_[index]; }
+
+  // The index of `op` or `tensor`, kNone if it is not in the subgraph.
+  Index OpIndex(LiteRtOpConst op) const;
+  Index TensorIndex(LiteRtTensorConst tensor) const;
+
+  // The tensors of the inputs and outputs of the op at `op`, in order.
+  absl::Span<const Index> OpInputs(Index op) const {
+    return Row(op_input_offsets_, op_inputs_, op);
+  }
+  absl::Span<const Index> OpOutputs(Index op) const {
+    return Row(op_output_offsets_, op_outputs_, op);
+  }
+
+  // The op that outputs the tensor at `tensor`.
+  Index Producer(Index tensor) const { return producers_[tensor]; }
+
+  // The ops that take the tensor at `tensor` as input, in execution order,
+  // once per input they take it on.
+  absl::Span<const Index> Consumers(Index tensor) const {
+    return Row(consumer_offsets_, consumers_, tensor);
+  }
+
+  // Calls `visit` with the index of each op taking an output of the op at `op`
+  // as input, once per such input.
+  template <class Visit>
+  void ForEachSuccessor(Index op, Visit&& visit) const {
+    for (Index output : OpOutputs(op)) {
+      for (Index consumer : Consumers(output)) {
+        visit(consumer);
+      }
+    }
+  }
+
+  // Calls `visit` with the index of each op outputting an input of the op at
+  // `op`, once per such input.
+  template <class Visit>
+  void ForEachPredecessor(Index op, Visit&& visit) const {
+    for (Index input : OpInputs(op)) {
+      if (input != kNone && producers_[input] != kNone) {
+        visit(producers_[input]);
+      }
+    }
+  }
+
+ private:
+  static absl::Span<const Index> Row(const std::vector<Index>& offsets,
+                                     const std::vector<Index>& values,
+                                     Index row) {
+    return absl::MakeConstSpan(values.data() + offsets[row],
+                               offsets[row + 1] - offsets[row]);
+  }
+
+  std::vector<LiteRtOp> ops_;
+  std::vector<LiteRtTensor> tensors_;
+  absl::flat_hash_map<LiteRtOpConst, Index> op_indices_;
+  absl::flat_hash_map<LiteRtTensorConst, Index> tensor_indices_;
+
+  // Row `i` of a table spans [offsets[i], offsets[i + 1]) of its values.
+  std::vector<Index> op_input_offsets_;
+  std::vector<Index> op_inputs_;
+  std::vector<Index> op_output_offsets_;
+  std::vector<Index> op_outputs_;
+  std::vector<Index> consumer_offsets_;
+  std::vector<Index> consumers_;
+  std::vector<Index> producers_;
+};
+
+}  // namespace litert::internal
+
+#endif  // ODML_LITERT_LITERT_CORE_MODEL_SUBGRAPH_ADJACENCY_H_
@@ -0,0 +1,137 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/core/model/subgraph_adjacency.h"
+
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "litert/core/model/model.h"
+
+namespace litert::internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using Index = SubgraphAdjacency::Index;
+constexpr Index kNone = SubgraphAdjacency::kNone;
+
+// func.func @main(t0)
+//   t1 = op0 t0, t0
+//   t2 = op1 t1, <omitted>
+//   t3 = op2 t1, t2
+//   return t3
+class SubgraphAdjacencyTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 4; ++i) {
+      tensors_.push_back(&subgraph_.EmplaceTensor());
+    }
+    for (int i = 0; i < 3; ++i) {
+      ops_.push_back(&subgraph_.EmplaceOp());
+    }
+    subgraph_.Inputs().push_back(tensors_[0]);
+    subgraph_.Outputs().push_back(tensors_[3]);
+    AttachInput(tensors_[0], *ops_[0]);
+    AttachInput(tensors_[0], *ops_[0]);
+    AttachOutput(tensors_[1], *ops_[0]);
+    AttachInput(tensors_[1], *ops_[1]);
+    ops_[1]->Inputs().push_back(nullptr);
+    AttachOutput(tensors_[2], *ops_[1]);
+    AttachInput(tensors_[1], *ops_[2]);
+    AttachInput(tensors_[2], *ops_[2]);
+    AttachOutput(tensors_[3], *ops_[2]);
+  }
+
+  LiteRtSubgraphT subgraph_;
+  std::vector<LiteRtTensor> tensors_;
+  std::vector<LiteRtOp> ops_;
+};
+
+TEST_F(SubgraphAdjacencyTest, IndexesOpsAndTensors) {
+  const SubgraphAdjacency adjacency(subgraph_);
+  ASSERT_EQ(adjacency.NumOps(), 3);
+  ASSERT_EQ(adjacency.NumTensors(), 4);
+  for (Index i = 0; i < 3; ++i) {
+    EXPECT_EQ(adjacency.Op(i), ops_[i]);
+    EXPECT_EQ(adjacency.OpIndex(ops_[i]), i);
+  }
+  for (Index i = 0; i < 4; ++i) {
+    EXPECT_EQ(adjacency.Tensor(i), tensors_[i]);
+    EXPECT_EQ(adjacency.TensorIndex(tensors_[i]), i);
+  }
+
+  LiteRtOpT other_op;
+  LiteRtTensorT other_tensor;
+  EXPECT_EQ(adjacency.OpIndex(&other_op), kNone);
+  EXPECT_EQ(adjacency.TensorIndex(&other_tensor), kNone);
+  EXPECT_EQ(adjacency.TensorIndex(nullptr), kNone);
+}
+
+TEST_F(SubgraphAdjacencyTest, HoldsProducersAndConsumers) {
+  const SubgraphAdjacency adjacency(subgraph_);
+
+  EXPECT_THAT(adjacency.OpInputs(0), ElementsAre(0, 0));
+  EXPECT_THAT(adjacency.OpInputs(1), ElementsAre(1, kNone));
+  EXPECT_THAT(adjacency.OpInputs(2), ElementsAre(1, 2));
+  EXPECT_THAT(adjacency.OpOutputs(0), ElementsAre(1));
+  EXPECT_THAT(adjacency.OpOutputs(2), ElementsAre(3));
+
+  EXPECT_EQ(adjacency.Producer(0), kNone);
+  EXPECT_EQ(adjacency.Producer(1), 0);
+  EXPECT_EQ(adjacency.Producer(3), 2);
+  EXPECT_THAT(adjacency.Consumers(0), ElementsAre(0, 0));
+  EXPECT_THAT(adjacency.Consumers(1), ElementsAre(1, 2));
+  EXPECT_THAT(adjacency.Consumers(3), IsEmpty());
+}
+
+TEST_F(SubgraphAdjacencyTest, VisitsSuccessorsAndPredecessors) {
+  const SubgraphAdjacency adjacency(subgraph_);
+
+  std::vector<Index> successors;
+  adjacency.ForEachSuccessor(0, [&](Index op) { successors.push_back(op); });
+  EXPECT_THAT(successors, ElementsAre(1, 2));
+
+  std::vector<Index> predecessors;
+  adjacency.ForEachPredecessor(2,
+                               [&](Index op) { predecessors.push_back(op); });
+  EXPECT_THAT(predecessors, ElementsAre(0, 1));
+
+  predecessors.clear();
+  adjacency.ForEachPredecessor(0,
+                               [&](Index op) { predecessors.push_back(op); });
+  EXPECT_THAT(predecessors, IsEmpty());
+}
+
+TEST_F(SubgraphAdjacencyTest, RebuildsAfterEdits) {
+  EXPECT_THAT(subgraph_.Adjacency().Consumers(3), IsEmpty());
+
+  // Edits through the graph editing functions are tracked.
+  auto& op = subgraph_.EmplaceOp();
+  AttachInput(tensors_[3], op);
+  EXPECT_EQ(subgraph_.Adjacency().NumOps(), 4);
+  EXPECT_THAT(subgraph_.Adjacency().Consumers(3), ElementsAre(3));
+
+  Drop(op);
+  EXPECT_THAT(subgraph_.Adjacency().Consumers(3), IsEmpty());
+
+  // Direct edits of the vectors are not.
+  op.Inputs().push_back(tensors_[2]);
+  subgraph_.InvalidateAdjacency();
+  EXPECT_THAT(subgraph_.Adjacency().Consumers(2), ElementsAre(2, 3));
+}
+
+}  // namespace
+}  // namespace litert::internal
@@ -58,11 +58,19 @@ struct LiteRtOptionsT {
   // Note: Changing a default value does not impact the version.
   LiteRtApiVersion version = {.major = 1, .minor = 0, .patch = 0};
   LiteRtHwAcceleratorSet hardware_accelerators = kLiteRtHwAcceleratorNone;
+  // If true, the compiled model runs on the accelerators the mini-benchmark
+  // selected for the model on the device, and on `hardware_accelerators`
+  // until it has.
+  bool auto_hardware_accelerators = false;
   LiteRtOpaqueOptions options = nullptr;
   std::vector<CustomOpOption> custom_op_options;
   std::vector<LiteRtExternalTensorBinding> external_tensor_bindings;
   // Non-owning pointer used to expose the runtime's WeightLoader to delegates.
   weight_loader::WeightLoader* weight_loader = nullptr;
+  // Identifies the model in the compilation cache of the environment. Set by
+  // the compiled model while its accelerators create their delegates, empty
+  // otherwise.
+  std::string model_cache_key;
 };
 
 #endif  // ODML_LITERT_LITERT_CORE_COMPILATION_OPTIONS_H_
@@ -316,6 +316,26 @@ Expected<FlatbufferWrapper::Ptr> FlatbufferWrapper::CreateFromTflFile(
   return FlatbufferWrapper::CreateFromAllocation(std::move(allocation));
 }
 
+Expected<FlatbufferWrapper::Ptr> FlatbufferWrapper::CreateFromFileDescriptor(
+    int fd, size_t offset, size_t length) {
+  if (fd < 0 || length == 0) {
+    return Error(kLiteRtStatusErrorInvalidArgument,
+                 "Invalid file descriptor or length");
+  }
+  if (!tflite::MMAPAllocation::IsSupported()) {
+    return Error(kLiteRtStatusErrorUnsupported,
+                 "Memory mapping is not supported on this platform");
+  }
+  auto allocation = std::make_unique<tflite::MMAPAllocation>(
+      fd, offset, length, tflite::DefaultErrorReporter(),
+      /*map_private=*/false);
+  if (!allocation->valid()) {
+    return Error(kLiteRtStatusErrorFileIO,
+                 "Failed to map the model from the file descriptor");
+  }
+  return FlatbufferWrapper::CreateFromAllocation(std::move(allocation));
+}
+
 OwningBufferRef<uint8_t> SerializeFlatbuffer(const TflModel& tfl_model) {
   flatbuffers::FlatBufferBuilder b;
   auto model_offset = tflite::Model::Pack(b, &tfl_model);
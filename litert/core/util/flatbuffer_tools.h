@@ -15,6 +15,7 @@
 #ifndef ODML_LITERT_LITERT_CORE_UTIL_FLATBUFFER_TOOLS_H_
 #define ODML_LITERT_LITERT_CORE_UTIL_FLATBUFFER_TOOLS_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <memory>
@@ -262,6 +263,13 @@ class FlatbufferWrapper {
   static Expected<Ptr> CreateFromTflFile(absl::string_view path,
                                          bool allow_modifications = false);
 
+  // Memory maps `length` bytes of `fd` starting at `offset`, e.g. a model
+  // stored inside a larger archive. The mapping is read-only and shared, so
+  // pages are only read from the file when accessed. `fd` is duplicated and
+  // may be closed by the caller.
+  static Expected<Ptr> CreateFromFileDescriptor(int fd, size_t offset,
+                                                size_t length);
+
   // The caller must ensure that the buffer remains valid for the lifetime of
   // the model.
   static Expected<Ptr> CreateFromBuffer(BufferRef<uint8_t> buffer);
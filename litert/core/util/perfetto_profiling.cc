@@ -14,6 +14,207 @@
 
 #include "litert/core/util/perfetto_profiling.h"
 
+#include <cstdint>
+
+#ifdef LITERT_PERFETTO_ENABLED
+#include <functional>
+#include <mutex>  // NOLINT(build/c++11)
+#include <string_view>
+#include <unordered_set>
+
+#include "perfetto/tracing.h"
+
+PERFETTO_DEFINE_CATEGORIES_IN_NAMESPACE(
+    litert::internal::tracing,
+    perfetto::Category("litert").SetDescription(
+        "The runs of the LiteRT compiled models on the CPU"),
+    perfetto::Category("litert.dispatch")
+        .SetDescription(
+            "The Dispatch API calls and the submissions to the accelerators"),
+    perfetto::Category("litert.device")
+        .SetDescription("The work executed by the accelerators"),
+    perfetto::Category("litert.buffer")
+        .SetDescription("The occupancy of the LiteRT buffer pools"));
+
+PERFETTO_TRACK_EVENT_STATIC_STORAGE_IN_NAMESPACE(litert::internal::tracing);
+#endif  // LITERT_PERFETTO_ENABLED
+
 namespace litert::internal {
+
+#ifdef LITERT_PERFETTO_ENABLED
+namespace {
+
+PERFETTO_USE_CATEGORIES_FROM_NAMESPACE(tracing);
+
+constexpr char kRuntimeCategory[] = "litert";
+constexpr char kDispatchCategory[] = "litert.dispatch";
+constexpr char kDeviceCategory[] = "litert.device";
+constexpr char kBufferCategory[] = "litert.buffer";
+
+// Runs the statement with `kCategory` set to the name of `category`, which the
+// track event macros need at compile time.
+#define LITERT_WITH_PERFETTO_CATEGORY(category, ...)                           \
+  switch (category) {                                                          \
+    case PerfettoCategory::kRuntime: {                                         \
+      constexpr const char* kCategory = kRuntimeCategory;                      \
+      __VA_ARGS__;                                                             \
+      break;                                                                   \
+    }                                                                          \
+    case PerfettoCategory::kDispatch: {                                        \
+      constexpr const char* kCategory = kDispatchCategory;                     \
+      __VA_ARGS__;                                                             \
+      break;                                                                   \
+    }                                                                          \
+    case PerfettoCategory::kDevice: {                                          \
+      constexpr const char* kCategory = kDeviceCategory;                       \
+      __VA_ARGS__;                                                             \
+      break;                                                                   \
+    }                                                                          \
+    case PerfettoCategory::kBuffer: {                                          \
+      constexpr const char* kCategory = kBufferCategory;                       \
+      __VA_ARGS__;                                                             \
+      break;                                                                   \
+    }                                                                          \
+  }
+
+// Returns the track `track_name` of the slices `slice_id`, which is named the
+// first time.
+perfetto::Track GetNamedTrack(const char* track_name, uint64_t slice_id) {
+  const uint64_t track_name_hash = std::hash<std::string_view>()(track_name);
+  const perfetto::Track track(track_name_hash ^ (slice_id * 0x9e3779b97f4a7c15),
+                              perfetto::ProcessTrack::Current());
+  static std::mutex mutex;
+  static auto* named_tracks = new std::unordered_set<uint64_t>();
+  std::lock_guard<std::mutex> lock(mutex);
+  if (named_tracks->insert(track.uuid).second) {
+    auto descriptor = track.Serialize();
+    descriptor.set_name(track_name);
+    tracing::TrackEvent::SetTrackDescriptor(track, descriptor);
+  }
+  return track;
+}
+
+}  // namespace
+
+void InitializePerfetto() {
+  static std::once_flag once;
+  std::call_once(once, [] {
+    perfetto::TracingInitArgs args;
+    args.backends = perfetto::kSystemBackend;
+    perfetto::Tracing::Initialize(args);
+    tracing::TrackEvent::Register();
+  });
+}
+
+void BeginPerfettoSlice(PerfettoCategory category, const char* event_name,
+                        uint64_t flow_id) {
+  LITERT_WITH_PERFETTO_CATEGORY(category, {
+    if (flow_id != 0) {
+      TRACE_EVENT_BEGIN(kCategory, perfetto::StaticString(event_name),
+                        perfetto::Flow::ProcessScoped(flow_id));
+    } else {
+      TRACE_EVENT_BEGIN(kCategory, perfetto::StaticString(event_name));
+    }
+  });
+}
+
+void EndPerfettoSlice(PerfettoCategory category) {
+  LITERT_WITH_PERFETTO_CATEGORY(category, TRACE_EVENT_END(kCategory));
+}
+
+void BeginPerfettoDeviceSlice(const char* track_name, uint64_t slice_id,
+                              const char* event_name, uint64_t flow_id) {
+  if (!TRACE_EVENT_CATEGORY_ENABLED(kDeviceCategory)) {
+    return;
+  }
+  const perfetto::Track track = GetNamedTrack(track_name, slice_id);
+  if (flow_id != 0) {
+    TRACE_EVENT_BEGIN(kDeviceCategory, perfetto::StaticString(event_name),
+                      track, perfetto::TerminatingFlow::ProcessScoped(flow_id));
+  } else {
+    TRACE_EVENT_BEGIN(kDeviceCategory, perfetto::StaticString(event_name),
+                      track);
+  }
+}
+
+void EndPerfettoDeviceSlice(const char* track_name, uint64_t slice_id) {
+  if (!TRACE_EVENT_CATEGORY_ENABLED(kDeviceCategory)) {
+    return;
+  }
+  TRACE_EVENT_END(kDeviceCategory, GetNamedTrack(track_name, slice_id));
+}
+
+void BeginPerfettoAsyncSlice(PerfettoCategory category, const char* event_name,
+                             uint64_t event_id) {
+  LITERT_WITH_PERFETTO_CATEGORY(
+      category, TRACE_EVENT_BEGIN(kCategory, perfetto::StaticString(event_name),
+                                  perfetto::Track(event_id)));
+}
+
+void EndPerfettoAsyncSlice(PerfettoCategory category, uint64_t event_id) {
+  LITERT_WITH_PERFETTO_CATEGORY(
+      category, TRACE_EVENT_END(kCategory, perfetto::Track(event_id)));
+}
+
+void TracePerfettoInstant(PerfettoCategory category, const char* event_name) {
+  LITERT_WITH_PERFETTO_CATEGORY(
+      category,
+      TRACE_EVENT_INSTANT(kCategory, perfetto::StaticString(event_name)));
+}
+
+void SetPerfettoCounter(PerfettoCategory category, const char* counter_name,
+                        int64_t value) {
+  LITERT_WITH_PERFETTO_CATEGORY(
+      category,
+      TRACE_COUNTER(kCategory, perfetto::CounterTrack(counter_name), value));
+}
+
+void TracePerfettoSlice(const char* track_name, const char* event_name,
+                        int64_t start_ns, int64_t end_ns) {
+  if (!TRACE_EVENT_CATEGORY_ENABLED(kRuntimeCategory)) {
+    return;
+  }
+  const perfetto::Track track = GetNamedTrack(track_name, /*slice_id=*/0);
+  TRACE_EVENT_BEGIN(
+      kRuntimeCategory, perfetto::DynamicString(event_name), track,
+      perfetto::TraceTimestamp{
+          perfetto::protos::pbzero::BUILTIN_CLOCK_MONOTONIC,
+          static_cast<uint64_t>(start_ns)});
+  TRACE_EVENT_END(kRuntimeCategory, track,
+                  perfetto::TraceTimestamp{
+                      perfetto::protos::pbzero::BUILTIN_CLOCK_MONOTONIC,
+                      static_cast<uint64_t>(end_ns)});
+}
+
+#undef LITERT_WITH_PERFETTO_CATEGORY
+
+#else  // LITERT_PERFETTO_ENABLED
+
 void InitializePerfetto() {}
+
+void BeginPerfettoSlice(PerfettoCategory category, const char* event_name,
+                        uint64_t flow_id) {}
+
+void EndPerfettoSlice(PerfettoCategory category) {}
+
+void BeginPerfettoDeviceSlice(const char* track_name, uint64_t slice_id,
+                              const char* event_name, uint64_t flow_id) {}
+
+void EndPerfettoDeviceSlice(const char* track_name, uint64_t slice_id) {}
+
+void BeginPerfettoAsyncSlice(PerfettoCategory category, const char* event_name,
+                             uint64_t event_id) {}
+
+void EndPerfettoAsyncSlice(PerfettoCategory category, uint64_t event_id) {}
+
+void TracePerfettoInstant(PerfettoCategory category, const char* event_name) {}
+
+void SetPerfettoCounter(PerfettoCategory category, const char* counter_name,
+                        int64_t value) {}
+
+void TracePerfettoSlice(const char* track_name, const char* event_name,
+                        int64_t start_ns, int64_t end_ns) {}
+
+#endif  // LITERT_PERFETTO_ENABLED
+
 }  // namespace litert::internal
@@ -15,13 +15,182 @@
 #ifndef THIRD_PARTY_ODML_LITERT_CORE_UTIL_PERFETTO_PROFILING_H_
 #define THIRD_PARTY_ODML_LITERT_CORE_UTIL_PERFETTO_PROFILING_H_
 
+#include <cstdint>
+
+// Perfetto track events of LiteRT, compiled in with
+// --define=LITERT_PERFETTO_PROFILING=1. The macros compile to nothing
+// otherwise.
+//
+// The event names, track names and counter names must be string literals.
+
+#define LITERT_PERFETTO_CONCAT_INNER(a, b) a##b
+#define LITERT_PERFETTO_CONCAT(a, b) LITERT_PERFETTO_CONCAT_INNER(a, b)
+
+#ifdef LITERT_PERFETTO_ENABLED
+
+// A slice of the runtime category on the calling thread, until the end of the
+// scope.
+#define LITERT_PERFETTO_TRACE_EVENT(event_name) \
+  LITERT_PERFETTO_TRACE_EVENT_IN(kRuntime, event_name)
+
+// A slice of the PerfettoCategory `category` on the calling thread, until the
+// end of the scope.
+#define LITERT_PERFETTO_TRACE_EVENT_IN(category, event_name) \
+  LITERT_PERFETTO_TRACE_EVENT_WITH_FLOW(category, event_name, 0)
+
+// A slice that begins the flow `flow_id`, e.g. the CPU side of a submission
+// to an accelerator, which the device slice of the work ends.
+#define LITERT_PERFETTO_TRACE_EVENT_WITH_FLOW(category, event_name, flow_id) \
+  ::litert::internal::ScopedPerfettoSlice LITERT_PERFETTO_CONCAT(            \
+      litert_perfetto_slice_, __LINE__)(                                     \
+      ::litert::internal::PerfettoCategory::category, event_name, flow_id)
+
+// A slice of device work on the track `track_name`, e.g. "NPU", until the end
+// of the scope. See BeginPerfettoDeviceSlice().
+#define LITERT_PERFETTO_TRACE_DEVICE_EVENT(track_name, slice_id, event_name, \
+                                           flow_id)                          \
+  ::litert::internal::ScopedPerfettoDeviceSlice LITERT_PERFETTO_CONCAT(      \
+      litert_perfetto_device_slice_, __LINE__)(track_name, slice_id,         \
+                                               event_name, flow_id)
+
+// A slice of device work that ends elsewhere, e.g. in a completion callback.
+#define LITERT_PERFETTO_TRACE_DEVICE_EVENT_BEGIN(track_name, slice_id, \
+                                                 event_name, flow_id)  \
+  ::litert::internal::BeginPerfettoDeviceSlice(track_name, slice_id,   \
+                                               event_name, flow_id)
+
+#define LITERT_PERFETTO_TRACE_DEVICE_EVENT_END(track_name, slice_id) \
+  ::litert::internal::EndPerfettoDeviceSlice(track_name, slice_id)
+
+#define LITERT_PERFETTO_TRACE_EVENT_INSTANT(event_name) \
+  ::litert::internal::TracePerfettoInstant(             \
+      ::litert::internal::PerfettoCategory::kRuntime, event_name)
+
+#define LITERT_PERFETTO_TRACE_EVENT_ASYNC_START(event_name, event_id) \
+  ::litert::internal::BeginPerfettoAsyncSlice(                        \
+      ::litert::internal::PerfettoCategory::kRuntime, event_name, event_id)
+
+#define LITERT_PERFETTO_TRACE_EVENT_ASYNC_END(event_id) \
+  ::litert::internal::EndPerfettoAsyncSlice(            \
+      ::litert::internal::PerfettoCategory::kRuntime, event_id)
+
+// Sets the counter track `counter_name` of the PerfettoCategory `category`.
+#define LITERT_PERFETTO_TRACE_COUNTER(category, counter_name, value) \
+  ::litert::internal::SetPerfettoCounter(                            \
+      ::litert::internal::PerfettoCategory::category, counter_name, value)
+
+#else  // LITERT_PERFETTO_ENABLED
+
 #define LITERT_PERFETTO_TRACE_EVENT(event_name)
+#define LITERT_PERFETTO_TRACE_EVENT_IN(category, event_name)
+#define LITERT_PERFETTO_TRACE_EVENT_WITH_FLOW(category, event_name, flow_id)
+#define LITERT_PERFETTO_TRACE_DEVICE_EVENT(track_name, slice_id, event_name, \
+                                           flow_id)
+#define LITERT_PERFETTO_TRACE_DEVICE_EVENT_BEGIN(track_name, slice_id, \
+                                                 event_name, flow_id)
+#define LITERT_PERFETTO_TRACE_DEVICE_EVENT_END(track_name, slice_id)
 #define LITERT_PERFETTO_TRACE_EVENT_INSTANT(event_name)
 #define LITERT_PERFETTO_TRACE_EVENT_ASYNC_START(event_name, event_id)
 #define LITERT_PERFETTO_TRACE_EVENT_ASYNC_END(event_id)
+#define LITERT_PERFETTO_TRACE_COUNTER(category, counter_name, value)
+
+#endif  // LITERT_PERFETTO_ENABLED
 
 namespace litert::internal {
+
+// The categories of the LiteRT track events, shared by the runtime, the
+// dispatch delegate and the vendor dispatch libraries so that a trace config
+// selects the same layer everywhere:
+//   litert           the runs of the compiled models on the CPU.
+//   litert.dispatch  the Dispatch API calls and the submissions to the
+//                    accelerators.
+//   litert.device    the work executed by the accelerators, on their own
+//                    tracks.
+//   litert.buffer    the occupancy of the buffer pools.
+enum class PerfettoCategory {
+  kRuntime,
+  kDispatch,
+  kDevice,
+  kBuffer,
+};
+
+// Registers LiteRT to the system tracing service. Events are only recorded
+// once it was called, by the process or by the library emitting them.
 void InitializePerfetto();
+
+// Returns the id of the flows of `pointer`, e.g. a dispatch invocation
+// context, which links its submissions to the device work.
+inline uint64_t GetPerfettoFlowId(const void* pointer) {
+  return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+}
+
+// Slices on the track of the calling thread, which must nest. A `flow_id`
+// other than 0 begins a flow from the slice.
+void BeginPerfettoSlice(PerfettoCategory category, const char* event_name,
+                        uint64_t flow_id);
+void EndPerfettoSlice(PerfettoCategory category);
+
+// Slices of device work, on the track named `track_name`. The work of the
+// slices with the same `slice_id` must nest, and slices with different ids
+// may overlap, e.g. the requests in flight on an accelerator. The slice may
+// end on another thread, e.g. in a completion callback. A `flow_id` other
+// than 0 ends the flow of the submission at the slice.
+void BeginPerfettoDeviceSlice(const char* track_name, uint64_t slice_id,
+                              const char* event_name, uint64_t flow_id);
+void EndPerfettoDeviceSlice(const char* track_name, uint64_t slice_id);
+
+// Async slices on the track `event_id`.
+void BeginPerfettoAsyncSlice(PerfettoCategory category, const char* event_name,
+                             uint64_t event_id);
+void EndPerfettoAsyncSlice(PerfettoCategory category, uint64_t event_id);
+
+void TracePerfettoInstant(PerfettoCategory category, const char* event_name);
+
+void SetPerfettoCounter(PerfettoCategory category, const char* counter_name,
+                        int64_t value);
+
+// Records a slice named `event_name` on the track `track_name`, between two
+// timestamps of the steady clock in nanoseconds. Used to export timings that
+// were measured elsewhere, e.g. GPU timestamps placed on the CPU timeline.
+void TracePerfettoSlice(const char* track_name, const char* event_name,
+                        int64_t start_ns, int64_t end_ns);
+
+class ScopedPerfettoSlice {
+ public:
+  ScopedPerfettoSlice(PerfettoCategory category, const char* event_name,
+                      uint64_t flow_id)
+      : category_(category) {
+    BeginPerfettoSlice(category, event_name, flow_id);
+  }
+  ~ScopedPerfettoSlice() { EndPerfettoSlice(category_); }
+
+  ScopedPerfettoSlice(const ScopedPerfettoSlice&) = delete;
+  ScopedPerfettoSlice& operator=(const ScopedPerfettoSlice&) = delete;
+
+ private:
+  PerfettoCategory category_;
+};
+
+class ScopedPerfettoDeviceSlice {
+ public:
+  ScopedPerfettoDeviceSlice(const char* track_name, uint64_t slice_id,
+                            const char* event_name, uint64_t flow_id)
+      : track_name_(track_name), slice_id_(slice_id) {
+    BeginPerfettoDeviceSlice(track_name, slice_id, event_name, flow_id);
+  }
+  ~ScopedPerfettoDeviceSlice() {
+    EndPerfettoDeviceSlice(track_name_, slice_id_);
+  }
+
+  ScopedPerfettoDeviceSlice(const ScopedPerfettoDeviceSlice&) = delete;
+  ScopedPerfettoDeviceSlice& operator=(const ScopedPerfettoDeviceSlice&) =
+      delete;
+
+ private:
+  const char* track_name_;
+  uint64_t slice_id_;
+};
+
 }  // namespace litert::internal
 
 #endif  // THIRD_PARTY_ODML_LITERT_CORE_UTIL_PERFETTO_PROFILING_H_
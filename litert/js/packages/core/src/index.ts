@@ -26,6 +26,8 @@ export * from './gpu_signature_runner';
 export {type CpuTensorReference, type ErrorReporter} from './wasm_binding_types';
 export {getGlobalLiteRt, getGlobalLiteRtPromise, LiteRtNotLoadedError} from './global_litert';
 export * from './load_litert';
+export * from './litert_worker';
+export {startLiteRtWorker} from './worker_scope';
 import {registerCopyFunctions} from './tensor_copy_functions';
 
 registerCopyFunctions();
@@ -16,7 +16,7 @@
 
 import '@tensorflow/tfjs-backend-webgpu'; // DO NOT REMOVE: Requried for side effects.
 
-import {CompiledModel, ErrorReporter, getAdapterInfo, getGlobalLiteRt, getGlobalLiteRtPromise, getWebGpuDevice, isWebGPUSupported, LiteRt, loadAndCompile, loadLiteRt, type LoadLiteRtOptions, setErrorReporter, setWebGpuDevice, Tensor, TensorTypeError, unloadLiteRt} from '@litertjs/core';
+import {CompiledModel, createSharedTypedArray, ErrorReporter, getAdapterInfo, getGlobalLiteRt, getGlobalLiteRtPromise, getWebGpuDevice, isWebGPUSupported, LiteRt, LiteRtWorker, loadAndCompile, loadLiteRt, type LoadLiteRtOptions, setErrorReporter, setWebGpuDevice, startLiteRtWorker, Tensor, TensorTypeError, unloadLiteRt, WorkerTensor} from '@litertjs/core';
 import {litertToTfjs, runWithTfjsTensors, TensorConversionError, tfjsToLitert} from '@litertjs/tfjs-interop';
 import {type WebGPUBackend} from '@tensorflow/tfjs-backend-webgpu';
 import * as tf from '@tensorflow/tfjs-core';
@@ -931,6 +931,98 @@ describe('LiteRt', () => {
     });
   });
 
+  describe('LiteRtWorker', () => {
+    // The worker end runs on this thread, over a MessageChannel, and shares
+    // the already loaded global LiteRt.
+    let channel: MessageChannel;
+    let stopWorker: () => void;
+    let liteRtWorker: LiteRtWorker;
+
+    const a = new Float32Array(100).map((_, i) => i);
+    const b = new Float32Array(100).fill(1);
+    const expected = new Float32Array(100).map((_, i) => i + 1);
+
+    beforeAll(async () => {
+      channel = new MessageChannel();
+      stopWorker = startLiteRtWorker(channel.port2);
+      liteRtWorker = await LiteRtWorker.create(
+          channel.port1, '/wasm/litert_wasm_internal.js');
+    });
+
+    afterAll(() => {
+      liteRtWorker.delete();
+      stopWorker();
+      channel.port1.close();
+      channel.port2.close();
+    });
+
+    for (const accelerator of ['webgpu', 'wasm'] as const) {
+      describe(accelerator, () => {
+        it('reports the model signature', async () => {
+          const model = await liteRtWorker.loadAndCompile(
+              '/testdata/add_10x10.tflite', {accelerator});
+          expect(model.accelerator).toEqual(accelerator);
+          expect(model.getInputDetails().map(({name}) => name)).toEqual([
+            'a', 'b'
+          ]);
+          expect(model.getOutputDetails()[0].shape).toEqual([10, 10]);
+          model.delete();
+        });
+
+        it('runs a model by input name', async () => {
+          const model = await liteRtWorker.loadAndCompile(
+              '/testdata/add_10x10.tflite', {accelerator});
+          const outputs = await model.run({a, b});
+          expect(outputs['Identity'].data).toEqual(expected);
+          expect(outputs['Identity'].dimensions).toEqual([10, 10]);
+          model.delete();
+        });
+
+        it('batches runs made in the same task', async () => {
+          const model = await liteRtWorker.loadAndCompile(
+              '/testdata/add_10x10.tflite', {accelerator});
+          const results = await Promise.all(
+              [1, 2, 3].map(scale => model.run([a, b.map(x => x * scale)])));
+          for (let i = 0; i < results.length; ++i) {
+            expect(results[i][0].data).toEqual(a.map(x => x + i + 1));
+          }
+          model.delete();
+        });
+
+        it('writes outputs into the given arrays', async () => {
+          const model = await liteRtWorker.loadAndCompile(
+              '/testdata/add_10x10.tflite', {accelerator});
+          const output = crossOriginIsolated ?
+              createSharedTypedArray('float32', 100) :
+              new Float32Array(100);
+          const [result] = await model.run([a, b], {outputs: [output]});
+          expect(result.data).toBe(output);
+          expect(output).toEqual(expected);
+          model.delete();
+        });
+
+        it('chains runs with outputs kept in the worker', async () => {
+          const model = await liteRtWorker.loadAndCompile(
+              '/testdata/add_10x10.tflite', {accelerator});
+          const [sum] = await model.run([a, b], {keepOutputs: true});
+          expect(sum).toBeInstanceOf(WorkerTensor);
+          const [result] = await model.run([sum, b]);
+          expect(result.data).toEqual(a.map(x => x + 2));
+          sum.delete();
+          await expectAsync(model.run([sum, b])).toBeRejected();
+          model.delete();
+        });
+      });
+    }
+
+    it('rejects a run of a deleted model', async () => {
+      const model = await liteRtWorker.loadAndCompile(
+          '/testdata/add_10x10.tflite', {accelerator: 'wasm'});
+      model.delete();
+      await expectAsync(model.run([a, b])).toBeRejectedWithError(/deleted/);
+    });
+  });
+
   describe('getGlobalLiteRtPromise', () => {
     afterEach(async () => {
       await resetLiteRt();
@@ -0,0 +1,483 @@
+/**
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import {Accelerator, DType, DTYPE_TO_ARRAY_TYPE, TypedArray} from './constants';
+import type {CompileOptions} from './litert_web';
+import type {LoadLiteRtOptions} from './load_litert';
+import type {MessageEndpoint, ModelMessage, RunTask, RunTaskResult, SignatureMessage, TensorDataMessage, TensorHandleMessage, WorkerRequest, WorkerResponse} from './worker_protocol';
+
+export type {MessageEndpoint} from './worker_protocol';
+
+/**
+ * Tensor data sent to or received from a LiteRtWorker.
+ */
+export interface WorkerTensorData {
+  dtype: DType;
+  dimensions: number[];
+  data: TypedArray;
+}
+
+/**
+ * An input of a WorkerCompiledModel run. A bare TypedArray takes the shape of
+ * the input it is given for.
+ */
+export type WorkerInput = TypedArray|WorkerTensorData|WorkerTensor;
+
+/**
+ * Options for WorkerCompiledModel.run().
+ */
+export interface WorkerRunOptions {
+  /** The signature to run. Defaults to the primary signature. */
+  signature?: string;
+  /**
+   * Arrays to write the outputs to, in output order or by output name. Back
+   * them with SharedArrayBuffers (see `createSharedTypedArray`) to have the
+   * worker write the results directly into them.
+   */
+  outputs?: TypedArray[]|Record<string, TypedArray>;
+  /**
+   * Keep the outputs in the worker, on the model's accelerator, and return
+   * WorkerTensor handles to them. Use this to pass outputs to another run
+   * without copying them, e.g. to chain WebGPU models without reading their
+   * GPU buffers back.
+   */
+  keepOutputs?: boolean;
+}
+
+// The requests that are answered with a 'result' response.
+type RequestMessage = {
+  kind: 'init',
+  wasmPath: string,
+  options?: LoadLiteRtOptions,
+}|{
+  kind: 'load',
+  model: string|Uint8Array,
+  accelerator: Accelerator,
+};
+
+function isShared(array: TypedArray): boolean {
+  return typeof SharedArrayBuffer !== 'undefined' &&
+      array.buffer instanceof SharedArrayBuffer;
+}
+
+function resolveUrl(url: string|URL): string {
+  const base = (globalThis as {location?: {href: string}}).location?.href;
+  return base ? new URL(url, base).href : String(url);
+}
+
+/**
+ * Returns a TypedArray backed by a SharedArrayBuffer, which a LiteRtWorker
+ * reads inputs from and writes outputs to without copying it between threads.
+ *
+ * SharedArrayBuffer is only available on cross-origin isolated pages.
+ */
+export function createSharedTypedArray(dtype: DType, length: number):
+    TypedArray {
+  if (typeof SharedArrayBuffer === 'undefined') {
+    throw new Error(
+        'SharedArrayBuffer is not available. The page must be cross-origin ' +
+        'isolated to share memory with a worker.');
+  }
+  const arrayType = DTYPE_TO_ARRAY_TYPE[dtype];
+  return new arrayType(
+      new SharedArrayBuffer(length * arrayType.BYTES_PER_ELEMENT) as
+      unknown as ArrayBuffer);
+}
+
+/**
+ * A tensor kept in a LiteRtWorker. It stays on the accelerator of the model
+ * that output it until it is deleted.
+ */
+export class WorkerTensor {
+  private deletedInternal = false;
+
+  constructor(
+      private readonly worker: LiteRtWorker, readonly dtype: DType,
+      readonly dimensions: number[], readonly handle: number) {}
+
+  get deleted(): boolean {
+    return this.deletedInternal;
+  }
+
+  delete() {
+    if (this.deletedInternal) {
+      return;
+    }
+    this.deletedInternal = true;
+    this.worker.deleteTensor(this.handle);
+  }
+}
+
+/**
+ * A model loaded and compiled in a LiteRtWorker.
+ */
+export class WorkerCompiledModel {
+  deleted = false;
+
+  constructor(
+      private readonly worker: LiteRtWorker,
+      private readonly modelMessage: ModelMessage) {}
+
+  get accelerator(): Accelerator {
+    return this.modelMessage.accelerator;
+  }
+
+  /**
+   * The names of the signatures of the model.
+   */
+  get signatures(): string[] {
+    return Object.keys(this.modelMessage.signatures).filter(name => name);
+  }
+
+  private getSignature(name = ''): SignatureMessage {
+    const signature = this.modelMessage.signatures[name];
+    if (!signature) {
+      throw new Error(`Signature '${
+          name}' not found in the model. Available signatures: ${
+          this.signatures.join(', ')}`);
+    }
+    return signature;
+  }
+
+  /**
+   * Returns the input details for the given signature, or the primary
+   * signature.
+   */
+  getInputDetails(signature?: string) {
+    return this.getSignature(signature).inputs;
+  }
+
+  /**
+   * Returns the output details for the given signature, or the primary
+   * signature.
+   */
+  getOutputDetails(signature?: string) {
+    return this.getSignature(signature).outputs;
+  }
+
+  /**
+   * Runs the model in the worker. Runs made in the same task are sent to the
+   * worker in one message and answered in one message.
+   *
+   * Inputs are copied to the worker unless they are backed by a
+   * SharedArrayBuffer or are WorkerTensors.
+   */
+  run(input: WorkerInput[], options?: WorkerRunOptions&{keepOutputs?: false}):
+      Promise<WorkerTensorData[]>;
+  run(input: Record<string, WorkerInput>,
+      options?: WorkerRunOptions&{keepOutputs?: false}):
+      Promise<Record<string, WorkerTensorData>>;
+  run(input: WorkerInput[], options: WorkerRunOptions&{keepOutputs: true}):
+      Promise<WorkerTensor[]>;
+  run(input: Record<string, WorkerInput>,
+      options: WorkerRunOptions&{keepOutputs: true}):
+      Promise<Record<string, WorkerTensor>>;
+  run(input: WorkerInput[]|Record<string, WorkerInput>,
+      options?: WorkerRunOptions):
+      Promise<Array<WorkerTensorData|WorkerTensor>|
+              Record<string, WorkerTensorData|WorkerTensor>>;
+  async run(
+      input: WorkerInput[]|Record<string, WorkerInput>,
+      options: WorkerRunOptions = {}):
+      Promise<Array<WorkerTensorData|WorkerTensor>|
+              Record<string, WorkerTensorData|WorkerTensor>> {
+    if (this.deleted) {
+      throw new Error('Model has been deleted. Please reload the model.');
+    }
+    const signature = this.getSignature(options.signature);
+
+    let inputArray: WorkerInput[];
+    if (Array.isArray(input)) {
+      if (input.length !== signature.inputs.length) {
+        throw new Error(
+            `run() called with ${input.length} ` +
+            `inputs, but signature expects ${signature.inputs.length} inputs`);
+      }
+      inputArray = input;
+    } else {
+      inputArray = signature.inputs.map(({name}) => {
+        const tensor = input[name];
+        if (!tensor) {
+          throw new Error(`Expected input tensor with name '${
+              name}', but none was provided.`);
+        }
+        return tensor;
+      });
+    }
+
+    const inputs = inputArray.map((tensor, i): RunTask['inputs'][number] => {
+      if (tensor instanceof WorkerTensor) {
+        if (tensor.deleted) {
+          throw new Error(`Input ${i} has been deleted.`);
+        }
+        return {handle: tensor.handle};
+      }
+      if ('data' in tensor) {
+        return tensor;
+      }
+      return {
+        dtype: signature.inputs[i].dtype,
+        dimensions: signature.inputs[i].shape,
+        data: tensor,
+      };
+    });
+
+    let outputs: TypedArray[]|undefined;
+    if (Array.isArray(options.outputs)) {
+      outputs = options.outputs;
+    } else if (options.outputs) {
+      const outputRecord = options.outputs;
+      outputs = signature.outputs.map(({name}) => outputRecord[name]);
+    }
+
+    const results = await this.worker.enqueueRun({
+      modelId: this.modelMessage.modelId,
+      signature: options.signature,
+      inputs,
+      outputs,
+      keepOutputs: options.keepOutputs,
+    });
+
+    // Arrays that are not shared were cloned to the worker, so the worker
+    // wrote to its copy.
+    for (let i = 0; i < results.length; ++i) {
+      const target = outputs?.[i];
+      const result = results[i];
+      if (target && !isShared(target) && !(result instanceof WorkerTensor)) {
+        target.set(result.data);
+        result.data = target;
+      }
+    }
+
+    if (Array.isArray(input)) {
+      return results;
+    }
+    const output: Record<string, WorkerTensorData|WorkerTensor> = {};
+    for (let i = 0; i < signature.outputs.length; ++i) {
+      output[signature.outputs[i].name] = results[i];
+    }
+    return output;
+  }
+
+  delete() {
+    if (this.deleted) {
+      return;
+    }
+    this.deleted = true;
+    this.worker.deleteModel(this.modelMessage.modelId);
+  }
+}
+
+interface PendingRun {
+  resolve: (outputs: Array<WorkerTensorData|WorkerTensor>) => void;
+  reject: (error: Error) => void;
+}
+
+/**
+ * Runs LiteRT models in a worker, so inference does not block the thread
+ * that calls it.
+ *
+ * The worker's script must call `startLiteRtWorker()`:
+ *
+ * ```ts
+ * // worker.ts
+ * import {startLiteRtWorker} from '@litertjs/core';
+ * startLiteRtWorker();
+ *
+ * // main.ts
+ * const liteRtWorker = await LiteRtWorker.create(
+ *     new Worker('worker.js', {type: 'module'}), '/wasm/');
+ * const model = await liteRtWorker.loadAndCompile(
+ *     '/model.tflite', {accelerator: 'webgpu'});
+ * const [output] = await model.run([inputArray]);
+ * ```
+ */
+export class LiteRtWorker {
+  private nextRequestId = 0;
+  private nextTaskId = 0;
+  private readonly pendingRequests = new Map<number, {
+    resolve: (model?: ModelMessage) => void,
+    reject: (error: Error) => void,
+  }>();
+  private readonly pendingRuns = new Map<number, PendingRun>();
+  private queuedTasks: RunTask[] = [];
+  private deleted = false;
+
+  private constructor(private readonly endpoint: MessageEndpoint) {
+    this.endpoint.addEventListener('message', this.onMessage);
+    this.endpoint.start?.();
+  }
+
+  /**
+   * Loads LiteRT in the worker behind `endpoint`.
+   *
+   * @param endpoint A Worker, or a MessagePort, whose other end has called
+   *     `startLiteRtWorker()`.
+   * @param wasmPath The path to the LiteRT Wasm files, as for `loadLiteRt()`.
+   *     Relative paths are resolved against this page, not the worker.
+   */
+  static async create(
+      endpoint: MessageEndpoint, wasmPath: string|URL,
+      options?: LoadLiteRtOptions): Promise<LiteRtWorker> {
+    const worker = new LiteRtWorker(endpoint);
+    try {
+      await worker.request(
+          {kind: 'init', wasmPath: resolveUrl(wasmPath), options});
+    } catch (error) {
+      worker.delete();
+      throw error;
+    }
+    return worker;
+  }
+
+  private readonly onMessage = (event: MessageEvent) => {
+    const response = event.data as WorkerResponse;
+    if (response.kind === 'result') {
+      const pending = this.pendingRequests.get(response.requestId);
+      this.pendingRequests.delete(response.requestId);
+      if (response.error !== undefined) {
+        pending?.reject(new Error(response.error));
+      } else {
+        pending?.resolve(response.model);
+      }
+    } else if (response.kind === 'runResults') {
+      for (const result of response.results) {
+        this.settleRun(result);
+      }
+    }
+  };
+
+  private settleRun(result: RunTaskResult) {
+    const pending = this.pendingRuns.get(result.taskId);
+    this.pendingRuns.delete(result.taskId);
+    if (!pending) {
+      return;
+    }
+    if (result.error !== undefined || !result.outputs) {
+      pending.reject(new Error(result.error ?? 'Run failed.'));
+      return;
+    }
+    pending.resolve(result.outputs.map(
+        (output: TensorDataMessage|TensorHandleMessage) => 'handle' in output ?
+            new WorkerTensor(
+                this, output.dtype, output.dimensions, output.handle) :
+            output));
+  }
+
+  private checkDeleted() {
+    if (this.deleted) {
+      throw new Error('LiteRtWorker has been deleted.');
+    }
+  }
+
+  private request(message: RequestMessage): Promise<ModelMessage|undefined> {
+    this.checkDeleted();
+    const requestId = this.nextRequestId++;
+    return new Promise((resolve, reject) => {
+      this.pendingRequests.set(requestId, {resolve, reject});
+      this.endpoint.postMessage({...message, requestId} as WorkerRequest);
+    });
+  }
+
+  /**
+   * Loads and compiles a model in the worker.
+   *
+   * @param model The model url, or the model bytes. Relative urls are
+   *     resolved against this page, not the worker.
+   */
+  async loadAndCompile(
+      model: string|URL|Uint8Array,
+      compileOptions: CompileOptions): Promise<WorkerCompiledModel> {
+    const modelMessage = await this.request({
+      kind: 'load',
+      model: model instanceof Uint8Array ? model : resolveUrl(model),
+      accelerator: compileOptions.accelerator,
+    });
+    return new WorkerCompiledModel(this, modelMessage!);
+  }
+
+  /**
+   * Queues a run to be sent with the other runs queued in this task.
+   */
+  enqueueRun(task: Omit<RunTask, 'taskId'>):
+      Promise<Array<WorkerTensorData|WorkerTensor>> {
+    this.checkDeleted();
+    const taskId = this.nextTaskId++;
+    if (this.queuedTasks.length === 0) {
+      queueMicrotask(() => {
+        this.flush();
+      });
+    }
+    this.queuedTasks.push({...task, taskId});
+    return new Promise((resolve, reject) => {
+      this.pendingRuns.set(taskId, {resolve, reject});
+    });
+  }
+
+  private flush() {
+    const tasks = this.queuedTasks;
+    this.queuedTasks = [];
+    if (tasks.length === 0 || this.deleted) {
+      return;
+    }
+    try {
+      this.endpoint.postMessage({kind: 'run', tasks} as WorkerRequest);
+    } catch (error) {
+      // E.g. an input that can not be cloned.
+      for (const task of tasks) {
+        this.pendingRuns.get(task.taskId)?.reject(error as Error);
+        this.pendingRuns.delete(task.taskId);
+      }
+    }
+  }
+
+  /** Called by WorkerCompiledModel.delete(). */
+  deleteModel(modelId: number) {
+    if (!this.deleted) {
+      this.endpoint.postMessage(
+          {kind: 'deleteModel', modelId} as WorkerRequest);
+    }
+  }
+
+  /** Called by WorkerTensor.delete(). */
+  deleteTensor(handle: number) {
+    if (!this.deleted) {
+      this.endpoint.postMessage(
+          {kind: 'deleteTensors', handles: [handle]} as WorkerRequest);
+    }
+  }
+
+  /**
+   * Stops listening to the worker and rejects anything still pending. This
+   * does not terminate the worker.
+   */
+  delete() {
+    if (this.deleted) {
+      return;
+    }
+    this.deleted = true;
+    this.endpoint.removeEventListener('message', this.onMessage);
+    const error = new Error('LiteRtWorker has been deleted.');
+    for (const pending of [
+             ...this.pendingRequests.values(), ...this.pendingRuns.values()
+         ]) {
+      pending.reject(error);
+    }
+    this.pendingRequests.clear();
+    this.pendingRuns.clear();
+    this.queuedTasks = [];
+  }
+}
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import type {Accelerator, DType, TypedArray} from './constants';
+import type {LoadLiteRtOptions} from './load_litert';
+
+// Messages exchanged between a LiteRtWorker and the worker running
+// startLiteRtWorker(). Only exposed internally.
+
+/**
+ * The end of a message channel, such as a Worker, the global scope of a
+ * worker, or a MessagePort.
+ */
+export interface MessageEndpoint {
+  postMessage(message: unknown, transfer?: Transferable[]): void;
+  addEventListener(
+      type: 'message', listener: (event: MessageEvent) => void): void;
+  removeEventListener(
+      type: 'message', listener: (event: MessageEvent) => void): void;
+  start?(): void;
+}
+
+/**
+ * The data of a tensor sent to or from the worker. When the data is backed by
+ * a SharedArrayBuffer, posting it does not copy it.
+ */
+export interface TensorDataMessage {
+  dtype: DType;
+  dimensions: number[];
+  data: TypedArray;
+}
+
+/**
+ * A tensor kept in the worker, on the accelerator of the model that made it.
+ */
+export interface TensorHandleMessage {
+  dtype: DType;
+  dimensions: number[];
+  handle: number;
+}
+
+/**
+ * A run of a model, sent to the worker in a batch with other runs.
+ */
+export interface RunTask {
+  taskId: number;
+  modelId: number;
+  signature?: string;
+  // In the order of the inputs of the signature.
+  inputs: Array<TensorDataMessage|Pick<TensorHandleMessage, 'handle'>>;
+  // Arrays that the outputs are written to. They must be backed by
+  // SharedArrayBuffers for the writes to be visible to the sender.
+  outputs?: TypedArray[];
+  // Whether to keep the outputs in the worker and return handles to them.
+  keepOutputs?: boolean;
+}
+
+/**
+ * The result of a RunTask.
+ */
+export interface RunTaskResult {
+  taskId: number;
+  outputs?: Array<TensorDataMessage|TensorHandleMessage>;
+  error?: string;
+}
+
+/**
+ * The inputs and outputs of a signature of a model loaded in the worker.
+ */
+export interface SignatureMessage {
+  inputs: Array<{name: string, dtype: DType, shape: number[]}>;
+  outputs: Array<{name: string, dtype: DType, shape: number[]}>;
+}
+
+/**
+ * A model loaded in the worker.
+ */
+export interface ModelMessage {
+  modelId: number;
+  accelerator: Accelerator;
+  // The primary signature is under the empty name.
+  signatures: Record<string, SignatureMessage>;
+}
+
+/**
+ * A message to the worker.
+ */
+export type WorkerRequest = {
+  kind: 'init',
+  requestId: number,
+  wasmPath: string,
+  options?: LoadLiteRtOptions,
+}|{
+  kind: 'load',
+  requestId: number,
+  model: string|Uint8Array,
+  accelerator: Accelerator,
+}|{
+  kind: 'run',
+  tasks: RunTask[],
+}|{
+  kind: 'deleteModel',
+  modelId: number,
+}|{
+  kind: 'deleteTensors',
+  handles: number[],
+};
+
+/**
+ * A message from the worker.
+ */
+export type WorkerResponse = {
+  kind: 'result',
+  requestId: number,
+  model?: ModelMessage,
+  error?: string,
+}|{
+  kind: 'runResults',
+  results: RunTaskResult[],
+};
@@ -0,0 +1,268 @@
+/**
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import type {CompiledModel} from './compiled_model';
+import {DType, DTYPE_TO_ARRAY_TYPE, TypedArray} from './constants';
+import {getGlobalLiteRt, getGlobalLiteRtPromise, hasGlobalLiteRtPromise} from './global_litert';
+import {loadLiteRt} from './load_litert';
+import {Tensor} from './tensor';
+import type {CpuTensorReference} from './wasm_binding_types';
+import type {MessageEndpoint, ModelMessage, RunTask, RunTaskResult, SignatureMessage, TensorDataMessage, TensorHandleMessage, WorkerRequest, WorkerResponse} from './worker_protocol';
+
+function errorMessage(error: unknown): string {
+  return error instanceof Error ? error.message : String(error);
+}
+
+function toSignatureMessage(
+    inputs: ReturnType<CompiledModel['getInputDetails']>,
+    outputs: ReturnType<CompiledModel['getOutputDetails']>): SignatureMessage {
+  const toMessage = (details: typeof inputs) => details.map(
+      ({name, dtype, shape}) =>
+          ({name, dtype: dtype as DType, shape: Array.from(shape)}));
+  return {inputs: toMessage(inputs), outputs: toMessage(outputs)};
+}
+
+/**
+ * Serves the models and tensors of one worker. Messages are handled one at a
+ * time, in the order they arrive.
+ */
+class WorkerServer {
+  private readonly models = new Map<number, CompiledModel>();
+  private readonly tensors = new Map<number, Tensor>();
+  private nextModelId = 0;
+  private nextHandle = 0;
+  private queue = Promise.resolve();
+
+  constructor(private readonly endpoint: MessageEndpoint) {}
+
+  readonly onMessage = (event: MessageEvent) => {
+    const request = event.data as WorkerRequest;
+    this.queue = this.queue.then(() => this.handle(request));
+  };
+
+  private post(response: WorkerResponse, transfer: Transferable[] = []) {
+    this.endpoint.postMessage(response, transfer);
+  }
+
+  private async handle(request: WorkerRequest) {
+    switch (request.kind) {
+      case 'init':
+      case 'load':
+        try {
+          let model: ModelMessage|undefined;
+          if (request.kind === 'init') {
+            await this.init(request.wasmPath, request.options);
+          } else {
+            model = await this.load(request.model, request.accelerator);
+          }
+          this.post({kind: 'result', requestId: request.requestId, model});
+        } catch (error) {
+          this.post({
+            kind: 'result',
+            requestId: request.requestId,
+            error: errorMessage(error),
+          });
+        }
+        break;
+      case 'run':
+        await this.run(request.tasks);
+        break;
+      case 'deleteModel':
+        this.models.get(request.modelId)?.delete();
+        this.models.delete(request.modelId);
+        break;
+      case 'deleteTensors':
+        for (const handle of request.handles) {
+          this.tensors.get(handle)?.delete();
+          this.tensors.delete(handle);
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+  private async init(
+      wasmPath: string,
+      options: Parameters<typeof loadLiteRt>[1]) {
+    // The worker may share its global LiteRT with other code.
+    if (!hasGlobalLiteRtPromise()) {
+      loadLiteRt(wasmPath, options);
+    }
+    await getGlobalLiteRtPromise();
+  }
+
+  private async load(
+      modelData: string|Uint8Array,
+      accelerator: ModelMessage['accelerator']): Promise<ModelMessage> {
+    const model =
+        await getGlobalLiteRt().loadAndCompile(modelData, {accelerator});
+    const modelId = this.nextModelId++;
+    this.models.set(modelId, model);
+
+    const signatures: Record<string, SignatureMessage> = {
+      '': toSignatureMessage(model.getInputDetails(), model.getOutputDetails()),
+    };
+    for (const [name, signature] of Object.entries(model.signatures)) {
+      signatures[name] = toSignatureMessage(
+          signature.getInputDetails(), signature.getOutputDetails());
+    }
+    return {modelId, accelerator: model.accelerator, signatures};
+  }
+
+  /**
+   * Runs a batch of tasks and answers them all in one message. A failed task
+   * does not stop the others.
+   */
+  private async run(tasks: RunTask[]) {
+    const results: RunTaskResult[] = [];
+    const transfer: Transferable[] = [];
+    for (const task of tasks) {
+      try {
+        results.push({
+          taskId: task.taskId,
+          outputs: await this.runTask(task, transfer),
+        });
+      } catch (error) {
+        results.push({taskId: task.taskId, error: errorMessage(error)});
+      }
+    }
+    this.post({kind: 'runResults', results}, transfer);
+  }
+
+  private async runTask(task: RunTask, transfer: Transferable[]):
+      Promise<Array<TensorDataMessage|TensorHandleMessage>> {
+    const model = this.models.get(task.modelId);
+    if (!model) {
+      throw new Error(`Model ${task.modelId} has been deleted.`);
+    }
+
+    // Tensors made for this run, deleted when it finishes.
+    const temporaries: Tensor[] = [];
+    try {
+      const inputs: Tensor[] = [];
+      for (const input of task.inputs) {
+        let tensor: Tensor;
+        if ('data' in input) {
+          tensor = new Tensor(input.data, input.dimensions);
+          temporaries.push(tensor);
+        } else {
+          const kept = this.tensors.get(input.handle);
+          if (!kept) {
+            throw new Error(`Tensor ${input.handle} has been deleted.`);
+          }
+          tensor = kept;
+        }
+        if (tensor.accelerator !== model.accelerator) {
+          tensor = await tensor.copyTo(model.accelerator);
+          temporaries.push(tensor);
+        }
+        inputs.push(tensor);
+      }
+
+      const outputs = task.signature ? model.run(task.signature, inputs) :
+                                       model.run(inputs);
+      if (task.keepOutputs) {
+        return outputs.map(output => {
+          const handle = this.nextHandle++;
+          this.tensors.set(handle, output);
+          return {
+            dtype: output.type.dtype,
+            dimensions: Array.from(output.type.layout.dimensions),
+            handle,
+          };
+        });
+      }
+
+      temporaries.push(...outputs);
+      const messages: TensorDataMessage[] = [];
+      for (let i = 0; i < outputs.length; ++i) {
+        let output = outputs[i];
+        if (output.accelerator !== 'wasm') {
+          output = await output.copyTo('wasm');
+          temporaries.push(output);
+        }
+        messages.push(
+            this.readOutput(output, task.outputs?.[i], transfer));
+      }
+      return messages;
+    } finally {
+      for (const tensor of temporaries) {
+        tensor.delete();
+      }
+    }
+  }
+
+  /**
+   * Copies a Wasm output into `target`, or into a new array if there is none.
+   * New arrays are backed by a SharedArrayBuffer when the worker can share
+   * memory, and are transferred otherwise.
+   */
+  private readOutput(
+      output: Tensor, target: TypedArray|undefined,
+      transfer: Transferable[]): TensorDataMessage {
+    const dtype = output.type.dtype;
+    const arrayType = DTYPE_TO_ARRAY_TYPE[dtype];
+    const bytes = (output.reference as CpuTensorReference).data();
+    const view = new arrayType(
+        // Cast is needed to avoid 'SharedArrayBuffer' in the type.
+        bytes.buffer as ArrayBuffer, bytes.byteOffset,
+        bytes.length / arrayType.BYTES_PER_ELEMENT);
+
+    let data: TypedArray;
+    if (target) {
+      if (!(target instanceof arrayType) || target.length !== view.length) {
+        throw new Error(`Output array of length ${
+            target.length} does not fit ${view.length} elements of ${dtype}.`);
+      }
+      target.set(view);
+      data = target;
+    } else if (globalThis.crossOriginIsolated) {
+      data = new arrayType(
+          new SharedArrayBuffer(view.byteLength) as unknown as ArrayBuffer);
+      data.set(view);
+    } else {
+      data = view.slice();
+      transfer.push(data.buffer);
+    }
+    return {
+      dtype,
+      dimensions: Array.from(output.type.layout.dimensions),
+      data,
+    };
+  }
+}
+
+/**
+ * Serves LiteRtWorker requests from this worker. Call this from the script of
+ * the worker that LiteRtWorker.create() is given.
+ *
+ * LiteRT is loaded here, so the main thread does not need to load it. If this
+ * worker has already loaded LiteRT, that instance is used.
+ *
+ * @param endpoint Where requests come from. Defaults to the global scope of
+ *     the worker.
+ * @returns A function that stops serving requests.
+ */
+export function startLiteRtWorker(
+    endpoint = globalThis as unknown as MessageEndpoint): () => void {
+  const server = new WorkerServer(endpoint);
+  endpoint.addEventListener('message', server.onMessage);
+  endpoint.start?.();
+  return () => {
+    endpoint.removeEventListener('message', server.onMessage);
+  };
+}
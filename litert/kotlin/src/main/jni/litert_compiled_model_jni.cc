@@ -116,6 +116,31 @@ litert::CompiledModel CreateCompileModel(jlong compiled_model_handle,
                                             litert::OwnHandle::kNo);
 }
 
+// The buffers of a run, resolved once and reused by every run with the same
+// buffers, so that they do not have to be unpacked from JNI arrays every time.
+struct RunBinding {
+  litert::CompiledModel compiled_model;
+  size_t signature_index;
+  std::vector<litert::TensorBuffer> input_buffers;
+  std::vector<litert::TensorBuffer> output_buffers;
+};
+
+// Wraps the given buffer handles, which are not owned by the returned
+// TensorBuffers.
+std::vector<litert::TensorBuffer> WrapTensorBuffers(JNIEnv* env,
+                                                    jlongArray handles) {
+  auto num_buffers = env->GetArrayLength(handles);
+  AUTO_CLEANUP_JNI_LONG_ARRAY(env, handles);
+  std::vector<litert::TensorBuffer> buffers;
+  buffers.reserve(num_buffers);
+  for (int i = 0; i < num_buffers; ++i) {
+    buffers.push_back(litert::TensorBuffer::WrapCObject(
+        reinterpret_cast<LiteRtTensorBuffer>(handles_array[i]),
+        litert::OwnHandle::kNo));
+  }
+  return buffers;
+}
+
 // Creates a LiteRtOpaqueOptions from the given cpu options.
 // The number of given options must be greater than 0.
 LiteRtStatus CreateCpuOptions(JNIEnv* env, LiteRtOpaqueOptions* options,
@@ -632,69 +657,14 @@ Java_com_google_ai_edge_litert_CompiledModel_nativeCreateOutputBuffersBySignatur
   return handles_array;
 }
 
-JNIEXPORT void JNICALL Java_com_google_ai_edge_litert_CompiledModel_nativeRun(
-    JNIEnv* env, jclass clazz, jlong compiled_model_handle, jlong model_handle,
-    jint signature_index, jlongArray input_buffers, jlongArray output_buffers) {
-  auto compiled_model = CreateCompileModel(compiled_model_handle, model_handle);
-
-  auto num_inputs = env->GetArrayLength(input_buffers);
-  AUTO_CLEANUP_JNI_LONG_ARRAY(env, input_buffers);
-  std::vector<litert::TensorBuffer> input_buffer_vector;
-  input_buffer_vector.reserve(num_inputs);
-  for (int i = 0; i < num_inputs; ++i) {
-    auto litert_tensor_buffer =
-        reinterpret_cast<LiteRtTensorBuffer>(input_buffers_array[i]);
-    input_buffer_vector.push_back(litert::TensorBuffer::WrapCObject(
-        litert_tensor_buffer, litert::OwnHandle::kNo));
-  }
-
-  auto num_outputs = env->GetArrayLength(output_buffers);
-  AUTO_CLEANUP_JNI_LONG_ARRAY(env, output_buffers);
-  std::vector<litert::TensorBuffer> output_buffer_vector;
-  output_buffer_vector.reserve(num_outputs);
-  for (int i = 0; i < num_outputs; ++i) {
-    auto litert_tensor_buffer =
-        reinterpret_cast<LiteRtTensorBuffer>(output_buffers_array[i]);
-    output_buffer_vector.push_back(litert::TensorBuffer::WrapCObject(
-        litert_tensor_buffer, litert::OwnHandle::kNo));
-  }
-  auto result = compiled_model.Run(signature_index, input_buffer_vector,
-                                   output_buffer_vector);
-  if (!result) {
-    LITERT_LOG(LITERT_ERROR, "Failed to run model: %s",
-               result.Error().Message().c_str());
-    ThrowLiteRtException(env, result.Error().Status(),
-                         result.Error().Message());
-  }
-}
-
 JNIEXPORT void JNICALL
 Java_com_google_ai_edge_litert_CompiledModel_nativeRunBySignature(
     JNIEnv* env, jclass clazz, jlong compiled_model_handle, jlong model_handle,
     jstring signature, jlongArray input_buffers, jlongArray output_buffers) {
   auto compiled_model = CreateCompileModel(compiled_model_handle, model_handle);
 
-  auto num_inputs = env->GetArrayLength(input_buffers);
-  AUTO_CLEANUP_JNI_LONG_ARRAY(env, input_buffers);
-  std::vector<litert::TensorBuffer> input_buffer_vector;
-  input_buffer_vector.reserve(num_inputs);
-  for (int i = 0; i < num_inputs; ++i) {
-    auto litert_tensor_buffer =
-        reinterpret_cast<LiteRtTensorBuffer>(input_buffers_array[i]);
-    input_buffer_vector.push_back(litert::TensorBuffer::WrapCObject(
-        litert_tensor_buffer, litert::OwnHandle::kNo));
-  }
-
-  auto num_outputs = env->GetArrayLength(output_buffers);
-  AUTO_CLEANUP_JNI_LONG_ARRAY(env, output_buffers);
-  std::vector<litert::TensorBuffer> output_buffer_vector;
-  output_buffer_vector.reserve(num_outputs);
-  for (int i = 0; i < num_outputs; ++i) {
-    auto litert_tensor_buffer =
-        reinterpret_cast<LiteRtTensorBuffer>(output_buffers_array[i]);
-    output_buffer_vector.push_back(litert::TensorBuffer::WrapCObject(
-        litert_tensor_buffer, litert::OwnHandle::kNo));
-  }
+  auto input_buffer_vector = WrapTensorBuffers(env, input_buffers);
+  auto output_buffer_vector = WrapTensorBuffers(env, output_buffers);
 
   AUTO_CLEANUP_JNI_STRING(env, signature);
   auto result = compiled_model.Run(signature_str, input_buffer_vector,
@@ -756,6 +726,58 @@ Java_com_google_ai_edge_litert_CompiledModel_nativeRunBySignatureWithMap(
   }
 }
 
+JNIEXPORT jlong JNICALL
+Java_com_google_ai_edge_litert_CompiledModel_nativeCreateRunBinding(
+    JNIEnv* env, jclass clazz, jlong compiled_model_handle, jlong model_handle,
+    jint signature_index, jlongArray input_buffers, jlongArray output_buffers) {
+  auto* binding = new RunBinding{
+      CreateCompileModel(compiled_model_handle, model_handle),
+      static_cast<size_t>(signature_index),
+      WrapTensorBuffers(env, input_buffers),
+      WrapTensorBuffers(env, output_buffers),
+  };
+  return reinterpret_cast<jlong>(binding);
+}
+
+JNIEXPORT void JNICALL
+Java_com_google_ai_edge_litert_CompiledModel_nativeRunBinding(
+    JNIEnv* env, jclass clazz, jlong binding_handle) {
+  auto* binding = reinterpret_cast<RunBinding*>(binding_handle);
+  auto result = binding->compiled_model.Run(
+      binding->signature_index, binding->input_buffers,
+      binding->output_buffers);
+  if (!result) {
+    LITERT_LOG(LITERT_ERROR, "Failed to run model: %s",
+               result.Error().Message().c_str());
+    ThrowLiteRtException(env, result.Error().Status(),
+                         result.Error().Message());
+  }
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_google_ai_edge_litert_CompiledModel_nativeRunBindingAsync(
+    JNIEnv* env, jclass clazz, jlong binding_handle) {
+  auto* binding = reinterpret_cast<RunBinding*>(binding_handle);
+  bool async = false;
+  auto result = binding->compiled_model.RunAsync(
+      binding->signature_index, binding->input_buffers,
+      binding->output_buffers, async);
+  if (!result) {
+    LITERT_LOG(LITERT_ERROR, "Failed to run model asynchronously: %s",
+               result.Error().Message().c_str());
+    ThrowLiteRtException(env, result.Error().Status(),
+                         result.Error().Message());
+    return JNI_FALSE;
+  }
+  return async ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL
+Java_com_google_ai_edge_litert_CompiledModel_nativeDestroyRunBinding(
+    JNIEnv* env, jclass clazz, jlong binding_handle) {
+  delete reinterpret_cast<RunBinding*>(binding_handle);
+}
+
 JNIEXPORT void JNICALL
 Java_com_google_ai_edge_litert_CompiledModel_nativeDestroy(JNIEnv* env,
                                                            jclass clazz,
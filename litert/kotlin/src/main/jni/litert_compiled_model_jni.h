@@ -68,10 +68,6 @@ Java_com_google_ai_edge_litert_CompiledModel_nativeCreateOutputBuffersBySignatur
     JNIEnv* env, jclass clazz, jlong compiled_model_handle, jlong model_handle,
     jstring signature);
 
-JNIEXPORT void JNICALL Java_com_google_ai_edge_litert_CompiledModel_nativeRun(
-    JNIEnv* env, jclass clazz, jlong compiled_model_handle, jlong model_handle,
-    jint signature_index, jlongArray input_buffers, jlongArray output_buffers);
-
 JNIEXPORT void JNICALL
 Java_com_google_ai_edge_litert_CompiledModel_nativeRunBySignature(
     JNIEnv* env, jclass clazz, jlong compiled_model_handle, jlong model_handle,
@@ -83,6 +79,23 @@ Java_com_google_ai_edge_litert_CompiledModel_nativeRunBySignatureWithMap(
     jstring signature, jobjectArray input_keys, jlongArray input_buffers,
     jobjectArray output_keys, jlongArray output_buffers);
 
+JNIEXPORT jlong JNICALL
+Java_com_google_ai_edge_litert_CompiledModel_nativeCreateRunBinding(
+    JNIEnv* env, jclass clazz, jlong compiled_model_handle, jlong model_handle,
+    jint signature_index, jlongArray input_buffers, jlongArray output_buffers);
+
+JNIEXPORT void JNICALL
+Java_com_google_ai_edge_litert_CompiledModel_nativeRunBinding(
+    JNIEnv* env, jclass clazz, jlong binding_handle);
+
+JNIEXPORT jboolean JNICALL
+Java_com_google_ai_edge_litert_CompiledModel_nativeRunBindingAsync(
+    JNIEnv* env, jclass clazz, jlong binding_handle);
+
+JNIEXPORT void JNICALL
+Java_com_google_ai_edge_litert_CompiledModel_nativeDestroyRunBinding(
+    JNIEnv* env, jclass clazz, jlong binding_handle);
+
 JNIEXPORT void JNICALL
 Java_com_google_ai_edge_litert_CompiledModel_nativeDestroy(JNIEnv* env,
                                                            jclass clazz,
@@ -17,6 +17,7 @@
 #include <jni.h>
 
 #include <any>
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -126,6 +127,24 @@ Java_com_google_ai_edge_litert_Environment_nativeGetAvailableAccelerators(
   return result;
 }
 
+JNIEXPORT jlong JNICALL
+Java_com_google_ai_edge_litert_Environment_nativeTrimMemory(JNIEnv* env,
+                                                            jclass clazz,
+                                                            jlong handle,
+                                                            jint level) {
+  auto litert_env = reinterpret_cast<LiteRtEnvironment>(handle);
+
+  size_t num_freed_bytes = 0;
+  auto status = LiteRtEnvironmentTrimMemory(
+      litert_env, static_cast<LiteRtTrimMemoryLevel>(level), &num_freed_bytes);
+  if (status != kLiteRtStatusOk) {
+    LITERT_LOG(LITERT_ERROR, "Failed to trim memory.");
+    ThrowLiteRtException(env, status, "Failed to trim memory.");
+    return 0;
+  }
+  return static_cast<jlong>(num_freed_bytes);
+}
+
 JNIEXPORT void JNICALL Java_com_google_ai_edge_litert_Environment_nativeDestroy(
     JNIEnv* env, jclass clazz, jlong handle) {
   LiteRtDestroyEnvironment(reinterpret_cast<LiteRtEnvironment>(handle));
@@ -30,6 +30,12 @@ JNIEXPORT jintArray JNICALL
 Java_com_google_ai_edge_litert_Environment_nativeGetAvailableAccelerators(
     JNIEnv* env, jclass clazz, jlong handle);
 
+JNIEXPORT jlong JNICALL
+Java_com_google_ai_edge_litert_Environment_nativeTrimMemory(JNIEnv* env,
+                                                            jclass clazz,
+                                                            jlong handle,
+                                                            jint level);
+
 JNIEXPORT void JNICALL Java_com_google_ai_edge_litert_Environment_nativeDestroy(
     JNIEnv* env, jclass clazz, jlong handle);
 
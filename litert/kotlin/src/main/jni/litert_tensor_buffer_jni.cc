@@ -16,16 +16,88 @@
 
 #include <jni.h>
 
+#include <cstddef>
+#include <cstdint>
+
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
+#include "litert/c/litert_environment.h"
+#include "litert/c/litert_layout.h"
+#include "litert/c/litert_model_types.h"
 #include "litert/c/litert_tensor_buffer.h"
+#include "litert/c/litert_tensor_buffer_types.h"
 #include "litert/cc/internal/litert_handle.h"
 #include "litert/cc/litert_tensor_buffer.h"
 #include "litert/kotlin/src/main/jni/litert_jni_common.h"
 
+#if LITERT_HAS_AHWB_SUPPORT
+#include <android/hardware_buffer_jni.h>
+#endif  // LITERT_HAS_AHWB_SUPPORT
+
 namespace {
 using litert::jni::ThrowLiteRtException;
+
+// Element types, the values should match the order of
+// com.google.ai.edge.litert.TensorType.ElementType in Kotlin.
+enum ElementType {
+  kElementTypeInt = 0,
+  kElementTypeFloat = 1,
+  kElementTypeInt8 = 2,
+  kElementTypeBoolean = 3,
+  kElementTypeInt64 = 4,
+};
+
+// Converts the given Kotlin element type and dimensions to a
+// LiteRtRankedTensorType. Throws a LiteRtException and returns false if they
+// are not supported.
+bool ToLiteRtRankedTensorType(JNIEnv* env, jint element_type,
+                              jintArray dimensions,
+                              LiteRtRankedTensorType* tensor_type) {
+  switch (element_type) {
+    case kElementTypeInt:
+      tensor_type->element_type = kLiteRtElementTypeInt32;
+      break;
+    case kElementTypeFloat:
+      tensor_type->element_type = kLiteRtElementTypeFloat32;
+      break;
+    case kElementTypeInt8:
+      tensor_type->element_type = kLiteRtElementTypeInt8;
+      break;
+    case kElementTypeBoolean:
+      tensor_type->element_type = kLiteRtElementTypeBool;
+      break;
+    case kElementTypeInt64:
+      tensor_type->element_type = kLiteRtElementTypeInt64;
+      break;
+    default:
+      ThrowLiteRtException(env, kLiteRtStatusErrorInvalidArgument,
+                           "Unsupported element type.");
+      return false;
+  }
+  auto rank = env->GetArrayLength(dimensions);
+  if (rank > LITERT_TENSOR_MAX_RANK) {
+    ThrowLiteRtException(env, kLiteRtStatusErrorInvalidArgument,
+                         "Tensor rank is too large.");
+    return false;
+  }
+  tensor_type->layout.rank = rank;
+  tensor_type->layout.has_strides = false;
+  env->GetIntArrayRegion(dimensions, 0, rank, tensor_type->layout.dimensions);
+  return true;
+}
+
+// Throws a LiteRtException if the TensorBuffer could not be created, otherwise
+// returns its handle.
+jlong ToTensorBufferHandle(JNIEnv* env, LiteRtStatus status,
+                           LiteRtTensorBuffer tensor_buffer) {
+  if (status != kLiteRtStatusOk) {
+    LITERT_LOG(LITERT_ERROR, "Failed to create tensor buffer.");
+    ThrowLiteRtException(env, status, "Failed to create tensor buffer.");
+    return 0;
+  }
+  return reinterpret_cast<jlong>(tensor_buffer);
+}
 }  // namespace
 
 #ifdef __cplusplus
@@ -288,6 +360,101 @@ Java_com_google_ai_edge_litert_TensorBuffer_nativeReadLong(JNIEnv* env,
   return result;
 }
 
+JNIEXPORT jint JNICALL
+Java_com_google_ai_edge_litert_TensorBuffer_nativeGetAlignmentOffset(
+    JNIEnv* env, jclass clazz, jobject buffer) {
+  auto addr = reinterpret_cast<uintptr_t>(env->GetDirectBufferAddress(buffer));
+  return (LITERT_HOST_MEMORY_BUFFER_ALIGNMENT -
+          addr % LITERT_HOST_MEMORY_BUFFER_ALIGNMENT) %
+         LITERT_HOST_MEMORY_BUFFER_ALIGNMENT;
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_google_ai_edge_litert_TensorBuffer_nativeCreateFromDirectBuffer(
+    JNIEnv* env, jclass clazz, jint element_type, jintArray dimensions,
+    jobject buffer) {
+  LiteRtRankedTensorType tensor_type;
+  if (!ToLiteRtRankedTensorType(env, element_type, dimensions, &tensor_type)) {
+    return 0;
+  }
+  void* addr = env->GetDirectBufferAddress(buffer);
+  jlong capacity = env->GetDirectBufferCapacity(buffer);
+  if (addr == nullptr || capacity < 0) {
+    ThrowLiteRtException(env, kLiteRtStatusErrorInvalidArgument,
+                         "The ByteBuffer is not direct.");
+    return 0;
+  }
+  if (reinterpret_cast<uintptr_t>(addr) % LITERT_HOST_MEMORY_BUFFER_ALIGNMENT) {
+    ThrowLiteRtException(env, kLiteRtStatusErrorInvalidArgument,
+                         "The ByteBuffer is not aligned to 64 bytes.");
+    return 0;
+  }
+  // The memory is owned by the ByteBuffer, which the Kotlin TensorBuffer keeps
+  // alive.
+  LiteRtTensorBuffer tensor_buffer = nullptr;
+  auto status = LiteRtCreateTensorBufferFromHostMemory(
+      &tensor_type, addr, static_cast<size_t>(capacity),
+      /*deallocator=*/nullptr, &tensor_buffer);
+  return ToTensorBufferHandle(env, status, tensor_buffer);
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_google_ai_edge_litert_TensorBuffer_nativeCreateFromHardwareBuffer(
+    JNIEnv* env, jclass clazz, jlong env_handle, jint element_type,
+    jintArray dimensions, jobject hardware_buffer, jint offset) {
+#if LITERT_HAS_AHWB_SUPPORT
+  LiteRtRankedTensorType tensor_type;
+  if (!ToLiteRtRankedTensorType(env, element_type, dimensions, &tensor_type)) {
+    return 0;
+  }
+  AHardwareBuffer* ahwb =
+      AHardwareBuffer_fromHardwareBuffer(env, hardware_buffer);
+  if (ahwb == nullptr) {
+    ThrowLiteRtException(env, kLiteRtStatusErrorInvalidArgument,
+                         "Invalid HardwareBuffer.");
+    return 0;
+  }
+  // The AHardwareBuffer is owned by the HardwareBuffer, which the Kotlin
+  // TensorBuffer keeps alive.
+  LiteRtTensorBuffer tensor_buffer = nullptr;
+  auto status = LiteRtCreateTensorBufferFromAhwb(
+      reinterpret_cast<LiteRtEnvironment>(env_handle), &tensor_type, ahwb,
+      static_cast<size_t>(offset), /*deallocator=*/nullptr, &tensor_buffer);
+  return ToTensorBufferHandle(env, status, tensor_buffer);
+#else
+  ThrowLiteRtException(env, kLiteRtStatusErrorUnsupported,
+                       "AHardwareBuffer is not supported on this platform.");
+  return 0;
+#endif  // LITERT_HAS_AHWB_SUPPORT
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_google_ai_edge_litert_TensorBuffer_nativeWaitEvent(
+    JNIEnv* env, jclass clazz, jlong handle, jlong timeout_ms) {
+  auto tb = reinterpret_cast<LiteRtTensorBuffer>(handle);
+  auto tensor_buffer =
+      litert::TensorBuffer::WrapCObject(tb, litert::OwnHandle::kNo);
+  if (!tensor_buffer.HasEvent()) {
+    return JNI_TRUE;
+  }
+  auto event = tensor_buffer.GetEvent();
+  if (!event) {
+    ThrowLiteRtException(env, event.Error().Status(), event.Error().Message());
+    return JNI_FALSE;
+  }
+  if (auto wait_result = event->Wait(timeout_ms); !wait_result) {
+    if (wait_result.Error().Status() == kLiteRtStatusErrorTimeoutExpired) {
+      return JNI_FALSE;
+    }
+    LITERT_LOG(LITERT_ERROR, "Failed to wait for tensor buffer event: %s",
+               wait_result.Error().Message().c_str());
+    ThrowLiteRtException(env, wait_result.Error().Status(),
+                         wait_result.Error().Message());
+    return JNI_FALSE;
+  }
+  return JNI_TRUE;
+}
+
 JNIEXPORT void JNICALL
 Java_com_google_ai_edge_litert_TensorBuffer_nativeDestroy(JNIEnv* env,
                                                           jclass clazz,
@@ -75,6 +75,26 @@ Java_com_google_ai_edge_litert_TensorBuffer_nativeReadLong(JNIEnv* env,
                                                            jclass clazz,
                                                            jlong handle);
 
+JNIEXPORT jint JNICALL
+Java_com_google_ai_edge_litert_TensorBuffer_nativeGetAlignmentOffset(
+    JNIEnv* env, jclass clazz, jobject buffer);
+
+JNIEXPORT jlong JNICALL
+Java_com_google_ai_edge_litert_TensorBuffer_nativeCreateFromDirectBuffer(
+    JNIEnv* env, jclass clazz, jint element_type, jintArray dimensions,
+    jobject buffer);
+
+JNIEXPORT jlong JNICALL
+Java_com_google_ai_edge_litert_TensorBuffer_nativeCreateFromHardwareBuffer(
+    JNIEnv* env, jclass clazz, jlong env_handle, jint element_type,
+    jintArray dimensions, jobject hardware_buffer, jint offset);
+
+JNIEXPORT jboolean JNICALL
+Java_com_google_ai_edge_litert_TensorBuffer_nativeWaitEvent(JNIEnv* env,
+                                                            jclass clazz,
+                                                            jlong handle,
+                                                            jlong timeout_ms);
+
 JNIEXPORT void JNICALL
 Java_com_google_ai_edge_litert_TensorBuffer_nativeDestroy(JNIEnv* env,
                                                           jclass clazz,
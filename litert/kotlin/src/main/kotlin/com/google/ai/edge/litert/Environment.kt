@@ -25,6 +25,17 @@ class Environment private constructor(handle: Long) : JniHandle(handle) {
     DispatchLibraryDir(1),
   }
 
+  /**
+   * Memory pressure levels to trim the memory at.
+   *
+   * [Moderate] matches `TRIM_MEMORY_RUNNING_LOW` and `TRIM_MEMORY_BACKGROUND` of Android, and
+   * [Critical] matches `TRIM_MEMORY_RUNNING_CRITICAL`, `TRIM_MEMORY_COMPLETE` and `onLowMemory`.
+   */
+  enum class TrimMemoryLevel private constructor(val value: Int) {
+    Moderate(1),
+    Critical(2),
+  }
+
   override protected fun destroy() {
     nativeDestroy(handle)
   }
@@ -38,6 +49,17 @@ class Environment private constructor(handle: Long) : JniHandle(handle) {
     return accelerators.map { Accelerator.of(it) }.toSet()
   }
 
+  /**
+   * Releases the memory that the environment and its compiled models can rebuild on demand, e.g.
+   * from `ComponentCallbacks2.onTrimMemory`. Returns the number of bytes freed.
+   */
+  @Throws(LiteRtException::class)
+  fun trimMemory(level: TrimMemoryLevel): Long {
+    assertNotDestroyed()
+
+    return nativeTrimMemory(handle, level.value)
+  }
+
   companion object {
     init {
       System.loadLibrary("litert_jni")
@@ -84,6 +106,8 @@ class Environment private constructor(handle: Long) : JniHandle(handle) {
 
     @JvmStatic private external fun nativeGetAvailableAccelerators(handle: Long): IntArray
 
+    @JvmStatic private external fun nativeTrimMemory(handle: Long, level: Int): Long
+
     @JvmStatic private external fun nativeDestroy(handle: Long)
   }
 }
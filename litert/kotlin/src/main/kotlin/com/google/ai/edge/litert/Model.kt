@@ -121,6 +121,25 @@ private constructor(
   private val envManaged: Boolean = false,
 ) : JniHandle(handle) {
 
+  /** The native buffers of the last run, which are reused while the same buffers are run. */
+  private class RunBinding(
+    val handle: Long,
+    val signatureIndex: Int,
+    val inputs: List<TensorBuffer>,
+    val outputs: List<TensorBuffer>,
+  ) {
+    fun matches(inputs: List<TensorBuffer>, outputs: List<TensorBuffer>, signatureIndex: Int) =
+      signatureIndex == this.signatureIndex &&
+        sameBuffers(inputs, this.inputs) &&
+        sameBuffers(outputs, this.outputs)
+
+    private fun sameBuffers(a: List<TensorBuffer>, b: List<TensorBuffer>) =
+      a.size == b.size && a.indices.all { a[it] === b[it] }
+  }
+
+  private val runBindingLock = Any()
+  private var runBinding: RunBinding? = null
+
   /** Options to specify CPU acceleration for compiling a model. */
   data class CpuOptions
   constructor(
@@ -317,13 +336,59 @@ private constructor(
   fun run(inputs: List<TensorBuffer>, outputs: List<TensorBuffer>, signatureIndex: Int = 0) {
     assertNotDestroyed()
 
-    nativeRun(
-      handle,
-      model.handle,
-      signatureIndex,
-      inputs.map { it.handle }.toLongArray(),
-      outputs.map { it.handle }.toLongArray(),
-    )
+    synchronized(runBindingLock) {
+      nativeRunBinding(getRunBinding(inputs, outputs, signatureIndex))
+    }
+  }
+
+  /**
+   * Runs the model asynchronously, if the accelerator supports it, otherwise synchronously.
+   *
+   * The outputs must not be read before the returned [RunCompletion] is awaited. Reading an
+   * output also waits for the run to complete.
+   */
+  @Throws(LiteRtException::class)
+  @JvmOverloads
+  fun runAsync(
+    inputs: List<TensorBuffer>,
+    outputs: List<TensorBuffer>,
+    signatureIndex: Int = 0,
+  ): RunCompletion {
+    assertNotDestroyed()
+
+    val isAsync =
+      synchronized(runBindingLock) {
+        nativeRunBindingAsync(getRunBinding(inputs, outputs, signatureIndex))
+      }
+    return RunCompletion(isAsync, outputs.toList())
+  }
+
+  /** Returns the binding of the given buffers, reusing the last one if the buffers are the same. */
+  private fun getRunBinding(
+    inputs: List<TensorBuffer>,
+    outputs: List<TensorBuffer>,
+    signatureIndex: Int,
+  ): Long {
+    val binding = runBinding
+    if (binding != null && binding.matches(inputs, outputs, signatureIndex)) {
+      return binding.handle
+    }
+    binding?.let { nativeDestroyRunBinding(it.handle) }
+    val newBinding =
+      RunBinding(
+        nativeCreateRunBinding(
+          handle,
+          model.handle,
+          signatureIndex,
+          inputs.map { it.handle }.toLongArray(),
+          outputs.map { it.handle }.toLongArray(),
+        ),
+        signatureIndex,
+        inputs.toList(),
+        outputs.toList(),
+      )
+    runBinding = newBinding
+    return newBinding.handle
   }
 
   @Throws(LiteRtException::class)
@@ -359,6 +424,10 @@ private constructor(
   }
 
   protected override fun destroy() {
+    synchronized(runBindingLock) {
+      runBinding?.let { nativeDestroyRunBinding(it.handle) }
+      runBinding = null
+    }
     nativeDestroy(handle)
     if (modelManaged) {
       model.close()
@@ -513,13 +582,19 @@ private constructor(
     ): LongArray
 
     @JvmStatic
-    private external fun nativeRun(
+    private external fun nativeCreateRunBinding(
       compiledModelHandle: Long,
       modelHandle: Long,
       signatureIndex: Int,
       inputBuffers: LongArray,
       outputBuffers: LongArray,
-    )
+    ): Long
+
+    @JvmStatic private external fun nativeRunBinding(bindingHandle: Long)
+
+    @JvmStatic private external fun nativeRunBindingAsync(bindingHandle: Long): Boolean
+
+    @JvmStatic private external fun nativeDestroyRunBinding(bindingHandle: Long)
 
     @JvmStatic
     private external fun nativeRunBySignature(
@@ -544,3 +619,17 @@ private constructor(
     @JvmStatic private external fun nativeDestroy(handle: Long)
   }
 }
+
+/** The completion of [CompiledModel.runAsync], tied to the events of the output buffers. */
+class RunCompletion
+internal constructor(val isAsync: Boolean, private val outputs: List<TensorBuffer>) {
+  /**
+   * Waits for all the outputs to be written, up to [timeoutMs] milliseconds each, or indefinitely
+   * if negative. Returns false if the timeout expired.
+   */
+  @Throws(LiteRtException::class)
+  @JvmOverloads
+  fun await(timeoutMs: Long = -1): Boolean {
+    return outputs.all { it.waitEvent(timeoutMs) }
+  }
+}
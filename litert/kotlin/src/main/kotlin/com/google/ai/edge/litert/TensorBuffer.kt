@@ -16,8 +16,19 @@
 
 package com.google.ai.edge.litert
 
-/** TensorBuffer represents the raw memory where tensor data is stored. */
-class TensorBuffer internal constructor(handle: Long) : JniHandle(handle) {
+import android.hardware.HardwareBuffer
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * TensorBuffer represents the raw memory where tensor data is stored.
+ *
+ * @param backingObject the object owning the memory of a TensorBuffer that wraps it, which is kept
+ *   alive as long as the TensorBuffer.
+ */
+class TensorBuffer
+internal constructor(handle: Long, @Suppress("unused") private val backingObject: Any? = null) :
+  JniHandle(handle) {
   // TODO(niuchl): Add support for different types of tensor buffers.
   // TODO(niuchl): Add tests for different element types.
 
@@ -91,6 +102,18 @@ class TensorBuffer internal constructor(handle: Long) : JniHandle(handle) {
     return nativeReadLong(handle)
   }
 
+  /**
+   * Waits for the pending write of an asynchronous run to this buffer, up to [timeoutMs]
+   * milliseconds, or indefinitely if negative. Returns false if the timeout expired.
+   */
+  @Throws(LiteRtException::class)
+  @JvmOverloads
+  fun waitEvent(timeoutMs: Long = -1): Boolean {
+    assertNotDestroyed()
+
+    return nativeWaitEvent(handle, timeoutMs)
+  }
+
   protected override fun destroy() {
     nativeDestroy(handle)
   }
@@ -100,6 +123,88 @@ class TensorBuffer internal constructor(handle: Long) : JniHandle(handle) {
       System.loadLibrary("litert_jni")
     }
 
+    /** Alignment of the memory wrapped by a TensorBuffer. */
+    private const val HOST_MEMORY_ALIGNMENT = 64
+
+    /**
+     * Allocates a direct ByteBuffer in native byte order, aligned for [createFromDirectByteBuffer].
+     */
+    @JvmStatic
+    fun allocateAlignedDirectByteBuffer(size: Int): ByteBuffer {
+      val buffer = ByteBuffer.allocateDirect(size + HOST_MEMORY_ALIGNMENT)
+      val offset = nativeGetAlignmentOffset(buffer)
+      buffer.position(offset)
+      buffer.limit(offset + size)
+      return buffer.slice().order(ByteOrder.nativeOrder())
+    }
+
+    /**
+     * Creates a TensorBuffer that wraps the memory of a direct ByteBuffer, without copying it.
+     *
+     * The whole capacity of the buffer is used, regardless of its position and limit, and its
+     * address must be aligned to 64 bytes, as with [allocateAlignedDirectByteBuffer].
+     */
+    @Throws(LiteRtException::class)
+    @JvmStatic
+    fun createFromDirectByteBuffer(tensorType: TensorType, buffer: ByteBuffer): TensorBuffer {
+      require(buffer.isDirect) { "The ByteBuffer must be direct." }
+      val layout = requireNotNull(tensorType.layout) { "The tensor type must have a layout." }
+
+      val handle =
+        nativeCreateFromDirectBuffer(
+          tensorType.elementType.ordinal,
+          layout.dimensions.toIntArray(),
+          buffer,
+        )
+      return TensorBuffer(handle, buffer)
+    }
+
+    /**
+     * Creates a TensorBuffer that wraps a HardwareBuffer, without copying it. The tensor data
+     * starts at [offset] bytes in the HardwareBuffer. Requires Android API level 26.
+     */
+    @Throws(LiteRtException::class)
+    @JvmOverloads
+    @JvmStatic
+    fun createFromHardwareBuffer(
+      env: Environment,
+      tensorType: TensorType,
+      hardwareBuffer: HardwareBuffer,
+      offset: Int = 0,
+    ): TensorBuffer {
+      val layout = requireNotNull(tensorType.layout) { "The tensor type must have a layout." }
+
+      val handle =
+        nativeCreateFromHardwareBuffer(
+          env.handle,
+          tensorType.elementType.ordinal,
+          layout.dimensions.toIntArray(),
+          hardwareBuffer,
+          offset,
+        )
+      return TensorBuffer(handle, hardwareBuffer)
+    }
+
+    @JvmStatic private external fun nativeGetAlignmentOffset(buffer: ByteBuffer): Int
+
+    @JvmStatic
+    private external fun nativeCreateFromDirectBuffer(
+      elementType: Int,
+      dimensions: IntArray,
+      buffer: ByteBuffer,
+    ): Long
+
+    @JvmStatic
+    private external fun nativeCreateFromHardwareBuffer(
+      envHandle: Long,
+      elementType: Int,
+      dimensions: IntArray,
+      hardwareBuffer: HardwareBuffer,
+      offset: Int,
+    ): Long
+
+    @JvmStatic private external fun nativeWaitEvent(handle: Long, timeoutMs: Long): Boolean
+
     @JvmStatic private external fun nativeWriteInt(handle: Long, data: IntArray)
 
     @JvmStatic private external fun nativeWriteFloat(handle: Long, data: FloatArray)
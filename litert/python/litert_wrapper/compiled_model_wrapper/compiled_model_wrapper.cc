@@ -416,6 +416,9 @@ PyObject* CompiledModelWrapper::RunByName(const char* signature_key,
     return ReportError("RunByName expects input_map & output_map as dict");
   }
 
+  // The names are copied so that they stay valid once the GIL is released.
+  std::vector<std::string> names;
+  names.reserve(PyDict_Size(input_map) + PyDict_Size(output_map));
   absl::flat_hash_map<absl::string_view, TensorBuffer> in_map;
   absl::flat_hash_map<absl::string_view, TensorBuffer> out_map;
 
@@ -436,8 +439,8 @@ PyObject* CompiledModelWrapper::RunByName(const char* signature_key,
     if (!ptr) {
       return ReportError("capsule missing pointer in input_map");
     }
-    in_map[nm] = TensorBuffer::WrapCObject(static_cast<LiteRtTensorBuffer>(ptr),
-                                           OwnHandle::kNo);
+    in_map[names.emplace_back(nm)] = TensorBuffer::WrapCObject(
+        static_cast<LiteRtTensorBuffer>(ptr), OwnHandle::kNo);
   }
 
   pos = 0;
@@ -455,12 +458,17 @@ PyObject* CompiledModelWrapper::RunByName(const char* signature_key,
     if (!ptr) {
       return ReportError("capsule missing pointer in output_map");
     }
-    out_map[nm] = TensorBuffer::WrapCObject(
+    out_map[names.emplace_back(nm)] = TensorBuffer::WrapCObject(
         static_cast<LiteRtTensorBuffer>(ptr), OwnHandle::kNo);
   }
 
-  if (auto run_or = compiled_model_.Run(signature_key, in_map, out_map);
-      !run_or) {
+  PyThreadState* thread_state = PyEval_SaveThread();
+  auto run_or = [&] {
+    absl::MutexLock lock(&run_mutex_);
+    return compiled_model_.Run(signature_key, in_map, out_map);
+  }();
+  PyEval_RestoreThread(thread_state);
+  if (!run_or) {
     return ConvertErrorToPyExc(run_or.Error());
   }
   Py_RETURN_NONE;
@@ -510,9 +518,14 @@ PyObject* CompiledModelWrapper::RunByIndex(int signature_index,
         static_cast<LiteRtTensorBuffer>(ptr), OwnHandle::kNo));
   }
 
-  if (auto run_or = compiled_model_.Run(static_cast<size_t>(signature_index),
-                                        inputs, outputs);
-      !run_or) {
+  PyThreadState* thread_state = PyEval_SaveThread();
+  auto run_or = [&] {
+    absl::MutexLock lock(&run_mutex_);
+    return compiled_model_.Run(static_cast<size_t>(signature_index), inputs,
+                               outputs);
+  }();
+  PyEval_RestoreThread(thread_state);
+  if (!run_or) {
     return ConvertErrorToPyExc(run_or.Error());
   }
   Py_RETURN_NONE;
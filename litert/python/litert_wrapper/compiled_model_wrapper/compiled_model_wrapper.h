@@ -19,6 +19,8 @@
 
 #include <string>
 
+#include "absl/base/thread_annotations.h"  // from @com_google_absl
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
 #include "litert/cc/internal/litert_extended_model.h"
 #include "litert/cc/litert_compiled_model.h"
 #include "litert/cc/litert_environment.h"
@@ -127,10 +129,13 @@ class CompiledModelWrapper {
   PyObject* CreateOutputBuffers(int signature_index);
 
   // Executes the model using a signature key and name-to-buffer mappings.
+  // The GIL is released while the model runs, so the buffers must not be
+  // destroyed by another thread before this returns.
   PyObject* RunByName(const char* signature_key, PyObject* input_map,
                       PyObject* output_map);
 
   // Executes the model using a signature index and lists of buffer capsules.
+  // Releases the GIL like RunByName().
   PyObject* RunByIndex(int signature_index, PyObject* input_caps_list,
                        PyObject* output_caps_list);
 
@@ -149,6 +154,9 @@ class CompiledModelWrapper {
   ExtendedModel model_;
   litert::CompiledModel compiled_model_;
 
+  // Serializes the runs, which the GIL no longer does.
+  absl::Mutex run_mutex_;
+
   // Python buffer object to keep it alive for models created from buffer
   PyObject* model_buffer_ = nullptr;
 };
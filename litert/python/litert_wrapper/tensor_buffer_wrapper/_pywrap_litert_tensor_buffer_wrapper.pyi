@@ -24,6 +24,9 @@ def CreateTensorBufferFromHostMemory(
 ) -> object:
     """Creates a TensorBuffer from existing host memory.
 
+    The memory is not copied. It must be C-contiguous and aligned to 64 bytes,
+    and py_data is kept alive until the tensor buffer is destroyed.
+
     Args:
       py_data: Python data to be used as the source for the tensor buffer.
         Can be a NumPy array (e.g., np.array([[1.0, 2.0, 3.0, 4.0]], dtype=np.float32)).
@@ -71,6 +74,30 @@ def ReadTensor(
     """
     ...
 
+class TensorBufferHostView:
+    """A locked TensorBuffer exposing its host memory as a flat byte buffer.
+
+    Supports the buffer protocol, e.g. np.frombuffer(view, dtype=np.float32).
+    The TensorBuffer is unlocked once the view is garbage collected.
+    """
+    ...
+
+def LockTensor(
+        capsule: object,
+        writable: bool = False
+) -> TensorBufferHostView:
+    """Locks the tensor buffer and returns a view over its host memory.
+
+    Args:
+      capsule: PyCapsule object containing the LiteRT TensorBuffer.
+      writable: Whether the view can be written to.
+
+    Returns:
+      A TensorBufferHostView over the memory of the tensor buffer. The data is
+      not copied.
+    """
+    ...
+
 def DestroyTensorBuffer(
         capsule: object
 ) -> None:
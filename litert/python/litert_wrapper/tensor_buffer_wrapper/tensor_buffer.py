@@ -28,6 +28,9 @@ else:
   from ai_edge_litert import _pywrap_litert_tensor_buffer_wrapper as _tb
 # pylint: enable=g-import-not-at-top
 
+# Matches LITERT_HOST_MEMORY_BUFFER_ALIGNMENT.
+_HOST_MEMORY_ALIGNMENT = 64
+
 
 class TensorBuffer:
   """Python wrapper for LiteRtTensorBuffer.
@@ -73,6 +76,10 @@ class TensorBuffer:
   def create_from_host_memory(cls, data_array):
     """Creates a new TensorBuffer referencing existing host memory.
 
+    The data is not copied: the TensorBuffer keeps data_array alive and reads
+    and writes its memory directly. The array must be C-contiguous and aligned
+    to 64 bytes, e.g. allocated with TensorBuffer.aligned_empty().
+
     Args:
       data_array: A NumPy array (e.g., np.array([[1.0, 2.0, 3.0, 4.0]],
         dtype=np.float32)). The dtype of the array is used.
@@ -94,6 +101,62 @@ class TensorBuffer:
     )
     return cls(cap)
 
+  @classmethod
+  def create_from_dlpack(cls, tensor):
+    """Creates a new TensorBuffer referencing the memory of a DLPack tensor.
+
+    The data is not copied, see create_from_host_memory().
+
+    Args:
+      tensor: A CPU tensor implementing __dlpack__ (e.g., a torch.Tensor or a
+        jax.Array), or a DLPack capsule.
+
+    Returns:
+      A new TensorBuffer instance.
+
+    Raises:
+      ValueError: If the tensor has an unsupported dtype.
+    """
+    return cls.create_from_host_memory(np.from_dlpack(tensor))
+
+  @staticmethod
+  def aligned_empty(shape, dtype):
+    """Returns an uninitialized NumPy array for create_from_host_memory().
+
+    Args:
+      shape: Shape of the array.
+      dtype: NumPy dtype of the array (e.g., np.float32).
+
+    Returns:
+      A C-contiguous NumPy array aligned to 64 bytes.
+    """
+    dtype = np.dtype(dtype)
+    num_bytes = int(np.prod(shape)) * dtype.itemsize
+    raw = np.empty(num_bytes + _HOST_MEMORY_ALIGNMENT, dtype=np.uint8)
+    offset = -raw.ctypes.data % _HOST_MEMORY_ALIGNMENT
+    return raw[offset : offset + num_bytes].view(dtype).reshape(shape)
+
+  def numpy_view(self, dtype, shape=None, writable=False):
+    """Returns a NumPy array viewing the memory of this tensor buffer.
+
+    The data is not copied. The tensor buffer stays locked until the returned
+    array, and every array derived from it, is garbage collected, so the view
+    must not be kept across model runs.
+
+    Args:
+      dtype: NumPy dtype of the elements (e.g., np.float32, np.int8).
+      shape: Optional shape of the view. Defaults to a flat array over the
+        whole buffer.
+      writable: Whether the view can be written to.
+
+    Returns:
+      A NumPy array over the locked tensor buffer.
+    """
+    view = np.frombuffer(_tb.LockTensor(self.capsule, writable), dtype=dtype)
+    if shape is not None:
+      view = view.reshape(shape)
+    return view
+
   def write(self, data_array):
     """Writes data to this tensor buffer.
 
@@ -107,13 +170,20 @@ class TensorBuffer:
       tensor_buffer.write(test_input)
 
     Raises:
-      ValueError: If the input is not a NumPy array or has an unsupported dtype.
+      ValueError: If the input is not a NumPy array, has an unsupported dtype,
+        or does not fit in the tensor buffer.
     """
     if not isinstance(data_array, np.ndarray):
       raise ValueError("data_array must be a NumPy array")
 
-    dtype_str = self._dtype_to_str(data_array.dtype)
-    _tb.WriteTensor(self._capsule, data_array.flatten().tolist(), dtype_str)
+    self._dtype_to_str(data_array.dtype)
+    view = self.numpy_view(data_array.dtype, writable=True)
+    if data_array.size > view.size:
+      raise ValueError(
+          f"data_array has {data_array.size} elements, but the tensor buffer"
+          f" holds {view.size}"
+      )
+    view[: data_array.size] = data_array.ravel()
 
   def read(self, num_elements: int, output_dtype):
     """Reads data from this tensor buffer.
@@ -130,16 +200,22 @@ class TensorBuffer:
       output_array = tensor_buffer.read(4, np.float32).reshape((1, 4))
 
     Raises:
-      ValueError: If output_dtype is not a NumPy dtype or is not supported.
+      ValueError: If output_dtype is not a NumPy dtype or is not supported, or
+        if the tensor buffer holds fewer than num_elements elements.
     """
     if not isinstance(output_dtype, type) or not hasattr(
         np, output_dtype.__name__
     ):
       raise ValueError(f"output_dtype must be a NumPy dtype (e.g., np.float32)")
 
-    dtype_str = self._dtype_to_str(output_dtype)
-    data_list = _tb.ReadTensor(self._capsule, num_elements, dtype_str)
-    return np.array(data_list, dtype=output_dtype)
+    self._dtype_to_str(output_dtype)
+    view = self.numpy_view(output_dtype)
+    if num_elements > view.size:
+      raise ValueError(
+          f"Cannot read {num_elements} elements, the tensor buffer holds"
+          f" {view.size}"
+      )
+    return view[:num_elements].copy()
 
   def destroy(self):
     """Explicitly releases resources associated with this tensor buffer.
@@ -19,13 +19,16 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_model.h"
 #include "litert/c/litert_tensor_buffer.h"
+#include "litert/c/litert_tensor_buffer_types.h"
 #include "litert/cc/internal/litert_handle.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_tensor_buffer.h"
@@ -155,6 +158,60 @@ size_t TensorBufferWrapper::ByteWidthOfDType(const std::string& dtype) {
   return 0;
 }
 
+TensorBufferHostView::TensorBufferHostView(PyObject* buffer_capsule,
+                                           TensorBuffer tensor_buffer,
+                                           void* data, size_t size,
+                                           bool writable)
+    : buffer_capsule_(buffer_capsule),
+      tensor_buffer_(std::move(tensor_buffer)),
+      data_(data),
+      size_(size),
+      writable_(writable) {
+  Py_INCREF(buffer_capsule_);
+}
+
+TensorBufferHostView::~TensorBufferHostView() {
+  // The capsule may have been destroyed explicitly while the view was alive,
+  // in which case there is nothing left to unlock.
+  if (PyCapsule_IsValid(buffer_capsule_,
+                        litert_wrapper_utils::kLiteRtTensorBufferName.data())) {
+    (void)tensor_buffer_.Unlock();
+  }
+  Py_DECREF(buffer_capsule_);
+}
+
+// Locks the TensorBuffer so that its host memory can be viewed from Python
+// without copying.
+std::unique_ptr<TensorBufferHostView> TensorBufferHostView::Create(
+    PyObject* buffer_capsule, bool writable) {
+  if (!PyCapsule_CheckExact(buffer_capsule)) {
+    TensorBufferWrapper::ReportError("LockTensor: invalid capsule");
+    return nullptr;
+  }
+  void* ptr = PyCapsule_GetPointer(
+      buffer_capsule, litert_wrapper_utils::kLiteRtTensorBufferName.data());
+  if (!ptr) {
+    TensorBufferWrapper::ReportError("LockTensor: null pointer in capsule");
+    return nullptr;
+  }
+  TensorBuffer tb = TensorBuffer::WrapCObject(
+      static_cast<LiteRtTensorBuffer>(ptr), OwnHandle::kNo);
+
+  auto size = tb.PackedSize();
+  if (!size) {
+    TensorBufferWrapper::ConvertErrorToPyExc(size.Error());
+    return nullptr;
+  }
+  auto data = tb.Lock(writable ? TensorBuffer::LockMode::kReadWrite
+                               : TensorBuffer::LockMode::kRead);
+  if (!data) {
+    TensorBufferWrapper::ConvertErrorToPyExc(data.Error());
+    return nullptr;
+  }
+  return std::unique_ptr<TensorBufferHostView>(new TensorBufferHostView(
+      buffer_capsule, std::move(tb), *data, *size, writable));
+}
+
 // Creates a TensorBuffer from existing host memory.
 // The memory is referenced, not copied, so the original data must outlive
 // the TensorBuffer unless it's explicitly copied.
@@ -177,6 +234,13 @@ PyObject* TensorBufferWrapper::CreateFromHostMemory(PyObject* py_data,
     PyBuffer_Release(&py_buf);
     return ReportError("Python buffer is too small for required size");
   }
+  if (reinterpret_cast<uintptr_t>(py_buf.buf) %
+      LITERT_HOST_MEMORY_BUFFER_ALIGNMENT) {
+    PyBuffer_Release(&py_buf);
+    return ReportError(
+        "Python buffer is not aligned to " +
+        std::to_string(LITERT_HOST_MEMORY_BUFFER_ALIGNMENT) + " bytes");
+  }
 
   // Create a LiteRtRankedTensorType for 1-D shape
   LiteRtRankedTensorType dummy_type;
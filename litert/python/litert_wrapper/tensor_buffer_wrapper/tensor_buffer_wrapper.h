@@ -17,6 +17,8 @@
 
 #include <Python.h>
 
+#include <cstddef>
+#include <memory>
 #include <string>
 
 #include "litert/cc/litert_model.h"
@@ -24,6 +26,46 @@
 
 namespace litert::tensor_buffer_wrapper {
 
+/**
+ * Keeps a TensorBuffer locked while Python holds views over its host memory.
+ *
+ * The view holds a reference to the capsule of the TensorBuffer, so the buffer
+ * outlives the view, and unlocks the buffer when it is destroyed.
+ */
+class TensorBufferHostView {
+ public:
+  /**
+   * Locks a TensorBuffer and returns a view over its host memory.
+   *
+   * @param buffer_capsule Python capsule containing the LiteRtTensorBuffer.
+   * @param writable Whether the view can be written to. Writable views lock
+   * the buffer for read and write, so that a device buffer is synced back.
+   * @return The view, or nullptr with a Python exception set on error.
+   */
+  static std::unique_ptr<TensorBufferHostView> Create(PyObject* buffer_capsule,
+                                                      bool writable);
+
+  ~TensorBufferHostView();
+
+  TensorBufferHostView(const TensorBufferHostView&) = delete;
+  TensorBufferHostView& operator=(const TensorBufferHostView&) = delete;
+
+  void* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool writable() const { return writable_; }
+
+ private:
+  TensorBufferHostView(PyObject* buffer_capsule, TensorBuffer tensor_buffer,
+                       void* data, size_t size, bool writable);
+
+  // Strong reference to the capsule that owns tensor_buffer_.
+  PyObject* buffer_capsule_;
+  TensorBuffer tensor_buffer_;
+  void* data_;
+  size_t size_;
+  bool writable_;
+};
+
 /**
  * Wrapper class for LiteRtTensorBuffer operations exposed to Python.
  *
@@ -37,6 +79,10 @@ class TensorBufferWrapper {
   /**
    * Creates a TensorBuffer from host memory and returns it as a Python capsule.
    *
+   * The memory is not copied. py_data must export a C-contiguous buffer
+   * aligned to LITERT_HOST_MEMORY_BUFFER_ALIGNMENT bytes, and is kept alive
+   * until the capsule is destroyed.
+   *
    * @param py_data Python object containing the source data.
    * @param dtype String representation of the data type (e.g., "float32").
    * @param num_elements Number of elements in the tensor.
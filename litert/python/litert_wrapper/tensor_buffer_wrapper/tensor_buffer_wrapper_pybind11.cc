@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -23,6 +24,7 @@
 
 namespace py = pybind11;
 
+using litert::tensor_buffer_wrapper::TensorBufferHostView;
 using litert::tensor_buffer_wrapper::TensorBufferWrapper;
 
 PYBIND11_MODULE(_pywrap_litert_tensor_buffer_wrapper, m) {
@@ -65,6 +67,30 @@ PYBIND11_MODULE(_pywrap_litert_tensor_buffer_wrapper, m) {
           return py::reinterpret_steal<py::object>(res);
         });
 
+  // A locked TensorBuffer exposing its host memory as a flat byte buffer, so
+  // that e.g. np.frombuffer() can view it without copying. The buffer stays
+  // locked until the view and every array over it are garbage collected.
+  py::class_<TensorBufferHostView>(m, "TensorBufferHostView",
+                                   py::buffer_protocol())
+      .def_buffer([](TensorBufferHostView& view) {
+        return py::buffer_info(
+            view.data(), /*itemsize=*/1,
+            py::format_descriptor<uint8_t>::format(), /*ndim=*/1,
+            {static_cast<py::ssize_t>(view.size())}, /*strides=*/{1},
+            /*readonly=*/!view.writable());
+      });
+
+  // Locks a TensorBuffer and returns a TensorBufferHostView over its host
+  // memory. The data is not copied.
+  m.def(
+      "LockTensor",
+      [](py::object capsule, bool writable) {
+        auto view = TensorBufferHostView::Create(capsule.ptr(), writable);
+        if (!view) throw py::error_already_set();
+        return view;
+      },
+      py::arg("capsule"), py::arg("writable") = false);
+
   // Destroys a TensorBuffer and releases associated resources.
   // This should be called when the TensorBuffer is no longer needed.
   m.def("DestroyTensorBuffer", [](py::object capsule) {
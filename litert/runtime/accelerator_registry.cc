@@ -14,9 +14,14 @@
 
 #include "litert/runtime/accelerator_registry.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <utility>
+#include <vector>
 
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
 #include "litert/cc/internal/litert_shared_library.h"
@@ -54,8 +59,42 @@ Expected<LiteRtAcceleratorT*> AcceleratorRegistry::RegisterAccelerator(
     return Error(kLiteRtStatusErrorInvalidArgument,
                  "Cannot register a null accelerator.");
   }
-  accelerators_.push_back(std::move(accelerator));
-  return accelerators_.back().get();
+  const int64_t rank = loading_rank_ >= 0 ? loading_rank_ : next_rank_++;
+  const auto position =
+      std::distance(ranks_.begin(),
+                    std::upper_bound(ranks_.begin(), ranks_.end(), rank));
+  ranks_.insert(ranks_.begin() + position, rank);
+  return accelerators_.insert(accelerators_.begin() + position,
+                              std::move(accelerator))
+      ->get();
+}
+
+void AcceleratorRegistry::RegisterLazyAccelerator(
+    LiteRtHwAcceleratorSet hardware, Loader load) {
+  absl::MutexLock lock(load_mutex_);
+  lazy_accelerators_.push_back({hardware, std::move(load), next_rank_++});
+}
+
+void AcceleratorRegistry::LoadAccelerators(LiteRtHwAcceleratorSet hardware) {
+  absl::MutexLock lock(load_mutex_);
+  std::vector<LazyAccelerator> remaining;
+  for (LazyAccelerator& lazy_accelerator : lazy_accelerators_) {
+    if (!(lazy_accelerator.hardware & hardware)) {
+      remaining.push_back(std::move(lazy_accelerator));
+      continue;
+    }
+    loading_rank_ = lazy_accelerator.rank;
+    if (auto loaded = lazy_accelerator.load(); !loaded) {
+      LITERT_LOG(LITERT_WARNING, "Failed to load accelerator: %s",
+                 loaded.Error().Message().c_str());
+    }
+    loading_rank_ = -1;
+  }
+  lazy_accelerators_ = std::move(remaining);
+}
+
+void AcceleratorRegistry::LoadAllAccelerators() {
+  LoadAccelerators(~LiteRtHwAcceleratorSet{kLiteRtHwAcceleratorNone});
 }
 
 Expected<LiteRtAcceleratorT*> AcceleratorRegistry::Get(LiteRtParamIndex idx) {
@@ -16,9 +16,13 @@
 #define ODML_LITERT_LITERT_RUNTIME_ACCELERATOR_REGISTRY_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"  // from @com_google_absl
+#include "absl/functional/any_invocable.h"  // from @com_google_absl
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/cc/internal/litert_shared_library.h"
 #include "litert/cc/litert_expected.h"
@@ -54,6 +58,24 @@ class AcceleratorRegistry {
   // Registers an accelerator.
   Expected<LiteRtAcceleratorT*> RegisterAccelerator(Ptr accelerator);
 
+  // Loads an accelerator, usually from a shared library, and registers it.
+  using Loader = absl::AnyInvocable<Expected<void>()>;
+
+  // Registers an accelerator for `hardware` that is only loaded once a model
+  // requests that hardware, to save the cost of loading its library when it
+  // isn't used.
+  //
+  // The accelerators that `load` registers take the place of this call in the
+  // registration order.
+  void RegisterLazyAccelerator(LiteRtHwAcceleratorSet hardware, Loader load);
+
+  // Loads the lazily registered accelerators for any of `hardware`. An
+  // accelerator that fails to load is logged and never retried.
+  void LoadAccelerators(LiteRtHwAcceleratorSet hardware);
+
+  // Loads all the lazily registered accelerators.
+  void LoadAllAccelerators();
+
   // Returns the idx-th accelerator that was registered.
   [[nodiscard]]
   Expected<LiteRtAcceleratorT*> Get(LiteRtParamIndex idx);
@@ -70,7 +92,8 @@ class AcceleratorRegistry {
   // The library will be closed when the registry is destroyed.
   void TakeOwnershipOfSharedLibrary(SharedLibrary library);
 
-  // Returns the number of accelerators that have been registered.
+  // Returns the number of accelerators that have been registered, not
+  // counting the lazily registered ones that are not loaded yet.
   size_t size() const { return accelerators_.size(); }
   auto begin() const { return accelerators_.begin(); }
   auto begin() { return accelerators_.begin(); }
@@ -78,6 +101,13 @@ class AcceleratorRegistry {
   auto end() { return accelerators_.end(); }
 
  private:
+  struct LazyAccelerator {
+    LiteRtHwAcceleratorSet hardware;
+    Loader load;
+    // Position of the accelerator in the registration order.
+    int64_t rank;
+  };
+
   // Warning: the order of these members is VERY important. When the
   // accelerators are destroyed they call into functions that are in their
   // libraries. This means that the libraries must be released AFTER the
@@ -91,6 +121,17 @@ class AcceleratorRegistry {
   // libraries loaded while the environment uses them.
   std::vector<SharedLibrary> accelerator_shared_libraries_;
   std::vector<Ptr> accelerators_;
+  // Position of each accelerator in the registration order, which is
+  // increasing.
+  std::vector<int64_t> ranks_;
+  int64_t next_rank_ = 0;
+  // Rank given to the accelerators registered while a lazy accelerator loads.
+  int64_t loading_rank_ = -1;
+
+  // Serializes the loading of lazy accelerators.
+  absl::Mutex load_mutex_;
+  std::vector<LazyAccelerator> lazy_accelerators_
+      ABSL_GUARDED_BY(load_mutex_);
 };
 
 }  // namespace litert::internal
@@ -0,0 +1,188 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/accelerator_selection.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#ifdef __ANDROID__
+#include <sys/system_properties.h>
+#else
+#include <sys/utsname.h>
+#endif  // __ANDROID__
+
+#include "absl/base/thread_annotations.h"  // from @com_google_absl
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/strings/str_cat.h"  // from @com_google_absl
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "flatbuffers/flatbuffer_builder.h"  // from @flatbuffers
+#include "litert/c/internal/litert_logging.h"
+#include "litert/c/litert_common.h"
+#include "litert/core/cache/hash_util.h"
+#include "litert/core/filesystem.h"
+#include "tflite/acceleration/configuration/configuration_generated.h"
+#include "tflite/experimental/acceleration/mini_benchmark/mini_benchmark.h"
+
+namespace litert::internal {
+namespace {
+
+constexpr absl::string_view kModelNamespace = "litert";
+
+#ifdef __ANDROID__
+std::string GetSystemProperty(const char* name) {
+  char value[PROP_VALUE_MAX];
+  if (__system_property_get(name, value) <= 0) {
+    return "";
+  }
+  return value;
+}
+#endif  // __ANDROID__
+
+// The mini-benchmarks of the process, by model id. A mini-benchmark that was
+// started must outlive its run, so they are never destroyed.
+class MiniBenchmarks {
+ public:
+  static MiniBenchmarks& Get() {
+    static auto* mini_benchmarks = new MiniBenchmarks;
+    return *mini_benchmarks;
+  }
+
+  LiteRtHwAcceleratorSet Select(absl::string_view cache_dir,
+                                absl::string_view model_path,
+                                const std::string& model_id,
+                                LiteRtHwAcceleratorSet fallback_accelerators) {
+    absl::MutexLock lock(mutex_);
+    Entry& entry = entries_[model_id];
+    if (entry.mini_benchmark == nullptr) {
+      entry.mini_benchmark = Create(cache_dir, model_path, model_id);
+    }
+    const tflite::ComputeSettingsT best =
+        entry.mini_benchmark->GetBestAcceleration();
+    if (best.tflite_settings != nullptr) {
+      const LiteRtHwAcceleratorSet accelerators =
+          GetAcceleratorsForSettings(*best.tflite_settings);
+      if (accelerators != kLiteRtHwAcceleratorNone) {
+        return accelerators;
+      }
+    }
+    if (!entry.started && !model_path.empty()) {
+      LITERT_LOG(LITERT_INFO,
+                 "Starting the accelerator selection of model %s in %s.",
+                 model_id.c_str(), std::string(cache_dir).c_str());
+      entry.mini_benchmark->TriggerMiniBenchmark();
+      entry.started = true;
+    }
+    return fallback_accelerators;
+  }
+
+ private:
+  struct Entry {
+    std::unique_ptr<tflite::acceleration::MiniBenchmark> mini_benchmark;
+    bool started = false;
+  };
+
+  static std::unique_ptr<tflite::acceleration::MiniBenchmark> Create(
+      absl::string_view cache_dir, absl::string_view model_path,
+      const std::string& model_id) {
+    tflite::MinibenchmarkSettingsT settings;
+    // The mini-benchmark tests the CPU too.
+    auto gpu_settings = std::make_unique<tflite::TFLiteSettingsT>();
+    gpu_settings->delegate = tflite::Delegate_GPU;
+    settings.settings_to_test.push_back(std::move(gpu_settings));
+    settings.model_file = std::make_unique<tflite::ModelFileT>();
+    settings.model_file->filename = std::string(model_path);
+    settings.storage_paths = std::make_unique<tflite::BenchmarkStoragePathsT>();
+    settings.storage_paths->storage_file_path = Join(
+        {cache_dir, absl::StrCat("accelerator_selection_", model_id, ".fb")});
+    settings.storage_paths->data_directory_path = std::string(cache_dir);
+
+    flatbuffers::FlatBufferBuilder fbb;
+    fbb.Finish(tflite::MinibenchmarkSettings::Pack(fbb, &settings));
+    return tflite::acceleration::CreateMiniBenchmark(
+        *flatbuffers::GetRoot<tflite::MinibenchmarkSettings>(
+            fbb.GetBufferPointer()),
+        std::string(kModelNamespace), model_id);
+  }
+
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, Entry> entries_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace
+
+std::string GetAcceleratorSelectionDeviceId() {
+#ifdef __ANDROID__
+  return absl::StrCat(GetSystemProperty("ro.product.manufacturer"), "/",
+                      GetSystemProperty("ro.product.model"));
+#else
+  struct utsname name;
+  if (uname(&name) != 0) {
+    return "";
+  }
+  return absl::StrCat(name.sysname, "/", name.machine);
+#endif  // __ANDROID__
+}
+
+std::string GetAcceleratorSelectionDriverId() {
+#ifdef __ANDROID__
+  // The drivers are part of the Android image.
+  return GetSystemProperty("ro.build.fingerprint");
+#else
+  struct utsname name;
+  if (uname(&name) != 0) {
+    return "";
+  }
+  return absl::StrCat(name.release, "/", name.version);
+#endif  // __ANDROID__
+}
+
+std::string GetAcceleratorSelectionModelId(absl::Span<const uint8_t> model,
+                                           absl::string_view device_id,
+                                           absl::string_view driver_id) {
+  uint64_t hash = StableHash(model.data(), model.size());
+  HashCombine(hash, std::string(device_id), std::string(driver_id));
+  return absl::StrFormat("%016x", hash);
+}
+
+LiteRtHwAcceleratorSet GetAcceleratorsForSettings(
+    const tflite::TFLiteSettingsT& settings) {
+  switch (settings.delegate) {
+    case tflite::Delegate_NONE:
+    case tflite::Delegate_XNNPACK:
+      return kLiteRtHwAcceleratorCpu;
+    case tflite::Delegate_GPU:
+      return kLiteRtHwAcceleratorGpu | kLiteRtHwAcceleratorCpu;
+    default:
+      return kLiteRtHwAcceleratorNone;
+  }
+}
+
+LiteRtHwAcceleratorSet SelectAccelerators(
+    absl::string_view cache_dir, absl::string_view model_path,
+    absl::Span<const uint8_t> model,
+    LiteRtHwAcceleratorSet fallback_accelerators) {
+  const std::string model_id = GetAcceleratorSelectionModelId(
+      model, GetAcceleratorSelectionDeviceId(),
+      GetAcceleratorSelectionDriverId());
+  return MiniBenchmarks::Get().Select(cache_dir, model_path, model_id,
+                                      fallback_accelerators);
+}
+
+}  // namespace litert::internal
@@ -0,0 +1,71 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_RUNTIME_ACCELERATOR_SELECTION_H_
+#define ODML_LITERT_LITERT_RUNTIME_ACCELERATOR_SELECTION_H_
+
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+#include "tflite/acceleration/configuration/configuration_generated.h"
+
+namespace litert::internal {
+
+// Selects the accelerators of a model with the TFLite mini-benchmark, which
+// runs the model on each accelerator in the background, checks its results
+// and persists the fastest configuration in its storage.
+//
+// The selection is stored per model, device and driver, so a model update or
+// a system update, which may carry new drivers, selects again.
+//
+// The mini-benchmark only runs if
+// //tflite/experimental/acceleration/mini_benchmark:mini_benchmark_implementation
+// is linked in. Otherwise nothing is ever selected.
+
+// Returns an identifier of the device.
+std::string GetAcceleratorSelectionDeviceId();
+
+// Returns an identifier of the drivers of the device, e.g. the Android build
+// fingerprint.
+std::string GetAcceleratorSelectionDriverId();
+
+// Returns the id the selection for `model` on the device and the drivers is
+// stored under.
+std::string GetAcceleratorSelectionModelId(absl::Span<const uint8_t> model,
+                                           absl::string_view device_id,
+                                           absl::string_view driver_id);
+
+// Returns the accelerators that run `settings`, with the CPU for the ops they
+// don't support, or kLiteRtHwAcceleratorNone if LiteRT has no accelerator for
+// its delegate.
+LiteRtHwAcceleratorSet GetAcceleratorsForSettings(
+    const tflite::TFLiteSettingsT& settings);
+
+// Returns the accelerators selected for `model`, whose file is at
+// `model_path`, from the results of the mini-benchmark in `cache_dir`.
+//
+// If the mini-benchmark has no results yet, starts it in the background the
+// first time in the process, and returns `fallback_accelerators`. An empty
+// `model_path` only reads previous results.
+LiteRtHwAcceleratorSet SelectAccelerators(
+    absl::string_view cache_dir, absl::string_view model_path,
+    absl::Span<const uint8_t> model,
+    LiteRtHwAcceleratorSet fallback_accelerators);
+
+}  // namespace litert::internal
+
+#endif  // ODML_LITERT_LITERT_RUNTIME_ACCELERATOR_SELECTION_H_
@@ -0,0 +1,69 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/accelerator_selection.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "litert/c/litert_common.h"
+#include "tflite/acceleration/configuration/configuration_generated.h"
+
+namespace litert::internal {
+namespace {
+
+TEST(AcceleratorSelectionTest, ModelIdDependsOnModelDeviceAndDriver) {
+  const std::vector<uint8_t> model = {1, 2, 3, 4};
+  const std::vector<uint8_t> other_model = {1, 2, 3, 5};
+  const auto model_id =
+      GetAcceleratorSelectionModelId(model, "device", "driver");
+
+  EXPECT_EQ(model_id.size(), 16);
+  EXPECT_EQ(GetAcceleratorSelectionModelId(model, "device", "driver"),
+            model_id);
+  EXPECT_NE(GetAcceleratorSelectionModelId(other_model, "device", "driver"),
+            model_id);
+  EXPECT_NE(GetAcceleratorSelectionModelId(model, "other_device", "driver"),
+            model_id);
+  EXPECT_NE(GetAcceleratorSelectionModelId(model, "device", "other_driver"),
+            model_id);
+}
+
+TEST(AcceleratorSelectionTest, MapsDelegatesToAccelerators) {
+  tflite::TFLiteSettingsT settings;
+  settings.delegate = tflite::Delegate_NONE;
+  EXPECT_EQ(GetAcceleratorsForSettings(settings), kLiteRtHwAcceleratorCpu);
+  settings.delegate = tflite::Delegate_XNNPACK;
+  EXPECT_EQ(GetAcceleratorsForSettings(settings), kLiteRtHwAcceleratorCpu);
+  settings.delegate = tflite::Delegate_GPU;
+  EXPECT_EQ(GetAcceleratorsForSettings(settings),
+            kLiteRtHwAcceleratorGpu | kLiteRtHwAcceleratorCpu);
+  settings.delegate = tflite::Delegate_HEXAGON;
+  EXPECT_EQ(GetAcceleratorsForSettings(settings), kLiteRtHwAcceleratorNone);
+}
+
+TEST(AcceleratorSelectionTest, ReturnsFallbackUntilSelected) {
+  const std::vector<uint8_t> model = {1, 2, 3, 4};
+  // Nothing is selected without the mini-benchmark implementation.
+  EXPECT_EQ(SelectAccelerators(::testing::TempDir(), "model.tflite", model,
+                               kLiteRtHwAcceleratorGpu),
+            kLiteRtHwAcceleratorGpu);
+  EXPECT_EQ(SelectAccelerators(::testing::TempDir(), "model.tflite", model,
+                               kLiteRtHwAcceleratorCpu),
+            kLiteRtHwAcceleratorCpu);
+}
+
+}  // namespace
+}  // namespace litert::internal
@@ -15,6 +15,9 @@
 #include "litert/runtime/accelerator.h"
 
 #include <gtest/gtest.h>
+#include "litert/c/litert_common.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/runtime/accelerator_registry.h"
 
 namespace litert::internal {
 namespace {
@@ -57,5 +60,54 @@ TEST(AcceleratorRegistryTest, AcceleratorCanBeRegisteredAndRetrieved) {
   EXPECT_EQ(idx2.Value(), 1);
 }
 
+TEST(AcceleratorRegistryTest, LazyAcceleratorIsLoadedWhenItsHardwareIsUsed) {
+  AcceleratorRegistry registry;
+  auto cpu_accelerator = registry.RegisterAccelerator(
+      AcceleratorRegistry::CreateEmptyAccelerator());
+  ASSERT_TRUE(cpu_accelerator);
+
+  LiteRtAcceleratorT* gpu_accelerator = nullptr;
+  registry.RegisterLazyAccelerator(
+      kLiteRtHwAcceleratorGpu, [&]() -> Expected<void> {
+        auto registered = registry.RegisterAccelerator(
+            AcceleratorRegistry::CreateEmptyAccelerator());
+        if (!registered) return registered.Error();
+        gpu_accelerator = registered.Value();
+        return {};
+      });
+
+  auto npu_accelerator = registry.RegisterAccelerator(
+      AcceleratorRegistry::CreateEmptyAccelerator());
+  ASSERT_TRUE(npu_accelerator);
+  EXPECT_EQ(registry.size(), 2);
+
+  registry.LoadAccelerators(kLiteRtHwAcceleratorCpu);
+  EXPECT_EQ(gpu_accelerator, nullptr);
+  EXPECT_EQ(registry.size(), 2);
+
+  // The loaded accelerator keeps its place in the registration order.
+  registry.LoadAccelerators(kLiteRtHwAcceleratorCpu | kLiteRtHwAcceleratorGpu);
+  ASSERT_NE(gpu_accelerator, nullptr);
+  ASSERT_EQ(registry.size(), 3);
+  EXPECT_EQ(registry.Get(0).Value(), cpu_accelerator.Value());
+  EXPECT_EQ(registry.Get(1).Value(), gpu_accelerator);
+  EXPECT_EQ(registry.Get(2).Value(), npu_accelerator.Value());
+}
+
+TEST(AcceleratorRegistryTest, LazyAcceleratorThatFailsToLoadIsNotRetried) {
+  AcceleratorRegistry registry;
+  int num_loads = 0;
+  registry.RegisterLazyAccelerator(kLiteRtHwAcceleratorGpu,
+                                   [&]() -> Expected<void> {
+                                     ++num_loads;
+                                     return Error(kLiteRtStatusErrorNotFound);
+                                   });
+
+  registry.LoadAllAccelerators();
+  registry.LoadAccelerators(kLiteRtHwAcceleratorGpu);
+  EXPECT_EQ(num_loads, 1);
+  EXPECT_EQ(registry.size(), 0);
+}
+
 }  // namespace
 }  // namespace litert::internal
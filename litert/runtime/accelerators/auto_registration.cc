@@ -14,20 +14,32 @@
 
 #include "litert/runtime/accelerators/auto_registration.h"
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/match.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
+#include "litert/c/litert_any.h"
 #include "litert/c/litert_common.h"
+#include "litert/c/litert_environment_options.h"
 #include "litert/cc/internal/litert_shared_library.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
 #include "litert/core/environment.h"
+#include "litert/core/filesystem.h"
 #include "litert/runtime/accelerators/xnnpack/xnnpack_accelerator.h"
 
 #if !defined(LITERT_DISABLE_NPU)
 #include "litert/runtime/accelerators/dispatch/dispatch_accelerator.h"
+#if defined(__ANDROID__)
+#include "litert/runtime/accelerators/nnapi/nnapi_accelerator.h"
+#endif  // defined(__ANDROID__)
 #endif  // !defined(LITERT_DISABLE_NPU)
 
 // Define a function pointer to allow the accelerator registration to be
@@ -52,35 +64,6 @@ Expected<SharedLibrary> LoadSharedLibrary(absl::string_view shlib_path,
   return SharedLibrary::Load(RtldFlags::kDefault);
 }
 
-}  // namespace
-
-Expected<void> TriggerAcceleratorAutomaticRegistration(
-    LiteRtEnvironmentT& environment) {
-  // Register the NPU accelerator.
-#if !defined(LITERT_DISABLE_NPU)
-  if (auto npu_registration = LiteRtRegisterNpuAccelerator(&environment);
-      npu_registration == kLiteRtStatusOk) {
-    LITERT_LOG(LITERT_INFO, "NPU accelerator registered.");
-  } else {
-    LITERT_LOG(LITERT_WARNING,
-               "NPU accelerator could not be loaded and registered: %s.",
-               LiteRtGetStatusString(npu_registration));
-  }
-#else
-  LITERT_LOG(LITERT_VERBOSE, "NPU accelerator accelerator is disabled.");
-#endif
-
-  // Register the WebNN accelerator if statically linked.
-  if (LiteRtRegisterStaticLinkedAcceleratorWebNn != nullptr &&
-      LiteRtRegisterStaticLinkedAcceleratorWebNn(environment) ==
-          kLiteRtStatusOk) {
-    LITERT_LOG(LITERT_INFO, "Statically linked WebNN accelerator registered.");
-  }
-
-  // Register the GPU accelerator.
-  // The following is list of plugins that are loaded in the order they are
-  // listed. The first plugin that is loaded and registered successfully will
-  // be used.
 #if defined(LITERT_WINDOWS_OS)
 #define SO_EXT ".dll"
 #elif defined(__APPLE__)
@@ -89,43 +72,84 @@ Expected<void> TriggerAcceleratorAutomaticRegistration(
 #define SO_EXT ".so"
 #endif
 #if !defined(LITERT_DISABLE_GPU)
-  static constexpr absl::string_view kGpuAcceleratorLibs[] = {
-      "libLiteRtGpuAccelerator" SO_EXT,
+// The following is list of plugins that are loaded in the order they are
+// listed. The first plugin that is loaded and registered successfully will be
+// used.
+constexpr absl::string_view kGpuAcceleratorLibs[] = {
+    "libLiteRtGpuAccelerator" SO_EXT,
 
 #ifdef __ANDROID__
 #if LITERT_HAS_OPENCL_SUPPORT
-      "libLiteRtOpenClAccelerator" SO_EXT,
+    "libLiteRtOpenClAccelerator" SO_EXT,
 #endif  // LITERT_HAS_OPENCL_SUPPORT
 #if LITERT_HAS_WEBGPU_SUPPORT
-      "libLiteRtWebGpuAccelerator" SO_EXT,
+    "libLiteRtWebGpuAccelerator" SO_EXT,
 #endif  // LITERT_HAS_WEBGPU_SUPPORT
 
 #elif TARGET_OS_IPHONE
 #if LITERT_HAS_METAL_SUPPORT
-      "libLiteRtMetalAccelerator" SO_EXT,
+    "libLiteRtMetalAccelerator" SO_EXT,
 #endif  // LITERT_HAS_METAL_SUPPORT
 #if LITERT_HAS_WEBGPU_SUPPORT
-      "libLiteRtWebGpuAccelerator" SO_EXT,
+    "libLiteRtWebGpuAccelerator" SO_EXT,
 #endif  // LITERT_HAS_WEBGPU_SUPPORT
 
 #else  // !__ANDROID__ && !TARGET_OS_IPHONE
 #if LITERT_HAS_WEBGPU_SUPPORT
-      "libLiteRtWebGpuAccelerator" SO_EXT,
+    "libLiteRtWebGpuAccelerator" SO_EXT,
 #endif  // LITERT_HAS_WEBGPU_SUPPORT
 #if LITERT_HAS_OPENCL_SUPPORT
-      "libLiteRtOpenClAccelerator" SO_EXT,
+    "libLiteRtOpenClAccelerator" SO_EXT,
 #endif  // LITERT_HAS_OPENCL_SUPPORT
 #if LITERT_HAS_METAL_SUPPORT
-      "libLiteRtMetalAccelerator" SO_EXT,
+    "libLiteRtMetalAccelerator" SO_EXT,
 #endif  // LITERT_HAS_METAL_SUPPORT
 #endif  // !__ANDROID__ && !TARGET_OS_IPHONE
 
 #if LITERT_HAS_VULKAN_SUPPORT
-      "libLiteRtVulkanAccelerator" SO_EXT,
+    "libLiteRtVulkanAccelerator" SO_EXT,
 #endif  // LITERT_HAS_VULKAN_SUPPORT
-  };
-  bool gpu_accelerator_registered = false;
-  for (auto plugin_path : kGpuAcceleratorLibs) {
+};
+
+// Name of the file in the compiler cache directory that records which GPU
+// plugin was loaded, so that the next runs try it first.
+constexpr absl::string_view kGpuDiscoveryCacheFile =
+    "litert_gpu_accelerator_discovery";
+
+std::optional<std::string> GetGpuDiscoveryCachePath(
+    const LiteRtEnvironmentT& environment) {
+  auto cache_dir = environment.GetOption(kLiteRtEnvOptionTagCompilerCacheDir);
+  if (!cache_dir.has_value() || cache_dir->type != kLiteRtAnyTypeString) {
+    return std::nullopt;
+  }
+  return internal::Join({cache_dir->str_value, kGpuDiscoveryCacheFile});
+}
+
+// Returns the GPU plugins in the order to try them, starting with the one
+// recorded in the discovery cache.
+std::vector<absl::string_view> GetGpuAcceleratorLibs(
+    const std::optional<std::string>& cache_path) {
+  std::vector<absl::string_view> libs(std::begin(kGpuAcceleratorLibs),
+                                      std::end(kGpuAcceleratorLibs));
+  if (!cache_path.has_value()) {
+    return libs;
+  }
+  std::ifstream cache(*cache_path);
+  std::string cached_lib;
+  if (cache >> cached_lib) {
+    auto it = std::find(libs.begin(), libs.end(), cached_lib);
+    if (it != libs.end()) {
+      std::rotate(libs.begin(), it, it + 1);
+    }
+  }
+  return libs;
+}
+
+Expected<void> LoadGpuAccelerator(LiteRtEnvironmentT& environment) {
+  const std::optional<std::string> cache_path =
+      GetGpuDiscoveryCachePath(environment);
+  const std::vector<absl::string_view> libs = GetGpuAcceleratorLibs(cache_path);
+  for (auto plugin_path : libs) {
     LITERT_LOG(LITERT_VERBOSE, "Loading GPU accelerator(%s).",
                plugin_path.data());
     auto registration = RegisterSharedObjectAccelerator(
@@ -135,8 +159,10 @@ Expected<void> TriggerAcceleratorAutomaticRegistration(
       LITERT_LOG(LITERT_INFO,
                  "Dynamically loaded GPU accelerator(%s) registered.",
                  plugin_path.data());
-      gpu_accelerator_registered = true;
-      break;
+      if (cache_path.has_value() && plugin_path != libs.front()) {
+        std::ofstream(*cache_path, std::ios::trunc) << plugin_path;
+      }
+      return {};
     }
     const auto& error = registration.Error();
     auto log_level = absl::StrContains(error.Message(), "cannot locate symbol")
@@ -146,18 +172,59 @@ Expected<void> TriggerAcceleratorAutomaticRegistration(
                plugin_path.data(), LiteRtGetStatusString(error.Status()),
                registration.Error().Message().data());
   }
-  if (!gpu_accelerator_registered) {
-    if (LiteRtRegisterStaticLinkedAcceleratorGpu != nullptr &&
-        LiteRtRegisterStaticLinkedAcceleratorGpu(environment) ==
-            kLiteRtStatusOk) {
-      LITERT_LOG(LITERT_INFO, "Statically linked GPU accelerator registered.");
-      gpu_accelerator_registered = true;
-    }
+  if (LiteRtRegisterStaticLinkedAcceleratorGpu != nullptr &&
+      LiteRtRegisterStaticLinkedAcceleratorGpu(environment) ==
+          kLiteRtStatusOk) {
+    LITERT_LOG(LITERT_INFO, "Statically linked GPU accelerator registered.");
+    return {};
   }
-  if (!gpu_accelerator_registered) {
-    LITERT_LOG(LITERT_WARNING,
+  return Error(kLiteRtStatusErrorNotFound,
                "GPU accelerator could not be loaded and registered.");
+}
+#endif  // !defined(LITERT_DISABLE_GPU)
+
+}  // namespace
+
+Expected<void> TriggerAcceleratorAutomaticRegistration(
+    LiteRtEnvironmentT& environment) {
+  // Register the NPU accelerator.
+#if !defined(LITERT_DISABLE_NPU)
+  if (auto npu_registration = LiteRtRegisterNpuAccelerator(&environment);
+      npu_registration == kLiteRtStatusOk) {
+    LITERT_LOG(LITERT_INFO, "NPU accelerator registered.");
+  } else {
+    LITERT_LOG(LITERT_WARNING,
+               "NPU accelerator could not be loaded and registered: %s.",
+               LiteRtGetStatusString(npu_registration));
+  }
+#if defined(__ANDROID__)
+  // Runs the ops the vendor dispatch doesn't cover when the NPU is requested.
+  if (auto nnapi_registration = LiteRtRegisterNnapiAccelerator(&environment);
+      nnapi_registration == kLiteRtStatusOk) {
+    LITERT_LOG(LITERT_INFO, "NNAPI accelerator registered.");
+  } else {
+    LITERT_LOG(LITERT_WARNING,
+               "NNAPI accelerator could not be registered: %s.",
+               LiteRtGetStatusString(nnapi_registration));
   }
+#endif  // defined(__ANDROID__)
+#else
+  LITERT_LOG(LITERT_VERBOSE, "NPU accelerator accelerator is disabled.");
+#endif
+
+  // Register the WebNN accelerator if statically linked.
+  if (LiteRtRegisterStaticLinkedAcceleratorWebNn != nullptr &&
+      LiteRtRegisterStaticLinkedAcceleratorWebNn(environment) ==
+          kLiteRtStatusOk) {
+    LITERT_LOG(LITERT_INFO, "Statically linked WebNN accelerator registered.");
+  }
+
+  // Register the GPU accelerator. Its library is only looked for and loaded
+  // once a model requests the GPU.
+#if !defined(LITERT_DISABLE_GPU)
+  environment.GetAcceleratorRegistry().RegisterLazyAccelerator(
+      kLiteRtHwAcceleratorGpu,
+      [&environment]() { return LoadGpuAccelerator(environment); });
 #else
   LITERT_LOG(LITERT_VERBOSE, "GPU accelerator registration disabled.");
 #endif
@@ -0,0 +1,150 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/accelerators/nnapi/nnapi_accelerator.h"
+
+#include <optional>
+
+#include "litert/c/internal/litert_accelerator_registration.h"
+#include "litert/c/internal/litert_delegate_wrapper.h"
+#include "litert/c/litert_any.h"
+#include "litert/c/litert_common.h"
+#include "litert/c/litert_environment_options.h"
+#include "litert/c/litert_options.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/core/environment.h"
+#include "litert/core/options.h"
+#include "litert/runtime/accelerator.h"
+#include "litert/runtime/accelerators/accelerator_implementation_helper.h"
+#include "tflite/c/c_api_types.h"
+#include "tflite/delegates/nnapi/nnapi_delegate.h"
+
+namespace litert {
+namespace {
+
+constexpr const char kNnapiAcceleratorName[] = "NnapiAccelerator";
+
+struct NnapiAcceleratorVersion {
+  static constexpr int kMajor = 1;
+  static constexpr int kMinor = 0;
+  static constexpr int kPatch = 0;
+  static constexpr LiteRtApiVersion version = {kMajor, kMinor, kPatch};  // NOLINT
+};
+
+class NnapiAccelerator final
+    : public internal::AcceleratorImplementationHelper<
+          NnapiAccelerator, kNnapiAcceleratorName, NnapiAcceleratorVersion,
+          kLiteRtHwAcceleratorNpu> {
+ public:
+  static Expected<Ptr> Create() { return Allocate(); }
+
+  // C API
+
+  // Creates an NNAPI delegate instance.
+  //
+  // When the environment has a compilation cache, the NNAPI compilations are
+  // cached in its directory under the key the compiled model derives from the
+  // model, so the next compiled model of the same model skips compiling.
+  static LiteRtStatus CreateDelegate(LiteRtAccelerator accelerator,
+                                     LiteRtOptions options,
+                                     LiteRtDelegateWrapper* delegate_wrapper) {
+    LITERT_RETURN_IF_ERROR(delegate_wrapper != nullptr,
+                           ErrorStatusBuilder::InvalidArgument())
+        << "Delegate wrapper pointer is null.";
+    LITERT_RETURN_IF_ERROR(accelerator != nullptr,
+                           ErrorStatusBuilder::InvalidArgument())
+        << "Accelerator handle is invalid.";
+    LITERT_RETURN_IF_ERROR(accelerator->env != nullptr,
+                           ErrorStatusBuilder::InvalidArgument())
+        << "Accelerator is not registered to an environment.";
+    LITERT_RETURN_IF_ERROR(options != nullptr,
+                           ErrorStatusBuilder::InvalidArgument())
+        << "Options are null.";
+
+    tflite::StatefulNnApiDelegate::Options nnapi_options;
+    // Bursts reuse the resources of the previous executions, which saves
+    // most of the per inference overhead of NNAPI.
+    nnapi_options.use_burst_computation = true;
+    std::optional<LiteRtAny> cache_dir_option =
+        accelerator->env->GetOption(kLiteRtEnvOptionTagCompilerCacheDir);
+    if (cache_dir_option.has_value() &&
+        cache_dir_option->type == kLiteRtAnyTypeString &&
+        !options->model_cache_key.empty()) {
+      // The delegate appends the fingerprint of each partition to the token.
+      nnapi_options.cache_dir = cache_dir_option->str_value;
+      nnapi_options.model_token = options->model_cache_key.c_str();
+    }
+    auto* nnapi_delegate = new tflite::StatefulNnApiDelegate(nnapi_options);
+    LITERT_RETURN_IF_ERROR(
+        LiteRtWrapDelegate(reinterpret_cast<TfLiteOpaqueDelegate*>(
+                               static_cast<TfLiteDelegate*>(nnapi_delegate)),
+                           delegate_wrapper));
+
+    return kLiteRtStatusOk;
+  }
+
+  // Destroys an NNAPI delegate instance.
+  static void DestroyDelegate(LiteRtDelegateWrapper delegate_wrapper) {
+    TfLiteOpaqueDelegate* nnapi_delegate;
+    LiteRtUnwrapDelegate(delegate_wrapper, &nnapi_delegate);
+    delete static_cast<tflite::StatefulNnApiDelegate*>(
+        reinterpret_cast<TfLiteDelegate*>(nnapi_delegate));
+  }
+
+  // Returns true so that the NNAPI delegate is only applied when the NPU is
+  // requested for the compilation.
+  static LiteRtStatus IsTfLiteDelegateResponsibleForJitCompilation(
+      LiteRtAcceleratorT* accelerator, bool* does_jit_compilation) {
+    LITERT_RETURN_IF_ERROR(does_jit_compilation,
+                           litert::ErrorStatusBuilder::InvalidArgument())
+        << "`does_jit_compilation` pointer is null.";
+    *does_jit_compilation = true;
+    return kLiteRtStatusOk;
+  }
+};
+
+}  // namespace
+}  // namespace litert
+
+extern "C" {
+
+LiteRtStatus LiteRtRegisterNnapiAccelerator(LiteRtEnvironment environment) {
+  LITERT_RETURN_IF_ERROR(environment != nullptr,
+                         litert::ErrorStatusBuilder::InvalidArgument())
+      << "environment handle is null";
+
+  LiteRtAccelerator accelerator_handle;
+  LITERT_RETURN_IF_ERROR(LiteRtCreateAccelerator(&accelerator_handle));
+  litert::internal::AcceleratorGuard accelerator(accelerator_handle);
+
+  LITERT_RETURN_IF_ERROR(litert::internal::SetAcceleratorBoilerplateFunctions<
+                         litert::NnapiAccelerator>(accelerator));
+
+  LITERT_ASSIGN_OR_RETURN(auto accelerator_impl,
+                          litert::NnapiAccelerator::Create());
+
+  LITERT_RETURN_IF_ERROR(
+      LiteRtSetIsAcceleratorDelegateResponsibleForJitCompilation(
+          accelerator.get(), litert::NnapiAccelerator::
+                                 IsTfLiteDelegateResponsibleForJitCompilation));
+
+  LITERT_RETURN_IF_ERROR(LiteRtRegisterAccelerator(
+      environment, accelerator.release(), accelerator_impl.release(),
+      litert::NnapiAccelerator::Destroy));
+
+  return kLiteRtStatusOk;
+}
+
+}  // extern "C"
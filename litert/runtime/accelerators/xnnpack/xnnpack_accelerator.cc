@@ -15,6 +15,7 @@
 #include "litert/runtime/accelerators/xnnpack/xnnpack_accelerator.h"
 
 #include <memory>
+#include <vector>
 
 #include "litert/c/internal/litert_accelerator_registration.h"
 #include "litert/c/internal/litert_delegate_wrapper.h"
@@ -22,10 +23,12 @@
 #include "litert/c/litert_opaque_options.h"
 #include "litert/c/litert_options.h"
 #include "litert/c/options/litert_cpu_options.h"
+#include "litert/c/options/litert_cpu_options_type.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
 #include "litert/runtime/accelerator.h"
 #include "litert/runtime/accelerators/accelerator_implementation_helper.h"
+#include "litert/runtime/cpu_affinity.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/delegates/xnnpack/xnnpack_delegate.h"
 
@@ -46,7 +49,9 @@ class CpuAccelerator final
           CpuAccelerator, kCpuAcceleratorName, CpuAcceleratorVersion,
           kLiteRtHwAcceleratorCpu> {
  public:
-  CpuAccelerator() = default;
+  CpuAccelerator() : workspace_(TfLiteXNNPackDelegateWorkspaceCreate()) {}
+
+  ~CpuAccelerator() { TfLiteXNNPackDelegateWorkspaceDelete(workspace_); }
 
   static Expected<Ptr> Create() { return Allocate(); }
 
@@ -86,14 +91,31 @@ class CpuAccelerator final
     // TODO: b/403547017 - Make the CPU accelerator configurable using the
     // compilation options.
     auto xnn_options = TfLiteXNNPackDelegateOptionsDefault();
+    std::vector<int> affinity_cpus;
     if (cpu_options != nullptr) {
       LiteRtGetCpuOptionsNumThread(cpu_options, &xnn_options.num_threads);
       LiteRtGetCpuOptionsXNNPackFlags(cpu_options, &xnn_options.flags);
       LITERT_RETURN_IF_ERROR(LiteRtGetCpuOptionsXnnPackWeightCachePath(
           cpu_options, &xnn_options.weight_cache_file_path));
+      LiteRtCpuAffinityPolicy affinity_policy;
+      LITERT_RETURN_IF_ERROR(
+          LiteRtGetCpuOptionsAffinityPolicy(cpu_options, &affinity_policy));
+      affinity_cpus = internal::GetCpusForAffinityPolicy(affinity_policy);
+      if (xnn_options.num_threads <= 0 && !affinity_cpus.empty()) {
+        xnn_options.num_threads = affinity_cpus.size();
+      }
+    }
+    // All the XNNPack delegates created in the same environment share their
+    // scratch memory.
+    xnn_options.workspace =
+        reinterpret_cast<CpuAccelerator*>(accelerator->data)->workspace_;
+    TfLiteOpaqueDelegate* xnnpack_delegate;
+    {
+      // The threads of the XNNPack thread pool, created with the delegate,
+      // inherit the affinity.
+      internal::ScopedCpuAffinity affinity(affinity_cpus);
+      xnnpack_delegate = TfLiteXNNPackDelegateCreate(&xnn_options);
     }
-    TfLiteOpaqueDelegate* xnnpack_delegate =
-        TfLiteXNNPackDelegateCreate(&xnn_options);
     LITERT_RETURN_IF_ERROR(xnnpack_delegate != nullptr,
                            ErrorStatusBuilder(kLiteRtStatusErrorRuntimeFailure))
         << "XNNPack delegate failed to be created.";
@@ -125,6 +147,11 @@ class CpuAccelerator final
 #endif  // defined(__EMSCRIPTEN__)
     return kLiteRtStatusOk;
   }
+
+ private:
+  // Kept alive by the delegates using it after the accelerator is destroyed.
+  // When null, each delegate creates its own.
+  TfLiteXNNPackDelegateWorkspace* workspace_;
 };
 
 }  // namespace
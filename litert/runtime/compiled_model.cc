@@ -43,6 +43,8 @@
 #include "absl/strings/str_cat.h"  // from @com_google_absl
 #include "absl/strings/str_format.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/time/clock.h"  // from @com_google_absl
+#include "absl/time/time.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/internal/litert_accelerator.h"
 #include "litert/c/internal/litert_delegate_wrapper.h"
@@ -50,8 +52,10 @@
 #include "litert/c/litert_any.h"
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_environment_options.h"
+#include "litert/c/litert_event_type.h"
 #include "litert/c/litert_opaque_options.h"
 #include "litert/c/litert_options.h"
+#include "litert/c/options/litert_gpu_options.h"
 #include "litert/c/litert_profiler_event.h"
 #include "litert/c/litert_tensor_buffer.h"
 #include "litert/c/litert_tensor_buffer_requirements.h"
@@ -62,10 +66,14 @@
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
 #include "litert/cc/litert_opaque_options.h"
+#include "litert/cc/options/litert_gpu_options.h"
 #include "litert/core/buffer_error_reporter.h"
 #include "litert/core/build_stamp.h"
+#include "litert/core/cache/hash_util.h"
+#include "litert/core/cache/verification_cache.h"
 #include "litert/core/error_reporter.h"
 #include "litert/core/model/model.h"
+#include "litert/core/model/model_load.h"
 #if !defined(LITERT_DISABLE_NPU)
 #include "litert/compiler/plugin/compiler_plugin.h"
 #include "litert/core/cache/compilation_cache.h"
@@ -73,14 +81,20 @@
 #endif  // !defined(LITERT_DISABLE_NPU)
 #include "litert/core/options.h"
 #include "litert/core/util/flatbuffer_tools.h"
+#include "litert/core/util/perfetto_profiling.h"
 #include "litert/runtime/accelerator.h"
+#include "litert/runtime/accelerator_selection.h"
+#include "litert/runtime/cpu_affinity.h"
 #include "litert/runtime/custom_op_dispatcher.h"
 #include "litert/runtime/dispatch/dispatch_opaque_options.h"
+#include "litert/runtime/event.h"
 #include "litert/runtime/external_litert_buffer_context.h"
 #include "litert/runtime/litert_cpu_options.h"
 #include "litert/runtime/litert_runtime_options.h"
 #include "litert/runtime/magic_number_utils.h"
 #include "litert/runtime/metrics.h"
+#include "litert/runtime/run_scheduler.h"
+#include "litert/runtime/serial_executor.h"
 #include "litert/runtime/tensor_buffer.h"
 #include "litert/runtime/tensor_buffer_requirements.h"
 #include "litert/runtime/tensor_identifier.h"
@@ -94,11 +108,15 @@
 #include "tflite/core/api/profiler.h"
 #include "tflite/core/interpreter_builder.h"
 #include "tflite/delegates/utils/simple_opaque_delegate.h"
+#include "tflite/external_cpu_backend_context.h"
 #include "tflite/interpreter.h"
 #include "tflite/interpreter_options.h"
-#if !defined(LITERT_NO_BUILTIN_OPS)
+#if defined(LITERT_SELECTED_OPS)
+#include "tflite/create_op_resolver.h"
+#include "tflite/mutable_op_resolver.h"
+#elif !defined(LITERT_NO_BUILTIN_OPS)
 #include "tflite/kernels/register.h"
-#endif  // LITERT_NO_BUILTIN_OPS
+#endif  // LITERT_SELECTED_OPS
 #include "tflite/model_builder.h"
 
 #if defined(LITERT_NO_BUILTIN_OPS)
@@ -169,6 +187,12 @@ Expected<void> LiteRtCompiledModelT::InitializeRuntime(
   // actual operations will be handled by LiteRT's accelerator system
   // (NPU > GPU > CPU) through their respective delegates.
   litert::internal::StubOpResolver resolver;
+#elif defined(LITERT_SELECTED_OPS)
+  // Only the built-in kernels of the ops used by the models the runtime was
+  // built for, see litert_selected_ops.bzl.
+  std::unique_ptr<tflite::MutableOpResolver> selected_ops_resolver =
+      tflite::CreateOpResolver();
+  tflite::MutableOpResolver& resolver = *selected_ops_resolver;
 #else
   tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates resolver;
 #endif  // LITERT_NO_BUILTIN_OPS
@@ -225,6 +249,10 @@ Expected<void> LiteRtCompiledModelT::InitializeRuntime(
       if ((*runtime_options)->enable_profiling) {
         profiler_ = new LiteRtProfilerT(/*max_profiling_buffer_entries=*/2048);
       }
+      lazy_signature_allocation_ =
+          (*runtime_options)->lazy_signature_allocation;
+      run_priority_ = (*runtime_options)->run_priority;
+      run_deadline_ = absl::Milliseconds((*runtime_options)->run_deadline_ms);
 
       // Create error reporter based on mode
       switch ((*runtime_options)->error_reporter_mode) {
@@ -244,6 +272,11 @@ Expected<void> LiteRtCompiledModelT::InitializeRuntime(
             opaque_options, LiteRtCpuOptionsT::Identifier());
         cpu_options) {
       num_threads = (*cpu_options)->xnn.num_threads;
+      affinity_cpus_ = litert::internal::GetCpusForAffinityPolicy(
+          (*cpu_options)->affinity_policy);
+      if (num_threads <= 0 && !affinity_cpus_.empty()) {
+        num_threads = affinity_cpus_.size();
+      }
     }
   }
 
@@ -255,6 +288,22 @@ Expected<void> LiteRtCompiledModelT::InitializeRuntime(
     return Unexpected(kLiteRtStatusErrorRuntimeFailure,
                       "Failed to build TFL interpreter");
   }
+  if (std::optional<LiteRtAny> thread_pool_option =
+          env->GetOption(kLiteRtEnvOptionTagCpuThreadPool);
+      thread_pool_option.has_value() &&
+      thread_pool_option->type == kLiteRtAnyTypeVoidPtr &&
+      thread_pool_option->ptr_value != nullptr) {
+    // The environment's user owns the pool.
+    std::shared_ptr<tflite::TfLiteCpuThreadPool> thread_pool(
+        std::shared_ptr<tflite::TfLiteCpuThreadPool>(),
+        static_cast<tflite::TfLiteCpuThreadPool*>(
+            const_cast<void*>(thread_pool_option->ptr_value)));
+    cpu_backend_context_ =
+        std::make_unique<tflite::ExternalCpuBackendContext>();
+    cpu_backend_context_->set_shared_thread_pool(std::move(thread_pool));
+    interp_->SetExternalContext(kTfLiteCpuBackendContext,
+                                cpu_backend_context_.get());
+  }
   interp_->SetNumThreads(num_threads);
 
   if (jit_compilation_options) {
@@ -278,6 +327,7 @@ Expected<void> LiteRtCompiledModelT::InitializeRuntime(
   if (profiler_ != nullptr) {
     interp_->SetProfiler(profiler_);
   }
+  SetInterpreterCancellationFunction();
 
   signature_keys_ = interp_->signature_keys();
   if (signature_keys_.empty()) {
@@ -304,6 +354,7 @@ Expected<void> LiteRtCompiledModelT::InitializeRuntime(
   // Register the ExternalLiteRtBufferContext for TensorBuffer handshaking.
   buffer_context_ =
       std::make_unique<LiteRtExternalLiteRtBufferContextT>(env, get_tensor_id);
+  buffer_context_->SetProfiler(profiler_);
   interp_->SetExternalContext(kTfLiteLiteRtBufferContext,
                               buffer_context_.get());
 #if defined(LITERT_WITH_EXTERNAL_WEIGHT_LOADER)
@@ -331,14 +382,25 @@ Expected<void> LiteRtCompiledModelT::InitializeRuntime(
 
 namespace {
 
+// Returns the file descriptor of the file `allocation` maps, or -1 if there is
+// none. The dispatch delegate resolves offsets from the allocation base as file
+// offsets, so a model mapped from the middle of a file, e.g. an archive entry,
+// reports no descriptor either.
 int GetAllocationFd(const tflite::Allocation* allocation) {
-  if (allocation != nullptr &&
-      allocation->type() == tflite::Allocation::Type::kMMap) {
-    auto& mmap_allocation =
-        static_cast<const tflite::MMAPAllocation&>(*allocation);
-    return mmap_allocation.fd();
-  }
-  return -1;
+  if (allocation == nullptr ||
+      allocation->type() != tflite::Allocation::Type::kMMap) {
+    return -1;
+  }
+  auto& mmap_allocation =
+      static_cast<const tflite::MMAPAllocation&>(*allocation);
+  const size_t offset_in_buffer =
+      static_cast<const char*>(mmap_allocation.base()) -
+      static_cast<const char*>(mmap_allocation.mmapped_buffer());
+  if (mmap_allocation.mmapped_buffer_offset_in_file() + offset_in_buffer !=
+      0) {
+    return -1;
+  }
+  return mmap_allocation.fd();
 }
 
 #if !defined(LITERT_DISABLE_NPU)
@@ -376,9 +438,17 @@ std::optional<litert::internal::CompilationCache> MaybeCreateCompilationCache(
     LITERT_LOG(LITERT_INFO,
                "NPU JIT compilation caching enabled with cache dir: %s",
                compiler_cache_dir_option->str_value);
+    size_t max_size = litert::internal::CompilationCache::kUnlimitedSize;
+    std::optional<LiteRtAny> max_size_option =
+        env.GetOption(kLiteRtEnvOptionTagCompilerCacheMaxSize);
+    if (max_size_option.has_value() &&
+        max_size_option->type == kLiteRtAnyTypeInt &&
+        max_size_option->int_value >= 0) {
+      max_size = max_size_option->int_value;
+    }
     auto compilation_cache_expected =
         litert::internal::CompilationCache::Create(
-            compiler_cache_dir_option->str_value);
+            compiler_cache_dir_option->str_value, max_size);
     if (compilation_cache_expected.HasValue()) {
       return compilation_cache_expected.Value();
     }
@@ -408,10 +478,77 @@ void TryApplyPluginsImpl(
   }
 }
 
+// Returns true if the plugins should be applied to `model` on a background
+// thread while the compiled model runs on the other accelerators.
+bool ShouldJitCompileInBackground(const LiteRtModelT& model,
+                                  LiteRtHwAcceleratorSet hw_accelerators,
+                                  LiteRtOptions options,
+                                  LiteRtEnvironmentT& env) {
+  if (!(hw_accelerators & kLiteRtHwAcceleratorNpu) || IsCompiled(model) ||
+      !env.GetOption(kLiteRtEnvOptionTagCompilerPluginLibraryDir)
+           .has_value() ||
+      litert::internal::GetTflFlatbuffer(model).Buf().Data() == nullptr) {
+    return false;
+  }
+  auto opaque_options = litert::OpaqueOptions::WrapCObject(
+      options->options, litert::OwnHandle::kNo);
+  auto runtime_options = litert::FindOpaqueData<LiteRtRuntimeOptionsT>(
+      opaque_options, LiteRtRuntimeOptionsT::Identifier());
+  return runtime_options && (*runtime_options)->background_jit_compilation;
+}
+
 #endif  // !defined(LITERT_DISABLE_NPU)
 
+// Returns the accelerators the mini-benchmark selected for `model`. Until it
+// has, returns `hardware_accelerators`, or the CPU if none are set.
+LiteRtHwAcceleratorSet SelectHardwareAccelerators(
+    LiteRtEnvironmentT& env, const LiteRtModelT& model,
+    LiteRtHwAcceleratorSet hardware_accelerators) {
+  const LiteRtHwAcceleratorSet fallback_accelerators =
+      hardware_accelerators != kLiteRtHwAcceleratorNone
+          ? hardware_accelerators
+          : kLiteRtHwAcceleratorCpu;
+  const auto cache_dir_option =
+      env.GetOption(kLiteRtEnvOptionTagCompilerCacheDir);
+  const auto model_buffer = litert::internal::GetTflFlatbuffer(model).Buf();
+  if (!cache_dir_option.has_value() ||
+      cache_dir_option->type != kLiteRtAnyTypeString ||
+      model_buffer.Data() == nullptr) {
+    LITERT_LOG(LITERT_WARNING,
+               "Automatic hardware accelerators need a compiler cache "
+               "directory and a model buffer.");
+    return fallback_accelerators;
+  }
+  return litert::internal::SelectAccelerators(
+      cache_dir_option->str_value, model.SourcePath().value_or(""),
+      absl::MakeConstSpan(model_buffer.Data(), model_buffer.Size()),
+      fallback_accelerators);
+}
+
 }  // namespace
 
+Expected<LiteRtModelT::Ptr> LiteRtCompiledModelT::LoadModelFile(
+    LiteRtEnvironmentT& env, absl::string_view filename) {
+  litert::internal::ModelLoadOptions options;
+  const auto cache_dir_option =
+      env.GetOption(kLiteRtEnvOptionTagCompilerCacheDir);
+  if (cache_dir_option.has_value() &&
+      cache_dir_option->type == kLiteRtAnyTypeString) {
+    if (auto verification_cache = litert::internal::VerificationCache::Create(
+            cache_dir_option->str_value);
+        verification_cache) {
+      options.verify_file =
+          [verification_cache = std::move(*verification_cache)](
+              absl::string_view path,
+              litert::BufferRef<uint8_t> buffer) mutable {
+            return verification_cache.Verify(path, buffer);
+          };
+    }
+  }
+  return litert::internal::LoadModelFromFile(
+      filename, /*allow_modifications=*/false, options);
+}
+
 Expected<void> LiteRtCompiledModelT::InitializeModel(
     LiteRtModelT& model, LiteRtHwAcceleratorSet hw_accelerators,
     LiteRtOptions options, LiteRtEnvironmentT& env) {
@@ -506,6 +643,36 @@ class ScopedCompilationOptionsModifier {
   int num_appended_options_ = 0;
 };
 
+// Returns the GPU accelerator item of the `options` list, or null if there is
+// none.
+LiteRtOpaqueOptions FindGpuOptions(LiteRtOpaqueOptions options) {
+  const absl::string_view gpu_identifier =
+      LiteRtGetGpuOptionsPayloadIdentifier();
+  for (; options != nullptr; LiteRtGetNextOpaqueOptions(&options)) {
+    const char* identifier = nullptr;
+    if (LiteRtGetOpaqueOptionsIdentifier(options, &identifier) ==
+            kLiteRtStatusOk &&
+        identifier != nullptr && identifier == gpu_identifier) {
+      return options;
+    }
+  }
+  return nullptr;
+}
+
+// Returns whether the user chose where the GPU accelerator serializes its
+// compiled programs.
+bool HasGpuSerializationDir(LiteRtOpaqueOptions gpu_options) {
+  void* payload = nullptr;
+  const char* serialization_dir = nullptr;
+  return LiteRtGetOpaqueOptionsData(gpu_options, &payload) ==
+             kLiteRtStatusOk &&
+         LiteRtGetGpuAcceleratorCompilationOptionsSerializationDir(
+             &serialization_dir,
+             reinterpret_cast<LiteRtGpuOptionsPayload>(payload)) ==
+             kLiteRtStatusOk &&
+         serialization_dir != nullptr;
+}
+
 }  // namespace
 
 Expected<LiteRtCompiledModelT::Ptr> LiteRtCompiledModelT::Create(
@@ -521,18 +688,100 @@ Expected<LiteRtCompiledModelT::Ptr> LiteRtCompiledModelT::Create(
   LiteRtHwAcceleratorSet hardware_accelerators = kLiteRtHwAcceleratorNone;
   LITERT_RETURN_IF_ERROR(LiteRtGetOptionsHardwareAccelerators(
       jit_compilation_options, &hardware_accelerators));
+  if (jit_compilation_options->auto_hardware_accelerators) {
+    hardware_accelerators =
+        SelectHardwareAccelerators(*env, *model, hardware_accelerators);
+  }
 
   if (hardware_accelerators == kLiteRtHwAcceleratorNone) {
     return litert::ErrorStatusBuilder::InvalidArgument()
            << "No acceleration provided.";
   }
 
+#if !defined(LITERT_DISABLE_NPU)
+  if (ShouldJitCompileInBackground(*model, hardware_accelerators,
+                                   jit_compilation_options, *env)) {
+    // Run on the other accelerators until the JIT compiled graph is ready.
+    const LiteRtHwAcceleratorSet fallback_accelerators =
+        (hardware_accelerators & ~kLiteRtHwAcceleratorNpu) |
+        kLiteRtHwAcceleratorCpu;
+    LITERT_RETURN_IF_ERROR(compiled_model->InitializeModel(
+        *model, kLiteRtHwAcceleratorNone, jit_compilation_options, *env));
+    LITERT_RETURN_IF_ERROR(compiled_model->InitializeExecution(
+        fallback_accelerators, jit_compilation_options));
+    LITERT_RETURN_IF_ERROR(compiled_model->StartBackgroundJitCompilation(
+        *model, hardware_accelerators, jit_compilation_options));
+    compiled_model->AddMemoryTrimmer();
+    return compiled_model;
+  }
+#endif  // !defined(LITERT_DISABLE_NPU)
+
+  const absl::Time compilation_start = absl::Now();
   LITERT_RETURN_IF_ERROR(compiled_model->InitializeModel(
       *model, hardware_accelerators, jit_compilation_options, *env));
+  compiled_model->startup_timings_.compilation =
+      absl::Now() - compilation_start;
+
+  LITERT_RETURN_IF_ERROR(compiled_model->InitializeExecution(
+      hardware_accelerators, jit_compilation_options));
+  compiled_model->AddMemoryTrimmer();
+  return compiled_model;
+}
+
+Expected<LiteRtCompiledModelT::Ptr> LiteRtCompiledModelT::CreateShared(
+    LiteRtCompiledModelT& primary, LiteRtOptions jit_compilation_options) {
+  if (!jit_compilation_options) {
+    return litert::ErrorStatusBuilder::InvalidArgument()
+           << "No compilation options passed.";
+  }
+  const char* model_base = primary.GetModelBase();
+  if (model_base == nullptr) {
+    return Error(kLiteRtStatusErrorInvalidArgument,
+                 "Primary compiled model is not initialized.");
+  }
 
-  LITERT_RETURN_IF_ERROR(compiled_model->InitializeRuntime(
-      env, hardware_accelerators, jit_compilation_options));
-  if (compiled_model->GetModelBase() == nullptr) {
+  LiteRtHwAcceleratorSet hardware_accelerators = kLiteRtHwAcceleratorNone;
+  LITERT_RETURN_IF_ERROR(LiteRtGetOptionsHardwareAccelerators(
+      jit_compilation_options, &hardware_accelerators));
+  if (hardware_accelerators == kLiteRtHwAcceleratorNone) {
+    return litert::ErrorStatusBuilder::InvalidArgument()
+           << "No acceleration provided.";
+  }
+
+  auto compiled_model = std::make_unique<LiteRtCompiledModelT>(primary.env_);
+  // The flatbuffer was already produced (and JIT compiled, if requested) by
+  // the primary compiled model. Wrap the same memory without copying it so
+  // that constant tensors and dispatch bytecode are shared.
+  compiled_model->fb_model_ = tflite::FlatBufferModel::BuildFromBuffer(
+      model_base, primary.fb_model_->allocation()->bytes(),
+      compiled_model->error_reporter_.get());
+  if (compiled_model->fb_model_ == nullptr) {
+    return Error(kLiteRtStatusErrorRuntimeFailure,
+                 "Failed to wrap the primary flatbuffer model.");
+  }
+  compiled_model->fb_model_fd_ = primary.fb_model_fd_;
+  compiled_model->model_directory_ = primary.model_directory_;
+
+  LITERT_RETURN_IF_ERROR(compiled_model->InitializeExecution(
+      hardware_accelerators, jit_compilation_options));
+  compiled_model->AddMemoryTrimmer();
+  return compiled_model;
+}
+
+void LiteRtCompiledModelT::AddMemoryTrimmer() {
+  env_->AddMemoryTrimmer(this, [this](LiteRtTrimMemoryLevel level) {
+    return TrimMemory(level);
+  });
+}
+
+Expected<void> LiteRtCompiledModelT::InitializeExecution(
+    LiteRtHwAcceleratorSet hardware_accelerators,
+    LiteRtOptions jit_compilation_options) {
+  absl::Time phase_start = absl::Now();
+  LITERT_RETURN_IF_ERROR(
+      InitializeRuntime(env_, hardware_accelerators, jit_compilation_options));
+  startup_timings_.runtime_initialization = absl::Now() - phase_start;
+  if (GetModelBase() == nullptr) {
     return Error(kLiteRtStatusErrorRuntimeFailure,
                  "Failed to initialize model memory.");
   }
@@ -543,16 +792,81 @@ Expected<LiteRtCompiledModelT::Ptr> LiteRtCompiledModelT::Create(
     // Add information about the model allocation to the opaque chain.
     LITERT_ASSIGN_OR_RETURN(auto dispatch_options,
                             DispatchDelegateOptions::Create());
-    LITERT_RETURN_IF_ERROR(
-        dispatch_options.SetAllocBase(compiled_model->GetModelBase()));
-    LITERT_RETURN_IF_ERROR(
-        dispatch_options.SetAllocBaseFd(compiled_model->fb_model_fd_));
+    LITERT_RETURN_IF_ERROR(dispatch_options.SetAllocBase(GetModelBase()));
+    LITERT_RETURN_IF_ERROR(dispatch_options.SetAllocBaseFd(fb_model_fd_));
     LITERT_RETURN_IF_ERROR(scoped_modifier.Append(std::move(dispatch_options)));
   }
 
+  // Unless the user chose where the GPU accelerator serializes its compiled
+  // programs, point it at the compilation cache of the environment, so that
+  // the next compiled model of the same model skips compiling and tuning its
+  // kernels. The options the user owns are restored once the delegates are
+  // created.
+  LiteRtOpaqueOptions user_gpu_options = nullptr;
+  absl::Cleanup restore_user_gpu_options = [&user_gpu_options] {
+    if (user_gpu_options != nullptr) {
+      LiteRtSetGpuAcceleratorCompilationOptionsSerializationDir(
+          user_gpu_options, nullptr);
+      LiteRtSetGpuAcceleratorCompilationOptionsModelCacheKey(user_gpu_options,
+                                                             nullptr);
+    }
+  };
+  std::optional<LiteRtAny> cache_dir_option =
+      env_->GetOption(kLiteRtEnvOptionTagCompilerCacheDir);
+  const bool has_cache_dir = cache_dir_option.has_value() &&
+                             cache_dir_option->type == kLiteRtAnyTypeString;
+  if (has_cache_dir && model_cache_key_.empty()) {
+    // The accelerators add the fingerprint of their own options to the entries
+    // they write, so the key only needs to identify the model.
+    model_cache_key_ = absl::StrFormat(
+        "%016x",
+        litert::StableHash(GetModelBase(), fb_model_->allocation()->bytes()));
+  }
+  // Lets the accelerators that cache their compilation without accelerator
+  // specific options, e.g. NNAPI, find the entries of this model.
+  absl::Cleanup clear_model_cache_key = [jit_compilation_options] {
+    jit_compilation_options->model_cache_key.clear();
+  };
+  if (has_cache_dir) {
+    jit_compilation_options->model_cache_key = model_cache_key_;
+  }
+
+  if (hardware_accelerators & kLiteRtHwAcceleratorGpu) {
+    LiteRtOpaqueOptions gpu_options =
+        FindGpuOptions(jit_compilation_options->options);
+    if (has_cache_dir &&
+        (gpu_options == nullptr || !HasGpuSerializationDir(gpu_options))) {
+      gpu_serialization_dir_ = cache_dir_option->str_value;
+      if (gpu_options == nullptr) {
+        LITERT_ASSIGN_OR_RETURN(auto new_gpu_options,
+                                litert::GpuOptions::Create());
+        LITERT_RETURN_IF_ERROR(new_gpu_options.SetSerializationDir(
+            gpu_serialization_dir_.c_str()));
+        LITERT_RETURN_IF_ERROR(
+            new_gpu_options.SetModelCacheKey(model_cache_key_.c_str()));
+        LITERT_RETURN_IF_ERROR(
+            scoped_modifier.Append(std::move(new_gpu_options)));
+      } else {
+        user_gpu_options = gpu_options;
+        LITERT_RETURN_IF_ERROR(
+            LiteRtSetGpuAcceleratorCompilationOptionsSerializationDir(
+                gpu_options, gpu_serialization_dir_.c_str()));
+        LITERT_RETURN_IF_ERROR(
+            LiteRtSetGpuAcceleratorCompilationOptionsModelCacheKey(
+                gpu_options, model_cache_key_.c_str()));
+      }
+    }
+  }
+
   // Apply accelerators matching the requested hardware support to the
-  // model in the order they were registered.
-  for (auto& accelerator : env->GetAcceleratorRegistry()) {
+  // model in the order they were registered, loading those that were
+  // registered lazily first.
+  phase_start = absl::Now();
+  env_->GetAcceleratorRegistry().LoadAccelerators(hardware_accelerators);
+  startup_timings_.accelerator_loading = absl::Now() - phase_start;
+  phase_start = absl::Now();
+  applied_accelerators_ = kLiteRtHwAcceleratorNone;
+  for (auto& accelerator : env_->GetAcceleratorRegistry()) {
     LITERT_DEBUG_CODE({
       const char* accelerator_name = nullptr;
       if (accelerator->GetName(accelerator.get(), &accelerator_name) !=
@@ -592,19 +906,22 @@ Expected<LiteRtCompiledModelT::Ptr> LiteRtCompiledModelT::Create(
                                     std::function<void(LiteRtDelegateWrapper)>>{
         delegate_wrapper, accelerator->DestroyDelegate};
 
-    if (compiled_model->interp_->ModifyGraphWithDelegate(delegate_ptr) !=
-        kTfLiteOk) {
+    if (interp_->ModifyGraphWithDelegate(delegate_ptr) != kTfLiteOk) {
       return Unexpected(kLiteRtStatusErrorRuntimeFailure,
                         "Failed to modify graph with delegate");
     }
 
-    compiled_model->RegisterDelegate({std::move(delegate),
-                                      accelerator->StartMetricsCollection,
-                                      accelerator->StopMetricsCollection});
+    RegisterDelegate({std::move(delegate), accelerator->StartMetricsCollection,
+                      accelerator->StopMetricsCollection});
+    applied_accelerators_ |=
+        accelerator_supported_hardware & hardware_accelerators;
   }
+  startup_timings_.delegation = absl::Now() - phase_start;
 
-  LITERT_ASSIGN_OR_RETURN(bool has_non_delegated_ops,
-                          compiled_model->HasNonDelegatedOps());
+  LITERT_ASSIGN_OR_RETURN(bool has_non_delegated_ops, HasNonDelegatedOps());
+  if (has_non_delegated_ops) {
+    applied_accelerators_ |= kLiteRtHwAcceleratorCpu;
+  }
   if (!(hardware_accelerators & kLiteRtHwAcceleratorCpu) &&
       has_non_delegated_ops) {
     return Error(
@@ -612,8 +929,16 @@ Expected<LiteRtCompiledModelT::Ptr> LiteRtCompiledModelT::Create(
         "Some ops are not accelerated. Add kLiteRtHwAcceleratorCpu to the "
         "compilation accelerator set to allow using the CPU to run those.");
   }
-  compiled_model->CheckCpuTensors();
-  return compiled_model;
+  CheckCpuTensors();
+
+  if (lazy_signature_allocation_) {
+    // Delegates that don't support dynamic shapes allocate the tensors of
+    // every subgraph when they are applied.
+    for (size_t i = 0; i < signature_keys_.size(); ++i) {
+      LITERT_RETURN_IF_ERROR(ReleaseSignatureMemory(i));
+    }
+  }
+  return {};
 }
 
 Expected<bool> LiteRtCompiledModelT::HasNonDelegatedOps() {
@@ -641,6 +966,7 @@ Expected<bool> LiteRtCompiledModelT::HasNonDelegatedOps() {
 
 void LiteRtCompiledModelT::CheckCpuTensors() {
   cpu_tensors_.clear();
+  runs_on_host_ = true;
   for (int subgraph_no = 0; subgraph_no < interp_->subgraphs_size();
        ++subgraph_no) {
     auto* subgraph = interp_->subgraph(subgraph_no);
@@ -655,6 +981,7 @@ void LiteRtCompiledModelT::CheckCpuTensors() {
           !(registration.custom_name &&
             registration.custom_name ==
                 absl::string_view("TfLiteXNNPackDelegate"))) {
+        runs_on_host_ = false;
         continue;
       }
       // Don't mark AOT compiled NPU custom ops as CPU nodes.
@@ -662,6 +989,7 @@ void LiteRtCompiledModelT::CheckCpuTensors() {
           registration.custom_name &&
           absl::StrContains(registration.custom_name,
                             litert::internal::kLiteRtDispatchOpCustomName)) {
+        runs_on_host_ = false;
         continue;
       }
       // Mark input of node as CPU tensors.
@@ -681,6 +1009,7 @@ litert::Expected<bool> LiteRtCompiledModelT::ApplyPluginsWithCaching(
   bool need_reserialization = false;
   compilation_cache_ = MaybeCreateCompilationCache(env);
   std::optional<uint64_t> model_hash = std::nullopt;
+  litert::internal::CompilationCache::SourceDigest source_digest;
   // Load the plugins before JIT compilation attempt, so that we can check the
   // cache first.
   auto maybe_compiled_plugins =
@@ -692,11 +1021,16 @@ litert::Expected<bool> LiteRtCompiledModelT::ApplyPluginsWithCaching(
     Expected<uint64_t> maybe_model_hash =
         litert::internal::CompilationCache::TryGetModelHash(
             model, &options, maybe_compiled_plugins);
-    if (maybe_model_hash.HasValue()) {
+    // The digest is taken before the plugins modify the model.
+    auto maybe_source_digest =
+        litert::internal::CompilationCache::GetSourceDigest(model);
+    if (maybe_model_hash.HasValue() && maybe_source_digest.HasValue()) {
       model_hash = maybe_model_hash.Value();
-      if (TryLoadingFromCache(model_hash.value())) {
+      source_digest = maybe_source_digest.Value();
+      if (TryLoadingFromCache(model_hash.value(), source_digest)) {
         LITERT_LOG(LITERT_INFO,
                    "Flatbuffer model initialized from cached model.");
+        startup_timings_.compiler_cache_hit = true;
         return true;
       }
     }
@@ -715,7 +1049,8 @@ litert::Expected<bool> LiteRtCompiledModelT::ApplyPluginsWithCaching(
   if (model_hash.has_value()) {
     LITERT_LOG(LITERT_DEBUG, "Saving JIT compiled model to cache.");
     LITERT_RETURN_IF_ERROR(
-        compilation_cache_.value().SaveModel(serialized, model_hash.value()));
+        compilation_cache_.value().SaveModel(serialized, model_hash.value(),
+                                             source_digest));
   }
 
   model_buf_ = std::move(serialized);
@@ -733,13 +1068,68 @@ litert::Expected<bool> LiteRtCompiledModelT::ApplyPluginsWithCaching(
   return true;
 }
 
-bool LiteRtCompiledModelT::TryLoadingFromCache(uint64_t model_hash) {
+Expected<void> LiteRtCompiledModelT::StartBackgroundJitCompilation(
+    const LiteRtModelT& model, LiteRtHwAcceleratorSet hw_accelerators,
+    LiteRtOptions options) {
+  // The plugins modify the model they are applied to, so work on a copy that
+  // nothing else references.
+  LITERT_ASSIGN_OR_RETURN(auto model_copy,
+                          litert::internal::LoadModelFromBuffer(
+                              litert::internal::GetTflFlatbuffer(model).Buf()));
+  jit_switch_pending_ = true;
+  jit_executor_ = std::make_unique<litert::internal::SerialExecutor>();
+  jit_executor_->Schedule([this, model_copy = std::move(model_copy),
+                           model_directory = model_directory_,
+                           hw_accelerators, options]() mutable {
+    auto jit_compiled_model =
+        JitCompile(env_, std::move(model_copy), std::move(model_directory),
+                   hw_accelerators, options);
+    absl::MutexLock lock(jit_mutex_);
+    if (jit_compiled_model) {
+      LITERT_LOG(LITERT_INFO, "Background JIT compilation completed.");
+      jit_compiled_model_ = std::move(*jit_compiled_model);
+      jit_status_ = {};
+      jit_result_ready_.store(true, std::memory_order_release);
+    } else {
+      LITERT_LOG(LITERT_WARNING,
+                 "Background JIT compilation failed, the model keeps running "
+                 "without the NPU: %s",
+                 jit_compiled_model.Error().Message().c_str());
+      jit_status_ = jit_compiled_model.Error();
+    }
+  });
+  return {};
+}
+
+Expected<LiteRtCompiledModelT::Ptr> LiteRtCompiledModelT::JitCompile(
+    LiteRtEnvironmentT* env, LiteRtModelT::Ptr model,
+    std::optional<std::string> model_directory,
+    LiteRtHwAcceleratorSet hw_accelerators, LiteRtOptions options) {
+  auto compiled_model = std::make_unique<LiteRtCompiledModelT>(env);
+  LITERT_RETURN_IF_ERROR(
+      litert::internal::ReplaceMagicNumbersIfAny(*env, *model));
+  LITERT_ASSIGN_OR_RETURN(bool compiled,
+                          compiled_model->ApplyPluginsWithCaching(
+                              *model, hw_accelerators, *options, *env));
+  if (!compiled) {
+    return Error(kLiteRtStatusErrorCompilation,
+                 "No compiler plugin compiled the model.");
+  }
+  compiled_model->model_directory_ = std::move(model_directory);
+  LITERT_RETURN_IF_ERROR(
+      compiled_model->InitializeExecution(hw_accelerators, options));
+  return compiled_model;
+}
+
+bool LiteRtCompiledModelT::TryLoadingFromCache(
+    uint64_t model_hash,
+    const litert::internal::CompilationCache::SourceDigest& source_digest) {
   if (!compilation_cache_.has_value()) {
     return false;
   }
   // Check if we compiled this model before.
   litert::Expected<std::optional<LiteRtModelT::Ptr>> maybe_cached_model =
-      compilation_cache_.value().TryLoadModel(model_hash);
+      compilation_cache_.value().TryLoadModel(model_hash, source_digest);
   if (!maybe_cached_model) {
     // The model was found in the cache, but failed to load.
     LITERT_LOG(LITERT_WARNING, "Failed to load model from cache: %s",
@@ -890,6 +1280,7 @@ litert::Expected<LiteRtLayout> LiteRtCompiledModelT::GetInputTensorLayout(
 Expected<void> LiteRtCompiledModelT::GetOutputTensorShapes(
     absl::string_view signature_key, absl::Span<LiteRtLayout>& output_layouts,
     bool update_allocation) {
+  WaitForPendingAsyncRun();
   auto runner = GetSignatureRunner(signature_key);
   if (runner == nullptr) {
     return Unexpected(kLiteRtStatusErrorNotFound,
@@ -940,7 +1331,8 @@ Expected<void> LiteRtCompiledModelT::RegisterBuffer(
     tflite::SignatureRunner* runner, TfLiteTensor* tensor,
     const char* tensor_name, LiteRtTensorBufferT* buffer, bool is_input,
     std::vector<LiteRtTensorBuffer>& locked_buffers,
-    std::vector<ConstantOutputInfo>& constant_outputs) {
+    std::vector<ConstantOutputInfo>& constant_outputs,
+    HostEventStates* deferred_input_events) {
   LITERT_DEBUG_CODE({
     absl::string_view io = is_input ? "input" : "output";
     auto buffer_type = litert::BufferTypeToString(buffer->buffer_type());
@@ -967,6 +1359,7 @@ Expected<void> LiteRtCompiledModelT::RegisterBuffer(
       // also be resized. This can invalidate previously cached buffer
       // requirements, so we clear the cache.
       cpu_buffer_requirements_.clear();
+      ++binding_epoch_;
       // Shape change detected - perform automatic resize.
       if (runner->ResizeInputTensor(
               tensor_name, std::vector<int>(buffer_shape.begin(),
@@ -1049,6 +1442,25 @@ Expected<void> LiteRtCompiledModelT::RegisterBuffer(
     }
 #endif
     if (buffer_is_cpu_compatible) {
+      if (is_constant_output && HoldsConstantOutput(tensor, buffer)) {
+        return {};
+      }
+      if (is_input && deferred_input_events != nullptr &&
+          buffer->buffer_type() == kLiteRtTensorBufferTypeHostMemory &&
+          buffer->HasPendingEvent()) {
+        LITERT_ASSIGN_OR_RETURN(LiteRtEventT * event, buffer->GetEvent());
+        if (event->type == LiteRtEventTypeHost) {
+          // The address of host memory doesn't depend on the event, so the
+          // wait is left to the invocation.
+          LITERT_ASSIGN_OR_RETURN(void* host_mem_addr,
+                                  buffer->GetHostBuffer());
+          deferred_input_events->push_back(event->host_state);
+          runner->SetCustomAllocationForInputTensor(
+              tensor_name, {host_mem_addr, buffer->buffer_size()},
+              /*flags=*/0);
+          return {};
+        }
+      }
       void* host_mem_addr;
       LiteRtTensorBufferLockMode lock_mode =
           is_input ? kLiteRtTensorBufferLockModeRead
@@ -1065,8 +1477,8 @@ Expected<void> LiteRtCompiledModelT::RegisterBuffer(
       // If this is a constant output, save the locked address for later data
       // copying
       if (is_constant_output) {
-        constant_outputs.push_back(
-            {buffer, host_mem_addr, tensor_name, buffer->buffer_size()});
+        constant_outputs.push_back({buffer, host_mem_addr, tensor_name,
+                                    buffer->buffer_size(), tensor});
         LITERT_LOG(LITERT_INFO,
                    "Tracked constant output tensor %s with locked address",
                    tensor_name);
@@ -1098,6 +1510,9 @@ Expected<void> LiteRtCompiledModelT::RegisterBuffer(
   LITERT_ASSIGN_OR_RETURN(const auto tensor_id,
                           GetTensorIdentifier(*interp_, tensor));
   if (cpu_tensors_.find(tensor_id) != cpu_tensors_.end()) {
+    if (is_constant_output && HoldsConstantOutput(tensor, buffer)) {
+      return {};
+    }
     void* host_mem_addr;
     if (auto status = LiteRtLockTensorBuffer(
             buffer, &host_mem_addr, kLiteRtTensorBufferLockModeReadWrite);
@@ -1109,8 +1524,8 @@ Expected<void> LiteRtCompiledModelT::RegisterBuffer(
     // If this is a constant output, save the locked address for later data
     // copying
     if (is_constant_output) {
-      constant_outputs.push_back(
-          {buffer, host_mem_addr, tensor_name, buffer->buffer_size()});
+      constant_outputs.push_back({buffer, host_mem_addr, tensor_name,
+                                  buffer->buffer_size(), tensor});
       LITERT_LOG(LITERT_INFO,
                  "Tracked CPU constant output tensor %s with locked address",
                  tensor_name);
@@ -1139,6 +1554,13 @@ Expected<void> LiteRtCompiledModelT::Run(
     absl::string_view signature_key,
     const std::vector<LiteRtTensorBuffer>& input_buffers,
     const std::vector<LiteRtTensorBuffer>& output_buffers, bool& async) {
+  LITERT_PERFETTO_TRACE_EVENT("LiteRT::Run");
+  absl::MutexLock trim_lock(trim_mutex_);
+  litert::internal::RunTelemetryRecorder telemetry(env_);
+  WaitForPendingAsyncRun();
+  MaybeSwitchToBackgroundJitResult();
+  // The buffers registered below replace the ones bound by any execution plan.
+  ++binding_epoch_;
   uint64_t event_handle = std::numeric_limits<uint64_t>::max();
   if (profiler_ && profiler_->IsProfiling()) {
     profiler_->SetCurrentEventSource(ProfiledEventSource::LITERT);
@@ -1164,6 +1586,8 @@ Expected<void> LiteRtCompiledModelT::Run(
     return Unexpected(kLiteRtStatusErrorRuntimeFailure,
                       "Output buffer size mismatch");
   }
+  telemetry.SetRun(runner->signature_key().c_str(), applied_accelerators_,
+                   input_buffers, output_buffers);
 
   // In general output buffer events are assigned by the runtime and not the
   // caller; here we check for any violation of that condition.
@@ -1188,6 +1612,10 @@ Expected<void> LiteRtCompiledModelT::Run(
       }
     }
   });
+  // Host runs don't block the caller on the producers of their inputs.
+  HostEventStates deferred_input_events;
+  HostEventStates* maybe_deferred_input_events =
+      async && runs_on_host_ ? &deferred_input_events : nullptr;
   for (int i = 0; i < num_inputs; ++i) {
     const auto& input_name = runner->subgraph_input_names()[i];
     auto* input_tensor = runner->input_tensor(input_name);
@@ -1196,9 +1624,10 @@ Expected<void> LiteRtCompiledModelT::Run(
       // been bound to an external buffer.
       continue;
     }
-    auto res =
-        RegisterBuffer(runner, input_tensor, input_name, input_buffers[i],
-                       /*is_input=*/true, locked_buffers, constant_outputs);
+    auto res = RegisterBuffer(runner, input_tensor, input_name,
+                              input_buffers[i], /*is_input=*/true,
+                              locked_buffers, constant_outputs,
+                              maybe_deferred_input_events);
 
     if (!res) {
       return Unexpected(kLiteRtStatusErrorRuntimeFailure,
@@ -1210,10 +1639,11 @@ Expected<void> LiteRtCompiledModelT::Run(
   for (int i = 0; i < runner->subgraph_output_names().size(); ++i) {
     const auto& output_name = runner->subgraph_output_names()[i];
     auto* output_tensor = runner->output_tensor(output_name);
-    auto res =
-        RegisterBuffer(runner, const_cast<TfLiteTensor*>(output_tensor),
-                       output_name, output_buffers[i],
-                       /*is_input=*/false, locked_buffers, constant_outputs);
+    auto res = RegisterBuffer(runner, const_cast<TfLiteTensor*>(output_tensor),
+                              output_name, output_buffers[i],
+                              /*is_input=*/false, locked_buffers,
+                              constant_outputs,
+                              /*deferred_input_events=*/nullptr);
 
     if (!res) {
       return Unexpected(
@@ -1236,9 +1666,126 @@ Expected<void> LiteRtCompiledModelT::Run(
                       "Failed to allocate tensors");
   }
 
+  return InvokeAndSync(runner, input_buffers, output_buffers, constant_outputs,
+                       locked_buffers, std::move(deferred_input_events), async,
+                       telemetry);
+}
+
+Expected<void> LiteRtCompiledModelT::InvokeAndSync(
+    tflite::SignatureRunner* runner,
+    absl::Span<const LiteRtTensorBuffer> input_buffers,
+    absl::Span<const LiteRtTensorBuffer> output_buffers,
+    absl::Span<const ConstantOutputInfo> constant_outputs,
+    absl::Span<const LiteRtTensorBuffer> locked_buffers,
+    HostEventStates deferred_input_events, bool& async,
+    litert::internal::RunTelemetryRecorder& telemetry) {
+  uint64_t event_handle = std::numeric_limits<uint64_t>::max();
+
+  if (async) {
+    LITERT_ASSIGN_OR_RETURN(
+        bool scheduled,
+        TryScheduleHostInvoke(runner, input_buffers, output_buffers,
+                              constant_outputs, locked_buffers,
+                              deferred_input_events, telemetry));
+    if (scheduled) {
+      return {};
+    }
+  }
+  LITERT_RETURN_IF_ERROR(WaitForHostEvents(deferred_input_events));
+
   // Relay the intended async execution mode to DelegateKernel of Accelerator.
   buffer_context_->SetAsyncExecutionMode(async);
 
+  telemetry.BeginInvoke();
+  auto invoked = Invoke(runner, constant_outputs);
+  telemetry.EndInvoke(invoked ? kLiteRtStatusOk : invoked.Error().Status());
+  LITERT_RETURN_IF_ERROR(invoked);
+
+  if (profiler_ && profiler_->IsProfiling()) {
+    profiler_->SetCurrentEventSource(ProfiledEventSource::LITERT);
+    event_handle = profiler_->BeginEvent(
+        "LiteRT::Run[Buffer sync]", tflite::Profiler::EventType::DEFAULT, 0, 0);
+  }
+
+  if (async) {
+    // If the caller requested async execution, then set async to true if any
+    // of the output buffers have been assigned a synchronization event.
+    async = false;
+    for (auto& tb : output_buffers) {
+      async |= tb->HasEvent();
+    }
+  } else {
+    // If the caller has not requested async execution, then wait on
+    // synchronization events that have been attached to the outputs.
+    for (auto& tb : output_buffers) {
+      if (tb->HasEvent()) {
+        LITERT_ASSIGN_OR_RETURN(LiteRtEventT * event, tb->GetEvent());
+        if (auto waited = event->Wait(/*timeout_in_ms=*/-1); !waited) {
+          telemetry.SetStatus(waited.Error().Status());
+          return waited.Error();
+        }
+      }
+    }
+  }
+  telemetry.EndSync(async);
+  if (profiler_ && profiler_->IsProfiling() &&
+      event_handle != std::numeric_limits<uint64_t>::max()) {
+    profiler_->SetCurrentEventSource(ProfiledEventSource::LITERT);
+    profiler_->EndEvent(event_handle);
+  }
+
+  return {};
+}
+
+Expected<void> LiteRtCompiledModelT::WaitForHostEvents(
+    absl::Span<const std::shared_ptr<litert::internal::HostEventState>>
+        host_event_states) {
+  for (const auto& host_event_state : host_event_states) {
+    host_event_state->notification.WaitForNotification();
+    if (host_event_state->status != kLiteRtStatusOk) {
+      return Unexpected(host_event_state->status,
+                        "The operation producing an input failed");
+    }
+  }
+  return {};
+}
+
+bool LiteRtCompiledModelT::HoldsConstantOutput(
+    const TfLiteTensor* tensor, const LiteRtTensorBufferT* buffer) const {
+  // Other buffer types may be written by a device without being locked, and
+  // wrapped host memory through the pointer of its owner.
+  if (!buffer->OwnsHostMemory()) {
+    return false;
+  }
+  auto filled = filled_constant_outputs_.find(tensor);
+  return filled != filled_constant_outputs_.end() &&
+         filled->second == buffer->ContentVersion();
+}
+
+Expected<void> LiteRtCompiledModelT::Invoke(
+    tflite::SignatureRunner* runner,
+    absl::Span<const ConstantOutputInfo> constant_outputs) {
+  LITERT_PERFETTO_TRACE_EVENT("LiteRT::Invoke");
+  // The threads of the built-in kernels, created by the first invocation,
+  // inherit the affinity.
+  litert::internal::ScopedCpuAffinity affinity(affinity_cpus_);
+  // The runs with a priority hold their device while invoking the graph, and
+  // yield it between nodes from CheckCancelledWrapper().
+  auto run_slot = env_->GetRunScheduler().Acquire(
+      litert::internal::RunScheduler::GetDevice(applied_accelerators_),
+      run_priority_,
+      run_deadline_ > absl::ZeroDuration() ? absl::Now() + run_deadline_
+                                           : absl::InfiniteFuture());
+  run_slot_ = run_slot ? &run_slot : nullptr;
+  auto clear_run_slot = absl::MakeCleanup([this]() { run_slot_ = nullptr; });
+  // In the sampling mode, the profiler times every run and aggregates the op
+  // events of the profiled ones.
+  const bool profiled_run = profiler_ && profiler_->BeginRun();
+  auto end_run = absl::MakeCleanup([this, profiled_run]() {
+    if (profiled_run) {
+      profiler_->EndRun();
+    }
+  });
   if (auto res = runner->Invoke(); res != kTfLiteOk) {
     if (res == kTfLiteCancelled) {
       return Unexpected(kLiteRtStatusCancelled, "Execution was cancelled");
@@ -1256,6 +1803,11 @@ Expected<void> LiteRtCompiledModelT::Run(
       if (constant_output.locked_address != nullptr) {
         memcpy(constant_output.locked_address, const_data_ptr,
                constant_output.data_size);
+        if (constant_output.buffer->buffer_type() ==
+            kLiteRtTensorBufferTypeHostMemory) {
+          filled_constant_outputs_[constant_output.tensor] =
+              constant_output.buffer->ContentVersion();
+        }
       } else {
         LITERT_LOG(LITERT_WARNING,
                    "Failed to obtain CPU view for constant output tensor %s",
@@ -1263,37 +1815,90 @@ Expected<void> LiteRtCompiledModelT::Run(
       }
     }
   }
+  return {};
+}
 
-  if (profiler_ && profiler_->IsProfiling()) {
-    profiler_->SetCurrentEventSource(ProfiledEventSource::LITERT);
-    event_handle = profiler_->BeginEvent(
-        "LiteRT::Run[Buffer sync]", tflite::Profiler::EventType::DEFAULT, 0, 0);
+Expected<bool> LiteRtCompiledModelT::TryScheduleHostInvoke(
+    tflite::SignatureRunner* runner,
+    absl::Span<const LiteRtTensorBuffer> input_buffers,
+    absl::Span<const LiteRtTensorBuffer> output_buffers,
+    absl::Span<const ConstantOutputInfo> constant_outputs,
+    absl::Span<const LiteRtTensorBuffer> locked_buffers,
+    HostEventStates& deferred_input_events,
+    litert::internal::RunTelemetryRecorder& telemetry) {
+  if (!runs_on_host_) {
+    return false;
+  }
+  // The input buffers are unlocked when registered, and the locked buffers by
+  // the caller right after this returns. This is only safe for host memory,
+  // whose address stays valid once unlocked; other buffer types are run
+  // synchronously. Inputs bound to external buffers are null.
+  auto is_host_memory = [](LiteRtTensorBuffer buffer) {
+    return buffer == nullptr ||
+           buffer->buffer_type() == kLiteRtTensorBufferTypeHostMemory;
+  };
+  if (!std::all_of(input_buffers.begin(), input_buffers.end(),
+                   is_host_memory) ||
+      !std::all_of(locked_buffers.begin(), locked_buffers.end(),
+                   is_host_memory) ||
+      !std::all_of(output_buffers.begin(), output_buffers.end(),
+                   is_host_memory)) {
+    return false;
   }
 
-  if (async) {
-    // If the caller requested async execution, then set async to true if any
-    // of the output buffers have been assigned a synchronization event.
-    async = false;
-    for (auto& tb : output_buffers) {
-      async |= tb->HasEvent();
-    }
-  } else {
-    // If the caller has not requested async execution, then wait on
-    // synchronization events that have been attached to the outputs.
-    for (auto& tb : output_buffers) {
-      if (tb->HasEvent()) {
-        LITERT_ASSIGN_OR_RETURN(LiteRtEventT * event, tb->GetEvent());
-        LITERT_RETURN_IF_ERROR(event->Wait(/*timeout_in_ms=*/-1));
-      }
+  // Keep the buffers alive until the invocation has completed, in case the
+  // caller releases them in the meantime.
+  std::vector<LiteRtTensorBuffer> retained_buffers;
+  retained_buffers.reserve(input_buffers.size() + locked_buffers.size());
+  for (auto buffer : input_buffers) {
+    if (buffer != nullptr) {
+      retained_buffers.push_back(buffer);
     }
   }
-  if (profiler_ && profiler_->IsProfiling() &&
-      event_handle != std::numeric_limits<uint64_t>::max()) {
-    profiler_->SetCurrentEventSource(ProfiledEventSource::LITERT);
-    profiler_->EndEvent(event_handle);
+  retained_buffers.insert(retained_buffers.end(), locked_buffers.begin(),
+                          locked_buffers.end());
+  for (auto buffer : retained_buffers) {
+    buffer->Duplicate();
   }
 
-  return {};
+  // All the output events share the completion state of the invocation.
+  auto state = std::make_shared<litert::internal::HostEventState>();
+  for (auto buffer : output_buffers) {
+    buffer->SetEvent(new LiteRtEventT{
+        .env = env_,
+        .type = LiteRtEventTypeHost,
+        .host_state = state,
+    });
+  }
+
+  if (host_executor_ == nullptr) {
+    host_executor_ = std::make_unique<litert::internal::SerialExecutor>();
+  }
+  host_executor_->Schedule(
+      [this, runner, state = std::move(state),
+       constant_outputs = std::vector<ConstantOutputInfo>(
+           constant_outputs.begin(), constant_outputs.end()),
+       retained_buffers = std::move(retained_buffers),
+       deferred_input_events = std::move(deferred_input_events),
+       telemetry = std::move(telemetry)]() mutable {
+        auto res = WaitForHostEvents(deferred_input_events);
+        if (res) {
+          telemetry.BeginInvoke();
+          res = Invoke(runner, constant_outputs);
+          telemetry.EndInvoke(res ? kLiteRtStatusOk : res.Error().Status());
+        }
+        telemetry.EndSync(/*async=*/true);
+        if (!res) {
+          LITERT_LOG(LITERT_ERROR, "Asynchronous invocation failed: %s",
+                     res.Error().Message().c_str());
+        }
+        for (auto buffer : retained_buffers) {
+          LiteRtDestroyTensorBuffer(buffer);
+        }
+        state->Signal(res ? kLiteRtStatusOk : res.Error().Status());
+        telemetry.Report();
+      });
+  return true;
 }
 
 Expected<void> LiteRtCompiledModelT::RunCApi(
@@ -1323,6 +1928,247 @@ Expected<void> LiteRtCompiledModelT::RunCApi(
   return result;
 }
 
+Expected<LiteRtExecutionPlanT::Ptr> LiteRtCompiledModelT::CreateExecutionPlan(
+    size_t signature_index, absl::Span<const LiteRtTensorBuffer> input_buffers,
+    absl::Span<const LiteRtTensorBuffer> output_buffers) {
+  if (signature_index >= signature_keys_.size()) {
+    return Unexpected(kLiteRtStatusErrorIndexOOB,
+                      "Signature index is out of range of signature keys");
+  }
+  auto* runner = GetSignatureRunner(*signature_keys_[signature_index]);
+  if (runner == nullptr) {
+    return Unexpected(kLiteRtStatusErrorNotFound,
+                      "Failed to get signature runner");
+  }
+  if (input_buffers.size() != runner->subgraph_input_names().size()) {
+    return Unexpected(
+        kLiteRtStatusErrorInvalidArgument,
+        absl::StrCat("Input buffer size mismatch: number of inputs:",
+                     runner->subgraph_input_names().size(),
+                     " vs buffers:", input_buffers.size()));
+  }
+  if (output_buffers.size() != runner->subgraph_output_names().size()) {
+    return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                      "Output buffer size mismatch");
+  }
+  for (auto output_buffer : output_buffers) {
+    if (output_buffer == nullptr) {
+      return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                        "Output buffers must not be null");
+    }
+  }
+
+  auto plan = LiteRtExecutionPlanT::Ptr(
+      new LiteRtExecutionPlanT(this, signature_index, runner));
+  plan->input_buffers_.assign(input_buffers.begin(), input_buffers.end());
+  plan->output_buffers_.assign(output_buffers.begin(), output_buffers.end());
+  for (auto buffer : plan->input_buffers_) {
+    if (buffer != nullptr) {
+      buffer->Duplicate();
+    }
+  }
+  for (auto buffer : plan->output_buffers_) {
+    buffer->Duplicate();
+  }
+  plan->dynamic_inputs_.reserve(input_buffers.size());
+  plan->dynamic_outputs_.reserve(output_buffers.size());
+  plan->locked_buffers_.reserve(input_buffers.size() + output_buffers.size());
+  plan->constant_outputs_.reserve(output_buffers.size());
+  return plan;
+}
+
+Expected<void> LiteRtCompiledModelT::RunExecutionPlan(
+    LiteRtExecutionPlanT& plan, bool& async) {
+  LITERT_PERFETTO_TRACE_EVENT("LiteRT::Run[execution plan]");
+  if (plan.compiled_model_ != this) {
+    return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                      "Execution plan belongs to another compiled model");
+  }
+  absl::MutexLock trim_lock(trim_mutex_);
+  litert::internal::RunTelemetryRecorder telemetry(env_);
+  if (telemetry.IsRecording()) {
+    telemetry.SetRun(signature_keys_[plan.signature_index_]->c_str(),
+                     applied_accelerators_, plan.input_buffers_,
+                     plan.output_buffers_);
+  }
+  WaitForPendingAsyncRun();
+  MaybeSwitchToBackgroundJitResult();
+  for (auto output_buffer : plan.output_buffers_) {
+    if (output_buffer->HasEvent()) {
+      return Error(kLiteRtStatusErrorInvalidArgument,
+                   "Output buffers cannot have events attached");
+    }
+  }
+
+  const bool full_registration = plan.bound_epoch_ != binding_epoch_;
+  if (full_registration) {
+    // The interpreter is replaced when switching to the JIT compiled graph.
+    plan.runner_ = GetSignatureRunner(*signature_keys_[plan.signature_index_]);
+  }
+  auto* runner = plan.runner_;
+  const auto& input_names = runner->subgraph_input_names();
+  const auto& output_names = runner->subgraph_output_names();
+
+  uint64_t event_handle = std::numeric_limits<uint64_t>::max();
+  if (profiler_ && profiler_->IsProfiling() &&
+      (full_registration || !plan.dynamic_inputs_.empty() ||
+       !plan.dynamic_outputs_.empty())) {
+    profiler_->SetCurrentEventSource(ProfiledEventSource::LITERT);
+    event_handle =
+        profiler_->BeginEvent("LiteRT::Run[buffer registration]",
+                              tflite::Profiler::EventType::DEFAULT, 0, 0);
+  }
+
+  plan.locked_buffers_.clear();
+  plan.constant_outputs_.clear();
+  auto unlock_buffers = absl::MakeCleanup([&plan]() {
+    for (auto locked_buffer : plan.locked_buffers_) {
+      if (LiteRtUnlockTensorBuffer(locked_buffer) != kLiteRtStatusOk) {
+        LITERT_LOG(LITERT_ERROR, "Failed to unlock buffer %p", locked_buffer);
+        ABSL_DCHECK(false);
+      }
+    }
+  });
+
+  HostEventStates deferred_input_events;
+  HostEventStates* maybe_deferred_input_events =
+      async && runs_on_host_ ? &deferred_input_events : nullptr;
+  auto register_input = [&](size_t i) -> Expected<void> {
+    auto res = RegisterBuffer(runner, runner->input_tensor(input_names[i]),
+                              input_names[i], plan.input_buffers_[i],
+                              /*is_input=*/true, plan.locked_buffers_,
+                              plan.constant_outputs_,
+                              maybe_deferred_input_events);
+    if (!res) {
+      return Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                        absl::StrCat("Failed to register input tensor buffer: ",
+                                     res.Error().Message()));
+    }
+    return {};
+  };
+  auto register_output = [&](size_t i) -> Expected<void> {
+    auto* output_tensor =
+        const_cast<TfLiteTensor*>(runner->output_tensor(output_names[i]));
+    auto res = RegisterBuffer(
+        runner, output_tensor, output_names[i], plan.output_buffers_[i],
+        /*is_input=*/false, plan.locked_buffers_, plan.constant_outputs_,
+        /*deferred_input_events=*/nullptr);
+    if (!res) {
+      return Unexpected(
+          kLiteRtStatusErrorRuntimeFailure,
+          absl::StrCat("Failed to register output tensor buffer: ",
+                       res.Error().Message()));
+    }
+    return {};
+  };
+
+  bool needs_allocation = full_registration;
+  if (full_registration) {
+    ++binding_epoch_;
+    plan.bound_epoch_.reset();
+    plan.dynamic_inputs_.clear();
+    plan.dynamic_outputs_.clear();
+    for (size_t i = 0; i < plan.input_buffers_.size(); ++i) {
+      if (plan.input_buffers_[i] != nullptr) {
+        LITERT_RETURN_IF_ERROR(register_input(i));
+      }
+    }
+    for (size_t i = 0; i < plan.output_buffers_.size(); ++i) {
+      LITERT_RETURN_IF_ERROR(register_output(i));
+    }
+  } else {
+    for (size_t i : plan.dynamic_inputs_) {
+      LITERT_RETURN_IF_ERROR(register_input(i));
+    }
+    for (size_t i : plan.dynamic_outputs_) {
+      LITERT_RETURN_IF_ERROR(register_output(i));
+    }
+    // Sticky host memory inputs may get an event attached by an upstream
+    // producer after the plan was bound. Such inputs must be locked, which
+    // waits on the event, before the invocation.
+    for (size_t i = 0; i < plan.input_buffers_.size(); ++i) {
+      auto* buffer = plan.input_buffers_[i];
+      if (buffer != nullptr && buffer->HasEvent() &&
+          buffer->buffer_type() == kLiteRtTensorBufferTypeHostMemory &&
+          std::find(plan.dynamic_inputs_.begin(), plan.dynamic_inputs_.end(),
+                    i) == plan.dynamic_inputs_.end()) {
+        LITERT_RETURN_IF_ERROR(register_input(i));
+      }
+    }
+    needs_allocation =
+        !plan.dynamic_inputs_.empty() || !plan.dynamic_outputs_.empty();
+  }
+
+  if (event_handle != std::numeric_limits<uint64_t>::max() && profiler_ &&
+      profiler_->IsProfiling()) {
+    profiler_->SetCurrentEventSource(ProfiledEventSource::LITERT);
+    profiler_->EndEvent(event_handle);
+  }
+
+  if (needs_allocation) {
+    if (auto res = runner->AllocateTensors(); res != kTfLiteOk) {
+      if (error_reporter_) {
+        error_reporter_->Report("Failed to allocate tensors for execution");
+      }
+      return Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                        "Failed to allocate tensors");
+    }
+  }
+
+  if (full_registration) {
+    // Classify the bindings now that the tensors have been allocated, so that
+    // subsequent runs only register the ones that can't be reused as is.
+    for (size_t i = 0; i < plan.input_buffers_.size(); ++i) {
+      auto* buffer = plan.input_buffers_[i];
+      if (buffer != nullptr &&
+          !LiteRtExecutionPlanT::IsStickyBinding(
+              runner->input_tensor(input_names[i]), buffer)) {
+        plan.dynamic_inputs_.push_back(i);
+      }
+    }
+    for (size_t i = 0; i < plan.output_buffers_.size(); ++i) {
+      if (!LiteRtExecutionPlanT::IsStickyBinding(
+              runner->output_tensor(output_names[i]),
+              plan.output_buffers_[i])) {
+        plan.dynamic_outputs_.push_back(i);
+      }
+    }
+    plan.bound_epoch_ = binding_epoch_;
+  }
+
+  return InvokeAndSync(runner, plan.input_buffers_, plan.output_buffers_,
+                       plan.constant_outputs_, plan.locked_buffers_,
+                       std::move(deferred_input_events), async, telemetry);
+}
+
+LiteRtExecutionPlanT::~LiteRtExecutionPlanT() {
+  for (auto buffer : input_buffers_) {
+    if (buffer != nullptr) {
+      LiteRtDestroyTensorBuffer(buffer);
+    }
+  }
+  for (auto buffer : output_buffers_) {
+    LiteRtDestroyTensorBuffer(buffer);
+  }
+}
+
+bool LiteRtExecutionPlanT::IsStickyBinding(const TfLiteTensor* tensor,
+                                           const LiteRtTensorBufferT* buffer) {
+  if (tensor == nullptr) {
+    return false;
+  }
+  // Buffers registered with a delegate through the buffer context stay
+  // registered until they are replaced.
+  if (tensor->allocation_type == kTfLiteNonCpu) {
+    return true;
+  }
+  // Host memory used as a custom allocation keeps its address, and locking it
+  // is only needed to wait on an attached event.
+  return tensor->allocation_type == kTfLiteCustom &&
+         buffer->buffer_type() == kLiteRtTensorBufferTypeHostMemory &&
+         !buffer->HasEvent();
+}
+
 Expected<void> LiteRtCompiledModelT::StartMetricsCollection(int detail_level) {
   if (detail_level < 0) {
     return Unexpected(kLiteRtStatusErrorInvalidArgument,
@@ -1438,8 +2284,83 @@ Expected<bool> LiteRtCompiledModelT::InputTensorNeedsResize(
   return true;
 }
 
+litert::Expected<void> LiteRtCompiledModelT::ReleaseSignatureMemory(
+    size_t signature_index) {
+  absl::MutexLock trim_lock(trim_mutex_);
+  WaitForPendingAsyncRun();
+  if (signature_index >= signature_keys_.size()) {
+    return litert::Unexpected(
+        kLiteRtStatusErrorIndexOOB,
+        "Signature index is out of range of signature keys");
+  }
+  const std::string& signature_key = *signature_keys_[signature_index];
+  const int subgraph_index =
+      signature_key == LiteRtSignatureT::kDefaultSignatureKey
+          ? 0
+          : interp_->GetSubgraphIndexFromSignature(signature_key.c_str());
+  if (subgraph_index < 0 ||
+      interp_->subgraph(subgraph_index)->ReleaseNonPersistentMemory() !=
+          kTfLiteOk) {
+    return litert::Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                              "Failed to release the signature memory");
+  }
+  // Execution plans must allocate the tensors again before their next run.
+  ++binding_epoch_;
+  return {};
+}
+
+size_t LiteRtCompiledModelT::TrimMemory(LiteRtTrimMemoryLevel level) {
+  if (level < kLiteRtTrimMemoryLevelCritical) {
+    return 0;
+  }
+  auto release_arenas = [this]() {
+    size_t num_freed_bytes = 0;
+    for (const std::string* signature_key : signature_keys_) {
+      const int subgraph_index =
+          *signature_key == LiteRtSignatureT::kDefaultSignatureKey
+              ? 0
+              : interp_->GetSubgraphIndexFromSignature(signature_key->c_str());
+      if (subgraph_index < 0) {
+        continue;
+      }
+      tflite::Subgraph* subgraph = interp_->subgraph(subgraph_index);
+      tflite::Subgraph::SubgraphAllocInfo before;
+      subgraph->GetMemoryAllocInfo(&before);
+      if (before.arena_size == 0 ||
+          subgraph->ReleaseNonPersistentMemory() != kTfLiteOk) {
+        continue;
+      }
+      tflite::Subgraph::SubgraphAllocInfo after;
+      subgraph->GetMemoryAllocInfo(&after);
+      num_freed_bytes += before.arena_size - after.arena_size;
+    }
+    if (num_freed_bytes > 0) {
+      // Execution plans must allocate the tensors again before their next run.
+      ++binding_epoch_;
+    }
+    return num_freed_bytes;
+  };
+  // The memory of a running compiled model is kept.
+  if (!trim_mutex_.TryLock()) {
+    return 0;
+  }
+  const size_t num_freed_bytes = HasPendingAsyncRun() ? 0 : release_arenas();
+  trim_mutex_.Unlock();
+  return num_freed_bytes;
+}
+
 litert::Expected<void> LiteRtCompiledModelT::ResizeInputTensor(
     size_t signature_index, size_t input_index, absl::Span<const int> dims) {
+  absl::MutexLock trim_lock(trim_mutex_);
+  WaitForPendingAsyncRun();
+  MaybeSwitchToBackgroundJitResult();
+  if (jit_switch_pending_) {
+    // The JIT compiled graph was built for the original input shapes.
+    LITERT_LOG(LITERT_INFO,
+               "Input resized, the background JIT compilation result won't "
+               "be used.");
+    jit_switch_pending_ = false;
+  }
   if (signature_index >= signature_keys_.size()) {
     return litert::Unexpected(
         kLiteRtStatusErrorIndexOOB,
@@ -1501,9 +2422,38 @@ litert::Expected<void> LiteRtCompiledModelT::ResizeInputTensor(
                               "Tensor does not have a dynamic shape.");
   }
 
+  // Round the shape up to the smallest bucket that holds it. The buckets are
+  // sorted by size.
+  std::vector<int> new_dims(dims.begin(), dims.end());
+  if (auto it = input_shape_buckets_.find({signature_index, input_index});
+      it != input_shape_buckets_.end()) {
+    const auto& buckets = it->second;
+    auto bucket = std::find_if(buckets.begin(), buckets.end(),
+                               [&](const std::vector<int>& shape) {
+                                 for (size_t i = 0; i < dims.size(); ++i) {
+                                   if (shape[i] < dims[i]) {
+                                     return false;
+                                   }
+                                 }
+                                 return true;
+                               });
+    if (bucket == buckets.end()) {
+      return litert::Unexpected(kLiteRtStatusErrorInvalidArgument,
+                                "No shape bucket holds the new shape.");
+    }
+    new_dims = *bucket;
+  }
+
+  // Nothing needs to be planned again if the input already has the shape,
+  // which is the common case once the inputs are bucketed.
+  if (input_tensor->dims &&
+      absl::MakeConstSpan(input_tensor->dims->data, input_tensor->dims->size) ==
+          absl::MakeConstSpan(new_dims)) {
+    return {};
+  }
+
   // Resize the input tensor using TFLite's SignatureRunner API
-  const auto status = runner->ResizeInputTensor(
-      input_name, std::vector<int>(dims.begin(), dims.end()));
+  const auto status = runner->ResizeInputTensor(input_name, new_dims);
   if (status != kTfLiteOk) {
     return litert::Unexpected(kLiteRtStatusErrorRuntimeFailure,
                               "Failed to resize input tensor");
@@ -1512,6 +2462,73 @@ litert::Expected<void> LiteRtCompiledModelT::ResizeInputTensor(
   // Clear cached buffer requirements for all tensors since output and
   // intermediate tensors may change shape after an explicit resize.
   cpu_buffer_requirements_.clear();
+  ++binding_epoch_;
+  return {};
+}
+
+litert::Expected<void> LiteRtCompiledModelT::SetInputShapeBuckets(
+    size_t signature_index, size_t input_index,
+    std::vector<std::vector<int>> buckets) {
+  absl::MutexLock trim_lock(trim_mutex_);
+  if (signature_index >= signature_keys_.size()) {
+    return litert::Unexpected(
+        kLiteRtStatusErrorIndexOOB,
+        "Signature index is out of range of signature keys");
+  }
+  auto* runner = GetSignatureRunner(*signature_keys_[signature_index]);
+  if (runner == nullptr) {
+    return litert::Unexpected(kLiteRtStatusErrorInvalidArgument,
+                              "Failed to get signature runner");
+  }
+  const auto& input_names = runner->subgraph_input_names();
+  if (input_index >= input_names.size()) {
+    return litert::Unexpected(kLiteRtStatusErrorIndexOOB,
+                              "Input index out of range");
+  }
+  auto* input_tensor = runner->input_tensor(input_names[input_index]);
+  if (input_tensor == nullptr) {
+    return litert::Unexpected(kLiteRtStatusErrorNotFound,
+                              "Failed to get input tensor");
+  }
+  const TfLiteIntArray* signature_shape =
+      (input_tensor->dims_signature && input_tensor->dims_signature->size > 0)
+          ? input_tensor->dims_signature
+          : input_tensor->dims;
+
+  if (buckets.empty()) {
+    input_shape_buckets_.erase({signature_index, input_index});
+    return {};
+  }
+
+  // Each bucket must be a valid shape for the input.
+  for (const auto& bucket : buckets) {
+    if (bucket.size() != static_cast<size_t>(signature_shape->size)) {
+      return litert::Unexpected(
+          kLiteRtStatusErrorInvalidArgument,
+          "Shape bucket rank does not match the input rank.");
+    }
+    for (size_t i = 0; i < bucket.size(); ++i) {
+      const int dim = signature_shape->data[i];
+      if (bucket[i] <= 0 || (dim != -1 && dim != bucket[i])) {
+        return litert::Unexpected(
+            kLiteRtStatusErrorInvalidArgument,
+            "Shape bucket is not compatible with the input shape.");
+      }
+    }
+  }
+
+  auto num_elements = [](const std::vector<int>& shape) {
+    size_t n = 1;
+    for (int dim : shape) {
+      n *= dim;
+    }
+    return n;
+  };
+  std::stable_sort(buckets.begin(), buckets.end(),
+                   [&](const std::vector<int>& a, const std::vector<int>& b) {
+                     return num_elements(a) < num_elements(b);
+                   });
+  input_shape_buckets_[{signature_index, input_index}] = std::move(buckets);
   return {};
 }
 
@@ -1565,26 +2582,113 @@ Expected<std::string> LiteRtCompiledModelT::GetErrorMessages() {
 
 bool LiteRtCompiledModelT::CheckCancelledWrapper(void* data) {
   auto* model = static_cast<LiteRtCompiledModelT*>(data);
-  if (model && model->check_cancelled_func_cpp_) {
+  if (model == nullptr) {
+    return false;
+  }
+  // The interpreter checks for cancellation between nodes, where a run can
+  // yield its device.
+  if (model->run_slot_ != nullptr) {
+    model->run_slot_->YieldToHigherPriority();
+  }
+  if (model->check_cancelled_func_cpp_) {
     return model->check_cancelled_func_cpp_();
   }
+  if (model->check_cancelled_func_ != nullptr) {
+    return model->check_cancelled_func_(model->check_cancelled_data_);
+  }
   return false;
 }
 
+void LiteRtCompiledModelT::SetInterpreterCancellationFunction() {
+  if (check_cancelled_func_cpp_ || run_priority_ != kLiteRtRunPriorityNone) {
+    interp_->SetCancellationFunction(this, &CheckCancelledWrapper);
+  } else {
+    interp_->SetCancellationFunction(check_cancelled_data_,
+                                     check_cancelled_func_);
+  }
+}
+
 void LiteRtCompiledModelT::SetCancellationFunction(
     absl::AnyInvocable<bool()> check_cancelled_func) {
   check_cancelled_func_cpp_ = std::move(check_cancelled_func);
   check_cancelled_func_ = nullptr;
-  interp_->SetCancellationFunction(this, &CheckCancelledWrapper);
+  check_cancelled_data_ = nullptr;
+  SetInterpreterCancellationFunction();
 }
 
 void LiteRtCompiledModelT::SetCancellationFunction(
     void* data, bool (*check_cancelled_func)(void*)) {
   check_cancelled_func_ = check_cancelled_func;
+  check_cancelled_data_ = data;
   check_cancelled_func_cpp_ = nullptr;
+  SetInterpreterCancellationFunction();
+}
 
-  // Set the cancellation function on the underlying TFLite interpreter
-  interp_->SetCancellationFunction(data, check_cancelled_func);
+void LiteRtCompiledModelT::SetRunPriority(LiteRtRunPriority priority,
+                                          absl::Duration deadline) {
+  run_priority_ = priority;
+  run_deadline_ = deadline;
+  SetInterpreterCancellationFunction();
+}
+
+Expected<void> LiteRtCompiledModelT::WaitForBackgroundJitCompilation() {
+  if (jit_executor_ == nullptr) {
+    return {};
+  }
+  jit_executor_->WaitForIdle();
+  absl::MutexLock lock(jit_mutex_);
+  return jit_status_;
+}
+
+void LiteRtCompiledModelT::MaybeSwitchToBackgroundJitResult() {
+  if (!jit_switch_pending_ ||
+      !jit_result_ready_.load(std::memory_order_acquire)) {
+    return;
+  }
+  Ptr jit_compiled_model;
+  {
+    absl::MutexLock lock(jit_mutex_);
+    jit_compiled_model = std::move(jit_compiled_model_);
+  }
+  jit_switch_pending_ = false;
+  SwapRuntimeState(*jit_compiled_model);
+  LITERT_LOG(LITERT_INFO, "Switched to the JIT compiled model.");
+  // `jit_compiled_model` now holds the fallback interpreter and is destroyed
+  // here.
+}
+
+void LiteRtCompiledModelT::SwapRuntimeState(LiteRtCompiledModelT& other) {
+  using std::swap;
+  swap(delegates_, other.delegates_);
+  swap(custom_op_dispatchers_, other.custom_op_dispatchers_);
+  swap(cpu_backend_context_, other.cpu_backend_context_);
+  swap(interp_, other.interp_);
+  swap(fb_model_, other.fb_model_);
+  swap(model_buf_, other.model_buf_);
+  swap(signature_keys_, other.signature_keys_);
+  swap(fb_model_fd_, other.fb_model_fd_);
+#if !defined(LITERT_DISABLE_NPU)
+  swap(compilation_cache_, other.compilation_cache_);
+  swap(cached_model_, other.cached_model_);
+#endif  // !defined(LITERT_DISABLE_NPU)
+  swap(cpu_buffer_requirements_, other.cpu_buffer_requirements_);
+  swap(signature_runners_, other.signature_runners_);
+  swap(buffer_context_, other.buffer_context_);
+#if defined(LITERT_WITH_EXTERNAL_WEIGHT_LOADER)
+  swap(weight_loader_, other.weight_loader_);
+#endif  // defined(LITERT_WITH_EXTERNAL_WEIGHT_LOADER)
+  swap(cpu_tensors_, other.cpu_tensors_);
+  swap(filled_constant_outputs_, other.filled_constant_outputs_);
+  swap(runs_on_host_, other.runs_on_host_);
+  swap(error_reporter_, other.error_reporter_);
+  // Execution plans must register their buffers with the new interpreter.
+  ++binding_epoch_;
+
+  if (profiler_ != nullptr) {
+    interp_->SetProfiler(profiler_);
+    buffer_context_->SetProfiler(profiler_);
+  }
+  SetInterpreterCancellationFunction();
 }
 
 // -----------------------------------------------------------------------------
@@ -1604,6 +2708,20 @@ litert::Expected<::tflite::Interpreter*> GetInterpreter(
   return compiled_model->interp_.get();
 }
 
+litert::Expected<const char*> GetModelBase(
+    LiteRtCompiledModelT* compiled_model) {
+  if (compiled_model == nullptr) {
+    return litert::Unexpected(kLiteRtStatusErrorInvalidArgument,
+                              "Compiled model is null");
+  }
+  const char* model_base = compiled_model->GetModelBase();
+  if (model_base == nullptr) {
+    return litert::Unexpected(kLiteRtStatusErrorInvalidArgument,
+                              "Model is not initialized");
+  }
+  return model_base;
+}
+
 litert::Expected<bool> InputTensorNeedsResize(
     LiteRtCompiledModelT* compiled_model, const TfLiteTensor* tensor,
     absl::Span<const int> new_shape) {
@@ -29,6 +29,8 @@
 #include "absl/container/flat_hash_set.h"  // from @com_google_absl
 #include "absl/functional/any_invocable.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
+#include "absl/time/time.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_layout.h"
@@ -45,14 +47,19 @@
 #include "litert/core/model/model.h"
 #include "litert/runtime/accelerator.h"
 #include "litert/runtime/custom_op_dispatcher.h"
+#include "litert/runtime/event.h"
 #include "litert/runtime/external_litert_buffer_context.h"
 #include "litert/runtime/metrics.h"
 #include "litert/runtime/profiler.h"
+#include "litert/runtime/run_scheduler.h"
+#include "litert/runtime/run_telemetry.h"
+#include "litert/runtime/serial_executor.h"
 #include "litert/runtime/tensor_identifier.h"
 #include "litert/runtime/tfl_utils.h"
 #include "tflite/converter/allocation.h"
 #include "tflite/core/api/error_reporter.h"
 #include "tflite/delegates/utils/simple_opaque_delegate.h"
+#include "tflite/external_cpu_backend_context.h"
 #include "tflite/interpreter.h"
 #include "tflite/model_builder.h"
 
@@ -60,6 +67,8 @@ using TfLiteTensorIdentifier = litert::internal::TfLiteTensorIdentifier;
 using TensorIdentifierHash = litert::internal::TensorIdentifierHash;
 using TensorIdentifierEqual = litert::internal::TensorIdentifierEqual;
 
+class LiteRtExecutionPlanT;
+
 // The LiteRtCompiledModelT is internal implementation of CompiledModel C++ API.
 class LiteRtCompiledModelT {
  public:
@@ -67,6 +76,9 @@ class LiteRtCompiledModelT {
 
   explicit LiteRtCompiledModelT(LiteRtEnvironmentT* env) : env_(env) {}
   ~LiteRtCompiledModelT() {
+    env_->RemoveMemoryTrimmer(this);
+    // An asynchronous run may still be using the interpreter and the profiler.
+    WaitForPendingAsyncRun();
     // If the profiler is set, delete it here.
     if (profiler_ != nullptr) {
       delete profiler_;
@@ -74,13 +86,55 @@ class LiteRtCompiledModelT {
     }
   };
 
+  // The time spent in each phase of Create(), to track the startup cost of a
+  // model apart from its runs.
+  struct StartupTimings {
+    // Applying the compiler plugins, or loading their output from the
+    // compiler cache when `compiler_cache_hit`.
+    absl::Duration compilation;
+    bool compiler_cache_hit = false;
+    // Building the interpreter.
+    absl::Duration runtime_initialization;
+    // Loading the accelerators that were registered lazily.
+    absl::Duration accelerator_loading;
+    // Creating and applying the delegates, e.g. packing the XNNPACK weights or
+    // reading them from the weight cache.
+    absl::Duration delegation;
+  };
+
   // Creates a LiteRtCompiledModelT from a LiteRtModel object.
   // The model is loaded into memory and the caller takes ownership of the
   // returned object.
+  //
+  // If background JIT compilation is enabled in the runtime options and the
+  // model needs to be JIT compiled for the NPU, the compiled model is created
+  // with the CPU accelerators (plus the GPU, if requested) and the plugins are
+  // applied on a background thread. The first run after the compilation
+  // completed switches to the compiled graph. `jit_compilation_options` must
+  // then stay valid until the compiled model is destroyed, and `model` until
+  // WaitForBackgroundJitCompilation() returned or the compiled model is
+  // destroyed, since the background compilation reads its flatbuffer.
   static litert::Expected<Ptr> Create(
       LiteRtEnvironmentT* env, LiteRtModel model,
       LiteRtOptions jit_compilation_options = nullptr);
 
+  // Loads the model file at `filename` to be compiled with `env`. If the
+  // environment has a compiler cache directory, the flatbuffer is verified
+  // before the model is unpacked, unless the verification cache there shows
+  // that the file was already verified.
+  static litert::Expected<LiteRtModelT::Ptr> LoadModelFile(
+      LiteRtEnvironmentT& env, absl::string_view filename);
+
+  // Creates a LiteRtCompiledModelT which shares the flatbuffer of `primary`,
+  // i.e. its weights and any dispatch bytecode, but owns its own interpreter,
+  // delegates and activation memory. No JIT compilation is performed, the
+  // model is used as compiled by `primary`. Run() can be called concurrently
+  // on `primary` and on every shared compiled model created from it.
+  //
+  // NOTE: `primary` must outlive the returned object.
+  static litert::Expected<Ptr> CreateShared(
+      LiteRtCompiledModelT& primary, LiteRtOptions jit_compilation_options);
+
   // Returns the buffer requirements for the n-th input tensor. The returned
   // LiteRtTensorBufferRequirements is used to create the input tensor
   // buffer.
@@ -151,6 +205,14 @@ class LiteRtCompiledModelT {
   // asynchronously, if possible. Upon returning, the function sets parameter
   // `async` to true if asynchronous execution was requested and possible,
   // otherwise it sets it to false.
+  //
+  // When the whole graph runs on the host (CPU, with or without XNNPack) and
+  // all the registered buffers are host memory, an asynchronous run is
+  // executed on an internal worker thread: a LiteRtEventTypeHost event is
+  // attached to each output buffer and the function returns once the buffers
+  // have been registered. The input buffers must not be written to until the
+  // output events are signaled. Any subsequent call that uses the interpreter
+  // first waits for the pending run to complete.
   litert::Expected<void> Run(
       absl::string_view signature_key,
       const std::vector<LiteRtTensorBuffer>& input_buffers,
@@ -164,10 +226,34 @@ class LiteRtCompiledModelT {
                                  const LiteRtTensorBuffer* output_buffers,
                                  bool* async);
 
+  // Binds the given input/output buffers to the signature once and returns an
+  // execution plan that can be run repeatedly with RunExecutionPlan(). The plan
+  // keeps a reference to every bound buffer until it is destroyed. A nullptr
+  // input buffer means the input is bound to an external buffer, as in Run().
+  litert::Expected<std::unique_ptr<LiteRtExecutionPlanT>> CreateExecutionPlan(
+      size_t signature_index,
+      absl::Span<const LiteRtTensorBuffer> input_buffers,
+      absl::Span<const LiteRtTensorBuffer> output_buffers);
+
+  // Runs an execution plan created by CreateExecutionPlan(). As long as no
+  // other Run(), execution plan or input resize happened on this compiled model
+  // since the last run of `plan`, bindings which stay valid across invocations
+  // (unsynchronized host memory and buffers registered with a delegate) are not
+  // registered again and AllocateTensors() is skipped. The `async` parameter
+  // has the same semantics as in Run().
+  litert::Expected<void> RunExecutionPlan(LiteRtExecutionPlanT& plan,
+                                          bool& async);
+
   litert::Expected<void> StartMetricsCollection(int detail_level);
 
   litert::Expected<LiteRtMetricsT> StopMetricsCollection();
 
+  // Returns true if an asynchronous host run, see Run(), has been scheduled and
+  // has not completed yet.
+  bool HasPendingAsyncRun() const {
+    return host_executor_ != nullptr && host_executor_->IsBusy();
+  }
+
   // Returns true if a non delegated operation is found in the interpreter.
   litert::Expected<bool> HasNonDelegatedOps();
 
@@ -177,11 +263,31 @@ class LiteRtCompiledModelT {
   // Returns the profiler used by the compiled model.
   litert::Expected<LiteRtProfilerT*> GetProfiler() { return profiler_; }
 
+  // Returns the time spent in each phase of Create().
+  const StartupTimings& GetStartupTimings() const { return startup_timings_; }
+
   // Resizes the specified input tensor to support dynamic shapes.
   litert::Expected<void> ResizeInputTensor(size_t signature_index,
                                            size_t input_index,
                                            absl::Span<const int> dims);
 
+  // Restricts the shapes ResizeInputTensor resizes the specified input tensor
+  // to. `buckets` holds shapes of the rank of the input. An empty list removes
+  // the restriction.
+  litert::Expected<void> SetInputShapeBuckets(
+      size_t signature_index, size_t input_index,
+      std::vector<std::vector<int>> buckets);
+
+  // Releases the tensor arena of the given signature. The tensors are
+  // allocated again when the signature runs next.
+  litert::Expected<void> ReleaseSignatureMemory(size_t signature_index);
+
+  // Releases the tensor arenas of all the signatures if `level` is critical
+  // and the compiled model is idle, i.e. neither running nor resizing, and
+  // returns the number of bytes freed. Called by the environment from any
+  // thread, see LiteRtEnvironmentTrimMemory().
+  size_t TrimMemory(LiteRtTrimMemoryLevel level);
+
   // Returns the external buffer context which contains dispatch annotations.
   LiteRtExternalLiteRtBufferContextT* GetBufferContext() {
     return buffer_context_.get();
@@ -205,6 +311,10 @@ class LiteRtCompiledModelT {
   friend litert::Expected<::tflite::Interpreter*> GetInterpreter(
       LiteRtCompiledModelT* compiled_model);
 
+  // Returns the base address of the flatbuffer run by the compiled model.
+  friend litert::Expected<const char*> GetModelBase(
+      LiteRtCompiledModelT* compiled_model);
+
   // Cancellation APIs
 
   // Enables cancellation for the compiled model. Once enabled, model execution
@@ -220,12 +330,29 @@ class LiteRtCompiledModelT {
   // C++-friendly version of SetCancellationFunction.
   void SetCancellationFunction(absl::AnyInvocable<bool()> check_cancelled_func);
 
+  // Sets the priority of the next runs on their device, and the time after
+  // their start by which they should complete, or zero for no deadline. See
+  // LiteRtSetRuntimeOptionsRunPriority(). Must not be called during a run.
+  void SetRunPriority(LiteRtRunPriority priority, absl::Duration deadline);
+
   // Cancels an ongoing model execution. Can be called from any thread.
   // Returns an error if cancellation is not enabled.
   litert::Expected<void> Cancel();
 
+  // Blocks until the background JIT compilation started by Create(), if any,
+  // has completed and returns its status. The compiled graph is used from the
+  // next run on; buffer requirements returned before that are invalidated.
+  litert::Expected<void> WaitForBackgroundJitCompilation();
+
  private:
+  friend class LiteRtExecutionPlanT;
+
   static bool CheckCancelledWrapper(void* data);
+  // Lets the environment call TrimMemory(). Removed by the destructor.
+  void AddMemoryTrimmer();
+  // Sets the cancellation function of the interpreter, going through
+  // CheckCancelledWrapper() when runs are scheduled by priority.
+  void SetInterpreterCancellationFunction();
   // Helper function to automatically resize input tensor based on shape change
   static litert::Expected<bool> InputTensorNeedsResize(
       const TfLiteTensor* tensor, absl::Span<const int> new_shape);
@@ -258,6 +385,12 @@ class LiteRtCompiledModelT {
       LiteRtEnvironmentT* env, LiteRtHwAcceleratorSet hardware_accelerators,
       LiteRtOptions jit_compilation_options);
 
+  // Initializes the runtime from fb_model_ and applies the accelerators
+  // matching `hardware_accelerators` to the interpreter.
+  litert::Expected<void> InitializeExecution(
+      LiteRtHwAcceleratorSet hardware_accelerators,
+      LiteRtOptions jit_compilation_options);
+
   // Handles any JIT compilation and initializes the flatbuffer_model_ and
   // related field within the compiled model.
   //
@@ -330,25 +463,91 @@ class LiteRtCompiledModelT {
     void* locked_address;
     const char* tensor_name;
     size_t data_size;
+    const TfLiteTensor* tensor;
   };
 
+  // The completion states of the host events an invocation depends on.
+  using HostEventStates =
+      std::vector<std::shared_ptr<litert::internal::HostEventState>>;
+
   // Registers the TensorBuffer for the given tensor with the SignatureRunner.
   // If the TensorBuffer can be directly consumed as CPU Tensors, they'll be
   // locked and use it with CustomAllocation. The locked buffer is kept in the
   // `locked_buffers`. Caller is responsible for unlocking of these buffers.
   // If the TensorBuffer can be consumed by the delegate, then `tensor` will be
   // marked as non-CPU to avoid TFLite from allocating it.
+  // If `deferred_input_events` is not null, host memory inputs with a pending
+  // host event are registered without waiting on it; the event state is added
+  // to `deferred_input_events` instead and must be waited on before invoking.
   litert::Expected<void> RegisterBuffer(
       tflite::SignatureRunner* runner, TfLiteTensor* tensor,
       const char* tensor_name, LiteRtTensorBufferT* buffer, bool is_input,
       std::vector<LiteRtTensorBuffer>& locked_buffers,
-      std::vector<ConstantOutputInfo>& constant_outputs);
+      std::vector<ConstantOutputInfo>& constant_outputs,
+      HostEventStates* deferred_input_events);
+
+  // Invokes the signature after its buffers have been registered, copies
+  // constant outputs and handles the output synchronization events according
+  // to `async`.
+  // The buffers in `input_buffers` and `locked_buffers` are used to decide
+  // whether the invocation can be scheduled on the host worker, see Run(). The
+  // phases of the run are recorded in `telemetry`.
+  litert::Expected<void> InvokeAndSync(
+      tflite::SignatureRunner* runner,
+      absl::Span<const LiteRtTensorBuffer> input_buffers,
+      absl::Span<const LiteRtTensorBuffer> output_buffers,
+      absl::Span<const ConstantOutputInfo> constant_outputs,
+      absl::Span<const LiteRtTensorBuffer> locked_buffers,
+      HostEventStates deferred_input_events, bool& async,
+      litert::internal::RunTelemetryRecorder& telemetry);
+
+  // Blocks until all of `host_event_states` are signaled. Returns the error of
+  // the first failed operation, if any.
+  static litert::Expected<void> WaitForHostEvents(
+      absl::Span<const std::shared_ptr<litert::internal::HostEventState>>
+          host_event_states);
+
+  // Returns true if `buffer` is host memory allocated by LiteRT that still
+  // holds the data copied from the constant output `tensor` by a previous run.
+  bool HoldsConstantOutput(const TfLiteTensor* tensor,
+                           const LiteRtTensorBufferT* buffer) const;
+
+  // Invokes the signature and copies the constant outputs.
+  litert::Expected<void> Invoke(
+      tflite::SignatureRunner* runner,
+      absl::Span<const ConstantOutputInfo> constant_outputs);
+
+  // Schedules the invocation on `host_executor_` and attaches a host event to
+  // each output buffer if the graph runs on the host and all the buffers are
+  // host memory. The scheduled invocation first waits on
+  // `deferred_input_events`, so that the caller doesn't block on the producers
+  // of its inputs, and holds a reference to each of `input_buffers` and
+  // `locked_buffers` until it has completed. Returns false if the invocation
+  // must run synchronously. Once scheduled, the invocation takes `telemetry`
+  // and reports it.
+  litert::Expected<bool> TryScheduleHostInvoke(
+      tflite::SignatureRunner* runner,
+      absl::Span<const LiteRtTensorBuffer> input_buffers,
+      absl::Span<const LiteRtTensorBuffer> output_buffers,
+      absl::Span<const ConstantOutputInfo> constant_outputs,
+      absl::Span<const LiteRtTensorBuffer> locked_buffers,
+      HostEventStates& deferred_input_events,
+      litert::internal::RunTelemetryRecorder& telemetry);
+
+  // Blocks until the invocation scheduled by an asynchronous host run, if any,
+  // has completed.
+  void WaitForPendingAsyncRun() {
+    if (host_executor_ != nullptr) {
+      host_executor_->WaitForIdle();
+    }
+  }
 
   void RegisterDelegate(Delegate&& delegate) {
     delegates_.push_back(std::move(delegate));
   }
 
-  // Checks the CPU Tensors and stores them in the `cpu_tensors_` set.
+  // Checks the CPU Tensors and stores them in the `cpu_tensors_` set. Also
+  // records in `runs_on_host_` whether all the nodes run on the host.
   void CheckCpuTensors();
 
 #if !defined(LITERT_DISABLE_NPU)
@@ -359,11 +558,37 @@ class LiteRtCompiledModelT {
       LiteRtModelT& model, LiteRtHwAcceleratorSet hw_accelerators,
       LiteRtOptionsT options, LiteRtEnvironmentT& env);
 
-  // Tries to load the model from the cache. Returns true if the model is loaded
-  // from the cache, false otherwise.
-  bool TryLoadingFromCache(uint64_t model_hash);
+  // Tries to load the model compiled from the source model of `source_digest`
+  // from the cache. Returns true if the model is loaded from the cache, false
+  // otherwise.
+  bool TryLoadingFromCache(
+      uint64_t model_hash,
+      const litert::internal::CompilationCache::SourceDigest& source_digest);
+
+  // Schedules the JIT compilation of a copy of `model` on `jit_executor_`. The
+  // copy is a view of the flatbuffer of `model`, which must outlive the
+  // compilation.
+  litert::Expected<void> StartBackgroundJitCompilation(
+      const LiteRtModelT& model, LiteRtHwAcceleratorSet hw_accelerators,
+      LiteRtOptions options);
+
+  // Creates a compiled model from the result of applying the plugins to
+  // `model`. Fails if no plugin compiled the model. Runs on `jit_executor_`.
+  static litert::Expected<Ptr> JitCompile(
+      LiteRtEnvironmentT* env, LiteRtModelT::Ptr model,
+      std::optional<std::string> model_directory,
+      LiteRtHwAcceleratorSet hw_accelerators, LiteRtOptions options);
 #endif  // !defined(LITERT_DISABLE_NPU)
 
+  // Switches to the compiled model produced by the background JIT
+  // compilation, if it is ready. Called at the start of every run, once no
+  // asynchronous run is pending.
+  void MaybeSwitchToBackgroundJitResult();
+
+  // Swaps everything that is used to run the model with `other`. The
+  // environment, the profiler and the cancellation callbacks are kept.
+  void SwapRuntimeState(LiteRtCompiledModelT& other);
+
   // The environment associated with the compiled model.
   LiteRtEnvironmentT* env_;
 
@@ -374,6 +599,10 @@ class LiteRtCompiledModelT {
   std::vector<std::unique_ptr<litert::internal::CustomOpDispatcher>>
       custom_op_dispatchers_;
 
+  // The CPU backend context of `interp_`, when the environment has a shared
+  // CPU thread pool.
+  std::unique_ptr<::tflite::ExternalCpuBackendContext> cpu_backend_context_;
+
   // The TFL interpreter.
   std::unique_ptr<::tflite::Interpreter> interp_;
 
@@ -425,12 +654,53 @@ class LiteRtCompiledModelT {
   // File system hints about the originating model location.
   std::optional<std::string> model_directory_;
 
+  // Where the GPU accelerator serializes its compiled programs when the
+  // environment has a compilation cache, and the key of the entries of this
+  // model. The accelerator options only point to these strings.
+  std::string gpu_serialization_dir_;
+  std::string model_cache_key_;
+
+  // Incremented whenever the buffers registered with the interpreter or the
+  // input shapes may have changed. An execution plan records the value after
+  // registering its buffers and only registers them again on mismatch.
+  uint64_t binding_epoch_ = 0;
+
+  // The content version of the host memory buffer each constant output tensor
+  // was last copied to. Constant outputs are only copied again once their
+  // buffer may have been written, so that reusing the output buffers across
+  // runs doesn't copy the same constant data on every run.
+  absl::flat_hash_map<const TfLiteTensor*, uint64_t> filled_constant_outputs_;
+
+  // Shapes the inputs can be resized to, by signature and input index, in
+  // increasing number of elements. Accessed with trim_mutex_ held, like the
+  // resizes reading it.
+  absl::flat_hash_map<std::pair<size_t, size_t>, std::vector<std::vector<int>>>
+      input_shape_buckets_;
+
   // The set of CPU Tensors. This is used to manage TensorBufferRequirements
   // for shared CPU Tensors.
   absl::flat_hash_set<TfLiteTensorIdentifier, TensorIdentifierHash,
                       TensorIdentifierEqual>
       cpu_tensors_;
 
+  // True if no node of the graph is handled by an accelerator other than
+  // XNNPack, i.e. the whole graph runs on the host.
+  bool runs_on_host_ = false;
+
+  // The accelerators applied to the graph, with the CPU if some ops are not
+  // delegated. Reported with the runs to the telemetry sink.
+  LiteRtHwAcceleratorSet applied_accelerators_ = kLiteRtHwAcceleratorNone;
+
+  StartupTimings startup_timings_;
+
+  // If true, the tensor arenas of the signatures are only allocated when the
+  // signatures run.
+  bool lazy_signature_allocation_ = false;
+
+  // The CPUs the signatures run on, from the affinity policy of the CPU
+  // options. Empty to run on any CPU.
+  std::vector<int> affinity_cpus_;
+
   // The profiler used by the compiled model. This is used to forward the
   // profiler events to the TFLite interpreter.
   LiteRtProfilerT* profiler_ = nullptr;
@@ -440,7 +710,94 @@ class LiteRtCompiledModelT {
 
   // Cancellation support
   bool (*check_cancelled_func_)(void*) = nullptr;
+  void* check_cancelled_data_ = nullptr;
   absl::AnyInvocable<bool()> check_cancelled_func_cpp_;
+
+  // The priority and deadline of the runs, see SetRunPriority(), and the slot
+  // of the device held by the current invocation, if scheduled.
+  LiteRtRunPriority run_priority_ = kLiteRtRunPriorityNone;
+  absl::Duration run_deadline_ = absl::ZeroDuration();
+  litert::internal::RunScheduler::Slot* run_slot_ = nullptr;
+
+  // Held by the calls using the tensor arenas, so that TrimMemory() only
+  // releases those of an idle compiled model.
+  absl::Mutex trim_mutex_;
+
+  // The worker running asynchronous host invocations. Created on the first
+  // asynchronous host run.
+  std::unique_ptr<litert::internal::SerialExecutor> host_executor_;
+
+  // The result of the background JIT compilation, until the next run switches
+  // to it.
+  absl::Mutex jit_mutex_;
+  Ptr jit_compiled_model_ ABSL_GUARDED_BY(jit_mutex_);
+  litert::Expected<void> jit_status_ ABSL_GUARDED_BY(jit_mutex_);
+  // Set once `jit_compiled_model_` is ready, to avoid locking on every run.
+  std::atomic<bool> jit_result_ready_ = false;
+  // True until the compiled model switches to the background JIT compilation
+  // result or gives up on it.
+  bool jit_switch_pending_ = false;
+
+  // The worker running the background JIT compilation. Declared last so that
+  // the compilation completes before any other field is destroyed.
+  std::unique_ptr<litert::internal::SerialExecutor> jit_executor_;
+};
+
+// The LiteRtExecutionPlanT is a set of input/output tensor buffers bound to a
+// signature of a LiteRtCompiledModelT. It caches everything needed to register
+// the buffers so that repeated runs with the same bindings avoid signature
+// lookups, name lookups and vector allocations.
+class LiteRtExecutionPlanT {
+ public:
+  using Ptr = std::unique_ptr<LiteRtExecutionPlanT>;
+
+  LiteRtExecutionPlanT(const LiteRtExecutionPlanT&) = delete;
+  LiteRtExecutionPlanT& operator=(const LiteRtExecutionPlanT&) = delete;
+  ~LiteRtExecutionPlanT();
+
+  // Returns the compiled model the plan was created for.
+  LiteRtCompiledModelT* CompiledModel() const { return compiled_model_; }
+
+  // Returns the index of the signature the buffers are bound to.
+  size_t SignatureIndex() const { return signature_index_; }
+
+ private:
+  friend class LiteRtCompiledModelT;
+
+  LiteRtExecutionPlanT(LiteRtCompiledModelT* compiled_model,
+                       size_t signature_index,
+                       tflite::SignatureRunner* runner)
+      : compiled_model_(compiled_model),
+        signature_index_(signature_index),
+        runner_(runner) {}
+
+  // Returns true if the registration of `buffer` done in a previous run is
+  // still valid, i.e. the buffer doesn't need to be locked or synchronized
+  // again before the next invocation.
+  static bool IsStickyBinding(const TfLiteTensor* tensor,
+                              const LiteRtTensorBufferT* buffer);
+
+  LiteRtCompiledModelT* compiled_model_;
+  size_t signature_index_;
+  tflite::SignatureRunner* runner_;
+
+  // Bound buffers in the order of the subgraph inputs/outputs. The plan holds
+  // a reference to each non-null buffer.
+  std::vector<LiteRtTensorBuffer> input_buffers_;
+  std::vector<LiteRtTensorBuffer> output_buffers_;
+
+  // Bindings which must be registered again on every run, as indices into the
+  // buffer vectors above. Computed after each full registration.
+  std::vector<size_t> dynamic_inputs_;
+  std::vector<size_t> dynamic_outputs_;
+
+  // Scratch storage reused across runs to avoid per-run allocations.
+  std::vector<LiteRtTensorBuffer> locked_buffers_;
+  std::vector<LiteRtCompiledModelT::ConstantOutputInfo> constant_outputs_;
+
+  // The binding epoch of the compiled model after the last full registration
+  // of this plan. std::nullopt if the plan hasn't been run yet.
+  std::optional<uint64_t> bound_epoch_;
 };
 
 #endif  // ODML_LITERT_LITERT_RUNTIME_COMPILED_MODEL_H_
@@ -0,0 +1,124 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/compiled_model_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "absl/log/absl_check.h"  // from @com_google_absl
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+#include "litert/c/litert_tensor_buffer.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/core/environment.h"
+#include "litert/runtime/compiled_model.h"
+
+namespace litert::internal {
+
+Expected<std::unique_ptr<CompiledModelPool>> CompiledModelPool::Create(
+    LiteRtEnvironmentT* env, LiteRtModel model,
+    LiteRtOptions jit_compilation_options, size_t num_contexts) {
+  if (num_contexts == 0) {
+    return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                      "A compiled model pool needs at least one context");
+  }
+
+  auto pool = std::unique_ptr<CompiledModelPool>(new CompiledModelPool());
+  LITERT_ASSIGN_OR_RETURN(
+      pool->primary_,
+      LiteRtCompiledModelT::Create(env, model, jit_compilation_options));
+
+  pool->shared_.reserve(num_contexts - 1);
+  for (size_t i = 1; i < num_contexts; ++i) {
+    LITERT_ASSIGN_OR_RETURN(auto shared,
+                            LiteRtCompiledModelT::CreateShared(
+                                *pool->primary_, jit_compilation_options));
+    pool->shared_.push_back(std::move(shared));
+  }
+
+  absl::MutexLock lock(pool->mutex_);
+  pool->available_.reserve(num_contexts);
+  pool->available_.push_back(pool->primary_.get());
+  for (auto& shared : pool->shared_) {
+    pool->available_.push_back(shared.get());
+  }
+  return pool;
+}
+
+CompiledModelPool::~CompiledModelPool() {
+  absl::MutexLock lock(mutex_);
+  ABSL_DCHECK_EQ(available_.size(), Size())
+      << "Compiled model pool destroyed with outstanding leases";
+}
+
+CompiledModelPool::Lease CompiledModelPool::Acquire() {
+  absl::MutexLock lock(mutex_);
+  mutex_.Await(absl::Condition(
+      +[](std::vector<LiteRtCompiledModelT*>* available) {
+        return !available->empty();
+      },
+      &available_));
+  return Lease(this, TakeAvailable());
+}
+
+Expected<CompiledModelPool::Lease> CompiledModelPool::TryAcquire() {
+  absl::MutexLock lock(mutex_);
+  if (available_.empty()) {
+    return Unexpected(kLiteRtStatusErrorNotFound,
+                      "No compiled model context is available");
+  }
+  return Lease(this, TakeAvailable());
+}
+
+Expected<void> CompiledModelPool::RunAsync(
+    size_t signature_index, absl::Span<const LiteRtTensorBuffer> input_buffers,
+    absl::Span<const LiteRtTensorBuffer> output_buffers, bool& async) {
+  Lease lease = Acquire();
+  async = true;
+  return lease->RunCApi(signature_index, input_buffers.size(),
+                        input_buffers.data(), output_buffers.size(),
+                        output_buffers.data(), &async);
+}
+
+size_t CompiledModelPool::NumAvailable() const {
+  absl::MutexLock lock(mutex_);
+  return available_.size();
+}
+
+LiteRtCompiledModelT* CompiledModelPool::TakeAvailable() {
+  // Take from the back, i.e. the most recently released contexts, whose
+  // memory is more likely to be cached.
+  auto idle = std::find_if(available_.rbegin(), available_.rend(),
+                           [](LiteRtCompiledModelT* compiled_model) {
+                             return !compiled_model->HasPendingAsyncRun();
+                           });
+  auto it = idle != available_.rend() ? std::prev(idle.base())
+                                      : std::prev(available_.end());
+  LiteRtCompiledModelT* compiled_model = *it;
+  available_.erase(it);
+  return compiled_model;
+}
+
+void CompiledModelPool::Release(LiteRtCompiledModelT* compiled_model) {
+  absl::MutexLock lock(mutex_);
+  available_.push_back(compiled_model);
+}
+
+}  // namespace litert::internal
@@ -0,0 +1,141 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_RUNTIME_COMPILED_MODEL_POOL_H_
+#define ODML_LITERT_LITERT_RUNTIME_COMPILED_MODEL_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"  // from @com_google_absl
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+#include "litert/c/litert_tensor_buffer.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/core/environment.h"
+#include "litert/runtime/compiled_model.h"
+
+namespace litert::internal {
+
+// A fixed-size pool of execution contexts for a single model.
+//
+// The first context is created with LiteRtCompiledModelT::Create() and
+// performs any JIT compilation. The other contexts are created with
+// LiteRtCompiledModelT::CreateShared() and share its read-only flatbuffer,
+// i.e. the weights and the dispatch bytecode; they only own their interpreter
+// and activation arenas. When an XNNPack weight cache is configured in the CPU
+// options, all contexts also map the same packed weights.
+//
+// Each context can be used by one thread at a time, so up to Size() threads
+// can run the model concurrently by acquiring a context from the pool.
+class CompiledModelPool {
+ public:
+  // Gives exclusive access to a context of the pool until destroyed.
+  class Lease {
+   public:
+    Lease(Lease&& other) noexcept
+        : pool_(other.pool_), compiled_model_(other.compiled_model_) {
+      other.pool_ = nullptr;
+      other.compiled_model_ = nullptr;
+    }
+    Lease& operator=(Lease&& other) = delete;
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+
+    ~Lease() {
+      if (pool_ != nullptr) {
+        pool_->Release(compiled_model_);
+      }
+    }
+
+    LiteRtCompiledModelT* Get() const { return compiled_model_; }
+    LiteRtCompiledModelT* operator->() const { return compiled_model_; }
+    LiteRtCompiledModelT& operator*() const { return *compiled_model_; }
+
+   private:
+    friend class CompiledModelPool;
+
+    Lease(CompiledModelPool* pool, LiteRtCompiledModelT* compiled_model)
+        : pool_(pool), compiled_model_(compiled_model) {}
+
+    CompiledModelPool* pool_;
+    LiteRtCompiledModelT* compiled_model_;
+  };
+
+  // Creates a pool of `num_contexts` contexts for `model`. The model is
+  // compiled once with `jit_compilation_options`.
+  static Expected<std::unique_ptr<CompiledModelPool>> Create(
+      LiteRtEnvironmentT* env, LiteRtModel model,
+      LiteRtOptions jit_compilation_options, size_t num_contexts);
+
+  CompiledModelPool(const CompiledModelPool&) = delete;
+  CompiledModelPool& operator=(const CompiledModelPool&) = delete;
+
+  // All leases must have been released before the pool is destroyed.
+  ~CompiledModelPool();
+
+  // Blocks until a context is available and returns it. The contexts without
+  // a pending asynchronous run are returned first.
+  Lease Acquire();
+
+  // Returns a context if one is available, otherwise an error with status
+  // kLiteRtStatusErrorNotFound.
+  Expected<Lease> TryAcquire();
+
+  // Runs the signature at `signature_index` asynchronously on an available
+  // context, see LiteRtCompiledModelT::Run(), and releases the context once
+  // the run is scheduled. Since the contexts without a pending run are used
+  // first, up to Size() runs of the same signature can be in flight, each
+  // signaling the events attached to its own output buffers. Once all the
+  // contexts have a pending run, blocks until that of the chosen context
+  // completes. Upon returning, `async` is set as by Run().
+  Expected<void> RunAsync(size_t signature_index,
+                          absl::Span<const LiteRtTensorBuffer> input_buffers,
+                          absl::Span<const LiteRtTensorBuffer> output_buffers,
+                          bool& async);
+
+  // Returns the number of contexts owned by the pool.
+  size_t Size() const { return 1 + shared_.size(); }
+
+  // Returns the number of contexts which are currently not leased.
+  size_t NumAvailable() const;
+
+  // Returns the context which owns the compiled flatbuffer. It can be used to
+  // query buffer requirements and layouts, which are identical for all
+  // contexts.
+  LiteRtCompiledModelT& Primary() { return *primary_; }
+
+ private:
+  CompiledModelPool() = default;
+
+  // Removes an available context, preferably one without a pending
+  // asynchronous run, from `available_` and returns it.
+  LiteRtCompiledModelT* TakeAvailable() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  void Release(LiteRtCompiledModelT* compiled_model);
+
+  // NOTE: The shared contexts reference the flatbuffer owned by the primary
+  // one, hence they must be destroyed first.
+  LiteRtCompiledModelT::Ptr primary_;
+  std::vector<LiteRtCompiledModelT::Ptr> shared_;
+
+  mutable absl::Mutex mutex_;
+  std::vector<LiteRtCompiledModelT*> available_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace litert::internal
+
+#endif  // ODML_LITERT_LITERT_RUNTIME_COMPILED_MODEL_POOL_H_
@@ -0,0 +1,219 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/compiled_model_pool.h"
+
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+#include "litert/c/litert_model.h"
+#include "litert/c/litert_options.h"
+#include "litert/c/litert_tensor_buffer.h"
+#include "litert/cc/internal/litert_handle.h"
+#include "litert/cc/litert_tensor_buffer.h"
+#include "litert/core/environment.h"
+#include "litert/core/model/model.h"
+#include "litert/runtime/compiled_model.h"
+#include "litert/test/common.h"
+#include "litert/test/matchers.h"
+#include "litert/test/testdata/simple_model_test_vectors.h"
+
+namespace litert::internal {
+namespace {
+
+using ::testing::FloatNear;
+using ::testing::Pointwise;
+using ::testing::litert::IsError;
+
+class CompiledModelPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    LITERT_ASSERT_OK_AND_ASSIGN(env_,
+                                LiteRtEnvironmentT::CreateWithOptions({}));
+    std::string path = testing::GetTestFilePath(kModelFileName);
+    ASSERT_EQ(LiteRtCreateModelFromFile(path.c_str(), &model_),
+              kLiteRtStatusOk);
+    ASSERT_EQ(LiteRtCreateOptions(&options_), kLiteRtStatusOk);
+    ASSERT_EQ(
+        LiteRtSetOptionsHardwareAccelerators(options_, kLiteRtHwAcceleratorCpu),
+        kLiteRtStatusOk);
+  }
+
+  void TearDown() override {
+    LiteRtDestroyOptions(options_);
+    LiteRtDestroyModel(model_);
+  }
+
+  // Creates the buffers of the default signature, with the test inputs scaled
+  // by `scale`.
+  void CreateBuffers(float scale, std::vector<LiteRtTensorBuffer>& inputs,
+                     std::vector<LiteRtTensorBuffer>& outputs) {
+    const LiteRtSubgraphT& subgraph = model_->Subgraph(0);
+    for (auto* tensor : subgraph.Inputs()) {
+      const auto type = tensor->Type().second.ranked_tensor_type;
+      LiteRtTensorBuffer buffer;
+      ASSERT_EQ(LiteRtCreateManagedTensorBuffer(
+                    env_.get(), kLiteRtTensorBufferTypeHostMemory, &type,
+                    kTestInput0Size * sizeof(float), &buffer),
+                kLiteRtStatusOk);
+      inputs.push_back(buffer);
+    }
+    for (auto* tensor : subgraph.Outputs()) {
+      const auto type = tensor->Type().second.ranked_tensor_type;
+      LiteRtTensorBuffer buffer;
+      ASSERT_EQ(LiteRtCreateManagedTensorBuffer(
+                    env_.get(), kLiteRtTensorBufferTypeHostMemory, &type,
+                    kTestOutputSize * sizeof(float), &buffer),
+                kLiteRtStatusOk);
+      outputs.push_back(buffer);
+    }
+
+    std::vector<float> input0(kTestInput0Tensor,
+                              kTestInput0Tensor + kTestInput0Size);
+    std::vector<float> input1(kTestInput1Tensor,
+                              kTestInput1Tensor + kTestInput1Size);
+    for (auto& v : input0) v *= scale;
+    for (auto& v : input1) v *= scale;
+    TensorBuffer::WrapCObject(inputs[0], OwnHandle::kNo)
+        .Write<float>(absl::MakeConstSpan(input0));
+    TensorBuffer::WrapCObject(inputs[1], OwnHandle::kNo)
+        .Write<float>(absl::MakeConstSpan(input1));
+  }
+
+  // Checks the output of a run with the test inputs scaled by `scale`, waiting
+  // for its completion if needed, and destroys the buffers.
+  void CheckAndDestroyBuffers(float scale,
+                              std::vector<LiteRtTensorBuffer>& inputs,
+                              std::vector<LiteRtTensorBuffer>& outputs) {
+    std::vector<float> expected(kTestOutputTensor,
+                                kTestOutputTensor + kTestOutputSize);
+    for (auto& v : expected) v *= scale;
+    std::vector<float> output(kTestOutputSize);
+    LITERT_EXPECT_OK(TensorBuffer::WrapCObject(outputs[0], OwnHandle::kNo)
+                         .Read<float>(absl::MakeSpan(output)));
+    EXPECT_THAT(output, Pointwise(FloatNear(1e-5), expected));
+
+    for (auto buffer : inputs) LiteRtDestroyTensorBuffer(buffer);
+    for (auto buffer : outputs) LiteRtDestroyTensorBuffer(buffer);
+  }
+
+  // Runs the default signature of `compiled_model` with scaled test inputs and
+  // checks the outputs.
+  void RunAndCheck(LiteRtCompiledModelT& compiled_model, float scale) {
+    std::vector<LiteRtTensorBuffer> inputs;
+    std::vector<LiteRtTensorBuffer> outputs;
+    CreateBuffers(scale, inputs, outputs);
+
+    bool async = false;
+    LITERT_ASSERT_OK(compiled_model.Run(LiteRtSignatureT::kDefaultSignatureKey,
+                                        inputs, outputs, async));
+    CheckAndDestroyBuffers(scale, inputs, outputs);
+  }
+
+  LiteRtEnvironmentT::Ptr env_;
+  LiteRtModel model_ = nullptr;
+  LiteRtOptions options_ = nullptr;
+};
+
+TEST_F(CompiledModelPoolTest, RejectsEmptyPool) {
+  EXPECT_THAT(CompiledModelPool::Create(env_.get(), model_, options_,
+                                        /*num_contexts=*/0),
+              IsError(kLiteRtStatusErrorInvalidArgument));
+}
+
+TEST_F(CompiledModelPoolTest, AcquireAndRelease) {
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto pool, CompiledModelPool::Create(env_.get(), model_, options_,
+                                           /*num_contexts=*/2));
+  EXPECT_EQ(pool->Size(), 2);
+  EXPECT_EQ(pool->NumAvailable(), 2);
+  {
+    auto first = pool->Acquire();
+    LITERT_ASSERT_OK_AND_ASSIGN(auto second, pool->TryAcquire());
+    EXPECT_NE(first.Get(), second.Get());
+    EXPECT_EQ(pool->NumAvailable(), 0);
+    EXPECT_THAT(pool->TryAcquire(), IsError(kLiteRtStatusErrorNotFound));
+  }
+  EXPECT_EQ(pool->NumAvailable(), 2);
+}
+
+TEST_F(CompiledModelPoolTest, SharedContextsShareTheModelBuffer) {
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto pool, CompiledModelPool::Create(env_.get(), model_, options_,
+                                           /*num_contexts=*/2));
+  auto first = pool->Acquire();
+  auto second = pool->Acquire();
+  LITERT_ASSERT_OK_AND_ASSIGN(auto* first_interp, GetInterpreter(first.Get()));
+  LITERT_ASSERT_OK_AND_ASSIGN(auto* second_interp,
+                              GetInterpreter(second.Get()));
+  EXPECT_NE(first_interp, second_interp);
+  LITERT_ASSERT_OK_AND_ASSIGN(const char* first_base,
+                              GetModelBase(first.Get()));
+  LITERT_ASSERT_OK_AND_ASSIGN(const char* second_base,
+                              GetModelBase(second.Get()));
+  EXPECT_EQ(first_base, second_base);
+  RunAndCheck(*first, 1.0f);
+  RunAndCheck(*second, 2.0f);
+}
+
+TEST_F(CompiledModelPoolTest, ConcurrentRuns) {
+  constexpr int kNumThreads = 4;
+  constexpr int kNumRunsPerThread = 10;
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto pool, CompiledModelPool::Create(env_.get(), model_, options_,
+                                           /*num_contexts=*/kNumThreads));
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kNumRunsPerThread; ++i) {
+        auto lease = pool->Acquire();
+        RunAndCheck(*lease, static_cast<float>(t + 1));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(pool->NumAvailable(), kNumThreads);
+}
+
+TEST_F(CompiledModelPoolTest, AsyncRunsInFlight) {
+  constexpr int kNumContexts = 3;
+  constexpr int kNumRuns = 2 * kNumContexts;
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto pool, CompiledModelPool::Create(env_.get(), model_, options_,
+                                           /*num_contexts=*/kNumContexts));
+  std::vector<std::vector<LiteRtTensorBuffer>> inputs(kNumRuns);
+  std::vector<std::vector<LiteRtTensorBuffer>> outputs(kNumRuns);
+  for (int i = 0; i < kNumRuns; ++i) {
+    CreateBuffers(static_cast<float>(i + 1), inputs[i], outputs[i]);
+    bool async = false;
+    LITERT_ASSERT_OK(
+        pool->RunAsync(/*signature_index=*/0, inputs[i], outputs[i], async));
+  }
+  // The contexts are released once the runs are scheduled.
+  EXPECT_EQ(pool->NumAvailable(), kNumContexts);
+  for (int i = 0; i < kNumRuns; ++i) {
+    CheckAndDestroyBuffers(static_cast<float>(i + 1), inputs[i], outputs[i]);
+  }
+}
+
+}  // namespace
+}  // namespace litert::internal
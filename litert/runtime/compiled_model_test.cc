@@ -18,6 +18,7 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <utility>
 #include <vector>
 
@@ -26,9 +27,14 @@
 #include "absl/debugging/leak_check.h"  // from @com_google_absl
 #include "absl/log/absl_log.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/time/clock.h"  // from @com_google_absl
+#include "absl/time/time.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_any.h"
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_environment.h"
+#include "litert/c/litert_environment_options.h"
+#include "litert/c/litert_event_type.h"
 #include "litert/c/litert_layout.h"
 #include "litert/c/litert_model.h"
 #include "litert/c/litert_options.h"
@@ -47,7 +53,9 @@
 #include "litert/cc/options/litert_runtime_options.h"
 #include "litert/core/model/model.h"
 #include "litert/core/options.h"
+#include "litert/runtime/event.h"
 #include "litert/runtime/open_cl_memory.h"
+#include "litert/runtime/run_scheduler.h"
 #include "litert/runtime/tensor_buffer.h"
 #include "litert/runtime/tensor_buffer_requirements.h"
 #include "litert/test/common.h"
@@ -1163,6 +1171,134 @@ TEST(CompiledModelTest, GetInterpreter) {
   EXPECT_NE(interpreter, nullptr);
 }
 
+TEST(CompiledModelTest, BackgroundJitCompilationWithoutPlugins) {
+  // Environment setup, without a compiler plugin directory.
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtEnvironmentT::Ptr env,
+                              LiteRtEnvironmentT::CreateWithOptions({}));
+  LiteRtEnvironmentT* env_ptr = env.release();
+
+  std::string path = testing::GetTestFilePath(kModelFileName);
+  LiteRtModel model;
+  ASSERT_EQ(LiteRtCreateModelFromFile(path.c_str(), &model), kLiteRtStatusOk);
+
+  LiteRtOptions jit_compilation_options;
+  ASSERT_EQ(LiteRtCreateOptions(&jit_compilation_options), kLiteRtStatusOk);
+  ASSERT_EQ(LiteRtSetOptionsHardwareAccelerators(
+                jit_compilation_options,
+                kLiteRtHwAcceleratorNpu | kLiteRtHwAcceleratorCpu),
+            kLiteRtStatusOk);
+  LITERT_ASSIGN_OR_ABORT(auto runtime_options, RuntimeOptions::Create());
+  runtime_options.SetBackgroundJitCompilation(true);
+  ASSERT_EQ(LiteRtAddOpaqueOptions(jit_compilation_options,
+                                   runtime_options.Release()),
+            kLiteRtStatusOk);
+
+  // Without plugins there is nothing to compile, so the model is created as
+  // usual and no background compilation is started.
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      LiteRtCompiledModelT::Ptr compiled_model,
+      LiteRtCompiledModelT::Create(env_ptr, model, jit_compilation_options));
+  LITERT_EXPECT_OK(compiled_model->WaitForBackgroundJitCompilation());
+  LITERT_ASSERT_OK_AND_ASSIGN(tflite::Interpreter * interpreter,
+                              GetInterpreter(compiled_model.get()));
+  EXPECT_NE(interpreter, nullptr);
+
+  compiled_model.reset();
+  LiteRtDestroyOptions(jit_compilation_options);
+  LiteRtDestroyModel(model);
+  LiteRtDestroyEnvironment(env_ptr);
+}
+
+TEST(CompiledModelTest, BackgroundJitCompilationWithExamplePlugin) {
+  // Environment setup, with the example compiler plugin and dispatch library.
+  const std::string libs_path = testing::GetLiteRtPath("vendors/examples");
+  const LiteRtEnvOption environment_options[] = {
+      {.tag = kLiteRtEnvOptionTagCompilerPluginLibraryDir,
+       .value = LiteRtAny{.type = kLiteRtAnyTypeString,
+                          .str_value = libs_path.c_str()}},
+      {.tag = kLiteRtEnvOptionTagDispatchLibraryDir,
+       .value = LiteRtAny{.type = kLiteRtAnyTypeString,
+                          .str_value = libs_path.c_str()}},
+  };
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtEnvironmentT::Ptr env,
+                              LiteRtEnvironmentT::CreateWithOptions(
+                                  absl::MakeConstSpan(environment_options)));
+  LiteRtEnvironmentT* env_ptr = env.release();
+
+  std::string path = testing::GetTestFilePath("one_mul.tflite");
+  LiteRtModel model;
+  ASSERT_EQ(LiteRtCreateModelFromFile(path.c_str(), &model), kLiteRtStatusOk);
+  absl::string_view signature_key = model->Signatures()[0]->Key();
+
+  LiteRtOptions jit_compilation_options;
+  ASSERT_EQ(LiteRtCreateOptions(&jit_compilation_options), kLiteRtStatusOk);
+  ASSERT_EQ(LiteRtSetOptionsHardwareAccelerators(
+                jit_compilation_options,
+                kLiteRtHwAcceleratorNpu | kLiteRtHwAcceleratorCpu),
+            kLiteRtStatusOk);
+  LITERT_ASSIGN_OR_ABORT(auto runtime_options, RuntimeOptions::Create());
+  runtime_options.SetBackgroundJitCompilation(true);
+  ASSERT_EQ(LiteRtAddOpaqueOptions(jit_compilation_options,
+                                   runtime_options.Release()),
+            kLiteRtStatusOk);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      LiteRtCompiledModelT::Ptr compiled_model,
+      LiteRtCompiledModelT::Create(env_ptr, model, jit_compilation_options));
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> input_buffers,
+      CreateInputBuffersOfType(env_ptr, *model, signature_key,
+                               kLiteRtTensorBufferTypeHostMemory,
+                               sizeof(float) * 4));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> output_buffers,
+      CreateOutputBuffersOfType(env_ptr, *model, signature_key,
+                                kLiteRtTensorBufferTypeHostMemory,
+                                sizeof(float) * 4));
+  for (auto& input_buffer : input_buffers) {
+    TensorBuffer cpu_buffer =
+        TensorBuffer::WrapCObject(input_buffer, OwnHandle::kNo);
+    LITERT_ASSERT_OK(cpu_buffer.Write<float>({1.0f, 2.0f, 3.0f, 4.0f}));
+  }
+  auto read_output = [&]() {
+    std::vector<float> output(4);
+    TensorBuffer cpu_buffer =
+        TensorBuffer::WrapCObject(output_buffers[0], OwnHandle::kNo);
+    LITERT_EXPECT_OK(cpu_buffer.Read<float>(absl::MakeSpan(output)));
+    return output;
+  };
+
+  // The model runs on the CPU until the compilation completed.
+  LITERT_ASSERT_OK_AND_ASSIGN(tflite::Interpreter * fallback_interpreter,
+                              GetInterpreter(compiled_model.get()));
+  bool async = false;
+  LITERT_ASSERT_OK(compiled_model->Run(signature_key, input_buffers,
+                                       output_buffers, async));
+  const std::vector<float> fallback_output = read_output();
+  EXPECT_THAT(fallback_output, ElementsAre(1.0f, 4.0f, 9.0f, 16.0f));
+
+  // The next run uses the compiled graph and computes the same outputs.
+  LITERT_ASSERT_OK(compiled_model->WaitForBackgroundJitCompilation());
+  LITERT_ASSERT_OK(compiled_model->Run(signature_key, input_buffers,
+                                       output_buffers, async));
+  LITERT_ASSERT_OK_AND_ASSIGN(tflite::Interpreter * compiled_interpreter,
+                              GetInterpreter(compiled_model.get()));
+  EXPECT_NE(compiled_interpreter, fallback_interpreter);
+  EXPECT_EQ(read_output(), fallback_output);
+
+  for (auto& input_buffer : input_buffers) {
+    LiteRtDestroyTensorBuffer(input_buffer);
+  }
+  for (auto& output_buffer : output_buffers) {
+    LiteRtDestroyTensorBuffer(output_buffer);
+  }
+  compiled_model.reset();
+  LiteRtDestroyOptions(jit_compilation_options);
+  LiteRtDestroyModel(model);
+  LiteRtDestroyEnvironment(env_ptr);
+}
+
 TEST(CompiledModelTest, GetOutputTensorShapes) {
   // Environment setup.
   LITERT_ASSERT_OK_AND_ASSIGN(LiteRtEnvironmentT::Ptr env,
@@ -1308,5 +1444,588 @@ TEST(CompiledModelTest, CheckResizeFail) {
   LiteRtDestroyEnvironment(env_ptr);
 }
 
+TEST(CompiledModelTest, RunExecutionPlan) {
+  // Environment setup.
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtEnvironmentT::Ptr env,
+                              LiteRtEnvironmentT::CreateWithOptions({}));
+  LiteRtEnvironmentT* env_ptr = env.release();
+
+  std::string path = testing::GetTestFilePath(kModelFileName);
+  LiteRtModel model;
+  ASSERT_EQ(LiteRtCreateModelFromFile(path.c_str(), &model), kLiteRtStatusOk);
+  absl::string_view signature_key = LiteRtSignatureT::kDefaultSignatureKey;
+
+  LiteRtOptions jit_compilation_options;
+  ASSERT_EQ(LiteRtCreateOptions(&jit_compilation_options), kLiteRtStatusOk);
+  ASSERT_EQ(LiteRtSetOptionsHardwareAccelerators(jit_compilation_options,
+                                                 kLiteRtHwAcceleratorCpu),
+            kLiteRtStatusOk);
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      LiteRtCompiledModelT::Ptr compiled_model,
+      LiteRtCompiledModelT::Create(env_ptr, model, jit_compilation_options));
+  LiteRtDestroyOptions(jit_compilation_options);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> input_buffers,
+      CreateInputBuffersFromRequirements(env_ptr, *model, signature_key,
+                                         *compiled_model));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> output_buffers,
+      CreateOutputBuffersFromRequirements(env_ptr, *model, signature_key,
+                                          *compiled_model));
+
+  // The plan holds its own references to the bound buffers.
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      LiteRtExecutionPlanT::Ptr plan,
+      compiled_model->CreateExecutionPlan(/*signature_index=*/0, input_buffers,
+                                          output_buffers));
+  EXPECT_EQ(plan->SignatureIndex(), 0);
+  EXPECT_EQ(plan->CompiledModel(), compiled_model.get());
+
+  auto write_inputs = [&](float scale) {
+    std::vector<float> input0(kTestInput0Tensor,
+                              kTestInput0Tensor + kTestInput0Size);
+    std::vector<float> input1(kTestInput1Tensor,
+                              kTestInput1Tensor + kTestInput1Size);
+    for (auto& v : input0) v *= scale;
+    for (auto& v : input1) v *= scale;
+    TensorBuffer buffer0 =
+        TensorBuffer::WrapCObject(input_buffers[0], OwnHandle::kNo);
+    ASSERT_TRUE(buffer0.Write<float>(absl::MakeConstSpan(input0)));
+    TensorBuffer buffer1 =
+        TensorBuffer::WrapCObject(input_buffers[1], OwnHandle::kNo);
+    ASSERT_TRUE(buffer1.Write<float>(absl::MakeConstSpan(input1)));
+  };
+  auto check_output = [&](float scale) {
+    std::vector<float> expected(kTestOutputTensor,
+                                kTestOutputTensor + kTestOutputSize);
+    for (auto& v : expected) v *= scale;
+    void* host_mem_addr;
+    ASSERT_EQ(LiteRtLockTensorBuffer(output_buffers[0], &host_mem_addr,
+                                     kLiteRtTensorBufferLockModeRead),
+              kLiteRtStatusOk);
+    absl::Span<const float> output = absl::MakeSpan(
+        static_cast<const float*>(host_mem_addr), kTestOutputSize);
+    EXPECT_THAT(output, Pointwise(FloatNear(1e-5), expected));
+    ASSERT_EQ(LiteRtUnlockTensorBuffer(output_buffers[0]), kLiteRtStatusOk);
+  };
+
+  // The first run registers the buffers, the second one reuses them.
+  bool async = false;
+  write_inputs(1.0f);
+  LITERT_ASSERT_OK(compiled_model->RunExecutionPlan(*plan, async));
+  EXPECT_FALSE(async);
+  check_output(1.0f);
+
+  write_inputs(2.0f);
+  LITERT_ASSERT_OK(compiled_model->RunExecutionPlan(*plan, async));
+  check_output(2.0f);
+
+  // A regular run in between invalidates the bindings of the plan.
+  LITERT_ASSERT_OK(
+      compiled_model->Run(signature_key, input_buffers, output_buffers, async));
+  write_inputs(3.0f);
+  LITERT_ASSERT_OK(compiled_model->RunExecutionPlan(*plan, async));
+  check_output(3.0f);
+
+  for (auto& input_buffer : input_buffers) {
+    LiteRtDestroyTensorBuffer(input_buffer);
+  }
+  for (auto& output_buffer : output_buffers) {
+    LiteRtDestroyTensorBuffer(output_buffer);
+  }
+  plan.reset();
+
+  LiteRtDestroyModel(model);
+  LiteRtDestroyEnvironment(env_ptr);
+}
+
+TEST(CompiledModelTest, CreateExecutionPlanFailsOnSizeMismatch) {
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtEnvironmentT::Ptr env,
+                              LiteRtEnvironmentT::CreateWithOptions({}));
+  LiteRtEnvironmentT* env_ptr = env.release();
+
+  std::string path = testing::GetTestFilePath(kModelFileName);
+  LiteRtModel model;
+  ASSERT_EQ(LiteRtCreateModelFromFile(path.c_str(), &model), kLiteRtStatusOk);
+
+  LiteRtOptions jit_compilation_options;
+  ASSERT_EQ(LiteRtCreateOptions(&jit_compilation_options), kLiteRtStatusOk);
+  ASSERT_EQ(LiteRtSetOptionsHardwareAccelerators(jit_compilation_options,
+                                                 kLiteRtHwAcceleratorCpu),
+            kLiteRtStatusOk);
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      LiteRtCompiledModelT::Ptr compiled_model,
+      LiteRtCompiledModelT::Create(env_ptr, model, jit_compilation_options));
+  LiteRtDestroyOptions(jit_compilation_options);
+
+  EXPECT_THAT(compiled_model->CreateExecutionPlan(/*signature_index=*/0,
+                                                  /*input_buffers=*/{},
+                                                  /*output_buffers=*/{}),
+              IsError(kLiteRtStatusErrorInvalidArgument));
+  EXPECT_THAT(compiled_model->CreateExecutionPlan(/*signature_index=*/1,
+                                                  /*input_buffers=*/{},
+                                                  /*output_buffers=*/{}),
+              IsError(kLiteRtStatusErrorIndexOOB));
+
+  LiteRtDestroyModel(model);
+  LiteRtDestroyEnvironment(env_ptr);
+}
+
+TEST(CompiledModelTest, RunAsyncOnHost) {
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtEnvironmentT::Ptr env,
+                              LiteRtEnvironmentT::CreateWithOptions({}));
+  LiteRtEnvironmentT* env_ptr = env.release();
+
+  std::string path = testing::GetTestFilePath(kModelFileName);
+  LiteRtModel model;
+  ASSERT_EQ(LiteRtCreateModelFromFile(path.c_str(), &model), kLiteRtStatusOk);
+  absl::string_view signature_key = LiteRtSignatureT::kDefaultSignatureKey;
+
+  LiteRtOptions jit_compilation_options;
+  ASSERT_EQ(LiteRtCreateOptions(&jit_compilation_options), kLiteRtStatusOk);
+  ASSERT_EQ(LiteRtSetOptionsHardwareAccelerators(jit_compilation_options,
+                                                 kLiteRtHwAcceleratorCpu),
+            kLiteRtStatusOk);
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      LiteRtCompiledModelT::Ptr compiled_model,
+      LiteRtCompiledModelT::Create(env_ptr, model, jit_compilation_options));
+  LiteRtDestroyOptions(jit_compilation_options);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> input_buffers,
+      CreateInputBuffersFromRequirements(env_ptr, *model, signature_key,
+                                         *compiled_model));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> output_buffers,
+      CreateOutputBuffersFromRequirements(env_ptr, *model, signature_key,
+                                          *compiled_model));
+  {
+    TensorBuffer buffer0 =
+        TensorBuffer::WrapCObject(input_buffers[0], OwnHandle::kNo);
+    ASSERT_TRUE(buffer0.Write<float>(
+        absl::MakeConstSpan(kTestInput0Tensor, kTestInput0Size)));
+    TensorBuffer buffer1 =
+        TensorBuffer::WrapCObject(input_buffers[1], OwnHandle::kNo);
+    ASSERT_TRUE(buffer1.Write<float>(
+        absl::MakeConstSpan(kTestInput1Tensor, kTestInput1Size)));
+  }
+
+  // The run is scheduled on the host worker and a host event is attached to
+  // the output.
+  bool async = true;
+  LITERT_ASSERT_OK(
+      compiled_model->Run(signature_key, input_buffers, output_buffers, async));
+  EXPECT_TRUE(async);
+  ASSERT_TRUE(output_buffers[0]->HasEvent());
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtEventT * event,
+                              output_buffers[0]->GetEvent());
+  EXPECT_EQ(event->type, LiteRtEventTypeHost);
+
+  // Locking the output waits for the event.
+  {
+    void* host_mem_addr;
+    ASSERT_EQ(LiteRtLockTensorBuffer(output_buffers[0], &host_mem_addr,
+                                     kLiteRtTensorBufferLockModeRead),
+              kLiteRtStatusOk);
+    LITERT_ASSERT_OK_AND_ASSIGN(bool is_signaled, event->IsSignaled());
+    EXPECT_TRUE(is_signaled);
+    absl::Span<const float> output = absl::MakeSpan(
+        static_cast<const float*>(host_mem_addr), kTestOutputSize);
+    EXPECT_THAT(output, Pointwise(FloatNear(1e-5), kTestOutputTensor));
+    ASSERT_EQ(LiteRtUnlockTensorBuffer(output_buffers[0]), kLiteRtStatusOk);
+  }
+
+  // The output can be reused once its event has been cleared.
+  output_buffers[0]->ClearEvent();
+  async = false;
+  LITERT_ASSERT_OK(
+      compiled_model->Run(signature_key, input_buffers, output_buffers, async));
+  EXPECT_FALSE(async);
+  EXPECT_FALSE(output_buffers[0]->HasEvent());
+
+  for (auto& input_buffer : input_buffers) {
+    LiteRtDestroyTensorBuffer(input_buffer);
+  }
+  for (auto& output_buffer : output_buffers) {
+    LiteRtDestroyTensorBuffer(output_buffer);
+  }
+
+  LiteRtDestroyModel(model);
+  LiteRtDestroyEnvironment(env_ptr);
+}
+
+TEST(CompiledModelTest, RunWithPriorityWaitsForHigherPriorityRun) {
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtEnvironmentT::Ptr env,
+                              LiteRtEnvironmentT::CreateWithOptions({}));
+  LiteRtEnvironmentT* env_ptr = env.release();
+
+  std::string path = testing::GetTestFilePath(kModelFileName);
+  LiteRtModel model;
+  ASSERT_EQ(LiteRtCreateModelFromFile(path.c_str(), &model), kLiteRtStatusOk);
+  absl::string_view signature_key = LiteRtSignatureT::kDefaultSignatureKey;
+
+  LiteRtOptions jit_compilation_options;
+  ASSERT_EQ(LiteRtCreateOptions(&jit_compilation_options), kLiteRtStatusOk);
+  ASSERT_EQ(LiteRtSetOptionsHardwareAccelerators(jit_compilation_options,
+                                                 kLiteRtHwAcceleratorCpu),
+            kLiteRtStatusOk);
+  LITERT_ASSIGN_OR_ABORT(auto runtime_options, RuntimeOptions::Create());
+  LITERT_ASSERT_OK(runtime_options.SetRunPriority(kLiteRtRunPriorityLow));
+  ASSERT_EQ(LiteRtAddOpaqueOptions(jit_compilation_options,
+                                   runtime_options.Release()),
+            kLiteRtStatusOk);
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      LiteRtCompiledModelT::Ptr compiled_model,
+      LiteRtCompiledModelT::Create(env_ptr, model, jit_compilation_options));
+  LiteRtDestroyOptions(jit_compilation_options);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> input_buffers,
+      CreateInputBuffersFromRequirements(env_ptr, *model, signature_key,
+                                         *compiled_model));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> output_buffers,
+      CreateOutputBuffersFromRequirements(env_ptr, *model, signature_key,
+                                          *compiled_model));
+  {
+    TensorBuffer buffer0 =
+        TensorBuffer::WrapCObject(input_buffers[0], OwnHandle::kNo);
+    ASSERT_TRUE(buffer0.Write<float>(
+        absl::MakeConstSpan(kTestInput0Tensor, kTestInput0Size)));
+    TensorBuffer buffer1 =
+        TensorBuffer::WrapCObject(input_buffers[1], OwnHandle::kNo);
+    ASSERT_TRUE(buffer1.Write<float>(
+        absl::MakeConstSpan(kTestInput1Tensor, kTestInput1Size)));
+  }
+
+  // The run waits while a run of higher priority holds the CPU.
+  auto& scheduler = env_ptr->GetRunScheduler();
+  auto slot =
+      scheduler.Acquire(kLiteRtHwAcceleratorCpu, kLiteRtRunPriorityHigh);
+  std::thread run([&]() {
+    bool async = false;
+    LITERT_EXPECT_OK(compiled_model->Run(signature_key, input_buffers,
+                                         output_buffers, async));
+  });
+  while (scheduler.GetDeviceStats(kLiteRtHwAcceleratorCpu).queue_depth < 2) {
+    absl::SleepFor(absl::Milliseconds(1));
+  }
+  slot = litert::internal::RunScheduler::Slot();
+  run.join();
+  EXPECT_EQ(scheduler.GetDeviceStats(kLiteRtHwAcceleratorCpu).queue_depth, 0);
+
+  {
+    TensorBuffer buffer =
+        TensorBuffer::WrapCObject(output_buffers[0], OwnHandle::kNo);
+    std::vector<float> output(kTestOutputSize);
+    ASSERT_TRUE(buffer.Read<float>(absl::MakeSpan(output)));
+    EXPECT_THAT(output, Pointwise(FloatNear(1e-5), kTestOutputTensor));
+  }
+
+  for (auto& input_buffer : input_buffers) {
+    LiteRtDestroyTensorBuffer(input_buffer);
+  }
+  for (auto& output_buffer : output_buffers) {
+    LiteRtDestroyTensorBuffer(output_buffer);
+  }
+
+  compiled_model.reset();
+  LiteRtDestroyModel(model);
+  LiteRtDestroyEnvironment(env_ptr);
+}
+
+TEST(CompiledModelTest, TrimMemoryKeepsCompiledModelRunnable) {
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtEnvironmentT::Ptr env,
+                              LiteRtEnvironmentT::CreateWithOptions({}));
+  LiteRtEnvironmentT* env_ptr = env.release();
+
+  std::string path = testing::GetTestFilePath(kModelFileName);
+  LiteRtModel model;
+  ASSERT_EQ(LiteRtCreateModelFromFile(path.c_str(), &model), kLiteRtStatusOk);
+  absl::string_view signature_key = LiteRtSignatureT::kDefaultSignatureKey;
+
+  LiteRtOptions jit_compilation_options;
+  ASSERT_EQ(LiteRtCreateOptions(&jit_compilation_options), kLiteRtStatusOk);
+  ASSERT_EQ(LiteRtSetOptionsHardwareAccelerators(jit_compilation_options,
+                                                 kLiteRtHwAcceleratorCpu),
+            kLiteRtStatusOk);
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      LiteRtCompiledModelT::Ptr compiled_model,
+      LiteRtCompiledModelT::Create(env_ptr, model, jit_compilation_options));
+  LiteRtDestroyOptions(jit_compilation_options);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> input_buffers,
+      CreateInputBuffersFromRequirements(env_ptr, *model, signature_key,
+                                         *compiled_model));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> output_buffers,
+      CreateOutputBuffersFromRequirements(env_ptr, *model, signature_key,
+                                          *compiled_model));
+  {
+    TensorBuffer buffer0 =
+        TensorBuffer::WrapCObject(input_buffers[0], OwnHandle::kNo);
+    ASSERT_TRUE(buffer0.Write<float>(
+        absl::MakeConstSpan(kTestInput0Tensor, kTestInput0Size)));
+    TensorBuffer buffer1 =
+        TensorBuffer::WrapCObject(input_buffers[1], OwnHandle::kNo);
+    ASSERT_TRUE(buffer1.Write<float>(
+        absl::MakeConstSpan(kTestInput1Tensor, kTestInput1Size)));
+  }
+
+  bool async = false;
+  LITERT_ASSERT_OK(compiled_model->Run(signature_key, input_buffers,
+                                       output_buffers, async));
+
+  // Only a critical memory pressure releases the arenas of the signatures, and
+  // only once until the next run.
+  EXPECT_EQ(compiled_model->TrimMemory(kLiteRtTrimMemoryLevelModerate), 0);
+  env_ptr->TrimMemory(kLiteRtTrimMemoryLevelCritical);
+  EXPECT_EQ(compiled_model->TrimMemory(kLiteRtTrimMemoryLevelCritical), 0);
+
+  // The released memory is allocated again by the next run.
+  LITERT_ASSERT_OK(compiled_model->Run(signature_key, input_buffers,
+                                       output_buffers, async));
+  {
+    TensorBuffer buffer =
+        TensorBuffer::WrapCObject(output_buffers[0], OwnHandle::kNo);
+    std::vector<float> output(kTestOutputSize);
+    ASSERT_TRUE(buffer.Read<float>(absl::MakeSpan(output)));
+    EXPECT_THAT(output, Pointwise(FloatNear(1e-5), kTestOutputTensor));
+  }
+
+  for (auto& input_buffer : input_buffers) {
+    LiteRtDestroyTensorBuffer(input_buffer);
+  }
+  for (auto& output_buffer : output_buffers) {
+    LiteRtDestroyTensorBuffer(output_buffer);
+  }
+
+  compiled_model.reset();
+  LiteRtDestroyModel(model);
+  LiteRtDestroyEnvironment(env_ptr);
+}
+
+TEST(CompiledModelTest, RunAsyncOnHostDefersInputEvents) {
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtEnvironmentT::Ptr env,
+                              LiteRtEnvironmentT::CreateWithOptions({}));
+  LiteRtEnvironmentT* env_ptr = env.release();
+
+  std::string path = testing::GetTestFilePath(kModelFileName);
+  LiteRtModel model;
+  ASSERT_EQ(LiteRtCreateModelFromFile(path.c_str(), &model), kLiteRtStatusOk);
+  absl::string_view signature_key = LiteRtSignatureT::kDefaultSignatureKey;
+
+  LiteRtOptions jit_compilation_options;
+  ASSERT_EQ(LiteRtCreateOptions(&jit_compilation_options), kLiteRtStatusOk);
+  ASSERT_EQ(LiteRtSetOptionsHardwareAccelerators(jit_compilation_options,
+                                                 kLiteRtHwAcceleratorCpu),
+            kLiteRtStatusOk);
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      LiteRtCompiledModelT::Ptr compiled_model,
+      LiteRtCompiledModelT::Create(env_ptr, model, jit_compilation_options));
+  LiteRtDestroyOptions(jit_compilation_options);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> input_buffers,
+      CreateInputBuffersFromRequirements(env_ptr, *model, signature_key,
+                                         *compiled_model));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> output_buffers,
+      CreateOutputBuffersFromRequirements(env_ptr, *model, signature_key,
+                                          *compiled_model));
+  {
+    TensorBuffer buffer1 =
+        TensorBuffer::WrapCObject(input_buffers[1], OwnHandle::kNo);
+    ASSERT_TRUE(buffer1.Write<float>(
+        absl::MakeConstSpan(kTestInput1Tensor, kTestInput1Size)));
+  }
+
+  // The first input is produced by a host operation that hasn't completed.
+  auto producer = std::make_shared<litert::internal::HostEventState>();
+  input_buffers[0]->SetEvent(new LiteRtEventT{
+      .env = env_ptr,
+      .type = LiteRtEventTypeHost,
+      .host_state = producer,
+  });
+
+  // The run doesn't wait for the producer.
+  bool async = true;
+  LITERT_ASSERT_OK(
+      compiled_model->Run(signature_key, input_buffers, output_buffers, async));
+  EXPECT_TRUE(async);
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtEventT * event,
+                              output_buffers[0]->GetEvent());
+  LITERT_ASSERT_OK_AND_ASSIGN(bool is_signaled, event->IsSignaled());
+  EXPECT_FALSE(is_signaled);
+
+  // Complete the producer, which releases the invocation.
+  std::memcpy(input_buffers[0]->GetHostBuffer().Value(), kTestInput0Tensor,
+              kTestInput0Size * sizeof(float));
+  producer->Signal(kLiteRtStatusOk);
+  {
+    void* host_mem_addr;
+    ASSERT_EQ(LiteRtLockTensorBuffer(output_buffers[0], &host_mem_addr,
+                                     kLiteRtTensorBufferLockModeRead),
+              kLiteRtStatusOk);
+    absl::Span<const float> output = absl::MakeSpan(
+        static_cast<const float*>(host_mem_addr), kTestOutputSize);
+    EXPECT_THAT(output, Pointwise(FloatNear(1e-5), kTestOutputTensor));
+    ASSERT_EQ(LiteRtUnlockTensorBuffer(output_buffers[0]), kLiteRtStatusOk);
+  }
+
+  for (auto& input_buffer : input_buffers) {
+    LiteRtDestroyTensorBuffer(input_buffer);
+  }
+  for (auto& output_buffer : output_buffers) {
+    LiteRtDestroyTensorBuffer(output_buffer);
+  }
+
+  LiteRtDestroyModel(model);
+  LiteRtDestroyEnvironment(env_ptr);
+}
+
+TEST(CompiledModelTest, RunAsyncOnHostReportsFailedInputProducer) {
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtEnvironmentT::Ptr env,
+                              LiteRtEnvironmentT::CreateWithOptions({}));
+  LiteRtEnvironmentT* env_ptr = env.release();
+
+  std::string path = testing::GetTestFilePath(kModelFileName);
+  LiteRtModel model;
+  ASSERT_EQ(LiteRtCreateModelFromFile(path.c_str(), &model), kLiteRtStatusOk);
+  absl::string_view signature_key = LiteRtSignatureT::kDefaultSignatureKey;
+
+  LiteRtOptions jit_compilation_options;
+  ASSERT_EQ(LiteRtCreateOptions(&jit_compilation_options), kLiteRtStatusOk);
+  ASSERT_EQ(LiteRtSetOptionsHardwareAccelerators(jit_compilation_options,
+                                                 kLiteRtHwAcceleratorCpu),
+            kLiteRtStatusOk);
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      LiteRtCompiledModelT::Ptr compiled_model,
+      LiteRtCompiledModelT::Create(env_ptr, model, jit_compilation_options));
+  LiteRtDestroyOptions(jit_compilation_options);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> input_buffers,
+      CreateInputBuffersFromRequirements(env_ptr, *model, signature_key,
+                                         *compiled_model));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> output_buffers,
+      CreateOutputBuffersFromRequirements(env_ptr, *model, signature_key,
+                                          *compiled_model));
+
+  auto producer = std::make_shared<litert::internal::HostEventState>();
+  input_buffers[0]->SetEvent(new LiteRtEventT{
+      .env = env_ptr,
+      .type = LiteRtEventTypeHost,
+      .host_state = producer,
+  });
+  bool async = true;
+  LITERT_ASSERT_OK(
+      compiled_model->Run(signature_key, input_buffers, output_buffers, async));
+  EXPECT_TRUE(async);
+
+  // The producer fails after the run has been scheduled.
+  producer->Signal(kLiteRtStatusErrorRuntimeFailure);
+
+  // Locking either the input or the output returns the error of the producer
+  // instead of the contents of the buffer.
+  void* host_mem_addr;
+  EXPECT_EQ(LiteRtLockTensorBuffer(input_buffers[0], &host_mem_addr,
+                                   kLiteRtTensorBufferLockModeRead),
+            kLiteRtStatusErrorRuntimeFailure);
+  EXPECT_EQ(LiteRtLockTensorBuffer(output_buffers[0], &host_mem_addr,
+                                   kLiteRtTensorBufferLockModeRead),
+            kLiteRtStatusErrorRuntimeFailure);
+
+  for (auto& input_buffer : input_buffers) {
+    LiteRtDestroyTensorBuffer(input_buffer);
+  }
+  for (auto& output_buffer : output_buffers) {
+    LiteRtDestroyTensorBuffer(output_buffer);
+  }
+
+  compiled_model.reset();
+  LiteRtDestroyModel(model);
+  LiteRtDestroyEnvironment(env_ptr);
+}
+
+TEST(CompiledModelTest, RunAsyncOnHostRetainsInputBuffers) {
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtEnvironmentT::Ptr env,
+                              LiteRtEnvironmentT::CreateWithOptions({}));
+  LiteRtEnvironmentT* env_ptr = env.release();
+
+  std::string path = testing::GetTestFilePath(kModelFileName);
+  LiteRtModel model;
+  ASSERT_EQ(LiteRtCreateModelFromFile(path.c_str(), &model), kLiteRtStatusOk);
+  absl::string_view signature_key = LiteRtSignatureT::kDefaultSignatureKey;
+
+  LiteRtOptions jit_compilation_options;
+  ASSERT_EQ(LiteRtCreateOptions(&jit_compilation_options), kLiteRtStatusOk);
+  ASSERT_EQ(LiteRtSetOptionsHardwareAccelerators(jit_compilation_options,
+                                                 kLiteRtHwAcceleratorCpu),
+            kLiteRtStatusOk);
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      LiteRtCompiledModelT::Ptr compiled_model,
+      LiteRtCompiledModelT::Create(env_ptr, model, jit_compilation_options));
+  LiteRtDestroyOptions(jit_compilation_options);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> input_buffers,
+      CreateInputBuffersFromRequirements(env_ptr, *model, signature_key,
+                                         *compiled_model));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      std::vector<LiteRtTensorBuffer> output_buffers,
+      CreateOutputBuffersFromRequirements(env_ptr, *model, signature_key,
+                                          *compiled_model));
+  {
+    TensorBuffer buffer0 =
+        TensorBuffer::WrapCObject(input_buffers[0], OwnHandle::kNo);
+    ASSERT_TRUE(buffer0.Write<float>(
+        absl::MakeConstSpan(kTestInput0Tensor, kTestInput0Size)));
+    TensorBuffer buffer1 =
+        TensorBuffer::WrapCObject(input_buffers[1], OwnHandle::kNo);
+    ASSERT_TRUE(buffer1.Write<float>(
+        absl::MakeConstSpan(kTestInput1Tensor, kTestInput1Size)));
+  }
+
+  // Hold the invocation on the first input, which has its wait deferred, so
+  // that the inputs are released before the invocation reads them.
+  auto producer = std::make_shared<litert::internal::HostEventState>();
+  input_buffers[0]->SetEvent(new LiteRtEventT{
+      .env = env_ptr,
+      .type = LiteRtEventTypeHost,
+      .host_state = producer,
+  });
+  bool async = true;
+  LITERT_ASSERT_OK(
+      compiled_model->Run(signature_key, input_buffers, output_buffers, async));
+  EXPECT_TRUE(async);
+  for (auto& input_buffer : input_buffers) {
+    LiteRtDestroyTensorBuffer(input_buffer);
+  }
+  producer->Signal(kLiteRtStatusOk);
+
+  {
+    void* host_mem_addr;
+    ASSERT_EQ(LiteRtLockTensorBuffer(output_buffers[0], &host_mem_addr,
+                                     kLiteRtTensorBufferLockModeRead),
+              kLiteRtStatusOk);
+    absl::Span<const float> output = absl::MakeSpan(
+        static_cast<const float*>(host_mem_addr), kTestOutputSize);
+    EXPECT_THAT(output, Pointwise(FloatNear(1e-5), kTestOutputTensor));
+    ASSERT_EQ(LiteRtUnlockTensorBuffer(output_buffers[0]), kLiteRtStatusOk);
+  }
+
+  for (auto& output_buffer : output_buffers) {
+    LiteRtDestroyTensorBuffer(output_buffer);
+  }
+
+  compiled_model.reset();
+  LiteRtDestroyModel(model);
+  LiteRtDestroyEnvironment(env_ptr);
+}
+
 }  // namespace
 }  // namespace litert
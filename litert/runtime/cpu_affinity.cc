@@ -0,0 +1,82 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/cpu_affinity.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/options/litert_cpu_options_type.h"
+#include "tflite/experimental/acceleration/mini_benchmark/big_little_affinity.h"
+
+namespace litert::internal {
+
+std::vector<int> GetCpusForAffinityPolicy(LiteRtCpuAffinityPolicy policy) {
+  if (policy == kLiteRtCpuAffinityPolicyNone) {
+    return {};
+  }
+  // The detection reads the cores once per process.
+  static const tflite::acceleration::BigLittleAffinity affinity =
+      tflite::acceleration::GetAffinity();
+  uint16_t mask = 0;
+  switch (policy) {
+    case kLiteRtCpuAffinityPolicyBigCores:
+      mask = affinity.big_core_affinity;
+      break;
+    case kLiteRtCpuAffinityPolicyPrimeCores:
+      mask = affinity.prime_core_affinity;
+      break;
+    case kLiteRtCpuAffinityPolicyLittleCores:
+      mask = affinity.little_core_affinity;
+      break;
+    default:
+      break;
+  }
+  std::vector<int> cpus;
+  for (int cpu = 0; cpu < 16; ++cpu) {
+    if (mask & (1 << cpu)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+ScopedCpuAffinity::ScopedCpuAffinity(absl::Span<const int> cpus) {
+#if defined(__linux__)
+  if (cpus.empty() ||
+      sched_getaffinity(0, sizeof(previous_cpus_), &previous_cpus_) != 0) {
+    return;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpu_set);
+    }
+  }
+  // Failures, e.g. because the CPUs are offline, leave the thread as it was.
+  pinned_ = sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0;
+#endif  // defined(__linux__)
+}
+
+ScopedCpuAffinity::~ScopedCpuAffinity() {
+#if defined(__linux__)
+  if (pinned_) {
+    sched_setaffinity(0, sizeof(previous_cpus_), &previous_cpus_);
+  }
+#endif  // defined(__linux__)
+}
+
+}  // namespace litert::internal
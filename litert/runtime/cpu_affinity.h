@@ -0,0 +1,57 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_RUNTIME_CPU_AFFINITY_H_
+#define ODML_LITERT_LITERT_RUNTIME_CPU_AFFINITY_H_
+
+#include <vector>
+
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/options/litert_cpu_options_type.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif  // defined(__linux__)
+
+namespace litert::internal {
+
+// Returns the CPUs of `policy` as detected by the TFLite mini-benchmark from
+// the max frequencies and micro-architectures of the cores, or an empty vector
+// for kLiteRtCpuAffinityPolicyNone or if the cores are unknown, e.g. off
+// Android.
+std::vector<int> GetCpusForAffinityPolicy(LiteRtCpuAffinityPolicy policy);
+
+// Pins the calling thread to `cpus` until it goes out of scope, then restores
+// its previous affinity. Does nothing if `cpus` is empty or off Linux.
+//
+// The threads the calling thread creates in that scope inherit the affinity,
+// e.g. those of the XNNPack and ruy thread pools.
+class ScopedCpuAffinity {
+ public:
+  explicit ScopedCpuAffinity(absl::Span<const int> cpus);
+  ~ScopedCpuAffinity();
+
+  ScopedCpuAffinity(const ScopedCpuAffinity&) = delete;
+  ScopedCpuAffinity& operator=(const ScopedCpuAffinity&) = delete;
+
+ private:
+#if defined(__linux__)
+  cpu_set_t previous_cpus_;
+  bool pinned_ = false;
+#endif  // defined(__linux__)
+};
+
+}  // namespace litert::internal
+
+#endif  // ODML_LITERT_LITERT_RUNTIME_CPU_AFFINITY_H_
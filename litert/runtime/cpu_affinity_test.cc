@@ -0,0 +1,87 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/cpu_affinity.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif  // defined(__linux__)
+
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "litert/c/options/litert_cpu_options_type.h"
+
+namespace litert::internal {
+namespace {
+
+using ::testing::Each;
+using ::testing::IsEmpty;
+using ::testing::Lt;
+
+TEST(CpuAffinityTest, NonePolicyHasNoCpus) {
+  EXPECT_THAT(GetCpusForAffinityPolicy(kLiteRtCpuAffinityPolicyNone),
+              IsEmpty());
+}
+
+TEST(CpuAffinityTest, PolicyCpusAreValid) {
+  const int num_cpus = std::thread::hardware_concurrency();
+  for (const auto policy :
+       {kLiteRtCpuAffinityPolicyBigCores, kLiteRtCpuAffinityPolicyPrimeCores,
+        kLiteRtCpuAffinityPolicyLittleCores}) {
+    EXPECT_THAT(GetCpusForAffinityPolicy(policy), Each(Lt(num_cpus)));
+  }
+}
+
+#if defined(__linux__)
+TEST(CpuAffinityTest, ScopedCpuAffinityPinsAndRestoresTheThread) {
+  cpu_set_t previous_cpus;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(previous_cpus), &previous_cpus), 0);
+  int cpu = 0;
+  while (!CPU_ISSET(cpu, &previous_cpus)) {
+    ++cpu;
+  }
+  {
+    ScopedCpuAffinity affinity(std::vector<int>{cpu});
+    cpu_set_t cpus;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(cpus), &cpus), 0);
+    EXPECT_EQ(CPU_COUNT(&cpus), 1);
+    EXPECT_TRUE(CPU_ISSET(cpu, &cpus));
+
+    // The threads created in the scope inherit the affinity.
+    cpu_set_t thread_cpus;
+    std::thread thread(
+        [&] { sched_getaffinity(0, sizeof(thread_cpus), &thread_cpus); });
+    thread.join();
+    EXPECT_TRUE(CPU_EQUAL(&thread_cpus, &cpus));
+  }
+  cpu_set_t cpus;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(cpus), &cpus), 0);
+  EXPECT_TRUE(CPU_EQUAL(&cpus, &previous_cpus));
+}
+
+TEST(CpuAffinityTest, ScopedCpuAffinityWithoutCpusKeepsTheThread) {
+  cpu_set_t previous_cpus;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(previous_cpus), &previous_cpus), 0);
+  ScopedCpuAffinity affinity({});
+  cpu_set_t cpus;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(cpus), &cpus), 0);
+  EXPECT_TRUE(CPU_EQUAL(&cpus, &previous_cpus));
+}
+#endif  // defined(__linux__)
+
+}  // namespace
+}  // namespace litert::internal
@@ -44,7 +44,11 @@ CustomBuffer::~CustomBuffer() {
   LITERT_ASSIGN_OR_ABORT(auto custom_buffer_handlers,
                          registry->GetCustomHandlers(buffer_type_));
   if (hw_memory_info_) {
+    HwMemoryHandle hw_buffer_handle = hw_memory_info_->memory_handle;
     custom_buffer_handlers.destroy_func(env_, hw_memory_info_);
+    if (deallocator_) {
+      deallocator_(hw_buffer_handle);
+    }
   }
 }
 
@@ -93,7 +97,8 @@ Expected<CustomBuffer> CustomBuffer::Alloc(
 Expected<CustomBuffer> CustomBuffer::Wrap(
     LiteRtEnvironment env, const LiteRtRankedTensorType& tensor_type,
     LiteRtTensorBufferType buffer_type, HwMemoryHandle hw_buffer_handle,
-    size_t buffer_size, size_t packed_buffer_size) {
+    size_t buffer_size, size_t packed_buffer_size,
+    void (*deallocator)(HwMemoryHandle)) {
   LITERT_ASSIGN_OR_RETURN(auto registry, GetTensorBufferRegistry(env));
   LITERT_ASSIGN_OR_RETURN(auto custom_buffer_handlers,
                           registry->GetCustomHandlers(buffer_type));
@@ -113,7 +118,8 @@ Expected<CustomBuffer> CustomBuffer::Wrap(
     return Unexpected(status, "Failed to import custom tensor buffer.");
   }
   // Use the private constructor to create the wrapper.
-  return CustomBuffer(env, tensor_type, buffer_type, hw_memory_info);
+  return CustomBuffer(env, tensor_type, buffer_type, hw_memory_info,
+                      deallocator);
 }
 
 }  // namespace internal
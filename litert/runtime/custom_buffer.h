@@ -37,12 +37,15 @@ class CustomBuffer {
   CustomBuffer(CustomBuffer&& other)
       : env_(other.env_),
         buffer_type_(other.buffer_type_),
-        hw_memory_info_(other.hw_memory_info_) {
+        hw_memory_info_(other.hw_memory_info_),
+        deallocator_(other.deallocator_) {
     other.hw_memory_info_ = nullptr;
+    other.deallocator_ = nullptr;
   }
 
   // Destructor to destroy the underlying custom buffer with
-  // `DestroyCustomTensorBuffer`.
+  // `DestroyCustomTensorBuffer`, then to release a wrapped H/W buffer with the
+  // deallocator given to `Wrap`, if any.
   ~CustomBuffer();
 
   HwMemoryHandle hw_buffer_handle() { return hw_memory_info_->memory_handle; }
@@ -61,23 +64,28 @@ class CustomBuffer {
                                       size_t packed_buffer_size);
 
   // Wraps an existing custom buffer. The function will not take ownership of
-  // the custom buffer.
-  static Expected<CustomBuffer> Wrap(LiteRtEnvironment env,
-                                     const LiteRtRankedTensorType& tensor_type,
-                                     LiteRtTensorBufferType buffer_type,
-                                     HwMemoryHandle hw_buffer_handle,
-                                     size_t buffer_size,
-                                     size_t packed_buffer_size);
+  // the custom buffer; the optional deallocator is called with the handle
+  // once the wrapper is destroyed.
+  static Expected<CustomBuffer> Wrap(
+      LiteRtEnvironment env, const LiteRtRankedTensorType& tensor_type,
+      LiteRtTensorBufferType buffer_type, HwMemoryHandle hw_buffer_handle,
+      size_t buffer_size, size_t packed_buffer_size,
+      void (*deallocator)(HwMemoryHandle) = nullptr);
 
  private:
   // Private constructor to create a custom buffer.
   CustomBuffer(LiteRtEnvironment env, const LiteRtRankedTensorType& tensor_type,
-               LiteRtTensorBufferType buffer_type, HwMemoryInfo* hw_memory_info)
-      : env_(env), buffer_type_(buffer_type), hw_memory_info_(hw_memory_info) {}
+               LiteRtTensorBufferType buffer_type, HwMemoryInfo* hw_memory_info,
+               void (*deallocator)(HwMemoryHandle) = nullptr)
+      : env_(env),
+        buffer_type_(buffer_type),
+        hw_memory_info_(hw_memory_info),
+        deallocator_(deallocator) {}
 
   LiteRtEnvironment env_;
   const LiteRtTensorBufferType buffer_type_;
   HwMemoryInfoPtr hw_memory_info_;
+  void (*deallocator_)(HwMemoryHandle) = nullptr;
 };
 
 }  // namespace litert::internal
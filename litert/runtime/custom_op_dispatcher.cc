@@ -25,9 +25,11 @@
 #include "litert/c/litert_layout.h"
 #include "litert/c/litert_model_types.h"
 #include "litert/c/litert_tensor_buffer.h"
+#include "litert/c/litert_tensor_buffer_types.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
 #include "litert/core/options.h"
+#include "litert/runtime/event.h"
 #include "litert/runtime/external_litert_buffer_context.h"
 #include "litert/runtime/tensor_buffer.h"
 #include "litert/runtime/tfl_utils.h"
@@ -192,8 +194,28 @@ Expected<void> CustomOpDispatcher::InvokeHelper(void* user_data,
     outputs.push_back(tensor_buffer.release());
   }
 
-  self.op_kernel_.Run(self.user_data_, inputs.size(), inputs.data(),
-                      outputs.size(), outputs.data());
+  if (!self.op_kernel_.RunAsync) {
+    LITERT_RETURN_IF_ERROR(self.op_kernel_.Run(self.user_data_, inputs.size(),
+                                               inputs.data(), outputs.size(),
+                                               outputs.data()));
+    return {};
+  }
+
+  LITERT_RETURN_IF_ERROR(self.op_kernel_.RunAsync(self.user_data_,
+                                                  inputs.size(), inputs.data(),
+                                                  outputs.size(),
+                                                  outputs.data()));
+
+  // The next ops read host memory outputs through the TFL tensor data without
+  // waiting for their events, so only device buffers keep theirs.
+  for (auto* output : outputs) {
+    if (output->HasEvent() &&
+        output->buffer_type() == kLiteRtTensorBufferTypeHostMemory) {
+      LITERT_ASSIGN_OR_RETURN(auto* event, output->GetEvent());
+      LITERT_RETURN_IF_ERROR(event->Wait(/*timeout_in_ms=*/-1));
+      output->ClearEvent();
+    }
+  }
 
   return {};
 }
@@ -19,7 +19,7 @@
 #include <cstdint>
 #include <cstring>
 #include <iterator>
-#include <set>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -42,8 +42,11 @@
 #include "litert/cc/litert_macros.h"
 #include "litert/cc/litert_opaque_options.h"
 #include "litert/core/dispatch_op_schema.h"
+#include "litert/core/util/perfetto_profiling.h"
 #include "litert/runtime/dispatch/dispatch_opaque_options.h"
+#include "litert/runtime/dispatch/dispatch_registration_cache.h"
 #include "litert/runtime/external_litert_buffer_context.h"
+#include "litert/runtime/litert_runtime_options.h"
 #include "litert/runtime/tensor_buffer.h"
 #include "litert/runtime/tensor_buffer_requirements.h"
 #include "litert/runtime/tfl_utils.h"
@@ -51,55 +54,75 @@
 #include "tflite/c/c_api_opaque.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/c/common.h"
+#include "tflite/core/api/profiler.h"
 #include "tflite/core/c/c_api_opaque.h"
 
 namespace litert::internal {
+namespace {
+
+// Records a step of the kernel evaluation on the profiler of the compiled
+// model, with the bytes copied during that step as first metadata. Tools
+// attribute these events to the partition whose op event contains them.
+class ScopedTransferProfile {
+ public:
+  ScopedTransferProfile(tflite::Profiler* profiler, const char* tag)
+      : profiler_(profiler),
+        event_handle_(profiler ? profiler->BeginEvent(
+                                     tag, tflite::Profiler::EventType::DEFAULT,
+                                     /*event_metadata1=*/0,
+                                     /*event_metadata2=*/0)
+                               : 0) {}
+  ~ScopedTransferProfile() { End(); }
+
+  void AddBytes(size_t bytes) { bytes_ += bytes; }
+
+  void End() {
+    if (profiler_) {
+      profiler_->EndEvent(event_handle_, bytes_, /*event_metadata2=*/0);
+      profiler_ = nullptr;
+    }
+  }
+
+ private:
+  tflite::Profiler* profiler_;
+  uint32_t event_handle_;
+  int64_t bytes_ = 0;
+};
+
+}  // namespace
 
 DispatchDelegateKernel::~DispatchDelegateKernel() {
   // Detach all buffer handles from invocation contexts.
-  {
-    for (const auto& [tfl_tensor, tensor_info] : tensor_buffer_infos_) {
-      auto itpc_it = io_tensors_port_connections_.find(tfl_tensor);
-      if (itpc_it == io_tensors_port_connections_.end()) {
-        LITERT_LOG(LITERT_ERROR,
-                   "IO tensor port connections not found for tensor %p",
-                   tfl_tensor);
-        continue;
-      }
-      const auto& port_connections = itpc_it->second;
-
-      auto tbi_it = tensor_buffer_infos_.find(tfl_tensor);
-      if (tbi_it == tensor_buffer_infos_.end()) {
-        // Tensor buffer initialized but never consumed will not present in
-        // tensor_buffer_infos_.
-        LITERT_LOG(LITERT_WARNING, "Tensor buffer info not found for tensor %p",
-                   tfl_tensor);
-        continue;
+  for (auto& slot : invocation_slots_) {
+    for (auto node_idx = 0; node_idx < slot.node_invocation_contexts.size();
+         ++node_idx) {
+      auto* invocation_context = slot.node_invocation_contexts[node_idx];
+      const auto& attached_inputs = slot.attached_inputs[node_idx];
+      for (auto i = 0; i < attached_inputs.size(); ++i) {
+        if (attached_inputs[i]) {
+          (void)LiteRtDispatchDetachInput(invocation_context, i,
+                                          *attached_inputs[i]);
+        }
       }
-      const auto& tensor_buffer_info = tbi_it->second;
-      for (auto& pc : port_connections) {
-        auto* invocation_context = node_invocation_contexts_[pc.node_idx];
-        if (pc.is_input_port) {
-          (void)LiteRtDispatchDetachInput(invocation_context, pc.port_idx,
-                                          tensor_buffer_info.buffer_handle);
-        } else {
-          (void)LiteRtDispatchDetachOutput(invocation_context, pc.port_idx,
-                                           tensor_buffer_info.buffer_handle);
+      const auto& attached_outputs = slot.attached_outputs[node_idx];
+      for (auto i = 0; i < attached_outputs.size(); ++i) {
+        if (attached_outputs[i]) {
+          (void)LiteRtDispatchDetachOutput(invocation_context, i,
+                                           *attached_outputs[i]);
         }
       }
     }
   }
 
-  // Unregister all buffer handles.
-  for (const auto& p : tensor_buffer_infos_) {
-    auto& tensor_buffer_info = p.second;
-    (void)LiteRtDispatchUnregisterTensorBuffer(
-        device_context_, tensor_buffer_info.buffer_handle);
-  }
+  // Unregister all buffer handles, including the cached ones that are no
+  // longer attached.
+  registration_cache_.Clear();
 
   // Destroy all invocation contexts.
-  for (auto invocation_context : node_invocation_contexts_) {
-    (void)LiteRtDispatchInvocationContextDestroy(invocation_context);
+  for (auto& slot : invocation_slots_) {
+    for (auto invocation_context : slot.node_invocation_contexts) {
+      (void)LiteRtDispatchInvocationContextDestroy(invocation_context);
+    }
   }
 }
 
@@ -119,9 +142,21 @@ Expected<DispatchDelegateKernel::Ptr> DispatchDelegateKernel::Create(
     LITERT_LOG(LITERT_INFO, "Found async dispatch capabilities");
   }
 
-  return Ptr(new DispatchDelegateKernel(environment_options, options,
-                                        std::move(graph_name), device_context,
-                                        async_dispatch));
+  size_t num_invocation_slots = 1;
+  if (options && async_dispatch) {
+    auto opaque_options =
+        OpaqueOptions::WrapCObject(options->options, OwnHandle::kNo);
+    if (auto runtime_options = FindOpaqueData<LiteRtRuntimeOptionsT>(
+            opaque_options, LiteRtRuntimeOptionsT::Identifier());
+        runtime_options) {
+      num_invocation_slots = std::max(
+          (*runtime_options)->num_dispatch_invocation_contexts, 1);
+    }
+  }
+
+  return Ptr(new DispatchDelegateKernel(
+      environment_options, options, std::move(graph_name), device_context,
+      async_dispatch, num_invocation_slots));
 }
 
 Expected<const void*> DispatchDelegateKernel::FindAllocBase() const {
@@ -170,37 +205,43 @@ TfLiteStatus DispatchDelegateKernel::Eval(TfLiteOpaqueContext* context,
 
 litert::Expected<void> DispatchDelegateKernel::StartMetricsCollection(
     int detail_level) {
-  for (auto invocation_context : node_invocation_contexts_) {
-    LITERT_RETURN_IF_ERROR(
-        LiteRtDispatchStartMetricsCollection(invocation_context, detail_level));
+  for (auto& slot : invocation_slots_) {
+    for (auto invocation_context : slot.node_invocation_contexts) {
+      LITERT_RETURN_IF_ERROR(LiteRtDispatchStartMetricsCollection(
+          invocation_context, detail_level));
+    }
   }
+  metrics_detail_level_ = detail_level;
   return {};
 }
 
 Expected<LiteRtMetricsT> DispatchDelegateKernel::StopMetricsCollection() {
   std::vector<LiteRtMetricsT::Metric> metrics;
+  metrics_detail_level_.reset();
+
+  for (auto& slot : invocation_slots_) {
+    for (auto invocation_context : slot.node_invocation_contexts) {
+      LiteRtDispatchMetrics dispatch_metrics;
+      LITERT_RETURN_IF_ERROR(LiteRtDispatchStopMetricsCollection(
+          invocation_context, &dispatch_metrics));
+
+      absl::Cleanup metrics_cleanup = [&dispatch_metrics] {
+        if (auto status = LiteRtDispatchDestroyMetrics(dispatch_metrics);
+            status != kLiteRtStatusOk) {
+          LITERT_LOG(LITERT_ERROR, "Failed to destroy metrics: %d", status);
+        }
+      };
 
-  for (auto invocation_context : node_invocation_contexts_) {
-    LiteRtDispatchMetrics dispatch_metrics;
-    LITERT_RETURN_IF_ERROR(LiteRtDispatchStopMetricsCollection(
-        invocation_context, &dispatch_metrics));
+      int num_metrics = 0;
+      LITERT_RETURN_IF_ERROR(
+          LiteRtDispatchGetNumMetrics(dispatch_metrics, &num_metrics));
 
-    absl::Cleanup metrics_cleanup = [&dispatch_metrics] {
-      if (auto status = LiteRtDispatchDestroyMetrics(dispatch_metrics);
-          status != kLiteRtStatusOk) {
-        LITERT_LOG(LITERT_ERROR, "Failed to destroy metrics: %d", status);
+      for (int i = 0; i < num_metrics; ++i) {
+        LiteRtMetric metric;
+        LITERT_RETURN_IF_ERROR(
+            LiteRtDispatchGetMetric(dispatch_metrics, i, &metric));
+        metrics.push_back({/*.name=*/metric.name, /*.value=*/metric.value});
       }
-    };
-
-    int num_metrics = 0;
-    LITERT_RETURN_IF_ERROR(
-        LiteRtDispatchGetNumMetrics(dispatch_metrics, &num_metrics));
-
-    for (int i = 0; i < num_metrics; ++i) {
-      LiteRtMetric metric;
-      LITERT_RETURN_IF_ERROR(
-          LiteRtDispatchGetMetric(dispatch_metrics, i, &metric));
-      metrics.push_back({/*.name=*/metric.name, /*.value=*/metric.value});
     }
   }
 
@@ -221,12 +262,6 @@ Expected<void> DispatchDelegateKernel::InitHelper(
   LITERT_ASSIGN_OR_RETURN(auto nodes, GetNodes(context, params));
   std::swap(nodes_, nodes);
 
-  for (auto& node : nodes_) {
-    LITERT_ASSIGN_OR_RETURN(auto node_invocation_contexts,
-                            CreateNodeInvocationContext(context, node));
-    node_invocation_contexts_.push_back(node_invocation_contexts);
-  }
-
   // Store tensor IDs for later pointer refresh
   input_tensor_ids_.clear();
   input_tensor_ids_.reserve(params.input_tensors->size);
@@ -285,6 +320,17 @@ Expected<void> DispatchDelegateKernel::InitHelper(
     }
   }
 
+  // Intermediate tensor buffers are shared by all invocation slots, so
+  // executions running on distinct slots would race on them.
+  if (num_invocation_slots_ > 1 && !internal_tensor_ids_.empty()) {
+    LITERT_LOG(LITERT_INFO,
+               "Using a single invocation context per node: the dispatch "
+               "nodes exchange intermediate tensors");
+    num_invocation_slots_ = 1;
+  }
+  invocation_slots_.reserve(num_invocation_slots_);
+  LITERT_RETURN_IF_ERROR(AddInvocationSlot(context));
+
   LITERT_RETURN_IF_ERROR(ComputeTensorPortConnections(context));
 
   // Compute requirements across the graph.
@@ -301,9 +347,19 @@ Expected<void> DispatchDelegateKernel::PrepareHelper(
 Expected<void> DispatchDelegateKernel::EvalHelper(TfLiteOpaqueContext* context,
                                                   TfLiteOpaqueNode* node) {
   LITERT_RETURN_IF_ERROR(AllocateTensorBuffersIfNeeded(context));
-  LITERT_RETURN_IF_ERROR(AttachBuffersToInvocationContextsIfNeeded(context));
 
+  const bool async_execution =
+      async_dispatch_ && buffer_context_->IsAsyncExecutionMode();
+  InvocationSlot* slot = &invocation_slots_.front();
+  if (async_execution) {
+    LITERT_ASSIGN_OR_RETURN(slot, NextAsyncInvocationSlot(context));
+  }
+  LITERT_RETURN_IF_ERROR(
+      AttachBuffersToInvocationContextsIfNeeded(context, *slot));
+
+  tflite::Profiler* profiler = buffer_context_->GetProfiler();
   // Copy input buffers from CPU, if needed.
+  ScopedTransferProfile copy_in_profile(profiler, "LiteRT::Dispatch[copy in]");
   for (int tensor_id : input_tensor_ids_) {
     auto* tfl_tensor = TfLiteOpaqueContextGetOpaqueTensor(context, tensor_id);
     if (!tfl_tensor) {
@@ -324,16 +380,22 @@ Expected<void> DispatchDelegateKernel::EvalHelper(TfLiteOpaqueContext* context,
                                     kLiteRtTensorBufferLockModeRead));
         std::memcpy(host_buffer, tensor_data, buffer_size);
         LITERT_RETURN_IF_ERROR(tensor_buffer_info.tensor_buffer->Unlock());
+        copy_in_profile.AddBytes(buffer_size);
       }
     }
   }
+  copy_in_profile.End();
 
-  if (async_dispatch_ && buffer_context_->IsAsyncExecutionMode()) {
-    LITERT_RETURN_IF_ERROR(ScheduleAsyncExecution(context));
+  ScopedTransferProfile invoke_profile(profiler, "LiteRT::Dispatch[invoke]");
+  if (async_execution) {
+    LITERT_RETURN_IF_ERROR(ScheduleAsyncExecution(context, *slot));
   } else {
-    LITERT_RETURN_IF_ERROR(ScheduleSyncExecution(context));
+    LITERT_RETURN_IF_ERROR(ScheduleSyncExecution(context, *slot));
   }
+  invoke_profile.End();
 
+  ScopedTransferProfile copy_out_profile(profiler,
+                                         "LiteRT::Dispatch[copy out]");
   for (int tensor_id : output_tensor_ids_) {
     auto* tfl_tensor = TfLiteOpaqueContextGetOpaqueTensor(context, tensor_id);
     if (!tfl_tensor) {
@@ -354,6 +416,7 @@ Expected<void> DispatchDelegateKernel::EvalHelper(TfLiteOpaqueContext* context,
                                     kLiteRtTensorBufferLockModeWrite));
         std::memcpy(tensor_data, host_buffer, buffer_size);
         LITERT_RETURN_IF_ERROR(tensor_buffer_info.tensor_buffer->Unlock());
+        copy_out_profile.AddBytes(buffer_size);
       }
     }
   }
@@ -527,6 +590,42 @@ DispatchDelegateKernel::CreateNodeInvocationContext(
   return invocation_context;
 }
 
+Expected<void> DispatchDelegateKernel::AddInvocationSlot(
+    TfLiteOpaqueContext* context) {
+  InvocationSlot slot;
+  absl::Cleanup destroy_invocation_contexts = [&slot] {
+    for (auto invocation_context : slot.node_invocation_contexts) {
+      (void)LiteRtDispatchInvocationContextDestroy(invocation_context);
+    }
+  };
+
+  for (auto* node : nodes_) {
+    LITERT_ASSIGN_OR_RETURN(auto invocation_context,
+                            CreateNodeInvocationContext(context, node));
+    slot.node_invocation_contexts.push_back(invocation_context);
+    if (metrics_detail_level_) {
+      LITERT_RETURN_IF_ERROR(LiteRtDispatchStartMetricsCollection(
+          invocation_context, *metrics_detail_level_));
+    }
+    slot.attached_inputs.emplace_back(TfLiteOpaqueNodeNumberOfInputs(node));
+    slot.attached_outputs.emplace_back(TfLiteOpaqueNodeNumberOfOutputs(node));
+  }
+
+  std::move(destroy_invocation_contexts).Cancel();
+  invocation_slots_.push_back(std::move(slot));
+  return {};
+}
+
+Expected<DispatchDelegateKernel::InvocationSlot*>
+DispatchDelegateKernel::NextAsyncInvocationSlot(TfLiteOpaqueContext* context) {
+  size_t slot_idx = next_async_invocation_slot_;
+  if (slot_idx == invocation_slots_.size()) {
+    LITERT_RETURN_IF_ERROR(AddInvocationSlot(context));
+  }
+  next_async_invocation_slot_ = (slot_idx + 1) % num_invocation_slots_;
+  return &invocation_slots_[slot_idx];
+}
+
 Expected<void> DispatchDelegateKernel::ComputeTensorPortConnections(
     TfLiteOpaqueContext* context) {
   for (auto node_idx = 0; node_idx < nodes_.size(); ++node_idx) {
@@ -556,7 +655,8 @@ DispatchDelegateKernel::GetBufferRequirements(int node_idx,
                                               TfLiteOpaqueTensor* io_tfl_tensor,
                                               int io_tensor_index,
                                               bool is_input) const {
-  auto* invocation_context = node_invocation_contexts_[node_idx];
+  auto* invocation_context =
+      invocation_slots_.front().node_invocation_contexts[node_idx];
 
   LITERT_ASSIGN_OR_RETURN(auto tensor_type, ConvertTensorType(io_tfl_tensor));
   auto litert_tensor_type = static_cast<LiteRtRankedTensorType>(tensor_type);
@@ -671,11 +771,8 @@ Expected<void> DispatchDelegateKernel::AllocateTensorBuffersIfNeeded(
   // also keep a non-owned alias of I/O tensor buffers in tensor_buffer_infos_,
   // for internal processing.
 
-  std::set<LiteRtTensorBufferHandle> unused_buffer_handles;
-
   auto allocate_and_register =
-      [this, context, &unused_buffer_handles,
-       &io_tensors](auto* tfl_tensor) -> Expected<void> {
+      [this, context, &io_tensors](auto* tfl_tensor) -> Expected<void> {
     auto iter = tensor_buffer_infos_.find(tfl_tensor);
     if (iter != tensor_buffer_infos_.end()) {
       auto& tensor_buffer_info = iter->second;
@@ -693,37 +790,22 @@ Expected<void> DispatchDelegateKernel::AllocateTensorBuffersIfNeeded(
         return {};
       }
 
-      // The tensor buffer associated with tfl_tensor has changed. Consequently,
-      // we must detach the old tensor buffer from the model and attach the new
-      // one.
+      // The tensor buffer associated with tfl_tensor has changed. The
+      // invocation contexts switch to the new one the next time they run.
 
-      const auto& port_connections =
-          io_tensors_port_connections_.find(tfl_tensor)->second;
-      for (auto& pc : port_connections) {
-        auto* invocation_context = node_invocation_contexts_[pc.node_idx];
-        if (pc.is_input_port) {
-          LITERT_RETURN_IF_ERROR(
-              LiteRtDispatchDetachInput(invocation_context, pc.port_idx,
-                                        tensor_buffer_info.buffer_handle));
-        } else {
-          LITERT_RETURN_IF_ERROR(
-              LiteRtDispatchDetachOutput(invocation_context, pc.port_idx,
-                                         tensor_buffer_info.buffer_handle));
-        }
-      }
-
-      tensor_buffer_info.attached = false;
-
-      // Unregister the old tensor buffer with the Dispatch API. We do that at
-      // the end after collecting all tensor buffer handles to unregister
-      // because a tensor buffer may be connected to multiple TFL tensors
-      // (once we implement a proper tensor buffer allocation algorithm).
-      unused_buffer_handles.insert(tensor_buffer_info.buffer_handle);
-
-      // Register the tensor buffer with the dispatch API.
+      // Register the new tensor buffer with the dispatch API. The registration
+      // of a buffer that was used before is served by registration_cache_.
+      LiteRtTensorBufferHandle old_buffer_handle =
+          tensor_buffer_info.buffer_handle;
       LITERT_RETURN_IF_ERROR(RegisterBufferWithDispatchApi(
           context, tfl_tensor, std::move(tensor_buffer)));
 
+      // The old tensor buffer stays registered while it is still attached to
+      // an invocation context, and then so that it can be attached again
+      // without going through the vendor registration, e.g. when the
+      // application cycles through a ring of I/O buffers.
+      registration_cache_.Release(old_buffer_handle);
+
       return {};
     }
 
@@ -807,11 +889,6 @@ Expected<void> DispatchDelegateKernel::AllocateTensorBuffersIfNeeded(
         context, tfl_tensor, std::move(tensor_buffer)));
   }
 
-  for (auto buffer_handle : unused_buffer_handles) {
-    LITERT_RETURN_IF_ERROR(
-        LiteRtDispatchUnregisterTensorBuffer(device_context_, buffer_handle));
-  }
-
   return {};
 }
 
@@ -836,14 +913,12 @@ Expected<LiteRtTensorBufferPtr> DispatchDelegateKernel::AllocateTensorBuffer(
 Expected<void> DispatchDelegateKernel::RegisterBufferWithDispatchApi(
     TfLiteOpaqueContext* context, TfLiteOpaqueTensor* tfl_tensor,
     LiteRtTensorBufferPtr&& tensor_buffer) {
-  LiteRtTensorBufferHandle buffer_handle = 0;
-  if (tensor_buffer && tensor_buffer.get()) {
-    LITERT_RETURN_IF_ERROR(LiteRtDispatchRegisterTensorBuffer(
-        device_context_, tensor_buffer.get(), &buffer_handle));
-  } else {
+  if (!tensor_buffer) {
     return Unexpected(kLiteRtStatusErrorRuntimeFailure,
                       "Invalid tensor buffer");
   }
+  LITERT_ASSIGN_OR_RETURN(LiteRtTensorBufferHandle buffer_handle,
+                          registration_cache_.Acquire(tensor_buffer.get()));
 
   auto iter = tensor_buffer_infos_.find(tfl_tensor);
   if (iter == tensor_buffer_infos_.end()) {
@@ -886,10 +961,13 @@ Expected<void> DispatchDelegateKernel::RegisterBufferWithDispatchApi(
 
 Expected<void>
 DispatchDelegateKernel::AttachBuffersToInvocationContextsIfNeeded(
-    TfLiteOpaqueContext* context) {
+    TfLiteOpaqueContext* context, InvocationSlot& slot) {
+  // Each attachment holds a use of the registration, so that a buffer that is
+  // no longer bound to its tensor but is still attached to another slot does
+  // not get evicted from under that slot.
   for (auto node_idx = 0; node_idx < nodes_.size(); ++node_idx) {
     auto* node = nodes_[node_idx];
-    auto invocation_context = node_invocation_contexts_[node_idx];
+    auto invocation_context = slot.node_invocation_contexts[node_idx];
 
     // Process inputs using tensor ID to handle mapping
     const int* input_indices = nullptr;
@@ -898,24 +976,6 @@ DispatchDelegateKernel::AttachBuffersToInvocationContextsIfNeeded(
     for (auto i = 0; i < num_node_inputs; ++i) {
       int tensor_idx = input_indices[i];
 
-      auto* tfl_tensor =
-          TfLiteOpaqueContextGetOpaqueTensor(context, tensor_idx);
-      if (!tfl_tensor) {
-        return Unexpected(kLiteRtStatusErrorRuntimeFailure,
-                          "Tensor not found for input index");
-      }
-
-      auto tensor_info_iter = tensor_buffer_infos_.find(tfl_tensor);
-      if (tensor_info_iter == tensor_buffer_infos_.end()) {
-        return Unexpected(kLiteRtStatusErrorRuntimeFailure,
-                          "Tensor info not found for input tensor");
-      }
-
-      auto& tensor_buffer_info = tensor_info_iter->second;
-      if (tensor_buffer_info.attached) {
-        continue;
-      }
-
       // Look up buffer handle by tensor ID
       auto handle_iter = tensor_idx_to_handle_.find(tensor_idx);
       if (handle_iter == tensor_idx_to_handle_.end()) {
@@ -924,8 +984,20 @@ DispatchDelegateKernel::AttachBuffersToInvocationContextsIfNeeded(
       }
 
       LiteRtTensorBufferHandle buffer_handle = handle_iter->second;
+      auto& attached = slot.attached_inputs[node_idx][i];
+      if (attached == buffer_handle) {
+        continue;
+      }
+      if (attached) {
+        LITERT_RETURN_IF_ERROR(
+            LiteRtDispatchDetachInput(invocation_context, i, *attached));
+        registration_cache_.Release(*attached);
+        attached.reset();
+      }
       LITERT_RETURN_IF_ERROR(
           LiteRtDispatchAttachInput(invocation_context, i, buffer_handle));
+      LITERT_RETURN_IF_ERROR(registration_cache_.Retain(buffer_handle));
+      attached = buffer_handle;
     }
 
     // Process outputs using tensor ID to handle mapping
@@ -935,24 +1007,6 @@ DispatchDelegateKernel::AttachBuffersToInvocationContextsIfNeeded(
     for (auto i = 0; i < num_node_outputs; ++i) {
       int tensor_idx = output_indices[i];
 
-      auto* tfl_tensor =
-          TfLiteOpaqueContextGetOpaqueTensor(context, tensor_idx);
-      if (!tfl_tensor) {
-        return Unexpected(kLiteRtStatusErrorRuntimeFailure,
-                          "Tensor not found for output index");
-      }
-
-      auto tensor_info_iter = tensor_buffer_infos_.find(tfl_tensor);
-      if (tensor_info_iter == tensor_buffer_infos_.end()) {
-        return Unexpected(kLiteRtStatusErrorRuntimeFailure,
-                          "Tensor info not found for output tensor");
-      }
-
-      auto& tensor_buffer_info = tensor_info_iter->second;
-      if (tensor_buffer_info.attached) {
-        continue;
-      }
-
       // Look up buffer handle by tensor ID
       auto handle_iter = tensor_idx_to_handle_.find(tensor_idx);
       if (handle_iter == tensor_idx_to_handle_.end()) {
@@ -961,35 +1015,43 @@ DispatchDelegateKernel::AttachBuffersToInvocationContextsIfNeeded(
       }
 
       LiteRtTensorBufferHandle buffer_handle = handle_iter->second;
+      auto& attached = slot.attached_outputs[node_idx][i];
+      if (attached == buffer_handle) {
+        continue;
+      }
+      if (attached) {
+        LITERT_RETURN_IF_ERROR(
+            LiteRtDispatchDetachOutput(invocation_context, i, *attached));
+        registration_cache_.Release(*attached);
+        attached.reset();
+      }
       LITERT_RETURN_IF_ERROR(
           LiteRtDispatchAttachOutput(invocation_context, i, buffer_handle));
+      LITERT_RETURN_IF_ERROR(registration_cache_.Retain(buffer_handle));
+      attached = buffer_handle;
     }
   }
 
-  // Mark buffers as attached only at the end since a given buffer may be
-  // attached to multiple invocation context I/Os.
-  for (auto& item : tensor_buffer_infos_) {
-    item.second.attached = true;
-  }
-
   return {};
 }
 
 Expected<void> DispatchDelegateKernel::ScheduleAsyncExecution(
-    TfLiteOpaqueContext* context) {
+    TfLiteOpaqueContext* context, InvocationSlot& slot) {
   std::vector<LiteRtEvent> output_events;
 
   // Run NPU bytecodes asynchronously and in topological order.
   for (auto node_idx = 0; node_idx < nodes_.size(); ++node_idx) {
     auto* node = nodes_[node_idx];
-    auto invocation_context = node_invocation_contexts_[node_idx];
+    auto invocation_context = slot.node_invocation_contexts[node_idx];
 
     auto num_node_inputs = TfLiteOpaqueNodeNumberOfInputs(node);
     for (auto i = 0; i < num_node_inputs; ++i) {
       auto* tfl_tensor = const_cast<TfLiteOpaqueTensor*>(
           TfLiteOpaqueNodeGetInput(context, node, i));
       auto& tensor_buffer_info = tensor_buffer_infos_.find(tfl_tensor)->second;
-      if (tensor_buffer_info.tensor_buffer->HasEvent()) {
+      // Already signaled events are dropped instead of adding a dependency
+      // the driver would have to track.
+      if (tensor_buffer_info.tensor_buffer->HasPendingEvent()) {
         LITERT_ASSIGN_OR_RETURN(LiteRtEventT * event,
                                 tensor_buffer_info.tensor_buffer->GetEvent());
         LITERT_RETURN_IF_ERROR(
@@ -999,8 +1061,13 @@ Expected<void> DispatchDelegateKernel::ScheduleAsyncExecution(
 
     auto num_node_outputs = TfLiteOpaqueNodeNumberOfOutputs(node);
     output_events.resize(num_node_outputs);
-    LITERT_RETURN_IF_ERROR(LiteRtDispatchInvokeAsync(
-        invocation_context, output_events.size(), output_events.data()));
+    {
+      LITERT_PERFETTO_TRACE_EVENT_WITH_FLOW(
+          kDispatch, "LiteRT::Dispatch[async submit]",
+          litert::internal::GetPerfettoFlowId(invocation_context));
+      LITERT_RETURN_IF_ERROR(LiteRtDispatchInvokeAsync(
+          invocation_context, output_events.size(), output_events.data()));
+    }
 
     for (auto i = 0; i < num_node_outputs; ++i) {
       auto* tfl_tensor = TfLiteOpaqueNodeGetOutput(context, node, i);
@@ -1013,15 +1080,25 @@ Expected<void> DispatchDelegateKernel::ScheduleAsyncExecution(
 }
 
 Expected<void> DispatchDelegateKernel::ScheduleSyncExecution(
-    TfLiteOpaqueContext* context) {
+    TfLiteOpaqueContext* context, InvocationSlot& slot) {
+  // When the nodes can be chained on the device, only the kernel outputs are
+  // waited for. Tensors flowing between two nodes then stay on the device,
+  // without a CPU round trip after each node.
+  if (async_dispatch_ && nodes_.size() > 1) {
+    LITERT_RETURN_IF_ERROR(ScheduleAsyncExecution(context, slot));
+    return WaitForOutputEvents(context);
+  }
+
   // Deal with any events attached to inputs.
+  ScopedTransferProfile sync_profile(buffer_context_->GetProfiler(),
+                                     "LiteRT::Dispatch[input sync]");
   for (int tensor_id : input_tensor_ids_) {
     auto* tfl_tensor = TfLiteOpaqueContextGetOpaqueTensor(context, tensor_id);
     if (!tfl_tensor) {
       continue;
     }
     auto& tensor_buffer_info = tensor_buffer_infos_.find(tfl_tensor)->second;
-    if (tensor_buffer_info.tensor_buffer->HasEvent()) {
+    if (tensor_buffer_info.tensor_buffer->HasPendingEvent()) {
       LITERT_ASSIGN_OR_RETURN(LiteRtEventT * event,
                               tensor_buffer_info.tensor_buffer->GetEvent());
 
@@ -1035,7 +1112,8 @@ Expected<void> DispatchDelegateKernel::ScheduleSyncExecution(
         for (const auto& [node_idx, port_idx, is_input_port] :
              port_connections) {
           if (is_input_port) {
-            auto* invocation_context = node_invocation_contexts_[node_idx];
+            auto* invocation_context =
+                slot.node_invocation_contexts[node_idx];
             (void)LiteRtDispatchAttachInputEvent(invocation_context, port_idx,
                                                  event);
           }
@@ -1049,13 +1127,39 @@ Expected<void> DispatchDelegateKernel::ScheduleSyncExecution(
       }
     }
   }
+  sync_profile.End();
 
   // Run NPU bytecodes synchronously and in topological order.
-  for (auto* invocation_context : node_invocation_contexts_) {
+  for (auto* invocation_context : slot.node_invocation_contexts) {
+    LITERT_PERFETTO_TRACE_EVENT_WITH_FLOW(
+        kDispatch, "LiteRT::Dispatch[submit]",
+        litert::internal::GetPerfettoFlowId(invocation_context));
     LITERT_RETURN_IF_ERROR(LiteRtDispatchInvoke(invocation_context));
   }
 
   return {};
 }
 
+Expected<void> DispatchDelegateKernel::WaitForOutputEvents(
+    TfLiteOpaqueContext* context) {
+  for (int tensor_id : output_tensor_ids_) {
+    auto* tfl_tensor = TfLiteOpaqueContextGetOpaqueTensor(context, tensor_id);
+    if (!tfl_tensor) {
+      continue;
+    }
+    auto iter = tensor_buffer_infos_.find(tfl_tensor);
+    if (iter == tensor_buffer_infos_.end()) {
+      return Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                        "TensorInfo not found");
+    }
+    auto& tensor_buffer = iter->second.tensor_buffer;
+    if (tensor_buffer->HasEvent()) {
+      LITERT_ASSIGN_OR_RETURN(LiteRtEventT * event, tensor_buffer->GetEvent());
+      LITERT_RETURN_IF_ERROR(event->Wait(/*timeout_in_ms=*/-1));
+      tensor_buffer->ClearEvent();
+    }
+  }
+  return {};
+}
+
 }  // namespace litert::internal
@@ -17,6 +17,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -26,6 +27,8 @@
 #include "absl/container/node_hash_map.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/runtime/dispatch/dispatch_registration_cache.h"
 #include "litert/runtime/external_litert_buffer_context.h"
 #include "litert/runtime/metrics.h"
 #include "litert/vendors/c/litert_dispatch.h"
@@ -68,12 +71,25 @@ class DispatchDelegateKernel
   DispatchDelegateKernel(LiteRtEnvironmentOptions environment_options,
                          LiteRtOptions options, std::string&& graph_name,
                          LiteRtDispatchDeviceContext device_context,
-                         bool async_dispatch)
+                         bool async_dispatch, size_t num_invocation_slots)
       : environment_options_(environment_options),
         options_(options),
         graph_name_(std::move(graph_name)),
         device_context_(std::move(device_context)),
-        async_dispatch_(async_dispatch) {}
+        async_dispatch_(async_dispatch),
+        num_invocation_slots_(num_invocation_slots),
+        registration_cache_(
+            [this](LiteRtTensorBufferT* tensor_buffer)
+                -> Expected<LiteRtTensorBufferHandle> {
+              LiteRtTensorBufferHandle buffer_handle = 0;
+              LITERT_RETURN_IF_ERROR(LiteRtDispatchRegisterTensorBuffer(
+                  device_context_, tensor_buffer, &buffer_handle));
+              return buffer_handle;
+            },
+            [this](LiteRtTensorBufferHandle buffer_handle) {
+              (void)LiteRtDispatchUnregisterTensorBuffer(device_context_,
+                                                         buffer_handle);
+            }) {}
 
   static Expected<std::vector<TfLiteOpaqueNode*>> GetNodes(
       TfLiteOpaqueContext* context, const TfLiteOpaqueDelegateParams& params);
@@ -91,9 +107,28 @@ class DispatchDelegateKernel
   Expected<void> EvalHelper(TfLiteOpaqueContext* context,
                             TfLiteOpaqueNode* node);
 
+  // The invocation contexts of the nodes, and the buffers attached to them.
+  struct InvocationSlot {
+    std::vector<LiteRtDispatchInvocationContext> node_invocation_contexts;
+    // Buffer handles attached to the node inputs and outputs, indexed by node
+    // and by port.
+    std::vector<std::vector<std::optional<LiteRtTensorBufferHandle>>>
+        attached_inputs;
+    std::vector<std::vector<std::optional<LiteRtTensorBufferHandle>>>
+        attached_outputs;
+  };
+
   Expected<LiteRtDispatchInvocationContext> CreateNodeInvocationContext(
       TfLiteOpaqueContext* context, TfLiteOpaqueNode* node);
 
+  // Creates the invocation contexts of a new slot.
+  Expected<void> AddInvocationSlot(TfLiteOpaqueContext* context);
+
+  // Returns the slot the next asynchronous execution is scheduled on, creating
+  // it if needed.
+  Expected<InvocationSlot*> NextAsyncInvocationSlot(
+      TfLiteOpaqueContext* context);
+
   Expected<LiteRtTensorBufferRequirementsPtr> GetBufferRequirements(
       int node_idx, TfLiteOpaqueTensor* io_tfl_tensor, int io_tensor_index,
       bool is_input) const;
@@ -109,10 +144,15 @@ class DispatchDelegateKernel
       LiteRtTensorBufferPtr&& tensor_buffer);
 
   Expected<void> AttachBuffersToInvocationContextsIfNeeded(
-      TfLiteOpaqueContext* context);
+      TfLiteOpaqueContext* context, InvocationSlot& slot);
 
-  Expected<void> ScheduleAsyncExecution(TfLiteOpaqueContext* context);
-  Expected<void> ScheduleSyncExecution(TfLiteOpaqueContext* context);
+  Expected<void> ScheduleAsyncExecution(TfLiteOpaqueContext* context,
+                                        InvocationSlot& slot);
+  Expected<void> ScheduleSyncExecution(TfLiteOpaqueContext* context,
+                                       InvocationSlot& slot);
+  // Waits for the events attached to the kernel outputs by an asynchronous
+  // execution and drops them.
+  Expected<void> WaitForOutputEvents(TfLiteOpaqueContext* context);
 
   Expected<const void*> FindAllocBase() const;
   Expected<int> FindAllocBaseFd() const;
@@ -124,9 +164,21 @@ class DispatchDelegateKernel
   const bool async_dispatch_;  // Indicates whether the Dispatch API can be
                                // invoked asynchronously.
 
+  // Maximum number of invocation slots. Asynchronous executions rotate
+  // through them, so that the next execution can be scheduled while the
+  // previous ones are still running on the device. Synchronous executions
+  // always use the first slot.
+  size_t num_invocation_slots_;
+
   LiteRtExternalLiteRtBufferContextT* buffer_context_ = nullptr;
   std::vector<TfLiteOpaqueNode*> nodes_;
-  std::vector<LiteRtDispatchInvocationContext> node_invocation_contexts_;
+  // Invocation slots created so far. Storage is reserved for
+  // num_invocation_slots_ of them, so references stay valid.
+  std::vector<InvocationSlot> invocation_slots_;
+  size_t next_async_invocation_slot_ = 0;
+  // Detail level of the ongoing metrics collection, which is also started on
+  // the invocation slots created during the collection.
+  std::optional<int> metrics_detail_level_;
 
   // Store tensor IDs - get tensors on demand to avoid stale pointers
   std::vector<int> input_tensor_ids_;
@@ -140,7 +192,6 @@ class DispatchDelegateKernel
     LiteRtTensorBufferHandle buffer_handle;
     bool maybe_sync_with_cpu = false;
     size_t tensor_buffer_used_size = 0;
-    bool attached = false;
 
     TensorInfo() = default;
 
@@ -152,6 +203,10 @@ class DispatchDelegateKernel
 
   absl::node_hash_map<TfLiteOpaqueTensor*, TensorInfo> tensor_buffer_infos_;
 
+  // Registrations of the tensor buffers in tensor_buffer_infos_, and of the
+  // recently detached ones.
+  DispatchRegistrationCache registration_cache_;
+
   struct PortConnection {
     int node_idx;
     int port_idx;        // The index of the I/O node port.
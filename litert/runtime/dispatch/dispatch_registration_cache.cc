@@ -0,0 +1,153 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/dispatch/dispatch_registration_cache.h"
+
+#include <utility>
+
+#include "litert/c/internal/litert_logging.h"
+#include "litert/c/litert_common.h"
+#include "litert/c/litert_tensor_buffer_types.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/runtime/external_litert_buffer_context.h"
+#include "litert/runtime/tensor_buffer.h"
+#include "litert/vendors/c/litert_dispatch.h"
+
+namespace litert::internal {
+
+DispatchRegistrationCache::Key DispatchRegistrationCache::MakeKey(
+    LiteRtTensorBufferT* tensor_buffer) {
+  Key key = {tensor_buffer->buffer_type(), tensor_buffer, /*fd=*/-1,
+             tensor_buffer->buffer_offset(), tensor_buffer->buffer_size()};
+  switch (key.buffer_type) {
+    case kLiteRtTensorBufferTypeHostMemory:
+      if (auto host_memory = tensor_buffer->GetHostBuffer(); host_memory) {
+        key.memory = *host_memory;
+      }
+      break;
+    case kLiteRtTensorBufferTypeAhwb:
+      if (auto ahwb = tensor_buffer->GetAhwbBuffer(); ahwb) {
+        key.memory = *ahwb;
+      }
+      break;
+    case kLiteRtTensorBufferTypeIon:
+      if (auto ion = tensor_buffer->GetIonBuffer(); ion) {
+        key.memory = ion->first;
+        key.fd = ion->second;
+      }
+      break;
+    case kLiteRtTensorBufferTypeDmaBuf:
+      if (auto dma_buf = tensor_buffer->GetDmaBufBuffer(); dma_buf) {
+        key.memory = dma_buf->first;
+        key.fd = dma_buf->second;
+      }
+      break;
+    case kLiteRtTensorBufferTypeFastRpc:
+      if (auto fast_rpc = tensor_buffer->GetFastRpcBuffer(); fast_rpc) {
+        key.memory = fast_rpc->first;
+        key.fd = fast_rpc->second;
+      }
+      break;
+    default:
+      // Other memory objects are identified by the tensor buffer itself.
+      break;
+  }
+  return key;
+}
+
+Expected<LiteRtTensorBufferHandle> DispatchRegistrationCache::Acquire(
+    LiteRtTensorBufferT* tensor_buffer) {
+  if (!tensor_buffer) {
+    return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                      "Invalid tensor buffer");
+  }
+
+  Key key = MakeKey(tensor_buffer);
+  if (auto it = entries_by_key_.find(key); it != entries_by_key_.end()) {
+    EntryList::iterator entry = it->second;
+    if (entry->num_users++ == 0) {
+      --num_idle_;
+    }
+    entries_.splice(entries_.begin(), entries_, entry);
+    ++stats_.num_hits;
+    return entry->buffer_handle;
+  }
+
+  LITERT_ASSIGN_OR_RETURN(LiteRtTensorBufferHandle buffer_handle,
+                          register_fn_(tensor_buffer));
+  ++stats_.num_registrations;
+
+  tensor_buffer->Duplicate();
+  entries_.push_front(Entry{key, LiteRtTensorBufferPtr(tensor_buffer),
+                            buffer_handle, /*num_users=*/1});
+  entries_by_key_[key] = entries_.begin();
+  entries_by_handle_[buffer_handle] = entries_.begin();
+  return buffer_handle;
+}
+
+Expected<void> DispatchRegistrationCache::Retain(
+    LiteRtTensorBufferHandle buffer_handle) {
+  auto it = entries_by_handle_.find(buffer_handle);
+  if (it == entries_by_handle_.end()) {
+    return Unexpected(kLiteRtStatusErrorNotFound,
+                      "Buffer handle is not registered");
+  }
+  if (it->second->num_users++ == 0) {
+    --num_idle_;
+  }
+  return {};
+}
+
+void DispatchRegistrationCache::Release(
+    LiteRtTensorBufferHandle buffer_handle) {
+  auto it = entries_by_handle_.find(buffer_handle);
+  if (it == entries_by_handle_.end() || it->second->num_users == 0) {
+    LITERT_LOG(LITERT_WARNING, "Releasing an unused buffer handle %llu",
+               static_cast<unsigned long long>(buffer_handle));  // NOLINT
+    return;
+  }
+  if (--it->second->num_users == 0) {
+    ++num_idle_;
+    EvictIdle();
+  }
+}
+
+void DispatchRegistrationCache::Clear() {
+  for (auto& entry : entries_) {
+    unregister_fn_(entry.buffer_handle);
+  }
+  entries_.clear();
+  entries_by_key_.clear();
+  entries_by_handle_.clear();
+  num_idle_ = 0;
+}
+
+void DispatchRegistrationCache::EvictIdle() {
+  for (auto it = entries_.end();
+       num_idle_ > max_idle_registrations_ && it != entries_.begin();) {
+    --it;
+    if (it->num_users > 0) {
+      continue;
+    }
+    unregister_fn_(it->buffer_handle);
+    entries_by_key_.erase(it->key);
+    entries_by_handle_.erase(it->buffer_handle);
+    it = entries_.erase(it);
+    --num_idle_;
+    ++stats_.num_evictions;
+  }
+}
+
+}  // namespace litert::internal
@@ -0,0 +1,147 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_RUNTIME_DISPATCH_DISPATCH_REGISTRATION_CACHE_H_
+#define ODML_LITERT_LITERT_RUNTIME_DISPATCH_DISPATCH_REGISTRATION_CACHE_H_
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "litert/c/litert_tensor_buffer_types.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/runtime/external_litert_buffer_context.h"
+#include "litert/vendors/c/litert_dispatch.h"
+
+namespace litert::internal {
+
+// Keeps the tensor buffers registered with a Dispatch API device context
+// alive after they are detached, so that an application cycling through a
+// ring of I/O buffers only pays for the vendor registration the first time
+// each buffer is seen.
+//
+// Registrations are keyed by the memory backing the tensor buffer (AHWB,
+// dmabuf/ION/FastRPC fd, host address) rather than by the LiteRtTensorBuffer
+// object, so that re-wrapping the same memory in a new tensor buffer hits the
+// cache too. Each entry holds a reference to the tensor buffer it was
+// registered with, which keeps the backing memory alive while it is mapped.
+//
+// Registrations that are no longer attached to any tensor are evicted, least
+// recently used first, beyond `max_idle_registrations`.
+//
+// Note: This class is not thread safe.
+class DispatchRegistrationCache {
+ public:
+  using RegisterFn = std::function<Expected<LiteRtTensorBufferHandle>(
+      LiteRtTensorBufferT* tensor_buffer)>;
+  using UnregisterFn =
+      std::function<void(LiteRtTensorBufferHandle buffer_handle)>;
+
+  struct Stats {
+    // Number of acquisitions served by an existing registration.
+    size_t num_hits = 0;
+    // Number of registrations made with the device context.
+    size_t num_registrations = 0;
+    // Number of idle registrations dropped to stay under the limit.
+    size_t num_evictions = 0;
+  };
+
+  static constexpr size_t kDefaultMaxIdleRegistrations = 16;
+
+  DispatchRegistrationCache(
+      RegisterFn register_fn, UnregisterFn unregister_fn,
+      size_t max_idle_registrations = kDefaultMaxIdleRegistrations)
+      : register_fn_(std::move(register_fn)),
+        unregister_fn_(std::move(unregister_fn)),
+        max_idle_registrations_(max_idle_registrations) {}
+
+  DispatchRegistrationCache(const DispatchRegistrationCache&) = delete;
+  DispatchRegistrationCache& operator=(const DispatchRegistrationCache&) =
+      delete;
+
+  ~DispatchRegistrationCache() { Clear(); }
+
+  // Returns the handle of a registration of the memory backing
+  // `tensor_buffer`, registering it if needed. Each successful call must be
+  // balanced by a call to Release().
+  Expected<LiteRtTensorBufferHandle> Acquire(
+      LiteRtTensorBufferT* tensor_buffer);
+
+  // Adds a use of the registration behind `buffer_handle`, which must have been
+  // acquired and not evicted. Each successful call must be balanced by a call
+  // to Release().
+  Expected<void> Retain(LiteRtTensorBufferHandle buffer_handle);
+
+  // Marks one use of `buffer_handle` as done. The registration is kept until
+  // it gets evicted.
+  void Release(LiteRtTensorBufferHandle buffer_handle);
+
+  // Unregisters all the buffers, including the ones that are still in use.
+  void Clear();
+
+  size_t NumRegistrations() const { return entries_.size(); }
+
+  const Stats& GetStats() const { return stats_; }
+
+ private:
+  struct Key {
+    LiteRtTensorBufferType buffer_type;
+    const void* memory;
+    int fd;
+    size_t offset;
+    size_t size;
+
+    bool operator==(const Key& other) const {
+      return buffer_type == other.buffer_type && memory == other.memory &&
+             fd == other.fd && offset == other.offset && size == other.size;
+    }
+
+    template <typename H>
+    friend H AbslHashValue(H h, const Key& key) {
+      return H::combine(std::move(h), key.buffer_type, key.memory, key.fd,
+                        key.offset, key.size);
+    }
+  };
+
+  struct Entry {
+    Key key;
+    LiteRtTensorBufferPtr tensor_buffer;
+    LiteRtTensorBufferHandle buffer_handle;
+    int num_users = 0;
+  };
+  using EntryList = std::list<Entry>;
+
+  static Key MakeKey(LiteRtTensorBufferT* tensor_buffer);
+
+  // Unregisters the least recently used idle entries until at most
+  // `max_idle_registrations_` are left.
+  void EvictIdle();
+
+  RegisterFn register_fn_;
+  UnregisterFn unregister_fn_;
+  const size_t max_idle_registrations_;
+  size_t num_idle_ = 0;
+  // Registrations, the most recently used first.
+  EntryList entries_;
+  absl::flat_hash_map<Key, EntryList::iterator> entries_by_key_;
+  absl::flat_hash_map<LiteRtTensorBufferHandle, EntryList::iterator>
+      entries_by_handle_;
+  Stats stats_;
+};
+
+}  // namespace litert::internal
+
+#endif  // ODML_LITERT_LITERT_RUNTIME_DISPATCH_DISPATCH_REGISTRATION_CACHE_H_
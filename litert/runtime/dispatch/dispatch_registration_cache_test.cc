@@ -0,0 +1,188 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/dispatch/dispatch_registration_cache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "litert/c/litert_common.h"
+#include "litert/c/litert_environment.h"
+#include "litert/c/litert_tensor_buffer.h"
+#include "litert/c/litert_tensor_buffer_types.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_layout.h"
+#include "litert/test/matchers.h"
+#include "litert/vendors/c/litert_dispatch.h"
+
+namespace litert::internal {
+namespace {
+
+constexpr const int32_t kTensorDimensions[] = {4};
+constexpr size_t kBufferSize = 4 * sizeof(float);
+
+constexpr const LiteRtRankedTensorType kTensorType = {
+    /*.element_type=*/kLiteRtElementTypeFloat32,
+    ::litert::BuildLayout(kTensorDimensions)};
+
+// Records the calls made to the device context.
+struct FakeDeviceContext {
+  LiteRtTensorBufferHandle next_handle = 1;
+  std::vector<LiteRtTensorBufferHandle> unregistered;
+
+  DispatchRegistrationCache::RegisterFn RegisterFn() {
+    return [this](LiteRtTensorBufferT*) -> Expected<LiteRtTensorBufferHandle> {
+      return next_handle++;
+    };
+  }
+
+  DispatchRegistrationCache::UnregisterFn UnregisterFn() {
+    return [this](LiteRtTensorBufferHandle buffer_handle) {
+      unregistered.push_back(buffer_handle);
+    };
+  }
+};
+
+class DispatchRegistrationCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    LITERT_ASSERT_OK(
+        LiteRtCreateEnvironment(/*num_options=*/0, /*options=*/nullptr, &env_));
+  }
+
+  void TearDown() override {
+    for (auto buffer : buffers_) {
+      LiteRtDestroyTensorBuffer(buffer);
+    }
+    LiteRtDestroyEnvironment(env_);
+  }
+
+  LiteRtTensorBuffer CreateBuffer() {
+    LiteRtTensorBuffer buffer = nullptr;
+    EXPECT_EQ(LiteRtCreateManagedTensorBuffer(
+                  env_, kLiteRtTensorBufferTypeHostMemory, &kTensorType,
+                  kBufferSize, &buffer),
+              kLiteRtStatusOk);
+    buffers_.push_back(buffer);
+    return buffer;
+  }
+
+  LiteRtEnvironment env_ = nullptr;
+  std::vector<LiteRtTensorBuffer> buffers_;
+};
+
+TEST_F(DispatchRegistrationCacheTest, ReusesRegistrationsOfARing) {
+  FakeDeviceContext device_context;
+  DispatchRegistrationCache cache(device_context.RegisterFn(),
+                                  device_context.UnregisterFn());
+
+  LiteRtTensorBuffer ring[3] = {CreateBuffer(), CreateBuffer(),
+                                CreateBuffer()};
+  std::vector<LiteRtTensorBufferHandle> first_handles;
+  for (int round = 0; round < 4; ++round) {
+    for (int i = 0; i < 3; ++i) {
+      LITERT_ASSERT_OK_AND_ASSIGN(LiteRtTensorBufferHandle handle,
+                                  cache.Acquire(ring[i]));
+      if (round == 0) {
+        first_handles.push_back(handle);
+      } else {
+        EXPECT_EQ(handle, first_handles[i]);
+      }
+      cache.Release(handle);
+    }
+  }
+
+  const auto& stats = cache.GetStats();
+  EXPECT_EQ(stats.num_registrations, 3);
+  EXPECT_EQ(stats.num_hits, 9);
+  EXPECT_EQ(stats.num_evictions, 0);
+  EXPECT_TRUE(device_context.unregistered.empty());
+
+  cache.Clear();
+  EXPECT_EQ(device_context.unregistered.size(), 3);
+  EXPECT_EQ(cache.NumRegistrations(), 0);
+}
+
+TEST_F(DispatchRegistrationCacheTest, KeysByBackingMemory) {
+  FakeDeviceContext device_context;
+  DispatchRegistrationCache cache(device_context.RegisterFn(),
+                                  device_context.UnregisterFn());
+
+  LiteRtTensorBuffer buffer = CreateBuffer();
+  void* host_memory = nullptr;
+  LITERT_ASSERT_OK(LiteRtGetTensorBufferHostMemory(buffer, &host_memory));
+  // A second tensor buffer wrapping the same memory.
+  LiteRtTensorBuffer alias = nullptr;
+  LITERT_ASSERT_OK(LiteRtCreateTensorBufferFromHostMemory(
+      &kTensorType, host_memory, kBufferSize, /*deallocator=*/nullptr, &alias));
+  buffers_.push_back(alias);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtTensorBufferHandle handle,
+                              cache.Acquire(buffer));
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtTensorBufferHandle alias_handle,
+                              cache.Acquire(alias));
+  EXPECT_EQ(handle, alias_handle);
+  EXPECT_EQ(cache.NumRegistrations(), 1);
+}
+
+TEST_F(DispatchRegistrationCacheTest, EvictsLeastRecentlyUsedIdleEntries) {
+  FakeDeviceContext device_context;
+  DispatchRegistrationCache cache(device_context.RegisterFn(),
+                                  device_context.UnregisterFn(),
+                                  /*max_idle_registrations=*/1);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtTensorBufferHandle in_use,
+                              cache.Acquire(CreateBuffer()));
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtTensorBufferHandle first,
+                              cache.Acquire(CreateBuffer()));
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtTensorBufferHandle second,
+                              cache.Acquire(CreateBuffer()));
+  cache.Release(first);
+  EXPECT_TRUE(device_context.unregistered.empty());
+
+  // Two idle entries: the least recently used one is dropped, while the
+  // registration in use is kept even though it is the oldest.
+  cache.Release(second);
+  ASSERT_EQ(device_context.unregistered.size(), 1);
+  EXPECT_EQ(device_context.unregistered[0], first);
+  EXPECT_EQ(cache.NumRegistrations(), 2);
+  EXPECT_EQ(cache.GetStats().num_evictions, 1);
+
+  cache.Release(in_use);
+  ASSERT_EQ(device_context.unregistered.size(), 2);
+  EXPECT_EQ(device_context.unregistered[1], in_use);
+}
+
+TEST_F(DispatchRegistrationCacheTest, RetainedRegistrationsAreNotEvicted) {
+  FakeDeviceContext device_context;
+  DispatchRegistrationCache cache(device_context.RegisterFn(),
+                                  device_context.UnregisterFn(),
+                                  /*max_idle_registrations=*/0);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(LiteRtTensorBufferHandle handle,
+                              cache.Acquire(CreateBuffer()));
+  LITERT_ASSERT_OK(cache.Retain(handle));
+  cache.Release(handle);
+  EXPECT_TRUE(device_context.unregistered.empty());
+
+  cache.Release(handle);
+  ASSERT_EQ(device_context.unregistered.size(), 1);
+  EXPECT_EQ(device_context.unregistered[0], handle);
+  EXPECT_FALSE(cache.Retain(handle));
+}
+
+}  // namespace
+}  // namespace litert::internal
@@ -34,16 +34,16 @@
 #include "litert/core/version.h"
 #include "litert/vendors/c/litert_dispatch_api.h"
 
-#define INVOKE_FUNC(function, ...)                                \
-  if (!TheApi.interface) {                                        \
-    LITERT_LOG(LITERT_ERROR, "Dispatch API interface not found"); \
-    return kLiteRtStatusErrorRuntimeFailure;                      \
-  }                                                               \
-  if (!TheApi.interface->function) {                              \
-    LITERT_LOG(LITERT_ERROR, #function " not found");             \
-    return kLiteRtStatusErrorRuntimeFailure;                      \
-  }                                                               \
-  LITERT_PERFETTO_TRACE_EVENT("Dispatch API " #function);         \
+#define INVOKE_FUNC(function, ...)                                      \
+  if (!TheApi.interface) {                                              \
+    LITERT_LOG(LITERT_ERROR, "Dispatch API interface not found");       \
+    return kLiteRtStatusErrorRuntimeFailure;                            \
+  }                                                                     \
+  if (!TheApi.interface->function) {                                    \
+    LITERT_LOG(LITERT_ERROR, #function " not found");                   \
+    return kLiteRtStatusErrorRuntimeFailure;                            \
+  }                                                                     \
+  LITERT_PERFETTO_TRACE_EVENT_IN(kDispatch, "Dispatch API " #function); \
   return TheApi.interface->function(__VA_ARGS__);
 
 #define INVOKE_ASYNC_FUNC(function, ...)                                \
@@ -55,6 +55,7 @@
     LITERT_LOG(LITERT_ERROR, #function " not found");                   \
     return kLiteRtStatusErrorRuntimeFailure;                            \
   }                                                                     \
+  LITERT_PERFETTO_TRACE_EVENT_IN(kDispatch, "Dispatch API " #function); \
   return TheApi.async_interface->function(__VA_ARGS__);
 
 #define INVOKE_GRAPH_FUNC(function, ...)                                \
@@ -68,6 +69,18 @@
   }                                                                     \
   return TheApi.graph_interface->function(__VA_ARGS__);
 
+#define INVOKE_BATCH_FUNC(function, ...)                                \
+  if (!TheApi.batch_interface) {                                        \
+    LITERT_LOG(LITERT_ERROR, "Dispatch API batch interface not found"); \
+    return kLiteRtStatusErrorUnsupported;                               \
+  }                                                                     \
+  if (!TheApi.batch_interface->function) {                              \
+    LITERT_LOG(LITERT_ERROR, #function " not found");                   \
+    return kLiteRtStatusErrorUnsupported;                               \
+  }                                                                     \
+  LITERT_PERFETTO_TRACE_EVENT_IN(kDispatch, "Dispatch API " #function); \
+  return TheApi.batch_interface->function(__VA_ARGS__);
+
 namespace {
 
 litert::SharedLibrary* DispatchSharedLibrary = nullptr;
@@ -77,6 +90,7 @@ LiteRtDispatchApi TheApi = {
     /*.interface=*/nullptr,
     /*.async_interface=*/nullptr,
     /*.graph_interface=*/nullptr,
+    /*.batch_interface=*/nullptr,
 };
 
 LiteRtStatus Initialize(LiteRtEnvironmentOptions environment_options,
@@ -412,6 +426,26 @@ LiteRtStatus LiteRtDispatchInvokeAsync(
                     output_events);
 }
 
+// /////////////////////////////////////////////////////////////////////////////
+// Batched Execution API
+// /////////////////////////////////////////////////////////////////////////////
+
+LiteRtStatus LiteRtDispatchInvokeBatch(
+    LiteRtDispatchInvocationContext invocation_context, int num_invocations,
+    const LiteRtDispatchInvocationBuffers* invocations,
+    LiteRtEvent* completion_event) {
+  if (!invocation_context || (num_invocations > 0 && !invocations)) {
+    LITERT_LOG(LITERT_ERROR, "Null input");
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  if (num_invocations < 0) {
+    LITERT_LOG(LITERT_ERROR, "Invalid number of invocations");
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  INVOKE_BATCH_FUNC(invoke_batch, invocation_context, num_invocations,
+                    invocations, completion_event);
+}
+
 // /////////////////////////////////////////////////////////////////////////////
 // Graph Execution API
 // /////////////////////////////////////////////////////////////////////////////
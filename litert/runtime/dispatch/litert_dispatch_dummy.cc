@@ -156,6 +156,13 @@ LiteRtStatus LiteRtDispatchInvokeAsync(
   return kLiteRtStatusErrorUnsupported;
 }
 
+LiteRtStatus LiteRtDispatchInvokeBatch(
+    LiteRtDispatchInvocationContext invocation_context, int num_invocations,
+    const LiteRtDispatchInvocationBuffers* invocations,
+    LiteRtEvent* completion_event) {
+  return kLiteRtStatusErrorUnsupported;
+}
+
 LiteRtStatus LiteRtDispatchGraphCreate(
     LiteRtDispatchDeviceContext device_context, LiteRtDispatchGraph* graph) {
   return kLiteRtStatusErrorUnsupported;
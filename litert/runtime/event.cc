@@ -18,8 +18,10 @@
 
 #include <cerrno>
 #include <cstdint>
+#include <memory>
 
 #include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/time/time.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_event_type.h"
 #include "litert/c/litert_gl_types.h"
@@ -42,6 +44,22 @@ using litert::Error;
 using litert::Expected;
 
 Expected<void> LiteRtEventT::Wait(int64_t timeout_in_ms) {
+  if (type == LiteRtEventTypeHost) {
+    LITERT_RETURN_IF_ERROR(host_state != nullptr,
+                           Error(kLiteRtStatusErrorRuntimeFailure,
+                                 "Host event has no state"));
+    if (timeout_in_ms < 0) {
+      host_state->notification.WaitForNotification();
+    } else if (!host_state->notification.WaitForNotificationWithTimeout(
+                   absl::Milliseconds(timeout_in_ms))) {
+      return Error(kLiteRtStatusErrorTimeoutExpired, "Timeout expired");
+    }
+    if (host_state->status != kLiteRtStatusOk) {
+      return Error(host_state->status,
+                   "The operation signaling the host event failed");
+    }
+    return {};
+  }
   if (type == LiteRtEventTypeSyncFenceFd) {
 #if LITERT_HAS_SYNC_FENCE_SUPPORT
     pollfd fds = {
@@ -157,7 +175,20 @@ Expected<int> LiteRtEventT::GetSyncFenceFd() {
 #endif
 }
 
-Expected<void> LiteRtEventT::Signal() {
+Expected<void> LiteRtEventT::Signal(LiteRtStatus status) {
+  if (type == LiteRtEventTypeHost) {
+    LITERT_RETURN_IF_ERROR(host_state != nullptr,
+                           Error(kLiteRtStatusErrorRuntimeFailure,
+                                 "Host event has no state"));
+    LITERT_RETURN_IF_ERROR(!host_state->notification.HasBeenNotified(),
+                           Error(kLiteRtStatusErrorRuntimeFailure,
+                                 "Host event is already signaled"));
+    host_state->Signal(status);
+    return {};
+  }
+  LITERT_RETURN_IF_ERROR(status == kLiteRtStatusOk,
+                         Error(kLiteRtStatusErrorInvalidArgument,
+                               "Only host events can be signaled as failed"));
 #if LITERT_HAS_OPENCL_SUPPORT
   if (type == LiteRtEventTypeOpenCl) {
     cl_int res =
@@ -175,6 +206,13 @@ Expected<void> LiteRtEventT::Signal() {
 
 Expected<LiteRtEventT*> LiteRtEventT::CreateManaged(LiteRtEnvironment env,
                                                     LiteRtEventType type) {
+  if (type == LiteRtEventTypeHost) {
+    return new LiteRtEventT{
+        .env = env,
+        .type = LiteRtEventTypeHost,
+        .host_state = std::make_shared<litert::internal::HostEventState>(),
+    };
+  }
   if (type == LiteRtEventTypeOpenCl) {
 #if LITERT_HAS_OPENCL_SUPPORT
     LITERT_ASSIGN_OR_RETURN(auto gpu_env, env->GetGpuEnvironment());
@@ -267,6 +305,60 @@ Expected<LiteRtEventT*> LiteRtEventT::CreateManaged(LiteRtEnvironment env,
 }
 
 Expected<bool> LiteRtEventT::IsSignaled() const {
+  if (type == LiteRtEventTypeHost) {
+    LITERT_RETURN_IF_ERROR(host_state != nullptr,
+                           Error(kLiteRtStatusErrorRuntimeFailure,
+                                 "Host event has no state"));
+    return host_state->notification.HasBeenNotified();
+  }
+  if (type == LiteRtEventTypeOpenCl) {
+#if LITERT_HAS_OPENCL_SUPPORT
+    cl_int status;
+    cl_int res = tflite::gpu::cl::clGetEventInfo(
+        opencl_event, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(status),
+        &status, /*param_value_size_ret=*/nullptr);
+    if (res != CL_SUCCESS) {
+      return Error(
+          kLiteRtStatusErrorRuntimeFailure,
+          absl::StrFormat("clGetEventInfo fails with error code %d", res));
+    }
+    // A negative status means the command was abnormally terminated.
+    LITERT_RETURN_IF_ERROR(status >= 0,
+                           Error(kLiteRtStatusErrorRuntimeFailure,
+                                 "The command signaling the event failed"));
+    return status == CL_COMPLETE;
+#else
+    return Error(kLiteRtStatusErrorUnsupported,
+                 "LiteRT does not have OpenCL support enabled.");
+#endif  // LITERT_HAS_OPENCL_SUPPORT
+  }
+  if (type == LiteRtEventTypeEglSyncFence ||
+      type == LiteRtEventTypeEglNativeSyncFence) {
+#if LITERT_HAS_OPENGL_SUPPORT
+    LITERT_ASSIGN_OR_RETURN(auto gpu_env, env->GetGpuEnvironment());
+    EGLDisplay display = gpu_env->GetEglDisplay();
+    LITERT_RETURN_IF_ERROR(display != EGL_NO_DISPLAY,
+                           Error(kLiteRtStatusErrorRuntimeFailure,
+                                 "EGL display is EGL_NO_DISPLAY"));
+    static auto* egl_get_sync_attrib_khr =
+        reinterpret_cast<decltype(&eglGetSyncAttribKHR)>(
+            eglGetProcAddress("eglGetSyncAttribKHR"));
+    LITERT_RETURN_IF_ERROR(
+        egl_get_sync_attrib_khr != nullptr,
+        Error(kLiteRtStatusErrorRuntimeFailure,
+              "Failed to load EGL function: eglGetSyncAttribKHR"));
+    EGLint status;
+    LITERT_RETURN_IF_ERROR(
+        egl_get_sync_attrib_khr(display, egl_sync, EGL_SYNC_STATUS_KHR,
+                                &status) == EGL_TRUE,
+        Error(kLiteRtStatusErrorRuntimeFailure,
+              "eglGetSyncAttribKHR failed"));
+    return status == EGL_SIGNALED_KHR;
+#else
+    return Error(kLiteRtStatusErrorUnsupported,
+                 "LiteRT does not have OpenGL support enabled.");
+#endif  // LITERT_HAS_OPENGL_SUPPORT
+  }
   if (type != LiteRtEventTypeSyncFenceFd) {
     return Error(kLiteRtStatusErrorInvalidArgument,
                  "IsSignaled is not supported for this event type");
@@ -16,7 +16,9 @@
 #define ODML_LITERT_LITERT_RUNTIME_EVENT_H_
 
 #include <cstdint>
+#include <memory>
 
+#include "absl/synchronization/notification.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_event_type.h"
 #include "litert/c/litert_gl_types.h"
@@ -28,6 +30,26 @@ typedef struct _cl_event* cl_event;
 }
 #endif  // LITERT_HAS_OPENCL_SUPPORT
 
+namespace litert::internal {
+
+// The state behind LiteRtEventTypeHost events. It is shared by all the events
+// signaled by the same host operation, e.g. the outputs of an asynchronous CPU
+// execution.
+struct HostEventState {
+  absl::Notification notification;
+  // The status of the host operation. Only valid once `notification` has been
+  // notified.
+  LiteRtStatus status = kLiteRtStatusOk;
+
+  // Records `op_status` and wakes up all the waiters.
+  void Signal(LiteRtStatus op_status) {
+    status = op_status;
+    notification.Notify();
+  }
+};
+
+}  // namespace litert::internal
+
 struct LiteRtEventT {
   LiteRtEnvironment env;
   LiteRtEventType type = LiteRtEventTypeUnknown;
@@ -41,10 +63,14 @@ struct LiteRtEventT {
 #if LITERT_HAS_OPENGL_SUPPORT
   EGLSyncKHR egl_sync;
 #endif  // LITERT_HAS_OPENGL_SUPPORT
+  // Only set for LiteRtEventTypeHost.
+  std::shared_ptr<litert::internal::HostEventState> host_state;
   ~LiteRtEventT();
   litert::Expected<void> Wait(int64_t timeout_in_ms);
   litert::Expected<int> GetSyncFenceFd();
-  litert::Expected<void> Signal();
+  // Signals the event. A host event also records `status`, which waiting on
+  // it then returns; other events can only be signaled as successful.
+  litert::Expected<void> Signal(LiteRtStatus status = kLiteRtStatusOk);
   litert::Expected<bool> IsSignaled() const;
   litert::Expected<int> DupFd() const;
   static litert::Expected<LiteRtEventT*> CreateManaged(LiteRtEnvironment env,
@@ -69,7 +69,11 @@ LiteRtExternalLiteRtBufferContextT::GetBufferRequirements(
 LiteRtStatus LiteRtExternalLiteRtBufferContextT::RegisterTensorBuffer(
     const TfLiteOpaqueTensor* tensor, LiteRtTensorBufferPtr tensor_buffer) {
   TfLiteTensorIdentifier tensor_id = get_tensor_identifier_fn_(tensor);
-  tensor_buffers_[tensor_id] = std::move(tensor_buffer);
+  LiteRtTensorBufferPtr& registered_buffer = tensor_buffers_[tensor_id];
+  if (registered_buffer.get() != tensor_buffer.get()) {
+    ++binding_generation_;
+  }
+  registered_buffer = std::move(tensor_buffer);
   return kLiteRtStatusOk;
 }
 
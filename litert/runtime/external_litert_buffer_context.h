@@ -16,6 +16,7 @@
 #define ODML_LITERT_LITERT_RUNTIME_EXTERNAL_LITERT_BUFFER_CONTEXT_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -30,6 +31,7 @@
 #include "tflite/c/c_api_opaque.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/c/common.h"
+#include "tflite/core/api/profiler.h"
 
 struct LiteRtTensorBufferRequirementsDeleter {
   void operator()(LiteRtTensorBufferRequirementsT* requirements) const {
@@ -128,6 +130,13 @@ class LiteRtExternalLiteRtBufferContextT : public TfLiteExternalContext {
   litert::Expected<LiteRtTensorBufferPtr> GetTensorBuffer(
       const TfLiteOpaqueTensor* tensor);
 
+  // Returns a counter that changes whenever a tensor is registered with a
+  // different tensor buffer than before. Registering the same buffers again
+  // on every run keeps it unchanged, so DelegateKernels can cache per bound
+  // buffer set what they build from the buffers (e.g. WebGPU bind groups and
+  // recorded command buffers) and rebuild only when it changes.
+  inline uint64_t GetBindingGeneration() const { return binding_generation_; }
+
   // Gets a registered tensor buffer for the given tensor.
   // The returned TensorBuffer object is a duplicate (reference counted)
   // of registered TensorBuffer.
@@ -159,6 +168,11 @@ class LiteRtExternalLiteRtBufferContextT : public TfLiteExternalContext {
   // Returns the LiteRtEnvironment used to create CompiledModel.
   inline LiteRtEnvironment GetEnvironment() const { return env_; }
 
+  // Profiler of the compiled model, or null. Lets the delegate kernels record
+  // the transfers at the boundaries of their partitions.
+  inline void SetProfiler(tflite::Profiler* profiler) { profiler_ = profiler; }
+  inline tflite::Profiler* GetProfiler() const { return profiler_; }
+
   // Sets dispatch annotations that should be propagated to dispatch graphs.
   void SetDispatchAnnotations(
       const std::unordered_map<std::string, std::string>& annotations) {
@@ -216,6 +230,7 @@ class LiteRtExternalLiteRtBufferContextT : public TfLiteExternalContext {
 
  private:
   LiteRtEnvironment env_;
+  tflite::Profiler* profiler_ = nullptr;
   GetTensorIdentifierFn get_tensor_identifier_fn_;
   std::unordered_map<litert::internal::TfLiteTensorIdentifier,
                      LiteRtTensorBufferRequirementsPtr,
@@ -227,6 +242,7 @@ class LiteRtExternalLiteRtBufferContextT : public TfLiteExternalContext {
                      litert::internal::TensorIdentifierHash,
                      litert::internal::TensorIdentifierEqual>
       tensor_buffers_;
+  uint64_t binding_generation_ = 0;
 
   LiteRtExternalLiteRtBufferContextT(
       const LiteRtExternalLiteRtBufferContextT&) = delete;
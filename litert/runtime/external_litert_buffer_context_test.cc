@@ -0,0 +1,94 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/external_litert_buffer_context.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+#include "litert/c/litert_common.h"
+#include "litert/c/litert_environment.h"
+#include "litert/c/litert_model_types.h"
+#include "litert/c/litert_tensor_buffer.h"
+#include "litert/c/litert_tensor_buffer_types.h"
+#include "litert/cc/litert_layout.h"
+#include "litert/runtime/tensor_identifier.h"
+#include "litert/test/matchers.h"
+#include "tflite/c/common.h"
+
+namespace {
+
+using ::litert::internal::TfLiteTensorIdentifier;
+
+constexpr const int32_t kTensorDimensions[] = {4};
+constexpr size_t kBufferSize = 4 * sizeof(float);
+
+constexpr const LiteRtRankedTensorType kTensorType = {
+    /*.element_type=*/kLiteRtElementTypeFloat32,
+    ::litert::BuildLayout(kTensorDimensions)};
+
+LiteRtTensorBufferPtr CreateBuffer(LiteRtEnvironment env) {
+  LiteRtTensorBuffer buffer = nullptr;
+  EXPECT_EQ(LiteRtCreateManagedTensorBuffer(env,
+                                            kLiteRtTensorBufferTypeHostMemory,
+                                            &kTensorType, kBufferSize, &buffer),
+            kLiteRtStatusOk);
+  return LiteRtTensorBufferPtr(buffer);
+}
+
+LiteRtTensorBufferPtr Duplicate(const LiteRtTensorBufferPtr& buffer) {
+  EXPECT_EQ(LiteRtDuplicateTensorBuffer(buffer.get()), kLiteRtStatusOk);
+  return LiteRtTensorBufferPtr(buffer.get());
+}
+
+TEST(ExternalLiteRtBufferContextTest, BindingGenerationTracksBufferChanges) {
+  LiteRtEnvironment env;
+  LITERT_ASSERT_OK(
+      LiteRtCreateEnvironment(/*num_options=*/0, /*options=*/nullptr, &env));
+  {
+    TfLiteTensor tensors[2] = {};
+    const auto* tensor0 =
+        reinterpret_cast<const TfLiteOpaqueTensor*>(&tensors[0]);
+    const auto* tensor1 =
+        reinterpret_cast<const TfLiteOpaqueTensor*>(&tensors[1]);
+    LiteRtExternalLiteRtBufferContextT context(
+        env, [&](const TfLiteOpaqueTensor* tensor) {
+          return TfLiteTensorIdentifier{0, tensor == tensor0 ? 0 : 1};
+        });
+    LiteRtTensorBufferPtr buffer0 = CreateBuffer(env);
+    LiteRtTensorBufferPtr buffer1 = CreateBuffer(env);
+
+    LITERT_ASSERT_OK(
+        context.RegisterTensorBuffer(tensor0, Duplicate(buffer0)));
+    LITERT_ASSERT_OK(
+        context.RegisterTensorBuffer(tensor1, Duplicate(buffer1)));
+    const uint64_t generation = context.GetBindingGeneration();
+
+    // Registering the same buffers again, as every run does, keeps the
+    // bindings.
+    LITERT_ASSERT_OK(
+        context.RegisterTensorBuffer(tensor0, Duplicate(buffer0)));
+    LITERT_ASSERT_OK(
+        context.RegisterTensorBuffer(tensor1, Duplicate(buffer1)));
+    EXPECT_EQ(context.GetBindingGeneration(), generation);
+
+    LITERT_ASSERT_OK(
+        context.RegisterTensorBuffer(tensor0, Duplicate(buffer1)));
+    EXPECT_NE(context.GetBindingGeneration(), generation);
+  }
+  LiteRtDestroyEnvironment(env);
+}
+
+}  // namespace
@@ -16,6 +16,7 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <utility>
@@ -152,12 +153,14 @@ GlBuffer::GlBuffer(GlBuffer&& other) {
   size_bytes_ = other.size_bytes_;
 #if LITERT_HAS_AHWB_SUPPORT
   ahwb_ = other.ahwb_;
+  owns_ahwb_ = other.owns_ahwb_;
 #endif  // LITERT_HAS_AHWB_SUPPORT
   // Reset the other GlBuffer to a default state.
   other.data_ = nullptr;
   other.size_bytes_ = 0;
 #if LITERT_HAS_AHWB_SUPPORT
   other.ahwb_ = nullptr;
+  other.owns_ahwb_ = false;
 #endif  // LITERT_HAS_AHWB_SUPPORT
 #else
   LITERT_LOG(LITERT_ERROR, "GlBuffer::GlBuffer() is not supported");
@@ -172,6 +175,12 @@ GlBuffer::~GlBuffer() {
   if (data_ != nullptr) {
     litert_aligned_free(data_);
   }
+#if LITERT_HAS_AHWB_SUPPORT
+  // The GL buffer holds its own reference to the AHardwareBuffer.
+  if (owns_ahwb_ && ahwb_ != nullptr) {
+    AhwbBuffer::Free(ahwb_);
+  }
+#endif  // LITERT_HAS_AHWB_SUPPORT
 #else
   LITERT_LOG(LITERT_ERROR, "GlBuffer::~GlBuffer() is not supported");
 #endif  // LITERT_HAS_OPENGL_SUPPORT
@@ -215,6 +224,22 @@ Expected<GlBuffer> GlBuffer::Alloc(GpuEnvironment* gpu_env, size_t size_bytes) {
   LITERT_RETURN_IF_ERROR(gpu_env->GetEglDisplay() != EGL_NO_DISPLAY,
                          litert::Unexpected(kLiteRtStatusErrorRuntimeFailure,
                                             "Failed to get EGL display"));
+#if LITERT_HAS_AHWB_SUPPORT
+  if (AhwbBuffer::IsSupported() && IsAhwbToGlBufferInteropSupported()) {
+    if (auto ahwb_buffer = AhwbBuffer::Alloc(size_bytes); ahwb_buffer) {
+      if (auto gl_buffer = AllocFromAhwbBuffer(gpu_env, *ahwb_buffer);
+          gl_buffer) {
+        gl_buffer->owns_ahwb_ = true;
+        return std::move(*gl_buffer);
+      } else {
+        LITERT_LOG(LITERT_WARNING,
+                   "Failed to back the GL buffer with an AHardwareBuffer: %s",
+                   gl_buffer.Error().Message().c_str());
+      }
+      AhwbBuffer::Free(ahwb_buffer->ahwb);
+    }
+  }
+#endif  // LITERT_HAS_AHWB_SUPPORT
   tflite::gpu::gl::GlBuffer tflite_gl_buffer;
 
   if (!tflite::gpu::gl::CreateReadWriteShaderStorageBuffer<std::byte>(
@@ -231,17 +256,24 @@ Expected<GlBuffer> GlBuffer::Alloc(GpuEnvironment* gpu_env, size_t size_bytes) {
 #endif  // LITERT_HAS_OPENGL_SUPPORT
 }
 
-template Expected<float*> GlBuffer::Lock<float>();
-template Expected<char*> GlBuffer::Lock<char>();
-template Expected<void> GlBuffer::Unlock<float>();
-template Expected<void> GlBuffer::Unlock<char>();
+template Expected<float*> GlBuffer::Lock<float>(bool gl_work_synced);
+template Expected<char*> GlBuffer::Lock<char>(bool gl_work_synced);
+template Expected<void> GlBuffer::Unlock<float>(size_t dirty_offset,
+                                                size_t dirty_size);
+template Expected<void> GlBuffer::Unlock<char>(size_t dirty_offset,
+                                               size_t dirty_size);
 
 template <typename T>
-Expected<T*> GlBuffer::Lock() {
+Expected<T*> GlBuffer::Lock(bool gl_work_synced) {
 #if LITERT_HAS_OPENGL_SUPPORT
   absl::MutexLock lock(&mutex_);
 #if LITERT_HAS_AHWB_SUPPORT
   if (ahwb_ != nullptr) {
+    if (owns_ahwb_ && !gl_work_synced) {
+      // Unlike reading the buffer through a GL mapping, locking the
+      // AHardwareBuffer doesn't wait for the pending GL commands.
+      glFinish();
+    }
     LITERT_ASSIGN_OR_RETURN(void* data,
                             litert::internal::AhwbBuffer::Lock(ahwb_));
     return static_cast<T*>(data);
@@ -271,7 +303,7 @@ Expected<T*> GlBuffer::Lock() {
 }
 
 template <typename T>
-Expected<void> GlBuffer::Unlock() {
+Expected<void> GlBuffer::Unlock(size_t dirty_offset, size_t dirty_size) {
 #if LITERT_HAS_OPENGL_SUPPORT
   absl::MutexLock lock(&mutex_);
 #if LITERT_HAS_AHWB_SUPPORT
@@ -284,9 +316,24 @@ Expected<void> GlBuffer::Unlock() {
         kLiteRtStatusErrorRuntimeFailure,
         "Cannot unlock a buffer that wasn't locked in the first place");
   }
-  if (auto status = tflite_gl_buffer_.Write(absl::MakeSpan(
-          static_cast<const T*>(data_), size_bytes_ / sizeof(T)));
-      !status.ok()) {
+  dirty_offset = std::min(dirty_offset, size_bytes_);
+  dirty_size = std::min(dirty_size, size_bytes_ - dirty_offset);
+  if (dirty_size == 0) {
+    return Expected<void>();
+  }
+  absl::Status status;
+  if (dirty_size == size_bytes_) {
+    status = tflite_gl_buffer_.Write(absl::MakeSpan(
+        static_cast<const T*>(data_), size_bytes_ / sizeof(T)));
+  } else {
+    tflite::gpu::gl::GlBuffer dirty_view;
+    status = tflite_gl_buffer_.MakeView(dirty_offset, dirty_size, &dirty_view);
+    if (status.ok()) {
+      status = dirty_view.Write(absl::MakeSpan(
+          static_cast<const char*>(data_) + dirty_offset, dirty_size));
+    }
+  }
+  if (!status.ok()) {
     return Unexpected(
         kLiteRtStatusErrorRuntimeFailure,
         absl::StrCat("Failed to write GL buffer: ", status.message()));
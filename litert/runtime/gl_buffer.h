@@ -17,6 +17,7 @@
 
 #include <cstddef>
 #include <cstdlib>
+#include <limits>
 
 #include "absl/synchronization/mutex.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
@@ -45,18 +46,28 @@ class GlBuffer {
   ~GlBuffer();
 
   static bool IsSupported() { return true; }
-  // Allocates an owned GL buffer.
+  // Allocates an owned GL buffer. When AHardwareBuffer to GL interop is
+  // supported, the buffer is backed by an owned AHardwareBuffer so that
+  // locking it gives the CPU direct access to the GPU memory.
   static Expected<GlBuffer> Alloc(GpuEnvironment* gpu_env, size_t size_bytes);
 
   // Allocates an owned GL buffer from an AHardwareBuffer.
   static Expected<GlBuffer> AllocFromAhwbBuffer(GpuEnvironment* gpu_env,
                                                 AhwbBuffer& ahwb_buffer);
 
+  // `gl_work_synced` tells that the GL commands writing the buffer are known
+  // to be complete, e.g. because its EGL fence was waited on. Locking a buffer
+  // backed by an owned AHardwareBuffer then doesn't wait for all the pending
+  // GL commands, which may belong to frames submitted after this one.
   template <typename T>
-  Expected<T*> Lock();
+  Expected<T*> Lock(bool gl_work_synced = false);
 
+  // Writes the CPU memory back to the GL buffer. Only the `dirty_size` bytes
+  // starting at `dirty_offset` are written.
   template <typename T>
-  Expected<void> Unlock();
+  Expected<void> Unlock(
+      size_t dirty_offset = 0,
+      size_t dirty_size = std::numeric_limits<size_t>::max());
 
   LiteRtGLenum target() const;
   LiteRtGLuint id() const;
@@ -97,6 +108,8 @@ class GlBuffer {
 #endif  // LITERT_HAS_OPENGL_SUPPORT
 #if LITERT_HAS_AHWB_SUPPORT
   AHardwareBuffer* ahwb_ = nullptr;
+  // Whether ahwb_ was allocated by Alloc() and must be released.
+  bool owns_ahwb_ = false;
 #endif  // LITERT_HAS_AHWB_SUPPORT
   GpuEnvironment* gpu_env_;
 };
@@ -14,6 +14,7 @@
 
 #include "litert/runtime/gl_buffer.h"
 
+#include <cstdint>
 #include <cstring>
 #include <utility>
 #include <vector>
@@ -26,12 +27,16 @@
 #include "litert/c/litert_event.h"
 #include "litert/c/litert_event_type.h"
 #include "litert/c/litert_gl_types.h"
+#include "litert/c/litert_model_types.h"
 #include "litert/c/litert_platform_support.h"
+#include "litert/c/litert_tensor_buffer_types.h"
 #include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_layout.h"
 #include "litert/cc/litert_macros.h"
 #include "litert/core/environment.h"
 #include "litert/runtime/ahwb_buffer.h"
 #include "litert/runtime/gpu_environment.h"
+#include "litert/runtime/tensor_buffer.h"
 #include "litert/test/matchers.h"
 
 #if LITERT_HAS_OPENGL_SUPPORT
@@ -46,6 +51,10 @@ using ::testing::FloatNear;
 using ::testing::Pointwise;
 
 constexpr const float kTensorData[] = {10, 20, 30, 40};
+constexpr const int32_t kTensorDimensions[] = {4};
+constexpr const LiteRtRankedTensorType kTensorType = {
+    /*.element_type=*/kLiteRtElementTypeFloat32,
+    ::litert::BuildLayout(kTensorDimensions)};
 
 Expected<LiteRtEnvironment> CreateGpuEnabledEnvironment() {
   LiteRtEnvironment env;
@@ -252,6 +261,55 @@ TEST(Buffer, GpuWriteAhwbRead) {
   LITERT_ASSERT_OK(AhwbBuffer::Unlock(ahwb_buffer.ahwb));
 }
 
+#if LITERT_HAS_OPENGL_SUPPORT
+// Writes a GL tensor buffer on the GPU and reads it back on the CPU. With an
+// EGL fence, locking only waits for that fence; without one, it has to wait
+// for all the pending GL commands.
+void GpuWriteGlTensorBufferRead(LiteRtEnvironment env, bool with_fence) {
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto tensor_buffer,
+      LiteRtTensorBufferT::CreateManaged(env, kLiteRtTensorBufferTypeGlBuffer,
+                                         kTensorType, 4 * sizeof(float)));
+  LITERT_ASSERT_OK_AND_ASSIGN(GlBuffer * gl_buffer,
+                              tensor_buffer->GetGlBuffer());
+
+  // Schedule GPU write to GL buffer.
+  FillGlBuffer(gl_buffer->id(), 4);
+  if (with_fence) {
+    LiteRtEventT* egl_sync_event;
+    LITERT_ASSERT_OK(LiteRtCreateManagedEvent(env, LiteRtEventTypeEglSyncFence,
+                                              &egl_sync_event));
+    tensor_buffer->SetEvent(egl_sync_event);
+  }
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      void* host_data, tensor_buffer->Lock(kLiteRtTensorBufferLockModeRead));
+  ASSERT_NE(host_data, nullptr);
+  std::vector<float> expected_data = {0.0f, 0.1f, 0.2f, 0.3f};
+  EXPECT_THAT(absl::MakeSpan(static_cast<float*>(host_data), 4),
+              Pointwise(FloatNear(1e-5), expected_data));
+  LITERT_ASSERT_OK(tensor_buffer->Unlock());
+}
+
+TEST(Buffer, GpuWriteGlTensorBufferReadWithFence) {
+  if (!LiteRtHasOpenGlSupport()) {
+    GTEST_SKIP() << "OpenGL buffers are not supported on this platform";
+  }
+  LITERT_ASSERT_OK_AND_ASSIGN(auto env, CreateGpuEnabledEnvironment());
+  GpuWriteGlTensorBufferRead(env, /*with_fence=*/true);
+  LiteRtDestroyEnvironment(env);
+}
+
+TEST(Buffer, GpuWriteGlTensorBufferReadWithoutFence) {
+  if (!LiteRtHasOpenGlSupport()) {
+    GTEST_SKIP() << "OpenGL buffers are not supported on this platform";
+  }
+  LITERT_ASSERT_OK_AND_ASSIGN(auto env, CreateGpuEnabledEnvironment());
+  GpuWriteGlTensorBufferRead(env, /*with_fence=*/false);
+  LiteRtDestroyEnvironment(env);
+}
+#endif  // LITERT_HAS_OPENGL_SUPPORT
+
 }  // namespace
 }  // namespace internal
 }  // namespace litert
@@ -15,6 +15,7 @@
 #ifndef THIRD_PARTY_ODML_LITERT_LITERT_RUNTIME_LITERT_CPU_OPTIONS_H_
 #define THIRD_PARTY_ODML_LITERT_LITERT_RUNTIME_LITERT_CPU_OPTIONS_H_
 
+#include "litert/c/options/litert_cpu_options_type.h"
 #include "tflite/delegates/xnnpack/xnnpack_delegate.h"
 
 // Internal LiteRt CPU options struct. This data structure is used to
@@ -22,6 +23,7 @@
 // code.
 struct LiteRtCpuOptionsT {
   TfLiteXNNPackDelegateOptions xnn = TfLiteXNNPackDelegateOptionsDefault();
+  LiteRtCpuAffinityPolicy affinity_policy = kLiteRtCpuAffinityPolicyNone;
 
   static const char* Identifier() { return "xnnpack"; }
 };
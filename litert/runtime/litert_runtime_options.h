@@ -15,6 +15,8 @@
 #ifndef THIRD_PARTY_ODML_LITERT_LITERT_RUNTIME_LITERT_RUNTIME_OPTIONS_H_
 #define THIRD_PARTY_ODML_LITERT_LITERT_RUNTIME_LITERT_RUNTIME_OPTIONS_H_
 
+#include <cstdint>
+
 #include "litert/c/litert_common.h"
 
 // Internal LiteRt runtime options struct. This data structure is used to
@@ -31,6 +33,23 @@ struct LiteRtRuntimeOptionsT {
   LiteRtErrorReporterMode error_reporter_mode =
       LiteRtErrorReporterMode::kLiteRtErrorReporterModeNone;
 
+  // If true, JIT compilation for the NPU runs on a background thread and the
+  // compiled model runs on the CPU until it completes.
+  bool background_jit_compilation = false;
+
+  // If true, the tensors of a signature are only allocated the first time the
+  // signature runs.
+  bool lazy_signature_allocation = false;
+
+  // Number of invocation contexts each dispatch delegate kernel rotates
+  // through for asynchronous executions.
+  int num_dispatch_invocation_contexts = 1;
+
+  // Priority of the runs on their device, and time after their start by which
+  // they should complete, in milliseconds, or 0 for no deadline.
+  LiteRtRunPriority run_priority = kLiteRtRunPriorityNone;
+  int64_t run_deadline_ms = 0;
+
   static const char* Identifier() { return "runtime"; }
 };
 
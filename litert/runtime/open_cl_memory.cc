@@ -16,12 +16,15 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 
 #include "absl/cleanup/cleanup.h"  // from @com_google_absl
 #include "absl/strings/str_cat.h"  // from @com_google_absl
 #include "absl/synchronization/mutex.h"  // from @com_google_absl
+#include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_model_types.h"
 #include "litert/c/litert_tensor_buffer_types.h"
@@ -37,6 +40,7 @@
 #include <CL/cl_platform.h>
 #include "tflite/delegates/gpu/cl/buffer.h"
 #include "tflite/delegates/gpu/cl/cl_context.h"
+#include "tflite/delegates/gpu/cl/cl_device.h"
 #include "tflite/delegates/gpu/cl/opencl_wrapper.h"
 #include "tflite/delegates/gpu/cl/util.h"
 
@@ -44,15 +48,46 @@
 
 namespace litert::internal {
 
+namespace {
+
+// Returns true if the OpenCL device shares the memory of the host. Mapping a
+// buffer of such a device doesn't copy it.
+bool HasHostUnifiedMemory(GpuEnvironment* gpu_env) {
+  cl_bool host_unified_memory = CL_FALSE;
+  return tflite::gpu::cl::GetDeviceInfo(gpu_env->GetDevice()->id(),
+                                        CL_DEVICE_HOST_UNIFIED_MEMORY,
+                                        &host_unified_memory)
+             .ok() &&
+         host_unified_memory == CL_TRUE;
+}
+
+cl_map_flags ToMapFlags(LockState lock_state, bool covers_buffer) {
+  switch (lock_state) {
+    case LockState::kReadLocked:
+      return CL_MAP_READ;
+    case LockState::kWriteLocked:
+      // The previous content doesn't need to be made visible to the CPU when
+      // it's all overwritten.
+      return covers_buffer ? CL_MAP_WRITE_INVALIDATE_REGION : CL_MAP_WRITE;
+    default:
+      return CL_MAP_READ | CL_MAP_WRITE;
+  }
+}
+
+}  // namespace
+
 template Expected<float*> OpenClMemory::Lock<float>(
-    LiteRtTensorBufferLockMode mode);
+    LiteRtTensorBufferLockMode mode, size_t offset, size_t size);
 template Expected<char*> OpenClMemory::Lock<char>(
-    LiteRtTensorBufferLockMode mode);
-template Expected<void> OpenClMemory::Unlock<float>();
-template Expected<void> OpenClMemory::Unlock<char>();
+    LiteRtTensorBufferLockMode mode, size_t offset, size_t size);
+template Expected<void> OpenClMemory::Unlock<float>(size_t dirty_offset,
+                                                    size_t dirty_size);
+template Expected<void> OpenClMemory::Unlock<char>(size_t dirty_offset,
+                                                   size_t dirty_size);
 
 template <typename T>
-Expected<T*> OpenClMemory::Lock(LiteRtTensorBufferLockMode mode) {
+Expected<T*> OpenClMemory::Lock(LiteRtTensorBufferLockMode mode,
+                                size_t offset, size_t size) {
   absl::MutexLock lock(mutex_);
   LITERT_RETURN_IF_ERROR(
       IsSupported(),
@@ -68,14 +103,30 @@ Expected<T*> OpenClMemory::Lock(LiteRtTensorBufferLockMode mode) {
     }
   };
 
+  LITERT_ASSIGN_OR_RETURN(const size_t cpu_buffer_size,
+                          litert::internal::GetNumPackedBytes(tensor_type_));
+  const bool covers_buffer = offset == 0 && size >= cpu_buffer_size;
+  if (UseMapping()) {
+    cpu_buffer_size_ = cpu_buffer_size;
+    if (auto mapped_data = Map(lock_state, covers_buffer); mapped_data) {
+      mapped_data_ = *mapped_data;
+      lock_success = true;
+      return Expected<T*>(static_cast<T*>(mapped_data_));
+    } else {
+      LITERT_LOG(LITERT_WARNING,
+                 "Failed to map the OpenCL buffer, falling back to a copy: %s",
+                 mapped_data.Error().Message().c_str());
+      use_mapping_ = false;
+    }
+  }
+
   if (data_ == nullptr) {
     // The current Lock() always provides a packed buffer regardless of the
     // underlying H/W buffer type. If the underlying H/W buffer has a stride,
     // the data will be converted to the packed buffer by
     // LiteRtGpuMemoryDownload().
     // TODO b/413449050 - Update behavior to return raw H/W buffer and its size.
-    LITERT_ASSIGN_OR_RETURN(cpu_buffer_size_,
-                            litert::internal::GetNumPackedBytes(tensor_type_));
+    cpu_buffer_size_ = cpu_buffer_size;
     // Ensure the data is aligned.
     if (auto rc = posix_memalign(&data_, LITERT_HOST_MEMORY_BUFFER_ALIGNMENT,
                                  cpu_buffer_size_);
@@ -84,8 +135,13 @@ Expected<T*> OpenClMemory::Lock(LiteRtTensorBufferLockMode mode) {
                         "Failed to allocate aligned memory");
     }
   }
+  // Unlock() uploads the whole CPU memory of strided buffers, so a partial
+  // write needs their previous content too.
+  const bool keeps_content =
+      lock_state == LockState::kWriteLocked && !covers_buffer &&
+      buffer_type_ != kLiteRtTensorBufferTypeOpenClBufferPacked;
   if (lock_state == LockState::kReadLocked ||
-      lock_state == LockState::kReadWriteLocked) {
+      lock_state == LockState::kReadWriteLocked || keeps_content) {
     if (buffer_type_ == kLiteRtTensorBufferTypeOpenClBufferPacked) {
       LITERT_RETURN_IF_ERROR(gpu_env_->GetCommandQueue()
                                  ->EnqueueReadBuffer(GetMemoryPtr(),
@@ -105,7 +161,7 @@ Expected<T*> OpenClMemory::Lock(LiteRtTensorBufferLockMode mode) {
 }
 
 template <typename T>
-Expected<void> OpenClMemory::Unlock() {
+Expected<void> OpenClMemory::Unlock(size_t dirty_offset, size_t dirty_size) {
   absl::MutexLock lock(mutex_);
   LITERT_RETURN_IF_ERROR(
       IsSupported(),
@@ -114,14 +170,41 @@ Expected<void> OpenClMemory::Unlock() {
                          Unexpected(kLiteRtStatusErrorRuntimeFailure,
                                     "The OpenCL memory is already unlocked."));
   absl::Cleanup unlock = [this] { lock_state_ = LockState::kUnlocked; };
+  if (mapped_data_ != nullptr) {
+    // The writes of the CPU are visible to the commands enqueued after the
+    // unmap.
+    cl_int error = tflite::gpu::cl::clEnqueueUnmapMemObject(
+        gpu_env_->GetCommandQueue()->queue(), GetMemoryPtr(), mapped_data_,
+        /*num_events_in_wait_list=*/0, /*event_wait_list=*/nullptr,
+        /*event=*/nullptr);
+    mapped_data_ = nullptr;
+    LITERT_RETURN_IF_ERROR(
+        error == CL_SUCCESS,
+        Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                   absl::StrCat("Failed to unmap the OpenCL buffer: ",
+                                tflite::gpu::cl::CLErrorCodeToString(error))));
+    return Expected<void>();
+  }
   if (lock_state_ == LockState::kWriteLocked ||
       lock_state_ == LockState::kReadWriteLocked) {
     if (buffer_type_ == kLiteRtTensorBufferTypeOpenClBufferPacked) {
-      LITERT_RETURN_IF_ERROR(gpu_env_->GetCommandQueue()
-                                 ->EnqueueWriteBuffer(GetMemoryPtr(),
-                                                      cpu_buffer_size_, data_,
-                                                      /*async=*/true)
-                                 .ok());
+      dirty_offset = std::min(dirty_offset, cpu_buffer_size_);
+      dirty_size = std::min(dirty_size, cpu_buffer_size_ - dirty_offset);
+      if (dirty_size == 0) {
+        return Expected<void>();
+      }
+      cl_int error = tflite::gpu::cl::clEnqueueWriteBuffer(
+          gpu_env_->GetCommandQueue()->queue(), GetMemoryPtr(),
+          /*blocking_write=*/CL_FALSE, dirty_offset, dirty_size,
+          static_cast<const char*>(data_) + dirty_offset,
+          /*num_events_in_wait_list=*/0, /*event_wait_list=*/nullptr,
+          /*event=*/nullptr);
+      LITERT_RETURN_IF_ERROR(
+          error == CL_SUCCESS,
+          Unexpected(
+              kLiteRtStatusErrorRuntimeFailure,
+              absl::StrCat("Failed to write the OpenCL buffer: ",
+                           tflite::gpu::cl::CLErrorCodeToString(error))));
     } else {
       // The current Unlock() translates the packed buffer (data_) if the
       // underlying H/W buffer has a stride. This conversion is done by
@@ -135,6 +218,40 @@ Expected<void> OpenClMemory::Unlock() {
   return Expected<void>();
 }
 
+bool OpenClMemory::UseMapping() {
+  if (!use_mapping_.has_value()) {
+    // Strided buffers need a layout conversion, which requires a copy.
+    use_mapping_ = buffer_type_ == kLiteRtTensorBufferTypeOpenClBufferPacked &&
+                   HasHostUnifiedMemory(gpu_env_);
+  }
+  return *use_mapping_;
+}
+
+Expected<void*> OpenClMemory::Map(LockState lock_state, bool covers_buffer) {
+  cl_int error = CL_SUCCESS;
+  // A blocking map waits for the commands using the buffer to complete.
+  void* mapped_data = tflite::gpu::cl::clEnqueueMapBuffer(
+      gpu_env_->GetCommandQueue()->queue(), GetMemoryPtr(),
+      /*blocking_map=*/CL_TRUE, ToMapFlags(lock_state, covers_buffer),
+      /*offset=*/0, cpu_buffer_size_, /*num_events_in_wait_list=*/0,
+      /*event_wait_list=*/nullptr, /*event=*/nullptr, &error);
+  LITERT_RETURN_IF_ERROR(
+      error == CL_SUCCESS && mapped_data != nullptr,
+      Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                 tflite::gpu::cl::CLErrorCodeToString(error)));
+  if (reinterpret_cast<uintptr_t>(mapped_data) %
+          LITERT_HOST_MEMORY_BUFFER_ALIGNMENT !=
+      0) {
+    tflite::gpu::cl::clEnqueueUnmapMemObject(
+        gpu_env_->GetCommandQueue()->queue(), GetMemoryPtr(), mapped_data,
+        /*num_events_in_wait_list=*/0, /*event_wait_list=*/nullptr,
+        /*event=*/nullptr);
+    return Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                      "The mapped OpenCL buffer is not aligned");
+  }
+  return mapped_data;
+}
+
 bool OpenClMemory::IsSupported() {
   static bool is_supported = ::tflite::gpu::cl::LoadOpenCL().ok();
   return is_supported;
@@ -151,6 +268,24 @@ Expected<OpenClMemory> OpenClMemory::Alloc(
                       "OpenCL is not supported");
   }
 
+  if (buffer_type == kLiteRtTensorBufferTypeOpenClBufferPacked &&
+      HasHostUnifiedMemory(gpu_env)) {
+    // Let the driver allocate memory that the CPU can map without a copy.
+    cl_int error = CL_SUCCESS;
+    cl_mem cl_memory = tflite::gpu::cl::clCreateBuffer(
+        gpu_env->GetContext()->context(),
+        CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR, bytes_size,
+        /*host_ptr=*/nullptr, &error);
+    if (cl_memory != nullptr) {
+      return Expected<OpenClMemory>(gpu_env, tensor_type, buffer_type,
+                                    tflite::gpu::cl::Buffer(cl_memory,
+                                                            bytes_size));
+    }
+    LITERT_LOG(LITERT_WARNING,
+               "Failed to allocate host accessible OpenCL buffer: %s",
+               tflite::gpu::cl::CLErrorCodeToString(error).c_str());
+  }
+
   if (buffer_type == kLiteRtTensorBufferTypeOpenClBufferPacked) {
     tflite::gpu::cl::Buffer buffer;
     LITERT_RETURN_IF_ERROR(tflite::gpu::cl::CreateReadWriteBuffer(
@@ -17,6 +17,8 @@
 
 #include <cstddef>
 #include <cstdlib>
+#include <limits>
+#include <optional>
 #include <utility>
 
 #include "absl/synchronization/mutex.h"  // from @com_google_absl
@@ -43,10 +45,13 @@ class OpenClMemory {
         tensor_type_(other.tensor_type_),
         buffer_type_(other.buffer_type_),
         data_(other.data_),
+        mapped_data_(other.mapped_data_),
         buffer_(std::move(other.buffer_)),
         size_(other.size_),
-        ahwb_(other.ahwb_) {
+        ahwb_(other.ahwb_),
+        use_mapping_(other.use_mapping_) {
     other.data_ = nullptr;
+    other.mapped_data_ = nullptr;
     other.size_ = 0;
     other.ahwb_ = nullptr;
   }
@@ -88,14 +93,22 @@ class OpenClMemory {
   }
 
   cl_mem GetMemoryPtr() { return buffer_.GetMemoryPtr(); }
-  // Allocates a CPU memory and conducts a copy from the OpenCL buffer to the
-  // CPU memory.
+  // Gives the CPU access to the buffer content. Packed buffers on devices
+  // sharing the host memory are mapped, so the CPU reads and writes the device
+  // memory directly. Other buffers are copied to a CPU memory. The previous
+  // content is kept for write locks that access only the `size` bytes starting
+  // at `offset`.
   template <typename T>
-  Expected<T*> Lock(LiteRtTensorBufferLockMode mode);
+  Expected<T*> Lock(LiteRtTensorBufferLockMode mode, size_t offset = 0,
+                    size_t size = std::numeric_limits<size_t>::max());
 
-  // Writes the data from the CPU memory to the OpenCL buffer.
+  // Unmaps the buffer, or writes the data from the CPU memory to the OpenCL
+  // buffer. Only the `dirty_size` bytes starting at `dirty_offset` are written
+  // to packed buffers.
   template <typename T>
-  Expected<void> Unlock();
+  Expected<void> Unlock(
+      size_t dirty_offset = 0,
+      size_t dirty_size = std::numeric_limits<size_t>::max());
 
   // Returns true if OpenCL is supported.
   // Warning: This is only for TEST.
@@ -113,12 +126,21 @@ class OpenClMemory {
   size_t size_bytes() const { return size_; }
 
  private:
+  // Returns true if the CPU accesses the buffer by mapping it.
+  bool UseMapping();
+
+  // Maps the packed buffer into the CPU address space. A write lock that
+  // doesn't cover the whole buffer keeps its previous content.
+  Expected<void*> Map(LockState lock_state, bool covers_buffer);
+
   GpuEnvironment* gpu_env_ = nullptr;
   const LiteRtRankedTensorType tensor_type_;
   LiteRtTensorBufferType buffer_type_;
   absl::Mutex mutex_;
   // The cpu memory buffer pointer.
   void* data_ = nullptr;
+  // The CPU address of the buffer while it is locked through a mapping.
+  void* mapped_data_ = nullptr;
   tflite::gpu::cl::Buffer buffer_;
   LiteRtOpenClDeallocator deallocator_ = nullptr;
   // The size of the buffer in bytes.
@@ -127,6 +149,8 @@ class OpenClMemory {
   size_t cpu_buffer_size_ = 0;
   AHardwareBuffer* ahwb_ = nullptr;
   LockState lock_state_ = LockState::kUnlocked;
+  // Whether Lock() maps the buffer, decided on the first lock.
+  std::optional<bool> use_mapping_;
 };
 
 }  // namespace litert::internal
@@ -14,159 +14,650 @@
 
 #include "litert/runtime/profiler.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <memory>
+#include <cstring>
+#include <mutex>  // NOLINT(build/c++11)
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <tuple>
 #include <utility>
 #include <vector>
 
+#include "absl/container/node_hash_set.h"  // from @com_google_absl
+#include "absl/numeric/bits.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
+#include "absl/time/time.h"  // from @com_google_absl
 #include "litert/c/litert_profiler_event.h"
-#include "tflite/profiling/profile_buffer.h"  // IWYU pragma: keep
+#include "tflite/core/api/profiler.h"
+#include "tflite/delegates/gpu/common/task/profiling_info.h"
+#include "tflite/delegates/gpu/tflite_profile.h"
+#include "tflite/profiling/memory_info.h"
+#include "tflite/profiling/time.h"
 
-LiteRtProfilerT::LiteRtProfilerT(size_t max_num_events)
-    : profiling_enabled_(false),
-      current_event_source_(ProfiledEventSource::LITERT) {
-  // Initialize the profile buffer with the TFLite metadata version
-  // and the maximum number of events.
-  profile_buffer_ = std::make_unique<tflite::profiling::ProfileBuffer>(
-      max_num_events, false);
+namespace {
+
+// An event handle holds the slot of the buffer of the thread that began the
+// event above these bits, and the low bits of the sequence number of the event
+// in the buffer. The handle 0 is invalid.
+constexpr int kSequenceBits = 26;
+constexpr uint32_t kSequenceMask = (1u << kSequenceBits) - 1;
+// The sequence numbers of the events of a buffer must be told apart from their
+// low bits.
+constexpr size_t kMaxNumEventsPerThread = 1u << (kSequenceBits - 1);
+
+static_assert(LiteRtProfilerT::kMaxThreads < (1 << (32 - kSequenceBits)),
+              "The slots of the threads must fit in the event handles");
+
+std::atomic<uint64_t> next_profiler_id{1};
+
+struct Event {
+  uint64_t sequence;
+  // Owned by the buffer.
+  const char* tag;
+  tflite::Profiler::EventType event_type;
+  ProfiledEventSource event_source;
+  // 0 for the events added with their elapsed time.
+  uint64_t begin_timestamp_us;
+  uint64_t elapsed_time_us;
+  // When the event was begun or added, to merge the buffers.
+  uint64_t timeline_us;
+  int64_t event_metadata1;
+  int64_t event_metadata2;
+  tflite::profiling::memory::MemoryUsage begin_mem_usage;
+  tflite::profiling::memory::MemoryUsage end_mem_usage;
+};
+
+bool RecordsMemoryUsage(tflite::Profiler::EventType event_type) {
+  // Reading the memory usage would take longer than most ops.
+  return event_type != tflite::Profiler::EventType::OPERATOR_INVOKE_EVENT;
 }
 
-LiteRtProfilerT::~LiteRtProfilerT() = default;
+// Returns whether the events of `event_type` are aggregated by the sampling
+// mode.
+bool IsOpEvent(tflite::Profiler::EventType event_type) {
+  return event_type == tflite::Profiler::EventType::OPERATOR_INVOKE_EVENT ||
+         event_type ==
+             tflite::Profiler::EventType::DELEGATE_OPERATOR_INVOKE_EVENT ||
+         event_type == tflite::Profiler::EventType::
+                           DELEGATE_PROFILED_OPERATOR_INVOKE_EVENT;
+}
 
-uint32_t LiteRtProfilerT::BeginEvent(const char* tag, EventType event_type,
-                              int64_t event_metadata1,
-                              int64_t event_metadata2) {
-  if (!profiling_enabled_ || !profile_buffer_) {
-    return 0;  // Return an invalid handle
+void AddLatency(LiteRtProfilerLatencyStats& stats, uint64_t time_us) {
+  if (stats.count == 0 || time_us < stats.min_time_us) {
+    stats.min_time_us = time_us;
   }
+  stats.max_time_us = std::max(stats.max_time_us, time_us);
+  ++stats.count;
+  stats.total_time_us += time_us;
+  ++stats.buckets[std::min<int>(absl::bit_width(time_us),
+                                LITERT_PROFILER_NUM_LATENCY_BUCKETS - 1)];
+}
+
+}  // namespace
 
-  // 1. Convert input tag to std::string and insert into the set to get a
-  // unique, owned string.
-  std::string s_tag(tag);
-  auto [it, inserted] = owned_tags_set_.insert(std::move(s_tag));
-  const char* owned_tag_ptr = it->c_str();
+struct LiteRtProfilerT::ThreadBuffer {
+  ThreadBuffer(size_t max_num_events, int slot)
+      : events(max_num_events), slot(slot) {}
+
+  // Returns a copy of `tag` owned by the buffer.
+  const char* OwnTag(const char* tag) {
+    auto it = tags.find(absl::string_view(tag));
+    if (it == tags.end()) {
+      it = tags.emplace(tag).first;
+    }
+    return it->c_str();
+  }
 
-  // Delegate to the owned ProfileBuffer to record the event and get a handle
-  uint32_t event_handle = profile_buffer_->BeginEvent(
-      owned_tag_ptr, event_type, event_metadata1, event_metadata2);
+  // Appends an event with the next sequence number, overwriting the oldest one
+  // if the buffer is full. Returns its handle.
+  uint32_t Append(Event& event) {
+    const uint64_t sequence = num_recorded.load(std::memory_order_relaxed);
+    event.sequence = sequence;
+    events[sequence % events.size()] = event;
+    num_recorded.store(sequence + 1, std::memory_order_release);
+    return (static_cast<uint32_t>(slot + 1) << kSequenceBits) |
+           (static_cast<uint32_t>(sequence) & kSequenceMask);
+  }
 
-  if (event_handle != 0) {
-    // Determine the effective source for this specific event
-    ProfiledEventSource effective_source = this->current_event_source_;
-    if (event_type == EventType::DELEGATE_OPERATOR_INVOKE_EVENT ||
-        event_type == EventType::DELEGATE_PROFILED_OPERATOR_INVOKE_EVENT) {
-      effective_source = ProfiledEventSource::TFLITE_DELEGATE;
+  // Returns the event of `event_handle`, or nullptr if it was overwritten.
+  Event* Find(uint32_t event_handle) {
+    const uint64_t num = num_recorded.load(std::memory_order_acquire);
+    const uint64_t age =
+        ((static_cast<uint32_t>(num) - event_handle) & kSequenceMask);
+    if (age == 0 || age > events.size() || age > num) {
+      return nullptr;
     }
-    // Store our determined source associated with the handle
-    active_event_sources_map_[event_handle] = effective_source;
+    Event& event = events[(num - age) % events.size()];
+    return event.sequence == num - age ? &event : nullptr;
+  }
+
+  // Returns the number of events in the buffer.
+  size_t Size() const {
+    return std::min<uint64_t>(num_recorded.load(std::memory_order_acquire),
+                              events.size());
+  }
+
+  // A ring buffer, written by the thread of the buffer.
+  std::vector<Event> events;
+  std::atomic<uint64_t> num_recorded{0};
+  // Written by the thread of the buffer only, so that the tags of the events
+  // are copied without locks.
+  absl::node_hash_set<std::string> tags;
+  std::atomic<ProfiledEventSource> current_event_source{
+      ProfiledEventSource::LITERT};
+  // Set while the thread of the buffer records an event.
+  std::atomic<bool> recording{false};
+  const int slot;
+  std::thread::id thread_id;
+
+  // The run of the thread in the sampling mode, only used by the thread.
+  bool in_run = false;
+  bool run_sampled = false;
+  // Whether the events of the run are recorded, until it is known whether it
+  // is profiled.
+  bool run_recorded = false;
+  uint64_t run_begin_us = 0;
+  uint64_t run_first_sequence = 0;
+
+  // The events of the GPU kernels recorded with their device times, which
+  // the delegate adds again without them. Only used by the thread.
+  size_t num_gpu_events_to_drop = 0;
+};
+
+namespace {
+
+// Marks the thread of `buffer` as recording an event while profiling is
+// enabled, which Pause() waits for.
+class ScopedRecording {
+ public:
+  ScopedRecording(std::atomic<bool>& profiling_enabled,
+                  std::atomic<bool>& recording)
+      : recording_(recording) {
+    // Sequentially consistent, so that either Pause() sees the recording or
+    // the recording sees that profiling is disabled.
+    recording_.store(true, std::memory_order_seq_cst);
+    enabled_ = profiling_enabled.load(std::memory_order_seq_cst);
+  }
+  ~ScopedRecording() { recording_.store(false, std::memory_order_release); }
+
+  bool enabled() const { return enabled_; }
+
+ private:
+  std::atomic<bool>& recording_;
+  bool enabled_;
+};
+
+}  // namespace
+
+LiteRtProfilerT::LiteRtProfilerT(size_t max_num_events)
+    : id_(next_profiler_id.fetch_add(1, std::memory_order_relaxed)),
+      max_num_events_(
+          std::clamp<size_t>(max_num_events, 1, kMaxNumEventsPerThread)) {}
+
+LiteRtProfilerT::~LiteRtProfilerT() {
+  for (auto& thread_buffer : thread_buffers_) {
+    delete thread_buffer.load(std::memory_order_relaxed);
   }
-  return event_handle;
+}
+
+LiteRtProfilerT::ThreadBuffer* LiteRtProfilerT::GetThreadBuffer() {
+  // The buffer of the profiler the thread last recorded into. The id of the
+  // profiler, rather than its address, tells whether it is still alive.
+  static thread_local uint64_t cached_profiler_id = 0;
+  static thread_local ThreadBuffer* cached_buffer = nullptr;
+  if (cached_profiler_id == id_) {
+    return cached_buffer;
+  }
+  const std::thread::id thread_id = std::this_thread::get_id();
+  std::lock_guard<std::mutex> lock(mutex_);
+  const int num_thread_buffers =
+      num_thread_buffers_.load(std::memory_order_relaxed);
+  ThreadBuffer* buffer = nullptr;
+  for (int i = 0; i < num_thread_buffers; ++i) {
+    ThreadBuffer* thread_buffer =
+        thread_buffers_[i].load(std::memory_order_relaxed);
+    if (thread_buffer->thread_id == thread_id) {
+      buffer = thread_buffer;
+      break;
+    }
+  }
+  if (buffer == nullptr) {
+    if (num_thread_buffers == kMaxThreads) {
+      return nullptr;
+    }
+    buffer = new ThreadBuffer(max_num_events_, num_thread_buffers);
+    buffer->thread_id = thread_id;
+    thread_buffers_[num_thread_buffers].store(buffer,
+                                              std::memory_order_release);
+    num_thread_buffers_.store(num_thread_buffers + 1,
+                              std::memory_order_release);
+  }
+  cached_profiler_id = id_;
+  cached_buffer = buffer;
+  return buffer;
+}
+
+uint32_t LiteRtProfilerT::BeginEvent(const char* tag, EventType event_type,
+                                     int64_t event_metadata1,
+                                     int64_t event_metadata2) {
+  if (!profiling_enabled_.load(std::memory_order_relaxed)) {
+    return 0;  // Return an invalid handle
+  }
+  ThreadBuffer* buffer = GetThreadBuffer();
+  if (buffer == nullptr) {
+    return 0;
+  }
+  ScopedRecording recording(profiling_enabled_, buffer->recording);
+  if (!recording.enabled()) {
+    return 0;
+  }
+  const bool sampling = sampling_.load(std::memory_order_relaxed);
+  if (sampling && !buffer->run_recorded) {
+    return 0;
+  }
+  Event event;
+  event.tag = buffer->OwnTag(tag);
+  event.event_type = event_type;
+  // Determine the effective source for this specific event
+  event.event_source =
+      buffer->current_event_source.load(std::memory_order_relaxed);
+  if (event_type == EventType::DELEGATE_OPERATOR_INVOKE_EVENT ||
+      event_type == EventType::DELEGATE_PROFILED_OPERATOR_INVOKE_EVENT) {
+    event.event_source = ProfiledEventSource::TFLITE_DELEGATE;
+  }
+  event.event_metadata1 = event_metadata1;
+  event.event_metadata2 = event_metadata2;
+  if (!sampling && RecordsMemoryUsage(event_type)) {
+    event.begin_mem_usage = tflite::profiling::memory::GetMemoryUsage();
+  }
+  event.begin_timestamp_us = tflite::profiling::time::NowMicros();
+  event.timeline_us = event.begin_timestamp_us;
+  event.elapsed_time_us = 0;
+  return buffer->Append(event);
 }
 
 void LiteRtProfilerT::EndEvent(uint32_t event_handle) {
-  if (!profiling_enabled_ || !profile_buffer_ || event_handle < 0) {
+  EndEvent(event_handle, nullptr, nullptr);
+}
+
+void LiteRtProfilerT::EndEvent(uint32_t event_handle, int64_t event_metadata1,
+                               int64_t event_metadata2) {
+  EndEvent(event_handle, &event_metadata1, &event_metadata2);
+}
+
+void LiteRtProfilerT::EndEvent(uint32_t event_handle,
+                               const int64_t* event_metadata1,
+                               const int64_t* event_metadata2) {
+  if (event_handle == 0 ||
+      !profiling_enabled_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  const uint64_t end_timestamp_us = tflite::profiling::time::NowMicros();
+  const int slot = static_cast<int>(event_handle >> kSequenceBits) - 1;
+  if (slot >= num_thread_buffers_.load(std::memory_order_acquire)) {
+    return;
+  }
+  ThreadBuffer* calling_thread_buffer = GetThreadBuffer();
+  if (calling_thread_buffer == nullptr) {
+    return;
+  }
+  ScopedRecording recording(profiling_enabled_,
+                            calling_thread_buffer->recording);
+  if (!recording.enabled()) {
+    return;
+  }
+  ThreadBuffer* buffer = thread_buffers_[slot].load(std::memory_order_acquire);
+  Event* event = buffer->Find(event_handle);
+  if (event == nullptr) {
+    // The event was overwritten.
     return;
   }
-  profile_buffer_->EndEvent(event_handle);
-  // The source associated with event_handle in active_event_sources_map_
-  // will be used when GetProfiledEvents is called.
-  // We don't remove from active_event_sources_map_ here; it's cleared on Reset.
+  event->elapsed_time_us = end_timestamp_us - event->begin_timestamp_us;
+  if (!sampling_.load(std::memory_order_relaxed) &&
+      RecordsMemoryUsage(event->event_type)) {
+    event->end_mem_usage = tflite::profiling::memory::GetMemoryUsage();
+  }
+  if (event_metadata1) {
+    event->event_metadata1 = *event_metadata1;
+  }
+  if (event_metadata2) {
+    event->event_metadata2 = *event_metadata2;
+  }
 }
 
 void LiteRtProfilerT::AddEvent(const char* tag, EventType event_type,
                                uint64_t metric, int64_t event_metadata1,
                                int64_t event_metadata2) {
-  if (!profiling_enabled_ || !profile_buffer_) {
+  if (!profiling_enabled_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  ThreadBuffer* buffer = GetThreadBuffer();
+  if (buffer == nullptr) {
+    return;
+  }
+  ScopedRecording recording(profiling_enabled_, buffer->recording);
+  if (!recording.enabled()) {
     return;
   }
-  // 1. Convert input tag to std::string and insert into the set to get a
-  // unique, owned string.
-  std::string s_tag(tag);
-  auto [it, inserted] = owned_tags_set_.insert(std::move(s_tag));
-  const char* owned_tag_ptr = it->c_str();
-  profile_buffer_->AddEvent(owned_tag_ptr, event_type, metric, event_metadata1,
-                            event_metadata2);
+  if (sampling_.load(std::memory_order_relaxed) && !buffer->run_recorded) {
+    return;
+  }
+  if (event_type == EventType::DELEGATE_PROFILED_OPERATOR_INVOKE_EVENT &&
+      buffer->num_gpu_events_to_drop > 0) {
+    --buffer->num_gpu_events_to_drop;
+    return;
+  }
+  Event event;
+  event.tag = buffer->OwnTag(tag);
+  event.event_type = event_type;
+  event.event_source =
+      buffer->current_event_source.load(std::memory_order_relaxed);
+  event.event_metadata1 = event_metadata1;
+  event.event_metadata2 = event_metadata2;
+  event.begin_timestamp_us = 0;
+  event.elapsed_time_us = metric;
+  event.timeline_us = tflite::profiling::time::NowMicros();
+  buffer->Append(event);
 }
 
-void LiteRtProfilerT::StartProfiling() {
-  if (!profile_buffer_) {
-    // Or handle error: Profiler not properly initialized
+void LiteRtProfilerT::AddEventWithData(const char* tag, EventType event_type,
+                                       const void* data) {
+  if (data == nullptr ||
+      event_type != EventType::DELEGATE_PROFILED_OPERATOR_INVOKE_EVENT ||
+      std::strcmp(tag, tflite::gpu::kGpuKernelsEventTag) != 0 ||
+      !profiling_enabled_.load(std::memory_order_relaxed)) {
     return;
   }
-  // Reset previous data if starting a new session without explicit reset
-  profile_buffer_->Reset();
-  active_event_sources_map_.clear();
-  current_event_source_ = ProfiledEventSource::LITERT;
+  ThreadBuffer* buffer = GetThreadBuffer();
+  if (buffer == nullptr) {
+    return;
+  }
+  ScopedRecording recording(profiling_enabled_, buffer->recording);
+  if (!recording.enabled()) {
+    return;
+  }
+  if (sampling_.load(std::memory_order_relaxed) && !buffer->run_recorded) {
+    return;
+  }
+  const auto& dispatches =
+      static_cast<const tflite::gpu::ProfilingInfo*>(data)->dispatches;
+  absl::Duration device_end;
+  for (const auto& dispatch : dispatches) {
+    device_end = std::max(device_end, dispatch.start + dispatch.duration);
+  }
+  // The device clock is not the host one: the kernels are aligned so that the
+  // last one ends now, which is once the delegate waited for them.
+  const uint64_t now_us = tflite::profiling::time::NowMicros();
+  const uint64_t device_begin_us =
+      now_us - std::min<uint64_t>(absl::ToInt64Microseconds(device_end),
+                                  now_us);
+  int64_t node_index = 0;
+  for (const auto& dispatch : dispatches) {
+    Event event;
+    event.tag = buffer->OwnTag(dispatch.label.c_str());
+    event.event_type = event_type;
+    event.event_source = ProfiledEventSource::GPU;
+    event.event_metadata1 = node_index++;
+    event.event_metadata2 = 0;
+    event.begin_timestamp_us =
+        device_begin_us + absl::ToInt64Microseconds(dispatch.start);
+    event.elapsed_time_us = absl::ToInt64Microseconds(dispatch.duration);
+    event.timeline_us = event.begin_timestamp_us;
+    buffer->Append(event);
+  }
+  buffer->num_gpu_events_to_drop = dispatches.size();
+}
 
-  profiling_enabled_ = true;
-  profile_buffer_->SetEnabled(profiling_enabled_);
+bool LiteRtProfilerT::Pause() {
+  const bool was_enabled =
+      profiling_enabled_.exchange(false, std::memory_order_seq_cst);
+  const int num_thread_buffers =
+      num_thread_buffers_.load(std::memory_order_acquire);
+  for (int i = 0; i < num_thread_buffers; ++i) {
+    ThreadBuffer* buffer = thread_buffers_[i].load(std::memory_order_acquire);
+    while (buffer->recording.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+  }
+  return was_enabled;
+}
+
+void LiteRtProfilerT::MergeEvents(
+    std::vector<ProfiledEventData>& events) const {
+  std::vector<std::pair<uint64_t, ProfiledEventData>> timeline;
+  const int num_thread_buffers =
+      num_thread_buffers_.load(std::memory_order_acquire);
+  for (int i = 0; i < num_thread_buffers; ++i) {
+    const ThreadBuffer* buffer =
+        thread_buffers_[i].load(std::memory_order_acquire);
+    const uint64_t num_recorded =
+        buffer->num_recorded.load(std::memory_order_acquire);
+    for (uint64_t sequence = num_recorded - buffer->Size();
+         sequence < num_recorded; ++sequence) {
+      const Event& event = buffer->events[sequence % buffer->events.size()];
+      ProfiledEventData ev_data;
+      ev_data.tag = event.tag;
+      ev_data.event_type = event.event_type;
+      ev_data.start_timestamp_us = event.begin_timestamp_us;
+      ev_data.elapsed_time_us = event.elapsed_time_us;
+      ev_data.event_metadata1 = event.event_metadata1;
+      ev_data.event_metadata2 = event.event_metadata2;
+      ev_data.begin_mem_usage = event.begin_mem_usage;
+      ev_data.end_mem_usage = event.end_mem_usage;
+      ev_data.event_source = event.event_source;
+      timeline.emplace_back(event.timeline_us, ev_data);
+    }
+  }
+  // The events of each thread are already in order.
+  std::stable_sort(
+      timeline.begin(), timeline.end(),
+      [](const auto& a, const auto& b) { return a.first < b.first; });
+  events.reserve(events.size() + timeline.size());
+  for (auto& [timeline_us, ev_data] : timeline) {
+    events.push_back(ev_data);
+  }
+}
+
+void LiteRtProfilerT::ClearBuffers() {
+  const int num_thread_buffers =
+      num_thread_buffers_.load(std::memory_order_acquire);
+  for (int i = 0; i < num_thread_buffers; ++i) {
+    ThreadBuffer* buffer = thread_buffers_[i].load(std::memory_order_acquire);
+    buffer->num_recorded.store(0, std::memory_order_relaxed);
+    buffer->current_event_source.store(ProfiledEventSource::LITERT,
+                                       std::memory_order_relaxed);
+  }
+  merged_events_.clear();
+}
+
+void LiteRtProfilerT::StartProfiling() {
+  // Reset previous data if starting a new session without explicit reset
+  Pause();
+  ClearBuffers();
+  ClearStats();
+  profiling_enabled_.store(true, std::memory_order_seq_cst);
 }
 
 void LiteRtProfilerT::StopProfiling() {
-  profiling_enabled_ = false;
-  profile_buffer_->SetEnabled(profiling_enabled_);
-  // Events already in the buffer are preserved until Reset() or
-  // GetProfiledEvents().
+  Pause();
+  // Events already in the buffers are preserved until Reset() or the next
+  // StartProfiling().
+  merged_events_.clear();
+  MergeEvents(merged_events_);
 }
 
 bool LiteRtProfilerT::IsProfiling() const {
-  return profiling_enabled_;
+  return profiling_enabled_.load(std::memory_order_relaxed);
 }
 
 void LiteRtProfilerT::Reset() {
-  if (profile_buffer_) {
-    profile_buffer_->Reset();
+  const bool was_enabled = Pause();
+  ClearBuffers();
+  ClearStats();
+  // The profiling state remains as is, Reset just clears data.
+  if (was_enabled) {
+    profiling_enabled_.store(true, std::memory_order_seq_cst);
   }
-  active_event_sources_map_.clear();
-  current_event_source_ = ProfiledEventSource::LITERT;  // Reset hint
-  // litert_profiling_enabled_ remains as is, Reset just clears data.
 }
 
 std::vector<ProfiledEventData> LiteRtProfilerT::GetProfiledEvents() const {
-  std::vector<ProfiledEventData> result_events;
-
-if (!profile_buffer_) {
-    return result_events;
-  }
-
-  // Get the raw events from the owned ProfileBuffer.
-  // These events are typically TFLite's internal representation.
-  for (int i = 0; i < profile_buffer_->Size(); ++i) {
-    ProfiledEventData ev_data;
-    auto tf_event = profile_buffer_->At(i);
-    ev_data.tag = tf_event->tag.c_str();
-    ev_data.event_type = tf_event->event_type;
-    ev_data.start_timestamp_us = tf_event->begin_timestamp_us;
-    ev_data.elapsed_time_us = tf_event->elapsed_time;
-    ev_data.event_metadata1 = tf_event->event_metadata;
-    ev_data.event_metadata2 = tf_event->extra_event_metadata;
-    ev_data.begin_mem_usage = tf_event->begin_mem_usage;
-    ev_data.end_mem_usage = tf_event->end_mem_usage;
-
-    // Look up our attributed source
-    auto it = active_event_sources_map_.find(i);
-    if (it != active_event_sources_map_.end()) {
-      ev_data.event_source = it->second;
-    } else {
-      // This case could happen if an event was somehow incompletely recorded
-      // or if handles are reused in a way not perfectly aligned with map
-      // clearing. A robust profiler might log this. For now, fallback.
-      ev_data.event_source = ProfiledEventSource::LITERT;  // Default fallback
-    }
-    result_events.push_back(ev_data);
+  if (!IsProfiling()) {
+    return merged_events_;
   }
-
+  std::vector<ProfiledEventData> result_events;
+  MergeEvents(result_events);
   // GetProfiledEvents is non-consuming, Reset() is the explicit way to clear
   // data.
   return result_events;
 }
 
 void LiteRtProfilerT::SetCurrentEventSource(ProfiledEventSource source_hint) {
-  this->current_event_source_ = source_hint;
+  if (ThreadBuffer* buffer = GetThreadBuffer(); buffer != nullptr) {
+    buffer->current_event_source.store(source_hint, std::memory_order_relaxed);
+  }
 }
 
 size_t LiteRtProfilerT::GetNumEvents() const {
-  return profile_buffer_->Size();
+  if (!IsProfiling()) {
+    return merged_events_.size();
+  }
+  size_t num_events = 0;
+  const int num_thread_buffers =
+      num_thread_buffers_.load(std::memory_order_acquire);
+  for (int i = 0; i < num_thread_buffers; ++i) {
+    num_events += thread_buffers_[i].load(std::memory_order_acquire)->Size();
+  }
+  return num_events;
+}
+
+void LiteRtProfilerT::SetSampling(int sample_every_n_runs,
+                                  uint64_t latency_threshold_us) {
+  const bool was_enabled = Pause();
+  sample_every_n_runs_.store(std::max(sample_every_n_runs, 0),
+                             std::memory_order_relaxed);
+  latency_threshold_us_.store(latency_threshold_us, std::memory_order_relaxed);
+  sampling_.store(sample_every_n_runs > 0 || latency_threshold_us > 0,
+                  std::memory_order_relaxed);
+  ClearBuffers();
+  ClearStats();
+  if (was_enabled) {
+    profiling_enabled_.store(true, std::memory_order_seq_cst);
+  }
+}
+
+bool LiteRtProfilerT::IsSampling() const {
+  return sampling_.load(std::memory_order_relaxed);
+}
+
+bool LiteRtProfilerT::BeginRun() {
+  if (!profiling_enabled_.load(std::memory_order_relaxed) ||
+      !sampling_.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  ThreadBuffer* buffer = GetThreadBuffer();
+  if (buffer == nullptr || buffer->in_run) {
+    return false;
+  }
+  const uint64_t run = num_runs_.fetch_add(1, std::memory_order_relaxed);
+  const int sample_every_n_runs =
+      sample_every_n_runs_.load(std::memory_order_relaxed);
+  buffer->in_run = true;
+  buffer->run_sampled =
+      sample_every_n_runs > 0 && run % sample_every_n_runs == 0;
+  // Whether a run is slow is only known once it is over.
+  buffer->run_recorded =
+      buffer->run_sampled ||
+      latency_threshold_us_.load(std::memory_order_relaxed) > 0;
+  buffer->run_first_sequence =
+      buffer->num_recorded.load(std::memory_order_relaxed);
+  buffer->run_begin_us = tflite::profiling::time::NowMicros();
+  return true;
+}
+
+void LiteRtProfilerT::EndRun() {
+  const uint64_t end_us = tflite::profiling::time::NowMicros();
+  ThreadBuffer* buffer = GetThreadBuffer();
+  if (buffer == nullptr || !buffer->in_run) {
+    return;
+  }
+  buffer->in_run = false;
+  buffer->run_recorded = false;
+  ScopedRecording recording(profiling_enabled_, buffer->recording);
+  // The run is dropped if profiling stopped or the mode changed while it ran.
+  if (!recording.enabled() || !sampling_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  const uint64_t elapsed_time_us = end_us - buffer->run_begin_us;
+  const uint64_t latency_threshold_us =
+      latency_threshold_us_.load(std::memory_order_relaxed);
+  const bool slow =
+      latency_threshold_us > 0 && elapsed_time_us >= latency_threshold_us;
+  // The buffer may have been cleared or have wrapped around during the run.
+  const uint64_t num_recorded =
+      buffer->num_recorded.load(std::memory_order_relaxed);
+  const uint64_t first_sequence =
+      std::max(std::min(buffer->run_first_sequence, num_recorded),
+               num_recorded - buffer->Size());
+  {
+    absl::MutexLock lock(stats_mutex_);
+    AddLatency(run_stats_.latency, elapsed_time_us);
+    if (slow) {
+      ++run_stats_.num_slow_runs;
+    }
+    if (buffer->run_sampled || slow) {
+      ++run_stats_.num_profiled_runs;
+      AggregateOpEvents(*buffer, first_sequence);
+    }
+  }
+  // Only the aggregates are kept.
+  buffer->num_recorded.store(first_sequence, std::memory_order_release);
+}
+
+void LiteRtProfilerT::AggregateOpEvents(const ThreadBuffer& buffer,
+                                        uint64_t first_sequence) {
+  const uint64_t num_recorded =
+      buffer.num_recorded.load(std::memory_order_relaxed);
+  for (uint64_t sequence = first_sequence; sequence < num_recorded;
+       ++sequence) {
+    const Event& event = buffer.events[sequence % buffer.events.size()];
+    if (!IsOpEvent(event.event_type)) {
+      continue;
+    }
+    auto [it, inserted] = op_stats_index_.try_emplace(
+        std::make_tuple(absl::string_view(event.tag),
+                        static_cast<int>(event.event_source),
+                        event.event_metadata1, event.event_metadata2),
+        op_stats_.size());
+    if (inserted) {
+      LiteRtProfilerOpStats op_stats = {};
+      op_stats.tag = event.tag;
+      op_stats.event_source = event.event_source;
+      op_stats.event_metadata1 = event.event_metadata1;
+      op_stats.event_metadata2 = event.event_metadata2;
+      op_stats_.push_back(op_stats);
+    }
+    AddLatency(op_stats_[it->second].latency, event.elapsed_time_us);
+  }
+}
+
+void LiteRtProfilerT::ClearStats() {
+  absl::MutexLock lock(stats_mutex_);
+  num_runs_.store(0, std::memory_order_relaxed);
+  run_stats_ = {};
+  op_stats_.clear();
+  op_stats_index_.clear();
+}
+
+LiteRtProfilerRunStats LiteRtProfilerT::GetRunStats() const {
+  absl::MutexLock lock(stats_mutex_);
+  return run_stats_;
+}
+
+std::vector<LiteRtProfilerOpStats> LiteRtProfilerT::GetOpStats() const {
+  absl::MutexLock lock(stats_mutex_);
+  return op_stats_;
 }
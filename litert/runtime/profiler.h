@@ -15,23 +15,47 @@
 #ifndef THIRD_PARTY_ODML_LITERT_LITERT_CC_LITERT_PROFILER_H_
 #define THIRD_PARTY_ODML_LITERT_LITERT_CC_LITERT_PROFILER_H_
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <map>
 #include <memory>
-#include <set>
+#include <mutex>  // NOLINT(build/c++11)
 #include <string>
+#include <tuple>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"  // from @com_google_absl
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
 #include "absl/strings/str_cat.h"  // from @com_google_absl
 #include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
 #include "litert/c/litert_profiler_event.h"
 #include "tflite/core/api/profiler.h"
-#include "tflite/profiling/profile_buffer.h"
 
+// Records the events of the threads running a model, e.g. the calls of
+// Run(), RunAsync() and the kernels or partitions they run concurrently.
+//
+// Each thread records its events in its own ring buffer of `max_num_events`,
+// without locks. The buffers are merged into one timeline, ordered by time,
+// when profiling stops. When profiling is off, recording an event only loads
+// an atomic flag.
+//
+// StartProfiling(), StopProfiling() and Reset() can be called while threads
+// record events: they wait for the events being recorded, and the events
+// begun after profiling stops are dropped.
+//
+// In the sampling mode, meant to stay on in production, the profiler times
+// every run between BeginRun() and EndRun() but only records the events of
+// 1 in `sample_every_n_runs` runs, without their memory usage. The events of
+// a run are recorded while it runs, and are only aggregated into per op
+// latency histograms when the run was sampled or took longer than
+// `latency_threshold_us`. Raw events are not kept, and the events of the
+// threads outside of a run are dropped.
 class LiteRtProfilerT : public tflite::Profiler {
  public:
-  // Constructor: max_num_events for the internal buffer.
+  // Constructor: max_num_events for the buffer of each thread.
   explicit LiteRtProfilerT(size_t max_num_events = 1024 * 10);
   ~LiteRtProfilerT() override;
 
@@ -49,8 +73,16 @@ class LiteRtProfilerT : public tflite::Profiler {
                       int64_t event_metadata1,
                       int64_t event_metadata2) override;
 
+  // Ends the event of `event_handle`, which should be called on the thread
+  // that began it: an event ended on another thread may be lost if the ring
+  // buffer of its thread wraps around at the same time.
   void EndEvent(uint32_t event_handle) override;
 
+  // Ends the event and replaces its metadata, e.g. with a byte count only
+  // known once the event is over.
+  void EndEvent(uint32_t event_handle, int64_t event_metadata1,
+                int64_t event_metadata2) override;
+
   // tag is copied and owned by the profiler, caller does not need to keep
   // the string alive.
   // `metric` field has different intreptation based on `event_type`.
@@ -60,12 +92,19 @@ class LiteRtProfilerT : public tflite::Profiler {
   void AddEvent(const char* tag, EventType event_type, uint64_t metric,
                 int64_t event_metadata1, int64_t event_metadata2) override;
 
+  // Records the kernels of a run of the TFLite GPU delegate, whose data is the
+  // tflite::gpu::ProfilingInfo of the run, as events of the GPU source. The
+  // kernels are placed at their device start times, the last one ending when
+  // they are added, and the events the delegate adds for each of them next
+  // are dropped. Other events with data are ignored.
+  void AddEventWithData(const char* tag, EventType event_type,
+                        const void* data) override;
+
   // Enables profiling. Events will start being recorded.
   void StartProfiling();
 
-  // Disables profiling. No new events will be recorded.
-  // This might also trigger processing of buffered events if not done
-  // continuously.
+  // Disables profiling. No new events will be recorded, and the events of all
+  // the threads are merged into one timeline.
   void StopProfiling();
 
   // Clears all previously collected profiling data.
@@ -74,18 +113,45 @@ class LiteRtProfilerT : public tflite::Profiler {
   // Returns true if the profiler is currently enabled and recording events.
   bool IsProfiling() const;
 
-  // Returns the number of events currently in the buffer.
+  // Returns the number of events currently in the buffers.
   size_t GetNumEvents() const;
 
-  // Retrieves the collected profile events.
-  // This might involve transforming data from ProfileBuffer into
-  // ProfiledEventData.
+  // Retrieves the collected profile events of all the threads, ordered by
+  // time. While profiling, it reads the buffers the threads are recording
+  // into, so it should not race with them.
   std::vector<ProfiledEventData> GetProfiledEvents() const;
 
-  // Allows LiteRT to hint the source of the next set of events,
-  // particularly useful before calling into TFLite interpreter.
+  // Allows LiteRT to hint the source of the next set of events of the calling
+  // thread, particularly useful before calling into TFLite interpreter.
   void SetCurrentEventSource(ProfiledEventSource source);
 
+  // --- Sampling mode ---
+
+  // Switches to the sampling mode if `sample_every_n_runs` or
+  // `latency_threshold_us` is positive, or back to recording all the events
+  // otherwise. Clears all previously collected profiling data.
+  void SetSampling(int sample_every_n_runs, uint64_t latency_threshold_us);
+
+  // Returns true if the profiler is in the sampling mode.
+  bool IsSampling() const;
+
+  // Begins a run on the calling thread. Returns false if the run is not
+  // timed, because profiling is off, the profiler is not in the sampling
+  // mode or the thread is already in a run; EndRun() must be called
+  // otherwise.
+  bool BeginRun();
+
+  // Ends the run begun on the calling thread, and aggregates its events if it
+  // is profiled.
+  void EndRun();
+
+  // Returns the latencies of the runs since profiling started.
+  LiteRtProfilerRunStats GetRunStats() const;
+
+  // Returns the latencies of the ops of the profiled runs, in the order the
+  // ops first ran.
+  std::vector<LiteRtProfilerOpStats> GetOpStats() const;
+
   std::string GetProfiledEventsString() const {
     std::string result;
     for (const auto& event : GetProfiledEvents()) {
@@ -103,21 +169,72 @@ class LiteRtProfilerT : public tflite::Profiler {
     return result;
   }
 
+  // The maximum number of threads recording events. The events of the other
+  // threads are dropped.
+  static constexpr int kMaxThreads = 63;
+
  private:
-  // Collection to own unique copies of tag strings
-  std::set<std::string> owned_tags_set_;
-
-  // Internal buffer to store raw event data.
-  // tflite::profiling::ProfileBuffer is well-suited for this as it handles
-  // event handle management, timing, and can store events from multiple
-  // threads.
-  std::unique_ptr<tflite::profiling::ProfileBuffer> profile_buffer_;
-
-  bool profiling_enabled_ = false;
-  ProfiledEventSource current_event_source_ = ProfiledEventSource::LITERT;
-  // Map of event handle to event source. This is used to track the source of
-  // the events that are currently active.
-  std::map<uint32_t, ProfiledEventSource> active_event_sources_map_;
+  // The buffer of the events of one thread.
+  struct ThreadBuffer;
+
+  // Returns the buffer of the calling thread, which is created the first time,
+  // or nullptr if there are already kMaxThreads buffers.
+  ThreadBuffer* GetThreadBuffer();
+
+  // Disables profiling and waits for the threads recording an event. Returns
+  // whether profiling was enabled.
+  bool Pause();
+
+  // Appends the events of the buffers to `events`, ordered by time.
+  void MergeEvents(std::vector<ProfiledEventData>& events) const;
+
+  // Clears the buffers, which must not be recorded into.
+  void ClearBuffers();
+
+  void EndEvent(uint32_t event_handle, const int64_t* event_metadata1,
+                const int64_t* event_metadata2);
+
+  // Aggregates the op events of `buffer` from `first_sequence` into the op
+  // stats.
+  void AggregateOpEvents(const ThreadBuffer& buffer, uint64_t first_sequence)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(stats_mutex_);
+
+  // Clears the run and op stats.
+  void ClearStats();
+
+  // Identifies the profiler in the buffer caches of the threads, which may
+  // outlive it.
+  const uint64_t id_;
+  const size_t max_num_events_;
+
+  std::atomic<bool> profiling_enabled_{false};
+
+  // Guards the creation of the buffers.
+  mutable std::mutex mutex_;
+  // The buffers by slot. A slot is only set once, and the buffer lives as
+  // long as the profiler.
+  std::array<std::atomic<ThreadBuffer*>, kMaxThreads> thread_buffers_{};
+  std::atomic<int> num_thread_buffers_{0};
+
+  // The timeline of the events merged by the last StopProfiling().
+  std::vector<ProfiledEventData> merged_events_;
+
+  // The sampling mode, only changed while profiling is paused.
+  std::atomic<bool> sampling_{false};
+  std::atomic<int> sample_every_n_runs_{0};
+  std::atomic<uint64_t> latency_threshold_us_{0};
+  std::atomic<uint64_t> num_runs_{0};
+
+  // Guards the stats, which are updated once per run.
+  mutable absl::Mutex stats_mutex_;
+  LiteRtProfilerRunStats run_stats_ ABSL_GUARDED_BY(stats_mutex_) = {};
+  std::vector<LiteRtProfilerOpStats> op_stats_ ABSL_GUARDED_BY(stats_mutex_);
+  // The index of the stats of each op in `op_stats_`, by tag, event source and
+  // metadata. The tags are owned by the buffers, which keep them as long as
+  // the profiler lives.
+  absl::flat_hash_map<std::tuple<absl::string_view, int, int64_t, int64_t>,
+                      size_t>
+      op_stats_index_ ABSL_GUARDED_BY(stats_mutex_);
 };
 
 #endif  // THIRD_PARTY_ODML_LITERT_LITERT_CC_LITERT_PROFILER_H_
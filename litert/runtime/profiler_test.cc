@@ -18,6 +18,8 @@
 #include <cstdint>
 #include <cstring>
 #include <iostream>  // For simple pass/fail messages if not using a framework
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -26,6 +28,8 @@
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_profiler_event.h"
 #include "tflite/core/api/profiler.h"  // For tflite::Profiler::EventType
+#include "tflite/delegates/gpu/common/task/profiling_info.h"
+#include "tflite/delegates/gpu/tflite_profile.h"
 
 // Suggested location: tests/litert/profiler_test.cc
 
@@ -256,5 +260,229 @@ TEST(LiteRTProfiler, MaxEventsHandling) {
   std::cout << "TestMaxEventsHandling: PASSED" << std::endl;
 }
 
+TEST(LiteRTProfiler, RingBufferKeepsTheLatestEvents) {
+  LiteRtProfilerT profiler(/*max_num_events=*/2);
+  profiler.StartProfiling();
+
+  uint32_t h1 =
+      profiler.BeginEvent("E1", tflite::Profiler::EventType::DEFAULT, 1, 0);
+  profiler.EndEvent(
+      profiler.BeginEvent("E2", tflite::Profiler::EventType::DEFAULT, 2, 0));
+  profiler.EndEvent(
+      profiler.BeginEvent("E3", tflite::Profiler::EventType::DEFAULT, 3, 0));
+  // E1 was overwritten, so this must not end E3.
+  profiler.EndEvent(h1, /*event_metadata1=*/42, /*event_metadata2=*/0);
+  profiler.StopProfiling();
+
+  const auto events = profiler.GetProfiledEvents();
+  ASSERT_EQ(events.size(), 2);
+  EXPECT_EQ(strcmp(events[0].tag, "E2"), 0);
+  EXPECT_EQ(strcmp(events[1].tag, "E3"), 0);
+  EXPECT_EQ(events[1].event_metadata1, 3);
+}
+
+TEST(LiteRTProfiler, MergesTheEventsOfAllThreads) {
+  constexpr int kNumThreads = 4;
+  constexpr int kNumEventsPerThread = 100;
+  LiteRtProfilerT profiler(kNumEventsPerThread);
+  profiler.StartProfiling();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&profiler, t] {
+      profiler.SetCurrentEventSource(
+          t % 2 == 0 ? ProfiledEventSource::LITERT
+                     : ProfiledEventSource::TFLITE_INTERPRETER);
+      const std::string tag = "Thread" + std::to_string(t);
+      for (int i = 0; i < kNumEventsPerThread; ++i) {
+        uint32_t handle = profiler.BeginEvent(
+            tag.c_str(), tflite::Profiler::EventType::OPERATOR_INVOKE_EVENT, i,
+            t);
+        profiler.EndEvent(handle);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  profiler.StopProfiling();
+
+  const auto events = profiler.GetProfiledEvents();
+  ASSERT_EQ(events.size(), kNumThreads * kNumEventsPerThread);
+  EXPECT_EQ(profiler.GetNumEvents(), events.size());
+  std::vector<int64_t> next_event_of_thread(kNumThreads, 0);
+  for (size_t i = 0; i < events.size(); ++i) {
+    if (i > 0) {
+      EXPECT_LE(events[i - 1].start_timestamp_us, events[i].start_timestamp_us);
+    }
+    const int t = events[i].event_metadata2;
+    ASSERT_LT(t, kNumThreads);
+    EXPECT_EQ(events[i].tag, "Thread" + std::to_string(t));
+    EXPECT_EQ(events[i].event_source,
+              t % 2 == 0 ? ProfiledEventSource::LITERT
+                         : ProfiledEventSource::TFLITE_INTERPRETER);
+    // The events of each thread stay in order.
+    EXPECT_EQ(events[i].event_metadata1, next_event_of_thread[t]++);
+  }
+}
+
+TEST(LiteRTProfiler, StopsWhileThreadsRecord) {
+  LiteRtProfilerT profiler;
+  profiler.StartProfiling();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&profiler] {
+      for (int i = 0; i < 1000; ++i) {
+        profiler.EndEvent(profiler.BeginEvent(
+            "Event", tflite::Profiler::EventType::OPERATOR_INVOKE_EVENT, i,
+            0));
+      }
+    });
+  }
+  profiler.StopProfiling();
+  const size_t num_events = profiler.GetNumEvents();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // The events begun after profiling stopped were dropped.
+  EXPECT_EQ(profiler.GetNumEvents(), num_events);
+  EXPECT_EQ(profiler.GetProfiledEvents().size(), num_events);
+}
+
+TEST(LiteRTProfiler, SamplingAggregatesTheOpsOfSampledRuns) {
+  LiteRtProfilerT profiler;
+  profiler.SetSampling(/*sample_every_n_runs=*/2, /*latency_threshold_us=*/0);
+  EXPECT_TRUE(profiler.IsSampling());
+  profiler.StartProfiling();
+
+  // Events outside of a run are dropped.
+  profiler.AddEvent("Outside",
+                    tflite::Profiler::EventType::OPERATOR_INVOKE_EVENT, 10, 0,
+                    0);
+  for (int run = 0; run < 4; ++run) {
+    ASSERT_TRUE(profiler.BeginRun());
+    // A thread is in one run at a time.
+    EXPECT_FALSE(profiler.BeginRun());
+    for (int op = 0; op < 2; ++op) {
+      profiler.EndEvent(profiler.BeginEvent(
+          op == 0 ? "CONV_2D" : "ADD",
+          tflite::Profiler::EventType::OPERATOR_INVOKE_EVENT, op, 0));
+    }
+    profiler.AddEvent(
+        "Delegate", tflite::Profiler::EventType::DELEGATE_OPERATOR_INVOKE_EVENT,
+        /*metric=*/5, 0, 0);
+    profiler.EndEvent(profiler.BeginEvent(
+        "Other", tflite::Profiler::EventType::DEFAULT, 0, 0));
+    profiler.EndRun();
+  }
+  profiler.StopProfiling();
+
+  // Raw events are not kept.
+  EXPECT_EQ(profiler.GetNumEvents(), 0);
+  const LiteRtProfilerRunStats run_stats = profiler.GetRunStats();
+  EXPECT_EQ(run_stats.latency.count, 4);
+  EXPECT_EQ(run_stats.num_profiled_runs, 2);
+  EXPECT_EQ(run_stats.num_slow_runs, 0);
+
+  const auto op_stats = profiler.GetOpStats();
+  ASSERT_EQ(op_stats.size(), 3);
+  EXPECT_STREQ(op_stats[0].tag, "CONV_2D");
+  EXPECT_EQ(op_stats[0].event_metadata1, 0);
+  EXPECT_STREQ(op_stats[1].tag, "ADD");
+  EXPECT_EQ(op_stats[1].event_metadata1, 1);
+  EXPECT_STREQ(op_stats[2].tag, "Delegate");
+  for (const auto& op : op_stats) {
+    EXPECT_EQ(op.latency.count, 2);
+    uint64_t bucket_count = 0;
+    for (uint64_t count : op.latency.buckets) {
+      bucket_count += count;
+    }
+    EXPECT_EQ(bucket_count, 2);
+  }
+  EXPECT_EQ(op_stats[2].latency.total_time_us, 10);
+  EXPECT_EQ(op_stats[2].latency.min_time_us, 5);
+  EXPECT_EQ(op_stats[2].latency.max_time_us, 5);
+  // 5 us is in [4, 8) us.
+  EXPECT_EQ(op_stats[2].latency.buckets[3], 2);
+}
+
+TEST(LiteRTProfiler, SamplingProfilesSlowRuns) {
+  LiteRtProfilerT profiler;
+  profiler.SetSampling(/*sample_every_n_runs=*/0,
+                       /*latency_threshold_us=*/5000);
+  profiler.StartProfiling();
+
+  for (int run = 0; run < 3; ++run) {
+    ASSERT_TRUE(profiler.BeginRun());
+    uint32_t handle = profiler.BeginEvent(
+        "SLEEP", tflite::Profiler::EventType::OPERATOR_INVOKE_EVENT, 0, 0);
+    if (run == 1) {
+      SimulateWork(10000);
+    }
+    profiler.EndEvent(handle);
+    profiler.EndRun();
+  }
+  profiler.StopProfiling();
+
+  const LiteRtProfilerRunStats run_stats = profiler.GetRunStats();
+  EXPECT_EQ(run_stats.latency.count, 3);
+  EXPECT_GE(run_stats.latency.max_time_us, 10000);
+  EXPECT_EQ(run_stats.num_slow_runs, 1);
+  EXPECT_EQ(run_stats.num_profiled_runs, 1);
+  const auto op_stats = profiler.GetOpStats();
+  ASSERT_EQ(op_stats.size(), 1);
+  EXPECT_EQ(op_stats[0].latency.count, 1);
+  EXPECT_GE(op_stats[0].latency.min_time_us, 10000);
+}
+
+TEST(LiteRTProfiler, SamplingIsOffByDefault) {
+  LiteRtProfilerT profiler;
+  EXPECT_FALSE(profiler.IsSampling());
+  profiler.StartProfiling();
+  EXPECT_FALSE(profiler.BeginRun());
+
+  profiler.SetSampling(/*sample_every_n_runs=*/1, /*latency_threshold_us=*/0);
+  ASSERT_TRUE(profiler.BeginRun());
+  profiler.EndRun();
+  EXPECT_EQ(profiler.GetRunStats().latency.count, 1);
+
+  // Switching back clears the stats.
+  profiler.SetSampling(/*sample_every_n_runs=*/0, /*latency_threshold_us=*/0);
+  EXPECT_FALSE(profiler.IsSampling());
+  EXPECT_TRUE(profiler.IsProfiling());
+  EXPECT_EQ(profiler.GetRunStats().latency.count, 0);
+  EXPECT_TRUE(profiler.GetOpStats().empty());
+}
+
+TEST(LiteRTProfiler, RecordsTheGpuKernelsWithTheirDeviceTimes) {
+  tflite::gpu::ProfilingInfo profiling_info;
+  profiling_info.dispatches.resize(2);
+  profiling_info.dispatches[0].label = "conv";
+  profiling_info.dispatches[0].duration = absl::Microseconds(30);
+  profiling_info.dispatches[1].label = "add";
+  profiling_info.dispatches[1].start = absl::Microseconds(40);
+  profiling_info.dispatches[1].duration = absl::Microseconds(10);
+
+  LiteRtProfilerT profiler;
+  profiler.StartProfiling();
+  profiler.SetCurrentEventSource(ProfiledEventSource::TFLITE_DELEGATE);
+  tflite::gpu::SetTfLiteProfiler(&profiler);
+  tflite::gpu::AddTfLiteProfilerEvents(&profiling_info);
+  tflite::gpu::SetTfLiteProfiler(nullptr);
+  profiler.StopProfiling();
+
+  const auto& events = profiler.GetProfiledEvents();
+  ASSERT_EQ(events.size(), 2);
+  EXPECT_STREQ(events[0].tag, "conv");
+  EXPECT_EQ(events[0].event_source, ProfiledEventSource::GPU);
+  EXPECT_EQ(events[0].elapsed_time_us, 30);
+  EXPECT_STREQ(events[1].tag, "add");
+  EXPECT_EQ(events[1].event_source, ProfiledEventSource::GPU);
+  EXPECT_EQ(events[1].elapsed_time_us, 10);
+  EXPECT_EQ(events[1].start_timestamp_us - events[0].start_timestamp_us, 40);
+}
+
 }  // namespace
 }  // namespace litert
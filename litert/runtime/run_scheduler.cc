@@ -0,0 +1,144 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/run_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
+#include "absl/time/clock.h"  // from @com_google_absl
+#include "absl/time/time.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+
+namespace litert::internal {
+
+RunScheduler::Slot& RunScheduler::Slot::operator=(Slot&& other) {
+  if (this != &other) {
+    Release();
+    scheduler_ = std::exchange(other.scheduler_, nullptr);
+    device_ = other.device_;
+    priority_ = other.priority_;
+    deadline_ = other.deadline_;
+    sequence_ = other.sequence_;
+  }
+  return *this;
+}
+
+void RunScheduler::Slot::YieldToHigherPriority() {
+  if (scheduler_ == nullptr) {
+    return;
+  }
+  absl::MutexLock lock(scheduler_->mutex_);
+  Device& device = scheduler_->devices_[device_];
+  const bool preempted = std::any_of(
+      device.waiting.begin(), device.waiting.end(),
+      [this](const Waiter& waiter) { return waiter.priority > priority_; });
+  if (!preempted) {
+    return;
+  }
+  ++device.num_preemptions;
+  device.busy = false;
+  // Keeping the sequence number puts the run back ahead of the runs of the
+  // same priority that arrived after it.
+  scheduler_->WaitForTurn(device, {priority_, deadline_, sequence_});
+}
+
+void RunScheduler::Slot::Release() {
+  if (scheduler_ == nullptr) {
+    return;
+  }
+  absl::MutexLock lock(scheduler_->mutex_);
+  Device& device = scheduler_->devices_[device_];
+  device.busy = false;
+  if (absl::Now() > deadline_) {
+    ++device.num_missed_deadlines;
+  }
+  scheduler_ = nullptr;
+}
+
+LiteRtHwAccelerators RunScheduler::GetDevice(
+    LiteRtHwAcceleratorSet accelerators) {
+  if (accelerators & kLiteRtHwAcceleratorNpu) {
+    return kLiteRtHwAcceleratorNpu;
+  }
+  if (accelerators & kLiteRtHwAcceleratorGpu) {
+    return kLiteRtHwAcceleratorGpu;
+  }
+#if defined(__EMSCRIPTEN__)
+  if (accelerators & kLiteRtHwAcceleratorWebNn) {
+    return kLiteRtHwAcceleratorWebNn;
+  }
+#endif  // __EMSCRIPTEN__
+  return kLiteRtHwAcceleratorCpu;
+}
+
+RunScheduler::Slot RunScheduler::Acquire(LiteRtHwAccelerators device,
+                                         LiteRtRunPriority priority,
+                                         absl::Time deadline) {
+  Slot slot;
+  if (priority == kLiteRtRunPriorityNone) {
+    return slot;
+  }
+  absl::MutexLock lock(mutex_);
+  slot.scheduler_ = this;
+  slot.device_ = device;
+  slot.priority_ = priority;
+  slot.deadline_ = deadline;
+  slot.sequence_ = next_sequence_++;
+  WaitForTurn(devices_[device], {priority, deadline, slot.sequence_});
+  return slot;
+}
+
+RunScheduler::DeviceStats RunScheduler::GetDeviceStats(
+    LiteRtHwAccelerators device) const {
+  absl::MutexLock lock(mutex_);
+  DeviceStats stats;
+  auto it = devices_.find(device);
+  if (it != devices_.end()) {
+    stats.queue_depth = it->second.waiting.size() + (it->second.busy ? 1 : 0);
+    stats.num_preemptions = it->second.num_preemptions;
+    stats.num_missed_deadlines = it->second.num_missed_deadlines;
+  }
+  return stats;
+}
+
+void RunScheduler::WaitForTurn(Device& device, const Waiter& waiter) {
+  auto runs_before = [](const Waiter& a, const Waiter& b) {
+    if (a.priority != b.priority) {
+      return a.priority > b.priority;
+    }
+    if (a.deadline != b.deadline) {
+      return a.deadline < b.deadline;
+    }
+    return a.sequence < b.sequence;
+  };
+  device.waiting.push_back(waiter);
+  auto is_turn = [&device, &waiter, &runs_before]() {
+    return !device.busy &&
+           std::none_of(device.waiting.begin(), device.waiting.end(),
+                        [&](const Waiter& other) {
+                          return runs_before(other, waiter);
+                        });
+  };
+  mutex_.Await(absl::Condition(&is_turn));
+  device.waiting.erase(std::find_if(device.waiting.begin(),
+                                    device.waiting.end(),
+                                    [&waiter](const Waiter& other) {
+                                      return other.sequence == waiter.sequence;
+                                    }));
+  device.busy = true;
+}
+
+}  // namespace litert::internal
@@ -0,0 +1,119 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_RUNTIME_RUN_SCHEDULER_H_
+#define ODML_LITERT_LITERT_RUNTIME_RUN_SCHEDULER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"  // from @com_google_absl
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
+#include "absl/time/time.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+
+namespace litert::internal {
+
+// Orders the runs of the compiled models of an environment on each device.
+//
+// A device runs one scheduled run at a time. When it becomes free, the waiting
+// run with the highest priority goes first, then the one with the earliest
+// deadline, then the one that arrived first. A run yields the device between
+// its nodes, i.e. between the partitions of an accelerated graph, when a run
+// of higher priority is waiting.
+class RunScheduler {
+ public:
+  struct DeviceStats {
+    // The number of runs waiting for or using the device.
+    size_t queue_depth = 0;
+    // The number of times a run yielded the device to a run of higher
+    // priority.
+    uint64_t num_preemptions = 0;
+    // The number of runs that completed after their deadline.
+    uint64_t num_missed_deadlines = 0;
+  };
+
+  // The use of a device by a run, released on destruction.
+  class Slot {
+   public:
+    Slot() = default;
+    Slot(Slot&& other) { *this = std::move(other); }
+    Slot& operator=(Slot&& other);
+    ~Slot() { Release(); }
+
+    // Returns true if the slot holds a device.
+    explicit operator bool() const { return scheduler_ != nullptr; }
+
+    // If runs of higher priority are waiting for the device, lets them run
+    // and blocks until the device is held again.
+    void YieldToHigherPriority();
+
+   private:
+    friend class RunScheduler;
+
+    void Release();
+
+    RunScheduler* scheduler_ = nullptr;
+    LiteRtHwAccelerators device_ = kLiteRtHwAcceleratorNone;
+    LiteRtRunPriority priority_ = kLiteRtRunPriorityNone;
+    absl::Time deadline_ = absl::InfiniteFuture();
+    uint64_t sequence_ = 0;
+  };
+
+  RunScheduler() = default;
+  RunScheduler(const RunScheduler&) = delete;
+  RunScheduler& operator=(const RunScheduler&) = delete;
+
+  // Returns the device the runs on `accelerators` are ordered on: the NPU,
+  // GPU or WebNN if used, the CPU otherwise.
+  static LiteRtHwAccelerators GetDevice(LiteRtHwAcceleratorSet accelerators);
+
+  // Blocks until the run can use `device` and returns its slot. Returns an
+  // empty slot right away if `priority` is kLiteRtRunPriorityNone.
+  Slot Acquire(LiteRtHwAccelerators device, LiteRtRunPriority priority,
+               absl::Time deadline = absl::InfiniteFuture());
+
+  DeviceStats GetDeviceStats(LiteRtHwAccelerators device) const;
+
+ private:
+  struct Waiter {
+    LiteRtRunPriority priority;
+    absl::Time deadline;
+    uint64_t sequence;
+  };
+
+  struct Device {
+    bool busy = false;
+    std::vector<Waiter> waiting;
+    uint64_t num_preemptions = 0;
+    uint64_t num_missed_deadlines = 0;
+  };
+
+  // Queues `waiter` and blocks until it is its turn to use `device`.
+  void WaitForTurn(Device& device, const Waiter& waiter)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  mutable absl::Mutex mutex_;
+  // A map since waiting releases the mutex, and must keep the references to
+  // the devices valid.
+  std::map<LiteRtHwAccelerators, Device> devices_ ABSL_GUARDED_BY(mutex_);
+  uint64_t next_sequence_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace litert::internal
+
+#endif  // ODML_LITERT_LITERT_RUNTIME_RUN_SCHEDULER_H_
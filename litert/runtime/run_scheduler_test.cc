@@ -0,0 +1,162 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/run_scheduler.h"
+
+#include <cstddef>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
+#include "absl/time/clock.h"  // from @com_google_absl
+#include "absl/time/time.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+
+namespace litert::internal {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr LiteRtHwAccelerators kDevice = kLiteRtHwAcceleratorNpu;
+
+void WaitForQueueDepth(const RunScheduler& scheduler, size_t queue_depth) {
+  while (scheduler.GetDeviceStats(kDevice).queue_depth < queue_depth) {
+    absl::SleepFor(absl::Milliseconds(1));
+  }
+}
+
+class RunRecorder {
+ public:
+  void Record(int run) {
+    absl::MutexLock lock(mutex_);
+    runs_.push_back(run);
+  }
+
+  std::vector<int> runs() {
+    absl::MutexLock lock(mutex_);
+    return runs_;
+  }
+
+ private:
+  absl::Mutex mutex_;
+  std::vector<int> runs_;
+};
+
+TEST(RunSchedulerTest, GetDevice) {
+  EXPECT_EQ(RunScheduler::GetDevice(kLiteRtHwAcceleratorCpu),
+            kLiteRtHwAcceleratorCpu);
+  EXPECT_EQ(RunScheduler::GetDevice(kLiteRtHwAcceleratorCpu |
+                                    kLiteRtHwAcceleratorGpu),
+            kLiteRtHwAcceleratorGpu);
+  EXPECT_EQ(RunScheduler::GetDevice(kLiteRtHwAcceleratorCpu |
+                                    kLiteRtHwAcceleratorNpu),
+            kLiteRtHwAcceleratorNpu);
+}
+
+TEST(RunSchedulerTest, RunsWithoutPriorityAreNotScheduled) {
+  RunScheduler scheduler;
+  auto first = scheduler.Acquire(kDevice, kLiteRtRunPriorityNone);
+  auto second = scheduler.Acquire(kDevice, kLiteRtRunPriorityNone);
+  EXPECT_FALSE(first);
+  EXPECT_FALSE(second);
+  EXPECT_EQ(scheduler.GetDeviceStats(kDevice).queue_depth, 0);
+}
+
+TEST(RunSchedulerTest, RunsHigherPriorityFirst) {
+  RunScheduler scheduler;
+  RunRecorder recorder;
+  auto slot = scheduler.Acquire(kDevice, kLiteRtRunPriorityNormal);
+  ASSERT_TRUE(slot);
+
+  std::thread low([&]() {
+    auto slot = scheduler.Acquire(kDevice, kLiteRtRunPriorityLow);
+    recorder.Record(0);
+  });
+  WaitForQueueDepth(scheduler, 2);
+  std::thread high([&]() {
+    auto slot = scheduler.Acquire(kDevice, kLiteRtRunPriorityHigh);
+    recorder.Record(1);
+  });
+  WaitForQueueDepth(scheduler, 3);
+
+  slot = RunScheduler::Slot();
+  low.join();
+  high.join();
+  EXPECT_THAT(recorder.runs(), ElementsAre(1, 0));
+  EXPECT_EQ(scheduler.GetDeviceStats(kDevice).queue_depth, 0);
+}
+
+TEST(RunSchedulerTest, RunsEarliestDeadlineFirst) {
+  RunScheduler scheduler;
+  RunRecorder recorder;
+  auto slot = scheduler.Acquire(kDevice, kLiteRtRunPriorityNormal);
+
+  const absl::Time now = absl::Now();
+  std::thread late([&]() {
+    auto slot = scheduler.Acquire(kDevice, kLiteRtRunPriorityNormal,
+                                  now + absl::Hours(2));
+    recorder.Record(0);
+  });
+  WaitForQueueDepth(scheduler, 2);
+  std::thread early([&]() {
+    auto slot = scheduler.Acquire(kDevice, kLiteRtRunPriorityNormal,
+                                  now + absl::Hours(1));
+    recorder.Record(1);
+  });
+  WaitForQueueDepth(scheduler, 3);
+
+  slot = RunScheduler::Slot();
+  late.join();
+  early.join();
+  EXPECT_THAT(recorder.runs(), ElementsAre(1, 0));
+}
+
+TEST(RunSchedulerTest, YieldsToHigherPriority) {
+  RunScheduler scheduler;
+  RunRecorder recorder;
+  auto slot = scheduler.Acquire(kDevice, kLiteRtRunPriorityLow);
+  slot.YieldToHigherPriority();
+  EXPECT_EQ(scheduler.GetDeviceStats(kDevice).num_preemptions, 0);
+
+  std::thread high([&]() {
+    auto slot = scheduler.Acquire(kDevice, kLiteRtRunPriorityHigh);
+    recorder.Record(1);
+  });
+  WaitForQueueDepth(scheduler, 2);
+  slot.YieldToHigherPriority();
+  recorder.Record(0);
+  high.join();
+
+  EXPECT_THAT(recorder.runs(), ElementsAre(1, 0));
+  const auto stats = scheduler.GetDeviceStats(kDevice);
+  EXPECT_EQ(stats.queue_depth, 1);
+  EXPECT_EQ(stats.num_preemptions, 1);
+}
+
+TEST(RunSchedulerTest, CountsMissedDeadlines) {
+  RunScheduler scheduler;
+  {
+    auto slot = scheduler.Acquire(kDevice, kLiteRtRunPriorityNormal,
+                                  absl::Now() - absl::Seconds(1));
+  }
+  {
+    auto slot = scheduler.Acquire(kDevice, kLiteRtRunPriorityNormal);
+  }
+  EXPECT_EQ(scheduler.GetDeviceStats(kDevice).num_missed_deadlines, 1);
+}
+
+}  // namespace
+}  // namespace litert::internal
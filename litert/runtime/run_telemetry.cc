@@ -0,0 +1,103 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/run_telemetry.h"
+
+#include <cstdint>
+
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+#include "litert/c/litert_telemetry.h"
+#include "litert/core/environment.h"
+#include "litert/runtime/tensor_buffer.h"
+#include "tflite/profiling/time.h"
+
+namespace litert::internal {
+namespace {
+
+uint64_t GetBufferTypes(absl::Span<const LiteRtTensorBuffer> buffers) {
+  uint64_t buffer_types = 0;
+  for (LiteRtTensorBuffer buffer : buffers) {
+    if (buffer == nullptr) continue;
+    const int buffer_type = buffer->buffer_type();
+    if (buffer_type >= 0 && buffer_type < 64) {
+      buffer_types |= uint64_t{1} << buffer_type;
+    }
+  }
+  return buffer_types;
+}
+
+}  // namespace
+
+RunTelemetryRecorder::RunTelemetryRecorder(LiteRtEnvironmentT* env) {
+  if (env == nullptr || !env->HasTelemetrySink()) {
+    return;
+  }
+  env_ = env;
+  begin_us_ = tflite::profiling::time::NowMicros();
+  // Until the invocation reports otherwise, the run failed before it.
+  record_.status = kLiteRtStatusErrorRuntimeFailure;
+}
+
+RunTelemetryRecorder::RunTelemetryRecorder(RunTelemetryRecorder&& other)
+    : env_(other.env_),
+      record_(other.record_),
+      begin_us_(other.begin_us_),
+      invoke_begin_us_(other.invoke_begin_us_),
+      invoke_end_us_(other.invoke_end_us_) {
+  other.env_ = nullptr;
+}
+
+void RunTelemetryRecorder::SetRun(
+    const char* signature_key, LiteRtHwAcceleratorSet accelerators,
+    absl::Span<const LiteRtTensorBuffer> input_buffers,
+    absl::Span<const LiteRtTensorBuffer> output_buffers) {
+  if (!IsRecording()) return;
+  record_.signature_key = signature_key;
+  record_.accelerators = accelerators;
+  record_.num_inputs = static_cast<int32_t>(input_buffers.size());
+  record_.num_outputs = static_cast<int32_t>(output_buffers.size());
+  record_.input_buffer_types = GetBufferTypes(input_buffers);
+  record_.output_buffer_types = GetBufferTypes(output_buffers);
+}
+
+void RunTelemetryRecorder::BeginInvoke() {
+  if (!IsRecording()) return;
+  invoke_begin_us_ = tflite::profiling::time::NowMicros();
+  record_.queue_time_us = invoke_begin_us_ - begin_us_;
+}
+
+void RunTelemetryRecorder::EndInvoke(LiteRtStatus status) {
+  if (!IsRecording()) return;
+  invoke_end_us_ = tflite::profiling::time::NowMicros();
+  record_.run_time_us = invoke_end_us_ - invoke_begin_us_;
+  record_.status = status;
+}
+
+void RunTelemetryRecorder::EndSync(bool async) {
+  if (!IsRecording()) return;
+  record_.async = async;
+  if (invoke_end_us_ != 0) {
+    record_.sync_time_us =
+        tflite::profiling::time::NowMicros() - invoke_end_us_;
+  }
+}
+
+void RunTelemetryRecorder::Report() {
+  if (!IsRecording()) return;
+  env_->ReportRunTelemetry(record_);
+  env_ = nullptr;
+}
+
+}  // namespace litert::internal
@@ -0,0 +1,75 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_RUNTIME_RUN_TELEMETRY_H_
+#define ODML_LITERT_LITERT_RUNTIME_RUN_TELEMETRY_H_
+
+#include <cstdint>
+
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+#include "litert/c/litert_telemetry.h"
+#include "litert/core/environment.h"
+
+namespace litert::internal {
+
+// Measures a run of a compiled model and reports it to the telemetry sink of
+// the environment, at the latest when destroyed. Does nothing and costs a
+// load if the environment has no sink when the run starts.
+//
+// The record is filled in place, so measuring a run doesn't allocate. A run
+// that completes asynchronously takes the recorder with it.
+class RunTelemetryRecorder {
+ public:
+  explicit RunTelemetryRecorder(LiteRtEnvironmentT* env);
+  ~RunTelemetryRecorder() { Report(); }
+
+  RunTelemetryRecorder(RunTelemetryRecorder&& other);
+  RunTelemetryRecorder& operator=(RunTelemetryRecorder&&) = delete;
+  RunTelemetryRecorder(const RunTelemetryRecorder&) = delete;
+  RunTelemetryRecorder& operator=(const RunTelemetryRecorder&) = delete;
+
+  bool IsRecording() const { return env_ != nullptr; }
+
+  // `signature_key` must outlive the recorder. Null input buffers, i.e. the
+  // inputs bound to external buffers, are skipped.
+  void SetRun(const char* signature_key, LiteRtHwAcceleratorSet accelerators,
+              absl::Span<const LiteRtTensorBuffer> input_buffers,
+              absl::Span<const LiteRtTensorBuffer> output_buffers);
+
+  void BeginInvoke();
+  void EndInvoke(LiteRtStatus status);
+
+  // Ends waiting for the outputs. `async` is true if the run completes after
+  // its call returns.
+  void EndSync(bool async);
+
+  void SetStatus(LiteRtStatus status) {
+    if (IsRecording()) record_.status = status;
+  }
+
+  // Reports the run, once.
+  void Report();
+
+ private:
+  LiteRtEnvironmentT* env_ = nullptr;
+  LiteRtRunTelemetry record_ = {};
+  uint64_t begin_us_ = 0;
+  uint64_t invoke_begin_us_ = 0;
+  uint64_t invoke_end_us_ = 0;
+};
+
+}  // namespace litert::internal
+
+#endif  // ODML_LITERT_LITERT_RUNTIME_RUN_TELEMETRY_H_
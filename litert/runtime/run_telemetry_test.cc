@@ -0,0 +1,116 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/run_telemetry.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "litert/c/litert_common.h"
+#include "litert/c/litert_telemetry.h"
+#include "litert/core/environment.h"
+
+namespace litert::internal {
+namespace {
+
+struct Record {
+  std::string signature_key;
+  LiteRtRunTelemetry telemetry;
+};
+
+void CollectRecord(void* user_data, const LiteRtRunTelemetry* telemetry) {
+  auto* records = static_cast<std::vector<Record>*>(user_data);
+  records->push_back({telemetry->signature_key, *telemetry});
+}
+
+TEST(RunTelemetryRecorderTest, DoesNothingWithoutSink) {
+  LiteRtEnvironmentT env;
+  RunTelemetryRecorder telemetry(&env);
+  EXPECT_FALSE(telemetry.IsRecording());
+
+  RunTelemetryRecorder no_env(nullptr);
+  EXPECT_FALSE(no_env.IsRecording());
+}
+
+TEST(RunTelemetryRecorderTest, ReportsTheRunWhenDestroyed) {
+  LiteRtEnvironmentT env;
+  std::vector<Record> records;
+  env.SetTelemetrySink(&CollectRecord, &records);
+  {
+    RunTelemetryRecorder telemetry(&env);
+    ASSERT_TRUE(telemetry.IsRecording());
+    telemetry.SetRun("serving_default", kLiteRtHwAcceleratorCpu, {}, {});
+    telemetry.BeginInvoke();
+    telemetry.EndInvoke(kLiteRtStatusOk);
+    telemetry.EndSync(/*async=*/false);
+    EXPECT_TRUE(records.empty());
+  }
+  ASSERT_EQ(records.size(), 1);
+  EXPECT_EQ(records[0].signature_key, "serving_default");
+  EXPECT_EQ(records[0].telemetry.accelerators, kLiteRtHwAcceleratorCpu);
+  EXPECT_EQ(records[0].telemetry.status, kLiteRtStatusOk);
+  EXPECT_FALSE(records[0].telemetry.async);
+  EXPECT_EQ(records[0].telemetry.num_inputs, 0);
+  EXPECT_EQ(records[0].telemetry.input_buffer_types, 0);
+}
+
+TEST(RunTelemetryRecorderTest, ReportsAFailureBeforeTheInvocation) {
+  LiteRtEnvironmentT env;
+  std::vector<Record> records;
+  env.SetTelemetrySink(&CollectRecord, &records);
+  {
+    RunTelemetryRecorder telemetry(&env);
+    telemetry.SetRun("serving_default", kLiteRtHwAcceleratorCpu, {}, {});
+  }
+  ASSERT_EQ(records.size(), 1);
+  EXPECT_NE(records[0].telemetry.status, kLiteRtStatusOk);
+  EXPECT_EQ(records[0].telemetry.run_time_us, 0);
+}
+
+TEST(RunTelemetryRecorderTest, ReportsOnceWhenMoved) {
+  LiteRtEnvironmentT env;
+  std::vector<Record> records;
+  env.SetTelemetrySink(&CollectRecord, &records);
+  {
+    RunTelemetryRecorder telemetry(&env);
+    telemetry.SetRun("encode", kLiteRtHwAcceleratorGpu, {}, {});
+    RunTelemetryRecorder moved(std::move(telemetry));
+    EXPECT_FALSE(telemetry.IsRecording());  // NOLINT(bugprone-use-after-move)
+    moved.BeginInvoke();
+    moved.EndInvoke(kLiteRtStatusOk);
+    moved.EndSync(/*async=*/true);
+    moved.Report();
+    EXPECT_EQ(records.size(), 1);
+  }
+  ASSERT_EQ(records.size(), 1);
+  EXPECT_EQ(records[0].signature_key, "encode");
+  EXPECT_TRUE(records[0].telemetry.async);
+}
+
+TEST(RunTelemetryRecorderTest, StopsRecordingOnceTheSinkIsCleared) {
+  LiteRtEnvironmentT env;
+  std::vector<Record> records;
+  env.SetTelemetrySink(&CollectRecord, &records);
+  env.SetTelemetrySink(nullptr, nullptr);
+  {
+    RunTelemetryRecorder telemetry(&env);
+    EXPECT_FALSE(telemetry.IsRecording());
+  }
+  EXPECT_TRUE(records.empty());
+}
+
+}  // namespace
+}  // namespace litert::internal
@@ -0,0 +1,77 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/serial_executor.h"
+
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
+
+namespace litert::internal {
+
+SerialExecutor::~SerialExecutor() {
+  {
+    absl::MutexLock lock(mutex_);
+    shutdown_ = true;
+  }
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void SerialExecutor::Schedule(Task task) {
+  absl::MutexLock lock(mutex_);
+  tasks_.push_back(std::move(task));
+  if (!worker_.joinable()) {
+    worker_ = std::thread(&SerialExecutor::WorkerLoop, this);
+  }
+}
+
+void SerialExecutor::WaitForIdle() {
+  absl::MutexLock lock(mutex_);
+  mutex_.Await(absl::Condition(this, &SerialExecutor::IsIdle));
+}
+
+bool SerialExecutor::IsBusy() const {
+  absl::MutexLock lock(mutex_);
+  return !IsIdle();
+}
+
+bool SerialExecutor::IsIdle() const { return tasks_.empty() && !running_task_; }
+
+bool SerialExecutor::HasTaskOrShutdown() const {
+  return !tasks_.empty() || shutdown_;
+}
+
+void SerialExecutor::WorkerLoop() {
+  while (true) {
+    Task task;
+    {
+      absl::MutexLock lock(mutex_);
+      mutex_.Await(absl::Condition(this, &SerialExecutor::HasTaskOrShutdown));
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+      running_task_ = true;
+    }
+    std::move(task)();
+    absl::MutexLock lock(mutex_);
+    running_task_ = false;
+  }
+}
+
+}  // namespace litert::internal
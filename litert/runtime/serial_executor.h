@@ -0,0 +1,64 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_RUNTIME_SERIAL_EXECUTOR_H_
+#define ODML_LITERT_LITERT_RUNTIME_SERIAL_EXECUTOR_H_
+
+#include <deque>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "absl/base/thread_annotations.h"  // from @com_google_absl
+#include "absl/functional/any_invocable.h"  // from @com_google_absl
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
+
+namespace litert::internal {
+
+// Runs tasks one at a time, in scheduling order, on a dedicated thread.
+//
+// The thread is only started when the first task is scheduled. The destructor
+// runs all the pending tasks before joining the thread.
+class SerialExecutor {
+ public:
+  using Task = absl::AnyInvocable<void() &&>;
+
+  SerialExecutor() = default;
+  SerialExecutor(const SerialExecutor&) = delete;
+  SerialExecutor& operator=(const SerialExecutor&) = delete;
+  ~SerialExecutor();
+
+  // Schedules `task` to run after all the previously scheduled tasks.
+  void Schedule(Task task);
+
+  // Blocks until all the scheduled tasks have run. Must not be called from a
+  // task.
+  void WaitForIdle();
+
+  // Returns true if a task is running or pending.
+  bool IsBusy() const;
+
+ private:
+  void WorkerLoop();
+  bool IsIdle() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  bool HasTaskOrShutdown() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  mutable absl::Mutex mutex_;
+  std::deque<Task> tasks_ ABSL_GUARDED_BY(mutex_);
+  bool running_task_ ABSL_GUARDED_BY(mutex_) = false;
+  bool shutdown_ ABSL_GUARDED_BY(mutex_) = false;
+  std::thread worker_;
+};
+
+}  // namespace litert::internal
+
+#endif  // ODML_LITERT_LITERT_RUNTIME_SERIAL_EXECUTOR_H_
@@ -0,0 +1,61 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/serial_executor.h"
+
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/synchronization/notification.h"  // from @com_google_absl
+
+namespace litert::internal {
+namespace {
+
+using ::testing::ElementsAre;
+
+TEST(SerialExecutorTest, RunsTasksInOrder) {
+  std::vector<int> order;
+  SerialExecutor executor;
+  for (int i = 0; i < 4; ++i) {
+    executor.Schedule([&order, i]() { order.push_back(i); });
+  }
+  executor.WaitForIdle();
+  EXPECT_FALSE(executor.IsBusy());
+  EXPECT_THAT(order, ElementsAre(0, 1, 2, 3));
+}
+
+TEST(SerialExecutorTest, IsBusyWhileTaskRuns) {
+  absl::Notification release;
+  SerialExecutor executor;
+  executor.Schedule([&release]() { release.WaitForNotification(); });
+  EXPECT_TRUE(executor.IsBusy());
+  release.Notify();
+  executor.WaitForIdle();
+  EXPECT_FALSE(executor.IsBusy());
+}
+
+TEST(SerialExecutorTest, DestructorRunsPendingTasks) {
+  int count = 0;
+  {
+    SerialExecutor executor;
+    for (int i = 0; i < 8; ++i) {
+      executor.Schedule([&count]() { ++count; });
+    }
+  }
+  EXPECT_EQ(count, 8);
+}
+
+}  // namespace
+}  // namespace litert::internal
@@ -16,6 +16,8 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -26,8 +28,10 @@
 
 #include "xnnpack.h"  // from @XNNPACK
 #include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
+#include "litert/c/internal/litert_tensor_buffer_registry.h"
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_model_types.h"
 #include "litert/c/litert_tensor_buffer_types.h"
@@ -37,6 +41,8 @@
 #include "litert/core/util/tensor_type_util.h"
 #include "litert/runtime/custom_buffer.h"
 #include "litert/runtime/event.h"
+#include "litert/runtime/tensor_buffer_pool.h"
+#include "litert/runtime/tensor_buffer_registry.h"
 
 #if LITERT_HAS_OPENCL_SUPPORT
 #include "litert/runtime/open_cl_memory.h"
@@ -80,6 +86,27 @@ void Copy(size_t array_size, const T* array, std::vector<T>& vec) {
 // in another function.
 void FreeHostMemory(void* ptr) { litert_aligned_free(ptr); }
 
+// The lock count of a write locked buffer.
+constexpr int32_t kWriteLockCount = -1;
+
+void DeleteTensorBuffer(LiteRtTensorBufferT* tensor_buffer) {
+  delete tensor_buffer;
+}
+
+// Returns the tensor buffer pool of `env`, or nullptr if there is none.
+litert::internal::TensorBufferPool* GetTensorBufferPool(LiteRtEnvironment env) {
+  if (env == nullptr) {
+    return nullptr;
+  }
+  void* registry = nullptr;
+  if (LiteRtGetTensorBufferRegistry(env, &registry) != kLiteRtStatusOk ||
+      registry == nullptr) {
+    return nullptr;
+  }
+  return &static_cast<litert::internal::TensorBufferRegistry*>(registry)
+              ->GetBufferPool();
+}
+
 }  // namespace
 
 // C API defined in environment.cc to workaround Windows build issue.
@@ -107,10 +134,24 @@ LiteRtTensorBufferT::LiteRtTensorBufferT(
       buffer_size_(buffer_size),
       buffer_offset_(buffer_offset),
       ref_(1) {
+  SetTensorType(tensor_type);
+// Our Emscripten builds process this as an error rather than a debug log, so
+// disabling for web platform temporarily to avoid breakages.
+#ifndef __EMSCRIPTEN__
+  LITERT_LOG(LITERT_DEBUG, "Created tensor buffer %p of type %s", this,
+             BufferTypeToString(buffer_type_).data());
+#endif  // __EMSCRIPTEN__
+}
+
+void LiteRtTensorBufferT::SetTensorType(
+    const LiteRtRankedTensorType& tensor_type) {
+  tensor_type_ = tensor_type;
   // Copy local memory passed by the caller.
   Copy(tensor_type_.layout.rank, tensor_type_.layout.dimensions, dimensions_);
   if (tensor_type_.layout.has_strides) {
     Copy(tensor_type_.layout.rank, tensor_type_.layout.strides, strides_);
+  } else {
+    strides_.clear();
   }
   auto packed_size = litert::internal::GetNumPackedBytes(tensor_type_);
   if (!packed_size) {
@@ -119,12 +160,46 @@ LiteRtTensorBufferT::LiteRtTensorBufferT(
   } else {
     packed_buffer_size_ = *packed_size;
   }
-// Our Emscripten builds process this as an error rather than a debug log, so
-// disabling for web platform temporarily to avoid breakages.
-#ifndef __EMSCRIPTEN__
-  LITERT_LOG(LITERT_DEBUG, "Created tensor buffer %p of type %s", this,
-             BufferTypeToString(buffer_type_).data());
-#endif  // __EMSCRIPTEN__
+}
+
+void LiteRtTensorBufferT::ResetForReuse(
+    const LiteRtRankedTensorType& tensor_type) {
+  SetTensorType(tensor_type);
+  event_ = nullptr;
+  // Memory backed buffers may have been created for the previous tensor type.
+  memory_backed_buffers_.clear();
+  lock_count_.store(0, std::memory_order_relaxed);
+  locked_host_memory_.store(nullptr, std::memory_order_relaxed);
+  content_version_.store(NextContentVersion(), std::memory_order_relaxed);
+  ref_.store(1, std::memory_order_relaxed);
+}
+
+uint64_t LiteRtTensorBufferT::NextContentVersion() {
+  static std::atomic<uint64_t> next_content_version{1};
+  return next_content_version.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LiteRtTensorBufferT::Destroy(LiteRtTensorBufferT* tensor_buffer) {
+  if (tensor_buffer->pool_ == nullptr || !tensor_buffer->pool_key_ ||
+      tensor_buffer->IsLocked()) {
+    delete tensor_buffer;
+    return;
+  }
+  // The buffer may still be in use by the device that signals the event.
+  if (tensor_buffer->event_ != nullptr) {
+    if (auto status = tensor_buffer->event_->Wait(/*timeout_in_ms=*/-1);
+        !status) {
+      LITERT_LOG(LITERT_WARNING,
+                 "Failed to wait for tensor buffer event, not pooling: %s",
+                 status.Error().Message().c_str());
+      delete tensor_buffer;
+      return;
+    }
+  }
+  auto* pool = tensor_buffer->pool_;
+  auto key = *tensor_buffer->pool_key_;
+  pool->Release(key, litert::internal::TensorBufferPool::Buffer(
+                         tensor_buffer, &DeleteTensorBuffer));
 }
 
 LiteRtTensorBufferT::~LiteRtTensorBufferT() {
@@ -491,8 +566,6 @@ LiteRtTensorBufferT::CreateManagedMetalMemory(
   return tensor_buffer;
 }
 
-// TODO b/426869066 - Add CreateFromVulkanMemory to support zero-copy scenarios
-// of Vulkan memory.
 Expected<LiteRtTensorBufferT::Ptr>
 LiteRtTensorBufferT::CreateManagedVulkanMemory(
     LiteRtEnvironment env, const LiteRtRankedTensorType& tensor_type,
@@ -576,6 +649,30 @@ Expected<LiteRtTensorBufferT::Ptr> LiteRtTensorBufferT::CreateFromMetalMemory(
 }
 #endif  // LITERT_HAS_METAL_SUPPORT
 
+#if LITERT_HAS_VULKAN_SUPPORT
+Expected<LiteRtTensorBufferT::Ptr> LiteRtTensorBufferT::CreateFromVulkanMemory(
+    LiteRtEnvironment env, const LiteRtRankedTensorType& tensor_type,
+    LiteRtTensorBufferType buffer_type, HwMemoryHandle vulkan_memory,
+    size_t buffer_size, LiteRtVulkanMemoryDeallocator deallocator) {
+  if (!IsVulkanMemory(buffer_type)) {
+    return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                      "Buffer type is not a Vulkan memory type");
+  }
+  LITERT_ASSIGN_OR_RETURN(size_t packed_size,
+                          litert::internal::GetNumPackedBytes(tensor_type));
+  LITERT_ASSIGN_OR_RETURN(litert::internal::CustomBuffer custom_buffer,
+                          litert::internal::CustomBuffer::Wrap(
+                              env, tensor_type, buffer_type, vulkan_memory,
+                              buffer_size, packed_size, deallocator));
+
+  Ptr tensor_buffer(
+      new LiteRtTensorBufferT(env, tensor_type, buffer_type, buffer_size));
+  tensor_buffer->buffer_.emplace<litert::internal::CustomBuffer>(
+      std::move(custom_buffer));
+  return tensor_buffer;
+}
+#endif  // LITERT_HAS_VULKAN_SUPPORT
+
 Expected<LiteRtTensorBufferT::Ptr> LiteRtTensorBufferT::CreateManaged(
     LiteRtEnvironment env, LiteRtTensorBufferType buffer_type,
     const LiteRtRankedTensorType& tensor_type, size_t buffer_size) {
@@ -588,6 +685,36 @@ LiteRtTensorBufferT::CreateManagedWithAlignment(
     LiteRtEnvironment env, LiteRtTensorBufferType buffer_type,
     const LiteRtRankedTensorType& tensor_type, size_t buffer_size,
     size_t alignment) {
+  auto* pool = GetTensorBufferPool(env);
+  if (pool == nullptr || !pool->IsEnabled() ||
+      !litert::internal::TensorBufferPool::IsPoolable(buffer_type)) {
+    return AllocateManaged(env, buffer_type, tensor_type, buffer_size,
+                           alignment);
+  }
+
+  litert::internal::TensorBufferPool::Key key{buffer_type, buffer_size,
+                                              alignment};
+  if (auto* pooled_buffer = pool->Acquire(key); pooled_buffer != nullptr) {
+    Ptr tensor_buffer(pooled_buffer);
+    tensor_buffer->ResetForReuse(tensor_type);
+    if (auto status = tensor_buffer->IsValid(); !status) {
+      return Unexpected(status.Error());
+    }
+    return tensor_buffer;
+  }
+
+  LITERT_ASSIGN_OR_RETURN(Ptr tensor_buffer,
+                          AllocateManaged(env, buffer_type, tensor_type,
+                                          buffer_size, alignment));
+  tensor_buffer->pool_ = pool;
+  tensor_buffer->pool_key_ = key;
+  return tensor_buffer;
+}
+
+Expected<LiteRtTensorBufferT::Ptr> LiteRtTensorBufferT::AllocateManaged(
+    LiteRtEnvironment env, LiteRtTensorBufferType buffer_type,
+    const LiteRtRankedTensorType& tensor_type, size_t buffer_size,
+    size_t alignment) {
   switch (buffer_type) {
     case kLiteRtTensorBufferTypeHostMemory:
       return CreateManagedOnHostMemory(tensor_type, buffer_size, alignment);
@@ -905,12 +1032,90 @@ LiteRtTensorBufferT::GetCustomBuffer() {
                     "Unexpected tensor buffer type");
 }
 
+size_t LiteRtTensorBufferT::LockableSize() const {
+  // The host memory of GPU buffers holds the packed tensor, which can be
+  // larger than the device buffer, e.g. for fp16 buffers.
+  return std::max(buffer_size_, packed_buffer_size_);
+}
+
 Expected<void*> LiteRtTensorBufferT::Lock(LiteRtTensorBufferLockMode mode) {
-  LITERT_RETURN_IF_ERROR(is_locked_ == false,
+  return Lock(mode, /*offset=*/0, LockableSize());
+}
+
+Expected<void*> LiteRtTensorBufferT::Lock(LiteRtTensorBufferLockMode mode,
+                                          size_t offset, size_t size) {
+  LITERT_RETURN_IF_ERROR(
+      offset <= LockableSize() && size <= LockableSize() - offset,
+      Unexpected(kLiteRtStatusErrorIndexOOB,
+                 absl::StrFormat("Lock range [%zu, %zu) exceeds the buffer "
+                                 "size %zu",
+                                 offset, offset + size, LockableSize())));
+  const bool read_only = mode == kLiteRtTensorBufferLockModeRead;
+  if (read_only) {
+    // Join the current readers, if any, without taking the mutex.
+    int32_t count = lock_count_.load(std::memory_order_acquire);
+    while (count > 0) {
+      if (lock_count_.compare_exchange_weak(count, count + 1,
+                                            std::memory_order_acquire)) {
+        return static_cast<char*>(
+                   locked_host_memory_.load(std::memory_order_acquire)) +
+               offset;
+      }
+    }
+  }
+
+  absl::MutexLock lock(lock_mutex_);
+  int32_t count = lock_count_.load(std::memory_order_acquire);
+  if (count > 0 && read_only) {
+    lock_count_.fetch_add(1, std::memory_order_acquire);
+    return static_cast<char*>(
+               locked_host_memory_.load(std::memory_order_acquire)) +
+           offset;
+  }
+  LITERT_RETURN_IF_ERROR(count == 0,
                          Unexpected(kLiteRtStatusErrorRuntimeFailure,
                                     "Tensor buffer is already locked."));
-  is_locked_ = true;
-  if (event_ != nullptr) {
+  LITERT_ASSIGN_OR_RETURN(void* host_memory,
+                          LockBuffer(mode, offset, size));
+  locked_host_memory_.store(host_memory, std::memory_order_release);
+  if (read_only) {
+    dirty_offset_ = 0;
+    dirty_size_ = 0;
+    lock_count_.store(1, std::memory_order_release);
+  } else {
+    dirty_offset_ = offset;
+    dirty_size_ = size;
+    MarkContentModified();
+    lock_count_.store(kWriteLockCount, std::memory_order_release);
+  }
+  return static_cast<char*>(host_memory) + offset;
+}
+
+bool LiteRtTensorBufferT::OwnsHostMemory() const {
+  const auto* host_buffer = std::get_if<HostBuffer>(&buffer_);
+  return host_buffer != nullptr && host_buffer->deallocator == FreeHostMemory;
+}
+
+bool LiteRtTensorBufferT::HasPendingEvent() const {
+  if (event_ == nullptr) {
+    return false;
+  }
+  // A host event signaled by a failed operation stays pending, so that locking
+  // the buffer waits on it and returns the error.
+  if (event_->type == LiteRtEventTypeHost && event_->host_state != nullptr &&
+      event_->host_state->notification.HasBeenNotified() &&
+      event_->host_state->status != kLiteRtStatusOk) {
+    return true;
+  }
+  auto is_signaled = event_->IsSignaled();
+  return !is_signaled || !*is_signaled;
+}
+
+Expected<void*> LiteRtTensorBufferT::LockBuffer(
+    LiteRtTensorBufferLockMode mode, size_t offset, size_t size) {
+  // Signaled events don't need a wait nor a fence handed to the driver.
+  const bool has_pending_event = HasPendingEvent();
+  if (has_pending_event) {
     // Only AHWB supports waiting on an input sync fence when locking the
     // buffer. For all other buffer types we wait here.
     if (buffer_type() != kLiteRtTensorBufferTypeAhwb) {
@@ -927,7 +1132,7 @@ Expected<void*> LiteRtTensorBufferT::Lock(LiteRtTensorBufferLockMode mode) {
 #if LITERT_HAS_AHWB_SUPPORT
       LITERT_ASSIGN_OR_ABORT(auto ahwb_buffer, GetAhwbBuffer());
       return litert::internal::AhwbBuffer::Lock(
-          ahwb_buffer, event_ != nullptr ? event_.get() : nullptr);
+          ahwb_buffer, has_pending_event ? event_.get() : nullptr);
 #else
       return Unexpected(kLiteRtStatusErrorRuntimeFailure,
                         "AHardwareBuffer is not supported");
@@ -955,7 +1160,7 @@ Expected<void*> LiteRtTensorBufferT::Lock(LiteRtTensorBufferLockMode mode) {
 #if LITERT_HAS_OPENCL_SUPPORT
       LITERT_ASSIGN_OR_ABORT(auto opencl_memory, GetOpenClMemory());
       LITERT_ASSIGN_OR_RETURN(float* const host_memory_ptr,
-                              opencl_memory->Lock<float>(mode));
+                              opencl_memory->Lock<float>(mode, offset, size));
       return host_memory_ptr;
 #else
       return Unexpected(kLiteRtStatusErrorRuntimeFailure,
@@ -965,8 +1170,14 @@ Expected<void*> LiteRtTensorBufferT::Lock(LiteRtTensorBufferLockMode mode) {
     case kLiteRtTensorBufferTypeGlBuffer: {
 #if LITERT_HAS_OPENGL_SUPPORT
       LITERT_ASSIGN_OR_RETURN(auto gl_buffer, GetGlBuffer());
+      // The GL commands writing the buffer are complete once its EGL fence is
+      // signaled, so only the frame that produced it is waited for.
+      const bool gl_work_synced =
+          event_ != nullptr &&
+          (event_->type == LiteRtEventTypeEglSyncFence ||
+           event_->type == LiteRtEventTypeEglNativeSyncFence);
       LITERT_ASSIGN_OR_RETURN(float* const host_memory_ptr,
-                              gl_buffer->Lock<float>());
+                              gl_buffer->Lock<float>(gl_work_synced));
       return host_memory_ptr;
 #else
       return Unexpected(kLiteRtStatusErrorRuntimeFailure,
@@ -1006,10 +1217,41 @@ Expected<void*> LiteRtTensorBufferT::Lock(LiteRtTensorBufferLockMode mode) {
 }
 
 Expected<void> LiteRtTensorBufferT::Unlock() {
-  LITERT_RETURN_IF_ERROR(is_locked_ == true,
-                         Unexpected(kLiteRtStatusErrorRuntimeFailure,
-                                    "Tensor buffer is already unlocked."));
-  is_locked_ = false;
+  // Leave the other readers, if any, without taking the mutex.
+  int32_t count = lock_count_.load(std::memory_order_acquire);
+  while (count > 1) {
+    if (lock_count_.compare_exchange_weak(count, count - 1,
+                                          std::memory_order_acq_rel)) {
+      return {};
+    }
+  }
+
+  absl::MutexLock lock(lock_mutex_);
+  while (true) {
+    count = lock_count_.load(std::memory_order_acquire);
+    LITERT_RETURN_IF_ERROR(count != 0,
+                           Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                                      "Tensor buffer is already unlocked."));
+    if (count == kWriteLockCount) {
+      break;
+    }
+    // Readers may still join or leave without the mutex.
+    if (lock_count_.compare_exchange_weak(count, count - 1,
+                                          std::memory_order_acq_rel)) {
+      if (count > 1) {
+        return {};
+      }
+      break;
+    }
+  }
+  // The buffer is now unlocked, no reader can join it without the mutex.
+  lock_count_.store(0, std::memory_order_release);
+  locked_host_memory_.store(nullptr, std::memory_order_relaxed);
+  return UnlockBuffer(dirty_offset_, dirty_size_);
+}
+
+Expected<void> LiteRtTensorBufferT::UnlockBuffer(size_t dirty_offset,
+                                                 size_t dirty_size) {
   switch (buffer_type()) {
     case kLiteRtTensorBufferTypeAhwb: {
 #if LITERT_HAS_AHWB_SUPPORT
@@ -1028,7 +1270,7 @@ Expected<void> LiteRtTensorBufferT::Unlock() {
     case kLiteRtTensorBufferTypeOpenClBufferPacked: {
 #if LITERT_HAS_OPENCL_SUPPORT
       LITERT_ASSIGN_OR_RETURN(auto opencl_buffer, GetOpenClMemory());
-      return opencl_buffer->Unlock<float>();
+      return opencl_buffer->Unlock<float>(dirty_offset, dirty_size);
 #else
       return Unexpected(kLiteRtStatusErrorRuntimeFailure,
                         "OpenCL buffers are not supported");
@@ -1037,7 +1279,7 @@ Expected<void> LiteRtTensorBufferT::Unlock() {
     case kLiteRtTensorBufferTypeGlBuffer: {
 #if LITERT_HAS_OPENGL_SUPPORT
       LITERT_ASSIGN_OR_RETURN(auto gl_buffer, GetGlBuffer());
-      return gl_buffer->Unlock<float>();
+      return gl_buffer->Unlock<float>(dirty_offset, dirty_size);
 #else
       return Unexpected(kLiteRtStatusErrorRuntimeFailure,
                         "OpenGL buffers are not supported");
@@ -19,6 +19,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -27,8 +28,10 @@
 
 #include "absl/container/flat_hash_map.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
+#include "litert/c/litert_custom_tensor_buffer.h"
 #include "litert/c/litert_gl_types.h"
 #include "litert/c/litert_layout.h"
 #include "litert/c/litert_model_types.h"
@@ -36,6 +39,7 @@
 #include "litert/cc/litert_expected.h"
 #include "litert/runtime/custom_buffer.h"
 #include "litert/runtime/event.h"
+#include "litert/runtime/tensor_buffer_pool.h"
 
 #if LITERT_HAS_OPENCL_SUPPORT
 #include "litert/runtime/open_cl_memory.h"
@@ -103,6 +107,9 @@ class LiteRtTensorBufferT {
       size_t size_bytes, LiteRtGLint layer,
       LiteRtGlTextureDeallocator deallocator = nullptr);
 
+  // Creates a buffer owning its memory. If the tensor buffer pool of `env` is
+  // enabled, a pooled buffer of the same type, size and alignment is reused
+  // when available.
   static litert::Expected<Ptr> CreateManaged(
       LiteRtEnvironment env, LiteRtTensorBufferType buffer_type,
       const LiteRtRankedTensorType& tensor_type, size_t buffer_size);
@@ -111,6 +118,11 @@ class LiteRtTensorBufferT {
       const LiteRtRankedTensorType& tensor_type, size_t buffer_size,
       size_t alignment);
 
+  // Frees a buffer whose last reference was dropped. A buffer created through
+  // the tensor buffer pool goes back to the pool once its pending event, if
+  // any, completed; any other buffer is deleted.
+  static void Destroy(LiteRtTensorBufferT* tensor_buffer);
+
 #if LITERT_HAS_OPENCL_SUPPORT
   static litert::Expected<Ptr> CreateFromOpenClMemory(
       LiteRtEnvironment env, const LiteRtRankedTensorType& tensor_type,
@@ -125,6 +137,15 @@ class LiteRtTensorBufferT {
       size_t buffer_size);
 #endif  // LITERT_HAS_METAL_SUPPORT
 
+#if LITERT_HAS_VULKAN_SUPPORT
+  // Wraps a Vulkan memory created outside of LiteRT, e.g. a VkDeviceMemory
+  // imported from an AHardwareBuffer or a DMA-BUF, without copying it.
+  static litert::Expected<Ptr> CreateFromVulkanMemory(
+      LiteRtEnvironment env, const LiteRtRankedTensorType& tensor_type,
+      LiteRtTensorBufferType buffer_type, HwMemoryHandle vulkan_memory,
+      size_t buffer_size, LiteRtVulkanMemoryDeallocator deallocator = nullptr);
+#endif  // LITERT_HAS_VULKAN_SUPPORT
+
   LiteRtRankedTensorType tensor_type() const { return tensor_type_; }
   LiteRtTensorBufferType buffer_type() const { return buffer_type_; }
 
@@ -136,6 +157,11 @@ class LiteRtTensorBufferT {
 
   bool HasEvent() const { return event_ != nullptr; }
 
+  // Returns true if the buffer has an event that may not be signaled yet.
+  // Events whose state can't be queried, and host events signaled with an
+  // error, are considered pending.
+  bool HasPendingEvent() const;
+
   litert::Expected<LiteRtEventT*> GetEvent() const {
     if (!HasEvent()) {
       return litert::Error(kLiteRtStatusErrorRuntimeFailure,
@@ -164,9 +190,46 @@ class LiteRtTensorBufferT {
 #endif  // LITERT_HAS_OPENCL_SUPPORT
   litert::Expected<litert::internal::CustomBuffer*> GetCustomBuffer();
 
+  // Locks the buffer and returns its host memory address.
+  //
+  // Read locks are shared: while the buffer is read locked, further read locks
+  // succeed without synchronizing with the device again and without taking a
+  // mutex. Write and read/write locks are exclusive.
   litert::Expected<void*> Lock(LiteRtTensorBufferLockMode mode);
+
+  // Locks the `size` bytes starting at `offset` of the host memory and returns
+  // the address of the first one. A write lock only syncs back this range to
+  // the device when the buffer is unlocked.
+  litert::Expected<void*> Lock(LiteRtTensorBufferLockMode mode, size_t offset,
+                               size_t size);
+
+  // Releases one lock. The device memory is updated when the last lock is
+  // released.
   litert::Expected<void> Unlock();
 
+  // Returns true if the buffer is locked.
+  bool IsLocked() const {
+    return lock_count_.load(std::memory_order_acquire) != 0;
+  }
+
+  // Returns a value that changes whenever the host memory may have been
+  // written through a write or read/write lock, or through the address handed
+  // out by LiteRtGetTensorBufferHostMemory(). Values are never reused, even
+  // across buffers, so that they identify the content of one buffer.
+  uint64_t ContentVersion() const {
+    return content_version_.load(std::memory_order_acquire);
+  }
+
+  // Changes the content version, for writers that don't lock the buffer.
+  void MarkContentModified() {
+    content_version_.store(NextContentVersion(), std::memory_order_release);
+  }
+
+  // Returns true if the buffer is host memory allocated by LiteRT, as opposed
+  // to wrapped memory that its owner may write without changing the content
+  // version.
+  bool OwnsHostMemory() const;
+
   // Used to duplicate the current tensor buffer. Internally it increases
   // reference count to the underlying buffer.
   void Duplicate() const { Ref(); }
@@ -234,6 +297,11 @@ class LiteRtTensorBufferT {
                       LiteRtTensorBufferType buffer_type, size_t buffer_size,
                       size_t buffer_offset = 0);
 
+  static litert::Expected<Ptr> AllocateManaged(
+      LiteRtEnvironment env, LiteRtTensorBufferType buffer_type,
+      const LiteRtRankedTensorType& tensor_type, size_t buffer_size,
+      size_t alignment);
+
   static litert::Expected<Ptr> CreateManagedOnHostMemory(
       const LiteRtRankedTensorType& tensor_type, size_t buffer_size);
   static litert::Expected<Ptr> CreateManagedOnHostMemory(
@@ -278,6 +346,27 @@ class LiteRtTensorBufferT {
 
   litert::Expected<void> IsValid();
 
+  // Returns the number of bytes of the host memory that can be locked.
+  size_t LockableSize() const;
+
+  // Gives the CPU access to the underlying buffer, of which the `size` bytes
+  // starting at `offset` are accessed.
+  litert::Expected<void*> LockBuffer(LiteRtTensorBufferLockMode mode,
+                                     size_t offset, size_t size);
+
+  // Ends the CPU access to the underlying buffer, syncing back the given
+  // range if it was written.
+  litert::Expected<void> UnlockBuffer(size_t dirty_offset, size_t dirty_size);
+
+  // Sets the tensor type and the derived fields.
+  void SetTensorType(const LiteRtRankedTensorType& tensor_type);
+
+  // Makes a buffer taken from the pool look like a newly created one.
+  void ResetForReuse(const LiteRtRankedTensorType& tensor_type);
+
+  // Returns a content version that hasn't been used by any buffer yet.
+  static uint64_t NextContentVersion();
+
   LiteRtEnvironment env_;
   LiteRtRankedTensorType tensor_type_;
   std::vector<std::decay_t<decltype(LiteRtLayout::dimensions[0])>> dimensions_;
@@ -294,7 +383,19 @@ class LiteRtTensorBufferT {
   // an AHWB buffer.
   absl::flat_hash_map<LiteRtTensorBufferType, BufferVariant>
       memory_backed_buffers_;
-  bool is_locked_ = false;
+  // Serializes the transitions between the unlocked and locked states.
+  absl::Mutex lock_mutex_;
+  // 0 when unlocked, the number of read locks, or kWriteLockCount.
+  std::atomic<int32_t> lock_count_{0};
+  // The host memory address while the buffer is locked.
+  std::atomic<void*> locked_host_memory_{nullptr};
+  // The range written by the current write lock.
+  size_t dirty_offset_ = 0;
+  size_t dirty_size_ = 0;
+  std::atomic<uint64_t> content_version_{NextContentVersion()};
+  // The pool the buffer goes back to when it is destroyed, if any.
+  litert::internal::TensorBufferPool* pool_ = nullptr;
+  std::optional<litert::internal::TensorBufferPool::Key> pool_key_;
 };
 
 #endif  // ODML_LITERT_LITERT_RUNTIME_TENSOR_BUFFER_H_
@@ -0,0 +1,148 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/tensor_buffer_pool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
+#include "litert/c/litert_tensor_buffer_types.h"
+#include "litert/core/util/perfetto_profiling.h"
+
+namespace litert {
+namespace internal {
+namespace {
+
+// Updates the counter tracks of the occupancy of the pool.
+void TraceOccupancy(const TensorBufferPool::Stats& stats) {
+  LITERT_PERFETTO_TRACE_COUNTER(kBuffer, "LiteRT::TensorBufferPool[bytes]",
+                                static_cast<int64_t>(stats.pooled_bytes));
+  LITERT_PERFETTO_TRACE_COUNTER(kBuffer, "LiteRT::TensorBufferPool[buffers]",
+                                static_cast<int64_t>(stats.num_pooled_buffers));
+}
+
+}  // namespace
+
+TensorBufferPool::~TensorBufferPool() { Clear(); }
+
+bool TensorBufferPool::IsPoolable(LiteRtTensorBufferType buffer_type) {
+  switch (buffer_type) {
+    case kLiteRtTensorBufferTypeHostMemory:
+    case kLiteRtTensorBufferTypeAhwb:
+    case kLiteRtTensorBufferTypeIon:
+    case kLiteRtTensorBufferTypeDmaBuf:
+    case kLiteRtTensorBufferTypeFastRpc:
+    case kLiteRtTensorBufferTypeGlBuffer:
+      return true;
+    default:
+      // GPU memory objects such as OpenCL buffers and textures are bound to
+      // the tensor type they were created for.
+      return false;
+  }
+}
+
+void TensorBufferPool::SetMaxPooledBytes(size_t max_pooled_bytes) {
+  std::vector<Buffer> evicted;
+  {
+    absl::MutexLock lock(mutex_);
+    max_pooled_bytes_ = max_pooled_bytes;
+    evicted = EvictLocked(max_pooled_bytes_);
+  }
+}
+
+bool TensorBufferPool::IsEnabled() const {
+  absl::MutexLock lock(mutex_);
+  return max_pooled_bytes_ > 0;
+}
+
+LiteRtTensorBufferT* TensorBufferPool::Acquire(const Key& key) {
+  absl::MutexLock lock(mutex_);
+  auto it = entries_by_key_.find(key);
+  if (it == entries_by_key_.end()) {
+    ++stats_.num_misses;
+    return nullptr;
+  }
+  EntryList::iterator entry = it->second.back();
+  it->second.pop_back();
+  if (it->second.empty()) {
+    entries_by_key_.erase(it);
+  }
+  LiteRtTensorBufferT* buffer = entry->buffer.release();
+  entries_.erase(entry);
+  ++stats_.num_hits;
+  --stats_.num_pooled_buffers;
+  stats_.pooled_bytes -= key.buffer_size;
+  TraceOccupancy(stats_);
+  return buffer;
+}
+
+void TensorBufferPool::Release(const Key& key, Buffer buffer) {
+  std::vector<Buffer> evicted;
+  {
+    absl::MutexLock lock(mutex_);
+    if (max_pooled_bytes_ == 0 || key.buffer_size > max_pooled_bytes_) {
+      // Freed when leaving the scope.
+      evicted.push_back(std::move(buffer));
+    } else {
+      evicted = EvictLocked(max_pooled_bytes_ - key.buffer_size);
+      entries_.push_front(Entry{key, std::move(buffer)});
+      entries_by_key_[key].push_back(entries_.begin());
+      ++stats_.num_pooled_buffers;
+      stats_.pooled_bytes += key.buffer_size;
+      TraceOccupancy(stats_);
+    }
+  }
+}
+
+void TensorBufferPool::Trim(size_t max_bytes) {
+  std::vector<Buffer> evicted;
+  {
+    absl::MutexLock lock(mutex_);
+    evicted = EvictLocked(max_bytes);
+  }
+}
+
+TensorBufferPool::Stats TensorBufferPool::GetStats() const {
+  absl::MutexLock lock(mutex_);
+  return stats_;
+}
+
+std::vector<TensorBufferPool::Buffer> TensorBufferPool::EvictLocked(
+    size_t max_bytes) {
+  std::vector<Buffer> evicted;
+  while (stats_.pooled_bytes > max_bytes) {
+    Entry& entry = entries_.back();
+    auto& same_key_entries = entries_by_key_[entry.key];
+    // The oldest entry of a key is the first one.
+    same_key_entries.erase(same_key_entries.begin());
+    if (same_key_entries.empty()) {
+      entries_by_key_.erase(entry.key);
+    }
+    --stats_.num_pooled_buffers;
+    stats_.pooled_bytes -= entry.key.buffer_size;
+    ++stats_.num_evictions;
+    evicted.push_back(std::move(entry.buffer));
+    entries_.pop_back();
+  }
+  if (!evicted.empty()) {
+    TraceOccupancy(stats_);
+  }
+  return evicted;
+}
+
+}  // namespace internal
+}  // namespace litert
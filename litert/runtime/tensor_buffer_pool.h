@@ -0,0 +1,133 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_ODML_LITERT_LITERT_RUNTIME_TENSOR_BUFFER_POOL_H_
+#define THIRD_PARTY_ODML_LITERT_LITERT_RUNTIME_TENSOR_BUFFER_POOL_H_
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"  // from @com_google_absl
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/synchronization/mutex.h"  // from @com_google_absl
+#include "litert/c/litert_tensor_buffer_types.h"
+
+class LiteRtTensorBufferT;
+
+namespace litert {
+namespace internal {
+
+// Keeps the managed tensor buffers destroyed by the user so that the next
+// managed buffer of the same type, size and alignment reuses the underlying
+// allocation instead of asking the driver for a new one.
+//
+// The pool is disabled until a byte budget is set. Once the pooled buffers
+// exceed the budget, the least recently returned ones are freed.
+//
+// Note: This class is thread safe.
+class TensorBufferPool {
+ public:
+  struct Key {
+    LiteRtTensorBufferType buffer_type;
+    size_t buffer_size;
+    size_t alignment;
+
+    bool operator==(const Key& other) const {
+      return buffer_type == other.buffer_type &&
+             buffer_size == other.buffer_size && alignment == other.alignment;
+    }
+
+    template <typename H>
+    friend H AbslHashValue(H h, const Key& key) {
+      return H::combine(std::move(h), key.buffer_type, key.buffer_size,
+                        key.alignment);
+    }
+  };
+
+  // A pooled buffer and the function that frees it.
+  using Buffer =
+      std::unique_ptr<LiteRtTensorBufferT, void (*)(LiteRtTensorBufferT*)>;
+
+  struct Stats {
+    // Number of buffers handed out from the pool.
+    size_t num_hits = 0;
+    // Number of poolable buffers that had to be allocated.
+    size_t num_misses = 0;
+    // Number of buffers freed to stay under the budget or by Trim().
+    size_t num_evictions = 0;
+    // Number and total size of the buffers currently in the pool.
+    size_t num_pooled_buffers = 0;
+    size_t pooled_bytes = 0;
+  };
+
+  TensorBufferPool() = default;
+  TensorBufferPool(const TensorBufferPool&) = delete;
+  TensorBufferPool& operator=(const TensorBufferPool&) = delete;
+  ~TensorBufferPool();
+
+  // Returns true if buffers of `buffer_type` can be recycled, i.e. their
+  // allocation only depends on their size.
+  static bool IsPoolable(LiteRtTensorBufferType buffer_type);
+
+  // Sets the maximum number of bytes kept in the pool. 0, the default,
+  // disables the pool and frees the pooled buffers.
+  void SetMaxPooledBytes(size_t max_pooled_bytes);
+
+  // Returns true if buffers are kept in the pool.
+  bool IsEnabled() const;
+
+  // Returns a pooled buffer matching `key`, or nullptr on a miss.
+  LiteRtTensorBufferT* Acquire(const Key& key);
+
+  // Adds `buffer` to the pool, or frees it if it doesn't fit in the budget.
+  void Release(const Key& key, Buffer buffer);
+
+  // Frees the least recently returned buffers until at most `max_bytes` are
+  // pooled.
+  void Trim(size_t max_bytes);
+
+  // Frees all the pooled buffers.
+  void Clear() { Trim(0); }
+
+  Stats GetStats() const;
+
+ private:
+  struct Entry {
+    Key key;
+    Buffer buffer;
+  };
+  using EntryList = std::list<Entry>;
+
+  // Frees the oldest entries until at most `max_bytes` are pooled and returns
+  // them so that they are destroyed without holding the lock.
+  std::vector<Buffer> EvictLocked(size_t max_bytes)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  mutable absl::Mutex mutex_;
+  size_t max_pooled_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+  // Pooled buffers, the most recently returned first.
+  EntryList entries_ ABSL_GUARDED_BY(mutex_);
+  // Pooled buffers by key, the most recently returned last.
+  absl::flat_hash_map<Key, std::vector<EntryList::iterator>> entries_by_key_
+      ABSL_GUARDED_BY(mutex_);
+  Stats stats_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace internal
+}  // namespace litert
+
+#endif  // THIRD_PARTY_ODML_LITERT_LITERT_RUNTIME_TENSOR_BUFFER_POOL_H_
@@ -0,0 +1,170 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/tensor_buffer_pool.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+#include "litert/c/internal/litert_tensor_buffer_registry.h"
+#include "litert/c/litert_any.h"
+#include "litert/c/litert_common.h"
+#include "litert/c/litert_environment.h"
+#include "litert/c/litert_environment_options.h"
+#include "litert/c/litert_model_types.h"
+#include "litert/c/litert_tensor_buffer.h"
+#include "litert/c/litert_tensor_buffer_types.h"
+#include "litert/cc/litert_layout.h"
+#include "litert/runtime/tensor_buffer_registry.h"
+#include "litert/test/matchers.h"
+
+namespace litert::internal {
+namespace {
+
+constexpr const int32_t kTensorDimensions[] = {4};
+constexpr size_t kBufferSize = 4 * sizeof(float);
+
+constexpr const LiteRtRankedTensorType kTensorType = {
+    /*.element_type=*/kLiteRtElementTypeFloat32,
+    ::litert::BuildLayout(kTensorDimensions)};
+
+LiteRtEnvironment CreateEnvironment(int64_t max_pooled_bytes) {
+  LiteRtEnvOption option;
+  option.tag = kLiteRtEnvOptionTagTensorBufferPoolMaxSize;
+  option.value.type = kLiteRtAnyTypeInt;
+  option.value.int_value = max_pooled_bytes;
+  LiteRtEnvironment env = nullptr;
+  EXPECT_EQ(LiteRtCreateEnvironment(/*num_options=*/1, &option, &env),
+            kLiteRtStatusOk);
+  return env;
+}
+
+TensorBufferPool& GetPool(LiteRtEnvironment env) {
+  void* registry = nullptr;
+  EXPECT_EQ(LiteRtGetTensorBufferRegistry(env, &registry), kLiteRtStatusOk);
+  return static_cast<TensorBufferRegistry*>(registry)->GetBufferPool();
+}
+
+LiteRtTensorBuffer CreateBuffer(LiteRtEnvironment env, size_t buffer_size) {
+  LiteRtTensorBuffer buffer = nullptr;
+  EXPECT_EQ(LiteRtCreateManagedTensorBuffer(env,
+                                            kLiteRtTensorBufferTypeHostMemory,
+                                            &kTensorType, buffer_size, &buffer),
+            kLiteRtStatusOk);
+  return buffer;
+}
+
+void* GetHostMemory(LiteRtTensorBuffer buffer) {
+  void* host_memory = nullptr;
+  EXPECT_EQ(LiteRtGetTensorBufferHostMemory(buffer, &host_memory),
+            kLiteRtStatusOk);
+  return host_memory;
+}
+
+TEST(TensorBufferPoolTest, DisabledByDefault) {
+  LiteRtEnvironment env;
+  LITERT_ASSERT_OK(
+      LiteRtCreateEnvironment(/*num_options=*/0, /*options=*/nullptr, &env));
+  EXPECT_FALSE(GetPool(env).IsEnabled());
+
+  LiteRtDestroyTensorBuffer(CreateBuffer(env, kBufferSize));
+  TensorBufferPool::Stats stats = GetPool(env).GetStats();
+  EXPECT_EQ(stats.num_misses, 0);
+  EXPECT_EQ(stats.num_pooled_buffers, 0);
+
+  LiteRtDestroyEnvironment(env);
+}
+
+TEST(TensorBufferPoolTest, ReusesReleasedBuffers) {
+  LiteRtEnvironment env = CreateEnvironment(/*max_pooled_bytes=*/1024);
+  ASSERT_NE(env, nullptr);
+  TensorBufferPool& pool = GetPool(env);
+  EXPECT_TRUE(pool.IsEnabled());
+
+  LiteRtTensorBuffer buffer = CreateBuffer(env, kBufferSize);
+  void* host_memory = GetHostMemory(buffer);
+  LiteRtDestroyTensorBuffer(buffer);
+  EXPECT_EQ(pool.GetStats().num_pooled_buffers, 1);
+  EXPECT_EQ(pool.GetStats().pooled_bytes, kBufferSize);
+
+  // A buffer of the same type and size gets the same memory back.
+  buffer = CreateBuffer(env, kBufferSize);
+  EXPECT_EQ(GetHostMemory(buffer), host_memory);
+  LiteRtRankedTensorType tensor_type;
+  LITERT_ASSERT_OK(LiteRtGetTensorBufferTensorType(buffer, &tensor_type));
+  EXPECT_EQ(tensor_type.layout.rank, 1);
+  EXPECT_EQ(tensor_type.layout.dimensions[0], kTensorDimensions[0]);
+
+  // A buffer of another size is allocated.
+  LiteRtTensorBuffer other_buffer = CreateBuffer(env, 2 * kBufferSize);
+  EXPECT_NE(GetHostMemory(other_buffer), host_memory);
+
+  TensorBufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(stats.num_hits, 1);
+  EXPECT_EQ(stats.num_misses, 2);
+  EXPECT_EQ(stats.num_pooled_buffers, 0);
+
+  LiteRtDestroyTensorBuffer(buffer);
+  LiteRtDestroyTensorBuffer(other_buffer);
+  EXPECT_EQ(pool.GetStats().pooled_bytes, 3 * kBufferSize);
+  LiteRtDestroyEnvironment(env);
+}
+
+TEST(TensorBufferPoolTest, EvictsOldestBuffersOverBudget) {
+  LiteRtEnvironment env = CreateEnvironment(2 * kBufferSize);
+  ASSERT_NE(env, nullptr);
+  TensorBufferPool& pool = GetPool(env);
+
+  LiteRtTensorBuffer buffers[3];
+  for (auto& buffer : buffers) {
+    buffer = CreateBuffer(env, kBufferSize);
+  }
+  for (auto& buffer : buffers) {
+    LiteRtDestroyTensorBuffer(buffer);
+  }
+  TensorBufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(stats.num_evictions, 1);
+  EXPECT_EQ(stats.num_pooled_buffers, 2);
+  EXPECT_EQ(stats.pooled_bytes, 2 * kBufferSize);
+
+  // Buffers larger than the budget are never pooled.
+  LiteRtDestroyTensorBuffer(CreateBuffer(env, 4 * kBufferSize));
+  EXPECT_EQ(pool.GetStats().num_pooled_buffers, 2);
+
+  pool.Trim(kBufferSize);
+  EXPECT_EQ(pool.GetStats().num_pooled_buffers, 1);
+  pool.Clear();
+  EXPECT_EQ(pool.GetStats().pooled_bytes, 0);
+
+  LiteRtDestroyEnvironment(env);
+}
+
+TEST(TensorBufferPoolTest, SharedBufferIsPooledOnLastRelease) {
+  LiteRtEnvironment env = CreateEnvironment(/*max_pooled_bytes=*/1024);
+  ASSERT_NE(env, nullptr);
+  TensorBufferPool& pool = GetPool(env);
+
+  LiteRtTensorBuffer buffer = CreateBuffer(env, kBufferSize);
+  LITERT_ASSERT_OK(LiteRtDuplicateTensorBuffer(buffer));
+  LiteRtDestroyTensorBuffer(buffer);
+  EXPECT_EQ(pool.GetStats().num_pooled_buffers, 0);
+  LiteRtDestroyTensorBuffer(buffer);
+  EXPECT_EQ(pool.GetStats().num_pooled_buffers, 1);
+
+  LiteRtDestroyEnvironment(env);
+}
+
+}  // namespace
+}  // namespace litert::internal
@@ -20,6 +20,7 @@
 #include "litert/c/litert_custom_tensor_buffer.h"
 #include "litert/c/litert_tensor_buffer_types.h"
 #include "litert/cc/litert_expected.h"
+#include "litert/runtime/tensor_buffer_pool.h"
 
 namespace litert {
 namespace internal {
@@ -50,9 +51,13 @@ class TensorBufferRegistry {
   litert::Expected<CustomTensorBufferHandlers> GetCustomHandlers(
       const LiteRtTensorBufferType buffer_type);
 
+  // Returns the pool recycling the managed tensor buffers.
+  TensorBufferPool& GetBufferPool() { return buffer_pool_; }
+
  private:
   std::unordered_map<LiteRtTensorBufferType, CustomTensorBufferHandlers>
       handlers_;
+  TensorBufferPool buffer_pool_;
 };
 
 }  // namespace internal
@@ -57,6 +57,14 @@ litert::Expected<std::unique_ptr<LiteRtTensorBufferRequirementsT>> Join(
       }
     }
   }
+  // Prefer any common device buffer type over host memory, so that the buffer
+  // can be handed off between the two sides without a copy. Otherwise keep the
+  // order of preference of `src1`.
+  std::stable_partition(buffer_types.begin(), buffer_types.end(),
+                        [](LiteRtTensorBufferType buffer_type) {
+                          return buffer_type !=
+                                 kLiteRtTensorBufferTypeHostMemory;
+                        });
 
   if (buffer_types.empty()) {
     return Unexpected(kLiteRtStatusErrorInvalidArgument,
@@ -67,8 +75,12 @@ litert::Expected<std::unique_ptr<LiteRtTensorBufferRequirementsT>> Join(
   // Take the max as buffer size.
   auto buffer_size = std::max(src1.BufferSize(), src2.BufferSize());
 
+  // Empty strides mean a packed layout with no stride requirement, so the
+  // strides of the other side win.
   std::vector<uint32_t> strides;
-  if (src1.Strides() == src2.Strides()) {
+  if (src1.Strides().empty()) {
+    strides = src2.Strides();
+  } else if (src2.Strides().empty() || src1.Strides() == src2.Strides()) {
     strides = src1.Strides();
   } else {
     return Unexpected(kLiteRtStatusErrorInvalidArgument,
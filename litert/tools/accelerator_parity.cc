@@ -0,0 +1,176 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/tools/accelerator_parity.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"  // from @com_google_absl
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/internal/litert_logging.h"
+#include "litert/c/litert_common.h"
+#include "litert/cc/litert_expected.h"
+
+namespace litert::tools {
+namespace {
+
+// The worst of the differences of all outputs.
+OutputDiff WorstOutputDiff(const std::vector<OutputDiff>& outputs) {
+  OutputDiff worst;
+  for (const OutputDiff& output : outputs) {
+    worst.num_elements += output.num_elements;
+    worst.num_mismatches += output.num_mismatches;
+    worst.max_abs_diff = std::max(worst.max_abs_diff, output.max_abs_diff);
+    worst.mean_abs_diff = std::max(worst.mean_abs_diff, output.mean_abs_diff);
+    worst.mse = std::max(worst.mse, output.mse);
+  }
+  return worst;
+}
+
+}  // namespace
+
+bool AcceleratorResult::Matches() const {
+  return Ran() && std::all_of(outputs.begin(), outputs.end(),
+                              [](const OutputDiff& output) {
+                                return output.num_mismatches == 0;
+                              });
+}
+
+OutputDiff CompareOutput(absl::Span<const float> reference,
+                         absl::Span<const float> values, double epsilon) {
+  OutputDiff diff;
+  diff.num_elements = std::min(reference.size(), values.size());
+  // Missing elements are all mismatches.
+  diff.num_mismatches = std::max(reference.size(), values.size()) -
+                        diff.num_elements;
+  double sum_abs_diff = 0.0;
+  double sum_squared_diff = 0.0;
+  for (size_t i = 0; i < diff.num_elements; ++i) {
+    const double abs_diff =
+        std::fabs(static_cast<double>(reference[i]) - values[i]);
+    // NaNs compare false, so they are counted explicitly.
+    if (!(abs_diff <= epsilon)) {
+      ++diff.num_mismatches;
+    }
+    diff.max_abs_diff = std::max(diff.max_abs_diff, abs_diff);
+    sum_abs_diff += abs_diff;
+    sum_squared_diff += abs_diff * abs_diff;
+  }
+  if (diff.num_elements > 0) {
+    diff.mean_abs_diff = sum_abs_diff / diff.num_elements;
+    diff.mse = sum_squared_diff / diff.num_elements;
+  }
+  return diff;
+}
+
+LatencyStats SummarizeLatencies(std::vector<double> run_ms) {
+  LatencyStats stats;
+  if (run_ms.empty()) {
+    return stats;
+  }
+  std::sort(run_ms.begin(), run_ms.end());
+  auto at = [&run_ms](double fraction) {
+    const size_t rank =
+        static_cast<size_t>(std::ceil(fraction * run_ms.size()));
+    return run_ms[std::max<size_t>(rank, 1) - 1];
+  };
+  stats.mean_ms =
+      std::accumulate(run_ms.begin(), run_ms.end(), 0.0) / run_ms.size();
+  stats.p50_ms = at(0.50);
+  stats.p90_ms = at(0.90);
+  stats.min_ms = run_ms.front();
+  stats.max_ms = run_ms.back();
+  return stats;
+}
+
+void LogParityReport(absl::Span<const AcceleratorResult> results) {
+  LITERT_LOG(LITERT_INFO, "\n========== ACCELERATOR PARITY ==========");
+  LITERT_LOG(LITERT_INFO,
+             "Accelerator | Compile ms | First ms | p50/p90 ms      | "
+             "Mem KB (rss/heap) | CPU ms/run | Temp +C | Max diff   | "
+             "Mismatches");
+  for (const AcceleratorResult& result : results) {
+    if (!result.Ran()) {
+      LITERT_LOG(LITERT_INFO, "%-11s | not run: %s", result.accelerator.c_str(),
+                 result.error.c_str());
+      continue;
+    }
+    const OutputDiff worst = WorstOutputDiff(result.outputs);
+    LITERT_LOG(LITERT_INFO,
+               "%-11s | %10.2f | %8.2f | %7.3f %7.3f | %8lld %8lld | %10.3f | "
+               "%7.1f | %10.3g | %zu/%zu",
+               result.accelerator.c_str(), result.compile_ms,
+               result.first_run_ms, result.latency.p50_ms,
+               result.latency.p90_ms,
+               static_cast<long long>(result.peak_rss_increase_kb),  // NOLINT
+               static_cast<long long>(result.heap_increase_kb),      // NOLINT
+               result.cpu_ms_per_run, result.temperature_rise_c,
+               worst.max_abs_diff, worst.num_mismatches, worst.num_elements);
+    for (size_t i = 0; i < result.outputs.size(); ++i) {
+      const OutputDiff& output = result.outputs[i];
+      if (output.num_mismatches == 0) continue;
+      LITERT_LOG(LITERT_INFO,
+                 "  output %zu: %zu of %zu elements mismatch, max diff %g, "
+                 "mean diff %g, mse %g",
+                 i, output.num_mismatches, output.num_elements,
+                 output.max_abs_diff, output.mean_abs_diff, output.mse);
+    }
+  }
+  LITERT_LOG(LITERT_INFO, "========================================\n");
+}
+
+Expected<void> WriteParityCsv(absl::Span<const AcceleratorResult> results,
+                              absl::string_view path) {
+  std::ofstream file{std::string(path)};
+  if (!file) {
+    return Unexpected(kLiteRtStatusErrorFileIO,
+                      absl::StrCat("Failed to open ", path));
+  }
+  file << "accelerator,ran,matches,compile_ms,first_run_ms,mean_ms,p50_ms,"
+          "p90_ms,min_ms,max_ms,peak_rss_increase_kb,heap_increase_kb,"
+          "cpu_ms_per_run,temperature_rise_c,num_elements,num_mismatches,"
+          "max_abs_diff,mean_abs_diff,mse,error\n";
+  for (const AcceleratorResult& result : results) {
+    const OutputDiff worst = WorstOutputDiff(result.outputs);
+    // The error is the last column, and has no commas.
+    std::string error = result.error;
+    std::replace(error.begin(), error.end(), ',', ';');
+    std::replace(error.begin(), error.end(), '\n', ' ');
+    file << absl::StrFormat(
+        "%s,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%d,%d,%.3f,%.2f,%d,%d,"
+        "%g,%g,%g,%s\n",
+        result.accelerator, result.Ran(), result.Matches(), result.compile_ms,
+        result.first_run_ms, result.latency.mean_ms, result.latency.p50_ms,
+        result.latency.p90_ms, result.latency.min_ms, result.latency.max_ms,
+        result.peak_rss_increase_kb, result.heap_increase_kb,
+        result.cpu_ms_per_run, result.temperature_rise_c, worst.num_elements,
+        worst.num_mismatches, worst.max_abs_diff, worst.mean_abs_diff,
+        worst.mse, error);
+  }
+  if (!file) {
+    return Unexpected(kLiteRtStatusErrorFileIO,
+                      absl::StrCat("Failed to write ", path));
+  }
+  return {};
+}
+
+}  // namespace litert::tools
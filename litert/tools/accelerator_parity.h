@@ -0,0 +1,95 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_TOOLS_ACCELERATOR_PARITY_H_
+#define ODML_LITERT_LITERT_TOOLS_ACCELERATOR_PARITY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/cc/litert_expected.h"
+
+// Accelerator parity: the accuracy, latency, memory and energy proxies of a
+// model on each accelerator, run with the same inputs, side by side with the
+// reference accelerator.
+
+namespace litert::tools {
+
+// The difference of an output with the one of the reference accelerator.
+struct OutputDiff {
+  size_t num_elements = 0;
+  // Elements whose absolute difference is above the epsilon.
+  size_t num_mismatches = 0;
+  double max_abs_diff = 0.0;
+  double mean_abs_diff = 0.0;
+  double mse = 0.0;
+};
+
+struct LatencyStats {
+  double mean_ms = 0.0;
+  double p50_ms = 0.0;
+  double p90_ms = 0.0;
+  double min_ms = 0.0;
+  double max_ms = 0.0;
+};
+
+struct AcceleratorResult {
+  std::string accelerator;
+  // Why the model could not be compiled or run on the accelerator. Empty when
+  // it ran.
+  std::string error;
+  double compile_ms = 0.0;
+  // The first run, which includes the lazy initializations.
+  double first_run_ms = 0.0;
+  // The runs after the first one.
+  LatencyStats latency;
+  // Increase of the peak resident memory of the process and of the heap in
+  // use, from before the compilation to the end of the runs.
+  int64_t peak_rss_increase_kb = 0;
+  int64_t heap_increase_kb = 0;
+  // Energy proxies: the CPU time of the process per run, and the largest rise
+  // of a thermal zone over the runs.
+  double cpu_ms_per_run = 0.0;
+  double temperature_rise_c = 0.0;
+  // One per output, empty for the reference accelerator.
+  std::vector<OutputDiff> outputs;
+
+  bool Ran() const { return error.empty(); }
+
+  // Whether the model ran and all of its outputs match the reference.
+  bool Matches() const;
+};
+
+// Compares `values` with `reference`, element by element.
+OutputDiff CompareOutput(absl::Span<const float> reference,
+                         absl::Span<const float> values, double epsilon);
+
+// Nearest-rank percentiles of the latencies of `run_ms`.
+LatencyStats SummarizeLatencies(std::vector<double> run_ms);
+
+// Logs a table with one row per accelerator, and the outputs that mismatch.
+void LogParityReport(absl::Span<const AcceleratorResult> results);
+
+// Writes one CSV row per accelerator to `path`. The accuracy columns are the
+// worst over the outputs.
+Expected<void> WriteParityCsv(absl::Span<const AcceleratorResult> results,
+                              absl::string_view path);
+
+}  // namespace litert::tools
+
+#endif  // ODML_LITERT_LITERT_TOOLS_ACCELERATOR_PARITY_H_
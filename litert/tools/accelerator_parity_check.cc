@@ -0,0 +1,398 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs a model on each accelerator with the same inputs, and reports the
+// accuracy against the first accelerator next to the latency, memory and
+// energy proxies of each of them.
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define INCLUDE_QUALCOMM_RUNTIME_FLAGS
+#define INCLUDE_MEDIATEK_RUNTIME_FLAGS
+#define INCLUDE_GOOGLE_TENSOR_RUNTIME_FLAGS
+
+#include "absl/flags/flag.h"  // from @com_google_absl
+#include "absl/flags/parse.h"  // from @com_google_absl
+#include "absl/log/absl_log.h"  // from @com_google_absl
+#include "absl/strings/str_cat.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+#include "litert/cc/litert_common.h"
+#include "litert/cc/litert_compiled_model.h"
+#include "litert/cc/litert_element_type.h"
+#include "litert/cc/litert_environment.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/cc/litert_options.h"
+#include "litert/cc/litert_tensor_buffer.h"
+#include "litert/cc/options/litert_gpu_options.h"
+#include "litert/tools/accelerator_parity.h"
+#include "litert/tools/flags/vendors/google_tensor_flags.h"  // IWYU pragma: keep
+#include "litert/tools/flags/vendors/mediatek_flags.h"  // IWYU pragma: keep
+#include "litert/tools/flags/vendors/qualcomm_flags.h"  // IWYU pragma: keep
+#include "litert/tools/sustained_load.h"
+#include "tflite/profiling/memory_info.h"
+#include "tflite/profiling/time.h"
+
+ABSL_FLAG(std::string, graph, "", "Model file to check.");
+ABSL_FLAG(std::string, npu_graph, "",
+          "Optional model compiled ahead of time for the NPU, with the same "
+          "signature as --graph. The NPU runs --graph otherwise.");
+ABSL_FLAG(std::vector<std::string>, accelerators,
+          std::vector<std::string>({"cpu", "gpu", "npu"}),
+          "Accelerators to run the model on. The first one is the reference "
+          "of the accuracy. The accelerators the model can not be compiled "
+          "for are reported as not run.");
+ABSL_FLAG(size_t, signature_index, 0, "Index of the signature to run.");
+ABSL_FLAG(int, num_runs, 20,
+          "Runs on each accelerator, including the first one, which is "
+          "reported apart.");
+ABSL_FLAG(float, epsilon, 1e-4f,
+          "Largest absolute difference of an output element with the "
+          "reference accelerator.");
+ABSL_FLAG(bool, use_fp16, false, "Whether to run the GPU with FP16.");
+ABSL_FLAG(std::string, dispatch_library_dir, "",
+          "Path to the dispatch library.");
+ABSL_FLAG(std::string, compiler_plugin_library_dir, "",
+          "Path to the compiler plugin library, to compile --graph for the "
+          "NPU on device.");
+ABSL_FLAG(std::string, sysfs_root, "/sys",
+          "Where the thermal zones are read from.");
+ABSL_FLAG(std::string, report_csv, "",
+          "Path of the CSV report, with one row per accelerator.");
+
+namespace litert {
+namespace {
+
+using ::litert::benchmark::PlatformSample;
+using ::litert::benchmark::SamplePlatform;
+using ::litert::google_tensor::GoogleTensorOptionsFromFlags;
+using ::litert::mediatek::UpdateMediatekOptionsFromFlags;
+using ::litert::qualcomm::UpdateQualcommOptionsFromFlags;
+using ::litert::tools::AcceleratorResult;
+using ::litert::tools::CompareOutput;
+using ::litert::tools::LogParityReport;
+using ::litert::tools::SummarizeLatencies;
+using ::litert::tools::WriteParityCsv;
+
+Expected<Environment> GetEnvironment() {
+  std::vector<Environment::Option> environment_options;
+  const auto dispatch_library_dir = absl::GetFlag(FLAGS_dispatch_library_dir);
+  if (!dispatch_library_dir.empty()) {
+    environment_options.push_back(
+        Environment::Option{Environment::OptionTag::DispatchLibraryDir,
+                            absl::string_view(dispatch_library_dir)});
+  }
+  const auto compiler_plugin_library_dir =
+      absl::GetFlag(FLAGS_compiler_plugin_library_dir);
+  if (!compiler_plugin_library_dir.empty()) {
+    environment_options.push_back(
+        Environment::Option{Environment::OptionTag::CompilerPluginLibraryDir,
+                            absl::string_view(compiler_plugin_library_dir)});
+  }
+  return Environment::Create(absl::MakeConstSpan(environment_options));
+}
+
+Expected<Options> GetOptions(absl::string_view accelerator) {
+  LITERT_ASSIGN_OR_RETURN(auto options, Options::Create());
+  if (accelerator == "cpu") {
+    options.SetHardwareAccelerators(HwAccelerators::kCpu);
+  } else if (accelerator == "gpu") {
+    options.SetHardwareAccelerators(HwAccelerators::kGpu);
+    LITERT_ASSIGN_OR_RETURN(auto& gpu_options, options.GetGpuOptions());
+    gpu_options.SetPrecision(absl::GetFlag(FLAGS_use_fp16)
+                                 ? GpuOptions::Precision::kFp16
+                                 : GpuOptions::Precision::kFp32);
+  } else if (accelerator == "npu") {
+    // The ops the NPU does not support fall back to the CPU.
+    options.SetHardwareAccelerators(HwAccelerators::kNpu |
+                                    HwAccelerators::kCpu);
+    LITERT_ASSIGN_OR_RETURN(auto& qnn_opts, options.GetQualcommOptions());
+    LITERT_RETURN_IF_ERROR(UpdateQualcommOptionsFromFlags(qnn_opts));
+    if (auto google_tensor_opts = GoogleTensorOptionsFromFlags()) {
+      options.AddOpaqueOptions(std::move(*google_tensor_opts));
+    }
+    LITERT_ASSIGN_OR_RETURN(auto& mediatek_opts, options.GetMediatekOptions());
+    LITERT_RETURN_IF_ERROR(UpdateMediatekOptionsFromFlags(mediatek_opts));
+  } else {
+    return Error(kLiteRtStatusErrorInvalidArgument,
+                 absl::StrCat("Unknown accelerator: ", accelerator));
+  }
+  return options;
+}
+
+Expected<size_t> NumElements(const TensorBuffer& buffer) {
+  LITERT_ASSIGN_OR_RETURN(auto type, buffer.TensorType());
+  const auto& dimensions = type.Layout().Dimensions();
+  return std::accumulate(dimensions.begin(), dimensions.end(), size_t{1},
+                         std::multiplies<size_t>());
+}
+
+// Deterministic inputs, so that the reports of two invocations compare.
+template <typename T>
+Expected<void> FillWith(TensorBuffer& buffer,
+                        const std::function<T(size_t)>& value) {
+  LITERT_ASSIGN_OR_RETURN(size_t num_elements, NumElements(buffer));
+  std::vector<T> data(num_elements);
+  for (size_t i = 0; i < num_elements; ++i) {
+    data[i] = value(i);
+  }
+  return buffer.Write<T>(absl::MakeConstSpan(data));
+}
+
+Expected<void> FillInputTensor(TensorBuffer& buffer) {
+  LITERT_ASSIGN_OR_RETURN(auto type, buffer.TensorType());
+  switch (type.ElementType()) {
+    case ElementType::Float32:
+      return FillWith<float>(buffer,
+                             [](size_t i) { return std::sin(i * 0.01f); });
+    case ElementType::Int32:
+      return FillWith<int32_t>(buffer,
+                               [](size_t i) { return i % 1024 + 1; });
+    case ElementType::Int64:
+      return FillWith<int64_t>(buffer, [](size_t i) { return i % 2048; });
+    case ElementType::Int16:
+      return FillWith<int16_t>(buffer, [](size_t i) { return i % 2048; });
+    case ElementType::Int8:
+      return FillWith<int8_t>(buffer,
+                              [](size_t i) { return i % 256 - 128; });
+    case ElementType::UInt8:
+      return FillWith<uint8_t>(buffer, [](size_t i) { return i % 256; });
+    default:
+      return Error(kLiteRtStatusErrorInvalidArgument,
+                   "Unsupported element type for filling tensor.");
+  }
+}
+
+template <typename T>
+Expected<std::vector<float>> ReadAs(TensorBuffer& buffer,
+                                    size_t num_elements) {
+  std::vector<T> data(num_elements);
+  LITERT_RETURN_IF_ERROR(buffer.Read<T>(absl::MakeSpan(data)));
+  return std::vector<float>(data.begin(), data.end());
+}
+
+Expected<std::vector<float>> ReadOutput(TensorBuffer& buffer) {
+  LITERT_ASSIGN_OR_RETURN(auto type, buffer.TensorType());
+  LITERT_ASSIGN_OR_RETURN(size_t num_elements, NumElements(buffer));
+  switch (type.ElementType()) {
+    case ElementType::Float32:
+      return ReadAs<float>(buffer, num_elements);
+    case ElementType::Int32:
+      return ReadAs<int32_t>(buffer, num_elements);
+    case ElementType::Int64:
+      return ReadAs<int64_t>(buffer, num_elements);
+    case ElementType::Int16:
+      return ReadAs<int16_t>(buffer, num_elements);
+    case ElementType::Int8:
+      return ReadAs<int8_t>(buffer, num_elements);
+    case ElementType::UInt8:
+      return ReadAs<uint8_t>(buffer, num_elements);
+    default:
+      return Error(kLiteRtStatusErrorInvalidArgument,
+                   "Unsupported element type for reading tensor.");
+  }
+}
+
+double ProcessCpuMs() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0.0;
+  }
+  return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e3 +
+         (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-3;
+}
+
+double TemperatureRise(const PlatformSample& before,
+                       const PlatformSample& after) {
+  double rise = 0.0;
+  const size_t num_zones =
+      std::min(before.temperatures_c.size(), after.temperatures_c.size());
+  for (size_t i = 0; i < num_zones; ++i) {
+    rise = std::max(rise, after.temperatures_c[i] - before.temperatures_c[i]);
+  }
+  return rise;
+}
+
+double MsSince(uint64_t start_us) {
+  return (tflite::profiling::time::NowMicros() - start_us) * 1e-3;
+}
+
+// The bytes of the inputs, shared by all accelerators, and the outputs of
+// the reference accelerator.
+struct Reference {
+  std::vector<std::vector<char>> inputs;
+  std::vector<std::vector<float>> outputs;
+};
+
+// Compiles and runs the model on `accelerator`, filling `result`. The first
+// accelerator to run creates the inputs and outputs of `reference`.
+Expected<void> RunOnAccelerator(Environment& env,
+                                absl::string_view accelerator,
+                                Reference& reference,
+                                AcceleratorResult& result) {
+  const size_t signature_index = absl::GetFlag(FLAGS_signature_index);
+  std::string model_path = absl::GetFlag(FLAGS_graph);
+  if (accelerator == "npu" && !absl::GetFlag(FLAGS_npu_graph).empty()) {
+    model_path = absl::GetFlag(FLAGS_npu_graph);
+  }
+
+  const auto memory_before = tflite::profiling::memory::GetMemoryUsage();
+  LITERT_ASSIGN_OR_RETURN(auto options, GetOptions(accelerator));
+  uint64_t start_us = tflite::profiling::time::NowMicros();
+  LITERT_ASSIGN_OR_RETURN(auto compiled_model,
+                          CompiledModel::Create(env, model_path, options));
+  result.compile_ms = MsSince(start_us);
+
+  LITERT_ASSIGN_OR_RETURN(auto input_buffers,
+                          compiled_model.CreateInputBuffers(signature_index));
+  LITERT_ASSIGN_OR_RETURN(auto output_buffers,
+                          compiled_model.CreateOutputBuffers(signature_index));
+  const bool is_reference = reference.inputs.empty();
+  if (!is_reference && reference.inputs.size() != input_buffers.size()) {
+    return Error(kLiteRtStatusErrorInvalidArgument,
+                 "Number of inputs mismatch with the reference.");
+  }
+  for (size_t i = 0; i < input_buffers.size(); ++i) {
+    if (is_reference) {
+      LITERT_RETURN_IF_ERROR(FillInputTensor(input_buffers[i]));
+      LITERT_ASSIGN_OR_RETURN(size_t size, input_buffers[i].Size());
+      std::vector<char>& data = reference.inputs.emplace_back(size);
+      LITERT_RETURN_IF_ERROR(input_buffers[i].Read<char>(absl::MakeSpan(data)));
+    } else {
+      LITERT_RETURN_IF_ERROR(input_buffers[i].Write<char>(
+          absl::MakeConstSpan(reference.inputs[i])));
+    }
+  }
+
+  const int num_runs = std::max(absl::GetFlag(FLAGS_num_runs), 1);
+  const std::string& sysfs_root = absl::GetFlag(FLAGS_sysfs_root);
+  const PlatformSample platform_before = SamplePlatform(sysfs_root);
+  const double cpu_ms_before = ProcessCpuMs();
+  std::vector<double> run_ms;
+  run_ms.reserve(num_runs - 1);
+  for (int run = 0; run < num_runs; ++run) {
+    start_us = tflite::profiling::time::NowMicros();
+    LITERT_RETURN_IF_ERROR(
+        compiled_model.Run(signature_index, input_buffers, output_buffers));
+    if (run == 0) {
+      result.first_run_ms = MsSince(start_us);
+    } else {
+      run_ms.push_back(MsSince(start_us));
+    }
+  }
+  result.cpu_ms_per_run = (ProcessCpuMs() - cpu_ms_before) / num_runs;
+  result.temperature_rise_c =
+      TemperatureRise(platform_before, SamplePlatform(sysfs_root));
+  result.latency = SummarizeLatencies(std::move(run_ms));
+
+  const auto memory_after = tflite::profiling::memory::GetMemoryUsage();
+  result.peak_rss_increase_kb =
+      memory_after.mem_footprint_kb - memory_before.mem_footprint_kb;
+  result.heap_increase_kb =
+      (static_cast<int64_t>(memory_after.in_use_allocated_bytes) -
+       static_cast<int64_t>(memory_before.in_use_allocated_bytes)) /
+      1024;
+
+  if (!is_reference && reference.outputs.size() != output_buffers.size()) {
+    return Error(kLiteRtStatusErrorInvalidArgument,
+                 "Number of outputs mismatch with the reference.");
+  }
+  const float epsilon = absl::GetFlag(FLAGS_epsilon);
+  for (size_t i = 0; i < output_buffers.size(); ++i) {
+    LITERT_ASSIGN_OR_RETURN(auto output, ReadOutput(output_buffers[i]));
+    if (is_reference) {
+      reference.outputs.push_back(std::move(output));
+    } else {
+      result.outputs.push_back(
+          CompareOutput(reference.outputs[i], output, epsilon));
+    }
+  }
+  return {};
+}
+
+Expected<std::vector<AcceleratorResult>> RunAccelerators() {
+  if (absl::GetFlag(FLAGS_graph).empty()) {
+    return Error(kLiteRtStatusErrorInvalidArgument,
+                 "No model provided. Use --graph to provide it.");
+  }
+  const std::vector<std::string> accelerators =
+      absl::GetFlag(FLAGS_accelerators);
+  if (accelerators.empty()) {
+    return Error(kLiteRtStatusErrorInvalidArgument,
+                 "No accelerator provided.");
+  }
+  LITERT_ASSIGN_OR_RETURN(auto env, GetEnvironment());
+
+  Reference reference;
+  std::vector<AcceleratorResult> results;
+  for (const std::string& accelerator : accelerators) {
+    AcceleratorResult& result = results.emplace_back();
+    result.accelerator = accelerator;
+    if (auto ran = RunOnAccelerator(env, accelerator, reference, result);
+        !ran) {
+      result.error = ran.Error().Message();
+      if (results.size() == 1) {
+        return Error(kLiteRtStatusErrorRuntimeFailure,
+                     absl::StrCat("Failed to run the reference accelerator ",
+                                  accelerator, ": ", result.error));
+      }
+    }
+  }
+  return results;
+}
+
+}  // namespace
+}  // namespace litert
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+
+  auto results = litert::RunAccelerators();
+  if (!results) {
+    ABSL_LOG(ERROR) << results.Error().Message();
+    return EXIT_FAILURE;
+  }
+  litert::tools::LogParityReport(*results);
+
+  const std::string report_csv = absl::GetFlag(FLAGS_report_csv);
+  if (!report_csv.empty()) {
+    if (auto written = litert::tools::WriteParityCsv(*results, report_csv);
+        !written) {
+      ABSL_LOG(ERROR) << written.Error().Message();
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The accelerators that are not available do not fail the check, the ones
+  // that disagree with the reference do.
+  for (const auto& result : *results) {
+    if (result.Ran() && !result.Matches()) {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
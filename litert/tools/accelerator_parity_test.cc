@@ -0,0 +1,106 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/tools/accelerator_parity.h"
+
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "litert/core/filesystem.h"
+#include "litert/test/common.h"
+#include "litert/test/matchers.h"
+
+namespace litert::tools {
+namespace {
+
+using ::testing::DoubleNear;
+using ::testing::HasSubstr;
+using ::testing::StartsWith;
+
+TEST(AcceleratorParityTest, CompareOutput) {
+  const std::vector<float> reference = {1.0f, 2.0f, 3.0f, 4.0f};
+  const std::vector<float> values = {1.0f, 2.05f, 3.0f, 3.5f};
+
+  const OutputDiff diff = CompareOutput(reference, values, /*epsilon=*/0.1);
+  EXPECT_EQ(diff.num_elements, 4);
+  EXPECT_EQ(diff.num_mismatches, 1);
+  EXPECT_THAT(diff.max_abs_diff, DoubleNear(0.5, 1e-6));
+  EXPECT_THAT(diff.mean_abs_diff, DoubleNear(0.55 / 4, 1e-6));
+  EXPECT_THAT(diff.mse, DoubleNear((0.05 * 0.05 + 0.25) / 4, 1e-6));
+}
+
+TEST(AcceleratorParityTest, CompareOutputCountsNansAndMissingElements) {
+  const std::vector<float> reference = {1.0f, 2.0f, 3.0f};
+  const std::vector<float> values = {1.0f, std::nanf("")};
+
+  const OutputDiff diff = CompareOutput(reference, values, /*epsilon=*/0.1);
+  EXPECT_EQ(diff.num_elements, 2);
+  EXPECT_EQ(diff.num_mismatches, 2);
+}
+
+TEST(AcceleratorParityTest, SummarizeLatencies) {
+  const LatencyStats stats = SummarizeLatencies({4.0, 1.0, 3.0, 2.0});
+  EXPECT_DOUBLE_EQ(stats.mean_ms, 2.5);
+  EXPECT_DOUBLE_EQ(stats.p50_ms, 2.0);
+  EXPECT_DOUBLE_EQ(stats.p90_ms, 4.0);
+  EXPECT_DOUBLE_EQ(stats.min_ms, 1.0);
+  EXPECT_DOUBLE_EQ(stats.max_ms, 4.0);
+
+  EXPECT_DOUBLE_EQ(SummarizeLatencies({}).mean_ms, 0.0);
+}
+
+TEST(AcceleratorParityTest, Matches) {
+  AcceleratorResult result;
+  result.outputs.push_back({.num_elements = 4});
+  EXPECT_TRUE(result.Matches());
+
+  result.outputs.push_back({.num_elements = 4, .num_mismatches = 1});
+  EXPECT_FALSE(result.Matches());
+
+  AcceleratorResult not_run;
+  not_run.error = "No NPU";
+  EXPECT_FALSE(not_run.Matches());
+}
+
+TEST(AcceleratorParityTest, WriteParityCsv) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto dir, testing::UniqueTestDirectory::Create());
+  std::vector<AcceleratorResult> results(2);
+  results[0].accelerator = "cpu";
+  results[0].latency.p50_ms = 1.5;
+  results[1].accelerator = "npu";
+  results[1].error = "Failed to compile, no dispatch library";
+
+  const std::string path = internal::Join({dir.Str(), "parity.csv"});
+  LITERT_ASSERT_OK(WriteParityCsv(results, path));
+
+  std::ifstream file(path);
+  std::string header;
+  std::string cpu_row;
+  std::string npu_row;
+  std::getline(file, header);
+  std::getline(file, cpu_row);
+  std::getline(file, npu_row);
+  EXPECT_THAT(header, StartsWith("accelerator,ran,matches,"));
+  EXPECT_THAT(cpu_row, StartsWith("cpu,1,1,"));
+  EXPECT_THAT(cpu_row, HasSubstr(",1.500,"));
+  EXPECT_THAT(npu_row, StartsWith("npu,0,0,"));
+  EXPECT_THAT(npu_row, HasSubstr("Failed to compile; no dispatch library"));
+}
+
+}  // namespace
+}  // namespace litert::tools
@@ -0,0 +1,254 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/tools/allocation_tracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "absl/base/attributes.h"  // from @com_google_absl
+#include "absl/debugging/stacktrace.h"  // from @com_google_absl
+#include "absl/debugging/symbolize.h"  // from @com_google_absl
+#include "absl/strings/str_cat.h"  // from @com_google_absl
+#include "absl/strings/str_format.h"  // from @com_google_absl
+
+namespace litert::tools {
+namespace {
+
+constexpr int kMaxFrames = 4;
+constexpr int kMaxSites = 1024;
+constexpr int kMaxProbes = 64;
+
+// A slot of the open addressing table of call sites. The thread that claims
+// the slot by setting its key writes the frames.
+struct Site {
+  std::atomic<uint64_t> key;
+  void* frames[kMaxFrames];
+  int num_frames;
+  std::atomic<int64_t> num_allocations;
+  std::atomic<int64_t> num_bytes;
+};
+
+// Constant initialized and never destroyed, since `operator new` can be
+// called before main and after exit.
+ABSL_CONST_INIT Site sites[kMaxSites] = {};
+ABSL_CONST_INIT std::atomic<int64_t> num_scopes{0};
+ABSL_CONST_INIT std::atomic<int64_t> num_allocations{0};
+ABSL_CONST_INIT std::atomic<int64_t> num_bytes{0};
+ABSL_CONST_INIT std::atomic<int64_t> max_allocations_per_scope{0};
+ABSL_CONST_INIT std::atomic<int64_t> num_untracked_allocations{0};
+
+struct ThreadState {
+  bool tracking;
+  // Set while recording an allocation, so that the allocations of the
+  // unwinder are not recorded.
+  bool recording;
+  int64_t scope_allocations;
+};
+
+ABSL_CONST_INIT thread_local ThreadState thread_state = {};
+
+uint64_t HashFrames(void* const* frames, int num_frames) {
+  uint64_t hash = 14695981039346656037ull;
+  for (int i = 0; i < num_frames; ++i) {
+    hash ^= reinterpret_cast<uintptr_t>(frames[i]);
+    hash *= 1099511628211ull;
+  }
+  // 0 marks the free slots.
+  return hash == 0 ? 1 : hash;
+}
+
+Site* FindOrClaimSite(void* const* frames, int num_frames) {
+  const uint64_t key = HashFrames(frames, num_frames);
+  for (int probe = 0; probe < kMaxProbes; ++probe) {
+    Site& site = sites[(key + probe) % kMaxSites];
+    uint64_t site_key = site.key.load(std::memory_order_acquire);
+    if (site_key == key) {
+      return &site;
+    }
+    if (site_key == 0 &&
+        site.key.compare_exchange_strong(site_key, key,
+                                         std::memory_order_acq_rel)) {
+      std::copy(frames, frames + num_frames, site.frames);
+      site.num_frames = num_frames;
+      return &site;
+    }
+    if (site_key == key) {
+      return &site;
+    }
+  }
+  return nullptr;
+}
+
+// Out of line so that the frames skipped are always the same.
+ABSL_ATTRIBUTE_NOINLINE void RecordAllocation(size_t size) {
+  ThreadState& state = thread_state;
+  state.recording = true;
+  ++state.scope_allocations;
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  num_bytes.fetch_add(size, std::memory_order_relaxed);
+
+  void* frames[kMaxFrames];
+  // The first frame returns into `operator new`, which is skipped.
+  const int num_frames =
+      absl::GetStackTrace(frames, kMaxFrames, /*skip_count=*/1);
+  if (Site* site = FindOrClaimSite(frames, num_frames)) {
+    site->num_allocations.fetch_add(1, std::memory_order_relaxed);
+    site->num_bytes.fetch_add(size, std::memory_order_relaxed);
+  } else {
+    num_untracked_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  state.recording = false;
+}
+
+inline void MaybeRecordAllocation(size_t size) {
+  const ThreadState& state = thread_state;
+  if (ABSL_PREDICT_FALSE(state.tracking && !state.recording)) {
+    RecordAllocation(size);
+  }
+}
+
+void* Allocate(size_t size) {
+  if (size == 0) size = 1;
+  for (;;) {
+    if (void* ptr = std::malloc(size)) {
+      return ptr;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr) {
+#if defined(__cpp_exceptions)
+      throw std::bad_alloc();
+#else
+      std::abort();
+#endif
+    }
+    handler();
+  }
+}
+
+std::string SymbolizeFrame(void* frame) {
+  char symbol[256];
+  if (absl::Symbolize(frame, symbol, sizeof(symbol))) {
+    return symbol;
+  }
+  return absl::StrFormat("%p", frame);
+}
+
+}  // namespace
+
+ScopedAllocationTracking::ScopedAllocationTracking() {
+  thread_state.scope_allocations = 0;
+  thread_state.tracking = true;
+}
+
+ScopedAllocationTracking::~ScopedAllocationTracking() {
+  thread_state.tracking = false;
+  num_scopes.fetch_add(1, std::memory_order_relaxed);
+  const int64_t scope_allocations = thread_state.scope_allocations;
+  int64_t max_allocations =
+      max_allocations_per_scope.load(std::memory_order_relaxed);
+  while (scope_allocations > max_allocations &&
+         !max_allocations_per_scope.compare_exchange_weak(
+             max_allocations, scope_allocations,
+             std::memory_order_relaxed)) {
+  }
+}
+
+AllocationReport GetAllocationReport() {
+  AllocationReport report;
+  report.num_scopes = num_scopes.load(std::memory_order_relaxed);
+  report.num_allocations = num_allocations.load(std::memory_order_relaxed);
+  report.num_bytes = num_bytes.load(std::memory_order_relaxed);
+  report.max_allocations_per_scope =
+      max_allocations_per_scope.load(std::memory_order_relaxed);
+  report.num_untracked_allocations =
+      num_untracked_allocations.load(std::memory_order_relaxed);
+  for (const Site& site : sites) {
+    if (site.key.load(std::memory_order_acquire) == 0) continue;
+    AllocationSite& reported = report.sites.emplace_back();
+    reported.frames.assign(site.frames, site.frames + site.num_frames);
+    reported.num_allocations =
+        site.num_allocations.load(std::memory_order_relaxed);
+    reported.num_bytes = site.num_bytes.load(std::memory_order_relaxed);
+  }
+  std::sort(report.sites.begin(), report.sites.end(),
+            [](const AllocationSite& a, const AllocationSite& b) {
+              return a.num_allocations > b.num_allocations;
+            });
+  return report;
+}
+
+void ResetAllocationTracking() {
+  for (Site& site : sites) {
+    site.num_allocations.store(0, std::memory_order_relaxed);
+    site.num_bytes.store(0, std::memory_order_relaxed);
+    site.num_frames = 0;
+    site.key.store(0, std::memory_order_release);
+  }
+  num_scopes.store(0, std::memory_order_relaxed);
+  num_allocations.store(0, std::memory_order_relaxed);
+  num_bytes.store(0, std::memory_order_relaxed);
+  max_allocations_per_scope.store(0, std::memory_order_relaxed);
+  num_untracked_allocations.store(0, std::memory_order_relaxed);
+}
+
+std::string AllocationReport::ToString(int max_sites) const {
+  std::string result = absl::StrFormat(
+      "%d allocations (%d bytes) in %d scopes, at most %d in one scope",
+      num_allocations, num_bytes, num_scopes, max_allocations_per_scope);
+  if (num_untracked_allocations > 0) {
+    absl::StrAppendFormat(&result, ", %d without a call site",
+                          num_untracked_allocations);
+  }
+  const int num_printed = std::min<int>(max_sites, sites.size());
+  for (int i = 0; i < num_printed; ++i) {
+    const AllocationSite& site = sites[i];
+    absl::StrAppendFormat(&result, "\n  %8d allocs %10d bytes  ",
+                          site.num_allocations, site.num_bytes);
+    for (int frame = 0; frame < site.frames.size(); ++frame) {
+      absl::StrAppend(&result, frame == 0 ? "" : " <- ",
+                      SymbolizeFrame(site.frames[frame]));
+    }
+  }
+  if (num_printed < sites.size()) {
+    absl::StrAppendFormat(&result, "\n  ... %d more sites",
+                          sites.size() - num_printed);
+  }
+  return result;
+}
+
+}  // namespace litert::tools
+
+// The replaceable global allocation functions. The array and the other sized
+// forms forward to these by default.
+
+void* operator new(size_t size) {
+  litert::tools::MaybeRecordAllocation(size);
+  return litert::tools::Allocate(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  litert::tools::MaybeRecordAllocation(size);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
@@ -0,0 +1,81 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_TOOLS_ALLOCATION_TRACKER_H_
+#define ODML_LITERT_LITERT_TOOLS_ALLOCATION_TRACKER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Hot-path allocation tracking: counts the allocations made on a thread while
+// it runs a model, grouped by call site, so that the allocations of a steady
+// state run can be reported and asserted on.
+//
+// Linking this library replaces the global `operator new` and
+// `operator delete`. Outside of a tracking scope, they only forward to
+// `malloc` and `free` after a thread-local check. Aligned `operator new` and
+// direct `malloc` calls are not tracked.
+
+namespace litert::tools {
+
+struct AllocationSite {
+  // Return addresses, starting at the caller of `operator new`. Unwinding
+  // stops early in code built without frame pointers.
+  std::vector<void*> frames;
+  int64_t num_allocations = 0;
+  int64_t num_bytes = 0;
+};
+
+struct AllocationReport {
+  // Tracking scopes that ended since the last reset.
+  int64_t num_scopes = 0;
+  int64_t num_allocations = 0;
+  int64_t num_bytes = 0;
+  // The most allocations made in a single scope.
+  int64_t max_allocations_per_scope = 0;
+  // Most allocations first.
+  std::vector<AllocationSite> sites;
+  // Allocations whose call site did not fit in the table of sites. They are
+  // counted in `num_allocations`, but not in `sites`.
+  int64_t num_untracked_allocations = 0;
+
+  // One line per site, with its symbolized frames, for the first `max_sites`
+  // sites.
+  std::string ToString(int max_sites = 10) const;
+};
+
+// Tracks the allocations of the calling thread while alive. Scopes don't
+// nest.
+class ScopedAllocationTracking {
+ public:
+  ScopedAllocationTracking();
+  ~ScopedAllocationTracking();
+
+  ScopedAllocationTracking(const ScopedAllocationTracking&) = delete;
+  ScopedAllocationTracking& operator=(const ScopedAllocationTracking&) =
+      delete;
+};
+
+// Returns what the scopes that ended since the last reset tracked. Must not
+// be called while a scope is active.
+AllocationReport GetAllocationReport();
+
+// Forgets the tracked allocations. Must not be called while a scope is
+// active.
+void ResetAllocationTracking();
+
+}  // namespace litert::tools
+
+#endif  // ODML_LITERT_LITERT_TOOLS_ALLOCATION_TRACKER_H_
@@ -0,0 +1,112 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/tools/allocation_tracker.h"
+
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace litert::tools {
+namespace {
+
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+
+class AllocationTrackerTest : public ::testing::Test {
+ protected:
+  void SetUp() override { ResetAllocationTracking(); }
+  void TearDown() override { ResetAllocationTracking(); }
+
+  // Kept outside of the scopes, so that the allocations are not elided.
+  std::vector<std::unique_ptr<int>> allocated_;
+};
+
+TEST_F(AllocationTrackerTest, CountsTheAllocationsInTheScope) {
+  allocated_.reserve(8);
+  {
+    ScopedAllocationTracking tracking;
+    for (int i = 0; i < 3; ++i) {
+      allocated_.push_back(std::make_unique<int>(i));
+    }
+  }
+  allocated_.push_back(std::make_unique<int>(3));
+
+  const AllocationReport report = GetAllocationReport();
+  EXPECT_EQ(report.num_scopes, 1);
+  EXPECT_EQ(report.num_allocations, 3);
+  EXPECT_EQ(report.num_bytes, 3 * sizeof(int));
+  EXPECT_EQ(report.max_allocations_per_scope, 3);
+  ASSERT_THAT(report.sites, SizeIs(1));
+  EXPECT_EQ(report.sites[0].num_allocations, 3);
+  EXPECT_THAT(report.ToString(), HasSubstr("3 allocations"));
+}
+
+TEST_F(AllocationTrackerTest, ReportsTheMostAllocationsInOneScope) {
+  allocated_.reserve(8);
+  {
+    ScopedAllocationTracking tracking;
+    allocated_.push_back(std::make_unique<int>(0));
+  }
+  {
+    ScopedAllocationTracking tracking;
+  }
+  {
+    ScopedAllocationTracking tracking;
+    allocated_.push_back(std::make_unique<int>(1));
+    allocated_.push_back(std::make_unique<int>(2));
+  }
+
+  const AllocationReport report = GetAllocationReport();
+  EXPECT_EQ(report.num_scopes, 3);
+  EXPECT_EQ(report.num_allocations, 3);
+  EXPECT_EQ(report.max_allocations_per_scope, 2);
+}
+
+TEST_F(AllocationTrackerTest, IgnoresTheOtherThreads) {
+  std::unique_ptr<int> allocated_by_thread;
+  std::thread thread;
+  {
+    ScopedAllocationTracking tracking;
+    thread = std::thread(
+        [&allocated_by_thread] { allocated_by_thread.reset(new int(0)); });
+  }
+  thread.join();
+
+  const AllocationReport report = GetAllocationReport();
+  // Starting the thread allocates its state, on this thread.
+  for (const AllocationSite& site : report.sites) {
+    EXPECT_NE(site.num_bytes, sizeof(int));
+  }
+}
+
+TEST_F(AllocationTrackerTest, ForgetsTheAllocationsOnReset) {
+  {
+    ScopedAllocationTracking tracking;
+    allocated_.push_back(std::make_unique<int>(0));
+  }
+  ResetAllocationTracking();
+
+  const AllocationReport report = GetAllocationReport();
+  EXPECT_EQ(report.num_scopes, 0);
+  EXPECT_EQ(report.num_allocations, 0);
+  EXPECT_THAT(report.sites, IsEmpty());
+}
+
+}  // namespace
+}  // namespace litert::tools
@@ -19,6 +19,7 @@
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/flags/flag.h"  // from @com_google_absl
 #include "absl/flags/parse.h"  // from @com_google_absl
@@ -28,8 +29,11 @@
 #include "litert/cc/internal/litert_logging.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_model.h"
+#include "litert/compiler/plugin/algo.h"
+#include "litert/core/build_stamp.h"
 #include "litert/core/model/model.h"
 #include "litert/tools/dump.h"
+#include "litert/tools/model_estimates.h"
 #include "litert/tools/tool_display.h"
 
 ABSL_FLAG(std::string, model_path, "", "Model to analyze");
@@ -38,11 +42,19 @@ ABSL_FLAG(bool, no_ops, false,
           "number of ops).");
 ABSL_FLAG(bool, only_summarize, false,
           "Only include the summary in the output.");
+ABSL_FLAG(double, transfer_cost_per_byte, 0.0,
+          "Estimated cost of moving one byte between the host and the "
+          "accelerator, used to report the cost of the dispatch op "
+          "boundaries.");
 
 namespace litert::tools {
 namespace {
 
 using ::litert::internal::Dump;
+using ::litert::internal::EstimatePartition;
+using ::litert::internal::GetCustomOpCode;
+using ::litert::internal::kLiteRtDispatchOpCustomName;
+using ::litert::internal::PartitionCostModel;
 
 class ModelAnalyzer {
  public:
@@ -79,6 +91,34 @@ class ModelAnalyzer {
     return summary;
   }
 
+  // Reports the boundary of each dispatch op, i.e. each partition offloaded
+  // to an accelerator, and the estimated cost of its transfers.
+  void AnalyzePartitions(std::ostream& out,
+                         const PartitionCostModel& cost_model) {
+    for (auto i = 0; i < Model().NumSubgraphs(); ++i) {
+      const auto& ops = Model().Subgraph(i).Ops();
+      for (auto j = 0; j < ops.size(); ++j) {
+        auto custom_op_code = GetCustomOpCode(Model(), *ops[j]);
+        if (!custom_op_code ||
+            *custom_op_code != kLiteRtDispatchOpCustomName) {
+          continue;
+        }
+        const auto estimate = EstimatePartition({ops[j]}, cost_model);
+        out << absl::StreamFormat(
+            "  Subgraph %d, op %d: boundary %s, transfer cost %f\n", i, j,
+            HumanReadableSize(estimate.boundary_bytes),
+            cost_model.transfer_cost_per_byte * estimate.boundary_bytes);
+      }
+    }
+  }
+
+  // Reports the static memory and bandwidth estimates of each signature.
+  void AnalyzeEstimates(std::ostream& out, bool no_ops) {
+    for (const auto& estimate : EstimateSignatures(Model())) {
+      DumpEstimate(estimate, out, !no_ops);
+    }
+  }
+
   void AnalyzeOp(std::ostream& out, size_t subgraph_idx, size_t op_idx) {
     Dump(Model().Subgraph(subgraph_idx).Op(op_idx), out);
   }
@@ -116,7 +156,8 @@ void FormatSummary(std::ostream& out, const ModelAnalyzer::Summary& summary) {
 }
 
 Expected<void> AnalyzeModel(const std::string& model_path, bool no_ops,
-                            bool only_summarize) {
+                            bool only_summarize,
+                            double transfer_cost_per_byte) {
   ToolDisplay display(std::cerr, "LITERT_MODEL_ANALYZE");
   DumpPreamble(display);
   auto scope = display.StartS("Model analysis");
@@ -145,6 +186,16 @@ Expected<void> AnalyzeModel(const std::string& model_path, bool no_ops,
     return {};
   }
 
+  display.Start("Analyzing partitions");
+  PartitionCostModel cost_model;
+  cost_model.transfer_cost_per_byte = transfer_cost_per_byte;
+  analyzer.AnalyzePartitions(display.Display(), cost_model);
+  display.Done("Analyzing partitions");
+
+  display.Start("Estimating memory and bandwidth");
+  analyzer.AnalyzeEstimates(display.Display(), no_ops);
+  display.Done("Estimating memory and bandwidth");
+
   display.Start("Analyzing graph");
   display.Display() << "\n";
   for (auto i = 0; i < analyzer.Model().NumSubgraphs(); ++i) {
@@ -173,7 +224,10 @@ int main(int argc, char* argv[]) {
   const auto model_path = absl::GetFlag(FLAGS_model_path);
   const auto no_ops = absl::GetFlag(FLAGS_no_ops);
   const auto only_summarize = absl::GetFlag(FLAGS_only_summarize);
+  const auto transfer_cost_per_byte =
+      absl::GetFlag(FLAGS_transfer_cost_per_byte);
 
-  return !litert::tools::AnalyzeModel(model_path, no_ops, only_summarize)
+  return !litert::tools::AnalyzeModel(model_path, no_ops, only_summarize,
+                                      transfer_cost_per_byte)
               .HasValue();
 }
@@ -48,7 +48,9 @@ using ::litert::BufferRef;
 using ::litert::internal::CompilerPlugin;
 using ::litert::internal::Dump;
 using ::litert::internal::PartitionResult;
+using ::litert::internal::SerializationOptions;
 using ::litert::internal::SerializeModel;
+using ::litert::internal::SerializeModelTo;
 using ::litert::internal::VerifyFlatbuffer;
 using ::litert::tools::ApplyPluginRun;
 
@@ -59,6 +61,10 @@ using ::litert::tools::ApplyPluginRun;
 
 namespace {
 
+// Weights at least this large are appended after the flatbuffer when applying
+// a plugin, so that they are streamed to the output from the input model.
+constexpr size_t kMinAppendedWeightsSize = 1024 * 1024;
+
 class Context {
  public:
   using Ptr = std::unique_ptr<Context>;
@@ -137,9 +143,9 @@ void DumpCompilationResult(ToolDisplay& display, size_t byte_code_size,
       byte_code_size);
 }
 
-void DumpModelStats(ToolDisplay& display, BufferRef<uint8_t> buf) {
+void DumpModelStats(ToolDisplay& display, size_t model_size) {
   display.Labeled() << absl::StreamFormat(
-      "Serialized a model of size %lu bytes\n", buf.Size());
+      "Serialized a model of size %lu bytes\n", model_size);
 }
 
 void DumpPartitionResult(ToolDisplay& display, const PartitionResult& result) {
@@ -337,7 +343,7 @@ LiteRtStatus Partition(Context& ctx) {
 
   ctx.Dump().Start("Serializing model");
   auto serialized = SerializeModel(std::move(model));
-  DumpModelStats(ctx.Dump(), *serialized);
+  DumpModelStats(ctx.Dump(), serialized->Size());
   ctx.Dump().Done();
 
   ctx.Dump().Start("Verifying flatbuffer");
@@ -447,7 +453,8 @@ LiteRtStatus Apply(Context& ctx) {
 
   ctx.Dump().Start("Applying plugin");
   if (auto status = litert::internal::ApplyPlugin(
-          *plugin, model, ctx.SocModelTarget(), ctx.Run().subgraphs);
+          *plugin, model, ctx.SocModelTarget(), ctx.Run().subgraphs,
+          ctx.Run().num_compile_threads);
       !status) {
     LITERT_LOG(LITERT_ERROR, "%s", status.Error().Message().c_str());
     return status.Error().Status();
@@ -455,19 +462,17 @@ LiteRtStatus Apply(Context& ctx) {
   ctx.Dump().Done();
 
   ctx.Dump().Start("Serializing model");
-  auto serialized = SerializeModel(std::move(model));
-  DumpModelStats(ctx.Dump(), *serialized);
-  ctx.Dump().Done();
-
-  ctx.Dump().Start("Verifying flatbuffer");
-  LITERT_RETURN_IF_ERROR(
-      VerifyFlatbuffer(serialized->Span()),
-      ErrorStatusBuilder(kLiteRtStatusErrorInvalidFlatbuffer))
-      << "Failed to invalidate flatbuffer";
-  ctx.Dump().Done();
-
-  ctx.Dump().Start("Writing to out");
-  serialized->WriteStr(ctx.Out());
+  // The flatbuffer is verified during serialization, and the bytecode and
+  // large weights are written to the output without being copied into one
+  // buffer first.
+  SerializationOptions options;
+  options.min_appended_weights_size = kMinAppendedWeightsSize;
+  auto model_size = SerializeModelTo(std::move(model), ctx.Out(), options);
+  if (!model_size) {
+    LITERT_LOG(LITERT_ERROR, "%s", model_size.Error().Message().c_str());
+    return model_size.Error().Status();
+  }
+  DumpModelStats(ctx.Dump(), *model_size);
   ctx.Dump().Done();
 
   return kLiteRtStatusOk;
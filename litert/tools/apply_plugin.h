@@ -15,6 +15,7 @@
 #ifndef ODML_LITERT_LITERT_TOOLS_APPLY_PLUGIN_H_
 #define ODML_LITERT_LITERT_TOOLS_APPLY_PLUGIN_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <memory>
@@ -148,6 +149,10 @@ struct ApplyPluginRun {
   // plugin.
   absl::flat_hash_set<uint32_t> subgraphs = {};
 
+  // Maximum number of concurrent plugin compilation calls, see
+  // litert::internal::ApplyPluginWithPartition.
+  size_t num_compile_threads = 1;
+
   // Options structure (containing opaque chain).
   // TODO: lukeboyer - Consolidate as much as possible from this class
   // into the official options api.
@@ -81,6 +81,7 @@ ApplyPluginRun::Ptr ParseFlags() {
   for (auto subgraph_idx : subgraphs.elements) {
     res->subgraphs.insert(subgraph_idx);
   }
+  res->num_compile_threads = absl::GetFlag(FLAGS_num_compile_threads);
 
   return res;
 }
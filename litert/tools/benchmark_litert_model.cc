@@ -14,12 +14,15 @@ limitations under the License.
 ==============================================================================*/
 #include "litert/tools/benchmark_litert_model.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/strings/str_format.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
@@ -42,6 +45,10 @@ limitations under the License.
 #include "litert/cc/options/litert_runtime_options.h"
 #include "litert/core/util/perfetto_profiling.h"
 #include "litert/runtime/compiled_model.h"
+#include "litert/tools/allocation_tracker.h"
+#include "litert/tools/concurrent_clients.h"
+#include "litert/tools/sustained_load.h"
+#include "tensorflow/core/util/stats_calculator.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/c/common.h"
 #include "tflite/interpreter.h"
@@ -243,8 +250,21 @@ TfLiteStatus BenchmarkLiteRtModel::Init() {
     LITERT_ASSIGN_OR_ABORT(profiler_, compiled_model_->GetProfiler());
     profiler_.StartProfiling();
   }
-  log_output_ =
-      std::make_unique<BenchmarkLoggingListener>(run_summarizer_.get());
+  if (params_.Get<bool>("report_partition_breakdown")) {
+    auto signature = params_.Get<std::string>("signature_to_run_for");
+    int subgraph_index =
+        signature.empty()
+            ? 0
+            : interpreter_->GetSubgraphIndexFromSignature(signature.c_str());
+    if (subgraph_index < 0) {
+      subgraph_index = 0;
+    }
+    partition_breakdown_ = std::make_unique<PartitionBreakdown>(
+        GetPartitionNodes(*interpreter_->subgraph(subgraph_index)),
+        subgraph_index);
+  }
+  log_output_ = std::make_unique<BenchmarkLoggingListener>(
+      run_summarizer_.get(), partition_breakdown_.get());
   AddListener(log_output_.get());
 
   auto signature = params_.Get<std::string>("signature_to_run_for");
@@ -263,4 +283,194 @@ TfLiteStatus BenchmarkLiteRtModel::Init() {
 
   return kTfLiteOk;
 }
+
+TfLiteStatus BenchmarkLiteRtModel::ValidateParams() {
+  TF_LITE_ENSURE_STATUS(BenchmarkModel::ValidateParams());
+  // The breakdown is computed from the profiler events.
+  if (params_.Get<bool>("report_partition_breakdown")) {
+    params_.Set<bool>("use_profiler", true);
+  }
+  const int num_clients = params_.Get<int32_t>("num_clients");
+  if (num_clients < 1) {
+    LITERT_LOG(LITERT_ERROR, "num_clients must be at least 1, got %d",
+               num_clients);
+    return kTfLiteError;
+  }
+  if (num_clients > 1 && params_.Get<float>("sustained_duration_secs") > 0) {
+    LITERT_LOG(LITERT_ERROR,
+               "num_clients and sustained_duration_secs are exclusive.");
+    return kTfLiteError;
+  }
+  if (params_.Get<int32_t>("max_allocations_per_run") >= 0) {
+    params_.Set<bool>("track_run_allocations", true);
+  }
+  // The allocations are tracked on the thread of the first client only.
+  if (num_clients > 1 && params_.Get<bool>("track_run_allocations")) {
+    LITERT_LOG(LITERT_ERROR,
+               "num_clients and track_run_allocations are exclusive.");
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus BenchmarkLiteRtModel::ReportRunAllocations() {
+  const tools::AllocationReport report = tools::GetAllocationReport();
+  LITERT_LOG(LITERT_INFO, "\nAllocations in steady state runs: %s",
+             report.ToString().c_str());
+  const int max_allocations = params_.Get<int32_t>("max_allocations_per_run");
+  if (max_allocations >= 0 &&
+      report.max_allocations_per_scope > max_allocations) {
+    LITERT_LOG(LITERT_ERROR,
+               "A steady state run made %d heap allocations, more than "
+               "max_allocations_per_run (%d).",
+               static_cast<int>(report.max_allocations_per_scope),
+               max_allocations);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus BenchmarkLiteRtModel::CreateClients(int num_clients) {
+  auto signature = params_.Get<std::string>("signature_to_run_for");
+  const bool share_compiled_model = params_.Get<bool>("share_compiled_model");
+  while (static_cast<int>(clients_.size()) + 1 < num_clients) {
+    auto compilation_options = CreateCompiledModelOptions(params_);
+    LITERT_ASSIGN_OR_RETURN(
+        auto compiled_model,
+        share_compiled_model
+            ? litert::CompiledModel::CreateShared(*compiled_model_,
+                                                  compilation_options)
+            : litert::CompiledModel::Create(*environment_, *model_,
+                                            compilation_options),
+        AsTfLiteStatus(_ << "Failed to compile the model of a client."));
+    Client client;
+    client.compiled_model =
+        std::make_unique<litert::CompiledModel>(std::move(compiled_model));
+    LITERT_ASSIGN_OR_RETURN(
+        client.input_buffers,
+        client.compiled_model->CreateInputBuffers(signature),
+        AsTfLiteStatus(_ << "Failed to create input buffer."));
+    LITERT_ASSIGN_OR_RETURN(
+        client.output_buffers,
+        client.compiled_model->CreateOutputBuffers(signature),
+        AsTfLiteStatus(_ << "Failed to create output buffer."));
+    TF_LITE_ENSURE_STATUS(WriteRandomInputs(client.input_buffers));
+    clients_.push_back(std::move(client));
+  }
+  return kTfLiteOk;
+}
+
+tensorflow::StatWithPercentiles<int64_t> BenchmarkLiteRtModel::RunClients(
+    int runs_per_client, float max_secs, TfLiteStatus* invoke_status) {
+  tensorflow::StatWithPercentiles<int64_t> latency_us;
+  const int num_clients = params_.Get<int32_t>("num_clients");
+  *invoke_status = CreateClients(num_clients);
+  if (*invoke_status != kTfLiteOk) {
+    return latency_us;
+  }
+  LITERT_LOG(LITERT_INFO, "Running up to %d concurrent clients (%s model)",
+             num_clients,
+             params_.Get<bool>("share_compiled_model") ? "shared" : "separate");
+
+  auto signature = params_.Get<std::string>("signature_to_run_for");
+  auto run_once = [&](int client) {
+    auto res = client == 0
+                   ? compiled_model_->Run(signature, *input_buffers_,
+                                          *output_buffers_)
+                   : clients_[client - 1].compiled_model->Run(
+                         signature, clients_[client - 1].input_buffers,
+                         clients_[client - 1].output_buffers);
+    if (!res) {
+      LITERT_LOG(LITERT_ERROR, "Run of client %d failed: %s", client,
+                 res.Error().Message().c_str());
+    }
+    return static_cast<bool>(res);
+  };
+  // Sweep the client count, so that the scaling is measured against a single
+  // client on the same device.
+  std::vector<ConcurrencyLevelResult> levels;
+  for (int count : ConcurrencySweep(num_clients)) {
+    levels.push_back(
+        RunConcurrentClients(count, runs_per_client, max_secs, run_once));
+    if (levels.back().num_failures > 0) {
+      *invoke_status = kTfLiteError;
+    }
+  }
+  LogConcurrencyReport(levels);
+
+  for (const auto& client_latencies_us : levels.back().latencies_us) {
+    for (int64_t time_us : client_latencies_us) {
+      latency_us.UpdateStat(time_us);
+    }
+  }
+  return latency_us;
+}
+
+tensorflow::StatWithPercentiles<int64_t> BenchmarkLiteRtModel::Run(
+    int min_num_times, float min_secs, float max_secs,
+    ::tflite::benchmark::RunType run_type, TfLiteStatus* invoke_status) {
+  // The warmup runs are not tracked: only the regular runs are in steady
+  // state. The tracked runs are those below.
+  if (run_type == ::tflite::benchmark::REGULAR &&
+      params_.Get<bool>("track_run_allocations") && !track_run_allocations_) {
+    tools::ResetAllocationTracking();
+    track_run_allocations_ = true;
+    auto stats =
+        Run(min_num_times, min_secs, max_secs, run_type, invoke_status);
+    track_run_allocations_ = false;
+    if (ReportRunAllocations() != kTfLiteOk) {
+      *invoke_status = kTfLiteError;
+    }
+    return stats;
+  }
+  if (run_type == ::tflite::benchmark::REGULAR &&
+      params_.Get<int32_t>("num_clients") > 1) {
+    return RunClients(std::max(min_num_times, 1), max_secs, invoke_status);
+  }
+  const float duration_secs = params_.Get<float>("sustained_duration_secs");
+  if (run_type != ::tflite::benchmark::REGULAR || duration_secs <= 0) {
+    return BenchmarkModel::Run(min_num_times, min_secs, max_secs, run_type,
+                               invoke_status);
+  }
+
+  SustainedLoadOptions options;
+  options.duration_secs = duration_secs;
+  options.target_qps = params_.Get<float>("sustained_target_qps");
+  options.poisson_arrivals = params_.Get<bool>("sustained_poisson_arrivals");
+  options.window_secs = params_.Get<float>("sustained_window_secs");
+  const std::string rate =
+      options.target_qps > 0
+          ? absl::StrFormat("%.2f QPS (%s arrivals)", options.target_qps,
+                            options.poisson_arrivals ? "Poisson"
+                                                     : "fixed interval")
+          : "full speed";
+  LITERT_LOG(LITERT_INFO, "Running a sustained load for %.1f seconds at %s",
+             duration_secs, rate.c_str());
+
+  *invoke_status = kTfLiteOk;
+  SustainedLoadReport report = RunSustainedLoad(options, [&]() {
+    ResetInputsAndOutputs();
+    listeners_.OnSingleRunStart(run_type);
+    TfLiteStatus status = RunImpl();
+    listeners_.OnSingleRunEnd();
+    return status == kTfLiteOk;
+  });
+  if (report.num_failures > 0) {
+    *invoke_status = kTfLiteError;
+  }
+  LogSustainedLoadReport(report);
+
+  const auto csv_path = params_.Get<std::string>("sustained_result_csv");
+  if (!csv_path.empty()) {
+    if (auto res = WriteSustainedLoadCsv(report, csv_path); !res) {
+      LITERT_LOG(LITERT_ERROR, "%s", res.Error().Message().c_str());
+    }
+  }
+
+  tensorflow::StatWithPercentiles<int64_t> service_time_us;
+  for (int64_t time_us : report.service_times_us) {
+    service_time_us.UpdateStat(time_us);
+  }
+  return service_time_us;
+}
 }  // namespace litert::benchmark
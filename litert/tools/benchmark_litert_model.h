@@ -20,6 +20,7 @@ limitations under the License.
 #include <fstream>
 #include <ios>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -37,6 +38,8 @@ limitations under the License.
 #include "litert/cc/litert_model.h"
 #include "litert/cc/litert_profiler.h"
 #include "litert/cc/litert_tensor_buffer.h"
+#include "litert/tools/allocation_tracker.h"
+#include "litert/tools/partition_breakdown.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/c/common.h"
 #include "tflite/interpreter.h"
@@ -58,11 +61,14 @@ class BenchmarkLoggingListener : public ::tflite::benchmark::BenchmarkListener {
  private:
   std::string result_file_path_ = "";
   tflite::profiling::ProfileSummarizer* run_summarizer_;
+  const PartitionBreakdown* partition_breakdown_;
 
  public:
   explicit BenchmarkLoggingListener(
-      tflite::profiling::ProfileSummarizer* run_summarizer)
-      : run_summarizer_(run_summarizer) {}
+      tflite::profiling::ProfileSummarizer* run_summarizer,
+      const PartitionBreakdown* partition_breakdown = nullptr)
+      : run_summarizer_(run_summarizer),
+        partition_breakdown_(partition_breakdown) {}
 
   void OnBenchmarkStart(
       const ::tflite::benchmark::BenchmarkParams& params) override {
@@ -178,11 +184,16 @@ class BenchmarkLoggingListener : public ::tflite::benchmark::BenchmarkListener {
       LITERT_LOG(LITERT_INFO, "\n%s",
                  run_summarizer_->GetOutputString().c_str());
     }
+    if (partition_breakdown_) {
+      LITERT_LOG(LITERT_INFO, "\n%s",
+                 partition_breakdown_->ToString().c_str());
+    }
   }
 };
 
 // Dumps the Model Runtime Info if enabled when export_model_runtime_info is
-// set to true.
+// set to true. With the profiler, it is dumped again at the end of the
+// benchmark with the measured time of each node, next to its estimated cost.
 class ModelRuntimeInfoListener : public ::tflite::benchmark::BenchmarkListener {
  public:
   explicit ModelRuntimeInfoListener(::tflite::Interpreter* interpreter_ptr)
@@ -192,20 +203,53 @@ class ModelRuntimeInfoListener : public ::tflite::benchmark::BenchmarkListener {
   // So the interpreter can be used to capture the ModelRuntimeDetails.
   void OnBenchmarkStart(
       const ::tflite::benchmark::BenchmarkParams& params) override {
-    const std::string output_file_path =
+    output_file_path_ =
         std::string(params.Get<std::string>("model_runtime_info_output_file"));
+    Generate({});
+  }
+
+  void OnBenchmarkEnd(
+      const ::tflite::benchmark::BenchmarkResults& results) override {
+    if (node_events_.empty()) {
+      return;
+    }
+    std::vector<const tflite::profiling::ProfileEvent*> events;
+    events.reserve(node_events_.size());
+    for (const auto& event : node_events_) {
+      events.push_back(&event);
+    }
+    Generate(events);
+  }
+
+  // Keeps the operator invoke events of a run.
+  void ProcessProfiles(
+      const std::vector<const tflite::profiling::ProfileEvent*>& events) {
+    for (const auto* event : events) {
+      if (event->event_type ==
+          tflite::profiling::ProfileEvent::EventType::OPERATOR_INVOKE_EVENT) {
+        node_events_.push_back(*event);
+      }
+    }
+  }
+
+ private:
+  void Generate(
+      const std::vector<const tflite::profiling::ProfileEvent*>& events) {
     const auto status = tflite::profiling::GenerateModelRuntimeInfo(
-        *interpreter_, output_file_path);
+        *interpreter_, events, output_file_path_);
     if (status != kTfLiteOk) {
-      LITERT_LOG(LITERT_ERROR, "Failed to generate model runtime info: %s",
+      LITERT_LOG(LITERT_ERROR, "Failed to generate model runtime info: %d",
                  status);
+      return;
     }
-    LITERT_LOG(LITERT_INFO, "Generated model runtime info: %s",
-               output_file_path.c_str());
+    LITERT_LOG(LITERT_INFO, "Generated model runtime info%s: %s",
+               events.empty() ? "" : " with the measured node times",
+               output_file_path_.c_str());
   }
 
- private:
   ::tflite::Interpreter* interpreter_ = nullptr;
+  std::string output_file_path_;
+  std::vector<tflite::profiling::ProfileEvent> node_events_;
 };
 using ::litert::CompiledModel;
 using ::litert::Environment;
@@ -256,6 +300,25 @@ class BenchmarkLiteRtModel : public BenchmarkModel {
                             BenchmarkParam::Create<std::string>(""));
     default_params.AddParam("mediatek_nerun_pilot_version",
                             BenchmarkParam::Create<std::string>("version8"));
+    default_params.AddParam("sustained_duration_secs",
+                            BenchmarkParam::Create<float>(0.0f));
+    default_params.AddParam("sustained_target_qps",
+                            BenchmarkParam::Create<float>(0.0f));
+    default_params.AddParam("sustained_poisson_arrivals",
+                            BenchmarkParam::Create<bool>(false));
+    default_params.AddParam("sustained_window_secs",
+                            BenchmarkParam::Create<float>(10.0f));
+    default_params.AddParam("sustained_result_csv",
+                            BenchmarkParam::Create<std::string>(""));
+    default_params.AddParam("num_clients", BenchmarkParam::Create<int32_t>(1));
+    default_params.AddParam("share_compiled_model",
+                            BenchmarkParam::Create<bool>(true));
+    default_params.AddParam("report_partition_breakdown",
+                            BenchmarkParam::Create<bool>(false));
+    default_params.AddParam("track_run_allocations",
+                            BenchmarkParam::Create<bool>(false));
+    default_params.AddParam("max_allocations_per_run",
+                            BenchmarkParam::Create<int32_t>(-1));
     return default_params;
   }
 
@@ -298,13 +361,18 @@ class BenchmarkLiteRtModel : public BenchmarkModel {
       return kTfLiteError;
     }
     auto signature = params_.Get<std::string>("signature_to_run_for");
-    if (auto res = compiled_model_->Run(signature, *input_buffers_,
-                                        *output_buffers_)) {
-      return kTfLiteOk;
-    } else {
+    std::optional<tools::ScopedAllocationTracking> allocation_tracking;
+    if (track_run_allocations_) {
+      allocation_tracking.emplace();
+    }
+    auto res = compiled_model_->Run(signature, *input_buffers_,
+                                    *output_buffers_);
+    allocation_tracking.reset();
+    if (!res) {
       LITERT_LOG(LITERT_ERROR, "Run failed: %s", res.Error().Message().c_str());
       return kTfLiteError;
     }
+    return kTfLiteOk;
   }
 
   uint64_t ComputeInputBytes() override {
@@ -332,8 +400,12 @@ class BenchmarkLiteRtModel : public BenchmarkModel {
   }
 
   TfLiteStatus PrepareInputData() override {
+    return WriteRandomInputs(*input_buffers_);
+  }
+
+  TfLiteStatus WriteRandomInputs(std::vector<litert::TensorBuffer>& buffers) {
     int index = 0;
-    for (auto& buffer : *input_buffers_) {
+    for (auto& buffer : buffers) {
       auto t_data =
           CreateRandomTensorData(buffer, "input_" + std::to_string(index));
       auto res = buffer.Write<char>(absl::MakeSpan(
@@ -374,6 +446,12 @@ class BenchmarkLiteRtModel : public BenchmarkModel {
         tflite_events.push_back(std::move(tflite_event));
       }
       run_summarizer_->ProcessProfiles(tflite_ptr_events, *interpreter_);
+      if (partition_breakdown_) {
+        partition_breakdown_->ProcessProfiles(tflite_ptr_events);
+      }
+      if (model_runtime_info_listener_) {
+        model_runtime_info_listener_->ProcessProfiles(tflite_ptr_events);
+      }
       profiler_.Reset();
       profiler_.StartProfiling();
     }
@@ -419,18 +497,86 @@ class BenchmarkLiteRtModel : public BenchmarkModel {
         "Path to save the benchmark result in binary proto format."));
     flags.push_back(tflite::benchmark::CreateFlag<std::string>(
         "model_runtime_info_output_file", &params_,
-        "Path to save the model runtime info in binary proto format."));
+        "Path to save the model runtime info in binary proto format. With "
+        "use_profiler, it includes the measured time of each node and its "
+        "achieved GFLOP/s and GB/s."));
     flags.push_back(tflite::benchmark::CreateFlag<std::string>(
         "mediatek_nerun_pilot_version", &params_,
         "Which version of the MediaTek NPU SDK to use."));
+    flags.push_back(tflite::benchmark::CreateFlag<float>(
+        "sustained_duration_secs", &params_,
+        "If > 0, replaces the regular runs with a sustained load of that many "
+        "seconds, reporting the latencies, CPU frequencies and temperatures "
+        "per window."));
+    flags.push_back(tflite::benchmark::CreateFlag<float>(
+        "sustained_target_qps", &params_,
+        "Request rate of the sustained load. 0 runs back to back."));
+    flags.push_back(tflite::benchmark::CreateFlag<bool>(
+        "sustained_poisson_arrivals", &params_,
+        "Whether the sustained load requests arrive as a Poisson process "
+        "instead of at a fixed interval."));
+    flags.push_back(tflite::benchmark::CreateFlag<float>(
+        "sustained_window_secs", &params_,
+        "Length of the sustained load reporting windows."));
+    flags.push_back(tflite::benchmark::CreateFlag<std::string>(
+        "sustained_result_csv", &params_,
+        "Path to save the sustained load windows in CSV format."));
+    flags.push_back(tflite::benchmark::CreateFlag<int32_t>(
+        "num_clients", &params_,
+        "If > 1, replaces the regular runs with that many threads running "
+        "concurrently, each with its own compiled model and buffers. The "
+        "client count is swept from 1 up to num_clients."));
+    flags.push_back(tflite::benchmark::CreateFlag<bool>(
+        "share_compiled_model", &params_,
+        "Whether the concurrent clients share the model of the first one "
+        "(CompiledModel::CreateShared) instead of compiling their own."));
+    flags.push_back(tflite::benchmark::CreateFlag<bool>(
+        "report_partition_breakdown", &params_,
+        "Whether to report the time of each delegated partition and CPU "
+        "island, and the cost of the transfers between them. Implies "
+        "use_profiler."));
+    flags.push_back(tflite::benchmark::CreateFlag<bool>(
+        "track_run_allocations", &params_,
+        "Whether to report the heap allocations made by the regular runs, "
+        "i.e. in steady state, with their call sites."));
+    flags.push_back(tflite::benchmark::CreateFlag<int32_t>(
+        "max_allocations_per_run", &params_,
+        "If >= 0, the benchmark fails when a regular run makes more heap "
+        "allocations. 0 asserts that steady state runs don't allocate. "
+        "Implies track_run_allocations."));
     return flags;
   }
 
  protected:
   virtual TfLiteStatus LoadModel();
+  // Runs the sustained load instead of the regular runs when
+  // sustained_duration_secs is set. The returned stats are the service times.
+  tensorflow::StatWithPercentiles<int64_t> Run(
+      int min_num_times, float min_secs, float max_secs,
+      ::tflite::benchmark::RunType run_type,
+      TfLiteStatus* invoke_status) override;
+  using BenchmarkModel::Run;
+  TfLiteStatus ValidateParams() override;
   std::unique_ptr<Model> model_;
 
  private:
+  // A concurrent client beyond the first, which uses compiled_model_.
+  struct Client {
+    std::unique_ptr<litert::CompiledModel> compiled_model;
+    std::vector<litert::TensorBuffer> input_buffers;
+    std::vector<litert::TensorBuffer> output_buffers;
+  };
+
+  // Logs the allocations tracked during the regular runs. Fails if a run made
+  // more than max_allocations_per_run.
+  TfLiteStatus ReportRunAllocations();
+
+  TfLiteStatus CreateClients(int num_clients);
+  // Runs the concurrent clients instead of the regular runs when num_clients
+  // is set. The returned stats are the latencies with num_clients clients.
+  tensorflow::StatWithPercentiles<int64_t> RunClients(
+      int runs_per_client, float max_secs, TfLiteStatus* invoke_status);
+
   std::unique_ptr<litert::Environment> environment_;
   std::unique_ptr<litert::CompiledModel> compiled_model_;
   std::unique_ptr<std::vector<litert::TensorBuffer>> input_buffers_;
@@ -442,6 +588,10 @@ class BenchmarkLiteRtModel : public BenchmarkModel {
   // TFLite Interpreter is needed for run_summarizer_
   ::tflite::Interpreter* interpreter_ = nullptr;
   std::unique_ptr<tflite::profiling::ProfileSummarizer> run_summarizer_;
+  std::unique_ptr<PartitionBreakdown> partition_breakdown_;
+  std::vector<Client> clients_;
+  // Set during the regular runs when track_run_allocations is.
+  bool track_run_allocations_ = false;
 };
 
 }  // namespace benchmark
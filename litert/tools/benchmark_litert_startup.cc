@@ -0,0 +1,304 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Starts a model once per variant, from the creation of the environment to
+// its first run, and reports the time of each phase of the startup next to the
+// latency of the runs that follow.
+//
+// The variants run in the same process, so the libraries loaded by the first
+// one stay loaded for the next ones. Run each variant in its own process,
+// with --variants, to include the loading of the libraries every time.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"  // from @com_google_absl
+#include "absl/flags/parse.h"  // from @com_google_absl
+#include "absl/log/absl_log.h"  // from @com_google_absl
+#include "absl/strings/str_cat.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/time/time.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+#include "litert/cc/litert_common.h"
+#include "litert/cc/litert_compiled_model.h"
+#include "litert/cc/litert_environment.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/cc/litert_model.h"
+#include "litert/cc/litert_options.h"
+#include "litert/cc/litert_tensor_buffer.h"
+#include "litert/cc/options/litert_cpu_options.h"
+#include "litert/core/environment.h"
+#include "litert/core/filesystem.h"
+#include "litert/runtime/compiled_model.h"
+#include "litert/tools/accelerator_parity.h"
+#include "litert/tools/startup_phases.h"
+#include "tflite/profiling/time.h"
+
+ABSL_FLAG(std::string, graph, "", "Model file to start.");
+ABSL_FLAG(std::string, accelerator, "cpu",
+          "Accelerator to run the model on: cpu, gpu or npu. The ops the GPU "
+          "or the NPU do not support fall back to the CPU.");
+ABSL_FLAG(std::vector<std::string>, variants,
+          std::vector<std::string>({"cold", "warm", "dropped_page_cache"}),
+          "Startups to run, in order. cold empties the compiler cache and "
+          "the weight cache first, warm reuses them, and dropped_page_cache "
+          "reuses them after evicting them and the model from the page "
+          "cache. The caches are filled by an unreported startup before a "
+          "first variant that reuses them.");
+ABSL_FLAG(int, num_runs, 20,
+          "Runs after the first one of each startup, to report the steady "
+          "state.");
+ABSL_FLAG(int, num_threads, 0,
+          "Number of CPU threads, 0 for the default of the CPU accelerator.");
+ABSL_FLAG(std::string, compiler_cache_dir, "",
+          "Directory of the compiler cache, which also holds the compiled "
+          "programs of the GPU. No compilation is cached when empty.");
+ABSL_FLAG(std::string, xnnpack_weight_cache_path, "",
+          "File of the XNNPACK weight cache. The weights are packed by every "
+          "startup when empty.");
+ABSL_FLAG(std::string, dispatch_library_dir, "",
+          "Path to the dispatch library.");
+ABSL_FLAG(std::string, compiler_plugin_library_dir, "",
+          "Path to the compiler plugin library, to compile --graph for the "
+          "NPU on device.");
+ABSL_FLAG(std::string, report_csv, "",
+          "Path of the CSV report, with one row per phase of each startup.");
+
+namespace litert {
+namespace {
+
+using ::litert::tools::EvictFromPageCache;
+using ::litert::tools::LogStartupReport;
+using ::litert::tools::ParseStartupVariant;
+using ::litert::tools::PhaseTimer;
+using ::litert::tools::StartupResult;
+using ::litert::tools::StartupVariant;
+using ::litert::tools::SummarizeLatencies;
+using ::litert::tools::WriteStartupCsv;
+
+double Ms(absl::Duration duration) {
+  return absl::ToDoubleMilliseconds(duration);
+}
+
+Expected<Environment> CreateEnvironment() {
+  std::vector<Environment::Option> environment_options;
+  const auto dispatch_library_dir = absl::GetFlag(FLAGS_dispatch_library_dir);
+  if (!dispatch_library_dir.empty()) {
+    environment_options.push_back(
+        Environment::Option{Environment::OptionTag::DispatchLibraryDir,
+                            absl::string_view(dispatch_library_dir)});
+  }
+  const auto compiler_plugin_library_dir =
+      absl::GetFlag(FLAGS_compiler_plugin_library_dir);
+  if (!compiler_plugin_library_dir.empty()) {
+    environment_options.push_back(
+        Environment::Option{Environment::OptionTag::CompilerPluginLibraryDir,
+                            absl::string_view(compiler_plugin_library_dir)});
+  }
+  const auto compiler_cache_dir = absl::GetFlag(FLAGS_compiler_cache_dir);
+  if (!compiler_cache_dir.empty()) {
+    environment_options.push_back(
+        Environment::Option{Environment::OptionTag::CompilerCacheDir,
+                            absl::string_view(compiler_cache_dir)});
+  }
+  return Environment::Create(absl::MakeConstSpan(environment_options));
+}
+
+Expected<Options> CreateOptions() {
+  LITERT_ASSIGN_OR_RETURN(auto options, Options::Create());
+  const std::string accelerator = absl::GetFlag(FLAGS_accelerator);
+  if (accelerator == "cpu") {
+    options.SetHardwareAccelerators(HwAccelerators::kCpu);
+  } else if (accelerator == "gpu") {
+    options.SetHardwareAccelerators(HwAccelerators::kGpu |
+                                    HwAccelerators::kCpu);
+  } else if (accelerator == "npu") {
+    options.SetHardwareAccelerators(HwAccelerators::kNpu |
+                                    HwAccelerators::kCpu);
+  } else {
+    return Error(kLiteRtStatusErrorInvalidArgument,
+                 absl::StrCat("Unknown accelerator: ", accelerator));
+  }
+
+  const int num_threads = absl::GetFlag(FLAGS_num_threads);
+  const std::string weight_cache_path =
+      absl::GetFlag(FLAGS_xnnpack_weight_cache_path);
+  if (num_threads > 0 || !weight_cache_path.empty()) {
+    LITERT_ASSIGN_OR_RETURN(auto cpu_options, CpuOptions::Create());
+    if (num_threads > 0) {
+      LITERT_RETURN_IF_ERROR(cpu_options.SetNumThreads(num_threads));
+    }
+    if (!weight_cache_path.empty()) {
+      LITERT_RETURN_IF_ERROR(
+          cpu_options.SetXNNPackWeightCachePath(weight_cache_path.c_str()));
+    }
+    options.AddOpaqueOptions(std::move(cpu_options));
+  }
+  return options;
+}
+
+// Empties the caches for a cold startup, or evicts them and the model from
+// the page cache.
+Expected<void> PrepareVariant(StartupVariant variant) {
+  const std::string compiler_cache_dir =
+      absl::GetFlag(FLAGS_compiler_cache_dir);
+  const std::string weight_cache_path =
+      absl::GetFlag(FLAGS_xnnpack_weight_cache_path);
+  switch (variant) {
+    case StartupVariant::kCold:
+      if (!compiler_cache_dir.empty()) {
+        LITERT_RETURN_IF_ERROR(internal::RmDir(compiler_cache_dir));
+        LITERT_RETURN_IF_ERROR(internal::MkDir(compiler_cache_dir));
+      }
+      if (!weight_cache_path.empty()) {
+        LITERT_RETURN_IF_ERROR(internal::Remove(weight_cache_path));
+      }
+      return {};
+    case StartupVariant::kWarm:
+      return {};
+    case StartupVariant::kDroppedPageCache:
+      LITERT_RETURN_IF_ERROR(EvictFromPageCache(absl::GetFlag(FLAGS_graph)));
+      for (const std::string& cache : {compiler_cache_dir, weight_cache_path}) {
+        if (!cache.empty() && internal::Exists(cache)) {
+          LITERT_RETURN_IF_ERROR(EvictFromPageCache(cache));
+        }
+      }
+      return {};
+  }
+  return {};
+}
+
+// Starts the model and runs it, filling the phases and the steady state of
+// `result`.
+Expected<void> RunStartup(StartupResult& result) {
+  LITERT_ASSIGN_OR_RETURN(auto options, CreateOptions());
+
+  PhaseTimer timer(result.phases);
+  LITERT_ASSIGN_OR_RETURN(auto env, CreateEnvironment());
+  timer.EndPhase("environment")
+      .parts.push_back({"accelerator_registration",
+                        Ms(env.Get()->GetAcceleratorRegistrationTime())});
+
+  LITERT_ASSIGN_OR_RETURN(auto model,
+                          Model::CreateFromFile(absl::GetFlag(FLAGS_graph)));
+  timer.EndPhase("model_load");
+
+  LITERT_ASSIGN_OR_RETURN(auto compiled_model,
+                          CompiledModel::Create(env, model, options));
+  const LiteRtCompiledModelT::StartupTimings& timings =
+      compiled_model.Get()->GetStartupTimings();
+  result.compiler_cache_hit = timings.compiler_cache_hit;
+  timer.EndPhase("compiled_model").parts = {
+      {"compilation", Ms(timings.compilation)},
+      {"runtime_initialization", Ms(timings.runtime_initialization)},
+      {"accelerator_loading", Ms(timings.accelerator_loading)},
+      {"delegation", Ms(timings.delegation)},
+  };
+
+  LITERT_ASSIGN_OR_RETURN(auto input_buffers,
+                          compiled_model.CreateInputBuffers());
+  LITERT_ASSIGN_OR_RETURN(auto output_buffers,
+                          compiled_model.CreateOutputBuffers());
+  // Zeros are valid inputs of most models, e.g. token ids.
+  for (TensorBuffer& buffer : input_buffers) {
+    LITERT_ASSIGN_OR_RETURN(size_t size, buffer.Size());
+    LITERT_RETURN_IF_ERROR(
+        buffer.Write<char>(absl::MakeConstSpan(std::vector<char>(size, 0))));
+  }
+  timer.EndPhase("buffers");
+
+  LITERT_RETURN_IF_ERROR(compiled_model.Run(input_buffers, output_buffers));
+  timer.EndPhase("first_run");
+
+  const int num_runs = absl::GetFlag(FLAGS_num_runs);
+  std::vector<double> run_ms;
+  run_ms.reserve(num_runs);
+  for (int run = 0; run < num_runs; ++run) {
+    const uint64_t start_us = tflite::profiling::time::NowMicros();
+    LITERT_RETURN_IF_ERROR(compiled_model.Run(input_buffers, output_buffers));
+    run_ms.push_back((tflite::profiling::time::NowMicros() - start_us) * 1e-3);
+  }
+  result.steady_state = SummarizeLatencies(std::move(run_ms));
+  return {};
+}
+
+Expected<std::vector<StartupResult>> RunStartups() {
+  if (absl::GetFlag(FLAGS_graph).empty()) {
+    return Error(kLiteRtStatusErrorInvalidArgument,
+                 "No model provided. Use --graph to provide it.");
+  }
+  std::vector<StartupVariant> variants;
+  for (const std::string& name : absl::GetFlag(FLAGS_variants)) {
+    LITERT_ASSIGN_OR_RETURN(auto variant, ParseStartupVariant(name));
+    variants.push_back(variant);
+  }
+
+  std::vector<StartupResult> results;
+  bool caches_filled = false;
+  for (StartupVariant variant : variants) {
+    if (variant != StartupVariant::kCold && !caches_filled) {
+      StartupResult unreported;
+      LITERT_RETURN_IF_ERROR(RunStartup(unreported));
+      caches_filled = true;
+    }
+    StartupResult& result = results.emplace_back();
+    result.variant = variant;
+    if (auto ran = PrepareVariant(variant); !ran) {
+      result.error = ran.Error().Message();
+      continue;
+    }
+    if (auto ran = RunStartup(result); !ran) {
+      result.error = ran.Error().Message();
+      continue;
+    }
+    caches_filled = true;
+  }
+  return results;
+}
+
+}  // namespace
+}  // namespace litert
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+
+  auto results = litert::RunStartups();
+  if (!results) {
+    ABSL_LOG(ERROR) << results.Error().Message();
+    return EXIT_FAILURE;
+  }
+  litert::tools::LogStartupReport(*results);
+
+  const std::string report_csv = absl::GetFlag(FLAGS_report_csv);
+  if (!report_csv.empty()) {
+    if (auto written = litert::tools::WriteStartupCsv(*results, report_csv);
+        !written) {
+      ABSL_LOG(ERROR) << written.Error().Message();
+      return EXIT_FAILURE;
+    }
+  }
+
+  for (const auto& result : *results) {
+    if (!result.Ran()) {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
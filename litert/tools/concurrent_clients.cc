@@ -0,0 +1,167 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "litert/tools/concurrent_clients.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "litert/c/internal/litert_logging.h"
+
+namespace litert::benchmark {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double Percentile(const std::vector<int64_t>& sorted_us, double fraction) {
+  const size_t rank =
+      static_cast<size_t>(std::ceil(fraction * sorted_us.size()));
+  return sorted_us[std::max<size_t>(rank, 1) - 1] / 1e3;
+}
+
+}  // namespace
+
+ConcurrencyLevelResult RunConcurrentClients(
+    int num_clients, int runs_per_client, double max_secs,
+    const std::function<bool(int client)>& run_once) {
+  ConcurrencyLevelResult result;
+  result.num_clients = num_clients;
+  result.latencies_us.resize(num_clients);
+  std::vector<int> failures(num_clients, 0);
+
+  // The clients wait for each other, so that thread creation does not count
+  // as concurrency.
+  std::atomic<int> num_ready = 0;
+  std::atomic<bool> start = false;
+  Clock::time_point start_time;
+  std::vector<std::thread> threads;
+  threads.reserve(num_clients);
+  for (int client = 0; client < num_clients; ++client) {
+    threads.emplace_back([&, client]() {
+      ++num_ready;
+      while (!start.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      const Clock::time_point deadline =
+          start_time + std::chrono::duration_cast<Clock::duration>(
+                           std::chrono::duration<double>(max_secs));
+      auto& latencies_us = result.latencies_us[client];
+      latencies_us.reserve(runs_per_client);
+      for (int run = 0; run < runs_per_client; ++run) {
+        const Clock::time_point run_start = Clock::now();
+        if (max_secs > 0 && run_start > deadline) {
+          break;
+        }
+        if (!run_once(client)) {
+          ++failures[client];
+        }
+        latencies_us.push_back(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                Clock::now() - run_start)
+                .count());
+      }
+    });
+  }
+  while (num_ready.load() < num_clients) {
+    std::this_thread::yield();
+  }
+  start_time = Clock::now();
+  start.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  result.wall_secs =
+      std::chrono::duration<double>(Clock::now() - start_time).count();
+  result.num_failures = std::accumulate(failures.begin(), failures.end(), 0);
+  return result;
+}
+
+ConcurrencyLevelSummary SummarizeConcurrencyLevel(
+    const ConcurrencyLevelResult& result, int client) {
+  ConcurrencyLevelSummary summary;
+  summary.num_clients = result.num_clients;
+  std::vector<int64_t> latencies_us;
+  for (int i = 0; i < static_cast<int>(result.latencies_us.size()); ++i) {
+    if (client < 0 || client == i) {
+      latencies_us.insert(latencies_us.end(), result.latencies_us[i].begin(),
+                          result.latencies_us[i].end());
+    }
+  }
+  summary.num_runs = static_cast<int>(latencies_us.size());
+  if (latencies_us.empty()) {
+    return summary;
+  }
+  std::sort(latencies_us.begin(), latencies_us.end());
+  const double total_ms =
+      std::accumulate(latencies_us.begin(), latencies_us.end(), 0.0) / 1e3;
+  summary.avg_ms = total_ms / latencies_us.size();
+  summary.p50_ms = Percentile(latencies_us, 0.50);
+  summary.p99_ms = Percentile(latencies_us, 0.99);
+  if (result.wall_secs > 0) {
+    summary.throughput = latencies_us.size() / result.wall_secs;
+    summary.occupancy = total_ms / 1e3 / result.wall_secs;
+  }
+  return summary;
+}
+
+std::vector<int> ConcurrencySweep(int max_clients) {
+  std::vector<int> counts;
+  for (int count = 1; count < max_clients; count *= 2) {
+    counts.push_back(count);
+  }
+  counts.push_back(std::max(max_clients, 1));
+  return counts;
+}
+
+void LogConcurrencyReport(const std::vector<ConcurrencyLevelResult>& levels) {
+  if (levels.empty()) {
+    return;
+  }
+  LITERT_LOG(LITERT_INFO, "\n========== CONCURRENT CLIENTS ==========");
+  LITERT_LOG(LITERT_INFO,
+             "Clients   Runs  Runs/s  Speedup  Avg (ms)  P50 (ms)  P99 (ms)  "
+             "P50 x  Occupancy  Failures");
+  const ConcurrencyLevelSummary base = SummarizeConcurrencyLevel(levels[0]);
+  for (const ConcurrencyLevelResult& level : levels) {
+    const ConcurrencyLevelSummary summary = SummarizeConcurrencyLevel(level);
+    LITERT_LOG(LITERT_INFO,
+               "%7d %6d %7.2f %7.2fx %9.2f %9.2f %9.2f %5.2fx %10.2f %9d",
+               summary.num_clients, summary.num_runs, summary.throughput,
+               base.throughput > 0 ? summary.throughput / base.throughput : 0.0,
+               summary.avg_ms, summary.p50_ms, summary.p99_ms,
+               base.p50_ms > 0 ? summary.p50_ms / base.p50_ms : 0.0,
+               summary.occupancy, level.num_failures);
+  }
+
+  const ConcurrencyLevelResult& last = levels.back();
+  LITERT_LOG(LITERT_INFO, "\nPer client (%d clients):", last.num_clients);
+  LITERT_LOG(LITERT_INFO, "Client   Runs  Avg (ms)  P50 (ms)  P99 (ms)");
+  for (int client = 0; client < last.num_clients; ++client) {
+    const ConcurrencyLevelSummary summary =
+        SummarizeConcurrencyLevel(last, client);
+    LITERT_LOG(LITERT_INFO, "%6d %6d %9.2f %9.2f %9.2f", client,
+               summary.num_runs, summary.avg_ms, summary.p50_ms,
+               summary.p99_ms);
+  }
+  LITERT_LOG(LITERT_INFO, "========================================\n");
+}
+
+}  // namespace litert::benchmark
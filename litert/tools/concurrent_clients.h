@@ -0,0 +1,73 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef ODML_LITERT_LITERT_TOOLS_CONCURRENT_CLIENTS_H_
+#define ODML_LITERT_LITERT_TOOLS_CONCURRENT_CLIENTS_H_
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Concurrent-client benchmarking: several threads drive their own compiled
+// model at once, to measure how far one device scales before the requests
+// queue up in the accelerator and dispatch layers.
+
+namespace litert::benchmark {
+
+// Latencies of one run of `num_clients` concurrent clients.
+struct ConcurrencyLevelResult {
+  int num_clients = 0;
+  // From the start of the clients to the end of the last one.
+  double wall_secs = 0.0;
+  int num_failures = 0;
+  // Latency of each run, per client.
+  std::vector<std::vector<int64_t>> latencies_us;
+};
+
+struct ConcurrencyLevelSummary {
+  int num_clients = 0;
+  int num_runs = 0;
+  // Runs per second over all the clients.
+  double throughput = 0.0;
+  double avg_ms = 0.0;
+  double p50_ms = 0.0;
+  double p99_ms = 0.0;
+  // Average number of runs in flight: the sum of the latencies over the wall
+  // time. When it keeps up with num_clients but the throughput does not, the
+  // runs are queued inside the runtime.
+  double occupancy = 0.0;
+};
+
+// Starts `num_clients` threads at once, each calling `run_once(client)`
+// `runs_per_client` times, or until `max_secs` when positive. `run_once`
+// returns false when the run failed.
+ConcurrencyLevelResult RunConcurrentClients(
+    int num_clients, int runs_per_client, double max_secs,
+    const std::function<bool(int client)>& run_once);
+
+// Summarizes the runs of all the clients of `result`, or of `client` only.
+ConcurrencyLevelSummary SummarizeConcurrencyLevel(
+    const ConcurrencyLevelResult& result, int client = -1);
+
+// Client counts of a scaling sweep: 1, 2, 4, ... up to and including
+// `max_clients`.
+std::vector<int> ConcurrencySweep(int max_clients);
+
+// Logs the throughput and latency of each level, scaled to those of the first
+// one, then the latency of each client of the last level.
+void LogConcurrencyReport(const std::vector<ConcurrencyLevelResult>& levels);
+
+}  // namespace litert::benchmark
+
+#endif  // ODML_LITERT_LITERT_TOOLS_CONCURRENT_CLIENTS_H_
@@ -0,0 +1,110 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "litert/tools/concurrent_clients.h"
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace litert::benchmark {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::SizeIs;
+
+TEST(ConcurrentClientsTest, EachClientRunsItsOwnRequests) {
+  std::atomic<int> max_in_flight = 0;
+  std::atomic<int> in_flight = 0;
+  auto result = RunConcurrentClients(
+      /*num_clients=*/4, /*runs_per_client=*/5, /*max_secs=*/0,
+      [&](int client) {
+        const int now = ++in_flight;
+        int max = max_in_flight.load();
+        while (now > max && !max_in_flight.compare_exchange_weak(max, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        --in_flight;
+        return true;
+      });
+
+  EXPECT_EQ(result.num_clients, 4);
+  EXPECT_THAT(result.latencies_us, ElementsAre(SizeIs(5), SizeIs(5), SizeIs(5),
+                                               SizeIs(5)));
+  EXPECT_EQ(result.num_failures, 0);
+  EXPECT_GT(max_in_flight.load(), 1);
+}
+
+TEST(ConcurrentClientsTest, SerializedDeviceDoesNotScale) {
+  // A device that runs one request at a time.
+  std::mutex device;
+  auto run_once = [&](int client) {
+    std::lock_guard<std::mutex> lock(device);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    return true;
+  };
+  auto one = SummarizeConcurrencyLevel(RunConcurrentClients(1, 20, 0, run_once));
+  auto four =
+      SummarizeConcurrencyLevel(RunConcurrentClients(4, 20, 0, run_once));
+
+  EXPECT_EQ(four.num_runs, 80);
+  // The throughput stays flat while the requests queue up.
+  EXPECT_LT(four.throughput, one.throughput * 1.5);
+  EXPECT_GT(four.p50_ms, one.p50_ms * 2);
+  EXPECT_GT(four.occupancy, 3.0);
+}
+
+TEST(ConcurrentClientsTest, StopsAtMaxSecs) {
+  auto result = RunConcurrentClients(2, 1000000, 0.05, [](int client) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return client != 1;
+  });
+
+  EXPECT_LT(result.wall_secs, 1.0);
+  EXPECT_EQ(result.num_failures,
+            static_cast<int>(result.latencies_us[1].size()));
+}
+
+TEST(ConcurrentClientsTest, SummarizesOneClient) {
+  ConcurrencyLevelResult result;
+  result.num_clients = 2;
+  result.wall_secs = 1.0;
+  result.latencies_us = {{1000, 2000, 3000}, {10000}};
+
+  auto client = SummarizeConcurrencyLevel(result, /*client=*/0);
+  EXPECT_EQ(client.num_runs, 3);
+  EXPECT_DOUBLE_EQ(client.avg_ms, 2.0);
+  EXPECT_DOUBLE_EQ(client.p50_ms, 2.0);
+  EXPECT_DOUBLE_EQ(client.p99_ms, 3.0);
+
+  auto all = SummarizeConcurrencyLevel(result);
+  EXPECT_EQ(all.num_runs, 4);
+  EXPECT_DOUBLE_EQ(all.throughput, 4.0);
+  EXPECT_DOUBLE_EQ(all.occupancy, 0.016);
+}
+
+TEST(ConcurrentClientsTest, ConcurrencySweep) {
+  EXPECT_THAT(ConcurrencySweep(1), ElementsAre(1));
+  EXPECT_THAT(ConcurrencySweep(4), ElementsAre(1, 2, 4));
+  EXPECT_THAT(ConcurrencySweep(6), ElementsAre(1, 2, 4, 6));
+  EXPECT_THAT(ConcurrencySweep(8), ElementsAre(1, 2, 4, 8));
+}
+
+}  // namespace
+}  // namespace litert::benchmark
@@ -33,6 +33,7 @@
 #include "litert/cc/litert_macros.h"
 #include "litert/tools/culprit_finder/culprit_finder_utils.h"
 #include "litert/tools/culprit_finder/interpreter_handler.h"
+#include "litert/tools/culprit_finder/latency_stats.h"
 #include "litert/tools/culprit_finder/model_metadata_lib.h"
 #include "litert/tools/culprit_finder/tflite_input_manager.h"
 #include "tflite/c/c_api_types.h"
@@ -65,6 +66,13 @@ constexpr char kFindNanFlag[] = "find_nan";
 // Find numeric error specific flags.
 constexpr char kFindNumericErrorFlag[] = "find_numeric_error";
 constexpr char kMinNumericErrorFlag[] = "min_numeric_error";
+// Find latency specific flags.
+constexpr char kFindLatencyFlag[] = "find_latency";
+constexpr char kLatencyNumRunsFlag[] = "latency_num_runs";
+constexpr char kLatencyNumWarmupRunsFlag[] = "latency_num_warmup_runs";
+constexpr char kMinLatencyRegressionFlag[] = "min_latency_regression_ms";
+constexpr char kLatencyBaselineFileFlag[] = "latency_baseline_file";
+constexpr char kLatencyReportFileFlag[] = "latency_report_file";
 
 using ::tflite::Flag;
 using ::tflite::Flags;
@@ -117,6 +125,13 @@ void CulpritFinder::SetDefaultParams() {
   params_.AddParam(kFindNanFlag, ToolParam::Create<bool>(true));
   params_.AddParam(kFindNumericErrorFlag, ToolParam::Create<bool>(true));
   params_.AddParam(kMinNumericErrorFlag, ToolParam::Create<float>(0.0001));
+  params_.AddParam(kFindLatencyFlag, ToolParam::Create<bool>(false));
+  params_.AddParam(kLatencyNumRunsFlag, ToolParam::Create<int>(10));
+  params_.AddParam(kLatencyNumWarmupRunsFlag, ToolParam::Create<int>(2));
+  params_.AddParam(kMinLatencyRegressionFlag, ToolParam::Create<float>(0.0));
+  params_.AddParam(kLatencyBaselineFileFlag,
+                   ToolParam::Create<std::string>(""));
+  params_.AddParam(kLatencyReportFileFlag, ToolParam::Create<std::string>(""));
   delegate_list_util_.AddAllDelegateParams();
 }
 
@@ -137,6 +152,16 @@ void CulpritFinder::LogParams() {
                  true);
   LOG_TOOL_PARAM(params_, float, kMinNumericErrorFlag, "Min numeric error",
                  true);
+  LOG_TOOL_PARAM(params_, bool, kFindLatencyFlag, "Find latency", true);
+  LOG_TOOL_PARAM(params_, int, kLatencyNumRunsFlag, "Latency num runs", true);
+  LOG_TOOL_PARAM(params_, int, kLatencyNumWarmupRunsFlag,
+                 "Latency num warmup runs", true);
+  LOG_TOOL_PARAM(params_, float, kMinLatencyRegressionFlag,
+                 "Min latency regression (ms)", true);
+  LOG_TOOL_PARAM(params_, std::string, kLatencyBaselineFileFlag,
+                 "Latency baseline file", true);
+  LOG_TOOL_PARAM(params_, std::string, kLatencyReportFileFlag,
+                 "Latency report file", true);
   for (const std::unique_ptr<tflite::tools::DelegateProvider>&
            delegate_provider :
        tflite::tools::GetRegisteredDelegateProviders()) {
@@ -168,6 +193,25 @@ std::vector<tflite::Flag> CulpritFinder::GetFlags() {
       CreateFlag<float>(kMinNumericErrorFlag, &params_,
                         "Minimum absolute difference to consider an "
                         "inference as an error."),
+      CreateFlag<bool>(kFindLatencyFlag, &params_,
+                       "If specified, searches for the node ranges whose "
+                       "delegation regresses the latency instead of the "
+                       "numeric culprits."),
+      CreateFlag<int>(kLatencyNumRunsFlag, &params_,
+                      "Number of timed inferences per node range."),
+      CreateFlag<int>(kLatencyNumWarmupRunsFlag, &params_,
+                      "Number of untimed inferences before the timed ones."),
+      CreateFlag<float>(kMinLatencyRegressionFlag, &params_,
+                        "Minimum latency increase over the baseline, in ms, "
+                        "to consider a node range as a latency culprit."),
+      CreateFlag<std::string>(
+          kLatencyBaselineFileFlag, &params_,
+          "If provided, the node range latencies written by a previous run "
+          "with --latency_report_file, to compare against instead of the "
+          "reference interpreter."),
+      CreateFlag<std::string>(kLatencyReportFileFlag, &params_,
+                              "If provided, the linear search writes the "
+                              "latency of each node range to this CSV file."),
   };
   delegate_list_util_.AppendCmdlineFlags(flag_list);
   return flag_list;
@@ -207,11 +251,15 @@ TfLiteStatus CulpritFinder::CalculateErrorStats(
     const int start_node, const int end_node,
     absl::Span<const int> intermediate_outputs, OverallStat& overall_stat) {
   bool is_crash = false;
+  const bool find_latency = params_.Get<bool>(kFindLatencyFlag);
   try {
+    // The intermediate outputs are copied out of the delegate, so they are
+    // left out when timing the node range.
     LITERT_ASSIGN_OR_RETURN(
         interpreter_with_delegate_,
         interpreter_handler_->PrepareInterpreter(
-            GetDelegate(start_node, end_node), intermediate_outputs),
+            GetDelegate(start_node, end_node),
+            find_latency ? absl::Span<const int>() : intermediate_outputs),
         AsTfLiteStatus(_ << "Failed to prepare interpreter."));
 
     TfLiteStatus status = interpreter_handler_->RunInference(
@@ -227,6 +275,26 @@ TfLiteStatus CulpritFinder::CalculateErrorStats(
 
   GetOverallStat(start_node, end_node, interpreter_.get(),
                  interpreter_with_delegate_.get(), is_crash, overall_stat);
+  if (find_latency && !is_crash) {
+    return CalculateLatencyStats(overall_stat);
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus CulpritFinder::CalculateLatencyStats(OverallStat& overall_stat) {
+  LITERT_ASSIGN_OR_RETURN(
+      const LatencyStat latency_stat,
+      interpreter_handler_->MeasureLatency(
+          *interpreter_with_delegate_, *input_manager_,
+          params_.Get<int>(kLatencyNumWarmupRunsFlag),
+          params_.Get<int>(kLatencyNumRunsFlag)),
+      AsTfLiteStatus(_ << "Failed to measure latency."));
+  overall_stat.latency_ms = latency_stat.median_ms;
+  const auto baseline =
+      baseline_latencies_ms_.find(overall_stat.delegated_node_range);
+  overall_stat.baseline_latency_ms = baseline != baseline_latencies_ms_.end()
+                                         ? baseline->second
+                                         : reference_latency_ms_;
   return kTfLiteOk;
 }
 
@@ -239,6 +307,10 @@ TfLiteStatus CulpritFinder::RunCulpritFinder() {
   std::string search_strategy;
   if (params_.HasValueSet<std::string>(kSearchStrategyFlag)) {
     search_strategy = params_.Get<std::string>(kSearchStrategyFlag);
+  } else if (params_.Get<bool>(kFindLatencyFlag)) {
+    // The latency does not grow with the delegated node range, so it cannot
+    // be bisected reliably.
+    search_strategy = kLinearSearchStrategyEnum;
   } else if (params_.Get<bool>(kFindNanFlag)) {
     search_strategy = kBinarySearchStrategyEnum;
   } else {
@@ -287,11 +359,42 @@ TfLiteStatus CulpritFinder::PrepareCulpritFinder() {
     return kTfLiteError;
   }
   LITERT_LOG(LITERT_INFO, "Reference inference run completed!");
+
+  if (params_.Get<bool>(kFindLatencyFlag)) {
+    LITERT_ASSIGN_OR_RETURN(
+        const LatencyStat reference_latency,
+        interpreter_handler_->MeasureLatency(
+            *interpreter_, *input_manager_,
+            params_.Get<int>(kLatencyNumWarmupRunsFlag),
+            params_.Get<int>(kLatencyNumRunsFlag)),
+        AsTfLiteStatus(_ << "Failed to measure reference latency."));
+    reference_latency_ms_ = reference_latency.median_ms;
+    LITERT_LOG(LITERT_INFO, "Reference latency: %f ms (min %f, max %f)",
+               reference_latency.median_ms, reference_latency.min_ms,
+               reference_latency.max_ms);
+
+    const std::string baseline_file =
+        params_.Get<std::string>(kLatencyBaselineFileFlag);
+    if (!baseline_file.empty()) {
+      LITERT_ASSIGN_OR_RETURN(
+          baseline_latencies_ms_, ReadNodeRangeLatencies(baseline_file),
+          AsTfLiteStatus(_ << "Failed to read latency baseline."));
+      LITERT_LOG(LITERT_INFO, "Read %zu baseline node range latencies",
+                 baseline_latencies_ms_.size());
+    }
+  }
   return kTfLiteOk;
 }
 
 bool CulpritFinder::CulpritSearchMatchCondition(
     const OverallStat& overall_stat) {
+  if (params_.Get<bool>(kFindLatencyFlag)) {
+    // Delegated node ranges rarely match the reference outputs within the
+    // default min_numeric_error, so the numeric conditions are ignored.
+    return !overall_stat.is_crash &&
+           overall_stat.latency_ms - overall_stat.baseline_latency_ms >=
+               params_.Get<float>(kMinLatencyRegressionFlag);
+  }
   if (params_.Get<bool>(kFindNanFlag) &&
       !overall_stat.nan_output_indices.empty()) {
     return true;
@@ -320,7 +423,8 @@ TfLiteStatus CulpritFinder::RunCulpritFinderBinarySearch() {
     LITERT_LOG(LITERT_ERROR, "Failed to calculate error stats");
     return kTfLiteError;
   } else if (!CulpritSearchMatchCondition(temp_overall_stat)) {
-    LITERT_LOG(LITERT_INFO, "No nan outputs/numeric errors found");
+    LITERT_LOG(LITERT_INFO,
+               "No nan outputs/numeric errors/latency regressions found");
     return kTfLiteOk;
   }
 
@@ -433,13 +537,36 @@ TfLiteStatus CulpritFinder::RunCulpritFinderLinearSearch() {
       LITERT_LOG(LITERT_ERROR, "Failed to calculate error stats");
       return kTfLiteError;
     }
+    const bool find_latency = params_.Get<bool>(kFindLatencyFlag);
     if (CulpritSearchMatchCondition(overall_stat)) {
-      overall_stats_.push_back({overall_stat.total_error, overall_stat});
+      overall_stats_.push_back(
+          {find_latency
+               ? overall_stat.latency_ms - overall_stat.baseline_latency_ms
+               : overall_stat.total_error,
+           overall_stat});
+    }
+    if (find_latency && !overall_stat.is_crash) {
+      node_range_latencies_.push_back(
+          {overall_stat.delegated_node_range, overall_stat.latency_ms});
     }
     LITERT_LOG(LITERT_INFO, "Done with Node range: [%d - %d]", node_start,
                node_end);
   }
-  MakeReport();
+  if (!params_.Get<bool>(kFindLatencyFlag)) {
+    MakeReport();
+    return kTfLiteOk;
+  }
+
+  MakeLatencyReport();
+  const std::string report_file =
+      params_.Get<std::string>(kLatencyReportFileFlag);
+  if (!report_file.empty()) {
+    LITERT_RETURN_IF_ERROR(
+        WriteNodeRangeLatencies(report_file, node_range_latencies_),
+        AsTfLiteStatus(_ << "Failed to write latency report."));
+    LITERT_LOG(LITERT_INFO, "Wrote %zu node range latencies to %s",
+               node_range_latencies_.size(), report_file.c_str());
+  }
   return kTfLiteOk;
 }
 
@@ -522,6 +649,10 @@ inline void CulpritFinder::LogOverallStat(const OverallStat& overall_stat) {
              overall_stat.max_error);
   LITERT_LOG(LITERT_INFO, "  Total average error: %f",
              overall_stat.total_error);
+  if (params_.Get<bool>(kFindLatencyFlag)) {
+    LITERT_LOG(LITERT_INFO, "  Latency: %f ms (baseline: %f ms)",
+               overall_stat.latency_ms, overall_stat.baseline_latency_ms);
+  }
   LITERT_LOG(LITERT_INFO, "  NAN output indices: ");
   for (int nan_output_index : overall_stat.nan_output_indices) {
     LITERT_LOG(LITERT_INFO, "%s, ",
@@ -642,4 +773,90 @@ void CulpritFinder::MakeReport() {
   }
 }
 
+void CulpritFinder::MakeLatencyReport() {
+  std::sort(
+      overall_stats_.begin(), overall_stats_.end(),
+      [](const std::pair<float, OverallStat>& a,
+         const std::pair<float, OverallStat>& b) { return a.first > b.first; });
+
+  // The number of node ranges with a regression and their total regression,
+  // per node type.
+  std::unordered_map<std::string, std::pair<int, float>>
+      node_type_to_regression;
+  for (const auto& [regression_ms, overall_stat] : overall_stats_) {
+    auto& [count, total_regression_ms] =
+        node_type_to_regression[model_metadata_->GetNodeIdentifier(
+            overall_stat.delegated_node_range.first, /*with_index=*/false)];
+    ++count;
+    total_regression_ms += regression_ms;
+  }
+  std::vector<std::pair<std::string, std::pair<int, float>>>
+      sorted_node_type_to_regression(node_type_to_regression.begin(),
+                                     node_type_to_regression.end());
+  std::sort(sorted_node_type_to_regression.begin(),
+            sorted_node_type_to_regression.end(),
+            [](const std::pair<std::string, std::pair<int, float>>& a,
+               const std::pair<std::string, std::pair<int, float>>& b) {
+              return a.second.second > b.second.second;
+            });
+
+  LITERT_LOG(LITERT_INFO, "CULPRIT FINDER LATENCY REPORT");
+  LITERT_LOG(LITERT_INFO,
+             "-------------------------------------------------------------");
+  LITERT_LOG(LITERT_INFO, "Reference latency: %f ms", reference_latency_ms_);
+  if (!baseline_latencies_ms_.empty()) {
+    LITERT_LOG(LITERT_INFO, "Baseline node ranges: %zu",
+               baseline_latencies_ms_.size());
+  }
+  LITERT_LOG(LITERT_INFO, "Total number of node ranges measured: %zu",
+             node_range_latencies_.size());
+  LITERT_LOG(LITERT_INFO,
+             "Total number of node ranges with latency regressions: %zu",
+             overall_stats_.size());
+
+  const int report_count = params_.Get<int>(kLinearSearchReportCountFlag);
+  if (report_count <= 0) {
+    LITERT_LOG(LITERT_INFO, "No linear search report count provided");
+    return;
+  }
+
+  LITERT_LOG(LITERT_INFO,
+             "Top %d node ranges sorted by latency regression (node_range, "
+             "op_name(s), input/output shapes, latency_ms, baseline_ms, "
+             "regression_ms):",
+             report_count);
+  for (int i = 0; i < overall_stats_.size() && i < report_count; ++i) {
+    const OverallStat& overall_stat = overall_stats_[i].second;
+    const int node_start_index = overall_stat.delegated_node_range.first;
+    const int node_end_index = overall_stat.delegated_node_range.second;
+    LITERT_LOG(
+        LITERT_INFO, "%d - %d, %s - %s, %s, %f, %f, %f", node_start_index,
+        node_end_index,
+        model_metadata_
+            ->GetNodeIdentifier(node_start_index, /*with_index=*/false)
+            .c_str(),
+        model_metadata_->GetNodeIdentifier(node_end_index, /*with_index=*/false)
+            .c_str(),
+        model_metadata_->GetNodeShapes(node_start_index).c_str(),
+        overall_stat.latency_ms, overall_stat.baseline_latency_ms,
+        overall_stats_[i].first);
+  }
+
+  LITERT_LOG(LITERT_INFO,
+             "-------------------------------------------------------------");
+  LITERT_LOG(LITERT_INFO,
+             "Top %d node(s) with most latency regression (op_name, count, "
+             "total_regression_ms):",
+             report_count);
+  for (int i = 0;
+       i < sorted_node_type_to_regression.size() && i < report_count; ++i) {
+    LITERT_LOG(LITERT_INFO, "%s, %d, %f",
+               sorted_node_type_to_regression[i].first.c_str(),
+               sorted_node_type_to_regression[i].second.first,
+               sorted_node_type_to_regression[i].second.second);
+  }
+  LITERT_LOG(LITERT_INFO,
+             "-------------------------------------------------------------");
+}
+
 }  // namespace litert::tools
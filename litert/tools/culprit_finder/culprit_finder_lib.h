@@ -21,9 +21,11 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/tools/culprit_finder/culprit_finder_utils.h"
 #include "litert/tools/culprit_finder/interpreter_handler.h"
+#include "litert/tools/culprit_finder/latency_stats.h"
 #include "litert/tools/culprit_finder/model_metadata_lib.h"
 #include "litert/tools/culprit_finder/tflite_input_manager.h"
 #include "tflite/c/c_api_types.h"
@@ -107,8 +109,15 @@ class CulpritFinder {
   // Get the model path from the params.
   std::string GetModelPath();
 
+  // Measure the latency of the interpreter with the delegated node range and
+  // store it with its baseline in the overall stat.
+  TfLiteStatus CalculateLatencyStats(OverallStat& overall_stat);
+
   // Make the report for the culprit finder.
   void MakeReport();
+  // Make the report for the latency search: the node ranges sorted by latency
+  // regression.
+  void MakeLatencyReport();
   // Run the node range analysis for the given node range.
   TfLiteStatus NodeRangeAnalysis(int start_node, int end_node);
   // Log the overall stat for the culprit finder.
@@ -134,6 +143,14 @@ class CulpritFinder {
 
   // A vector of <error_threshold, OverallStat> pairs.
   std::vector<std::pair<float, OverallStat>> overall_stats_;
+
+  // The median latency of the reference interpreter, when searching for
+  // latency culprits.
+  float reference_latency_ms_ = 0.0;
+  // The latencies of a previous run, keyed by delegated node range.
+  absl::flat_hash_map<std::pair<int, int>, float> baseline_latencies_ms_;
+  // The latency of every node range measured by the linear search.
+  std::vector<NodeRangeLatency> node_range_latencies_;
 };
 
 }  // namespace litert::tools
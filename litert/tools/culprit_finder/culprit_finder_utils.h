@@ -75,6 +75,12 @@ struct OverallStat {
   // The output indices that have NANs.
   std::vector<int> nan_output_indices;
   bool is_crash = false;
+
+  // The median latency with the node range delegated, when measured.
+  float latency_ms = 0.0;
+  // The latency to compare against: the reference interpreter, or the same
+  // node range in a baseline report.
+  float baseline_latency_ms = 0.0;
 };
 
 // Returns the error stats for a single OutputTensor.
@@ -14,6 +14,7 @@
 
 #include "litert/tools/culprit_finder/interpreter_handler.h"
 
+#include <chrono>  // NOLINT
 #include <memory>
 #include <utility>
 #include <vector>
@@ -23,6 +24,7 @@
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
 #include "litert/cc/litert_expected.h"
+#include "litert/tools/culprit_finder/latency_stats.h"
 #include "litert/tools/culprit_finder/tflite_input_manager.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/interpreter.h"
@@ -121,4 +123,33 @@ TfLiteStatus InterpreterHandler::RunInference(
   }
   return kTfLiteOk;
 }
+
+litert::Expected<LatencyStat> InterpreterHandler::MeasureLatency(
+    tflite::Interpreter& interpreter, TfliteInputManager& input_manager,
+    int num_warmup_runs, int num_runs) {
+  interpreter.ResetVariableTensors();
+  if (input_manager.SetInputTensors(interpreter) != kTfLiteOk) {
+    LITERT_LOG(LITERT_ERROR, "Failed to set input tensors");
+    return litert::Unexpected(LiteRtStatus::kLiteRtStatusErrorRuntimeFailure,
+                              "Failed to set input tensors");
+  }
+
+  std::vector<float> run_latencies_ms;
+  run_latencies_ms.reserve(num_runs);
+  for (int i = 0; i < num_warmup_runs + num_runs; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    if (interpreter.Invoke() != kTfLiteOk) {
+      LITERT_LOG(LITERT_ERROR, "Failed to invoke interpreter");
+      return litert::Unexpected(LiteRtStatus::kLiteRtStatusErrorRuntimeFailure,
+                                "Failed to invoke interpreter");
+    }
+    if (i >= num_warmup_runs) {
+      run_latencies_ms.push_back(
+          std::chrono::duration<float, std::milli>(
+              std::chrono::steady_clock::now() - start)
+              .count());
+    }
+  }
+  return GetLatencyStat(std::move(run_latencies_ms));
+}
 }  // namespace litert::tools
@@ -21,6 +21,7 @@
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/cc/litert_expected.h"
+#include "litert/tools/culprit_finder/latency_stats.h"
 #include "litert/tools/culprit_finder/tflite_input_manager.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/core/model_builder.h"
@@ -60,6 +61,12 @@ class InterpreterHandler {
   TfLiteStatus RunInference(tflite::Interpreter& interpreter,
                             TfliteInputManager& input_manager);
 
+  // Runs `num_warmup_runs` untimed inferences, then times `num_runs` of them.
+  // The inputs are set once, so only the invocations are timed.
+  litert::Expected<LatencyStat> MeasureLatency(
+      tflite::Interpreter& interpreter, TfliteInputManager& input_manager,
+      int num_warmup_runs, int num_runs);
+
  private:
   std::unique_ptr<tflite::FlatBufferModel> model_;
   std::unique_ptr<ModelLoader> model_loader_;
@@ -0,0 +1,111 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/tools/culprit_finder/latency_stats.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/strings/numbers.h"  // from @com_google_absl
+#include "absl/strings/str_cat.h"  // from @com_google_absl
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/str_split.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+#include "litert/cc/litert_expected.h"
+
+namespace litert::tools {
+
+namespace {
+constexpr char kNodeRangeLatenciesHeader[] = "start_node,end_node,latency_ms";
+}  // namespace
+
+LatencyStat GetLatencyStat(std::vector<float> run_latencies_ms) {
+  LatencyStat stat;
+  stat.num_runs = run_latencies_ms.size();
+  if (run_latencies_ms.empty()) {
+    return stat;
+  }
+  std::sort(run_latencies_ms.begin(), run_latencies_ms.end());
+  const size_t mid = run_latencies_ms.size() / 2;
+  stat.min_ms = run_latencies_ms.front();
+  stat.max_ms = run_latencies_ms.back();
+  stat.median_ms = run_latencies_ms.size() % 2 == 1
+                       ? run_latencies_ms[mid]
+                       : (run_latencies_ms[mid - 1] + run_latencies_ms[mid]) /
+                             2;
+  return stat;
+}
+
+litert::Expected<void> WriteNodeRangeLatencies(
+    absl::string_view path, absl::Span<const NodeRangeLatency> latencies) {
+  std::ofstream file{std::string(path)};
+  if (!file) {
+    return litert::Unexpected(LiteRtStatus::kLiteRtStatusErrorFileIO,
+                              absl::StrCat("Failed to open ", path));
+  }
+  file << kNodeRangeLatenciesHeader << "\n";
+  for (const NodeRangeLatency& latency : latencies) {
+    file << absl::StrFormat("%d,%d,%.4f\n", latency.delegated_node_range.first,
+                            latency.delegated_node_range.second,
+                            latency.latency_ms);
+  }
+  if (!file) {
+    return litert::Unexpected(LiteRtStatus::kLiteRtStatusErrorFileIO,
+                              absl::StrCat("Failed to write ", path));
+  }
+  return {};
+}
+
+litert::Expected<absl::flat_hash_map<std::pair<int, int>, float>>
+ReadNodeRangeLatencies(absl::string_view path) {
+  std::ifstream file{std::string(path)};
+  if (!file) {
+    return litert::Unexpected(LiteRtStatus::kLiteRtStatusErrorFileIO,
+                              absl::StrCat("Failed to open ", path));
+  }
+  std::string line;
+  if (!std::getline(file, line) || line != kNodeRangeLatenciesHeader) {
+    return litert::Unexpected(
+        LiteRtStatus::kLiteRtStatusErrorInvalidArgument,
+        absl::StrCat("Missing node range latencies header in ", path));
+  }
+  absl::flat_hash_map<std::pair<int, int>, float> latencies;
+  while (std::getline(file, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    const std::vector<absl::string_view> fields = absl::StrSplit(line, ',');
+    int start_node = 0;
+    int end_node = 0;
+    float latency_ms = 0.0;
+    if (fields.size() != 3 || !absl::SimpleAtoi(fields[0], &start_node) ||
+        !absl::SimpleAtoi(fields[1], &end_node) ||
+        !absl::SimpleAtof(fields[2], &latency_ms)) {
+      return litert::Unexpected(
+          LiteRtStatus::kLiteRtStatusErrorInvalidArgument,
+          absl::StrCat("Malformed node range latency \"", line, "\" in ",
+                       path));
+    }
+    latencies[{start_node, end_node}] = latency_ms;
+  }
+  return latencies;
+}
+
+}  // namespace litert::tools
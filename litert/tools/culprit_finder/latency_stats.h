@@ -0,0 +1,56 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_TOOLS_CULPRIT_FINDER_LATENCY_STATS_H_
+#define ODML_LITERT_TOOLS_CULPRIT_FINDER_LATENCY_STATS_H_
+
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/cc/litert_expected.h"
+
+namespace litert::tools {
+
+// Latency of repeated inferences of one interpreter.
+struct LatencyStat {
+  int num_runs = 0;
+  float min_ms = 0.0;
+  float median_ms = 0.0;
+  float max_ms = 0.0;
+};
+
+// Returns the stats of the given run latencies.
+LatencyStat GetLatencyStat(std::vector<float> run_latencies_ms);
+
+// Median latency of the model with a node range delegated.
+struct NodeRangeLatency {
+  std::pair<int, int> delegated_node_range;
+  float latency_ms = 0.0;
+};
+
+// Writes the latencies as a CSV file with a "start_node,end_node,latency_ms"
+// header, to be read back as the baseline of a later run.
+litert::Expected<void> WriteNodeRangeLatencies(
+    absl::string_view path, absl::Span<const NodeRangeLatency> latencies);
+
+// Reads the latencies written by WriteNodeRangeLatencies, keyed by node range.
+litert::Expected<absl::flat_hash_map<std::pair<int, int>, float>>
+ReadNodeRangeLatencies(absl::string_view path);
+
+}  // namespace litert::tools
+
+#endif  // ODML_LITERT_TOOLS_CULPRIT_FINDER_LATENCY_STATS_H_
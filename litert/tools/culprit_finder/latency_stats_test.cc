@@ -0,0 +1,70 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/tools/culprit_finder/latency_stats.h"
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace litert::tools {
+namespace {
+
+TEST(LatencyStatsTest, GetLatencyStatOddRuns) {
+  const LatencyStat stat = GetLatencyStat({3.0, 1.0, 2.0});
+  EXPECT_EQ(stat.num_runs, 3);
+  EXPECT_FLOAT_EQ(stat.min_ms, 1.0);
+  EXPECT_FLOAT_EQ(stat.median_ms, 2.0);
+  EXPECT_FLOAT_EQ(stat.max_ms, 3.0);
+}
+
+TEST(LatencyStatsTest, GetLatencyStatEvenRuns) {
+  const LatencyStat stat = GetLatencyStat({4.0, 1.0, 2.0, 8.0});
+  EXPECT_FLOAT_EQ(stat.median_ms, 3.0);
+}
+
+TEST(LatencyStatsTest, GetLatencyStatNoRuns) {
+  const LatencyStat stat = GetLatencyStat({});
+  EXPECT_EQ(stat.num_runs, 0);
+  EXPECT_FLOAT_EQ(stat.median_ms, 0.0);
+}
+
+TEST(LatencyStatsTest, NodeRangeLatenciesRoundTrip) {
+  const std::string path = ::testing::TempDir() + "/latencies.csv";
+  const std::vector<NodeRangeLatency> latencies = {{{0, 3}, 1.5},
+                                                   {{4, 4}, 0.25}};
+  ASSERT_TRUE(WriteNodeRangeLatencies(path, latencies));
+
+  auto read_latencies = ReadNodeRangeLatencies(path);
+  ASSERT_TRUE(read_latencies);
+  EXPECT_EQ(read_latencies->size(), 2);
+  EXPECT_FLOAT_EQ(read_latencies->at({0, 3}), 1.5);
+  EXPECT_FLOAT_EQ(read_latencies->at({4, 4}), 0.25);
+}
+
+TEST(LatencyStatsTest, ReadNodeRangeLatenciesRejectsMalformedFiles) {
+  const std::string path = ::testing::TempDir() + "/malformed.csv";
+  {
+    std::ofstream file(path);
+    file << "start_node,end_node,latency_ms\n0,x,1.0\n";
+  }
+  EXPECT_FALSE(ReadNodeRangeLatencies(path));
+  EXPECT_FALSE(ReadNodeRangeLatencies(::testing::TempDir() + "/missing.csv"));
+}
+
+}  // namespace
+}  // namespace litert::tools
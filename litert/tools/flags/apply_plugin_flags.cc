@@ -31,6 +31,11 @@ ABSL_FLAG(::litert::tools::IntList, subgraphs, ::litert::tools::IntList{},
           "If provides, only the subgraphs with the given indices "
           "are applied with the plugin.");
 
+ABSL_FLAG(size_t, num_compile_threads, 1,
+          "If greater than 1, each partition is compiled by a separate plugin "
+          "call, with up to this many concurrent calls. The plugin must "
+          "support concurrent compilation.");
+
 ABSL_FLAG(LiteRtCompilerOptionsPartitionStrategy, partition_strategy,
           kLiteRtCompilerOptionsPartitionStrategyDefault,
           "Partition strategy for the compiler.");
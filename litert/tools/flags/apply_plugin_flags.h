@@ -28,6 +28,8 @@ ABSL_DECLARE_FLAG(std::string, cmd);
 
 ABSL_DECLARE_FLAG(::litert::tools::IntList, subgraphs);
 
+ABSL_DECLARE_FLAG(size_t, num_compile_threads);
+
 // Compiler plugin partition strategy flag.
 ABSL_DECLARE_FLAG(LiteRtCompilerOptionsPartitionStrategy, partition_strategy);
 bool AbslParseFlag(absl::string_view text,
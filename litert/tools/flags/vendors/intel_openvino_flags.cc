@@ -24,6 +24,7 @@
 #include "absl/strings/str_split.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
+#include "litert/c/litert_common.h"
 #include "litert/c/options/litert_intel_openvino_options.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
@@ -47,6 +48,11 @@ ABSL_FLAG(std::string, intel_openvino_configs_map, "",
           "key=value pairs "
           "(e.g., 'INFERENCE_PRECISION_HINT=f16,CACHE_DIR=/tmp/cache').");
 
+ABSL_FLAG(int, intel_openvino_num_infer_requests, 0,
+          "Number of inference requests kept per compiled model, i.e. the "
+          "number of invocations that can run concurrently. 0 uses the number "
+          "reported as optimal by OpenVINO.");
+
 bool AbslParseFlag(absl::string_view text,
                    LiteRtIntelOpenVinoDeviceType* options, std::string* error) {
   if (text == "cpu") {
@@ -128,6 +134,14 @@ Expected<IntelOpenVinoOptions> IntelOpenVinoOptionsFromFlags() {
   options.SetPerformanceMode(
       absl::GetFlag(FLAGS_intel_openvino_performance_mode));
 
+  const int num_infer_requests =
+      absl::GetFlag(FLAGS_intel_openvino_num_infer_requests);
+  if (num_infer_requests < 0) {
+    return Error(kLiteRtStatusErrorInvalidArgument,
+                 "intel_openvino_num_infer_requests must not be negative");
+  }
+  options.SetNumInferRequests(num_infer_requests);
+
   // Parse configs map options from the flag (comma-separated key=value pairs)
   const std::string configs_map_str =
       absl::GetFlag(FLAGS_intel_openvino_configs_map);
@@ -50,6 +50,14 @@ std::string AbslUnparseFlag(LiteRtIntelOpenVinoPerformanceMode options);
 
 #endif
 
+// RUNTIME OPTIONS /////////////////////////////////////////////////////////////
+
+#if defined(INCLUDE_INTEL_OPENVINO_RUNTIME_FLAGS)
+
+ABSL_DECLARE_FLAG(int, intel_openvino_num_infer_requests);
+
+#endif
+
 // PARSERS (internal) //////////////////////////////////////////////////////////
 
 #if defined(INCLUDE_INTEL_OPENVINO_COMPILE_FLAGS) || \
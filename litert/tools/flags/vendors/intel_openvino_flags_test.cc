@@ -118,6 +118,26 @@ TEST(IntelOpenVinoOptionsFromFlagsTest, DefaultValues) {
   EXPECT_EQ(options.Value().GetDeviceType(), kLiteRtIntelOpenVinoDeviceTypeNPU);
   EXPECT_EQ(options.Value().GetPerformanceMode(),
             kLiteRtIntelOpenVinoPerformanceModeLatency);
+  EXPECT_EQ(options.Value().GetNumInferRequests(), 0);
+}
+
+TEST(IntelOpenVinoOptionsFromFlagsTest, SetNumInferRequests) {
+  absl::SetFlag(&FLAGS_intel_openvino_num_infer_requests, 4);
+  Expected<IntelOpenVinoOptions> options = IntelOpenVinoOptionsFromFlags();
+
+  ASSERT_TRUE(options.HasValue());
+  EXPECT_EQ(options.Value().GetNumInferRequests(), 4);
+
+  // Reset flag to default to avoid affecting other tests
+  absl::SetFlag(&FLAGS_intel_openvino_num_infer_requests, 0);
+}
+
+TEST(IntelOpenVinoOptionsFromFlagsTest, RejectsNegativeNumInferRequests) {
+  absl::SetFlag(&FLAGS_intel_openvino_num_infer_requests, -1);
+  EXPECT_FALSE(IntelOpenVinoOptionsFromFlags().HasValue());
+
+  // Reset flag to default to avoid affecting other tests
+  absl::SetFlag(&FLAGS_intel_openvino_num_infer_requests, 0);
 }
 
 TEST(IntelOpenVinoOptionsFromFlagsTest, SetDeviceTypeToCPU) {
@@ -102,6 +102,11 @@ ABSL_FLAG(litert::qualcomm::QualcommOptions::HtpPerformanceMode,
           litert::qualcomm::QualcommOptions::HtpPerformanceMode::kDefault,
           "HTP performance mode.");
 
+ABSL_FLAG(uint32_t, qualcomm_htp_latency_slo_us, 0,
+          "Target latency of one invocation in microseconds. If set, the HTP "
+          "performance mode is only voted for around bursts of invocations. "
+          "0 holds the performance mode for the whole session.");
+
 ABSL_FLAG(std::vector<std::string>, qualcomm_dump_tensor_ids, {},
           "Debug Feature. Ids to dump as outputs. Comma-separated list of "
           "string. Use -1 to dump all op outputs.");
@@ -321,6 +326,10 @@ Expected<void> UpdateQualcommOptionsFromFlags(QualcommOptions& opts) {
       absl::GetFlag(FLAGS_qualcomm_htp_performance_mode);
   opts.SetHtpPerformanceMode(htp_performance_mode);
 
+  const auto htp_latency_slo_us =
+      absl::GetFlag(FLAGS_qualcomm_htp_latency_slo_us);
+  opts.SetHtpLatencySloUs(htp_latency_slo_us);
+
   const auto profiling = absl::GetFlag(FLAGS_qualcomm_profiling);
   opts.SetProfiling(profiling);
 
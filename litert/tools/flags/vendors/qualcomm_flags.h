@@ -87,6 +87,8 @@ ABSL_DECLARE_FLAG(bool, qualcomm_use_fold_relu);
 ABSL_DECLARE_FLAG(litert::qualcomm::QualcommOptions::HtpPerformanceMode,
                   qualcomm_htp_performance_mode);
 
+ABSL_DECLARE_FLAG(uint32_t, qualcomm_htp_latency_slo_us);
+
 namespace litert::qualcomm {
 
 bool AbslParseFlag(absl::string_view text,
@@ -0,0 +1,133 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/tools/input_replay.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"  // from @com_google_absl
+#include "absl/strings/match.h"  // from @com_google_absl
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+#include "litert/cc/litert_buffer_ref.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/cc/litert_tensor_buffer.h"
+#include "litert/core/filesystem.h"
+
+namespace litert::tools {
+namespace {
+
+constexpr absl::string_view kInputSuffix = ".bin";
+
+}  // namespace
+
+Expected<std::vector<InputSet>> LoadInputSets(
+    absl::string_view dir, absl::Span<const absl::string_view> input_names,
+    absl::Span<const size_t> input_sizes) {
+  if (input_names.size() != input_sizes.size()) {
+    return Error(kLiteRtStatusErrorInvalidArgument,
+                 "Input names and sizes do not match");
+  }
+  LITERT_ASSIGN_OR_RETURN(auto files, internal::ListDir(dir));
+
+  // Set names, sorted so that the replay order does not depend on the file
+  // system.
+  std::map<std::string, absl::flat_hash_set<std::string>> set_files;
+  for (const auto& file : files) {
+    LITERT_ASSIGN_OR_RETURN(auto filename, internal::Filename(file));
+    if (!absl::EndsWith(filename, kInputSuffix)) {
+      continue;
+    }
+    const auto dot = filename.find('.');
+    set_files[filename.substr(0, dot)].insert(filename);
+  }
+  if (set_files.empty()) {
+    return Error(kLiteRtStatusErrorNotFound,
+                 absl::StrFormat("No input sets in %s", dir));
+  }
+
+  std::vector<InputSet> sets;
+  sets.reserve(set_files.size());
+  for (const auto& [name, filenames] : set_files) {
+    auto& set = sets.emplace_back();
+    set.name = name;
+    for (size_t i = 0; i < input_names.size(); ++i) {
+      const auto filename =
+          absl::StrFormat("%s.%s%s", name, input_names[i], kInputSuffix);
+      if (!filenames.contains(filename)) {
+        return Error(kLiteRtStatusErrorNotFound,
+                     absl::StrFormat("Input set %s has no %s", name, filename));
+      }
+      LITERT_ASSIGN_OR_RETURN(
+          auto data, internal::LoadBinaryFile(internal::Join({dir, filename})));
+      if (data.Size() != input_sizes[i]) {
+        return Error(kLiteRtStatusErrorInvalidArgument,
+                     absl::StrFormat("%s has %d bytes, input %s needs %d",
+                                     filename, data.Size(), input_names[i],
+                                     input_sizes[i]));
+      }
+      set.inputs.push_back(std::move(data));
+    }
+  }
+  return sets;
+}
+
+Expected<void> WriteInputSet(const InputSet& set,
+                             std::vector<TensorBuffer>& buffers) {
+  if (set.inputs.size() != buffers.size()) {
+    return Error(kLiteRtStatusErrorInvalidArgument,
+                 absl::StrFormat("Input set %s has %d inputs, expected %d",
+                                 set.name, set.inputs.size(), buffers.size()));
+  }
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    const auto& input = set.inputs[i];
+    LITERT_RETURN_IF_ERROR(buffers[i].Write<uint8_t>(
+        absl::MakeConstSpan(input.Data(), input.Size())));
+  }
+  return {};
+}
+
+Expected<InputReplay> InputReplay::Create(
+    std::vector<InputSet> sets, std::vector<std::vector<TensorBuffer>> slots) {
+  if (sets.empty() || slots.empty()) {
+    return Error(kLiteRtStatusErrorInvalidArgument,
+                 "Replay needs at least one input set and buffer slot");
+  }
+  if (slots.size() > sets.size()) {
+    slots.resize(sets.size());
+  }
+  for (size_t i = 0; i < slots.size(); ++i) {
+    LITERT_RETURN_IF_ERROR(WriteInputSet(sets[i], slots[i]));
+  }
+  return InputReplay(std::move(sets), std::move(slots));
+}
+
+Expected<void> InputReplay::Done(size_t i) {
+  // Each slot keeps its set when there are no more sets than slots.
+  if (NumSets() <= NumSlots()) {
+    return {};
+  }
+  return WriteInputSet(sets_[(i + NumSlots()) % NumSets()],
+                       slots_[i % NumSlots()]);
+}
+
+}  // namespace litert::tools
@@ -0,0 +1,94 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_TOOLS_INPUT_REPLAY_H_
+#define ODML_LITERT_LITERT_TOOLS_INPUT_REPLAY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/cc/litert_buffer_ref.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_tensor_buffer.h"
+
+// Replay of captured inputs, since the latency of many models depends on the
+// content of their inputs (sparsity, detection counts, early exits).
+
+namespace litert::tools {
+
+// One captured set of inputs, in the order of the signature inputs.
+struct InputSet {
+  std::string name;
+  std::vector<OwningBufferRef<uint8_t>> inputs;
+};
+
+// Loads the input sets captured in `dir`, sorted by name. Set `<set>` holds a
+// `<set>.<input name>.bin` file of raw tensor data for each of `input_names`,
+// of exactly `input_sizes` bytes.
+Expected<std::vector<InputSet>> LoadInputSets(
+    absl::string_view dir, absl::Span<const absl::string_view> input_names,
+    absl::Span<const size_t> input_sizes);
+
+// Writes `set` into `buffers`, which must match the signature inputs.
+Expected<void> WriteInputSet(const InputSet& set,
+                             std::vector<TensorBuffer>& buffers);
+
+// Replays input sets through a fixed number of pre-bound buffer slots, so
+// that no buffer is created or filled in the timed region. The set of
+// iteration `i` is already in its slot when the iteration starts, and the
+// buffers the accelerator may still be reading are never written.
+class InputReplay {
+ public:
+  // Fills the slots with the first sets. Uses two slots, or one if there is
+  // a single set.
+  static Expected<InputReplay> Create(
+      std::vector<InputSet> sets, std::vector<std::vector<TensorBuffer>> slots);
+
+  // Input buffers of iteration `i`.
+  std::vector<TensorBuffer>& Buffers(size_t i) {
+    return slots_[i % slots_.size()];
+  }
+
+  // Name of the set of iteration `i`.
+  const std::string& SetName(size_t i) const {
+    return sets_[i % sets_.size()].name;
+  }
+
+  // Index of the set of iteration `i`.
+  size_t SetIndex(size_t i) const { return i % sets_.size(); }
+
+  // Prepares the slot of iteration `i`, once it completed, for iteration
+  // `i + NumSlots()`. Must not be timed.
+  Expected<void> Done(size_t i);
+
+  size_t NumSets() const { return sets_.size(); }
+  size_t NumSlots() const { return slots_.size(); }
+
+ private:
+  InputReplay(std::vector<InputSet> sets,
+              std::vector<std::vector<TensorBuffer>> slots)
+      : sets_(std::move(sets)), slots_(std::move(slots)) {}
+
+  std::vector<InputSet> sets_;
+  std::vector<std::vector<TensorBuffer>> slots_;
+};
+
+}  // namespace litert::tools
+
+#endif  // ODML_LITERT_LITERT_TOOLS_INPUT_REPLAY_H_
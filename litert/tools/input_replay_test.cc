@@ -0,0 +1,141 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/tools/input_replay.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/cc/litert_ranked_tensor_type.h"
+#include "litert/cc/litert_tensor_buffer.h"
+#include "litert/core/filesystem.h"
+#include "litert/test/common.h"
+#include "litert/test/matchers.h"
+
+namespace litert::tools {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::SizeIs;
+
+void WriteFile(const std::string& path, const std::vector<float>& data) {
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(data.data()),
+             data.size() * sizeof(float));
+}
+
+constexpr absl::string_view kInputNames[] = {"x", "y"};
+constexpr size_t kInputSizes[] = {2 * sizeof(float), 2 * sizeof(float)};
+
+// Writes `num_sets` sets whose inputs are filled with the set index.
+std::string WriteSets(const testing::UniqueTestDirectory& dir, int num_sets) {
+  for (int i = 0; i < num_sets; ++i) {
+    const float value = i;
+    for (auto name : kInputNames) {
+      WriteFile(internal::Join({dir.Str(), absl::StrFormat("set%d.%s.bin", i,
+                                                           name)}),
+                {value, value});
+    }
+  }
+  return std::string(dir.Str());
+}
+
+std::vector<TensorBuffer> MakeBuffers() {
+  std::vector<TensorBuffer> buffers;
+  for (size_t size : kInputSizes) {
+    auto buffer = TensorBuffer::CreateManagedHostMemory(
+        MakeRankedTensorType<float>({2}), size);
+    buffers.push_back(std::move(*buffer));
+  }
+  return buffers;
+}
+
+float FirstValue(TensorBuffer& buffer) {
+  std::vector<float> data(2);
+  buffer.Read<float>(absl::MakeSpan(data));
+  return data[0];
+}
+
+TEST(InputReplayTest, LoadInputSets) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto dir, testing::UniqueTestDirectory::Create());
+  WriteSets(dir, 3);
+  // Ignored.
+  WriteFile(internal::Join({dir.Str(), "notes.txt"}), {});
+
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto sets, LoadInputSets(dir.Str(), kInputNames, kInputSizes));
+  ASSERT_THAT(sets, SizeIs(3));
+  EXPECT_EQ(sets[0].name, "set0");
+  EXPECT_EQ(sets[2].name, "set2");
+  EXPECT_THAT(sets[1].inputs, SizeIs(2));
+  EXPECT_EQ(sets[1].inputs[0].Size(), 2 * sizeof(float));
+}
+
+TEST(InputReplayTest, LoadInputSetsChecksInputs) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto dir, testing::UniqueTestDirectory::Create());
+  WriteFile(internal::Join({dir.Str(), "set0.x.bin"}), {1.0f, 2.0f});
+  // Missing y.
+  EXPECT_FALSE(LoadInputSets(dir.Str(), kInputNames, kInputSizes));
+
+  // Wrong size.
+  WriteFile(internal::Join({dir.Str(), "set0.y.bin"}), {1.0f});
+  EXPECT_FALSE(LoadInputSets(dir.Str(), kInputNames, kInputSizes));
+}
+
+TEST(InputReplayTest, DoubleBuffersTheSets) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto dir, testing::UniqueTestDirectory::Create());
+  WriteSets(dir, 3);
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto sets, LoadInputSets(dir.Str(), kInputNames, kInputSizes));
+  std::vector<std::vector<TensorBuffer>> slots;
+  slots.push_back(MakeBuffers());
+  slots.push_back(MakeBuffers());
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto replay, InputReplay::Create(std::move(sets), std::move(slots)));
+  EXPECT_EQ(replay.NumSlots(), 2);
+
+  std::vector<float> replayed;
+  for (size_t i = 0; i < 7; ++i) {
+    replayed.push_back(FirstValue(replay.Buffers(i)[0]));
+    EXPECT_EQ(replay.SetIndex(i), static_cast<size_t>(replayed.back()));
+    LITERT_ASSERT_OK(replay.Done(i));
+  }
+  EXPECT_THAT(replayed, ElementsAre(0, 1, 2, 0, 1, 2, 0));
+}
+
+TEST(InputReplayTest, SingleSetUsesOneSlot) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto dir, testing::UniqueTestDirectory::Create());
+  WriteSets(dir, 1);
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto sets, LoadInputSets(dir.Str(), kInputNames, kInputSizes));
+  std::vector<std::vector<TensorBuffer>> slots;
+  slots.push_back(MakeBuffers());
+  slots.push_back(MakeBuffers());
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto replay, InputReplay::Create(std::move(sets), std::move(slots)));
+  EXPECT_EQ(replay.NumSlots(), 1);
+  EXPECT_EQ(replay.SetName(5), "set0");
+}
+
+}  // namespace
+}  // namespace litert::tools
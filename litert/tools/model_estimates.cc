@@ -0,0 +1,370 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/tools/model_estimates.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/container/flat_hash_set.h"  // from @com_google_absl
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "litert/c/litert_model_types.h"
+#include "litert/c/litert_op_code.h"
+#include "litert/cc/internal/litert_logging.h"
+#include "litert/core/build_stamp.h"
+#include "litert/core/dispatch_op_schema.h"
+#include "litert/core/model/model.h"
+#include "litert/core/util/tensor_type_util.h"
+#include "litert/tools/dump.h"
+
+namespace litert::tools {
+namespace {
+
+using ::litert::internal::Dump;
+using ::litert::internal::GetDispatchOpOptions;
+using ::litert::internal::GetNumElements;
+using ::litert::internal::GetNumPackedBytes;
+
+// Same as the default tensor alignment of the TFLite arenas.
+constexpr size_t kArenaAlignment = 64;
+
+const LiteRtRankedTensorType* RankedType(const LiteRtTensorT& tensor) {
+  const auto& [type_id, type] = tensor.Type();
+  return type_id == kLiteRtRankedTensorType ? &type.ranked_tensor_type
+                                            : nullptr;
+}
+
+// Size of the tensor data, 0 if it is not statically known.
+size_t TensorBytes(const LiteRtTensorT& tensor) {
+  const auto* type = RankedType(tensor);
+  if (type == nullptr) {
+    return 0;
+  }
+  auto num_bytes = GetNumPackedBytes(*type);
+  return num_bytes ? *num_bytes : 0;
+}
+
+size_t NumElements(const LiteRtTensorT& tensor) {
+  const auto* type = RankedType(tensor);
+  if (type == nullptr) {
+    return 0;
+  }
+  auto num_elements = GetNumElements(*type);
+  return num_elements ? *num_elements : 0;
+}
+
+// Dimension `dim` of the tensor, counted from the end if negative.
+size_t Dim(const LiteRtTensorT* tensor, int dim) {
+  const auto* type = tensor == nullptr ? nullptr : RankedType(*tensor);
+  if (type == nullptr) {
+    return 0;
+  }
+  const int rank = type->layout.rank;
+  if (dim < 0) {
+    dim += rank;
+  }
+  if (dim < 0 || dim >= rank || type->layout.dimensions[dim] < 0) {
+    return 0;
+  }
+  return type->layout.dimensions[dim];
+}
+
+const LiteRtTensorT* Input(const LiteRtOpT& op, size_t index) {
+  return index < op.Inputs().size() ? op.Inputs()[index] : nullptr;
+}
+
+uint64_t EstimateFlops(const LiteRtOpT& op) {
+  const uint64_t output_elements =
+      op.Outputs().empty() ? 0 : NumElements(*op.Outputs()[0]);
+  switch (op.OpCode()) {
+    case kLiteRtOpCodeTflConv2d: {
+      // Filter is [out_channels, kh, kw, in_channels / groups].
+      const auto* filter = Input(op, 1);
+      return 2 * output_elements * Dim(filter, 1) * Dim(filter, 2) *
+             Dim(filter, 3);
+    }
+    case kLiteRtOpCodeTflDepthwiseConv2d: {
+      // Filter is [1, kh, kw, out_channels].
+      const auto* filter = Input(op, 1);
+      return 2 * output_elements * Dim(filter, 1) * Dim(filter, 2);
+    }
+    case kLiteRtOpCodeTflTransposeConv: {
+      // Each input element is scattered through the [out_channels, kh, kw,
+      // in_channels] filter.
+      const auto* filter = Input(op, 1);
+      const auto* input = Input(op, 2);
+      if (filter == nullptr || input == nullptr) {
+        return 0;
+      }
+      return 2 * static_cast<uint64_t>(NumElements(*input)) * Dim(filter, 0) *
+             Dim(filter, 1) * Dim(filter, 2);
+    }
+    case kLiteRtOpCodeTflFullyConnected:
+      // Weights are [out_channels, depth].
+      return 2 * output_elements * Dim(Input(op, 1), -1);
+    case kLiteRtOpCodeTflBatchMatmul: {
+      // The depth is whatever of the lhs is not in the output, which does
+      // not depend on the adjoint options.
+      const auto* lhs = Input(op, 0);
+      const size_t n = op.Outputs().empty() ? 0 : Dim(op.Outputs()[0], -1);
+      if (lhs == nullptr || n == 0 || output_elements == 0) {
+        return 0;
+      }
+      const uint64_t depth = NumElements(*lhs) * n / output_elements;
+      return 2 * output_elements * depth;
+    }
+    default:
+      return output_elements;
+  }
+}
+
+bool IsDispatchOp(const LiteRtModelT& model, const LiteRtOpT& op) {
+  const auto custom_op_code = internal::GetCustomOpCode(model, op);
+  return custom_op_code &&
+         *custom_op_code == internal::kLiteRtDispatchOpCustomName;
+}
+
+// Live range of an activation, in op indices.
+struct Interval {
+  size_t bytes;
+  size_t first;
+  size_t last;
+  size_t offset = 0;
+};
+
+// Places the activations the way the TFLite arena planner does, and returns
+// the size of the arena.
+size_t PlanArena(std::vector<Interval> intervals) {
+  std::stable_sort(intervals.begin(), intervals.end(),
+                   [](const Interval& a, const Interval& b) {
+                     return a.bytes != b.bytes ? a.bytes > b.bytes
+                                               : a.first < b.first;
+                   });
+  auto align = [](size_t offset) {
+    return (offset + kArenaAlignment - 1) / kArenaAlignment * kArenaAlignment;
+  };
+  // Placed intervals, sorted by offset.
+  std::vector<const Interval*> placed;
+  size_t arena_bytes = 0;
+  for (auto& interval : intervals) {
+    size_t best_offset = std::numeric_limits<size_t>::max();
+    size_t best_fit = std::numeric_limits<size_t>::max();
+    size_t current_offset = 0;
+    for (const auto* other : placed) {
+      if (other->last < interval.first || other->first > interval.last) {
+        continue;
+      }
+      const size_t aligned = align(current_offset);
+      if (aligned + interval.bytes <= other->offset &&
+          other->offset - aligned < best_fit) {
+        best_offset = aligned;
+        best_fit = other->offset - aligned;
+      }
+      current_offset = std::max(current_offset, other->offset + other->bytes);
+    }
+    interval.offset = best_offset != std::numeric_limits<size_t>::max()
+                          ? best_offset
+                          : align(current_offset);
+    arena_bytes = std::max(arena_bytes, interval.offset + interval.bytes);
+    placed.insert(std::upper_bound(placed.begin(), placed.end(), &interval,
+                                   [](const Interval* a, const Interval* b) {
+                                     return a->offset < b->offset;
+                                   }),
+                  &interval);
+  }
+  return arena_bytes;
+}
+
+size_t PeakLiveBytes(const std::vector<Interval>& intervals, size_t num_ops) {
+  std::vector<size_t> live(std::max<size_t>(num_ops, 1), 0);
+  for (const auto& interval : intervals) {
+    for (size_t i = interval.first; i <= interval.last; ++i) {
+      live[i] += interval.bytes;
+    }
+  }
+  return *std::max_element(live.begin(), live.end());
+}
+
+}  // namespace
+
+SignatureEstimate EstimateSubgraph(const LiteRtModelT& model,
+                                   size_t subgraph_index) {
+  const auto& subgraph = model.Subgraph(subgraph_index);
+  const auto& ops = subgraph.Ops();
+  SignatureEstimate estimate;
+  estimate.subgraph_index = subgraph_index;
+
+  absl::flat_hash_map<const LiteRtOpT*, size_t> op_indices;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    op_indices[ops[i]] = i;
+  }
+
+  // Activations and their live ranges.
+  const absl::flat_hash_set<const LiteRtTensorT*> outputs(
+      subgraph.Outputs().begin(), subgraph.Outputs().end());
+  const size_t last_op = ops.empty() ? 0 : ops.size() - 1;
+  std::vector<Interval> intervals;
+  for (const auto* tensor : subgraph.Tensors()) {
+    if (internal::IsConstant(*tensor)) {
+      continue;
+    }
+    const size_t bytes = TensorBytes(*tensor);
+    if (bytes == 0) {
+      ++estimate.num_dynamic_tensors;
+      continue;
+    }
+    auto defining = op_indices.find(tensor->DefiningOp());
+    Interval interval{bytes, 0, 0};
+    interval.first = defining == op_indices.end() ? 0 : defining->second;
+    interval.last = interval.first;
+    for (const auto* user : tensor->Users()) {
+      if (auto it = op_indices.find(user); it != op_indices.end()) {
+        interval.last = std::max(interval.last, it->second);
+      }
+    }
+    if (outputs.contains(tensor)) {
+      interval.last = last_op;
+    }
+    intervals.push_back(interval);
+  }
+  estimate.peak_live_bytes = PeakLiveBytes(intervals, ops.size());
+  estimate.arena_bytes = PlanArena(std::move(intervals));
+
+  // Partitions and their weights.
+  absl::flat_hash_set<const LiteRtTensorT*> counted_weights;
+  absl::flat_hash_set<size_t> counted_bytecode;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    const auto& op = *ops[i];
+    auto& roofline = estimate.ops.emplace_back();
+    roofline.op_index = i;
+    roofline.op_code = op.OpCode();
+    roofline.flops = EstimateFlops(op);
+    for (const auto* input : op.Inputs()) {
+      if (input != nullptr) {
+        roofline.bytes += TensorBytes(*input);
+      }
+    }
+    for (const auto* output : op.Outputs()) {
+      roofline.bytes += TensorBytes(*output);
+    }
+
+    if (IsDispatchOp(model, op)) {
+      auto& segment = estimate.segments.emplace_back();
+      segment.kind = SegmentEstimate::Kind::kDispatch;
+      segment.first_op = i;
+      segment.num_ops = 1;
+      const auto options = GetDispatchOpOptions(op.CustomOptions());
+      segment.weight_bytes = options.bytecode_size;
+      // Several dispatch ops may share a bytecode module.
+      if (counted_bytecode.insert(options.bytecode_offset).second) {
+        estimate.weight_bytes += options.bytecode_size;
+      }
+      for (const auto* input : op.Inputs()) {
+        if (input != nullptr && !internal::IsConstant(*input)) {
+          segment.input_bytes += TensorBytes(*input);
+        }
+      }
+      for (const auto* output : op.Outputs()) {
+        segment.output_bytes += TensorBytes(*output);
+      }
+      estimate.transfer_bytes += segment.input_bytes + segment.output_bytes;
+      continue;
+    }
+
+    if (estimate.segments.empty() ||
+        estimate.segments.back().kind != SegmentEstimate::Kind::kCpu) {
+      auto& segment = estimate.segments.emplace_back();
+      segment.first_op = i;
+    }
+    auto& segment = estimate.segments.back();
+    ++segment.num_ops;
+    for (const auto* input : op.Inputs()) {
+      if (input == nullptr || !internal::IsConstant(*input)) {
+        continue;
+      }
+      const size_t bytes = input->Weights().Buffer().Size();
+      segment.weight_bytes += bytes;
+      if (counted_weights.insert(input).second) {
+        estimate.weight_bytes += bytes;
+      }
+    }
+  }
+  return estimate;
+}
+
+std::vector<SignatureEstimate> EstimateSignatures(const LiteRtModelT& model) {
+  auto index_of = [&model](const LiteRtSubgraphT* subgraph) -> size_t {
+    for (size_t i = 0; i < model.NumSubgraphs(); ++i) {
+      if (&model.Subgraph(i) == subgraph) {
+        return i;
+      }
+    }
+    return 0;
+  };
+  std::vector<SignatureEstimate> estimates;
+  for (const auto* signature : model.Signatures()) {
+    auto& estimate = estimates.emplace_back(
+        EstimateSubgraph(model, index_of(&signature->GetSubgraph())));
+    estimate.key = std::string(signature->Key());
+  }
+  if (estimates.empty() && model.NumSubgraphs() > 0) {
+    auto& estimate = estimates.emplace_back(
+        EstimateSubgraph(model, LiteRtModelT::kMainSubgraphIndex));
+    estimate.key = "<main>";
+  }
+  return estimates;
+}
+
+void DumpEstimate(const SignatureEstimate& estimate, std::ostream& out,
+                  bool ops) {
+  out << absl::StreamFormat(
+      "  Signature \"%s\" (subgraph %d):\n"
+      "    Arena:     %s (peak live %s, %d dynamic tensors)\n"
+      "    Weights:   %s\n"
+      "    Transfers: %s per inference\n",
+      estimate.key, estimate.subgraph_index,
+      HumanReadableSize(estimate.arena_bytes),
+      HumanReadableSize(estimate.peak_live_bytes), estimate.num_dynamic_tensors,
+      HumanReadableSize(estimate.weight_bytes),
+      HumanReadableSize(estimate.transfer_bytes));
+  for (const auto& segment : estimate.segments) {
+    const bool dispatch = segment.kind == SegmentEstimate::Kind::kDispatch;
+    out << absl::StreamFormat("    %s ops [%d, %d): weights %s",
+                              dispatch ? "Dispatch" : "CPU", segment.first_op,
+                              segment.first_op + segment.num_ops,
+                              HumanReadableSize(segment.weight_bytes));
+    if (dispatch) {
+      out << absl::StreamFormat(", in %s, out %s",
+                                HumanReadableSize(segment.input_bytes),
+                                HumanReadableSize(segment.output_bytes));
+    }
+    out << "\n";
+  }
+  if (!ops) {
+    return;
+  }
+  for (const auto& op : estimate.ops) {
+    out << absl::StreamFormat("    Op %d ", op.op_index);
+    Dump(op.op_code, out);
+    out << absl::StreamFormat(": %d FLOPs, %s, %.2f FLOPs/byte\n", op.flops,
+                              HumanReadableSize(op.bytes), op.Intensity());
+  }
+}
+
+}  // namespace litert::tools
@@ -0,0 +1,98 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_TOOLS_MODEL_ESTIMATES_H_
+#define ODML_LITERT_LITERT_TOOLS_MODEL_ESTIMATES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "litert/c/litert_op_code.h"
+#include "litert/core/model/model.h"
+
+// Static estimates of the memory and bandwidth of a model, computed from its
+// graph alone so that quantization and partitioning can be weighed without
+// running it on a device. Tensors of dynamic shape count as 0 bytes.
+
+namespace litert::tools {
+
+// Roofline inputs of a single op.
+struct OpEstimate {
+  size_t op_index = 0;
+  LiteRtOpCode op_code = kLiteRtOpCodeTflCustom;
+  // Two per multiply-accumulate for the convolutions and matrix products,
+  // one per output element for everything else.
+  uint64_t flops = 0;
+  // Bytes of the inputs, weights included, and outputs.
+  size_t bytes = 0;
+
+  // FLOPs per byte moved.
+  double Intensity() const {
+    return bytes == 0 ? 0.0 : static_cast<double>(flops) / bytes;
+  }
+};
+
+// A run of consecutive ops on the host, or a single dispatch op.
+struct SegmentEstimate {
+  enum class Kind { kCpu, kDispatch };
+
+  Kind kind = Kind::kCpu;
+  size_t first_op = 0;
+  size_t num_ops = 0;
+  // Constant tensors of the host ops, or the bytecode of the dispatch op,
+  // which embeds its weights.
+  size_t weight_bytes = 0;
+  // Bytes copied to and from the accelerator on each inference, only for
+  // dispatch ops.
+  size_t input_bytes = 0;
+  size_t output_bytes = 0;
+};
+
+struct SignatureEstimate {
+  std::string key;
+  size_t subgraph_index = 0;
+  // High water mark of the activations placed in a single arena the way the
+  // TFLite arena planner does: greedy by size, best fit over the tensors
+  // alive at the same time.
+  size_t arena_bytes = 0;
+  // Most bytes of activations alive at the same time, the lower bound of the
+  // arena size.
+  size_t peak_live_bytes = 0;
+  // Constant tensors and bytecode, each counted once.
+  size_t weight_bytes = 0;
+  // Bytes crossing the host/accelerator boundaries on each inference.
+  size_t transfer_bytes = 0;
+  size_t num_dynamic_tensors = 0;
+  std::vector<SegmentEstimate> segments;
+  std::vector<OpEstimate> ops;
+};
+
+// Estimates one subgraph of `model`.
+SignatureEstimate EstimateSubgraph(const LiteRtModelT& model,
+                                   size_t subgraph_index);
+
+// Estimates the subgraph of each signature of `model`, or the main subgraph
+// if it has none.
+std::vector<SignatureEstimate> EstimateSignatures(const LiteRtModelT& model);
+
+// Prints `estimate`, including the roofline inputs of each op if `ops`.
+void DumpEstimate(const SignatureEstimate& estimate, std::ostream& out,
+                  bool ops = true);
+
+}  // namespace litert::tools
+
+#endif  // ODML_LITERT_LITERT_TOOLS_MODEL_ESTIMATES_H_
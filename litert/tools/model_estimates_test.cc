@@ -0,0 +1,98 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/tools/model_estimates.h"
+
+#include <cstdint>
+#include <sstream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "litert/c/litert_op_code.h"
+#include "litert/core/model/model.h"
+#include "litert/test/common.h"
+
+namespace litert::tools {
+namespace {
+
+using ::litert::testing::LoadTestFileModel;
+using ::testing::HasSubstr;
+using ::testing::SizeIs;
+
+TEST(ModelEstimatesTest, ElementwiseOp) {
+  auto model = LoadTestFileModel("one_mul.tflite");
+  auto estimates = EstimateSignatures(*model.Get());
+  ASSERT_THAT(estimates, SizeIs(1));
+  const auto& estimate = estimates[0];
+
+  // Two inputs and the output, 16 bytes each, alive at the same time and
+  // aligned in the arena.
+  EXPECT_EQ(estimate.peak_live_bytes, 48);
+  EXPECT_EQ(estimate.arena_bytes, 2 * 64 + 16);
+  EXPECT_EQ(estimate.weight_bytes, 0);
+  EXPECT_EQ(estimate.transfer_bytes, 0);
+
+  ASSERT_THAT(estimate.segments, SizeIs(1));
+  EXPECT_EQ(estimate.segments[0].kind, SegmentEstimate::Kind::kCpu);
+  EXPECT_EQ(estimate.segments[0].num_ops, 1);
+
+  ASSERT_THAT(estimate.ops, SizeIs(1));
+  EXPECT_EQ(estimate.ops[0].op_code, kLiteRtOpCodeTflMul);
+  EXPECT_EQ(estimate.ops[0].flops, 4);
+  EXPECT_EQ(estimate.ops[0].bytes, 48);
+}
+
+TEST(ModelEstimatesTest, Conv2dFlops) {
+  auto model = LoadTestFileModel("simple_conv_2d_op.tflite");
+  const auto estimate = EstimateSubgraph(*model.Get(), 0);
+  ASSERT_THAT(estimate.ops, SizeIs(1));
+  // 1x216x288x24 outputs, each over a 3x3x24 window.
+  const uint64_t outputs = 216 * 288 * 24;
+  EXPECT_EQ(estimate.ops[0].flops, 2 * outputs * 3 * 3 * 24);
+  EXPECT_GT(estimate.ops[0].Intensity(), 1.0);
+}
+
+TEST(ModelEstimatesTest, FullyConnectedFlops) {
+  auto model = LoadTestFileModel("simple_fully_connected_op.tflite");
+  const auto estimate = EstimateSubgraph(*model.Get(), 0);
+  ASSERT_THAT(estimate.ops, SizeIs(1));
+  EXPECT_EQ(estimate.ops[0].flops, uint64_t{2} * 128 * 2304 * 2048);
+}
+
+TEST(ModelEstimatesTest, DispatchBoundary) {
+  auto model = LoadTestFileModel(
+      "shared_input_cpu_npu_google_tensor_precompiled.tflite");
+  const auto estimate = EstimateSubgraph(*model.Get(), 0);
+
+  size_t num_dispatch = 0;
+  for (const auto& segment : estimate.segments) {
+    if (segment.kind != SegmentEstimate::Kind::kDispatch) {
+      continue;
+    }
+    ++num_dispatch;
+    // Two f32[2] inputs and one f32[2] output.
+    EXPECT_EQ(segment.input_bytes, 16);
+    EXPECT_EQ(segment.output_bytes, 8);
+    EXPECT_GT(segment.weight_bytes, 0);
+  }
+  EXPECT_EQ(num_dispatch, 1);
+  EXPECT_EQ(estimate.transfer_bytes, 24);
+
+  std::ostringstream out;
+  DumpEstimate(estimate, out);
+  EXPECT_THAT(out.str(), HasSubstr("Dispatch ops"));
+}
+
+}  // namespace
+}  // namespace litert::tools
@@ -0,0 +1,253 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "litert/tools/partition_breakdown.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/match.h"  // from @com_google_absl
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/str_join.h"  // from @com_google_absl
+#include "tflite/c/common.h"
+#include "tflite/core/subgraph.h"
+#include "tflite/profiling/profile_buffer.h"
+#include "tflite/util.h"
+
+namespace litert::benchmark {
+namespace {
+
+using ::tflite::profiling::ProfileEvent;
+
+// Recorded by DispatchDelegateKernel, with the bytes in event_metadata.
+constexpr char kDispatchCopyIn[] = "LiteRT::Dispatch[copy in]";
+constexpr char kDispatchInputSync[] = "LiteRT::Dispatch[input sync]";
+constexpr char kDispatchInvoke[] = "LiteRT::Dispatch[invoke]";
+constexpr char kDispatchCopyOut[] = "LiteRT::Dispatch[copy out]";
+constexpr char kDispatchPrefix[] = "LiteRT::Dispatch[";
+constexpr char kRunPrefix[] = "LiteRT::Run[";
+
+size_t NonConstantBytes(const tflite::Subgraph& subgraph,
+                        const TfLiteIntArray* tensors) {
+  size_t bytes = 0;
+  for (int i = 0; i < tensors->size; ++i) {
+    const int tensor_index = tensors->data[i];
+    if (tensor_index == kTfLiteOptionalTensor) {
+      continue;
+    }
+    const TfLiteTensor* tensor = subgraph.tensor(tensor_index);
+    if (tensor != nullptr && tensor->allocation_type != kTfLiteMmapRo) {
+      bytes += tensor->bytes;
+    }
+  }
+  return bytes;
+}
+
+// Time span of an operator event of a delegated partition.
+struct DelegateSpan {
+  uint64_t begin_us;
+  uint64_t end_us;
+  int segment;
+};
+
+double AvgMs(int64_t total_us, int num_runs) {
+  return num_runs > 0 ? total_us / 1e3 / num_runs : 0.0;
+}
+
+int64_t AvgBytes(int64_t total_bytes, int num_runs) {
+  return num_runs > 0 ? total_bytes / num_runs : 0;
+}
+
+}  // namespace
+
+std::vector<PartitionNode> GetPartitionNodes(const tflite::Subgraph& subgraph) {
+  std::vector<PartitionNode> nodes;
+  for (int node_index : subgraph.execution_plan()) {
+    const auto* node_and_registration =
+        subgraph.node_and_registration(node_index);
+    if (node_and_registration == nullptr) {
+      continue;
+    }
+    const auto& [node, registration] = *node_and_registration;
+    PartitionNode partition_node;
+    partition_node.node_index = node_index;
+    partition_node.delegated = node.delegate != nullptr;
+    partition_node.op_name = tflite::GetOpNameByRegistration(registration);
+    partition_node.input_bytes = NonConstantBytes(subgraph, node.inputs);
+    partition_node.output_bytes = NonConstantBytes(subgraph, node.outputs);
+    nodes.push_back(std::move(partition_node));
+  }
+  return nodes;
+}
+
+PartitionBreakdown::PartitionBreakdown(const std::vector<PartitionNode>& nodes,
+                                       int subgraph_index)
+    : subgraph_index_(subgraph_index) {
+  std::vector<std::vector<std::string>> cpu_op_names;
+  for (const PartitionNode& node : nodes) {
+    // Every delegated node is its own partition; consecutive CPU nodes form
+    // one island.
+    if (node.delegated || segments_.empty() ||
+        segments_.back().kind != PartitionSegment::Kind::kCpu) {
+      PartitionSegment segment;
+      segment.kind = node.delegated ? PartitionSegment::Kind::kDelegate
+                                    : PartitionSegment::Kind::kCpu;
+      if (node.delegated) {
+        segment.name = node.op_name;
+        segment.input_bytes = node.input_bytes;
+        segment.output_bytes = node.output_bytes;
+      }
+      segments_.push_back(std::move(segment));
+      cpu_op_names.emplace_back();
+    }
+    PartitionSegment& segment = segments_.back();
+    segment.node_indices.push_back(node.node_index);
+    if (!node.delegated) {
+      auto& op_names = cpu_op_names.back();
+      if (std::find(op_names.begin(), op_names.end(), node.op_name) ==
+          op_names.end()) {
+        op_names.push_back(node.op_name);
+      }
+    }
+    if (node.node_index >= static_cast<int>(segment_of_node_.size())) {
+      segment_of_node_.resize(node.node_index + 1, -1);
+    }
+    segment_of_node_[node.node_index] = segments_.size() - 1;
+  }
+  for (size_t i = 0; i < segments_.size(); ++i) {
+    if (segments_[i].kind == PartitionSegment::Kind::kCpu) {
+      segments_[i].name = absl::StrJoin(cpu_op_names[i], ", ");
+    }
+  }
+}
+
+void PartitionBreakdown::ProcessProfiles(
+    const std::vector<const ProfileEvent*>& events) {
+  bool has_operator_events = false;
+  std::vector<DelegateSpan> delegate_spans;
+  for (const ProfileEvent* event : events) {
+    if (event->event_type != ProfileEvent::EventType::OPERATOR_INVOKE_EVENT ||
+        event->extra_event_metadata != subgraph_index_ ||
+        event->event_metadata < 0 ||
+        event->event_metadata >=
+            static_cast<int64_t>(segment_of_node_.size())) {
+      continue;
+    }
+    const int segment = segment_of_node_[event->event_metadata];
+    if (segment < 0) {
+      continue;
+    }
+    has_operator_events = true;
+    segments_[segment].total_us += event->elapsed_time;
+    if (segments_[segment].kind == PartitionSegment::Kind::kDelegate) {
+      delegate_spans.push_back(
+          {event->begin_timestamp_us,
+           event->begin_timestamp_us + event->elapsed_time, segment});
+    }
+  }
+  if (!has_operator_events) {
+    return;
+  }
+  ++num_runs_;
+
+  for (const ProfileEvent* event : events) {
+    if (event->event_type != ProfileEvent::EventType::DEFAULT) {
+      continue;
+    }
+    if (absl::StartsWith(event->tag, kRunPrefix)) {
+      runtime_overhead_us_ += event->elapsed_time;
+      continue;
+    }
+    if (!absl::StartsWith(event->tag, kDispatchPrefix)) {
+      continue;
+    }
+    // The dispatch events are nested in the operator event of their
+    // partition.
+    auto span = std::find_if(
+        delegate_spans.begin(), delegate_spans.end(),
+        [event](const DelegateSpan& span) {
+          return event->begin_timestamp_us >= span.begin_us &&
+                 event->begin_timestamp_us <= span.end_us;
+        });
+    if (span == delegate_spans.end()) {
+      continue;
+    }
+    PartitionSegment& segment = segments_[span->segment];
+    if (event->tag == kDispatchCopyIn) {
+      segment.copy_in_us += event->elapsed_time;
+      segment.copy_in_bytes += event->event_metadata;
+    } else if (event->tag == kDispatchInputSync) {
+      segment.input_sync_us += event->elapsed_time;
+    } else if (event->tag == kDispatchInvoke) {
+      segment.invoke_us += event->elapsed_time;
+    } else if (event->tag == kDispatchCopyOut) {
+      segment.copy_out_us += event->elapsed_time;
+      segment.copy_out_bytes += event->event_metadata;
+    }
+  }
+}
+
+std::string PartitionBreakdown::ToString() const {
+  int64_t total_us = runtime_overhead_us_;
+  for (const PartitionSegment& segment : segments_) {
+    total_us += segment.total_us;
+  }
+  auto percent = [total_us](int64_t us) {
+    return total_us > 0 ? 100.0 * us / total_us : 0.0;
+  };
+
+  std::string out;
+  absl::StrAppendFormat(&out,
+                        "========== PARTITION BREAKDOWN (%d runs) ==========\n",
+                        num_runs_);
+  absl::StrAppend(&out,
+                  "Segment Kind     Nodes  Avg (ms)       % | In (B)    "
+                  "Out (B)  | Copy in ms (B)      Sync ms  Invoke ms  "
+                  "Copy out ms (B)     | Ops\n");
+  for (size_t i = 0; i < segments_.size(); ++i) {
+    const PartitionSegment& segment = segments_[i];
+    const bool delegated = segment.kind == PartitionSegment::Kind::kDelegate;
+    absl::StrAppendFormat(&out, "%7zu %-8s %5zu %9.3f %6.2f%% ", i,
+                          delegated ? "DELEGATE" : "CPU",
+                          segment.node_indices.size(),
+                          AvgMs(segment.total_us, num_runs_),
+                          percent(segment.total_us));
+    if (delegated) {
+      absl::StrAppendFormat(
+          &out,
+          "| %-9zu %-9zu| %7.3f (%-10d) %7.3f  %9.3f  %7.3f (%-10d) | %s\n",
+          segment.input_bytes, segment.output_bytes,
+          AvgMs(segment.copy_in_us, num_runs_),
+          AvgBytes(segment.copy_in_bytes, num_runs_),
+          AvgMs(segment.input_sync_us, num_runs_),
+          AvgMs(segment.invoke_us, num_runs_),
+          AvgMs(segment.copy_out_us, num_runs_),
+          AvgBytes(segment.copy_out_bytes, num_runs_), segment.name);
+    } else {
+      absl::StrAppendFormat(&out, "| %-19s| %-58s | %s\n", "", "",
+                            segment.name);
+    }
+  }
+  absl::StrAppendFormat(&out, "Runtime overhead: %.3f ms (%.2f%%)\n",
+                        AvgMs(runtime_overhead_us_, num_runs_),
+                        percent(runtime_overhead_us_));
+  absl::StrAppend(&out, "==================================================\n");
+  return out;
+}
+
+}  // namespace litert::benchmark
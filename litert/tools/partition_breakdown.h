@@ -0,0 +1,101 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef ODML_LITERT_LITERT_TOOLS_PARTITION_BREAKDOWN_H_
+#define ODML_LITERT_LITERT_TOOLS_PARTITION_BREAKDOWN_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tflite/core/subgraph.h"
+#include "tflite/profiling/profile_buffer.h"
+
+// Per-partition breakdown of the runs of a partially delegated model: the time
+// of each delegated partition and of each CPU island in between, and the cost
+// of the transfers at their boundaries, from the events of the LiteRT
+// profiler.
+
+namespace litert::benchmark {
+
+// A node of the execution plan.
+struct PartitionNode {
+  int node_index = 0;
+  bool delegated = false;
+  std::string op_name;
+  // Bytes of the non-constant input and output tensors.
+  size_t input_bytes = 0;
+  size_t output_bytes = 0;
+};
+
+// A delegated partition, or a maximal run of CPU nodes between two of them.
+struct PartitionSegment {
+  enum class Kind { kCpu, kDelegate };
+
+  Kind kind = Kind::kCpu;
+  // The op name of a delegated partition, or the distinct op names of a CPU
+  // island.
+  std::string name;
+  std::vector<int> node_indices;
+  // Bytes crossing the boundary of a delegated partition per run.
+  size_t input_bytes = 0;
+  size_t output_bytes = 0;
+
+  // Totals over the processed runs. The transfers are recorded by the
+  // dispatch delegate only; they are part of total_us.
+  int64_t total_us = 0;
+  int64_t copy_in_us = 0;
+  int64_t copy_in_bytes = 0;
+  int64_t input_sync_us = 0;
+  int64_t invoke_us = 0;
+  int64_t copy_out_us = 0;
+  int64_t copy_out_bytes = 0;
+};
+
+// Returns the nodes of the execution plan of `subgraph`.
+std::vector<PartitionNode> GetPartitionNodes(const tflite::Subgraph& subgraph);
+
+class PartitionBreakdown {
+ public:
+  // `nodes` are in execution order; `subgraph_index` selects the operator
+  // events to attribute.
+  PartitionBreakdown(const std::vector<PartitionNode>& nodes,
+                     int subgraph_index);
+
+  // Attributes the events of one run.
+  void ProcessProfiles(
+      const std::vector<const tflite::profiling::ProfileEvent*>& events);
+
+  const std::vector<PartitionSegment>& segments() const { return segments_; }
+  int num_runs() const { return num_runs_; }
+  // Total of the LiteRT::Run events outside of the interpreter, such as the
+  // buffer registration and synchronization.
+  int64_t runtime_overhead_us() const { return runtime_overhead_us_; }
+
+  // Table of the average time per run of each segment.
+  std::string ToString() const;
+
+ private:
+  std::vector<PartitionSegment> segments_;
+  // Segment of each node index, -1 for the nodes outside the plan.
+  std::vector<int> segment_of_node_;
+  int subgraph_index_;
+  int num_runs_ = 0;
+  int64_t runtime_overhead_us_ = 0;
+};
+
+}  // namespace litert::benchmark
+
+#endif  // ODML_LITERT_LITERT_TOOLS_PARTITION_BREAKDOWN_H_
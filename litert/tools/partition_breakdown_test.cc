@@ -0,0 +1,140 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "litert/tools/partition_breakdown.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tflite/profiling/profile_buffer.h"
+
+namespace litert::benchmark {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::tflite::profiling::ProfileEvent;
+
+PartitionNode Node(int index, bool delegated, const std::string& op_name) {
+  PartitionNode node;
+  node.node_index = index;
+  node.delegated = delegated;
+  node.op_name = op_name;
+  return node;
+}
+
+ProfileEvent OperatorEvent(int node, uint64_t begin_us, uint64_t elapsed_us,
+                           int subgraph = 0) {
+  ProfileEvent event{};
+  event.tag = "op";
+  event.event_type = ProfileEvent::EventType::OPERATOR_INVOKE_EVENT;
+  event.begin_timestamp_us = begin_us;
+  event.elapsed_time = elapsed_us;
+  event.event_metadata = node;
+  event.extra_event_metadata = subgraph;
+  return event;
+}
+
+ProfileEvent DefaultEvent(const std::string& tag, uint64_t begin_us,
+                          uint64_t elapsed_us, int64_t bytes = 0) {
+  ProfileEvent event{};
+  event.tag = tag;
+  event.event_type = ProfileEvent::EventType::DEFAULT;
+  event.begin_timestamp_us = begin_us;
+  event.elapsed_time = elapsed_us;
+  event.event_metadata = bytes;
+  return event;
+}
+
+std::vector<const ProfileEvent*> Pointers(
+    const std::vector<ProfileEvent>& events) {
+  std::vector<const ProfileEvent*> pointers;
+  for (const ProfileEvent& event : events) {
+    pointers.push_back(&event);
+  }
+  return pointers;
+}
+
+// CPU island, delegated partition, CPU island.
+std::vector<PartitionNode> MixedNodes() {
+  return {Node(0, false, "QUANTIZE"), Node(1, false, "RESHAPE"),
+          Node(5, true, "DELEGATE DispatchDelegate"),
+          Node(3, false, "SOFTMAX"), Node(4, false, "SOFTMAX")};
+}
+
+TEST(PartitionBreakdownTest, GroupsCpuIslandsAroundPartitions) {
+  PartitionBreakdown breakdown(MixedNodes(), /*subgraph_index=*/0);
+
+  const auto& segments = breakdown.segments();
+  ASSERT_EQ(segments.size(), 3);
+  EXPECT_EQ(segments[0].kind, PartitionSegment::Kind::kCpu);
+  EXPECT_EQ(segments[0].name, "QUANTIZE, RESHAPE");
+  EXPECT_THAT(segments[0].node_indices, ElementsAre(0, 1));
+  EXPECT_EQ(segments[1].kind, PartitionSegment::Kind::kDelegate);
+  EXPECT_EQ(segments[1].name, "DELEGATE DispatchDelegate");
+  EXPECT_EQ(segments[2].name, "SOFTMAX");
+  EXPECT_THAT(segments[2].node_indices, ElementsAre(3, 4));
+}
+
+TEST(PartitionBreakdownTest, AttributesTransfersToTheirPartition) {
+  PartitionBreakdown breakdown(MixedNodes(), /*subgraph_index=*/0);
+  const std::vector<ProfileEvent> events = {
+      DefaultEvent("LiteRT::Run[buffer registration]", 0, 5),
+      OperatorEvent(0, 10, 20),
+      OperatorEvent(1, 30, 10),
+      OperatorEvent(5, 40, 100),
+      DefaultEvent("LiteRT::Dispatch[copy in]", 41, 10, 1024),
+      DefaultEvent("LiteRT::Dispatch[invoke]", 51, 80),
+      DefaultEvent("LiteRT::Dispatch[copy out]", 131, 8, 256),
+      OperatorEvent(3, 140, 30),
+      OperatorEvent(4, 170, 30),
+      // Another subgraph.
+      OperatorEvent(3, 200, 1000, /*subgraph=*/1),
+  };
+  breakdown.ProcessProfiles(Pointers(events));
+  breakdown.ProcessProfiles(Pointers(events));
+
+  EXPECT_EQ(breakdown.num_runs(), 2);
+  EXPECT_EQ(breakdown.runtime_overhead_us(), 10);
+  const auto& segments = breakdown.segments();
+  EXPECT_EQ(segments[0].total_us, 60);
+  EXPECT_EQ(segments[1].total_us, 200);
+  EXPECT_EQ(segments[1].copy_in_us, 20);
+  EXPECT_EQ(segments[1].copy_in_bytes, 2048);
+  EXPECT_EQ(segments[1].invoke_us, 160);
+  EXPECT_EQ(segments[1].copy_out_bytes, 512);
+  EXPECT_EQ(segments[2].total_us, 120);
+
+  const std::string table = breakdown.ToString();
+  EXPECT_THAT(table, HasSubstr("(2 runs)"));
+  EXPECT_THAT(table, HasSubstr("DELEGATE DispatchDelegate"));
+  EXPECT_THAT(table, HasSubstr("(1024"));
+}
+
+TEST(PartitionBreakdownTest, IgnoresRunsWithoutOperatorEvents) {
+  PartitionBreakdown breakdown(MixedNodes(), /*subgraph_index=*/0);
+  const std::vector<ProfileEvent> events = {
+      DefaultEvent("LiteRT::Run[buffer registration]", 0, 5)};
+  breakdown.ProcessProfiles(Pointers(events));
+
+  EXPECT_EQ(breakdown.num_runs(), 0);
+  EXPECT_EQ(breakdown.runtime_overhead_us(), 0);
+}
+
+}  // namespace
+}  // namespace litert::benchmark
@@ -23,6 +23,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -48,6 +49,7 @@
 #include "litert/tools/flags/vendors/intel_openvino_flags.h"  // IWYU pragma: keep
 #include "litert/tools/flags/vendors/mediatek_flags.h"  // IWYU pragma: keep
 #include "litert/tools/flags/vendors/qualcomm_flags.h"  // IWYU pragma: keep
+#include "litert/tools/input_replay.h"
 #include "litert/tools/tensor_utils.h"
 #include "tflite/profiling/time.h"
 
@@ -75,6 +77,12 @@ ABSL_FLAG(bool, language_model, false,
           " so that the input tensors will be reasonable.");
 ABSL_FLAG(bool, enable_on_device_compilation_caching, false,
           "Whether to enable on device compilation caching.");
+ABSL_FLAG(std::string, input_dir, "",
+          "Directory of captured input sets to replay instead of generated "
+          "inputs. Set <set> holds a <set>.<input name>.bin file of raw tensor "
+          "data for each input of the signature. The sets are replayed in "
+          "name order, round robin over the iterations, and are written into "
+          "double buffered input buffers outside of the timed runs.");
 constexpr absl::string_view kCompilerCacheDir =
     "/data/local/tmp/litert_compiler_cache";
 
@@ -291,6 +299,56 @@ Expected<void> PrintTensorBuffer(TensorBuffer& buffer,
   return {};
 }
 
+// Loads the captured input sets and pre-binds them to two slots of input
+// buffers, the first one being `input_buffers`.
+Expected<tools::InputReplay> MakeInputReplay(
+    CompiledModel& compiled_model, size_t signature_index,
+    const std::string& input_dir, std::vector<TensorBuffer> input_buffers) {
+  LITERT_ASSIGN_OR_RETURN(auto signature,
+                          compiled_model.GetSignature(signature_index));
+  const auto input_names = signature.InputNames();
+  std::vector<size_t> input_sizes;
+  for (auto& buffer : input_buffers) {
+    LITERT_ASSIGN_OR_RETURN(auto size, buffer.PackedSize());
+    input_sizes.push_back(size);
+  }
+  LITERT_ASSIGN_OR_RETURN(
+      auto sets, tools::LoadInputSets(input_dir, input_names, input_sizes));
+
+  std::vector<std::vector<TensorBuffer>> slots;
+  slots.push_back(std::move(input_buffers));
+  if (sets.size() > 1) {
+    LITERT_ASSIGN_OR_RETURN(auto second,
+                            compiled_model.CreateInputBuffers(signature_index));
+    slots.push_back(std::move(second));
+  }
+  return tools::InputReplay::Create(std::move(sets), std::move(slots));
+}
+
+// Logs the latency of each input set, which depends on the content of the
+// inputs for many models.
+void LogReplayLatencies(const tools::InputReplay& replay,
+                        const std::vector<uint64_t>& timers) {
+  std::vector<std::vector<uint64_t>> per_set(replay.NumSets());
+  for (size_t i = 0; i < timers.size(); ++i) {
+    per_set[replay.SetIndex(i)].push_back(timers[i]);
+  }
+  for (size_t i = 0; i < per_set.size(); ++i) {
+    const auto& set_timers = per_set[i];
+    if (set_timers.empty()) {
+      continue;
+    }
+    ABSL_LOG(INFO) << "Input set " << replay.SetName(i) << ": "
+                   << set_timers.size() << " runs, average "
+                   << std::accumulate(set_timers.begin(), set_timers.end(),
+                                      uint64_t{0}) /
+                          set_timers.size()
+                   << " microseconds, fastest "
+                   << *std::min_element(set_timers.begin(), set_timers.end())
+                   << " microseconds";
+  }
+}
+
 Expected<void> RunModel() {
   if (absl::GetFlag(FLAGS_graph).empty()) {
     return Error(kLiteRtStatusErrorInvalidArgument,
@@ -313,7 +371,22 @@ Expected<void> RunModel() {
   LITERT_ASSIGN_OR_RETURN(auto input_buffers,
                           compiled_model.CreateInputBuffers(signature_index));
 
-  if (!absl::GetFlag(FLAGS_language_model)) {  // non-language model
+  std::optional<tools::InputReplay> replay;
+  if (const auto input_dir = absl::GetFlag(FLAGS_input_dir);
+      !input_dir.empty()) {
+    LITERT_ASSIGN_OR_RETURN(
+        replay, MakeInputReplay(compiled_model, signature_index, input_dir,
+                                std::move(input_buffers)));
+    ABSL_LOG(INFO) << "Replaying " << replay->NumSets() << " input sets from "
+                   << input_dir << " through " << replay->NumSlots()
+                   << " buffer slots";
+    if (absl::GetFlag(FLAGS_print_tensors)) {
+      for (size_t i = 0; i < replay->Buffers(0).size(); ++i) {
+        LITERT_RETURN_IF_ERROR(
+            PrintTensorBuffer(replay->Buffers(0)[i], "Input", i));
+      }
+    }
+  } else if (!absl::GetFlag(FLAGS_language_model)) {  // non-language model
     // Fill input buffers with sample data
     for (size_t i = 0; i < input_buffers.size(); ++i) {
       auto& buffer = input_buffers[i];
@@ -351,11 +424,15 @@ Expected<void> RunModel() {
   ABSL_LOG(INFO) << "Run model for " << iterations << " times";
   litert::Expected<void> status;
   std::vector<uint64_t> timers(iterations, 0);
-  for (auto& timer : timers) {
+  for (size_t i = 0; i < iterations; ++i) {
+    auto& inputs = replay ? replay->Buffers(i) : input_buffers;
     uint64_t start = tflite::profiling::time::NowMicros();
-    status = compiled_model.Run(signature_index, input_buffers, output_buffers);
+    status = compiled_model.Run(signature_index, inputs, output_buffers);
     uint64_t end = tflite::profiling::time::NowMicros();
-    timer = end - start;
+    timers[i] = end - start;
+    if (replay) {
+      LITERT_RETURN_IF_ERROR(replay->Done(i));
+    }
   }
   ABSL_LOG(INFO) << "First run took " << timers[0] << " microseconds";
   ABSL_LOG(INFO) << "Slowest run took "
@@ -369,6 +446,10 @@ Expected<void> RunModel() {
                         timers.size()
                  << " microseconds";
 
+  if (replay) {
+    LogReplayLatencies(*replay, timers);
+  }
+
   // Print output tensor information and values if requested
   if (absl::GetFlag(FLAGS_print_tensors)) {
     for (size_t i = 0; i < output_buffers.size(); ++i) {
@@ -0,0 +1,219 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "litert/tools/startup_phases.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"  // from @com_google_absl
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/internal/litert_logging.h"
+#include "litert/c/litert_common.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/core/filesystem.h"
+#include "tflite/profiling/time.h"
+
+#if defined(__linux__) || defined(__ANDROID__)
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace litert::tools {
+namespace {
+
+constexpr std::pair<StartupVariant, absl::string_view> kVariantNames[] = {
+    {StartupVariant::kCold, "cold"},
+    {StartupVariant::kWarm, "warm"},
+    {StartupVariant::kDroppedPageCache, "dropped_page_cache"},
+};
+
+#if defined(__linux__) || defined(__ANDROID__)
+Expected<void> EvictFileFromPageCache(const std::string& path) {
+  const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return Unexpected(kLiteRtStatusErrorFileIO,
+                      absl::StrCat("Failed to open ", path));
+  }
+  // Dirty pages are not evicted, the ones of a cache written by the previous
+  // startup are written back first.
+  fdatasync(fd);
+  const int error = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  close(fd);
+  if (error != 0) {
+    return Unexpected(kLiteRtStatusErrorFileIO,
+                      absl::StrCat("Failed to evict ", path,
+                                   " from the page cache"));
+  }
+  return {};
+}
+#endif
+
+}  // namespace
+
+absl::string_view StartupVariantName(StartupVariant variant) {
+  for (const auto& [value, name] : kVariantNames) {
+    if (value == variant) return name;
+  }
+  return "unknown";
+}
+
+Expected<StartupVariant> ParseStartupVariant(absl::string_view name) {
+  for (const auto& [value, variant_name] : kVariantNames) {
+    if (variant_name == name) return value;
+  }
+  return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                    absl::StrCat("Unknown startup variant: ", name));
+}
+
+double StartupResult::StartupMs() const {
+  double ms = 0.0;
+  for (const StartupPhase& phase : phases) {
+    ms += phase.ms;
+  }
+  return ms;
+}
+
+PhaseTimer::PhaseTimer(std::vector<StartupPhase>& phases)
+    : phases_(phases),
+      start_us_(tflite::profiling::time::NowMicros()),
+      start_major_faults_(MajorPageFaults()) {}
+
+StartupPhase& PhaseTimer::EndPhase(absl::string_view name) {
+  const uint64_t end_us = tflite::profiling::time::NowMicros();
+  const int64_t end_major_faults = MajorPageFaults();
+  StartupPhase& phase = phases_.emplace_back();
+  phase.name = std::string(name);
+  phase.ms = (end_us - start_us_) * 1e-3;
+  phase.major_faults = end_major_faults - start_major_faults_;
+  // The next phase starts after the bookkeeping of this one.
+  start_us_ = tflite::profiling::time::NowMicros();
+  start_major_faults_ = end_major_faults;
+  return phase;
+}
+
+int64_t MajorPageFaults() {
+#if defined(__linux__) || defined(__ANDROID__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    return usage.ru_majflt;
+  }
+#endif
+  return 0;
+}
+
+Expected<void> EvictFromPageCache(absl::string_view path) {
+#if defined(__linux__) || defined(__ANDROID__)
+  if (!internal::IsDir(path)) {
+    return EvictFileFromPageCache(std::string(path));
+  }
+  LITERT_ASSIGN_OR_RETURN(auto files, internal::ListDir(path));
+  for (const std::string& file : files) {
+    LITERT_RETURN_IF_ERROR(EvictFileFromPageCache(file));
+  }
+  return {};
+#else
+  return Unexpected(kLiteRtStatusErrorUnsupported,
+                    "Evicting files from the page cache is not supported on "
+                    "this platform");
+#endif
+}
+
+void LogStartupReport(absl::Span<const StartupResult> results) {
+  LITERT_LOG(LITERT_INFO, "\n============ STARTUP PHASES ============");
+  for (const StartupResult& result : results) {
+    const std::string variant(StartupVariantName(result.variant));
+    if (!result.Ran()) {
+      LITERT_LOG(LITERT_INFO, "%s: failed: %s", variant.c_str(),
+                 result.error.c_str());
+      continue;
+    }
+    LITERT_LOG(LITERT_INFO, "%s: %.2f ms to the end of the first run%s",
+               variant.c_str(), result.StartupMs(),
+               result.compiler_cache_hit ? ", compiler cache hit" : "");
+    LITERT_LOG(LITERT_INFO, "  Phase                        |         ms | "
+                            "Major faults");
+    for (const StartupPhase& phase : result.phases) {
+      LITERT_LOG(LITERT_INFO, "  %-28s | %10.2f | %12lld", phase.name.c_str(),
+                 phase.ms,
+                 static_cast<long long>(phase.major_faults));  // NOLINT
+      for (const auto& [part, ms] : phase.parts) {
+        LITERT_LOG(LITERT_INFO, "    %-26s | %10.2f |", part.c_str(), ms);
+      }
+    }
+    LITERT_LOG(LITERT_INFO,
+               "  Steady state ms: mean %.3f, p50 %.3f, p90 %.3f, min %.3f, "
+               "max %.3f",
+               result.steady_state.mean_ms, result.steady_state.p50_ms,
+               result.steady_state.p90_ms, result.steady_state.min_ms,
+               result.steady_state.max_ms);
+  }
+  LITERT_LOG(LITERT_INFO, "========================================\n");
+}
+
+Expected<void> WriteStartupCsv(absl::Span<const StartupResult> results,
+                               absl::string_view path) {
+  std::ofstream file{std::string(path)};
+  if (!file) {
+    return Unexpected(kLiteRtStatusErrorFileIO,
+                      absl::StrCat("Failed to open ", path));
+  }
+  file << "variant,phase,part,ms,major_faults,compiler_cache_hit,error\n";
+  for (const StartupResult& result : results) {
+    const absl::string_view variant = StartupVariantName(result.variant);
+    if (!result.Ran()) {
+      // The error is the last column, and has no commas.
+      std::string error = result.error;
+      std::replace(error.begin(), error.end(), ',', ';');
+      std::replace(error.begin(), error.end(), '\n', ' ');
+      file << absl::StrFormat("%s,,,,,,%s\n", variant, error);
+      continue;
+    }
+    const int cache_hit = result.compiler_cache_hit;
+    for (const StartupPhase& phase : result.phases) {
+      file << absl::StrFormat("%s,%s,,%.3f,%d,%d,\n", variant, phase.name,
+                              phase.ms, phase.major_faults, cache_hit);
+      for (const auto& [part, ms] : phase.parts) {
+        file << absl::StrFormat("%s,%s,%s,%.3f,,%d,\n", variant, phase.name,
+                                part, ms, cache_hit);
+      }
+    }
+    file << absl::StrFormat("%s,total,,%.3f,,%d,\n", variant,
+                            result.StartupMs(), cache_hit);
+    const LatencyStats& steady_state = result.steady_state;
+    for (const auto& [stat, ms] : {std::pair{"mean", steady_state.mean_ms},
+                                   std::pair{"p50", steady_state.p50_ms},
+                                   std::pair{"p90", steady_state.p90_ms},
+                                   std::pair{"min", steady_state.min_ms},
+                                   std::pair{"max", steady_state.max_ms}}) {
+      file << absl::StrFormat("%s,steady_state,%s,%.3f,,%d,\n", variant, stat,
+                              ms, cache_hit);
+    }
+  }
+  if (!file) {
+    return Unexpected(kLiteRtStatusErrorFileIO,
+                      absl::StrCat("Failed to write ", path));
+  }
+  return {};
+}
+
+}  // namespace litert::tools
@@ -0,0 +1,113 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef ODML_LITERT_LITERT_TOOLS_STARTUP_PHASES_H_
+#define ODML_LITERT_LITERT_TOOLS_STARTUP_PHASES_H_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/cc/litert_expected.h"
+#include "litert/tools/accelerator_parity.h"
+
+// Startup benchmarking: the time of each phase of the start of a model, from
+// the creation of the environment to its first run, next to the latency of the
+// runs that follow, so that a startup regression is tracked down to its phase.
+
+namespace litert::tools {
+
+// How the caches are set up before a startup.
+enum class StartupVariant {
+  // The compiler cache and the XNNPACK weight cache are emptied, so that the
+  // model is compiled and its weights are packed.
+  kCold,
+  // The caches hold the output of a previous startup.
+  kWarm,
+  // As kWarm, with the model and the caches evicted from the page cache, so
+  // that they are read from storage, as after a reboot.
+  kDroppedPageCache,
+};
+
+absl::string_view StartupVariantName(StartupVariant variant);
+
+// Parses the name returned by StartupVariantName().
+Expected<StartupVariant> ParseStartupVariant(absl::string_view name);
+
+struct StartupPhase {
+  std::string name;
+  double ms = 0.0;
+  // Major page faults of the process during the phase, i.e. the pages read
+  // from storage rather than found in the page cache.
+  int64_t major_faults = 0;
+  // The parts of the phase timed by the runtime, in milliseconds, e.g. the
+  // compilation within the creation of the compiled model.
+  std::vector<std::pair<std::string, double>> parts;
+};
+
+struct StartupResult {
+  StartupVariant variant = StartupVariant::kCold;
+  // Why the startup failed. Empty when it succeeded.
+  std::string error;
+  // In the order they ran, up to and including the first run.
+  std::vector<StartupPhase> phases;
+  // Whether the compilation was loaded from the compiler cache.
+  bool compiler_cache_hit = false;
+  // The runs after the first one.
+  LatencyStats steady_state;
+
+  bool Ran() const { return error.empty(); }
+
+  // The sum of the phases.
+  double StartupMs() const;
+};
+
+// Times consecutive phases, from the construction of the timer.
+class PhaseTimer {
+ public:
+  explicit PhaseTimer(std::vector<StartupPhase>& phases);
+
+  // Ends the phase that started at the end of the previous one, and returns
+  // it to add its parts.
+  StartupPhase& EndPhase(absl::string_view name);
+
+ private:
+  std::vector<StartupPhase>& phases_;
+  uint64_t start_us_;
+  int64_t start_major_faults_;
+};
+
+// The major page faults of the process so far, 0 when the platform does not
+// report them.
+int64_t MajorPageFaults();
+
+// Evicts the file at `path`, or the files of the directory at `path`, from
+// the page cache, after writing back their dirty pages. Only supported on
+// Linux and Android.
+Expected<void> EvictFromPageCache(absl::string_view path);
+
+// Logs a table with one row per phase of each startup.
+void LogStartupReport(absl::Span<const StartupResult> results);
+
+// Writes one CSV row per phase, and per part of a phase, of each startup to
+// `path`, followed by the steady state of the startup.
+Expected<void> WriteStartupCsv(absl::Span<const StartupResult> results,
+                               absl::string_view path);
+
+}  // namespace litert::tools
+
+#endif  // ODML_LITERT_LITERT_TOOLS_STARTUP_PHASES_H_
@@ -0,0 +1,116 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "litert/tools/startup_phases.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "litert/core/filesystem.h"
+#include "litert/test/common.h"
+#include "litert/test/matchers.h"
+
+namespace litert::tools {
+namespace {
+
+using ::testing::Each;
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::Ge;
+using ::testing::litert::IsError;
+
+TEST(StartupPhasesTest, ParsesVariantNames) {
+  for (StartupVariant variant :
+       {StartupVariant::kCold, StartupVariant::kWarm,
+        StartupVariant::kDroppedPageCache}) {
+    LITERT_ASSERT_OK_AND_ASSIGN(
+        StartupVariant parsed,
+        ParseStartupVariant(StartupVariantName(variant)));
+    EXPECT_EQ(parsed, variant);
+  }
+  EXPECT_THAT(ParseStartupVariant("lukewarm"), IsError());
+}
+
+TEST(StartupPhasesTest, TimesConsecutivePhases) {
+  std::vector<StartupPhase> phases;
+  PhaseTimer timer(phases);
+  timer.EndPhase("environment");
+  timer.EndPhase("model_load").parts.push_back({"mmap", 0.5});
+
+  EXPECT_THAT(phases, ElementsAre(Field(&StartupPhase::name, "environment"),
+                                  Field(&StartupPhase::name, "model_load")));
+  EXPECT_THAT(phases, Each(Field(&StartupPhase::ms, Ge(0.0))));
+  EXPECT_THAT(phases, Each(Field(&StartupPhase::major_faults, Ge(0))));
+  EXPECT_THAT(phases[1].parts, ElementsAre(std::pair<std::string, double>(
+                                   "mmap", 0.5)));
+
+  StartupResult result;
+  result.phases = {{.name = "environment", .ms = 1.5},
+                   {.name = "first_run", .ms = 2.0}};
+  EXPECT_DOUBLE_EQ(result.StartupMs(), 3.5);
+}
+
+TEST(StartupPhasesTest, EvictsFromPageCache) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto dir, testing::UniqueTestDirectory::Create());
+  const std::string path = internal::Join({dir.Str(), "model.tflite"});
+  std::ofstream(path) << "weights";
+
+#if defined(__linux__) || defined(__ANDROID__)
+  LITERT_EXPECT_OK(EvictFromPageCache(path));
+  LITERT_EXPECT_OK(EvictFromPageCache(dir.Str()));
+#endif
+  EXPECT_THAT(EvictFromPageCache(internal::Join({dir.Str(), "missing"})),
+              IsError());
+}
+
+TEST(StartupPhasesTest, WriteStartupCsv) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto dir, testing::UniqueTestDirectory::Create());
+  std::vector<StartupResult> results(2);
+  results[0].variant = StartupVariant::kWarm;
+  results[0].compiler_cache_hit = true;
+  results[0].phases = {{.name = "compiled_model",
+                        .ms = 10.0,
+                        .major_faults = 3,
+                        .parts = {{"compilation", 4.0}}}};
+  results[0].steady_state.p50_ms = 1.5;
+  results[1].variant = StartupVariant::kDroppedPageCache;
+  results[1].error = "Failed to evict, no permission";
+
+  const std::string path = internal::Join({dir.Str(), "startup.csv"});
+  LITERT_ASSERT_OK(WriteStartupCsv(results, path));
+
+  std::ifstream file(path);
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(file, line);) {
+    lines.push_back(line);
+  }
+  EXPECT_THAT(
+      lines,
+      ElementsAre("variant,phase,part,ms,major_faults,compiler_cache_hit,error",
+                  "warm,compiled_model,,10.000,3,1,",
+                  "warm,compiled_model,compilation,4.000,,1,",
+                  "warm,total,,10.000,,1,",
+                  "warm,steady_state,mean,0.000,,1,",
+                  "warm,steady_state,p50,1.500,,1,",
+                  "warm,steady_state,p90,0.000,,1,",
+                  "warm,steady_state,min,0.000,,1,",
+                  "warm,steady_state,max,0.000,,1,",
+                  "dropped_page_cache,,,,,,Failed to evict; no permission"));
+}
+
+}  // namespace
+}  // namespace litert::tools
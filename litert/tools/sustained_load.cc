@@ -0,0 +1,287 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "litert/tools/sustained_load.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"  // from @com_google_absl
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/str_join.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "litert/c/internal/litert_logging.h"
+#include "litert/c/litert_common.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/core/filesystem.h"
+
+namespace litert::benchmark {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Request {
+  double arrival_secs;
+  double start_secs;
+  double end_secs;
+  bool ok;
+};
+
+double SecondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Reads the first integer of a sysfs file.
+bool ReadInt64(const std::string& path, int64_t* value) {
+  std::ifstream file(path);
+  return static_cast<bool>(file >> *value);
+}
+
+// Nearest-rank percentiles of `values_ms`.
+LatencyPercentiles ComputePercentiles(std::vector<double> values_ms) {
+  LatencyPercentiles percentiles;
+  if (values_ms.empty()) {
+    return percentiles;
+  }
+  std::sort(values_ms.begin(), values_ms.end());
+  auto at = [&values_ms](double fraction) {
+    const size_t rank =
+        static_cast<size_t>(std::ceil(fraction * values_ms.size()));
+    return values_ms[std::max<size_t>(rank, 1) - 1];
+  };
+  percentiles.p50_ms = at(0.50);
+  percentiles.p90_ms = at(0.90);
+  percentiles.p99_ms = at(0.99);
+  percentiles.max_ms = values_ms.back();
+  return percentiles;
+}
+
+SustainedLoadWindow SummarizeWindow(double start_secs, double end_secs,
+                                    const std::vector<Request>& requests,
+                                    absl::string_view sysfs_root) {
+  SustainedLoadWindow window;
+  window.start_secs = start_secs;
+  window.end_secs = end_secs;
+  window.num_requests = static_cast<int>(requests.size());
+  std::vector<double> queueing_ms;
+  std::vector<double> service_ms;
+  std::vector<double> total_ms;
+  for (const Request& request : requests) {
+    if (!request.ok) {
+      ++window.num_failures;
+    }
+    queueing_ms.push_back((request.start_secs - request.arrival_secs) * 1e3);
+    service_ms.push_back((request.end_secs - request.start_secs) * 1e3);
+    total_ms.push_back((request.end_secs - request.arrival_secs) * 1e3);
+  }
+  window.queueing = ComputePercentiles(std::move(queueing_ms));
+  window.service = ComputePercentiles(std::move(service_ms));
+  window.total = ComputePercentiles(std::move(total_ms));
+  window.platform = SamplePlatform(sysfs_root);
+  return window;
+}
+
+std::string FormatPlatform(const PlatformSample& sample) {
+  std::string out;
+  if (!sample.cpu_freq_khz.empty()) {
+    const auto [min_khz, max_khz] = std::minmax_element(
+        sample.cpu_freq_khz.begin(), sample.cpu_freq_khz.end());
+    absl::StrAppendFormat(&out, "cpu %d-%d MHz", *min_khz / 1000,
+                          *max_khz / 1000);
+  }
+  if (!sample.temperatures_c.empty()) {
+    absl::StrAppendFormat(&out, "%smax %.1f C", out.empty() ? "" : ", ",
+                          *std::max_element(sample.temperatures_c.begin(),
+                                            sample.temperatures_c.end()));
+  }
+  return out.empty() ? "n/a" : out;
+}
+
+}  // namespace
+
+PlatformSample SamplePlatform(absl::string_view sysfs_root) {
+  PlatformSample sample;
+  const std::string cpu_dir =
+      internal::Join({sysfs_root, "devices/system/cpu"});
+  for (int cpu = 0;; ++cpu) {
+    const std::string dir = internal::Join({cpu_dir, absl::StrCat("cpu", cpu)});
+    if (!internal::IsDir(dir)) {
+      break;
+    }
+    int64_t freq_khz = 0;
+    // Offline CPUs have no cpufreq.
+    if (ReadInt64(internal::Join({dir, "cpufreq/scaling_cur_freq"}),
+                  &freq_khz)) {
+      sample.cpu_freq_khz.push_back(freq_khz);
+    }
+  }
+  const std::string thermal_dir = internal::Join({sysfs_root, "class/thermal"});
+  for (int zone = 0;; ++zone) {
+    const std::string dir =
+        internal::Join({thermal_dir, absl::StrCat("thermal_zone", zone)});
+    if (!internal::IsDir(dir)) {
+      break;
+    }
+    int64_t millidegrees = 0;
+    // Some zones fail to read while their sensor is powered down.
+    if (ReadInt64(internal::Join({dir, "temp"}), &millidegrees)) {
+      sample.temperatures_c.push_back(millidegrees / 1000.0);
+    }
+  }
+  return sample;
+}
+
+SustainedLoadReport RunSustainedLoad(const SustainedLoadOptions& options,
+                                     const std::function<bool()>& run_once) {
+  SustainedLoadReport report;
+  const double duration_secs = options.duration_secs;
+  const double window_secs =
+      options.window_secs > 0 ? options.window_secs : duration_secs;
+  const bool open_loop = options.target_qps > 0;
+
+  std::mt19937 rng(options.seed);
+  std::exponential_distribution<double> exponential(
+      open_loop ? options.target_qps : 1.0);
+  auto next_interval = [&]() {
+    return options.poisson_arrivals ? exponential(rng)
+                                    : 1.0 / options.target_qps;
+  };
+
+  std::vector<Request> window_requests;
+  double window_start = 0.0;
+  auto flush_window = [&](double end_secs) {
+    report.windows.push_back(SummarizeWindow(
+        window_start, end_secs, window_requests, options.sysfs_root));
+    window_requests.clear();
+    window_start = end_secs;
+  };
+
+  double next_arrival = 0.0;
+  const Clock::time_point start = Clock::now();
+  while (true) {
+    double arrival_secs = SecondsSince(start);
+    if (open_loop) {
+      arrival_secs = next_arrival;
+      if (arrival_secs >= duration_secs) {
+        break;
+      }
+      next_arrival += next_interval();
+      std::this_thread::sleep_until(
+          start + std::chrono::duration_cast<Clock::duration>(
+                      std::chrono::duration<double>(arrival_secs)));
+    }
+    const double now = SecondsSince(start);
+    if (now >= duration_secs) {
+      if (open_loop) {
+        // This request and the ones arriving until the end are still queued.
+        for (++report.num_dropped; next_arrival < duration_secs;
+             next_arrival += next_interval()) {
+          ++report.num_dropped;
+        }
+      }
+      break;
+    }
+    while (now >= window_start + window_secs) {
+      flush_window(window_start + window_secs);
+    }
+
+    Request request;
+    request.arrival_secs = arrival_secs;
+    request.start_secs = SecondsSince(start);
+    request.ok = run_once();
+    request.end_secs = SecondsSince(start);
+    if (!request.ok) {
+      ++report.num_failures;
+    }
+    report.service_times_us.push_back(static_cast<int64_t>(
+        (request.end_secs - request.start_secs) * 1e6));
+    window_requests.push_back(request);
+  }
+  while (window_start < duration_secs) {
+    flush_window(std::min(window_start + window_secs, duration_secs));
+  }
+  return report;
+}
+
+void LogSustainedLoadReport(const SustainedLoadReport& report) {
+  LITERT_LOG(LITERT_INFO, "\n========== SUSTAINED LOAD ==========");
+  LITERT_LOG(LITERT_INFO,
+             "Window (s)    Reqs  Fail     QPS | Queue p50/p99 ms | "
+             "Service p50/p90/p99 ms | Total p99 ms | Platform");
+  for (const SustainedLoadWindow& window : report.windows) {
+    const double length_secs = window.end_secs - window.start_secs;
+    LITERT_LOG(LITERT_INFO,
+               "%5.0f-%-5.0f %6d %5d %7.2f | %7.2f %7.2f  | %6.2f %6.2f %6.2f  "
+               "|  %10.2f  | %s",
+               window.start_secs, window.end_secs, window.num_requests,
+               window.num_failures,
+               length_secs > 0 ? window.num_requests / length_secs : 0.0,
+               window.queueing.p50_ms, window.queueing.p99_ms,
+               window.service.p50_ms, window.service.p90_ms,
+               window.service.p99_ms, window.total.p99_ms,
+               FormatPlatform(window.platform).c_str());
+  }
+  LITERT_LOG(LITERT_INFO, "Requests: %zu, failed: %d, dropped: %d",
+             report.service_times_us.size(), report.num_failures,
+             report.num_dropped);
+  LITERT_LOG(LITERT_INFO, "====================================\n");
+}
+
+Expected<void> WriteSustainedLoadCsv(const SustainedLoadReport& report,
+                                     absl::string_view path) {
+  std::ofstream file{std::string(path)};
+  if (!file) {
+    return Unexpected(kLiteRtStatusErrorFileIO,
+                      absl::StrCat("Failed to open ", path));
+  }
+  auto percentile_columns = [](absl::string_view name) {
+    return absl::StrFormat("%s_p50_ms,%s_p90_ms,%s_p99_ms,%s_max_ms", name,
+                           name, name, name);
+  };
+  auto percentile_values = [](const LatencyPercentiles& p) {
+    return absl::StrFormat("%.3f,%.3f,%.3f,%.3f", p.p50_ms, p.p90_ms, p.p99_ms,
+                           p.max_ms);
+  };
+  // Frequencies and temperatures hold one value per CPU and thermal zone.
+  file << "start_secs,end_secs,num_requests,num_failures,"
+       << percentile_columns("queueing") << ","
+       << percentile_columns("service") << "," << percentile_columns("total")
+       << ",cpu_freq_khz,temperatures_c\n";
+  for (const SustainedLoadWindow& window : report.windows) {
+    file << absl::StrFormat("%.3f,%.3f,%d,%d,", window.start_secs,
+                            window.end_secs, window.num_requests,
+                            window.num_failures)
+         << percentile_values(window.queueing) << ","
+         << percentile_values(window.service) << ","
+         << percentile_values(window.total) << ","
+         << absl::StrJoin(window.platform.cpu_freq_khz, " ") << ","
+         << absl::StrJoin(window.platform.temperatures_c, " ") << "\n";
+  }
+  if (!file) {
+    return Unexpected(kLiteRtStatusErrorFileIO,
+                      absl::StrCat("Failed to write ", path));
+  }
+  return {};
+}
+
+}  // namespace litert::benchmark
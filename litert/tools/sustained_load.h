@@ -0,0 +1,111 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef ODML_LITERT_LITERT_TOOLS_SUSTAINED_LOAD_H_
+#define ODML_LITERT_LITERT_TOOLS_SUSTAINED_LOAD_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "litert/cc/litert_expected.h"
+
+// Sustained-load benchmarking: drives a model at a given request rate for a
+// given duration, so that thermal throttling and DVFS effects show up in the
+// latencies, the way they do in production.
+
+namespace litert::benchmark {
+
+struct SustainedLoadOptions {
+  // How long to issue requests for.
+  double duration_secs = 0.0;
+  // Request rate. 0 issues the requests back to back (closed loop), so that
+  // there is no queueing.
+  double target_qps = 0.0;
+  // With a target_qps, draws the inter-arrival times from an exponential
+  // distribution (open loop with Poisson arrivals) instead of issuing the
+  // requests at a fixed interval.
+  bool poisson_arrivals = false;
+  uint32_t seed = 0;
+  // Length of the windows the latencies are reported over.
+  double window_secs = 10.0;
+  // Where the cpufreq and thermal zones are read from.
+  std::string sysfs_root = "/sys";
+};
+
+struct LatencyPercentiles {
+  double p50_ms = 0.0;
+  double p90_ms = 0.0;
+  double p99_ms = 0.0;
+  double max_ms = 0.0;
+};
+
+// CPU frequencies and temperatures at one point in time. Empty when the
+// platform does not expose them.
+struct PlatformSample {
+  // Current frequency of each CPU with cpufreq, in kHz.
+  std::vector<int64_t> cpu_freq_khz;
+  // Temperature of each thermal zone, in degrees Celsius.
+  std::vector<double> temperatures_c;
+};
+
+struct SustainedLoadWindow {
+  // Offsets of the window from the start of the run.
+  double start_secs = 0.0;
+  double end_secs = 0.0;
+  // Requests whose service started in the window.
+  int num_requests = 0;
+  int num_failures = 0;
+  // Time between the arrival of a request and the start of its service,
+  // spent waiting for the previous requests.
+  LatencyPercentiles queueing;
+  // Time spent running the request.
+  LatencyPercentiles service;
+  // Queueing plus service, as seen by the client.
+  LatencyPercentiles total;
+  // Taken at the end of the window.
+  PlatformSample platform;
+};
+
+struct SustainedLoadReport {
+  std::vector<SustainedLoadWindow> windows;
+  // Service time of every request, in microseconds.
+  std::vector<int64_t> service_times_us;
+  int num_failures = 0;
+  // Requests that arrived before the end of the run but were still queued,
+  // because the model could not keep up with the target_qps.
+  int num_dropped = 0;
+};
+
+// Reads the current CPU frequencies and thermal zone temperatures under
+// `sysfs_root`.
+PlatformSample SamplePlatform(absl::string_view sysfs_root);
+
+// Calls `run_once` following `options` and reports the latencies per window.
+// `run_once` returns false when the request failed.
+SustainedLoadReport RunSustainedLoad(const SustainedLoadOptions& options,
+                                     const std::function<bool()>& run_once);
+
+// Logs a table with one row per window.
+void LogSustainedLoadReport(const SustainedLoadReport& report);
+
+// Writes one CSV row per window to `path`.
+Expected<void> WriteSustainedLoadCsv(const SustainedLoadReport& report,
+                                     absl::string_view path);
+
+}  // namespace litert::benchmark
+
+#endif  // ODML_LITERT_LITERT_TOOLS_SUSTAINED_LOAD_H_
@@ -0,0 +1,165 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "litert/tools/sustained_load.h"
+
+#include <chrono>  // NOLINT
+#include <fstream>
+#include <string>
+#include <thread>  // NOLINT
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "litert/core/filesystem.h"
+#include "litert/test/common.h"
+#include "litert/test/matchers.h"
+
+namespace litert::benchmark {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Gt;
+using ::testing::HasSubstr;
+using ::testing::SizeIs;
+
+bool SleepFor(int ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+  return true;
+}
+
+void WriteFile(const std::string& path, const std::string& contents) {
+  std::ofstream file(path);
+  file << contents;
+}
+
+TEST(SustainedLoadTest, ClosedLoopHasNoQueueing) {
+  SustainedLoadOptions options;
+  options.duration_secs = 0.2;
+  options.window_secs = 0.1;
+  auto report = RunSustainedLoad(options, [] { return SleepFor(5); });
+
+  ASSERT_THAT(report.windows, SizeIs(2));
+  EXPECT_THAT(report.service_times_us, SizeIs(Gt(10)));
+  EXPECT_EQ(report.num_failures, 0);
+  EXPECT_EQ(report.num_dropped, 0);
+  for (const auto& window : report.windows) {
+    EXPECT_GT(window.num_requests, 0);
+    EXPECT_GE(window.service.p50_ms, 5.0);
+    EXPECT_LT(window.queueing.p99_ms, 1.0);
+  }
+}
+
+TEST(SustainedLoadTest, OpenLoopFollowsTargetQps) {
+  SustainedLoadOptions options;
+  options.duration_secs = 0.5;
+  options.target_qps = 32;
+  auto report = RunSustainedLoad(options, [] { return SleepFor(1); });
+
+  // Arrivals every 31.25 ms, from 0 to 468.75 ms.
+  EXPECT_THAT(report.service_times_us, SizeIs(16));
+  EXPECT_EQ(report.num_dropped, 0);
+  ASSERT_THAT(report.windows, SizeIs(1));
+  EXPECT_DOUBLE_EQ(report.windows[0].end_secs, 0.5);
+}
+
+TEST(SustainedLoadTest, PoissonArrivalsAreDeterministicPerSeed) {
+  SustainedLoadOptions options;
+  options.duration_secs = 0.3;
+  options.target_qps = 50;
+  options.poisson_arrivals = true;
+  options.seed = 42;
+  auto first = RunSustainedLoad(options, [] { return true; });
+  auto second = RunSustainedLoad(options, [] { return true; });
+
+  EXPECT_EQ(first.service_times_us.size(), second.service_times_us.size());
+  EXPECT_EQ(first.num_dropped, 0);
+}
+
+TEST(SustainedLoadTest, OverloadQueuesAndDropsRequests) {
+  SustainedLoadOptions options;
+  options.duration_secs = 0.2;
+  options.target_qps = 200;
+  auto report = RunSustainedLoad(options, [] { return SleepFor(10); });
+
+  EXPECT_GT(report.num_dropped, 0);
+  ASSERT_THAT(report.windows, SizeIs(1));
+  // Each request waits for the previous ones.
+  EXPECT_GT(report.windows[0].queueing.p90_ms, 10.0);
+  EXPECT_GT(report.windows[0].total.p90_ms, report.windows[0].service.p90_ms);
+}
+
+TEST(SustainedLoadTest, CountsFailures) {
+  SustainedLoadOptions options;
+  options.duration_secs = 0.05;
+  auto report = RunSustainedLoad(options, [] {
+    SleepFor(1);
+    return false;
+  });
+
+  EXPECT_EQ(report.num_failures,
+            static_cast<int>(report.service_times_us.size()));
+  EXPECT_EQ(report.windows[0].num_failures, report.windows[0].num_requests);
+}
+
+TEST(SustainedLoadTest, SamplePlatformReadsSysfs) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto dir, testing::UniqueTestDirectory::Create());
+  const std::string root(dir.Str());
+  for (const char* path :
+       {"devices", "devices/system", "devices/system/cpu",
+        "devices/system/cpu/cpu0", "devices/system/cpu/cpu0/cpufreq",
+        "devices/system/cpu/cpu1", "class", "class/thermal",
+        "class/thermal/thermal_zone0", "class/thermal/thermal_zone1"}) {
+    LITERT_ASSERT_OK(internal::MkDir(internal::Join({root, path})));
+  }
+  WriteFile(internal::Join({root, "devices/system/cpu/cpu0/cpufreq/"
+                                  "scaling_cur_freq"}),
+            "1804800\n");
+  WriteFile(internal::Join({root, "class/thermal/thermal_zone0/temp"}),
+            "41500\n");
+  WriteFile(internal::Join({root, "class/thermal/thermal_zone1/temp"}),
+            "52000\n");
+
+  // cpu1 is offline and has no cpufreq.
+  auto sample = SamplePlatform(root);
+  EXPECT_THAT(sample.cpu_freq_khz, ElementsAre(1804800));
+  EXPECT_THAT(sample.temperatures_c, ElementsAre(41.5, 52.0));
+}
+
+TEST(SustainedLoadTest, WriteSustainedLoadCsv) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto dir, testing::UniqueTestDirectory::Create());
+  SustainedLoadReport report;
+  SustainedLoadWindow window;
+  window.end_secs = 10.0;
+  window.num_requests = 3;
+  window.service.p50_ms = 1.5;
+  window.platform.cpu_freq_khz = {1000, 2000};
+  report.windows.push_back(window);
+
+  const std::string path = internal::Join({dir.Str(), "sustained.csv"});
+  LITERT_ASSERT_OK(WriteSustainedLoadCsv(report, path));
+
+  std::ifstream file(path);
+  std::string header;
+  std::string row;
+  std::getline(file, header);
+  std::getline(file, row);
+  EXPECT_THAT(header, HasSubstr("service_p50_ms"));
+  EXPECT_THAT(row, HasSubstr("0.000,10.000,3,0,"));
+  EXPECT_THAT(row, HasSubstr("1.500"));
+  EXPECT_THAT(row, HasSubstr(",1000 2000,"));
+}
+
+}  // namespace
+}  // namespace litert::benchmark
@@ -42,6 +42,10 @@ typedef enum LiteRtDispatchCapabilities {
   kLiteRtDispatchCapabilitiesBasic = 1,  // The vendor supports the Basic API
   kLiteRtDispatchCapabilitiesAsync = 2,  // The vendor supports the Async API
   kLiteRtDispatchCapabilitiesGraph = 4,  // The vendor supports the Graph API
+  kLiteRtDispatchCapabilitiesBatch = 8,  // The vendor supports the Batch API
+  // Invocation contexts created on a device context from the same bytecode
+  // share a single device-resident copy of its weights.
+  kLiteRtDispatchCapabilitiesSharedWeights = 16,
 } LiteRtDispatchCapabilities;
 
 // Types of executable that can run on the HW accelerators.
@@ -205,6 +209,38 @@ LITERT_CAPI_EXPORT LiteRtStatus
 LiteRtDispatchInvokeAsync(LiteRtDispatchInvocationContext invocation_context,
                           int num_output_events, LiteRtEvent* output_events);
 
+// /////////////////////////////////////////////////////////////////////////////
+// Batched Execution API
+// /////////////////////////////////////////////////////////////////////////////
+
+// The tensor buffers bound to the I/Os of an invocation context for one
+// invocation of a batch. `inputs` and `outputs` are indexed by graph
+// input/output index.
+typedef struct LiteRtDispatchInvocationBuffers {
+  int num_inputs;
+  const LiteRtTensorBufferHandle* inputs;
+  int num_outputs;
+  const LiteRtTensorBufferHandle* outputs;
+} LiteRtDispatchInvocationBuffers;
+
+// Run `num_invocations` invocations of an invocation context in a single call,
+// each one with its own set of registered tensor buffers, in order. This
+// amortizes the per-invocation overhead of the vendor driver over the batch,
+// e.g. for a batch-1 model run once per token or per crop.
+//
+// If `completion_event` is not null, the function may return before the
+// invocations complete and returns a newly created LiteRtEvent that is
+// signaled once all of them are done. The caller takes ownership of the
+// returned LiteRtEvent. Otherwise the function returns once all the
+// invocations are done.
+//
+// After the call, the I/Os of the invocation context remain attached to the
+// tensor buffers of the last invocation.
+LITERT_CAPI_EXPORT LiteRtStatus LiteRtDispatchInvokeBatch(
+    LiteRtDispatchInvocationContext invocation_context, int num_invocations,
+    const LiteRtDispatchInvocationBuffers* invocations,
+    LiteRtEvent* completion_event);
+
 // /////////////////////////////////////////////////////////////////////////////
 // Graph Execution API
 // /////////////////////////////////////////////////////////////////////////////
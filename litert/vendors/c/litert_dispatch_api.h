@@ -230,12 +230,25 @@ typedef struct LiteRtDispatchGraphInterface {
 
 // /////////////////////////////////////////////////////////////////////////////
 
+typedef LiteRtStatus (*LiteRtDispatchInvokeBatchT)(
+    LiteRtDispatchInvocationContext invocation_context, int num_invocations,
+    const LiteRtDispatchInvocationBuffers* invocations,
+    LiteRtEvent* completion_event);
+
+typedef struct LiteRtDispatchBatchInterface {
+  LiteRtDispatchInvokeBatchT invoke_batch;
+} LiteRtDispatchBatchInterface;
+
+// /////////////////////////////////////////////////////////////////////////////
+
 // FIXME See Vulkan and OpenCL extensions.
 typedef struct LiteRtDispatchApi {
   LiteRtApiVersion version;
   LiteRtDispatchInterface* interface;
   LiteRtDispatchAsyncInterface* async_interface;
   LiteRtDispatchGraphInterface* graph_interface;
+  // Optional, may be left null by vendors that don't support batching.
+  LiteRtDispatchBatchInterface* batch_interface;
 } LiteRtDispatchApi;
 
 LITERT_CAPI_EXPORT LiteRtStatus LiteRtDispatchGetApi(LiteRtDispatchApi* api);
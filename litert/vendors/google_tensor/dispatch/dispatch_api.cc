@@ -34,6 +34,7 @@
 #include "litert/cc/litert_environment_options.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/options/darwinn_options.h"
+#include "litert/core/util/perfetto_profiling.h"
 #include "litert/vendors/c/litert_dispatch.h"
 #include "litert/vendors/c/litert_dispatch_api.h"
 #include "litert/vendors/cc/options_helper.h"
@@ -76,6 +77,8 @@ std::optional<std::string> GetSharedLibraryDir(
 
 LiteRtStatus Initialize(LiteRtEnvironmentOptions environment_options,
                         LiteRtOptions options) {
+  // The dispatch library records its own track events.
+  litert::internal::InitializePerfetto();
   TheEnvironmntOptions = environment_options;
   TheOptions = options;
 
@@ -144,7 +147,8 @@ LiteRtStatus GetBuildId(const char** build_id) {
 LiteRtStatus GetCapabilities(int* capabilities) {
   *capabilities = kLiteRtDispatchCapabilitiesBasic |
                   kLiteRtDispatchCapabilitiesAsync |
-                  kLiteRtDispatchCapabilitiesGraph;
+                  kLiteRtDispatchCapabilitiesGraph |
+                  kLiteRtDispatchCapabilitiesSharedWeights;
   return kLiteRtStatusOk;
 }
 
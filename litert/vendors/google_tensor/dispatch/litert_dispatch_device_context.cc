@@ -14,6 +14,7 @@
 
 #include "litert/vendors/google_tensor/dispatch/litert_dispatch_device_context.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <string>
@@ -340,6 +341,15 @@ litert::Expected<void> LiteRtDispatchDeviceContextT::DestroyGraph(
 litert::Expected<LiteRtDispatchExecutableHandle>
 LiteRtDispatchDeviceContextT::LoadExecutable(
     LiteRtDispatchExecutableType type, const LiteRtMemBuffer* bytecode_buffer) {
+  const ExecutableKey key(type, bytecode_buffer->fd,
+                          bytecode_buffer->base_addr, bytecode_buffer->offset,
+                          bytecode_buffer->size);
+  if (auto iter = loaded_executables_.find(key);
+      iter != loaded_executables_.end()) {
+    ++iter->second.ref_count;
+    return iter->second.exec_handle;
+  }
+
   auto thr_load_sq_container = southbound_.api().thr_load_sq_container;
   if (!thr_load_sq_container) {
     return Error(kLiteRtStatusErrorRuntimeFailure,
@@ -385,11 +395,23 @@ LiteRtDispatchDeviceContextT::LoadExecutable(
                  "thr_load_sq_container failed");
   }
 
+  loaded_executables_[key] = {sq_handle, /*ref_count=*/1};
   return sq_handle;
 }
 
 litert::Expected<void> LiteRtDispatchDeviceContextT::UnloadExecutable(
     LiteRtDispatchExecutableHandle exec_handle) {
+  auto iter = std::find_if(loaded_executables_.begin(),
+                           loaded_executables_.end(), [&](const auto& entry) {
+                             return entry.second.exec_handle == exec_handle;
+                           });
+  if (iter != loaded_executables_.end()) {
+    if (--iter->second.ref_count > 0) {
+      return {};
+    }
+    loaded_executables_.erase(iter);
+  }
+
   auto thr_unload_sq_container = southbound_.api().thr_unload_sq_container;
   if (!thr_unload_sq_container) {
     return Error(kLiteRtStatusErrorRuntimeFailure,
@@ -15,10 +15,13 @@
 #ifndef ODML_LITERT_LITERT_VENDORS_GOOGLE_TENSOR_DISPATCH_LITERT_DISPATCH_DEVICE_CONTEXT_H_
 #define ODML_LITERT_LITERT_VENDORS_GOOGLE_TENSOR_DISPATCH_LITERT_DISPATCH_DEVICE_CONTEXT_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <tuple>
 
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
 #include "absl/container/flat_hash_set.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/cc/litert_expected.h"
@@ -49,10 +52,16 @@ class LiteRtDispatchDeviceContextT {
   litert::Expected<LiteRtDispatchGraph> CreateGraph();
   litert::Expected<void> DestroyGraph(LiteRtDispatchGraph graph);
 
+  // Loads the executable in `bytecode_buffer`. Executables loaded more than
+  // once from the same buffer, e.g. by the invocation contexts of the
+  // different signatures of a model, share a single SQ container and thus a
+  // single device-resident copy of their weights.
   litert::Expected<LiteRtDispatchExecutableHandle> LoadExecutable(
       LiteRtDispatchExecutableType type,
       const LiteRtMemBuffer* bytecode_buffer);
 
+  // Releases one reference to the given executable, and unloads it when it
+  // was the last one.
   litert::Expected<void> UnloadExecutable(
       LiteRtDispatchExecutableHandle exec_handle);
 
@@ -73,10 +82,21 @@ class LiteRtDispatchDeviceContextT {
     bool prefer_coherent = false;
   };
 
+  // Identifies the bytecode buffer an executable was loaded from, as its type
+  // and the fd, base address, offset and size of the buffer.
+  using ExecutableKey = std::tuple<LiteRtDispatchExecutableType, int,
+                                   const void*, size_t, size_t>;
+
+  struct LoadedExecutable {
+    LiteRtDispatchExecutableHandle exec_handle;
+    int ref_count;
+  };
+
   const litert::google_tensor::Southbound& southbound_;
   ThrContext* thr_context_ = nullptr;
   absl::flat_hash_set<ThrGraph*> thr_graphs_;
   std::optional<DarwinnOptionsData> darwinn_options_;
+  absl::flat_hash_map<ExecutableKey, LoadedExecutable> loaded_executables_;
 };
 
 #endif  // ODML_LITERT_LITERT_VENDORS_GOOGLE_TENSOR_DISPATCH_LITERT_DISPATCH_DEVICE_CONTEXT_H_
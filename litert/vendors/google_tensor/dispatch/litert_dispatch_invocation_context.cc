@@ -24,6 +24,7 @@
 #include "litert/c/litert_tensor_buffer.h"
 #include "litert/c/litert_tensor_buffer_requirements.h"
 #include "litert/cc/litert_expected.h"
+#include "litert/core/util/perfetto_profiling.h"
 #include "litert/core/util/tensor_type_util.h"
 #include "litert/vendors/c/litert_dispatch.h"
 #include "litert/vendors/google_tensor/dispatch/litert_dispatch_device_context.h"
@@ -42,6 +43,9 @@ namespace {
 
 constexpr const size_t kEdgeTpuPadding = 64;
 
+// The Perfetto track of the work executed by the TPU.
+constexpr char kDeviceTrackName[] = "Google Tensor TPU";
+
 template <class X, class Align>
 inline constexpr auto Pad(X x, Align align) {
   return ((x + align - 1) / align) * align;
@@ -419,6 +423,9 @@ litert::Expected<void> LiteRtDispatchInvocationContextT::Invoke() {
       !result) {
     return result.Error();
   }
+  LITERT_PERFETTO_TRACE_DEVICE_EVENT(
+      kDeviceTrackName, litert::internal::GetPerfettoFlowId(this),
+      "LiteRT::Dispatch[execute]", litert::internal::GetPerfettoFlowId(this));
   if (auto result = InvokeOnce(southbound_, this); !result) {
     return result.Error();
   }
@@ -528,8 +535,16 @@ litert::Expected<void> LiteRtDispatchInvocationContextT::InvokeAsync(
     return status.Error();
   }
 
-  if (auto status = InvokeOnce(southbound_, this); !status) {
-    return status.Error();
+  {
+    // The completion is only known to the output fences, so the device track
+    // shows when the work is enqueued.
+    LITERT_PERFETTO_TRACE_DEVICE_EVENT(
+        kDeviceTrackName, litert::internal::GetPerfettoFlowId(this),
+        "LiteRT::Dispatch[enqueue]",
+        litert::internal::GetPerfettoFlowId(this));
+    if (auto status = InvokeOnce(southbound_, this); !status) {
+      return status.Error();
+    }
   }
 
   // Deatach input fences.
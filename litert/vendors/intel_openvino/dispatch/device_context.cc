@@ -40,8 +40,12 @@
 #include "litert/vendors/intel_openvino/utils.h"
 
 litert::Expected<LiteRtDispatchDeviceContextT::Ptr>
-LiteRtDispatchDeviceContextT::Create() {
-  return Ptr(new LiteRtDispatchDeviceContextT());
+LiteRtDispatchDeviceContextT::Create(int num_infer_requests) {
+  if (num_infer_requests < 0) {
+    return litert::Unexpected(kLiteRtStatusErrorInvalidArgument,
+                              "Invalid number of inference requests");
+  }
+  return Ptr(new LiteRtDispatchDeviceContextT(num_infer_requests));
 }
 
 #if LITERT_HAS_AHWB_SUPPORT
@@ -39,7 +39,9 @@ class LiteRtDispatchDeviceContextT {
   using Ptr = std::unique_ptr<LiteRtDispatchDeviceContextT>;
 
   ~LiteRtDispatchDeviceContextT() = default;
-  static litert::Expected<Ptr> Create();
+  // `num_infer_requests` is the number of inference requests each invocation
+  // context keeps, or 0 to use the optimal number of the compiled model.
+  static litert::Expected<Ptr> Create(int num_infer_requests = 0);
   litert::Expected<LiteRtTensorBufferHandle> RegisterTensorBuffer(
       LiteRtTensorBuffer tensor_buffer);
 
@@ -64,10 +66,15 @@ class LiteRtDispatchDeviceContextT {
   // Return the core shared_pointer.
   std::shared_ptr<ov::Core> getCore() const { return core_; }
 
+  int getNumInferRequests() const { return num_infer_requests_; }
+
  private:
-  explicit LiteRtDispatchDeviceContextT()
-      : core_(std::make_shared<ov::Core>()), next_handle_(0) {}
+  explicit LiteRtDispatchDeviceContextT(int num_infer_requests)
+      : core_(std::make_shared<ov::Core>()),
+        num_infer_requests_(num_infer_requests),
+        next_handle_(0) {}
   std::shared_ptr<ov::Core> core_;
+  int num_infer_requests_;
 #if defined(LITERT_WINDOWS_OS)
   std::unordered_map<LiteRtTensorBufferHandle,
                      ov::intel_npu::level_zero::ZeroBufferTensor>
@@ -19,30 +19,51 @@
 #include "openvino/runtime/core.hpp"
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
+#include "litert/c/litert_event.h"
 #include "litert/c/litert_model.h"
 #include "litert/c/litert_tensor_buffer.h"
 #include "litert/c/litert_tensor_buffer_requirements.h"
 #include "litert/cc/litert_environment_options.h"
 #include "litert/cc/litert_expected.h"
+#include "litert/cc/options/litert_intel_openvino_options.h"
+#include "litert/core/util/perfetto_profiling.h"
 #include "litert/vendors/c/litert_dispatch.h"
 #include "litert/vendors/c/litert_dispatch_api.h"
+#include "litert/vendors/cc/options_helper.h"
 #include "litert/vendors/intel_openvino/dispatch/device_context.h"
 #include "litert/vendors/intel_openvino/dispatch/invocation_context.h"
 
 namespace litert {
 namespace openvino {
 
+namespace {
+
+// Number of inference requests per invocation context, 0 for the optimal
+// number of the compiled model.
+int static_num_infer_requests = 0;
+
+}  // namespace
+
 // Initialize the Dispatch API runtime.
 // This function should be called before calling any other Dispatch API
 // functions.
 LiteRtStatus DispatchInitialize(LiteRtEnvironmentOptions environment_options,
                                 LiteRtOptions options) {
+  // The dispatch library records its own track events.
+  litert::internal::InitializePerfetto();
   ov::Core core;
   std::vector<std::string> availableDevices = core.get_available_devices();
   for (auto&& device : availableDevices)
     LITERT_LOG(LITERT_INFO, "[Openvino]Found device plugin for: %s",
                device.c_str());
 
+  auto [env, opts, opq_opts, intel_openvino_opts] =
+      litert::ParseOptions<litert::intel_openvino::IntelOpenVinoOptions>(
+          environment_options, options);
+  if (intel_openvino_opts) {
+    static_num_infer_requests = intel_openvino_opts->GetNumInferRequests();
+  }
+
   return kLiteRtStatusOk;
 }
 
@@ -65,8 +86,8 @@ LiteRtStatus DispatchGetBuildId(const char** build_id) {
 // Return the capabilities supported by the Dispatch API runtime as a set of the
 // values specified in LiteRtDispatchCapabilities.
 LiteRtStatus DispatchGetCapabilities(int* capabilities) {
-  // TODO: add support for async later
-  *capabilities = kLiteRtDispatchCapabilitiesBasic;
+  *capabilities =
+      kLiteRtDispatchCapabilitiesBasic | kLiteRtDispatchCapabilitiesAsync;
   return kLiteRtStatusOk;
 }
 
@@ -78,7 +99,9 @@ LiteRtStatus DispatchGetCapabilities(int* capabilities) {
 LiteRtStatus DispatchDeviceContextCreate(
     LiteRtDispatchDeviceContext* device_context) {
   try {
-    if (auto context = LiteRtDispatchDeviceContextT::Create(); context) {
+    if (auto context =
+            LiteRtDispatchDeviceContextT::Create(static_num_infer_requests);
+        context) {
       *device_context = context->release();
       return kLiteRtStatusOk;
     } else {
@@ -302,6 +325,38 @@ LiteRtStatus DispatchInvoke(
   }
 }
 
+LiteRtStatus DispatchAttachInputEvent(
+    LiteRtDispatchInvocationContext invocation_context, int graph_input_index,
+    LiteRtEvent input_event) {
+  if (auto status =
+          invocation_context->AttachInputEvent(graph_input_index, input_event);
+      !status) {
+    LITERT_LOG(LITERT_ERROR, "Failed to attach input event: %s",
+               status.Error().Message().c_str());
+    return status.Error().Status();
+  }
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus DispatchInvokeAsync(
+    LiteRtDispatchInvocationContext invocation_context, int num_output_events,
+    LiteRtEvent* output_events) {
+  try {
+    if (auto status =
+            invocation_context->InvokeAsync(num_output_events, output_events);
+        !status) {
+      LITERT_LOG(LITERT_ERROR, "Failed to invoke context asynchronously: %s",
+                 status.Error().Message().c_str());
+      return status.Error().Status();
+    }
+    return kLiteRtStatusOk;
+  } catch (const std::exception& e) {
+    LITERT_LOG(LITERT_ERROR, "Exception in Dispatch invoke_async: %s",
+               e.what());
+    return kLiteRtStatusErrorRuntimeFailure;
+  }
+}
+
 }  // namespace openvino
 }  // namespace litert
 
@@ -330,12 +385,17 @@ LiteRtDispatchInterface TheInterface = {
     .invoke = litert::openvino::DispatchInvoke,
 };
 
+LiteRtDispatchAsyncInterface TheAsyncInterface = {
+    .attach_input_event = litert::openvino::DispatchAttachInputEvent,
+    .invoke_async = litert::openvino::DispatchInvokeAsync,
+};
+
 LiteRtDispatchApi TheApi = {
     .version = {.major = LITERT_API_VERSION_MAJOR,
                 .minor = LITERT_API_VERSION_MINOR,
                 .patch = LITERT_API_VERSION_PATCH},
     .interface = &TheInterface,
-    .async_interface = nullptr,
+    .async_interface = &TheAsyncInterface,
     .graph_interface = nullptr,
 };
 
@@ -15,20 +15,42 @@
 
 #include "litert/vendors/intel_openvino/dispatch/invocation_context.h"
 
+#include <algorithm>
 #include <chrono>  // NOLINT
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "absl/cleanup/cleanup.h"  // from @com_google_absl
+#include "openvino/runtime/compiled_model.hpp"
+#include "openvino/runtime/properties.hpp"
 #include "openvino/runtime/tensor.hpp"
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
+#include "litert/c/litert_event.h"
+#include "litert/c/litert_event_type.h"
 #include "litert/c/litert_model.h"
 #include "litert/c/litert_tensor_buffer.h"
 #include "litert/c/litert_tensor_buffer_requirements.h"
 #include "litert/c/litert_tensor_buffer_types.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
+#include "litert/core/util/perfetto_profiling.h"
 #include "litert/core/util/tensor_type_util.h"
 #include "litert/vendors/c/litert_dispatch.h"
 
+namespace {
+
+// The Perfetto track of the work executed by the NPU.
+constexpr char kDeviceTrackName[] = "Intel NPU";
+
+}  // namespace
+
 litert::Expected<LiteRtDispatchInvocationContextT::Ptr>
 LiteRtDispatchInvocationContextT::Create(
     LiteRtDispatchDeviceContextT& device_context,
@@ -53,11 +75,52 @@ LiteRtDispatchInvocationContextT::Create(
                          "Failed to get OpenVINO core from device context");
   }
   ov::CompiledModel compiled_model = core->import_model(model_stream, "NPU");
-  auto infer_request = compiled_model.create_infer_request();
-  LITERT_LOG(LITERT_INFO, "Openvino InvocationContext Initialize SUCCESS");
+
+  int num_infer_requests = device_context.getNumInferRequests();
+  if (num_infer_requests == 0) {
+    try {
+      num_infer_requests = static_cast<int>(
+          compiled_model.get_property(ov::optimal_number_of_infer_requests));
+    } catch (const std::exception& e) {
+      LITERT_LOG(LITERT_WARNING,
+                 "Failed to get the optimal number of inference requests: %s",
+                 e.what());
+    }
+    num_infer_requests = std::max(num_infer_requests, 1);
+  }
+  LITERT_LOG(LITERT_INFO,
+             "Openvino InvocationContext Initialize SUCCESS with %d inference "
+             "requests",
+             num_infer_requests);
   // TODO: add support for loading cached model
-  return Ptr(new LiteRtDispatchInvocationContextT(infer_request, device_context,
-                                                  num_inputs, num_outputs));
+  return Ptr(new LiteRtDispatchInvocationContextT(
+      std::move(compiled_model), device_context, num_inputs, num_outputs,
+      num_infer_requests));
+}
+
+LiteRtDispatchInvocationContextT::LiteRtDispatchInvocationContextT(
+    ov::CompiledModel compiled_model,
+    LiteRtDispatchDeviceContextT& device_context, int num_inputs,
+    int num_outputs, int num_infer_requests)
+    : device_context_(device_context),
+      compiled_model_(std::move(compiled_model)),
+      inputs_(num_inputs),
+      outputs_(num_outputs),
+      input_events_(num_inputs, nullptr) {
+  requests_.reserve(num_infer_requests);
+  for (int i = 0; i < num_infer_requests; ++i) {
+    requests_.push_back(std::make_unique<Request>(
+        compiled_model_.create_infer_request(), num_inputs, num_outputs));
+  }
+}
+
+LiteRtDispatchInvocationContextT::~LiteRtDispatchInvocationContextT() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  request_released_.wait(lock, [this] {
+    return std::none_of(
+        requests_.begin(), requests_.end(),
+        [](const std::unique_ptr<Request>& request) { return request->busy; });
+  });
 }
 
 litert::Expected<LiteRtTensorBufferRequirements>
@@ -108,40 +171,183 @@ LiteRtDispatchInvocationContextT::GetOutputRequirements(
 
 litert::Expected<void> LiteRtDispatchInvocationContextT::AttachInput(
     int graph_input_index, LiteRtTensorBufferHandle tensor_buffer_handle) {
-#if defined(LITERT_WINDOWS_OS)
-  LITERT_ASSIGN_OR_RETURN(ov::intel_npu::level_zero::ZeroBufferTensor ov_tensor,
-                          device_context_.getOvTensor(tensor_buffer_handle));
-#else
-  LITERT_ASSIGN_OR_RETURN(ov::Tensor ov_tensor,
-                          device_context_.getOvTensor(tensor_buffer_handle));
-#endif
+  if (graph_input_index < 0 ||
+      graph_input_index >= static_cast<int>(inputs_.size())) {
+    return litert::Unexpected(kLiteRtStatusErrorIndexOOB,
+                              "Invalid graph input index");
+  }
   // TODO: visit this if need to maintain graph indices for inputs and outputs
   // in dispatch_api
-  infer_request_.set_input_tensor(graph_input_index, ov_tensor);
+  LITERT_RETURN_IF_ERROR(device_context_.getOvTensor(tensor_buffer_handle));
+  inputs_[graph_input_index] = tensor_buffer_handle;
   return {};
 }
 
 litert::Expected<void> LiteRtDispatchInvocationContextT::AttachOutput(
     int graph_output_index, LiteRtTensorBufferHandle tensor_buffer_handle) {
-#if defined(LITERT_WINDOWS_OS)
-  LITERT_ASSIGN_OR_RETURN(ov::intel_npu::level_zero::ZeroBufferTensor ov_tensor,
-                          device_context_.getOvTensor(tensor_buffer_handle));
-#else
-  LITERT_ASSIGN_OR_RETURN(ov::Tensor ov_tensor,
-                          device_context_.getOvTensor(tensor_buffer_handle));
-#endif
-  // TODO: visit this if need to maintain graph indices for inputs and outputs
-  // in dispatch_api
-  infer_request_.set_output_tensor(graph_output_index, ov_tensor);
+  if (graph_output_index < 0 ||
+      graph_output_index >= static_cast<int>(outputs_.size())) {
+    return litert::Unexpected(kLiteRtStatusErrorIndexOOB,
+                              "Invalid graph output index");
+  }
+  LITERT_RETURN_IF_ERROR(device_context_.getOvTensor(tensor_buffer_handle));
+  outputs_[graph_output_index] = tensor_buffer_handle;
+  return {};
+}
+
+litert::Expected<void> LiteRtDispatchInvocationContextT::AttachInputEvent(
+    int graph_input_index, LiteRtEvent input_event) {
+  if (graph_input_index < 0 ||
+      graph_input_index >= static_cast<int>(input_events_.size())) {
+    return litert::Unexpected(kLiteRtStatusErrorIndexOOB,
+                              "Invalid graph input index");
+  }
+  input_events_[graph_input_index] = input_event;
+  return {};
+}
+
+LiteRtDispatchInvocationContextT::Request&
+LiteRtDispatchInvocationContextT::AcquireRequest() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  Request* idle_request = nullptr;
+  request_released_.wait(lock, [this, &idle_request] {
+    for (auto& request : requests_) {
+      if (!request->busy) {
+        idle_request = request.get();
+        return true;
+      }
+    }
+    return false;
+  });
+  idle_request->busy = true;
+  return *idle_request;
+}
+
+void LiteRtDispatchInvocationContextT::ReleaseRequest(Request& request) {
+  // Notify while holding the lock: the context may be destroyed as soon as it
+  // is released.
+  std::lock_guard<std::mutex> lock(mutex_);
+  request.busy = false;
+  request_released_.notify_all();
+}
+
+litert::Expected<void> LiteRtDispatchInvocationContextT::BindTensors(
+    Request& request) {
+  for (int i = 0; i < static_cast<int>(inputs_.size()); ++i) {
+    if (!inputs_[i] || request.inputs[i] == inputs_[i]) {
+      continue;
+    }
+    LITERT_ASSIGN_OR_RETURN(auto ov_tensor,
+                            device_context_.getOvTensor(*inputs_[i]));
+    request.inputs[i].reset();
+    request.infer_request.set_input_tensor(i, ov_tensor);
+    request.inputs[i] = inputs_[i];
+  }
+  for (int i = 0; i < static_cast<int>(outputs_.size()); ++i) {
+    if (!outputs_[i] || request.outputs[i] == outputs_[i]) {
+      continue;
+    }
+    LITERT_ASSIGN_OR_RETURN(auto ov_tensor,
+                            device_context_.getOvTensor(*outputs_[i]));
+    request.outputs[i].reset();
+    request.infer_request.set_output_tensor(i, ov_tensor);
+    request.outputs[i] = outputs_[i];
+  }
+  return {};
+}
+
+litert::Expected<void> LiteRtDispatchInvocationContextT::WaitForInputEvents() {
+  for (auto& input_event : input_events_) {
+    if (input_event == nullptr) {
+      continue;
+    }
+    LITERT_RETURN_IF_ERROR(
+        LiteRtWaitEvent(input_event, kInferRequestTimeoutMs));
+    input_event = nullptr;
+  }
   return {};
 }
 
 litert::Expected<void> LiteRtDispatchInvocationContextT::Invoke() {
-  infer_request_.start_async();
-  if (!infer_request_.wait_for(
-          std::chrono::milliseconds(kInferRequestTimeoutMs)))
+  LITERT_RETURN_IF_ERROR(WaitForInputEvents());
+  Request& request = AcquireRequest();
+  absl::Cleanup release_request = [this, &request] { ReleaseRequest(request); };
+  LITERT_RETURN_IF_ERROR(BindTensors(request));
+
+  // Drop the completion callback of a previous asynchronous invocation.
+  request.infer_request.set_callback([](std::exception_ptr) {});
+  // Requests in flight are on their own tracks.
+  LITERT_PERFETTO_TRACE_DEVICE_EVENT(
+      kDeviceTrackName, litert::internal::GetPerfettoFlowId(&request),
+      "LiteRT::Dispatch[execute]", litert::internal::GetPerfettoFlowId(this));
+  request.infer_request.start_async();
+  if (!request.infer_request.wait_for(
+          std::chrono::milliseconds(kInferRequestTimeoutMs))) {
+    request.infer_request.cancel();
     return litert::Unexpected(
         kLiteRtStatusErrorRuntimeFailure,
         "Failed to execute inference request due to timeout");
+  }
+  return {};
+}
+
+litert::Expected<void> LiteRtDispatchInvocationContextT::InvokeAsync(
+    int num_output_events, LiteRtEvent* output_events) {
+  if (num_output_events < 0 ||
+      (num_output_events > 0 && output_events == nullptr)) {
+    return litert::Unexpected(kLiteRtStatusErrorInvalidArgument,
+                              "Invalid output events");
+  }
+  LITERT_RETURN_IF_ERROR(WaitForInputEvents());
+
+  std::vector<LiteRtEvent> events(num_output_events, nullptr);
+  absl::Cleanup destroy_events = [&events] {
+    for (auto event : events) {
+      if (event != nullptr) {
+        LiteRtDestroyEvent(event);
+      }
+    }
+  };
+  for (auto& event : events) {
+    LITERT_RETURN_IF_ERROR(
+        LiteRtCreateManagedEvent(/*env=*/nullptr, LiteRtEventTypeHost, &event));
+  }
+
+  Request& request = AcquireRequest();
+  absl::Cleanup release_request = [this, &request] { ReleaseRequest(request); };
+  LITERT_RETURN_IF_ERROR(BindTensors(request));
+
+  request.infer_request.set_callback(
+      [this, &request, events](std::exception_ptr error) {
+        LiteRtStatus status = kLiteRtStatusOk;
+        if (error) {
+          status = kLiteRtStatusErrorRuntimeFailure;
+          try {
+            std::rethrow_exception(error);
+          } catch (const std::exception& e) {
+            LITERT_LOG(LITERT_ERROR, "Asynchronous inference failed: %s",
+                       e.what());
+          } catch (...) {
+            LITERT_LOG(LITERT_ERROR, "Asynchronous inference failed");
+          }
+        }
+        LITERT_PERFETTO_TRACE_DEVICE_EVENT_END(
+            kDeviceTrackName, litert::internal::GetPerfettoFlowId(&request));
+        // Waiting on the output events returns the failure, rather than
+        // letting the consumers read outputs that were never written.
+        for (auto event : events) {
+          LiteRtSignalEventWithStatus(event, status);
+        }
+        ReleaseRequest(request);
+      });
+  LITERT_PERFETTO_TRACE_DEVICE_EVENT_BEGIN(
+      kDeviceTrackName, litert::internal::GetPerfettoFlowId(&request),
+      "LiteRT::Dispatch[execute]", litert::internal::GetPerfettoFlowId(this));
+  request.infer_request.start_async();
+
+  // The request is released and the events are signaled by the callback.
+  std::move(release_request).Cancel();
+  std::move(destroy_events).Cancel();
+  std::copy(events.begin(), events.end(), output_events);
   return {};
 }
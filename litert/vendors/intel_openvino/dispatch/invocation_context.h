@@ -16,8 +16,17 @@
 #ifndef ODML_LITERT_LITERT_VENDORS_OPENVINO_DISPATCH_LITERT_DISPATCH_INVOCATION_CONTEXT_H_
 #define ODML_LITERT_LITERT_VENDORS_OPENVINO_DISPATCH_LITERT_DISPATCH_INVOCATION_CONTEXT_H_
 
+#include <condition_variable>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "openvino/runtime/compiled_model.hpp"
 #include "openvino/runtime/core.hpp"
 #include "openvino/runtime/infer_request.hpp"
+#include "litert/c/litert_event.h"
 #include "litert/c/litert_model.h"
 #include "litert/c/litert_tensor_buffer_requirements.h"
 #include "litert/cc/litert_expected.h"
@@ -26,11 +35,20 @@
 
 class LiteRtDispatchDeviceContextT;
 
+// Runs a compiled model on a pool of OpenVINO inference requests.
+//
+// Tensors attached to the context are bound to a request when an invocation
+// starts, so that the buffers can be re-attached for the next invocation while
+// the previous ones are still running. Concurrent invocations run on distinct
+// requests, which lets throughput performance modes fill the parallel
+// execution streams of the device. An invocation waits for an idle request
+// when all of them are busy.
 class LiteRtDispatchInvocationContextT {
  public:
   using Ptr = std::unique_ptr<LiteRtDispatchInvocationContextT>;
 
-  ~LiteRtDispatchInvocationContextT() = default;
+  // Waits for the asynchronous invocations in flight.
+  ~LiteRtDispatchInvocationContextT();
 
   static litert::Expected<Ptr> Create(
       LiteRtDispatchDeviceContextT& device_context,
@@ -62,15 +80,60 @@ class LiteRtDispatchInvocationContextT {
     return {};
   }
 
+  // Sets an event to wait for before the next invocation reads the input.
+  litert::Expected<void> AttachInputEvent(int graph_input_index,
+                                          LiteRtEvent input_event);
+
   litert::Expected<void> Invoke();
 
+  // Starts an invocation and returns right away. Each of the returned events
+  // is signaled once the invocation completes.
+  litert::Expected<void> InvokeAsync(int num_output_events,
+                                     LiteRtEvent* output_events);
+
+  int NumInferRequests() const { return static_cast<int>(requests_.size()); }
+
  private:
-  LiteRtDispatchInvocationContextT(ov::InferRequest& infer_request,
+  struct Request {
+    explicit Request(ov::InferRequest infer_request, int num_inputs,
+                     int num_outputs)
+        : infer_request(std::move(infer_request)),
+          inputs(num_inputs),
+          outputs(num_outputs) {}
+
+    ov::InferRequest infer_request;
+    // Handles of the tensors currently set on the request.
+    std::vector<std::optional<LiteRtTensorBufferHandle>> inputs;
+    std::vector<std::optional<LiteRtTensorBufferHandle>> outputs;
+    bool busy = false;
+  };
+
+  LiteRtDispatchInvocationContextT(ov::CompiledModel compiled_model,
                                    LiteRtDispatchDeviceContextT& device_context,
-                                   int num_inputs, int num_outputs)
-      : device_context_(device_context), infer_request_(infer_request) {}
+                                   int num_inputs, int num_outputs,
+                                   int num_infer_requests);
+
+  // Waits for an idle request and marks it busy.
+  Request& AcquireRequest();
+  void ReleaseRequest(Request& request);
+
+  // Sets the attached tensors that changed since the last invocation on
+  // `request`.
+  litert::Expected<void> BindTensors(Request& request);
+
+  // Waits for the attached input events, which are consumed.
+  litert::Expected<void> WaitForInputEvents();
+
   LiteRtDispatchDeviceContextT& device_context_;
-  ov::InferRequest infer_request_;
+  ov::CompiledModel compiled_model_;
+  std::vector<std::unique_ptr<Request>> requests_;
+  // The attached tensors and events are only accessed by the thread invoking
+  // the context, while the completion callbacks only release their request.
+  std::vector<std::optional<LiteRtTensorBufferHandle>> inputs_;
+  std::vector<std::optional<LiteRtTensorBufferHandle>> outputs_;
+  std::vector<LiteRtEvent> input_events_;
+  std::mutex mutex_;
+  std::condition_variable request_released_;
   // Timeout is in milliseconds
   static constexpr int kInferRequestTimeoutMs = 10000;
 };
@@ -44,6 +44,7 @@
 #include "litert/vendors/mediatek/compiler/legalizations/resize_nearest_neighbor_op_legalization.h"
 #include "litert/vendors/mediatek/compiler/legalizations/rms_norm_op_legalization.h"
 #include "litert/vendors/mediatek/compiler/legalizations/rsqrt_op_legalization.h"
+#include "litert/vendors/mediatek/compiler/legalizations/sdpa_op_legalization.h"
 #include "litert/vendors/mediatek/compiler/legalizations/softmax_op_legalization.h"
 #include "litert/vendors/mediatek/compiler/legalizations/split_op_legalization.h"
 #include "litert/vendors/mediatek/compiler/legalizations/squared_difference_op_legalization.h"
@@ -304,6 +305,9 @@ Expected<void> CreateModel(const NeuronAdapterApi& neuron_adapter_api,
         } else if (std::string(op_name) == "odml.l2_norm") {
           status = LegalizeCommonOp(neuron_adapter_api, model, *operand_map, op,
                                     NEURON_L2_NORMALIZATION);
+        } else if (std::string(op_name) ==
+                   "odml.scaled_dot_product_attention") {
+          status = LegalizeSdpaOp(neuron_adapter_api, model, *operand_map, op);
         } else {
           return Error(kLiteRtStatusErrorRuntimeFailure,
                        "Unsupported ShloComposite op");
@@ -26,6 +26,7 @@
 #include "litert/cc/litert_expected.h"
 #include "litert/vendors/mediatek/compiler/legalizations/neuron_utils.h"
 #include "litert/vendors/mediatek/compiler/legalizations/operand_map.h"
+#include "litert/vendors/mediatek/compiler/legalizations/sdpa_op_legalization.h"
 #include "litert/vendors/mediatek/neuron_adapter_api.h"
 
 namespace litert::mediatek {
@@ -56,6 +57,9 @@ bool VerifyCommonOp(const litert::Op& op, LiteRtOpCode op_code) {
         std::string(op_name) == "odml.l2_norm") {
       return true;
     }
+    if (std::string(op_name) == "odml.scaled_dot_product_attention") {
+      return VerifySdpaOp(op);
+    }
     return false;
   }
 
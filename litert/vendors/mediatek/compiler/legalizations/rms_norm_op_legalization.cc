@@ -21,6 +21,7 @@
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_options.h"
 #include "litert/cc/internal/litert_extended_model.h"
+#include "litert/cc/internal/litert_op_options.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/vendors/mediatek/compiler/legalizations/operand_map.h"
 #include "litert/vendors/mediatek/neuron_adapter_api.h"
@@ -90,8 +91,11 @@ Expected<void> LegalizeRmsNormOp(const NeuronAdapterApi& neuron_adapter_api,
                                   beta_bytes));
   input_indices.push_back(beta_tensor_id);
 
-  // Eplison
+  // Eplison: Use the composite attribute, FLT_EPSILON if it is missing
   float epsilon_value = std::numeric_limits<float>::epsilon();
+  if (auto options = GetOptionsAs<RmsNormOpts>(op.Get()); options) {
+    epsilon_value = options->epsilon;
+  }
   LITERT_ASSIGN_OR_RETURN(auto epsilon_tensor_id,
                           operand_map.AddScalarFloat32(epsilon_value));
   input_indices.push_back(epsilon_tensor_id);
@@ -0,0 +1,281 @@
+// Copyright (c) 2025 MediaTek Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/vendors/mediatek/compiler/legalizations/sdpa_op_legalization.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "litert/c/internal/litert_logging.h"
+#include "litert/c/litert_common.h"
+#include "litert/cc/internal/litert_extended_model.h"
+#include "litert/cc/internal/litert_op_options.h"
+#include "litert/cc/litert_element_type.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/vendors/mediatek/compiler/legalizations/legalize_helper.h"
+#include "litert/vendors/mediatek/compiler/legalizations/neuron_utils.h"
+#include "litert/vendors/mediatek/compiler/legalizations/operand_map.h"
+#include "litert/vendors/mediatek/neuron_adapter_api.h"
+
+namespace litert::mediatek {
+
+namespace {
+
+// [batch, seq_len, num_heads, head_dim] <-> [batch, num_heads, seq_len,
+// head_dim]. The permutation is its own inverse.
+constexpr int32_t kHeadMajorPerm[] = {0, 2, 1, 3};
+
+std::vector<uint32_t> GetDimensions(const Tensor& tensor) {
+  LITERT_ASSIGN_OR_ABORT(auto tensor_type, tensor.RankedTensorType());
+  auto dims = tensor_type.Layout().Dimensions();
+  return std::vector<uint32_t>(dims.begin(), dims.end());
+}
+
+std::vector<uint32_t> Permute(const std::vector<uint32_t>& dims) {
+  std::vector<uint32_t> permuted(dims.size());
+  for (int i = 0; i < dims.size(); ++i) {
+    permuted[i] = dims[kHeadMajorPerm[i]];
+  }
+  return permuted;
+}
+
+// Returns true if permuting `dims` only moves dimensions of size 1, in which
+// case the data layout is unchanged and a RESHAPE can replace the TRANSPOSE.
+// This is always the case for the query and output of a decode step.
+bool IsLayoutPreserving(const std::vector<uint32_t>& dims) {
+  int last_moved_dim = -1;
+  for (int i = 0; i < dims.size(); ++i) {
+    const int dim = kHeadMajorPerm[i];
+    if (dims[dim] == 1) {
+      continue;
+    }
+    if (dim < last_moved_dim) {
+      return false;
+    }
+    last_moved_dim = dim;
+  }
+  return true;
+}
+
+Expected<uint32_t> AddFloat32Operand(OperandMap& operand_map,
+                                     std::vector<uint32_t> dims) {
+  const NeuronOperandType operand_type = {
+      .type = NEURON_TENSOR_FLOAT32,
+      .dimensionCount = static_cast<uint32_t>(dims.size()),
+      .dimensions = dims.data(),
+  };
+  return operand_map.AddOperand(operand_type);
+}
+
+// Converts `input` of shape `dims` between the sequence-major layout of the
+// composite and the head-major layout of BATCH_MATMUL, writing to `output`.
+Expected<void> AddHeadMajorRelayout(const NeuronAdapterApi& neuron_adapter_api,
+                                    NeuronModel* model,
+                                    OperandMap& operand_map, uint32_t input,
+                                    const std::vector<uint32_t>& dims,
+                                    uint32_t output) {
+  std::vector<uint32_t> param_shape = {static_cast<uint32_t>(dims.size())};
+  if (IsLayoutPreserving(dims)) {
+    auto new_shape = Permute(dims);
+    LITERT_ASSIGN_OR_RETURN(
+        auto new_shape_operand,
+        operand_map.AddTensorByType(NEURON_TENSOR_INT32, param_shape,
+                                    new_shape.data(),
+                                    new_shape.size() * sizeof(int32_t)));
+    if (ModelAddOperation(neuron_adapter_api, model, /*type=*/NEURON_RESHAPE,
+                          {input, new_shape_operand},
+                          {output}) != NEURON_NO_ERROR) {
+      return Error(kLiteRtStatusErrorRuntimeFailure,
+                   "Failed to add NEURON_RESHAPE op");
+    }
+    return {};
+  }
+
+  LITERT_ASSIGN_OR_RETURN(
+      auto perm_operand,
+      operand_map.AddTensorByType(NEURON_TENSOR_INT32, param_shape,
+                                  kHeadMajorPerm, sizeof(kHeadMajorPerm)));
+  if (ModelAddOperation(neuron_adapter_api, model, /*type=*/NEURON_TRANSPOSE,
+                        {input, perm_operand}, {output}) != NEURON_NO_ERROR) {
+    return Error(kLiteRtStatusErrorRuntimeFailure,
+                 "Failed to add NEURON_TRANSPOSE op");
+  }
+  return {};
+}
+
+Expected<uint32_t> AddToHeadMajor(const NeuronAdapterApi& neuron_adapter_api,
+                                  NeuronModel* model, OperandMap& operand_map,
+                                  const Tensor& tensor) {
+  LITERT_ASSIGN_OR_RETURN(auto input, operand_map.GetOperandIndex(tensor));
+  const auto dims = GetDimensions(tensor);
+  LITERT_ASSIGN_OR_RETURN(auto output,
+                          AddFloat32Operand(operand_map, Permute(dims)));
+  LITERT_RETURN_IF_ERROR(AddHeadMajorRelayout(neuron_adapter_api, model,
+                                              operand_map, input, dims,
+                                              output));
+  return output;
+}
+
+Expected<uint32_t> AddBatchMatMul(const NeuronAdapterApi& neuron_adapter_api,
+                                  NeuronModel* model, OperandMap& operand_map,
+                                  uint32_t lhs, uint32_t rhs, bool adj_y,
+                                  std::vector<uint32_t> output_dims) {
+  LITERT_ASSIGN_OR_RETURN(auto adj_x_operand,
+                          operand_map.AddScalarBool(false));
+  LITERT_ASSIGN_OR_RETURN(auto adj_y_operand,
+                          operand_map.AddScalarBool(adj_y));
+  LITERT_ASSIGN_OR_RETURN(auto output,
+                          AddFloat32Operand(operand_map, output_dims));
+  if (ModelAddOperation(neuron_adapter_api, model,
+                        /*type=*/NEURON_BATCH_MATMUL,
+                        {lhs, rhs, adj_x_operand, adj_y_operand},
+                        {output}) != NEURON_NO_ERROR) {
+    return Error(kLiteRtStatusErrorRuntimeFailure,
+                 "Failed to add NEURON_BATCH_MATMUL op");
+  }
+  return output;
+}
+
+float GetScale(const litert::Op& op, uint32_t head_dim) {
+  auto options = GetOptionsAs<CompositeOptions>(op.Get());
+  if (options && options->attributes_map.has_value()) {
+    auto scale = options->attributes_map.value()["scale"];
+    if (!scale.IsNull()) {
+      return scale.AsFloat();
+    }
+  }
+  return 1.0f / std::sqrt(static_cast<float>(head_dim));
+}
+
+}  // namespace
+
+bool VerifySdpaOp(const litert::Op& op) {
+  const auto inputs = op.Inputs();
+  if (inputs.size() < 3 || inputs.size() > 4 || op.Outputs().size() != 1) {
+    return false;
+  }
+  for (const auto& input : inputs) {
+    if (GetElementType(input) != ElementType::Float32 ||
+        GetDimensions(input).size() != 4) {
+      return false;
+    }
+  }
+  const auto query_dims = GetDimensions(inputs[0]);
+  const auto key_dims = GetDimensions(inputs[1]);
+  // Grouped-query attention would need the key and value heads broadcast,
+  // which BATCH_MATMUL does not do; leave it to the decomposition.
+  return key_dims == GetDimensions(inputs[2]) &&
+         key_dims[0] == query_dims[0] && key_dims[2] == query_dims[2] &&
+         key_dims[3] == query_dims[3] &&
+         GetDimensions(op.Outputs()[0]) == query_dims;
+}
+
+Expected<void> LegalizeSdpaOp(const NeuronAdapterApi& neuron_adapter_api,
+                              NeuronModel* model, OperandMap& operand_map,
+                              const litert::Op& op) {
+  LITERT_LOG(LITERT_INFO, "Legalize Scaled Dot Product Attention");
+  const auto inputs = op.Inputs();
+  const bool has_mask = inputs.size() > 3;
+  const auto query_dims = GetDimensions(inputs[0]);
+  const auto key_dims = GetDimensions(inputs[1]);
+  const uint32_t batch = query_dims[0];
+  const uint32_t query_len = query_dims[1];
+  const uint32_t num_heads = query_dims[2];
+  const uint32_t head_dim = query_dims[3];
+  const uint32_t kv_len = key_dims[1];
+  const float scale = GetScale(op, head_dim);
+
+  LITERT_ASSIGN_OR_RETURN(
+      auto query,
+      AddToHeadMajor(neuron_adapter_api, model, operand_map, inputs[0]));
+  LITERT_ASSIGN_OR_RETURN(
+      auto key,
+      AddToHeadMajor(neuron_adapter_api, model, operand_map, inputs[1]));
+  LITERT_ASSIGN_OR_RETURN(
+      auto value,
+      AddToHeadMajor(neuron_adapter_api, model, operand_map, inputs[2]));
+
+  // Without a mask the scale is folded into the softmax beta. With a mask it
+  // must be applied before the mask is added, so scale the query, which is
+  // smaller than the attention logits.
+  float beta = scale;
+  if (has_mask) {
+    beta = 1.0f;
+    std::vector<uint32_t> scale_shape = {1};
+    LITERT_ASSIGN_OR_RETURN(
+        auto scale_operand,
+        operand_map.AddTensorByType(NEURON_TENSOR_FLOAT32, scale_shape, &scale,
+                                    sizeof(scale)));
+    LITERT_ASSIGN_OR_RETURN(auto activation_operand,
+                            operand_map.AddScalarInt32(0));
+    LITERT_ASSIGN_OR_RETURN(
+        auto scaled_query,
+        AddFloat32Operand(operand_map,
+                          {batch, num_heads, query_len, head_dim}));
+    if (ModelAddOperation(neuron_adapter_api, model, /*type=*/NEURON_MUL,
+                          {query, scale_operand, activation_operand},
+                          {scaled_query}) != NEURON_NO_ERROR) {
+      return Error(kLiteRtStatusErrorRuntimeFailure,
+                   "Failed to add NEURON_MUL op");
+    }
+    query = scaled_query;
+  }
+
+  const std::vector<uint32_t> logits_dims = {batch, num_heads, query_len,
+                                             kv_len};
+  LITERT_ASSIGN_OR_RETURN(
+      auto logits, AddBatchMatMul(neuron_adapter_api, model, operand_map,
+                                  query, key, /*adj_y=*/true, logits_dims));
+
+  if (has_mask) {
+    LITERT_ASSIGN_OR_RETURN(auto mask, operand_map.GetOperandIndex(inputs[3]));
+    LITERT_ASSIGN_OR_RETURN(auto activation_operand,
+                            operand_map.AddScalarInt32(0));
+    LITERT_ASSIGN_OR_RETURN(auto masked_logits,
+                            AddFloat32Operand(operand_map, logits_dims));
+    if (ModelAddOperation(neuron_adapter_api, model, /*type=*/NEURON_ADD,
+                          {logits, mask, activation_operand},
+                          {masked_logits}) != NEURON_NO_ERROR) {
+      return Error(kLiteRtStatusErrorRuntimeFailure,
+                   "Failed to add NEURON_ADD op");
+    }
+    logits = masked_logits;
+  }
+
+  LITERT_ASSIGN_OR_RETURN(auto beta_operand,
+                          operand_map.AddScalarFloat32(beta));
+  LITERT_ASSIGN_OR_RETURN(auto probs,
+                          AddFloat32Operand(operand_map, logits_dims));
+  if (ModelAddOperation(neuron_adapter_api, model, /*type=*/NEURON_SOFTMAX,
+                        {logits, beta_operand}, {probs}) != NEURON_NO_ERROR) {
+    return Error(kLiteRtStatusErrorRuntimeFailure,
+                 "Failed to add NEURON_SOFTMAX op");
+  }
+
+  const std::vector<uint32_t> attention_dims = {batch, num_heads, query_len,
+                                                head_dim};
+  LITERT_ASSIGN_OR_RETURN(
+      auto attention,
+      AddBatchMatMul(neuron_adapter_api, model, operand_map, probs, value,
+                     /*adj_y=*/false, attention_dims));
+
+  LITERT_ASSIGN_OR_RETURN(auto output,
+                          operand_map.GetOperandIndex(op.Outputs()[0]));
+  return AddHeadMajorRelayout(neuron_adapter_api, model, operand_map,
+                              attention, attention_dims, output);
+}
+
+}  // namespace litert::mediatek
@@ -0,0 +1,74 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/vendors/mediatek/dispatch/compiled_network_cache.h"
+
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/cc/litert_expected.h"
+#include "litert/core/cache/hash_util.h"
+#include "litert/core/filesystem.h"
+
+namespace litert::mediatek {
+
+uint64_t CompiledNetworkCache::GetKey(absl::Span<const uint8_t> bytecode,
+                                      absl::string_view compile_options,
+                                      int priority, int preference) const {
+  uint64_t key = StableHash(bytecode.data(), bytecode.size());
+  HashCombine(key, device_id_);
+  HashCombine(key, std::string(compile_options));
+  HashCombine(key, priority);
+  HashCombine(key, preference);
+  return key;
+}
+
+std::string CompiledNetworkCache::GetPath(uint64_t key) const {
+  return absl::StrFormat("%s/%016x.neuron_network", cache_dir_, key);
+}
+
+std::optional<std::vector<uint8_t>> CompiledNetworkCache::Load(
+    uint64_t key) const {
+  std::ifstream file(GetPath(key), std::ios::binary | std::ios::ate);
+  if (!file) {
+    return std::nullopt;
+  }
+  const std::streamsize size = file.tellg();
+  if (size <= 0) {
+    return std::nullopt;
+  }
+  std::vector<uint8_t> compiled_network(size);
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char*>(compiled_network.data()), size)) {
+    return std::nullopt;
+  }
+  return compiled_network;
+}
+
+Expected<void> CompiledNetworkCache::Store(
+    uint64_t key, absl::Span<const uint8_t> compiled_network) const {
+  return internal::WriteFileAtomically(
+      GetPath(key),
+      absl::string_view(reinterpret_cast<const char*>(compiled_network.data()),
+                        compiled_network.size()));
+}
+
+}  // namespace litert::mediatek
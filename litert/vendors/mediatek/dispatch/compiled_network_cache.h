@@ -0,0 +1,70 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_VENDORS_MEDIATEK_DISPATCH_COMPILED_NETWORK_CACHE_H_
+#define ODML_LITERT_LITERT_VENDORS_MEDIATEK_DISPATCH_COMPILED_NETWORK_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/cc/litert_expected.h"
+
+namespace litert::mediatek {
+
+// A persistent cache of the Neuron compiled networks built from DLA bytecode,
+// so that the on-device compilation is only done the first time a bytecode is
+// loaded.
+//
+// Compiled networks are only valid for the SoC and Neuron runtime they were
+// built with, and depend on the options of the compilation, so the cache keys
+// combine the hash of the bytecode with a `device_id` identifying both and with
+// the compilation options. Each compiled network is stored as
+// '<key>.neuron_network' under the cache directory, written to a temporary
+// file first and then renamed so that concurrent processes never load a
+// partially written network.
+class CompiledNetworkCache {
+ public:
+  CompiledNetworkCache(std::string cache_dir, std::string device_id)
+      : cache_dir_(std::move(cache_dir)), device_id_(std::move(device_id)) {}
+
+  // Returns the key of the compiled network built from `bytecode` on this
+  // device with the given optimization string, priority and preference.
+  uint64_t GetKey(absl::Span<const uint8_t> bytecode,
+                  absl::string_view compile_options, int priority,
+                  int preference) const;
+
+  // Returns the compiled network stored under `key`, or an empty optional on
+  // a cache miss.
+  std::optional<std::vector<uint8_t>> Load(uint64_t key) const;
+
+  // Stores `compiled_network` under `key`, replacing any previous entry.
+  Expected<void> Store(uint64_t key,
+                       absl::Span<const uint8_t> compiled_network) const;
+
+ private:
+  std::string GetPath(uint64_t key) const;
+
+  std::string cache_dir_;
+  std::string device_id_;
+};
+
+}  // namespace litert::mediatek
+
+#endif  // ODML_LITERT_LITERT_VENDORS_MEDIATEK_DISPATCH_COMPILED_NETWORK_CACHE_H_
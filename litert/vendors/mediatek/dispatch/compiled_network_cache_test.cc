@@ -0,0 +1,84 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/vendors/mediatek/dispatch/compiled_network_cache.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "litert/test/matchers.h"
+
+namespace litert::mediatek {
+namespace {
+
+using ::testing::ElementsAreArray;
+using ::testing::Optional;
+
+constexpr uint8_t kBytecode[] = {0x44, 0x4c, 0x41, 0x01, 0x02, 0x03};
+constexpr uint8_t kOtherBytecode[] = {0x44, 0x4c, 0x41, 0x01, 0x02, 0x04};
+constexpr char kOptions[] = "--opt=3";
+
+TEST(CompiledNetworkCacheTest, KeysDependOnBytecodeAndDevice) {
+  CompiledNetworkCache cache(::testing::TempDir(), "mt6991/neuron-8.2.19");
+  CompiledNetworkCache other_device_cache(::testing::TempDir(),
+                                          "mt6989/neuron-8.2.19");
+  CompiledNetworkCache other_runtime_cache(::testing::TempDir(),
+                                           "mt6991/neuron-8.2.20");
+
+  const uint64_t key = cache.GetKey(kBytecode, kOptions, 1, 2);
+  EXPECT_EQ(key, cache.GetKey(kBytecode, kOptions, 1, 2));
+  EXPECT_NE(key, cache.GetKey(kOtherBytecode, kOptions, 1, 2));
+  EXPECT_NE(key, other_device_cache.GetKey(kBytecode, kOptions, 1, 2));
+  EXPECT_NE(key, other_runtime_cache.GetKey(kBytecode, kOptions, 1, 2));
+}
+
+TEST(CompiledNetworkCacheTest, KeysDependOnCompilationOptions) {
+  CompiledNetworkCache cache(::testing::TempDir(), "mt6991/neuron-8.2.19");
+
+  const uint64_t key = cache.GetKey(kBytecode, kOptions, 1, 2);
+  EXPECT_NE(key, cache.GetKey(kBytecode, "", 1, 2));
+  EXPECT_NE(key, cache.GetKey(kBytecode, "--opt=2", 1, 2));
+  EXPECT_NE(key, cache.GetKey(kBytecode, kOptions, 0, 2));
+  EXPECT_NE(key, cache.GetKey(kBytecode, kOptions, 1, 0));
+}
+
+TEST(CompiledNetworkCacheTest, StoresAndLoadsCompiledNetworks) {
+  CompiledNetworkCache cache(::testing::TempDir(), "mt6991/neuron-8.2.19");
+  const uint64_t key = cache.GetKey(kBytecode, kOptions, 1, 2);
+  const uint64_t other_key = cache.GetKey(kOtherBytecode, kOptions, 1, 2);
+  EXPECT_EQ(cache.Load(key), std::nullopt);
+
+  const std::vector<uint8_t> compiled_network = {1, 2, 3, 4, 5};
+  LITERT_ASSERT_OK(cache.Store(key, compiled_network));
+  EXPECT_THAT(cache.Load(key), Optional(ElementsAreArray(compiled_network)));
+  EXPECT_EQ(cache.Load(other_key), std::nullopt);
+
+  // Storing again replaces the entry.
+  const std::vector<uint8_t> new_compiled_network = {6, 7};
+  LITERT_ASSERT_OK(cache.Store(key, new_compiled_network));
+  EXPECT_THAT(cache.Load(key),
+              Optional(ElementsAreArray(new_compiled_network)));
+}
+
+TEST(CompiledNetworkCacheTest, FailsToStoreInMissingDirectory) {
+  CompiledNetworkCache cache(::testing::TempDir() + "/does/not/exist",
+                             "mt6991/neuron-8.2.19");
+  EXPECT_FALSE(cache.Store(cache.GetKey(kBytecode, kOptions, 1, 2), kBytecode));
+}
+
+}  // namespace
+}  // namespace litert::mediatek
@@ -15,6 +15,7 @@
 #include <cstdio>
 #include <optional>
 #include <string>
+#include <variant>
 
 #include "litert/vendors/cc/options_helper.h"
 
@@ -22,12 +23,16 @@
 #include <android/hardware_buffer.h>
 #endif
 
+#include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_environment_options.h"
+#include "litert/c/litert_event.h"
+#include "litert/c/litert_event_type.h"
 #include "litert/c/litert_model.h"
 #include "litert/cc/litert_environment_options.h"
 #include "litert/cc/litert_expected.h"
+#include "litert/core/util/perfetto_profiling.h"
 #include "litert/vendors/c/litert_dispatch.h"
 #include "litert/vendors/c/litert_dispatch_api.h"
 #include "litert/vendors/mediatek/dispatch/litert_dispatch_device_context.h"
@@ -65,8 +70,25 @@ std::optional<std::string> GetSharedLibraryDir(
   return std::string(std::get<const char*>(*dispatch_lib_dir_any));
 }
 
+std::optional<std::string> GetCompilerCacheDir(
+    LiteRtEnvironmentOptions environment_options) {
+  litert::EnvironmentOptions env_options(environment_options);
+  auto cache_dir_any =
+      env_options.GetOption(litert::EnvironmentOptions::Tag::kCompilerCacheDir);
+  if (!cache_dir_any) {
+    return std::nullopt;
+  }
+  auto* cache_dir = std::get_if<const char*>(&*cache_dir_any);
+  if (!cache_dir || !*cache_dir) {
+    return std::nullopt;
+  }
+  return std::string(*cache_dir);
+}
+
 LiteRtStatus LiteRtInitialize(LiteRtEnvironmentOptions environment_options,
                               LiteRtOptions options) {
+  // The dispatch library records its own track events.
+  litert::internal::InitializePerfetto();
   static_environment_options = environment_options;
   static_options = options;
 
@@ -127,14 +149,16 @@ LiteRtStatus LiteRtGetBuildId(const char** build_id) {
 }
 
 LiteRtStatus LiteRtGetCapabilities(int* capabilities) {
-  *capabilities = kLiteRtDispatchCapabilitiesBasic;
+  *capabilities =
+      kLiteRtDispatchCapabilitiesBasic | kLiteRtDispatchCapabilitiesBatch;
   return kLiteRtStatusOk;
 }
 
 LiteRtStatus LiteRtDeviceContextCreate(
     LiteRtDispatchDeviceContext* device_context) {
-  if (auto context =
-          LiteRtDispatchDeviceContextT::Create(*static_neuron_adapter);
+  if (auto context = LiteRtDispatchDeviceContextT::Create(
+          *static_neuron_adapter,
+          GetCompilerCacheDir(static_environment_options));
       context) {
     *device_context = context->release();
     return kLiteRtStatusOk;
@@ -296,6 +320,33 @@ LiteRtStatus LiteRtInvoke(LiteRtDispatchInvocationContext invocation_context) {
   return kLiteRtStatusOk;
 }
 
+// /////////////////////////////////////////////////////////////////////////////
+// Batched Execution API
+// /////////////////////////////////////////////////////////////////////////////
+
+LiteRtStatus LiteRtInvokeBatch(
+    LiteRtDispatchInvocationContext invocation_context, int num_invocations,
+    const LiteRtDispatchInvocationBuffers* invocations,
+    LiteRtEvent* completion_event) {
+  if (auto status = invocation_context->InvokeBatch(
+          absl::MakeConstSpan(invocations, num_invocations));
+      !status) {
+    LITERT_LOG(LITERT_ERROR, "Failed to invoke batch: %s",
+               status.Error().Message().c_str());
+    return status.Error().Status();
+  }
+  // Neuron executions are synchronous, hence the batch is already done.
+  if (completion_event) {
+    if (auto status = LiteRtCreateManagedEvent(
+            /*env=*/nullptr, LiteRtEventTypeHost, completion_event);
+        status != kLiteRtStatusOk) {
+      return status;
+    }
+    return LiteRtSignalEvent(*completion_event);
+  }
+  return kLiteRtStatusOk;
+}
+
 }  // namespace mediatek
 }  // namespace litert
 
@@ -325,6 +376,10 @@ LiteRtDispatchInterface TheInterface = {
     .invoke = litert::mediatek::LiteRtInvoke,
 };
 
+LiteRtDispatchBatchInterface TheBatchInterface = {
+    .invoke_batch = litert::mediatek::LiteRtInvokeBatch,
+};
+
 LiteRtDispatchApi TheApi = {
     .version = {.major = LITERT_API_VERSION_MAJOR,
                 .minor = LITERT_API_VERSION_MINOR,
@@ -332,6 +387,7 @@ LiteRtDispatchApi TheApi = {
     .interface = &TheInterface,
     .async_interface = nullptr,
     .graph_interface = nullptr,
+    .batch_interface = &TheBatchInterface,
 };
 
 }  // namespace
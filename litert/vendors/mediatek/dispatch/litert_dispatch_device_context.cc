@@ -16,8 +16,16 @@
 
 #include <sys/mman.h>
 
+#ifdef __ANDROID__
+#include <sys/system_properties.h>
+#endif  // __ANDROID__
+
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
+#include <utility>
 
 #include "neuron/api/NeuronAdapter.h"
 #include "absl/strings/str_format.h"  // from @com_google_absl
@@ -27,17 +35,53 @@
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
 #include "litert/vendors/c/litert_dispatch.h"
+#include "litert/vendors/mediatek/dispatch/compiled_network_cache.h"
 #include "litert/vendors/mediatek/neuron_adapter_api.h"
 
 using litert::Error;
 
+namespace {
+
+// Returns a string identifying the SoC and the Neuron runtime, which the
+// compiled networks depend on.
+litert::Expected<std::string> GetDeviceId(
+    const litert::mediatek::NeuronAdapterApi& neuron_adapter_api) {
+  NeuronRuntimeVersion version;
+  if (neuron_adapter_api.api().get_version(&version) != NEURON_NO_ERROR) {
+    return Error(kLiteRtStatusErrorRuntimeFailure,
+                 "Failed to get Neuron runtime version");
+  }
+  std::string soc_model = "unknown";
+#ifdef __ANDROID__
+  char value[PROP_VALUE_MAX];
+  if (__system_property_get("ro.soc.model", value) > 0) {
+    soc_model = value;
+  }
+#endif  // __ANDROID__
+  return absl::StrFormat("%s/neuron-%d.%d.%d", soc_model, version.major,
+                         version.minor, version.patch);
+}
+
+}  // namespace
+
 LiteRtDispatchDeviceContextT::~LiteRtDispatchDeviceContextT() = default;
 
 litert::Expected<LiteRtDispatchDeviceContextT::Ptr>
 LiteRtDispatchDeviceContextT::Create(
-    const litert::mediatek::NeuronAdapterApi& neuron_adapter_api) {
-  return std::unique_ptr<LiteRtDispatchDeviceContextT>(
+    const litert::mediatek::NeuronAdapterApi& neuron_adapter_api,
+    std::optional<std::string> compiled_network_cache_dir) {
+  auto device_context = std::unique_ptr<LiteRtDispatchDeviceContextT>(
       new LiteRtDispatchDeviceContextT(neuron_adapter_api));
+  if (compiled_network_cache_dir) {
+    if (auto device_id = GetDeviceId(neuron_adapter_api); device_id) {
+      device_context->compiled_network_cache_.emplace(
+          std::move(*compiled_network_cache_dir), std::move(*device_id));
+    } else {
+      LITERT_LOG(LITERT_WARNING, "Compiled network caching disabled: %s",
+                 device_id.Error().Message().c_str());
+    }
+  }
+  return device_context;
 }
 
 litert::Expected<LiteRtTensorBufferHandle>
@@ -163,7 +207,7 @@ LiteRtDispatchDeviceContextT::NeuronMemoryRegistry::Register(
     records_.push_back({});
   }
   auto& dest = records_[dest_index];
-  dest = {neuron_memory, size, offset};
+  dest = {neuron_memory, size, offset, next_registration_id_++};
   return dest_index;
 }
 
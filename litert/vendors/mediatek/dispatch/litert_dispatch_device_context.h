@@ -15,13 +15,17 @@
 #ifndef ODML_LITERT_LITERT_VENDORS_MEDIATEK_DISPATCH_LITERT_DISPATCH_DEVICE_CONTEXT_H_
 #define ODML_LITERT_LITERT_VENDORS_MEDIATEK_DISPATCH_LITERT_DISPATCH_DEVICE_CONTEXT_H_
 
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
 
 #include "neuron/api/NeuronAdapter.h"
 #include "absl/container/flat_hash_set.h"  // from @com_google_absl
 #include "litert/c/litert_tensor_buffer.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/vendors/c/litert_dispatch.h"
+#include "litert/vendors/mediatek/dispatch/compiled_network_cache.h"
 #include "litert/vendors/mediatek/neuron_adapter_api.h"
 
 class LiteRtDispatchDeviceContextT {
@@ -31,12 +35,18 @@ class LiteRtDispatchDeviceContextT {
     NeuronMemory* neuron_memory;
     size_t size;
     size_t offset;
+    // Unique across the registrations of the device context, unlike the
+    // tensor buffer handles which get reused.
+    uint64_t registration_id;
   };
 
   ~LiteRtDispatchDeviceContextT();
 
+  // Compiled networks are cached under `compiled_network_cache_dir`, if
+  // provided.
   static litert::Expected<Ptr> Create(
-      const litert::mediatek::NeuronAdapterApi& neuron_adapter_api);
+      const litert::mediatek::NeuronAdapterApi& neuron_adapter_api,
+      std::optional<std::string> compiled_network_cache_dir = std::nullopt);
 
   litert::Expected<LiteRtTensorBufferHandle> RegisterTensorBuffer(
       LiteRtTensorBuffer tensor_buffer);
@@ -56,6 +66,13 @@ class LiteRtDispatchDeviceContextT {
     }
   }
 
+  // Returns the cache of compiled networks, or nullptr if caching is
+  // disabled.
+  const litert::mediatek::CompiledNetworkCache* GetCompiledNetworkCache()
+      const {
+    return compiled_network_cache_ ? &*compiled_network_cache_ : nullptr;
+  }
+
  private:
   class NeuronMemoryRegistry {
    public:
@@ -73,6 +90,7 @@ class LiteRtDispatchDeviceContextT {
    private:
     const litert::mediatek::NeuronAdapterApi& neuron_adapter_api_;
     std::vector<NeuronMemoryInfo> records_;
+    uint64_t next_registration_id_ = 0;
   };
 
   explicit LiteRtDispatchDeviceContextT(
@@ -82,6 +100,7 @@ class LiteRtDispatchDeviceContextT {
 
   const litert::mediatek::NeuronAdapterApi& neuron_adapter_api_;
   NeuronMemoryRegistry neuron_memory_registry_;
+  std::optional<litert::mediatek::CompiledNetworkCache> compiled_network_cache_;
 };
 
 #endif  // ODML_LITERT_LITERT_VENDORS_MEDIATEK_DISPATCH_LITERT_DISPATCH_DEVICE_CONTEXT_H_
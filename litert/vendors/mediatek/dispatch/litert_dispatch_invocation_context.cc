@@ -18,17 +18,22 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_model.h"
 #include "litert/c/litert_tensor_buffer.h"
 #include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/core/util/perfetto_profiling.h"
 #include "litert/vendors/c/litert_dispatch.h"
+#include "litert/vendors/mediatek/dispatch/compiled_network_cache.h"
 #include "litert/vendors/mediatek/dispatch/litert_dispatch_device_context.h"
 #include "litert/vendors/mediatek/neuron_adapter_api.h"
 #include "litert/vendors/mediatek/schema/schema_resolver.h"
@@ -44,6 +49,14 @@ namespace {
 // FIXME (b/409133962): This is used as a workaround to b/409133962.
 constexpr int kExpectedRankForB409133962War = 4;
 
+// The Perfetto track of the work executed by the APU.
+constexpr char kDeviceTrackName[] = "MediaTek APU";
+
+// The options of the compilation of DLA bytecode, which are also part of the
+// key of its cached compiled network.
+constexpr int kCompilationPriority = NEURON_PRIORITY_HIGH;
+constexpr int kCompilationPreference = NEURON_PREFER_SUSTAINED_SPEED;
+
 Expected<std::pair<NeuronModelPtr, NeuronCompilationPtr>> LoadFromCachedNetwork(
     const litert::mediatek::NeuronAdapterApi& neuron_adapter_api,
     const void* bytecode_addr, size_t bytecode_size) {
@@ -180,14 +193,13 @@ Expected<std::pair<NeuronModelPtr, NeuronCompilationPtr>> LoadFromDlaBytecode(
   }
 
   if (neuron_adapter_api.api().compilation_set_priority(
-          compilation->get(), NEURON_PRIORITY_HIGH) != NEURON_NO_ERROR) {
+          compilation->get(), kCompilationPriority) != NEURON_NO_ERROR) {
     return Error(kLiteRtStatusErrorRuntimeFailure,
                  "Failed to set compilation priority");
   }
 
   if (neuron_adapter_api.api().compilation_set_preference(
-          compilation->get(), NEURON_PREFER_SUSTAINED_SPEED) !=
-      NEURON_NO_ERROR) {
+          compilation->get(), kCompilationPreference) != NEURON_NO_ERROR) {
     return Error(kLiteRtStatusErrorRuntimeFailure,
                  "Failed to set compilation preference");
   }
@@ -212,19 +224,73 @@ Expected<std::pair<NeuronModelPtr, NeuronCompilationPtr>> LoadFromDlaBytecode(
   return std::make_pair(std::move(*model), std::move(*compilation));
 }
 
+// Stores the compiled network of `compilation` in `cache` under `key`.
+Expected<void> StoreCompiledNetwork(
+    const litert::mediatek::NeuronAdapterApi& neuron_adapter_api,
+    NeuronCompilation* compilation,
+    const litert::mediatek::CompiledNetworkCache& cache, uint64_t key) {
+  size_t compiled_network_size;
+  if (neuron_adapter_api.api().compilation_get_compiled_network_size(
+          compilation, &compiled_network_size) != NEURON_NO_ERROR) {
+    return Error(kLiteRtStatusErrorRuntimeFailure,
+                 "Failed to get compiled network size");
+  }
+  std::vector<uint8_t> compiled_network(compiled_network_size);
+  if (neuron_adapter_api.api().compilation_store_compiled_network(
+          compilation, compiled_network.data(), compiled_network.size()) !=
+      NEURON_NO_ERROR) {
+    return Error(kLiteRtStatusErrorRuntimeFailure,
+                 "Failed to get compiled network");
+  }
+  return cache.Store(key, compiled_network);
+}
+
+// Loads the model and compilation of `bytecode`, which is either DLA bytecode
+// or a compiled network. The compiled network of DLA bytecode is looked up in
+// `cache`, if any, and added to it on a miss. On a cache hit, the compiled
+// network is returned in `cached_network`, which must outlive the returned
+// compilation.
 Expected<std::pair<NeuronModelPtr, NeuronCompilationPtr>>
 LoadModelAndCompilation(
     const litert::mediatek::NeuronAdapterApi& neuron_adapter_api,
+    const litert::mediatek::CompiledNetworkCache* cache,
     const void* bytecode_addr, size_t bytecode_size, int num_inputs,
-    int num_outputs) {
-  if (auto result = LoadFromDlaBytecode(neuron_adapter_api, bytecode_addr,
-                                        bytecode_size, num_inputs, num_outputs);
-      !result) {
+    int num_outputs, std::vector<uint8_t>& cached_network) {
+  uint64_t cache_key = 0;
+  if (cache) {
+    cache_key = cache->GetKey(
+        absl::MakeConstSpan(static_cast<const uint8_t*>(bytecode_addr),
+                            bytecode_size),
+        neuron_adapter_api.AotCompileOptions(), kCompilationPriority,
+        kCompilationPreference);
+    if (auto compiled_network = cache->Load(cache_key); compiled_network) {
+      if (auto result = LoadFromCachedNetwork(neuron_adapter_api,
+                                              compiled_network->data(),
+                                              compiled_network->size());
+          result) {
+        cached_network = std::move(*compiled_network);
+        return result;
+      }
+      LITERT_LOG(LITERT_WARNING,
+                 "Failed to restore the cached compiled network, recompiling");
+    }
+  }
+
+  auto result = LoadFromDlaBytecode(neuron_adapter_api, bytecode_addr,
+                                    bytecode_size, num_inputs, num_outputs);
+  if (!result) {
     return LoadFromCachedNetwork(neuron_adapter_api, bytecode_addr,
                                  bytecode_size);
-  } else {
-    return result;
   }
+  if (cache) {
+    if (auto status = StoreCompiledNetwork(
+            neuron_adapter_api, result->second.get(), *cache, cache_key);
+        !status) {
+      LITERT_LOG(LITERT_WARNING, "Failed to cache the compiled network: %s",
+                 status.Error().Message().c_str());
+    }
+  }
+  return result;
 }
 
 }  // namespace
@@ -258,9 +324,11 @@ LiteRtDispatchInvocationContextT::Create(
     std::tie(exec_bytecode_ptr, exec_bytecode_size) = compile_graph.Value();
   }
 
-  auto model_and_compilation =
-      LoadModelAndCompilation(neuron_adapter_api, exec_bytecode_ptr,
-                              exec_bytecode_size, num_inputs, num_outputs);
+  std::vector<uint8_t> cached_network;
+  auto model_and_compilation = LoadModelAndCompilation(
+      neuron_adapter_api, device_context->GetCompiledNetworkCache(),
+      exec_bytecode_ptr, exec_bytecode_size, num_inputs, num_outputs,
+      cached_network);
   if (!model_and_compilation) {
     return model_and_compilation.Error();
   }
@@ -280,8 +348,9 @@ LiteRtDispatchInvocationContextT::Create(
   }
 
   return Ptr(new LiteRtDispatchInvocationContextT(
-      neuron_adapter_api, device_context, model.release(),
-      compilation.release(), execution->release(), num_inputs, num_outputs));
+      neuron_adapter_api, device_context, std::move(cached_network),
+      model.release(), compilation.release(), execution->release(),
+      num_inputs, num_outputs));
 }
 
 LiteRtDispatchInvocationContextT::~LiteRtDispatchInvocationContextT() {
@@ -451,37 +520,63 @@ LiteRtDispatchInvocationContextT::GetOutputRequirements(
 
 Expected<void> LiteRtDispatchInvocationContextT::AttachInput(
     int graph_input_index, LiteRtTensorBufferHandle tensor_buffer_handle) {
+  if (graph_input_index < 0 ||
+      graph_input_index >= bound_inputs_.size()) {
+    return litert::Error(
+        kLiteRtStatusErrorInvalidArgument,
+        absl::StrFormat("Invalid input index: %d", graph_input_index));
+  }
   auto neuron_memory_info =
       device_context_->GetNeuronMemoryInfo(tensor_buffer_handle);
   if (!neuron_memory_info) {
     return litert::Error(neuron_memory_info.Error());
   }
 
+  // The execution keeps the memory it was given until it is replaced.
+  auto& bound_input = bound_inputs_[graph_input_index];
+  if (bound_input == neuron_memory_info->registration_id) {
+    return {};
+  }
   if (neuron_adapter_api_.api().execution_set_input_from_memory(
           execution_, graph_input_index, nullptr,
           neuron_memory_info->neuron_memory, neuron_memory_info->offset,
           neuron_memory_info->size) != NEURON_NO_ERROR) {
+    bound_input.reset();
     return litert::Error(kLiteRtStatusErrorRuntimeFailure,
                          "Failed to set execution input from memory");
   }
+  bound_input = neuron_memory_info->registration_id;
   return {};
 }
 
 Expected<void> LiteRtDispatchInvocationContextT::AttachOutput(
     int graph_output_index, LiteRtTensorBufferHandle tensor_buffer_handle) {
+  if (graph_output_index < 0 ||
+      graph_output_index >= bound_outputs_.size()) {
+    return litert::Error(
+        kLiteRtStatusErrorInvalidArgument,
+        absl::StrFormat("Invalid output index: %d", graph_output_index));
+  }
   auto neuron_memory_info =
       device_context_->GetNeuronMemoryInfo(tensor_buffer_handle);
   if (!neuron_memory_info) {
     return litert::Error(neuron_memory_info.Error());
   }
 
+  // The execution keeps the memory it was given until it is replaced.
+  auto& bound_output = bound_outputs_[graph_output_index];
+  if (bound_output == neuron_memory_info->registration_id) {
+    return {};
+  }
   if (neuron_adapter_api_.api().execution_set_output_from_memory(
           execution_, graph_output_index, nullptr,
           neuron_memory_info->neuron_memory, neuron_memory_info->offset,
           neuron_memory_info->size) != NEURON_NO_ERROR) {
+    bound_output.reset();
     return litert::Error(kLiteRtStatusErrorRuntimeFailure,
                          "Failed to set execution output from memory");
   }
+  bound_output = neuron_memory_info->registration_id;
   return {};
 }
 
@@ -498,6 +593,9 @@ Expected<void> LiteRtDispatchInvocationContextT::DetachOutput(
 }
 
 Expected<void> LiteRtDispatchInvocationContextT::Invoke() {
+  LITERT_PERFETTO_TRACE_DEVICE_EVENT(
+      kDeviceTrackName, litert::internal::GetPerfettoFlowId(this),
+      "LiteRT::Dispatch[execute]", litert::internal::GetPerfettoFlowId(this));
   if (neuron_adapter_api_.api().execution_compute(execution_) !=
       NEURON_NO_ERROR) {
     return litert::Error(kLiteRtStatusErrorRuntimeFailure,
@@ -505,3 +603,28 @@ Expected<void> LiteRtDispatchInvocationContextT::Invoke() {
   }
   return {};
 }
+
+Expected<void> LiteRtDispatchInvocationContextT::InvokeBatch(
+    absl::Span<const LiteRtDispatchInvocationBuffers> invocations) {
+  // The Neuron memory of the tensor buffers is created when they are
+  // registered, so that switching buffers between two executions only updates
+  // the execution I/Os that changed.
+  for (const auto& invocation : invocations) {
+    if (invocation.num_inputs != static_cast<int>(bound_inputs_.size()) ||
+        invocation.num_outputs != static_cast<int>(bound_outputs_.size())) {
+      return litert::Error(kLiteRtStatusErrorInvalidArgument,
+                           "Invocation buffers don't match the graph I/Os");
+    }
+  }
+
+  for (const auto& invocation : invocations) {
+    for (int i = 0; i < invocation.num_inputs; ++i) {
+      LITERT_RETURN_IF_ERROR(AttachInput(i, invocation.inputs[i]));
+    }
+    for (int i = 0; i < invocation.num_outputs; ++i) {
+      LITERT_RETURN_IF_ERROR(AttachOutput(i, invocation.outputs[i]));
+    }
+    LITERT_RETURN_IF_ERROR(Invoke());
+  }
+  return {};
+}
@@ -15,9 +15,14 @@
 #ifndef ODML_LITERT_LITERT_VENDORS_MEDIATEK_DISPATCH_LITERT_DISPATCH_INVOCATION_CONTEXT_H_
 #define ODML_LITERT_LITERT_VENDORS_MEDIATEK_DISPATCH_LITERT_DISPATCH_INVOCATION_CONTEXT_H_
 
+#include <cstdint>
+#include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include "neuron/api/NeuronAdapter.h"
+#include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/litert_model.h"
 #include "litert/c/litert_tensor_buffer_requirements.h"
 #include "litert/cc/litert_expected.h"
@@ -55,6 +60,12 @@ class LiteRtDispatchInvocationContextT {
 
   litert::Expected<void> Invoke();
 
+  // Runs one execution for each element of `invocations`, setting the given
+  // tensor buffers as execution I/Os before each one. The execution I/Os are
+  // left set to the tensor buffers of the last invocation.
+  litert::Expected<void> InvokeBatch(
+      absl::Span<const LiteRtDispatchInvocationBuffers> invocations);
+
  private:
   class IoRequirementsBuilder {
    public:
@@ -69,19 +80,26 @@ class LiteRtDispatchInvocationContextT {
 
   LiteRtDispatchInvocationContextT(
       const litert::mediatek::NeuronAdapterApi& neuron_adapter_api,
-      LiteRtDispatchDeviceContext device_context, NeuronModel* model,
+      LiteRtDispatchDeviceContext device_context,
+      std::vector<uint8_t> cached_network, NeuronModel* model,
       NeuronCompilation* compilation, NeuronExecution* execution,
       int num_inputs, int num_outputs)
       : neuron_adapter_api_(neuron_adapter_api),
         device_context_(device_context),
+        cached_network_(std::move(cached_network)),
         model_(model),
         compilation_(compilation),
         execution_(execution),
         input_requirements_builders_(num_inputs),
-        output_requirements_builders_(num_outputs) {}
+        output_requirements_builders_(num_outputs),
+        bound_inputs_(num_inputs),
+        bound_outputs_(num_outputs) {}
 
   const litert::mediatek::NeuronAdapterApi& neuron_adapter_api_;
   LiteRtDispatchDeviceContext device_context_;
+  // The compiled network loaded from the device context cache, if any, which
+  // the model has been restored from.
+  std::vector<uint8_t> cached_network_;
   NeuronModel* model_;
   NeuronCompilation* compilation_;
   NeuronExecution* execution_;
@@ -89,6 +107,10 @@ class LiteRtDispatchInvocationContextT {
       input_requirements_builders_;
   std::vector<std::unique_ptr<IoRequirementsBuilder>>
       output_requirements_builders_;
+  // Registration ids of the Neuron memory set as execution I/Os, so that
+  // attaching the same tensor buffers again doesn't update the execution.
+  std::vector<std::optional<uint64_t>> bound_inputs_;
+  std::vector<std::optional<uint64_t>> bound_outputs_;
 };
 
 #endif  // ODML_LITERT_LITERT_VENDORS_MEDIATEK_DISPATCH_LITERT_DISPATCH_INVOCATION_CONTEXT_H_
@@ -205,7 +205,8 @@ bool HtpBackend::Init(const Options& options,
     QNN_LOG_INFO("Set HTP performance mode: %d",
                  options.GetHtpPerformanceMode());
     perf_control_ = std::make_unique<PerfControl>(
-        QnnApi(), options.GetHtpPerformanceMode());
+        QnnApi(), options.GetHtpPerformanceMode(),
+        options.GetHtpLatencySloUs());
     if (!local_qnn_device_platform_info) {
       QNN_LOG_WARNING(
           "The platforminfo is not available, using default performance mode.");
@@ -230,4 +231,16 @@ bool HtpBackend::Init(const Options& options,
   return true;
 }
 
+void HtpBackend::OnExecuteBegin() {
+  if (perf_control_) {
+    perf_control_->OnExecuteBegin();
+  }
+}
+
+void HtpBackend::OnExecuteEnd() {
+  if (perf_control_) {
+    perf_control_->OnExecuteEnd();
+  }
+}
+
 }  // namespace qnn
@@ -51,6 +51,9 @@ class HtpBackend : public QnnBackend {
 
   ::qnn::SocInfo GetSocInfo() { return soc_info_; }
 
+  void OnExecuteBegin() override;
+  void OnExecuteEnd() override;
+
  private:
   QnnHtpDevice_CustomConfig_t& AllocateHtpDeviceConfig() {
     auto& back = htp_device_configs_.emplace_back();
@@ -3,11 +3,14 @@
 
 #include "litert/vendors/qualcomm/core/backends/htp_perf_control.h"
 
+#include <chrono>  // NOLINT
 #include <cstdint>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <vector>
 
 #include "absl/base/attributes.h"  // from @com_google_absl
+#include "litert/vendors/qualcomm/core/backends/htp_perf_governor.h"
 #include "litert/vendors/qualcomm/core/common.h"
 #include "litert/vendors/qualcomm/core/utils/log.h"
 #include "HTP/QnnHtpDevice.h"  // from @qairt
@@ -29,6 +32,12 @@ constexpr int kDcvsEnable = 1;
 constexpr int kRpcControlLatency = 0;
 // default rpc polling time for high power modes - 9999 us
 constexpr int kRpcPollingTimeHighPower = 9999;
+
+std::int64_t NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
 }  // namespace
 
 bool GetPerfInfra(const QNN_INTERFACE_VER_TYPE* api,
@@ -283,9 +292,13 @@ struct PerfControl::BackendConfig {
 };
 
 PerfControl::PerfControl(const QNN_INTERFACE_VER_TYPE* api,
-                         const ::qnn::HtpPerformanceMode htp_performance_mode)
+                         const ::qnn::HtpPerformanceMode htp_performance_mode,
+                         const std::uint32_t latency_slo_us)
     : api_(api), performance_mode_(htp_performance_mode) {
   backend_config_ = std::make_unique<BackendConfig>();
+  if (latency_slo_us != 0 && IsPerfModeEnabled()) {
+    governor_.emplace(latency_slo_us);
+  }
 }
 
 PerfControl::~PerfControl() = default;
@@ -324,6 +337,36 @@ void PerfControl::PerformanceVote() {
   }
 };
 
+void PerfControl::PerformanceDownVote() {
+  if (IsPerfModeEnabled() && manual_voting_type_ == kUpVote &&
+      !backend_config_->down_vote_power_configs_ptr_.empty()) {
+    backend_config_->htp_perf_infra_->setPowerConfig(
+        powerconfig_client_id_,
+        backend_config_->down_vote_power_configs_ptr_.data());
+    manual_voting_type_ = kDownVote;
+  }
+}
+
+void PerfControl::OnExecuteBegin() {
+  if (!governor_ || backend_config_->htp_perf_infra_ == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(governor_mutex_);
+  if (governor_->OnExecuteBegin(NowUs())) {
+    PerformanceVote();
+  }
+}
+
+void PerfControl::OnExecuteEnd() {
+  if (!governor_ || backend_config_->htp_perf_infra_ == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(governor_mutex_);
+  if (governor_->OnExecuteEnd(NowUs())) {
+    PerformanceDownVote();
+  }
+}
+
 std::vector<QnnHtpPerfInfrastructure_PowerConfig_t> SetRpcPollingPowerConfig(
     ::qnn::HtpPerformanceMode perf_mode) {
   std::vector<QnnHtpPerfInfrastructure_PowerConfig_t> power_configs;
@@ -397,8 +440,11 @@ bool PerfControl::Init(const QnnHtpDevice_Arch_t& arch) {
       return false;
     }
 
-    // vote immediately, which only take effects in manual mode.
-    PerformanceVote();
+    // vote immediately, which only take effects in manual mode. With a
+    // latency target, the governor votes before the first execution instead.
+    if (!governor_) {
+      PerformanceVote();
+    }
 
     // Set Rpc polling mode
     if (arch >= QNN_HTP_DEVICE_ARCH_V69) {
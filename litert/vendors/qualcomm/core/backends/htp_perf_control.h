@@ -6,9 +6,12 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>  // NOLINT
+#include <optional>
 #include <type_traits>
 #include <vector>
 
+#include "litert/vendors/qualcomm/core/backends/htp_perf_governor.h"
 #include "litert/vendors/qualcomm/core/common.h"
 #include "HTP/QnnHtpDevice.h"  // from @qairt
 #include "QnnInterface.h"  // from @qairt
@@ -32,8 +35,11 @@ enum PerformanceModeVoteType {
 };
 class PerfControl {
  public:
+  // A non-zero `latency_slo_us` lets the votes follow the executions instead
+  // of holding the performance profile for the whole session.
   explicit PerfControl(const QNN_INTERFACE_VER_TYPE* api,
-                       const ::qnn::HtpPerformanceMode htp_performance_mode);
+                       const ::qnn::HtpPerformanceMode htp_performance_mode,
+                       const std::uint32_t latency_slo_us = 0);
   PerfControl(const PerfControl&) = delete;
   PerfControl(PerfControl&&) = delete;
   PerfControl& operator=(const PerfControl&) = delete;
@@ -44,6 +50,12 @@ class PerfControl {
   bool Terminate();
   // Direct vote is only supported in manual mode.
   void PerformanceVote();
+  // Releases the vote of PerformanceVote().
+  void PerformanceDownVote();
+  // Hooks around graph executions, which only take effect when a latency
+  // target is set.
+  void OnExecuteBegin();
+  void OnExecuteEnd();
   bool CreatePerfPowerConfigPtr(const std::uint32_t power_config_id,
                                 const ::qnn::HtpPerformanceMode perf_mode,
                                 const PerformanceModeVoteType vote_type);
@@ -61,6 +73,10 @@ class PerfControl {
   ::qnn::HtpPerformanceMode performance_mode_{
       ::qnn::HtpPerformanceMode::kDefault};
   std::uint32_t device_id_{0};
+  // Guards the votes cast by the governor, since graphs can be executed
+  // concurrently from several invocation contexts.
+  std::mutex governor_mutex_;
+  std::optional<::qnn::HtpPerfGovernor> governor_;
 };
 
 #endif  // ODML_LITERT_LITERT_VENDORS_QUALCOMM_CORE_BACKENDS_HTP_PERF_CONTROL_H_
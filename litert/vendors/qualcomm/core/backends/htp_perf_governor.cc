@@ -0,0 +1,56 @@
+// Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "litert/vendors/qualcomm/core/backends/htp_perf_governor.h"
+
+#include <cstdint>
+
+namespace qnn {
+
+bool HtpPerfGovernor::OnExecuteBegin(std::int64_t now_us) {
+  if (end_us_ >= 0) {
+    gap_us_ = Average(gap_us_, now_us - end_us_);
+  }
+  begin_us_ = now_us;
+
+  bool vote = !boosted_ && (InBurst() || !PowerSaverMeetsSlo());
+  if (vote) {
+    boosted_ = true;
+  }
+  boosted_execution_ = boosted_;
+  return vote;
+}
+
+bool HtpPerfGovernor::OnExecuteEnd(std::int64_t now_us) {
+  if (begin_us_ < 0) {
+    return false;
+  }
+  const std::int64_t latency_us = now_us - begin_us_;
+  if (boosted_execution_) {
+    boosted_latency_us_ = Average(boosted_latency_us_, latency_us);
+  } else {
+    power_saver_latency_us_ = Average(power_saver_latency_us_, latency_us);
+  }
+  begin_us_ = -1;
+  end_us_ = now_us;
+
+  bool release = boosted_ && !InBurst();
+  if (release) {
+    boosted_ = false;
+  }
+  return release;
+}
+
+bool HtpPerfGovernor::InBurst() const {
+  return gap_us_ >= 0 && gap_us_ <= latency_slo_us_;
+}
+
+bool HtpPerfGovernor::PowerSaverMeetsSlo() const {
+  if (power_saver_latency_us_ >= 0) {
+    return power_saver_latency_us_ <= latency_slo_us_;
+  }
+  return boosted_latency_us_ >= 0 &&
+         boosted_latency_us_ * kAssumedPowerSaverSlowdown <= latency_slo_us_;
+}
+
+}  // namespace qnn
@@ -0,0 +1,66 @@
+// Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ODML_LITERT_LITERT_VENDORS_QUALCOMM_CORE_BACKENDS_HTP_PERF_GOVERNOR_H_
+#define ODML_LITERT_LITERT_VENDORS_QUALCOMM_CORE_BACKENDS_HTP_PERF_GOVERNOR_H_
+
+#include <cstdint>
+
+namespace qnn {
+
+// Decides when the performance profile of an HTP session should be voted for
+// and when it can be released, from the timing of graph executions and a
+// target latency per execution.
+//
+// Executions that start within one latency target of the end of the previous
+// one are considered a burst: the performance vote is held for the whole
+// burst and released once the executions are predicted to be further apart.
+// An isolated execution runs on the power saving profile when its latency
+// there is known or expected to meet the target, and is boosted otherwise.
+//
+// Timestamps are in microseconds from an arbitrary steady origin.
+//
+// Note: This class is not thread safe.
+class HtpPerfGovernor {
+ public:
+  // Latency of an execution on the power saving profile relative to the
+  // performance profile, assumed until it has been observed.
+  static constexpr std::uint32_t kAssumedPowerSaverSlowdown = 2;
+
+  explicit HtpPerfGovernor(std::uint32_t latency_slo_us)
+      : latency_slo_us_(latency_slo_us) {}
+
+  // Called right before an execution. Returns true if the performance profile
+  // must be voted for before executing.
+  bool OnExecuteBegin(std::int64_t now_us);
+
+  // Called right after an execution. Returns true if the vote for the
+  // performance profile can be released.
+  bool OnExecuteEnd(std::int64_t now_us);
+
+  bool IsBoosted() const { return boosted_; }
+
+ private:
+  // Exponential moving average with a weight of 1/2 for the new sample, so
+  // that the end of a burst is noticed after a single long gap.
+  static std::int64_t Average(std::int64_t average, std::int64_t sample) {
+    return average < 0 ? sample : (average + sample) / 2;
+  }
+
+  bool InBurst() const;
+  bool PowerSaverMeetsSlo() const;
+
+  const std::uint32_t latency_slo_us_;
+  bool boosted_ = false;
+  bool boosted_execution_ = false;
+  std::int64_t begin_us_ = -1;
+  std::int64_t end_us_ = -1;
+  // Averages are negative until a sample has been recorded.
+  std::int64_t gap_us_ = -1;
+  std::int64_t boosted_latency_us_ = -1;
+  std::int64_t power_saver_latency_us_ = -1;
+};
+
+}  // namespace qnn
+
+#endif  // ODML_LITERT_LITERT_VENDORS_QUALCOMM_CORE_BACKENDS_HTP_PERF_GOVERNOR_H_
@@ -0,0 +1,71 @@
+// Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "litert/vendors/qualcomm/core/backends/htp_perf_governor.h"
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+namespace qnn {
+namespace {
+
+constexpr std::uint32_t kLatencySloUs = 5000;
+constexpr std::int64_t kIdleUs = 1000000;
+
+TEST(HtpPerfGovernorTest, BoostsFirstExecution) {
+  HtpPerfGovernor governor(kLatencySloUs);
+  EXPECT_TRUE(governor.OnExecuteBegin(0));
+  EXPECT_TRUE(governor.IsBoosted());
+  // Nothing is known about the next execution yet.
+  EXPECT_TRUE(governor.OnExecuteEnd(1000));
+  EXPECT_FALSE(governor.IsBoosted());
+}
+
+TEST(HtpPerfGovernorTest, HoldsVoteDuringBurst) {
+  HtpPerfGovernor governor(kLatencySloUs);
+  EXPECT_TRUE(governor.OnExecuteBegin(0));
+  EXPECT_TRUE(governor.OnExecuteEnd(1000));
+
+  // Back to back executions boost once and keep the vote.
+  EXPECT_TRUE(governor.OnExecuteBegin(1500));
+  EXPECT_FALSE(governor.OnExecuteEnd(2500));
+  EXPECT_FALSE(governor.OnExecuteBegin(3000));
+  EXPECT_FALSE(governor.OnExecuteEnd(4000));
+  EXPECT_TRUE(governor.IsBoosted());
+
+  // The vote is released after the burst.
+  EXPECT_FALSE(governor.OnExecuteBegin(4000 + kIdleUs));
+  EXPECT_TRUE(governor.OnExecuteEnd(5000 + kIdleUs));
+  EXPECT_FALSE(governor.IsBoosted());
+}
+
+TEST(HtpPerfGovernorTest, RunsFastIsolatedExecutionsOnPowerSaver) {
+  HtpPerfGovernor governor(kLatencySloUs);
+  EXPECT_TRUE(governor.OnExecuteBegin(0));
+  EXPECT_TRUE(governor.OnExecuteEnd(1000));
+
+  EXPECT_FALSE(governor.OnExecuteBegin(kIdleUs));
+  EXPECT_FALSE(governor.OnExecuteEnd(kIdleUs + 3000));
+  EXPECT_FALSE(governor.OnExecuteBegin(2 * kIdleUs));
+  EXPECT_FALSE(governor.IsBoosted());
+}
+
+TEST(HtpPerfGovernorTest, BoostsIsolatedExecutionsMissingSlo) {
+  HtpPerfGovernor slow_model_governor(kLatencySloUs);
+  EXPECT_TRUE(slow_model_governor.OnExecuteBegin(0));
+  EXPECT_TRUE(slow_model_governor.OnExecuteEnd(4000));
+  // The power saving profile is expected to miss the target.
+  EXPECT_TRUE(slow_model_governor.OnExecuteBegin(kIdleUs));
+
+  HtpPerfGovernor governor(kLatencySloUs);
+  EXPECT_TRUE(governor.OnExecuteBegin(0));
+  EXPECT_TRUE(governor.OnExecuteEnd(2000));
+  EXPECT_FALSE(governor.OnExecuteBegin(kIdleUs));
+  // The power saving profile turned out to miss the target.
+  EXPECT_FALSE(governor.OnExecuteEnd(kIdleUs + 6000));
+  EXPECT_TRUE(governor.OnExecuteBegin(2 * kIdleUs));
+}
+
+}  // namespace
+}  // namespace qnn
@@ -44,6 +44,10 @@ class QnnBackend {
 
   Qnn_LogHandle_t GetLogHandle();
 
+  // Called around each graph execution on the backend.
+  virtual void OnExecuteBegin() {}
+  virtual void OnExecuteEnd() {}
+
  private:
   const QNN_INTERFACE_VER_TYPE* qnn_api_ = nullptr;
   std::list<QnnBackend_Config_t> backend_configs_;
@@ -102,6 +102,14 @@ HtpPerformanceMode Options::GetHtpPerformanceMode() const {
   return htp_performance_mode_;
 }
 
+void Options::SetHtpLatencySloUs(std::uint32_t htp_latency_slo_us) {
+  htp_latency_slo_us_ = htp_latency_slo_us;
+}
+
+std::uint32_t Options::GetHtpLatencySloUs() const {
+  return htp_latency_slo_us_;
+}
+
 void Options::SetDumpTensorIds(const std::vector<std::int32_t>& ids) {
   dump_tensor_ids_ = ids;
 }
@@ -146,6 +154,7 @@ EnableWeightSharing: %v\n\
 UseConvHMX: %v\n\
 UseFoldReLU: %v\n\
 HtpPerformanceMode: %d\n\
+HtpLatencySloUs: %d\n\
 DumpTensorIds: %s\n\
 IrJsonDir: %s\n\
 VtcmSize: %d\n\
@@ -157,8 +166,9 @@ OptimizationLevel: %d\n";  // NOLINT
   return absl::StrFormat(kQnnOptionsDumpFormat, log_level_, profiling_,
                          use_htp_preference_, use_qint16_as_quint16_,
                          enable_weight_sharing_, use_conv_hmx_, use_fold_relu_,
-                         htp_performance_mode_, dump_tensor_ids, ir_json_dir_,
-                         vtcm_size_, num_hvx_threads_, optimization_level_);
+                         htp_performance_mode_, htp_latency_slo_us_,
+                         dump_tensor_ids, ir_json_dir_, vtcm_size_,
+                         num_hvx_threads_, optimization_level_);
 }
 
 QnnLog_Callback_t GetDefaultStdOutLogger() { return DefaultStdOutLogger; }
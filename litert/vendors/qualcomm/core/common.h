@@ -87,6 +87,12 @@ class Options {
   void SetHtpPerformanceMode(HtpPerformanceMode htp_performance_mode);
   HtpPerformanceMode GetHtpPerformanceMode() const;
 
+  // Target latency of a single graph execution. When non-zero, the HTP backend
+  // adapts its performance votes to the observed invocation pattern instead of
+  // holding the performance mode for the whole session.
+  void SetHtpLatencySloUs(std::uint32_t htp_latency_slo_us);
+  std::uint32_t GetHtpLatencySloUs() const;
+
   // for per-layer dump
   void SetDumpTensorIds(const std::vector<std::int32_t>& ids);
   std::vector<std::int32_t> GetDumpTensorIds() const;
@@ -115,6 +121,7 @@ class Options {
   bool use_conv_hmx_ = true;
   bool use_fold_relu_ = true;
   HtpPerformanceMode htp_performance_mode_ = HtpPerformanceMode::kDefault;
+  std::uint32_t htp_latency_slo_us_ = 0;
   std::vector<std::int32_t> dump_tensor_ids_;
   std::string ir_json_dir_;
   std::uint32_t vtcm_size_ = 0;
@@ -159,6 +159,14 @@ TEST(QnnOptionTest, SetVtcmSize) {
   EXPECT_EQ(options.GetVtcmSize(), 0);
 }
 
+TEST(QnnOptionTest, SetHtpLatencySloUs) {
+  Options options;
+  options.SetHtpLatencySloUs(5000);
+  EXPECT_EQ(options.GetHtpLatencySloUs(), 5000);
+  options.SetHtpLatencySloUs(0);
+  EXPECT_EQ(options.GetHtpLatencySloUs(), 0);
+}
+
 TEST(QnnOptionTest, SetHvxThread) {
   Options options;
   options.SetNumHvxThreads(4);
@@ -191,6 +199,7 @@ TEST(QnnOptionTest, Default) {
   EXPECT_TRUE(options.GetUseConvHMX());
   EXPECT_TRUE(options.GetUseFoldReLU());
   EXPECT_EQ(options.GetHtpPerformanceMode(), HtpPerformanceMode::kDefault);
+  EXPECT_EQ(options.GetHtpLatencySloUs(), 0);
   EXPECT_TRUE(options.GetIrJsonDir().empty());
   EXPECT_EQ(options.GetVtcmSize(), 0);
   EXPECT_EQ(options.GetNumHvxThreads(), 0);
@@ -6,6 +6,7 @@
 #include <fstream>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_set.h"  // from @com_google_absl
@@ -252,6 +253,41 @@ nlohmann::json SerializeOpToJson(const Qnn_OpConfig_t& op_config) {
   return qnn_node_json;
 }
 
+nlohmann::json SerializeOpSignatureToJson(const Qnn_OpConfig_t& op_config) {
+  auto serialize_tensor = [](const Qnn_TensorV1_t& qnn_tensor) {
+    nlohmann::json qnn_tensor_json = SerializeTensorToJson(qnn_tensor);
+    qnn_tensor_json.erase("id");
+    return qnn_tensor_json;
+  };
+  nlohmann::json signature;
+  signature["package"] =
+      op_config.v1.packageName ? op_config.v1.packageName : "";
+  signature["type"] = op_config.v1.typeName;
+  signature["inputs"] = nlohmann::json::array();
+  for (uint32_t i = 0; i < op_config.v1.numOfInputs; ++i) {
+    signature["inputs"].emplace_back(
+        serialize_tensor(op_config.v1.inputTensors[i].v1));
+  }
+  signature["outputs"] = nlohmann::json::array();
+  for (uint32_t i = 0; i < op_config.v1.numOfOutputs; ++i) {
+    signature["outputs"].emplace_back(
+        serialize_tensor(op_config.v1.outputTensors[i].v1));
+  }
+  signature["params"] = nlohmann::json::array();
+  for (uint32_t i = 0; i < op_config.v1.numOfParams; ++i) {
+    const Qnn_Param_t& param = op_config.v1.params[i];
+    nlohmann::json param_json = {{"name", param.name}};
+    if (param.paramType == QNN_PARAMTYPE_SCALAR) {
+      param_json["scalar"] = SerializeScalarParamToJson(param.scalarParam);
+    } else if (param.paramType == QNN_PARAMTYPE_TENSOR) {
+      param_json["tensor"] = serialize_tensor(param.tensorParam.v1);
+      param_json["data"] = SerializeTensorParamToJson(param.tensorParam.v1);
+    }
+    signature["params"].emplace_back(std::move(param_json));
+  }
+  return signature;
+}
+
 void DumpIrJson(
     const absl::flat_hash_set<const TensorWrapper*>& tensor_wrappers,
     std::vector<OpWrapper>& graph_op_wrappers, std::string_view json_dir,
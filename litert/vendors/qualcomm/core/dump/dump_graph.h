@@ -20,6 +20,11 @@ nlohmann::json SerializeScalarParamToJson(const Qnn_Scalar_t& scalar);
 nlohmann::json SerializeTensorParamToJson(const Qnn_TensorV1_t& qnn_tensor);
 nlohmann::json SerializeOpToJson(const Qnn_OpConfig_t& op_config);
 
+// Serializes what the validation of `op_config` depends on: its type, params
+// and the types, shapes and quantization of its tensors, but not their names
+// and ids. Ops of equal signatures are validated the same way by the backend.
+nlohmann::json SerializeOpSignatureToJson(const Qnn_OpConfig_t& op_config);
+
 void DumpIrJson(
     const absl::flat_hash_set<const TensorWrapper*>& tensor_wrappers,
     std::vector<OpWrapper>& graph_op_wrappers, std::string_view json_dir,
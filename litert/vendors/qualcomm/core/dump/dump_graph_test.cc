@@ -56,6 +56,37 @@ TEST(IrJsonDump, SerializeOpToJson) {
   EXPECT_EQ(qnn_op["type"], "MatMul");
 }
 
+TEST(IrJsonDump, SerializeOpSignatureToJson) {
+  TensorPool tensor_pool;
+  QuantizeParamsWrapperVariant quant_param;
+  quant_param.emplace<ScaleOffsetQuantizeParamsWrapper>(0.001, 0);
+
+  auto build_matmul = [&](uint32_t rows) {
+    auto& input0 = tensor_pool.CreateNativeTensor(
+        QNN_DATATYPE_SFIXED_POINT_16, quant_param, {1, 1, rows, 256});
+    auto& input1 = tensor_pool.CreateNativeTensor(
+        QNN_DATATYPE_SFIXED_POINT_16, quant_param, {1, 1, 1280, 256});
+    auto& output0 = tensor_pool.CreateNativeTensor(
+        QNN_DATATYPE_SFIXED_POINT_16, quant_param, {1, 1, rows, 1280});
+    return BuildMatmulOp(tensor_pool, {input0, input1}, {output0}, false,
+                         true);
+  };
+  auto matmul0 = build_matmul(512);
+  auto matmul1 = build_matmul(512);
+  auto matmul2 = build_matmul(64);
+
+  // The signatures ignore the names and ids of the tensors.
+  const nlohmann::json signature0 =
+      SerializeOpSignatureToJson(matmul0[0].GetOpConfig());
+  EXPECT_EQ(signature0,
+            SerializeOpSignatureToJson(matmul1[0].GetOpConfig()));
+  EXPECT_NE(signature0,
+            SerializeOpSignatureToJson(matmul2[0].GetOpConfig()));
+  EXPECT_EQ(signature0["type"], "MatMul");
+  EXPECT_EQ(signature0["inputs"].size(), 2u);
+  EXPECT_FALSE(signature0["inputs"][0].contains("id"));
+}
+
 TEST(IrJsonDump, SerializeQuantParamToJson) {
   const Qnn_QuantizeParams_t quant_params = {
       QNN_DEFINITION_DEFINED,                 /*encodingDefinition*/
@@ -4,12 +4,14 @@
 #ifndef ODML_LITERT_LITERT_VENDORS_QUALCOMM_CORE_TENSOR_POOL_H_
 #define ODML_LITERT_LITERT_VENDORS_QUALCOMM_CORE_TENSOR_POOL_H_
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <list>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -85,6 +87,44 @@ class TensorPool {
 
 namespace {
 
+// Whether every value of Src can be represented by Dst, in which case the
+// conversion needs no range check.
+template <typename Src, typename Dst>
+constexpr bool IsRangeCovered() {
+  if constexpr (std::is_same_v<Src, bool>) {
+    return true;
+  } else if constexpr (std::is_integral_v<Src> && std::is_integral_v<Dst>) {
+    if constexpr (std::is_signed_v<Src> == std::is_signed_v<Dst>) {
+      return sizeof(Dst) >= sizeof(Src);
+    } else {
+      return std::is_unsigned_v<Src> && sizeof(Dst) > sizeof(Src);
+    }
+  } else if constexpr (std::is_integral_v<Src>) {
+    // Integers of up to 64 bits are in the range of floating point types.
+    return std::is_floating_point_v<Dst>;
+  } else {
+    return std::is_floating_point_v<Dst> && sizeof(Dst) >= sizeof(Src);
+  }
+}
+
+template <typename Dst, typename Src>
+bool IsInRange(Src value) {
+  if constexpr (std::is_integral_v<Src> && std::is_integral_v<Dst> &&
+                std::is_signed_v<Src> != std::is_signed_v<Dst>) {
+    // Compare in the unsigned type to avoid sign conversions.
+    if constexpr (std::is_signed_v<Src>) {
+      return value >= 0 && static_cast<std::make_unsigned_t<Src>>(value) <=
+                               std::numeric_limits<Dst>::max();
+    } else {
+      return value <= static_cast<std::make_unsigned_t<Dst>>(
+                          std::numeric_limits<Dst>::max());
+    }
+  } else {
+    return !(value > std::numeric_limits<Dst>::max() ||
+             value < std::numeric_limits<Dst>::lowest());
+  }
+}
+
 template <typename Src, typename Dst>
 bool FillData(const TensorWrapper& src_tensor, std::vector<Dst>& dst_data) {
   const auto src_data = src_tensor.GetTensorData<Src>();
@@ -92,20 +132,26 @@ bool FillData(const TensorWrapper& src_tensor, std::vector<Dst>& dst_data) {
     QNN_LOG_ERROR("Failed to get static tensor data when filling data.");
     return false;
   }
+  // The range check below dereferences the min and max elements.
+  if (src_data->empty()) {
+    QNN_LOG_ERROR("No element in static tensor data when filling data.");
+    return false;
+  }
 
   dst_data.clear();
-  dst_data.reserve(src_data->size());
-  for (size_t i = 0; i < src_data->size(); ++i) {
-    if ((*src_data)[i] > std::numeric_limits<Dst>::max() ||
-        (*src_data)[i] < std::numeric_limits<Dst>::lowest()) {
+  if constexpr (!IsRangeCovered<Src, Dst>()) {
+    // Check the range of the whole buffer at once rather than per element.
+    const auto [min, max] =
+        std::minmax_element(src_data->begin(), src_data->end());
+    if (!IsInRange<Dst>(*min) || !IsInRange<Dst>(*max)) {
       QNN_LOG_ERROR("Source data exceeds the range of destination data type.");
-
-      dst_data.clear();
       return false;
     }
-
-    dst_data.emplace_back((*src_data)[i]);
   }
+  // A plain element-wise conversion which the compiler can vectorize.
+  dst_data.resize(src_data->size());
+  std::transform(src_data->begin(), src_data->end(), dst_data.begin(),
+                 [](Src value) { return static_cast<Dst>(value); });
   return true;
 }
 
@@ -119,10 +165,27 @@ TensorWrapper* TensorPool::ConvertStaticTensorFrom(
     return nullptr;
   }
 
+  const auto id = tensor_wrappers_.size();
+  auto tensor_name = std::to_string(id) + kQnnSuffix;
+  const auto src_data_type = src_tensor.GetDataType();
+  if (src_data_type == GetQnnDataType<T>(src_tensor.IsQuant()) &&
+      src_tensor.owned_data_.empty()) {
+    // No conversion is needed and the source is a view of memory outliving
+    // the tensor pool, e.g. the weights of the model: alias it.
+    if (!src_tensor.GetTensorData<T>().has_value()) {
+      QNN_LOG_ERROR("Failed to get static tensor data when aliasing data.");
+      return nullptr;
+    }
+    return &tensor_wrappers_.emplace_back(
+        std::move(tensor_name), QNN_TENSOR_TYPE_STATIC, src_data_type,
+        src_tensor.GetQuantParams(), src_tensor.GetDims(),
+        src_tensor.qnn_tensor_.v2.clientBuf.dataSize,
+        src_tensor.qnn_tensor_.v2.clientBuf.data, /*copy_data=*/false);
+  }
+
   std::vector<T> dst_data{};
   bool fill_result = true;
-  if (const auto src_data_type = src_tensor.GetDataType();
-      src_data_type == QNN_DATATYPE_BOOL_8) {
+  if (src_data_type == QNN_DATATYPE_BOOL_8) {
     fill_result = FillData<bool, T>(src_tensor, dst_data);
   } else if (src_data_type == QNN_DATATYPE_INT_8 ||
              src_data_type == QNN_DATATYPE_SFIXED_POINT_8) {
@@ -158,8 +221,6 @@ TensorWrapper* TensorPool::ConvertStaticTensorFrom(
   if (!fill_result) {
     return nullptr;
   }
-  const auto id = tensor_wrappers_.size();
-  auto tensor_name = std::to_string(id) + kQnnSuffix;
   auto& back = tensor_wrappers_.emplace_back(
       std::move(tensor_name), QNN_TENSOR_TYPE_STATIC,
       GetQnnDataType<T>(src_tensor.IsQuant()), src_tensor.GetQuantParams(),
@@ -46,6 +46,38 @@ TEST(TensorPoolConvertStaticTensorTest, ExceedRangeAndFailToConvert) {
   ASSERT_EQ(res, nullptr);
 }
 
+TEST(TensorPoolConvertStaticTensorTest, NegativeToUnsignedFailsToConvert) {
+  TensorPool tensor_pool;
+
+  std::vector<std::int32_t> tensor_data{0, -1};
+  auto& tensor_wrapper = tensor_pool.CreateStaticTensor(
+      QNN_DATATYPE_INT_32, QuantizeParamsWrapperVariant{}, {2},
+      sizeof(decltype(tensor_data)::value_type) * tensor_data.size(),
+      tensor_data.data());
+
+  auto* res =
+      tensor_pool.ConvertStaticTensorFrom<std::uint32_t>(tensor_wrapper);
+  ASSERT_EQ(res, nullptr);
+}
+
+TEST(TensorPoolConvertStaticTensorTest, SameTypeConversionAliasesView) {
+  TensorPool tensor_pool;
+
+  std::vector<std::int8_t> tensor_data{0, 1, 2, 3, 4, 5};
+  auto& tensor_wrapper = tensor_pool.CreateStaticTensorWithSuffix(
+      QNN_DATATYPE_INT_8, QuantizeParamsWrapperVariant{}, {1, 2, 3}, "_view",
+      sizeof(decltype(tensor_data)::value_type) * tensor_data.size(),
+      tensor_data.data(), /*copy_data=*/false);
+
+  auto* res = tensor_pool.ConvertStaticTensorFrom<std::int8_t>(tensor_wrapper);
+  ASSERT_NE(res, nullptr);
+
+  auto converted_data = res->GetTensorData<std::int8_t>();
+  ASSERT_TRUE(converted_data.has_value());
+  EXPECT_EQ(converted_data->data(), tensor_data.data());
+  EXPECT_EQ(converted_data->size(), tensor_data.size());
+}
+
 TEST(TensorPoolConvertStaticTensorTest, SameTypeConversionFloat32) {
   TensorPool tensor_pool;
 
@@ -10,6 +10,7 @@
 #include "litert/vendors/qualcomm/core/op_code.h"
 #include "litert/vendors/qualcomm/core/tensor_pool.h"
 #include "litert/vendors/qualcomm/core/transformation/embedding_gemma.h"
+#include "litert/vendors/qualcomm/core/transformation/kv_cache_update.h"
 #include "litert/vendors/qualcomm/core/transformation/mask.h"
 #include "litert/vendors/qualcomm/core/transformation/matmul_convert.h"
 #include "litert/vendors/qualcomm/core/transformation/mha_to_sha.h"
@@ -167,6 +168,16 @@ void GraphToGraphTransform(const G2GConfig g2g_option,
   Transform(validate_op_config, ops, tensor_pool, gemma3_mask,
             TransformQuantizeInMask);
 
+  // KV Cache Update Optimization
+  const std::vector<QnnOpCode> kv_cache_update = {
+      QnnOpCode::kReduceSum,
+      QnnOpCode::kElementWiseNotEqual,
+      QnnOpCode::kReshape,
+      QnnOpCode::kElementWiseSelect,
+  };
+  Transform(validate_op_config, ops, tensor_pool, kv_cache_update,
+            TransformKvCacheUpdate);
+
   // Embedding Gemma Optimization
   const std::vector<QnnOpCode> embedding_gemma = {
       QnnOpCode::kElementWiseMultiply,
@@ -8,12 +8,14 @@
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <optional>
 #include <variant>
 #include <vector>
 
 #include <gtest/gtest.h>
 #include "litert/vendors/qualcomm/core/builders/cast_op_builder.h"
 #include "litert/vendors/qualcomm/core/builders/concatenation_op_builder.h"
+#include "litert/vendors/qualcomm/core/builders/dynamic_update_slice_op_builder.h"
 #include "litert/vendors/qualcomm/core/builders/elementwise_op_builder.h"
 #include "litert/vendors/qualcomm/core/builders/matmul_op_builder.h"
 #include "litert/vendors/qualcomm/core/builders/quantize_op_builder.h"
@@ -1285,5 +1287,210 @@ TEST(MHAOptimization, AttentionWithSelect) {
   ASSERT_TRUE(op_wrappers[41].IsOpCode(QnnOpCode::kPack));
 }
 
+TEST(KvCacheUpdateTest, Gemma3Decode) {
+  // G2G Test case:
+  //
+  // ----- Before -----
+  //     Cache  Update  Indices
+  //       |      |        |
+  //       |      |    ReduceSum
+  //       |      |        |
+  //       |      |     NotEqual
+  //       |      |        |
+  //       |      |     Reshape
+  //        \     |     /
+  //           Select
+  //             |
+  //            Out
+  //
+  // ----- After -----
+  //     Cache  Update  Indices
+  //       |      |        |
+  //       |      |    ReduceSum
+  //       |      |        |
+  //       |      |      Concat
+  //       |      |        |
+  //       |      |     Reshape
+  //        \     |     /
+  //          ScatterNd
+  //             |
+  //            Out
+  //
+  static const std::vector<uint32_t> kCacheDims{1, 1280, 1, 256};
+  static const std::vector<uint32_t> kUpdateDims{1, 1, 1, 256};
+  std::vector<OpWrapper> op_wrappers;
+  TensorPool tensor_pool;
+
+  QuantizeParamsWrapperVariant quant_param;
+  quant_param.emplace<ScaleOffsetQuantizeParamsWrapper>(1e-4f, 0);
+  auto& cache = tensor_pool.CreateNativeTensor(QNN_DATATYPE_SFIXED_POINT_16,
+                                               quant_param, kCacheDims);
+  auto& update = tensor_pool.CreateNativeTensor(QNN_DATATYPE_SFIXED_POINT_16,
+                                                quant_param, kUpdateDims);
+  auto& indices = tensor_pool.CreateNativeTensor(QNN_DATATYPE_INT_32, {}, {4});
+  auto& output = tensor_pool.CreateNativeTensor(QNN_DATATYPE_SFIXED_POINT_16,
+                                                quant_param, kCacheDims);
+  auto dus_ops = BuildDynamicUpdateSliceOp(tensor_pool,
+                                           {cache, update, indices}, {output});
+  ASSERT_EQ(dus_ops.size(), 4);
+  std::move(dus_ops.begin(), dus_ops.end(), std::back_inserter(op_wrappers));
+
+  GraphToGraphTransform(G2GConfig::kMHAOptPrefill, op_wrappers, tensor_pool,
+                        [](OpWrapper& op) { return true; });
+  ASSERT_EQ(op_wrappers.size(), 4);
+  ASSERT_TRUE(op_wrappers[0].IsOpCode(QnnOpCode::kReduceSum));
+  ASSERT_TRUE(op_wrappers[1].IsOpCode(QnnOpCode::kConcat));
+  ASSERT_TRUE(op_wrappers[2].IsOpCode(QnnOpCode::kReshape));
+  ASSERT_TRUE(op_wrappers[3].IsOpCode(QnnOpCode::kScatterNd));
+  EXPECT_EQ(op_wrappers[2].GetOutputTensor(0).GetDims(),
+            (std::vector<uint32_t>{1, 1, 2}));
+  EXPECT_EQ(op_wrappers[3].GetInputTensor(0), cache);
+  EXPECT_EQ(op_wrappers[3].GetInputTensor(1),
+            op_wrappers[2].GetOutputTensor(0));
+  EXPECT_EQ(op_wrappers[3].GetInputTensor(2), update);
+  EXPECT_EQ(op_wrappers[3].GetOutputTensor(0), output);
+}
+
+TEST(KvCacheUpdateTest, RollsBackOnValidationFailure) {
+  static const std::vector<uint32_t> kCacheDims{1, 1280, 1, 256};
+  static const std::vector<uint32_t> kUpdateDims{1, 1, 1, 256};
+  std::vector<OpWrapper> op_wrappers;
+  TensorPool tensor_pool;
+
+  auto& cache =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kCacheDims);
+  auto& update =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kUpdateDims);
+  auto& indices = tensor_pool.CreateNativeTensor(QNN_DATATYPE_INT_32, {}, {4});
+  auto& output =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kCacheDims);
+  auto dus_ops = BuildDynamicUpdateSliceOp(tensor_pool,
+                                           {cache, update, indices}, {output});
+  std::move(dus_ops.begin(), dus_ops.end(), std::back_inserter(op_wrappers));
+
+  GraphToGraphTransform(
+      G2GConfig::kMHAOptPrefill, op_wrappers, tensor_pool,
+      [](OpWrapper& op) { return !op.IsOpCode(QnnOpCode::kScatterNd); });
+  ASSERT_EQ(op_wrappers.size(), 4);
+  ASSERT_TRUE(op_wrappers[3].IsOpCode(QnnOpCode::kElementWiseSelect));
+}
+
+TEST(KvCacheUpdateTest, RewritesEverySelectSharingTheMask) {
+  static const std::vector<uint32_t> kCacheDims{1, 1280, 1, 256};
+  static const std::vector<uint32_t> kUpdateDims{1, 1, 1, 256};
+  std::vector<OpWrapper> op_wrappers;
+  TensorPool tensor_pool;
+
+  auto& k_cache =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kCacheDims);
+  auto& k_update =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kUpdateDims);
+  auto& indices = tensor_pool.CreateNativeTensor(QNN_DATATYPE_INT_32, {}, {4});
+  auto& k_output =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kCacheDims);
+  auto dus_ops = BuildDynamicUpdateSliceOp(
+      tensor_pool, {k_cache, k_update, indices}, {k_output});
+  ASSERT_EQ(dus_ops.size(), 4);
+  std::move(dus_ops.begin(), dus_ops.end(), std::back_inserter(op_wrappers));
+
+  // The V cache update reuses the mask of the K cache update.
+  auto& v_cache =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kCacheDims);
+  auto& v_update =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kUpdateDims);
+  auto& v_output =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kCacheDims);
+  auto select_ops = BuildSelectOp(
+      tensor_pool,
+      {const_cast<TensorWrapper&>(op_wrappers[2].GetOutputTensor(0)), v_cache,
+       v_update},
+      {v_output});
+  std::move(select_ops.begin(), select_ops.end(),
+            std::back_inserter(op_wrappers));
+
+  GraphToGraphTransform(G2GConfig::kMHAOptPrefill, op_wrappers, tensor_pool,
+                        [](OpWrapper& op) { return true; });
+  ASSERT_EQ(op_wrappers.size(), 7);
+  ASSERT_TRUE(op_wrappers[0].IsOpCode(QnnOpCode::kReduceSum));
+  ASSERT_TRUE(op_wrappers[3].IsOpCode(QnnOpCode::kScatterNd));
+  ASSERT_TRUE(op_wrappers[6].IsOpCode(QnnOpCode::kScatterNd));
+  EXPECT_EQ(op_wrappers[3].GetInputTensor(0), k_cache);
+  EXPECT_EQ(op_wrappers[3].GetOutputTensor(0), k_output);
+  EXPECT_EQ(op_wrappers[6].GetInputTensor(0), v_cache);
+  EXPECT_EQ(op_wrappers[6].GetInputTensor(2), v_update);
+  EXPECT_EQ(op_wrappers[6].GetOutputTensor(0), v_output);
+  EXPECT_EQ(op_wrappers[4].GetInputTensor(1),
+            op_wrappers[0].GetOutputTensor(0));
+}
+
+TEST(KvCacheUpdateTest, KeepsMaskWithAnotherConsumer) {
+  static const std::vector<uint32_t> kCacheDims{1, 1280, 1, 256};
+  static const std::vector<uint32_t> kUpdateDims{1, 1, 1, 256};
+  std::vector<OpWrapper> op_wrappers;
+  TensorPool tensor_pool;
+
+  auto& cache =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kCacheDims);
+  auto& update =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kUpdateDims);
+  auto& indices = tensor_pool.CreateNativeTensor(QNN_DATATYPE_INT_32, {}, {4});
+  auto& output =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kCacheDims);
+  auto dus_ops = BuildDynamicUpdateSliceOp(tensor_pool,
+                                           {cache, update, indices}, {output});
+  std::move(dus_ops.begin(), dus_ops.end(), std::back_inserter(op_wrappers));
+
+  // A select of two whole tensors cannot become a row scatter, so the mask
+  // has to stay.
+  auto& other =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kCacheDims);
+  auto& other_output =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kCacheDims);
+  auto select_ops = BuildSelectOp(
+      tensor_pool,
+      {const_cast<TensorWrapper&>(op_wrappers[2].GetOutputTensor(0)), cache,
+       other},
+      {other_output});
+  std::move(select_ops.begin(), select_ops.end(),
+            std::back_inserter(op_wrappers));
+
+  GraphToGraphTransform(G2GConfig::kMHAOptPrefill, op_wrappers, tensor_pool,
+                        [](OpWrapper& op) { return true; });
+  ASSERT_EQ(op_wrappers.size(), 5);
+  ASSERT_TRUE(op_wrappers[1].IsOpCode(QnnOpCode::kElementWiseNotEqual));
+  ASSERT_TRUE(op_wrappers[3].IsOpCode(QnnOpCode::kElementWiseSelect));
+  ASSERT_TRUE(op_wrappers[4].IsOpCode(QnnOpCode::kElementWiseSelect));
+}
+
+TEST(KvCacheUpdateTest, KeepsSelectWithoutPositionRamp) {
+  static const std::vector<uint32_t> kCacheDims{1, 4, 1, 8};
+  static const std::vector<uint32_t> kUpdateDims{1, 1, 1, 8};
+  std::vector<OpWrapper> op_wrappers;
+  TensorPool tensor_pool;
+
+  auto& cache =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kCacheDims);
+  auto& update =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kUpdateDims);
+  auto& indices = tensor_pool.CreateNativeTensor(QNN_DATATYPE_INT_32, {}, {4});
+  auto& output =
+      tensor_pool.CreateNativeTensor(QNN_DATATYPE_FLOAT_32, {}, kCacheDims);
+  auto dus_ops = BuildDynamicUpdateSliceOp(tensor_pool,
+                                           {cache, update, indices}, {output});
+  ASSERT_EQ(dus_ops.size(), 4);
+  std::move(dus_ops.begin(), dus_ops.end(), std::back_inserter(op_wrappers));
+
+  // Compare the row index against something other than [0, 1, 2, 3].
+  const std::array<std::int32_t, 4> kTable{3, 2, 1, 0};
+  auto& table = tensor_pool.CreateStaticTensor(
+      QNN_DATATYPE_INT_32, {}, {4}, sizeof(kTable), kTable.data());
+  op_wrappers[1].UpdateTensors({table, std::nullopt}, {std::nullopt});
+
+  GraphToGraphTransform(G2GConfig::kMHAOptPrefill, op_wrappers, tensor_pool,
+                        [](OpWrapper& op) { return true; });
+  ASSERT_EQ(op_wrappers.size(), 4);
+  ASSERT_TRUE(op_wrappers[3].IsOpCode(QnnOpCode::kElementWiseSelect));
+}
+
 }  // namespace
 }  // namespace qnn
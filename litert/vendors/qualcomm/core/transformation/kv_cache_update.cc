@@ -0,0 +1,211 @@
+// Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "litert/vendors/qualcomm/core/transformation/kv_cache_update.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+#include "litert/vendors/qualcomm/core/builders/concatenation_op_builder.h"
+#include "litert/vendors/qualcomm/core/builders/op_builder.h"
+#include "litert/vendors/qualcomm/core/builders/reshape_op_builder.h"
+#include "litert/vendors/qualcomm/core/op_code.h"
+#include "litert/vendors/qualcomm/core/tensor_pool.h"
+#include "litert/vendors/qualcomm/core/utils/log.h"
+#include "litert/vendors/qualcomm/core/wrappers/op_wrapper.h"
+#include "litert/vendors/qualcomm/core/wrappers/quantize_params_wrapper.h"
+#include "litert/vendors/qualcomm/core/wrappers/tensor_wrapper.h"
+#include "QnnOpDef.h"  // from @qairt
+#include "QnnTypes.h"  // from @qairt
+
+namespace qnn {
+
+namespace {
+
+constexpr size_t kReduceSumIndex = 0;
+constexpr size_t kNotEqualIndex = 1;
+constexpr size_t kReshapeIndex = 2;
+constexpr size_t kSelectIndex = 3;
+
+// Returns true if `update` is a single row of `cache` along dimension 1, the
+// only update the select-based dynamic update slice supports.
+bool IsSingleRowUpdate(const TensorWrapper& cache,
+                       const TensorWrapper& update) {
+  if (cache.GetRank() < 2 || cache.GetRank() != update.GetRank()) {
+    return false;
+  }
+  if (cache.GetDim(0) != 1 || update.GetDim(0) != 1 || update.GetDim(1) != 1) {
+    return false;
+  }
+  for (size_t i = 2; i < cache.GetRank(); ++i) {
+    if (cache.GetDim(i) != update.GetDim(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Builds the ScatterNd writing `update` to `output` at row `row_index` of
+// `cache`:
+//   indices = Reshape(Concat([0], row_index)) -> [1, 1, 2]
+//   output = ScatterNd(cache, indices, update)
+std::vector<OpWrapper> BuildRowScatter(TensorPool& tensor_pool,
+                                       const TensorWrapper& cache,
+                                       const TensorWrapper& update,
+                                       const TensorWrapper& row_index,
+                                       const TensorWrapper& output) {
+  std::vector<OpWrapper> res;
+
+  // const_cast for the builders, can be removed if builders are refined
+  auto& index = const_cast<TensorWrapper&>(row_index);
+  const std::int32_t batch_data = 0;
+  auto& batch_index = tensor_pool.CreateStaticTensor(
+      QNN_DATATYPE_INT_32, QuantizeParamsWrapperVariant{}, {1},
+      sizeof(batch_data), &batch_data);
+  auto& concat_out = tensor_pool.CloneNativeTensorFrom(index, {2});
+  auto concat_ops = BuildConcatenationOp(tensor_pool, {batch_index, index},
+                                         {concat_out}, /*axis=*/0);
+  std::move(concat_ops.begin(), concat_ops.end(), std::back_inserter(res));
+
+  auto& indices = tensor_pool.CloneNativeTensorFrom(index, {1, 1, 2});
+  auto reshape_ops = BuildReshapeOp(tensor_pool, {concat_out}, {indices});
+  std::move(reshape_ops.begin(), reshape_ops.end(), std::back_inserter(res));
+
+  auto& scatter_op = CreateOpWrapper(res, QNN_OP_SCATTER_ND);
+  scatter_op.AddInputTensor(cache);
+  scatter_op.AddInputTensor(indices);
+  scatter_op.AddInputTensor(update);
+  scatter_op.AddOutputTensor(output);
+  return res;
+}
+
+// Returns true if `table` is the static position ramp [0, 1, ..., rows - 1]
+// compared against the row index to build the update mask.
+bool IsPositionRamp(const TensorWrapper& table, std::uint32_t rows) {
+  if (!table.IsTensorStatic() || table.GetDataType() != QNN_DATATYPE_INT_32 ||
+      table.GetRank() != 1 || table.GetDim(0) != rows) {
+    return false;
+  }
+  const auto data = table.GetTensorData<std::int32_t>();
+  if (!data.has_value() || data->size() != rows) {
+    return false;
+  }
+  for (std::uint32_t i = 0; i < rows; ++i) {
+    if ((*data)[i] != static_cast<std::int32_t>(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if `mask` broadcasts the ramp along dimension 1 of `cache`.
+bool IsRowMask(const TensorWrapper& mask, const TensorWrapper& cache) {
+  if (mask.GetDataType() != QNN_DATATYPE_BOOL_8 ||
+      mask.GetRank() + 1 != cache.GetRank() ||
+      mask.GetDim(0) != cache.GetDim(1)) {
+    return false;
+  }
+  for (size_t i = 1; i < mask.GetRank(); ++i) {
+    if (mask.GetDim(i) != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+size_t TransformKvCacheUpdate(
+    std::function<bool(OpWrapper&)> validate_op_config,
+    std::vector<OpWrapper>& ops, size_t start_index, TensorPool& tensor_pool,
+    size_t pattern_size) {
+  const auto& reduce_sum = ops[start_index + kReduceSumIndex];
+  const auto& not_equal = ops[start_index + kNotEqualIndex];
+  const auto& reshape = ops[start_index + kReshapeIndex];
+  const auto& select = ops[start_index + kSelectIndex];
+  // Connection check
+  bool is_connected =
+      reduce_sum.GetOutputTensor(0) == not_equal.GetInputTensor(1) &&
+      not_equal.GetOutputTensor(0) == reshape.GetInputTensor(0) &&
+      reshape.GetOutputTensor(0) == select.GetInputTensor(0);
+  if (!is_connected) {
+    return 1;
+  }
+  const auto& row_index = reduce_sum.GetOutputTensor(0);
+  const auto& cache = select.GetInputTensor(1);
+  const auto& mask_in = not_equal.GetOutputTensor(0);
+  const auto& mask = reshape.GetOutputTensor(0);
+  if (row_index.GetDataType() != QNN_DATATYPE_INT_32 ||
+      row_index.GetTensorNumElements() != 1 ||
+      !IsPositionRamp(not_equal.GetInputTensor(0), cache.GetDim(1)) ||
+      !IsRowMask(mask, cache) || mask_in.IsSubgraphOutput() ||
+      mask.IsSubgraphOutput()) {
+    return 1;
+  }
+  // The mask is erased with the rewrite, so every consumer of it has to be a
+  // select writing a single row of a cache as tall as the ramp, e.g. the K and
+  // V cache updates of one layer sharing the mask.
+  std::vector<size_t> select_indices;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    for (size_t j = 0; j < ops[i].GetNumInputTensors(); ++j) {
+      const auto& input = ops[i].GetInputTensor(j);
+      if (input == mask_in && i != start_index + kReshapeIndex) {
+        return 1;
+      }
+      if (input != mask) {
+        continue;
+      }
+      if (j != 0 || !ops[i].IsOpCode(QnnOpCode::kElementWiseSelect) ||
+          !IsSingleRowUpdate(ops[i].GetInputTensor(1),
+                             ops[i].GetInputTensor(2)) ||
+          ops[i].GetInputTensor(1).GetDim(1) != cache.GetDim(1)) {
+        return 1;
+      }
+      select_indices.emplace_back(i);
+    }
+  }
+  // Graph transform
+  QNN_LOG_INFO("[G2G] KV cache update to ScatterNd, %zu select(s)",
+               select_indices.size());
+  std::vector<std::vector<OpWrapper>> scatters;
+  scatters.reserve(select_indices.size());
+  for (const size_t i : select_indices) {
+    scatters.emplace_back(BuildRowScatter(
+        tensor_pool, ops[i].GetInputTensor(1), ops[i].GetInputTensor(2),
+        row_index, ops[i].GetOutputTensor(0)));
+  }
+  // Validate new graph.
+  bool is_valid = std::all_of(
+      scatters.begin(), scatters.end(),
+      [&validate_op_config](std::vector<OpWrapper>& new_ops) -> bool {
+        return std::all_of(new_ops.begin(), new_ops.end(),
+                           [&validate_op_config](OpWrapper& op_wrapper) {
+                             return validate_op_config(op_wrapper);
+                           });
+      });
+  if (!is_valid) {
+    QNN_LOG_WARNING(
+        "[G2G] Validation failed. Rolling back to the original graph.");
+    return 1;
+  }
+  // Keep the ReduceSum computing the row index and replace every select with
+  // its scatter, back to front so the indices ahead stay valid. The mask ops
+  // precede all of its consumers and go last.
+  size_t step_size = scatters.front().size() + 1;
+  for (size_t k = select_indices.size(); k-- > 0;) {
+    const size_t i = select_indices[k];
+    ops.insert(ops.begin() + i + 1,
+               std::make_move_iterator(scatters[k].begin()),
+               std::make_move_iterator(scatters[k].end()));
+    ops.erase(ops.begin() + i);
+  }
+  ops.erase(ops.begin() + start_index + kNotEqualIndex,
+            ops.begin() + start_index + kSelectIndex);
+  return step_size;
+}
+
+}  // namespace qnn
@@ -27,20 +27,20 @@ static constexpr int kRequiredNumProviders{1};
 typedef Qnn_ErrorHandle_t (*QnnInterfaceGetProvidersFn_t)(
     const QnnInterface_t*** provider_list, uint32_t* num_providers);
 
+// The offset flips are written as indexed loops over preallocated buffers so
+// that they get vectorized, which matters for large weight tensors.
 void ConvertDataFromInt16toUInt16(absl::Span<const std::int16_t> src,
                                   std::vector<std::uint16_t>& dst) {
-  dst.clear();
-  dst.reserve(src.size());
-  for (const auto& data : src) {
-    dst.emplace_back(data + kUint16ZeroPoint);
+  dst.resize(src.size());
+  for (size_t i = 0; i < src.size(); ++i) {
+    dst[i] = static_cast<std::uint16_t>(src[i]) + kUint16ZeroPoint;
   }
 }
 void ConvertDataFromUInt16toInt16(absl::Span<const std::uint16_t> src,
                                   std::vector<std::int16_t>& dst) {
-  dst.clear();
-  dst.reserve(src.size());
-  for (const auto& data : src) {
-    dst.emplace_back(data - kUint16ZeroPoint);
+  dst.resize(src.size());
+  for (size_t i = 0; i < src.size(); ++i) {
+    dst[i] = static_cast<std::int16_t>(src[i] - kUint16ZeroPoint);
   }
 }
 
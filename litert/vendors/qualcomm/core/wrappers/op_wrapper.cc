@@ -105,6 +105,8 @@ bool OpWrapper::IsOpCode(QnnOpCode op_code) const {
   return op_code_ == op_code;
 }
 
+size_t OpWrapper::GetNumInputTensors() const { return input_tensors_.size(); }
+
 const qnn::TensorWrapper& OpWrapper::GetInputTensor(size_t i) const {
   return input_tensors_[i].get();
 }
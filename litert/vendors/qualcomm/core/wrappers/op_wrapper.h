@@ -48,6 +48,8 @@ class OpWrapper final {
 
   bool IsOpCode(QnnOpCode op_code) const;
 
+  size_t GetNumInputTensors() const;
+
   const qnn::TensorWrapper& GetInputTensor(size_t i) const;
 
   const qnn::TensorWrapper& GetOutputTensor(size_t i) const;
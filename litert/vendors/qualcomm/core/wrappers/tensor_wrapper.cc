@@ -248,6 +248,9 @@ void TensorWrapper::ConvertQint16ToQuint16() {
     QNN_LOG_DEBUG("Converting static tensor data from QInt16 to QUint16...");
     std::vector<std::uint16_t> uint16_data;
     ConvertDataFromInt16toUInt16((*int16_data), uint16_data);
+    // Static data aliasing external memory, e.g. the weights of the model, is
+    // converted into a buffer of its own.
+    owned_data_.resize(GetTensorBytes());
     std::memcpy(owned_data_.data(),
                 reinterpret_cast<const char*>(uint16_data.data()),
                 GetTensorBytes());
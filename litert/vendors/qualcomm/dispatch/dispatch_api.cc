@@ -18,13 +18,17 @@
 #include <string>
 #include <utility>
 
+#include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_environment_options.h"
+#include "litert/c/litert_event.h"
+#include "litert/c/litert_event_type.h"
 #include "litert/c/litert_model_types.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
 #include "litert/cc/options/litert_qualcomm_options.h"
+#include "litert/core/util/perfetto_profiling.h"
 #include "litert/vendors/c/litert_dispatch.h"
 #include "litert/vendors/c/litert_dispatch_api.h"
 #include "litert/vendors/cc/options_helper.h"
@@ -56,6 +60,8 @@ char BuildId[256];
 
 LiteRtStatus Initialize(LiteRtEnvironmentOptions environment_options,
                         LiteRtOptions options) {
+  // The dispatch library records its own track events.
+  litert::internal::InitializePerfetto();
   TheEnvironmentOptions = environment_options;
   TheOptions = options;
 
@@ -137,7 +143,9 @@ LiteRtStatus GetBuildId(const char** build_id) {
 }
 
 LiteRtStatus GetCapabilities(int* capabilities) {
-  *capabilities = kLiteRtDispatchCapabilitiesBasic;
+  *capabilities = kLiteRtDispatchCapabilitiesBasic |
+                  kLiteRtDispatchCapabilitiesBatch |
+                  kLiteRtDispatchCapabilitiesSharedWeights;
   return kLiteRtStatusOk;
 }
 
@@ -291,6 +299,30 @@ LiteRtStatus Invoke(LiteRtDispatchInvocationContext invocation_context) {
   return kLiteRtStatusOk;
 }
 
+// /////////////////////////////////////////////////////////////////////////////
+// Batched Execution API
+// /////////////////////////////////////////////////////////////////////////////
+
+LiteRtStatus InvokeBatch(LiteRtDispatchInvocationContext invocation_context,
+                         int num_invocations,
+                         const LiteRtDispatchInvocationBuffers* invocations,
+                         LiteRtEvent* completion_event) {
+  if (auto status = invocation_context->ExecuteBatch(
+          absl::MakeConstSpan(invocations, num_invocations));
+      !status) {
+    LITERT_LOG(LITERT_ERROR, "Failed to execute invocation batch: %s",
+               status.Error().Message().c_str());
+    return status.Error().Status();
+  }
+  // QNN graph executions are synchronous, hence the batch is already done.
+  if (completion_event) {
+    LITERT_RETURN_IF_ERROR(LiteRtCreateManagedEvent(
+        /*env=*/nullptr, LiteRtEventTypeHost, completion_event));
+    LITERT_RETURN_IF_ERROR(LiteRtSignalEvent(*completion_event));
+  }
+  return kLiteRtStatusOk;
+}
+
 // /////////////////////////////////////////////////////////////////////////////
 
 LiteRtDispatchInterface TheInterface = {
@@ -313,6 +345,10 @@ LiteRtDispatchInterface TheInterface = {
     /*.invoke=*/Invoke,
 };
 
+LiteRtDispatchBatchInterface TheBatchInterface = {
+    /*.invoke_batch=*/InvokeBatch,
+};
+
 LiteRtDispatchApi TheApi = {
     /*.version=*/{/*.major=*/LITERT_API_VERSION_MAJOR,
                   /*.minor=*/LITERT_API_VERSION_MINOR,
@@ -320,6 +356,7 @@ LiteRtDispatchApi TheApi = {
     /*.interface=*/&TheInterface,
     /*.async_interface=*/nullptr,
     /*.graph_interface=*/nullptr,
+    /*.batch_interface=*/&TheBatchInterface,
 };
 
 }  // namespace
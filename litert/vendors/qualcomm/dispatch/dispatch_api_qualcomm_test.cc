@@ -29,6 +29,7 @@
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/litert_any.h"
 #include "litert/c/litert_common.h"
+#include "litert/c/litert_event.h"
 #include "litert/c/litert_tensor_buffer.h"
 #include "litert/c/litert_tensor_buffer_requirements.h"
 #include "litert/c/litert_tensor_buffer_types.h"
@@ -42,6 +43,7 @@
 #include "litert/test/testdata/simple_model_test_vectors.h"
 #include "litert/vendors/c/litert_dispatch.h"
 #include "litert/vendors/qualcomm/core/utils/miscs.h"
+#include "litert/vendors/qualcomm/dispatch/litert_dispatch_invocation_context.h"
 
 namespace {
 
@@ -292,6 +294,37 @@ TEST(Qualcomm, DispatchApiWithFastRpc) {
     ASSERT_EQ(LiteRtUnlockTensorBuffer(output_tensor_buffer), kLiteRtStatusOk);
   }
 
+  // ///////////////////////////////////////////////////////////////////////////
+  // Execute model as a batch of invocations.
+  // ///////////////////////////////////////////////////////////////////////////
+
+  if (capabilities & kLiteRtDispatchCapabilitiesBatch) {
+    ABSL_LOG(INFO) << "Invoking batched execution...";
+    const LiteRtTensorBufferHandle input_handles[] = {input_0_handle,
+                                                      input_1_handle};
+    const LiteRtDispatchInvocationBuffers invocations[] = {
+        {2, input_handles, 1, &output_handle},
+        {2, input_handles, 1, &output_handle},
+    };
+    LiteRtEvent completion_event = nullptr;
+    ASSERT_EQ(LiteRtDispatchInvokeBatch(invocation_context,
+                                        /*num_invocations=*/2, invocations,
+                                        &completion_event),
+              kLiteRtStatusOk);
+    ASSERT_EQ(LiteRtWaitEvent(completion_event, /*timeout_in_ms=*/-1),
+              kLiteRtStatusOk);
+    LiteRtDestroyEvent(completion_event);
+
+    void* host_mem_addr;
+    ASSERT_EQ(LiteRtLockTensorBuffer(output_tensor_buffer, &host_mem_addr,
+                                     kLiteRtTensorBufferLockModeRead),
+              kLiteRtStatusOk);
+    auto output = absl::MakeSpan(static_cast<const float*>(host_mem_addr),
+                                 kTestOutputSize);
+    EXPECT_THAT(output, Pointwise(testing::FloatNear(kTol), kTestOutputTensor));
+    ASSERT_EQ(LiteRtUnlockTensorBuffer(output_tensor_buffer), kLiteRtStatusOk);
+  }
+
   // ///////////////////////////////////////////////////////////////////////////
   // Clean up resources.
   // ///////////////////////////////////////////////////////////////////////////
@@ -582,6 +615,63 @@ TEST(Qualcomm, DispatchApiWithDmaBuf) {
             kLiteRtStatusOk);
 }
 
+TEST(Qualcomm, InvocationContextsShareContext) {
+#if !defined(__ANDROID__)
+  GTEST_SKIP()
+      << "This test is specific to Android devices with a Qualcomm NPU";
+#endif
+
+  LITERT_ASSERT_OK_AND_ASSIGN(auto env, CreateDefaultEnvironment());
+  LITERT_ASSERT_OK_AND_ASSIGN(auto env_options, env.GetOptions());
+  LITERT_ASSERT_OK_AND_ASSIGN(auto options, Options::Create());
+
+  ASSERT_EQ(LiteRtDispatchInitialize(env_options.Get(), options.Get()),
+            kLiteRtStatusOk);
+
+  int capabilities;
+  ASSERT_EQ(LiteRtDispatchGetCapabilities(&capabilities), kLiteRtStatusOk);
+  EXPECT_TRUE(capabilities & kLiteRtDispatchCapabilitiesSharedWeights);
+
+  LiteRtDispatchDeviceContext device_context = nullptr;
+  ASSERT_EQ(LiteRtDispatchDeviceContextCreate(&device_context),
+            kLiteRtStatusOk);
+
+  auto model_file_name =
+      litert::testing::GetTestFilePath(kQualcommModelFileName);
+  auto model = litert::internal::LoadBinaryFile(model_file_name);
+  ASSERT_TRUE(model) << model.Error();
+  // A second copy of the context binary, as loaded by another model.
+  std::vector<uint8_t> model_copy(model->Data(),
+                                  model->Data() + model->Size());
+
+  LiteRtMemBuffer exec_bytecode_buffers[] = {
+      {/*.fd=*/-1, /*.base_addr=*/model->Data(), /*.offset=*/0,
+       /*.size=*/model->Size()},
+      {/*.fd=*/-1, /*.base_addr=*/model_copy.data(), /*.offset=*/0,
+       /*.size=*/model_copy.size()},
+  };
+  LiteRtDispatchInvocationContext invocation_contexts[2] = {};
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_EQ(LiteRtDispatchInvocationContextCreate(
+                  device_context, kLiteRtDispatchExecutableTypeMlModel,
+                  &exec_bytecode_buffers[i], /*function_name=*/"simple",
+                  /*num_inputs=*/2, /*num_outputs=*/1,
+                  &invocation_contexts[i]),
+              kLiteRtStatusOk);
+  }
+  EXPECT_EQ(invocation_contexts[0]->ContextHandle(),
+            invocation_contexts[1]->ContextHandle());
+
+  // The shared context outlives the invocation context that created it.
+  EXPECT_EQ(LiteRtDispatchInvocationContextDestroy(invocation_contexts[0]),
+            kLiteRtStatusOk);
+  EXPECT_NE(invocation_contexts[1]->ContextHandle(), nullptr);
+  EXPECT_EQ(LiteRtDispatchInvocationContextDestroy(invocation_contexts[1]),
+            kLiteRtStatusOk);
+  EXPECT_EQ(LiteRtDispatchDeviceContextDestroy(device_context),
+            kLiteRtStatusOk);
+}
+
 TEST(Qualcomm, DispatchApiWithFastRpcInt16Model) {
 #if !defined(__ANDROID__)
   GTEST_SKIP()
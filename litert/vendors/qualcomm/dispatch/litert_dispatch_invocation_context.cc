@@ -26,6 +26,7 @@
 #include <fstream>
 #include <ios>
 #include <iterator>
+#include <memory>
 #include <ostream>
 #include <sstream>
 #include <string>
@@ -43,9 +44,11 @@
 #include "litert/c/litert_tensor_buffer_types.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
+#include "litert/core/util/perfetto_profiling.h"
 #include "litert/core/util/tensor_type_util.h"
 #include "litert/vendors/c/litert_dispatch.h"
 #include "litert/vendors/qualcomm/context_binary_info.h"
+#include "litert/vendors/qualcomm/core/backends/qnn_backend.h"
 #include "litert/vendors/qualcomm/core/common.h"
 #include "litert/vendors/qualcomm/core/utils/miscs.h"
 #include "litert/vendors/qualcomm/core/wrappers/quantize_params_wrapper.h"
@@ -61,6 +64,9 @@ using litert::Expected;
 using litert::Unexpected;
 using litert::qnn::QnnManager;
 
+// The Perfetto track of the work executed by the HTP.
+constexpr char kDeviceTrackName[] = "Qualcomm HTP";
+
 std::string_view inline GetEventUnit(QnnProfile_EventUnit_t unit) {
   switch (unit) {
     case QNN_PROFILE_EVENTUNIT_MICROSEC:
@@ -81,7 +87,7 @@ LiteRtDispatchInvocationContextT::LiteRtDispatchInvocationContextT(
     litert::qnn::QnnManager& qnn_manager,
     const litert::qnn::ContextBinaryInfo& context_binary_info,
     LiteRtDispatchDeviceContextT& device_context,
-    QnnManager::ContextHandle&& context_handle,
+    std::shared_ptr<QnnManager::ContextHandle> context_handle,
     Qnn_ProfileHandle_t profile_handle, int graph_index,
     Qnn_GraphHandle_t graph_handle)
     : qnn_manager_(qnn_manager),
@@ -166,13 +172,22 @@ LiteRtDispatchInvocationContextT::Create(
     }
   }
 
-  auto context_handle = qnn.CreateContextHandle(
-      configs,
-      absl::MakeSpan(static_cast<const uint8_t*>(exec_bytecode_ptr),
-                     exec_bytecode_buffer->size),
-      profile_handle);
-  if (!context_handle) {
-    return Unexpected(context_handle.Error());
+  auto bytecode = absl::MakeSpan(static_cast<const uint8_t*>(exec_bytecode_ptr),
+                                 exec_bytecode_buffer->size);
+  std::shared_ptr<QnnManager::ContextHandle> context_handle;
+  if (profile_handle == nullptr) {
+    // Invocation contexts created from the same context binary, e.g. for each
+    // of the graphs of a weight-shared context binary, share a single context.
+    LITERT_ASSIGN_OR_RETURN(context_handle,
+                            qnn.GetSharedContextHandle(configs, bytecode));
+  } else {
+    // Profile events are collected per context, so profiled invocation
+    // contexts get their own.
+    LITERT_ASSIGN_OR_RETURN(
+        auto owned_context_handle,
+        qnn.CreateContextHandle(configs, bytecode, profile_handle));
+    context_handle = std::make_shared<QnnManager::ContextHandle>(
+        std::move(owned_context_handle));
   }
 
   Qnn_GraphHandle_t graph_handle;
@@ -185,7 +200,7 @@ LiteRtDispatchInvocationContextT::Create(
 
   return Ptr(new LiteRtDispatchInvocationContextT(
       qnn, std::move(*context_binary_info), device_context,
-      std::move(*context_handle), profile_handle, graph_index, graph_handle));
+      std::move(context_handle), profile_handle, graph_index, graph_handle));
 }
 
 namespace {
@@ -337,10 +352,24 @@ Expected<void> LiteRtDispatchInvocationContextT::Execute() {
     *(outputs + i) = outputs_.at(i).GetQnnTensor();
   }
 
-  if (auto status = qnn_manager_.Api()->graphExecute(
-          graph_handle_, inputs, num_ins, outputs, num_outs, profile_handle_,
-          /*signalHandle=*/nullptr);
-      status != QNN_SUCCESS) {
+  ::qnn::QnnBackend* backend = qnn_manager_.Backend();
+  if (backend) {
+    backend->OnExecuteBegin();
+  }
+  Qnn_ErrorHandle_t status;
+  {
+    LITERT_PERFETTO_TRACE_DEVICE_EVENT(
+        kDeviceTrackName, litert::internal::GetPerfettoFlowId(this),
+        "LiteRT::Dispatch[execute]",
+        litert::internal::GetPerfettoFlowId(this));
+    status = qnn_manager_.Api()->graphExecute(
+        graph_handle_, inputs, num_ins, outputs, num_outs, profile_handle_,
+        /*signalHandle=*/nullptr);
+  }
+  if (backend) {
+    backend->OnExecuteEnd();
+  }
+  if (status != QNN_SUCCESS) {
     return Unexpected(kLiteRtStatusErrorRuntimeFailure,
                       "Failed to execute graph");
   }
@@ -368,6 +397,31 @@ Expected<void> LiteRtDispatchInvocationContextT::Execute() {
   return {};
 }
 
+Expected<void> LiteRtDispatchInvocationContextT::ExecuteBatch(
+    absl::Span<const LiteRtDispatchInvocationBuffers> invocations) {
+  for (const auto& invocation : invocations) {
+    if (invocation.num_inputs != static_cast<int>(inputs_.size()) ||
+        invocation.num_outputs != static_cast<int>(outputs_.size())) {
+      return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                        "Invocation buffers don't match the graph I/Os");
+    }
+  }
+
+  // The QNN memory handles of the tensor buffers are created on their first
+  // attachment and cached by the device context, so that switching buffers
+  // between two executions only updates the QNN tensors.
+  for (const auto& invocation : invocations) {
+    for (int i = 0; i < invocation.num_inputs; ++i) {
+      LITERT_RETURN_IF_ERROR(AttachInput(i, invocation.inputs[i]));
+    }
+    for (int i = 0; i < invocation.num_outputs; ++i) {
+      LITERT_RETURN_IF_ERROR(AttachOutput(i, invocation.outputs[i]));
+    }
+    LITERT_RETURN_IF_ERROR(Execute());
+  }
+  return {};
+}
+
 Expected<void> LiteRtDispatchInvocationContextT::ConvertToUint16(
     LiteRtTensorBufferHandle tensor_buffer_handle, size_t bytes) {
   auto tensor_buffer = device_context_.GetTensorBuffer(tensor_buffer_handle);
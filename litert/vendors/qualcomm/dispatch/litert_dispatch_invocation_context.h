@@ -23,6 +23,7 @@
 #include <memory>
 #include <vector>
 
+#include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_model.h"
 #include "litert/c/litert_tensor_buffer_requirements.h"
@@ -64,16 +65,22 @@ class LiteRtDispatchInvocationContextT {
 
   litert::Expected<void> Execute();
 
+  // Executes the graph once for each element of `invocations`, attaching the
+  // given tensor buffers before each execution. The graph I/Os are left
+  // attached to the tensor buffers of the last invocation.
+  litert::Expected<void> ExecuteBatch(
+      absl::Span<const LiteRtDispatchInvocationBuffers> invocations);
+
   litert::Expected<void> Profile();
 
-  Qnn_ContextHandle_t ContextHandle() { return context_handle_.get(); }
+  Qnn_ContextHandle_t ContextHandle() { return context_handle_->get(); }
 
  private:
   LiteRtDispatchInvocationContextT(
       litert::qnn::QnnManager& qnn_manager,
       const litert::qnn::ContextBinaryInfo& context_binary_info,
       LiteRtDispatchDeviceContextT& device_context,
-      litert::qnn::QnnManager::ContextHandle&& context_handle,
+      std::shared_ptr<litert::qnn::QnnManager::ContextHandle> context_handle,
       Qnn_ProfileHandle_t profile_handle, int graph_index,
       Qnn_GraphHandle_t graph_handle);
 
@@ -94,7 +101,9 @@ class LiteRtDispatchInvocationContextT {
 
   litert::qnn::QnnManager& qnn_manager_;
   LiteRtDispatchDeviceContextT& device_context_;
-  litert::qnn::QnnManager::ContextHandle context_handle_;
+  // Shared with the other invocation contexts created from the same context
+  // binary, unless profiling.
+  std::shared_ptr<litert::qnn::QnnManager::ContextHandle> context_handle_;
   Qnn_ProfileHandle_t profile_handle_;
   int graph_index_;
   Qnn_GraphHandle_t graph_handle_;
@@ -22,12 +22,15 @@
 #include <array>
 #include <cstdint>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
 #include "absl/strings/match.h"  // from @com_google_absl
+#include "absl/strings/str_cat.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
@@ -35,11 +38,13 @@
 #include "litert/cc/internal/litert_shared_library.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
+#include "litert/core/cache/sha256.h"
 #include "litert/core/dynamic_loading.h"
 #include "litert/vendors/qualcomm/common.h"
 #include "litert/vendors/qualcomm/core/backends/htp_backend.h"
 #include "litert/vendors/qualcomm/core/backends/ir_backend.h"
 #include "litert/vendors/qualcomm/core/common.h"
+#include "litert/vendors/qualcomm/core/dump/dump_graph.h"
 #include "litert/vendors/qualcomm/core/schema/soc_table.h"
 #include "HTP/QnnHtpContext.h"  // from @qairt
 #include "HTP/QnnHtpProfile.h"  // from @qairt
@@ -316,15 +321,29 @@ LiteRtStatus QnnManager::ValidateOp(const Qnn_OpConfig_t& op_config) {
     return kLiteRtStatusOk;
   }
 
+  // The repeated layers of a model produce many ops of the same signature,
+  // which are only validated once by the backend.
+  const std::string signature =
+      ::qnn::SerializeOpSignatureToJson(op_config).dump();
+  {
+    std::lock_guard<std::mutex> lock(validated_ops_mutex_);
+    if (auto it = validated_ops_.find(signature); it != validated_ops_.end()) {
+      return it->second;
+    }
+  }
+
+  LiteRtStatus status = kLiteRtStatusOk;
   if (Qnn_ErrorHandle_t error =
           Api()->backendValidateOpConfig(BackendHandle(), op_config);
       QNN_SUCCESS != error) {
     LITERT_LOG(LITERT_ERROR, "Failed to validate op %s\n, error: %lld",
                op_config.v1.name, static_cast<long long>(error));
-    return kLiteRtStatusErrorInvalidLegalization;
+    status = kLiteRtStatusErrorInvalidLegalization;
   }
 
-  return kLiteRtStatusOk;
+  std::lock_guard<std::mutex> lock(validated_ops_mutex_);
+  validated_ops_.emplace(signature, status);
+  return status;
 }
 
 std::optional<::qnn::SocInfo> FindSocInfo(
@@ -484,6 +503,49 @@ Expected<QnnManager::ContextHandle> QnnManager::CreateContextHandle(
                        profile_deleter};
 }
 
+Expected<std::shared_ptr<QnnManager::ContextHandle>>
+QnnManager::GetSharedContextHandle(
+    absl::Span<const QnnContext_Config_t*> configs,
+    absl::Span<const uint8_t> bytecode) {
+  // A collision resistant digest, so that a context binary can't be crafted
+  // to get the context of another one. The configs are compared by their
+  // bytes, so configs pointing to other structures only match when they point
+  // to the same ones.
+  const Sha256Digest digest = Sha256(bytecode.data(), bytecode.size());
+  std::string key = absl::StrCat(
+      bytecode.size(), ":",
+      absl::string_view(reinterpret_cast<const char*>(digest.data()),
+                        digest.size()));
+  for (const QnnContext_Config_t* config : configs) {
+    if (config == nullptr) {
+      break;
+    }
+    key.append(reinterpret_cast<const char*>(config), sizeof(*config));
+  }
+
+  std::lock_guard<std::mutex> lock(shared_contexts_mutex_);
+  if (auto it = shared_contexts_.find(key); it != shared_contexts_.end()) {
+    if (auto context_handle = it->second.lock(); context_handle) {
+      LITERT_LOG(LITERT_INFO, "Reusing QNN context %p",
+                 context_handle->get());
+      return context_handle;
+    }
+  }
+
+  LITERT_ASSIGN_OR_RETURN(
+      auto context_handle,
+      CreateContextHandle(configs, bytecode, /*profile_handle=*/nullptr));
+  auto shared_context_handle =
+      std::make_shared<ContextHandle>(std::move(context_handle));
+
+  // Drop the entries of the contexts that have been freed since.
+  absl::erase_if(shared_contexts_, [](const auto& entry) {
+    return entry.second.expired();
+  });
+  shared_contexts_[key] = shared_context_handle;
+  return shared_context_handle;
+}
+
 Expected<QnnManager::Ptr> QnnManager::Create(
     const ::qnn::Options& options,
     std::optional<std::string> shared_library_dir,
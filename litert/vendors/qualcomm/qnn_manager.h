@@ -18,14 +18,17 @@
 #ifndef ODML_LITERT_LITERT_VENDORS_QUALCOMM_QNN_MANAGER_H_
 #define ODML_LITERT_LITERT_VENDORS_QUALCOMM_QNN_MANAGER_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <optional>
 #include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
@@ -117,6 +120,16 @@ class QnnManager {
       absl::Span<const QnnContext_Config_t*> configs,
       absl::Span<const uint8_t> bytecode, Qnn_ProfileHandle_t profile_handle);
 
+  // Returns a context for inference loaded from `bytecode`, shared with all
+  // the other callers that load the same context binary while it is alive.
+  // The graphs of a context binary, e.g. the variants of a model compiled
+  // with weight sharing, are then retrieved by name from a single context
+  // instead of each loading their own copy of the shared weights. The context
+  // is freed with its last reference.
+  Expected<std::shared_ptr<ContextHandle>> GetSharedContextHandle(
+      absl::Span<const QnnContext_Config_t*> configs,
+      absl::Span<const uint8_t> bytecode);
+
   //
   // Context Binary
   //
@@ -134,6 +147,9 @@ class QnnManager {
   // called.
   Qnn_BackendHandle_t BackendHandle() { return backend_->GetBackendHandle(); }
 
+  // Get the backend. Nullptr if it has not been successfully initialized.
+  ::qnn::QnnBackend* Backend() { return backend_.get(); }
+
   const ::qnn::Options& GetOptions() const { return options_; }
 
  private:
@@ -185,6 +201,17 @@ class QnnManager {
   std::unique_ptr<::qnn::QnnBackend> backend_ = nullptr;
   ::qnn::SocInfo soc_info_ = ::qnn::kSocInfos[7];  // V75
   ::qnn::Options options_;
+
+  // Contexts shared by GetSharedContextHandle(), keyed by the SHA-256 digest
+  // and size of their context binary and by the configs they were created
+  // with. The other options belong to the manager, as do its contexts.
+  std::mutex shared_contexts_mutex_;
+  absl::flat_hash_map<std::string, std::weak_ptr<ContextHandle>>
+      shared_contexts_;
+
+  // Results of ValidateOp(), keyed by the serialized signatures of the ops.
+  std::mutex validated_ops_mutex_;
+  absl::flat_hash_map<std::string, LiteRtStatus> validated_ops_;
 };
 
 // Unfortunately we can't use std::unique_ptr with a deleter because
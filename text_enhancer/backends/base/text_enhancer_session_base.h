@@ -12,17 +12,23 @@
 #include "litert/cc/litert_options.h"
 
 // --- MODIFIED: Include Vulkan processor header ---
+#include "text_enhancer/image_processing/vulkan_image_postprocessor.h"
 #include "text_enhancer/image_processing/vulkan_image_processor.h"
 #include "text_enhancer/text_enhancer_api.h"  // For TextEnhancerOptions
+#include "text_enhancer/utils/latency_history.h"
 
 /**
  * @brief Opaque struct holding all session state.
  */
 struct TextEnhancerSession {
     // --- Environment & Model ---
-    std::unique_ptr<litert::Environment> env;
-    std::unique_ptr<litert::Model> model;
-    std::unique_ptr<litert::CompiledModel> compiled_model;
+    // Shared with the sessions created by TextEnhancer_InitializeShared.
+    std::shared_ptr<litert::Environment> env;
+    std::shared_ptr<litert::Model> model;
+    // The compiled model whose weights `compiled_model` shares, kept alive for
+    // it. Null unless the session was created by TextEnhancer_InitializeShared.
+    std::shared_ptr<litert::CompiledModel> primary_compiled_model;
+    std::shared_ptr<litert::CompiledModel> compiled_model;
     std::unique_ptr<std::vector<litert::TensorBuffer>> input_buffers;
     std::unique_ptr<std::vector<litert::TensorBuffer>> output_buffers;
 
@@ -56,6 +62,32 @@ struct TextEnhancerSession {
 
     // --- MODIFIED: Member to store last *synced* Vulkan timings ---
     VulkanImageProcessor::TimingInfo last_synced_vulkan_timings_;
+
+    // --- Timing history (TextEnhancerOptions::timing_history_size) ---
+    // Null when disabled. The timeline of a frame is kept per buffer index
+    // from Submit to Sync, then filled in by Run and recorded by PostProcess.
+    std::unique_ptr<LatencyHistory> latency_history_;
+    std::vector<FrameTimeline> pending_timelines_ =
+        std::vector<FrameTimeline>(kMaxFramesInFlight);
+    FrameTimeline current_timeline_;
+    int current_buffer_index_ = 0;
+
+#ifdef __ANDROID__
+    // --- Zero-copy hand-off of Vulkan pre-processed frames ---
+    // When the model accepts AHardwareBuffer inputs, the compute shader writes
+    // each frame straight into one of these, and Sync attaches the completion
+    // fence instead of reading the frame back. Empty otherwise.
+    std::vector<AHardwareBuffer*> zero_copy_input_ahbs_;
+    std::vector<litert::TensorBuffer> zero_copy_input_buffers_;
+
+    // --- GPU post-processing to RGBA8 (TextEnhancer_PostProcess_AHB) ---
+    // Runs on the context of vulkan_processor, declared before so that it
+    // outlives this.
+    std::unique_ptr<VulkanImagePostprocessor> vulkan_postprocessor;
+    // Destination buffers used when the caller provides none, in turn.
+    std::vector<AHardwareBuffer*> rgba_output_ahbs_;
+    int next_rgba_output_ = 0;
+#endif
 };
 
 /**
@@ -65,6 +97,13 @@ TextEnhancerSession* TextEnhancer_Initialize_Base(const TextEnhancerOptions& opt
                                                   litert::Options litert_options,
                                                   std::unique_ptr<litert::Environment> env);
 
+/**
+ * @brief Base implementation for TextEnhancer_InitializeShared.
+ */
+TextEnhancerSession* TextEnhancer_InitializeShared_Base(const TextEnhancerOptions& options,
+                                                        litert::Options litert_options,
+                                                        TextEnhancerSession* primary);
+
 /**
  * @brief Base implementation for TextEnhancer_Run.
  */
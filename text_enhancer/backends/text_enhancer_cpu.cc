@@ -41,6 +41,16 @@ TextEnhancerSession* TextEnhancer_Initialize(const TextEnhancerOptions& options)
     return TextEnhancer_Initialize_Base(options, std::move(litert_options), std::move(env_ptr));
 }
 
+/**
+ * @brief Initializes a Text Enhancer instance sharing the model of another one
+ * (CPU Backend).
+ */
+TextEnhancerSession* TextEnhancer_InitializeShared(const TextEnhancerOptions& options,
+                                                   TextEnhancerSession* primary) {
+    LOG(INFO) << "TextEnhancer_InitializeShared (CPU Backend)...";
+    return TextEnhancer_InitializeShared_Base(options, CreateCpuOptions(), primary);
+}
+
 /**
  * @brief Runs the inference (CPU Backend).
  */
@@ -48,6 +48,16 @@ TextEnhancerSession* TextEnhancer_Initialize(const TextEnhancerOptions& options)
     return TextEnhancer_Initialize_Base(options, std::move(litert_options), std::move(env_ptr));
 }
 
+/**
+ * @brief Initializes a Text Enhancer instance sharing the model of another one
+ * (GPU Backend).
+ */
+TextEnhancerSession* TextEnhancer_InitializeShared(const TextEnhancerOptions& options,
+                                                   TextEnhancerSession* primary) {
+    LOG(INFO) << "TextEnhancer_InitializeShared (GPU Backend)...";
+    return TextEnhancer_InitializeShared_Base(options, CreateGpuOptions(), primary);
+}
+
 /**
  * @brief Runs the inference (GPU Backend).
  */
@@ -12,7 +12,10 @@ VulkanComputePipeline::VulkanComputePipeline() {
 VulkanComputePipeline::~VulkanComputePipeline() { Shutdown(); }
 
 bool VulkanComputePipeline::Initialize(VulkanContext* context,
-                                       const std::string& shader_spirv_path) {
+                                       const std::string& shader_spirv_path,
+                                       const std::vector<VkDescriptorType>& binding_types,
+                                       uint32_t push_constants_size,
+                                       const std::vector<int32_t>& specialization_constants) {
     if (!context) {
         return false;
     }
@@ -29,23 +32,15 @@ bool VulkanComputePipeline::Initialize(VulkanContext* context,
 
         // 2. Create Descriptor Set Layout
 
-        // --- Binding 0: Input Storage Image ---
-        VkDescriptorSetLayoutBinding input_storage_binding = {};
-        input_storage_binding.binding = 0;
-        input_storage_binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-        input_storage_binding.descriptorCount = 1;
-        input_storage_binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-
-        // --- Binding 1: Output Storage Buffer ---
-        VkDescriptorSetLayoutBinding output_storage_binding = {};
-        output_storage_binding.binding = 1;
-        output_storage_binding.descriptorType =
-            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER; 
-        output_storage_binding.descriptorCount = 1;
-        output_storage_binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-
-        std::vector<VkDescriptorSetLayoutBinding> bindings = {input_storage_binding,
-                                                              output_storage_binding};
+        // --- Binding i: binding_types[i] (crop/resize: input storage image,
+        // output storage buffer) ---
+        std::vector<VkDescriptorSetLayoutBinding> bindings(binding_types.size());
+        for (size_t i = 0; i < binding_types.size(); ++i) {
+            bindings[i].binding = static_cast<uint32_t>(i);
+            bindings[i].descriptorType = binding_types[i];
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
 
         VkDescriptorSetLayoutCreateInfo layout_info = {
             VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
@@ -61,7 +56,7 @@ bool VulkanComputePipeline::Initialize(VulkanContext* context,
         VkPushConstantRange push_constant_range = {};
         push_constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
         push_constant_range.offset = 0;
-        push_constant_range.size = sizeof(CropResizePushConstants);
+        push_constant_range.size = push_constants_size;
 
         VkPipelineLayoutCreateInfo pipeline_layout_info = {
             VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
@@ -82,13 +77,29 @@ bool VulkanComputePipeline::Initialize(VulkanContext* context,
         shader_stage_info.module = compute_shader_module_;
         shader_stage_info.pName = "main";
 
+        std::vector<VkSpecializationMapEntry> specialization_entries(
+            specialization_constants.size());
+        for (size_t i = 0; i < specialization_constants.size(); ++i) {
+            specialization_entries[i].constantID = static_cast<uint32_t>(i);
+            specialization_entries[i].offset = static_cast<uint32_t>(i * sizeof(int32_t));
+            specialization_entries[i].size = sizeof(int32_t);
+        }
+        VkSpecializationInfo specialization_info = {};
+        specialization_info.mapEntryCount = static_cast<uint32_t>(specialization_entries.size());
+        specialization_info.pMapEntries = specialization_entries.data();
+        specialization_info.dataSize = specialization_constants.size() * sizeof(int32_t);
+        specialization_info.pData = specialization_constants.data();
+        if (!specialization_constants.empty()) {
+            shader_stage_info.pSpecializationInfo = &specialization_info;
+        }
+
         VkComputePipelineCreateInfo pipeline_info = {
             VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
         pipeline_info.stage = shader_stage_info;
         pipeline_info.layout = pipeline_layout_;
 
-        if (vkCreateComputePipelines(device_, VK_NULL_HANDLE, 1, &pipeline_info, nullptr,
-                                     &compute_pipeline_) != VK_SUCCESS) {
+        if (vkCreateComputePipelines(device_, context->GetPipelineCache(), 1, &pipeline_info,
+                                     nullptr, &compute_pipeline_) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create compute pipeline!");
         }
 
@@ -14,13 +14,30 @@ struct CropResizePushConstants {
     int32_t out_dims[2];
 };
 
+// Push constants of the shader packing the model output into RGBA8
+struct DenormalizePushConstants {
+    int32_t dims[2];
+    int32_t in_channels;
+    int32_t is_input_uint8;
+};
+
 class VulkanComputePipeline {
    public:
     VulkanComputePipeline();
     ~VulkanComputePipeline();
 
-    // Initializes shader, layouts, and pipeline
-    bool Initialize(VulkanContext* context, const std::string& shader_spirv_path);
+    // Initializes shader, layouts, and pipeline. `binding_types` lists the
+    // descriptor type of each binding of set 0, the default matching the
+    // crop/resize shader (storage image in, storage buffer out).
+    // `specialization_constants[i]` is the value of the int constant with
+    // constant_id i, letting the driver fold sizes fixed for the session; ids
+    // the shader does not declare are ignored. The pipeline is created through
+    // the context's pipeline cache.
+    bool Initialize(VulkanContext* context, const std::string& shader_spirv_path,
+                    const std::vector<VkDescriptorType>& binding_types =
+                        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER},
+                    uint32_t push_constants_size = sizeof(CropResizePushConstants),
+                    const std::vector<int32_t>& specialization_constants = {});
     // Destroys all pipeline-related objects
     void Shutdown();
 
@@ -1,5 +1,9 @@
 #include "vulkan_context.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <stdexcept>
 #include <vector>
 
@@ -56,7 +60,8 @@ static void DestroyDebugUtilsMessengerEXT(VkInstance instance,
 
 VulkanContext::VulkanContext() { }
 VulkanContext::~VulkanContext() { Shutdown(); }
-bool VulkanContext::Initialize() {
+bool VulkanContext::Initialize(const std::string& pipeline_cache_path) {
+    pipeline_cache_path_ = pipeline_cache_path;
     try {
         if (!createInstance()) {
             std::cerr << "Failed to create Vulkan instance." << std::endl;
@@ -80,12 +85,22 @@ bool VulkanContext::Initialize() {
         }
         std::cout << "Vulkan logical device created." << std::endl;
 
+        if (!createQueryPool()) {
+            std::cerr << "Failed to create query pool." << std::endl;
+            return false;
+        }
+
         if (!createCommandPool()) {
             std::cerr << "Failed to create command pool." << std::endl;
             return false;
         }
         std::cout << "Vulkan command pool created." << std::endl;
 
+        if (!createPipelineCache()) {
+            std::cerr << "Failed to create pipeline cache." << std::endl;
+            return false;
+        }
+
     } catch (const std::exception& e) {
         std::cerr << "Vulkan Context Initialization Error: " << e.what() << std::endl;
         Shutdown(); // Clean up partial initialization
@@ -94,9 +109,36 @@ bool VulkanContext::Initialize() {
     std::cout << "VulkanContext initialized successfully." << std::endl;
     return true;
 }
+bool VulkanContext::InitializeShared(std::shared_ptr<VulkanContext> device_owner) {
+    if (!device_owner || device_owner->device_ == VK_NULL_HANDLE) {
+        std::cerr << "Cannot share the device of an uninitialized VulkanContext." << std::endl;
+        return false;
+    }
+    // Always refer to the context owning the device, whose queue mutex is used.
+    if (device_owner->device_owner_) {
+        device_owner = device_owner->device_owner_;
+    }
+    device_owner_ = std::move(device_owner);
+    instance_ = device_owner_->instance_;
+    physical_device_ = device_owner_->physical_device_;
+    device_ = device_owner_->device_;
+    compute_queue_ = device_owner_->compute_queue_;
+    compute_queue_family_index_ = device_owner_->compute_queue_family_index_;
+    timestamp_period_ = device_owner_->timestamp_period_;
+    vkGetCalibratedTimestampsEXT_ = device_owner_->vkGetCalibratedTimestampsEXT_;
+    pipeline_cache_ = device_owner_->pipeline_cache_;
+
+    if (!createQueryPool() || !createCommandPool()) {
+        std::cerr << "Failed to create the resources of a shared VulkanContext." << std::endl;
+        Shutdown();
+        return false;
+    }
+    std::cout << "VulkanContext initialized on a shared device." << std::endl;
+    return true;
+}
 void VulkanContext::Shutdown() {
     if (device_ != VK_NULL_HANDLE) {
-        vkDeviceWaitIdle(device_);
+        WaitQueueIdle();
     }
 
     // --- NEW: Destroy Query Pool ---
@@ -106,6 +148,29 @@ void VulkanContext::Shutdown() {
     }
     // --- END NEW ---
 
+    if (device_owner_) {
+        // Only the pools are ours, the rest goes with the last context sharing
+        // the device.
+        if (command_pool_ != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(device_, command_pool_, nullptr);
+            command_pool_ = VK_NULL_HANDLE;
+        }
+        pipeline_cache_ = VK_NULL_HANDLE;
+        device_ = VK_NULL_HANDLE;
+        instance_ = VK_NULL_HANDLE;
+        physical_device_ = VK_NULL_HANDLE;
+        compute_queue_ = VK_NULL_HANDLE;
+        vkGetCalibratedTimestampsEXT_ = nullptr;
+        device_owner_.reset();
+        return;
+    }
+
+    if (pipeline_cache_ != VK_NULL_HANDLE) {
+        savePipelineCache();
+        vkDestroyPipelineCache(device_, pipeline_cache_, nullptr);
+        pipeline_cache_ = VK_NULL_HANDLE;
+    }
+
     if (command_pool_ != VK_NULL_HANDLE) {
         vkDestroyCommandPool(device_, command_pool_, nullptr);
         command_pool_ = VK_NULL_HANDLE;
@@ -128,6 +193,7 @@ void VulkanContext::Shutdown() {
     
     physical_device_ = VK_NULL_HANDLE;
     compute_queue_ = VK_NULL_HANDLE;
+    vkGetCalibratedTimestampsEXT_ = nullptr;
 }
 
 // ... (createInstance, setupDebugMessenger - NO CHANGES) ...
@@ -231,17 +297,26 @@ bool VulkanContext::createDevice() {
     create_info.queueCreateInfoCount = 1;
     create_info.pEnabledFeatures = &device_features;
     
+    std::vector<const char*> device_extensions;
     #ifdef __ANDROID__
-    std::vector<const char*> device_extensions = {
+    device_extensions = {
         VK_KHR_SAMPLER_YCBCR_CONVERSION_EXTENSION_NAME,
         VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME,
-        VK_ANDROID_EXTERNAL_MEMORY_ANDROID_HARDWARE_BUFFER_EXTENSION_NAME
+        VK_ANDROID_EXTERNAL_MEMORY_ANDROID_HARDWARE_BUFFER_EXTENSION_NAME,
+        // To hand the pre-processed frames over as sync fences.
+        VK_KHR_EXTERNAL_SEMAPHORE_EXTENSION_NAME,
+        VK_KHR_EXTERNAL_SEMAPHORE_FD_EXTENSION_NAME
     };
-    create_info.enabledExtensionCount = static_cast<uint32_t>(device_extensions.size());
-    create_info.ppEnabledExtensionNames = device_extensions.data();
-    #else
-    create_info.enabledExtensionCount = 0;
     #endif
+    // Optional, to place the GPU timestamps on the CPU timeline.
+    const bool has_calibrated_timestamps =
+        timestamp_period_ > 0.0f && supportsCalibratedTimestamps();
+    if (has_calibrated_timestamps) {
+        device_extensions.push_back(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+    }
+    create_info.enabledExtensionCount = static_cast<uint32_t>(device_extensions.size());
+    create_info.ppEnabledExtensionNames =
+        device_extensions.empty() ? nullptr : device_extensions.data();
 
     if (kEnableValidationLayers) {
         create_info.enabledLayerCount = static_cast<uint32_t>(kValidationLayers.size());
@@ -255,14 +330,58 @@ bool VulkanContext::createDevice() {
     }
 
     vkGetDeviceQueue(device_, compute_queue_family_index_, 0, &compute_queue_);
+
+    if (has_calibrated_timestamps) {
+        vkGetCalibratedTimestampsEXT_ = (PFN_vkGetCalibratedTimestampsEXT)vkGetDeviceProcAddr(
+            device_, "vkGetCalibratedTimestampsEXT");
+    }
     
-    // --- NEW: Create Query Pool ---
+    return true;
+}
+bool VulkanContext::supportsCalibratedTimestamps() {
+    uint32_t extension_count = 0;
+    vkEnumerateDeviceExtensionProperties(physical_device_, nullptr, &extension_count, nullptr);
+    std::vector<VkExtensionProperties> extensions(extension_count);
+    vkEnumerateDeviceExtensionProperties(physical_device_, nullptr, &extension_count,
+                                         extensions.data());
+    bool has_extension = false;
+    for (const auto& extension : extensions) {
+        if (strcmp(extension.extensionName, VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME) == 0) {
+            has_extension = true;
+            break;
+        }
+    }
+    if (!has_extension) {
+        return false;
+    }
+
+    // The device counter must be calibrateable against CLOCK_MONOTONIC, which
+    // backs std::chrono::steady_clock.
+    auto get_time_domains = (PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT)
+        vkGetInstanceProcAddr(instance_, "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT");
+    if (!get_time_domains) {
+        return false;
+    }
+    uint32_t domain_count = 0;
+    get_time_domains(physical_device_, &domain_count, nullptr);
+    std::vector<VkTimeDomainEXT> domains(domain_count);
+    get_time_domains(physical_device_, &domain_count, domains.data());
+    bool has_device = false;
+    bool has_monotonic = false;
+    for (VkTimeDomainEXT domain : domains) {
+        has_device |= domain == VK_TIME_DOMAIN_DEVICE_EXT;
+        has_monotonic |= domain == VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT;
+    }
+    return has_device && has_monotonic;
+}
+bool VulkanContext::createQueryPool() {
     // (Only if timestamps are supported)
     if (timestamp_period_ > 0.0f) {
         VkQueryPoolCreateInfo query_pool_info = {VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
         query_pool_info.queryType = VK_QUERY_TYPE_TIMESTAMP;
-        // We need 4 timestamps: 0=pre-shader, 1=post-shader, 2=pre-copy, 3=post-copy
-        query_pool_info.queryCount = 4; 
+        // We need 4 timestamps per frame in flight, of which there are 2:
+        // 0=pre-shader, 1=post-shader, 2=pre-copy, 3=post-copy
+        query_pool_info.queryCount = 4 * 2;
         if (vkCreateQueryPool(device_, &query_pool_info, nullptr, &query_pool_) != VK_SUCCESS) {
             std::cerr << "Failed to create query pool!" << std::endl;
             // Not a fatal error, we can continue without timings
@@ -271,8 +390,6 @@ bool VulkanContext::createDevice() {
             std::cout << "Vulkan query pool created." << std::endl;
         }
     }
-    // --- END NEW ---
-    
     return true;
 }
 
@@ -285,6 +402,78 @@ bool VulkanContext::createCommandPool() {
 
     return vkCreateCommandPool(device_, &pool_info, nullptr, &command_pool_) == VK_SUCCESS;
 }
+bool VulkanContext::createPipelineCache() {
+    std::vector<char> initial_data;
+    if (!pipeline_cache_path_.empty()) {
+        std::ifstream file(pipeline_cache_path_, std::ios::binary);
+        if (file) {
+            initial_data.assign(std::istreambuf_iterator<char>(file),
+                                std::istreambuf_iterator<char>());
+        }
+    }
+
+    // Drivers are meant to ignore data of another device or driver version,
+    // but some do not: only hand over a cache whose header matches.
+    if (!initial_data.empty()) {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physical_device_, &properties);
+        VkPipelineCacheHeaderVersionOne header;
+        bool matches = initial_data.size() >= sizeof(header);
+        if (matches) {
+            memcpy(&header, initial_data.data(), sizeof(header));
+            matches = header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+                      header.vendorID == properties.vendorID &&
+                      header.deviceID == properties.deviceID &&
+                      memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID,
+                             VK_UUID_SIZE) == 0;
+        }
+        if (!matches) {
+            std::cout << "Ignoring stale pipeline cache " << pipeline_cache_path_ << "."
+                      << std::endl;
+            initial_data.clear();
+        }
+    }
+
+    VkPipelineCacheCreateInfo cache_info = { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+    cache_info.initialDataSize = initial_data.size();
+    cache_info.pInitialData = initial_data.empty() ? nullptr : initial_data.data();
+    if (vkCreatePipelineCache(device_, &cache_info, nullptr, &pipeline_cache_) != VK_SUCCESS) {
+        return false;
+    }
+    if (!initial_data.empty()) {
+        std::cout << "Loaded pipeline cache " << pipeline_cache_path_ << " ("
+                  << initial_data.size() << " bytes)." << std::endl;
+    }
+    return true;
+}
+void VulkanContext::savePipelineCache() {
+    if (pipeline_cache_path_.empty()) return;
+    size_t size = 0;
+    if (vkGetPipelineCacheData(device_, pipeline_cache_, &size, nullptr) != VK_SUCCESS ||
+        size == 0) {
+        return;
+    }
+    std::vector<char> data(size);
+    if (vkGetPipelineCacheData(device_, pipeline_cache_, &size, data.data()) != VK_SUCCESS) {
+        return;
+    }
+
+    // Write to a temporary file first so that a reader never sees half a cache.
+    const std::string tmp_path = pipeline_cache_path_ + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(data.data(), static_cast<std::streamsize>(size))) {
+            std::cerr << "Warning: Failed to write pipeline cache " << tmp_path << "."
+                      << std::endl;
+            return;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), pipeline_cache_path_.c_str()) != 0) {
+        std::cerr << "Warning: Failed to save pipeline cache " << pipeline_cache_path_ << "."
+                  << std::endl;
+        std::remove(tmp_path.c_str());
+    }
+}
 VkCommandBuffer VulkanContext::BeginOneTimeCommands() {
     VkCommandBufferAllocateInfo alloc_info = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
     alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
@@ -317,7 +506,7 @@ void VulkanContext::EndAndSubmitCommands(VkCommandBuffer command_buffer) {
     }
 
     std::cout << "[Debug PreprocessImage] Submitting commands..." << std::endl;
-    if (vkQueueSubmit(compute_queue_, 1, &submit_info, fence) != VK_SUCCESS) {
+    if (SubmitToQueue(submit_info, fence) != VK_SUCCESS) {
         throw std::runtime_error("Failed to submit command buffer!");
     }
 
@@ -327,4 +516,33 @@ void VulkanContext::EndAndSubmitCommands(VkCommandBuffer command_buffer) {
     
     vkDestroyFence(device_, fence, nullptr);
     vkFreeCommandBuffers(device_, command_pool_, 1, &command_buffer);
-}
\ No newline at end of file
+}
+VkResult VulkanContext::SubmitToQueue(const VkSubmitInfo& submit_info, VkFence fence) {
+    VulkanContext* owner = device_owner_ ? device_owner_.get() : this;
+    std::lock_guard<std::mutex> lock(owner->queue_mutex_);
+    return vkQueueSubmit(compute_queue_, 1, &submit_info, fence);
+}
+void VulkanContext::WaitQueueIdle() {
+    VulkanContext* owner = device_owner_ ? device_owner_.get() : this;
+    std::lock_guard<std::mutex> lock(owner->queue_mutex_);
+    vkQueueWaitIdle(compute_queue_);
+}
+bool VulkanContext::GetCalibratedTimestamps(uint64_t* gpu_ticks, int64_t* cpu_ns) const {
+    if (!vkGetCalibratedTimestampsEXT_) {
+        return false;
+    }
+    VkCalibratedTimestampInfoEXT infos[2] = {
+        {VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT},
+        {VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT}};
+    infos[0].timeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+    infos[1].timeDomain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT;
+    uint64_t timestamps[2] = {0, 0};
+    uint64_t max_deviation = 0;
+    if (vkGetCalibratedTimestampsEXT_(device_, 2, infos, timestamps, &max_deviation) !=
+        VK_SUCCESS) {
+        return false;
+    }
+    *gpu_ticks = timestamps[0];
+    *cpu_ns = static_cast<int64_t>(timestamps[1]);
+    return true;
+}
@@ -2,13 +2,24 @@
 
 #include <vulkan/vulkan.h>
 
+#include <memory>
+#include <mutex>
+#include <string>
+
 class VulkanContext {
 public:
     VulkanContext();
     ~VulkanContext();
 
-    // Initializes instance, device, queue, and command pool
-    bool Initialize();
+    // Initializes instance, device, queue, command pool and pipeline cache.
+    // A non-empty pipeline_cache_path loads the cache from that file if it was
+    // written for this device, and saves it back on Shutdown.
+    bool Initialize(const std::string& pipeline_cache_path = "");
+    // Initializes a context on the device of `device_owner`, which is kept
+    // alive until Shutdown. The instance, device, queue and pipeline cache are
+    // shared; the command pool and query pool are this context's own, so that
+    // contexts sharing a device can be used from different threads.
+    bool InitializeShared(std::shared_ptr<VulkanContext> device_owner);
     // Destroys all created Vulkan objects
     void Shutdown();
 
@@ -25,6 +36,21 @@ public:
     float GetTimestampPeriod() const { return timestamp_period_; }
     // --- END NEW ---
 
+    // Samples the GPU timestamp counter and the steady clock (in nanoseconds)
+    // at the same time, to place GPU timestamps on the CPU timeline. Returns
+    // false if the device does not support VK_EXT_calibrated_timestamps.
+    bool GetCalibratedTimestamps(uint64_t* gpu_ticks, int64_t* cpu_ns) const;
+
+    // Shared by all the compute pipelines created on this context.
+    VkPipelineCache GetPipelineCache() const { return pipeline_cache_; }
+
+    // Submits to the compute queue, which is shared by all the contexts on the
+    // device: use instead of vkQueueSubmit.
+    VkResult SubmitToQueue(const VkSubmitInfo& submit_info, VkFence fence);
+    // Waits for the work of all the contexts on the device. Use instead of
+    // vkDeviceWaitIdle, which would race with their submissions.
+    void WaitQueueIdle();
+
     // Command buffer helpers
     VkCommandBuffer BeginOneTimeCommands();
     void EndAndSubmitCommands(VkCommandBuffer command_buffer);
@@ -34,7 +60,11 @@ private:
     bool setupDebugMessenger();
     bool findPhysicalDevice();
     bool createDevice();
+    bool supportsCalibratedTimestamps();
     bool createCommandPool();
+    bool createQueryPool();
+    bool createPipelineCache();
+    void savePipelineCache();
 
     // Core Vulkan objects
     VkInstance instance_ = VK_NULL_HANDLE;
@@ -51,4 +81,17 @@ private:
     VkQueryPool query_pool_ = VK_NULL_HANDLE;
     float timestamp_period_ = 1.0f; // Nanoseconds per tick
     // --- END NEW ---
+    // Null unless timestamps can be calibrated against the CPU clock
+    PFN_vkGetCalibratedTimestampsEXT vkGetCalibratedTimestampsEXT_ = nullptr;
+
+    // Pipeline cache, persisted to pipeline_cache_path_ when set
+    VkPipelineCache pipeline_cache_ = VK_NULL_HANDLE;
+    std::string pipeline_cache_path_;
+
+    // --- Device sharing ---
+    // Set on contexts created by InitializeShared, which own neither the
+    // device nor the objects shared with it.
+    std::shared_ptr<VulkanContext> device_owner_;
+    // Guards the compute queue; only the one of the device owner is used.
+    std::mutex queue_mutex_;
 };
\ No newline at end of file
@@ -230,6 +230,63 @@ bool ImportAhbToImage(VkDevice device,
 
     return true;
 }
+
+bool ImportAhbToBuffer(VkDevice device,
+                       VkPhysicalDevice physical_device,
+                       AHardwareBuffer* hardware_buffer,
+                       PFN_vkGetAndroidHardwareBufferPropertiesANDROID vkGetAndroidHardwareBufferPropertiesANDROID,
+                       VkBufferUsageFlags usage,
+                       VkBuffer& out_buffer,
+                       VkDeviceMemory& out_memory,
+                       VkDeviceSize& out_size) {
+    VkAndroidHardwareBufferPropertiesANDROID ahb_props = { VK_STRUCTURE_TYPE_ANDROID_HARDWARE_BUFFER_PROPERTIES_ANDROID };
+    if (vkGetAndroidHardwareBufferPropertiesANDROID(device, hardware_buffer, &ahb_props) != VK_SUCCESS) {
+        std::cerr << "Failed to get AHB properties." << std::endl;
+        return false;
+    }
+
+    AHardwareBuffer_Desc ahb_desc;
+    AHardwareBuffer_describe(hardware_buffer, &ahb_desc);
+    if (ahb_desc.format != AHARDWAREBUFFER_FORMAT_BLOB) {
+        std::cerr << "Only BLOB AHardwareBuffers can be imported as buffers." << std::endl;
+        return false;
+    }
+
+    VkExternalMemoryBufferCreateInfo external_mem_info = { VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO };
+    external_mem_info.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_ANDROID_HARDWARE_BUFFER_BIT_ANDROID;
+
+    VkBufferCreateInfo buffer_info = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    buffer_info.pNext = &external_mem_info;
+    buffer_info.size = ahb_desc.width;  // BLOB buffers are width bytes wide.
+    buffer_info.usage = usage;
+    buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &buffer_info, nullptr, &out_buffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create external buffer for AHB!");
+    }
+
+    VkImportAndroidHardwareBufferInfoANDROID import_mem_info = { VK_STRUCTURE_TYPE_IMPORT_ANDROID_HARDWARE_BUFFER_INFO_ANDROID };
+    import_mem_info.buffer = hardware_buffer;
+
+    VkMemoryAllocateInfo alloc_info = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    alloc_info.pNext = &import_mem_info;
+    alloc_info.allocationSize = ahb_props.allocationSize;
+    alloc_info.memoryTypeIndex = FindMemoryType(physical_device, ahb_props.memoryTypeBits, 0);
+
+    if (vkAllocateMemory(device, &alloc_info, nullptr, &out_memory) != VK_SUCCESS) {
+        vkDestroyBuffer(device, out_buffer, nullptr);
+        throw std::runtime_error("Failed to allocate/import memory for AHB!");
+    }
+
+    if (vkBindBufferMemory(device, out_buffer, out_memory, 0) != VK_SUCCESS) {
+        vkDestroyBuffer(device, out_buffer, nullptr);
+        vkFreeMemory(device, out_memory, nullptr);
+        throw std::runtime_error("Failed to bind AHB memory to buffer!");
+    }
+
+    out_size = ahb_desc.width;
+    return true;
+}
 #endif // __ANDROID__
 
 void TransitionImageLayout(VkCommandBuffer command_buffer,
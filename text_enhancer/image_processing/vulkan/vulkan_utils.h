@@ -61,6 +61,22 @@ bool ImportAhbToImage(VkDevice device,
                       VkDeviceMemory& out_memory,
                       VkImageView& out_image_view,
                       VkFormat& out_format);
+
+/**
+ * @brief Imports a BLOB AHardwareBuffer into a new VkBuffer.
+ *
+ * The buffer covers the whole AHardwareBuffer, whose size is returned in
+ * out_size.
+ * @return true on success, false on failure.
+ */
+bool ImportAhbToBuffer(VkDevice device,
+                       VkPhysicalDevice physical_device,
+                       AHardwareBuffer* hardware_buffer,
+                       PFN_vkGetAndroidHardwareBufferPropertiesANDROID vkGetAndroidHardwareBufferPropertiesANDROID,
+                       VkBufferUsageFlags usage,
+                       VkBuffer& out_buffer,
+                       VkDeviceMemory& out_memory,
+                       VkDeviceSize& out_size);
 #endif // __ANDROID__
 
 
@@ -0,0 +1,382 @@
+#include "vulkan_image_postprocessor.h"
+
+#ifdef __ANDROID__
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "vulkan/vulkan_utils.h"
+
+VulkanImagePostprocessor::VulkanImagePostprocessor() {
+    // All members initialized in header
+}
+VulkanImagePostprocessor::~VulkanImagePostprocessor() { Shutdown(); }
+
+bool VulkanImagePostprocessor::Initialize(VulkanContext* context,
+                                          const std::string& shader_spirv_path, int width,
+                                          int height, int in_channels, bool is_input_uint8) {
+    if (!context) {
+        return false;
+    }
+    context_ = context;
+    width_ = width;
+    height_ = height;
+    in_channels_ = in_channels;
+    is_input_uint8_ = is_input_uint8;
+    in_size_bytes_ = static_cast<VkDeviceSize>(width) * height * in_channels *
+                     (is_input_uint8 ? sizeof(uint8_t) : sizeof(float));
+    // The shader reads 32-bit words.
+    in_size_bytes_ = (in_size_bytes_ + 3) & ~static_cast<VkDeviceSize>(3);
+    VkDevice device = context_->GetDevice();
+
+    try {
+        vkGetAndroidHardwareBufferPropertiesANDROID_ =
+            (PFN_vkGetAndroidHardwareBufferPropertiesANDROID)vkGetDeviceProcAddr(
+                device, "vkGetAndroidHardwareBufferPropertiesANDROID");
+        vkGetMemoryAndroidHardwareBufferANDROID_ =
+            (PFN_vkGetMemoryAndroidHardwareBufferANDROID)vkGetDeviceProcAddr(
+                device, "vkGetMemoryAndroidHardwareBufferANDROID");
+        if (!vkGetAndroidHardwareBufferPropertiesANDROID_ ||
+            !vkGetMemoryAndroidHardwareBufferANDROID_) {
+            throw std::runtime_error("Failed to get AHB extension proc addrs.");
+        }
+
+        // --- 1. Pipeline: storage buffer in, storage image out ---
+        compute_pipeline_ = std::make_unique<VulkanComputePipeline>();
+        if (!compute_pipeline_->Initialize(
+                context_, shader_spirv_path,
+                {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE},
+                sizeof(DenormalizePushConstants),
+                {width, height, in_channels, is_input_uint8 ? 1 : 0})) {
+            throw std::runtime_error("Failed to initialize postprocessing pipeline.");
+        }
+
+        // --- 2. Staging buffer for model outputs in host memory ---
+        VulkanUtils::CreateBuffer(
+            device, context_->GetPhysicalDevice(), in_size_bytes_,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            staging_buffer_, staging_buffer_memory_);
+
+        // --- 3. Descriptor set ---
+        VkDescriptorPoolSize pool_size_storage_buffer = {};
+        pool_size_storage_buffer.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        pool_size_storage_buffer.descriptorCount = 1;
+        VkDescriptorPoolSize pool_size_storage_image = {};
+        pool_size_storage_image.type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        pool_size_storage_image.descriptorCount = 1;
+        std::vector<VkDescriptorPoolSize> pool_sizes = {pool_size_storage_buffer,
+                                                        pool_size_storage_image};
+        VkDescriptorPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
+        pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+        pool_info.pPoolSizes = pool_sizes.data();
+        pool_info.maxSets = 1;
+        if (vkCreateDescriptorPool(device, &pool_info, nullptr, &descriptor_pool_) !=
+            VK_SUCCESS) {
+            throw std::runtime_error("Failed to create descriptor pool!");
+        }
+        VkDescriptorSetLayout layout = compute_pipeline_->GetDescriptorSetLayout();
+        VkDescriptorSetAllocateInfo set_alloc_info = {
+            VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+        set_alloc_info.descriptorPool = descriptor_pool_;
+        set_alloc_info.descriptorSetCount = 1;
+        set_alloc_info.pSetLayouts = &layout;
+        if (vkAllocateDescriptorSets(device, &set_alloc_info, &descriptor_set_) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate descriptor set!");
+        }
+
+        // --- 4. Command buffer and fence ---
+        VkCommandBufferAllocateInfo alloc_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        alloc_info.commandPool = context_->GetCommandPool();
+        alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        alloc_info.commandBufferCount = 1;
+        if (vkAllocateCommandBuffers(device, &alloc_info, &command_buffer_) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate command buffer!");
+        }
+        VkFenceCreateInfo fence_info = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+        if (vkCreateFence(device, &fence_info, nullptr, &fence_) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create fence!");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "VulkanImagePostprocessor Initialization Error: " << e.what() << std::endl;
+        Shutdown();
+        return false;
+    }
+
+    std::cout << "Vulkan postprocessor initialized for " << width_ << "x" << height_ << "x"
+              << in_channels_ << (is_input_uint8_ ? " uint8" : " float") << " outputs."
+              << std::endl;
+    return true;
+}
+
+void VulkanImagePostprocessor::Shutdown() {
+    if (!context_ || !context_->GetDevice()) {
+        return;
+    }
+    VkDevice device = context_->GetDevice();
+    context_->WaitQueueIdle();
+
+    for (auto& entry : input_imports_) {
+        destroyImport(entry.second);
+    }
+    input_imports_.clear();
+    for (auto& entry : output_imports_) {
+        destroyImport(entry.second);
+    }
+    output_imports_.clear();
+
+    if (fence_ != VK_NULL_HANDLE) {
+        vkDestroyFence(device, fence_, nullptr);
+        fence_ = VK_NULL_HANDLE;
+    }
+    if (command_buffer_ != VK_NULL_HANDLE) {
+        vkFreeCommandBuffers(device, context_->GetCommandPool(), 1, &command_buffer_);
+        command_buffer_ = VK_NULL_HANDLE;
+    }
+    if (descriptor_pool_ != VK_NULL_HANDLE) {
+        // Also frees descriptor_set_.
+        vkDestroyDescriptorPool(device, descriptor_pool_, nullptr);
+        descriptor_pool_ = VK_NULL_HANDLE;
+        descriptor_set_ = VK_NULL_HANDLE;
+    }
+    if (staging_buffer_ != VK_NULL_HANDLE) {
+        vkDestroyBuffer(device, staging_buffer_, nullptr);
+        staging_buffer_ = VK_NULL_HANDLE;
+    }
+    if (staging_buffer_memory_ != VK_NULL_HANDLE) {
+        vkFreeMemory(device, staging_buffer_memory_, nullptr);
+        staging_buffer_memory_ = VK_NULL_HANDLE;
+    }
+    compute_pipeline_.reset();
+    context_ = nullptr;
+}
+
+bool VulkanImagePostprocessor::Run(AHardwareBuffer* in_buffer, AHardwareBuffer* out_buffer,
+                                   bool cache_imports) {
+    if (!context_ || !compute_pipeline_ || !in_buffer || !out_buffer) return false;
+
+    ImportedBuffer in_import;
+    ImportedImage out_import;
+    bool ok = false;
+    try {
+        if (!importInput(in_buffer, in_import) || !importOutput(out_buffer, out_import)) {
+            throw std::runtime_error("Failed to import AHardwareBuffers.");
+        }
+        ok = dispatch(in_import.buffer, out_import.image, out_import.view);
+    } catch (const std::exception& e) {
+        std::cerr << "[VulkanImagePostprocessor::Run] " << e.what() << std::endl;
+        ok = false;
+    }
+
+    if (cache_imports && ok) {
+        input_imports_[in_buffer] = in_import;
+        output_imports_[out_buffer] = out_import;
+    } else {
+        // Cached entries stay cached, fresh imports are dropped.
+        if (!input_imports_.count(in_buffer)) destroyImport(in_import);
+        if (!output_imports_.count(out_buffer)) destroyImport(out_import);
+    }
+    return ok;
+}
+
+bool VulkanImagePostprocessor::Run(const void* in_data, AHardwareBuffer* out_buffer,
+                                   bool cache_imports) {
+    if (!context_ || !compute_pipeline_ || !in_data || !out_buffer) return false;
+    VkDevice device = context_->GetDevice();
+
+    ImportedImage out_import;
+    bool ok = false;
+    try {
+        // The last frame was waited for, so the staging buffer is free.
+        void* mapped_data =
+            VulkanUtils::MapBufferMemory(device, staging_buffer_memory_, in_size_bytes_);
+        memcpy(mapped_data, in_data,
+               static_cast<size_t>(width_) * height_ * in_channels_ *
+                   (is_input_uint8_ ? sizeof(uint8_t) : sizeof(float)));
+        VulkanUtils::UnmapBufferMemory(device, staging_buffer_memory_);
+
+        if (!importOutput(out_buffer, out_import)) {
+            throw std::runtime_error("Failed to import output AHardwareBuffer.");
+        }
+        ok = dispatch(staging_buffer_, out_import.image, out_import.view);
+    } catch (const std::exception& e) {
+        std::cerr << "[VulkanImagePostprocessor::Run] " << e.what() << std::endl;
+        ok = false;
+    }
+
+    if (cache_imports && ok) {
+        output_imports_[out_buffer] = out_import;
+    } else if (!output_imports_.count(out_buffer)) {
+        destroyImport(out_import);
+    }
+    return ok;
+}
+
+bool VulkanImagePostprocessor::importInput(AHardwareBuffer* in_buffer, ImportedBuffer& imported) {
+    auto it = input_imports_.find(in_buffer);
+    if (it != input_imports_.end()) {
+        imported = it->second;
+        return true;
+    }
+    VkDeviceSize size = 0;
+    if (!VulkanUtils::ImportAhbToBuffer(context_->GetDevice(), context_->GetPhysicalDevice(),
+                                        in_buffer, vkGetAndroidHardwareBufferPropertiesANDROID_,
+                                        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, imported.buffer,
+                                        imported.memory, size)) {
+        return false;
+    }
+    if (size < in_size_bytes_) {
+        std::cerr << "Model output AHardwareBuffer is too small (" << size << " < "
+                  << in_size_bytes_ << " bytes)." << std::endl;
+        destroyImport(imported);
+        return false;
+    }
+    return true;
+}
+
+bool VulkanImagePostprocessor::importOutput(AHardwareBuffer* out_buffer,
+                                            ImportedImage& imported) {
+    auto it = output_imports_.find(out_buffer);
+    if (it != output_imports_.end()) {
+        imported = it->second;
+        return true;
+    }
+    AHardwareBuffer_Desc desc;
+    AHardwareBuffer_describe(out_buffer, &desc);
+    if (desc.format != AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM ||
+        static_cast<int>(desc.width) != width_ || static_cast<int>(desc.height) != height_) {
+        std::cerr << "Output AHardwareBuffer must be R8G8B8A8_UNORM and " << width_ << "x"
+                  << height_ << "." << std::endl;
+        return false;
+    }
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    if (!VulkanUtils::ImportAhbToImage(context_->GetDevice(), context_->GetPhysicalDevice(),
+                                       out_buffer, vkGetAndroidHardwareBufferPropertiesANDROID_,
+                                       vkGetMemoryAndroidHardwareBufferANDROID_,
+                                       VK_IMAGE_USAGE_STORAGE_BIT, imported.image,
+                                       imported.memory, imported.view, format)) {
+        return false;
+    }
+    if (format != VK_FORMAT_R8G8B8A8_UNORM) {
+        std::cerr << "Output AHardwareBuffer imported with unexpected format " << format << "."
+                  << std::endl;
+        destroyImport(imported);
+        return false;
+    }
+    return true;
+}
+
+void VulkanImagePostprocessor::destroyImport(ImportedBuffer& imported) {
+    VkDevice device = context_->GetDevice();
+    if (imported.buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(device, imported.buffer, nullptr);
+    }
+    if (imported.memory != VK_NULL_HANDLE) {
+        vkFreeMemory(device, imported.memory, nullptr);
+    }
+    imported = {};
+}
+
+void VulkanImagePostprocessor::destroyImport(ImportedImage& imported) {
+    VkDevice device = context_->GetDevice();
+    if (imported.view != VK_NULL_HANDLE) {
+        vkDestroyImageView(device, imported.view, nullptr);
+    }
+    if (imported.image != VK_NULL_HANDLE) {
+        vkDestroyImage(device, imported.image, nullptr);
+    }
+    if (imported.memory != VK_NULL_HANDLE) {
+        vkFreeMemory(device, imported.memory, nullptr);
+    }
+    imported = {};
+}
+
+bool VulkanImagePostprocessor::dispatch(VkBuffer in_buffer, VkImage out_image,
+                                        VkImageView out_image_view) {
+    VkDevice device = context_->GetDevice();
+
+    // --- 1. Point the descriptor set to this run's buffers ---
+    VkDescriptorBufferInfo input_buffer_info = {};
+    input_buffer_info.buffer = in_buffer;
+    input_buffer_info.offset = 0;
+    input_buffer_info.range = in_size_bytes_;
+    VkWriteDescriptorSet write_input = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+    write_input.dstSet = descriptor_set_;
+    write_input.dstBinding = 0;
+    write_input.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write_input.descriptorCount = 1;
+    write_input.pBufferInfo = &input_buffer_info;
+
+    VkDescriptorImageInfo output_image_info = {};
+    output_image_info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+    output_image_info.imageView = out_image_view;
+    VkWriteDescriptorSet write_output = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+    write_output.dstSet = descriptor_set_;
+    write_output.dstBinding = 1;
+    write_output.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    write_output.descriptorCount = 1;
+    write_output.pImageInfo = &output_image_info;
+
+    std::vector<VkWriteDescriptorSet> descriptor_writes = {write_input, write_output};
+    vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptor_writes.size()),
+                           descriptor_writes.data(), 0, nullptr);
+
+    // --- 2. Record commands ---
+    vkResetCommandBuffer(command_buffer_, 0);
+    VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(command_buffer_, &begin_info);
+
+    // a. Every pixel is overwritten, so the previous contents are discarded.
+    VulkanUtils::TransitionImageLayout(command_buffer_, out_image, VK_FORMAT_R8G8B8A8_UNORM,
+                                       VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL);
+
+    // b. Make the model output (written by the accelerator or the host) visible.
+    VkMemoryBarrier barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+    barrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(command_buffer_, VK_PIPELINE_STAGE_HOST_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0,
+                         nullptr);
+
+    // c. Bind pipeline and descriptors
+    vkCmdBindPipeline(command_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE,
+                      compute_pipeline_->GetPipeline());
+    vkCmdBindDescriptorSets(command_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE,
+                            compute_pipeline_->GetPipelineLayout(), 0, 1, &descriptor_set_, 0,
+                            nullptr);
+
+    // d. Push constants and dispatch
+    DenormalizePushConstants push_constants = {};
+    push_constants.dims[0] = width_;
+    push_constants.dims[1] = height_;
+    push_constants.in_channels = in_channels_;
+    push_constants.is_input_uint8 = is_input_uint8_ ? 1 : 0;
+    vkCmdPushConstants(command_buffer_, compute_pipeline_->GetPipelineLayout(),
+                       VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push_constants), &push_constants);
+    vkCmdDispatch(command_buffer_, (width_ + 7) / 8, (height_ + 7) / 8, 1);
+
+    // e. Shader writes -> whoever reads the AHB next (display, CPU)
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(command_buffer_, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_HOST_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 1,
+                         &barrier, 0, nullptr, 0, nullptr);
+    vkEndCommandBuffer(command_buffer_);
+
+    // --- 3. Submit and wait ---
+    VkSubmitInfo submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &command_buffer_;
+    vkResetFences(device, 1, &fence_);
+    if (context_->SubmitToQueue(submit_info, fence_) != VK_SUCCESS) {
+        std::cerr << "Failed to submit postprocessing commands!" << std::endl;
+        return false;
+    }
+    vkWaitForFences(device, 1, &fence_, VK_TRUE, UINT64_MAX);
+    return true;
+}
+
+#endif  // __ANDROID__
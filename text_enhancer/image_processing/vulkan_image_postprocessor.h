@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "vulkan/vulkan_compute_pipeline.h"
+#include "vulkan/vulkan_context.h"
+
+#ifdef __ANDROID__
+#include <android/hardware_buffer.h>
+#include <vulkan/vulkan_android.h>  // For PFN types
+
+/**
+ * @brief Packs the model output into an RGBA8 AHardwareBuffer on the GPU.
+ *
+ * Runs a second compute pipeline on the Vulkan context of the pre-processor:
+ * the output tensor is clamped, converted to 8 bits and written to the
+ * destination image, so post-processing needs neither a heap allocation nor
+ * a CPU pass over the pixels.
+ */
+class VulkanImagePostprocessor {
+   public:
+    VulkanImagePostprocessor();
+    ~VulkanImagePostprocessor();
+
+    /**
+     * @brief Creates the denormalization pipeline and its resources.
+     *
+     * @param context Vulkan context to run on, which must outlive this object.
+     * @param shader_spirv_path Path to the compiled denormalize_rgba8 shader.
+     * @param width Width of the model output.
+     * @param height Height of the model output.
+     * @param in_channels Channels of the model output.
+     * @param is_input_uint8 True if the model output is uint8, false if float.
+     * @return true on success, false on failure.
+     */
+    bool Initialize(VulkanContext* context, const std::string& shader_spirv_path, int width,
+                    int height, int in_channels, bool is_input_uint8);
+
+    /**
+     * @brief Destroys all Vulkan resources. Called by the destructor.
+     */
+    void Shutdown();
+
+    /**
+     * @brief Converts the model output held by the BLOB AHardwareBuffer
+     * `in_buffer` into `out_buffer`, an R8G8B8A8_UNORM AHardwareBuffer of the
+     * output size. Waits for the GPU work to complete.
+     *
+     * Imports of buffers are cached by handle when `cache_imports` is true, so
+     * the buffers must then stay allocated until Shutdown().
+     */
+    bool Run(AHardwareBuffer* in_buffer, AHardwareBuffer* out_buffer, bool cache_imports);
+
+    /**
+     * @brief Same as above, for a model output in host memory, first copied
+     * to a staging buffer.
+     */
+    bool Run(const void* in_data, AHardwareBuffer* out_buffer, bool cache_imports);
+
+    VkDeviceSize GetInputSizeBytes() const { return in_size_bytes_; }
+
+   private:
+    struct ImportedBuffer {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+    };
+    struct ImportedImage {
+        VkImage image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+    };
+
+    bool importInput(AHardwareBuffer* in_buffer, ImportedBuffer& imported);
+    bool importOutput(AHardwareBuffer* out_buffer, ImportedImage& imported);
+    void destroyImport(ImportedBuffer& imported);
+    void destroyImport(ImportedImage& imported);
+    // Binds `in_buffer` and `out_image`, dispatches the shader and waits.
+    bool dispatch(VkBuffer in_buffer, VkImage out_image, VkImageView out_image_view);
+
+    VulkanContext* context_ = nullptr;  // Non-owning pointer
+    std::unique_ptr<VulkanComputePipeline> compute_pipeline_;
+
+    int width_ = 0;
+    int height_ = 0;
+    int in_channels_ = 0;
+    bool is_input_uint8_ = false;
+    VkDeviceSize in_size_bytes_ = 0;
+
+    // --- Persistent Resources ---
+    VkBuffer staging_buffer_ = VK_NULL_HANDLE;
+    VkDeviceMemory staging_buffer_memory_ = VK_NULL_HANDLE;
+    VkDescriptorPool descriptor_pool_ = VK_NULL_HANDLE;
+    VkDescriptorSet descriptor_set_ = VK_NULL_HANDLE;
+    VkCommandBuffer command_buffer_ = VK_NULL_HANDLE;
+    VkFence fence_ = VK_NULL_HANDLE;
+
+    // --- Cached AHB Imports ---
+    std::unordered_map<AHardwareBuffer*, ImportedBuffer> input_imports_;
+    std::unordered_map<AHardwareBuffer*, ImportedImage> output_imports_;
+
+    // --- AHB-related Function Pointers ---
+    PFN_vkGetAndroidHardwareBufferPropertiesANDROID vkGetAndroidHardwareBufferPropertiesANDROID_ =
+        nullptr;
+    PFN_vkGetMemoryAndroidHardwareBufferANDROID vkGetMemoryAndroidHardwareBufferANDROID_ = nullptr;
+};
+#endif  // __ANDROID__
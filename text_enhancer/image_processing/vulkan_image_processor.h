@@ -32,6 +32,17 @@ class VulkanImageProcessor {
         double gpu_readback_ms = 0.0;    // Time for vkCmdCopyBuffer (device to host buffer).
     };
 
+    // --- GPU work of a frame on the CPU timeline ---
+    struct GpuTimeline {
+        // Nanoseconds of std::chrono::steady_clock.
+        int64_t shader_start_ns = 0;
+        int64_t shader_end_ns = 0;
+        int64_t output_end_ns = 0;  // End of the readback copy or of the hand-over.
+        // False if the device cannot calibrate its timestamps: the start of
+        // the shader is then placed at the end of the submission.
+        bool calibrated = false;
+    };
+
     // [ADDED] Number of buffers for pipelining
     static const int kMaxFramesInFlight = 2;
 
@@ -48,10 +59,17 @@ class VulkanImageProcessor {
      * @param out_width Target width (e.g., 256).
      * @param out_height Target height (e.g., 256).
      * @param is_output_int8 True if the output is int8, false if float.
+     * @param pipeline_cache_path Optional file persisting the Vulkan pipeline
+     * cache across sessions, so that only the first one compiles the shaders.
+     * @param device_owner Optional context whose device, queue and pipeline
+     * cache to share (see ShareContext()), instead of creating a device. The
+     * pipeline_cache_path is then that of the owner.
      * @return true on success, false on failure.
      */
     bool Initialize(const std::string& shader_spirv_path, int max_in_width, int max_in_height,
-                    int max_in_channels, int out_width, int out_height, bool is_output_int8);
+                    int max_in_channels, int out_width, int out_height, bool is_output_int8,
+                    const std::string& pipeline_cache_path = "",
+                    std::shared_ptr<VulkanContext> device_owner = nullptr);
 
     /**
      * @brief Shuts down all Vulkan resources.
@@ -79,6 +97,28 @@ class VulkanImageProcessor {
     bool SubmitPreprocessImage(AHardwareBuffer* in_buffer, int in_width, int in_height,
                                int buffer_index);
 
+    /**
+     * @brief Makes the compute shader write straight into AHardwareBuffers.
+     *
+     * `output_ahbs` holds one BLOB AHardwareBuffer of at least the output size
+     * per buffer index, typically wrapped as model inputs. The readback to the
+     * CPU is skipped, and each submission instead signals a sync fence to be
+     * taken with TakeOutputSyncFd(). SyncPreprocess() must then not be used.
+     *
+     * @return true on success, false on failure.
+     */
+    bool SetOutputAhbs(const std::vector<AHardwareBuffer*>& output_ahbs);
+
+    bool HasOutputAhbs() const { return !output_ahb_buffers_.empty(); }
+
+    /**
+     * @brief Exports the completion of the work last submitted for
+     * buffer_index as a sync fence fd, owned by the caller.
+     *
+     * @return The sync fence fd, or -1 on failure.
+     */
+    int TakeOutputSyncFd(int buffer_index);
+
     // --- [OMITTED] PreprocessImage_ZeroCopy, GetOutputAhb (unchanged) ---
     bool PreprocessImage_ZeroCopy(AHardwareBuffer* in_buffer, int in_width, int in_height);
     AHardwareBuffer* GetOutputAhb() { return output_ahb_; }
@@ -120,9 +160,33 @@ class VulkanImageProcessor {
         return last_timings_[buffer_index];
     }
 
+    /**
+     * @brief Places the GPU timestamps of the work last submitted for
+     * buffer_index on the CPU timeline.
+     *
+     * Must be called once that work is complete, e.g. after SyncPreprocess()
+     * or once the consumer of the output AHB waited for it, and before the
+     * next submission for buffer_index.
+     *
+     * @return true on success, false if timestamps are not supported.
+     */
+    bool GetGpuTimeline(int buffer_index, GpuTimeline* timeline);
+
+    /**
+     * @brief Vulkan context, to share with other pipelines such as the
+     * post-processor. Null before Initialize().
+     */
+    VulkanContext* GetContext() const { return context_.get(); }
+
+    /**
+     * @brief Vulkan context, to initialize other processors on the same
+     * device. Null before Initialize().
+     */
+    std::shared_ptr<VulkanContext> ShareContext() const { return context_; }
+
    private:
     // --- Core Vulkan Modules ---
-    std::unique_ptr<VulkanContext> context_;
+    std::shared_ptr<VulkanContext> context_;
     std::unique_ptr<VulkanComputePipeline> compute_pipeline_;
 
     // --- Output Image Properties ---
@@ -159,6 +223,8 @@ class VulkanImageProcessor {
     std::vector<VkFence> fences_;
     std::vector<VkCommandBuffer> command_buffers_; // [ADDED]
     std::vector<TimingInfo> last_timings_;
+    // Steady clock at the end of the last submission, per buffer index.
+    std::vector<int64_t> submit_end_ns_;
 
     // --- Persistent AHB Input Resources (Cache) ---
     AHardwareBuffer* last_in_ahb_ = nullptr;
@@ -179,6 +245,14 @@ class VulkanImageProcessor {
     PFN_vkGetMemoryAndroidHardwareBufferANDROID vkGetMemoryAndroidHardwareBufferANDROID_ = nullptr;
 #endif
 
+#ifdef __ANDROID__
+    // --- AHB Zero-Copy Model Input (one per frame in flight) ---
+    std::vector<VkBuffer> output_ahb_buffers_;
+    std::vector<VkDeviceMemory> output_ahb_buffers_memory_;
+    std::vector<VkSemaphore> output_semaphores_;
+    PFN_vkGetSemaphoreFdKHR vkGetSemaphoreFdKHR_ = nullptr;
+#endif
+
     // --- Private Helper Functions ---
     bool createPersistentResources();
     void destroyPersistentResources();
@@ -186,4 +260,13 @@ class VulkanImageProcessor {
     bool createDescriptorPool();
     // [MODIFIED]
     bool createDescriptorSets();
+    void updateOutputDescriptor(int buffer_index, VkBuffer buffer);
+    // Records the hand-over of the shader output: a copy to the readback
+    // buffer, or nothing but a barrier when writing to an output AHB.
+    void recordOutputCommands(VkCommandBuffer cmd, int buffer_index, VkQueryPool query_pool,
+                              uint32_t query_idx_base, bool can_query_timestamps);
+    bool submitCommands(VkCommandBuffer cmd, int buffer_index);
+#ifdef __ANDROID__
+    void destroyOutputAhbResources();
+#endif
 };
\ No newline at end of file
@@ -36,6 +36,11 @@ typedef struct {
     int input_width;                     // Required input width
     int input_height;                    // Required input height
     bool use_int8_preprocessor = false;  // Default to float
+    // Optional, for TextEnhancer_PostProcess_AHB (Android, Vulkan only).
+    const char* postprocess_shader_path = nullptr;
+    // Optional, number of frames whose timings are kept for
+    // TextEnhancer_GetLatencyStats. 0 disables the history.
+    int timing_history_size = 0;
 } TextEnhancerOptions;
 
 /**
@@ -69,8 +74,38 @@ typedef struct {
     // --- GPU-Only Timings (from vkCmdWriteTimestamp) ---
     double gpu_shader_ms;      // Time for vkCmdDispatch (the compute shader).
     double gpu_readback_ms;    // Time for vkCmdCopyBuffer (device to host buffer).
+
+    // --- Per-Stage Timings (only filled by TextEnhancer_RunBatch) ---
+    double submit_ms;          // Time for TextEnhancer_SubmitPreProcess.
+    double sync_wait_ms;       // Time for TextEnhancer_SyncPreProcess.
+    double inference_ms;       // Time for TextEnhancer_Run.
+    double postprocess_ms;     // Time for TextEnhancer_PostProcess.
 } TextEnhancerPreprocessorTimings;
 
+/**
+ * @brief Latency percentiles of a pipeline stage over the timing history.
+ */
+typedef struct {
+    double p50_ms;
+    double p90_ms;
+    double p99_ms;
+    double max_ms;
+} TextEnhancerLatencyPercentiles;
+
+/**
+ * @brief Latency distributions of the frames of the timing history.
+ *
+ * A stage only counts the frames that went through it.
+ */
+typedef struct {
+    int num_frames;                                 // Frames in the history.
+    TextEnhancerLatencyPercentiles preprocess;      // Submit to the end of Sync.
+    TextEnhancerLatencyPercentiles gpu_preprocess;  // Vulkan work, from GPU timestamps.
+    TextEnhancerLatencyPercentiles inference;       // TextEnhancer_Run.
+    TextEnhancerLatencyPercentiles postprocess;     // TextEnhancer_PostProcess(_AHB).
+    TextEnhancerLatencyPercentiles total;           // Submit to the end of post-processing.
+} TextEnhancerLatencyStats;
+
 
 /**
  * Initializes the Text Enhancer instance.
@@ -80,6 +115,25 @@ typedef struct {
  */
 TextEnhancerSession* TextEnhancer_Initialize(const TextEnhancerOptions& options);
 
+/**
+ * Initializes a Text Enhancer instance sharing the model of another one.
+ *
+ * The new session uses the LiteRT environment, the compiled weights and any
+ * NPU bytecode of `primary`, and the Vulkan device, queue and pipeline cache
+ * of its pre-processor, so that it costs little more than its own input and
+ * output buffers. Each session can then be run from its own thread,
+ * concurrently with the others. `primary` and the sessions sharing it can be
+ * shut down in any order.
+ *
+ * @param options Configuration options. The model_path and accelerator_name
+ * of `primary` are used, whatever these are; the input size and the
+ * pre-processor may differ.
+ * @param primary The session to share the model with.
+ * @return A session handle, or NULL on failure.
+ */
+TextEnhancerSession* TextEnhancer_InitializeShared(const TextEnhancerOptions& options,
+                                                   TextEnhancerSession* primary);
+
 /**
  * @brief Submits an AHardwareBuffer for asynchronous pre-processing (Android only).
  *
@@ -158,6 +212,94 @@ TextEnhancerStatus TextEnhancer_Run(TextEnhancerSession* session, float* inferen
  */
 TextEnhancerStatus TextEnhancer_PostProcess(TextEnhancerSession* session, TextEnhancerOutput& output);
 
+#ifdef __ANDROID__
+/**
+ * @brief Post-processes the model output into an RGBA8 AHardwareBuffer on the
+ * GPU (Android only).
+ *
+ * The output tensor is clamped and packed to RGBA8 by a Vulkan compute shader,
+ * without heap allocations or CPU passes over the pixels. Requires the Vulkan
+ * preprocessor and TextEnhancerOptions::postprocess_shader_path.
+ *
+ * @brief Must be called AFTER TextEnhancer_Run.
+ *
+ * @param session The instance session.
+ * @param output_buffer Destination R8G8B8A8_UNORM AHardwareBuffer of the model
+ * output size, or NULL to use one of the session's pooled buffers. A pooled
+ * buffer is rewritten by the second next call, so its contents must be
+ * consumed before then.
+ * @param output Filled with 'output_buffer' (acquired, 4 channels) and dims,
+ * to be freed with TextEnhancer_FreeOutputData.
+ * @return kTextEnhancerOk on success.
+ */
+TextEnhancerStatus TextEnhancer_PostProcess_AHB(TextEnhancerSession* session,
+                                                AHardwareBuffer* output_buffer,
+                                                TextEnhancerOutput& output);
+#endif
+
+/**
+ * @brief Enhances a batch of raw RGBA images in a single call.
+ *
+ * The pre-processing of each image is submitted before the previous image
+ * is inferred and post-processed, so that the Vulkan crop/resize of an image
+ * overlaps the inference of the previous one. All the images must have the
+ * dimensions the session was initialized with.
+ *
+ * @param session The instance session.
+ * @param rgb_images Array of `num_images` input RGBA images.
+ * @param num_images Number of images in the batch.
+ * @param outputs Array of `num_images` structs filled with the output images,
+ * each to be freed with TextEnhancer_FreeOutputData. Nothing is left to free
+ * on failure.
+ * @param timings Optional array of `num_images` structs filled with the
+ * per-stage timings of each image.
+ * @return kTextEnhancerOk on success.
+ */
+TextEnhancerStatus TextEnhancer_RunBatch(TextEnhancerSession* session,
+                                         const uint8_t* const* rgb_images, int num_images,
+                                         TextEnhancerOutput* outputs,
+                                         TextEnhancerPreprocessorTimings* timings);
+
+#ifdef __ANDROID__
+/**
+ * @brief AHardwareBuffer variant of TextEnhancer_RunBatch (Android only).
+ *
+ * Requires the Vulkan preprocessor.
+ */
+TextEnhancerStatus TextEnhancer_RunBatch_AHB(TextEnhancerSession* session,
+                                             AHardwareBuffer* const* buffers, int num_images,
+                                             TextEnhancerOutput* outputs,
+                                             TextEnhancerPreprocessorTimings* timings);
+#endif
+
+/**
+ * @brief Enhances an image of any size by running the model tile by tile.
+ *
+ * The image is split into tiles of the model input size that overlap by
+ * `tile_overlap` pixels, and the enhanced tiles are blended across the
+ * overlaps into a single output of the image size times the model scale.
+ * Pre-processing of the next tile runs while the current one is inferred,
+ * and the intermediate buffers only depend on the tile size.
+ *
+ * The CPU pre-processor is used for the tiles, whatever the session was
+ * initialized with. Images smaller than a tile are padded by replicating
+ * their edges.
+ *
+ * @param session The instance session.
+ * @param rgb_data The input raw RGBA data.
+ * @param width Width of the input image.
+ * @param height Height of the input image.
+ * @param tile_overlap Overlap between neighboring tiles, in input pixels.
+ * Must be smaller than the tiles.
+ * @param output Filled with the output image, to be freed with
+ * TextEnhancer_FreeOutputData.
+ * @param inference_time_ms Optional output for the total inference time.
+ * @return kTextEnhancerOk on success.
+ */
+TextEnhancerStatus TextEnhancer_RunTiled(TextEnhancerSession* session, const uint8_t* rgb_data,
+                                         int width, int height, int tile_overlap,
+                                         TextEnhancerOutput& output, float* inference_time_ms);
+
 /**
  * Frees the data buffer allocated within the TextEnhancerOutput struct.
  * If output_buffer is non-NULL, it will be released.
@@ -186,6 +328,35 @@ TextEnhancerStatus TextEnhancer_GetLastPreprocessorTimings(
     TextEnhancerSession* session,
     TextEnhancerPreprocessorTimings* timings);
 
+/**
+ * @brief Gets the latency percentiles of each stage over the last frames.
+ *
+ * Requires TextEnhancerOptions::timing_history_size. A frame is recorded once
+ * post-processed, with the timings of its submission, sync and inference.
+ *
+ * @param session The instance session.
+ * @param stats A pointer to a struct to be filled with the percentiles.
+ * @return kTextEnhancerOk on success, or kTextEnhancerFailed if the history
+ * is disabled.
+ */
+TextEnhancerStatus TextEnhancer_GetLatencyStats(TextEnhancerSession* session,
+                                                TextEnhancerLatencyStats* stats);
+
+/**
+ * @brief Writes the timing history as a trace for the Perfetto UI.
+ *
+ * The file is in the Chrome JSON trace format, with one track per stage and
+ * the Vulkan pre-processing on its own track, its GPU timestamps placed on the
+ * CPU timeline. The frames are also emitted as Perfetto slices when LiteRT is
+ * built with Perfetto.
+ *
+ * @param session The instance session.
+ * @param path Path of the JSON file to write.
+ * @return kTextEnhancerOk on success, or kTextEnhancerFailed if the history
+ * is disabled or the file cannot be written.
+ */
+TextEnhancerStatus TextEnhancer_ExportLatencyTrace(TextEnhancerSession* session, const char* path);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
\ No newline at end of file
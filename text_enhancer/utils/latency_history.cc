@@ -0,0 +1,93 @@
+#include "latency_history.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+const char* const kTracks[] = {"Preprocess", "Preprocess (GPU)", "Inference", "Postprocess"};
+
+// Thread id of `track` in the JSON trace, one per track.
+int TrackId(const char* track) {
+    for (size_t i = 0; i < sizeof(kTracks) / sizeof(kTracks[0]); ++i) {
+        if (track == kTracks[i]) return static_cast<int>(i) + 1;
+    }
+    return 0;
+}
+
+}  // namespace
+
+LatencyHistory::LatencyHistory(size_t capacity) : frames_(capacity) {}
+
+void LatencyHistory::Add(const FrameTimeline& frame) {
+    if (frames_.empty()) return;
+    frames_[next_] = frame;
+    next_ = (next_ + 1) % frames_.size();
+    size_ = std::min(size_ + 1, frames_.size());
+}
+
+std::vector<FrameTimeline> LatencyHistory::Frames() const {
+    std::vector<FrameTimeline> frames;
+    frames.reserve(size_);
+    const size_t oldest = (next_ + frames_.size() - size_) % std::max<size_t>(frames_.size(), 1);
+    for (size_t i = 0; i < size_; ++i) {
+        frames.push_back(frames_[(oldest + i) % frames_.size()]);
+    }
+    return frames;
+}
+
+double LatencyHistory::Percentile(std::vector<double>& values, double fraction) {
+    if (values.empty()) return 0.0;
+    fraction = std::min(std::max(fraction, 0.0), 1.0);
+    size_t rank = static_cast<size_t>(std::ceil(fraction * values.size()));
+    size_t index = rank > 0 ? rank - 1 : 0;
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+void LatencyHistory::ForEachSlice(const FrameTimeline& frame, const SliceCallback& callback) {
+    auto emit = [&](const char* track, const char* name, int64_t start_ns, int64_t end_ns) {
+        if (start_ns > 0 && end_ns >= start_ns) {
+            callback(track, name, start_ns, end_ns);
+        }
+    };
+    emit(kTracks[0], "Preprocess", frame.preprocess_start_ns, frame.preprocess_end_ns);
+    emit(kTracks[1], "Crop/resize shader", frame.gpu_shader_start_ns, frame.gpu_shader_end_ns);
+    emit(kTracks[1], "Output", frame.gpu_shader_end_ns, frame.gpu_output_end_ns);
+    emit(kTracks[2], "Inference", frame.inference_start_ns, frame.inference_end_ns);
+    emit(kTracks[3], "Postprocess", frame.postprocess_start_ns, frame.postprocess_end_ns);
+}
+
+bool LatencyHistory::WriteTrace(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) return false;
+
+    file << "{\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&]() -> const char* {
+        const char* s = first ? "\n" : ",\n";
+        first = false;
+        return s;
+    };
+    for (const char* track : kTracks) {
+        file << separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+             << TrackId(track) << ",\"args\":{\"name\":\"" << track << "\"}}";
+    }
+    // Timestamps are in microseconds.
+    char buffer[256];
+    for (const FrameTimeline& frame : Frames()) {
+        ForEachSlice(frame, [&](const char* track, const char* name, int64_t start_ns,
+                                int64_t end_ns) {
+            snprintf(buffer, sizeof(buffer),
+                     "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,"
+                     "\"dur\":%.3f,\"args\":{\"frame\":%llu}}",
+                     name, TrackId(track), start_ns / 1000.0, (end_ns - start_ns) / 1000.0,
+                     static_cast<unsigned long long>(frame.frame_index));
+            file << separator() << buffer;
+        });
+    }
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Timeline of one frame through the pipeline, in nanoseconds of
+ * std::chrono::steady_clock. Stages the frame did not go through are 0.
+ */
+struct FrameTimeline {
+    uint64_t frame_index = 0;
+
+    // --- CPU Stages ---
+    int64_t preprocess_start_ns = 0;   // Start of the submission.
+    int64_t preprocess_end_ns = 0;     // End of the sync.
+    int64_t inference_start_ns = 0;
+    int64_t inference_end_ns = 0;
+    int64_t postprocess_start_ns = 0;
+    int64_t postprocess_end_ns = 0;
+
+    // --- GPU Pre-processing (Vulkan queries, on the CPU timeline) ---
+    int64_t gpu_shader_start_ns = 0;
+    int64_t gpu_shader_end_ns = 0;
+    int64_t gpu_output_end_ns = 0;
+};
+
+/**
+ * @brief Ring buffer of the timelines of the last frames.
+ */
+class LatencyHistory {
+   public:
+    // Called with the track, the name, the start and the end of a slice.
+    using SliceCallback =
+        std::function<void(const char* track, const char* name, int64_t start_ns, int64_t end_ns)>;
+
+    explicit LatencyHistory(size_t capacity);
+
+    /**
+     * @brief Records a frame, overwriting the oldest one when full.
+     */
+    void Add(const FrameTimeline& frame);
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return frames_.size(); }
+
+    /**
+     * @brief Returns the recorded frames, oldest first.
+     */
+    std::vector<FrameTimeline> Frames() const;
+
+    /**
+     * @brief Returns the nearest-rank percentile `fraction` (in [0, 1]) of
+     * `values`, which is reordered. Returns 0 for no values.
+     */
+    static double Percentile(std::vector<double>& values, double fraction);
+
+    /**
+     * @brief Calls `callback` for each stage `frame` went through, the GPU
+     * stages on their own track.
+     */
+    static void ForEachSlice(const FrameTimeline& frame, const SliceCallback& callback);
+
+    /**
+     * @brief Writes the recorded frames to `path` in the Chrome JSON trace
+     * format, which the Perfetto UI opens, with one track per stage.
+     *
+     * @return true on success, false if the file cannot be written.
+     */
+    bool WriteTrace(const std::string& path) const;
+
+   private:
+    std::vector<FrameTimeline> frames_;
+    size_t next_ = 0;
+    size_t size_ = 0;
+};
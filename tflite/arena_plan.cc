@@ -0,0 +1,132 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/arena_plan.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace tflite {
+namespace {
+
+// Values are serialized as protobuf varints, i.e., in chunks of 7 bits each.
+constexpr int kMod = (1 << 7);
+
+void Serialize(std::string* out, uint64_t value) {
+  for (; value >= kMod; value /= kMod) {
+    out->push_back(value % kMod + kMod);
+  }
+  out->push_back(value);
+}
+
+bool Parse(const char** data, size_t* size, uint64_t* out) {
+  *out = 0;
+  for (int shift = 0;; shift += 7) {
+    if (*size == 0 || shift >= 64) {
+      return false;
+    }
+    const unsigned char byte = **data;
+    ++*data;
+    --*size;
+    *out |= static_cast<uint64_t>(byte % kMod) << shift;
+    if (!(byte & kMod)) {
+      return true;
+    }
+  }
+}
+
+bool ParseSize(const char** data, size_t* size, size_t* out) {
+  uint64_t value = 0;
+  if (!Parse(data, size, &value) ||
+      value > std::numeric_limits<size_t>::max()) {
+    return false;
+  }
+  *out = value;
+  return true;
+}
+
+// Tensor and node indices are never negative.
+bool ParseIndex(const char** data, size_t* size, int32_t* out) {
+  uint64_t value = 0;
+  if (!Parse(data, size, &value) ||
+      value > std::numeric_limits<int32_t>::max()) {
+    return false;
+  }
+  *out = value;
+  return true;
+}
+
+}  // namespace
+
+std::string SerializeModelArenaPlan(const ModelArenaPlan& in) {
+  std::string out;
+  Serialize(&out, kModelArenaPlanMetadataVersion);
+  Serialize(&out, in.size());
+  for (const auto& plan : in) {
+    Serialize(&out, plan.arena_size);
+    Serialize(&out, plan.allocs.size());
+    for (const auto& alloc : plan.allocs) {
+      Serialize(&out, alloc.tensor);
+      Serialize(&out, alloc.first_node);
+      Serialize(&out, alloc.last_node);
+      Serialize(&out, alloc.offset);
+      Serialize(&out, alloc.size);
+    }
+  }
+  return out;
+}
+
+bool ParseModelArenaPlan(const char* data, size_t size, ModelArenaPlan* out) {
+  out->clear();
+  uint64_t version = 0;
+  size_t num_plans = 0;
+  if (!Parse(&data, &size, &version) ||
+      version != kModelArenaPlanMetadataVersion ||
+      !ParseSize(&data, &size, &num_plans) || num_plans > size) {
+    return false;
+  }
+  out->resize(num_plans);
+  for (auto& plan : *out) {
+    size_t num_allocs = 0;
+    // Each alloc takes at least 5 bytes.
+    if (!ParseSize(&data, &size, &plan.arena_size) ||
+        !ParseSize(&data, &size, &num_allocs) || num_allocs > size / 5) {
+      return false;
+    }
+    plan.allocs.resize(num_allocs);
+    for (auto& alloc : plan.allocs) {
+      if (!ParseIndex(&data, &size, &alloc.tensor) ||
+          !ParseIndex(&data, &size, &alloc.first_node) ||
+          !ParseIndex(&data, &size, &alloc.last_node) ||
+          !ParseSize(&data, &size, &alloc.offset) ||
+          !ParseSize(&data, &size, &alloc.size)) {
+        return false;
+      }
+    }
+  }
+  return size == 0;
+}
+
+size_t GetArenaPlanSize(const SubgraphArenaPlan& plan) {
+  size_t arena_size = 0;
+  for (const auto& alloc : plan.allocs) {
+    arena_size = std::max(arena_size, alloc.offset + alloc.size);
+  }
+  return arena_size;
+}
+
+}  // namespace tflite
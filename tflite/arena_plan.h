@@ -0,0 +1,70 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_ARENA_PLAN_H_
+#define TENSORFLOW_LITE_ARENA_PLAN_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tflite {
+
+// The placement of a tensor in the non-persistent arena of a subgraph.
+struct ArenaPlanAlloc {
+  int32_t tensor;
+  // Execution plan indices of the first and last nodes using the tensor.
+  int32_t first_node;
+  int32_t last_node;
+  size_t offset;
+  size_t size;
+};
+
+// The placement of all the tensors of the non-persistent arena of a subgraph,
+// computed offline so that loading the model skips planning it. It only
+// applies while the tensors keep the sizes and usage intervals it was computed
+// for.
+struct SubgraphArenaPlan {
+  size_t arena_size = 0;
+  std::vector<ArenaPlanAlloc> allocs;
+};
+
+// The arena plans of the subgraphs of a model, indexed by subgraph. A subgraph
+// without a plan has no allocs.
+using ModelArenaPlan = std::vector<SubgraphArenaPlan>;
+
+// Serializes `in` into the returned string. The result is parseable with
+// ParseModelArenaPlan.
+std::string SerializeModelArenaPlan(const ModelArenaPlan& in);
+
+// Deserializes `*out` from a character buffer of size `size` at `data`.
+// Returns true iff successful. When returning false, `*out`'s state is
+// undefined.
+bool ParseModelArenaPlan(const char* data, size_t size, ModelArenaPlan* out);
+
+// Returns the size of the arena holding the allocs of `plan`.
+size_t GetArenaPlanSize(const SubgraphArenaPlan& plan);
+
+// The key under which to store the serialized arena plan in the model's
+// metadata.
+constexpr char kModelArenaPlanMetadataKey[] = "arena_plan";
+
+// The version of the serialized arena plan. Plans of other versions are
+// ignored, and planned again at runtime.
+constexpr uint32_t kModelArenaPlanMetadataVersion = 1;
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_ARENA_PLAN_H_
@@ -0,0 +1,79 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/arena_plan.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace tflite {
+namespace {
+
+ModelArenaPlan MakePlan() {
+  ModelArenaPlan plan(3);
+  plan[0].allocs = {{0, 0, 2, 0, 100},
+                    {3, 1, std::numeric_limits<int32_t>::max(), 128, 12},
+                    {7, 2, 2, 0, size_t{1} << 40}};
+  plan[0].arena_size = GetArenaPlanSize(plan[0]);
+  plan[2].allocs = {{1, 0, 0, 64, 64}};
+  plan[2].arena_size = GetArenaPlanSize(plan[2]);
+  return plan;
+}
+
+TEST(ArenaPlanTest, RoundTrip) {
+  const ModelArenaPlan plan = MakePlan();
+  EXPECT_EQ(plan[0].arena_size, size_t{1} << 40);
+  EXPECT_EQ(plan[2].arena_size, 128);
+
+  const std::string serialized = SerializeModelArenaPlan(plan);
+  ModelArenaPlan parsed;
+  ASSERT_TRUE(
+      ParseModelArenaPlan(serialized.data(), serialized.size(), &parsed));
+  ASSERT_EQ(parsed.size(), plan.size());
+  for (size_t i = 0; i < plan.size(); ++i) {
+    EXPECT_EQ(parsed[i].arena_size, plan[i].arena_size);
+    ASSERT_EQ(parsed[i].allocs.size(), plan[i].allocs.size());
+    for (size_t j = 0; j < plan[i].allocs.size(); ++j) {
+      EXPECT_EQ(parsed[i].allocs[j].tensor, plan[i].allocs[j].tensor);
+      EXPECT_EQ(parsed[i].allocs[j].first_node, plan[i].allocs[j].first_node);
+      EXPECT_EQ(parsed[i].allocs[j].last_node, plan[i].allocs[j].last_node);
+      EXPECT_EQ(parsed[i].allocs[j].offset, plan[i].allocs[j].offset);
+      EXPECT_EQ(parsed[i].allocs[j].size, plan[i].allocs[j].size);
+    }
+  }
+}
+
+TEST(ArenaPlanTest, ParseRejectsMalformedData) {
+  const std::string serialized = SerializeModelArenaPlan(MakePlan());
+  ModelArenaPlan parsed;
+  // Truncated.
+  EXPECT_FALSE(
+      ParseModelArenaPlan(serialized.data(), serialized.size() - 1, &parsed));
+  // Trailing data.
+  const std::string trailing = serialized + "x";
+  EXPECT_FALSE(ParseModelArenaPlan(trailing.data(), trailing.size(), &parsed));
+  // Other version.
+  std::string other_version = serialized;
+  other_version[0] = kModelArenaPlanMetadataVersion + 1;
+  EXPECT_FALSE(ParseModelArenaPlan(other_version.data(), other_version.size(),
+                                   &parsed));
+  EXPECT_FALSE(ParseModelArenaPlan(nullptr, 0, &parsed));
+}
+
+}  // namespace
+}  // namespace tflite
@@ -20,12 +20,14 @@ limitations under the License.
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "tflite/core/c/common.h"
 #include "tflite/graph_info.h"
 #include "tflite/simple_memory_arena.h"
+#include "tflite/tensor_views.h"
 
 namespace tflite {
 
@@ -33,6 +35,22 @@ constexpr int32_t kLastActiveNodeUndefined =
     std::numeric_limits<int32_t>::max();
 constexpr int32_t kNodeNotAssigned = std::numeric_limits<int32_t>::max();
 constexpr int32_t kScalarTensorBytes = 4;
+// Tensor index of the allocs of node memory. -1 marks the allocs to delete in
+// SimpleMemoryArena.
+constexpr int32_t kNodeMemoryTensor = -2;
+
+namespace {
+
+bool HasDynamicTensors(GraphInfo& graph_info) {
+  for (size_t i = 0; i < graph_info.num_tensors(); ++i) {
+    if (graph_info.tensor(i)->allocation_type == kTfLiteDynamic) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
 
 ArenaPlanner::ArenaPlanner(TfLiteContext* context,
                            std::unique_ptr<GraphInfo> graph_info,
@@ -45,7 +63,14 @@ ArenaPlanner::ArenaPlanner(TfLiteContext* context,
       persistent_arena_(kDefaultArenaAlignment, subgraph_index),
       preserve_all_tensors_(preserve_all_tensors),
       tensor_alignment_(tensor_alignment),
-      last_active_node_(kLastActiveNodeUndefined) {}
+      last_active_node_(kLastActiveNodeUndefined),
+      caller_(nullptr),
+      caller_node_(-1),
+      caller_offset_(0),
+      caller_size_(0),
+      arena_plan_(nullptr),
+      incremental_planning_(false),
+      planned_for_node_levels_(false) {}
 
 ArenaPlanner::~ArenaPlanner() {
   arena_.ReleaseBuffer();
@@ -62,11 +87,23 @@ std::intptr_t ArenaPlanner::BasePointer(TfLiteAllocationType type) {
   return 0;
 }
 
+void ArenaPlanner::SetBufferOptions(const ArenaBufferOptions& options) {
+  arena_.SetBufferOptions(options);
+  persistent_arena_.SetBufferOptions(options);
+}
+
 TfLiteStatus ArenaPlanner::ResetAllocations() {
   TF_LITE_ENSURE_STATUS(arena_.ClearPlan());
   TF_LITE_ENSURE_STATUS(persistent_arena_.ClearPlan());
+  if (incremental_planning_ && last_active_node_ != kLastActiveNodeUndefined) {
+    previous_allocs_.swap(allocs_);
+  }
   allocs_.clear();
   allocs_.resize(graph_info_->num_tensors());
+  for (auto& alloc : node_memory_allocs_) {
+    alloc.reset();
+  }
+  planned_for_node_levels_ = false;
   // NOMUTANTS -- Setting last_active_node_ to kLastActiveNodeUndefined causes
   // all allocs to be cleared. if this is not set, the slow path is taken
   // (Purge) which inspects each alloc. Both paths give the exact same result.
@@ -85,12 +122,28 @@ TfLiteStatus ArenaPlanner::ResetAllocationsAfter(int node) {
       }
     }
   }
+  bool has_node_memory = false;
+  for (int i = 0; i < static_cast<int>(node_memory_allocs_.size()); ++i) {
+    if (i > node) {
+      node_memory_allocs_[i].reset();
+    } else if (node_memory_allocs_[i].size > 0) {
+      has_node_memory = true;
+    }
+  }
   if (last_active_node_ > node) {
-    arena_.CalculateActiveAllocs(allocs_, node);
+    if (has_node_memory) {
+      std::vector<ArenaAllocWithUsageInterval> allocs = allocs_;
+      allocs.insert(allocs.end(), node_memory_allocs_.begin(),
+                    node_memory_allocs_.end());
+      arena_.CalculateActiveAllocs(allocs, node);
+    } else {
+      arena_.CalculateActiveAllocs(allocs_, node);
+    }
   } else {
     arena_.PurgeAfter(node);
   }
   last_active_node_ = node;
+  planned_for_node_levels_ = false;
   return kTfLiteOk;
 }
 
@@ -99,6 +152,10 @@ int ArenaPlanner::FindSharedTensor(int tensor_index) {
   if (actual_tensor_it != actual_tensor_id_.end()) {
     tensor_index = actual_tensor_it->second;
   }
+  auto view_it = tensor_views_.find(tensor_index);
+  if (view_it != tensor_views_.end()) {
+    tensor_index = view_it->second.base;
+  }
   return tensor_index;
 }
 
@@ -201,6 +258,98 @@ void ArenaPlanner::IdentifyInPlaceTensors() {
   }
 }
 
+// A tensor can be a view of another if both are allocated in the non
+// persistent arena, neither is an input, output or variable of the subgraph
+// nor shares its memory with another tensor, and the view is aligned. Chains
+// of views are not planned, so that views are placed in their base directly.
+void ArenaPlanner::IdentifyTensorViews() {
+  if (preserve_all_tensors_) {
+    return;
+  }
+  // NOLINTNEXTLINE - absl::flat_hash_set increases binary size by 106kB.
+  std::unordered_set<int32_t> excluded(graph_info_->inputs().begin(),
+                                       graph_info_->inputs().end());
+  excluded.insert(graph_info_->outputs().begin(), graph_info_->outputs().end());
+  excluded.insert(graph_info_->variables().begin(),
+                  graph_info_->variables().end());
+  for (const auto& [tensor_index, actual_tensor_index] : actual_tensor_id_) {
+    excluded.insert(tensor_index);
+    excluded.insert(actual_tensor_index);
+  }
+  // NOLINTNEXTLINE - absl::flat_hash_set increases binary size by 106kB.
+  std::unordered_set<int32_t> bases;
+  TfLiteTensor* tensors = graph_info_->tensors();
+  std::vector<TensorView> views;
+  const int num_execution_nodes = graph_info_->num_execution_nodes();
+  for (int i = 0; i < num_execution_nodes; ++i) {
+    views.clear();
+    if (!GetTensorViews(graph_info_->registration(i).builtin_code,
+                        graph_info_->node(i), tensors, &views)) {
+      continue;
+    }
+    bool placeable = true;
+    for (const TensorView& view : views) {
+      if (excluded.count(view.tensor) > 0 || excluded.count(view.base) > 0 ||
+          tensor_views_.count(view.tensor) > 0 ||
+          tensor_views_.count(view.base) > 0 || bases.count(view.tensor) > 0 ||
+          !CanPlaceTensorView(view)) {
+        placeable = false;
+        break;
+      }
+    }
+    if (!placeable) {
+      continue;
+    }
+    for (const TensorView& view : views) {
+      tensor_views_[view.tensor] = view;
+      bases.insert(view.base);
+    }
+    view_nodes_.push_back(i);
+  }
+}
+
+bool ArenaPlanner::CanPlaceTensorView(const TensorView& view) {
+  return graph_info_->tensor(view.tensor)->allocation_type == kTfLiteArenaRw &&
+         graph_info_->tensor(view.base)->allocation_type == kTfLiteArenaRw &&
+         view.offset % tensor_alignment_ == 0;
+}
+
+void ArenaPlanner::UpdateTensorViews() {
+  TfLiteTensor* tensors = graph_info_->tensors();
+  std::vector<TensorView> views;
+  std::vector<int> view_nodes;
+  for (const int node_index : view_nodes_) {
+    const TfLiteNode& node = graph_info_->node(node_index);
+    views.clear();
+    bool placeable = GetTensorViews(
+        graph_info_->registration(node_index).builtin_code, node, tensors,
+        &views);
+    for (const TensorView& view : views) {
+      placeable = placeable && CanPlaceTensorView(view);
+    }
+    if (placeable) {
+      for (const TensorView& view : views) {
+        tensor_views_[view.tensor].offset = view.offset;
+      }
+      view_nodes.push_back(node_index);
+      continue;
+    }
+    // The views of a node are among its inputs and outputs, and none of them
+    // is a view of another node.
+    for (const TfLiteIntArray* node_tensors : {node.inputs, node.outputs}) {
+      for (int j = 0; j < node_tensors->size; ++j) {
+        tensor_views_.erase(node_tensors->data[j]);
+      }
+    }
+  }
+  view_nodes_.swap(view_nodes);
+}
+
+void ArenaPlanner::DropTensorViews() {
+  tensor_views_.clear();
+  view_nodes_.clear();
+}
+
 TfLiteStatus ArenaPlanner::PlanAllocations() {
   // Invalidate any existing data.
   const size_t num_tensors = graph_info_->num_tensors();
@@ -211,9 +360,35 @@ TfLiteStatus ArenaPlanner::PlanAllocations() {
   nodes_to_tensors_.clear();
   nodes_to_tensors_.resize(
       std::max(graph_info_->num_execution_nodes(), (size_t)1), {});
+  node_memory_sizes_.assign(graph_info_->num_execution_nodes(), 0);
+  node_memory_allocs_.assign(graph_info_->num_execution_nodes(), {});
+
+  // The levels only apply to the nodes they were set for, if they are
+  // contiguous.
+  level_first_node_.clear();
+  level_last_node_.clear();
+  const int num_nodes = graph_info_->num_execution_nodes();
+  if (static_cast<int>(node_levels_.size()) == num_nodes &&
+      std::is_sorted(node_levels_.begin(), node_levels_.end())) {
+    level_first_node_.resize(num_nodes);
+    level_last_node_.resize(num_nodes);
+    for (int i = 0; i < num_nodes; ++i) {
+      level_first_node_[i] =
+          i > 0 && node_levels_[i] == node_levels_[i - 1]
+              ? level_first_node_[i - 1]
+              : i;
+    }
+    for (int i = num_nodes - 1; i >= 0; --i) {
+      level_last_node_[i] =
+          i + 1 < num_nodes && node_levels_[i] == node_levels_[i + 1]
+              ? level_last_node_[i + 1]
+              : i;
+    }
+  }
 
   // Keeps track of references to each tensor.
   refcounts_.assign(num_tensors, 0);
+  DropTensorViews();
 
   auto allocate = [this](int node, int tensor) -> TfLiteStatus {
     if (alloc_node_[tensor] != kNodeNotAssigned) {
@@ -285,6 +460,7 @@ TfLiteStatus ArenaPlanner::PlanAllocations() {
   }
 
   IdentifyInPlaceTensors();
+  IdentifyTensorViews();
   // Use the new reference counts to determine when tensors memory can safely be
   // reused.
   for (size_t i = 0; i < num_execution_nodes; ++i) {
@@ -293,6 +469,11 @@ TfLiteStatus ArenaPlanner::PlanAllocations() {
     for (int j = 0; j < node_inputs->size; ++j) {
       int tensor_index = node_inputs->data[j];
       if (tensor_index != kTfLiteOptionalTensor) {
+        // Views are also counted on their own, so that they are deallocated in
+        // time if they are dropped when the tensors are allocated.
+        if (tensor_views_.count(tensor_index) > 0) {
+          ++refcounts[tensor_index];
+        }
         // Correctly count references for shared buffers.
         tensor_index = FindSharedTensor(tensor_index);
         ++refcounts[tensor_index];
@@ -311,6 +492,12 @@ TfLiteStatus ArenaPlanner::PlanAllocations() {
       //  Don't allocate output tensors here for shared memory parts.
       nodes_to_tensors_[i].insert(tensor_index);
       TF_LITE_ENSURE_STATUS(allocate(i, tensor_index));
+      // The base of a view is allocated no later than the view.
+      auto view_it = tensor_views_.find(tensor_index);
+      if (view_it != tensor_views_.end()) {
+        nodes_to_tensors_[i].insert(view_it->second.base);
+        TF_LITE_ENSURE_STATUS(allocate(i, view_it->second.base));
+      }
     }
 
     // Then update the ref-counts of the node's inputs, and if necessary queue
@@ -321,6 +508,10 @@ TfLiteStatus ArenaPlanner::PlanAllocations() {
         // If the tensor is a ref we decrement the original tensor.
         int tensor_index = node_inputs->data[j];
         if (tensor_index != kTfLiteOptionalTensor) {
+          if (tensor_views_.count(tensor_index) > 0 &&
+              --refcounts[tensor_index] == 0) {
+            TF_LITE_ENSURE_STATUS(deallocate(i, tensor_index));
+          }
           // Correctly count references for shared buffers.
           tensor_index = FindSharedTensor(tensor_index);
           --refcounts[tensor_index];
@@ -333,9 +524,24 @@ TfLiteStatus ArenaPlanner::PlanAllocations() {
   }
   // Note that graph outputs will never be scheduled for deallocation. We
   // could do that here for completeness, but it won't have any effect.
+  WidenToNodeLevels();
   return kTfLiteOk;
 }
 
+void ArenaPlanner::WidenToNodeLevels() {
+  if (level_first_node_.empty()) {
+    return;
+  }
+  for (size_t i = 0; i < alloc_node_.size(); ++i) {
+    if (alloc_node_[i] != kNodeNotAssigned) {
+      alloc_node_[i] = level_first_node_[alloc_node_[i]];
+    }
+    if (dealloc_node_[i] != kNodeNotAssigned) {
+      dealloc_node_[i] = level_last_node_[dealloc_node_[i]];
+    }
+  }
+}
+
 TfLiteStatus ArenaPlanner::ExecuteAllocations(int first_node, int last_node) {
   // Grow the size of `allocs_` if necessary. This allows allocating temporary
   // tensors in op's `prepare` function.
@@ -352,10 +558,12 @@ TfLiteStatus ArenaPlanner::ExecuteAllocations(int first_node, int last_node) {
     TfLiteIntArray* node_temporaries = node.temporaries;
     for (int j = 0; j < node_temporaries->size; ++j) {
       int tensor_index = node_temporaries->data[j];
-      alloc_node_[tensor_index] = i;
+      alloc_node_[tensor_index] =
+          level_first_node_.empty() ? i : level_first_node_[i];
       nodes_to_tensors_[i].insert(tensor_index);
       if (!preserve_all_tensors_) {
-        dealloc_node_[tensor_index] = i;
+        dealloc_node_[tensor_index] =
+            level_last_node_.empty() ? i : level_last_node_[i];
       }
     }
   }
@@ -363,6 +571,9 @@ TfLiteStatus ArenaPlanner::ExecuteAllocations(int first_node, int last_node) {
   std::vector<int32_t> tensors_allocated;
   TF_LITE_ENSURE_STATUS(
       CalculateAllocations(first_node, last_node, &tensors_allocated));
+  if (first_node == 0 && last_node + 1 >= num_execution_nodes) {
+    planned_for_node_levels_ = !level_first_node_.empty();
+  }
   bool arena_reallocated = false;
   TF_LITE_ENSURE_STATUS(Commit(&arena_reallocated));
 
@@ -399,6 +610,7 @@ TfLiteStatus ArenaPlanner::ReleaseNonPersistentMemory() {
 TfLiteStatus ArenaPlanner::AcquireNonPersistentMemory() {
   // First commit arena_ to allocate underlying buffer.
   bool reallocated;
+  UpdateSharedNodeMemory();
   TF_LITE_ENSURE_STATUS(arena_.Commit(&reallocated));
   has_nonpersistent_memory_ = true;
   // Resolve allocations for all tensors not on the persistent arena.
@@ -428,8 +640,222 @@ void ArenaPlanner::GetAllocInfo(size_t* arena_size,
   *arena_persist_size = persistent_arena_.GetBufferSize();
 }
 
+size_t ArenaPlanner::GetNonPersistentMemorySize() const {
+  return arena_.GetHighWaterMark();
+}
+
+bool ArenaPlanner::ReserveNodeMemory(int node, size_t size) {
+  if (node < 0) {
+    return false;
+  }
+  if (node >= static_cast<int>(node_memory_sizes_.size())) {
+    node_memory_sizes_.resize(node + 1, 0);
+    node_memory_allocs_.resize(node + 1);
+  }
+  node_memory_sizes_[node] = size;
+  return true;
+}
+
+char* ArenaPlanner::GetNodeMemory(int node) {
+  if (!has_nonpersistent_memory_ || node < 0 ||
+      node >= static_cast<int>(node_memory_allocs_.size()) ||
+      node_memory_allocs_[node].size == 0) {
+    return nullptr;
+  }
+  char* ptr = nullptr;
+  if (arena_.ResolveAlloc(context_, node_memory_allocs_[node], &ptr) !=
+      kTfLiteOk) {
+    return nullptr;
+  }
+  return ptr;
+}
+
+void ArenaPlanner::ShareNodeMemory(MemoryPlanner* caller, int node,
+                                   size_t offset, size_t size) {
+  caller_ = caller;
+  caller_node_ = node;
+  caller_offset_ = offset;
+  caller_size_ = size;
+}
+
+size_t ArenaPlanner::GetNodeMemorySavings() const {
+  size_t tensors_end = 0;
+  for (const auto& alloc : allocs_) {
+    if (alloc.size > 0 && alloc.tensor >= 0 &&
+        graph_info_->tensor(alloc.tensor)->allocation_type == kTfLiteArenaRw) {
+      tensors_end = std::max(tensors_end, alloc.offset + alloc.size);
+    }
+  }
+  size_t node_memory_end = 0;
+  size_t node_memory_size = 0;
+  for (const auto& alloc : node_memory_allocs_) {
+    node_memory_end = std::max(node_memory_end, alloc.offset + alloc.size);
+    node_memory_size += alloc.size;
+  }
+  // The node memory placed above the tensors is what it costs.
+  const size_t growth =
+      node_memory_end > tensors_end ? node_memory_end - tensors_end : 0;
+  return node_memory_size > growth ? node_memory_size - growth : 0;
+}
+
+bool ArenaPlanner::GetArenaPlan(SubgraphArenaPlan* plan) const {
+  if (last_active_node_ == kLastActiveNodeUndefined) {
+    return false;
+  }
+  // The plan can't place the node memory.
+  for (const auto& alloc : node_memory_allocs_) {
+    if (alloc.size > 0) {
+      return false;
+    }
+  }
+  plan->allocs.clear();
+  for (int i = 0; i < static_cast<int>(allocs_.size()); ++i) {
+    const ArenaAllocWithUsageInterval& alloc = allocs_[i];
+    if (alloc.size == 0 || alloc.tensor != i ||
+        graph_info_->tensor(i)->allocation_type != kTfLiteArenaRw) {
+      continue;
+    }
+    // With incremental planning, the alloc may be larger than the tensor.
+    plan->allocs.push_back({i, alloc.first_node, alloc.last_node, alloc.offset,
+                            graph_info_->tensor(i)->bytes});
+  }
+  plan->arena_size = GetArenaPlanSize(*plan);
+  return true;
+}
+
+void ArenaPlanner::SetArenaPlan(const SubgraphArenaPlan* plan) {
+  arena_plan_ = plan;
+}
+
+bool ArenaPlanner::AllocateFromArenaPlan(
+    int first_node, int last_node,
+    const std::vector<int32_t>& tensors_to_allocate) {
+  // The plan covers the lifetime of all the tensors, so it only applies when
+  // they are all allocated at once.
+  if (arena_plan_ == nullptr || arena_plan_->allocs.empty() ||
+      first_node != 0 ||
+      last_node + 1 < static_cast<int>(graph_info_->num_execution_nodes())) {
+    return false;
+  }
+  TfLiteTensor* tensors = graph_info_->tensors();
+  std::vector<const ArenaPlanAlloc*> planned_allocs(
+      graph_info_->num_tensors(), nullptr);
+  for (const auto& alloc : arena_plan_->allocs) {
+    if (alloc.tensor < 0 || alloc.tensor >= planned_allocs.size()) {
+      return false;
+    }
+    planned_allocs[alloc.tensor] = &alloc;
+  }
+  size_t num_planned = 0;
+  for (const int32_t tensor_index : tensors_to_allocate) {
+    const ArenaPlanAlloc* alloc = planned_allocs[tensor_index];
+    if (tensors[tensor_index].bytes == 0) {
+      continue;
+    }
+    // The plan is stale if the model or the tensor sizes changed.
+    if (alloc == nullptr || alloc->size != tensors[tensor_index].bytes ||
+        alloc->first_node != alloc_node_[tensor_index] ||
+        alloc->last_node != dealloc_node_[tensor_index]) {
+      return false;
+    }
+    ++num_planned;
+  }
+  if (num_planned != arena_plan_->allocs.size()) {
+    return false;
+  }
+  for (const int32_t tensor_index : tensors_to_allocate) {
+    const ArenaPlanAlloc* alloc = planned_allocs[tensor_index];
+    const size_t offset = alloc == nullptr ? 0 : alloc->offset;
+    if (arena_.AllocateAt(context_, tensor_alignment_, offset,
+                          tensors[tensor_index].bytes, tensor_index,
+                          alloc_node_[tensor_index],
+                          dealloc_node_[tensor_index],
+                          &allocs_[tensor_index]) != kTfLiteOk) {
+      // Drop the allocs of the plan, and its size.
+      arena_.ClearPlan();
+      return false;
+    }
+  }
+  return true;
+}
+
+void ArenaPlanner::SetIncrementalPlanning(bool incremental_planning) {
+  incremental_planning_ = incremental_planning;
+  arena_.SetGrowInSizeClasses(incremental_planning);
+  if (!incremental_planning) {
+    previous_allocs_.clear();
+  }
+}
+
+bool ArenaPlanner::AllocateIncrementally(
+    int first_node, const std::vector<int32_t>& tensors_to_allocate) {
+  if (!incremental_planning_ || first_node != 0 || previous_allocs_.empty()) {
+    return false;
+  }
+  TfLiteTensor* tensors = graph_info_->tensors();
+  std::vector<int32_t> tensors_to_place;
+  for (const int32_t tensor_index : tensors_to_allocate) {
+    const size_t bytes = tensors[tensor_index].bytes;
+    const ArenaAllocWithUsageInterval* previous =
+        tensor_index < static_cast<int>(previous_allocs_.size())
+            ? &previous_allocs_[tensor_index]
+            : nullptr;
+    // Tensors that shrank keep their larger alloc, so that growing back to
+    // their previous size doesn't move them.
+    if (previous == nullptr || previous->tensor != tensor_index ||
+        bytes == 0 || previous->size < bytes ||
+        previous->first_node != alloc_node_[tensor_index] ||
+        previous->last_node != dealloc_node_[tensor_index]) {
+      tensors_to_place.push_back(tensor_index);
+      continue;
+    }
+    if (arena_.AllocateAt(context_, tensor_alignment_, previous->offset,
+                          previous->size, tensor_index,
+                          alloc_node_[tensor_index],
+                          dealloc_node_[tensor_index],
+                          &allocs_[tensor_index]) != kTfLiteOk) {
+      arena_.ClearPlan();
+      return false;
+    }
+  }
+  for (const int32_t tensor_index : tensors_to_place) {
+    if (arena_.Allocate(context_, tensor_alignment_,
+                        tensors[tensor_index].bytes, tensor_index,
+                        alloc_node_[tensor_index], dealloc_node_[tensor_index],
+                        &allocs_[tensor_index]) != kTfLiteOk) {
+      arena_.ClearPlan();
+      return false;
+    }
+  }
+  if (arena_.GetHighWaterMark() > arena_.GetCommittedSize()) {
+    arena_.ClearPlan();
+    return false;
+  }
+  return true;
+}
+
+void ArenaPlanner::SetNodeLevels(const std::vector<int>& levels) {
+  node_levels_ = levels;
+}
+
+bool ArenaPlanner::IsPlannedForNodeLevels() const {
+  return planned_for_node_levels_;
+}
+
+void ArenaPlanner::UpdateSharedNodeMemory() {
+  char* buffer = nullptr;
+  if (caller_ != nullptr) {
+    buffer = caller_->GetNodeMemory(caller_node_);
+    if (buffer != nullptr) {
+      buffer += caller_offset_;
+    }
+  }
+  arena_.SetExternalBuffer(buffer, caller_size_);
+}
+
 TfLiteStatus ArenaPlanner::Commit(bool* reallocated) {
   bool arena_reallocated, persistent_arena_reallocated;
+  UpdateSharedNodeMemory();
   TF_LITE_ENSURE_STATUS(arena_.Commit(&arena_reallocated));
   has_nonpersistent_memory_ = true;
   TF_LITE_ENSURE_STATUS(
@@ -486,6 +912,17 @@ std::vector<int32_t> ArenaPlanner::GetTensorsToAllocate(int first_node,
 
 TfLiteStatus ArenaPlanner::CalculateAllocations(
     int first_node, int last_node, std::vector<int32_t>* tensors_allocated) {
+  if (!view_nodes_.empty()) {
+    // Views are only placed when all the tensors are allocated at once, so
+    // that a view and its base are never allocated apart.
+    if (first_node != 0 ||
+        last_node + 1 < static_cast<int>(graph_info_->num_execution_nodes()) ||
+        HasDynamicTensors(*graph_info_)) {
+      DropTensorViews();
+    } else {
+      UpdateTensorViews();
+    }
+  }
   // Indices of tensors in order their allocation offsets will be calculated.
   const std::vector<int32_t> tensors_to_allocate =
       GetTensorsToAllocate(first_node, last_node);
@@ -505,11 +942,21 @@ TfLiteStatus ArenaPlanner::CalculateAllocations(
     }
   }
 
-  if (tensors_allocated->empty()) {
+  // Nodes whose reserved memory is yet to be allocated.
+  std::vector<int32_t> nodes_reserved;
+  for (int i = first_node;
+       i <= last_node && i < static_cast<int>(node_memory_sizes_.size()); ++i) {
+    if (node_memory_allocs_[i].size < node_memory_sizes_[i]) {
+      nodes_reserved.push_back(i);
+    }
+  }
+
+  if (tensors_allocated->empty() && nodes_reserved.empty()) {
     last_active_node_ = last_node;
     return kTfLiteOk;
   }
-  if (first_node < last_active_node_) {
+  const bool arena_reset = first_node < last_active_node_;
+  if (arena_reset) {
     arena_.ResetAllocs();
     last_active_node_ = first_node;
   } else {
@@ -518,9 +965,16 @@ TfLiteStatus ArenaPlanner::CalculateAllocations(
     arena_.PurgeActiveAllocs(first_node);
   }
   CreateTensorAllocationVector(tensors_allocated);
+  // ArenaRw tensors to allocate, in the order of `tensors_allocated`.
+  std::vector<int32_t> arena_tensors;
+  arena_tensors.reserve(tensors_allocated->size());
   // Vector of ids of already allocated tensors, ordered by offset.
   for (const auto& tensor_index : *tensors_allocated) {
     TfLiteTensor& tensor = tensors[tensor_index];
+    // Views are placed in the memory of their base.
+    if (tensor_views_.count(tensor_index) > 0) {
+      continue;
+    }
     // Only allocate ArenaRw tensors which own their buffer.
     auto it = actual_tensor_id_.find(tensor_index);
     if (it != actual_tensor_id_.end()) {
@@ -541,10 +995,7 @@ TfLiteStatus ArenaPlanner::CalculateAllocations(
       }
     }
     if (tensor.allocation_type == kTfLiteArenaRw) {
-      TF_LITE_ENSURE_STATUS(
-          arena_.Allocate(context_, tensor_alignment_, tensor.bytes,
-                          tensor_index, alloc_node_[tensor_index],
-                          dealloc_node_[tensor_index], &allocs_[tensor_index]));
+      arena_tensors.push_back(tensor_index);
     }
     // Check allocs_[].size to prevent from reallocation of persistent tensors.
     // Only allocate ArenaRwPersistent tensors which own their buffer.
@@ -559,6 +1010,27 @@ TfLiteStatus ArenaPlanner::CalculateAllocations(
       }
     }
   }
+  if (!arena_reset || !nodes_reserved.empty() ||
+      (!AllocateFromArenaPlan(first_node, last_node, arena_tensors) &&
+       !AllocateIncrementally(first_node, arena_tensors))) {
+    for (const int32_t tensor_index : arena_tensors) {
+      TF_LITE_ENSURE_STATUS(arena_.Allocate(
+          context_, tensor_alignment_, tensors[tensor_index].bytes,
+          tensor_index, alloc_node_[tensor_index], dealloc_node_[tensor_index],
+          &allocs_[tensor_index]));
+    }
+  }
+  // Node memory only lives for its node, so it goes in the gaps the tensors
+  // leave at that node.
+  for (const int32_t node : nodes_reserved) {
+    const bool has_level = node < static_cast<int>(level_first_node_.size());
+    TF_LITE_ENSURE_STATUS(arena_.Allocate(
+        context_, kDefaultArenaAlignment, node_memory_sizes_[node],
+        kNodeMemoryTensor,
+        /*first_node=*/has_level ? level_first_node_[node] : node,
+        /*last_node=*/has_level ? level_last_node_[node] : node,
+        &node_memory_allocs_[node]));
+  }
   last_active_node_ = last_node;
   return kTfLiteOk;
 }
@@ -579,6 +1051,15 @@ bool AreTensorsAllocatedInSameArena(int32_t root_tensor_index,
 
 TfLiteStatus ArenaPlanner::ResolveTensorAllocation(int32_t tensor_index,
                                                    TfLiteTensor* tensors) {
+  auto view_it = tensor_views_.find(tensor_index);
+  if (view_it != tensor_views_.end()) {
+    const TensorView& view = view_it->second;
+    TF_LITE_ENSURE_STATUS(ResolveTensorAllocation(view.base, tensors));
+    char* base_data = tensors[view.base].data.raw;
+    tensors[tensor_index].data.raw =
+        base_data == nullptr ? nullptr : base_data + view.offset;
+    return kTfLiteOk;
+  }
   // Resolve allocation for tensors which share buffers.
   auto actual_tensor_it = actual_tensor_id_.find(tensor_index);
   TfLiteTensor& tensor = tensors[tensor_index];
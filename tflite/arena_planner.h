@@ -22,10 +22,12 @@ limitations under the License.
 #include <unordered_set>
 #include <vector>
 
+#include "tflite/arena_plan.h"
 #include "tflite/core/c/common.h"
 #include "tflite/graph_info.h"
 #include "tflite/memory_planner.h"
 #include "tflite/simple_memory_arena.h"
+#include "tflite/tensor_views.h"
 #include "tflite/util.h"
 
 namespace tflite {
@@ -39,7 +41,9 @@ constexpr const int kDefaultArenaAlignment = 64;
 // necessary memory (the PlanAllocations phase). It then assigns portions of
 // this memory buffer to each tensor (the ExecuteAllocations phase). Tensors may
 // share some of the buffer if a tensor B is to be allocated after another
-// tensor A has been deallocated.
+// tensor A has been deallocated. The tensors that ops only copy between, e.g.
+// the outputs of a split along the outermost axis, are placed in the memory of
+// the tensor they are a part of, when the whole graph is allocated at once.
 //
 // If dynamic tensors are used the planning steps can be repeated during model
 // execution. Since dynamic tensors don't have sizes until after the
@@ -68,10 +72,25 @@ class ArenaPlanner : public MemoryPlanner {
   void DumpDebugInfo(const std::vector<int>& execution_plan) const override;
   void GetAllocInfo(size_t* arena_size,
                     size_t* arena_persist_size) const override;
+  size_t GetNonPersistentMemorySize() const override;
+  bool ReserveNodeMemory(int node, size_t size) override;
+  char* GetNodeMemory(int node) override;
+  void ShareNodeMemory(MemoryPlanner* caller, int node, size_t offset,
+                       size_t size) override;
+  size_t GetNodeMemorySavings() const override;
+  bool GetArenaPlan(SubgraphArenaPlan* plan) const override;
+  void SetArenaPlan(const SubgraphArenaPlan* plan) override;
+  void SetIncrementalPlanning(bool incremental_planning) override;
+  void SetNodeLevels(const std::vector<int>& levels) override;
+  bool IsPlannedForNodeLevels() const override;
 
   // Returns the base arena location for a given allocation type.
   std::intptr_t BasePointer(TfLiteAllocationType type);
 
+  // Sets how the memory of both arenas is backed, from the next time they
+  // grow.
+  void SetBufferOptions(const ArenaBufferOptions& options);
+
  private:
   // Check whether the input tensor's memory may be shared the output tensor.
   // tensor_changed: true if the output tensor modifies the tensor data. For
@@ -83,6 +102,21 @@ class ArenaPlanner : public MemoryPlanner {
   // Identify tensors which can share memory with another.
   void IdentifyInPlaceTensors();
 
+  // Identify the tensors which can be views of a part of another tensor, so
+  // that the ops copying between them are no-ops. See GetTensorViews().
+  void IdentifyTensorViews();
+
+  // Whether `view` can be placed in its base, with their current allocation
+  // types and sizes.
+  bool CanPlaceTensorView(const TensorView& view);
+
+  // Updates the offsets of the views with the current shapes of their
+  // tensors, and drops the views of the nodes that no longer have them.
+  void UpdateTensorViews();
+
+  // Drops all the views, so that tensors get their own memory.
+  void DropTensorViews();
+
   // Make sure all the arenas have reserved enough memory to store all their
   // tensors.
   TfLiteStatus Commit(bool* arena_reallocated);
@@ -104,6 +138,24 @@ class ArenaPlanner : public MemoryPlanner {
   TfLiteStatus CalculateAllocations(int first_node, int last_node,
                                     std::vector<int32_t>* tensors_allocated);
 
+  // Places the ArenaRw tensors `tensors_to_allocate` at the offsets of
+  // `arena_plan_`, if the arena was reset and the plan matches them exactly.
+  // Returns false, leaving the arena empty, otherwise.
+  bool AllocateFromArenaPlan(int first_node, int last_node,
+                             const std::vector<int32_t>& tensors_to_allocate);
+
+  // Places the ArenaRw tensors `tensors_to_allocate` at their offsets of the
+  // allocations before the last reset, if they still fit, and the others in
+  // the gaps. Returns false, leaving the arena empty, if incremental planning
+  // is off, the arena wasn't allocated from the first node or it would have to
+  // grow, in which case planning from scratch packs the tensors better.
+  bool AllocateIncrementally(int first_node,
+                             const std::vector<int32_t>& tensors_to_allocate);
+
+  // Widens the allocation intervals of the tensors to the levels of their
+  // first and last nodes, if the nodes have levels.
+  void WidenToNodeLevels();
+
   // Assign absolute memory location to a tensor, based on its relative
   // position inside the corresponding arena buffer.
   TfLiteStatus ResolveTensorAllocation(int32_t tensor_index,
@@ -117,9 +169,14 @@ class ArenaPlanner : public MemoryPlanner {
   // 'node_index'.
   TfLiteStatus CalculateDeallocationOfInternalTensors(int node_index);
 
-  // Return the index of the tensor owing `tensor_index's` buffer.
+  // Return the index of the tensor owing `tensor_index's` buffer, or the base
+  // of `tensor_index` if it is a view.
   int FindSharedTensor(int tensor_index);
 
+  // Points `arena_` at the node memory of the caller before it is committed,
+  // if it is shared.
+  void UpdateSharedNodeMemory();
+
   TfLiteContext* context_;
   std::unique_ptr<GraphInfo> graph_info_;
 
@@ -166,6 +223,42 @@ class ArenaPlanner : public MemoryPlanner {
 
   // Store number of references to each tensor.
   std::vector<int> refcounts_;
+
+  // Tensors placed in the memory of their base, by tensor index, and the nodes
+  // they are the views of, by execution plan index. A view is never the base
+  // of another view, nor shares its memory as in `actual_tensor_id_`.
+  // NOLINTNEXTLINE - absl::flat_hash_map increases binary size by 106kB.
+  std::unordered_map<int32_t, TensorView> tensor_views_;
+  std::vector<int> view_nodes_;
+
+  // Size and allocation of the memory reserved for each node, by execution
+  // plan index. It lives in `arena_` for the duration of the node only.
+  std::vector<size_t> node_memory_sizes_;
+  std::vector<ArenaAllocWithUsageInterval> node_memory_allocs_;
+
+  // When not null, `arena_` uses `caller_size_` bytes at `caller_offset_` of
+  // the memory `caller_` reserved for `caller_node_`.
+  MemoryPlanner* caller_;
+  int caller_node_;
+  size_t caller_offset_;
+  size_t caller_size_;
+
+  // Placement of the ArenaRw tensors computed offline, if any.
+  const SubgraphArenaPlan* arena_plan_;
+
+  // If true, `previous_allocs_` holds the allocs before the last
+  // ResetAllocations(), to start the next plan from.
+  bool incremental_planning_;
+  std::vector<ArenaAllocWithUsageInterval> previous_allocs_;
+
+  // Levels of the nodes, by execution plan index, and the execution plan
+  // indices of the first and last nodes of the level of each node, if the
+  // nodes have levels.
+  std::vector<int> node_levels_;
+  std::vector<int32_t> level_first_node_;
+  std::vector<int32_t> level_last_node_;
+  // True if the tensors of all the nodes were allocated for their levels.
+  bool planned_for_node_levels_;
 };
 
 }  // namespace tflite
@@ -12,12 +12,15 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
+#include <cstddef>
 #include <vector>
 
 #include <gtest/gtest.h>
 #include "tflite/c/c_api_types.h"
 #include "tflite/c/common.h"
+#include "tflite/core/subgraph.h"
 #include "tflite/interpreter.h"
+#include "tflite/interpreter_options.h"
 #include "tflite/kernels/subgraph_test_util.h"
 
 namespace tflite {
@@ -156,5 +159,60 @@ TEST(ArenaPlannerSubgraphTest, HWTensor) {
   EXPECT_NE(reshape_output->data.data, nullptr);
 }
 
+// Runs a model calling a while loop after its intermediate tensor is freed,
+// and returns the memory of its primary subgraph.
+Subgraph::SubgraphAllocInfo RunWhileAfterIntermediate(
+    bool share_subgraph_arenas) {
+  constexpr int kSize = 1024;
+  Interpreter interpreter;
+  subgraph_test_util::SubgraphBuilder builder;
+  interpreter.AddSubgraphs(2);
+  builder.BuildLessEqualCondSubgraph(interpreter.subgraph(1), 3);
+  builder.BuildAccumulateLoopBodySubgraph(interpreter.subgraph(2));
+  builder.BuildWhileAfterIntermediateSubgraph(&interpreter.primary_subgraph());
+  InterpreterOptions options;
+  options.SetShareSubgraphArenas(share_subgraph_arenas);
+  EXPECT_EQ(interpreter.ApplyOptions(&options), kTfLiteOk);
+
+  EXPECT_EQ(interpreter.ResizeInputTensor(interpreter.inputs()[0], {kSize}),
+            kTfLiteOk);
+  EXPECT_EQ(interpreter.ResizeInputTensor(interpreter.inputs()[1], {1}),
+            kTfLiteOk);
+  EXPECT_EQ(interpreter.ResizeInputTensor(interpreter.inputs()[2], {1}),
+            kTfLiteOk);
+  EXPECT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+  for (int i = 0; i < 2; ++i) {
+    subgraph_test_util::FillIntTensor(
+        interpreter.tensor(interpreter.inputs()[0]),
+        std::vector<int>(kSize, i + 1));
+    subgraph_test_util::FillIntTensor(
+        interpreter.tensor(interpreter.inputs()[1]), {1});
+    subgraph_test_util::FillIntTensor(
+        interpreter.tensor(interpreter.inputs()[2]), {1});
+    EXPECT_EQ(interpreter.Invoke(), kTfLiteOk);
+    subgraph_test_util::CheckIntTensor(
+        interpreter.tensor(interpreter.outputs()[0]), {kSize},
+        std::vector<int>(kSize, 3 * (i + 1)));
+    subgraph_test_util::CheckIntTensor(
+        interpreter.tensor(interpreter.outputs()[1]), {1}, {4});
+    subgraph_test_util::CheckIntTensor(
+        interpreter.tensor(interpreter.outputs()[2]), {1}, {10});
+  }
+  Subgraph::SubgraphAllocInfo alloc_info;
+  interpreter.primary_subgraph().GetMemoryAllocInfo(&alloc_info);
+  return alloc_info;
+}
+
+TEST(ArenaPlannerSubgraphTest, ShareSubgraphArenas) {
+  const Subgraph::SubgraphAllocInfo own_arenas =
+      RunWhileAfterIntermediate(/*share_subgraph_arenas=*/false);
+  const Subgraph::SubgraphAllocInfo shared_arenas =
+      RunWhileAfterIntermediate(/*share_subgraph_arenas=*/true);
+  EXPECT_EQ(own_arenas.arena_shared_size, 0);
+  // The arenas of the while loop fit in the space of the intermediate tensor.
+  EXPECT_GT(shared_arenas.arena_shared_size, 0);
+  EXPECT_EQ(shared_arenas.arena_size, own_arenas.arena_size);
+}
+
 }  // namespace
 }  // namespace tflite
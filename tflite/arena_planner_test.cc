@@ -28,8 +28,10 @@ limitations under the License.
 #include <gtest/gtest.h>
 #include "absl/log/check.h"
 #include "absl/log/log.h"
+#include "tflite/arena_plan.h"
 #include "tflite/builtin_ops.h"
 #include "tflite/c/c_api_types.h"
+#include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
 #include "tflite/graph_info.h"
 
@@ -133,6 +135,9 @@ class TestGraph {
       TfLiteIntArrayFree(node.outputs);
       TfLiteIntArrayFree(node.temporaries);
     }
+    for (auto& tensor : tensors_) {
+      TfLiteIntArrayFree(tensor.dims);
+    }
   }
 
   const std::vector<TfLiteNode>& nodes() { return nodes_; }
@@ -148,6 +153,24 @@ class TestGraph {
     variables_ = variables;
   }
 
+  // Sets the shape of a float32 tensor.
+  void SetShape(int tensor_index, std::initializer_list<int> dims) {
+    TfLiteTensor& tensor = tensors_[tensor_index];
+    TfLiteIntArrayFree(tensor.dims);
+    tensor.type = kTfLiteFloat32;
+    tensor.dims = TfLiteIntArrayCreate(dims.size());
+    tensor.bytes = sizeof(float);
+    int d = 0;
+    for (int dim : dims) {
+      tensor.dims->data[d++] = dim;
+      tensor.bytes *= dim;
+    }
+  }
+
+  void SetBuiltinData(int node_index, void* builtin_data) {
+    nodes_[node_index].builtin_data = builtin_data;
+  }
+
   void Swap(TestGraph* other) {
     std::swap(nodes_, other->nodes_);
     std::swap(tensors_, other->tensors_);
@@ -1101,6 +1124,337 @@ TEST_F(ArenaPlannerTest, DebugTensorsInputReuse) {
   EXPECT_NE(GetOffset(4), GetOffset(5));
 }
 
+TEST_F(ArenaPlannerTest, NodeMemory) {
+  TestGraph graph({0},
+                  {
+                      /* in, out, tmp */
+                      {{0}, {1}, {}},
+                      {{1}, {2}, {}},
+                      {{2}, {3}, {}},
+                  },
+                  {3});
+  (*graph.tensors())[1].bytes = 256;
+  SetGraph(&graph);
+  EXPECT_TRUE(planner_->ReserveNodeMemory(2, 64));
+  EXPECT_FALSE(planner_->ReserveNodeMemory(-1, 64));
+  EXPECT_EQ(planner_->GetNodeMemory(2), nullptr);
+  Execute(0, graph.nodes().size() - 1);
+
+  EXPECT_EQ(planner_->GetNodeMemory(0), nullptr);
+  char* node_memory = planner_->GetNodeMemory(2);
+  ASSERT_NE(node_memory, nullptr);
+  const std::ptrdiff_t offset =
+      reinterpret_cast<std::intptr_t>(node_memory) -
+      planner_->BasePointer(kTfLiteArenaRw);
+  // The node memory goes in the space of tensor 1, which is no longer used by
+  // node 2, so it doesn't grow the arena.
+  EXPECT_GE(offset, GetOffset(1));
+  EXPECT_LE(offset + 64, GetOffsetAfter(1));
+  for (int tensor : {0, 2, 3}) {
+    EXPECT_TRUE(offset >= GetOffsetAfter(tensor) ||
+                offset + 64 <= GetOffset(tensor));
+  }
+  EXPECT_EQ(planner_->GetNodeMemorySavings(), 64);
+
+  ReleaseNonPersistentMemory();
+  EXPECT_EQ(planner_->GetNodeMemory(2), nullptr);
+}
+
+TEST_F(ArenaPlannerTest, ArenaPlan) {
+  TestGraph graph({0, 1},
+                  {
+                      /* in, out, tmp */
+                      {{0, 1}, {2}, {}},
+                      {{2, 0}, {4, 5}, {}},
+                      {{4, 5}, {3}, {}},
+                  },
+                  {3});
+  SetGraph(&graph);
+  Execute(0, graph.nodes().size() - 1);
+  SubgraphArenaPlan plan;
+  ASSERT_TRUE(planner_->GetArenaPlan(&plan));
+  ASSERT_EQ(plan.allocs.size(), 6);
+  for (const auto& alloc : plan.allocs) {
+    EXPECT_EQ(alloc.offset, GetOffset(alloc.tensor));
+    EXPECT_EQ(alloc.size, (*graph.tensors())[alloc.tensor].bytes);
+  }
+
+  // Place the tensors one after the other instead.
+  size_t offset = 0;
+  for (auto& alloc : plan.allocs) {
+    alloc.offset = offset;
+    offset += (alloc.size + kTensorAlignment - 1) / kTensorAlignment *
+              kTensorAlignment;
+  }
+  plan.arena_size = GetArenaPlanSize(plan);
+  SetGraph(&graph);
+  planner_->SetArenaPlan(&plan);
+  Execute(0, graph.nodes().size() - 1);
+  for (const auto& alloc : plan.allocs) {
+    EXPECT_EQ(GetOffset(alloc.tensor), alloc.offset);
+  }
+
+  // A plan that doesn't match the tensors is ignored.
+  (*graph.tensors())[4].bytes = 128;
+  ResetAllocations();
+  Execute(0, graph.nodes().size() - 1);
+  std::vector<std::ptrdiff_t> offsets;
+  for (int i = 0; i <= 5; ++i) {
+    offsets.push_back(GetOffset(i));
+  }
+  SetGraph(&graph);
+  Execute(0, graph.nodes().size() - 1);
+  for (int i = 0; i <= 5; ++i) {
+    EXPECT_EQ(GetOffset(i), offsets[i]);
+  }
+}
+
+TEST_F(ArenaPlannerTest, IncrementalPlanning) {
+  TestGraph graph({0, 1},
+                  {
+                      /* in, out, tmp */
+                      {{0, 1}, {2}, {}},
+                      {{2, 0}, {4, 5}, {}},
+                      {{4, 5}, {3}, {}},
+                  },
+                  {3});
+  SetGraph(&graph);
+  planner_->SetIncrementalPlanning(true);
+  Execute(0, graph.nodes().size() - 1);
+  auto get_offsets = [&]() {
+    std::vector<std::ptrdiff_t> offsets;
+    for (int i = 0; i <= 5; ++i) {
+      offsets.push_back(GetOffset(i));
+    }
+    return offsets;
+  };
+  auto get_arena_size = [&]() {
+    size_t arena_size = 0;
+    size_t arena_persist_size = 0;
+    planner_->GetAllocInfo(&arena_size, &arena_persist_size);
+    return arena_size;
+  };
+  const std::vector<std::ptrdiff_t> offsets = get_offsets();
+  const size_t arena_size = get_arena_size();
+
+  // Tensors that shrink or grow back stay in place.
+  for (const size_t bytes : {1, 15}) {
+    (*graph.tensors())[4].bytes = bytes;
+    ResetAllocations();
+    Execute(0, graph.nodes().size() - 1);
+    EXPECT_EQ(get_offsets(), offsets);
+    EXPECT_EQ(get_arena_size(), arena_size);
+  }
+
+  // Growing the arena plans it from scratch, like a new planner does.
+  (*graph.tensors())[4].bytes = 1000;
+  ResetAllocations();
+  Execute(0, graph.nodes().size() - 1);
+  const std::vector<std::ptrdiff_t> grown_offsets = get_offsets();
+  const size_t grown_arena_size = get_arena_size();
+  EXPECT_GT(grown_arena_size, arena_size);
+  SetGraph(&graph);
+  Execute(0, graph.nodes().size() - 1);
+  EXPECT_EQ(get_offsets(), grown_offsets);
+  // Without incremental planning, the arena is planned to the exact size.
+  EXPECT_LE(get_arena_size(), grown_arena_size);
+
+  // Going back to the smaller size keeps the arena and the plan.
+  planner_->SetIncrementalPlanning(true);
+  Execute(0, graph.nodes().size() - 1);
+  (*graph.tensors())[4].bytes = 15;
+  ResetAllocations();
+  Execute(0, graph.nodes().size() - 1);
+  EXPECT_EQ(get_offsets(), grown_offsets);
+  EXPECT_LE(get_arena_size(), grown_arena_size);
+}
+
+TEST_F(ArenaPlannerTest, NodeLevels) {
+  TestGraph graph({0},
+                  {
+                      /* in, out, tmp */
+                      {{0}, {2}, {}},
+                      {{2}, {3}, {}},
+                      {{0}, {4}, {6}},
+                      {{3, 4}, {5}, {}},
+                  },
+                  {5});
+  auto overlap = [&](int a, int b) {
+    const auto& tensors = *graph.tensors();
+    return GetOffset(a) < GetOffset(b) + tensors[b].bytes &&
+           GetOffset(b) < GetOffset(a) + tensors[a].bytes;
+  };
+  SetGraph(&graph);
+  Execute(0, graph.nodes().size() - 1);
+  // Node 2 reuses the memory of tensor 2, which node 1 reads.
+  EXPECT_TRUE(overlap(2, 4) || overlap(2, 6));
+  EXPECT_FALSE(planner_->IsPlannedForNodeLevels());
+
+  // Nodes 1 and 2 run at the same time.
+  planner_->SetNodeLevels({0, 1, 1, 2});
+  CHECK(planner_->PlanAllocations() == kTfLiteOk);
+  Execute(0, 1);
+  EXPECT_FALSE(planner_->IsPlannedForNodeLevels());
+  Execute(2, graph.nodes().size() - 1);
+  EXPECT_FALSE(planner_->IsPlannedForNodeLevels());
+  ResetAllocations();
+  Execute(0, graph.nodes().size() - 1);
+  EXPECT_TRUE(planner_->IsPlannedForNodeLevels());
+  for (const int tensor : {2, 3}) {
+    EXPECT_FALSE(overlap(tensor, 4));
+    EXPECT_FALSE(overlap(tensor, 6));
+  }
+
+  ResetAllocationsAfter(1);
+  EXPECT_FALSE(planner_->IsPlannedForNodeLevels());
+}
+
+// Checks that the arena ranges of two tensors don't overlap.
+#define EXPECT_DISJOINT(a, b)                                  \
+  EXPECT_TRUE(GetOffsetAfter(a) <= GetOffset(b) ||             \
+              GetOffsetAfter(b) <= GetOffset(a))               \
+      << "Tensors " << a << " and " << b << " overlap."
+
+TEST_F(ArenaPlannerTest, SplitOutputsAreViewsOfInput) {
+  TestGraph graph(
+      {0},
+      {
+          /* in, out, tmp */
+          {{0}, {1}, {}, kTfLiteBuiltinAdd, kTfLiteInplaceOpNone},
+          {{2, 1}, {3, 4}, {}, kTfLiteBuiltinSplit, kTfLiteInplaceOpNone},
+          {{3}, {5}, {}, kTfLiteBuiltinAdd, kTfLiteInplaceOpNone},
+          {{4}, {6}, {}, kTfLiteBuiltinAdd, kTfLiteInplaceOpNone},
+      },
+      {5, 6});
+  graph.SetShape(0, {1, 4, 2});
+  graph.SetShape(1, {1, 4, 2});
+  graph.SetShape(2, {1});
+  (*graph.tensors())[2].allocation_type = kTfLiteMmapRo;
+  for (int i = 3; i <= 6; ++i) {
+    graph.SetShape(i, {1, 2, 2});
+  }
+  SetGraph(&graph);
+  Execute(0, graph.nodes().size() - 1);
+
+  EXPECT_EQ(GetOffset(3), GetOffset(1));
+  EXPECT_EQ(GetOffset(4), GetOffset(1) + 16);
+  // The input lives as long as its views.
+  EXPECT_DISJOINT(1, 5);
+  EXPECT_DISJOINT(0, 1);
+}
+
+TEST_F(ArenaPlannerTest, ConcatenationInputsAreViewsOfOutput) {
+  TestGraph graph(
+      {0},
+      {
+          /* in, out, tmp */
+          {{0}, {1}, {}, kTfLiteBuiltinAdd, kTfLiteInplaceOpNone},
+          {{0}, {2}, {}, kTfLiteBuiltinAdd, kTfLiteInplaceOpNone},
+          {{1, 2}, {3}, {}, kTfLiteBuiltinConcatenation, kTfLiteInplaceOpNone},
+          {{3}, {4}, {}, kTfLiteBuiltinAdd, kTfLiteInplaceOpNone},
+      },
+      {4});
+  TfLiteConcatenationParams params = {/*axis=*/0, kTfLiteActNone};
+  graph.SetBuiltinData(2, &params);
+  graph.SetShape(0, {1, 2, 2});
+  graph.SetShape(1, {1, 2, 2});
+  graph.SetShape(2, {1, 2, 2});
+  graph.SetShape(3, {2, 2, 2});
+  graph.SetShape(4, {2, 2, 2});
+  SetGraph(&graph);
+  Execute(0, graph.nodes().size() - 1);
+
+  EXPECT_EQ(GetOffset(1), GetOffset(3));
+  EXPECT_EQ(GetOffset(2), GetOffset(3) + 16);
+  // The output is allocated when its first input is.
+  EXPECT_DISJOINT(0, 3);
+  EXPECT_DISJOINT(3, 4);
+}
+
+TEST_F(ArenaPlannerTest, SplitAlongInnerAxisIsNotAView) {
+  TestGraph graph(
+      {0},
+      {
+          /* in, out, tmp */
+          {{0}, {1}, {}, kTfLiteBuiltinAdd, kTfLiteInplaceOpNone},
+          {{2, 1}, {3, 4}, {}, kTfLiteBuiltinSplit, kTfLiteInplaceOpNone},
+          {{3, 4}, {5}, {}, kTfLiteBuiltinAdd, kTfLiteInplaceOpNone},
+      },
+      {5});
+  graph.SetShape(0, {2, 4});
+  graph.SetShape(1, {2, 4});
+  graph.SetShape(2, {1});
+  (*graph.tensors())[2].allocation_type = kTfLiteMmapRo;
+  for (int i = 3; i <= 5; ++i) {
+    graph.SetShape(i, {2, 2});
+  }
+  SetGraph(&graph);
+  Execute(0, graph.nodes().size() - 1);
+
+  EXPECT_DISJOINT(1, 3);
+  EXPECT_DISJOINT(1, 4);
+  EXPECT_DISJOINT(3, 4);
+}
+
+TEST_F(ArenaPlannerTest, NoViewsWhenAllocatingStepwise) {
+  TestGraph graph(
+      {0},
+      {
+          /* in, out, tmp */
+          {{0}, {1}, {}, kTfLiteBuiltinAdd, kTfLiteInplaceOpNone},
+          {{2, 1}, {3, 4}, {}, kTfLiteBuiltinSplit, kTfLiteInplaceOpNone},
+          {{3, 4}, {5}, {}, kTfLiteBuiltinAdd, kTfLiteInplaceOpNone},
+      },
+      {5});
+  graph.SetShape(0, {4, 2});
+  graph.SetShape(1, {4, 2});
+  graph.SetShape(2, {1});
+  (*graph.tensors())[2].allocation_type = kTfLiteMmapRo;
+  for (int i = 3; i <= 5; ++i) {
+    graph.SetShape(i, {2, 2});
+  }
+  SetGraph(&graph);
+  Execute(0, 0);
+  Execute(1, graph.nodes().size() - 1);
+
+  EXPECT_DISJOINT(1, 3);
+  EXPECT_DISJOINT(1, 4);
+}
+
+TEST_F(ArenaPlannerTest, DroppedViewsAreDeallocatedAfterTheirLastUse) {
+  TestGraph graph(
+      {0},
+      {
+          /* in, out, tmp */
+          {{0}, {1}, {}, kTfLiteBuiltinAdd, kTfLiteInplaceOpNone},
+          {{2, 1}, {3, 4}, {}, kTfLiteBuiltinSplit, kTfLiteInplaceOpNone},
+          {{3, 4}, {5}, {}, kTfLiteBuiltinAdd, kTfLiteInplaceOpNone},
+          {{5, 1}, {6}, {}, kTfLiteBuiltinAdd, kTfLiteInplaceOpNone},
+      },
+      {6});
+  graph.SetShape(0, {4, 2});
+  graph.SetShape(1, {4, 2});
+  graph.SetShape(2, {1});
+  (*graph.tensors())[2].allocation_type = kTfLiteMmapRo;
+  for (int i = 3; i <= 6; ++i) {
+    graph.SetShape(i, {2, 2});
+  }
+  SetGraph(&graph);
+  Execute(0, 0);
+  Execute(1, graph.nodes().size() - 1);
+
+  EXPECT_DISJOINT(1, 3);
+  EXPECT_DISJOINT(1, 4);
+  // The split outputs are no longer used once 6 is allocated, while the
+  // split input still is, so 6 takes the memory of a split output.
+  auto overlaps = [this](int a, int b) {
+    return GetOffsetAfter(a) > GetOffset(b) && GetOffsetAfter(b) > GetOffset(a);
+  };
+  EXPECT_TRUE(overlaps(6, 3) || overlaps(6, 4));
+}
+
+#undef EXPECT_DISJOINT
+
 TEST_F(ArenaPlannerTest, SimpleProfilerTest) {
   gNumAlloc = 0;
   gNumDealloc = 0;
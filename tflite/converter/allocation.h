@@ -112,6 +112,10 @@ class MMAPAllocation : public Allocation {
     return offset_of_buffer_in_file_;
   }
 
+  // Whether the mapping is private and writeable, rather than shared and
+  // read-only.
+  bool map_private() const { return map_private_; }
+
   static bool IsSupported();
 
  protected:
@@ -122,6 +126,7 @@ class MMAPAllocation : public Allocation {
   // Used when the address to mmap is not page-aligned.
   size_t offset_in_buffer_ = 0;
   size_t offset_of_buffer_in_file_ = 0;
+  bool map_private_ = false;
 
  private:
   // Assumes ownership of the provided `owned_fd` instance.
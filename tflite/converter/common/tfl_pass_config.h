@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_COMPILER_MLIR_LITE_COMMON_TFL_PASS_CONFIG_H_
 #define TENSORFLOW_COMPILER_MLIR_LITE_COMMON_TFL_PASS_CONFIG_H_
 
+#include <cstdint>
 #include <string>
 #include <utility>
 
@@ -58,6 +59,20 @@ struct PassConfig {
   // Whether to enable TFLite variables or not, this will allow
   // mutable variables and produce ReadVariable/AssignVariable ops in TFLite.
   bool enable_tflite_variables = false;
+  // Whether to convert the inputs and outputs that carry state between calls
+  // of the signatures, such as KV caches, into TFLite variables. Requires
+  // `enable_tflite_variables`.
+  bool lift_state_to_variables = false;
+  // Whether to reorder the operations to reduce the peak memory of the
+  // activations.
+  bool minimize_peak_memory = false;
+  // Bytes of memory that keeping Flex delegated operations together is worth
+  // when `minimize_peak_memory` is set.
+  int64_t peak_memory_locality_penalty = 0;
+  // Size in bytes below which folding TFL ops always creates constants. Larger
+  // constants are only created if folding at most doubles the constants it
+  // replaces. The default of the folders applies if negative.
+  int64_t constant_folding_budget_bytes = -1;
   // Whether to unfold large splat constant tensors and replace them with
   // fill operation.
   bool unfold_large_splat_constant = false;
@@ -128,6 +143,13 @@ inline llvm::raw_ostream& operator<<(llvm::raw_ostream& os,
             << "\nruntime_verification: " << pass_config.runtime_verification
             << "\nenable_tflite_variables: "
             << pass_config.enable_tflite_variables
+            << "\nlift_state_to_variables: "
+            << pass_config.lift_state_to_variables
+            << "\nminimize_peak_memory: " << pass_config.minimize_peak_memory
+            << "\npeak_memory_locality_penalty: "
+            << pass_config.peak_memory_locality_penalty
+            << "\nconstant_folding_budget_bytes: "
+            << pass_config.constant_folding_budget_bytes
             << "\nunfold_large_splat_constant: "
             << pass_config.unfold_large_splat_constant
             << "\nguarantee_all_funcs_one_use: "
@@ -228,10 +228,16 @@ DenseElementsAttr GetSqueezedPermutation(Value input_value,
       llvm::ArrayRef(squeezed_permutation));
 }
 
+// Module attribute holding the number of bytes below which folded constants
+// are always accepted. Set by the ConstantFoldingBudget pass.
+constexpr char kConstantFoldingBudget[] = "tfl.constant_folding_budget";
+
 // Utility function to determine if an operation should be folded.
 // This is a heuristic to avoid folding operations that result in larger
-// constants.
-// TODO(b/394905516): Remove this once we have a way to configure the threshold.
+// constants. Constant operands that other operations also use stay in the
+// model after folding, so they do not count towards the size that folding
+// replaces. This keeps, for example, broadcasts of shared weights as runtime
+// operations.
 bool ShouldFoldOperation(Operation* inst) {
   auto get_size = [&](TypeRange types) {
     int64_t size = 0;
@@ -250,13 +256,29 @@ bool ShouldFoldOperation(Operation* inst) {
   int64_t results_size = get_size(inst->getResultTypes());
   int64_t operands_size = get_size(inst->getOperandTypes());
 
+  SmallVector<Type, 4> replaced_types;
+  for (Value operand : inst->getOperands()) {
+    if (!matchPattern(operand, m_Constant()) ||
+        llvm::all_of(operand.getUsers(),
+                     [&](Operation* user) { return user == inst; })) {
+      replaced_types.push_back(operand.getType());
+    }
+  }
+  int64_t replaced_size = get_size(replaced_types);
+
   constexpr int kSizeFactor = 2;
-  constexpr int64_t kResultsSizeThreshold = (1 << 19);                // 64 KiB
   constexpr int64_t kOperandsSizeThreshold = 200L * 1024 * 1024 * 8;  // 200 MiB
+  int64_t results_size_threshold = (1 << 19);  // 64 KiB
+  if (auto module = inst->getParentOfType<ModuleOp>()) {
+    if (auto budget =
+            module->getAttrOfType<IntegerAttr>(kConstantFoldingBudget)) {
+      results_size_threshold = budget.getInt() * 8;
+    }
+  }
 
   return (operands_size <= kOperandsSizeThreshold) &&
-         ((results_size <= kResultsSizeThreshold) ||
-          (results_size <= kSizeFactor * operands_size));
+         ((results_size <= results_size_threshold) ||
+          (results_size <= kSizeFactor * replaced_size));
 }
 
 // Returns dimension index for the given axis that supports negative
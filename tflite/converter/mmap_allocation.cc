@@ -88,7 +88,8 @@ MMAPAllocation::MMAPAllocation(ErrorReporter* error_reporter, int owned_fd,
     : Allocation(error_reporter, Allocation::Type::kMMap),
       mmap_fd_(owned_fd),
       mmapped_buffer_(MAP_FAILED),
-      buffer_size_bytes_(length) {
+      buffer_size_bytes_(length),
+      map_private_(map_private) {
   if (owned_fd < 0) {
     return;
   }
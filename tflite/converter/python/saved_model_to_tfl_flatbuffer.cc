@@ -217,6 +217,13 @@ absl::Status ConvertSavedModelToTFLiteFlatBuffer(
       converter_flags.canonicalizing_inf_as_min_max_float();
   pass_config.unsafe_fuse_dynamic_shaped_broadcast =
       converter_flags.unsafe_fuse_dynamic_shaped_broadcast();
+  pass_config.lift_state_to_variables =
+      converter_flags.lift_state_to_variables();
+  pass_config.minimize_peak_memory = converter_flags.minimize_peak_memory();
+  pass_config.peak_memory_locality_penalty =
+      converter_flags.peak_memory_locality_penalty();
+  pass_config.constant_folding_budget_bytes =
+      converter_flags.constant_folding_budget_bytes();
 
   if (converter_flags.strict_qdq_mode()) {
     pass_config.quant_specs.qdq_conversion_mode =
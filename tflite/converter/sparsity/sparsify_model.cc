@@ -37,6 +37,7 @@ limitations under the License.
 #include "tflite/converter/schema/schema_generated.h"
 #include "tflite/converter/tools/optimize/reduced_precision_metadata.h"
 #include "tflite/converter/transforms/dense_to_sparse_pass.h"
+#include "tflite/converter/transforms/dense_to_sparse_pass_options.h"
 #include "tflite/converter/transforms/pass_registry_utils.h"
 #include "tensorflow/compiler/mlir/tensorflow/utils/error_util.h"
 #include "tensorflow/core/framework/types.pb.h"
@@ -45,7 +46,8 @@ namespace mlir {
 namespace lite {
 
 absl::Status SparsifyModel(const tflite::ModelT& input_model,
-                           flatbuffers::FlatBufferBuilder* builder) {
+                           flatbuffers::FlatBufferBuilder* builder,
+                           bool supported_blocks_only) {
   MLIRContext context;
   StatusScopedDiagnosticHandler statusHandler(&context,
                                               /*propagate=*/true);
@@ -68,7 +70,9 @@ absl::Status SparsifyModel(const tflite::ModelT& input_model,
   }
 
   PassManager pm((*module)->getName(), OpPassManager::Nesting::Implicit);
-  pm.addPass(TFL::Create<TFL::DenseToSparsePass>());
+  TFL::DenseToSparsePassOptions pass_options;
+  pass_options.supported_blocks_only = supported_blocks_only;
+  pm.addPass(TFL::Create<TFL::DenseToSparsePass>(pass_options));
 
   if (failed(pm.run(module.get()))) {
     LOG(ERROR) << "Failed to sparsify: "
@@ -23,8 +23,11 @@ namespace mlir {
 namespace lite {
 
 // Sparsify the `input_model` and write the result to a flatbuffer `builder`.
+// If `supported_blocks_only`, only the weights that the sparse kernels are
+// expected to run faster than the dense ones are sparsified.
 absl::Status SparsifyModel(const tflite::ModelT& input_model,
-                           flatbuffers::FlatBufferBuilder* builder);
+                           flatbuffers::FlatBufferBuilder* builder,
+                           bool supported_blocks_only = false);
 }  // namespace lite
 }  // namespace mlir
 
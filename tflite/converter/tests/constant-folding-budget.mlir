@@ -0,0 +1,35 @@
+// RUN: litert-opt %s -split-input-file -tfl-constant-folding-budget=budget-bytes=16 -verify-diagnostics | FileCheck %s
+
+// CHECK: module attributes {tfl.constant_folding_budget = 16 : i64}
+// expected-remark@+1 {{constant folding changed the constants from 36 to 32 bytes; kept 0 ops on constants at runtime within a budget of 16 bytes per op}}
+module {
+  // CHECK-LABEL: @fold_broadcast_of_unshared_weight
+  func.func @fold_broadcast_of_unshared_weight() -> tensor<8xf32> {
+    %w = arith.constant dense<1.0> : tensor<8xf32>
+    %c = arith.constant dense<2.0> : tensor<1xf32>
+    %0 = "tfl.mul"(%w, %c) <{fused_activation_function = "NONE"}> : (tensor<8xf32>, tensor<1xf32>) -> tensor<8xf32>
+    func.return %0 : tensor<8xf32>
+  }
+  // CHECK-NEXT: %[[CST:.*]] = arith.constant dense<2.000000e+00> : tensor<8xf32>
+  // CHECK-NEXT: return %[[CST]]
+}
+
+// -----
+
+// CHECK: module attributes {tfl.constant_folding_budget = 16 : i64}
+// expected-remark@+1 {{constant folding changed the constants from 36 to 36 bytes; kept 1 ops on constants at runtime within a budget of 16 bytes per op}}
+module {
+  // CHECK-LABEL: @keep_broadcast_of_shared_weight
+  func.func @keep_broadcast_of_shared_weight(%arg0: tensor<8xf32>) -> (tensor<8xf32>, tensor<8xf32>) {
+    %w = arith.constant dense<1.0> : tensor<8xf32>
+    %c = arith.constant dense<2.0> : tensor<1xf32>
+    %0 = "tfl.mul"(%w, %c) <{fused_activation_function = "NONE"}> : (tensor<8xf32>, tensor<1xf32>) -> tensor<8xf32>
+    %1 = tfl.add %arg0, %w {fused_activation_function = "NONE"} : tensor<8xf32>
+    func.return %0, %1 : tensor<8xf32>, tensor<8xf32>
+  }
+  // CHECK-DAG: %[[W:.*]] = arith.constant dense<1.000000e+00> : tensor<8xf32>
+  // CHECK-DAG: %[[C:.*]] = arith.constant dense<2.000000e+00> : tensor<1xf32>
+  // CHECK: %[[MUL:.*]] = tfl.mul(%[[W]], %[[C]])
+  // CHECK: %[[ADD:.*]] = tfl.add %arg0, %[[W]]
+  // CHECK: return %[[MUL]], %[[ADD]]
+}
@@ -0,0 +1,53 @@
+// RUN: litert-opt %s -tfl-dense-to-sparse -verify-diagnostics | FileCheck %s
+// RUN: litert-opt %s -tfl-dense-to-sparse='supported-blocks-only=true' -verify-diagnostics | FileCheck --check-prefix=SUPPORTED %s
+
+// CHECK-LABEL: @block_sparse_weights
+// SUPPORTED-LABEL: @block_sparse_weights
+func.func @block_sparse_weights(%arg0: tensor<1x32xf32>) -> tensor<1x1xf32> {
+  %cst = "tfl.pseudo_const"() {value = dense<[[1.0, 2.0, 3.0, 4.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0]]> : tensor<1x32xf32>} : () -> tensor<1x32xf32>
+  %none = "tfl.no_value"() {value = unit} : () -> none
+  // expected-remark@+1 {{operand 1 is 88% sparse in 1x4 blocks: sparse kernel estimated 2.00x as fast as dense}}
+  %0 = "tfl.fully_connected"(%arg0, %cst, %none) {fused_activation_function = "NONE", keep_num_dims = false, weights_format = "DEFAULT"} : (tensor<1x32xf32>, tensor<1x32xf32>, none) -> tensor<1x1xf32>
+  func.return %0 : tensor<1x1xf32>
+
+  // CHECK: %[[W:.*]] = "tfl.pseudo_sparse_const"()
+  // CHECK-NOT: tfl.densify
+  // CHECK: "tfl.fully_connected"(%arg0, %[[W]]
+  // SUPPORTED: %[[W:.*]] = "tfl.pseudo_sparse_const"()
+  // SUPPORTED-NOT: tfl.densify
+  // SUPPORTED: "tfl.fully_connected"(%arg0, %[[W]]
+}
+
+// CHECK-LABEL: @block_sparse_weights_with_short_rows
+// SUPPORTED-LABEL: @block_sparse_weights_with_short_rows
+func.func @block_sparse_weights_with_short_rows(%arg0: tensor<1x8xf32>) -> tensor<1x2xf32> {
+  %cst = "tfl.pseudo_const"() {value = dense<[[1.0, 2.0, 3.0, 4.0, 0.0, 0.0, 0.0, 0.0], [5.0, 6.0, 7.0, 8.0, 0.0, 0.0, 0.0, 0.0]]> : tensor<2x8xf32>} : () -> tensor<2x8xf32>
+  %none = "tfl.no_value"() {value = unit} : () -> none
+  // expected-remark@+1 {{operand 1 is 50% sparse in 1x4 blocks: sparse kernel estimated 0.50x as fast as dense}}
+  %0 = "tfl.fully_connected"(%arg0, %cst, %none) {fused_activation_function = "NONE", keep_num_dims = false, weights_format = "DEFAULT"} : (tensor<1x8xf32>, tensor<2x8xf32>, none) -> tensor<1x2xf32>
+  func.return %0 : tensor<1x2xf32>
+
+  // CHECK: %[[W:.*]] = "tfl.pseudo_sparse_const"()
+  // CHECK: "tfl.fully_connected"(%arg0, %[[W]]
+  // SUPPORTED-NOT: tfl.pseudo_sparse_const
+  // SUPPORTED: %[[W:.*]] = "tfl.pseudo_const"()
+  // SUPPORTED: "tfl.fully_connected"(%arg0, %[[W]]
+}
+
+// CHECK-LABEL: @random_sparse_weights
+// SUPPORTED-LABEL: @random_sparse_weights
+func.func @random_sparse_weights(%arg0: tensor<1x8xf32>) -> tensor<1x1xf32> {
+  %cst = "tfl.pseudo_const"() {value = dense<[[1.0, 0.0, 2.0, 0.0, 3.0, 0.0, 4.0, 0.0]]> : tensor<1x8xf32>} : () -> tensor<1x8xf32>
+  %none = "tfl.no_value"() {value = unit} : () -> none
+  // expected-remark@+1 {{operand 1 is 50% sparse, but not in blocks supported by the sparse kernel}}
+  %0 = "tfl.fully_connected"(%arg0, %cst, %none) {fused_activation_function = "NONE", keep_num_dims = false, weights_format = "DEFAULT"} : (tensor<1x8xf32>, tensor<1x8xf32>, none) -> tensor<1x1xf32>
+  func.return %0 : tensor<1x1xf32>
+
+  // CHECK: %[[SPARSE:.*]] = "tfl.pseudo_sparse_const"()
+  // CHECK: %[[W:.*]] = "tfl.densify"(%[[SPARSE]])
+  // CHECK: "tfl.fully_connected"(%arg0, %[[W]]
+  // SUPPORTED-NOT: tfl.pseudo_sparse_const
+  // SUPPORTED-NOT: tfl.densify
+  // SUPPORTED: %[[W:.*]] = "tfl.pseudo_const"()
+  // SUPPORTED: "tfl.fully_connected"(%arg0, %[[W]]
+}
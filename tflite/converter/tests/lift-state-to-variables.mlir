@@ -0,0 +1,78 @@
+// RUN: litert-opt %s -split-input-file -tfl-lift-state-to-variables | FileCheck %s
+
+// Tests that a KV cache passed through two signatures becomes one variable.
+module attributes {tf_saved_model.semantics} {
+  // CHECK-LABEL: func.func @prefill
+  // CHECK-SAME: (%arg0: tensor<1x4xf32> {tf_saved_model.index_path = ["tokens"]})
+  // CHECK-SAME: inputs = "prefill_tokens:0", outputs = ""
+  func.func @prefill(%arg0: tensor<1x4xf32> {tf_saved_model.index_path = ["tokens"]}, %arg1: tensor<2x8xf32> {tf_saved_model.index_path = ["kv_cache"]}) -> (tensor<2x8xf32> {tf_saved_model.index_path = ["kv_cache"]}) attributes {tf.entry_function = {inputs = "prefill_tokens:0,prefill_kv_cache:0", outputs = "PartitionedCall:0"}, tf_saved_model.exported_names = ["prefill"]} {
+    %0 = tfl.add %arg1, %arg1 {fused_activation_function = "NONE"} : tensor<2x8xf32>
+    func.return %0 : tensor<2x8xf32>
+  }
+  // CHECK: "tfl.call_once"() <{session_init_function = "tfl_lifted_state_initializer"}> : () -> ()
+  // CHECK: %[[HANDLE:.*]] = "tfl.var_handle"() <{{.*}}shared_name = "kv_cache"}> : () -> tensor<!tf_type.resource<tensor<2x8xf32>>>
+  // CHECK: %[[READ:.*]] = "tfl.read_variable"(%[[HANDLE]]) : (tensor<!tf_type.resource<tensor<2x8xf32>>>) -> tensor<2x8xf32>
+  // CHECK: %[[ADD:.*]] = tfl.add %[[READ]], %[[READ]]
+  // CHECK: "tfl.assign_variable"(%[[HANDLE]], %[[ADD]])
+  // CHECK: return
+
+  // CHECK-LABEL: func.func @decode
+  // CHECK-SAME: (%arg0: tensor<1x1xf32> {tf_saved_model.index_path = ["tokens"]}) -> (tensor<1x1xf32> {tf_saved_model.index_path = ["logits"]})
+  // CHECK-SAME: inputs = "decode_tokens:0", outputs = "PartitionedCall:0"
+  func.func @decode(%arg0: tensor<1x1xf32> {tf_saved_model.index_path = ["tokens"]}, %arg1: tensor<2x8xf32> {tf_saved_model.index_path = ["kv_cache"]}) -> (tensor<1x1xf32> {tf_saved_model.index_path = ["logits"]}, tensor<2x8xf32> {tf_saved_model.index_path = ["kv_cache"]}) attributes {tf.entry_function = {inputs = "decode_tokens:0,decode_kv_cache:0", outputs = "PartitionedCall:0,PartitionedCall:1"}, tf_saved_model.exported_names = ["decode"]} {
+    %0 = tfl.mul %arg1, %arg1 {fused_activation_function = "NONE"} : tensor<2x8xf32>
+    func.return %arg0, %0 : tensor<1x1xf32>, tensor<2x8xf32>
+  }
+  // CHECK: "tfl.call_once"() <{session_init_function = "tfl_lifted_state_initializer"}> : () -> ()
+  // CHECK: %[[HANDLE:.*]] = "tfl.var_handle"() <{{.*}}shared_name = "kv_cache"}>
+  // CHECK: %[[READ:.*]] = "tfl.read_variable"(%[[HANDLE]])
+  // CHECK: %[[MUL:.*]] = tfl.mul %[[READ]], %[[READ]]
+  // CHECK: "tfl.assign_variable"(%[[HANDLE]], %[[MUL]])
+  // CHECK: return %arg0 : tensor<1x1xf32>
+
+  // CHECK-LABEL: func.func @tfl_lifted_state_initializer()
+  // CHECK-SAME: tf_saved_model.exported_names = ["tfl_lifted_state_initializer"]
+  // CHECK: %[[HANDLE:.*]] = "tfl.var_handle"() <{{.*}}shared_name = "kv_cache"}>
+  // CHECK-DAG: %[[ZERO:.*]] = arith.constant dense<0.000000e+00> : tensor<f32>
+  // CHECK-DAG: %[[DIMS:.*]] = arith.constant dense<[2, 8]> : tensor<2xi64>
+  // CHECK: %[[FILL:.*]] = "tfl.fill"(%[[DIMS]], %[[ZERO]]) : (tensor<2xi64>, tensor<f32>) -> tensor<2x8xf32>
+  // CHECK: "tfl.assign_variable"(%[[HANDLE]], %[[FILL]])
+  // CHECK: return
+}
+
+// -----
+
+// Tests that a state returned unchanged is not assigned.
+module attributes {tf_saved_model.semantics} {
+  // CHECK-LABEL: func.func @peek
+  // CHECK-SAME: () -> (tensor<4xi32> {tf_saved_model.index_path = ["sum"]})
+  func.func @peek(%arg0: tensor<4xi32> {tf_saved_model.index_path = ["state"]}) -> (tensor<4xi32> {tf_saved_model.index_path = ["sum"]}, tensor<4xi32> {tf_saved_model.index_path = ["state"]}) attributes {tf.entry_function = {inputs = "peek_state:0", outputs = "sum:0,state:0"}, tf_saved_model.exported_names = ["peek"]} {
+    %0 = tfl.add %arg0, %arg0 {fused_activation_function = "NONE"} : tensor<4xi32>
+    func.return %0, %arg0 : tensor<4xi32>, tensor<4xi32>
+  }
+  // CHECK: %[[READ:.*]] = "tfl.read_variable"
+  // CHECK: %[[ADD:.*]] = tfl.add %[[READ]], %[[READ]]
+  // CHECK-NOT: "tfl.assign_variable"
+  // CHECK: return %[[ADD]] : tensor<4xi32>
+}
+
+// -----
+
+// Tests that a state is not lifted when signatures disagree on its type, or
+// one of them only reads it.
+module attributes {tf_saved_model.semantics} {
+  // CHECK-LABEL: func.func @small
+  // CHECK-SAME: %arg1: tensor<2xf32> {tf_saved_model.index_path = ["cache"]}
+  // CHECK-NOT: tfl.var_handle
+  func.func @small(%arg0: tensor<2xf32> {tf_saved_model.index_path = ["x"]}, %arg1: tensor<2xf32> {tf_saved_model.index_path = ["cache"]}, %arg2: tensor<2xf32> {tf_saved_model.index_path = ["weights"]}) -> (tensor<2xf32> {tf_saved_model.index_path = ["cache"]}, tensor<2xf32> {tf_saved_model.index_path = ["weights"]}) attributes {tf.entry_function = {inputs = "x:0,cache:0,weights:0", outputs = "cache:0,weights:0"}, tf_saved_model.exported_names = ["small"]} {
+    %0 = tfl.add %arg0, %arg1 {fused_activation_function = "NONE"} : tensor<2xf32>
+    func.return %0, %arg2 : tensor<2xf32>, tensor<2xf32>
+  }
+
+  // CHECK-LABEL: func.func @large
+  // CHECK-NOT: tfl.var_handle
+  func.func @large(%arg0: tensor<4xf32> {tf_saved_model.index_path = ["cache"]}, %arg1: tensor<2xf32> {tf_saved_model.index_path = ["weights"]}) -> (tensor<4xf32> {tf_saved_model.index_path = ["cache"]}, tensor<2xf32> {tf_saved_model.index_path = ["out"]}) attributes {tf.entry_function = {inputs = "cache:0,weights:0", outputs = "cache:0,out:0"}, tf_saved_model.exported_names = ["large"]} {
+    func.return %arg0, %arg1 : tensor<4xf32>, tensor<2xf32>
+  }
+  // CHECK-NOT: tfl_lifted_state_initializer
+}
@@ -0,0 +1,33 @@
+// RUN: litert-opt %s -tfl-minimize-peak-memory -verify-diagnostics | FileCheck %s
+
+// CHECK-LABEL: @reduce_each_branch_before_expanding_the_next
+// expected-remark@+1 {{estimated peak activation memory 4008 bytes (originally: 8004 bytes)}}
+func.func @reduce_each_branch_before_expanding_the_next(%arg0: tensor<1xf32>, %arg1: tensor<1xf32>) -> (tensor<f32>, tensor<f32>) {
+  %shape = arith.constant dense<1000> : tensor<1xi32>
+  %axis = arith.constant dense<0> : tensor<1xi32>
+  %a = "tfl.broadcast_to"(%arg0, %shape) : (tensor<1xf32>, tensor<1xi32>) -> tensor<1000xf32>
+  %b = "tfl.broadcast_to"(%arg1, %shape) : (tensor<1xf32>, tensor<1xi32>) -> tensor<1000xf32>
+  %a2 = "tfl.sum"(%a, %axis) <{keep_dims = false}> : (tensor<1000xf32>, tensor<1xi32>) -> tensor<f32>
+  %b2 = "tfl.sum"(%b, %axis) <{keep_dims = false}> : (tensor<1000xf32>, tensor<1xi32>) -> tensor<f32>
+  func.return %a2, %b2 : tensor<f32>, tensor<f32>
+}
+// CHECK-NEXT: %[[SHAPE:.*]] = arith.constant dense<1000>
+// CHECK-NEXT: %[[AXIS:.*]] = arith.constant dense<0>
+// CHECK-NEXT: %[[A:.*]] = "tfl.broadcast_to"(%arg0, %[[SHAPE]])
+// CHECK-NEXT: %[[A2:.*]] = "tfl.sum"(%[[A]], %[[AXIS]])
+// CHECK-NEXT: %[[B:.*]] = "tfl.broadcast_to"(%arg1, %[[SHAPE]])
+// CHECK-NEXT: %[[B2:.*]] = "tfl.sum"(%[[B]], %[[AXIS]])
+// CHECK-NEXT: return %[[A2]], %[[B2]]
+
+// CHECK-LABEL: @keep_order_without_saving
+// expected-remark@+1 {{estimated peak activation memory 12 bytes, kept the original order}}
+func.func @keep_order_without_saving(%arg0: tensor<1xf32>) -> tensor<1xf32> {
+  %0 = "tfl.exp"(%arg0) : (tensor<1xf32>) -> tensor<1xf32>
+  %1 = "tfl.exp"(%0) : (tensor<1xf32>) -> tensor<1xf32>
+  %2 = tfl.add %0, %1 {fused_activation_function = "NONE"} : tensor<1xf32>
+  func.return %2 : tensor<1xf32>
+}
+// CHECK-NEXT: %[[EXP0:.*]] = "tfl.exp"(%arg0)
+// CHECK-NEXT: %[[EXP1:.*]] = "tfl.exp"(%[[EXP0]])
+// CHECK-NEXT: %[[ADD:.*]] = tfl.add %[[EXP0]], %[[EXP1]]
+// CHECK-NEXT: return %[[ADD]]
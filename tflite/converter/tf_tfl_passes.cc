@@ -590,9 +590,17 @@ void AddPostVariableFreezingTFToTFLConversionPasses(
         pass_config.preserve_assert_op;
     pass_manager->addNestedPass<mlir::func::FuncOp>(
         mlir::TFL::CreateLegalizeTFPass(legalize_tf_pass_options));
+    if (pass_config.constant_folding_budget_bytes >= 0) {
+      pass_manager->addPass(mlir::TFL::CreateConstantFoldingBudgetPass(
+          pass_config.constant_folding_budget_bytes));
+    }
 
     pass_manager->addPass(mlir::TFL::CreateAnalyzeVariablesPass());
     pass_manager->addPass(mlir::TFL::CreateLegalizeVariablesPass());
+    if (pass_config.enable_tflite_variables &&
+        pass_config.lift_state_to_variables) {
+      pass_manager->addPass(mlir::TFL::CreateLiftStateToVariablesPass());
+    }
     pass_manager->addPass(mlir::TFL::CreateLegalizeHashTablesPass());
 
     if (pass_config.quant_specs.qdq_conversion_mode ==
@@ -650,6 +658,12 @@ void AddPostVariableFreezingTFToTFLConversionPasses(
     }
     pass_manager->addPass(mlir::TFL::CreateCleanupOptimizationBarrierPass());
 
+    if (pass_config.minimize_peak_memory) {
+      pass_manager->addNestedPass<mlir::func::FuncOp>(
+          mlir::TFL::CreateMinimizePeakMemoryPass(
+              pass_config.peak_memory_locality_penalty));
+    }
+
     // This pass should always run before the end of the model conversion but
     // not after the CreateSplitMergedOperandsPass below.
     if (pass_config.canonicalizing_inf_as_min_max_float)
@@ -148,6 +148,10 @@ int GetBuiltinOperatorVersion(const OpSignature& op_sig) {
     case BuiltinOperator_EMBEDDING_LOOKUP: {
       if (op_sig.inputs.at(1).type == kTfLiteInt4 ||
           op_sig.ext_options.embedding_lookup.is_per_channel_quantized) {
+        // Requantized to an int8 output.
+        if (op_sig.outputs.at(0).type == kTfLiteInt8) {
+          return 5;
+        }
         return 4;
       }
       return 1;
@@ -1043,6 +1047,10 @@ int GetBuiltinOperatorVersion(const OpSignature& op_sig) {
       }
       return 1;
     case BuiltinOperator_TOPK_V2:
+      if (op_sig.inputs.at(0).type == kTfLiteFloat16 ||
+          op_sig.inputs.at(0).type == kTfLiteBFloat16) {
+        return 4;
+      }
       if (op_sig.inputs.at(0).type == kTfLiteInt16 ||
           op_sig.inputs.at(1).type == kTfLiteInt16 ||
           op_sig.outputs.at(1).type == kTfLiteInt16) {
@@ -123,6 +123,7 @@ std::string FindMinimumRuntimeVersionForOp(tflite::BuiltinOperator op_code,
               {{BuiltinOperator_EMBEDDING_LOOKUP, 2}, "1.14.0"},
               {{BuiltinOperator_EMBEDDING_LOOKUP, 3}, "1.14.0"},
               {{BuiltinOperator_EMBEDDING_LOOKUP, 4}, "2.18.0"},
+              {{BuiltinOperator_EMBEDDING_LOOKUP, 5}, "2.21.0"},
               {{BuiltinOperator_EMBEDDING_LOOKUP_SPARSE, 1}, "1.5.0"},
               {{BuiltinOperator_FAKE_QUANT, 1}, "1.5.0"},
               {{BuiltinOperator_FAKE_QUANT, 2}, "1.10.0"},
@@ -269,6 +270,7 @@ std::string FindMinimumRuntimeVersionForOp(tflite::BuiltinOperator op_code,
               {{BuiltinOperator_TOPK_V2, 1}, "1.7.0"},
               {{BuiltinOperator_TOPK_V2, 2}, "1.14.0"},
               {{BuiltinOperator_TOPK_V2, 3}, "2.13.0"},
+              {{BuiltinOperator_TOPK_V2, 4}, "2.21.0"},
               {{BuiltinOperator_ARG_MAX, 1}, "1.9.0"},
               {{BuiltinOperator_ARG_MAX, 2}, "1.14.0"},
               {{BuiltinOperator_ARG_MAX, 3}, "2.9.0"},
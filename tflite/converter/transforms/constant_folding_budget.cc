@@ -0,0 +1,128 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cstdint>
+#include <memory>
+
+#include "llvm/ADT/STLExtras.h"
+#include "mlir/IR/Builders.h"  // from @llvm-project
+#include "mlir/IR/BuiltinAttributes.h"  // from @llvm-project
+#include "mlir/IR/BuiltinOps.h"  // from @llvm-project
+#include "mlir/IR/BuiltinTypes.h"  // from @llvm-project
+#include "mlir/IR/Diagnostics.h"  // from @llvm-project
+#include "mlir/IR/Matchers.h"  // from @llvm-project
+#include "mlir/IR/Operation.h"  // from @llvm-project
+#include "mlir/IR/PatternMatch.h"  // from @llvm-project
+#include "mlir/Pass/Pass.h"  // from @llvm-project
+#include "mlir/Rewrite/FrozenRewritePatternSet.h"  // from @llvm-project
+#include "mlir/Support/LLVM.h"  // from @llvm-project
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"  // from @llvm-project
+#include "tflite/converter/ir/tfl_ops.h"
+#include "tflite/converter/transforms/passes.h"
+
+namespace mlir {
+namespace TFL {
+namespace {
+#define GEN_PASS_DEF_CONSTANTFOLDINGBUDGETPASS
+#include "tflite/converter/transforms/passes.h.inc"
+
+// Read by the folders of the TFL ops, see ShouldFoldOperation in tfl_ops.cc.
+constexpr char kConstantFoldingBudget[] = "tfl.constant_folding_budget";
+
+// The constants of a module and the ops computed from constants only.
+struct ConstantStats {
+  int64_t constant_bytes = 0;
+  int64_t num_unfolded_ops = 0;
+};
+
+int64_t TensorBytes(Type type) {
+  auto tensor_type = mlir::dyn_cast<RankedTensorType>(type);
+  if (!tensor_type || !tensor_type.hasStaticShape() ||
+      !tensor_type.getElementType().isIntOrFloat()) {
+    return 0;
+  }
+  return (tensor_type.getNumElements() *
+              tensor_type.getElementType().getIntOrFloatBitWidth() +
+          7) /
+         8;
+}
+
+ConstantStats CollectConstantStats(ModuleOp module) {
+  ConstantStats stats;
+  module.walk([&](Operation* op) {
+    if (matchPattern(op, m_Constant())) {
+      for (Type type : op->getResultTypes()) {
+        stats.constant_bytes += TensorBytes(type);
+      }
+      return;
+    }
+    if (!llvm::isa_and_nonnull<TFL::TensorFlowLiteDialect>(op->getDialect()) ||
+        op->getNumOperands() == 0 || op->getNumRegions() != 0) {
+      return;
+    }
+    if (llvm::all_of(op->getOperands(), [](Value operand) {
+          return matchPattern(operand, m_Constant());
+        })) {
+      ++stats.num_unfolded_ops;
+    }
+  });
+  return stats;
+}
+
+// Bounds the size of the constants that the TFL folders create for the rest
+// of the conversion, folds the module, and reports how the constants grew.
+class ConstantFoldingBudgetPass
+    : public impl::ConstantFoldingBudgetPassBase<ConstantFoldingBudgetPass> {
+ public:
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(ConstantFoldingBudgetPass)
+
+  explicit ConstantFoldingBudgetPass() = default;
+  explicit ConstantFoldingBudgetPass(int64_t budget_bytes) {
+    budget_bytes_ = budget_bytes;
+  }
+
+  void runOnOperation() override;
+};
+
+void ConstantFoldingBudgetPass::runOnOperation() {
+  ModuleOp module = getOperation();
+  Builder builder(module);
+  module->setAttr(kConstantFoldingBudget,
+                  builder.getI64IntegerAttr(budget_bytes_));
+
+  const ConstantStats before = CollectConstantStats(module);
+  // Without patterns, the driver only folds ops and erases dead ones.
+  (void)applyPatternsGreedily(module, FrozenRewritePatternSet());
+  const ConstantStats after = CollectConstantStats(module);
+
+  emitRemark(module.getLoc())
+      << "constant folding changed the constants from "
+      << before.constant_bytes << " to " << after.constant_bytes
+      << " bytes; kept " << after.num_unfolded_ops
+      << " ops on constants at runtime within a budget of " << budget_bytes_
+      << " bytes per op";
+}
+
+}  // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> CreateConstantFoldingBudgetPass(
+    int64_t budget_bytes) {
+  return std::make_unique<ConstantFoldingBudgetPass>(budget_bytes);
+}
+
+static PassRegistration<ConstantFoldingBudgetPass> pass;
+
+}  // namespace TFL
+}  // namespace mlir
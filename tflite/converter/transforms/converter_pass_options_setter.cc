@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tflite/converter/transforms/converter_pass_options_setter.h"
 
+#include "tflite/converter/transforms/dense_to_sparse_pass_options.h"
 #include "tflite/converter/transforms/optimize_broadcast_like_pass_options.h"
 #include "tflite/converter/transforms/optimize_pass_options.h"
 #include "tflite/converter/transforms/pass_options.h"
@@ -40,6 +41,9 @@ void ConverterPassOptionsSetter::SetOptions(
   //     converter_flags_.unsafe_fuse_dynamic_shaped_broadcast();
 }
 
+void ConverterPassOptionsSetter::SetOptions(
+    DenseToSparsePassOptions& options) const {}
+
 void ConverterPassOptionsSetter::SetOptions(EmptyPassOptions& options) const {}
 
 }  // namespace TFL
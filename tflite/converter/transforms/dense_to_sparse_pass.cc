@@ -16,8 +16,13 @@ limitations under the License.
 // This transformation pass convert dense tensor to sparse format.
 #include "tflite/converter/transforms/dense_to_sparse_pass.h"
 
+#include <cmath>
+#include <string>
+#include <vector>
+
 #include "absl/memory/memory.h"  // from @com_google_absl
 #include "Eigen/Core"  // from @eigen_archive
+#include "llvm/Support/FormatVariadic.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"  // from @llvm-project
 #include "mlir/IR/Builders.h"  // from @llvm-project
 #include "mlir/IR/BuiltinTypes.h"  // from @llvm-project
@@ -41,6 +46,12 @@ constexpr float kBlockOverRandomSparsityRatio = 0.9;
 // After quantization, some non-zero values are set to 0.
 // Lower the ratio for identifying block configuration for quantized constants.
 constexpr float kBlockOverRandomSparsityRatioQuant = 0.8;
+// Rough cost model of the sparse kernels, in units of the time the dense
+// kernels spend on a weight value. The sparse kernels skip the blocks of
+// zeros, but run the other blocks without the register tiling of the dense
+// kernels, and walk the segment of each row of blocks.
+constexpr float kSparseValueCost = 2.0;
+constexpr float kSparseRowCost = 8.0;
 
 Eigen::half APFloatToEigenHalf(const APFloat& val) {
   uint16_t raw_data = val.bitcastToAPInt().getZExtValue();
@@ -166,6 +177,10 @@ typedef struct InspectResult {
   // Among the supported block configs of an op, which got selected to encode
   // the sparse weight.
   std::vector<int> selected_block_size;
+  // Ratio of zeros in the weight tensor.
+  float random_sparsity;
+  // Ratio of values in blocks of zeros for the selected block config.
+  float block_sparsity;
 } InspectResult;
 
 InspectResult InspectWeight(
@@ -200,6 +215,7 @@ InspectResult InspectWeight(
   }
 
   result.can_compress = true;
+  result.random_sparsity = random_sparsity;
 
   float curr_sparsity = 0;
   std::vector<int> selected_block_size;
@@ -211,6 +227,7 @@ InspectResult InspectWeight(
       result.can_compress = true;
       result.needs_densify = false;
       result.selected_block_size = selected_block_size;
+      result.block_sparsity = curr_sparsity;
       break;
     }
   }
@@ -218,6 +235,31 @@ InspectResult InspectWeight(
   return result;
 }
 
+// Returns how many times faster the sparse kernel is expected to be than the
+// dense one, for a 2-D weight of `type` with `block_sparsity` of its values in
+// blocks of zeros of `block_size`.
+float EstimateSparseSpeedup(const ShapedType& type,
+                            const std::vector<int>& block_size,
+                            const float block_sparsity) {
+  const float num_values = type.getNumElements();
+  const float num_block_rows = type.getDimSize(0) / block_size[0];
+  const float sparse_cost =
+      (1 - block_sparsity) * num_values * kSparseValueCost +
+      num_block_rows * kSparseRowCost;
+  return num_values / sparse_cost;
+}
+
+std::string BlockSizeToString(const std::vector<int>& block_size) {
+  std::string result;
+  for (int i = 0; i < block_size.size(); i++) {
+    if (i > 0) result += "x";
+    result += std::to_string(block_size[i]);
+  }
+  return result;
+}
+
+inline int ToPercent(const float ratio) { return std::round(100 * ratio); }
+
 template <typename T>
 std::vector<T> BuildSparsityParameterAttribute(
     const std::vector<int>& block_size, const T* dense_buffer, Operation* inst,
@@ -278,12 +320,14 @@ std::vector<T> BuildSparsityParameterAttribute(
 void DenseToSparsePass::runOnOperation() {
   func::FuncOp func = getOperation();
   OpBuilder builder(func);
+  const bool supported_blocks_only = GetOptions().supported_blocks_only;
 
   func.walk([&](SparseOpInterface sparse_op) {
     const auto& sparse_operands = sparse_op.GetSparseOperands();
     std::vector<std::vector<int>> supported_block_size;
     for (int operand : sparse_operands) {
       auto* op = sparse_op.getOperation();
+      const int sparse_operand = operand;
       auto value = op->getOperand(operand);
 
       auto* inst = value.getDefiningOp();
@@ -323,6 +367,28 @@ void DenseToSparsePass::runOnOperation() {
         continue;
       }
 
+      // Reports whether the sparse kernel is expected to pay off.
+      bool is_faster = false;
+      if (result.needs_densify) {
+        sparse_op->emitRemark()
+            << "operand " << sparse_operand << " is "
+            << ToPercent(result.random_sparsity)
+            << "% sparse, but not in blocks supported by the sparse kernel";
+      } else {
+        const float speedup = EstimateSparseSpeedup(
+            type, result.selected_block_size, result.block_sparsity);
+        is_faster = speedup > 1;
+        sparse_op->emitRemark()
+            << "operand " << sparse_operand << " is "
+            << ToPercent(result.block_sparsity) << "% sparse in "
+            << BlockSizeToString(result.selected_block_size)
+            << " blocks: sparse kernel estimated "
+            << llvm::formatv("{0:F2}", speedup).str() << "x as fast as dense";
+      }
+      if (supported_blocks_only && !is_faster) {
+        continue;
+      }
+
       // The weight is not block sparse. Encode with random sparsity.
       if (result.selected_block_size.empty()) {
         result.selected_block_size = std::vector<int>(type.getRank(), 1);
@@ -25,8 +25,8 @@ limitations under the License.
 #include "mlir/Support/LLVM.h"  // from @llvm-project
 #include "mlir/Support/TypeID.h"  // from @llvm-project
 #include "tflite/converter/ir/tfl_ops.h"
+#include "tflite/converter/transforms/dense_to_sparse_pass_options.h"
 #include "tflite/converter/transforms/pass.h"
-#include "tflite/converter/transforms/pass_options.h"
 
 namespace mlir {
 namespace TFL {
@@ -44,12 +44,20 @@ namespace TFL {
 //     4.1. Return the matching block config if found.
 //     4.2. If no matching block config is found, encode the weight with random
 //          sparsity, and add Densify() op to fall back to dense execution.
+//
+// A remark reports for each sparse weight whether its op is expected to run
+// faster with the sparse kernel than with the dense one. With the
+// `supported-blocks-only` option, only those weights are encoded, and the
+// others are kept dense.
 
 class DenseToSparsePass
-    : public Pass<DenseToSparsePass, EmptyPassOptions, func::FuncOp> {
+    : public Pass<DenseToSparsePass, DenseToSparsePassOptions, func::FuncOp> {
  public:
   DenseToSparsePass() = default;
   DenseToSparsePass(const DenseToSparsePass &other) {}
+  explicit DenseToSparsePass(const mlir::detail::PassOptions &options)
+      : Pass<DenseToSparsePass, DenseToSparsePassOptions, func::FuncOp>(
+            options) {}
 
   void runOnOperation() final;
 
@@ -0,0 +1,44 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_COMPILER_MLIR_LITE_TRANSFORMS_DENSE_TO_SPARSE_PASS_OPTIONS_H_
+#define TENSORFLOW_COMPILER_MLIR_LITE_TRANSFORMS_DENSE_TO_SPARSE_PASS_OPTIONS_H_
+
+#include "llvm/Support/CommandLine.h"
+#include "mlir/Pass/PassOptions.h"  // from @llvm-project
+
+namespace mlir {
+namespace TFL {
+
+////////////////////////////////////////////////////////////////////////////////
+// Pass Options
+////////////////////////////////////////////////////////////////////////////////
+
+struct DenseToSparsePassOptions : public mlir::detail::PassOptions {
+  mlir::detail::PassOptions::Option<bool> supported_blocks_only{
+      *this, "supported-blocks-only",
+      llvm::cl::desc(
+          "Only encode the weights whose sparsity matches a block "
+          "configuration of the sparse kernel of their op, and for which that "
+          "kernel is expected to be faster than the dense one. Other weights "
+          "are kept dense, instead of being encoded with random sparsity and "
+          "densified at runtime."),
+      llvm::cl::init(false)};
+};
+
+}  // namespace TFL
+}  // namespace mlir
+
+#endif  // TENSORFLOW_COMPILER_MLIR_LITE_TRANSFORMS_DENSE_TO_SPARSE_PASS_OPTIONS_H_
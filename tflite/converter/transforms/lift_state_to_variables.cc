@@ -0,0 +1,324 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <memory>
+#include <string>
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/Casting.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"  // from @llvm-project
+#include "mlir/Dialect/Func/IR/FuncOps.h"  // from @llvm-project
+#include "mlir/IR/Builders.h"  // from @llvm-project
+#include "mlir/IR/BuiltinAttributes.h"  // from @llvm-project
+#include "mlir/IR/BuiltinOps.h"  // from @llvm-project
+#include "mlir/IR/BuiltinTypes.h"  // from @llvm-project
+#include "mlir/IR/Location.h"  // from @llvm-project
+#include "mlir/IR/SymbolTable.h"  // from @llvm-project
+#include "mlir/IR/Value.h"  // from @llvm-project
+#include "mlir/Pass/Pass.h"  // from @llvm-project
+#include "mlir/Support/LLVM.h"  // from @llvm-project
+#include "tflite/converter/ir/tfl_ops.h"
+#include "tflite/converter/transforms/passes.h"
+#include "tflite/converter/utils/variables_utils.h"
+#include "tensorflow/compiler/mlir/tensorflow/ir/tf_saved_model.h"
+#include "tensorflow/compiler/mlir/tensorflow/ir/tf_types.h"
+
+namespace mlir {
+namespace TFL {
+namespace {
+#define GEN_PASS_DEF_LIFTSTATETOVARIABLESPASS
+#include "tflite/converter/transforms/passes.h.inc"
+
+constexpr char kEntryFunctionAttr[] = "tf.entry_function";
+constexpr char kStateInitializerName[] = "tfl_lifted_state_initializer";
+
+// An input of an entry function that is returned, updated, by an output of
+// the same name, such as a KV cache.
+struct StatePair {
+  int arg_index;
+  int result_index;
+  std::string name;
+};
+
+// Returns the names of the arguments (or results) of `func`: their
+// tf_saved_model.index_path if they all have one, and otherwise the names in
+// tf.entry_function. Returns an empty list if they are not all named.
+llvm::SmallVector<std::string> GetNames(func::FuncOp func, bool results) {
+  const int size = results ? func.getNumResults() : func.getNumArguments();
+  llvm::SmallVector<std::string> names;
+  for (int i = 0; i < size; ++i) {
+    auto index_path =
+        results ? func.getResultAttrOfType<ArrayAttr>(
+                      i, tf_saved_model::kTfSavedModelIndexPathAttr)
+                : func.getArgAttrOfType<ArrayAttr>(
+                      i, tf_saved_model::kTfSavedModelIndexPathAttr);
+    if (!index_path || index_path.size() != 1) break;
+    auto name = llvm::dyn_cast<StringAttr>(index_path[0]);
+    if (!name) break;
+    names.push_back(name.str());
+  }
+  if (names.size() == size) return names;
+
+  names.clear();
+  auto entry_function = func->getAttrOfType<DictionaryAttr>(kEntryFunctionAttr);
+  auto entry_names = entry_function
+                         ? entry_function.getAs<StringAttr>(
+                               results ? "outputs" : "inputs")
+                         : nullptr;
+  if (!entry_names) return {};
+  llvm::SmallVector<StringRef> split;
+  entry_names.getValue().split(split, ',', /*MaxSplit=*/-1,
+                               /*KeepEmpty=*/false);
+  if (split.size() != size) return {};
+  for (StringRef name : split) names.push_back(name.str());
+  return names;
+}
+
+bool IsLiftableType(Type type) {
+  auto shaped_type = llvm::dyn_cast<RankedTensorType>(type);
+  return shaped_type && shaped_type.hasStaticShape() &&
+         shaped_type.getElementType().isIntOrFloat() &&
+         utils::IsSupportedVariableType(shaped_type);
+}
+
+// Returns a tensor of zeros of `type`. Types supported by tfl.fill are filled
+// at runtime rather than stored as a constant, as the state is usually large.
+Value CreateZeros(OpBuilder& builder, Location loc, RankedTensorType type) {
+  Type element_type = type.getElementType();
+  Value zero = builder.create<arith::ConstantOp>(
+      loc, builder.getZeroAttr(RankedTensorType::get({}, element_type)));
+  if (!element_type.isF32() && !element_type.isSignlessInteger(32) &&
+      !element_type.isSignlessInteger(64) &&
+      !element_type.isSignlessInteger(1)) {
+    return builder.create<arith::ConstantOp>(loc, builder.getZeroAttr(type));
+  }
+  auto dims_type = RankedTensorType::get({type.getRank()},
+                                         builder.getIntegerType(64));
+  Value dims = builder.create<arith::ConstantOp>(
+      loc, DenseIntElementsAttr::get(dims_type, type.getShape()));
+  return builder.create<TFL::FillOp>(loc, type, dims, zero);
+}
+
+Value CreateVarHandle(OpBuilder& builder, Location loc, StringRef name,
+                      RankedTensorType type) {
+  auto resource_type = RankedTensorType::get(
+      {}, TF::ResourceType::get({type}, builder.getContext()));
+  return builder.create<TFL::VarHandleOp>(loc, resource_type,
+                                          /*container=*/StringRef(""), name);
+}
+
+// Removes the names at `indices` from the tf.entry_function `key` list.
+void EraseEntryFunctionNames(func::FuncOp func, StringRef key,
+                             const llvm::BitVector& indices) {
+  auto entry_function = func->getAttrOfType<DictionaryAttr>(kEntryFunctionAttr);
+  if (!entry_function) return;
+  auto names = entry_function.getAs<StringAttr>(key);
+  if (!names) return;
+  llvm::SmallVector<StringRef> split;
+  names.getValue().split(split, ',', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+  if (split.size() != indices.size()) return;
+  llvm::SmallVector<StringRef> kept;
+  for (int i = 0; i < split.size(); ++i) {
+    if (!indices.test(i)) kept.push_back(split[i]);
+  }
+  NamedAttrList attrs(entry_function);
+  attrs.set(key, StringAttr::get(func.getContext(), llvm::join(kept, ",")));
+  func->setAttr(kEntryFunctionAttr, attrs.getDictionary(func.getContext()));
+}
+
+// Converts the inputs and outputs of entry functions that carry state from
+// one invocation to the next, such as the KV cache of a decoder, into
+// resource variables. The runtime then updates the state in place instead of
+// copying it in and out of every signature.
+class LiftStateToVariablesPass
+    : public impl::LiftStateToVariablesPassBase<LiftStateToVariablesPass> {
+ public:
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(LiftStateToVariablesPass)
+
+  explicit LiftStateToVariablesPass() = default;
+  explicit LiftStateToVariablesPass(llvm::ArrayRef<std::string> state_names) {
+    state_names_ = state_names;
+  }
+
+  void runOnOperation() override;
+
+ private:
+  // Finds the state pairs of every entry function. A name is only lifted if
+  // every entry function that has an input or output of that name has both,
+  // with the same type, so that all signatures can share one variable.
+  llvm::MapVector<func::FuncOp, llvm::SmallVector<StatePair>> FindStatePairs(
+      llvm::StringMap<RankedTensorType>& state_types);
+
+  void LiftStatePairs(func::FuncOp func, ArrayRef<StatePair> pairs,
+                      const llvm::StringMap<RankedTensorType>& state_types,
+                      StringRef initializer_name);
+
+  func::FuncOp CreateInitializer(
+      const llvm::MapVector<StringRef, RankedTensorType>& states);
+};
+
+llvm::MapVector<func::FuncOp, llvm::SmallVector<StatePair>>
+LiftStateToVariablesPass::FindStatePairs(
+    llvm::StringMap<RankedTensorType>& state_types) {
+  llvm::StringSet<> allowed_names;
+  for (const std::string& name : state_names_) allowed_names.insert(name);
+
+  llvm::MapVector<func::FuncOp, llvm::SmallVector<StatePair>> candidates;
+  llvm::StringSet<> rejected;
+  for (auto func : getOperation().getOps<func::FuncOp>()) {
+    if (!func->hasAttr(kEntryFunctionAttr) || func.isExternal()) continue;
+    llvm::SmallVector<std::string> arg_names = GetNames(func, false);
+    llvm::SmallVector<std::string> result_names = GetNames(func, true);
+    llvm::StringMap<int> result_indices;
+    for (int i = 0; i < result_names.size(); ++i) {
+      result_indices[result_names[i]] = i;
+    }
+
+    llvm::StringSet<> paired;
+    for (int i = 0; i < arg_names.size(); ++i) {
+      const std::string& name = arg_names[i];
+      if (!allowed_names.empty() && !allowed_names.contains(name)) continue;
+      auto result = result_indices.find(name);
+      if (result == result_indices.end()) {
+        // Only read by this function.
+        rejected.insert(name);
+        continue;
+      }
+      Type type = func.getArgument(i).getType();
+      auto ranked_type = llvm::dyn_cast<RankedTensorType>(type);
+      if (type != func.getResultTypes()[result->second] ||
+          !IsLiftableType(type)) {
+        rejected.insert(name);
+        continue;
+      }
+      auto [it, inserted] = state_types.try_emplace(name, ranked_type);
+      if (!inserted && it->second != ranked_type) rejected.insert(name);
+      candidates[func].push_back({i, result->second, name});
+      paired.insert(name);
+    }
+    for (const std::string& name : result_names) {
+      // Only written by this function.
+      if (!paired.contains(name)) rejected.insert(name);
+    }
+  }
+
+  llvm::MapVector<func::FuncOp, llvm::SmallVector<StatePair>> state_pairs;
+  for (auto& [func, pairs] : candidates) {
+    for (const StatePair& pair : pairs) {
+      if (!rejected.contains(pair.name)) state_pairs[func].push_back(pair);
+    }
+  }
+  for (const auto& name : rejected) state_types.erase(name.getKey());
+  return state_pairs;
+}
+
+func::FuncOp LiftStateToVariablesPass::CreateInitializer(
+    const llvm::MapVector<StringRef, RankedTensorType>& states) {
+  ModuleOp module = getOperation();
+  OpBuilder builder = OpBuilder::atBlockEnd(module.getBody());
+  Location loc = builder.getUnknownLoc();
+  auto initializer = builder.create<func::FuncOp>(
+      loc, kStateInitializerName, builder.getFunctionType({}, {}));
+  // Renames the initializer if its name is taken.
+  SymbolTable(module).insert(initializer);
+  // The initializer stays public so that it is exported, as it is only
+  // referenced by name from the tfl.call_once ops.
+  if (module->hasAttr("tf_saved_model.semantics")) {
+    initializer->setAttr(
+        tf_saved_model::kTfSavedModelExportedNamesAttr,
+        builder.getStrArrayAttr({initializer.getSymName()}));
+  }
+
+  builder.setInsertionPointToStart(initializer.addEntryBlock());
+  for (const auto& [name, type] : states) {
+    Value handle = CreateVarHandle(builder, loc, name, type);
+    builder.create<TFL::AssignVariableOp>(
+        loc, handle, CreateZeros(builder, loc, type));
+  }
+  builder.create<func::ReturnOp>(loc);
+  return initializer;
+}
+
+void LiftStateToVariablesPass::LiftStatePairs(
+    func::FuncOp func, ArrayRef<StatePair> pairs,
+    const llvm::StringMap<RankedTensorType>& state_types,
+    StringRef initializer_name) {
+  Location loc = func.getLoc();
+  OpBuilder builder = OpBuilder::atBlockBegin(&func.front());
+  builder.create<TFL::CallOnceOp>(loc, initializer_name);
+
+  Operation* terminator = func.front().getTerminator();
+  llvm::BitVector erased_args(func.getNumArguments());
+  llvm::BitVector erased_results(func.getNumResults());
+  llvm::SmallVector<Value> handles, reads;
+  for (const StatePair& pair : pairs) {
+    RankedTensorType type = state_types.lookup(pair.name);
+    Value handle = CreateVarHandle(builder, loc, pair.name, type);
+    Value read = builder.create<TFL::ReadVariableOp>(loc, type, handle);
+    func.getArgument(pair.arg_index).replaceAllUsesWith(read);
+    handles.push_back(handle);
+    reads.push_back(read);
+    erased_args.set(pair.arg_index);
+    erased_results.set(pair.result_index);
+  }
+
+  builder.setInsertionPoint(terminator);
+  for (int i = 0; i < pairs.size(); ++i) {
+    Value value = terminator->getOperand(pairs[i].result_index);
+    // Returning the input unchanged leaves the variable as it is.
+    if (value == reads[i]) continue;
+    builder.create<TFL::AssignVariableOp>(loc, handles[i], value);
+  }
+  terminator->eraseOperands(erased_results);
+  EraseEntryFunctionNames(func, "inputs", erased_args);
+  EraseEntryFunctionNames(func, "outputs", erased_results);
+  (void)func.eraseArguments(erased_args);
+  (void)func.eraseResults(erased_results);
+}
+
+void LiftStateToVariablesPass::runOnOperation() {
+  llvm::StringMap<RankedTensorType> state_types;
+  auto state_pairs = FindStatePairs(state_types);
+  if (state_pairs.empty()) return;
+
+  // Initialized in the order the states first appear.
+  llvm::MapVector<StringRef, RankedTensorType> states;
+  for (const auto& [func, pairs] : state_pairs) {
+    for (const StatePair& pair : pairs) {
+      states.insert({state_types.find(pair.name)->getKey(),
+                     state_types.lookup(pair.name)});
+    }
+  }
+  func::FuncOp initializer = CreateInitializer(states);
+  for (auto& [func, pairs] : state_pairs) {
+    LiftStatePairs(func, pairs, state_types, initializer.getSymName());
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> CreateLiftStateToVariablesPass(
+    llvm::ArrayRef<std::string> state_names) {
+  return std::make_unique<LiftStateToVariablesPass>(state_names);
+}
+
+}  // namespace TFL
+}  // namespace mlir
@@ -0,0 +1,298 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallVector.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"  // from @llvm-project
+#include "mlir/Dialect/Quant/IR/QuantTypes.h"  // from @llvm-project
+#include "mlir/IR/Block.h"  // from @llvm-project
+#include "mlir/IR/BuiltinTypes.h"  // from @llvm-project
+#include "mlir/IR/Diagnostics.h"  // from @llvm-project
+#include "mlir/IR/Matchers.h"  // from @llvm-project
+#include "mlir/IR/Operation.h"  // from @llvm-project
+#include "mlir/IR/Value.h"  // from @llvm-project
+#include "mlir/Interfaces/SideEffectInterfaces.h"  // from @llvm-project
+#include "mlir/Pass/Pass.h"  // from @llvm-project
+#include "mlir/Support/LLVM.h"  // from @llvm-project
+#include "tflite/converter/ir/tfl_ops.h"
+#include "tflite/converter/transforms/passes.h"
+
+namespace mlir {
+namespace TFL {
+namespace {
+#define GEN_PASS_DEF_MINIMIZEPEAKMEMORYPASS
+#include "tflite/converter/transforms/passes.h.inc"
+
+// Returns the number of bytes the arena planner allocates for `value`.
+// Constants live in the flatbuffer rather than the arena, and dynamic
+// dimensions are assumed to be one.
+int64_t ArenaBytes(Value value) {
+  if (Operation* def = value.getDefiningOp();
+      def && matchPattern(def, m_Constant())) {
+    return 0;
+  }
+  auto type = mlir::dyn_cast<RankedTensorType>(value.getType());
+  if (!type) return 0;
+  Type element_type = type.getElementType();
+  if (auto quant_type = mlir::dyn_cast<quant::QuantizedType>(element_type)) {
+    element_type = quant_type.getStorageType();
+  }
+  if (!element_type.isIntOrFloat()) return 0;
+  int64_t num_elements = 1;
+  for (int64_t dim : type.getShape()) {
+    if (!ShapedType::isDynamic(dim)) num_elements *= dim;
+  }
+  return (num_elements * element_type.getIntOrFloatBitWidth() + 7) / 8;
+}
+
+// Returns true for ops that the Flex delegate runs, which form partitions
+// that are costly to split.
+bool IsFlexOp(Operation* op) {
+  if (auto custom_op = mlir::dyn_cast<TFL::CustomOp>(op)) {
+    return custom_op.getCustomCode().starts_with("Flex");
+  }
+  return op->getDialect() && op->getDialect()->getNamespace() == "tf";
+}
+
+// The dataflow of the ops of a block, ignoring its terminator. Ops with
+// regions are scheduled as a whole, with the values they capture as operands.
+class BlockGraph {
+ public:
+  explicit BlockGraph(Block& block) : block_(block) {
+    for (Operation& op : block.without_terminator()) {
+      index_[&op] = ops_.size();
+      ops_.push_back(&op);
+    }
+    operands_.resize(ops_.size());
+    predecessors_.resize(ops_.size());
+    successors_.resize(ops_.size());
+
+    Operation* last_side_effect = nullptr;
+    for (int i = 0; i < ops_.size(); ++i) {
+      llvm::SetVector<Value> operands;
+      ops_[i]->walk([&](Operation* nested) {
+        for (Value operand : nested->getOperands()) {
+          if (IsDefinedOutside(operand, ops_[i])) operands.insert(operand);
+        }
+      });
+      for (Value operand : operands) {
+        operands_[i].push_back(operand);
+        ++num_uses_[operand];
+        if (Operation* def = ProducerInBlock(operand)) {
+          AddEdge(index_[def], i);
+        }
+      }
+      // Ops with side effects keep their relative order.
+      if (!isMemoryEffectFree(ops_[i])) {
+        if (last_side_effect) AddEdge(index_[last_side_effect], i);
+        last_side_effect = ops_[i];
+      }
+    }
+    for (Value value : block.getTerminator()->getOperands()) {
+      returned_.insert(value);
+    }
+  }
+
+  ArrayRef<Operation*> ops() const { return ops_; }
+  ArrayRef<Value> operands(int op) const { return operands_[op]; }
+  ArrayRef<int> successors(int op) const { return successors_[op]; }
+  int num_predecessors(int op) const { return predecessors_[op].size(); }
+  int num_uses(Value value) const { return num_uses_.lookup(value); }
+  // Returned values stay allocated until the end.
+  bool is_returned(Value value) const { return returned_.contains(value); }
+
+  // Returns the peak of the arena when the ops run in `order`, given as
+  // indices into ops().
+  int64_t EstimatePeak(ArrayRef<int> order) const {
+    llvm::DenseMap<Value, int> remaining_uses;
+    int64_t live = 0;
+    for (BlockArgument arg : block_.getArguments()) live += ArenaBytes(arg);
+    int64_t peak = live;
+    for (int op : order) {
+      live += AllocatedBytes(op);
+      peak = std::max(peak, live);
+      live -= FreedBytes(op, remaining_uses, /*update=*/true);
+    }
+    return peak;
+  }
+
+  int64_t AllocatedBytes(int op) const {
+    int64_t bytes = 0;
+    for (Value result : ops_[op]->getResults()) bytes += ArenaBytes(result);
+    return bytes;
+  }
+
+  // Returns the bytes freed once `op` has run: its operands it is the last
+  // user of, and its unused results. `remaining_uses` counts the uses of each
+  // value that have run so far, and is only updated with `update`.
+  int64_t FreedBytes(int op, llvm::DenseMap<Value, int>& remaining_uses,
+                     bool update) const {
+    int64_t bytes = 0;
+    for (Value operand : operands_[op]) {
+      auto [it, inserted] =
+          remaining_uses.try_emplace(operand, num_uses(operand));
+      if (it->second == 1 && !is_returned(operand)) {
+        bytes += ArenaBytes(operand);
+      }
+      if (update) --it->second;
+    }
+    for (Value result : ops_[op]->getResults()) {
+      if (result.use_empty()) bytes += ArenaBytes(result);
+    }
+    return bytes;
+  }
+
+ private:
+  // Returns true if `value` is not defined in `op` or its regions.
+  static bool IsDefinedOutside(Value value, Operation* op) {
+    return !op->isAncestor(value.getParentRegion()->getParentOp());
+  }
+
+  // Returns the op of the block that defines `value`, if any.
+  Operation* ProducerInBlock(Value value) const {
+    Operation* def = value.getDefiningOp();
+    if (!def) return nullptr;
+    Operation* ancestor = block_.findAncestorOpInBlock(*def);
+    if (!ancestor || !index_.count(ancestor)) return nullptr;
+    return ancestor;
+  }
+
+  void AddEdge(int from, int to) {
+    if (from == to || !predecessors_[to].insert(from).second) return;
+    successors_[from].push_back(to);
+  }
+
+  Block& block_;
+  std::vector<Operation*> ops_;
+  llvm::DenseMap<Operation*, int> index_;
+  std::vector<llvm::SmallVector<Value, 4>> operands_;
+  std::vector<llvm::DenseSet<int>> predecessors_;
+  std::vector<llvm::SmallVector<int, 4>> successors_;
+  llvm::DenseMap<Value, int> num_uses_;
+  llvm::DenseSet<Value> returned_;
+};
+
+// Schedules the ops greedily: of the ops that are ready, runs the one that
+// grows the arena the least, counting the bytes its outputs add and the bytes
+// its last uses free. Switching between delegated and builtin ops adds
+// `locality_penalty` bytes to the cost, so that partitions that the delegate
+// would otherwise run in one go are only split for a large enough saving.
+// Ties keep the original order.
+std::vector<int> MinPeakOrder(const BlockGraph& graph,
+                              int64_t locality_penalty) {
+  const int num_ops = graph.ops().size();
+  std::vector<int> num_pending(num_ops);
+  std::vector<int> ready;
+  for (int i = 0; i < num_ops; ++i) {
+    num_pending[i] = graph.num_predecessors(i);
+    if (num_pending[i] == 0) ready.push_back(i);
+  }
+
+  std::vector<int> order;
+  order.reserve(num_ops);
+  llvm::DenseMap<Value, int> remaining_uses;
+  while (!ready.empty()) {
+    auto cost = [&](int op) {
+      int64_t growth = graph.AllocatedBytes(op) -
+                       graph.FreedBytes(op, remaining_uses, /*update=*/false);
+      if (!order.empty() &&
+          IsFlexOp(graph.ops()[op]) != IsFlexOp(graph.ops()[order.back()])) {
+        growth += locality_penalty;
+      }
+      return growth;
+    };
+    auto best = ready.begin();
+    int64_t best_cost = cost(*best);
+    for (auto it = std::next(ready.begin()); it != ready.end(); ++it) {
+      int64_t it_cost = cost(*it);
+      if (it_cost < best_cost || (it_cost == best_cost && *it < *best)) {
+        best = it;
+        best_cost = it_cost;
+      }
+    }
+    const int op = *best;
+    ready.erase(best);
+    order.push_back(op);
+    graph.FreedBytes(op, remaining_uses, /*update=*/true);
+    for (int successor : graph.successors(op)) {
+      if (--num_pending[successor] == 0) ready.push_back(successor);
+    }
+  }
+  return order;
+}
+
+// Reorders the ops of each function to reduce the peak size of the arena in
+// which the runtime allocates the activations.
+class MinimizePeakMemoryPass
+    : public impl::MinimizePeakMemoryPassBase<MinimizePeakMemoryPass> {
+ public:
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(MinimizePeakMemoryPass)
+
+  explicit MinimizePeakMemoryPass() = default;
+  explicit MinimizePeakMemoryPass(int64_t locality_penalty) {
+    locality_penalty_ = locality_penalty;
+  }
+
+  void runOnOperation() override;
+};
+
+void MinimizePeakMemoryPass::runOnOperation() {
+  func::FuncOp func = getOperation();
+  if (func.isExternal() || !func.getBody().hasOneBlock()) return;
+  Block& block = func.getBody().front();
+  BlockGraph graph(block);
+  if (graph.ops().size() < 2) return;
+
+  std::vector<int> original_order(graph.ops().size());
+  for (int i = 0; i < original_order.size(); ++i) original_order[i] = i;
+  const int64_t original_peak = graph.EstimatePeak(original_order);
+
+  std::vector<int> order = MinPeakOrder(graph, locality_penalty_);
+  // The graph of a verified block is acyclic, so every op is scheduled.
+  if (order.size() != graph.ops().size()) return;
+  const int64_t peak = graph.EstimatePeak(order);
+
+  // Locality may cost memory, but the order never makes the peak worse.
+  if (peak >= original_peak) {
+    emitRemark(func.getLoc(), func.getName())
+        << ": estimated peak activation memory " << original_peak
+        << " bytes, kept the original order";
+    return;
+  }
+  Operation* terminator = block.getTerminator();
+  for (int op : order) graph.ops()[op]->moveBefore(terminator);
+  emitRemark(func.getLoc(), func.getName())
+      << ": estimated peak activation memory " << peak
+      << " bytes (originally: " << original_peak << " bytes)";
+}
+
+}  // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>> CreateMinimizePeakMemoryPass(
+    int64_t locality_penalty) {
+  return std::make_unique<MinimizePeakMemoryPass>(locality_penalty);
+}
+
+static PassRegistration<MinimizePeakMemoryPass> pass;
+
+}  // namespace TFL
+}  // namespace mlir
@@ -23,6 +23,7 @@ class OptimizePassOptions;
 class VariableFreezingPipelineOptions;
 class EmptyPassOptions;
 class OptimizeBroadcastLikePassOptions;
+class DenseToSparsePassOptions;
 
 // Interface for setting options for TFLite Converter Pass/Pipeline Options.
 class PassOptionsSetter {
@@ -32,6 +33,7 @@ class PassOptionsSetter {
   virtual void SetOptions(VariableFreezingPipelineOptions& options) const = 0;
   virtual void SetOptions(EmptyPassOptions& options) const = 0;
   virtual void SetOptions(OptimizeBroadcastLikePassOptions& options) const = 0;
+  virtual void SetOptions(DenseToSparsePassOptions& options) const = 0;
 };
 }  // namespace TFL
 }  // namespace mlir
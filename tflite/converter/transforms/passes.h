@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_COMPILER_MLIR_LITE_TRANSFORMS_PASSES_H_
 #define TENSORFLOW_COMPILER_MLIR_LITE_TRANSFORMS_PASSES_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -25,6 +26,8 @@ limitations under the License.
 #include "tflite/converter/quantization/common/quantization_lib/quantization_config.h"
 #include "tflite/converter/transforms/canonicalize_boundary_value_pass.h"
 #include "tflite/converter/transforms/cleanup_optimization_barrier_pass.h"
+#include "tflite/converter/transforms/dense_to_sparse_pass.h"
+#include "tflite/converter/transforms/dense_to_sparse_pass_options.h"
 #include "tflite/converter/transforms/optimize_batch_matmul_pass.h"
 #include "tflite/converter/transforms/optimize_broadcast_like_pass.h"
 #include "tflite/converter/transforms/optimize_broadcast_like_pass_options.h"
@@ -164,9 +167,20 @@ std::unique_ptr<OperationPass<ModuleOp>> CreatePrepareQuantizeVariablesPass();
 std::unique_ptr<OperationPass<func::FuncOp>>
 CreateDecomposeHybridQuantizationPass();
 
+// Creates a pass that bounds the size of the constants that folding TFL ops
+// creates to `budget_bytes` per op, and reports the folded bytes.
+std::unique_ptr<OperationPass<ModuleOp>> CreateConstantFoldingBudgetPass(
+    int64_t budget_bytes = 1 << 16);
+
 // Creates an instance of the TensorFlow Lite optimize op order pass.
 std::unique_ptr<OperationPass<func::FuncOp>> CreateOptimizeOpOrderPass();
 
+// Creates a pass that reorders operations to reduce the peak memory of the
+// activations. Switching between Flex delegated and builtin operations costs
+// `locality_penalty` bytes.
+std::unique_ptr<OperationPass<func::FuncOp>> CreateMinimizePeakMemoryPass(
+    int64_t locality_penalty = 0);
+
 // Creates an instance of the TensorFlow Lite dialect TrimFunctions
 // pass.
 std::unique_ptr<OperationPass<ModuleOp>> CreateTrimFunctionsPass();
@@ -245,6 +259,13 @@ std::unique_ptr<OperationPass<func::FuncOp>> CreateLegalizeJaxRandomPass();
 // TensorFlow Lite variables.
 std::unique_ptr<OperationPass<ModuleOp>> CreateLegalizeVariablesPass();
 
+// Creates a pass which converts the inputs and outputs that carry state from
+// one call of a signature to the next, such as a KV cache, into TensorFlow
+// Lite variables. Only the inputs and outputs in `state_names` are converted,
+// or all the detected ones if it is empty.
+std::unique_ptr<OperationPass<ModuleOp>> CreateLiftStateToVariablesPass(
+    llvm::ArrayRef<std::string> state_names = {});
+
 // Creates a pass which analyze the model whether it is safe to use
 // native TFLite variables or not.
 inline std::unique_ptr<mlir::Pass> CreateAnalyzeVariablesPass() {
@@ -359,6 +380,7 @@ inline void registerTensorFlowLitePasses() {
   Register<CanonicalizeBoundaryValuePass>();
 
   // Other TFLite Passes
+  Register<DenseToSparsePass, DenseToSparsePassOptions>();
   Register<UnfoldLargeSplatConstantPass>();
   Register<SplitMergedOperandsPass>();
   Register<CleanupOptimizationBarrierPass>();
@@ -0,0 +1,93 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/core/inter_op_thread_pool.h"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>  // NOLINT(build/c++11)
+
+namespace tflite {
+
+InterOpThreadPool::InterOpThreadPool(int num_threads) {
+  for (int i = 1; i < num_threads; ++i) {
+    threads_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+InterOpThreadPool::~InterOpThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_available_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void InterOpThreadPool::ParallelFor(int num_tasks,
+                                    const std::function<void(int)>& task) {
+  if (num_tasks <= 0) {
+    return;
+  }
+  if (threads_.empty() || num_tasks == 1) {
+    for (int i = 0; i < num_tasks; ++i) {
+      task(i);
+    }
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    num_tasks_ = num_tasks;
+    next_task_.store(0, std::memory_order_relaxed);
+    num_busy_workers_ = threads_.size();
+    ++generation_;
+  }
+  work_available_.notify_all();
+  RunTasks();
+  std::unique_lock<std::mutex> lock(mutex_);
+  work_done_.wait(lock, [this] { return num_busy_workers_ == 0; });
+  task_ = nullptr;
+}
+
+void InterOpThreadPool::RunTasks() {
+  for (int i = next_task_.fetch_add(1, std::memory_order_relaxed);
+       i < num_tasks_; i = next_task_.fetch_add(1, std::memory_order_relaxed)) {
+    (*task_)(i);
+  }
+}
+
+void InterOpThreadPool::WorkerLoop() {
+  uint64_t generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_available_.wait(
+          lock, [&] { return stop_ || generation_ != generation; });
+      if (stop_) {
+        return;
+      }
+      generation = generation_;
+    }
+    RunTasks();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--num_busy_workers_ == 0) {
+      work_done_.notify_one();
+    }
+  }
+}
+
+}  // namespace tflite
@@ -0,0 +1,81 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_CORE_INTER_OP_THREAD_POOL_H_
+#define TENSORFLOW_LITE_CORE_INTER_OP_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <cstdint>
+#include <functional>
+#include <mutex>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+namespace tflite {
+
+// A pool of threads running the independent nodes of a subgraph at the same
+// time.
+//
+// The threads take the tasks of a `ParallelFor()` one at a time, in order,
+// from a shared counter, so that the threads done with short nodes take over
+// the remaining ones instead of waiting.
+//
+// WARNING: This is an experimental API and subject to change.
+class InterOpThreadPool {
+ public:
+  // Creates `num_threads - 1` threads, the thread calling `ParallelFor()`
+  // being the last one.
+  explicit InterOpThreadPool(int num_threads);
+  ~InterOpThreadPool();
+  InterOpThreadPool(const InterOpThreadPool&) = delete;
+  InterOpThreadPool& operator=(const InterOpThreadPool&) = delete;
+
+  // Returns the number of threads, including the calling thread.
+  int num_threads() const { return threads_.size() + 1; }
+
+  // Calls `task(i)` for each i in [0, num_tasks), on the threads of the pool
+  // and the calling thread, and returns once all the calls returned. It must
+  // not be called from the tasks.
+  void ParallelFor(int num_tasks, const std::function<void(int)>& task);
+
+ private:
+  // Runs the tasks of the current ParallelFor() until there are none left.
+  void RunTasks();
+
+  void WorkerLoop();
+
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  // Signaled when a ParallelFor() starts, or the pool stops.
+  std::condition_variable work_available_;
+  // Signaled when the last worker is done with the tasks.
+  std::condition_variable work_done_;
+  // Incremented by each ParallelFor(), for the workers to tell when there
+  // are new tasks.
+  uint64_t generation_ = 0;
+  // Number of workers yet to finish the tasks of the current generation.
+  int num_busy_workers_ = 0;
+  bool stop_ = false;
+
+  // The tasks of the current ParallelFor().
+  const std::function<void(int)>* task_ = nullptr;
+  int num_tasks_ = 0;
+  std::atomic<int> next_task_{0};
+};
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_CORE_INTER_OP_THREAD_POOL_H_
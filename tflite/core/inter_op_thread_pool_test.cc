@@ -0,0 +1,63 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/core/inter_op_thread_pool.h"
+
+#include <atomic>
+#include <set>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace tflite {
+namespace {
+
+TEST(InterOpThreadPoolTest, RunsEachTaskOnce) {
+  InterOpThreadPool pool(4);
+  EXPECT_EQ(pool.num_threads(), 4);
+  for (const int num_tasks : {0, 1, 3, 4, 100}) {
+    std::vector<std::atomic<int>> counts(num_tasks);
+    pool.ParallelFor(num_tasks, [&](int i) { ++counts[i]; });
+    for (const auto& count : counts) {
+      EXPECT_EQ(count, 1);
+    }
+  }
+}
+
+TEST(InterOpThreadPoolTest, RunsTasksAtTheSameTime) {
+  InterOpThreadPool pool(2);
+  // Each task waits for the other, so they only complete if they run on
+  // different threads.
+  std::atomic<int> num_started{0};
+  pool.ParallelFor(2, [&](int i) {
+    ++num_started;
+    while (num_started < 2) {
+      std::this_thread::yield();
+    }
+  });
+  EXPECT_EQ(num_started, 2);
+}
+
+TEST(InterOpThreadPoolTest, SingleThread) {
+  InterOpThreadPool pool(1);
+  EXPECT_EQ(pool.num_threads(), 1);
+  std::set<std::thread::id> thread_ids;
+  pool.ParallelFor(
+      3, [&](int i) { thread_ids.insert(std::this_thread::get_id()); });
+  EXPECT_EQ(thread_ids, std::set<std::thread::id>{std::this_thread::get_id()});
+}
+
+}  // namespace
+}  // namespace tflite
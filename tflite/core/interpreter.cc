@@ -27,6 +27,7 @@ limitations under the License.
 #include <vector>
 
 #include "ruy/denormal.h"  // from @ruy
+#include "tflite/arena_plan.h"
 #include "tflite/converter/allocation.h"
 #include "tflite/converter/experimental/remat/metadata_util.h"
 #include "tflite/core/api/error_reporter.h"
@@ -442,12 +443,24 @@ TfLiteStatus Interpreter::SetMetadata(
           &model_control_dependencies_)) {
     model_control_dependencies_.clear();
   }
+  const auto maybe_model_arena_plan =
+      metadata_.find(kModelArenaPlanMetadataKey);
+  if (maybe_model_arena_plan == metadata_.end() ||
+      !ParseModelArenaPlan(maybe_model_arena_plan->second.data(),
+                           maybe_model_arena_plan->second.size(),
+                           &model_arena_plan_) ||
+      model_arena_plan_.size() != subgraphs_.size()) {
+    model_arena_plan_.clear();
+  }
   for (int subgraph_index = 0; subgraph_index < subgraphs_.size();
        ++subgraph_index) {
     TF_LITE_ENSURE_STATUS(subgraphs_[subgraph_index]->SetMetadata(
-        &metadata_, model_control_dependencies_.empty()
-                        ? nullptr
-                        : &model_control_dependencies_[subgraph_index]));
+        &metadata_,
+        model_control_dependencies_.empty()
+            ? nullptr
+            : &model_control_dependencies_[subgraph_index],
+        model_arena_plan_.empty() ? nullptr
+                                  : &model_arena_plan_[subgraph_index]));
   }
   return kTfLiteOk;
 }
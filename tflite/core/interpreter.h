@@ -43,6 +43,7 @@ limitations under the License.
 #include "tflite/converter/allocation.h"
 #include "tflite/converter/experimental/remat/metadata_util.h"
 #include "tflite/allocation.h"
+#include "tflite/arena_plan.h"
 #include "tflite/core/api/error_reporter.h"
 #include "tflite/core/api/profiler.h"
 #include "tflite/core/async/async_signature_runner.h"
@@ -1101,6 +1102,12 @@ class Interpreter {
   // checks when dereferencing by subgraph and operator index) will take place.
   ModelControlDependencies model_control_dependencies_;
 
+  // Stores the arena plans that are cached in the metadata of the model.
+  // Updated in SetMetadata; model_arena_plan_.empty() means that there was no
+  // plan in the metadata, or that we were unable to parse it. The plan of each
+  // subgraph is checked against its tensors before it is used.
+  ModelArenaPlan model_arena_plan_;
+
   // Flag indicating whether to continue or cancel in flight invocation.
   // If false, the in flight invocation will be cancelled.
   // Will be set true when application starts a new invocation.
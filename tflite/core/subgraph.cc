@@ -17,11 +17,13 @@ limitations under the License.
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
 #include <cstdarg>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <numeric>
@@ -31,6 +33,13 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#if defined(__APPLE__) || defined(__linux__) || defined(__Fuchsia__)
+#include <unistd.h>
+#endif
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
 #include "tflite/converter/allocation.h"
 #include "tflite/array.h"
 #include "tflite/builtin_ops.h"
@@ -43,6 +52,7 @@ limitations under the License.
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/c_api_types.h"
 #include "tflite/core/c/common.h"
+#include "tflite/core/inter_op_thread_pool.h"
 #include "tflite/experimental/resource/initialization_status.h"
 #include "tflite/experimental/resource/resource_base.h"
 #include "tflite/graph_info.h"
@@ -56,6 +66,7 @@ limitations under the License.
 #include "tflite/simple_planner.h"
 #else
 #include "tflite/arena_planner.h"
+#include "tflite/simple_memory_arena.h"
 #endif
 #ifdef TF_LITE_TENSORFLOW_PROFILER
 #include "tflite/tensorflow_profiler_logger.h"
@@ -200,6 +211,64 @@ TfLiteStatus VerifyCustomAllocationForTensor(
   return kTfLiteOk;
 }
 
+// Returns the subgraphs called by `node`, which only run while it runs. Sets
+// `exclusive` if at most one of them runs at a time.
+std::vector<int> GetCalledSubgraphs(const TfLiteNode& node,
+                                    const TfLiteRegistration& registration,
+                                    bool* exclusive) {
+  *exclusive = false;
+  if (node.builtin_data == nullptr) {
+    return {};
+  }
+  switch (registration.builtin_code) {
+    case kTfLiteBuiltinWhile: {
+      // The condition and the body are alive at the same time.
+      const auto* params =
+          reinterpret_cast<const TfLiteWhileParams*>(node.builtin_data);
+      return {params->cond_subgraph_index, params->body_subgraph_index};
+    }
+    case kTfLiteBuiltinIf: {
+      const auto* params =
+          reinterpret_cast<const TfLiteIfParams*>(node.builtin_data);
+      *exclusive = true;
+      return {params->then_subgraph_index, params->else_subgraph_index};
+    }
+    case kTfLiteBuiltinStablehloCase: {
+      const auto* params =
+          reinterpret_cast<const TfLiteStablehloCaseParams*>(node.builtin_data);
+      *exclusive = true;
+      const uint32_t num_branches =
+          std::min<uint32_t>(params->num_branches,
+                             TFLITE_STABLEHLO_CASE_PARAMS_MAX_BRANCHES_COUNT);
+      return std::vector<int>(params->branch_subgraph_indices,
+                              params->branch_subgraph_indices + num_branches);
+    }
+    default:
+      return {};
+  }
+}
+
+#ifndef TFLITE_USE_SIMPLE_MEMORY_PLANNER
+// Returns how the memory of the arenas is backed with `options`.
+ArenaBufferOptions GetArenaBufferOptions(const InterpreterOptions& options) {
+  ArenaBufferOptions buffer_options;
+  switch (options.GetArenaHugePages()) {
+    case InterpreterOptions::ArenaHugePages::kNone:
+      buffer_options.huge_pages = ArenaBufferOptions::HugePages::kNone;
+      break;
+    case InterpreterOptions::ArenaHugePages::kTransparent:
+      buffer_options.huge_pages = ArenaBufferOptions::HugePages::kTransparent;
+      break;
+    case InterpreterOptions::ArenaHugePages::kExplicit:
+      buffer_options.huge_pages = ArenaBufferOptions::HugePages::kExplicit;
+      break;
+  }
+  buffer_options.numa_node = options.GetArenaNumaNode();
+  buffer_options.prefault = options.GetArenaPrefault();
+  return buffer_options;
+}
+#endif  // TFLITE_USE_SIMPLE_MEMORY_PLANNER
+
 }  // namespace
 
 // A trivial implementation of GraphInfo around the Interpreter.
@@ -854,9 +923,13 @@ TfLiteStatus Subgraph::SetVariables(std::vector<int> variables) {
 
 TfLiteStatus Subgraph::SetMetadata(
     const std::map<std::string, std::string>* metadata,
-    const ControlEdges* control_edges) {
+    const ControlEdges* control_edges, const SubgraphArenaPlan* arena_plan) {
   metadata_ = metadata;
   control_edges_ = control_edges;
+  arena_plan_ = arena_plan;
+  if (memory_planner_) {
+    memory_planner_->SetArenaPlan(arena_plan_);
+  }
   return kTfLiteOk;
 }
 
@@ -998,15 +1071,21 @@ TfLiteStatus Subgraph::AllocateTensors(InliningStrategy auto_inline) {
   }
 
   // The runtime doesn't need to adjust any allocations if the state is
-  // invokable & no inputs are dynamic (which implies memory plan is unchanged).
+  // invokable & no inputs are dynamic (which implies memory plan is unchanged),
+  // or if nothing the nodes were prepared for changed since.
   const bool no_reallocations_necessary =
-      state_ != kStateUninvokable &&
-      !HasDynamicTensorImpl(context_, inputs(), &dynamic_tensor_index_);
+      (state_ != kStateUninvokable &&
+       !HasDynamicTensorImpl(context_, inputs(), &dynamic_tensor_index_)) ||
+      (ops_prepared_ && memory_planner_ && !HasUnallocatedPersistentInput() &&
+       GetPreparedFingerprint() == prepared_fingerprint_);
   if (no_reallocations_necessary) {
-    // If non-persistent memory was released, re-allocate it.
-    if (memory_planner_ && !memory_planner_->HasNonPersistentMemory()) {
-      memory_planner_->AcquireNonPersistentMemory();
+    // If non-persistent memory was released, or inputs were resized, which
+    // resets their data, re-allocate it.
+    if (memory_planner_ && (state_ == kStateUninvokable ||
+                            !memory_planner_->HasNonPersistentMemory())) {
+      TF_LITE_ENSURE_STATUS(memory_planner_->AcquireNonPersistentMemory());
     }
+    state_ = kStateInvokable;
     // Check custom allocations, which may have been modified since last
     // AllocateTensors() call.
     if (!custom_allocations_.empty()) {
@@ -1028,13 +1107,21 @@ TfLiteStatus Subgraph::AllocateTensors(InliningStrategy auto_inline) {
   next_execution_plan_index_to_prepare_ = 0;
   next_execution_plan_index_to_plan_allocation_ = 0;
   next_original_execution_plan_index_to_prepare_ = 0;
+  TF_LITE_ENSURE_STATUS(ScheduleNodeLevels());
+  CreateWeightStreamer();
   if (memory_planner_) {
     TF_LITE_ENSURE_STATUS(memory_planner_->ResetAllocations());
   }
 
+  ops_prepared_ = false;
   TF_LITE_ENSURE_STATUS(PrepareOpsAndTensors());
 
   state_ = kStateInvokable;
+  if (next_execution_plan_index_to_prepare_ >= execution_plan_.size() &&
+      !has_dynamic_tensors_) {
+    ops_prepared_ = true;
+    prepared_fingerprint_ = GetPreparedFingerprint();
+  }
 
   // Reset the variable tensors to zero after (re)allocating the tensors.
   // Developers shouldn't rely on the side effect of this function to reset
@@ -1104,6 +1191,7 @@ TfLiteStatus Subgraph::AddNodeWithParameters(
     return kTfLiteError;
   }
   state_ = kStateUninvokable;
+  ops_prepared_ = false;
 
   TF_LITE_ENSURE_OK(&context_, CheckTensorIndices("node inputs", inputs.data(),
                                                   inputs.size()));
@@ -1285,6 +1373,7 @@ TfLiteStatus Subgraph::ReleaseNonPersistentMemory() {
 
 TfLiteStatus Subgraph::ReleaseMemory() {
   state_ = kStateUninvokable;
+  ops_prepared_ = false;
   ReleaseNonPersistentMemory();
 
   // Free dynamic input tensors.
@@ -1560,6 +1649,14 @@ TfLiteStatus Subgraph::PrepareOpsStartingAt(
 }
 
 TfLiteStatus Subgraph::PrepareOpsAndTensors() {
+  TFLITE_SCOPED_TAGGED_DEFAULT_PROFILE(profiler_.get(), "PrepareOpsAndTensors");
+
+  // The called subgraphs of the nodes to prepare are planned again before the
+  // memory of this subgraph is, so they can't use it in the meantime.
+  if (ShouldShareSubgraphArenas()) {
+    UnshareCalledSubgraphArenas(next_execution_plan_index_to_prepare_);
+  }
+
   // Prepare original execution plan if any applied delegate wants it.
   // If any of the delegates is immutable, this won't be triggered
   // post-delegation (since we undo/redo delegation). For all other cases, other
@@ -1593,28 +1690,51 @@ TfLiteStatus Subgraph::PrepareOpsAndTensors() {
 #ifdef TFLITE_USE_SIMPLE_MEMORY_PLANNER
     memory_planner_.reset(new SimplePlanner(&context_, CreateGraphInfo()));
 #else
-    memory_planner_ = std::make_unique<ArenaPlanner>(
+    auto arena_planner = std::make_unique<ArenaPlanner>(
         &context_, CreateGraphInfo(), ShouldPreserveAllTensors(),
         kDefaultTensorAlignment, subgraph_index_);
+    if (options_) {
+      arena_planner->SetBufferOptions(GetArenaBufferOptions(*options_));
+    }
+    memory_planner_ = std::move(arena_planner);
 #endif
+    memory_planner_->SetArenaPlan(arena_plan_);
+    memory_planner_->SetIncrementalPlanning(ShouldPlanArenaIncrementally());
+    memory_planner_->SetNodeLevels(node_levels_);
     memory_planner_->PlanAllocations();
   }
 
+  if (ShouldShareSubgraphArenas()) {
+    ReserveCalledSubgraphArenas(next_execution_plan_index_to_plan_allocation_,
+                                last_exec_plan_index_prepared);
+  }
+
   // Execute arena allocations.
   TF_LITE_ENSURE_STATUS(memory_planner_->ExecuteAllocations(
       next_execution_plan_index_to_plan_allocation_,
       last_exec_plan_index_prepared));
 
+  if (ShouldShareSubgraphArenas()) {
+    ShareCalledSubgraphArenas(next_execution_plan_index_to_plan_allocation_,
+                              last_exec_plan_index_prepared);
+  }
+
   if (!custom_allocations_.empty()) {
     // Verify custom allocations for output tensors from the ops that have just
     // been prepared. Other output tensors might be resized later.
     if (!nodes_and_registration_.empty()) {
       for (int node_idx = next_execution_plan_index_to_plan_allocation_;
            node_idx <= last_exec_plan_index_prepared; ++node_idx) {
-        TfLiteNode& node = nodes_and_registration_[node_idx].first;
+        const auto& [node, registration] = nodes_and_registration_[node_idx];
         for (int i = 0; i < node.outputs->size; ++i) {
           const int output_tensor_idx = node.outputs->data[i];
           if (output_tensor_idx == kTfLiteOptionalTensor) continue;
+          // READ_VARIABLE points the custom outputs it owns to the buffer of
+          // the variable itself.
+          if (registration.builtin_code == kTfLiteBuiltinReadVariable &&
+              custom_allocations_.count(output_tensor_idx) == 0) {
+            continue;
+          }
           TF_LITE_ENSURE_STATUS(VerifyCustomAllocationForTensor(
               context(), custom_allocations_, output_tensor_idx));
         }
@@ -1636,6 +1756,116 @@ TfLiteStatus Subgraph::PrepareOpsAndTensors() {
   return kTfLiteOk;
 }
 
+size_t Subgraph::LayoutCalledSubgraphArenas(
+    int node, std::vector<CalledSubgraphArena>* arenas) {
+  arenas->clear();
+  const auto& node_and_registration =
+      nodes_and_registration_[execution_plan_[node]];
+  bool exclusive;
+  size_t block_size = 0;
+  for (const int subgraph_index :
+       GetCalledSubgraphs(node_and_registration.first,
+                          node_and_registration.second, &exclusive)) {
+    if (subgraph_index < 0 || subgraph_index >= subgraphs_->size() ||
+        subgraph_index == subgraph_index_) {
+      continue;
+    }
+    Subgraph* subgraph = (*subgraphs_)[subgraph_index].get();
+    // Subgraphs not prepared yet keep an arena of their own, and so do those
+    // with several callers, which could each place them elsewhere.
+    if (!subgraph->memory_planner_ ||
+        CountSubgraphCallers(subgraph_index) != 1 ||
+        std::any_of(arenas->begin(), arenas->end(),
+                    [subgraph](const CalledSubgraphArena& arena) {
+                      return arena.subgraph == subgraph;
+                    })) {
+      continue;
+    }
+    const size_t size =
+        (subgraph->memory_planner_->GetNonPersistentMemorySize() +
+         kDefaultTensorAlignment - 1) /
+        kDefaultTensorAlignment * kDefaultTensorAlignment;
+    if (size == 0) {
+      continue;
+    }
+    if (exclusive) {
+      // Only one of them runs at a time, so they all start at the beginning.
+      arenas->push_back({subgraph, 0, size});
+      block_size = std::max(block_size, size);
+    } else {
+      arenas->push_back({subgraph, block_size, size});
+      block_size += size;
+    }
+  }
+  return block_size;
+}
+
+int Subgraph::CountSubgraphCallers(int subgraph_index) const {
+  int num_callers = 0;
+  for (const auto& subgraph : *subgraphs_) {
+    for (const int node_index : subgraph->execution_plan_) {
+      const auto& node_and_registration =
+          subgraph->nodes_and_registration_[node_index];
+      bool exclusive;
+      const std::vector<int> called_subgraphs =
+          GetCalledSubgraphs(node_and_registration.first,
+                             node_and_registration.second, &exclusive);
+      if (std::find(called_subgraphs.begin(), called_subgraphs.end(),
+                    subgraph_index) != called_subgraphs.end()) {
+        ++num_callers;
+      }
+    }
+  }
+  return num_callers;
+}
+
+void Subgraph::ReserveCalledSubgraphArenas(int first_node, int last_node) {
+  std::vector<CalledSubgraphArena> arenas;
+  for (int i = first_node;
+       i <= last_node && i < static_cast<int>(execution_plan_.size()); ++i) {
+    if (!memory_planner_->ReserveNodeMemory(
+            i, LayoutCalledSubgraphArenas(i, &arenas))) {
+      // Not supported by the memory planner.
+      return;
+    }
+  }
+}
+
+void Subgraph::ShareCalledSubgraphArenas(int first_node, int last_node) {
+  std::vector<CalledSubgraphArena> arenas;
+  for (int i = first_node;
+       i <= last_node && i < static_cast<int>(execution_plan_.size()); ++i) {
+    LayoutCalledSubgraphArenas(i, &arenas);
+    for (const auto& arena : arenas) {
+      arena.subgraph->memory_planner_->ShareNodeMemory(
+          memory_planner_.get(), i, arena.offset, arena.size);
+      // Drop the memory of its own. The control flow ops allocate the tensors
+      // of the subgraph before running it, which places them in the shared
+      // memory.
+      arena.subgraph->ReleaseNonPersistentMemory();
+    }
+  }
+}
+
+void Subgraph::UnshareCalledSubgraphArenas(int first_node) {
+  for (int i = first_node; i < static_cast<int>(execution_plan_.size()); ++i) {
+    const auto& node_and_registration =
+        nodes_and_registration_[execution_plan_[i]];
+    bool exclusive;
+    for (const int subgraph_index :
+         GetCalledSubgraphs(node_and_registration.first,
+                            node_and_registration.second, &exclusive)) {
+      if (subgraph_index < 0 || subgraph_index >= subgraphs_->size()) {
+        continue;
+      }
+      Subgraph* subgraph = (*subgraphs_)[subgraph_index].get();
+      if (subgraph->memory_planner_) {
+        subgraph->memory_planner_->ShareNodeMemory(nullptr, -1, 0, 0);
+      }
+    }
+  }
+}
+
 TfLiteStatus Subgraph::RemoveUnusedInputs() {
   std::vector<int> input_tensors_count = GetInputTensorsCount();
   // Mark unused inputs as kTfLiteOptionalTensor.
@@ -1649,6 +1879,79 @@ TfLiteStatus Subgraph::RemoveUnusedInputs() {
   return kTfLiteOk;
 }
 
+bool Subgraph::HasUnallocatedPersistentInput() const {
+  for (const int tensor_index : inputs_) {
+    if (tensor_index == kTfLiteOptionalTensor) continue;
+    const TfLiteTensor& tensor = context_.tensors[tensor_index];
+    if (tensor.allocation_type == kTfLiteArenaRwPersistent &&
+        tensor.data.raw == nullptr) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<int64_t> Subgraph::GetPreparedFingerprint() const {
+  std::vector<int64_t> fingerprint;
+  for (const int tensor_index : inputs_) {
+    if (tensor_index == kTfLiteOptionalTensor) continue;
+    const TfLiteTensor& tensor = context_.tensors[tensor_index];
+    fingerprint.push_back(tensor_index);
+    fingerprint.push_back(tensor.type);
+    fingerprint.push_back(tensor.allocation_type);
+    fingerprint.push_back(tensor.bytes);
+    const int rank = tensor.dims ? tensor.dims->size : -1;
+    fingerprint.push_back(rank);
+    for (int i = 0; i < rank; ++i) {
+      fingerprint.push_back(tensor.dims->data[i]);
+    }
+  }
+  for (const auto& idx_and_alloc : custom_allocations_) {
+    fingerprint.push_back(idx_and_alloc.first);
+    fingerprint.push_back(
+        reinterpret_cast<intptr_t>(idx_and_alloc.second.data));
+    fingerprint.push_back(idx_and_alloc.second.bytes);
+  }
+  return fingerprint;
+}
+
+TfLiteStatus Subgraph::EnsureNodeInputsAreReadable(
+    const TfLiteNode& node, const TfLiteRegistration& registration) {
+  for (int i = 0; i < node.inputs->size; ++i) {
+    int tensor_index = node.inputs->data[i];
+    if (tensor_index == kTfLiteOptionalTensor) {
+      continue;
+    }
+    TfLiteTensor* tensor = &tensors_[tensor_index];
+    if (tensor->delegate && tensor->delegate != node.delegate &&
+        tensor->data_is_stale) {
+      TF_LITE_ENSURE_STATUS(EnsureTensorDataIsReadable(tensor_index));
+    }
+    if (tensor->data.raw == nullptr && tensor->bytes > 0 &&
+        tensor->allocation_type != kTfLiteNonCpu) {
+      if (registration.builtin_code == kTfLiteBuiltinReshape && i == 1 &&
+          tensor->dims->size != 1) {
+        // In general, having a tensor here with no buffer will be an error.
+        // However, for the reshape operator, the second input tensor is
+        // sometimes only used for the shape, not for the data. Thus, null
+        // buffer is ok in this situation.
+        // The situation where null buffer is not ok for reshape operator is
+        // only when there are 2 inputs given to the node and the one
+        // corresponding to the shape (i == 1) is a vector that contains all
+        // dimensions. See `GetOutputShape()` function in
+        // `tensorflow/lite/kernels/reshape.cc`
+        continue;
+      } else {
+        // In all other cases, we need to return an error as otherwise we will
+        // trigger a null pointer dereference (likely).
+        ReportError("Input tensor %d lacks data", tensor_index);
+        return kTfLiteError;
+      }
+    }
+  }
+  return kTfLiteOk;
+}
+
 TfLiteStatus Subgraph::Invoke() {
   auto status = InvokeImpl();
   telemetry::TelemetryReportEvent(&context_, "Invoke", status);
@@ -1669,6 +1972,9 @@ TfLiteStatus Subgraph::InvokeImpl() {
     return kTfLiteError;
   }
   TFLITE_SCOPED_TAGGED_DEFAULT_PROFILE(profiler_.get(), "Invoke");
+  if (CanInvokeNodeLevels()) {
+    return InvokeNodeLevels();
+  }
 #ifdef TF_LITE_TENSORFLOW_PROFILER
   tensorflow::profiler::TraceMe* trace_subgraph =
       tflite::OnTfLiteSubgraphInvoke(name_.c_str(), subgraph_index_);
@@ -1708,38 +2014,7 @@ TfLiteStatus Subgraph::InvokeImpl() {
     TFLITE_SCOPED_TAGGED_OPERATOR_PROFILE(
         profile_op ? profiler_.get() : nullptr, op_name, node_index);
 
-    for (int i = 0; i < node.inputs->size; ++i) {
-      int tensor_index = node.inputs->data[i];
-      if (tensor_index == kTfLiteOptionalTensor) {
-        continue;
-      }
-      TfLiteTensor* tensor = &tensors_[tensor_index];
-      if (tensor->delegate && tensor->delegate != node.delegate &&
-          tensor->data_is_stale) {
-        TF_LITE_ENSURE_STATUS(EnsureTensorDataIsReadable(tensor_index));
-      }
-      if (tensor->data.raw == nullptr && tensor->bytes > 0 &&
-          tensor->allocation_type != kTfLiteNonCpu) {
-        if (registration.builtin_code == kTfLiteBuiltinReshape && i == 1 &&
-            tensor->dims->size != 1) {
-          // In general, having a tensor here with no buffer will be an error.
-          // However, for the reshape operator, the second input tensor is
-          // sometimes only used for the shape, not for the data. Thus, null
-          // buffer is ok in this situation.
-          // The situation where null buffer is not ok for reshape operator is
-          // only when there are 2 inputs given to the node and the one
-          // corresponding to the shape (i == 1) is a vector that contains all
-          // dimensions. See `GetOutputShape()` function in
-          // `tensorflow/lite/kernels/reshape.cc`
-          continue;
-        } else {
-          // In all other cases, we need to return an error as otherwise we will
-          // trigger a null pointer dereference (likely).
-          ReportError("Input tensor %d lacks data", tensor_index);
-          return kTfLiteError;
-        }
-      }
-    }
+    TF_LITE_ENSURE_STATUS(EnsureNodeInputsAreReadable(node, registration));
     // Allocate dynamic tensors which memory is required to be allocated
     // before executing the node.
     MayAllocateOpOutput(&node);
@@ -1758,11 +2033,35 @@ TfLiteStatus Subgraph::InvokeImpl() {
 
     EnsureTensorsVectorCapacity();
     tensor_resized_since_op_invoke_ = false;
+    if (weight_streamer_) weight_streamer_->BeforeStep(execution_plan_index);
+#if defined(__linux__)
+    // The major page faults of the op, e.g. on the weights of a memory mapped
+    // model, are reported with the duration of the op they stalled.
+    struct rusage usage_before = {};
+    const bool count_page_faults =
+        profiler_ && getrusage(RUSAGE_THREAD, &usage_before) == 0;
+    const auto op_start = std::chrono::steady_clock::now();
+#endif
     if (auto s = OpInvoke(registration, &node); s != kTfLiteOk) {
       auto err = ReportOpError(&context_, node, registration, node_index,
                                "failed to invoke");
       return s == kTfLiteCancelled ? s : err;
     }
+#if defined(__linux__)
+    struct rusage usage_after;
+    if (count_page_faults && getrusage(RUSAGE_THREAD, &usage_after) == 0 &&
+        usage_after.ru_majflt > usage_before.ru_majflt) {
+      const auto op_duration =
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - op_start);
+      profiler_->AddEvent(
+          "PageFaults",
+          Profiler::EventType::GENERAL_RUNTIME_INSTRUMENTATION_EVENT,
+          op_duration.count(), usage_after.ru_majflt - usage_before.ru_majflt,
+          /*event_metadata2=*/0);
+    }
+#endif
+    if (weight_streamer_) weight_streamer_->AfterStep(execution_plan_index);
 
     // Force execution prep for downstream ops if the latest op triggered the
     // resize of a dynamic tensor.
@@ -1796,6 +2095,236 @@ TfLiteStatus Subgraph::InvokeImpl() {
   return status;
 }
 
+namespace {
+
+// Returns true if the kernels of the builtin op keep no state outside of their
+// node and tensors while they run, so that several of them can run at the same
+// time. The ops whose kernels use the CPU backend context are not, as it is
+// created lazily and its thread pool is not thread-safe. Besides the
+// convolutions, this rules out SOFTMAX, TRANSPOSE, GATHER, QUANTIZE,
+// DEQUANTIZE and CAST.
+bool IsBuiltinSafeToRunConcurrently(int builtin_code) {
+  switch (builtin_code) {
+    case kTfLiteBuiltinAbs:
+    case kTfLiteBuiltinAdd:
+    case kTfLiteBuiltinAveragePool2d:
+    case kTfLiteBuiltinConcatenation:
+    case kTfLiteBuiltinDiv:
+    case kTfLiteBuiltinExp:
+    case kTfLiteBuiltinExpandDims:
+    case kTfLiteBuiltinHardSwish:
+    case kTfLiteBuiltinLogistic:
+    case kTfLiteBuiltinMaxPool2d:
+    case kTfLiteBuiltinMaximum:
+    case kTfLiteBuiltinMinimum:
+    case kTfLiteBuiltinMul:
+    case kTfLiteBuiltinNeg:
+    case kTfLiteBuiltinPad:
+    case kTfLiteBuiltinPadv2:
+    case kTfLiteBuiltinRelu:
+    case kTfLiteBuiltinRelu6:
+    case kTfLiteBuiltinReluN1To1:
+    case kTfLiteBuiltinReshape:
+    case kTfLiteBuiltinRsqrt:
+    case kTfLiteBuiltinSlice:
+    case kTfLiteBuiltinSqrt:
+    case kTfLiteBuiltinSquare:
+    case kTfLiteBuiltinSquaredDifference:
+    case kTfLiteBuiltinSqueeze:
+    case kTfLiteBuiltinStridedSlice:
+    case kTfLiteBuiltinSub:
+    case kTfLiteBuiltinTanh:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+bool Subgraph::CanRunConcurrently(int node_index) const {
+  const auto& [node, registration] = nodes_and_registration_[node_index];
+  if (node.delegate != nullptr || node.might_have_side_effect ||
+      registration.custom_name != nullptr ||
+      registration.registration_external != nullptr ||
+      !IsBuiltinSafeToRunConcurrently(registration.builtin_code)) {
+    return false;
+  }
+  for (const TfLiteIntArray* tensor_indices : {node.inputs, node.outputs}) {
+    for (const int tensor_index : TfLiteIntArrayView(tensor_indices)) {
+      if (tensor_index == kTfLiteOptionalTensor) continue;
+      const TfLiteTensor& tensor = tensors_[tensor_index];
+      if (tensor.is_variable || tensor.type == kTfLiteResource ||
+          tensor.type == kTfLiteVariant || tensor.type == kTfLiteString) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+TfLiteStatus Subgraph::ScheduleNodeLevels() {
+  if (!ShouldRunNodesConcurrently()) {
+    return kTfLiteOk;
+  }
+  const int num_nodes = execution_plan_.size();
+  const int num_total_nodes = nodes_and_registration_.size();
+  std::vector<bool> exclusive(num_nodes);
+  std::vector<int> execution_plan_indices(num_total_nodes, -1);
+  for (int i = 0; i < num_nodes; ++i) {
+    exclusive[i] = !CanRunConcurrently(execution_plan_[i]);
+    execution_plan_indices[execution_plan_[i]] = i;
+  }
+  // The control edges are between node indices.
+  ControlEdges control_edges;
+  if (control_edges_ != nullptr) {
+    for (const auto& [from, to] : *control_edges_) {
+      if (from < 0 || from >= num_total_nodes || to < 0 ||
+          to >= num_total_nodes || execution_plan_indices[from] == -1 ||
+          execution_plan_indices[to] == -1) {
+        continue;
+      }
+      control_edges.emplace_back(execution_plan_indices[from],
+                                 execution_plan_indices[to]);
+    }
+  }
+  const InterpreterInfo info(this);
+  std::vector<int> levels;
+  const int num_levels =
+      AssignNodeLevels(&info, exclusive, control_edges, &levels);
+
+  std::vector<int> execution_plan = execution_plan_;
+  std::vector<int> node_levels;
+  if (num_levels < num_nodes) {
+    // Each node only depends on nodes of lower levels, so the execution plan
+    // stays in dependency order.
+    std::vector<int> order(num_nodes);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](int a, int b) { return levels[a] < levels[b]; });
+    node_levels.reserve(num_nodes);
+    for (int i = 0; i < num_nodes; ++i) {
+      execution_plan[i] = execution_plan_[order[i]];
+      node_levels.push_back(levels[order[i]]);
+    }
+  }
+  if (execution_plan != execution_plan_ || node_levels != node_levels_) {
+    execution_plan_ = std::move(execution_plan);
+    node_levels_ = std::move(node_levels);
+    if (memory_planner_) {
+      memory_planner_->SetNodeLevels(node_levels_);
+      TF_LITE_ENSURE_STATUS(memory_planner_->PlanAllocations());
+    }
+  }
+  return kTfLiteOk;
+}
+
+void Subgraph::CreateWeightStreamer() {
+  weight_streamer_.reset();
+#if defined(__APPLE__) || defined(__linux__) || defined(__Fuchsia__)
+  if (!options_ || !options_->GetWeightStreaming() || !allocation_ ||
+      allocation_->type() != Allocation::Type::kMMap) {
+    return;
+  }
+  const auto* mmap_allocation = static_cast<const MMAPAllocation*>(allocation_);
+  const char* begin = static_cast<const char*>(mmap_allocation->base());
+  const char* end = begin + mmap_allocation->bytes();
+  // The constant inputs of each node that are read from the mapping.
+  std::vector<std::vector<WeightStreamer::Weight>> step_weights(
+      execution_plan_.size());
+  for (size_t i = 0; i < execution_plan_.size(); ++i) {
+    const TfLiteNode& node = nodes_and_registration_[execution_plan_[i]].first;
+    for (int tensor_index : TfLiteIntArrayView(node.inputs)) {
+      if (tensor_index == kTfLiteOptionalTensor) continue;
+      const TfLiteTensor& t = tensors_[tensor_index];
+      const char* data = t.data.raw_const;
+      if (t.allocation_type == kTfLiteMmapRo && data >= begin &&
+          data + t.bytes <= end) {
+        step_weights[i].push_back({data, t.bytes});
+      }
+    }
+  }
+  WeightStreamer::Options streamer_options;
+  streamer_options.budget_bytes = options_->GetWeightStreamingBudget();
+  streamer_options.lookahead = options_->GetWeightStreamingLookahead();
+  weight_streamer_ = std::make_unique<WeightStreamer>(
+      step_weights, sysconf(_SC_PAGESIZE), streamer_options,
+      WeightStreamer::Madvise(mmap_allocation->map_private()));
+#endif
+}
+
+bool Subgraph::CanInvokeNodeLevels() {
+#ifdef TF_LITE_TENSORFLOW_PROFILER
+  // The traces of the nodes are per thread.
+  return false;
+#else
+  return !node_levels_.empty() &&
+         node_levels_.size() == execution_plan_.size() && !profiler_ &&
+         next_execution_plan_index_to_prepare_ >= execution_plan_.size() &&
+         !HasDynamicTensors() && memory_planner_ &&
+         memory_planner_->IsPlannedForNodeLevels() && !weight_streamer_;
+#endif  // TF_LITE_TENSORFLOW_PROFILER
+}
+
+TfLiteStatus Subgraph::InvokeNodeLevels() {
+  const int num_nodes = execution_plan_.size();
+  std::vector<TfLiteStatus> statuses;
+  for (int first = 0, last = 0; first < num_nodes; first = last + 1) {
+    last = first;
+    while (last + 1 < num_nodes &&
+           node_levels_[last + 1] == node_levels_[first]) {
+      ++last;
+    }
+    for (int i = first; i <= last; ++i) {
+      auto& [node, registration] = nodes_and_registration_[execution_plan_[i]];
+      TF_LITE_ENSURE_STATUS(EnsureNodeInputsAreReadable(node, registration));
+      MayAllocateOpOutput(&node);
+    }
+
+    if (check_cancelled_func_ != nullptr &&
+        check_cancelled_func_(cancellation_data_)) {
+      ReportError("Client requested cancel during Invoke()");
+      return kTfLiteError;
+    }
+
+    if (continue_invocation_ && !continue_invocation_->test_and_set()) {
+      // `Cancel` is called and cancellation flag is flipped.
+      ReportError("Client requested cancel during Invoke()");
+      return kTfLiteCancelled;
+    }
+
+    EnsureTensorsVectorCapacity();
+    const int num_level_nodes = last - first + 1;
+    statuses.assign(num_level_nodes, kTfLiteOk);
+    const std::function<void(int)> invoke = [&](int i) {
+      auto& [node, registration] =
+          nodes_and_registration_[execution_plan_[first + i]];
+      statuses[i] = OpInvoke(registration, &node);
+    };
+    if (num_level_nodes == 1) {
+      invoke(0);
+    } else {
+      if (!inter_op_thread_pool_) {
+        inter_op_thread_pool_ =
+            std::make_unique<InterOpThreadPool>(options_->GetInterOpThreads());
+      }
+      inter_op_thread_pool_->ParallelFor(num_level_nodes, invoke);
+    }
+
+    for (int i = first; i <= last; ++i) {
+      const int node_index = execution_plan_[i];
+      auto& [node, registration] = nodes_and_registration_[node_index];
+      if (const TfLiteStatus s = statuses[i - first]; s != kTfLiteOk) {
+        auto err = ReportOpError(&context_, node, registration, node_index,
+                                 "failed to invoke");
+        return s == kTfLiteCancelled ? s : err;
+      }
+      MaybeReleaseDynamicTensors(node, node_index);
+    }
+  }
+  return kTfLiteOk;
+}
+
 TfLiteStatus Subgraph::ResizeTensor(TfLiteContext* context,
                                     TfLiteTensor* tensor,
                                     TfLiteIntArray* new_size) {
@@ -1959,6 +2488,7 @@ TfLiteStatus Subgraph::SetTensorParametersReadOnly(
     tensor.allocation = allocation;
   } else {
     state_ = kStateUninvokable;
+    ops_prepared_ = false;
     TfLiteTensorReset(type, name, ConvertArrayToTfLiteIntArray(ndims, dims),
                       GetLegacyQuantization(quantization),
                       const_cast<char*>(buffer), bytes, kTfLiteMmapRo,
@@ -1991,6 +2521,7 @@ TfLiteStatus Subgraph::SetTensorParametersReadWrite(
         "SetTensorParametersReadWrite is disallowed when graph is immutable.");
     return kTfLiteError;
   }
+  ops_prepared_ = false;
   TF_LITE_ENSURE(&context_,
                  tensor_index < context_.tensors_size && tensor_index >= 0);
   size_t required_bytes = 0;
@@ -2036,6 +2567,7 @@ TfLiteStatus Subgraph::SetExecutionPlan(const std::vector<int>& new_plan) {
                                   node_index < nodes_and_registration_.size());
   }
   execution_plan_ = new_plan;
+  ops_prepared_ = false;
   return kTfLiteOk;
 }
 
@@ -2238,6 +2770,7 @@ TfLiteStatus Subgraph::UndoAllDelegates() {
 
   // After undoing delegates, the graph is uninvokable, but mutable.
   state_ = kStateUninvokable;
+  ops_prepared_ = false;
 
   delegates_undone_ = true;
   return kTfLiteOk;
@@ -2447,6 +2980,7 @@ void Subgraph::EnsureTensorsVectorCapacity() {
 TfLiteStatus Subgraph::EnsureMemoryAllocations() {
   if (memory_planner_) {
     state_ = kStateUninvokable;
+    ops_prepared_ = false;
     TF_LITE_ENSURE_OK(&context_, memory_planner_->PlanAllocations());
   }
   TF_LITE_ENSURE_OK(&context_,
@@ -2500,6 +3034,7 @@ TfLiteStatus Subgraph::ModifyGraphWithDelegateImpl(TfLiteDelegate* delegate) {
     // tensors.
     // Reset the state to force tensor/op reallocation.
     state_ = kStateUninvokable;
+    ops_prepared_ = false;
   } else if (!delegate_supports_dynamic_shapes) {
     // Check if graph has dynamic tensors by preparing ops.
     int last_execution_plan_index_prepared;
@@ -2540,6 +3075,7 @@ TfLiteStatus Subgraph::ModifyGraphWithDelegateImpl(TfLiteDelegate* delegate) {
     // CASE 1: Current delegate does not support dynamic shapes.
     // Reset the state to force tensor/op reallocation.
     state_ = kStateUninvokable;
+    ops_prepared_ = false;
     TF_LITE_ENSURE_STATUS(
         reset_delegation_if_not_ok(EnsureMemoryAllocations()));
     // After using a delegate which doesn't support dynamic tensors, make the
@@ -2623,6 +3159,9 @@ void Subgraph::GetMemoryAllocInfo(SubgraphAllocInfo* alloc_info) const {
   if (memory_planner_ == nullptr) return;
   memory_planner_->GetAllocInfo(&alloc_info->arena_size,
                                 &alloc_info->arena_persist_size);
+  if (ShouldShareSubgraphArenas()) {
+    alloc_info->arena_shared_size = memory_planner_->GetNodeMemorySavings();
+  }
   for (const auto& tensor : tensors_) {
     if (tensor.allocation_type == kTfLiteDynamic &&
         tensor.data.raw != nullptr) {
@@ -30,13 +30,16 @@ limitations under the License.
 
 #include "tflite/converter/allocation.h"
 #include "tflite/allocation.h"
+#include "tflite/arena_plan.h"
 #include "tflite/array.h"
 #include "tflite/c/common_internal.h"
 #include "tflite/core/api/error_reporter.h"
 #include "tflite/core/api/op_resolver.h"
 #include "tflite/core/api/profiler.h"
 #include "tflite/core/c/common.h"
+#include "tflite/core/inter_op_thread_pool.h"
 #include "tflite/core/macros.h"
+#include "tflite/core/weight_streamer.h"
 #include "tflite/experimental/resource/initialization_status.h"
 #include "tflite/experimental/resource/resource_base.h"
 #include "tflite/graph_info.h"
@@ -457,12 +460,23 @@ class Subgraph {
     size_t arena_persist_size;
     size_t dynamic_size;
     size_t resource_size;
+    // Bytes of the arenas of the called subgraphs which are planned into the
+    // arena of this subgraph without growing it. Only set when subgraph arenas
+    // are shared.
+    size_t arena_shared_size;
   } SubgraphAllocInfo;
 
   // WARNING: This is an experimental API and subject to change.
   // Returns memory allocation status.
   void GetMemoryAllocInfo(SubgraphAllocInfo* alloc_info) const;
 
+  // WARNING: This is an experimental API and subject to change.
+  // Exports the placement of the arena tensors of the current plan, to cache
+  // it in the model metadata. Returns false if it is not available.
+  bool GetArenaPlan(SubgraphArenaPlan* plan) const {
+    return memory_planner_ && memory_planner_->GetArenaPlan(plan);
+  }
+
   // WARNING: This is an experimental API and subject to change.
   // Set the given `InterpreterOptions` object.
   void SetOptions(InterpreterOptions* options) {
@@ -483,6 +497,26 @@ class Subgraph {
     return (options_ && options_->GetPreserveAllTensors());
   }
 
+  // WARNING: This is an experimental API and subject to change.
+  // True if the arenas of the subgraphs called by control flow ops should be
+  // planned into the arena of this subgraph.
+  bool ShouldShareSubgraphArenas() const {
+    return (options_ && options_->GetShareSubgraphArenas() &&
+            !ShouldPreserveAllTensors());
+  }
+
+  // WARNING: This is an experimental API and subject to change.
+  // True if the arena should be re-planned incrementally after a resize.
+  bool ShouldPlanArenaIncrementally() const {
+    return (options_ && options_->GetIncrementalArenaPlanning());
+  }
+
+  // WARNING: This is an experimental API and subject to change.
+  // True if the independent nodes should run at the same time.
+  bool ShouldRunNodesConcurrently() const {
+    return (options_ && options_->GetInterOpThreads() > 1);
+  }
+
   // WARNING: This is an experimental API and subject to change.
   // True if all intermediate dynamic tensors should be released once they are
   // not used by the model.
@@ -982,8 +1016,11 @@ class Subgraph {
   // Since the lifetime of the Interpreter exceeds the Subgraph, metadata
   // remains valid for the latter's lifetime.
   // Also sets relevant fields on context_ based on known metadata.
+  // `arena_plan`, if not null, is the placement of the arena tensors cached in
+  // the metadata, owned by the Interpreter too.
   TfLiteStatus SetMetadata(const std::map<std::string, std::string>* metadata,
-                           const ControlEdges* control_edges = nullptr);
+                           const ControlEdges* control_edges = nullptr,
+                           const SubgraphArenaPlan* arena_plan = nullptr);
 
   // Initializes the mapping between tensor index to the index of the
   // last operation that uses the tensor as input.
@@ -998,6 +1035,74 @@ class Subgraph {
   // tensors if configured.
   void MaybeReleaseDynamicTensors(const TfLiteNode& node, size_t node_index);
 
+  // Arena of a called subgraph, placed in the memory reserved for its caller.
+  struct CalledSubgraphArena {
+    Subgraph* subgraph;
+    size_t offset;
+    size_t size;
+  };
+
+  // Lays out the arenas of the subgraphs called by the node at execution plan
+  // index `node`, which only run while it runs, in one block of memory. Fills
+  // `arenas` with their place in the block and returns the size of the block.
+  // Only the subgraphs called by no other node are placed.
+  size_t LayoutCalledSubgraphArenas(int node,
+                                    std::vector<CalledSubgraphArena>* arenas);
+
+  // Returns the number of nodes of the interpreter calling `subgraph_index`.
+  int CountSubgraphCallers(int subgraph_index) const;
+
+  // Reserves the memory of the subgraphs called by the nodes in
+  // [first_node, last_node] in the arena of this subgraph.
+  void ReserveCalledSubgraphArenas(int first_node, int last_node);
+
+  // Places the arenas of the subgraphs called by the nodes in
+  // [first_node, last_node] in the memory reserved for them. They use it from
+  // the next time they acquire their memory, right before running.
+  void ShareCalledSubgraphArenas(int first_node, int last_node);
+
+  // Makes the subgraphs called by the nodes from `first_node` on use arenas of
+  // their own, until they are placed again.
+  void UnshareCalledSubgraphArenas(int first_node);
+
+  // Returns true if the node at `node_index` can run at the same time as other
+  // nodes, i.e., it is a builtin op which doesn't use shared state such as the
+  // CPU backend context or resource variables, and isn't delegated.
+  bool CanRunConcurrently(int node_index) const;
+
+  // Groups the nodes of the execution plan in levels of nodes which can run at
+  // the same time, and reorders the execution plan to make each level
+  // contiguous, if the nodes should run concurrently. Plans the allocations
+  // again if the levels changed.
+  TfLiteStatus ScheduleNodeLevels();
+
+  // Returns true if the nodes of each level can run at the same time in the
+  // current state: all the nodes are prepared, the tensors are allocated for
+  // the levels, and there are neither dynamic tensors, profilers nor weight
+  // streaming.
+  bool CanInvokeNodeLevels();
+
+  // Creates `weight_streamer_` for the current execution plan if weight
+  // streaming is enabled and the model is memory mapped.
+  void CreateWeightStreamer();
+
+  // Runs the levels of nodes one after the other, and the nodes of each level
+  // at the same time on `inter_op_thread_pool_`.
+  TfLiteStatus InvokeNodeLevels();
+
+  // Returns the shapes, types and allocation types of the inputs, and the
+  // custom allocations, which the preparation of the nodes depends on.
+  std::vector<int64_t> GetPreparedFingerprint() const;
+
+  // Returns true if a kTfLiteArenaRwPersistent input lost its data by being
+  // resized, which only preparing the nodes again allocates.
+  bool HasUnallocatedPersistentInput() const;
+
+  // Makes the inputs of `node` readable before it runs, and checks that they
+  // have data.
+  TfLiteStatus EnsureNodeInputsAreReadable(
+      const TfLiteNode& node, const TfLiteRegistration& registration);
+
   // Set the buffer handle to a tensor.
   // The method is used to implement Interpreter::SetBufferHandle and
   // SignatureRunner::SetInputBufferHandle/SetOutputBufferHandle APIs.
@@ -1168,6 +1273,14 @@ class Subgraph {
   // is kept only for user error message.
   int dynamic_tensor_index_ = -1;
 
+  // True if all the nodes were prepared by the last `AllocateTensors()`
+  // without dynamic tensors, and the graph didn't change since then, other
+  // than by releasing the non-persistent memory or resizing the inputs. The
+  // nodes don't need to be prepared again while `prepared_fingerprint_` still
+  // matches `GetPreparedFingerprint()`.
+  bool ops_prepared_ = false;
+  std::vector<int64_t> prepared_fingerprint_;
+
   // Reference to cancellation function that can cancel a request in the middle
   // of a call to Invoke(). When this function returns True, a kTfLiteError is
   // thrown by Invoke().
@@ -1215,6 +1328,23 @@ class Subgraph {
   // metadata_ by appropriately parametrized SetMetadata method calls.
   const ControlEdges* control_edges_ = nullptr;
 
+  // Placement of the arena tensors computed offline; can be nullptr. Owned by
+  // the owning interpreter, like `control_edges_`.
+  const SubgraphArenaPlan* arena_plan_ = nullptr;
+
+  // Level of each node, by execution plan index, if the nodes run
+  // concurrently and some levels have more than one node. See
+  // `ScheduleNodeLevels()`.
+  std::vector<int> node_levels_;
+
+  // Threads running the nodes of a level, created by the first level with
+  // more than one node.
+  std::unique_ptr<InterOpThreadPool> inter_op_thread_pool_;
+
+  // Prefetches and releases the weights of the memory mapped model around the
+  // nodes of the execution plan, if weight streaming is enabled.
+  std::unique_ptr<WeightStreamer> weight_streamer_;
+
   // Whether this subgraph is "delegation skippable". If a subgraph is
   // delegation-skippable, then the subgraph will be handled by a TfLiteDelegate
   // (and that the delegate is supposed to be already aware of this state), and
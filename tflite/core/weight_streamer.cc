@@ -0,0 +1,147 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/core/weight_streamer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__APPLE__) || defined(__linux__) || defined(__Fuchsia__)
+#include <sys/mman.h>
+#endif
+
+namespace tflite {
+
+namespace {
+
+const char* AlignDown(const char* p, size_t page_size) {
+  return reinterpret_cast<const char*>(reinterpret_cast<uintptr_t>(p) /
+                                       page_size * page_size);
+}
+
+const char* AlignUp(const char* p, size_t page_size) {
+  return AlignDown(p + page_size - 1, page_size);
+}
+
+}  // namespace
+
+WeightStreamer::AdviseFunction WeightStreamer::Madvise(bool private_mapping) {
+  return [private_mapping](const char* begin, size_t size, Advice advice) {
+#if defined(__APPLE__) || defined(__linux__) || defined(__Fuchsia__)
+    // The advice is only a hint, its failures are ignored.
+    void* addr = const_cast<char*>(begin);
+    if (advice == Advice::kWillNeed) {
+      madvise(addr, size, MADV_WILLNEED);
+    } else if (!private_mapping) {
+      // The pages of a read-only mapping are read from the file again on the
+      // next access.
+      madvise(addr, size, MADV_DONTNEED);
+    } else {
+#ifdef MADV_PAGEOUT
+      // Dropping the written pages of a private mapping would lose their
+      // content, unlike paging them out.
+      madvise(addr, size, MADV_PAGEOUT);
+#endif
+    }
+#else
+    (void)private_mapping;
+    (void)begin;
+    (void)size;
+    (void)advice;
+#endif
+  };
+}
+
+WeightStreamer::WeightStreamer(
+    const std::vector<std::vector<Weight>>& step_weights, size_t page_size,
+    Options options, AdviseFunction advise)
+    : steps_(step_weights.size()),
+      page_size_(page_size),
+      options_(options),
+      advise_(std::move(advise)) {
+  // NOLINTNEXTLINE - absl::flat_hash_map increases binary size.
+  std::unordered_map<const char*, int> range_indices;
+  for (size_t step = 0; step < step_weights.size(); ++step) {
+    for (const Weight& weight : step_weights[step]) {
+      if (weight.data == nullptr || weight.bytes == 0) continue;
+      auto [it, inserted] = range_indices.emplace(weight.data, ranges_.size());
+      if (inserted) {
+        ranges_.push_back({weight.data, weight.bytes});
+      }
+      Range& range = ranges_[it->second];
+      range.size = std::max(range.size, weight.bytes);
+      std::vector<int>& step_ranges = steps_[step];
+      if (std::find(step_ranges.begin(), step_ranges.end(), it->second) ==
+          step_ranges.end()) {
+        step_ranges.push_back(it->second);
+      }
+    }
+  }
+}
+
+void WeightStreamer::BeforeStep(int step) {
+  const int num_steps = steps_.size();
+  if (step < 0 || step >= num_steps) return;
+  ++window_;
+  const int window_size = std::min(options_.lookahead + 1, num_steps);
+  for (int i = 0; i < window_size; ++i) {
+    for (int index : steps_[(step + i) % num_steps]) {
+      Range& range = ranges_[index];
+      range.needed_in_window = window_;
+      if (range.resident) continue;
+      range.resident = true;
+      range.lru_position = lru_.insert(lru_.end(), index);
+      resident_bytes_ += range.size;
+      // All the pages the range touches are read.
+      const char* begin = AlignDown(range.begin, page_size_);
+      const char* end = AlignUp(range.begin + range.size, page_size_);
+      advise_(begin, end - begin, Advice::kWillNeed);
+    }
+  }
+}
+
+void WeightStreamer::AfterStep(int step) {
+  if (step < 0 || step >= static_cast<int>(steps_.size())) return;
+  for (int index : steps_[step]) {
+    Range& range = ranges_[index];
+    if (range.resident) {
+      lru_.splice(lru_.end(), lru_, range.lru_position);
+    }
+  }
+  if (options_.budget_bytes == 0) return;
+  for (auto it = lru_.begin();
+       it != lru_.end() && resident_bytes_ > options_.budget_bytes;) {
+    Range& range = ranges_[*it];
+    if (range.needed_in_window == window_) {
+      ++it;
+      continue;
+    }
+    it = lru_.erase(it);
+    range.resident = false;
+    resident_bytes_ -= range.size;
+    // Only the pages fully covered by the range are released, as the others
+    // hold the data of neighbouring tensors too.
+    const char* begin = AlignUp(range.begin, page_size_);
+    const char* end = AlignDown(range.begin + range.size, page_size_);
+    if (begin < end) {
+      advise_(begin, end - begin, Advice::kDontNeed);
+    }
+  }
+}
+
+}  // namespace tflite
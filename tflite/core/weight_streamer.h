@@ -0,0 +1,108 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_CORE_WEIGHT_STREAMER_H_
+#define TENSORFLOW_LITE_CORE_WEIGHT_STREAMER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <vector>
+
+namespace tflite {
+
+// Streams the constant tensors of a memory mapped model in and out of memory
+// following the execution plan, instead of leaving the OS to page them in on
+// first touch and to evict them at random.
+//
+// Before a step of the execution plan runs, the weights of the next
+// `lookahead` steps are advised as needed, so that the OS reads them ahead in
+// the background. The plan wraps around, as the first steps run again on the
+// next invocation. After a step ran, the least recently used weights beyond
+// `budget_bytes` are released, except those of the coming steps.
+//
+// WARNING: This is an experimental API and subject to change.
+class WeightStreamer {
+ public:
+  enum class Advice { kWillNeed, kDontNeed };
+
+  // Applies `advice` to the page aligned `size` bytes at `begin`.
+  using AdviseFunction =
+      std::function<void(const char* begin, size_t size, Advice advice)>;
+
+  // A constant tensor of the model.
+  struct Weight {
+    const char* data;
+    size_t bytes;
+  };
+
+  struct Options {
+    // The maximum size of the weights kept in memory, or 0 for no limit.
+    size_t budget_bytes = 0;
+    // The number of steps whose weights are prefetched ahead of their run.
+    int lookahead = 2;
+  };
+
+  // Returns the function calling madvise() on the pages of a mapping. The
+  // pages of `private_mapping`s, which may have been written, are paged out
+  // rather than dropped.
+  static AdviseFunction Madvise(bool private_mapping);
+
+  // Creates a streamer for the weights read by each step of the execution
+  // plan, in `step_weights`, of a mapping with pages of `page_size` bytes.
+  WeightStreamer(const std::vector<std::vector<Weight>>& step_weights,
+                 size_t page_size, Options options, AdviseFunction advise);
+  WeightStreamer(const WeightStreamer&) = delete;
+  WeightStreamer& operator=(const WeightStreamer&) = delete;
+
+  // Prefetches the weights of `step` and of the following steps.
+  void BeforeStep(int step);
+
+  // Releases the least recently used weights beyond the budget.
+  void AfterStep(int step);
+
+  // The total size of the weights prefetched and not released since.
+  size_t resident_bytes() const { return resident_bytes_; }
+
+ private:
+  // A page aligned range of the mapping, shared by the tensors with the same
+  // data.
+  struct Range {
+    const char* begin;
+    size_t size;
+    bool resident = false;
+    // The `window_` during which the range is needed by a coming step.
+    uint64_t needed_in_window = 0;
+    // The position of a resident range in `lru_`.
+    std::list<int>::iterator lru_position = {};
+  };
+
+  std::vector<Range> ranges_;
+  // The indices in `ranges_` of the weights of each step.
+  std::vector<std::vector<int>> steps_;
+  size_t page_size_;
+  Options options_;
+  AdviseFunction advise_;
+
+  // The resident ranges, from the least to the most recently used.
+  std::list<int> lru_;
+  size_t resident_bytes_ = 0;
+  // Incremented by each BeforeStep().
+  uint64_t window_ = 0;
+};
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_CORE_WEIGHT_STREAMER_H_
@@ -0,0 +1,145 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/core/weight_streamer.h"
+
+#include <cstddef>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace tflite {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::FieldsAre;
+using ::testing::IsEmpty;
+
+constexpr size_t kPageSize = 4096;
+
+struct AdviceCall {
+  size_t offset;
+  size_t size;
+  WeightStreamer::Advice advice;
+};
+
+class WeightStreamerTest : public ::testing::Test {
+ protected:
+  WeightStreamer::AdviseFunction Recorder() {
+    return [this](const char* begin, size_t size,
+                  WeightStreamer::Advice advice) {
+      calls_.push_back({static_cast<size_t>(begin - mapping_), size, advice});
+    };
+  }
+
+  WeightStreamer::Weight WeightAt(size_t offset, size_t bytes) {
+    return {mapping_ + offset, bytes};
+  }
+
+  alignas(kPageSize) char mapping_[8 * kPageSize];
+  std::vector<AdviceCall> calls_;
+};
+
+TEST_F(WeightStreamerTest, PrefetchesTheNextStepsOnce) {
+  WeightStreamer streamer(
+      {{WeightAt(0, kPageSize)}, {WeightAt(kPageSize, 100)}, {}},
+      kPageSize, {/*budget_bytes=*/0, /*lookahead=*/1}, Recorder());
+
+  streamer.BeforeStep(0);
+  EXPECT_THAT(calls_,
+              ElementsAre(FieldsAre(0, kPageSize,
+                                    WeightStreamer::Advice::kWillNeed),
+                          FieldsAre(kPageSize, kPageSize,
+                                    WeightStreamer::Advice::kWillNeed)));
+  streamer.AfterStep(0);
+  calls_.clear();
+  streamer.BeforeStep(1);
+  streamer.AfterStep(1);
+  EXPECT_THAT(calls_, IsEmpty());
+  EXPECT_EQ(streamer.resident_bytes(), kPageSize + 100);
+}
+
+TEST_F(WeightStreamerTest, ReleasesLeastRecentlyUsedWeightsOverBudget) {
+  WeightStreamer streamer({{WeightAt(0, 2 * kPageSize)},
+                           {WeightAt(2 * kPageSize, 2 * kPageSize)},
+                           {WeightAt(4 * kPageSize, 2 * kPageSize)},
+                           {WeightAt(6 * kPageSize, 2 * kPageSize)}},
+                          kPageSize,
+                          {/*budget_bytes=*/4 * kPageSize, /*lookahead=*/1},
+                          Recorder());
+
+  for (int step = 0; step < 3; ++step) {
+    streamer.BeforeStep(step);
+    streamer.AfterStep(step);
+  }
+  // After step 2, the weights of steps 2 and 3 are needed, those of steps 0
+  // and 1 went over the budget.
+  std::vector<AdviceCall> releases;
+  for (const AdviceCall& call : calls_) {
+    if (call.advice == WeightStreamer::Advice::kDontNeed) {
+      releases.push_back(call);
+    }
+  }
+  EXPECT_THAT(releases,
+              ElementsAre(FieldsAre(0, 2 * kPageSize,
+                                    WeightStreamer::Advice::kDontNeed),
+                          FieldsAre(2 * kPageSize, 2 * kPageSize,
+                                    WeightStreamer::Advice::kDontNeed)));
+  EXPECT_EQ(streamer.resident_bytes(), 4 * kPageSize);
+}
+
+TEST_F(WeightStreamerTest, KeepsTheWeightsOfTheNextInvocation) {
+  // The last step prefetches the weights of the first one, which are shared
+  // with the second step.
+  WeightStreamer streamer({{WeightAt(0, kPageSize)},
+                           {WeightAt(0, kPageSize)},
+                           {WeightAt(kPageSize, kPageSize)}},
+                          kPageSize,
+                          {/*budget_bytes=*/kPageSize, /*lookahead=*/1},
+                          Recorder());
+  for (int step = 0; step < 3; ++step) {
+    streamer.BeforeStep(step);
+    streamer.AfterStep(step);
+  }
+  EXPECT_THAT(calls_,
+              ElementsAre(FieldsAre(0, kPageSize,
+                                    WeightStreamer::Advice::kWillNeed),
+                          FieldsAre(kPageSize, kPageSize,
+                                    WeightStreamer::Advice::kWillNeed)));
+  EXPECT_EQ(streamer.resident_bytes(), 2 * kPageSize);
+}
+
+TEST_F(WeightStreamerTest, OnlyReleasesThePagesOfTheWeight) {
+  WeightStreamer streamer({{WeightAt(100, 3 * kPageSize)},
+                           {WeightAt(4 * kPageSize, kPageSize)},
+                           {WeightAt(5 * kPageSize, kPageSize)}},
+                          kPageSize,
+                          {/*budget_bytes=*/kPageSize, /*lookahead=*/0},
+                          Recorder());
+  streamer.BeforeStep(0);
+  streamer.AfterStep(0);
+  streamer.BeforeStep(1);
+  streamer.AfterStep(1);
+  EXPECT_THAT(calls_,
+              ElementsAre(FieldsAre(0, 4 * kPageSize,
+                                    WeightStreamer::Advice::kWillNeed),
+                          FieldsAre(4 * kPageSize, kPageSize,
+                                    WeightStreamer::Advice::kWillNeed),
+                          FieldsAre(kPageSize, 2 * kPageSize,
+                                    WeightStreamer::Advice::kDontNeed)));
+}
+
+}  // namespace
+}  // namespace tflite
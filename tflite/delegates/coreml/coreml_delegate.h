@@ -47,6 +47,11 @@ typedef struct {
   // This sets the minimum number of nodes per partition delegated with
   // Core ML delegate. Defaults to 2.
   int min_nodes_per_partition;
+  // Directory where compiled Core ML models are cached across runs. When set,
+  // a delegated partition whose converted model and OS version match a cached
+  // one loads the compiled model from it instead of compiling it again. The
+  // directory must already exist. Defaults to nullptr, which disables caching.
+  const char* cache_dir;
 #ifdef TFLITE_DEBUG_DELEGATE
   // This sets the index of the first node that could be delegated.
   int first_delegate_node_index;
@@ -17,6 +17,7 @@ limitations under the License.
 #include <string.h>
 #include <sys/utsname.h>
 #include <limits>
+#include <string>
 #include <vector>
 
 #include "tflite/builtin_ops.h"
@@ -175,6 +176,11 @@ class CoreMlDelegate : public TfLiteDelegate {
       if (params_.min_nodes_per_partition <= 0) {
         params_.min_nodes_per_partition = kMinNodesPerCoreMlDelegate;
       }
+      // Keeps a copy, since the options may not outlive the delegate.
+      if (params_.cache_dir != nullptr) {
+        cache_dir_ = params_.cache_dir;
+        params_.cache_dir = cache_dir_.c_str();
+      }
 #ifdef TFLITE_DEBUG_DELEGATE
       if (params_.first_delegate_node_index < 0) {
         params_.first_delegate_node_index = 0;
@@ -192,6 +198,7 @@ class CoreMlDelegate : public TfLiteDelegate {
 
  private:
   TfLiteCoreMlDelegateOptions params_;
+  std::string cache_dir_;
 };
 
 TfLiteRegistration GetCoreMlKernelRegistration() {
@@ -213,7 +220,8 @@ TfLiteRegistration GetCoreMlKernelRegistration() {
                                 size_t length) -> void* {
     const auto* params = reinterpret_cast<const TfLiteDelegateParams*>(buffer);
     const auto* coreml_options = (reinterpret_cast<CoreMlDelegate*>(params->delegate))->params();
-    CoreMlDelegateKernel* coreml_kernel = new CoreMlDelegateKernel(coreml_options->coreml_version);
+    CoreMlDelegateKernel* coreml_kernel =
+        new CoreMlDelegateKernel(coreml_options->coreml_version, coreml_options->cache_dir);
     if (coreml_kernel->Init(context, params) != kTfLiteOk) {
       delete coreml_kernel;
       return nullptr;
@@ -15,6 +15,8 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_EXPERIMENTAL_DELEGATES_COREML_COREML_DELEGATE_KERNEL_H_
 #define TENSORFLOW_LITE_EXPERIMENTAL_DELEGATES_COREML_COREML_DELEGATE_KERNEL_H_
 
+#include <string>
+
 #include "tflite/core/c/common.h"
 #include "tflite/delegates/coreml/builders/op_builder.h"
 #import "tflite/delegates/coreml/coreml_executor.h"
@@ -28,8 +30,10 @@ namespace coreml {
 // implements Init/Prepare/Invoke as TFLite kernel nodes.
 class CoreMlDelegateKernel {
  public:
-  explicit CoreMlDelegateKernel(int coreml_version)
-      : coreml_version_(coreml_version) {}
+  // `cache_dir` is the directory compiled models are cached in, or nullptr.
+  CoreMlDelegateKernel(int coreml_version, const char* cache_dir)
+      : coreml_version_(coreml_version),
+        cache_dir_(cache_dir != nullptr ? cache_dir : "") {}
   // Initialize the delegated graph and add required nodes.
   TfLiteStatus Init(TfLiteContext* context, const TfLiteDelegateParams* params);
 
@@ -58,6 +62,7 @@ class CoreMlDelegateKernel {
   std::unique_ptr<CoreML::Specification::Model> model_;
   ::CoreMlExecutor* executor_;
   int coreml_version_;
+  std::string cache_dir_;
 
   std::vector<int> input_tensor_ids_;
   std::vector<TensorData> inputs_;
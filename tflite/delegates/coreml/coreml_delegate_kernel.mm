@@ -69,6 +69,13 @@ TfLiteStatus CoreMlDelegateKernel::Init(TfLiteContext* context,
       TF_LITE_KERNEL_LOG(context, "Failed to createModel");
       return kTfLiteError;
     }
+    if (!cache_dir_.empty()) {
+      executor_.cacheDirectory = [NSString stringWithUTF8String:cache_dir_.c_str()];
+      if ([executor_ loadCachedModel:model_.get()]) {
+        model_.reset();
+        return kTfLiteOk;
+      }
+    }
     NSURL* model_url = [executor_ saveModel:model_.get()];
     model_.reset();
     if (![executor_ build:model_url]) {
@@ -39,10 +39,17 @@ struct TensorData {
 - (NSURL*)saveModel:(CoreML::Specification::Model*)model API_AVAILABLE(ios(11));
 - (bool)build:(NSURL*)modelUrl API_AVAILABLE(ios(11));
 
+// Looks for a compiled model matching `model` and the OS version in
+// `cacheDirectory`, and loads it if found. Otherwise, the model compiled by the
+// next build: call is stored there for the following runs.
+- (bool)loadCachedModel:(CoreML::Specification::Model*)model API_AVAILABLE(ios(11));
+
 - (bool)cleanup;
 
 @property MLModel* model API_AVAILABLE(ios(11));
 @property NSString* mlModelFilePath;
 @property NSString* compiledModelFilePath;
+// Directory where compiled models are cached, nil to disable caching.
+@property NSString* cacheDirectory;
 @property(nonatomic, readonly) int coreMlVersion;
 @end
@@ -17,8 +17,11 @@ limitations under the License.
 #import <CoreML/CoreML.h>
 #import <Foundation/Foundation.h>
 
+#include <cstdint>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <string>
 
 namespace {
 // Returns NSURL for a temporary file.
@@ -32,6 +35,32 @@ NSURL* createTemporaryFile() {
 
   return temporaryFileURL;
 }
+
+// Returns the Core ML version of the model specification, or 0 if it is not
+// supported.
+int getCoreMlVersion(const CoreML::Specification::Model& model) {
+  switch (model.specificationversion()) {
+    case 3:
+      return 2;
+    case 4:
+      return 3;
+    default:
+      return 0;
+  }
+}
+
+// Returns the file name the compiled `model` is cached under. The compiled
+// model depends on the OS version as well, so it is part of the key.
+NSString* getCacheFileName(const CoreML::Specification::Model& model) {
+  // 64-bit FNV-1a, which is stable across runs unlike std::hash.
+  std::string key = model.SerializeAsString();
+  key += [[[NSProcessInfo processInfo] operatingSystemVersionString] UTF8String];
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (unsigned char c : key) {
+    hash = (hash ^ c) * 0x100000001b3ULL;
+  }
+  return [NSString stringWithFormat:@"%016llx.mlmodelc", (unsigned long long)hash];
+}
 }  // namespace
 
 @interface MultiArrayFeatureProvider : NSObject <MLFeatureProvider> {
@@ -126,7 +155,11 @@ NSURL* createTemporaryFile() {
 }
 @end
 
-@implementation CoreMlExecutor
+@implementation CoreMlExecutor {
+  // Path of the compiled model in `cacheDirectory`, nil if caching is disabled.
+  NSString* _cachedModelFilePath;
+}
+
 - (bool)invokeWithInputs:(const std::vector<TensorData>&)inputs
                  outputs:(const std::vector<TensorData>&)outputs {
   if (_model == nil) {
@@ -165,10 +198,16 @@ NSURL* createTemporaryFile() {
 
 - (bool)cleanup {
   NSError* error = nil;
-  [[NSFileManager defaultManager] removeItemAtPath:_mlModelFilePath error:&error];
-  if (error != nil) {
-    NSLog(@"Failed cleaning up model: %@", [error localizedDescription]);
-    return NO;
+  if (_mlModelFilePath != nil) {
+    [[NSFileManager defaultManager] removeItemAtPath:_mlModelFilePath error:&error];
+    if (error != nil) {
+      NSLog(@"Failed cleaning up model: %@", [error localizedDescription]);
+      return NO;
+    }
+  }
+  // Cached compiled models are kept for the next runs.
+  if (_compiledModelFilePath == nil || [_compiledModelFilePath isEqual:_cachedModelFilePath]) {
+    return YES;
   }
   [[NSFileManager defaultManager] removeItemAtPath:_compiledModelFilePath error:&error];
   if (error != nil) {
@@ -181,11 +220,8 @@ NSURL* createTemporaryFile() {
 - (NSURL*)saveModel:(CoreML::Specification::Model*)model {
   NSURL* modelUrl = createTemporaryFile();
   NSString* modelPath = [modelUrl path];
-  if (model->specificationversion() == 3) {
-    _coreMlVersion = 2;
-  } else if (model->specificationversion() == 4) {
-    _coreMlVersion = 3;
-  } else {
+  _coreMlVersion = getCoreMlVersion(*model);
+  if (_coreMlVersion == 0) {
     NSLog(@"Only Core ML models with specification version 3 or 4 are supported");
     return nil;
   }
@@ -205,7 +241,61 @@ NSURL* createTemporaryFile() {
   }
   _mlModelFilePath = [modelUrl path];
   _compiledModelFilePath = [compileUrl path];
+  if (_cachedModelFilePath != nil) {
+    [self storeCompiledModel];
+  }
+  return [self loadCompiledModel];
+}
 
+- (bool)loadCachedModel:(CoreML::Specification::Model*)model {
+  if (_cacheDirectory == nil) {
+    return NO;
+  }
+  _coreMlVersion = getCoreMlVersion(*model);
+  if (_coreMlVersion == 0) {
+    return NO;
+  }
+  _cachedModelFilePath =
+      [_cacheDirectory stringByAppendingPathComponent:getCacheFileName(*model)];
+  if (![[NSFileManager defaultManager] fileExistsAtPath:_cachedModelFilePath]) {
+    return NO;
+  }
+  _compiledModelFilePath = _cachedModelFilePath;
+  if (![self loadCompiledModel]) {
+    // The cached model is unusable, it is replaced by the next build.
+    [[NSFileManager defaultManager] removeItemAtPath:_cachedModelFilePath error:nil];
+    _compiledModelFilePath = nil;
+    return NO;
+  }
+  return YES;
+}
+
+// Moves the compiled model to the cache. It is moved to a unique path next to
+// the cached one first and then renamed, so that concurrent runs never load a
+// partially written model.
+- (void)storeCompiledModel {
+  NSFileManager* fileManager = [NSFileManager defaultManager];
+  NSString* stagingPath = [_cachedModelFilePath
+      stringByAppendingPathExtension:[[NSProcessInfo processInfo] globallyUniqueString]];
+  NSError* error = nil;
+  if (![fileManager moveItemAtPath:_compiledModelFilePath toPath:stagingPath error:&error]) {
+    NSLog(@"Failed caching compiled model: %@", [error localizedDescription]);
+    return;
+  }
+  _compiledModelFilePath = stagingPath;
+  if (rename([stagingPath fileSystemRepresentation],
+             [_cachedModelFilePath fileSystemRepresentation]) == 0) {
+    _compiledModelFilePath = _cachedModelFilePath;
+  } else if ([fileManager fileExistsAtPath:_cachedModelFilePath]) {
+    // Another run cached the same model first.
+    [fileManager removeItemAtPath:stagingPath error:nil];
+    _compiledModelFilePath = _cachedModelFilePath;
+  }
+}
+
+- (bool)loadCompiledModel {
+  NSError* error = nil;
+  NSURL* compileUrl = [NSURL fileURLWithPath:_compiledModelFilePath isDirectory:YES];
   if (@available(iOS 12.0, *)) {
     MLModelConfiguration* config = [MLModelConfiguration alloc];
     config.computeUnits = MLComputeUnitsAll;
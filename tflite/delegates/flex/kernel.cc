@@ -369,7 +369,10 @@ class OpNode {
       return kTfLiteError;
     }
     // Copy TF tensor's data content into TfLiteTensor, and release the tensor.
-    memcpy(tensor->data.raw, t_data.data(), t_data.size());
+    // There is nothing to copy if TF forwarded the TfLite buffer itself.
+    if (t_data.data() != tensor->data.raw) {
+      memcpy(tensor->data.raw, t_data.data(), t_data.size());
+    }
     *tf_tensor = {};
     shared_info->already_transferred_outputs.insert(tensor_index);
     return kTfLiteOk;
@@ -751,19 +754,24 @@ static tensorflow::CancellationManager* GetDefaultCancellationManager() {
 
 TfLiteStatus DelegateKernel::Eval(TfLiteContext* context, TfLiteNode* node) {
   BufferMap* buffer_map = op_data_->shared_info.buffer_map;
+  auto* profiler = reinterpret_cast<Profiler*>(context->profiler);
 
   // Insert a tensor in the buffer map for all inputs that are not constant.
-  // Constants were handled in Prepare() already.
-  for (auto tensor_index : op_data_->subgraph_inputs) {
-    TfLiteTensor* tensor = &context->tensors[tensor_index];
-    if (!IsConstantTensor(tensor)) {
-      // If this tensor is part of an earlier TF subgraph we should not add it
-      // to the BufferMap again, because TF already knows about it and its
-      // contents are kept automatically up-to-date.
-      if (!tensor->data_is_stale || !buffer_map->HasTensor(tensor_index)) {
-        buffer_map->SetFromTfLite(
-            tensor_index, tensor,
-            !op_data_->disable_reusing_buffer_tensors.count(tensor_index));
+  // Constants were handled in Prepare() already. The bridging between TfLite
+  // and TF tensors is profiled apart from the ops, to tell their costs apart.
+  {
+    TFLITE_SCOPED_TAGGED_DEFAULT_PROFILE(profiler, "FlexBridgeInputs");
+    for (auto tensor_index : op_data_->subgraph_inputs) {
+      TfLiteTensor* tensor = &context->tensors[tensor_index];
+      if (!IsConstantTensor(tensor)) {
+        // If this tensor is part of an earlier TF subgraph we should not add
+        // it to the BufferMap again, because TF already knows about it and its
+        // contents are kept automatically up-to-date.
+        if (!tensor->data_is_stale || !buffer_map->HasTensor(tensor_index)) {
+          buffer_map->SetFromTfLite(
+              tensor_index, tensor,
+              !op_data_->disable_reusing_buffer_tensors.count(tensor_index));
+        }
       }
     }
   }
@@ -787,8 +795,7 @@ TfLiteStatus DelegateKernel::Eval(TfLiteContext* context, TfLiteNode* node) {
     // Execute the TensorFlow Ops sequentially.
     for (auto& node_data : op_data_->nodes) {
       TFLITE_SCOPED_DELEGATE_PROFILED_OPERATOR_PROFILE(
-          reinterpret_cast<Profiler*>(context->profiler),
-          node_data->name().c_str(), node_data->index());
+          profiler, node_data->name().c_str(), node_data->index());
 
       if (op_data_->cancellation_manager != nullptr &&
           op_data_->cancellation_manager->IsCancelled()) {
@@ -802,6 +809,7 @@ TfLiteStatus DelegateKernel::Eval(TfLiteContext* context, TfLiteNode* node) {
     }
   }
 
+  TFLITE_SCOPED_TAGGED_DEFAULT_PROFILE(profiler, "FlexBridgeOutputs");
   for (auto tensor_index : op_data_->subgraph_outputs) {
     if (op_data_->shared_info.already_transferred_outputs.count(tensor_index) !=
         0) {
@@ -839,7 +847,9 @@ TfLiteStatus DelegateKernel::Eval(TfLiteContext* context, TfLiteNode* node) {
       return kTfLiteError;
     }
     absl::string_view t_data = tf_tensor.tensor_data();
-    memcpy(tensor->data.raw, t_data.data(), t_data.size());
+    if (t_data.data() != tensor->data.raw) {
+      memcpy(tensor->data.raw, t_data.data(), t_data.size());
+    }
   }
 
   return kTfLiteOk;
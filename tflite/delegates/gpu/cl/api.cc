@@ -697,6 +697,8 @@ CreateGpuModelInfo GetCreateInfo(const Environment& environment,
   if (options.usage == InferenceUsage::FAST_SINGLE_ANSWER) {
     create_info.hints.Add(ModelHints::kReduceKernelsCount);
     create_info.hints.Add(ModelHints::kFastTuning);
+    // Recording a command buffer only pays off when it is replayed.
+    create_info.hints.Add(ModelHints::kNoCommandBuffer);
   } else if (options.usage == InferenceUsage::BALANCED) {
     create_info.hints.Add(ModelHints::kReduceKernelsCount);
   } else if (options.usage == InferenceUsage::SUSTAINED_SPEED) {
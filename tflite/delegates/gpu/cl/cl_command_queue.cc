@@ -252,9 +252,15 @@ absl::Status ProfilingCommandQueue::DispatchNTimes(
 ProfilingInfo ProfilingCommandQueue::GetProfilingInfo() const {
   ProfilingInfo result;
   result.dispatches.resize(number_of_dispatches_.size());
+  if (events_.empty()) {
+    return result;
+  }
+  const uint64_t first_start_ns = events_[0].GetStartedTimeNs();
   int events_counter = 0;
   for (int i = 0; i < number_of_dispatches_.size(); ++i) {
     result.dispatches[i].label = events_[events_counter].GetName();
+    result.dispatches[i].start = absl::Nanoseconds(
+        events_[events_counter].GetStartedTimeNs() - first_start_ns);
     if (number_of_dispatches_[i] == 1) {
       result.dispatches[i].duration =
           absl::Nanoseconds(events_[events_counter].GetEventTimeNs());
@@ -35,6 +35,9 @@ namespace data {
 struct Program;
 struct ProgramBuilder;
 
+struct TunedWorkGroup;
+struct TunedWorkGroupBuilder;
+
 struct CompiledCache;
 struct CompiledCacheBuilder;
 
@@ -101,11 +104,124 @@ inline ::flatbuffers::Offset<Program> CreateProgramDirect(
       binary__);
 }
 
+struct TunedWorkGroup FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef TunedWorkGroupBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_KERNEL_FINGERPRINT = 4,
+    VT_GRID_SIZE_X = 6,
+    VT_GRID_SIZE_Y = 8,
+    VT_GRID_SIZE_Z = 10,
+    VT_WORK_GROUP_SIZE_X = 12,
+    VT_WORK_GROUP_SIZE_Y = 14,
+    VT_WORK_GROUP_SIZE_Z = 16,
+    VT_EXHAUSTIVE = 18
+  };
+  uint64_t kernel_fingerprint() const {
+    return GetField<uint64_t>(VT_KERNEL_FINGERPRINT, 0);
+  }
+  int32_t grid_size_x() const {
+    return GetField<int32_t>(VT_GRID_SIZE_X, 0);
+  }
+  int32_t grid_size_y() const {
+    return GetField<int32_t>(VT_GRID_SIZE_Y, 0);
+  }
+  int32_t grid_size_z() const {
+    return GetField<int32_t>(VT_GRID_SIZE_Z, 0);
+  }
+  int32_t work_group_size_x() const {
+    return GetField<int32_t>(VT_WORK_GROUP_SIZE_X, 0);
+  }
+  int32_t work_group_size_y() const {
+    return GetField<int32_t>(VT_WORK_GROUP_SIZE_Y, 0);
+  }
+  int32_t work_group_size_z() const {
+    return GetField<int32_t>(VT_WORK_GROUP_SIZE_Z, 0);
+  }
+  bool exhaustive() const {
+    return GetField<uint8_t>(VT_EXHAUSTIVE, 0) != 0;
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint64_t>(verifier, VT_KERNEL_FINGERPRINT, 8) &&
+           VerifyField<int32_t>(verifier, VT_GRID_SIZE_X, 4) &&
+           VerifyField<int32_t>(verifier, VT_GRID_SIZE_Y, 4) &&
+           VerifyField<int32_t>(verifier, VT_GRID_SIZE_Z, 4) &&
+           VerifyField<int32_t>(verifier, VT_WORK_GROUP_SIZE_X, 4) &&
+           VerifyField<int32_t>(verifier, VT_WORK_GROUP_SIZE_Y, 4) &&
+           VerifyField<int32_t>(verifier, VT_WORK_GROUP_SIZE_Z, 4) &&
+           VerifyField<uint8_t>(verifier, VT_EXHAUSTIVE, 1) &&
+           verifier.EndTable();
+  }
+};
+
+struct TunedWorkGroupBuilder {
+  typedef TunedWorkGroup Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_kernel_fingerprint(uint64_t kernel_fingerprint) {
+    fbb_.AddElement<uint64_t>(TunedWorkGroup::VT_KERNEL_FINGERPRINT, kernel_fingerprint, 0);
+  }
+  void add_grid_size_x(int32_t grid_size_x) {
+    fbb_.AddElement<int32_t>(TunedWorkGroup::VT_GRID_SIZE_X, grid_size_x, 0);
+  }
+  void add_grid_size_y(int32_t grid_size_y) {
+    fbb_.AddElement<int32_t>(TunedWorkGroup::VT_GRID_SIZE_Y, grid_size_y, 0);
+  }
+  void add_grid_size_z(int32_t grid_size_z) {
+    fbb_.AddElement<int32_t>(TunedWorkGroup::VT_GRID_SIZE_Z, grid_size_z, 0);
+  }
+  void add_work_group_size_x(int32_t work_group_size_x) {
+    fbb_.AddElement<int32_t>(TunedWorkGroup::VT_WORK_GROUP_SIZE_X, work_group_size_x, 0);
+  }
+  void add_work_group_size_y(int32_t work_group_size_y) {
+    fbb_.AddElement<int32_t>(TunedWorkGroup::VT_WORK_GROUP_SIZE_Y, work_group_size_y, 0);
+  }
+  void add_work_group_size_z(int32_t work_group_size_z) {
+    fbb_.AddElement<int32_t>(TunedWorkGroup::VT_WORK_GROUP_SIZE_Z, work_group_size_z, 0);
+  }
+  void add_exhaustive(bool exhaustive) {
+    fbb_.AddElement<uint8_t>(TunedWorkGroup::VT_EXHAUSTIVE, static_cast<uint8_t>(exhaustive), 0);
+  }
+  explicit TunedWorkGroupBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<TunedWorkGroup> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<TunedWorkGroup>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<TunedWorkGroup> CreateTunedWorkGroup(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    uint64_t kernel_fingerprint = 0,
+    int32_t grid_size_x = 0,
+    int32_t grid_size_y = 0,
+    int32_t grid_size_z = 0,
+    int32_t work_group_size_x = 0,
+    int32_t work_group_size_y = 0,
+    int32_t work_group_size_z = 0,
+    bool exhaustive = false) {
+  TunedWorkGroupBuilder builder_(_fbb);
+  builder_.add_kernel_fingerprint(kernel_fingerprint);
+  builder_.add_work_group_size_z(work_group_size_z);
+  builder_.add_work_group_size_y(work_group_size_y);
+  builder_.add_work_group_size_x(work_group_size_x);
+  builder_.add_grid_size_z(grid_size_z);
+  builder_.add_grid_size_y(grid_size_y);
+  builder_.add_grid_size_x(grid_size_x);
+  builder_.add_exhaustive(exhaustive);
+  return builder_.Finish();
+}
+
 struct CompiledCache FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef CompiledCacheBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_DRIVER_VERSION = 4,
-    VT_PROGRAMS = 6
+    VT_PROGRAMS = 6,
+    VT_TUNING_DEVICE = 8,
+    VT_TUNED_WORK_GROUPS = 10
   };
   const ::flatbuffers::String *driver_version() const {
     return GetPointer<const ::flatbuffers::String *>(VT_DRIVER_VERSION);
@@ -113,6 +229,12 @@ struct CompiledCache FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   const ::flatbuffers::Vector<::flatbuffers::Offset<tflite::gpu::cl::data::Program>> *programs() const {
     return GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<tflite::gpu::cl::data::Program>> *>(VT_PROGRAMS);
   }
+  const ::flatbuffers::String *tuning_device() const {
+    return GetPointer<const ::flatbuffers::String *>(VT_TUNING_DEVICE);
+  }
+  const ::flatbuffers::Vector<::flatbuffers::Offset<tflite::gpu::cl::data::TunedWorkGroup>> *tuned_work_groups() const {
+    return GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<tflite::gpu::cl::data::TunedWorkGroup>> *>(VT_TUNED_WORK_GROUPS);
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_DRIVER_VERSION) &&
@@ -120,6 +242,11 @@ struct CompiledCache FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
            VerifyOffset(verifier, VT_PROGRAMS) &&
            verifier.VerifyVector(programs()) &&
            verifier.VerifyVectorOfTables(programs()) &&
+           VerifyOffset(verifier, VT_TUNING_DEVICE) &&
+           verifier.VerifyString(tuning_device()) &&
+           VerifyOffset(verifier, VT_TUNED_WORK_GROUPS) &&
+           verifier.VerifyVector(tuned_work_groups()) &&
+           verifier.VerifyVectorOfTables(tuned_work_groups()) &&
            verifier.EndTable();
   }
 };
@@ -134,6 +261,12 @@ struct CompiledCacheBuilder {
   void add_programs(::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<tflite::gpu::cl::data::Program>>> programs) {
     fbb_.AddOffset(CompiledCache::VT_PROGRAMS, programs);
   }
+  void add_tuning_device(::flatbuffers::Offset<::flatbuffers::String> tuning_device) {
+    fbb_.AddOffset(CompiledCache::VT_TUNING_DEVICE, tuning_device);
+  }
+  void add_tuned_work_groups(::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<tflite::gpu::cl::data::TunedWorkGroup>>> tuned_work_groups) {
+    fbb_.AddOffset(CompiledCache::VT_TUNED_WORK_GROUPS, tuned_work_groups);
+  }
   explicit CompiledCacheBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -148,8 +281,12 @@ struct CompiledCacheBuilder {
 inline ::flatbuffers::Offset<CompiledCache> CreateCompiledCache(
     ::flatbuffers::FlatBufferBuilder &_fbb,
     ::flatbuffers::Offset<::flatbuffers::String> driver_version = 0,
-    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<tflite::gpu::cl::data::Program>>> programs = 0) {
+    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<tflite::gpu::cl::data::Program>>> programs = 0,
+    ::flatbuffers::Offset<::flatbuffers::String> tuning_device = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<tflite::gpu::cl::data::TunedWorkGroup>>> tuned_work_groups = 0) {
   CompiledCacheBuilder builder_(_fbb);
+  builder_.add_tuned_work_groups(tuned_work_groups);
+  builder_.add_tuning_device(tuning_device);
   builder_.add_programs(programs);
   builder_.add_driver_version(driver_version);
   return builder_.Finish();
@@ -158,13 +295,19 @@ inline ::flatbuffers::Offset<CompiledCache> CreateCompiledCache(
 inline ::flatbuffers::Offset<CompiledCache> CreateCompiledCacheDirect(
     ::flatbuffers::FlatBufferBuilder &_fbb,
     const char *driver_version = nullptr,
-    const std::vector<::flatbuffers::Offset<tflite::gpu::cl::data::Program>> *programs = nullptr) {
+    const std::vector<::flatbuffers::Offset<tflite::gpu::cl::data::Program>> *programs = nullptr,
+    const char *tuning_device = nullptr,
+    const std::vector<::flatbuffers::Offset<tflite::gpu::cl::data::TunedWorkGroup>> *tuned_work_groups = nullptr) {
   auto driver_version__ = driver_version ? _fbb.CreateString(driver_version) : 0;
   auto programs__ = programs ? _fbb.CreateVector<::flatbuffers::Offset<tflite::gpu::cl::data::Program>>(*programs) : 0;
+  auto tuning_device__ = tuning_device ? _fbb.CreateString(tuning_device) : 0;
+  auto tuned_work_groups__ = tuned_work_groups ? _fbb.CreateVector<::flatbuffers::Offset<tflite::gpu::cl::data::TunedWorkGroup>>(*tuned_work_groups) : 0;
   return tflite::gpu::cl::data::CreateCompiledCache(
       _fbb,
       driver_version__,
-      programs__);
+      programs__,
+      tuning_device__,
+      tuned_work_groups__);
 }
 
 inline const tflite::gpu::cl::data::CompiledCache *GetCompiledCache(const void *buf) {
@@ -149,7 +149,7 @@ absl::Status GetBufferAssignment(
     std::map<ValueId, int>* graph_ids_to_shared_buffer_tensors,
     ObjectsAssignment<size_t>* buffer_assignment,
     OffsetsAssignment* offset_assignment, bool* use_offset_assignment,
-    bool* is_sub_buffers_supported) {
+    bool* is_sub_buffers_supported, MemoryStrategy* strategy = nullptr) {
   std::map<ValueId, int2> buffer_usages;
   GetUsages(
       gpu_model,
@@ -200,8 +200,12 @@ absl::Status GetBufferAssignment(
                                      static_cast<TaskId>(usage.second.y)});
   }
 
-  RETURN_IF_ERROR(AssignObjectsToTensors(
-      *buffer_usage_records, MemoryStrategy::GREEDY_BEST, buffer_assignment));
+  MemoryStrategy objects_strategy = MemoryStrategy::GREEDY_BEST;
+  RETURN_IF_ERROR(
+      BestGreedy(*buffer_usage_records, buffer_assignment, &objects_strategy));
+  if (strategy) {
+    *strategy = objects_strategy;
+  }
 
   *is_sub_buffers_supported =
       (!has_buffer_based_images && gpu_info.IsCL11OrHigher()) ||
@@ -211,12 +215,16 @@ absl::Status GetBufferAssignment(
 
   *use_offset_assignment = false;
   if (*is_sub_buffers_supported) {
-    RETURN_IF_ERROR(AssignOffsetsToTensors(
-        *buffer_usage_records, MemoryStrategy::GREEDY_BY_SIZE,
-        offset_assignment, base_align_bytes));
-    if (offset_assignment->total_size <= TotalSize(*buffer_assignment) &&
+    MemoryStrategy offsets_strategy = MemoryStrategy::GREEDY_BEST;
+    RETURN_IF_ERROR(BestGreedyOffsets(*buffer_usage_records, base_align_bytes,
+                                      offset_assignment, &offsets_strategy));
+    if (offset_assignment->total_size <=
+            TotalSize(*buffer_assignment, base_align_bytes) &&
         offset_assignment->total_size <= gpu_info.GetMaxBufferSize()) {
       *use_offset_assignment = true;
+      if (strategy) {
+        *strategy = offsets_strategy;
+      }
     }
   }
   return absl::OkStatus();
@@ -318,7 +326,7 @@ absl::Status InferenceContext::InitFromGpuModel(
                                  &create_info, &env->context()));
 
   gpu_info_ = env->device().GetInfo();
-  InitFromGpuModel(gpu_info_, gpu_model);
+  InitFromGpuModel(gpu_info_, create_info.hints, gpu_model);
 
   CreationContext creation_context;
   creation_context.device = env->GetDevicePtr();
@@ -359,8 +367,8 @@ absl::Status InferenceContext::InitFromGpuModel(
       tuning_type = TuningType::kFast;
     }
   }
-  RETURN_IF_ERROR(
-      Tune(tuning_type, env->device().GetInfo(), env->profiling_queue()));
+  RETURN_IF_ERROR(Tune(tuning_type, env->device().GetInfo(),
+                       env->profiling_queue(), env->program_cache()));
   if (external_mutable_tensors_.empty()) {
     // using recordable queue only when no mutable external tensors
     InitRecordableQueue(env);
@@ -408,7 +416,9 @@ absl::Status InferenceContext::RestoreDeserialized(
   RETURN_IF_ERROR(tflite::gpu::Decode(decoded_fb->gpu_model(), &gpu_model));
   RETURN_IF_ERROR(AllocateMemory(gpu_model, env->GetDevicePtr()->GetInfo(),
                                  create_info, &env->context()));
-  InitFromGpuModel(env->GetDevicePtr()->GetInfo(), &gpu_model);
+  InitFromGpuModel(env->GetDevicePtr()->GetInfo(),
+                   create_info ? create_info->hints : ModelHints(),
+                   &gpu_model);
 
   // deserializing kernels into program_cache
   for (auto binary_program_fb : *decoded_fb->binary_programs()) {
@@ -464,6 +474,7 @@ absl::Status InferenceContext::RestoreDeserialized(
 }
 
 void InferenceContext::InitFromGpuModel(const GpuInfo& gpu_info,
+                                        const ModelHints& hints,
                                         GpuModel* gpu_model) {
   for (const auto& input : gpu_model->input_ids_and_refs) {
     input_ids_.push_back(input.first);
@@ -471,7 +482,7 @@ void InferenceContext::InitFromGpuModel(const GpuInfo& gpu_info,
   for (const auto& output : gpu_model->output_ids_and_refs) {
     output_ids_.push_back(output.first);
   }
-  if (gpu_info.opencl_info.IsCLVK() &&
+  if (!hints.Check(ModelHints::kNoCommandBuffer) &&
       gpu_info.SupportsExtension("cl_khr_command_buffer")) {
     use_command_buffer_ = true;
     command_buffer_ = nullptr;
@@ -556,7 +567,8 @@ absl::Status InferenceContext::AllocateBufferBasedTensors(
   RETURN_IF_ERROR(GetBufferAssignment(
       gpu_model, create_info, gpu_info, &buffer_usage_records,
       &graph_ids_to_shared_buffer_tensors_, &buffer_assignment,
-      &offset_assignment, &use_offset_assignment, &is_sub_buffers_supported));
+      &offset_assignment, &use_offset_assignment, &is_sub_buffers_supported,
+      &intermediate_tensors_memory_strategy_));
   const size_t base_align_bytes =
       std::max<size_t>(gpu_info.opencl_info.base_addr_align_in_bits >> 3, 1);
 
@@ -564,6 +576,16 @@ absl::Status InferenceContext::AllocateBufferBasedTensors(
     return absl::OkStatus();
   }
 
+  uint64_t separate_size = 0;
+  for (const auto& usage_record : buffer_usage_records) {
+    separate_size += usage_record.tensor_size;
+  }
+  const uint64_t planned_size = use_offset_assignment
+                                    ? offset_assignment.total_size
+                                    : TotalSize(buffer_assignment);
+  intermediate_tensors_memory_savings_ =
+      separate_size > planned_size ? separate_size - planned_size : 0;
+
   if (use_offset_assignment) {
     if (!shared_buffers_parent_ptr_) {
       Buffer shared_buffer;
@@ -759,7 +781,8 @@ absl::Status InferenceContext::Compile(
 
 absl::Status InferenceContext::Tune(TuningType tuning_type,
                                     const GpuInfo& gpu_info,
-                                    ProfilingCommandQueue* profiling_queue) {
+                                    ProfilingCommandQueue* profiling_queue,
+                                    ProgramCache* program_cache) {
   // Cache tuned CL operations. Multiple CL operations might share the
   // same kernel but use different inputs, which might require different working
   // group setups. Therefore, we store a vector of tuned cl operations for each
@@ -786,8 +809,20 @@ absl::Status InferenceContext::Tune(TuningType tuning_type,
     if (found_cached_cl_op) {
       continue;
     }
-    RETURN_IF_ERROR(
-        node.cl_operation.Tune(tuning_type, gpu_info, profiling_queue));
+    // Work group sizes tuned by a previous initialization, possibly in
+    // another process, are restored with the serialized program cache.
+    GPUOperation& operation = node.cl_operation.GetGpuOperation();
+    const int3 grid_size = operation.GetCurrentGridSize();
+    if (program_cache->GetTunedWorkGroupSize(fingerprint, grid_size,
+                                             tuning_type,
+                                             &operation.work_group_size_)) {
+      operation.RecalculateWorkGroupsCount();
+    } else {
+      RETURN_IF_ERROR(
+          node.cl_operation.Tune(tuning_type, gpu_info, profiling_queue));
+      program_cache->AddTunedWorkGroupSize(fingerprint, grid_size, tuning_type,
+                                           operation.work_group_size_);
+    }
     tuned_ops[fingerprint].emplace_back(std::cref(node.cl_operation));
   }
   return absl::OkStatus();
@@ -806,7 +841,13 @@ absl::Status InferenceContext::SetTensor(const ValueId& tensor_id,
   if (it == external_mutable_tensors_.end()) {
     return absl::InvalidArgumentError("No external tensor with this id.");
   }
-  external_mutable_tensors_[tensor_id] = tensor_ptr;
+  if (it->second == tensor_ptr) {
+    return absl::OkStatus();
+  }
+  it->second = tensor_ptr;
+  // The recorded command buffer has the previous tensor bound, record it
+  // again on the next run.
+  command_buffer_ = nullptr;
   for (int node_index : external_tensor_to_nodes_[tensor_id]) {
     auto& node = nodes_[node_index];
     for (int i = 0; i < node.inputs.size(); ++i) {
@@ -846,14 +887,12 @@ void InferenceContext::PrepareExternal() {
   }
 }
 
-absl::Status InferenceContext::AddCommandBufferToQueue(CLCommandQueue* queue) {
-  if (command_buffer_ == nullptr) {
-    command_buffer_ = std::make_unique<CLCommandBuffer>();
-    RETURN_IF_ERROR(command_buffer_->Init(queue));
-    RETURN_IF_ERROR(AddToCommandBuffer(command_buffer_->GetCommandBuffer()));
-    RETURN_IF_ERROR(command_buffer_->Finalize());
-  }
-  RETURN_IF_ERROR(command_buffer_->Enqueue(queue));
+absl::Status InferenceContext::RecordCommandBuffer(CLCommandQueue* queue) {
+  auto command_buffer = std::make_unique<CLCommandBuffer>();
+  RETURN_IF_ERROR(command_buffer->Init(queue));
+  RETURN_IF_ERROR(AddToCommandBuffer(command_buffer->GetCommandBuffer()));
+  RETURN_IF_ERROR(command_buffer->Finalize());
+  command_buffer_ = std::move(command_buffer);
   return absl::OkStatus();
 }
 
@@ -874,8 +913,14 @@ absl::Status InferenceContext::AddToQueue(CLCommandQueue* queue) {
     RETURN_IF_ERROR(
         queue->EnqueueEvent(&execution_hints_.prev_enqueue_start_point));
   }
+  if (use_command_buffer_ && command_buffer_ == nullptr &&
+      !RecordCommandBuffer(queue).ok()) {
+    // Some drivers advertise the extension but fail to record the kernels,
+    // enqueue them one by one from now on.
+    use_command_buffer_ = false;
+  }
   if (use_command_buffer_) {
-    RETURN_IF_ERROR(AddCommandBufferToQueue(queue));
+    RETURN_IF_ERROR(command_buffer_->Enqueue(queue));
   } else {
     int counter = 0;
     for (auto& node : nodes_) {
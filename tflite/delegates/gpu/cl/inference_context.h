@@ -35,6 +35,7 @@ limitations under the License.
 #include "tflite/delegates/gpu/cl/serialization_generated.h"
 #include "tflite/delegates/gpu/cl/tensor.h"
 #include "tflite/delegates/gpu/common/gpu_model.h"
+#include "tflite/delegates/gpu/common/memory_management.h"
 #include "tflite/delegates/gpu/common/model.h"
 #include "tflite/delegates/gpu/common/model_hints.h"
 #include "tflite/delegates/gpu/common/precision.h"
@@ -90,6 +91,14 @@ class InferenceContext {
   // for profiling and memory statistics
   uint64_t GetSizeOfMemoryAllocatedForIntermediateTensors() const;
   uint64_t GetConstantTensorsSize() const;
+  // The strategy that planned the memory of the buffer based intermediate
+  // tensors, and the bytes it saves compared to allocating them separately.
+  MemoryStrategy GetIntermediateTensorsMemoryStrategy() const {
+    return intermediate_tensors_memory_strategy_;
+  }
+  uint64_t GetIntermediateTensorsMemorySavings() const {
+    return intermediate_tensors_memory_savings_;
+  }
 
   absl::Status SetInputTensor(ValueId id, const TensorFloat32& tensor,
                               CLCommandQueue* queue);
@@ -118,7 +127,8 @@ class InferenceContext {
       flatbuffers::Offset<tflite::gpu::data::GpuModel> gpu_model_fb,
       flatbuffers::FlatBufferBuilder* builder);
 
-  void InitFromGpuModel(const GpuInfo& gpu_info, GpuModel* gpu_model);
+  void InitFromGpuModel(const GpuInfo& gpu_info, const ModelHints& hints,
+                        GpuModel* gpu_model);
 
   absl::Status AllocateMemory(const GpuModel& gpu_model,
                               const GpuInfo& gpu_info,
@@ -143,7 +153,8 @@ class InferenceContext {
   void BindMemoryToOperations();
   absl::Status Compile(const CreationContext& creation_context);
   absl::Status Tune(TuningType tuning_type, const GpuInfo& gpu_info,
-                    ProfilingCommandQueue* profiling_queue);
+                    ProfilingCommandQueue* profiling_queue,
+                    ProgramCache* program_cache);
   absl::Status UpdateParams();
   void PrepareExternal();
 
@@ -157,7 +168,8 @@ class InferenceContext {
   absl::Status ClarifyTimeWithCommandBuffer(ProfilingCommandQueue* queue,
                                             ProfilingInfo* result);
 
-  absl::Status AddCommandBufferToQueue(CLCommandQueue* queue);
+  // Records the kernels of all the nodes in `command_buffer_`.
+  absl::Status RecordCommandBuffer(CLCommandQueue* queue);
 
   struct ExecutionHints {
     bool need_flush = false;
@@ -202,11 +214,17 @@ class InferenceContext {
   std::map<ValueId, Tensor> strong_shape_tensors_;
   std::map<ValueId, ValueId> graph_ids_to_strong_shape_tensors_;
 
+  MemoryStrategy intermediate_tensors_memory_strategy_ = MemoryStrategy::NAIVE;
+  uint64_t intermediate_tensors_memory_savings_ = 0;
+
   std::vector<ValueId> input_ids_;
   std::vector<ValueId> output_ids_;
 
   std::unique_ptr<RecordableQueue> recordable_queue_ = nullptr;
 
+  // Whether the nodes are replayed from `command_buffer_` rather than
+  // enqueued individually. The command buffer is recorded on the first run
+  // and again after the external tensors bound to them change.
   bool use_command_buffer_ = false;
   std::unique_ptr<CLCommandBuffer> command_buffer_ = nullptr;
 
@@ -55,6 +55,11 @@ TEST_F(OpenCLOperationTest, FullyConnectedInt8) {
   ASSERT_TRUE(status.ok()) << status.message();
 }
 
+TEST_F(OpenCLOperationTest, FullyConnectedPerChannelInt8) {
+  auto status = FullyConnectedPerChannelInt8Test(&exec_env_);
+  ASSERT_TRUE(status.ok()) << status.message();
+}
+
 TEST_F(OpenCLOperationTest, RearrageWeights) {
   tflite::gpu::Tensor<OHWI, DataType::FLOAT32> weights;
   weights.shape = OHWI(8, 1, 1, 8);
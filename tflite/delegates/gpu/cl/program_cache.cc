@@ -23,7 +23,10 @@ limitations under the License.
 #include "tflite/delegates/gpu/cl/cl_program.h"
 #include "tflite/delegates/gpu/cl/compiled_program_cache_generated.h"
 #include "tflite/delegates/gpu/cl/util.h"
+#include "tflite/delegates/gpu/common/gpu_info.h"
 #include "tflite/delegates/gpu/common/status.h"
+#include "tflite/delegates/gpu/common/task/tuning_type.h"
+#include "tflite/delegates/gpu/common/types.h"
 #include <farmhash.h>
 
 namespace tflite {
@@ -58,6 +61,12 @@ std::string GetDriverVersion(const CLDevice& device) {
   return device.GetPlatformVersion() + "_jet_version_0";
 }
 
+// Work group sizes are tuned for a device, with a driver.
+std::string GetTuningDevice(const CLDevice& device) {
+  const OpenClInfo& info = device.GetInfo().opencl_info;
+  return info.device_name + "_" + info.driver_version;
+}
+
 }  // namespace
 
 ProgramCache::ProgramDescriptor::ProgramDescriptor(
@@ -68,11 +77,13 @@ ProgramCache::ProgramDescriptor::ProgramDescriptor(uint64_t fingerprints)
     : fingerprint(fingerprints) {}
 
 ProgramCache::ProgramCache(ProgramCache&& program_cache)
-    : programs_(std::move(program_cache.programs_)) {}
+    : programs_(std::move(program_cache.programs_)),
+      tuned_work_groups_(std::move(program_cache.tuned_work_groups_)) {}
 
 ProgramCache& ProgramCache::operator=(ProgramCache&& program_cache) {
   if (this != &program_cache) {
     programs_ = std::move(program_cache.programs_);
+    tuned_work_groups_ = std::move(program_cache.tuned_work_groups_);
   }
   return *this;
 }
@@ -170,6 +181,19 @@ absl::Status ProgramCache::AddSerializedCache(
     RETURN_IF_ERROR(AddProgramBinary(
         context, device, serialized_program->fingerprint(), binary_span));
   }
+
+  if (model->tuned_work_groups() && model->tuning_device() &&
+      model->tuning_device()->str() == GetTuningDevice(device)) {
+    for (auto tuned : *model->tuned_work_groups()) {
+      AddTunedWorkGroupSize(
+          tuned->kernel_fingerprint(),
+          int3(tuned->grid_size_x(), tuned->grid_size_y(),
+               tuned->grid_size_z()),
+          tuned->exhaustive() ? TuningType::kExhaustive : TuningType::kFast,
+          int3(tuned->work_group_size_x(), tuned->work_group_size_y(),
+               tuned->work_group_size_z()));
+    }
+  }
   return absl::OkStatus();
 }
 
@@ -186,11 +210,23 @@ absl::Status ProgramCache::GetSerializedCache(
     program_builder.add_binary(binary_offset);
     serialized_programs.push_back(program_builder.Finish());
   }
+  std::vector<flatbuffers::Offset<data::TunedWorkGroup>> serialized_tuned;
+  for (const auto& [key, tuned] : tuned_work_groups_) {
+    const auto& [fingerprint, grid_x, grid_y, grid_z] = key;
+    serialized_tuned.push_back(data::CreateTunedWorkGroup(
+        builder, fingerprint, grid_x, grid_y, grid_z,
+        tuned.work_group_size.x, tuned.work_group_size.y,
+        tuned.work_group_size.z, tuned.exhaustive));
+  }
   auto driver_version = builder.CreateString(GetDriverVersion(device));
   auto programs_s = builder.CreateVector(serialized_programs);
+  auto tuning_device = builder.CreateString(GetTuningDevice(device));
+  auto tuned_s = builder.CreateVector(serialized_tuned);
   data::CompiledCacheBuilder cache_builder(builder);
   cache_builder.add_driver_version(driver_version);
   cache_builder.add_programs(programs_s);
+  cache_builder.add_tuning_device(tuning_device);
+  cache_builder.add_tuned_work_groups(tuned_s);
   data::FinishCompiledCacheBuffer(builder, cache_builder.Finish());
   size_t next_element = serialized_cache->size();
   serialized_cache->resize(serialized_cache->size() + builder.GetSize());
@@ -199,6 +235,34 @@ absl::Status ProgramCache::GetSerializedCache(
   return absl::OkStatus();
 }
 
+bool ProgramCache::GetTunedWorkGroupSize(uint64_t kernel_fingerprint,
+                                         const int3& grid_size,
+                                         TuningType tuning_type,
+                                         int3* work_group_size) const {
+  auto it = tuned_work_groups_.find(
+      {kernel_fingerprint, grid_size.x, grid_size.y, grid_size.z});
+  if (it == tuned_work_groups_.end() ||
+      (tuning_type == TuningType::kExhaustive && !it->second.exhaustive)) {
+    return false;
+  }
+  *work_group_size = it->second.work_group_size;
+  return true;
+}
+
+void ProgramCache::AddTunedWorkGroupSize(uint64_t kernel_fingerprint,
+                                         const int3& grid_size,
+                                         TuningType tuning_type,
+                                         const int3& work_group_size) {
+  const TunedWorkGroup tuned{work_group_size,
+                             tuning_type == TuningType::kExhaustive};
+  auto [it, inserted] = tuned_work_groups_.try_emplace(
+      {kernel_fingerprint, grid_size.x, grid_size.y, grid_size.z}, tuned);
+  // Never replace an exhaustively tuned work group with a faster guess.
+  if (!inserted && (tuned.exhaustive || !it->second.exhaustive)) {
+    it->second = tuned;
+  }
+}
+
 }  // namespace cl
 }  // namespace gpu
 }  // namespace tflite
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <cstdint>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
@@ -27,6 +28,8 @@ limitations under the License.
 #include "tflite/delegates/gpu/cl/cl_kernel.h"
 #include "tflite/delegates/gpu/cl/cl_program.h"
 #include "tflite/delegates/gpu/common/status.h"
+#include "tflite/delegates/gpu/common/task/tuning_type.h"
+#include "tflite/delegates/gpu/common/types.h"
 
 namespace tflite {
 namespace gpu {
@@ -68,6 +71,17 @@ class ProgramCache {
   absl::Status GetSerializedCache(const CLDevice& device,
                                   std::vector<uint8_t>* serialized_cache) const;
 
+  // Returns true and the work group size the kernel with `kernel_fingerprint`
+  // was tuned to for `grid_size`, if it was tuned at least as thoroughly as
+  // `tuning_type` asks for. The tuned work groups are serialized with the
+  // programs, and only restored on the device and driver they were tuned on.
+  bool GetTunedWorkGroupSize(uint64_t kernel_fingerprint, const int3& grid_size,
+                             TuningType tuning_type,
+                             int3* work_group_size) const;
+  void AddTunedWorkGroupSize(uint64_t kernel_fingerprint, const int3& grid_size,
+                             TuningType tuning_type,
+                             const int3& work_group_size);
+
  private:
   struct ProgramDescriptor {
     ProgramDescriptor() = default;
@@ -92,6 +106,14 @@ class ProgramCache {
   absl::flat_hash_map<ProgramDescriptor, CLProgram, ProgramDescriptorHasher,
                       ProgramDescriptorEqual>
       programs_;
+
+  struct TunedWorkGroup {
+    int3 work_group_size;
+    bool exhaustive;
+  };
+  // Kernel fingerprint and grid size.
+  using TunedWorkGroupKey = std::tuple<uint64_t, int, int, int>;
+  absl::flat_hash_map<TunedWorkGroupKey, TunedWorkGroup> tuned_work_groups_;
 };
 
 }  // namespace cl
@@ -30,6 +30,7 @@ limitations under the License.
 #include "tflite/delegates/gpu/cl/environment.h"
 #include "tflite/delegates/gpu/cl/inference_context.h"
 #include "tflite/delegates/gpu/cl/opencl_wrapper.h"
+#include "tflite/delegates/gpu/common/memory_management.h"
 #include "tflite/delegates/gpu/common/model.h"
 #include "tflite/delegates/gpu/common/model_builder.h"
 #include "tflite/delegates/gpu/common/status.h"
@@ -306,6 +307,11 @@ absl::Status RunModelSample(const std::string& model_name) {
       context.GetSizeOfMemoryAllocatedForIntermediateTensors();
   std::cout << "Memory for intermediate tensors - "
             << runtime_mem_bytes / 1024.0 / 1024.0 << " MB" << std::endl;
+  std::cout << "Intermediate buffers planned with "
+            << ToString(context.GetIntermediateTensorsMemoryStrategy())
+            << ", saving "
+            << context.GetIntermediateTensorsMemorySavings() / 1024.0 / 1024.0
+            << " MB" << std::endl;
   const uint64_t const_mem_bytes = context.GetConstantTensorsSize();
   std::cout << "Memory for constant tensors - "
             << const_mem_bytes / 1024.0 / 1024.0 << " MB" << std::endl;
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <cstddef>
 #include <numeric>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -30,6 +31,7 @@ limitations under the License.
 #include "tflite/delegates/gpu/common/shape.h"
 #include "tflite/delegates/gpu/common/status.h"
 #include "tflite/delegates/gpu/common/types.h"
+#include "tflite/delegates/gpu/common/util.h"
 
 namespace tflite {
 namespace gpu {
@@ -43,13 +45,15 @@ size_t TotalSize(const ObjectsAssignment<size_t>& assignment) {
 }  // namespace
 
 OffsetsAssignment ObjectsToOffsets(
-    const ObjectsAssignment<size_t>& obj_assignment) {
+    const ObjectsAssignment<size_t>& obj_assignment,
+    size_t base_addr_align_bytes) {
   size_t num_tensors = obj_assignment.object_ids.size();
   size_t num_objects = obj_assignment.object_sizes.size();
   OffsetsAssignment result = {/*offsets=*/std::vector<size_t>(num_tensors),
                               /*total_size=*/0};
   std::vector<size_t> ids_to_offset(num_objects);
   for (size_t i = 0; i < num_objects; ++i) {
+    result.total_size = AlignByN(result.total_size, base_addr_align_bytes);
     ids_to_offset[i] = result.total_size;
     result.total_size += obj_assignment.object_sizes[i];
   }
@@ -59,15 +63,69 @@ OffsetsAssignment ObjectsToOffsets(
   return result;
 }
 
+std::string ToString(MemoryStrategy strategy) {
+  switch (strategy) {
+    case MemoryStrategy::NAIVE:
+      return "NAIVE";
+    case MemoryStrategy::EQUALITY:
+      return "EQUALITY";
+    case MemoryStrategy::GREEDY_IN_ORDER:
+      return "GREEDY_IN_ORDER";
+    case MemoryStrategy::GREEDY_BY_BREADTH:
+      return "GREEDY_BY_BREADTH";
+    case MemoryStrategy::GREEDY_BY_SIZE:
+      return "GREEDY_BY_SIZE";
+    case MemoryStrategy::GREEDY_BEST:
+      return "GREEDY_BEST";
+    case MemoryStrategy::MINCOSTFLOW:
+      return "MINCOSTFLOW";
+  }
+  return "UNKNOWN";
+}
+
 absl::Status BestGreedy(
     const std::vector<TensorUsageRecord<size_t>>& usage_records,
-    ObjectsAssignment<size_t>* assignment) {
+    ObjectsAssignment<size_t>* assignment, MemoryStrategy* strategy) {
   RETURN_IF_ERROR(
       GreedyBySizeDistPriorityAssignment(usage_records, assignment));
+  MemoryStrategy best_strategy = MemoryStrategy::GREEDY_BY_SIZE;
   ObjectsAssignment<size_t> assignment_by_breadth;
   if (GreedyByBreadthAssignment(usage_records, &assignment_by_breadth).ok() &&
       TotalSize(assignment_by_breadth) < TotalSize(*assignment)) {
     std::swap(*assignment, assignment_by_breadth);
+    best_strategy = MemoryStrategy::GREEDY_BY_BREADTH;
+  }
+  ObjectsAssignment<size_t> assignment_in_order;
+  if (GreedyInOrderAssignment(usage_records, &assignment_in_order).ok() &&
+      TotalSize(assignment_in_order) < TotalSize(*assignment)) {
+    std::swap(*assignment, assignment_in_order);
+    best_strategy = MemoryStrategy::GREEDY_IN_ORDER;
+  }
+  if (strategy) {
+    *strategy = best_strategy;
+  }
+  return absl::OkStatus();
+}
+
+absl::Status BestGreedyOffsets(
+    const std::vector<TensorUsageRecord<size_t>>& usage_records,
+    size_t base_addr_align_bytes, OffsetsAssignment* assignment,
+    MemoryStrategy* strategy) {
+  RETURN_IF_ERROR(
+      GreedyBySizeAssignment(usage_records, base_addr_align_bytes, assignment));
+  MemoryStrategy best_strategy = MemoryStrategy::GREEDY_BY_SIZE;
+  ObjectsAssignment<size_t> objects_assignment;
+  MemoryStrategy objects_strategy;
+  if (BestGreedy(usage_records, &objects_assignment, &objects_strategy).ok()) {
+    OffsetsAssignment objects_offsets =
+        ObjectsToOffsets(objects_assignment, base_addr_align_bytes);
+    if (objects_offsets.total_size < assignment->total_size) {
+      std::swap(*assignment, objects_offsets);
+      best_strategy = objects_strategy;
+    }
+  }
+  if (strategy) {
+    *strategy = best_strategy;
   }
   return absl::OkStatus();
 }
@@ -163,10 +221,13 @@ absl::Status AssignOffsetsToTensors(
     return GreedyBySizeAssignment(usage_records, base_addr_align_bytes,
                                   assignment);
   }
+  if (strategy == MemoryStrategy::GREEDY_BEST) {
+    return BestGreedyOffsets(usage_records, base_addr_align_bytes, assignment);
+  }
   ObjectsAssignment<size_t> objects_assignment;
   RETURN_IF_ERROR(AssignObjectsToTensors(
       usage_records, strategy, &objects_assignment, reallocation_graph));
-  *assignment = ObjectsToOffsets(objects_assignment);
+  *assignment = ObjectsToOffsets(objects_assignment, base_addr_align_bytes);
   return absl::OkStatus();
 }
 
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <stddef.h>
 
+#include <string>
 #include <vector>
 
 #include "absl/memory/memory.h"
@@ -34,9 +35,11 @@ namespace gpu {
 using TaskId = size_t;
 
 // Converts given assignment of tensors to shared objects to the assignment of
-// the same tensors to offsets in continuous memory block.
+// the same tensors to offsets in continuous memory block. Offsets of the
+// objects are aligned to base_addr_align_bytes.
 OffsetsAssignment ObjectsToOffsets(
-    const ObjectsAssignment<size_t>& obj_assignment);
+    const ObjectsAssignment<size_t>& obj_assignment,
+    size_t base_addr_align_bytes = 1);
 
 enum class MemoryStrategy {
   // Naive strategy is to allocate each object separately.
@@ -64,7 +67,8 @@ enum class MemoryStrategy {
   GREEDY_BY_SIZE,
 
   // Choose greedy strategy from several fast algorithms, that provides best
-  // memory allocation for the given usage records.
+  // memory allocation for the given usage records. For offsets, the objects
+  // assignments of these algorithms compete with the GREEDY_BY_SIZE offsets.
   GREEDY_BEST,
 
   // Mincostflow strategy consists of building auxiliary flow graph and solving
@@ -73,11 +77,24 @@ enum class MemoryStrategy {
   MINCOSTFLOW,
 };
 
+std::string ToString(MemoryStrategy strategy);
+
 // Chooses greedy algorithm with the lowest memory consumption for given usage
-// records and returns corresponding shared objects assignment.
+// records and returns corresponding shared objects assignment. If `strategy`
+// is not null, it is set to the chosen algorithm.
 absl::Status BestGreedy(
     const std::vector<TensorUsageRecord<size_t>>& usage_records,
-    ObjectsAssignment<size_t>* assignment);
+    ObjectsAssignment<size_t>* assignment,
+    MemoryStrategy* strategy = nullptr);
+
+// Chooses the assignment of tensors to offsets with the lowest total size,
+// among the GREEDY_BY_SIZE one and the ones of the greedy objects
+// assignments. If `strategy` is not null, it is set to the algorithm that
+// produced it.
+absl::Status BestGreedyOffsets(
+    const std::vector<TensorUsageRecord<size_t>>& usage_records,
+    size_t base_addr_align_bytes, OffsetsAssignment* assignment,
+    MemoryStrategy* strategy = nullptr);
 
 // Calculates the assignment of shared objects to given tensors, including
 // objects' sizes. Below there are specializations for different types, that
@@ -60,6 +60,16 @@ TEST(Model, ManyObjectsAssignment) {
   EXPECT_THAT(result.offsets, ElementsAre(24, 0, 24, 16, 56, 56, 16, 92));
 }
 
+TEST(Model, ManyObjectsAssignmentWithAlignment) {
+  ObjectsAssignment<size_t> objects_assignment;
+  objects_assignment.object_sizes = {16, 8, 64};
+  objects_assignment.object_ids = {0, 1, 2, 1};
+  OffsetsAssignment result =
+      ObjectsToOffsets(objects_assignment, /*base_addr_align_bytes=*/32);
+  EXPECT_THAT(result.offsets, ElementsAre(0, 32, 64, 32));
+  EXPECT_EQ(result.total_size, 128);
+}
+
 TEST(Model, EmptyRecords) {
   ObjectsAssignment<size_t> assignment;
   ASSERT_TRUE(
@@ -399,6 +409,37 @@ TEST(Model, OffsetAssignmentWithAlignment) {
   EXPECT_EQ(offsets_assignment.total_size, 160);
 }
 
+TEST(Model, BestGreedyReportsStrategy) {
+  std::vector<TensorUsageRecord<size_t>> usage_records{
+      {/*size=*/16, /*first=*/0, /*last=*/1},
+      {/*size=*/8, /*first=*/1, /*last=*/2},
+      {/*size=*/64, /*first=*/2, /*last=*/3},
+      {/*size=*/32, /*first=*/3, /*last=*/4},
+      {/*size=*/8, /*first=*/4, /*last=*/5},
+  };
+
+  ObjectsAssignment<size_t> assignment;
+  MemoryStrategy strategy = MemoryStrategy::NAIVE;
+  ASSERT_TRUE(BestGreedy(usage_records, &assignment, &strategy).ok());
+  EXPECT_EQ(strategy, MemoryStrategy::GREEDY_BY_SIZE);
+  EXPECT_THAT(assignment.object_sizes, ElementsAre(64, 32));
+
+  OffsetsAssignment offsets_assignment;
+  strategy = MemoryStrategy::NAIVE;
+  ASSERT_TRUE(BestGreedyOffsets(usage_records, /*base_addr_align_bytes=*/128,
+                                &offsets_assignment, &strategy)
+                  .ok());
+  EXPECT_EQ(strategy, MemoryStrategy::GREEDY_BY_SIZE);
+  EXPECT_EQ(offsets_assignment.total_size, 160);
+
+  ASSERT_TRUE(AssignOffsetsToTensors(usage_records,
+                                     MemoryStrategy::GREEDY_BEST,
+                                     &offsets_assignment,
+                                     /*base_addr_align_bytes=*/128)
+                  .ok());
+  EXPECT_EQ(offsets_assignment.total_size, 160);
+}
+
 }  // namespace
 }  // namespace gpu
 }  // namespace tflite
@@ -79,6 +79,60 @@ absl::Status GetFullyConnectedAttributes(int weights_tensor_id,
   return absl::OkStatus();
 }
 
+// Returns whether the weights are constant int8 values quantized per tensor
+// or symmetrically per output channel, which FULLY_CONNECTED_INT8 keeps
+// quantized on the GPU.
+bool IsInt8FullyConnectedWeights(const TfLiteTensor& weights) {
+  if (weights.type != kTfLiteInt8 || !IsConstantTensor(&weights) ||
+      weights.sparsity != nullptr || weights.dims->size != 2 ||
+      weights.quantization.type != kTfLiteAffineQuantization) {
+    return false;
+  }
+  const auto* quant_params = static_cast<const TfLiteAffineQuantization*>(
+      weights.quantization.params);
+  if (quant_params->scale->size == 1) {
+    return true;
+  }
+  if (quant_params->quantized_dimension != 0 ||
+      quant_params->scale->size != weights.dims->data[0]) {
+    return false;
+  }
+  for (int i = 0; i < quant_params->zero_point->size; ++i) {
+    if (quant_params->zero_point->data[i] != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+absl::Status GetFullyConnectedInt8Attributes(
+    int weights_tensor_id, int bias_tensor_id, ObjectReader* reader,
+    FullyConnectedInt8Attributes* attr) {
+  const TfLiteTensor* weights = reader->GetInputTensor(weights_tensor_id);
+  const auto* quant_params = static_cast<const TfLiteAffineQuantization*>(
+      weights->quantization.params);
+  attr->weights.shape =
+      OHWI(weights->dims->data[0], 1, 1, weights->dims->data[1]);
+  attr->weights.data.assign(weights->data.int8,
+                            weights->data.int8 + NumElements(weights));
+  int tensor_id;
+  RETURN_IF_ERROR(reader->GetTensorId(weights_tensor_id, &tensor_id));
+  attr->weights.id = tensor_id;
+  if (quant_params->scale->size == 1) {
+    attr->scale = quant_params->scale->data[0];
+    attr->zero_point = quant_params->zero_point->data[0];
+  } else {
+    attr->scale = 0.0f;
+    attr->zero_point = 0;
+    attr->per_channel_scales.shape = Linear(quant_params->scale->size);
+    attr->per_channel_scales.data.assign(
+        quant_params->scale->data,
+        quant_params->scale->data + quant_params->scale->size);
+  }
+  reader->ReadTensor(bias_tensor_id, &attr->bias).IgnoreError();  // optional
+  return absl::OkStatus();
+}
+
 template <typename ParamsT>
 absl::Status RetrieveBuiltinData(const TfLiteNode* tflite_node,
                                  const ParamsT** tf_options) {
@@ -1352,10 +1406,28 @@ class FullyConnectedOperationParser : public TFLiteOperationParser {
           "Unsupported FullyConnected weights format.");
     }
 
+    auto input = graph->FindInputs(node->id)[0];
+    if (input->tensor.shape.h == 1 && input->tensor.shape.w == 1 &&
+        IsInt8FullyConnectedWeights(*reader->GetInputTensor(1))) {
+      // Keeps the weights quantized, so that they take a byte per value on
+      // the GPU and are dequantized by the kernel.
+      FullyConnectedInt8Attributes attr;
+      RETURN_IF_ERROR(GetFullyConnectedInt8Attributes(1, 2, reader, &attr));
+      if (input->tensor.shape.c != attr.weights.shape.i) {
+        return absl::UnimplementedError(
+            "Amount of input channels should match weights width");
+      }
+      node->operation.type = ToString(OperationType::FULLY_CONNECTED_INT8);
+      node->operation.attributes = std::move(attr);
+      RETURN_IF_ERROR(reader->AddOutputs(node));
+      RETURN_IF_ERROR(
+          MaybeFuseActivation(tf_options->activation, graph, node));
+      return absl::OkStatus();
+    }
+
     FullyConnectedAttributes attr;
     RETURN_IF_ERROR(GetFullyConnectedAttributes(1, 2, reader, &attr));
 
-    auto input = graph->FindInputs(node->id)[0];
     if (input->tensor.shape.c != attr.weights.shape.i) {
       return absl::UnimplementedError(
           "Amount of input channels should match weights width");
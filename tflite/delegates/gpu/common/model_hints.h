@@ -46,6 +46,11 @@ struct ModelHints {
   // Can decrease constant memory usage(if model has the same weights).
   static constexpr ModelHint kReuseConvWeights = 0x00000001 << 4;
 
+  // By default, when the device supports command buffers, the kernels of the
+  // inference are recorded once in a command buffer that is replayed on every
+  // run, which saves enqueueing them one by one. This hint disables it.
+  static constexpr ModelHint kNoCommandBuffer = 0x00000001 << 5;
+
   void Add(ModelHint hint) {
     if (hint == kFastestInference) {
       hints = kFastestInference;
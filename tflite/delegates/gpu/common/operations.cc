@@ -868,6 +868,16 @@ FullyConnectedAttributes DequatizeFullyConnectedAttr(
   dequant_attr.bias = attr.bias;
 
   // weights dequantization to float32
+  if (!attr.per_channel_scales.data.empty()) {
+    for (int o = 0; o < attr.weights.shape.o; ++o) {
+      const float scale = attr.per_channel_scales.data[o];
+      for (int i = 0; i < attr.weights.shape.i; ++i) {
+        const int index = attr.weights.shape.LinearIndex({o, 0, 0, i});
+        dequant_attr.weights.data[index] = scale * attr.weights.data[index];
+      }
+    }
+    return dequant_attr;
+  }
   for (int i = 0; i < attr.weights.data.size(); i++) {
     const int32_t val = attr.weights.data[i];
     dequant_attr.weights.data[i] = attr.scale * (val - attr.zero_point);
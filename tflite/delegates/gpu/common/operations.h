@@ -560,6 +560,9 @@ struct FullyConnectedInt8Attributes {
   Tensor<Linear, DataType::FLOAT32> bias;
   float scale;
   int zero_point;
+  // Scales of the output channels of symmetrically quantized weights. When it
+  // is not empty, `scale` and `zero_point` are not used.
+  Tensor<Linear, DataType::FLOAT32> per_channel_scales;
 };
 
 FullyConnectedAttributes DequatizeFullyConnectedAttr(
@@ -41,7 +41,13 @@ std::unique_ptr<GPUOperation> SelectFullyConnected(
 
 std::unique_ptr<GPUOperation> SelectFullyConnected(
     const FullyConnectedInt8Attributes& attr, const GpuInfo& gpu_info,
-    const OperationDef& op_def) {
+    const OperationDef& op_def, int batch_size) {
+  // The quantized weights are kept in a texture and the kernel reads a single
+  // batch, so the other cases use the dequantized weights.
+  if (op_def.IsBatchSupported() || !gpu_info.SupportsImages()) {
+    return SelectFullyConnected(DequatizeFullyConnectedAttr(attr), gpu_info,
+                                op_def, batch_size);
+  }
   FullyConnected fc = CreateFullyConnected(gpu_info, op_def, attr);
   return std::make_unique<FullyConnected>(std::move(fc));
 }
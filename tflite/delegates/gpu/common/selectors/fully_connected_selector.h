@@ -31,7 +31,7 @@ std::unique_ptr<GPUOperation> SelectFullyConnected(
 
 std::unique_ptr<GPUOperation> SelectFullyConnected(
     const FullyConnectedInt8Attributes& attr, const GpuInfo& gpu_info,
-    const OperationDef& op_def);
+    const OperationDef& op_def, int batch_size);
 
 }  // namespace gpu
 }  // namespace tflite
@@ -624,7 +624,10 @@ absl::Status GPUOperationFromNodePart0(
     case OperationType::FULLY_CONNECTED_INT8: {
       auto attr = absl::any_cast<FullyConnectedInt8Attributes>(
           node.operation.attributes);
-      *gpu_op = SelectFullyConnected(attr, gpu_info, op_def);
+      *gpu_op = SelectFullyConnected(attr, gpu_info, op_def,
+                                     inputs[0]->tensor.shape.b);
+      (*gpu_op)->flops_ =
+          GetFullyConnectedFlops(outputs[0]->tensor.shape, attr.weights.shape);
       return absl::OkStatus();
     }
     case OperationType::GATHER: {
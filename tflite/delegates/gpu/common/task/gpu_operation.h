@@ -116,6 +116,8 @@ class GPUOperation {
   const std::vector<GpuSpatialTensor*>& GetSrcTensors() const { return src_; }
   const std::vector<GpuSpatialTensor*>& GetDstTensors() const { return dst_; }
   const int3& GetWorkGroupsCount() const { return work_groups_count_; }
+  // The grid size from the last RecalculateGridSize() call.
+  const int3& GetCurrentGridSize() const { return grid_size_; }
 
   absl::Status AssembleCode(const GpuInfo& gpu_info);
 
@@ -27,6 +27,9 @@ namespace gpu {
 struct ProfilingInfo {
   struct DispatchInfo {
     std::string label;
+    // Device time between the start of the first dispatch and the start of
+    // this one, when the device reports it.
+    absl::Duration start;
     absl::Duration duration;
     uint64_t read_mem_size = 0;
     uint64_t write_mem_size = 0;
@@ -110,7 +110,7 @@ FullyConnected& FullyConnected::operator=(FullyConnected&& kernel) {
 
 std::string FullyConnected::GetFullyConnectedKernelCode(
     const OperationDef& op_def, const GpuInfo& gpu_info,
-    bool weights_are_buffer, bool quantized) {
+    bool weights_are_buffer, bool quantized, bool per_channel_scales) {
   const int wg_total_size = work_group_size_.x * work_group_size_.y;
   const std::string barrier =
       wg_total_size == 32 && gpu_info.IsWaveSizeEqualTo32()
@@ -129,7 +129,13 @@ std::string FullyConnected::GetFullyConnectedKernelCode(
   int2 tid = INIT_INT2v2(LOCAL_ID_0, LOCAL_ID_1);
   ACCUM_FLT4 s = INIT_ACCUM_FLT4(0.0f);
   if (gid < args.dst_tensor.Slices()) {
-    for (int c = tid.y; c < args.src_tensor.Slices(); c += WG_Y) {
+)";
+  if (per_channel_scales) {
+    c += R"(    FLT4 q0 = args.scales.Read(gid);
+    FLT4 q1 = q0 * INIT_FLT(-127.0f);
+)";
+  }
+  c += R"(    for (int c = tid.y; c < args.src_tensor.Slices(); c += WG_Y) {
       FLT4 v = args.src_tensor.Read(0, 0, c);
 )";
   if (weights_are_buffer) {
@@ -152,11 +158,12 @@ std::string FullyConnected::GetFullyConnectedKernelCode(
     c += "      FLT4 w3 = args.weights.Read<" + read_as_type +
          ">(c * 4 + 3, gid);\n";
     if (quantized) {
-      c += R"(w0 = w0 * args.q0 + args.q1;
-      w1 = w1 * args.q0 + args.q1;
-      w2 = w2 * args.q0 + args.q1;
-      w3 = w3 * args.q0 + args.q1;
-)";
+      const std::string q0 = per_channel_scales ? "q0" : "args.q0";
+      const std::string q1 = per_channel_scales ? "q1" : "args.q1";
+      for (int i = 0; i < 4; ++i) {
+        const std::string w = "w" + std::to_string(i);
+        c += "      " + w + " = " + w + " * " + q0 + " + " + q1 + ";\n";
+      }
     }
     c += R"(FLT4 partial = v.x * w0;
       partial += v.y * w1;
@@ -215,6 +222,27 @@ void FullyConnected::UploadQuantizedWeights(
                   std::make_unique<TensorDescriptor>(std::move(desc)));
 }
 
+void FullyConnected::UploadPerChannelQuantizedWeights(
+    const GpuInfo& gpu_info,
+    const tflite::gpu::Tensor<OHWI, DataType::INT8>& weights,
+    const tflite::gpu::Tensor<Linear, DataType::FLOAT32>& scales) {
+  const int src_depth = DivideRoundUp(weights.shape.i, 4);
+  const int dst_depth = DivideRoundUp(weights.shape.o, 4);
+
+  std::vector<uint8_t> data(src_depth * 4 * dst_depth * 4);
+  RearrangeFCWeightsToOIO4I4(weights, data.data());
+  TensorDescriptor desc = CreateConstantHWVec4TensorDescriptor(
+      DataType::UINT8, TensorStorageType::TEXTURE_2D, src_depth * 4, dst_depth,
+      data.data());
+  args_.AddObject("weights",
+                  std::make_unique<TensorDescriptor>(std::move(desc)));
+
+  TensorDescriptor scales_desc = CreateConstantLinearTensorDescriptor(
+      gpu_info, definition_.src_tensors[0].GetDataType(), scales);
+  args_.AddObject("scales",
+                  std::make_unique<TensorDescriptor>(std::move(scales_desc)));
+}
+
 FullyConnected CreateFullyConnected(const GpuInfo& gpu_info,
                                     const OperationDef& definition,
                                     const FullyConnectedAttributes& attr) {
@@ -235,9 +263,15 @@ FullyConnected CreateFullyConnected(const GpuInfo& gpu_info,
                                     const OperationDef& definition,
                                     const FullyConnectedInt8Attributes& attr) {
   FullyConnected result(definition, gpu_info);
-  result.UploadQuantizedWeights(attr.weights, attr.scale, attr.zero_point);
-  result.code_ =
-      result.GetFullyConnectedKernelCode(definition, gpu_info, false, true);
+  const bool per_channel_scales = !attr.per_channel_scales.data.empty();
+  if (per_channel_scales) {
+    result.UploadPerChannelQuantizedWeights(gpu_info, attr.weights,
+                                            attr.per_channel_scales);
+  } else {
+    result.UploadQuantizedWeights(attr.weights, attr.scale, attr.zero_point);
+  }
+  result.code_ = result.GetFullyConnectedKernelCode(
+      definition, gpu_info, false, true, per_channel_scales);
 
   TensorDescriptor bias_tensor_desc = CreateConstantLinearTensorDescriptor(
       gpu_info, definition.src_tensors[0].GetDataType(), attr.bias);
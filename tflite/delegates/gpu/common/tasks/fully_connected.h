@@ -147,6 +147,12 @@ class FullyConnected : public GPUOperation {
   void UploadQuantizedWeights(
       const tflite::gpu::Tensor<OHWI, DataType::INT8>& weights, float scale,
       float zero_point);
+  // Uploads weights quantized with a scale per output channel, which the
+  // kernel reads together with each slice of the weights.
+  void UploadPerChannelQuantizedWeights(
+      const GpuInfo& gpu_info,
+      const tflite::gpu::Tensor<OHWI, DataType::INT8>& weights,
+      const tflite::gpu::Tensor<Linear, DataType::FLOAT32>& scales);
   template <DataType T>
   void UploadWeights(const tflite::gpu::Tensor<OHWI, T>& weights,
                      bool weights_are_buffer);
@@ -154,7 +160,8 @@ class FullyConnected : public GPUOperation {
   std::string GetFullyConnectedKernelCode(const OperationDef& op_def,
                                           const GpuInfo& gpu_info,
                                           bool weights_are_buffer,
-                                          bool quantized);
+                                          bool quantized,
+                                          bool per_channel_scales = false);
 };
 
 template <DataType T>
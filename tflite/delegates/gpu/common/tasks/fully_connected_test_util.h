@@ -26,6 +26,7 @@ absl::Status FullyConnectedTest(TestExecutionEnvironment* env);
 absl::Status FullyConnectedLargeTest(TestExecutionEnvironment* env);
 absl::Status FullyConnectedExtraLargeTest(TestExecutionEnvironment* env);
 absl::Status FullyConnectedInt8Test(TestExecutionEnvironment* env);
+absl::Status FullyConnectedPerChannelInt8Test(TestExecutionEnvironment* env);
 
 }  // namespace gpu
 }  // namespace tflite
@@ -29,6 +29,12 @@ limitations under the License.
 namespace tflite {
 namespace gpu {
 namespace {
+bool HasPerChannelScales(const Node& fc_node) {
+  return !absl::any_cast<const FullyConnectedInt8Attributes&>(
+              fc_node.operation.attributes)
+              .per_channel_scales.data.empty();
+}
+
 bool UseBufferForWeights(const GpuInfo& gpu_info) {
   return gpu_info.IsAdreno() || gpu_info.IsAMD() || gpu_info.IsMali();
 }
@@ -347,6 +353,11 @@ absl::Status TryFCFCAdd(
   if (!(both_quantized || both_not_quantized)) {
     return absl::NotFoundError("FCFCAdd not suitable.");
   }
+  // The fused kernel supports a single scale per weights tensor only.
+  if (both_quantized &&
+      (HasPerChannelScales(*fc0_node) || HasPerChannelScales(*fc1_node))) {
+    return absl::NotFoundError("FCFCAdd not suitable.");
+  }
   if (consumed_nodes->find(fc1_node->id) != consumed_nodes->end()) {
     return absl::NotFoundError("FCFCAdd not suitable.");
   }
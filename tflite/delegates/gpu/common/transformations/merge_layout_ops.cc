@@ -0,0 +1,159 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tflite/delegates/gpu/common/transformations/merge_layout_ops.h"
+
+#include <any>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "tflite/delegates/gpu/common/model.h"
+#include "tflite/delegates/gpu/common/model_transformer.h"
+#include "tflite/delegates/gpu/common/operations.h"
+#include "tflite/delegates/gpu/common/shape.h"
+#include "tflite/delegates/gpu/common/status.h"
+
+namespace tflite {
+namespace gpu {
+namespace {
+
+bool IsIdentityPermutation(const BHWC& perm) {
+  return perm == BHWC(0, 1, 2, 3);
+}
+
+class TransposeToReshape : public NodeTransformation {
+ public:
+  TransformResult ApplyToNode(Node* node, GraphFloat32* graph) final {
+    if (node->operation.type != ToString(OperationType::TRANSPOSE)) {
+      return {TransformStatus::SKIPPED, ""};
+    }
+    const auto& attr =
+        std::any_cast<const TransposeAttributes&>(node->operation.attributes);
+    const BHWC& input_shape = graph->FindInputs(node->id)[0]->tensor.shape;
+    // The elements keep their order if the dimensions of size one are the only
+    // ones that move.
+    int last_axis = -1;
+    for (int i = 0; i < 4; ++i) {
+      const int axis = attr.perm.get(i);
+      if (input_shape.get(axis) == 1) {
+        continue;
+      }
+      if (axis < last_axis) {
+        return {TransformStatus::SKIPPED, ""};
+      }
+      last_axis = axis;
+    }
+    ReshapeAttributes reshape_attr;
+    reshape_attr.new_shape = graph->FindOutputs(node->id)[0]->tensor.shape;
+    node->operation.type = ToString(OperationType::RESHAPE);
+    node->operation.attributes = reshape_attr;
+    return {TransformStatus::APPLIED,
+            "Replaced transpose of dimensions of size one with reshape."};
+  }
+};
+
+class MergeConsecutiveTransposes : public SequenceTransformation {
+ public:
+  int ExpectedSequenceLength() const final { return 2; }
+
+  TransformResult ApplyToNodesSequence(const std::vector<Node*>& sequence,
+                                       GraphFloat32* graph) final {
+    Node* first_node = sequence[0];
+    Node* second_node = sequence[1];
+    const std::string transpose = ToString(OperationType::TRANSPOSE);
+    if (first_node->operation.type != transpose ||
+        second_node->operation.type != transpose) {
+      return {TransformStatus::SKIPPED, ""};
+    }
+    if (graph->IsGraphOutput(graph->FindOutputs(first_node->id)[0]->id)) {
+      return {TransformStatus::SKIPPED,
+              "Can not apply transformation when the first transpose output "
+              "is graph output"};
+    }
+    const auto& first_attr = std::any_cast<const TransposeAttributes&>(
+        first_node->operation.attributes);
+    const auto& second_attr = std::any_cast<const TransposeAttributes&>(
+        second_node->operation.attributes);
+    // Axis i of the output is axis second_attr.perm[i] of the intermediate
+    // tensor, which is axis first_attr.perm[second_attr.perm[i]] of the input.
+    TransposeAttributes attr;
+    for (int i = 0; i < 4; ++i) {
+      attr.perm.set(i, first_attr.perm.get(second_attr.perm.get(i)));
+    }
+    absl::Status status = RemovePrecedingNode(graph, first_node, second_node);
+    if (!status.ok()) {
+      return {TransformStatus::INVALID,
+              "Unable to remove a node: " + std::string(status.message())};
+    }
+    second_node->operation.attributes = attr;
+    if (!IsIdentityPermutation(attr.perm) ||
+        graph->IsGraphOutput(graph->FindOutputs(second_node->id)[0]->id)) {
+      return {TransformStatus::APPLIED, "Merged consecutive transposes."};
+    }
+    status = RemoveSimpleNodeKeepInput(graph, second_node);
+    if (!status.ok()) {
+      return {TransformStatus::INVALID,
+              "Unable to remove a node: " + std::string(status.message())};
+    }
+    return {TransformStatus::APPLIED,
+            "Removed consecutive transposes that cancel each other."};
+  }
+};
+
+class MergeConsecutiveReshapes : public SequenceTransformation {
+ public:
+  int ExpectedSequenceLength() const final { return 2; }
+
+  TransformResult ApplyToNodesSequence(const std::vector<Node*>& sequence,
+                                       GraphFloat32* graph) final {
+    Node* first_node = sequence[0];
+    Node* second_node = sequence[1];
+    const std::string reshape = ToString(OperationType::RESHAPE);
+    if (first_node->operation.type != reshape ||
+        second_node->operation.type != reshape) {
+      return {TransformStatus::SKIPPED, ""};
+    }
+    if (graph->IsGraphOutput(graph->FindOutputs(first_node->id)[0]->id)) {
+      return {TransformStatus::SKIPPED,
+              "Can not apply transformation when the first reshape output is "
+              "graph output"};
+    }
+    absl::Status status = RemovePrecedingNode(graph, first_node, second_node);
+    if (!status.ok()) {
+      return {TransformStatus::INVALID,
+              "Unable to remove a node: " + std::string(status.message())};
+    }
+    return {TransformStatus::APPLIED, "Merged consecutive reshapes."};
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<NodeTransformation> NewTransposeToReshape() {
+  return absl::make_unique<TransposeToReshape>();
+}
+
+std::unique_ptr<SequenceTransformation> NewMergeConsecutiveTransposes() {
+  return absl::make_unique<MergeConsecutiveTransposes>();
+}
+
+std::unique_ptr<SequenceTransformation> NewMergeConsecutiveReshapes() {
+  return absl::make_unique<MergeConsecutiveReshapes>();
+}
+
+}  // namespace gpu
+}  // namespace tflite
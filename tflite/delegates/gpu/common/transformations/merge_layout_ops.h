@@ -0,0 +1,40 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_DELEGATES_GPU_COMMON_TRANSFORMATIONS_MERGE_LAYOUT_OPS_H_
+#define TENSORFLOW_LITE_DELEGATES_GPU_COMMON_TRANSFORMATIONS_MERGE_LAYOUT_OPS_H_
+
+#include <memory>
+
+#include "tflite/delegates/gpu/common/model_transformer.h"
+
+namespace tflite {
+namespace gpu {
+
+// Replaces a transpose that keeps the order of all the dimensions bigger than
+// one with a reshape, which does not reorder the elements.
+std::unique_ptr<NodeTransformation> NewTransposeToReshape();
+
+// Replaces two consecutive transposes with one transpose by the composed
+// permutation, and removes it if the permutation is the identity.
+std::unique_ptr<SequenceTransformation> NewMergeConsecutiveTransposes();
+
+// Replaces two consecutive reshapes with the second one.
+std::unique_ptr<SequenceTransformation> NewMergeConsecutiveReshapes();
+
+}  // namespace gpu
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_DELEGATES_GPU_COMMON_TRANSFORMATIONS_MERGE_LAYOUT_OPS_H_
@@ -0,0 +1,177 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tflite/delegates/gpu/common/transformations/merge_layout_ops.h"
+
+#include <any>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tflite/delegates/gpu/common/model.h"
+#include "tflite/delegates/gpu/common/model_transformer.h"
+#include "tflite/delegates/gpu/common/operations.h"
+#include "tflite/delegates/gpu/common/shape.h"
+
+namespace tflite {
+namespace gpu {
+namespace {
+
+using ::testing::UnorderedElementsAre;
+
+// Builds graph_input -> producer -> value0 -> first -> value1 -> second
+// -> value2 -> consumer -> graph_output.
+struct LayoutChain {
+  GraphFloat32 graph;
+  Node* producer_node;
+  Node* first_node;
+  Node* second_node;
+  Node* consumer_node;
+  Value* graph_input;
+  Value* graph_output;
+  Value* value0;
+  Value* value1;
+  Value* value2;
+
+  LayoutChain() {
+    producer_node = graph.NewNode();
+    first_node = graph.NewNode();
+    second_node = graph.NewNode();
+    consumer_node = graph.NewNode();
+    graph_input = graph.NewValue();
+    graph_output = graph.NewValue();
+    value0 = graph.NewValue();
+    value1 = graph.NewValue();
+    value2 = graph.NewValue();
+    EXPECT_TRUE(graph.AddConsumer(producer_node->id, graph_input->id).ok());
+    EXPECT_TRUE(graph.SetProducer(producer_node->id, value0->id).ok());
+    EXPECT_TRUE(graph.AddConsumer(first_node->id, value0->id).ok());
+    EXPECT_TRUE(graph.SetProducer(first_node->id, value1->id).ok());
+    EXPECT_TRUE(graph.AddConsumer(second_node->id, value1->id).ok());
+    EXPECT_TRUE(graph.SetProducer(second_node->id, value2->id).ok());
+    EXPECT_TRUE(graph.AddConsumer(consumer_node->id, value2->id).ok());
+    EXPECT_TRUE(graph.SetProducer(consumer_node->id, graph_output->id).ok());
+  }
+};
+
+void SetTranspose(const BHWC& perm, Node* node) {
+  node->operation.type = ToString(OperationType::TRANSPOSE);
+  TransposeAttributes attr;
+  attr.perm = perm;
+  node->operation.attributes = attr;
+}
+
+void SetReshape(const BHWC& new_shape, Node* node) {
+  node->operation.type = ToString(OperationType::RESHAPE);
+  ReshapeAttributes attr;
+  attr.new_shape = new_shape;
+  node->operation.attributes = attr;
+}
+
+TEST(TransposeToReshape, Smoke) {
+  LayoutChain chain;
+  chain.value0->tensor.shape = BHWC(1, 1, 8, 16);
+  chain.value1->tensor.shape = BHWC(1, 8, 1, 16);
+  SetTranspose(BHWC(0, 2, 1, 3), chain.first_node);
+
+  auto transformation = NewTransposeToReshape();
+  ModelTransformer transformer(&chain.graph);
+  transformer.Apply("transpose_to_reshape", transformation.get());
+
+  EXPECT_EQ(chain.first_node->operation.type,
+            ToString(OperationType::RESHAPE));
+  EXPECT_EQ(std::any_cast<const ReshapeAttributes&>(
+                chain.first_node->operation.attributes)
+                .new_shape,
+            BHWC(1, 8, 1, 16));
+}
+
+TEST(TransposeToReshape, DoNotTrigger_ReorderedElements) {
+  LayoutChain chain;
+  chain.value0->tensor.shape = BHWC(1, 4, 8, 16);
+  chain.value1->tensor.shape = BHWC(1, 8, 4, 16);
+  SetTranspose(BHWC(0, 2, 1, 3), chain.first_node);
+
+  auto transformation = NewTransposeToReshape();
+  ModelTransformer transformer(&chain.graph);
+  transformer.Apply("transpose_to_reshape", transformation.get());
+
+  EXPECT_EQ(chain.first_node->operation.type,
+            ToString(OperationType::TRANSPOSE));
+}
+
+TEST(MergeConsecutiveTransposes, ComposesPermutations) {
+  LayoutChain chain;
+  chain.value0->tensor.shape = BHWC(1, 2, 3, 4);
+  chain.value1->tensor.shape = BHWC(1, 3, 2, 4);
+  chain.value2->tensor.shape = BHWC(1, 4, 2, 3);
+  SetTranspose(BHWC(0, 2, 1, 3), chain.first_node);
+  SetTranspose(BHWC(0, 3, 2, 1), chain.second_node);
+
+  auto transformation = NewMergeConsecutiveTransposes();
+  ModelTransformer transformer(&chain.graph);
+  transformer.Apply("merge_consecutive_transposes", transformation.get());
+
+  EXPECT_THAT(chain.graph.nodes(),
+              UnorderedElementsAre(chain.producer_node, chain.second_node,
+                                   chain.consumer_node));
+  EXPECT_THAT(chain.graph.FindInputs(chain.second_node->id),
+              UnorderedElementsAre(chain.value0));
+  EXPECT_EQ(std::any_cast<const TransposeAttributes&>(
+                chain.second_node->operation.attributes)
+                .perm,
+            BHWC(0, 3, 1, 2));
+}
+
+TEST(MergeConsecutiveTransposes, RemovesInversePermutations) {
+  LayoutChain chain;
+  chain.value0->tensor.shape = BHWC(1, 2, 3, 4);
+  chain.value1->tensor.shape = BHWC(1, 4, 2, 3);
+  chain.value2->tensor.shape = BHWC(1, 2, 3, 4);
+  SetTranspose(BHWC(0, 3, 1, 2), chain.first_node);
+  SetTranspose(BHWC(0, 2, 3, 1), chain.second_node);
+
+  auto transformation = NewMergeConsecutiveTransposes();
+  ModelTransformer transformer(&chain.graph);
+  transformer.Apply("merge_consecutive_transposes", transformation.get());
+
+  EXPECT_THAT(chain.graph.nodes(),
+              UnorderedElementsAre(chain.producer_node, chain.consumer_node));
+  EXPECT_THAT(chain.graph.values(),
+              UnorderedElementsAre(chain.graph_input, chain.graph_output,
+                                   chain.value0));
+}
+
+TEST(MergeConsecutiveReshapes, Smoke) {
+  LayoutChain chain;
+  chain.value0->tensor.shape = BHWC(1, 4, 4, 8);
+  chain.value1->tensor.shape = BHWC(1, 1, 16, 8);
+  chain.value2->tensor.shape = BHWC(1, 2, 8, 8);
+  SetReshape(BHWC(1, 1, 16, 8), chain.first_node);
+  SetReshape(BHWC(1, 2, 8, 8), chain.second_node);
+
+  auto transformation = NewMergeConsecutiveReshapes();
+  ModelTransformer transformer(&chain.graph);
+  transformer.Apply("merge_consecutive_reshapes", transformation.get());
+
+  EXPECT_THAT(chain.graph.nodes(),
+              UnorderedElementsAre(chain.producer_node, chain.second_node,
+                                   chain.consumer_node));
+  EXPECT_THAT(chain.graph.FindInputs(chain.second_node->id),
+              UnorderedElementsAre(chain.value0));
+}
+
+}  // namespace
+}  // namespace gpu
+}  // namespace tflite
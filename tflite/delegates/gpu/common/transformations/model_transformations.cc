@@ -25,6 +25,7 @@ limitations under the License.
 #include "tflite/delegates/gpu/common/transformations/make_fully_connected.h"
 #include "tflite/delegates/gpu/common/transformations/make_padding.h"
 #include "tflite/delegates/gpu/common/transformations/merge_densify.h"
+#include "tflite/delegates/gpu/common/transformations/merge_layout_ops.h"
 #include "tflite/delegates/gpu/common/transformations/merge_padding_with.h"
 #include "tflite/delegates/gpu/common/transformations/remove_noop.h"
 
@@ -44,6 +45,12 @@ bool ApplyGeneralTransformations(ModelTransformer* transformer) {
                             NewRemoveSingleInputAdd().get()) &&
          transformer->Apply("remove_single_input_concat",
                             NewRemoveSingleInputConcat().get()) &&
+         transformer->Apply("transpose_to_reshape",
+                            NewTransposeToReshape().get()) &&
+         transformer->Apply("merge_consecutive_transposes",
+                            NewMergeConsecutiveTransposes().get()) &&
+         transformer->Apply("merge_consecutive_reshapes",
+                            NewMergeConsecutiveReshapes().get()) &&
          transformer->Apply("remove_identity_reshape",
                             NewRemoveIdentityReshape().get()) &&
          transformer->Apply("remove_identity_strided_slice",
@@ -39,8 +39,17 @@ class FullyConnectedBuffers : public NodeShader {
  public:
   absl::Status GenerateCode(const GenerationContext& ctx,
                             GeneratedCode* generated_code) const final {
-    const auto& attr =
-        std::any_cast<const FullyConnectedAttributes&>(ctx.op_attr);
+    // Quantized weights are dequantized here, since the shader reads float
+    // weights only.
+    const auto* attr_ptr =
+        std::any_cast<FullyConnectedAttributes>(&ctx.op_attr);
+    FullyConnectedAttributes dequantized_attr;
+    if (attr_ptr == nullptr) {
+      dequantized_attr = DequatizeFullyConnectedAttr(
+          std::any_cast<const FullyConnectedInt8Attributes&>(ctx.op_attr));
+      attr_ptr = &dequantized_attr;
+    }
+    const FullyConnectedAttributes& attr = *attr_ptr;
 
     const int src_depth = DivideRoundUp(attr.weights.shape.i, 4);
     const int dst_depth = DivideRoundUp(attr.weights.shape.o, 4);
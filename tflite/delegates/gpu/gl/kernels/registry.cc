@@ -84,6 +84,7 @@ class Registry : public NodeShader {
     insert_op(Type::DEPTHWISE_CONVOLUTION, NewDepthwiseConvolutionNodeShader);
     insert_op(Type::DEPTH_TO_SPACE, NewDepthToSpaceNodeShader);
     insert_op(Type::FULLY_CONNECTED, NewFullyConnectedNodeShader);
+    insert_op(Type::FULLY_CONNECTED_INT8, NewFullyConnectedNodeShader);
     insert_op(Type::LSTM, NewLstmNodeShader);
     insert_op(Type::MEAN, NewMeanNodeShader);
     // TODO(b/162763635): implement MeanStddevNormalization for OpenGL.
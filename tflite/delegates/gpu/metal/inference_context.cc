@@ -112,6 +112,53 @@ void DecodeProgram(const data::MetalProgram* metal_program, std::string* code,
     (*defines)[key] = value;
   }
 }
+
+// Places one buffer per tensor of `records` in a placement heap, at offsets
+// planned from the tensor lifetimes, so that the buffers of tensors that are
+// never alive at the same time alias each other. Unlike a single shared
+// MTLBuffer, the heap is not limited by maxBufferLength. Leaves `heap` nil if
+// the device can not create such a heap.
+API_AVAILABLE(ios(13.0), macos(10.15), tvos(13.0))
+absl::Status CreateAliasedHeapBuffers(
+    MetalDevice* device, std::vector<TensorUsageRecord<size_t>> records,
+    size_t alignment, id<MTLHeap>* heap, std::vector<id<MTLBuffer>>* buffers) {
+  const MTLResourceOptions options = MTLResourceStorageModeShared |
+                                     MTLResourceHazardTrackingModeTracked;
+  for (auto& record : records) {
+    if (record.tensor_size > device->GetInfo().GetMaxBufferSize()) {
+      return absl::OkStatus();
+    }
+    const MTLSizeAndAlign size_and_align = [device->device()
+        heapBufferSizeAndAlignWithLength:record.tensor_size
+                                 options:options];
+    record.tensor_size = size_and_align.size;
+    alignment = std::lcm(alignment, size_and_align.align);
+  }
+  OffsetsAssignment offset_assignment;
+  RETURN_IF_ERROR(AssignOffsetsToTensors(records, MemoryStrategy::GREEDY_BEST,
+                                         &offset_assignment, alignment));
+
+  MTLHeapDescriptor* heap_desc = [[MTLHeapDescriptor alloc] init];
+  heap_desc.type = MTLHeapTypePlacement;
+  heap_desc.storageMode = MTLStorageModeShared;
+  heap_desc.hazardTrackingMode = MTLHazardTrackingModeTracked;
+  heap_desc.size = offset_assignment.total_size;
+  id<MTLHeap> new_heap = [device->device() newHeapWithDescriptor:heap_desc];
+  if (!new_heap) {
+    return absl::OkStatus();
+  }
+  buffers->resize(records.size());
+  for (int i = 0; i < records.size(); ++i) {
+    (*buffers)[i] = [new_heap newBufferWithLength:records[i].tensor_size
+                                          options:options
+                                           offset:offset_assignment.offsets[i]];
+    if (!(*buffers)[i]) {
+      return absl::InternalError("Failed to create MTLBuffer in MTLHeap.");
+    }
+  }
+  *heap = new_heap;
+  return absl::OkStatus();
+}
 }  // namespace
 
 absl::Status InferenceContext::InitFromGraphWithTransforms(
@@ -523,7 +570,7 @@ absl::Status InferenceContext::AllocateMemoryForBuffers(MetalDevice* device) {
 
   OffsetsAssignment offset_assignment;
   RETURN_IF_ERROR(AssignOffsetsToTensors(
-      buffer_usage_records, MemoryStrategy::GREEDY_BY_SIZE, &offset_assignment,
+      buffer_usage_records, MemoryStrategy::GREEDY_BEST, &offset_assignment,
       min_common_alignment));
 
   bool use_offset_assignment = false;
@@ -532,12 +579,31 @@ absl::Status InferenceContext::AllocateMemoryForBuffers(MetalDevice* device) {
     use_offset_assignment = true;
   }
 
+  // The offsets plan is smaller but does not fit in one MTLBuffer, so the
+  // tensors get aliased buffers of a placement heap instead.
+  bool use_heap_assignment = false;
+  if (!use_offset_assignment &&
+      offset_assignment.total_size < TotalSize(buffer_assignment)) {
+    if (@available(macOS 10.15, iOS 13.0, tvOS 13.0, *)) {
+      id<MTLHeap> heap = nullptr;
+      RETURN_IF_ERROR(CreateAliasedHeapBuffers(device, buffer_usage_records,
+                                               min_common_alignment, &heap,
+                                               &shared_buffers_));
+      if (heap) {
+        shared_heap_ = heap;
+        use_heap_assignment = true;
+      } else {
+        shared_buffers_.clear();
+      }
+    }
+  }
+
   if (use_offset_assignment) {
     shared_buffers_.resize(1);
     shared_buffers_[0] =
         [device->device() newBufferWithLength:offset_assignment.total_size
                                       options:MTLResourceStorageModeShared];
-  } else {
+  } else if (!use_heap_assignment) {
     shared_buffers_.resize(buffer_assignment.object_sizes.size());
     for (int i = 0; i < buffer_assignment.object_sizes.size(); ++i) {
       // Initialize metal buffer
@@ -577,6 +643,9 @@ absl::Status InferenceContext::AllocateMemoryForBuffers(MetalDevice* device) {
       if (use_offset_assignment) {
         base_buffer = shared_buffers_[0];
         base_buffer_offset = offset_assignment.offsets[tensor_index];
+      } else if (use_heap_assignment) {
+        base_buffer = shared_buffers_[tensor_index];
+        base_buffer_offset = 0;
       } else {
         base_buffer = shared_buffers_[buffer_index];
         base_buffer_offset = 0;
@@ -689,6 +758,8 @@ void InferenceContext::EncodeWithICB(
 void InferenceContext::Profile(id<MTLDevice> device, ProfilingInfo* result) {
   result->dispatches.resize(nodes_.size());
   id<MTLCommandQueue> command_queue = [device newCommandQueue];
+  // The nodes are profiled one at a time, so they start one after the other.
+  absl::Duration start_offset;
   for (int k = 0; k < nodes_.size(); ++k) {
     @autoreleasepool {
       id<MTLCommandBuffer> command_buffer = [command_queue commandBuffer];
@@ -707,6 +778,16 @@ void InferenceContext::Profile(id<MTLDevice> device, ProfilingInfo* result) {
       auto& dispatch_info = result->dispatches[k];
       dispatch_info.label = nodes_[k].name;
       dispatch_info.duration = (end - start) / static_cast<float>(kRuns);
+      if (@available(iOS 10.3, macOS 10.15, tvOS 10.3, *)) {
+        // The device timestamps leave out the commit and the wait.
+        const CFTimeInterval gpu_time =
+            command_buffer.GPUEndTime - command_buffer.GPUStartTime;
+        if (gpu_time > 0) {
+          dispatch_info.duration = absl::Seconds(gpu_time) / kRuns;
+        }
+      }
+      dispatch_info.start = start_offset;
+      start_offset += dispatch_info.duration;
 
       uint64_t read_size = 0;
       for (auto& src_id : nodes_[k].inputs) {
@@ -730,8 +811,12 @@ uint64_t InferenceContext::GetIntermediateTensorsSize() const {
   for (const auto& t : strong_shape_tensors_) {
     total_memory += t.second.GetMemorySizeInBytes();
   }
-  for (const auto& b : shared_buffers_) {
-    total_memory += [b length];
+  if (shared_heap_) {
+    total_memory += [shared_heap_ size];
+  } else {
+    for (const auto& b : shared_buffers_) {
+      total_memory += [b length];
+    }
   }
 
   return total_memory;
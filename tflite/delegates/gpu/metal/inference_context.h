@@ -178,6 +178,8 @@ class InferenceContext {
 
   std::map<ValueId, int> graph_ids_to_shared_buffer_tensors_;
   std::vector<id<MTLBuffer>> shared_buffers_;
+  // Backs shared_buffers_, one per tensor, when they alias each other.
+  id<MTLHeap> shared_heap_ = nullptr;
   std::vector<MetalSpatialTensor>
       shared_buffer_tensors_;  // use references to memory
                                // from _sharedBuffers
@@ -46,4 +46,9 @@ limitations under the License.
   XCTAssertTrue(status.ok(), @"%s", std::string(status.message()).c_str());
 }
 
+- (void)testFullyConnectedPerChannelInt8 {
+  auto status = FullyConnectedPerChannelInt8Test(&exec_env_);
+  XCTAssertTrue(status.ok(), @"%s", std::string(status.message()).c_str());
+}
+
 @end
@@ -34,6 +34,10 @@ void AddTfLiteProfilerEvents(tflite::gpu::ProfilingInfo* profiling_info) {
       reinterpret_cast<tflite::Profiler*>(GetTfLiteProfiler());
   if (profile == nullptr) return;
 
+  profile->AddEventWithData(
+      kGpuKernelsEventTag,
+      Profiler::EventType::DELEGATE_PROFILED_OPERATOR_INVOKE_EVENT,
+      profiling_info);
   int node_index = 0;
   for (const auto& dispatch : profiling_info->dispatches) {
     profile->AddEvent(
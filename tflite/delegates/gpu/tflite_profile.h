@@ -29,6 +29,13 @@ void SetTfLiteProfiler(void* profiler);
 // Returns saved TFLite Profiler object.
 void* GetTfLiteProfiler();
 
+// The tag of the event added with Profiler::AddEventWithData() before the
+// events of the kernels of a profiled run. The data is the ProfilingInfo of
+// the run, so that the profilers can place the kernels on a device timeline.
+// A profiler that records it should drop the
+// DELEGATE_PROFILED_OPERATOR_INVOKE_EVENT of each dispatch that follow.
+inline constexpr char kGpuKernelsEventTag[] = "GpuKernels";
+
 // Generate TFLite Profiler events with the given ProfilingInfo object.
 void AddTfLiteProfilerEvents(tflite::gpu::ProfilingInfo* profiling_info);
 
@@ -37,6 +37,12 @@ class SingleOpModelWithHexagon : public SingleOpModel {
   }
 
   void ApplyDelegateAndInvoke() {
+    ApplyDelegate();
+    Invoke();
+  }
+
+  // Initializes the DSP connection and delegates the op to it.
+  void ApplyDelegate() {
     static const char kDelegateName[] = "TfLiteHexagonDelegate";
 
     // Make sure we set the environment.
@@ -71,8 +77,6 @@ class SingleOpModelWithHexagon : public SingleOpModel {
     ASSERT_TRUE(node_and_reg != nullptr);
     ASSERT_TRUE(node_and_reg->second.custom_name != nullptr);
     ASSERT_STREQ(kDelegateName, node_and_reg->second.custom_name);
-
-    Invoke();
   }
 
  protected:
@@ -0,0 +1,186 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include <dlfcn.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tflite/c/c_api_types.h"
+#include "tflite/delegates/hexagon/builders/tests/hexagon_delegate_op_model.h"
+#include "tflite/delegates/hexagon/hexagon_delegate.h"
+#include "tflite/kernels/test_util.h"
+#include "tflite/schema/schema_generated.h"
+
+namespace tflite {
+using testing::ElementsAreArray;
+
+// An ION or dma-buf buffer allocated with rpcmem, the allocator of the FastRPC
+// library. This is the memory backing FastRPC LiteRtTensorBuffers.
+class RpcMemBuffer {
+ public:
+  explicit RpcMemBuffer(int size) : size_(size) {
+    lib_ = dlopen("libcdsprpc.so", RTLD_NOW | RTLD_LOCAL);
+    if (lib_ == nullptr) {
+      lib_ = dlopen("libadsprpc.so", RTLD_NOW | RTLD_LOCAL);
+    }
+    if (lib_ == nullptr) {
+      return;
+    }
+    auto* rpcmem_alloc = reinterpret_cast<void* (*)(int, uint32_t, int)>(
+        dlsym(lib_, "rpcmem_alloc"));
+    auto* rpcmem_to_fd =
+        reinterpret_cast<int (*)(void*)>(dlsym(lib_, "rpcmem_to_fd"));
+    rpcmem_free_ =
+        reinterpret_cast<void (*)(void*)>(dlsym(lib_, "rpcmem_free"));
+    if (rpcmem_alloc == nullptr || rpcmem_to_fd == nullptr ||
+        rpcmem_free_ == nullptr) {
+      return;
+    }
+    data_ = rpcmem_alloc(kRpcmemHeapIdSystem, kRpcmemDefaultFlags, size);
+    if (data_ != nullptr) {
+      fd_ = rpcmem_to_fd(data_);
+    }
+  }
+
+  ~RpcMemBuffer() {
+    if (data_ != nullptr) {
+      rpcmem_free_(data_);
+    }
+    if (lib_ != nullptr) {
+      dlclose(lib_);
+    }
+  }
+
+  uint8_t* data() const { return static_cast<uint8_t*>(data_); }
+  int size() const { return size_; }
+  int fd() const { return fd_; }
+
+ private:
+  static constexpr int kRpcmemHeapIdSystem = 25;
+  static constexpr uint32_t kRpcmemDefaultFlags = 1;
+
+  int size_;
+  void* lib_ = nullptr;
+  void (*rpcmem_free_)(void*) = nullptr;
+  void* data_ = nullptr;
+  int fd_ = -1;
+};
+
+class SharedBufferAddOpModel : public SingleOpModelWithHexagon {
+ public:
+  SharedBufferAddOpModel(const TensorData& input, const TensorData& output) {
+    input1_ = AddInput(input);
+    input2_ = AddInput(input);
+    output_ = AddOutput(output);
+    SetBuiltinOp(BuiltinOperator_ADD, BuiltinOptions_AddOptions,
+                 CreateAddOptions(builder_).Union());
+    BuildInterpreter({GetShape(input1_), GetShape(input2_)});
+  }
+
+  // Places the I/O tensors in `buffer`, each at a multiple of the tensor
+  // alignment.
+  TfLiteStatus UseBuffer(const RpcMemBuffer& buffer) {
+    int offset = 0;
+    for (int tensor : {input1_, input2_, output_}) {
+      const size_t bytes = interpreter_->tensor(tensor)->bytes;
+      if (bytes > static_cast<size_t>(kBufferOffsetAlignment) ||
+          offset + kBufferOffsetAlignment > buffer.size()) {
+        return kTfLiteError;
+      }
+      TfLiteCustomAllocation allocation = {buffer.data() + offset, bytes};
+      if (interpreter_->SetCustomAllocationForTensor(tensor, allocation) !=
+          kTfLiteOk) {
+        return kTfLiteError;
+      }
+      offset += kBufferOffsetAlignment;
+    }
+    return interpreter_->AllocateTensors();
+  }
+
+  void SetInputs(const std::vector<float>& input1,
+                 const std::vector<float>& input2) {
+    QuantizeAndPopulate<uint8_t>(input1_, input1);
+    QuantizeAndPopulate<uint8_t>(input2_, input2);
+  }
+
+  std::vector<float> GetDequantizedOutput() {
+    return Dequantize<uint8_t>(ExtractVector<uint8_t>(output_),
+                               GetScale(output_), GetZeroPoint(output_));
+  }
+
+  const void* OutputData() { return interpreter_->tensor(output_)->data.raw; }
+
+  void ClearOutput() {
+    TfLiteTensor* output = interpreter_->tensor(output_);
+    std::memset(output->data.raw, 0, output->bytes);
+  }
+
+  static constexpr int kBufferOffsetAlignment = 64;
+
+ private:
+  int input1_;
+  int input2_;
+  int output_;
+};
+
+TEST(SharedBufferTest, RunsOnRegisteredRpcMemBuffer) {
+  const float kQuantizedTolerance = 2.0 / 255.0;
+  // Declared first so that the buffer outlives the interpreter.
+  RpcMemBuffer buffer(3 * SharedBufferAddOpModel::kBufferOffsetAlignment);
+  if (buffer.data() == nullptr) {
+    GTEST_SKIP() << "rpcmem is not available.";
+  }
+
+  SharedBufferAddOpModel m({TensorType_UINT8, {1, 2, 2, 1}, -1.0, 1.0},
+                           {TensorType_UINT8, {1, 2, 2, 1}, -1.0, 1.0});
+  ASSERT_EQ(m.UseBuffer(buffer), kTfLiteOk);
+  m.SetInputs({0.1, 0.2, 0.3, 0.4}, {0.6, 0.4, -0.8, 0.1});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  const auto reference_output = m.GetDequantizedOutput();
+  m.ClearOutput();
+
+  m.ApplyDelegate();
+  if (!TfLiteHexagonRegisterBuffer(buffer.data(), buffer.size(),
+                                   buffer.fd())) {
+    GTEST_SKIP() << "The Hexagon interface library can't register buffers.";
+  }
+  // The tensors are still in the registered buffer once delegated.
+  EXPECT_EQ(m.OutputData(),
+            buffer.data() + 2 * SharedBufferAddOpModel::kBufferOffsetAlignment);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetDequantizedOutput(),
+              ElementsAreArray(ArrayFloatNear(reference_output,
+                                              kQuantizedTolerance)));
+
+  // Inputs written in place are seen by the next execution.
+  m.SetInputs({-0.5, 0.0, 0.5, 0.25}, {0.5, 0.5, 0.25, -0.25});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  const auto delegated_output = m.GetDequantizedOutput();
+  TfLiteHexagonUnregisterBuffer(buffer.data(), buffer.size());
+
+  SharedBufferAddOpModel cpu({TensorType_UINT8, {1, 2, 2, 1}, -1.0, 1.0},
+                             {TensorType_UINT8, {1, 2, 2, 1}, -1.0, 1.0});
+  cpu.SetInputs({-0.5, 0.0, 0.5, 0.25}, {0.5, 0.5, 0.25, -0.25});
+  ASSERT_EQ(cpu.Invoke(), kTfLiteOk);
+  EXPECT_THAT(delegated_output,
+              ElementsAreArray(ArrayFloatNear(cpu.GetDequantizedOutput(),
+                                              kQuantizedTolerance)));
+}
+
+}  // namespace tflite
@@ -152,3 +152,11 @@ void TfLiteHexagonInitWithPath(const char* lib_directory_path) {
   tflite::HexagonDelegateKernel::InitState();
 }
 void TfLiteHexagonTearDown() { tflite::HexagonDelegateKernel::Teardown(); }
+
+bool TfLiteHexagonRegisterBuffer(void* data, int size, int fd) {
+  return tflite::HexagonDelegateKernel::RegisterBuffer(data, size, fd);
+}
+
+void TfLiteHexagonUnregisterBuffer(void* data, int size) {
+  tflite::HexagonDelegateKernel::RegisterBuffer(data, size, /*fd=*/-1);
+}
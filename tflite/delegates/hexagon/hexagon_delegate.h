@@ -115,6 +115,18 @@ void TFL_CAPI_EXPORT TfLiteHexagonInit();
 // Clean up and switch off the DSP connection.
 // This should be called after all processing is done and delegate is deleted.
 void TFL_CAPI_EXPORT TfLiteHexagonTearDown();
+
+// Registers the ION or dma-buf buffer `fd`, mapped at `data` for `size`
+// bytes, with the DSP connection. Input and output tensors whose data lives in
+// a registered buffer, e.g. through Interpreter::SetCustomAllocationForTensor,
+// are then mapped to the DSP instead of being copied on each execution.
+// Must be called after TfLiteHexagonInit*, and the buffer unregistered before
+// it is freed. Returns false if the Hexagon interface library doesn't support
+// registering buffers.
+bool TFL_CAPI_EXPORT TfLiteHexagonRegisterBuffer(void* data, int size, int fd);
+
+// Unregisters a buffer registered with TfLiteHexagonRegisterBuffer.
+void TFL_CAPI_EXPORT TfLiteHexagonUnregisterBuffer(void* data, int size);
 #ifdef __cplusplus
 }
 #endif  // __cplusplus
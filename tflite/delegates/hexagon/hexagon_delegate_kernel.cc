@@ -367,4 +367,14 @@ void HexagonDelegateKernel::InitState() {
     hexagon_nn->hexagon_nn_global_init();
   }
 }
+
+bool HexagonDelegateKernel::RegisterBuffer(void* data, int size, int fd) {
+  auto* hexagon_nn = HexagonNNImplementation();
+  if (hexagon_nn == nullptr ||
+      hexagon_nn->hexagon_nn_register_buffer == nullptr) {
+    return false;
+  }
+  hexagon_nn->hexagon_nn_register_buffer(data, size, fd);
+  return true;
+}
 }  // namespace tflite
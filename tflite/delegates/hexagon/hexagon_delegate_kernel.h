@@ -64,6 +64,11 @@ class HexagonDelegateKernel : public SimpleDelegateKernelInterface {
   // Teardown the environment initialized in InitState.
   static void Teardown();
 
+  // Registers the shared buffer `fd` mapped at `data` with FastRPC, or
+  // unregisters it if `fd` is -1. Returns false if the interface library
+  // doesn't support it.
+  static bool RegisterBuffer(void* data, int size, int fd);
+
  private:
   // Builds the Hexagon graph based on delegated TFLite subgraph.
   TfLiteStatus BuildGraph(TfLiteContext* context,
@@ -76,6 +76,10 @@ HexagonNN CreateNewHexagonInterface() {
   LOAD_FUNCTION(libhexagon_interface, hexagon_nn_version, hexagon_nn);
   LOAD_FUNCTION(libhexagon_interface, hexagon_nn_hexagon_interface_version,
                 hexagon_nn);
+  // Optional, older interface libraries don't export it.
+  hexagon_nn.hexagon_nn_register_buffer =
+      reinterpret_cast<hexagon_nn_register_buffer_fn*>(
+          dlsym(libhexagon_interface, "hexagon_nn_register_buffer"));
   hexagon_nn.interface_loaded = successfully_loaded;
   return hexagon_nn;
 }
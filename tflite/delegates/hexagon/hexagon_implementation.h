@@ -131,6 +131,10 @@ struct HexagonNN {
 
   hexagon_nn_version_fn* hexagon_nn_version = nullptr;
 
+  // Registers a shared buffer with FastRPC so that the DSP maps it instead of
+  // copying it. Null with interface libraries predating it.
+  hexagon_nn_register_buffer_fn* hexagon_nn_register_buffer = nullptr;
+
   bool interface_loaded = false;
 };
 
@@ -46,4 +46,8 @@ bool hexagon_nn_is_device_supported() {
 
 int hexagon_nn_hexagon_interface_version() { return kHexagonNNVersion; }
 
+void hexagon_nn_register_buffer(void* buf, int size, int fd) {
+  remote_register_buf(buf, size, fd);
+}
+
 }
@@ -22,6 +22,10 @@ void hexagon_nn_global_teardown(void);
 void hexagon_nn_global_init(void);
 bool hexagon_nn_is_device_supported();
 int hexagon_nn_hexagon_interface_version(void);
+// Registers the ION or dma-buf buffer `fd` mapped at [buf, buf + size) with
+// FastRPC, so that passing it to the DSP maps it instead of copying it. An
+// `fd` of -1 unregisters the buffer.
+void hexagon_nn_register_buffer(void* buf, int size, int fd);
 #ifdef __cplusplus
 }
 #endif
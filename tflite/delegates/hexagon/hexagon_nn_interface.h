@@ -59,4 +59,6 @@ using hexagon_nn_version_fn = decltype(hexagon_nn_version);
 using hexagon_nn_hexagon_interface_version_fn =
     decltype(hexagon_nn_hexagon_interface_version);
 
+using hexagon_nn_register_buffer_fn = decltype(hexagon_nn_register_buffer);
+
 #endif  // TENSORFLOW_LITE_DELEGATES_HEXAGON_HEXAGON_NN_INTERFACE_H_
@@ -0,0 +1,533 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/delegates/norm_fusion/norm_fusion_delegate.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "tflite/builtin_ops.h"
+#include "tflite/context_util.h"
+#include "tflite/core/c/builtin_op_data.h"
+#include "tflite/core/c/common.h"
+#include "tflite/delegates/utils/simple_delegate.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/internal/optimized/normalization.h"
+#include "tflite/kernels/internal/tensor_ctypes.h"
+#include "tflite/kernels/internal/types.h"
+#include "tflite/kernels/kernel_util.h"
+
+namespace tflite {
+namespace norm_fusion {
+
+enum class NormKind { kLayerNorm, kRmsNorm };
+
+// A normalization decomposed into builtin operators, and the tensors it reads
+// and writes.
+struct FusedNorm {
+  NormKind kind;
+  // The operators of the chain, in execution order.
+  std::vector<int> nodes;
+  int input;
+  int output;
+  // The optional constant scale and offset, or -1.
+  int gamma = -1;
+  int beta = -1;
+  float epsilon;
+};
+
+// Finds the normalizations of an execution plan.
+class NormMatcher {
+ public:
+  explicit NormMatcher(TfLiteContext* context) : context_(context) {}
+
+  TfLiteStatus Match(std::vector<FusedNorm>* norms) {
+    TfLiteIntArray* plan;
+    TF_LITE_ENSURE_STATUS(context_->GetExecutionPlan(context_, &plan));
+    producers_.assign(context_->tensors_size, -1);
+    consumers_.assign(context_->tensors_size, {});
+    nodes_.resize(plan->size);
+    for (int i = 0; i < plan->size; ++i) {
+      Node& node = nodes_[i];
+      node.index = plan->data[i];
+      TF_LITE_ENSURE_STATUS(context_->GetNodeAndRegistration(
+          context_, node.index, &node.node, &node.registration));
+      for (int output : TfLiteIntArrayView(node.node->outputs)) {
+        if (output >= 0) producers_[output] = i;
+      }
+      for (int input : TfLiteIntArrayView(node.node->inputs)) {
+        if (input >= 0) consumers_[input].push_back(i);
+      }
+    }
+
+    std::set<int> fused_nodes;
+    for (int i = 0; i < nodes_.size(); ++i) {
+      if (nodes_[i].registration->builtin_code != kTfLiteBuiltinRsqrt) {
+        continue;
+      }
+      FusedNorm norm;
+      if (!MatchFromRsqrt(i, &norm)) continue;
+      if (std::any_of(norm.nodes.begin(), norm.nodes.end(),
+                      [&](int node) { return fused_nodes.count(node); })) {
+        continue;
+      }
+      bool is_isolated;
+      TF_LITE_ENSURE_STATUS(IsIsolated(norm, &is_isolated));
+      if (!is_isolated) continue;
+      fused_nodes.insert(norm.nodes.begin(), norm.nodes.end());
+      norms->push_back(std::move(norm));
+    }
+    return kTfLiteOk;
+  }
+
+ private:
+  struct Node {
+    int index;
+    TfLiteNode* node;
+    TfLiteRegistration* registration;
+  };
+
+  const TfLiteTensor& Tensor(int tensor) const {
+    return context_->tensors[tensor];
+  }
+
+  int Input(int node, int i) const {
+    return nodes_[node].node->inputs->data[i];
+  }
+
+  int Output(int node) const { return nodes_[node].node->outputs->data[0]; }
+
+  // Returns the position in the plan of the operator with `builtin_code`
+  // writing `tensor` as its only output, or -1.
+  int Producer(int tensor, int builtin_code) const {
+    if (tensor < 0) return -1;
+    const int node = producers_[tensor];
+    if (node < 0 ||
+        nodes_[node].registration->builtin_code != builtin_code ||
+        nodes_[node].node->outputs->size != 1) {
+      return -1;
+    }
+    return node;
+  }
+
+  // Returns the only operator reading `tensor`, or -1.
+  int OnlyConsumer(int tensor) const {
+    return consumers_[tensor].size() == 1 ? consumers_[tensor][0] : -1;
+  }
+
+  bool IsConstant(int tensor) const {
+    return tensor >= 0 && Tensor(tensor).allocation_type == kTfLiteMmapRo;
+  }
+
+  template <typename Params>
+  bool HasNoActivation(int node) const {
+    const auto* params =
+        static_cast<const Params*>(nodes_[node].node->builtin_data);
+    return params == nullptr || params->activation == kTfLiteActNone;
+  }
+
+  // Returns whether the operator is a binary one with `builtin_code` and no
+  // fused activation, and sets its inputs.
+  bool IsBinary(int node, int builtin_code, int* lhs, int* rhs) const {
+    if (node < 0 || nodes_[node].registration->builtin_code != builtin_code ||
+        nodes_[node].node->inputs->size != 2) {
+      return false;
+    }
+    switch (builtin_code) {
+      case kTfLiteBuiltinAdd:
+        if (!HasNoActivation<TfLiteAddParams>(node)) return false;
+        break;
+      case kTfLiteBuiltinSub:
+        if (!HasNoActivation<TfLiteSubParams>(node)) return false;
+        break;
+      case kTfLiteBuiltinMul:
+        if (!HasNoActivation<TfLiteMulParams>(node)) return false;
+        break;
+      default:
+        break;
+    }
+    *lhs = Input(node, 0);
+    *rhs = Input(node, 1);
+    return true;
+  }
+
+  // Returns the MEAN over the last axis, keeping it, which writes `tensor`,
+  // or -1.
+  int LastAxisMean(int tensor) const {
+    const int node = Producer(tensor, kTfLiteBuiltinMean);
+    if (node < 0 || nodes_[node].node->inputs->size != 2) return -1;
+    const auto* params = static_cast<const TfLiteReducerParams*>(
+        nodes_[node].node->builtin_data);
+    if (params == nullptr || !params->keep_dims) return -1;
+    const TfLiteTensor& axis = Tensor(Input(node, 1));
+    const int rank = NumDimensions(&Tensor(Input(node, 0)));
+    if (!IsConstant(Input(node, 1)) || axis.type != kTfLiteInt32 ||
+        NumElements(&axis) != 1 || rank == 0) {
+      return -1;
+    }
+    const int32_t axis_value = GetTensorData<int32_t>(&axis)[0];
+    if (axis_value != -1 && axis_value != rank - 1) return -1;
+    return node;
+  }
+
+  // Returns the constant of one value per column of `input` multiplied by
+  // (`builtin_code` MUL) or added to (ADD) `tensor` by `node`, or -1.
+  int ConstantOperand(int node, int builtin_code, int tensor,
+                      int input) const {
+    int lhs;
+    int rhs;
+    if (!IsBinary(node, builtin_code, &lhs, &rhs)) return -1;
+    const int constant = lhs == tensor ? rhs : lhs;
+    if ((lhs != tensor && rhs != tensor) || !IsConstant(constant) ||
+        Tensor(constant).type != Tensor(input).type) {
+      return -1;
+    }
+    const TfLiteTensor& input_tensor = Tensor(input);
+    const int columns =
+        SizeOfDimension(&input_tensor, NumDimensions(&input_tensor) - 1);
+    return NumElements(&Tensor(constant)) == columns ? constant : -1;
+  }
+
+  // Matches the chain around the RSQRT at position `rsqrt` in the plan.
+  bool MatchFromRsqrt(int rsqrt, FusedNorm* norm) const {
+    std::vector<int> nodes = {rsqrt};
+    int lhs;
+    int rhs;
+    // epsilon + variance.
+    const int add = Producer(Input(rsqrt, 0), kTfLiteBuiltinAdd);
+    if (!IsBinary(add, kTfLiteBuiltinAdd, &lhs, &rhs)) return false;
+    const int epsilon = IsConstant(rhs) ? rhs : lhs;
+    if (!IsConstant(epsilon) || NumElements(&Tensor(epsilon)) != 1) {
+      return false;
+    }
+    const int variance_mean = LastAxisMean(epsilon == rhs ? lhs : rhs);
+    if (variance_mean < 0) return false;
+    nodes.push_back(add);
+    nodes.push_back(variance_mean);
+
+    // The squares, of the centered input for layer normalizations.
+    const int squares = Input(variance_mean, 0);
+    int x = -1;
+    int mean = -1;
+    int centered = -1;
+    const int squared_difference =
+        Producer(squares, kTfLiteBuiltinSquaredDifference);
+    if (squared_difference >= 0) {
+      x = Input(squared_difference, 0);
+      mean = LastAxisMean(Input(squared_difference, 1));
+      if (mean < 0 || Input(mean, 0) != x) return false;
+      nodes.push_back(squared_difference);
+    } else {
+      int squared = -1;
+      const int square = Producer(squares, kTfLiteBuiltinSquare);
+      const int mul = Producer(squares, kTfLiteBuiltinMul);
+      if (square >= 0) {
+        squared = Input(square, 0);
+        nodes.push_back(square);
+      } else if (IsBinary(mul, kTfLiteBuiltinMul, &lhs, &rhs) && lhs == rhs) {
+        squared = lhs;
+        nodes.push_back(mul);
+      } else {
+        return false;
+      }
+      const int sub = Producer(squared, kTfLiteBuiltinSub);
+      if (IsBinary(sub, kTfLiteBuiltinSub, &lhs, &rhs) &&
+          (mean = LastAxisMean(rhs)) >= 0 && Input(mean, 0) == lhs) {
+        x = lhs;
+        centered = squared;
+        nodes.push_back(sub);
+      } else {
+        x = squared;
+        mean = -1;
+      }
+    }
+    norm->kind = mean >= 0 ? NormKind::kLayerNorm : NormKind::kRmsNorm;
+    if (mean >= 0) nodes.push_back(mean);
+
+    // The scaling of the centered input by the reciprocal of the deviation.
+    const int inv_stddev = Output(rsqrt);
+    const int scale = OnlyConsumer(inv_stddev);
+    if (!IsBinary(scale, kTfLiteBuiltinMul, &lhs, &rhs)) return false;
+    const int scaled = lhs == inv_stddev ? rhs : lhs;
+    if (lhs != inv_stddev && rhs != inv_stddev) return false;
+    if (norm->kind == NormKind::kRmsNorm) {
+      if (scaled != x) return false;
+    } else if (centered >= 0) {
+      if (scaled != centered) return false;
+    } else {
+      const int sub = Producer(scaled, kTfLiteBuiltinSub);
+      if (!IsBinary(sub, kTfLiteBuiltinSub, &lhs, &rhs) || lhs != x ||
+          rhs != Output(mean)) {
+        return false;
+      }
+      nodes.push_back(sub);
+    }
+    nodes.push_back(scale);
+    int output = Output(scale);
+
+    // The optional scale and offset.
+    norm->gamma = ConstantOperand(OnlyConsumer(output), kTfLiteBuiltinMul,
+                                  output, x);
+    if (norm->gamma >= 0) {
+      nodes.push_back(OnlyConsumer(output));
+      output = Output(nodes.back());
+    }
+    norm->beta = ConstantOperand(OnlyConsumer(output), kTfLiteBuiltinAdd,
+                                 output, x);
+    if (norm->beta >= 0) {
+      nodes.push_back(OnlyConsumer(output));
+      output = Output(nodes.back());
+    }
+
+    // All the tensors of the chain must have the type of its input, and its
+    // intermediate tensors must only be read inside of it.
+    const TfLiteType type = Tensor(x).type;
+    if ((type != kTfLiteFloat32 && type != kTfLiteInt8) ||
+        NumDimensions(&Tensor(x)) == 0 || Tensor(epsilon).type != type) {
+      return false;
+    }
+    const std::set<int> chain(nodes.begin(), nodes.end());
+    for (int node : nodes) {
+      if (nodes_[node].node->outputs->size != 1 ||
+          Tensor(Output(node)).type != type) {
+        return false;
+      }
+      if (Output(node) == output) continue;
+      for (int consumer : consumers_[Output(node)]) {
+        if (!chain.count(consumer)) return false;
+      }
+    }
+    if (type == kTfLiteInt8 &&
+        (Tensor(x).params.scale == 0 || Tensor(output).params.scale == 0)) {
+      return false;
+    }
+
+    std::sort(nodes.begin(), nodes.end());
+    norm->nodes.clear();
+    for (int node : nodes) norm->nodes.push_back(nodes_[node].index);
+    norm->input = x;
+    norm->output = output;
+    const TfLiteTensor& epsilon_tensor = Tensor(epsilon);
+    norm->epsilon =
+        type == kTfLiteFloat32
+            ? GetTensorData<float>(&epsilon_tensor)[0]
+            : (GetTensorData<int8_t>(&epsilon_tensor)[0] -
+               epsilon_tensor.params.zero_point) *
+                  epsilon_tensor.params.scale;
+    return true;
+  }
+
+  // Returns in `is_isolated` whether the only tensor of the chain used after
+  // it, including as an output of the graph, is its output.
+  TfLiteStatus IsIsolated(const FusedNorm& norm, bool* is_isolated) const {
+    TfLiteIntArray* nodes = TfLiteIntArrayCreate(norm.nodes.size());
+    std::copy(norm.nodes.begin(), norm.nodes.end(), nodes->data);
+    TfLiteDelegateParams* partitions;
+    int num_partitions;
+    const TfLiteStatus status = context_->PreviewDelegatePartitioning(
+        context_, nodes, &partitions, &num_partitions);
+    TfLiteIntArrayFree(nodes);
+    TF_LITE_ENSURE_STATUS(status);
+    *is_isolated = num_partitions == 1 &&
+                   partitions[0].output_tensors->size == 1 &&
+                   partitions[0].output_tensors->data[0] == norm.output;
+    return kTfLiteOk;
+  }
+
+  TfLiteContext* context_;
+  std::vector<Node> nodes_;
+  // The position in the plan of the operator writing each tensor, or -1.
+  std::vector<int> producers_;
+  // The positions in the plan of the operators reading each tensor.
+  std::vector<std::vector<int>> consumers_;
+};
+
+// Runs the normalizations of a partition.
+class NormFusionKernel : public SimpleDelegateKernelInterface {
+ public:
+  explicit NormFusionKernel(const std::vector<FusedNorm>* norms)
+      : all_norms_(norms) {}
+
+  TfLiteStatus Init(TfLiteContext* context,
+                    const TfLiteDelegateParams* params) override {
+    const TfLiteIntArrayView nodes(params->nodes_to_replace);
+    const std::set<int> partition(nodes.begin(), nodes.end());
+    for (const FusedNorm& norm : *all_norms_) {
+      if (partition.count(norm.nodes.back())) norms_.push_back({norm});
+    }
+    // A normalization may read the output of an other one.
+    std::sort(norms_.begin(), norms_.end(),
+              [](const Norm& a, const Norm& b) {
+                return a.fused.nodes.back() < b.fused.nodes.back();
+              });
+    return kTfLiteOk;
+  }
+
+  TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) override {
+    for (Norm& norm : norms_) {
+      const TfLiteTensor* input = &context->tensors[norm.fused.input];
+      TfLiteTensor* output = &context->tensors[norm.fused.output];
+      TF_LITE_ENSURE_TYPES_EQ(context, output->type, input->type);
+      const int columns = SizeOfDimension(input, NumDimensions(input) - 1);
+      TF_LITE_ENSURE_STATUS(DequantizeConstant(context, norm.fused.gamma,
+                                               columns, &norm.gamma));
+      TF_LITE_ENSURE_STATUS(DequantizeConstant(context, norm.fused.beta,
+                                               columns, &norm.beta));
+      TF_LITE_ENSURE_STATUS(context->ResizeTensor(
+          context, output, TfLiteIntArrayCopy(input->dims)));
+    }
+    return kTfLiteOk;
+  }
+
+  TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) override {
+    CpuBackendContext* cpu_backend_context =
+        CpuBackendContext::GetFromContext(context);
+    for (const Norm& norm : norms_) {
+      const TfLiteTensor* input = &context->tensors[norm.fused.input];
+      TfLiteTensor* output = &context->tensors[norm.fused.output];
+      LayerNormalizationParams op_params;
+      op_params.epsilon = norm.fused.epsilon;
+      op_params.input_zero_point = input->params.zero_point;
+      op_params.input_scale = input->params.scale;
+      op_params.output_zero_point = output->params.zero_point;
+      op_params.output_scale = output->params.scale;
+      const float* gamma = norm.gamma.empty() ? nullptr : norm.gamma.data();
+      const float* beta = norm.beta.empty() ? nullptr : norm.beta.data();
+      switch (input->type) {
+        case kTfLiteFloat32:
+          if (norm.fused.kind == NormKind::kLayerNorm) {
+            optimized_ops::LayerNorm(
+                op_params, GetTensorShape(input), GetTensorData<float>(input),
+                gamma, beta, GetTensorData<float>(output), cpu_backend_context);
+          } else {
+            optimized_ops::RmsNorm(
+                op_params, GetTensorShape(input), GetTensorData<float>(input),
+                gamma, beta, GetTensorData<float>(output), cpu_backend_context);
+          }
+          break;
+        case kTfLiteInt8:
+          if (norm.fused.kind == NormKind::kLayerNorm) {
+            optimized_ops::LayerNorm(op_params, GetTensorShape(input),
+                                     GetTensorData<int8_t>(input), gamma, beta,
+                                     GetTensorData<int8_t>(output),
+                                     cpu_backend_context);
+          } else {
+            optimized_ops::RmsNorm(op_params, GetTensorShape(input),
+                                   GetTensorData<int8_t>(input), gamma, beta,
+                                   GetTensorData<int8_t>(output),
+                                   cpu_backend_context);
+          }
+          break;
+        default:
+          TF_LITE_KERNEL_LOG(context, "Type %s is not supported.",
+                             TfLiteTypeGetName(input->type));
+          return kTfLiteError;
+      }
+    }
+    return kTfLiteOk;
+  }
+
+ private:
+  struct Norm {
+    FusedNorm fused;
+    std::vector<float> gamma;
+    std::vector<float> beta;
+  };
+
+  // Copies the constant `tensor`, if any, of `size` values to `values` as
+  // floats.
+  static TfLiteStatus DequantizeConstant(TfLiteContext* context, int tensor,
+                                         int size, std::vector<float>* values) {
+    values->clear();
+    if (tensor < 0) return kTfLiteOk;
+    const TfLiteTensor* constant = &context->tensors[tensor];
+    TF_LITE_ENSURE_EQ(context, NumElements(constant), size);
+    values->resize(size);
+    if (constant->type == kTfLiteFloat32) {
+      std::copy_n(GetTensorData<float>(constant), size, values->begin());
+      return kTfLiteOk;
+    }
+    TF_LITE_ENSURE_TYPES_EQ(context, constant->type, kTfLiteInt8);
+    const int8_t* data = GetTensorData<int8_t>(constant);
+    for (int i = 0; i < size; ++i) {
+      (*values)[i] =
+          (data[i] - constant->params.zero_point) * constant->params.scale;
+    }
+    return kTfLiteOk;
+  }
+
+  // The normalizations of all the partitions of the delegate, only valid
+  // during Init().
+  const std::vector<FusedNorm>* all_norms_;
+  std::vector<Norm> norms_;
+};
+
+class NormFusionDelegate : public SimpleDelegateInterface {
+ public:
+  bool IsNodeSupportedByDelegate(const TfLiteRegistration* registration,
+                                 const TfLiteNode* node,
+                                 TfLiteContext* context) const override {
+    return fused_nodes_.count(node) != 0;
+  }
+
+  TfLiteStatus Initialize(TfLiteContext* context) override {
+    norms_.clear();
+    fused_nodes_.clear();
+    TF_LITE_ENSURE_STATUS(NormMatcher(context).Match(&norms_));
+    for (const FusedNorm& norm : norms_) {
+      for (int node_index : norm.nodes) {
+        TfLiteNode* node;
+        TfLiteRegistration* registration;
+        TF_LITE_ENSURE_STATUS(context->GetNodeAndRegistration(
+            context, node_index, &node, &registration));
+        fused_nodes_.insert(node);
+      }
+    }
+    return kTfLiteOk;
+  }
+
+  const char* Name() const override {
+    static constexpr char kName[] = "NormFusionDelegate";
+    return kName;
+  }
+
+  std::unique_ptr<SimpleDelegateKernelInterface> CreateDelegateKernelInterface()
+      override {
+    return std::make_unique<NormFusionKernel>(&norms_);
+  }
+
+  SimpleDelegateInterface::Options DelegateOptions() const override {
+    return SimpleDelegateInterface::Options();
+  }
+
+ private:
+  std::vector<FusedNorm> norms_;
+  std::set<const TfLiteNode*> fused_nodes_;
+};
+
+}  // namespace norm_fusion
+}  // namespace tflite
+
+TfLiteDelegate* TfLiteNormFusionDelegateCreate() {
+  return tflite::TfLiteDelegateFactory::CreateSimpleDelegate(
+      std::make_unique<tflite::norm_fusion::NormFusionDelegate>());
+}
+
+void TfLiteNormFusionDelegateDelete(TfLiteDelegate* delegate) {
+  tflite::TfLiteDelegateFactory::DeleteSimpleDelegate(delegate);
+}
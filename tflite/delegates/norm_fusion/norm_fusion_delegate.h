@@ -0,0 +1,62 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_DELEGATES_NORM_FUSION_NORM_FUSION_DELEGATE_H_
+#define TENSORFLOW_LITE_DELEGATES_NORM_FUSION_NORM_FUSION_DELEGATE_H_
+
+#include <memory>
+
+#include "tflite/core/c/common.h"
+
+// A delegate which recognizes the layer normalizations and RMS normalizations
+// decomposed into chains of builtin operators, and runs each of them as one
+// fused kernel reading the activations once for their statistics and once to
+// normalize them, instead of one pass and one intermediate tensor per
+// operator. The chains are, over the last axis of float32 or int8 tensors:
+//
+//   LayerNorm: mean = MEAN(x), centered = SUB(x, mean),
+//              variance = MEAN(SQUARE(centered)), or MEAN(MUL(centered,
+//              centered)), or MEAN(SQUARED_DIFFERENCE(x, mean)),
+//              y = MUL(centered, RSQRT(ADD(variance, epsilon)))
+//   RMSNorm:   y = MUL(x, RSQRT(ADD(MEAN(SQUARE(x)), epsilon))), or with
+//              MUL(x, x) for SQUARE(x)
+//
+// optionally followed by a MUL by a constant scale and an ADD of a constant
+// offset of one value per column. Chains whose intermediate tensors are used
+// by other operators or are outputs of the graph are left untouched.
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+// Creates a new delegate instance that needs to be destroyed with
+// `TfLiteNormFusionDelegateDelete` when delegate is no longer used by TFLite.
+TfLiteDelegate* TfLiteNormFusionDelegateCreate();
+
+// Destroys a delegate created with `TfLiteNormFusionDelegateCreate` call.
+void TfLiteNormFusionDelegateDelete(TfLiteDelegate* delegate);
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+// A convenient wrapper that returns C++ std::unique_ptr for automatic memory
+// management.
+inline std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)>
+TfLiteNormFusionDelegateCreateUnique() {
+  return std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)>(
+      TfLiteNormFusionDelegateCreate(), TfLiteNormFusionDelegateDelete);
+}
+
+#endif  // TENSORFLOW_LITE_DELEGATES_NORM_FUSION_NORM_FUSION_DELEGATE_H_
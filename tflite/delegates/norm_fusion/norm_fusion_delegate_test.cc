@@ -0,0 +1,331 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/delegates/norm_fusion/norm_fusion_delegate.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/builtin_ops.h"
+#include "tflite/core/c/builtin_op_data.h"
+#include "tflite/core/c/common.h"
+#include "tflite/core/kernels/builtin_op_kernels.h"
+#include "tflite/interpreter.h"
+
+namespace tflite {
+namespace {
+
+// Builds a graph of builtin operators tensor by tensor.
+class GraphBuilder {
+ public:
+  explicit GraphBuilder(TfLiteType type, float scale = 0.0f)
+      : type_(type), scale_(scale) {
+    interpreter_ = std::make_unique<Interpreter>();
+  }
+
+  int AddInput(const std::vector<int>& shape) {
+    const int tensor = AddTensor(shape);
+    inputs_.push_back(tensor);
+    return tensor;
+  }
+
+  // Adds a constant of the graph type, quantized if it is int8.
+  int AddConstant(const std::vector<int>& shape,
+                  const std::vector<float>& values) {
+    int tensor;
+    interpreter_->AddTensors(1, &tensor);
+    if (type_ == kTfLiteFloat32) {
+      buffers_.emplace_back(values.size() * sizeof(float));
+      std::memcpy(buffers_.back().data(), values.data(),
+                  buffers_.back().size());
+    } else {
+      buffers_.emplace_back(values.size());
+      for (int i = 0; i < values.size(); ++i) {
+        buffers_.back()[i] =
+            static_cast<char>(std::round(values[i] / scale_));
+      }
+    }
+    interpreter_->SetTensorParametersReadOnly(
+        tensor, type_, "", shape, Quantization(), buffers_.back().data(),
+        buffers_.back().size());
+    return tensor;
+  }
+
+  int AddAxis() {
+    int tensor;
+    interpreter_->AddTensors(1, &tensor);
+    interpreter_->SetTensorParametersReadOnly(
+        tensor, kTfLiteInt32, "", {1}, TfLiteQuantizationParams(),
+        reinterpret_cast<const char*>(&kLastAxis), sizeof(kLastAxis));
+    return tensor;
+  }
+
+  int Mean(int input, const std::vector<int>& shape) {
+    auto* params = static_cast<TfLiteReducerParams*>(
+        calloc(1, sizeof(TfLiteReducerParams)));
+    params->keep_dims = true;
+    return AddOp(ops::builtin::Register_MEAN(), kTfLiteBuiltinMean,
+                 {input, AddAxis()}, shape, params);
+  }
+
+  template <typename Params>
+  int Binary(TfLiteRegistration* registration, int builtin_code, int lhs,
+             int rhs, const std::vector<int>& shape) {
+    auto* params = static_cast<Params*>(calloc(1, sizeof(Params)));
+    params->activation = kTfLiteActNone;
+    return AddOp(registration, builtin_code, {lhs, rhs}, shape, params);
+  }
+
+  int Add(int lhs, int rhs, const std::vector<int>& shape) {
+    return Binary<TfLiteAddParams>(ops::builtin::Register_ADD(),
+                                   kTfLiteBuiltinAdd, lhs, rhs, shape);
+  }
+  int Sub(int lhs, int rhs, const std::vector<int>& shape) {
+    return Binary<TfLiteSubParams>(ops::builtin::Register_SUB(),
+                                   kTfLiteBuiltinSub, lhs, rhs, shape);
+  }
+  int Mul(int lhs, int rhs, const std::vector<int>& shape) {
+    return Binary<TfLiteMulParams>(ops::builtin::Register_MUL(),
+                                   kTfLiteBuiltinMul, lhs, rhs, shape);
+  }
+  int SquaredDifference(int lhs, int rhs, const std::vector<int>& shape) {
+    return AddOp(ops::builtin::Register_SQUARED_DIFFERENCE(),
+                 kTfLiteBuiltinSquaredDifference, {lhs, rhs}, shape, nullptr);
+  }
+  int Square(int input, const std::vector<int>& shape) {
+    return AddOp(ops::builtin::Register_SQUARE(), kTfLiteBuiltinSquare,
+                 {input}, shape, nullptr);
+  }
+  int Rsqrt(int input, const std::vector<int>& shape) {
+    return AddOp(ops::builtin::Register_RSQRT(), kTfLiteBuiltinRsqrt, {input},
+                 shape, nullptr);
+  }
+
+  Interpreter* Build(const std::vector<int>& outputs) {
+    interpreter_->SetInputs(inputs_);
+    interpreter_->SetOutputs(outputs);
+    return interpreter_.get();
+  }
+
+ private:
+  static constexpr int32_t kLastAxis = -1;
+
+  TfLiteQuantizationParams Quantization() const {
+    TfLiteQuantizationParams quantization;
+    quantization.scale = scale_;
+    quantization.zero_point = 0;
+    return quantization;
+  }
+
+  int AddTensor(const std::vector<int>& shape) {
+    int tensor;
+    interpreter_->AddTensors(1, &tensor);
+    interpreter_->SetTensorParametersReadWrite(tensor, type_, "", shape,
+                                               Quantization());
+    return tensor;
+  }
+
+  int AddOp(TfLiteRegistration* registration, int builtin_code,
+            const std::vector<int>& inputs, const std::vector<int>& shape,
+            void* builtin_data) {
+    const int output = AddTensor(shape);
+    TfLiteRegistration builtin = *registration;
+    builtin.builtin_code = builtin_code;
+    interpreter_->AddNodeWithParameters(inputs, {output}, nullptr, 0,
+                                        builtin_data, &builtin);
+    return output;
+  }
+
+  TfLiteType type_;
+  float scale_;
+  std::vector<int> inputs_;
+  std::vector<std::vector<char>> buffers_;
+  std::unique_ptr<Interpreter> interpreter_;
+};
+
+constexpr int kRows = 3;
+constexpr int kColumns = 70;
+const std::vector<int> kShape = {1, kRows, kColumns};
+const std::vector<int> kStatisticsShape = {1, kRows, 1};
+
+std::vector<float> RandomValues(int size, float offset, int seed) {
+  std::mt19937 random_engine(seed);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  std::vector<float> values(size);
+  for (float& value : values) value = offset + distribution(random_engine);
+  return values;
+}
+
+enum class Variance { kSquare, kMul, kSquaredDifference };
+
+// x -> (x - mean) * rsqrt(variance + epsilon) * gamma + beta.
+Interpreter* BuildLayerNorm(GraphBuilder* builder, Variance variance_ops,
+                            bool expose_intermediate = false) {
+  const int x = builder->AddInput(kShape);
+  const int mean = builder->Mean(x, kStatisticsShape);
+  int squares;
+  int centered;
+  if (variance_ops == Variance::kSquaredDifference) {
+    squares = builder->SquaredDifference(x, mean, kShape);
+    centered = builder->Sub(x, mean, kShape);
+  } else {
+    centered = builder->Sub(x, mean, kShape);
+    squares = variance_ops == Variance::kSquare
+                  ? builder->Square(centered, kShape)
+                  : builder->Mul(centered, centered, kShape);
+  }
+  const int variance = builder->Mean(squares, kStatisticsShape);
+  const int epsilon = builder->AddConstant({1}, {1e-5f});
+  const int inv_stddev = builder->Rsqrt(
+      builder->Add(variance, epsilon, kStatisticsShape), kStatisticsShape);
+  const int normalized = builder->Mul(centered, inv_stddev, kShape);
+  const int gamma =
+      builder->AddConstant({kColumns}, RandomValues(kColumns, 1.0f, 1));
+  const int beta =
+      builder->AddConstant({kColumns}, RandomValues(kColumns, 0.0f, 2));
+  const int output =
+      builder->Add(builder->Mul(normalized, gamma, kShape), beta, kShape);
+  if (expose_intermediate) return builder->Build({output, inv_stddev});
+  return builder->Build({output});
+}
+
+// x -> x * rsqrt(mean(x * x) + epsilon) * gamma.
+Interpreter* BuildRmsNorm(GraphBuilder* builder) {
+  const int x = builder->AddInput(kShape);
+  const int mean_square =
+      builder->Mean(builder->Mul(x, x, kShape), kStatisticsShape);
+  const int epsilon = builder->AddConstant({1}, {1e-6f});
+  const int inv_rms = builder->Rsqrt(
+      builder->Add(mean_square, epsilon, kStatisticsShape), kStatisticsShape);
+  const int gamma =
+      builder->AddConstant({kColumns}, RandomValues(kColumns, 1.0f, 3));
+  const int output =
+      builder->Mul(builder->Mul(x, inv_rms, kShape), gamma, kShape);
+  return builder->Build({output});
+}
+
+std::vector<float> RunFloat(Interpreter* interpreter,
+                            const std::vector<float>& input) {
+  EXPECT_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+  std::memcpy(interpreter->typed_input_tensor<float>(0), input.data(),
+              input.size() * sizeof(float));
+  EXPECT_EQ(interpreter->Invoke(), kTfLiteOk);
+  const float* output = interpreter->typed_output_tensor<float>(0);
+  return std::vector<float>(output, output + input.size());
+}
+
+class NormFusionDelegateTest : public ::testing::Test {
+ protected:
+  // Checks that the graph built by `build` is delegated to one fused kernel
+  // computing the same results as the decomposed operators.
+  template <typename BuildFn>
+  void ExpectFusedMatchesDecomposed(const BuildFn& build) {
+    const std::vector<float> input =
+        RandomValues(kRows * kColumns, /*offset=*/5.0f, /*seed=*/4);
+    GraphBuilder reference_builder(kTfLiteFloat32);
+    const std::vector<float> expected =
+        RunFloat(build(&reference_builder), input);
+
+    GraphBuilder builder(kTfLiteFloat32);
+    Interpreter* interpreter = build(&builder);
+    ASSERT_EQ(interpreter->ModifyGraphWithDelegate(delegate_.get()),
+              kTfLiteOk);
+    EXPECT_EQ(interpreter->execution_plan().size(), 1);
+    const std::vector<float> output = RunFloat(interpreter, input);
+    for (int i = 0; i < expected.size(); ++i) {
+      EXPECT_NEAR(output[i], expected[i], 1e-4f) << i;
+    }
+  }
+
+  std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)> delegate_ =
+      TfLiteNormFusionDelegateCreateUnique();
+};
+
+TEST_F(NormFusionDelegateTest, LayerNormWithSquare) {
+  ExpectFusedMatchesDecomposed([](GraphBuilder* builder) {
+    return BuildLayerNorm(builder, Variance::kSquare);
+  });
+}
+
+TEST_F(NormFusionDelegateTest, LayerNormWithMul) {
+  ExpectFusedMatchesDecomposed([](GraphBuilder* builder) {
+    return BuildLayerNorm(builder, Variance::kMul);
+  });
+}
+
+TEST_F(NormFusionDelegateTest, LayerNormWithSquaredDifference) {
+  ExpectFusedMatchesDecomposed([](GraphBuilder* builder) {
+    return BuildLayerNorm(builder, Variance::kSquaredDifference);
+  });
+}
+
+TEST_F(NormFusionDelegateTest, RmsNorm) {
+  ExpectFusedMatchesDecomposed(BuildRmsNorm);
+}
+
+TEST_F(NormFusionDelegateTest, IntermediateOutputIsNotFused) {
+  GraphBuilder builder(kTfLiteFloat32);
+  Interpreter* interpreter = BuildLayerNorm(&builder, Variance::kSquare,
+                                            /*expose_intermediate=*/true);
+  const int num_nodes = interpreter->execution_plan().size();
+  ASSERT_EQ(interpreter->ModifyGraphWithDelegate(delegate_.get()), kTfLiteOk);
+  EXPECT_EQ(interpreter->execution_plan().size(), num_nodes);
+}
+
+TEST_F(NormFusionDelegateTest, Int8RmsNorm) {
+  constexpr float kScale = 1.0f / 32;
+  GraphBuilder builder(kTfLiteInt8, kScale);
+  Interpreter* interpreter = BuildRmsNorm(&builder);
+  ASSERT_EQ(interpreter->ModifyGraphWithDelegate(delegate_.get()), kTfLiteOk);
+  ASSERT_EQ(interpreter->execution_plan().size(), 1);
+  ASSERT_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+
+  const std::vector<float> values = RandomValues(kRows * kColumns, 0.0f, 5);
+  int8_t* input = interpreter->typed_input_tensor<int8_t>(0);
+  for (int i = 0; i < values.size(); ++i) {
+    input[i] = static_cast<int8_t>(std::round(values[i] / kScale));
+  }
+  ASSERT_EQ(interpreter->Invoke(), kTfLiteOk);
+  const int8_t* output = interpreter->typed_output_tensor<int8_t>(0);
+  const std::vector<float> gamma = RandomValues(kColumns, 1.0f, 3);
+  for (int row = 0; row < kRows; ++row) {
+    float mean_square = 0.0f;
+    for (int i = 0; i < kColumns; ++i) {
+      const float value = input[row * kColumns + i] * kScale;
+      mean_square += value * value;
+    }
+    mean_square /= kColumns;
+    for (int i = 0; i < kColumns; ++i) {
+      // The constants are quantized like the activations.
+      const float scale = std::round(gamma[i] / kScale) * kScale;
+      const float expected = input[row * kColumns + i] * kScale /
+                             std::sqrt(mean_square + 1e-6f) * scale;
+      EXPECT_NEAR(output[row * kColumns + i] * kScale,
+                  std::max(-128 * kScale, std::min(127 * kScale, expected)),
+                  kScale)
+          << row << " " << i;
+    }
+  }
+}
+
+}  // namespace
+}  // namespace tflite
@@ -0,0 +1,479 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/delegates/residual_fusion/residual_fusion_delegate.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "tflite/builtin_ops.h"
+#include "tflite/context_util.h"
+#include "tflite/core/c/builtin_op_data.h"
+#include "tflite/core/c/common.h"
+#include "tflite/delegates/utils/simple_delegate.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/internal/optimized/fused_residual.h"
+#include "tflite/kernels/internal/tensor_ctypes.h"
+#include "tflite/kernels/internal/types.h"
+#include "tflite/kernels/kernel_util.h"
+
+namespace tflite {
+namespace residual_fusion {
+
+// A pointwise convolution or fully connected layer followed by the addition
+// of a residual, and the tensors they read and write.
+struct FusedResidual {
+  // The indices of the operators.
+  int product_node;
+  int add_node;
+  int input;
+  int filter;
+  // The optional bias, or -1.
+  int bias;
+  // The output of the matrix multiply, which is not computed.
+  int product;
+  int residual;
+  int output;
+  TfLiteFusedActivation product_activation;
+  TfLiteFusedActivation activation;
+};
+
+// Finds the residual additions of an execution plan.
+class ResidualMatcher {
+ public:
+  explicit ResidualMatcher(TfLiteContext* context) : context_(context) {}
+
+  TfLiteStatus Match(std::vector<FusedResidual>* residuals) {
+    TfLiteIntArray* plan;
+    TF_LITE_ENSURE_STATUS(context_->GetExecutionPlan(context_, &plan));
+    producers_.assign(context_->tensors_size, -1);
+    consumers_.assign(context_->tensors_size, {});
+    nodes_.resize(plan->size);
+    for (int i = 0; i < plan->size; ++i) {
+      Node& node = nodes_[i];
+      node.index = plan->data[i];
+      TF_LITE_ENSURE_STATUS(context_->GetNodeAndRegistration(
+          context_, node.index, &node.node, &node.registration));
+      for (int output : TfLiteIntArrayView(node.node->outputs)) {
+        if (output >= 0) producers_[output] = i;
+      }
+      for (int input : TfLiteIntArrayView(node.node->inputs)) {
+        if (input >= 0) consumers_[input].push_back(i);
+      }
+    }
+
+    for (int i = 0; i < nodes_.size(); ++i) {
+      if (nodes_[i].registration->builtin_code != kTfLiteBuiltinAdd ||
+          nodes_[i].node->inputs->size != 2 ||
+          nodes_[i].node->outputs->size != 1) {
+        continue;
+      }
+      // Either operand of the addition may be the product.
+      for (int operand = 0; operand < 2; ++operand) {
+        FusedResidual residual;
+        if (!MatchAdd(i, operand, &residual)) continue;
+        bool is_isolated;
+        TF_LITE_ENSURE_STATUS(IsIsolated(residual, &is_isolated));
+        if (!is_isolated) continue;
+        residual.product_node = nodes_[residual.product_node].index;
+        residual.add_node = nodes_[residual.add_node].index;
+        residuals->push_back(residual);
+        break;
+      }
+    }
+    return kTfLiteOk;
+  }
+
+ private:
+  struct Node {
+    int index;
+    TfLiteNode* node;
+    TfLiteRegistration* registration;
+  };
+
+  const TfLiteTensor& Tensor(int tensor) const {
+    return context_->tensors[tensor];
+  }
+
+  int Input(int node, int i) const {
+    return nodes_[node].node->inputs->data[i];
+  }
+
+  int Output(int node) const { return nodes_[node].node->outputs->data[0]; }
+
+  // Returns whether the fused activation is a clamp of its input.
+  static bool IsClamp(TfLiteFusedActivation activation) {
+    return activation == kTfLiteActNone || activation == kTfLiteActRelu ||
+           activation == kTfLiteActReluN1To1 || activation == kTfLiteActRelu6;
+  }
+
+  bool IsConstant(int tensor) const {
+    return tensor >= 0 && Tensor(tensor).allocation_type == kTfLiteMmapRo;
+  }
+
+  // Returns whether the int8 `tensor` has a per tensor scale and zero point.
+  bool HasQuantization(int tensor) const {
+    return Tensor(tensor).params.scale != 0;
+  }
+
+  // Returns whether the int8 filter is quantized symmetrically, per tensor or
+  // per output channel.
+  bool IsSymmetricFilter(int filter) const {
+    const TfLiteTensor& tensor = Tensor(filter);
+    if (tensor.quantization.type != kTfLiteAffineQuantization) return false;
+    const auto* params = static_cast<const TfLiteAffineQuantization*>(
+        tensor.quantization.params);
+    if (params == nullptr || params->scale == nullptr ||
+        params->zero_point == nullptr ||
+        (params->scale->size != 1 &&
+         (params->quantized_dimension != 0 ||
+          params->scale->size != SizeOfDimension(&tensor, 0)))) {
+      return false;
+    }
+    const TfLiteIntArrayView zero_points(params->zero_point);
+    return std::all_of(zero_points.begin(), zero_points.end(),
+                       [](int zero_point) { return zero_point == 0; });
+  }
+
+  // Returns whether the operator at position `node` in the plan is a pointwise
+  // convolution or a fully connected layer with constant weights, and sets
+  // its tensors.
+  bool MatchProduct(int node, FusedResidual* residual) const {
+    const TfLiteNode* tflite_node = nodes_[node].node;
+    if (tflite_node->inputs->size < 2 || tflite_node->inputs->size > 3 ||
+        tflite_node->outputs->size != 1) {
+      return false;
+    }
+    residual->product_node = node;
+    residual->input = Input(node, 0);
+    residual->filter = Input(node, 1);
+    residual->bias = tflite_node->inputs->size == 3 ? Input(node, 2) : -1;
+    residual->product = Output(node);
+    if (!IsConstant(residual->filter) ||
+        (residual->bias >= 0 && !IsConstant(residual->bias))) {
+      return false;
+    }
+    const TfLiteTensor& input = Tensor(residual->input);
+    const TfLiteTensor& filter = Tensor(residual->filter);
+    switch (nodes_[node].registration->builtin_code) {
+      case kTfLiteBuiltinConv2d: {
+        const auto* params =
+            static_cast<const TfLiteConvParams*>(tflite_node->builtin_data);
+        if (params == nullptr || params->stride_width != 1 ||
+            params->stride_height != 1 || params->dilation_width_factor != 1 ||
+            params->dilation_height_factor != 1 ||
+            NumDimensions(&filter) != 4 || SizeOfDimension(&filter, 1) != 1 ||
+            SizeOfDimension(&filter, 2) != 1 || NumDimensions(&input) != 4 ||
+            SizeOfDimension(&input, 3) != SizeOfDimension(&filter, 3)) {
+          return false;
+        }
+        residual->product_activation = params->activation;
+        break;
+      }
+      case kTfLiteBuiltinFullyConnected: {
+        const auto* params = static_cast<const TfLiteFullyConnectedParams*>(
+            tflite_node->builtin_data);
+        if (params == nullptr ||
+            params->weights_format !=
+                kTfLiteFullyConnectedWeightsFormatDefault ||
+            NumDimensions(&filter) != 2 || filter.sparsity != nullptr ||
+            NumDimensions(&input) == 0 ||
+            NumElements(&input) % SizeOfDimension(&filter, 1) != 0) {
+          return false;
+        }
+        residual->product_activation = params->activation;
+        break;
+      }
+      default:
+        return false;
+    }
+    return true;
+  }
+
+  // Matches the ADD at position `add` in the plan of its input `operand` by
+  // the product of an other operator and a residual of the same shape.
+  bool MatchAdd(int add, int operand, FusedResidual* residual) const {
+    const int product = Input(add, operand);
+    if (product < 0 || producers_[product] < 0 ||
+        consumers_[product].size() != 1 ||
+        !MatchProduct(producers_[product], residual)) {
+      return false;
+    }
+    const auto* params =
+        static_cast<const TfLiteAddParams*>(nodes_[add].node->builtin_data);
+    residual->add_node = add;
+    residual->residual = Input(add, 1 - operand);
+    residual->output = Output(add);
+    residual->activation =
+        params == nullptr ? kTfLiteActNone : params->activation;
+    if (residual->residual < 0 || residual->residual == product ||
+        !TfLiteIntArrayEqual(Tensor(product).dims,
+                             Tensor(residual->residual).dims)) {
+      return false;
+    }
+    if (!IsClamp(residual->activation) ||
+        !IsClamp(residual->product_activation)) {
+      return false;
+    }
+
+    // All the tensors have the type of the input, and the int8 ones are
+    // quantized per tensor, except the filter.
+    const TfLiteType type = Tensor(residual->input).type;
+    for (int tensor : {residual->filter, residual->product, residual->residual,
+                       residual->output}) {
+      if (Tensor(tensor).type != type) return false;
+    }
+    if (type == kTfLiteFloat32) {
+      return residual->bias < 0 || Tensor(residual->bias).type == type;
+    }
+    if (type != kTfLiteInt8 ||
+        (residual->bias >= 0 && Tensor(residual->bias).type != kTfLiteInt32)) {
+      return false;
+    }
+    return HasQuantization(residual->input) &&
+           HasQuantization(residual->product) &&
+           HasQuantization(residual->residual) &&
+           HasQuantization(residual->output) &&
+           IsSymmetricFilter(residual->filter);
+  }
+
+  // Returns in `is_isolated` whether the only tensor of the two operators
+  // used after them, including as an output of the graph, is their output.
+  TfLiteStatus IsIsolated(const FusedResidual& residual,
+                          bool* is_isolated) const {
+    TfLiteIntArray* nodes = TfLiteIntArrayCreate(2);
+    nodes->data[0] = nodes_[residual.product_node].index;
+    nodes->data[1] = nodes_[residual.add_node].index;
+    TfLiteDelegateParams* partitions;
+    int num_partitions;
+    const TfLiteStatus status = context_->PreviewDelegatePartitioning(
+        context_, nodes, &partitions, &num_partitions);
+    TfLiteIntArrayFree(nodes);
+    TF_LITE_ENSURE_STATUS(status);
+    *is_isolated = num_partitions == 1 &&
+                   partitions[0].output_tensors->size == 1 &&
+                   partitions[0].output_tensors->data[0] == residual.output;
+    return kTfLiteOk;
+  }
+
+  TfLiteContext* context_;
+  std::vector<Node> nodes_;
+  // The position in the plan of the operator writing each tensor, or -1.
+  std::vector<int> producers_;
+  // The positions in the plan of the operators reading each tensor.
+  std::vector<std::vector<int>> consumers_;
+};
+
+// Runs the residual additions of a partition.
+class ResidualFusionKernel : public SimpleDelegateKernelInterface {
+ public:
+  explicit ResidualFusionKernel(const std::vector<FusedResidual>* residuals)
+      : all_residuals_(residuals) {}
+
+  TfLiteStatus Init(TfLiteContext* context,
+                    const TfLiteDelegateParams* params) override {
+    const TfLiteIntArrayView nodes(params->nodes_to_replace);
+    const std::set<int> partition(nodes.begin(), nodes.end());
+    for (const FusedResidual& residual : *all_residuals_) {
+      if (partition.count(residual.add_node)) {
+        residuals_.push_back({residual});
+      }
+    }
+    // A residual addition may read the output of an other one.
+    std::sort(residuals_.begin(), residuals_.end(),
+              [](const Residual& a, const Residual& b) {
+                return a.fused.add_node < b.fused.add_node;
+              });
+    return kTfLiteOk;
+  }
+
+  TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) override {
+    size_t scratch_size = 0;
+    for (Residual& residual : residuals_) {
+      const FusedResidual& fused = residual.fused;
+      const TfLiteTensor* input = &context->tensors[fused.input];
+      const TfLiteTensor* filter = &context->tensors[fused.filter];
+      const TfLiteTensor* residual_tensor = &context->tensors[fused.residual];
+      TfLiteTensor* output = &context->tensors[fused.output];
+      const int output_depth = SizeOfDimension(filter, 0);
+      const int accum_depth = NumElements(filter) / output_depth;
+      TF_LITE_ENSURE_EQ(context, NumElements(input) % accum_depth, 0);
+      TF_LITE_ENSURE_EQ(context, NumElements(residual_tensor),
+                        NumElements(input) / accum_depth * output_depth);
+      TF_LITE_ENSURE_EQ(
+          context,
+          SizeOfDimension(residual_tensor,
+                          NumDimensions(residual_tensor) - 1),
+          output_depth);
+      TF_LITE_ENSURE_STATUS(context->ResizeTensor(
+          context, output, TfLiteIntArrayCopy(residual_tensor->dims)));
+
+      FusedResidualParams& params = residual.params;
+      if (input->type == kTfLiteFloat32) {
+        CalculateActivationRange(fused.product_activation, &params.product_min,
+                                 &params.product_max);
+        CalculateActivationRange(fused.activation,
+                                 &params.float_activation_min,
+                                 &params.float_activation_max);
+        continue;
+      }
+      // The products are clamped to the range of their quantized tensor,
+      // which is not computed, as real values.
+      TfLiteTensor* product = &context->tensors[fused.product];
+      int32_t product_min;
+      int32_t product_max;
+      TF_LITE_ENSURE_STATUS(CalculateActivationRangeQuantized(
+          context, fused.product_activation, product, &product_min,
+          &product_max));
+      params.product_min =
+          (product_min - product->params.zero_point) * product->params.scale;
+      params.product_max =
+          (product_max - product->params.zero_point) * product->params.scale;
+      TF_LITE_ENSURE_STATUS(CalculateActivationRangeQuantized(
+          context, fused.activation, output, &params.quantized_activation_min,
+          &params.quantized_activation_max));
+      const auto* filter_params = static_cast<const TfLiteAffineQuantization*>(
+          filter->quantization.params);
+      residual.product_scales.resize(output_depth);
+      for (int c = 0; c < output_depth; ++c) {
+        residual.product_scales[c] =
+            input->params.scale *
+            filter_params->scale->data[filter_params->scale->size == 1 ? 0
+                                                                       : c];
+      }
+      params.product_scales = residual.product_scales.data();
+      params.input_zero_point = input->params.zero_point;
+      params.residual_zero_point = residual_tensor->params.zero_point;
+      params.residual_scale = residual_tensor->params.scale;
+      params.output_zero_point = output->params.zero_point;
+      params.output_scale = output->params.scale;
+      scratch_size = std::max<size_t>(
+          scratch_size, optimized_ops::FullyConnectedResidualAddScratchSize(
+                            GetTensorShape(filter), GetTensorShape(output)));
+    }
+    scratch_.resize(scratch_size);
+    return kTfLiteOk;
+  }
+
+  TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) override {
+    CpuBackendContext* cpu_backend_context =
+        CpuBackendContext::GetFromContext(context);
+    for (const Residual& residual : residuals_) {
+      const FusedResidual& fused = residual.fused;
+      const TfLiteTensor* input = &context->tensors[fused.input];
+      const TfLiteTensor* filter = &context->tensors[fused.filter];
+      const TfLiteTensor* bias =
+          fused.bias >= 0 ? &context->tensors[fused.bias] : nullptr;
+      const TfLiteTensor* residual_tensor = &context->tensors[fused.residual];
+      TfLiteTensor* output = &context->tensors[fused.output];
+      switch (input->type) {
+        case kTfLiteFloat32:
+          optimized_ops::FullyConnectedResidualAdd(
+              residual.params, GetTensorShape(input),
+              GetTensorData<float>(input), GetTensorShape(filter),
+              GetTensorData<float>(filter), GetTensorData<float>(bias),
+              GetTensorData<float>(residual_tensor), GetTensorShape(output),
+              GetTensorData<float>(output), cpu_backend_context);
+          break;
+        case kTfLiteInt8:
+          optimized_ops::FullyConnectedResidualAdd(
+              residual.params, GetTensorShape(input),
+              GetTensorData<int8_t>(input), GetTensorShape(filter),
+              GetTensorData<int8_t>(filter), GetTensorData<int32_t>(bias),
+              GetTensorData<int8_t>(residual_tensor), GetTensorShape(output),
+              GetTensorData<int8_t>(output), scratch_.data(),
+              cpu_backend_context);
+          break;
+        default:
+          TF_LITE_KERNEL_LOG(context, "Type %s is not supported.",
+                             TfLiteTypeGetName(input->type));
+          return kTfLiteError;
+      }
+    }
+    return kTfLiteOk;
+  }
+
+ private:
+  struct Residual {
+    FusedResidual fused;
+    FusedResidualParams params;
+    std::vector<float> product_scales;
+  };
+
+  // The residual additions of all the partitions of the delegate, only valid
+  // during Init().
+  const std::vector<FusedResidual>* all_residuals_;
+  std::vector<Residual> residuals_;
+  // The accumulators of the int8 products.
+  std::vector<int32_t> scratch_;
+};
+
+class ResidualFusionDelegate : public SimpleDelegateInterface {
+ public:
+  bool IsNodeSupportedByDelegate(const TfLiteRegistration* registration,
+                                 const TfLiteNode* node,
+                                 TfLiteContext* context) const override {
+    return fused_nodes_.count(node) != 0;
+  }
+
+  TfLiteStatus Initialize(TfLiteContext* context) override {
+    residuals_.clear();
+    fused_nodes_.clear();
+    TF_LITE_ENSURE_STATUS(ResidualMatcher(context).Match(&residuals_));
+    for (const FusedResidual& residual : residuals_) {
+      for (int node_index : {residual.product_node, residual.add_node}) {
+        TfLiteNode* node;
+        TfLiteRegistration* registration;
+        TF_LITE_ENSURE_STATUS(context->GetNodeAndRegistration(
+            context, node_index, &node, &registration));
+        fused_nodes_.insert(node);
+      }
+    }
+    return kTfLiteOk;
+  }
+
+  const char* Name() const override {
+    static constexpr char kName[] = "ResidualFusionDelegate";
+    return kName;
+  }
+
+  std::unique_ptr<SimpleDelegateKernelInterface> CreateDelegateKernelInterface()
+      override {
+    return std::make_unique<ResidualFusionKernel>(&residuals_);
+  }
+
+  SimpleDelegateInterface::Options DelegateOptions() const override {
+    return SimpleDelegateInterface::Options();
+  }
+
+ private:
+  std::vector<FusedResidual> residuals_;
+  std::set<const TfLiteNode*> fused_nodes_;
+};
+
+}  // namespace residual_fusion
+}  // namespace tflite
+
+TfLiteDelegate* TfLiteResidualFusionDelegateCreate() {
+  return tflite::TfLiteDelegateFactory::CreateSimpleDelegate(
+      std::make_unique<tflite::residual_fusion::ResidualFusionDelegate>());
+}
+
+void TfLiteResidualFusionDelegateDelete(TfLiteDelegate* delegate) {
+  tflite::TfLiteDelegateFactory::DeleteSimpleDelegate(delegate);
+}
@@ -0,0 +1,60 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_DELEGATES_RESIDUAL_FUSION_RESIDUAL_FUSION_DELEGATE_H_
+#define TENSORFLOW_LITE_DELEGATES_RESIDUAL_FUSION_RESIDUAL_FUSION_DELEGATE_H_
+
+#include <memory>
+
+#include "tflite/core/c/common.h"
+
+// A delegate which runs each pointwise CONV_2D (1x1 filter, unit strides and
+// dilations) or FULLY_CONNECTED operator whose output is only read by an ADD
+// of a tensor of the same shape, as in the residual connections of ResNet and
+// MobileNet blocks, as one kernel. The kernel adds the residual to blocks of
+// the products while they are still in the cache, instead of writing all of
+// them to an intermediate tensor which the ADD reads back. The fused
+// activations of both operators are applied.
+//
+// The float32 operators and the int8 ones with symmetric filters quantized
+// per tensor or per output channel are fused. The int8 products are scaled
+// and added to the residual as real values which are quantized once, so the
+// results can differ by one quantization step from the unfused operators,
+// which quantize the products first.
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+// Creates a new delegate instance that needs to be destroyed with
+// `TfLiteResidualFusionDelegateDelete` when delegate is no longer used by
+// TFLite.
+TfLiteDelegate* TfLiteResidualFusionDelegateCreate();
+
+// Destroys a delegate created with `TfLiteResidualFusionDelegateCreate` call.
+void TfLiteResidualFusionDelegateDelete(TfLiteDelegate* delegate);
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+// A convenient wrapper that returns C++ std::unique_ptr for automatic memory
+// management.
+inline std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)>
+TfLiteResidualFusionDelegateCreateUnique() {
+  return std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)>(
+      TfLiteResidualFusionDelegateCreate(), TfLiteResidualFusionDelegateDelete);
+}
+
+#endif  // TENSORFLOW_LITE_DELEGATES_RESIDUAL_FUSION_RESIDUAL_FUSION_DELEGATE_H_
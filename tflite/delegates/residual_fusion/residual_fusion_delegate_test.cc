@@ -0,0 +1,349 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/delegates/residual_fusion/residual_fusion_delegate.h"
+
+#include <stdlib.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/builtin_ops.h"
+#include "tflite/core/c/builtin_op_data.h"
+#include "tflite/core/c/common.h"
+#include "tflite/core/kernels/builtin_op_kernels.h"
+#include "tflite/interpreter.h"
+
+namespace tflite {
+namespace {
+
+// The scale of the int8 activations and filters.
+constexpr float kScale = 1.0f / 16;
+
+// Builds a graph of builtin operators tensor by tensor. The activations and
+// filters of int8 graphs are quantized with kScale and no zero point, the
+// biases with the scale of their accumulators.
+class GraphBuilder {
+ public:
+  explicit GraphBuilder(TfLiteType type) : type_(type) {
+    interpreter_ = std::make_unique<Interpreter>();
+  }
+
+  int AddInput(const std::vector<int>& shape) {
+    const int tensor = AddTensor(shape);
+    inputs_.push_back(tensor);
+    return tensor;
+  }
+
+  int AddFilter(const std::vector<int>& shape,
+                const std::vector<float>& values) {
+    if (type_ == kTfLiteFloat32) {
+      return AddConstant(kTfLiteFloat32, shape, values.data(),
+                         values.size() * sizeof(float), 0.0f);
+    }
+    std::vector<int8_t> quantized(values.size());
+    for (int i = 0; i < values.size(); ++i) {
+      quantized[i] = static_cast<int8_t>(std::round(values[i] / kScale));
+    }
+    return AddConstant(kTfLiteInt8, shape, quantized.data(), quantized.size(),
+                       kScale);
+  }
+
+  int AddBias(const std::vector<float>& values) {
+    const int size = values.size();
+    if (type_ == kTfLiteFloat32) {
+      return AddConstant(kTfLiteFloat32, {size}, values.data(),
+                         size * sizeof(float), 0.0f);
+    }
+    std::vector<int32_t> quantized(size);
+    for (int i = 0; i < size; ++i) {
+      quantized[i] =
+          static_cast<int32_t>(std::round(values[i] / (kScale * kScale)));
+    }
+    return AddConstant(kTfLiteInt32, {size}, quantized.data(),
+                       size * sizeof(int32_t), kScale * kScale);
+  }
+
+  int Conv(int input, int filter, int bias, const std::vector<int>& shape,
+           TfLiteFusedActivation activation, int stride = 1) {
+    auto* params =
+        static_cast<TfLiteConvParams*>(calloc(1, sizeof(TfLiteConvParams)));
+    params->padding = kTfLitePaddingSame;
+    params->stride_width = stride;
+    params->stride_height = stride;
+    params->dilation_width_factor = 1;
+    params->dilation_height_factor = 1;
+    params->activation = activation;
+    return AddOp(ops::builtin::Register_CONV_2D(), kTfLiteBuiltinConv2d,
+                 {input, filter, bias}, shape, params);
+  }
+
+  int FullyConnected(int input, int filter, int bias,
+                     const std::vector<int>& shape,
+                     TfLiteFusedActivation activation) {
+    auto* params = static_cast<TfLiteFullyConnectedParams*>(
+        calloc(1, sizeof(TfLiteFullyConnectedParams)));
+    params->weights_format = kTfLiteFullyConnectedWeightsFormatDefault;
+    params->activation = activation;
+    return AddOp(ops::builtin::Register_FULLY_CONNECTED(),
+                 kTfLiteBuiltinFullyConnected, {input, filter, bias}, shape,
+                 params);
+  }
+
+  int Add(int lhs, int rhs, const std::vector<int>& shape,
+          TfLiteFusedActivation activation) {
+    auto* params =
+        static_cast<TfLiteAddParams*>(calloc(1, sizeof(TfLiteAddParams)));
+    params->activation = activation;
+    return AddOp(ops::builtin::Register_ADD(), kTfLiteBuiltinAdd, {lhs, rhs},
+                 shape, params);
+  }
+
+  Interpreter* Build(const std::vector<int>& outputs) {
+    interpreter_->SetInputs(inputs_);
+    interpreter_->SetOutputs(outputs);
+    return interpreter_.get();
+  }
+
+ private:
+  TfLiteQuantizationParams Quantization(float scale) const {
+    TfLiteQuantizationParams quantization;
+    quantization.scale = scale;
+    quantization.zero_point = 0;
+    return quantization;
+  }
+
+  int AddConstant(TfLiteType type, const std::vector<int>& shape,
+                  const void* data, size_t bytes, float scale) {
+    int tensor;
+    interpreter_->AddTensors(1, &tensor);
+    buffers_.emplace_back(bytes);
+    std::memcpy(buffers_.back().data(), data, bytes);
+    interpreter_->SetTensorParametersReadOnly(
+        tensor, type, "", shape, Quantization(scale), buffers_.back().data(),
+        buffers_.back().size());
+    return tensor;
+  }
+
+  int AddTensor(const std::vector<int>& shape) {
+    int tensor;
+    interpreter_->AddTensors(1, &tensor);
+    interpreter_->SetTensorParametersReadWrite(
+        tensor, type_, "", shape,
+        Quantization(type_ == kTfLiteInt8 ? kScale : 0.0f));
+    return tensor;
+  }
+
+  int AddOp(TfLiteRegistration* registration, int builtin_code,
+            const std::vector<int>& inputs, const std::vector<int>& shape,
+            void* builtin_data) {
+    const int output = AddTensor(shape);
+    TfLiteRegistration builtin = *registration;
+    builtin.builtin_code = builtin_code;
+    interpreter_->AddNodeWithParameters(inputs, {output}, nullptr, 0,
+                                        builtin_data, &builtin);
+    return output;
+  }
+
+  TfLiteType type_;
+  std::vector<int> inputs_;
+  std::vector<std::vector<char>> buffers_;
+  std::unique_ptr<Interpreter> interpreter_;
+};
+
+// More rows than one block of the fused kernel.
+const std::vector<int> kConvInputShape = {1, 24, 24, 16};
+const std::vector<int> kConvOutputShape = {1, 24, 24, 64};
+constexpr int kFullyConnectedRows = 6;
+constexpr int kFullyConnectedDepth = 48;
+constexpr int kFullyConnectedUnits = 32;
+
+std::vector<float> RandomValues(int size, float range, int seed) {
+  std::mt19937 random_engine(seed);
+  std::uniform_real_distribution<float> distribution(-range, range);
+  std::vector<float> values(size);
+  for (float& value : values) value = distribution(random_engine);
+  return values;
+}
+
+int FlatSize(const std::vector<int>& shape) {
+  int size = 1;
+  for (int dim : shape) size *= dim;
+  return size;
+}
+
+// x, residual -> (conv1x1(x) + residual)
+Interpreter* BuildConvResidual(GraphBuilder* builder,
+                               TfLiteFusedActivation conv_activation,
+                               TfLiteFusedActivation add_activation,
+                               int stride = 1, bool expose_product = false) {
+  const int input = builder->AddInput(kConvInputShape);
+  const int residual = builder->AddInput(kConvOutputShape);
+  const int output_depth = kConvOutputShape[3];
+  const int input_depth = kConvInputShape[3];
+  const int filter = builder->AddFilter(
+      {output_depth, 1, 1, input_depth},
+      RandomValues(output_depth * input_depth, 0.5f, 1));
+  const int bias = builder->AddBias(RandomValues(output_depth, 1.0f, 2));
+  const int product = builder->Conv(input, filter, bias, kConvOutputShape,
+                                    conv_activation, stride);
+  const int output =
+      builder->Add(residual, product, kConvOutputShape, add_activation);
+  if (expose_product) return builder->Build({output, product});
+  return builder->Build({output});
+}
+
+// x, residual -> (fully_connected(x) + residual)
+Interpreter* BuildFullyConnectedResidual(GraphBuilder* builder,
+                                         TfLiteFusedActivation activation) {
+  const std::vector<int> output_shape = {kFullyConnectedRows,
+                                         kFullyConnectedUnits};
+  const int input =
+      builder->AddInput({2, kFullyConnectedRows / 2, kFullyConnectedDepth});
+  const int residual = builder->AddInput(output_shape);
+  const int filter = builder->AddFilter(
+      {kFullyConnectedUnits, kFullyConnectedDepth},
+      RandomValues(kFullyConnectedUnits * kFullyConnectedDepth, 0.5f, 3));
+  const int bias =
+      builder->AddBias(RandomValues(kFullyConnectedUnits, 1.0f, 4));
+  const int product = builder->FullyConnected(input, filter, bias, output_shape,
+                                              kTfLiteActNone);
+  return builder->Build(
+      {builder->Add(product, residual, output_shape, activation)});
+}
+
+template <typename T>
+std::vector<T> Run(Interpreter* interpreter, const std::vector<T>& input,
+                   const std::vector<T>& residual) {
+  EXPECT_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+  const int input_index = interpreter->inputs()[0];
+  const int residual_index = interpreter->inputs()[1];
+  std::memcpy(interpreter->typed_tensor<T>(input_index), input.data(),
+              input.size() * sizeof(T));
+  std::memcpy(interpreter->typed_tensor<T>(residual_index), residual.data(),
+              residual.size() * sizeof(T));
+  EXPECT_EQ(interpreter->Invoke(), kTfLiteOk);
+  const T* output = interpreter->typed_output_tensor<T>(0);
+  return std::vector<T>(output, output + residual.size());
+}
+
+class ResidualFusionDelegateTest : public ::testing::Test {
+ protected:
+  // Checks that the graph built by `build`, of inputs of `input_size` and
+  // `residual_size` values, is delegated to one fused kernel computing the
+  // same results as the builtin operators.
+  template <typename BuildFn>
+  void ExpectFusedMatchesUnfused(const BuildFn& build, int input_size,
+                                 int residual_size) {
+    const std::vector<float> input = RandomValues(input_size, 2.0f, 5);
+    const std::vector<float> residual = RandomValues(residual_size, 2.0f, 6);
+    GraphBuilder reference_builder(kTfLiteFloat32);
+    const std::vector<float> expected =
+        Run(build(&reference_builder), input, residual);
+
+    GraphBuilder builder(kTfLiteFloat32);
+    Interpreter* interpreter = build(&builder);
+    ASSERT_EQ(interpreter->ModifyGraphWithDelegate(delegate_.get()),
+              kTfLiteOk);
+    EXPECT_EQ(interpreter->execution_plan().size(), 1);
+    const std::vector<float> output = Run(interpreter, input, residual);
+    for (int i = 0; i < expected.size(); ++i) {
+      EXPECT_NEAR(output[i], expected[i], 1e-4f) << i;
+    }
+  }
+
+  std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)> delegate_ =
+      TfLiteResidualFusionDelegateCreateUnique();
+};
+
+TEST_F(ResidualFusionDelegateTest, Conv1x1) {
+  ExpectFusedMatchesUnfused(
+      [](GraphBuilder* builder) {
+        return BuildConvResidual(builder, kTfLiteActNone, kTfLiteActRelu);
+      },
+      FlatSize(kConvInputShape), FlatSize(kConvOutputShape));
+}
+
+TEST_F(ResidualFusionDelegateTest, Conv1x1WithActivations) {
+  ExpectFusedMatchesUnfused(
+      [](GraphBuilder* builder) {
+        return BuildConvResidual(builder, kTfLiteActRelu6,
+                                 kTfLiteActReluN1To1);
+      },
+      FlatSize(kConvInputShape), FlatSize(kConvOutputShape));
+}
+
+TEST_F(ResidualFusionDelegateTest, FullyConnected) {
+  ExpectFusedMatchesUnfused(
+      [](GraphBuilder* builder) {
+        return BuildFullyConnectedResidual(builder, kTfLiteActNone);
+      },
+      kFullyConnectedRows * kFullyConnectedDepth,
+      kFullyConnectedRows * kFullyConnectedUnits);
+}
+
+TEST_F(ResidualFusionDelegateTest, ProductOutputIsNotFused) {
+  GraphBuilder builder(kTfLiteFloat32);
+  Interpreter* interpreter =
+      BuildConvResidual(&builder, kTfLiteActNone, kTfLiteActNone,
+                        /*stride=*/1, /*expose_product=*/true);
+  ASSERT_EQ(interpreter->ModifyGraphWithDelegate(delegate_.get()), kTfLiteOk);
+  EXPECT_EQ(interpreter->execution_plan().size(), 2);
+}
+
+TEST_F(ResidualFusionDelegateTest, StridedConvIsNotFused) {
+  GraphBuilder builder(kTfLiteFloat32);
+  Interpreter* interpreter = BuildConvResidual(&builder, kTfLiteActNone,
+                                               kTfLiteActNone, /*stride=*/2);
+  ASSERT_EQ(interpreter->ModifyGraphWithDelegate(delegate_.get()), kTfLiteOk);
+  EXPECT_EQ(interpreter->execution_plan().size(), 2);
+}
+
+TEST_F(ResidualFusionDelegateTest, Int8Conv1x1) {
+  const auto quantize = [](const std::vector<float>& values) {
+    std::vector<int8_t> quantized(values.size());
+    for (int i = 0; i < values.size(); ++i) {
+      quantized[i] = static_cast<int8_t>(std::round(values[i] / kScale));
+    }
+    return quantized;
+  };
+  const std::vector<int8_t> input =
+      quantize(RandomValues(FlatSize(kConvInputShape), 2.0f, 7));
+  const std::vector<int8_t> residual =
+      quantize(RandomValues(FlatSize(kConvOutputShape), 2.0f, 8));
+  GraphBuilder reference_builder(kTfLiteInt8);
+  const std::vector<int8_t> expected =
+      Run(BuildConvResidual(&reference_builder, kTfLiteActRelu, kTfLiteActNone),
+          input, residual);
+
+  GraphBuilder builder(kTfLiteInt8);
+  Interpreter* interpreter =
+      BuildConvResidual(&builder, kTfLiteActRelu, kTfLiteActNone);
+  ASSERT_EQ(interpreter->ModifyGraphWithDelegate(delegate_.get()), kTfLiteOk);
+  EXPECT_EQ(interpreter->execution_plan().size(), 1);
+  const std::vector<int8_t> output = Run(interpreter, input, residual);
+  // The fused kernel does not round the products to int8 before adding them.
+  for (int i = 0; i < expected.size(); ++i) {
+    EXPECT_LE(std::abs(output[i] - expected[i]), 1) << i;
+  }
+}
+
+}  // namespace
+}  // namespace tflite
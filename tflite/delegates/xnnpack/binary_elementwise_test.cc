@@ -235,6 +235,35 @@ TEST_P(BinaryTest, FP16Weights) {
       .Test(op, xnnpack_delegate.get());
 }
 
+TEST_P(BinaryTest, FP16Activations) {
+  BuiltinOperator op = GetParam();
+
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+  const auto batch = shape_rng();
+  const auto height = shape_rng();
+  const auto width = shape_rng();
+  const auto channels = shape_rng();
+
+  BinaryElementwiseTester()
+      .Input1Shape({batch, height, width, channels})
+      .Input2Shape({batch, height, width, channels})
+      .FP16Activations()
+      .Test(op, xnnpack_delegate.get());
+
+  BinaryElementwiseTester()
+      .Input1Shape({batch, height, width, channels})
+      .Input2Shape({channels})
+      .FP16Activations()
+      .Test(op, xnnpack_delegate.get());
+}
+
 TEST_P(BinaryTest, INT8Weights) {
   BuiltinOperator op = GetParam();
 
@@ -381,6 +410,69 @@ TEST_P(BinaryTest, MultiThreading) {
       .Test(op, xnnpack_delegate.get());
 }
 
+TEST_P(BinaryTest, DeferRuntimeCreation) {
+  BuiltinOperator op = GetParam();
+
+  TfLiteXNNPackDelegateOptions delegate_options =
+      TfLiteXNNPackDelegateOptionsDefault();
+  delegate_options.flags |= TFLITE_XNNPACK_DELEGATE_FLAG_DEFER_RUNTIME_CREATION;
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(&delegate_options),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+  const auto batch = shape_rng();
+  const auto height = shape_rng();
+  const auto width = shape_rng();
+  const auto channels = shape_rng();
+
+  BinaryElementwiseTester()
+      .Input1Shape({batch, height, width, channels})
+      .Input2Shape({batch, height, width, channels})
+      .Input2Static(true)
+      .Test(op, xnnpack_delegate.get());
+}
+
+TEST_P(BinaryTest, SharedWorkspace) {
+  BuiltinOperator op = GetParam();
+
+  std::unique_ptr<TfLiteXNNPackDelegateWorkspace,
+                  decltype(&TfLiteXNNPackDelegateWorkspaceDelete)>
+      workspace(TfLiteXNNPackDelegateWorkspaceCreate(),
+                TfLiteXNNPackDelegateWorkspaceDelete);
+  ASSERT_NE(workspace, nullptr);
+  TfLiteXNNPackDelegateOptions delegate_options =
+      TfLiteXNNPackDelegateOptionsDefault();
+  delegate_options.workspace = workspace.get();
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate1(TfLiteXNNPackDelegateCreate(&delegate_options),
+                        TfLiteXNNPackDelegateDelete);
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate2(TfLiteXNNPackDelegateCreate(&delegate_options),
+                        TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+  const auto batch = shape_rng();
+  const auto height = shape_rng();
+  const auto width = shape_rng();
+  const auto channels = shape_rng();
+
+  BinaryElementwiseTester()
+      .Input1Shape({batch, height, width, channels})
+      .Input2Shape({batch, height, width, channels})
+      .Test(op, xnnpack_delegate1.get());
+  BinaryElementwiseTester()
+      .Input1Shape({batch, height, width, channels})
+      .Input2Shape({batch, height, width, channels})
+      .Test(op, xnnpack_delegate2.get());
+}
+
 INSTANTIATE_TEST_SUITE_P(
     BinaryTest, BinaryTest, testing::ValuesIn(all_binary_ops),
     [](const testing::TestParamInfo<BinaryTest::ParamType>& info) {
@@ -33,6 +33,7 @@ limitations under the License.
 #include "flatbuffers/flatbuffer_builder.h"  // from @flatbuffers
 #include "flatbuffers/string.h"  // from @flatbuffers
 #include "tflite/converter/schema/schema_conversion_utils.h"
+#include "tflite/core/c/common.h"
 #include "tflite/core/interpreter_builder.h"
 #include "tflite/core/kernels/register.h"
 #include "tflite/delegates/xnnpack/test_util.h"
@@ -81,6 +82,9 @@ void BinaryElementwiseTester::Test(tflite::BuiltinOperator binary_op,
       ASSERT_FALSE(Input2Shape().empty());
     }
   }
+  if (FP16Activations()) {
+    ASSERT_FALSE(Input1Static() || Input2Static());
+  }
 
   std::random_device random_device;
   auto rng = std::mt19937(random_device());
@@ -102,8 +106,16 @@ void BinaryElementwiseTester::Test(tflite::BuiltinOperator binary_op,
   auto input1_rng = std::bind(input1_distribution, std::ref(rng));
   auto input2_rng = std::bind(input2_distribution, std::ref(rng));
 
-  std::vector<char> buffer = CreateTfLiteModel(binary_op);
+  std::vector<char> buffer = CreateTfLiteModel(
+      binary_op,
+      FP16Activations() ? TensorType_FLOAT16 : TensorType_FLOAT32);
   const Model* model = GetModel(buffer.data());
+  // The reference kernels have no FP16 binary operators, so the reference
+  // outputs of FP16 activations are computed in FP32 from the same values.
+  std::vector<char> default_buffer =
+      FP16Activations() ? CreateTfLiteModel(binary_op, TensorType_FLOAT32)
+                        : buffer;
+  const Model* default_model = GetModel(default_buffer.data());
 
   std::unique_ptr<Interpreter> delegate_interpreter;
   ASSERT_EQ(
@@ -115,7 +127,7 @@ void BinaryElementwiseTester::Test(tflite::BuiltinOperator binary_op,
   std::unique_ptr<Interpreter> default_interpreter;
   ASSERT_EQ(
       InterpreterBuilder(
-          model,
+          default_model,
           ::tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates())(
           &default_interpreter),
       kTfLiteOk);
@@ -139,6 +151,52 @@ void BinaryElementwiseTester::Test(tflite::BuiltinOperator binary_op,
 
   ASSERT_EQ(delegate_interpreter->ModifyGraphWithDelegate(delegate), kTfLiteOk);
 
+  if (FP16Activations()) {
+    // The operator must be delegated as is, without converting the
+    // activations on the CPU.
+    ASSERT_EQ(delegate_interpreter->execution_plan().size(), 1);
+    const int node_index = delegate_interpreter->execution_plan()[0];
+    ASSERT_EQ(
+        delegate_interpreter->node_and_registration(node_index)->first.delegate,
+        delegate);
+
+    for (int i = 0; i < 2; i++) {
+      const int32_t input_size =
+          ComputeSize(i == 0 ? Input1Shape() : Input2Shape());
+      auto& input_rng = i == 0 ? input1_rng : input2_rng;
+      float* default_input_data =
+          default_interpreter->typed_input_tensor<float>(i);
+      std::generate_n(default_input_data, input_size, std::ref(input_rng));
+
+      TfLiteFloat16* xnnpack_input_data =
+          delegate_interpreter->typed_input_tensor<TfLiteFloat16>(i);
+      for (int32_t j = 0; j < input_size; j++) {
+        xnnpack_input_data[j].data =
+            fp16_ieee_from_fp32_value(default_input_data[j]);
+        default_input_data[j] =
+            fp16_ieee_to_fp32_value(xnnpack_input_data[j].data);
+      }
+    }
+
+    ASSERT_EQ(default_interpreter->Invoke(), kTfLiteOk);
+    ASSERT_EQ(delegate_interpreter->Invoke(), kTfLiteOk);
+
+    float* default_output_data =
+        default_interpreter->typed_output_tensor<float>(0);
+    TfLiteFloat16* xnnpack_output_data =
+        delegate_interpreter->typed_output_tensor<TfLiteFloat16>(0);
+
+    // Allow two FP16 ULPs for the rounding of the result.
+    const float fp16_epsilon = 9.765625e-4f;
+    for (size_t i = 0; i < ComputeSize(OutputShape()); i++) {
+      ASSERT_NEAR(default_output_data[i],
+                  fp16_ieee_to_fp32_value(xnnpack_output_data[i].data),
+                  2.0f * fp16_epsilon *
+                      std::max(std::abs(default_output_data[i]), 1.0f));
+    }
+    return;
+  }
+
   if (!Input1Static()) {
     float* default_input1_data =
         default_interpreter->typed_input_tensor<float>(0);
@@ -179,7 +237,7 @@ void BinaryElementwiseTester::Test(tflite::BuiltinOperator binary_op,
 }
 
 std::vector<char> BinaryElementwiseTester::CreateTfLiteModel(
-    tflite::BuiltinOperator binary_op) const {
+    tflite::BuiltinOperator binary_op, TensorType activation_type) const {
   std::random_device random_device;
   auto rng = std::mt19937(random_device());
   std::uniform_real_distribution<float> input1_distribution(-25.0f, 25.0f);
@@ -434,15 +492,15 @@ std::vector<char> BinaryElementwiseTester::CreateTfLiteModel(
   tensors.emplace_back(CreateTensor(
       builder,
       builder.CreateVector<int32_t>(Input1Shape().data(), Input1Shape().size()),
-      TensorType_FLOAT32, input1_buffer));
+      activation_type, input1_buffer));
   tensors.emplace_back(CreateTensor(
       builder,
       builder.CreateVector<int32_t>(Input2Shape().data(), Input2Shape().size()),
-      TensorType_FLOAT32, input2_buffer));
+      activation_type, input2_buffer));
   tensors.emplace_back(CreateTensor(
       builder,
       builder.CreateVector<int32_t>(output_shape.data(), output_shape.size()),
-      TensorType_FLOAT32));
+      activation_type));
 
   tflite::BuiltinOptions builtin_options_type = tflite::BuiltinOptions_NONE;
   flatbuffers::Offset<void> builtin_options = 0;
@@ -80,6 +80,13 @@ class BinaryElementwiseTester {
 
   inline bool FP16Weights() const { return fp16_weights_; }
 
+  inline BinaryElementwiseTester& FP16Activations() {
+    fp16_activations_ = true;
+    return *this;
+  }
+
+  inline bool FP16Activations() const { return fp16_activations_; }
+
   inline BinaryElementwiseTester& INT8Weights() {
     int8_weights_ = true;
     return *this;
@@ -112,7 +119,8 @@ class BinaryElementwiseTester {
   void Test(tflite::BuiltinOperator binary_op, TfLiteDelegate* delegate) const;
 
  private:
-  std::vector<char> CreateTfLiteModel(tflite::BuiltinOperator binary_op) const;
+  std::vector<char> CreateTfLiteModel(tflite::BuiltinOperator binary_op,
+                                      TensorType activation_type) const;
 
   inline ::tflite::ActivationFunctionType Activation() const {
     return activation_;
@@ -125,6 +133,7 @@ class BinaryElementwiseTester {
   bool input1_static_ = false;
   bool input2_static_ = false;
   bool fp16_weights_ = false;
+  bool fp16_activations_ = false;
   bool int8_weights_ = false;
   bool int8_channel_wise_weights_ = false;
   bool sparse_weights_ = false;
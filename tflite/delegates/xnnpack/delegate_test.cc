@@ -14,11 +14,15 @@ limitations under the License.
 ==============================================================================*/
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include "pthreadpool.h"  // from @pthreadpool
 #include "tflite/c/c_api_types.h"
+#include "tflite/core/model_building.h"
 #include "tflite/delegates/xnnpack/xnnpack_delegate.h"
+#include "tflite/interpreter.h"
 
 namespace tflite {
 namespace xnnpack {
@@ -60,5 +64,71 @@ TEST(Delegate, GetThreadPool) {
   ASSERT_EQ(2, pthreadpool_get_threads_count(threadpool));
 }
 
+TEST(Delegate, WorkspaceOutlivedByDelegates) {
+  TfLiteXNNPackDelegateWorkspace* workspace =
+      TfLiteXNNPackDelegateWorkspaceCreate();
+  ASSERT_TRUE(workspace);
+  TfLiteXNNPackDelegateOptions delegate_options =
+      TfLiteXNNPackDelegateOptionsDefault();
+  delegate_options.workspace = workspace;
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate1(TfLiteXNNPackDelegateCreate(&delegate_options),
+                        TfLiteXNNPackDelegateDelete);
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate2(TfLiteXNNPackDelegateCreate(&delegate_options),
+                        TfLiteXNNPackDelegateDelete);
+  ASSERT_TRUE(xnnpack_delegate1);
+  ASSERT_TRUE(xnnpack_delegate2);
+  TfLiteXNNPackDelegateWorkspaceDelete(workspace);
+}
+
+// Fills the input of `interpreter` and checks that its output doubles it.
+void InvokeAndCheckDoubledInput(Interpreter& interpreter) {
+  const TfLiteTensor* input = interpreter.input_tensor(0);
+  const int num_elements = input->bytes / sizeof(float);
+  for (int i = 0; i < num_elements; ++i) {
+    interpreter.typed_input_tensor<float>(0)[i] = i;
+  }
+  ASSERT_EQ(interpreter.Invoke(), kTfLiteOk);
+  const TfLiteTensor* output = interpreter.output_tensor(0);
+  ASSERT_TRUE(TfLiteIntArrayEqual(input->dims, output->dims));
+  for (int i = 0; i < num_elements; ++i) {
+    EXPECT_EQ(interpreter.typed_output_tensor<float>(0)[i], 2 * i);
+  }
+}
+
+TEST(Delegate, ReshapesRuntimeOnlyWhenInputShapesChange) {
+  model_builder::ModelBuilder builder;
+  auto graph = NewGraph(builder);
+  auto input = NewInput(graph, kTfLiteFloat32);
+  SetShape(input, {2, 3});
+  model_builder::MarkOutputs({Add(input, input)});
+  Interpreter interpreter;
+  builder.Build(interpreter);
+
+  TfLiteXNNPackDelegateOptions delegate_options =
+      TfLiteXNNPackDelegateOptionsDefault();
+  delegate_options.flags |=
+      TFLITE_XNNPACK_DELEGATE_FLAG_ENABLE_SUBGRAPH_RESHAPING;
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(&delegate_options),
+                       TfLiteXNNPackDelegateDelete);
+  ASSERT_EQ(interpreter.ModifyGraphWithDelegate(std::move(xnnpack_delegate)),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+  InvokeAndCheckDoubledInput(interpreter);
+
+  // Same shape: the runtime keeps its shapes but the tensors may have moved.
+  ASSERT_EQ(interpreter.ResizeInputTensor(interpreter.inputs()[0], {2, 3}),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+  InvokeAndCheckDoubledInput(interpreter);
+
+  ASSERT_EQ(interpreter.ResizeInputTensor(interpreter.inputs()[0], {4, 3}),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+  InvokeAndCheckDoubledInput(interpreter);
+}
+
 }  // namespace xnnpack
 }  // namespace tflite
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tflite/delegates/xnnpack/dequantize_tester.h"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -26,10 +27,12 @@ limitations under the License.
 #include <vector>
 
 #include <gtest/gtest.h>
+#include "fp16.h"  // from @FP16
 #include "flatbuffers/buffer.h"  // from @flatbuffers
 #include "flatbuffers/flatbuffer_builder.h"  // from @flatbuffers
 #include "flatbuffers/string.h"  // from @flatbuffers
 #include "tflite/converter/schema/schema_conversion_utils.h"
+#include "tflite/core/c/common.h"
 #include "tflite/core/interpreter_builder.h"
 #include "tflite/core/kernels/register.h"
 #include "tflite/interpreter.h"
@@ -69,6 +72,45 @@ void DequantizeTester::Test(Interpreter* delegate_interpreter,
   }
 }
 
+void DequantizeTester::TestFloat16(TfLiteDelegate* delegate,
+                                   Interpreter* delegate_interpreter,
+                                   Interpreter* default_interpreter) const {
+  // The conversion must be delegated rather than left to the CPU.
+  ASSERT_EQ(delegate_interpreter->execution_plan().size(), 1);
+  const int node_index = delegate_interpreter->execution_plan()[0];
+  ASSERT_EQ(
+      delegate_interpreter->node_and_registration(node_index)->first.delegate,
+      delegate);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  std::uniform_real_distribution<float> input_distribution(-100.0f, 100.0f);
+  auto input_rng = std::bind(input_distribution, std::ref(rng));
+
+  TfLiteFloat16* default_input_data =
+      default_interpreter->typed_input_tensor<TfLiteFloat16>(0);
+  for (int32_t i = 0; i < ComputeSize(Shape()); i++) {
+    default_input_data[i].data = fp16_ieee_from_fp32_value(input_rng());
+  }
+
+  TfLiteFloat16* delegate_input_data =
+      delegate_interpreter->typed_input_tensor<TfLiteFloat16>(0);
+  std::copy_n(default_input_data, ComputeSize(Shape()), delegate_input_data);
+
+  ASSERT_EQ(default_interpreter->Invoke(), kTfLiteOk);
+  ASSERT_EQ(delegate_interpreter->Invoke(), kTfLiteOk);
+
+  float* default_output_data =
+      default_interpreter->typed_output_tensor<float>(0);
+  float* delegate_output_data =
+      delegate_interpreter->typed_output_tensor<float>(0);
+
+  for (size_t i = 0; i < ComputeSize(Shape()); i++) {
+    ASSERT_EQ(default_output_data[i], delegate_output_data[i])
+        << " at index " << i << " / " << ComputeSize(Shape());
+  }
+}
+
 void DequantizeTester::Test(TfLiteDelegate* delegate) const {
   std::vector<char> buffer = CreateTfLiteModel();
   const Model* model = GetModel(buffer.data());
@@ -102,7 +144,10 @@ void DequantizeTester::Test(TfLiteDelegate* delegate) const {
 
   ASSERT_EQ(delegate_interpreter->ModifyGraphWithDelegate(delegate), kTfLiteOk);
 
-  if (Unsigned()) {
+  if (Float16()) {
+    TestFloat16(delegate, delegate_interpreter.get(),
+                default_interpreter.get());
+  } else if (Unsigned()) {
     Test<uint8_t>(delegate_interpreter.get(), default_interpreter.get());
   } else {
     Test<int8_t>(delegate_interpreter.get(), default_interpreter.get());
@@ -119,15 +164,20 @@ std::vector<char> DequantizeTester::CreateTfLiteModel() const {
   }};
 
   const std::array<flatbuffers::Offset<Tensor>, 2> tensors{{
-      CreateTensor(
-          builder,
-          builder.CreateVector<int32_t>(Shape().data(), Shape().size()),
-          Unsigned() ? TensorType_UINT8 : TensorType_INT8,
-          /*buffer=*/0, /*name=*/0,
-          CreateQuantizationParameters(
-              builder, /*min=*/0, /*max=*/0,
-              builder.CreateVector<float>({InputScale()}),
-              builder.CreateVector<int64_t>({InputZeroPoint()}))),
+      Float16()
+          ? CreateTensor(
+                builder,
+                builder.CreateVector<int32_t>(Shape().data(), Shape().size()),
+                TensorType_FLOAT16)
+          : CreateTensor(
+                builder,
+                builder.CreateVector<int32_t>(Shape().data(), Shape().size()),
+                Unsigned() ? TensorType_UINT8 : TensorType_INT8,
+                /*buffer=*/0, /*name=*/0,
+                CreateQuantizationParameters(
+                    builder, /*min=*/0, /*max=*/0,
+                    builder.CreateVector<float>({InputScale()}),
+                    builder.CreateVector<int64_t>({InputZeroPoint()}))),
       CreateTensor(
           builder,
           builder.CreateVector<int32_t>(Shape().data(), Shape().size()),
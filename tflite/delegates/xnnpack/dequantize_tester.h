@@ -68,6 +68,14 @@ class DequantizeTester {
 
   inline bool Unsigned() const { return unsigned_; }
 
+  // Dequantizes FP16 instead of quantized 8-bit inputs.
+  inline DequantizeTester& Float16(bool is_float16) {
+    float16_ = is_float16;
+    return *this;
+  }
+
+  inline bool Float16() const { return float16_; }
+
   template <class T>
   void Test(Interpreter* delegate_interpreter,
             Interpreter* default_interpreter) const;
@@ -75,6 +83,9 @@ class DequantizeTester {
   void Test(TfLiteDelegate* delegate) const;
 
  private:
+  void TestFloat16(TfLiteDelegate* delegate, Interpreter* delegate_interpreter,
+                   Interpreter* default_interpreter) const;
+
   std::vector<char> CreateTfLiteModel() const;
 
   static int32_t ComputeSize(const std::vector<int32_t>& shape);
@@ -84,6 +95,7 @@ class DequantizeTester {
   int32_t input_zero_point_ = 0;
   float input_scale_ = 1.0f;
   bool unsigned_ = false;
+  bool float16_ = false;
 };
 
 }  // namespace xnnpack
@@ -73,6 +73,22 @@ TEST_P(SDPATest, CompareWithTFLiteReference) {
   tester.Test(xnnpack_delegate.get());
 }
 
+TEST(SDPA, QuantizedKVCache) {
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+  // MQA, GQA and MHA.
+  for (int kv_heads : {1, 4, 32}) {
+    ODMLSDPATester(kOdmlSdpaCustom)
+        .QueryShape({1, 1, 32, 4})
+        .KeyShape({1, 64, kv_heads, 4})
+        .ValueShape({1, 64, kv_heads, 4})
+        .MaskShape({1, 1, 1, 64})
+        .QuantizedKV(true)
+        .Test(xnnpack_delegate.get());
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(SDPA, SDPATest,
                          testing::Values(SDPATestParams{kOdmlSdpaCompositeMqa},
                                          SDPATestParams{kOdmlSdpaCompositeMha},
@@ -48,6 +48,15 @@ limitations under the License.
 namespace tflite {
 namespace xnnpack {
 
+namespace {
+
+// The quantization of INT8 key and value tensors. The scale is a power of
+// two so that the dequantized values the reference runs on are exact.
+constexpr float kKVScale = 1.0f / 64.0f;
+constexpr int32_t kKVZeroPoint = 3;
+
+}  // namespace
+
 std::vector<int32_t> ODMLSDPATester::OutputShape() const {
   std::vector<int32_t> output_shape = QueryShape();
   return output_shape;
@@ -59,9 +68,17 @@ void ODMLSDPATester::Test(TfLiteDelegate* delegate) const {
   auto rng = std::mt19937(random_device());
   auto input_rng =
       std::bind(std::uniform_real_distribution<float>(), std::ref(rng));
+  auto quantized_input_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(
+                    std::numeric_limits<int8_t>::min(),
+                    std::numeric_limits<int8_t>::max()),
+                std::ref(rng));
 
-  std::vector<char> buffer = CreateTfLiteModel();
+  std::vector<char> buffer = CreateTfLiteModel(QuantizedKV());
   const Model* model = GetModel(buffer.data());
+  // The reference kernel runs on the dequantized key and value.
+  std::vector<char> default_buffer = CreateTfLiteModel(/*quantized_kv=*/false);
+  const Model* default_model = GetModel(default_buffer.data());
 
   std::unique_ptr<Interpreter> delegate_interpreter;
   auto resolver =
@@ -71,7 +88,7 @@ void ODMLSDPATester::Test(TfLiteDelegate* delegate) const {
   ASSERT_EQ(InterpreterBuilder(model, resolver)(&delegate_interpreter),
             kTfLiteOk);
   std::unique_ptr<Interpreter> default_interpreter;
-  ASSERT_EQ(InterpreterBuilder(model, resolver)(&default_interpreter),
+  ASSERT_EQ(InterpreterBuilder(default_model, resolver)(&default_interpreter),
             kTfLiteOk);
 
   ASSERT_TRUE(delegate_interpreter);
@@ -91,6 +108,19 @@ void ODMLSDPATester::Test(TfLiteDelegate* delegate) const {
   for (size_t i = 0; i < delegate_interpreter->inputs().size(); ++i) {
     const TfLiteTensor* delegate_input_tensor = delegate_interpreter->tensor(i);
     const size_t num_elts = NumElements(delegate_input_tensor);
+    if (delegate_input_tensor->type == kTfLiteInt8) {
+      int8_t* const delegate_input_data =
+          delegate_interpreter->typed_input_tensor<int8_t>(i);
+      float* const default_input_data =
+          default_interpreter->typed_input_tensor<float>(i);
+      std::generate_n(delegate_input_data, num_elts,
+                      std::ref(quantized_input_rng));
+      for (size_t j = 0; j < num_elts; ++j) {
+        default_input_data[j] =
+            (delegate_input_data[j] - kKVZeroPoint) * kKVScale;
+      }
+      continue;
+    }
     float* const delegate_input_data =
         delegate_interpreter->typed_input_tensor<float>(i);
     float* const default_input_data =
@@ -116,7 +146,7 @@ void ODMLSDPATester::Test(TfLiteDelegate* delegate) const {
   }
 }
 
-std::vector<char> ODMLSDPATester::CreateTfLiteModel() const {
+std::vector<char> ODMLSDPATester::CreateTfLiteModel(bool quantized_kv) const {
   if (!model_name_.empty() && model_name_ != kOdmlSdpaCustom) {
     const char kTestModelFolder[] =
         "tflite/delegates/xnnpack/";
@@ -138,6 +168,15 @@ std::vector<char> ODMLSDPATester::CreateTfLiteModel() const {
         CreateBuffer(builder, builder.CreateVector({})),
     }};
 
+    const TensorType kv_type =
+        quantized_kv ? TensorType_INT8 : TensorType_FLOAT32;
+    const flatbuffers::Offset<QuantizationParameters> kv_quantization =
+        quantized_kv
+            ? CreateQuantizationParameters(
+                  builder, /*min=*/0, /*max=*/0,
+                  builder.CreateVector<float>({kKVScale}),
+                  builder.CreateVector<int64_t>({kKVZeroPoint}))
+            : 0;
     const std::array<flatbuffers::Offset<Tensor>, 5> tensors{{
         CreateTensor(builder,
                      builder.CreateVector<int32_t>(QueryShape().data(),
@@ -146,11 +185,11 @@ std::vector<char> ODMLSDPATester::CreateTfLiteModel() const {
         CreateTensor(
             builder,
             builder.CreateVector<int32_t>(KeyShape().data(), KeyShape().size()),
-            TensorType_FLOAT32),
+            kv_type, /*buffer=*/0, /*name=*/0, kv_quantization),
         CreateTensor(builder,
                      builder.CreateVector<int32_t>(ValueShape().data(),
                                                    ValueShape().size()),
-                     TensorType_FLOAT32),
+                     kv_type, /*buffer=*/0, /*name=*/0, kv_quantization),
         CreateTensor(builder,
                      builder.CreateVector<int32_t>(MaskShape().data(),
                                                    MaskShape().size()),
@@ -76,6 +76,14 @@ class ODMLSDPATester {
     return *this;
   }
 
+  // Keeps the key and value tensors in INT8 with per-tensor quantization.
+  inline ODMLSDPATester& QuantizedKV(bool quantized_kv) {
+    quantized_kv_ = quantized_kv;
+    return *this;
+  }
+
+  inline bool QuantizedKV() const { return quantized_kv_; }
+
   int32_t Batch() const { return query_shape_[0]; };
   int32_t InputSeqLen() const { return query_shape_[1]; };
   int32_t QHeads() const { return query_shape_[2]; };
@@ -100,7 +108,7 @@ class ODMLSDPATester {
   void Test(TfLiteDelegate* delegate) const;
 
  private:
-  std::vector<char> CreateTfLiteModel() const;
+  std::vector<char> CreateTfLiteModel(bool quantized_kv) const;
 
   std::vector<int32_t> query_shape_;
   std::vector<int32_t> key_shape_;
@@ -110,6 +118,7 @@ class ODMLSDPATester {
   int32_t key_size_ = 1;
   int32_t value_size_ = 1;
   int32_t mask_size_ = 1;
+  bool quantized_kv_ = false;
   std::string model_name_;
 };
 
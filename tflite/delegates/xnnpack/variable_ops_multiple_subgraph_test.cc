@@ -33,6 +33,18 @@ TEST(ReadAssignVariable, TwoSubgraphsReadAssign) {
       .TestTwoSubgraphsReadAssign(delegate);
 }
 
+TEST(ReadAssignVariable, TwoSubgraphsReadAssignMultipleInvocations) {
+  auto xnnpack_delegate = NewXnnPackDelegateSupportingVariableOps();
+  TfLiteDelegate* delegate = xnnpack_delegate.get();
+
+  VariableOpsTester()
+      .NumInputs(0)
+      .NumOutputs(2)
+      .NumSubgraphs(2)
+      .NumInvocations(3)
+      .TestTwoSubgraphsReadAssign(delegate);
+}
+
 TEST(ReadAssignVariable, TwoSubgraphsReadAssignOneVarHandle) {
   auto xnnpack_delegate = NewXnnPackDelegateSupportingVariableOps();
   TfLiteDelegate* delegate = xnnpack_delegate.get();
@@ -864,25 +864,27 @@ void VariableOpsTester::Test(TfLiteDelegate* delegate,
 
   ASSERT_EQ(delegate_interpreter->ModifyGraphWithDelegate(delegate), kTfLiteOk);
 
-  for (size_t i = 0; i < NumInputs(); i++) {
-    float* default_input_data =
-        default_interpreter->typed_input_tensor<float>(i);
-    std::generate_n(default_input_data, InputSize(), std::ref(f32rng));
-    float* delegate_input_data =
-        delegate_interpreter->typed_input_tensor<float>(i);
-    std::copy_n(default_input_data, InputSize(), delegate_input_data);
-  }
-
-  ASSERT_EQ(default_interpreter->Invoke(), kTfLiteOk);
-  ASSERT_EQ(delegate_interpreter->Invoke(), kTfLiteOk);
+  for (size_t n = 0; n < NumInvocations(); n++) {
+    for (size_t i = 0; i < NumInputs(); i++) {
+      float* default_input_data =
+          default_interpreter->typed_input_tensor<float>(i);
+      std::generate_n(default_input_data, InputSize(), std::ref(f32rng));
+      float* delegate_input_data =
+          delegate_interpreter->typed_input_tensor<float>(i);
+      std::copy_n(default_input_data, InputSize(), delegate_input_data);
+    }
 
-  for (size_t i = 0; i < NumOutputs(); i++) {
-    const float* default_output_data =
-        default_interpreter->typed_output_tensor<float>(i);
-    const float* delegate_output_data =
-        delegate_interpreter->typed_output_tensor<float>(i);
-    for (size_t i = 0; i < OutputSize(); i++) {
-      EXPECT_EQ(delegate_output_data[i], default_output_data[i]);
+    ASSERT_EQ(default_interpreter->Invoke(), kTfLiteOk);
+    ASSERT_EQ(delegate_interpreter->Invoke(), kTfLiteOk);
+
+    for (size_t i = 0; i < NumOutputs(); i++) {
+      const float* default_output_data =
+          default_interpreter->typed_output_tensor<float>(i);
+      const float* delegate_output_data =
+          delegate_interpreter->typed_output_tensor<float>(i);
+      for (size_t i = 0; i < OutputSize(); i++) {
+        EXPECT_EQ(delegate_output_data[i], default_output_data[i]);
+      }
     }
   }
 }
@@ -180,6 +180,15 @@ class VariableOpsTester {
     return *this;
   }
 
+  // Invokes the models this many times, so that the variables carry their
+  // values over from one invocation to the next.
+  inline VariableOpsTester &NumInvocations(size_t num_invocations) {
+    num_invocations_ = num_invocations;
+    return *this;
+  }
+
+  inline size_t NumInvocations() const { return num_invocations_; }
+
   const std::vector<int32_t> &Shape() const { return shape_; }
 
   const std::vector<int32_t> &ResourceShape() const { return resource_shape_; }
@@ -202,6 +211,7 @@ class VariableOpsTester {
   size_t num_inputs_ = 0;
   size_t num_outputs_ = 0;
   size_t num_subgraphs_ = 1;
+  size_t num_invocations_ = 1;
 };
 
 }  // namespace xnnpack
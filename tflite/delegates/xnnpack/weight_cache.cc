@@ -19,6 +19,7 @@ limitations under the License.
 #include <io.h>
 #define F_OK 0
 #else
+#include <sys/file.h>
 #include <unistd.h>
 #endif
 
@@ -31,6 +32,7 @@ limitations under the License.
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "xnnpack.h"  // from @XNNPACK
@@ -102,6 +104,7 @@ WeightCacheBuilder::WeightCacheBuilder(WeightCacheBuilder&& other)
       XNN_MOVE_CONSTRUCT_MEMBER(build_segment_size_),
       XNN_MOVE_CONSTRUCT_MEMBER(build_segment_start_),
       XNN_MOVE_CONSTRUCT_MEMBER(first_write_done_),
+      XNN_MOVE_CONSTRUCT_MEMBER(append_),
       XNN_MOVE_CONSTRUCT_MEMBER(fd_),
       XNN_MOVE_CONSTRUCT_MEMBER(file_path_) {}
 #undef XNN_MOVE_CONSTRUCT_MEMBER
@@ -114,6 +117,7 @@ WeightCacheBuilder& WeightCacheBuilder::operator=(WeightCacheBuilder&& other) {
   XNN_MOVE_MEMBER(build_segment_size_);
   XNN_MOVE_MEMBER(build_segment_start_);
   XNN_MOVE_MEMBER(first_write_done_);
+  XNN_MOVE_MEMBER(append_);
   XNN_MOVE_MEMBER(fd_);
   XNN_MOVE_MEMBER(file_path_);
 #undef XNN_MOVE_MEMBER
@@ -143,6 +147,21 @@ bool WeightCacheBuilder::Start(const char* path, const FileDescriptor& fd) {
   return true;
 }
 
+bool WeightCacheBuilder::StartAppend(const char* path,
+                                     const FileDescriptor& fd) {
+  XNNPACK_RETURN_CHECK(!IsStarted());
+  file_path_ = Sanitize(path);
+
+  XNNPACK_RETURN_CHECK(fd.IsValid(), "File descriptor isn't valid ('%s'): %s.",
+                       file_path_.c_str(), strerror(errno));
+  fd_ = fd;
+  // The file holds a valid cache, the header doesn't need to be rewritten if
+  // nothing is appended.
+  first_write_done_ = true;
+  append_ = true;
+  return true;
+}
+
 bool WeightCacheBuilder::StartBuildStep() {
   XNNPACK_RETURN_CHECK(IsStarted(),
                        "Trying to start a build step in an invalid builder.")
@@ -168,9 +187,11 @@ bool WeightCacheBuilder::StartBuildStep() {
     cache::schema::GetBufferList(buffer_list_data.data())->UnPackTo(&schema_);
   }
 
-  // Move cursor to end of existing data.
+  // Move cursor to end of existing data. When appending, the buffer list is
+  // kept until the header points to the new one.
   build_segment_size_ = 0;
-  build_segment_start_ = fd_.SetPos(header.buffer_list_offset);
+  build_segment_start_ = append_ ? fd_.SetPosFromEnd(0)
+                                 : fd_.SetPos(header.buffer_list_offset);
   XNNPACK_RETURN_CHECK(build_segment_start_ != -1);
 
   return true;
@@ -227,6 +248,7 @@ bool WeightCacheBuilder::StopBuildStep() {
 
   if (fd_.GetPos() == build_segment_start_ && first_write_done_) {
     // Nothing was written to the file, we can exit early.
+    is_build_step_ = false;
     return true;
   }
 
@@ -276,6 +298,86 @@ bool WeightCacheBuilder::StopBuildStep() {
   return true;
 }
 
+WeightCacheBuildLock::WeightCacheBuildLock(WeightCacheBuildLock&& other)
+    : path_(std::move(other.path_)),
+      build_path_(std::move(other.build_path_)),
+      lock_fd_(std::move(other.lock_fd_)),
+      locked_(std::exchange(other.locked_, false)) {}
+
+WeightCacheBuildLock& WeightCacheBuildLock::operator=(
+    WeightCacheBuildLock&& other) {
+  Unlock();
+  path_ = std::move(other.path_);
+  build_path_ = std::move(other.build_path_);
+  lock_fd_ = std::move(other.lock_fd_);
+  locked_ = std::exchange(other.locked_, false);
+  return *this;
+}
+
+bool WeightCacheBuildLock::TryLock(const std::string& path) {
+  return Acquire(path, /*wait=*/false);
+}
+
+bool WeightCacheBuildLock::Lock(const std::string& path) {
+  if (!Acquire(path, /*wait=*/true)) {
+    return false;
+  }
+  build_path_ = path;
+  return true;
+}
+
+bool WeightCacheBuildLock::Acquire(const std::string& path, bool wait) {
+  XNNPACK_RETURN_CHECK(!IsLocked(), "cache file '%s' is already locked.",
+                       path.c_str());
+#if defined(_MSC_VER)
+  // Windows builds the cache in place.
+  build_path_ = path;
+#else
+  const std::string lock_path = path + ".lock";
+  FileDescriptor lock_fd =
+      FileDescriptor::Open(lock_path.c_str(), O_CREAT | O_RDWR, 0644);
+  XNNPACK_RETURN_CHECK(lock_fd.IsValid(),
+                       "could not open lock file ('%s'): %s.",
+                       lock_path.c_str(), strerror(errno));
+  int status;
+  do {
+    status = flock(lock_fd.Value(), wait ? LOCK_EX : LOCK_EX | LOCK_NB);
+  } while (status != 0 && errno == EINTR);
+  if (status != 0) {
+    XNNPACK_RETURN_CHECK(!wait && errno == EWOULDBLOCK,
+                         "could not lock '%s': %s.", lock_path.c_str(),
+                         strerror(errno));
+    return false;
+  }
+  // The lock file is never removed: a process could otherwise lock a file
+  // that was just unlinked while another one creates and locks a new one.
+  lock_fd_ = std::move(lock_fd);
+  build_path_ = path + ".tmp";
+#endif
+  path_ = path;
+  locked_ = true;
+  return true;
+}
+
+bool WeightCacheBuildLock::Install() {
+  XNNPACK_RETURN_CHECK(IsLocked(), "cannot install an unlocked cache file.");
+  const bool installed =
+      build_path_ == path_ || rename(build_path_.c_str(), path_.c_str()) == 0;
+  if (!installed) {
+    TFLITE_LOG_PROD(tflite::TFLITE_LOG_ERROR,
+                    "XNNPack weight cache: could not move '%s' to '%s': %s.",
+                    build_path_.c_str(), path_.c_str(), strerror(errno));
+  }
+  Unlock();
+  return installed;
+}
+
+void WeightCacheBuildLock::Unlock() {
+  // Closing the file releases the lock.
+  lock_fd_.Close();
+  locked_ = false;
+}
+
 #define XNN_MOVE_CONSTRUCT_MEMBER(member) member(std::move(other.member))
 MMapWeightCacheProvider::MMapWeightCacheProvider(
     MMapWeightCacheProvider&& other)
@@ -288,7 +390,9 @@ MMapWeightCacheProvider::MMapWeightCacheProvider(
       XNN_MOVE_CONSTRUCT_MEMBER(mmap_buffer_base_offset_),
       XNN_MOVE_CONSTRUCT_MEMBER(file_descriptor_),
       XNN_MOVE_CONSTRUCT_MEMBER(builder_),
+      XNN_MOVE_CONSTRUCT_MEMBER(build_lock_),
       XNN_MOVE_CONSTRUCT_MEMBER(building_run_),
+      XNN_MOVE_CONSTRUCT_MEMBER(appending_),
       XNN_MOVE_CONSTRUCT_MEMBER(offset_to_addr_) {
   // The contexts need to keep pointing to their owning object.
   cache_provider_.context = this;
@@ -311,12 +415,16 @@ MMapWeightCacheProvider& MMapWeightCacheProvider::operator=(
   XNN_MOVE_MEMBER(mmap_buffer_base_offset_);
   XNN_MOVE_MEMBER(file_descriptor_);
   XNN_MOVE_MEMBER(builder_);
+  XNN_MOVE_MEMBER(build_lock_);
   XNN_MOVE_MEMBER(building_run_);
+  XNN_MOVE_MEMBER(appending_);
   XNN_MOVE_MEMBER(offset_to_addr_);
 #undef XNN_MOVE_MEMBER
   return *this;
 }
 
+MMapWeightCacheProvider::~MMapWeightCacheProvider() { InstallBuiltCache(); }
+
 void MMapWeightCacheProvider::SetFilePath(const char* path) {
   XNNPACK_ABORT_CHECK(
       !IsBuilding(),
@@ -339,11 +447,35 @@ bool MMapWeightCacheProvider::LoadOrStartBuild(const char* path,
   }
   const char* const safe_path = Sanitize(path);
   FileDescriptor build_fd = fd.Duplicate();
-  if (!IsInMemoryCachePath(safe_path) && Load(safe_path, std::move(fd))) {
+  const bool in_memory = IsInMemoryCachePath(safe_path);
+  if (!in_memory && !build_fd.IsValid() && LoadForAppend(safe_path)) {
+    TFLITE_LOG_PROD(tflite::TFLITE_LOG_VERBOSE,
+                    "XNNPack weight cache loaded from '%s'.", safe_path);
+    return true;
+  }
+  if (!in_memory && build_fd.IsValid() && Load(safe_path, std::move(fd))) {
     TFLITE_LOG_PROD(tflite::TFLITE_LOG_VERBOSE,
                     "XNNPack weight cache loaded from '%s'.", safe_path);
     return true;
-  } else if (StartBuild(safe_path, std::move(build_fd))) {
+  }
+  if (!in_memory && !build_fd.IsValid()) {
+    if (!build_lock_.TryLock(safe_path)) {
+      TFLITE_LOG_PROD(tflite::TFLITE_LOG_INFO,
+                      "XNNPack weight cache: '%s' is being built by another "
+                      "process, packing weights in memory.",
+                      safe_path);
+      Release();
+      return true;
+    }
+    // The cache may have been installed since the first load attempt.
+    if (LoadForAppend(safe_path)) {
+      build_lock_.Unlock();
+      TFLITE_LOG_PROD(tflite::TFLITE_LOG_VERBOSE,
+                      "XNNPack weight cache loaded from '%s'.", safe_path);
+      return true;
+    }
+  }
+  if (StartBuild(safe_path, std::move(build_fd))) {
     TFLITE_LOG_PROD(tflite::TFLITE_LOG_VERBOSE,
                     "XNNPack weight cache build for '%s' started.", safe_path);
     return true;
@@ -355,21 +487,67 @@ bool MMapWeightCacheProvider::StartBuild(const char* path, FileDescriptor fd) {
   const char* const safe_path = Sanitize(path);
   SetFilePath(safe_path);
 
+  // When locked, the cache is built to a temporary file that is installed at
+  // `file_path_` once done.
+  const std::string& build_path =
+      build_lock_.IsLocked() ? build_lock_.GetBuildPath() : file_path_;
   if (!fd.IsValid()) {
     if (IsInMemoryCachePath(file_path_)) {
       fd = CreateInMemoryFileDescriptor("XNNPack in-memory weight cache");
     } else {
-      fd = FileDescriptor::Open(file_path_.c_str(), O_CREAT | O_TRUNC | O_RDWR,
+      fd = FileDescriptor::Open(build_path.c_str(), O_CREAT | O_TRUNC | O_RDWR,
                                 0644);
     }
   }
+  if (!fd.IsValid()) {
+    build_lock_.Unlock();
+  }
   XNNPACK_RETURN_CHECK(fd.IsValid(), "could not open file ('%s'): %s.",
-                       file_path_.c_str(), strerror(errno));
+                       build_path.c_str(), strerror(errno));
   file_descriptor_ = std::move(fd);
-  building_run_ = builder_.Start(safe_path, file_descriptor_);
+  building_run_ = builder_.Start(build_path.c_str(), file_descriptor_);
+  if (!building_run_) {
+    build_lock_.Unlock();
+  }
   return building_run_;
 }
 
+void MMapWeightCacheProvider::StopBuild() {
+  building_run_ = false;
+  InstallBuiltCache();
+}
+
+void MMapWeightCacheProvider::InstallBuiltCache() {
+  if (!build_lock_.IsLocked()) {
+    return;
+  }
+  // The file is only valid between build steps, after one was written.
+  if (builder_.IsBuilding() || !builder_.IsCacheWritten()) {
+    build_lock_.Unlock();
+    return;
+  }
+  if (build_lock_.Install()) {
+    TFLITE_LOG_PROD(tflite::TFLITE_LOG_VERBOSE,
+                    "XNNPack weight cache: installed '%s'.",
+                    file_path_.c_str());
+  }
+}
+
+bool MMapWeightCacheProvider::LoadForAppend(const char* path) {
+  // The file is mapped through the descriptor the packings are appended to,
+  // in case it is replaced at `path` in the meantime.
+  FileDescriptor fd = FileDescriptor::Open(path, O_RDWR);
+  const bool writable = fd.IsValid();
+  if (!Load(path, std::move(fd))) {
+    return false;
+  }
+  if (writable && builder_.StartAppend(path, file_descriptor_)) {
+    building_run_ = true;
+    appending_ = true;
+  }
+  return true;
+}
+
 bool MMapWeightCacheProvider::Load(const std::string& path, FileDescriptor fd) {
   SetFilePath(path.c_str());
   file_descriptor_ = std::move(fd);
@@ -476,10 +654,12 @@ bool MMapWeightCacheProvider::LoadLastBuildStep() {
   // - either resize the last mmap handle;
   // - or add a new mapping handle.
   {
+    // Other processes may have appended to the file since it was mapped.
     MMapHandle& last_mmap_handle = mmap_handles_.back();
-    const int last_mmap_size = last_mmap_handle.size();
-    if (!last_mmap_handle.Resize(last_mmap_size +
-                                 builder_.LastBuildStepSize())) {
+    const size_t build_step_end =
+        builder_.LastBuildStepStart() + builder_.LastBuildStepSize();
+    if (!last_mmap_handle.Resize(build_step_end -
+                                 last_mmap_handle.offset())) {
       mmap_handles_.emplace_back();
       if (file_descriptor_.IsValid()) {
         XNNPACK_RETURN_CHECK(
@@ -515,6 +695,10 @@ bool MMapWeightCacheProvider::LoadLastBuildStep() {
       buffer_list->base_offset() - segment_mmap_handle.offset();
   for (const auto* buffer : *(buffer_list->buffers())) {
     const size_t offset = buffer->offset();
+    // Skip the buffers that other processes appended outside of the mapping.
+    if (offset + buffer_list->base_offset() < segment_mmap_handle.offset()) {
+      continue;
+    }
     if (!offset_to_addr_.count(offset)) {
       offset_to_addr_.insert(
           {offset, segment_mmap_handle.data() + offset + offset_modifier});
@@ -529,10 +713,26 @@ bool MMapWeightCacheProvider::StartBuildStep() {
   if (IsBuilding()) {
     return true;
   }
-  return builder_.StartBuildStep();
+  // Appending to a loaded file requires exclusive access to its end. The
+  // build step reloads the buffer list with the other processes' additions.
+  if (appending_ && !build_lock_.Lock(file_path_)) {
+    return false;
+  }
+  if (!builder_.StartBuildStep()) {
+    if (appending_) {
+      build_lock_.Unlock();
+    }
+    return false;
+  }
+  return true;
 }
 
 bool MMapWeightCacheProvider::StopBuildStep() {
+  ScopeGuard unlock([this] {
+    if (appending_) {
+      build_lock_.Unlock();
+    }
+  });
   XNNPACK_RETURN_CHECK(builder_.StopBuildStep());
 #if defined(XNNPACK_CACHE_NO_MMAP_FOR_TEST)
   if (!mmap_handles_.empty()) {
@@ -696,4 +896,63 @@ bool IsCompatibleCacheFile(const char* path) {
   return true;
 }
 
+bool CompactCacheFile(const char* path) {
+  XNNPACK_RETURN_CHECK(IsCompatibleCacheFile(path));
+  WeightCacheBuildLock lock;
+  XNNPACK_RETURN_CHECK(lock.TryLock(path),
+                       "'%s' is being built by another process.", path);
+  XNNPACK_RETURN_CHECK(lock.GetBuildPath() != path,
+                       "cache files cannot be compacted on this platform.");
+
+  MMapHandle mmap_handle;
+  XNNPACK_RETURN_CHECK(mmap_handle.Map(path));
+  XNNPackCacheHeader header;
+  XNNPACK_RETURN_CHECK(mmap_handle.size() >= sizeof(header),
+                       "invalid cache file size: %zu.", mmap_handle.size());
+  memcpy(&header, mmap_handle.data(), sizeof(header));
+  XNNPACK_RETURN_CHECK(header.buffer_list_offset < mmap_handle.size() &&
+                           header.buffer_list_size ==
+                               mmap_handle.size() - header.buffer_list_offset,
+                       "invalid buffer list descriptor.");
+  flatbuffers::Verifier verifier(mmap_handle.data() + header.buffer_list_offset,
+                                 header.buffer_list_size);
+  XNNPACK_RETURN_CHECK(cache::schema::VerifyBufferListBuffer(verifier),
+                       "buffer list validation failed.");
+  const cache::schema::BufferList* buffer_list = cache::schema::GetBufferList(
+      mmap_handle.data() + header.buffer_list_offset);
+
+  const std::string& build_path = lock.GetBuildPath();
+  FileDescriptor fd = FileDescriptor::Open(
+      build_path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+  XNNPACK_RETURN_CHECK(fd.IsValid(), "could not open file ('%s'): %s.",
+                       build_path.c_str(), strerror(errno));
+  WeightCacheBuilder builder;
+  XNNPACK_RETURN_CHECK(builder.Start(build_path.c_str(), fd));
+  XNNPACK_RETURN_CHECK(builder.StartBuildStep());
+  // Only the buffers referenced by the current buffer list are copied, once.
+  std::unordered_set<PackIdentifier, PackIdentifier::Hash> copied;
+  if (const auto buffers = buffer_list->buffers(); buffers) {
+    for (const auto* buffer : *buffers) {
+      const PackIdentifier pack_id{
+          /*pack_algorithm_id=*/buffer->packing_algorithm_id(),
+          /*weights_id=*/buffer->weights_id(),
+          /*bias_id=*/buffer->bias_id()};
+      if (!copied.insert(pack_id).second) {
+        continue;
+      }
+      const size_t offset = buffer_list->base_offset() + buffer->offset();
+      XNNPACK_RETURN_CHECK(offset <= mmap_handle.size() &&
+                               buffer->size() <= mmap_handle.size() - offset,
+                           "invalid buffer location in '%s'.", path);
+      XNNPACK_RETURN_CHECK(
+          !builder
+               .Append(pack_id, mmap_handle.data() + offset, buffer->size())
+               .IsInvalid(),
+          "could not copy buffer to '%s'.", build_path.c_str());
+    }
+  }
+  XNNPACK_RETURN_CHECK(builder.StopBuildStep());
+  return lock.Install();
+}
+
 }  // namespace tflite::xnnpack
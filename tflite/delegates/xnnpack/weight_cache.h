@@ -65,6 +65,15 @@ struct XNNPackCacheHeader {
 
 bool IsCompatibleCacheFile(const char* path);
 
+// Rewrites the cache file at `path` without the space that appending to it
+// left unused: the previous buffer lists and the buffers that were packed
+// more than once. The new file is installed with an atomic rename, processes
+// that have mapped the old one keep using it.
+//
+// Returns false if the file is invalid or is being built by another process.
+[[nodiscard /*Compacting a cache file may fail.*/]]
+bool CompactCacheFile(const char* path);
+
 struct PackIdentifier {
   enum { kNoId = SIZE_MAX };
   uint64_t pack_algorithm_id = kNoId;
@@ -117,6 +126,14 @@ class WeightCacheBuilder {
   [[nodiscard /*Starting the builder may fail.*/]]
   bool Start(const char* path, const FileDescriptor& fd);
 
+  // Starts adding data to an existing cache file.
+  //
+  // The build steps append their data after the end of the file instead of
+  // overwriting the current buffer list, which stays valid for the processes
+  // that load the file until the header is updated.
+  [[nodiscard /*Starting the builder may fail.*/]]
+  bool StartAppend(const char* path, const FileDescriptor& fd);
+
   [[nodiscard]]
   bool IsStarted() const {
     return fd_.IsValid();
@@ -173,6 +190,13 @@ class WeightCacheBuilder {
     return build_segment_size_;
   }
 
+  // Returns true if a valid cache was written to the file, i.e. a build step
+  // has been stopped successfully.
+  [[nodiscard]]
+  bool IsCacheWritten() const {
+    return first_write_done_;
+  }
+
   // Returns the file descriptor.
   FileDescriptorView GetFileDescriptor() const { return fd_; }
 
@@ -202,6 +226,8 @@ class WeightCacheBuilder {
   // cache. To ensure a smooth reloading, we need to ensure that the file header
   // is correct. This flag lets us know if that has happened.
   bool first_write_done_ = false;
+  // Set when the builder appends to an existing cache file.
+  bool append_ = false;
   // File descriptor view.
   FileDescriptorView fd_;
   std::string file_path_;
@@ -209,6 +235,59 @@ class WeightCacheBuilder {
   std::atomic<bool> is_build_step_ = false;
 };
 
+// Lets a single process build the cache file at a given path when several
+// processes start the same model at the same time.
+//
+// The process holding the lock builds the cache to a temporary file next to
+// the cache file and installs it with an atomic rename when it is done, so
+// that the other processes only ever see complete cache files. The lock is
+// released by the system if the process dies, the next build then overwrites
+// the temporary file.
+//
+// WARNING: the interface in this file is still under experimentation and WILL
+// CHANGE. Do not rely on it.
+class WeightCacheBuildLock {
+ public:
+  WeightCacheBuildLock() = default;
+  WeightCacheBuildLock(const WeightCacheBuildLock&) = delete;
+  WeightCacheBuildLock& operator=(const WeightCacheBuildLock&) = delete;
+  WeightCacheBuildLock(WeightCacheBuildLock&& other);
+  WeightCacheBuildLock& operator=(WeightCacheBuildLock&& other);
+
+  // Tries to lock the cache file at `path` without waiting. Returns false if
+  // another process holds the lock or if the lock file cannot be opened.
+  [[nodiscard /*Another process may be building the cache.*/]]
+  bool TryLock(const std::string& path);
+
+  // Waits for the lock on the cache file at `path` to update the file in
+  // place. Returns false if the lock file cannot be opened.
+  [[nodiscard /*Locking the cache file may fail.*/]]
+  bool Lock(const std::string& path);
+
+  [[nodiscard]]
+  bool IsLocked() const {
+    return locked_;
+  }
+
+  // Returns the path of the temporary file to build the cache to.
+  const std::string& GetBuildPath() const { return build_path_; }
+
+  // Moves the temporary file to the cache file path and releases the lock.
+  [[nodiscard /*Installing the cache file may fail.*/]]
+  bool Install();
+
+  // Releases the lock without installing the temporary file.
+  void Unlock();
+
+ private:
+  bool Acquire(const std::string& path, bool wait);
+
+  std::string path_;
+  std::string build_path_;
+  FileDescriptor lock_fd_;
+  bool locked_ = false;
+};
+
 // Allows XNNPack to directly load packed weights from disk instead of having to
 // repack them every time.
 //
@@ -230,6 +309,9 @@ class MMapWeightCacheProvider {
   MMapWeightCacheProvider(MMapWeightCacheProvider&&);
   MMapWeightCacheProvider& operator=(MMapWeightCacheProvider&&);
 
+  // Installs the cache file if it was built by this provider.
+  ~MMapWeightCacheProvider();
+
   // Changes the file path to save the cache to.
   //
   // WARNING: Can only be called if the cache isn't finalized.
@@ -242,6 +324,15 @@ class MMapWeightCacheProvider {
   //
   // If `fd` is provided, use that instead of reopening the file at the given
   // path.
+  //
+  // Otherwise, the file is only built by one process at a time: if another
+  // process is building it, this returns true without activating the cache
+  // and the weights are packed in memory. The cache file is installed when
+  // the build is stopped or the provider is destroyed.
+  //
+  // A cache file loaded from a writable path is opened for appending: the
+  // packings that are missing from it, for new shapes or precisions, are
+  // added to it instead of requiring a full rebuild.
   [[nodiscard /*Loading a cache file may fail.*/]]
   bool LoadOrStartBuild(const char* file_path,
                         FileDescriptor fd = FileDescriptor());
@@ -252,7 +343,9 @@ class MMapWeightCacheProvider {
   // If the cache is still being built, this signals that all of the building
   // operations are done and that `CanStartBuildStep()` should now return
   // `false`.
-  void StopBuild() { building_run_ = false; }
+  //
+  // This installs the cache file for the other processes to load.
+  void StopBuild();
 
   // Sets the weight file path and loads it.
   [[nodiscard /*Loading a cache file may fail.*/]]
@@ -262,6 +355,11 @@ class MMapWeightCacheProvider {
   [[nodiscard /*Loading cache data may fail.*/]]
   bool Load();
 
+  // Loads the cache file at `path` and, if the file is writable, prepares to
+  // append the packings that are missing from it.
+  [[nodiscard /*Loading a cache file may fail.*/]]
+  bool LoadForAppend(const char* path);
+
   // Checks if the cache is currently being built or if it was loaded from a
   // file.
   [[nodiscard]]
@@ -363,6 +461,9 @@ class MMapWeightCacheProvider {
   [[nodiscard /*Loading cache data may fail.*/]]
   bool LoadLastBuildStep();
 
+  // Installs the cache file built under `build_lock_`, if any.
+  void InstallBuiltCache();
+
   // Cache provider implementation for XNNPack.
   xnn_weights_cache_provider cache_provider_{
       /*context=*/this,
@@ -397,13 +498,22 @@ class MMapWeightCacheProvider {
   // Used to build the cache.
   WeightCacheBuilder builder_;
 
-  // True if the current run is the one building the cache file.
+  // Held while building the cache file at `file_path_`.
+  WeightCacheBuildLock build_lock_;
+
+  // True if the current run is the one building the cache file or if it can
+  // append to the cache file it loaded.
   //
   // We cannot distinguish between a wrong/outdated cache and one that is not
   // fully done. To detect misuse, we still want to raise an error when XNNPack
   // tries to append data to an existing file (i.e. when this is `false`).
   bool building_run_ = false;
 
+  // True if the build steps append to a cache file that was loaded. The build
+  // lock is then held during each step, to merge the data that other
+  // processes append to the file.
+  bool appending_ = false;
+
   // Stores the loaded buffer addresses corresponding to the given offset in the
   // cache file.
   std::map<size_t, void*> offset_to_addr_;
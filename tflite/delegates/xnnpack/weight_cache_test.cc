@@ -16,6 +16,10 @@ limitations under the License.
 
 #include <fcntl.h>
 
+#if !defined(_MSC_VER)
+#include <unistd.h>
+#endif
+
 #include <algorithm>
 #include <cassert>
 #include <cerrno>
@@ -972,6 +976,140 @@ TEST_P(MMapWeightCacheProviderTest, XnnpackRebuildOnVersionMismatch) {
   ASSERT_TRUE(cache_provider.StartBuildStep());
 }
 
+#if !defined(_MSC_VER)
+TEST(WeightCacheBuildLockTest, OnlyOneLockCanBeHeld) {
+  TempFileDesc tmp_file{TempFileDesc::kAutoClose};
+  const std::string lock_path = tmp_file.GetPath() + ".lock";
+
+  WeightCacheBuildLock lock1;
+  WeightCacheBuildLock lock2;
+  ASSERT_TRUE(lock1.TryLock(tmp_file.GetPath()));
+  EXPECT_NE(lock1.GetBuildPath(), tmp_file.GetPath());
+  EXPECT_FALSE(lock2.TryLock(tmp_file.GetPath()));
+  EXPECT_FALSE(lock2.IsLocked());
+  lock1.Unlock();
+  EXPECT_TRUE(lock2.TryLock(tmp_file.GetPath()));
+  lock2.Unlock();
+  unlink(lock_path.c_str());
+}
+
+TEST(WeightCacheBuildLockTest, ConcurrentBuildersDontShareTheCacheFile) {
+  TempFileDesc tmp_file{TempFileDesc::kAutoClose};
+  const std::string lock_path = tmp_file.GetPath() + ".lock";
+  FakeContext ctx;
+  ctx.AddTensor(/*buffer_identifier=*/0, /*size=*/12);
+  ctx.FinalizeTensors();
+
+  auto builder = std::make_unique<MMapWeightCacheProvider>();
+  builder->MapTensorIdentifiers(ctx.tensors.data(), ctx.tensors.size(),
+                                ctx.tensor_buffer_identifiers);
+  ASSERT_TRUE(builder->LoadOrStartBuild(tmp_file.GetCPath()));
+  ASSERT_TRUE(builder->IsActive());
+
+  // Another process starting while the cache is being built packs its weights
+  // in memory.
+  MMapWeightCacheProvider waiter;
+  EXPECT_TRUE(waiter.LoadOrStartBuild(tmp_file.GetCPath()));
+  EXPECT_FALSE(waiter.IsActive());
+
+  ASSERT_TRUE(builder->StartBuildStep());
+  ctx.PackTensors(&builder->GetCacheProvider(), /*algorithm_seed=*/0,
+                  /*tensor_index=*/0);
+  ASSERT_TRUE(builder->StopBuildStep());
+  builder.reset();
+
+  // The cache file is installed when the builder is done with it.
+  MMapWeightCacheProvider loader;
+  ASSERT_TRUE(loader.LoadOrStartBuild(tmp_file.GetCPath()));
+  EXPECT_TRUE(loader.IsActive());
+  EXPECT_FALSE(loader.IsBuilding());
+  unlink(lock_path.c_str());
+}
+
+// Checks that the buffers packed in `ctx` can be found in the cache at `path`.
+void ExpectPackedBuffersInCache(const FakeContext& ctx, const char* path) {
+  MMapWeightCacheProvider cache_provider;
+  ASSERT_TRUE(cache_provider.Load(path));
+  cache_provider.MapTensorIdentifiers(ctx.tensors.data(), ctx.tensors.size(),
+                                      ctx.tensor_buffer_identifiers);
+  for (const auto& [pack_id, packed] : ctx.packed_buffers) {
+    const xnn_weights_cache_look_up_key look_up_key =
+        ctx.LookUpKey(pack_id.pack_algorithm_id, pack_id.weights_id);
+    const size_t offset = cache_provider.LookUp(&look_up_key);
+    ASSERT_NE(offset, SIZE_MAX);
+    EXPECT_THAT(LightSpan<const uint8_t>(cache_provider.OffsetToAddr(offset),
+                                         packed.buffer.size()),
+                ElementsAreArray(packed.buffer));
+  }
+}
+
+TEST(WeightCacheAppendTest, MissingPackingsAreAppendedToALoadedCache) {
+  TempFileDesc tmp_file{TempFileDesc::kAutoClose};
+  const std::string lock_path = tmp_file.GetPath() + ".lock";
+  enum { kAlgoSeed1, kAlgoSeed2 };
+  FakeContext ctx;
+  // The buffer identifiers match the tensor indices.
+  ctx.AddTensor(/*buffer_identifier=*/0, /*size=*/12);
+  ctx.AddTensor(/*buffer_identifier=*/1, /*size=*/43);
+  ctx.FinalizeTensors();
+
+  {
+    MMapWeightCacheProvider cache_provider;
+    cache_provider.MapTensorIdentifiers(ctx.tensors.data(), ctx.tensors.size(),
+                                        ctx.tensor_buffer_identifiers);
+    ASSERT_TRUE(cache_provider.LoadOrStartBuild(tmp_file.GetCPath()));
+    ASSERT_TRUE(cache_provider.StartBuildStep());
+    ctx.PackTensors(&cache_provider.GetCacheProvider(), kAlgoSeed1,
+                    /*tensor_index=*/0);
+    ASSERT_TRUE(cache_provider.StopBuildStep());
+  }
+  const FileDescriptor::Offset built_size =
+      FileDescriptor::Open(tmp_file.GetCPath(), O_RDONLY).SetPosFromEnd(0);
+
+  {
+    MMapWeightCacheProvider cache_provider;
+    cache_provider.MapTensorIdentifiers(ctx.tensors.data(), ctx.tensors.size(),
+                                        ctx.tensor_buffer_identifiers);
+    ASSERT_TRUE(cache_provider.LoadOrStartBuild(tmp_file.GetCPath()));
+    ASSERT_TRUE(cache_provider.CanStartBuildStep());
+    // A build step that doesn't add anything leaves the file untouched.
+    ASSERT_TRUE(cache_provider.StartBuildStep());
+    ASSERT_TRUE(cache_provider.StopBuildStep());
+    EXPECT_EQ(
+        FileDescriptor::Open(tmp_file.GetCPath(), O_RDONLY).SetPosFromEnd(0),
+        built_size);
+
+    ASSERT_TRUE(cache_provider.StartBuildStep());
+    ctx.PackTensors(&cache_provider.GetCacheProvider(), kAlgoSeed2,
+                    /*tensor_index=*/1);
+    ctx.PackTensors(&cache_provider.GetCacheProvider(), kAlgoSeed2,
+                    /*tensor_index=*/0);
+    ASSERT_TRUE(cache_provider.StopBuildStep());
+
+    for (const auto& [pack_id, packed] : ctx.packed_buffers) {
+      const xnn_weights_cache_look_up_key look_up_key =
+          ctx.LookUpKey(pack_id.pack_algorithm_id, pack_id.weights_id);
+      const size_t offset = cache_provider.LookUp(&look_up_key);
+      ASSERT_NE(offset, SIZE_MAX);
+      EXPECT_THAT(LightSpan<const uint8_t>(cache_provider.OffsetToAddr(offset),
+                                           packed.buffer.size()),
+                  ElementsAreArray(packed.buffer));
+    }
+  }
+  ExpectPackedBuffersInCache(ctx, tmp_file.GetCPath());
+
+  // Compacting drops the buffer list that the append replaced.
+  const FileDescriptor::Offset appended_size =
+      FileDescriptor::Open(tmp_file.GetCPath(), O_RDONLY).SetPosFromEnd(0);
+  ASSERT_TRUE(CompactCacheFile(tmp_file.GetCPath()));
+  EXPECT_LT(
+      FileDescriptor::Open(tmp_file.GetCPath(), O_RDONLY).SetPosFromEnd(0),
+      appended_size);
+  ExpectPackedBuffersInCache(ctx, tmp_file.GetCPath());
+  unlink(lock_path.c_str());
+}
+#endif
+
 class IsCompatibleCacheFileTest : public testing::Test {
  public:
   void SetUp() override {
@@ -74,6 +74,25 @@ namespace tflite {
 namespace xnnpack {
 namespace {
 
+// Scratch memory of the XNNPack runtimes of one or more delegates, with the
+// mutex that serializes them.
+struct Workspace {
+  ~Workspace() { xnn_release_workspace(workspace); }
+
+  xnn_workspace_t workspace = nullptr;
+  std::mutex mutex;
+};
+
+std::shared_ptr<Workspace> CreateWorkspace() {
+  xnn_workspace_t workspace = nullptr;
+  if (xnn_create_workspace(&workspace) != xnn_status_success) {
+    return nullptr;
+  }
+  auto shared_workspace = std::make_shared<Workspace>();
+  shared_workspace->workspace = workspace;
+  return shared_workspace;
+}
+
 // VisitDotAttentionNode uses a clamp to add a constant value to the XNNPack
 // subgraph. The constant data must outlive the XNNPack delegate and there is no
 // simple way of doing this. Therefore a clamp was used to clamp some arbitrary
@@ -572,7 +591,8 @@ class Delegate {
 
  public:
   explicit Delegate(const TfLiteXNNPackDelegateOptions* options_ptr,
-                    xnn_workspace_t workspace, TfLiteContext* context = nullptr)
+                    std::shared_ptr<Workspace> workspace,
+                    TfLiteContext* context = nullptr)
       : options_(options_ptr ? *options_ptr
                              : TfLiteXNNPackDelegateOptionsDefault()) {
     int num_subgraphs = 1;
@@ -612,7 +632,7 @@ class Delegate {
                          "Created TensorFlow Lite XNNPACK delegate for CPU.");
 
     delegate_.flags = GetXNNPackDelegateFlags();
-    workspace_.reset(workspace);
+    workspace_ = std::move(workspace);
 
     // If no weight cache is provided, add one when requested.
     if (!options_.weights_cache) {
@@ -766,7 +786,15 @@ class Delegate {
     }
   }
 
-  xnn_workspace_t workspace() const { return workspace_.get(); }
+  xnn_workspace_t workspace() const { return workspace_->workspace; }
+
+  bool defer_runtime_creation() const {
+    // The weights are packed into the caches when the runtime is created, so
+    // it must happen while they are being built.
+    return (options_.flags &
+            TFLITE_XNNPACK_DELEGATE_FLAG_DEFER_RUNTIME_CREATION) != 0 &&
+           weights_cache() == nullptr && !weight_cache_provider_->IsActive();
+  }
 
   const ResourceInfo* FindResourceInfo(int local_id) const {
     auto it = local_id_to_resources_.find(local_id);
@@ -832,11 +860,11 @@ class Delegate {
   // Boolean that indicates if threadpool_ was created by xnnpack_delegate.
   bool own_threadpool_;
 #endif
-  std::unique_ptr<xnn_workspace, decltype(&xnn_release_workspace)> workspace_{
-      nullptr, &xnn_release_workspace};
+  // Shared with the other delegates created with the same
+  // `TfLiteXNNPackDelegateOptions::workspace`.
+  std::shared_ptr<Workspace> workspace_;
 
   TfLiteXNNPackDelegateOptions options_{};
-  std::mutex workspace_mutex_;
 
   // If no weight cache is provided and a cache is set in the delegate options,
   // this will be used as a weight cache.
@@ -1147,7 +1175,32 @@ class Subgraph {
       }
     }
 
+    if (delegate.defer_runtime_creation()) {
+      return new Subgraph(delegate, /*runtime=*/nullptr, subgraph.release(),
+                          has_sparse_weights, externals,
+                          std::move(external_inputs),
+                          std::move(external_outputs),
+                          std::move(tflite_tensor_to_xnnpack));
+    }
+
     xnn_runtime_t runtime_ptr = nullptr;
+    if (CreateRuntime(context, delegate, subgraph.get(), has_sparse_weights,
+                      &runtime_ptr) != kTfLiteOk) {
+      return nullptr;
+    }
+
+    return new Subgraph(delegate, runtime_ptr, /*subgraph=*/nullptr,
+                        has_sparse_weights, externals,
+                        std::move(external_inputs), std::move(external_outputs),
+                        std::move(tflite_tensor_to_xnnpack));
+  }
+
+  // Creates the XNNPACK runtime of `subgraph`.
+  static TfLiteStatus CreateRuntime(TfLiteContext* context,
+                                    Delegate& delegate,
+                                    xnn_subgraph_t subgraph,
+                                    bool has_sparse_weights,
+                                    xnn_runtime_t* runtime) {
     uint32_t flags = XNN_FLAG_DONT_SPIN_WORKERS;
     if (has_sparse_weights) {
       flags |= XNN_FLAG_HINT_SPARSE_INFERENCE;
@@ -1189,91 +1242,58 @@ class Subgraph {
       if (!delegate.weight_cache_provider_->StartBuildStep()) {
         TF_LITE_KERNEL_LOG(
             context, "XNNPack delegate failed to start cache build step.");
-        return nullptr;
+        return kTfLiteError;
       }
     }
-    status = xnn_create_runtime_v4(subgraph.get(), delegate.weights_cache(),
-                                   delegate.workspace(), delegate.threadpool(),
-                                   flags, &runtime_ptr);
+    const xnn_status status = xnn_create_runtime_v4(
+        subgraph, delegate.weights_cache(), delegate.workspace(),
+        delegate.threadpool(), flags, runtime);
     if (delegate.weight_cache_provider_->IsActive() &&
         delegate.weight_cache_provider_->CanStartBuildStep()) {
       if (!delegate.weight_cache_provider_->StopBuildStep()) {
         TF_LITE_KERNEL_LOG(context,
                            "XNNPack delegate failed to stop cache build step.");
-        return nullptr;
+        return kTfLiteError;
       }
     }
     if (status != xnn_status_success) {
       TF_LITE_KERNEL_LOG(context, "failed to create XNNPACK runtime");
-      return nullptr;
+      return kTfLiteError;
     }
+    return kTfLiteOk;
+  }
 
-    return new Subgraph(delegate, runtime_ptr, externals,
-                        std::move(external_inputs), std::move(external_outputs),
-                        std::move(tflite_tensor_to_xnnpack));
+  // Creates the runtime if its creation was deferred.
+  TfLiteStatus EnsureRuntime(TfLiteContext* context) {
+    if (runtime_ != nullptr) {
+      return kTfLiteOk;
+    }
+    xnn_runtime_t runtime_ptr = nullptr;
+    TF_LITE_ENSURE_STATUS(CreateRuntime(context, *delegate_, subgraph_.get(),
+                                        has_sparse_weights_, &runtime_ptr));
+    runtime_.reset(runtime_ptr);
+    subgraph_.reset();
+    return kTfLiteOk;
   }
 
   TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node,
                        bool enable_subgraph_reshaping, Delegate* delegate) {
-    std::lock_guard<std::mutex> lock(delegate->workspace_mutex_);
+    std::lock_guard<std::mutex> lock(delegate->workspace_->mutex);
     tflite::Subgraph* this_subgraph =
         reinterpret_cast<tflite::Subgraph*>(context->impl_);
 
     if (enable_subgraph_reshaping) {
-      xnn_status status = xnn_status_invalid_state;
-      for (int i = 0; i < inputs_.size(); ++i) {
-        const TfLiteTensor* tensor = &context->tensors[inputs_[i]];
-        const int dims_count = NumDimensions(tensor);
-        std::array<size_t, XNN_MAX_TENSOR_DIMS> xnn_dims;
-        std::copy(&tensor->dims->data[0], &tensor->dims->data[dims_count],
-                  xnn_dims.begin());
-        status = xnn_reshape_external_value(
-            runtime_.get(), tflite_tensor_to_xnnpack_[inputs_[i]], dims_count,
-            xnn_dims.data());
-        if (status != xnn_status_success) {
-          TF_LITE_KERNEL_LOG(
-              context, "XNNPack delegate failed to reshape external value");
-          return kTfLiteError;
-        }
-      }
-      status = xnn_reshape_runtime(runtime_.get());
-      if (status != xnn_status_success) {
-        TF_LITE_KERNEL_LOG(context,
-                           "XNNPack delegate failed to reshape runtime");
-        return kTfLiteError;
-      }
-
-      for (int i = 0; i < outputs_.size(); ++i) {
-        TfLiteTensor* tensor = &context->tensors[outputs_[i]];
-        size_t num_out_dims;
-        size_t out_dims[XNN_MAX_TENSOR_DIMS];
-        status = xnn_get_external_value_shape(
-            runtime_.get(),
-            static_cast<uint32_t>(tflite_tensor_to_xnnpack_[outputs_[i]]),
-            &num_out_dims, &out_dims[0]);
-        if (status != xnn_status_success) {
-          TF_LITE_KERNEL_LOG(
-              context, "XNNPack delegate failed to get external value shape");
-          return kTfLiteError;
-        }
-        TfLiteIntArray* output_shape = TfLiteIntArrayCreate(num_out_dims);
-        for (int k = 0; k < num_out_dims; ++k) {
-          output_shape->data[k] = out_dims[k];
-        }
-        if (context->ResizeTensor(context, tensor, output_shape) != kTfLiteOk) {
-          TF_LITE_KERNEL_LOG(
-              context, "XNNPack delegate failed to get resize output tensor");
-          return kTfLiteError;
-        }
-      }
-
-      // signal that setup must be called.
-      for (std::pair<const int, void*>& io_info : externals_) {
-        io_info.second = nullptr;
+      // The output shapes are inferred by the runtime.
+      TF_LITE_ENSURE_STATUS(EnsureRuntime(context));
+      if (!reshaped_ || InputShapesChanged(context)) {
+        TF_LITE_ENSURE_STATUS(ReshapeRuntime(context));
       }
+      TF_LITE_ENSURE_STATUS(ResizeOutputs(context));
     }
 
-    // Prepare any VarHandle ops we delegated.
+    // Prepare any VarHandle ops we delegated. Their outputs are reallocated,
+    // so the next invocation writes them and looks the variables up again.
+    variables_.clear();
     for (std::pair<const int, void*>& io_info : externals_) {
       const auto& resource_it = resources_.find(io_info.first);
       if (resource_it != resources_.end()) {
@@ -1290,9 +1310,94 @@ class Subgraph {
     return kTfLiteOk;
   }
 
+  // Checks if the shape of an input changed since the runtime was reshaped.
+  bool InputShapesChanged(TfLiteContext* context) const {
+    for (int i = 0; i < inputs_.size(); ++i) {
+      const TfLiteIntArray* dims = context->tensors[inputs_[i]].dims;
+      const std::vector<int>& reshaped_dims = reshaped_input_dims_[i];
+      if (!std::equal(reshaped_dims.begin(), reshaped_dims.end(), dims->data,
+                      dims->data + dims->size)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Reshapes the runtime to the current input shapes.
+  //
+  // The runtime needs to be set up again afterwards, even if the data
+  // pointers didn't change.
+  TfLiteStatus ReshapeRuntime(TfLiteContext* context) {
+    // The runtime needs to be reshaped again if this fails.
+    reshaped_ = false;
+    xnn_status status = xnn_status_invalid_state;
+    for (int i = 0; i < inputs_.size(); ++i) {
+      const TfLiteTensor* tensor = &context->tensors[inputs_[i]];
+      const int dims_count = NumDimensions(tensor);
+      std::array<size_t, XNN_MAX_TENSOR_DIMS> xnn_dims;
+      std::copy(&tensor->dims->data[0], &tensor->dims->data[dims_count],
+                xnn_dims.begin());
+      status = xnn_reshape_external_value(
+          runtime_.get(), tflite_tensor_to_xnnpack_[inputs_[i]], dims_count,
+          xnn_dims.data());
+      if (status != xnn_status_success) {
+        TF_LITE_KERNEL_LOG(context,
+                           "XNNPack delegate failed to reshape external value");
+        return kTfLiteError;
+      }
+    }
+    status = xnn_reshape_runtime(runtime_.get());
+    if (status != xnn_status_success) {
+      TF_LITE_KERNEL_LOG(context, "XNNPack delegate failed to reshape runtime");
+      return kTfLiteError;
+    }
+
+    reshaped_input_dims_.resize(inputs_.size());
+    for (int i = 0; i < inputs_.size(); ++i) {
+      const TfLiteIntArray* dims = context->tensors[inputs_[i]].dims;
+      reshaped_input_dims_[i].assign(dims->data, dims->data + dims->size);
+    }
+    reshaped_ = true;
+
+    // signal that setup must be called.
+    for (std::pair<const int, void*>& io_info : externals_) {
+      io_info.second = nullptr;
+    }
+    return kTfLiteOk;
+  }
+
+  // Sets the shapes of the output tensors to the ones inferred by the runtime.
+  TfLiteStatus ResizeOutputs(TfLiteContext* context) {
+    for (int i = 0; i < outputs_.size(); ++i) {
+      TfLiteTensor* tensor = &context->tensors[outputs_[i]];
+      size_t num_out_dims;
+      size_t out_dims[XNN_MAX_TENSOR_DIMS];
+      const xnn_status status = xnn_get_external_value_shape(
+          runtime_.get(),
+          static_cast<uint32_t>(tflite_tensor_to_xnnpack_[outputs_[i]]),
+          &num_out_dims, &out_dims[0]);
+      if (status != xnn_status_success) {
+        TF_LITE_KERNEL_LOG(
+            context, "XNNPack delegate failed to get external value shape");
+        return kTfLiteError;
+      }
+      TfLiteIntArray* output_shape = TfLiteIntArrayCreate(num_out_dims);
+      for (int k = 0; k < num_out_dims; ++k) {
+        output_shape->data[k] = out_dims[k];
+      }
+      if (context->ResizeTensor(context, tensor, output_shape) != kTfLiteOk) {
+        TF_LITE_KERNEL_LOG(
+            context, "XNNPack delegate failed to get resize output tensor");
+        return kTfLiteError;
+      }
+    }
+    return kTfLiteOk;
+  }
+
   TfLiteStatus Invoke(TfLiteContext* context, bool enable_subgraph_reshaping,
                       Delegate* delegate) {
-    std::lock_guard<std::mutex> lock(delegate->workspace_mutex_);
+    std::lock_guard<std::mutex> lock(delegate->workspace_->mutex);
+    TF_LITE_ENSURE_STATUS(EnsureRuntime(context));
 
     tflite::Subgraph* this_subgraph =
         reinterpret_cast<tflite::Subgraph*>(context->impl_);
@@ -1318,31 +1423,38 @@ class Subgraph {
           io_info.second = data_pointer;
         }
       } else {
-        const int node_index = resource_it->second.GetVarHandleNodeIndex();
-        int resource_id;
-        const auto* var_handle_and_registration =
-            this_subgraph->node_and_registration(node_index);
-        if (var_handle_and_registration) {
-          // By invoking VarHandle here, we're effectively reordering these ops
-          // to be at the beginning of the subgraph. This is OK because
-          // VarHandle has no input dependencies, and we already checked that
-          // multiple different VarHandles are not written to the same variable.
-          TF_LITE_ENSURE_STATUS(InvokeVarHandle(
-              context, &var_handle_and_registration->first, resource_id));
-        } else {
-          // There was no var handle. Maybe the resource is a static tensor?
-          const TfLiteTensor& resource_tensor =
-              context->tensors[resource_it->first];
-          TF_LITE_ENSURE(context, resource_tensor.data.raw != nullptr);
-          resource_id = *GetTensorData<int>(&resource_tensor);
-        }
+        // Variables are never removed from the resource map, so they are only
+        // looked up once. XNNPack reads and writes them in place, and they
+        // are shared with the other subgraphs and signatures as they are.
+        tflite::resource::ResourceVariable*& variable =
+            variables_[io_info.first];
+        if (variable == nullptr) {
+          const int node_index = resource_it->second.GetVarHandleNodeIndex();
+          int resource_id;
+          const auto* var_handle_and_registration =
+              this_subgraph->node_and_registration(node_index);
+          if (var_handle_and_registration) {
+            // By invoking VarHandle here, we're effectively reordering these
+            // ops to be at the beginning of the subgraph. This is OK because
+            // VarHandle has no input dependencies, and we already checked
+            // that multiple different VarHandles are not written to the same
+            // variable.
+            TF_LITE_ENSURE_STATUS(InvokeVarHandle(
+                context, &var_handle_and_registration->first, resource_id));
+          } else {
+            // There was no var handle. Maybe the resource is a static tensor?
+            const TfLiteTensor& resource_tensor =
+                context->tensors[resource_it->first];
+            TF_LITE_ENSURE(context, resource_tensor.data.raw != nullptr);
+            resource_id = *GetTensorData<int>(&resource_tensor);
+          }
 
-        resource::CreateResourceVariableIfNotAvailable(
-            &this_subgraph->resources(), resource_id);
-        tflite::resource::ResourceVariable* variable =
-            resource::GetResourceVariable(&this_subgraph->resources(),
-                                          resource_id);
-        TF_LITE_ENSURE(context, variable != nullptr);
+          resource::CreateResourceVariableIfNotAvailable(
+              &this_subgraph->resources(), resource_id);
+          variable = resource::GetResourceVariable(&this_subgraph->resources(),
+                                                   resource_id);
+          TF_LITE_ENSURE(context, variable != nullptr);
+        }
         if (!variable->GetTensor()) {
           TF_LITE_ENSURE(context, resource_it->second.GetProxyValue() >= 0);
           TfLiteTensor value =
@@ -2119,6 +2231,20 @@ class Subgraph {
     return kTfLiteError;
   }
 
+  // Same as above, also accepting FP16 tensors, which stay in half precision
+  // in XNNPack.
+  static TfLiteStatus CheckTensorFloatOrQUInt8Type(const Delegate& delegate,
+                                                   TfLiteContext* context,
+                                                   const TfLiteTensor& tensor,
+                                                   int tensor_index,
+                                                   int node_index) {
+    if (tensor.type == kTfLiteFloat16) {
+      return kTfLiteOk;
+    }
+    return CheckTensorFloat32OrQUInt8Type(delegate, context, tensor,
+                                          tensor_index, node_index);
+  }
+
   static TfLiteStatus CheckTensorFloat32OrQCInt8Type(
       const Delegate& delegate, TfLiteContext* context,
       const TfLiteTensor& tensor, int expected_quantized_dimension,
@@ -3962,11 +4088,11 @@ class Subgraph {
       case BuiltinOperator_ADD:
       case BuiltinOperator_MUL:
       case BuiltinOperator_SUB:
-        TF_LITE_ENSURE_STATUS(CheckTensorFloat32OrQUInt8Type(
+        TF_LITE_ENSURE_STATUS(CheckTensorFloatOrQUInt8Type(
             delegate, logging_context, input1_tensor, input1_id, node_index));
-        TF_LITE_ENSURE_STATUS(CheckTensorFloat32OrQUInt8Type(
+        TF_LITE_ENSURE_STATUS(CheckTensorFloatOrQUInt8Type(
             delegate, logging_context, input2_tensor, input2_id, node_index));
-        TF_LITE_ENSURE_STATUS(CheckTensorFloat32OrQUInt8Type(
+        TF_LITE_ENSURE_STATUS(CheckTensorFloatOrQUInt8Type(
             delegate, logging_context, output_tensor, output_id, node_index));
         if (input1_tensor.type != input2_tensor.type ||
             input1_tensor.type != output_tensor.type) {
@@ -3979,8 +4105,22 @@ class Subgraph {
       case BuiltinOperator_DIV:
       case BuiltinOperator_MAXIMUM:
       case BuiltinOperator_MINIMUM:
-      case BuiltinOperator_PRELU:
       case BuiltinOperator_SQUARED_DIFFERENCE:
+        TF_LITE_ENSURE_STATUS(CheckTensorFloatType(
+            logging_context, input1_tensor, input1_id, node_index));
+        TF_LITE_ENSURE_STATUS(CheckTensorFloatType(
+            logging_context, input2_tensor, input2_id, node_index));
+        TF_LITE_ENSURE_STATUS(CheckTensorFloatType(
+            logging_context, output_tensor, output_id, node_index));
+        if (input1_tensor.type != input2_tensor.type ||
+            input1_tensor.type != output_tensor.type) {
+          TF_LITE_MAYBE_KERNEL_LOG(
+              logging_context, "unsupported mixed types in %s operator #%d",
+              EnumNameBuiltinOperator(op_type), node_index);
+          return kTfLiteError;
+        }
+        break;
+      case BuiltinOperator_PRELU:
         TF_LITE_ENSURE_STATUS(CheckTensorFloat32Type(
             logging_context, input1_tensor, input1_id, node_index));
         TF_LITE_ENSURE_STATUS(CheckTensorFloat32Type(
@@ -4174,8 +4314,11 @@ class Subgraph {
             logging_context, output_tensor, output_id, node_index));
         break;
       case BuiltinOperator_DEQUANTIZE:
-        TF_LITE_ENSURE_STATUS(CheckTensorQInt8OrQUInt8Type(
-            delegate, logging_context, input_tensor, input_id, node_index));
+        // FP16 activations are converted to FP32 inside of the partition.
+        if (input_tensor.type != kTfLiteFloat16) {
+          TF_LITE_ENSURE_STATUS(CheckTensorQInt8OrQUInt8Type(
+              delegate, logging_context, input_tensor, input_id, node_index));
+        }
         TF_LITE_ENSURE_STATUS(CheckTensorFloat32Type(
             logging_context, output_tensor, output_id, node_index));
         break;
@@ -5865,6 +6008,52 @@ class Subgraph {
                                  input_output_tensors);
   }
 
+  // Transposes the key or value `tensor` of an attention node to an FP32
+  // value. INT8 tensors are transposed first and converted to FP32 after.
+  static TfLiteStatus DefineAttentionTranspose(
+      xnn_subgraph_t subgraph, TfLiteContext* logging_context,
+      const TfLiteTensor& tensor, const std::array<size_t, 4>& perm,
+      uint32_t input_id, uint32_t* output_id) {
+    uint32_t transpose_out_id = XNN_INVALID_VALUE_ID;
+    if (tensor.type == kTfLiteInt8) {
+      const TfLiteAffineQuantization* quantization_params =
+          static_cast<const TfLiteAffineQuantization*>(
+              tensor.quantization.params);
+      TF_LITE_ENSURE_EQ(
+          logging_context, xnn_status_success,
+          xnn_define_quantized_tensor_value(
+              subgraph, xnn_datatype_qint8,
+              quantization_params->zero_point->data[0],
+              quantization_params->scale->data[0], /*num_dims=*/0,
+              /*dims=*/nullptr, /*data=*/nullptr, XNN_INVALID_VALUE_ID,
+              /*flags=*/0, &transpose_out_id));
+    } else {
+      TF_LITE_ENSURE_EQ(
+          logging_context, xnn_status_success,
+          xnn_define_tensor_value(subgraph, xnn_datatype_fp32, /*num_dims=*/0,
+                                  /*dims=*/nullptr, nullptr,
+                                  XNN_INVALID_VALUE_ID, 0, &transpose_out_id));
+    }
+    TF_LITE_ENSURE_EQ(
+        logging_context, xnn_status_success,
+        xnn_define_static_transpose(subgraph, perm.size(), perm.data(),
+                                    input_id, transpose_out_id, /*flags=*/0));
+    if (tensor.type != kTfLiteInt8) {
+      *output_id = transpose_out_id;
+      return kTfLiteOk;
+    }
+    TF_LITE_ENSURE_EQ(
+        logging_context, xnn_status_success,
+        xnn_define_tensor_value(subgraph, xnn_datatype_fp32, /*num_dims=*/0,
+                                /*dims=*/nullptr, nullptr,
+                                XNN_INVALID_VALUE_ID, 0, output_id));
+    TF_LITE_ENSURE_EQ(
+        logging_context, xnn_status_success,
+        xnn_define_unary(subgraph, xnn_unary_convert, /*params=*/nullptr,
+                         transpose_out_id, *output_id, /*flags=*/0));
+    return kTfLiteOk;
+  }
+
   static TfLiteStatus VisitDotAttentionNode(
       xnn_subgraph_t subgraph, const Delegate& delegate,
       TfLiteContext* logging_context, int node_index, TfLiteNode* node,
@@ -5875,13 +6064,17 @@ class Subgraph {
     TF_LITE_ENSURE_STATUS(CheckTensorFloat32Type(
         logging_context, query_proj, node->inputs->data[0], node_index));
 
+    // The KV cache may be kept in INT8, it is only dequantized after it is
+    // transposed, so that the cache is read in its quantized form.
     const TfLiteTensor& key_proj = tensors[node->inputs->data[1]];
-    TF_LITE_ENSURE_STATUS(CheckTensorFloat32Type(
-        logging_context, key_proj, node->inputs->data[1], node_index));
+    TF_LITE_ENSURE_STATUS(CheckTensorFloat32OrQInt8Type(
+        delegate, logging_context, key_proj, node->inputs->data[1],
+        node_index));
 
     const TfLiteTensor& value_proj = tensors[node->inputs->data[2]];
-    TF_LITE_ENSURE_STATUS(CheckTensorFloat32Type(
-        logging_context, value_proj, node->inputs->data[2], node_index));
+    TF_LITE_ENSURE_STATUS(CheckTensorFloat32OrQInt8Type(
+        delegate, logging_context, value_proj, node->inputs->data[2],
+        node_index));
 
     const TfLiteTensor* atten_mask = nullptr;
     if (node->inputs->size > 3) {
@@ -5988,15 +6181,9 @@ class Subgraph {
       std::array<size_t, 4> permute_k = {0, 2, 1, 3};
       TF_LITE_ENSURE_EQ(logging_context, key_proj.dims->size, permute_k.size());
       uint32_t permute_k_out_id = XNN_INVALID_VALUE_ID;
-      TF_LITE_ENSURE_EQ(
-          logging_context, xnn_status_success,
-          xnn_define_tensor_value(subgraph, xnn_datatype_fp32, /*num_dims=*/0,
-                                  /*dims=*/nullptr, nullptr,
-                                  XNN_INVALID_VALUE_ID, 0, &permute_k_out_id));
-      TF_LITE_ENSURE_EQ(logging_context, xnn_status_success,
-                        xnn_define_static_transpose(
-                            subgraph, permute_k.size(), permute_k.data(),
-                            key_proj_id, permute_k_out_id, /*flags=*/0));
+      TF_LITE_ENSURE_STATUS(DefineAttentionTranspose(
+          subgraph, logging_context, key_proj, permute_k, key_proj_id,
+          &permute_k_out_id));
       // einsum(BNTH.BNSH -> BNTS)
       uint32_t fc_out_id = XNN_INVALID_VALUE_ID;
       if (!is_mqa) {
@@ -6170,15 +6357,9 @@ class Subgraph {
       TF_LITE_ENSURE_EQ(logging_context, value_proj.dims->size,
                         permute_v.size());
       uint32_t permute_v_out_id = XNN_INVALID_VALUE_ID;
-      TF_LITE_ENSURE_EQ(
-          logging_context, xnn_status_success,
-          xnn_define_tensor_value(subgraph, xnn_datatype_fp32, /*num_dims=*/0,
-                                  /*dims=*/nullptr, nullptr,
-                                  XNN_INVALID_VALUE_ID, 0, &permute_v_out_id));
-      TF_LITE_ENSURE_EQ(logging_context, xnn_status_success,
-                        xnn_define_static_transpose(
-                            subgraph, permute_v.size(), permute_v.data(),
-                            value_proj_id, permute_v_out_id, /*flags=*/0));
+      TF_LITE_ENSURE_STATUS(DefineAttentionTranspose(
+          subgraph, logging_context, value_proj, permute_v, value_proj_id,
+          &permute_v_out_id));
       // Outcome
       // BNTS.BNHS -> BNTH
       uint32_t fc2_out_id = XNN_INVALID_VALUE_ID;
@@ -6598,11 +6779,15 @@ class Subgraph {
   inline Delegate* GetDelegate() const { return delegate_; }
 
  private:
-  Subgraph(Delegate& delegate, xnn_runtime_t runtime,
-           const std::unordered_set<int>& externals, std::vector<int> inputs,
-           std::vector<int> outputs,
+  // Takes ownership of `subgraph` if `runtime` is null, which is then created
+  // from it when it is first needed.
+  Subgraph(Delegate& delegate, xnn_runtime_t runtime, xnn_subgraph_t subgraph,
+           bool has_sparse_weights, const std::unordered_set<int>& externals,
+           std::vector<int> inputs, std::vector<int> outputs,
            std::unordered_map<int, uint32_t> tflite_tensor_to_xnnpack)
-      : runtime_(runtime, &xnn_delete_runtime) {
+      : runtime_(runtime, &xnn_delete_runtime),
+        subgraph_(subgraph, &xnn_delete_subgraph),
+        has_sparse_weights_(has_sparse_weights) {
     for (int t : externals) {
       externals_[t] = nullptr;
     }
@@ -6618,6 +6803,10 @@ class Subgraph {
   // management.
   std::unique_ptr<xnn_runtime, decltype(&xnn_delete_runtime)> runtime_{
       nullptr, &xnn_delete_runtime};
+  // XNNPACK subgraph the runtime is created from, until it is created.
+  std::unique_ptr<xnn_subgraph, decltype(&xnn_delete_subgraph)> subgraph_{
+      nullptr, &xnn_delete_subgraph};
+  bool has_sparse_weights_ = false;
   // Mapping from TFLite Tensor IDs for input/output tensors in the delegated
   // subgraph to their data locations.
   std::unordered_map<int, void*> externals_;
@@ -6632,10 +6821,18 @@ class Subgraph {
   std::unordered_map<int, uint32_t> tflite_tensor_to_xnnpack_;
   // Mapping from tensors to a "resource" ID.
   std::unordered_map<int, ResourceInfo> resources_;
+  // The variables of the resource tensors in `externals_`, once they are
+  // looked up.
+  std::unordered_map<int, tflite::resource::ResourceVariable*> variables_;
   // Memory location to use for 0-size external tensors, as TFLite init their
   // data pointer to nullptr, and XNNPACK requires valid data pointers.
   char dummy_data_{0};
   bool enable_subgraph_reshaping_ = false;
+  // Set once the runtime is reshaped to `reshaped_input_dims_`, which are the
+  // dimensions of `inputs_`. Preparing the node again with the same input
+  // shapes keeps the runtime and its external value bindings as they are.
+  bool reshaped_ = false;
+  std::vector<std::vector<int>> reshaped_input_dims_;
   Delegate* delegate_;
 };
 
@@ -7177,6 +7374,10 @@ TfLiteStatus DelegatePrepare(TfLiteContext* context, TfLiteDelegate* delegate) {
 }  // namespace xnnpack
 }  // namespace tflite
 
+struct TfLiteXNNPackDelegateWorkspace {
+  std::shared_ptr<::tflite::xnnpack::Workspace> workspace;
+};
+
 TfLiteXNNPackDelegateWeightsCache* TfLiteXNNPackDelegateWeightsCacheCreate() {
   xnn_status status = xnn_initialize(/*allocator=*/nullptr);
   if (status != xnn_status_success) {
@@ -7230,6 +7431,25 @@ void TfLiteXNNPackDelegateWeightsCacheDelete(
   xnn_delete_weights_cache(weights_cache);
 }
 
+TfLiteXNNPackDelegateWorkspace* TfLiteXNNPackDelegateWorkspaceCreate() {
+  xnn_status status = xnn_initialize(/*allocator=*/nullptr);
+  if (status != xnn_status_success) {
+    return nullptr;
+  }
+
+  std::shared_ptr<::tflite::xnnpack::Workspace> workspace =
+      ::tflite::xnnpack::CreateWorkspace();
+  if (workspace == nullptr) {
+    return nullptr;
+  }
+  return new TfLiteXNNPackDelegateWorkspace{std::move(workspace)};
+}
+
+void TfLiteXNNPackDelegateWorkspaceDelete(
+    TfLiteXNNPackDelegateWorkspace* workspace) {
+  delete workspace;
+}
+
 bool TfLiteXNNPackDelegateCanUseInMemoryWeightCacheProvider() {
   return tflite::xnnpack::InMemoryFileDescriptorAvailable();
 }
@@ -7279,13 +7499,16 @@ TfLiteDelegate* TfLiteXNNPackDelegateCreateWithThreadpool(
     return nullptr;
   }
 
-  xnn_workspace_t workspace = nullptr;
-  if (xnn_create_workspace(&workspace) != xnn_status_success) {
+  std::shared_ptr<::tflite::xnnpack::Workspace> workspace =
+      options != nullptr && options->workspace != nullptr
+          ? options->workspace->workspace
+          : ::tflite::xnnpack::CreateWorkspace();
+  if (workspace == nullptr) {
     return nullptr;
   }
 
   auto* xnnpack_delegate =
-      new ::tflite::xnnpack::Delegate(options, workspace, context);
+      new ::tflite::xnnpack::Delegate(options, std::move(workspace), context);
   return xnnpack_delegate ? xnnpack_delegate->tflite_delegate() : nullptr;
 }
 
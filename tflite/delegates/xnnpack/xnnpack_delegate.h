@@ -59,8 +59,16 @@ extern "C" {
 // Disable delegation of dynamically quantized ops.
 #define TFLITE_XNNPACK_DELEGATE_FLAG_DISABLE_DYNAMICALLY_QUANTIZED_OPS \
   0x00000800
+// Defer the creation of the XNNPack runtime of each delegated partition until
+// it is first needed, i.e. when the partition is first invoked, or prepared
+// with subgraph reshaping enabled. This reduces the initialization time and
+// memory of models with many partitions or signatures that are not all used.
+// It is ignored when a weights cache or a weight cache file is used, since
+// the weights are packed when the runtime is created.
+#define TFLITE_XNNPACK_DELEGATE_FLAG_DEFER_RUNTIME_CREATION 0x00001000
 
 struct TfLiteXNNPackDelegateWeightsCache;
+struct TfLiteXNNPackDelegateWorkspace;
 
 typedef struct {
   // Number of threads to use in the thread pool.
@@ -80,6 +88,7 @@ typedef struct {
   // - TFLITE_XNNPACK_DELEGATE_FLAG_DISABLE_DYNAMICALLY_QUANTIZED_OPS
   // - TFLITE_XNNPACK_DELEGATE_FLAG_DISABLE_SUBGRAPH_RESHAPING
   // - TFLITE_XNNPACK_DELEGATE_FLAG_SLOW_CONSISTENT_ARITHMETIC
+  // - TFLITE_XNNPACK_DELEGATE_FLAG_DEFER_RUNTIME_CREATION
   uint32_t flags;
   // Cache for packed weights, can be shared between multiple instances of
   // delegates.
@@ -121,6 +130,12 @@ typedef struct {
   // the weight cache will only be loaded from this if `weights_cache` is
   // undefined.
   void* weight_cache_provider;
+  // Scratch memory for the XNNPack runtimes, can be shared between multiple
+  // instances of delegates. When undefined, each delegate instance creates
+  // its own, shared by all the partitions it delegates.
+  //
+  // Note: The runtimes using the same workspace are invoked one at a time.
+  struct TfLiteXNNPackDelegateWorkspace* workspace;
 } TfLiteXNNPackDelegateOptions;
 
 // Returns true on systems that support running the in-memory weight cache
@@ -207,6 +222,17 @@ TFL_CAPI_EXPORT bool TfLiteXNNPackDelegateWeightsCacheFinalizeHard(
 TFL_CAPI_EXPORT void TfLiteXNNPackDelegateWeightsCacheDelete(
     struct TfLiteXNNPackDelegateWeightsCache* cache);
 
+// Creates a new workspace that can be shared with multiple delegate instances.
+// Returns NULL on error.
+TFL_CAPI_EXPORT struct TfLiteXNNPackDelegateWorkspace*
+TfLiteXNNPackDelegateWorkspaceCreate();
+
+// Destroys a workspace created with `TfLiteXNNPackDelegateWorkspaceCreate`
+// call. The delegate instances using it keep it alive until they are
+// destroyed.
+TFL_CAPI_EXPORT void TfLiteXNNPackDelegateWorkspaceDelete(
+    struct TfLiteXNNPackDelegateWorkspace* workspace);
+
 #ifdef __cplusplus
 }
 #endif  // __cplusplus
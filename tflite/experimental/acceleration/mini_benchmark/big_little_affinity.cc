@@ -99,6 +99,9 @@ BigLittleAffinity GetAffinity() {
       affinity.little_core_affinity |= (0x1 << processor->linux_id);
     } else {
       affinity.big_core_affinity |= (0x1 << processor->linux_id);
+      if (max_frequency == largest_max_frequency) {
+        affinity.prime_core_affinity |= (0x1 << processor->linux_id);
+      }
     }
 #endif  // __ANDROID__
   }
@@ -116,6 +119,10 @@ BigLittleAffinity GetAffinity() {
     affinity.big_core_affinity = affinity.little_core_affinity =
         std::max(affinity.big_core_affinity, affinity.little_core_affinity);
   }
+  if (affinity.prime_core_affinity == 0 ||
+      affinity.big_core_affinity == affinity.little_core_affinity) {
+    affinity.prime_core_affinity = affinity.big_core_affinity;
+  }
   return affinity;
 }
 
@@ -23,6 +23,10 @@ namespace acceleration {
 struct BigLittleAffinity {
   uint16_t big_core_affinity = 0;
   uint16_t little_core_affinity = 0;
+  // The big cores with the largest max frequency, e.g. the single prime core
+  // of 1+3+4 CPUs. The same as `big_core_affinity` if all the big cores have
+  // the same max frequency.
+  uint16_t prime_core_affinity = 0;
 };
 
 BigLittleAffinity GetAffinity();
@@ -58,10 +58,14 @@ TEST(BigLittle, CheckBasics) {
   BigLittleAffinity affinity = GetAffinity();
   EXPECT_GT(affinity.little_core_affinity, 0);
   EXPECT_GT(affinity.big_core_affinity, 0);
+  EXPECT_GT(affinity.prime_core_affinity, 0);
+  EXPECT_EQ(affinity.prime_core_affinity & ~affinity.big_core_affinity, 0);
   std::cout << "Little core affinity: " << std::hex
             << affinity.little_core_affinity << std::endl;
   std::cout << "Big core affinity: " << std::hex << affinity.big_core_affinity
             << std::endl;
+  std::cout << "Prime core affinity: " << std::hex
+            << affinity.prime_core_affinity << std::endl;
 #endif
 }
 
@@ -28,6 +28,8 @@ extern "C" void GenAIOpsRegisterer(::tflite::MutableOpResolver* resolver) {
                       tflite::ops::custom::Register_SDPA());
   resolver->AddCustom("odml.update_external_kv_cache",
                       tflite::ops::custom::Register_EXTERNAL_KV_CACHE());
+  resolver->AddCustom("odml.sample_top_k_top_p",
+                      tflite::ops::custom::Register_SAMPLING());
 }
 
 }  // namespace custom
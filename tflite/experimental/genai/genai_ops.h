@@ -26,6 +26,7 @@ namespace custom {
 TfLiteRegistration* Register_KV_CACHE();
 TfLiteRegistration* Register_EXTERNAL_KV_CACHE();
 TfLiteRegistration* Register_SDPA();
+TfLiteRegistration* Register_SAMPLING();
 
 extern "C" void GenAIOpsRegisterer(::tflite::MutableOpResolver* resolver);
 
@@ -0,0 +1,204 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/experimental/genai/kv_cache_snapshot.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tflite/c/common.h"
+#include "tflite/minimal_logging.h"
+#include "tflite/util.h"
+
+namespace tflite {
+namespace ops {
+namespace custom {
+namespace llm {
+namespace {
+
+constexpr uint32_t kSnapshotMagic = 0x5343564b;  // "KVCS"
+constexpr uint32_t kSnapshotVersion = 1;
+
+struct SnapshotHeader {
+  uint32_t magic;
+  uint32_t version;
+  int32_t num_layers;
+  int32_t cache_size;
+  int32_t elements_in_one_entry;
+  int32_t num_entries;
+};
+
+// The header is padded to one alignment unit so that the caches after it are
+// aligned like tensor buffers.
+static_assert(sizeof(SnapshotHeader) <= kDefaultTensorAlignment,
+              "The snapshot header must fit in one alignment unit");
+
+size_t GetCacheBytes(int cache_size, int elements_in_one_entry) {
+  return sizeof(float) * static_cast<size_t>(cache_size) *
+         static_cast<size_t>(elements_in_one_entry);
+}
+
+// The distance between the caches in the file, in which the key and value
+// caches of layer i are the caches 2 * i and 2 * i + 1.
+size_t GetCacheStride(int cache_size, int elements_in_one_entry) {
+  const size_t bytes = GetCacheBytes(cache_size, elements_in_one_entry);
+  return (bytes + kDefaultTensorAlignment - 1) / kDefaultTensorAlignment *
+         kDefaultTensorAlignment;
+}
+
+size_t GetSnapshotBytes(int num_layers, int cache_size,
+                        int elements_in_one_entry) {
+  return kDefaultTensorAlignment +
+         2 * static_cast<size_t>(num_layers) *
+             GetCacheStride(cache_size, elements_in_one_entry);
+}
+
+bool WriteAt(int fd, const void* data, size_t size, off_t offset) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  while (size > 0) {
+    const ssize_t written = pwrite(fd, bytes, size, offset);
+    if (written <= 0) {
+      return false;
+    }
+    bytes += written;
+    size -= written;
+    offset += written;
+  }
+  return true;
+}
+
+}  // namespace
+
+TfLiteStatus SaveKVCacheSnapshot(const char* path,
+                                 const std::vector<KVCacheLayer>& layers,
+                                 int cache_size, int elements_in_one_entry,
+                                 int num_entries) {
+  if (cache_size <= 0 || elements_in_one_entry <= 0 || num_entries < 0 ||
+      num_entries > cache_size) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR,
+                    "Invalid KV cache snapshot of %d entries of %d elements "
+                    "in a cache of %d entries.",
+                    num_entries, elements_in_one_entry, cache_size);
+    return kTfLiteError;
+  }
+  for (const KVCacheLayer& layer : layers) {
+    if (layer.key == nullptr || layer.value == nullptr) {
+      TFLITE_LOG_PROD(TFLITE_LOG_ERROR, "KV cache snapshot layer is null.");
+      return kTfLiteError;
+    }
+  }
+  const int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR, "Can not create KV cache snapshot %s.",
+                    path);
+    return kTfLiteError;
+  }
+  const int num_layers = static_cast<int>(layers.size());
+  SnapshotHeader header;
+  header.magic = kSnapshotMagic;
+  header.version = kSnapshotVersion;
+  header.num_layers = num_layers;
+  header.cache_size = cache_size;
+  header.elements_in_one_entry = elements_in_one_entry;
+  header.num_entries = num_entries;
+  const size_t stride = GetCacheStride(cache_size, elements_in_one_entry);
+  const size_t used_bytes = GetCacheBytes(num_entries, elements_in_one_entry);
+  bool ok = WriteAt(fd, &header, sizeof(header), 0);
+  for (int i = 0; ok && i < num_layers; ++i) {
+    const size_t key_offset = kDefaultTensorAlignment + 2 * i * stride;
+    ok = WriteAt(fd, layers[i].key, used_bytes, key_offset) &&
+         WriteAt(fd, layers[i].value, used_bytes, key_offset + stride);
+  }
+  // Extending the file leaves the unused entries of the caches as holes.
+  ok = ok && ftruncate(fd, GetSnapshotBytes(num_layers, cache_size,
+                                            elements_in_one_entry)) == 0;
+  ok = close(fd) == 0 && ok;
+  if (!ok) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR, "Can not write KV cache snapshot %s.",
+                    path);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+std::unique_ptr<KVCacheSnapshot> KVCacheSnapshot::Load(const char* path) {
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR, "Can not open KV cache snapshot %s.",
+                    path);
+    return nullptr;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 ||
+      file_stat.st_size < static_cast<off_t>(kDefaultTensorAlignment)) {
+    close(fd);
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR, "Invalid KV cache snapshot %s.", path);
+    return nullptr;
+  }
+  const size_t size = file_stat.st_size;
+  // A private writable mapping lets the kvcache op keep decoding in place
+  // without changing the file.
+  void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR, "Can not map KV cache snapshot %s.",
+                    path);
+    return nullptr;
+  }
+  const SnapshotHeader* header = static_cast<const SnapshotHeader*>(data);
+  if (header->magic != kSnapshotMagic || header->version != kSnapshotVersion ||
+      header->num_layers < 0 || header->cache_size <= 0 ||
+      header->elements_in_one_entry <= 0 || header->num_entries < 0 ||
+      header->num_entries > header->cache_size ||
+      size != GetSnapshotBytes(header->num_layers, header->cache_size,
+                               header->elements_in_one_entry)) {
+    munmap(data, size);
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR, "Invalid KV cache snapshot %s.", path);
+    return nullptr;
+  }
+  return std::unique_ptr<KVCacheSnapshot>(new KVCacheSnapshot(
+      static_cast<uint8_t*>(data), size, header->num_layers,
+      header->cache_size, header->elements_in_one_entry,
+      header->num_entries));
+}
+
+KVCacheSnapshot::~KVCacheSnapshot() { munmap(data_, size_); }
+
+float* KVCacheSnapshot::key_cache(int layer) const {
+  const size_t stride = GetCacheStride(cache_size_, elements_in_one_entry_);
+  return reinterpret_cast<float*>(data_ + kDefaultTensorAlignment +
+                                  2 * layer * stride);
+}
+
+float* KVCacheSnapshot::value_cache(int layer) const {
+  const size_t stride = GetCacheStride(cache_size_, elements_in_one_entry_);
+  return reinterpret_cast<float*>(data_ + kDefaultTensorAlignment +
+                                  (2 * layer + 1) * stride);
+}
+
+size_t KVCacheSnapshot::cache_bytes() const {
+  return GetCacheBytes(cache_size_, elements_in_one_entry_);
+}
+
+}  // namespace llm
+}  // namespace custom
+}  // namespace ops
+}  // namespace tflite
@@ -0,0 +1,98 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_GENAI_KV_CACHE_SNAPSHOT_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_GENAI_KV_CACHE_SNAPSHOT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tflite/c/common.h"
+
+namespace tflite {
+namespace ops {
+namespace custom {
+namespace llm {
+
+/// WARNING: Experimental interface, subject to change.
+// The key and value caches of one transformer layer as used by the external
+// kvcache op. Both have shape (1, cache_size, num_heads, head_dim).
+struct KVCacheLayer {
+  const float* key;
+  const float* value;
+};
+
+// Writes the first `num_entries` entries of the key and value caches of
+// `layers` to the file at `path`, e.g. after the prefill of a system prompt.
+// The caches of each layer keep their full `cache_size` span in the file, but
+// the entries past `num_entries` are left as holes that take no disk space.
+TfLiteStatus SaveKVCacheSnapshot(const char* path,
+                                 const std::vector<KVCacheLayer>& layers,
+                                 int cache_size, int elements_in_one_entry,
+                                 int num_entries);
+
+// A KV cache snapshot file mapped in memory. The caches it returns can be set
+// as the custom allocations of the cache inputs and outputs of the external
+// kvcache op, so a session resumes at position `num_entries()` without a copy
+// or a prefill. The mapping is private: the op writes the next entries into
+// copy-on-write pages, and the file keeps the snapshot.
+class KVCacheSnapshot {
+ public:
+  // Maps the snapshot written by `SaveKVCacheSnapshot` at `path`. Returns
+  // nullptr if the file can not be mapped or is not a valid snapshot.
+  static std::unique_ptr<KVCacheSnapshot> Load(const char* path);
+
+  KVCacheSnapshot(const KVCacheSnapshot&) = delete;
+  KVCacheSnapshot& operator=(const KVCacheSnapshot&) = delete;
+  ~KVCacheSnapshot();
+
+  int num_layers() const { return num_layers_; }
+  int cache_size() const { return cache_size_; }
+  int elements_in_one_entry() const { return elements_in_one_entry_; }
+  // The number of entries of each layer written in the snapshot, i.e. the
+  // position the next entry goes to.
+  int num_entries() const { return num_entries_; }
+
+  // The caches of a layer, of `cache_bytes()` bytes each and aligned to
+  // kDefaultTensorAlignment.
+  float* key_cache(int layer) const;
+  float* value_cache(int layer) const;
+  size_t cache_bytes() const;
+
+ private:
+  KVCacheSnapshot(uint8_t* data, size_t size, int num_layers, int cache_size,
+                  int elements_in_one_entry, int num_entries)
+      : data_(data),
+        size_(size),
+        num_layers_(num_layers),
+        cache_size_(cache_size),
+        elements_in_one_entry_(elements_in_one_entry),
+        num_entries_(num_entries) {}
+
+  uint8_t* data_;
+  size_t size_;
+  int num_layers_;
+  int cache_size_;
+  int elements_in_one_entry_;
+  int num_entries_;
+};
+
+}  // namespace llm
+}  // namespace custom
+}  // namespace ops
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_GENAI_KV_CACHE_SNAPSHOT_H_
@@ -0,0 +1,135 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/experimental/genai/kv_cache_snapshot.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/c/common.h"
+#include "tflite/util.h"
+
+namespace tflite {
+namespace ops {
+namespace custom {
+namespace llm {
+namespace {
+
+constexpr int kNumLayers = 2;
+constexpr int kCacheSize = 16;
+constexpr int kElementsInOneEntry = 6;
+constexpr int kNumEntries = 5;
+
+std::string GetSnapshotPath(const std::string& name) {
+  return ::testing::TempDir() + "/" + name;
+}
+
+std::vector<float> MakeCache(float start) {
+  std::vector<float> cache(kCacheSize * kElementsInOneEntry);
+  for (size_t i = 0; i < cache.size(); ++i) {
+    cache[i] = start + i;
+  }
+  return cache;
+}
+
+TEST(KVCacheSnapshotTest, RestoresWrittenEntries) {
+  std::vector<std::vector<float>> caches;
+  std::vector<KVCacheLayer> layers;
+  for (int i = 0; i < 2 * kNumLayers; ++i) {
+    caches.push_back(MakeCache(1000.0f * (i + 1)));
+  }
+  for (int i = 0; i < kNumLayers; ++i) {
+    layers.push_back({caches[2 * i].data(), caches[2 * i + 1].data()});
+  }
+  const std::string path = GetSnapshotPath("restores_written_entries");
+  ASSERT_EQ(SaveKVCacheSnapshot(path.c_str(), layers, kCacheSize,
+                                kElementsInOneEntry, kNumEntries),
+            kTfLiteOk);
+
+  std::unique_ptr<KVCacheSnapshot> snapshot =
+      KVCacheSnapshot::Load(path.c_str());
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_EQ(snapshot->num_layers(), kNumLayers);
+  EXPECT_EQ(snapshot->cache_size(), kCacheSize);
+  EXPECT_EQ(snapshot->elements_in_one_entry(), kElementsInOneEntry);
+  EXPECT_EQ(snapshot->num_entries(), kNumEntries);
+  EXPECT_EQ(snapshot->cache_bytes(),
+            sizeof(float) * kCacheSize * kElementsInOneEntry);
+  for (int i = 0; i < kNumLayers; ++i) {
+    const float* key = snapshot->key_cache(i);
+    const float* value = snapshot->value_cache(i);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(key) % kDefaultTensorAlignment, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(value) % kDefaultTensorAlignment,
+              0);
+    for (int j = 0; j < kCacheSize * kElementsInOneEntry; ++j) {
+      const bool written = j < kNumEntries * kElementsInOneEntry;
+      EXPECT_EQ(key[j], written ? caches[2 * i][j] : 0.0f) << j;
+      EXPECT_EQ(value[j], written ? caches[2 * i + 1][j] : 0.0f) << j;
+    }
+  }
+  std::remove(path.c_str());
+}
+
+TEST(KVCacheSnapshotTest, WritesToTheMappingKeepTheFile) {
+  std::vector<float> key = MakeCache(1.0f);
+  std::vector<float> value = MakeCache(2.0f);
+  const std::string path = GetSnapshotPath("writes_keep_the_file");
+  ASSERT_EQ(SaveKVCacheSnapshot(path.c_str(), {{key.data(), value.data()}},
+                                kCacheSize, kElementsInOneEntry, kNumEntries),
+            kTfLiteOk);
+
+  {
+    std::unique_ptr<KVCacheSnapshot> snapshot =
+        KVCacheSnapshot::Load(path.c_str());
+    ASSERT_NE(snapshot, nullptr);
+    snapshot->key_cache(0)[0] = -1.0f;
+    snapshot->value_cache(0)[kNumEntries * kElementsInOneEntry] = -1.0f;
+  }
+  std::unique_ptr<KVCacheSnapshot> snapshot =
+      KVCacheSnapshot::Load(path.c_str());
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_EQ(snapshot->key_cache(0)[0], key[0]);
+  EXPECT_EQ(snapshot->value_cache(0)[kNumEntries * kElementsInOneEntry], 0.0f);
+  std::remove(path.c_str());
+}
+
+TEST(KVCacheSnapshotTest, RejectsInvalidFiles) {
+  const std::string path = GetSnapshotPath("invalid");
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  const std::vector<uint8_t> garbage(256, 0xab);
+  std::fwrite(garbage.data(), 1, garbage.size(), file);
+  std::fclose(file);
+  EXPECT_EQ(KVCacheSnapshot::Load(path.c_str()), nullptr);
+  std::remove(path.c_str());
+
+  EXPECT_EQ(KVCacheSnapshot::Load(path.c_str()), nullptr);
+
+  std::vector<float> key = MakeCache(1.0f);
+  EXPECT_EQ(SaveKVCacheSnapshot(path.c_str(), {{key.data(), key.data()}},
+                                kCacheSize, kElementsInOneEntry,
+                                kCacheSize + 1),
+            kTfLiteError);
+}
+
+}  // namespace
+}  // namespace llm
+}  // namespace custom
+}  // namespace ops
+}  // namespace tflite
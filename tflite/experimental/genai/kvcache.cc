@@ -17,6 +17,7 @@ limitations under the License.
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <vector>
 
 #include "flatbuffers/flexbuffers.h"
 #include "tflite/core/c/common.h"
@@ -49,7 +50,10 @@ struct OpData {
   int num_layers;
   int layer_index;
   int max_num_entries;
-  int first_slot_index;
+  // The first position held by the cache of each sequence in the batch.
+  std::vector<int64_t> first_slot_indices;
+  // The number of entries in the cache of each sequence in the batch.
+  std::vector<int64_t> num_entries;
   // Pointers to the key and value cache buffers that this Op doesn't own
   // (and therefore does not free on destruction of this Op).
   resource::CacheBuffer* key_cache_buffer;
@@ -66,7 +70,6 @@ void* KVCacheInit(TfLiteContext* context, const char* buffer, size_t length) {
   op_data->max_num_entries = -1;
   op_data->num_layers = -1;
   op_data->layer_index = -1;
-  op_data->first_slot_index = -1;
   op_data->key_cache_buffer = nullptr;
   op_data->value_cache_buffer = nullptr;
   op_data->is_initialized = false;
@@ -95,7 +98,6 @@ TfLiteStatus KVCachePrepare(TfLiteContext* context, TfLiteNode* node) {
         num_layers > 0 ? num_layers : kDefaultNumTransformerLayers;
     op_data->layer_index =
         layer_index > 0 ? layer_index : kDefaultTransformerLayerId;
-    op_data->first_slot_index = 0;
     op_data->is_initialized = true;
   }
 
@@ -111,15 +113,22 @@ TfLiteStatus KVCachePrepare(TfLiteContext* context, TfLiteNode* node) {
   TF_LITE_ENSURE_EQ(context, position->type, kTfLiteInt64);
   TF_LITE_ENSURE_EQ(context, key->type, kTfLiteFloat32);
   TF_LITE_ENSURE_EQ(context, value->type, kTfLiteFloat32);
-  // Ensure Positions correspond to KV sequence length.
-  TF_LITE_ENSURE(context, NumDimensions(position) == 1);
-  TF_LITE_ENSURE(
-      context, GetTensorShape(position).Dims(0) == GetTensorShape(key).Dims(1));
   // Support only (B, S, N, H) for now.
   TF_LITE_ENSURE(context, NumDimensions(key) == kRequiredNumDimensions);
-  // Enforce Batch == 1 for now.
-  TF_LITE_ENSURE(context, GetTensorShape(key).Dims(0) == 1);
   TF_LITE_ENSURE(context, HaveSameShapes(key, value));
+  // Ensure Positions correspond to KV sequence length. They are either shared
+  // by all the sequences, (S), or given per sequence, (B, S).
+  const int position_rank = NumDimensions(position);
+  TF_LITE_ENSURE(context, position_rank == 1 || position_rank == 2);
+  TF_LITE_ENSURE(context, GetTensorShape(position).Dims(position_rank - 1) ==
+                              GetTensorShape(key).Dims(1));
+  const int batch_size = GetTensorShape(key).Dims(0);
+  if (position_rank == 2) {
+    TF_LITE_ENSURE(context, GetTensorShape(position).Dims(0) == batch_size);
+  }
+  // Sequences joining the batch start with an empty cache.
+  op_data->first_slot_indices.resize(batch_size, 0);
+  op_data->num_entries.resize(batch_size, 0);
 
   // Create the key and value caches. Currently statically sized.
   TfLiteTensor* kfull;
@@ -142,12 +151,13 @@ TfLiteStatus KVCachePrepare(TfLiteContext* context, TfLiteNode* node) {
   vcache_dims->data[1] = op_data->max_num_entries;
 
   TfLiteIntArray* kcache_buffer_dims = TfLiteIntArrayCreate(5);
-  // Batch
-  kcache_buffer_dims->data[0] = input_dims->data[0];
+  // Batch. The sequences of a layer are stored one after the other instead,
+  // so that the cache of a layer is a single (B, max_num_entries, N, H) tensor.
+  kcache_buffer_dims->data[0] = 1;
   // Number of layers
   kcache_buffer_dims->data[1] = op_data->num_layers;
   // Sequence Length
-  kcache_buffer_dims->data[2] = op_data->max_num_entries;
+  kcache_buffer_dims->data[2] = batch_size * op_data->max_num_entries;
   // Num heads
   kcache_buffer_dims->data[3] = input_dims->data[2];
   // Head dim
@@ -168,6 +178,9 @@ TfLiteStatus KVCachePrepare(TfLiteContext* context, TfLiteNode* node) {
     resource::ResourceBase* resourcePtr =
         resources.at(KVCACHE_KEY_RESOURCE).get();
     resource::CacheBuffer* cbuffer = (resource::CacheBuffer*)(resourcePtr);
+    TF_LITE_ENSURE_EQ(
+        context, cbuffer->GetSize(),
+        sizeof(float) * static_cast<size_t>(NumElements(kcache_buffer_dims)));
     op_data->key_cache_buffer = cbuffer;
   }
   if (resources.count(KVCACHE_VALUE_RESOURCE) == 0) {
@@ -179,6 +192,9 @@ TfLiteStatus KVCachePrepare(TfLiteContext* context, TfLiteNode* node) {
     resource::ResourceBase* resourcePtr =
         resources.at(KVCACHE_VALUE_RESOURCE).get();
     resource::CacheBuffer* cbuffer = (resource::CacheBuffer*)(resourcePtr);
+    TF_LITE_ENSURE_EQ(
+        context, cbuffer->GetSize(),
+        sizeof(float) * static_cast<size_t>(NumElements(vcache_buffer_dims)));
     op_data->value_cache_buffer = cbuffer;
   }
 
@@ -186,7 +202,7 @@ TfLiteStatus KVCachePrepare(TfLiteContext* context, TfLiteNode* node) {
   RuntimeShape shape(GetTensorShape(key));
   const int elements_in_one_entry = shape.Dims(2) * shape.Dims(3);
   const int elements_in_one_block =
-      op_data->max_num_entries * elements_in_one_entry;
+      batch_size * op_data->max_num_entries * elements_in_one_entry;
   uint8_t* k_ptr =
       reinterpret_cast<uint8_t*>(op_data->key_cache_buffer->GetBuffer());
   uint8_t* v_ptr =
@@ -227,6 +243,83 @@ void KVCacheFree(TfLiteContext* context, void* buffer) {
   delete static_cast<OpData*>(buffer);
 }
 
+// Writes `num_slots_needed` entries of one sequence starting at position
+// `input_first_idx` into the cache of that sequence, shifting the oldest
+// entries out if the cache is full, and updates `num_entries` to the number of
+// entries the cache now holds. Writing before the end of the cache, e.g. after
+// some speculatively decoded tokens were rejected, truncates the cache there.
+TfLiteStatus UpdateSequenceCache(TfLiteContext* context,
+                                 int64_t max_num_entries,
+                                 int64_t num_bytes_per_tensor,
+                                 int64_t input_first_idx,
+                                 int64_t num_slots_needed, const uint8_t* key,
+                                 const uint8_t* value, uint8_t* k_ptr,
+                                 uint8_t* v_ptr, int64_t& first_slot_index,
+                                 int64_t& num_entries) {
+  // 1. Determine which slots the inputs take up, and which slots are in the
+  //    existing span of the cache.
+
+  // Compute the span of the inputs.
+  const int64_t input_last_idx = input_first_idx + num_slots_needed - 1;
+
+  // Compute the span of the cache.
+  const int64_t cache_first_slot_idx = first_slot_index;
+  const int64_t cache_last_slot_idx =
+      cache_first_slot_idx + max_num_entries - 1;
+
+  // Compute if a shift is needed.
+  const int64_t slots_to_shift = std::min(
+      std::max(static_cast<int64_t>(0), input_last_idx - cache_last_slot_idx),
+      max_num_entries);
+
+  // first_slot := the first cache entry that we will write to.
+  int64_t first_slot = input_first_idx - first_slot_index;
+  if (first_slot < 0) {
+    TF_LITE_KERNEL_LOG(context,
+                       "Can not specify a position before this cache's first "
+                       "slot index of %lld",
+                       static_cast<long long>(first_slot_index));
+    return kTfLiteError;
+  }
+
+  // 2. If we need more slots, make room in the cache by writing over oldest
+  //    entries.
+  if (slots_to_shift > 0 && slots_to_shift < max_num_entries) {
+    const int64_t bytes_offset = num_bytes_per_tensor * slots_to_shift;
+    const int64_t size_bytes_to_shift =
+        num_bytes_per_tensor * (max_num_entries - slots_to_shift);
+    // TODO(b/333893996): This is O(cache_size) data motion. Consider optimizing
+    // with a circular buffer or similar.
+    memmove(k_ptr, k_ptr + bytes_offset, size_bytes_to_shift);
+    memmove(v_ptr, v_ptr + bytes_offset, size_bytes_to_shift);
+  }
+
+  // Update the first slot this cache now covers.
+  first_slot_index = first_slot_index + slots_to_shift;
+
+  // Recompute the first slot in case any shifting occurred.
+  first_slot = input_first_idx - first_slot_index;
+  const int64_t bytes_offset_for_cache = first_slot * num_bytes_per_tensor;
+
+  // 3. Put the key and value in their respective caches.
+  const int64_t num_bytes = num_slots_needed * num_bytes_per_tensor;
+  memcpy(k_ptr + bytes_offset_for_cache, key, num_bytes);
+  memcpy(v_ptr + bytes_offset_for_cache, value, num_bytes);
+
+  // 4. Clear the entries past the new end of a truncated cache.
+  const int64_t new_num_entries =
+      std::min(first_slot + num_slots_needed, max_num_entries);
+  if (new_num_entries < num_entries) {
+    const int64_t end_offset = new_num_entries * num_bytes_per_tensor;
+    const int64_t num_bytes_to_clear =
+        (num_entries - new_num_entries) * num_bytes_per_tensor;
+    memset(k_ptr + end_offset, 0, num_bytes_to_clear);
+    memset(v_ptr + end_offset, 0, num_bytes_to_clear);
+  }
+  num_entries = new_num_entries;
+  return kTfLiteOk;
+}
+
 TfLiteStatus KVCacheEval(TfLiteContext* context, TfLiteNode* node) {
   const TfLiteTensor* position;
   TF_LITE_ENSURE_OK(context,
@@ -249,16 +342,18 @@ TfLiteStatus KVCacheEval(TfLiteContext* context, TfLiteNode* node) {
   float* value_cache_ptr = op_data->value_cache_buffer->GetBuffer();
   const int layer_index = op_data->layer_index;
   const int64_t max_num_entries = op_data->max_num_entries;
-  int current_num_entries =
-      op_data->key_cache_buffer->GetNumEntries(layer_index);
 
   // Compute some constants for various pieces of the cache.
   RuntimeShape shape(GetTensorShape(key));
+  const int batch_size = shape.Dims(0);
   const int64_t num_slots_needed = shape.Dims(1);
   const int elements_in_one_entry = shape.Dims(2) * shape.Dims(3);
   const int elements_in_one_block =
-      op_data->max_num_entries * elements_in_one_entry;
+      batch_size * op_data->max_num_entries * elements_in_one_entry;
   const int64_t num_bytes_per_tensor = sizeof(float) * elements_in_one_entry;
+  const int64_t num_bytes_per_sequence = num_bytes_per_tensor * max_num_entries;
+  const int64_t num_input_bytes_per_sequence =
+      num_bytes_per_tensor * num_slots_needed;
 
   // Get the pointers to the individual caches for a layer.
   uint8_t* k_ptr = reinterpret_cast<uint8_t*>(key_cache_ptr);
@@ -272,71 +367,40 @@ TfLiteStatus KVCacheEval(TfLiteContext* context, TfLiteNode* node) {
   TF_LITE_ENSURE(context, k_ptr == kfull->data.data);
   TF_LITE_ENSURE(context, v_ptr == vfull->data.data);
 
-  // 1. Determine which slots the inputs take up, and which slots are in the
-  //    existing span of the cache.
-
-  // Compute the span of the inputs.
-  const int64_t input_first_idx = position->data.i64[0];
-  const int64_t input_last_idx = input_first_idx + num_slots_needed - 1;
-
-  // Compute the span of the cache.
-  const int64_t cache_first_slot_idx = op_data->first_slot_index;
-  const int64_t cache_last_slot_idx =
-      cache_first_slot_idx + op_data->max_num_entries - 1;
-
-  // Compute if a shift is needed.
-  const int slots_to_shift = std::min(
-      std::max(static_cast<int64_t>(0), input_last_idx - cache_last_slot_idx),
-      max_num_entries);
-
-  // These values determine how we will write to the output tensor:
-  // first_slot := the first cache entry that we will write to in the output
-  int64_t first_slot = input_first_idx - op_data->first_slot_index;
-  if (first_slot < 0) {
-    TF_LITE_KERNEL_LOG(
+  // Each sequence of the batch has its own cache and span of positions.
+  const bool per_sequence_positions = NumDimensions(position) == 2;
+  for (int b = 0; b < batch_size; ++b) {
+    const int64_t input_first_idx =
+        position->data.i64[per_sequence_positions ? b * num_slots_needed : 0];
+    uint8_t* seq_k_ptr = k_ptr + b * num_bytes_per_sequence;
+    uint8_t* seq_v_ptr = v_ptr + b * num_bytes_per_sequence;
+    int64_t& first_slot_index = op_data->first_slot_indices[b];
+    if (input_first_idx < 0) {
+      // A negative position marks a slot whose sequence left the batch. Its
+      // cache is cleared so that a new sequence can start at position 0 in
+      // the next step.
+      memset(seq_k_ptr, 0, num_bytes_per_sequence);
+      memset(seq_v_ptr, 0, num_bytes_per_sequence);
+      first_slot_index = 0;
+      op_data->num_entries[b] = 0;
+      continue;
+    }
+    int64_t& num_entries = op_data->num_entries[b];
+    TF_LITE_ENSURE_OK(
         context,
-        "Can not specify a position before this cache's first slot index of %d",
-        op_data->first_slot_index);
-    return kTfLiteError;
+        UpdateSequenceCache(
+            context, max_num_entries, num_bytes_per_tensor, input_first_idx,
+            num_slots_needed,
+            reinterpret_cast<const uint8_t*>(key->data.raw_const) +
+                b * num_input_bytes_per_sequence,
+            reinterpret_cast<const uint8_t*>(value->data.raw_const) +
+                b * num_input_bytes_per_sequence,
+            seq_k_ptr, seq_v_ptr, first_slot_index, num_entries));
   }
 
-  // byte_offset_for_output := the byte offset for the first slot.
-  int64_t byte_offset_for_output = first_slot * num_bytes_per_tensor;
-  // num_slots_for_output := the number of slots we write in the output
-  int64_t num_slots_for_output = num_slots_needed;
-
-  // 3. If we need more slots, make room in the cache by writing over oldest
-  //    entries.
-  if (slots_to_shift > 0 && slots_to_shift < max_num_entries) {
-    // If we are shifting the cache, we need to start writing from the
-    // beginning.
-    byte_offset_for_output = 0;
-    // And we need to write the entire cache.
-    num_slots_for_output = max_num_entries;
-    const int bytes_offset =
-        sizeof(float) * elements_in_one_entry * slots_to_shift;
-    const int size_bytes_to_shift = sizeof(float) * elements_in_one_entry *
-                                    (max_num_entries - slots_to_shift);
-    // TODO(b/333893996): This is O(cache_size) data motion. Consider optimizing
-    // with a circular buffer or similar.
-    memmove(k_ptr, k_ptr + bytes_offset, size_bytes_to_shift);
-    memmove(v_ptr, v_ptr + bytes_offset, size_bytes_to_shift);
-  }
-
-  // Update the first slot this cache now covers.
-  op_data->first_slot_index = op_data->first_slot_index + slots_to_shift;
-
-  // Recompute the first slot in case any shifting occurred.
-  first_slot = input_first_idx - op_data->first_slot_index;
-  const int64_t bytes_offset_for_cache = first_slot * num_bytes_per_tensor;
-
-  // 4. Put the key and value in their respective caches.
-  memcpy(k_ptr + bytes_offset_for_cache, key->data.data, key->bytes);
-  memcpy(v_ptr + bytes_offset_for_cache, value->data.data, value->bytes);
-
   // Update counts.
-  current_num_entries =
-      std::min(first_slot + num_slots_needed, max_num_entries);
+  const int64_t current_num_entries = *std::max_element(
+      op_data->num_entries.begin(), op_data->num_entries.end());
   op_data->key_cache_buffer->SetNumEntries(layer_index, current_num_entries);
   op_data->value_cache_buffer->SetNumEntries(layer_index, current_num_entries);
 
@@ -237,5 +237,102 @@ TEST(SimpleCacheOp2Test, ShiftSlotsInCache) {
   ASSERT_EQ(m.Invoke(), kTfLiteError);
 }
 
+TEST(SimpleCacheOp2Test, RewritingPositionsTruncatesCache) {
+  SimpleCacheOpModel m({TensorType_INT64, {2}},
+                       {TensorType_FLOAT32, {1, 2, 1, 3}},
+                       {TensorType_FLOAT32, {1, 2, 1, 3}});
+  const int entry_size = 3;
+
+  m.SetPosition({0, 1});
+  m.SetKey({1, 1, 1, 2, 2, 2});
+  m.SetValue({1, 1, 1, 2, 2, 2});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  // Two draft tokens are verified at positions 2 and 3.
+  m.SetPosition({2, 3});
+  m.SetKey({3, 3, 3, 4, 4, 4});
+  m.SetValue({3, 3, 3, 4, 4, 4});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  // Only the first one is accepted, so decoding resumes at position 2 with
+  // the corrected token and the next one.
+  m.SetPosition({2, 3});
+  m.SetKey({5, 5, 5, 6, 6, 6});
+  m.SetValue({5, 5, 5, 6, 6, 6});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  m.ResizeKey({1, 1, 1, 3});
+  m.ResizeValue({1, 1, 1, 3});
+  m.ResizePosition({1});
+  ASSERT_EQ(m.ReAllocate(), kTfLiteOk);
+  // Rolling back to position 1 drops the entries at positions 2 and 3.
+  m.SetPosition({1});
+  m.SetKey({7, 7, 7});
+  m.SetValue({7, 7, 7});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  std::vector<float> fullk = m.GetFullK();
+  std::vector<float> fullv = m.GetFullV();
+  for (int i = 0; i < entry_size; ++i) {
+    EXPECT_EQ(fullk[i], 1);
+    EXPECT_EQ(fullk[entry_size + i], 7);
+    EXPECT_EQ(fullv[entry_size + i], 7);
+  }
+  for (int i = 2 * entry_size; i < fullk.size(); ++i) {
+    ASSERT_EQ(fullk[i], 0);
+    ASSERT_EQ(fullv[i], 0);
+  }
+}
+
+TEST(SimpleCacheOp3Test, BatchWithPerSequencePositions) {
+  SimpleCacheOpModel m({TensorType_INT64, {2, 1}},
+                       {TensorType_FLOAT32, {2, 1, 1, 2}},
+                       {TensorType_FLOAT32, {2, 1, 1, 2}});
+  const int entry_size = 2;
+  const int sequence_size = entry_size * kDefaultMaxNumCacheEntries;
+
+  m.SetPosition({0, 3});
+  m.SetKey({1, 2, 3, 4});
+  m.SetValue({5, 6, 7, 8});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  std::vector<float> fullk = m.GetFullK();
+  std::vector<float> fullv = m.GetFullV();
+  ASSERT_EQ(fullk.size(), 2 * sequence_size);
+  ASSERT_EQ(fullv.size(), 2 * sequence_size);
+  EXPECT_EQ(fullk[0], 1);
+  EXPECT_EQ(fullk[1], 2);
+  EXPECT_EQ(fullv[0], 5);
+  EXPECT_EQ(fullv[1], 6);
+  EXPECT_EQ(fullk[sequence_size + 3 * entry_size], 3);
+  EXPECT_EQ(fullk[sequence_size + 3 * entry_size + 1], 4);
+  EXPECT_EQ(fullv[sequence_size + 3 * entry_size], 7);
+  EXPECT_EQ(fullv[sequence_size + 3 * entry_size + 1], 8);
+
+  // The first sequence leaves the batch while the second one keeps decoding.
+  m.SetPosition({-1, 4});
+  m.SetKey({9, 9, 10, 11});
+  m.SetValue({9, 9, 12, 13});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  fullk = m.GetFullK();
+  fullv = m.GetFullV();
+  for (int i = 0; i < sequence_size; ++i) {
+    ASSERT_EQ(fullk[i], 0);
+    ASSERT_EQ(fullv[i], 0);
+  }
+  EXPECT_EQ(fullk[sequence_size + 3 * entry_size], 3);
+  EXPECT_EQ(fullk[sequence_size + 4 * entry_size], 10);
+  EXPECT_EQ(fullk[sequence_size + 4 * entry_size + 1], 11);
+  EXPECT_EQ(fullv[sequence_size + 4 * entry_size], 12);
+  EXPECT_EQ(fullv[sequence_size + 4 * entry_size + 1], 13);
+
+  // A new sequence joins in the freed slot.
+  m.SetPosition({0, 5});
+  m.SetKey({14, 15, 16, 17});
+  m.SetValue({18, 19, 20, 21});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  fullk = m.GetFullK();
+  EXPECT_EQ(fullk[0], 14);
+  EXPECT_EQ(fullk[1], 15);
+  EXPECT_EQ(fullk[sequence_size + 5 * entry_size], 16);
+}
+
 }  // namespace
 }  // namespace tflite
@@ -0,0 +1,258 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "flatbuffers/flexbuffers.h"
+#include "tflite/c/c_api_types.h"
+#include "tflite/core/c/common.h"
+#include "tflite/kernels/internal/tensor_ctypes.h"
+#include "tflite/kernels/kernel_util.h"
+#include "tflite/kernels/rng_util.h"
+
+namespace tflite {
+namespace ops {
+namespace custom {
+namespace llm {
+
+// Samples one token per row of logits, replacing the softmax, TOPK_V2 and
+// MULTINOMIAL ops of a decoding step.
+//
+// Input: float32 logits of shape [..., vocab_size].
+// Output: int32 token ids of shape [...].
+// Options (flexbuffer map, all optional):
+//   "temperature": the logits are divided by it before the softmax. A
+//     temperature <= 0 picks the most likely token. Defaults to 1.
+//   "top_k": only the `top_k` most likely tokens are sampled from. 0, the
+//     default, keeps all of them.
+//   "top_p": only the most likely tokens whose cumulative probability reaches
+//     `top_p` are sampled from. Defaults to 1.
+//   "seed": the seed of the random number generator. Each invocation draws
+//     new random numbers, so that a model always samples the same sequence of
+//     tokens from the same seed.
+
+static const int kLogitsTensor = 0;
+static const int kOutputTensor = 0;
+
+struct OpData {
+  float temperature = 1.0f;
+  int top_k = 0;
+  float top_p = 1.0f;
+  uint32_t seed_lo = 0;
+  uint32_t seed_hi = 0;
+  // Incremented by each invocation, for it to draw new random numbers.
+  uint64_t invocation = 0;
+  // The (logit, token) candidates of the row being sampled.
+  std::vector<std::pair<float, int>> candidates;
+};
+
+void* SamplingInit(TfLiteContext* context, const char* buffer,
+                   size_t length) {
+  OpData* op_data = new OpData();
+  if (buffer == nullptr || length == 0) {
+    return op_data;
+  }
+  const auto flexbuffer_map =
+      flexbuffers::GetRoot(reinterpret_cast<const uint8_t*>(buffer), length)
+          .AsMap();
+  if (!flexbuffer_map["temperature"].IsNull()) {
+    op_data->temperature = flexbuffer_map["temperature"].AsFloat();
+  }
+  op_data->top_k = flexbuffer_map["top_k"].AsInt32();
+  if (!flexbuffer_map["top_p"].IsNull()) {
+    op_data->top_p = flexbuffer_map["top_p"].AsFloat();
+  }
+  const uint64_t seed = flexbuffer_map["seed"].AsUInt64();
+  op_data->seed_lo = static_cast<uint32_t>(seed);
+  op_data->seed_hi = static_cast<uint32_t>(seed >> 32);
+  return op_data;
+}
+
+void SamplingFree(TfLiteContext* context, void* buffer) {
+  delete reinterpret_cast<OpData*>(buffer);
+}
+
+TfLiteStatus SamplingPrepare(TfLiteContext* context, TfLiteNode* node) {
+  TF_LITE_ENSURE_EQ(context, NumInputs(node), 1);
+  TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
+  OpData* op_data = reinterpret_cast<OpData*>(node->user_data);
+  TF_LITE_ENSURE(context, op_data->top_k >= 0);
+  TF_LITE_ENSURE(context, op_data->top_p > 0.0f && op_data->top_p <= 1.0f);
+
+  const TfLiteTensor* logits;
+  TF_LITE_ENSURE_OK(context,
+                    GetInputSafe(context, node, kLogitsTensor, &logits));
+  TF_LITE_ENSURE_TYPES_EQ(context, logits->type, kTfLiteFloat32);
+  const int num_dims = NumDimensions(logits);
+  TF_LITE_ENSURE(context, num_dims >= 1);
+  TF_LITE_ENSURE(context, SizeOfDimension(logits, num_dims - 1) > 0);
+
+  TfLiteTensor* output;
+  TF_LITE_ENSURE_OK(context,
+                    GetOutputSafe(context, node, kOutputTensor, &output));
+  TF_LITE_ENSURE_TYPES_EQ(context, output->type, kTfLiteInt32);
+  TfLiteIntArray* output_shape = TfLiteIntArrayCreate(num_dims - 1);
+  for (int i = 0; i < num_dims - 1; ++i) {
+    output_shape->data[i] = logits->dims->data[i];
+  }
+  return context->ResizeTensor(context, output, output_shape);
+}
+
+// Returns a uniform random number in [0, 1).
+float UniformFloat(uint32_t bits) {
+  // The 24 most significant bits fit exactly in a float mantissa.
+  return static_cast<float>(bits >> 8) * (1.0f / (1 << 24));
+}
+
+// Samples one row of logits, reading them once.
+int SampleRow(const float* logits, int vocab_size, OpData* op_data,
+              float uniform) {
+  // Greedy decoding only needs the streaming max.
+  if (op_data->temperature <= 0.0f) {
+    return std::max_element(logits, logits + vocab_size) - logits;
+  }
+
+  // Collects the candidates in a single pass over the vocabulary. With top-k,
+  // they are kept in a min-heap of the k largest logits, most of the logits
+  // being rejected by a single comparison with its top once it is full.
+  auto& candidates = op_data->candidates;
+  candidates.clear();
+  const int top_k = op_data->top_k == 0
+                        ? vocab_size
+                        : std::min(op_data->top_k, vocab_size);
+  candidates.reserve(top_k);
+  if (top_k == vocab_size) {
+    for (int i = 0; i < vocab_size; ++i) {
+      candidates.emplace_back(logits[i], i);
+    }
+  } else {
+    // The min-heap comparator, preferring the smaller ids on ties.
+    const auto greater = [](const std::pair<float, int>& a,
+                            const std::pair<float, int>& b) {
+      return a.first > b.first || (a.first == b.first && a.second < b.second);
+    };
+    for (int i = 0; i < top_k; ++i) {
+      candidates.emplace_back(logits[i], i);
+    }
+    std::make_heap(candidates.begin(), candidates.end(), greater);
+    float threshold = candidates.front().first;
+    for (int i = top_k; i < vocab_size; ++i) {
+      if (logits[i] <= threshold) {
+        continue;
+      }
+      std::pop_heap(candidates.begin(), candidates.end(), greater);
+      candidates.back() = {logits[i], i};
+      std::push_heap(candidates.begin(), candidates.end(), greater);
+      threshold = candidates.front().first;
+    }
+  }
+
+  // Nucleus sampling needs the candidates from the most likely one.
+  const bool use_top_p = op_data->top_p < 1.0f;
+  if (use_top_p) {
+    std::sort(candidates.begin(), candidates.end(),
+              [](const std::pair<float, int>& a,
+                 const std::pair<float, int>& b) {
+                return a.first > b.first ||
+                       (a.first == b.first && a.second < b.second);
+              });
+  }
+  float max_logit = candidates.front().first;
+  if (!use_top_p) {
+    for (const auto& candidate : candidates) {
+      max_logit = std::max(max_logit, candidate.first);
+    }
+  }
+
+  // Replaces the logits by the partial sums of their unnormalized
+  // probabilities, which are the only ones the sampling needs.
+  const float inverse_temperature = 1.0f / op_data->temperature;
+  float sum = 0.0f;
+  for (auto& candidate : candidates) {
+    sum += std::exp((candidate.first - max_logit) * inverse_temperature);
+    candidate.first = sum;
+  }
+  int num_candidates = candidates.size();
+  if (use_top_p) {
+    // Keeps the smallest prefix reaching `top_p` of the probability mass.
+    const float mass = op_data->top_p * sum;
+    num_candidates =
+        std::lower_bound(candidates.begin(), candidates.end(), mass,
+                         [](const std::pair<float, int>& candidate,
+                            float value) { return candidate.first < value; }) -
+        candidates.begin() + 1;
+    num_candidates = std::min<int>(num_candidates, candidates.size());
+    sum = candidates[num_candidates - 1].first;
+  }
+
+  const float sample = uniform * sum;
+  const auto it =
+      std::upper_bound(candidates.begin(), candidates.begin() + num_candidates,
+                       sample,
+                       [](float value, const std::pair<float, int>& candidate) {
+                         return value < candidate.first;
+                       });
+  // Rounding may leave `sample` at `sum`.
+  const int position = std::min<int>(it - candidates.begin(),
+                                     num_candidates - 1);
+  return candidates[position].second;
+}
+
+TfLiteStatus SamplingEval(TfLiteContext* context, TfLiteNode* node) {
+  OpData* op_data = reinterpret_cast<OpData*>(node->user_data);
+  const TfLiteTensor* logits;
+  TF_LITE_ENSURE_OK(context,
+                    GetInputSafe(context, node, kLogitsTensor, &logits));
+  TfLiteTensor* output;
+  TF_LITE_ENSURE_OK(context,
+                    GetOutputSafe(context, node, kOutputTensor, &output));
+
+  const int vocab_size = SizeOfDimension(logits, NumDimensions(logits) - 1);
+  const int num_rows = NumElements(output);
+  const float* logits_data = GetTensorData<float>(logits);
+  int32_t* output_data = GetTensorData<int32_t>(output);
+  const uint64_t invocation = op_data->invocation++;
+  for (int row = 0; row < num_rows; row += 4) {
+    // Each Philox call draws the random numbers of 4 rows.
+    const std::array<uint32_t, 4> bits = rng::Philox4x32(
+        op_data->seed_lo, op_data->seed_hi,
+        {static_cast<uint32_t>(invocation),
+         static_cast<uint32_t>(invocation >> 32), static_cast<uint32_t>(row),
+         0});
+    for (int i = 0; i < 4 && row + i < num_rows; ++i) {
+      output_data[row + i] =
+          SampleRow(logits_data + static_cast<size_t>(row + i) * vocab_size,
+                    vocab_size, op_data, UniformFloat(bits[i]));
+    }
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace llm
+
+TfLiteRegistration* Register_SAMPLING() {
+  static TfLiteRegistration r = {llm::SamplingInit, llm::SamplingFree,
+                                 llm::SamplingPrepare, llm::SamplingEval};
+  return &r;
+}
+
+}  // namespace custom
+}  // namespace ops
+}  // namespace tflite
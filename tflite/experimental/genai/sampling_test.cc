@@ -0,0 +1,134 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "flatbuffers/flexbuffers.h"
+#include "tflite/experimental/genai/genai_ops.h"
+#include "tflite/kernels/test_util.h"
+#include "tflite/schema/schema_generated.h"
+
+namespace tflite {
+namespace {
+
+using ::testing::ElementsAre;
+
+class SamplingOpModel : public SingleOpModel {
+ public:
+  SamplingOpModel(const std::vector<int>& logits_shape, float temperature,
+                  int top_k, float top_p, int64_t seed) {
+    logits_ = AddInput(TensorType_FLOAT32);
+    output_ = AddOutput(TensorType_INT32);
+
+    flexbuffers::Builder fbb;
+    fbb.Map([&]() {
+      fbb.Float("temperature", temperature);
+      fbb.Int("top_k", top_k);
+      fbb.Float("top_p", top_p);
+      fbb.Int("seed", seed);
+    });
+    fbb.Finish();
+    SetCustomOp("Sampling", fbb.GetBuffer(), ops::custom::Register_SAMPLING);
+    BuildInterpreter({logits_shape});
+  }
+
+  void SetLogits(const std::vector<float>& data) {
+    PopulateTensor(logits_, data);
+  }
+  std::vector<int32_t> GetOutput() { return ExtractVector<int32_t>(output_); }
+  std::vector<int> GetOutputShape() { return GetTensorShape(output_); }
+
+ private:
+  int logits_;
+  int output_;
+};
+
+// Returns how many times each token is sampled from `logits` in
+// `num_samples` invocations.
+std::map<int, int> CountSamples(SamplingOpModel* m,
+                                const std::vector<float>& logits,
+                                int num_samples) {
+  std::map<int, int> counts;
+  for (int i = 0; i < num_samples; ++i) {
+    m->SetLogits(logits);
+    EXPECT_EQ(m->Invoke(), kTfLiteOk);
+    ++counts[m->GetOutput()[0]];
+  }
+  return counts;
+}
+
+TEST(SamplingOpTest, ZeroTemperaturePicksMostLikelyTokens) {
+  SamplingOpModel m({2, 1, 4}, /*temperature=*/0.0f, /*top_k=*/0,
+                    /*top_p=*/1.0f, /*seed=*/0);
+  m.SetLogits({0.5f, 3.0f, -1.0f, 2.0f, 7.0f, 1.0f, 0.0f, 6.0f});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(2, 1));
+  EXPECT_THAT(m.GetOutput(), ElementsAre(1, 0));
+}
+
+TEST(SamplingOpTest, TopKSamplesFromTheKMostLikelyTokens) {
+  SamplingOpModel m({1, 6}, /*temperature=*/1.0f, /*top_k=*/2,
+                    /*top_p=*/1.0f, /*seed=*/42);
+  const std::map<int, int> counts =
+      CountSamples(&m, {0.0f, 1.0f, 2.0f, 3.0f, -5.0f, 2.5f}, 1000);
+  ASSERT_EQ(counts.size(), 2);
+  // The probabilities are 0.62 and 0.38 once renormalized.
+  EXPECT_NEAR(counts.at(3), 622, 60);
+  EXPECT_NEAR(counts.at(5), 378, 60);
+}
+
+TEST(SamplingOpTest, TopPSamplesFromTheNucleus) {
+  SamplingOpModel m({1, 6}, /*temperature=*/1.0f, /*top_k=*/0,
+                    /*top_p=*/0.5f, /*seed=*/42);
+  // Tokens 3 and 5 have 0.46 and 0.28 of the probability mass.
+  const std::map<int, int> counts =
+      CountSamples(&m, {0.0f, 1.0f, 2.0f, 3.0f, -5.0f, 2.5f}, 1000);
+  ASSERT_EQ(counts.size(), 2);
+  EXPECT_GT(counts.at(3), counts.at(5));
+}
+
+TEST(SamplingOpTest, LowTemperatureSharpensTheDistribution) {
+  SamplingOpModel m({1, 3}, /*temperature=*/0.05f, /*top_k=*/0,
+                    /*top_p=*/1.0f, /*seed=*/7);
+  const std::map<int, int> counts =
+      CountSamples(&m, {1.0f, 2.0f, 1.5f}, 100);
+  EXPECT_GE(counts.at(1), 99);
+}
+
+TEST(SamplingOpTest, SameSeedSamplesSameTokens) {
+  const std::vector<float> logits(64, 0.0f);
+  SamplingOpModel m1({1, 64}, 1.0f, 0, 1.0f, /*seed=*/1234);
+  SamplingOpModel m2({1, 64}, 1.0f, 0, 1.0f, /*seed=*/1234);
+  std::vector<int32_t> tokens1;
+  std::vector<int32_t> tokens2;
+  for (int i = 0; i < 16; ++i) {
+    m1.SetLogits(logits);
+    m2.SetLogits(logits);
+    ASSERT_EQ(m1.Invoke(), kTfLiteOk);
+    ASSERT_EQ(m2.Invoke(), kTfLiteOk);
+    tokens1.push_back(m1.GetOutput()[0]);
+    tokens2.push_back(m2.GetOutput()[0]);
+  }
+  EXPECT_EQ(tokens1, tokens2);
+  // Each invocation draws new random numbers.
+  EXPECT_NE(std::count(tokens1.begin(), tokens1.end(), tokens1[0]), 16);
+}
+
+}  // namespace
+}  // namespace tflite
@@ -15,23 +15,19 @@ limitations under the License.
 
 #include <math.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <cstring>
 #include <limits>
+#include <vector>
 
+#include "fp16/fp16.h"  // from @FP16
 #include "flatbuffers/flexbuffers.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/core/c/common.h"
-#include "tflite/kernels/internal/common.h"
-#include "tflite/kernels/internal/reference/add.h"
-#include "tflite/kernels/internal/reference/batch_matmul.h"
-#include "tflite/kernels/internal/reference/fully_connected.h"
-#include "tflite/kernels/internal/reference/softmax.h"
-#include "tflite/kernels/internal/reference/transpose.h"
-#include "tflite/kernels/internal/runtime_shape.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/cpu_backend_threadpool.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
-#include "tflite/kernels/internal/types.h"
 #include "tflite/kernels/kernel_util.h"
 
 namespace tflite {
@@ -45,27 +41,262 @@ static const int kValueTensor = 2;
 static const int kAttentionMaskTensor = 3;
 static const int kOutputTensor = 0;
 
-static const int kNumTempTensors = 10;
-static const int kTransposeQueryTempTensorIndex = 0;
-static const int kTransposeKeyTempTensorIndex = 1;
-static const int kMatMul1TempTensorIndex = 2;
-static const int kAddTempTensorIndex = 3;
-static const int kTransposeValueTempTensorIndex = 4;
-static const int kMatMul2TempTensorIndex = 5;
-static const int kReshape1TempTensorIndex = 6;
-static const int kReshape2TempTensorIndex = 7;
-static const int kBroadcastKTempTensorIndex = 8;
-static const int kBroadcastVTempTensorIndex = 9;
+// The queries of a head are processed kQueryBlockSize at a time against the
+// keys and values kKeyBlockSize at a time, so that the blocks of keys, values
+// and scores in use stay in the L2 cache whatever the sequence lengths.
+static const int kQueryBlockSize = 16;
+static const int kKeyBlockSize = 128;
+// Below this number of multiply-adds per task, the work runs on the calling
+// thread only.
+static const int64_t kMinMultiplyAddsPerTask = 1 << 16;
 
 struct OpData {
   float scale;
-  int scratch_tensor_index;
 };
 
+// The dimensions of the inputs, with q (B, T, N, H), k (B, S, N_kv, H),
+// v (B, S, N_kv, H_v), a mask broadcast to (B, N, T, S) and an output
+// (B, T, N, H_v).
+struct SDPAParams {
+  int batch_size;
+  int query_length;
+  int key_length;
+  int num_heads;
+  int num_kv_heads;
+  int head_dim;
+  int value_head_dim;
+  float scale;
+  // The strides of the mask along (B, N, T, S), 0 for the broadcast ones.
+  int64_t mask_strides[4];
+};
+
+// Converts `num_rows` rows of `row_size` keys or values with a distance of
+// `row_stride` between them to float, and returns a pointer to the converted
+// rows, `row_size` apart.
+template <typename T>
+const float* GetFloatRows(const T* data, const TfLiteQuantizationParams&,
+                          int num_rows, int row_size, int row_stride,
+                          float* buffer);
+
+template <>
+const float* GetFloatRows(const float* data, const TfLiteQuantizationParams&,
+                          int num_rows, int row_size, int row_stride,
+                          float* buffer) {
+  if (row_size == row_stride) {
+    return data;
+  }
+  for (int i = 0; i < num_rows; ++i) {
+    std::copy_n(data + static_cast<int64_t>(i) * row_stride, row_size,
+                buffer + i * row_size);
+  }
+  return buffer;
+}
+
+template <>
+const float* GetFloatRows(const uint16_t* data,
+                          const TfLiteQuantizationParams&, int num_rows,
+                          int row_size, int row_stride, float* buffer) {
+  for (int i = 0; i < num_rows; ++i) {
+    const uint16_t* row = data + static_cast<int64_t>(i) * row_stride;
+    for (int j = 0; j < row_size; ++j) {
+      buffer[i * row_size + j] = fp16_ieee_to_fp32_value(row[j]);
+    }
+  }
+  return buffer;
+}
+
+template <>
+const float* GetFloatRows(const int8_t* data,
+                          const TfLiteQuantizationParams& params,
+                          int num_rows, int row_size, int row_stride,
+                          float* buffer) {
+  for (int i = 0; i < num_rows; ++i) {
+    const int8_t* row = data + static_cast<int64_t>(i) * row_stride;
+    for (int j = 0; j < row_size; ++j) {
+      buffer[i * row_size + j] =
+          params.scale * (static_cast<int32_t>(row[j]) - params.zero_point);
+    }
+  }
+  return buffer;
+}
+
+// Computes the attention of the query blocks [begin, end), numbered along
+// (B, N, T / kQueryBlockSize), with an online softmax over the key blocks so
+// that the scores are never materialized for the whole key sequence.
+template <typename KVType>
+struct SDPATask : cpu_backend_threadpool::Task {
+  SDPATask(const SDPAParams& params, const float* query, const KVType* key,
+           const TfLiteQuantizationParams& key_params, const KVType* value,
+           const TfLiteQuantizationParams& value_params, const float* mask,
+           float* output, int begin, int end)
+      : params(params),
+        query(query),
+        key(key),
+        key_params(key_params),
+        value(value),
+        value_params(value_params),
+        mask(mask),
+        output(output),
+        begin(begin),
+        end(end) {}
+
+  void Run() override {
+    const int head_dim = params.head_dim;
+    const int value_head_dim = params.value_head_dim;
+    const int num_query_blocks =
+        (params.query_length + kQueryBlockSize - 1) / kQueryBlockSize;
+    const int heads_per_kv_head = params.num_heads / params.num_kv_heads;
+    const int kv_row_stride = params.num_kv_heads * head_dim;
+    const int value_row_stride = params.num_kv_heads * value_head_dim;
+    std::vector<float> key_buffer(kKeyBlockSize * head_dim);
+    std::vector<float> value_buffer(kKeyBlockSize * value_head_dim);
+    std::vector<float> scores(kKeyBlockSize);
+    std::vector<float> row_max(kQueryBlockSize);
+    std::vector<float> row_sum(kQueryBlockSize);
+    std::vector<float> accumulator(kQueryBlockSize * value_head_dim);
+
+    for (int block = begin; block < end; ++block) {
+      const int query_block = block % num_query_blocks;
+      const int head = (block / num_query_blocks) % params.num_heads;
+      const int batch = block / num_query_blocks / params.num_heads;
+      // The key and value heads are shared by consecutive query heads, like
+      // torch.repeat_interleave.
+      const int kv_head = head / heads_per_kv_head;
+      const int t_begin = query_block * kQueryBlockSize;
+      const int t_end =
+          std::min(t_begin + kQueryBlockSize, params.query_length);
+      std::fill(row_max.begin(), row_max.end(),
+                -std::numeric_limits<float>::infinity());
+      std::fill(row_sum.begin(), row_sum.end(), 0.0f);
+      std::fill(accumulator.begin(), accumulator.end(), 0.0f);
+
+      for (int s_begin = 0; s_begin < params.key_length;
+           s_begin += kKeyBlockSize) {
+        const int num_keys =
+            std::min(kKeyBlockSize, params.key_length - s_begin);
+        const int64_t kv_row =
+            static_cast<int64_t>(batch) * params.key_length + s_begin;
+        const float* key_block = GetFloatRows(
+            key + kv_row * kv_row_stride + kv_head * head_dim, key_params,
+            num_keys, head_dim, kv_row_stride, key_buffer.data());
+        const float* value_block = GetFloatRows(
+            value + kv_row * value_row_stride + kv_head * value_head_dim,
+            value_params, num_keys, value_head_dim, value_row_stride,
+            value_buffer.data());
+
+        for (int t = t_begin; t < t_end; ++t) {
+          const float* query_row =
+              query +
+              ((static_cast<int64_t>(batch) * params.query_length + t) *
+                   params.num_heads +
+               head) *
+                  head_dim;
+          const float* mask_row =
+              mask + batch * params.mask_strides[0] +
+              head * params.mask_strides[1] + t * params.mask_strides[2];
+          float block_max = -std::numeric_limits<float>::infinity();
+          for (int s = 0; s < num_keys; ++s) {
+            const float* key_row = key_block + s * head_dim;
+            float dot = 0.0f;
+            for (int d = 0; d < head_dim; ++d) {
+              dot += query_row[d] * key_row[d];
+            }
+            scores[s] = dot * params.scale +
+                        mask_row[(s_begin + s) * params.mask_strides[3]];
+            block_max = std::max(block_max, scores[s]);
+          }
+
+          const int i = t - t_begin;
+          const float new_max = std::max(row_max[i], block_max);
+          if (new_max == -std::numeric_limits<float>::infinity()) {
+            // All the keys so far are masked out.
+            continue;
+          }
+          // Rescale what was accumulated for the previous key blocks to the
+          // new maximum.
+          const float correction = expf(row_max[i] - new_max);
+          float* accumulator_row = accumulator.data() + i * value_head_dim;
+          row_sum[i] *= correction;
+          for (int d = 0; d < value_head_dim; ++d) {
+            accumulator_row[d] *= correction;
+          }
+          for (int s = 0; s < num_keys; ++s) {
+            const float p = expf(scores[s] - new_max);
+            row_sum[i] += p;
+            const float* value_row = value_block + s * value_head_dim;
+            for (int d = 0; d < value_head_dim; ++d) {
+              accumulator_row[d] += p * value_row[d];
+            }
+          }
+          row_max[i] = new_max;
+        }
+      }
+
+      for (int t = t_begin; t < t_end; ++t) {
+        const int i = t - t_begin;
+        float* output_row =
+            output + ((static_cast<int64_t>(batch) * params.query_length + t) *
+                          params.num_heads +
+                      head) *
+                         value_head_dim;
+        const float inv_sum = row_sum[i] > 0.0f ? 1.0f / row_sum[i] : 0.0f;
+        for (int d = 0; d < value_head_dim; ++d) {
+          output_row[d] = accumulator[i * value_head_dim + d] * inv_sum;
+        }
+      }
+    }
+  }
+
+  const SDPAParams& params;
+  const float* query;
+  const KVType* key;
+  const TfLiteQuantizationParams& key_params;
+  const KVType* value;
+  const TfLiteQuantizationParams& value_params;
+  const float* mask;
+  float* output;
+  const int begin;
+  const int end;
+};
+
+template <typename KVType>
+void RunSDPA(const SDPAParams& params, const float* query,
+             const TfLiteTensor* key, const TfLiteTensor* value,
+             const float* mask, float* output,
+             CpuBackendContext* cpu_backend_context) {
+  const int num_query_blocks =
+      (params.query_length + kQueryBlockSize - 1) / kQueryBlockSize;
+  const int num_blocks =
+      params.batch_size * params.num_heads * num_query_blocks;
+  const int64_t multiply_adds = static_cast<int64_t>(params.batch_size) *
+                                params.num_heads * params.query_length *
+                                params.key_length *
+                                (params.head_dim + params.value_head_dim);
+  const int num_tasks = static_cast<int>(std::max<int64_t>(
+      1, std::min<int64_t>({cpu_backend_context->max_num_threads(), num_blocks,
+                            multiply_adds / kMinMultiplyAddsPerTask})));
+  std::vector<SDPATask<KVType>> tasks;
+  tasks.reserve(num_tasks);
+  int begin = 0;
+  for (int i = 0; i < num_tasks; ++i) {
+    const int end = begin + (num_blocks - begin) / (num_tasks - i);
+    tasks.emplace_back(
+        params, query, reinterpret_cast<const KVType*>(key->data.raw_const),
+        key->params, reinterpret_cast<const KVType*>(value->data.raw_const),
+        value->params, mask, output, begin, end);
+    begin = end;
+  }
+  if (num_tasks == 1) {
+    tasks[0].Run();
+  } else {
+    cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                    cpu_backend_context);
+  }
+}
+
 void* SDPAInit(TfLiteContext* context, const char* buffer, size_t length) {
   OpData* op_data = new OpData();
   op_data->scale = 0.0f;
-  context->AddTensors(context, kNumTempTensors, &op_data->scratch_tensor_index);
   return op_data;
 }
 
@@ -86,12 +317,46 @@ TfLiteStatus SDPAPrepare(TfLiteContext* context, TfLiteNode* node) {
   const TfLiteTensor* mask_tensor;
   TF_LITE_ENSURE_OK(
       context, GetInputSafe(context, node, kAttentionMaskTensor, &mask_tensor));
+  TfLiteTensor* output_tensor;
+  TF_LITE_ENSURE_OK(
+      context, GetOutputSafe(context, node, kOutputTensor, &output_tensor));
   TF_LITE_ENSURE_EQ(context, NumDimensions(q_tensor), NumDimensions(k_tensor));
   TF_LITE_ENSURE_EQ(context, NumDimensions(k_tensor), NumDimensions(v_tensor));
   TF_LITE_ENSURE_EQ(context, NumDimensions(v_tensor),
                     NumDimensions(mask_tensor));
   TF_LITE_ENSURE_EQ(context, NumDimensions(mask_tensor), 4);
 
+  // The keys and values can be kept in float32, float16 or per-tensor
+  // quantized int8.
+  TF_LITE_ENSURE_TYPES_EQ(context, q_tensor->type, kTfLiteFloat32);
+  TF_LITE_ENSURE_TYPES_EQ(context, mask_tensor->type, kTfLiteFloat32);
+  TF_LITE_ENSURE_TYPES_EQ(context, output_tensor->type, kTfLiteFloat32);
+  TF_LITE_ENSURE_TYPES_EQ(context, k_tensor->type, v_tensor->type);
+  TF_LITE_ENSURE(context, k_tensor->type == kTfLiteFloat32 ||
+                              k_tensor->type == kTfLiteFloat16 ||
+                              k_tensor->type == kTfLiteInt8);
+  if (k_tensor->type == kTfLiteInt8) {
+    TF_LITE_ENSURE(context, k_tensor->params.scale > 0.0f);
+    TF_LITE_ENSURE(context, v_tensor->params.scale > 0.0f);
+  }
+
+  const int batch_size = q_tensor->dims->data[0];
+  const int num_heads = q_tensor->dims->data[2];
+  const int num_kv_heads = k_tensor->dims->data[2];
+  TF_LITE_ENSURE_EQ(context, k_tensor->dims->data[0], batch_size);
+  TF_LITE_ENSURE_EQ(context, v_tensor->dims->data[0], batch_size);
+  TF_LITE_ENSURE_EQ(context, k_tensor->dims->data[1], v_tensor->dims->data[1]);
+  TF_LITE_ENSURE_EQ(context, k_tensor->dims->data[3], q_tensor->dims->data[3]);
+  TF_LITE_ENSURE_EQ(context, v_tensor->dims->data[2], num_kv_heads);
+  TF_LITE_ENSURE(context, num_kv_heads > 0 && num_heads % num_kv_heads == 0);
+  // The mask is broadcast to the scores, (B, N, T, S).
+  const int scores_shape[4] = {batch_size, num_heads, q_tensor->dims->data[1],
+                               k_tensor->dims->data[1]};
+  for (int i = 0; i < 4; ++i) {
+    TF_LITE_ENSURE(context, mask_tensor->dims->data[i] == 1 ||
+                                mask_tensor->dims->data[i] == scores_shape[i]);
+  }
+
   // Get custom op params
   const uint8_t* buffer =
       reinterpret_cast<const uint8_t*>(node->custom_initial_data);
@@ -104,253 +369,6 @@ TfLiteStatus SDPAPrepare(TfLiteContext* context, TfLiteNode* node) {
   if (op_data->scale == 0.0f)
     op_data->scale = 1 / sqrt(q_tensor->dims->data[3]);
 
-  TfLiteIntArrayFree(node->temporaries);
-  node->temporaries = TfLiteIntArrayCreate(kNumTempTensors);
-  bool mqa = k_tensor->dims->data[2] == 1;
-
-  // Temp tensor for Transposed Q;
-  {
-    node->temporaries->data[kTransposeQueryTempTensorIndex] =
-        op_data->scratch_tensor_index + kTransposeQueryTempTensorIndex;
-    TfLiteTensor* scratch_buffer;
-    TF_LITE_ENSURE_OK(context,
-                      GetTemporarySafe(context, node,
-                                       /*index=*/kTransposeQueryTempTensorIndex,
-                                       &scratch_buffer));
-    TfLiteIntArray* scratch_buffer_size = TfLiteIntArrayCreate(4);
-    for (int i = 0; i < 4; ++i) {
-      scratch_buffer_size->data[i] = q_tensor->dims->data[i];
-    }
-    // Swap middle two dimensions.
-    scratch_buffer_size->data[1] = q_tensor->dims->data[2];
-    scratch_buffer_size->data[2] = q_tensor->dims->data[1];
-
-    scratch_buffer->type = kTfLiteFloat32;
-    scratch_buffer->allocation_type = kTfLiteArenaRw;
-    TF_LITE_ENSURE_OK(context, context->ResizeTensor(context, scratch_buffer,
-                                                     scratch_buffer_size));
-  }
-
-  // Temp tensor for Transposed K;
-  {
-    node->temporaries->data[kTransposeKeyTempTensorIndex] =
-        op_data->scratch_tensor_index + kTransposeKeyTempTensorIndex;
-    TfLiteTensor* scratch_buffer;
-    TF_LITE_ENSURE_OK(context,
-                      GetTemporarySafe(context, node,
-                                       /*index=*/kTransposeKeyTempTensorIndex,
-                                       &scratch_buffer));
-    TfLiteIntArray* scratch_buffer_size = TfLiteIntArrayCreate(4);
-    for (int i = 0; i < 4; ++i) {
-      scratch_buffer_size->data[i] = k_tensor->dims->data[i];
-    }
-    // Swap to middle two dimensions.
-    scratch_buffer_size->data[1] = k_tensor->dims->data[2];
-    scratch_buffer_size->data[2] = k_tensor->dims->data[1];
-
-    scratch_buffer->type = kTfLiteFloat32;
-    scratch_buffer->allocation_type = kTfLiteArenaRw;
-    TF_LITE_ENSURE_OK(context, context->ResizeTensor(context, scratch_buffer,
-                                                     scratch_buffer_size));
-  }
-
-  TfLiteIntArray* add_broadcast_shape = nullptr;
-  // Temp tensor for Matmul1 output;
-  {
-    node->temporaries->data[kMatMul1TempTensorIndex] =
-        op_data->scratch_tensor_index + kMatMul1TempTensorIndex;
-    TfLiteTensor* scratch_buffer;
-    TF_LITE_ENSURE_OK(
-        context,
-        GetTemporarySafe(context, node,
-                         /*index=*/kMatMul1TempTensorIndex, &scratch_buffer));
-    TfLiteIntArray* scratch_buffer_size = TfLiteIntArrayCreate(4);
-    // mha/gqa: [permute_q[0], permute_q[1], permute_q[2], permute_k[2]]
-    int matmul_out_shape[4] = {q_tensor->dims->data[0], q_tensor->dims->data[2],
-                               q_tensor->dims->data[1],
-                               k_tensor->dims->data[1]};
-    for (int i = 0; i < 4; ++i) {
-      scratch_buffer_size->data[i] = matmul_out_shape[i];
-    }
-
-    scratch_buffer->type = kTfLiteFloat32;
-    scratch_buffer->allocation_type = kTfLiteArenaRw;
-    TF_LITE_ENSURE_OK(context, context->ResizeTensor(context, scratch_buffer,
-                                                     scratch_buffer_size));
-    // get dims from attention_mask, matmul1_out for add broadcast
-    CalculateShapeForBroadcast(context, mask_tensor, scratch_buffer,
-                               &add_broadcast_shape);
-  }
-
-  // Temp tensor for add output;
-  int add_out_shape[4];
-  {
-    node->temporaries->data[kAddTempTensorIndex] =
-        op_data->scratch_tensor_index + kAddTempTensorIndex;
-    TfLiteTensor* scratch_buffer;
-    TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node,
-                                                /*index=*/kAddTempTensorIndex,
-                                                &scratch_buffer));
-    TfLiteIntArray* scratch_buffer_size = add_broadcast_shape;
-    for (int i = 0; i < 4; ++i) {
-      add_out_shape[i] = scratch_buffer_size->data[i];
-    }
-
-    scratch_buffer->type = kTfLiteFloat32;
-    scratch_buffer->allocation_type = kTfLiteArenaRw;
-    TF_LITE_ENSURE_OK(context, context->ResizeTensor(context, scratch_buffer,
-                                                     scratch_buffer_size));
-  }
-
-  // Temp tensor for Transposed V;
-  {
-    node->temporaries->data[kTransposeValueTempTensorIndex] =
-        op_data->scratch_tensor_index + kTransposeValueTempTensorIndex;
-    TfLiteTensor* scratch_buffer;
-    TF_LITE_ENSURE_OK(context,
-                      GetTemporarySafe(context, node,
-                                       /*index=*/kTransposeValueTempTensorIndex,
-                                       &scratch_buffer));
-    TfLiteIntArray* scratch_buffer_size = TfLiteIntArrayCreate(4);
-    // Swap to {0, 2, 3, 1} dimensions.
-    scratch_buffer_size->data[0] = v_tensor->dims->data[0];
-    scratch_buffer_size->data[1] = v_tensor->dims->data[2];
-    scratch_buffer_size->data[2] = v_tensor->dims->data[3];
-    scratch_buffer_size->data[3] = v_tensor->dims->data[1];
-
-    scratch_buffer->type = kTfLiteFloat32;
-    scratch_buffer->allocation_type = kTfLiteArenaRw;
-    TF_LITE_ENSURE_OK(context, context->ResizeTensor(context, scratch_buffer,
-                                                     scratch_buffer_size));
-  }
-
-  // Temp tensor for Matmul2 output;
-  {
-    node->temporaries->data[kMatMul2TempTensorIndex] =
-        op_data->scratch_tensor_index + kMatMul2TempTensorIndex;
-    TfLiteTensor* scratch_buffer;
-    TF_LITE_ENSURE_OK(
-        context,
-        GetTemporarySafe(context, node,
-                         /*index=*/kMatMul2TempTensorIndex, &scratch_buffer));
-    TfLiteIntArray* scratch_buffer_size = TfLiteIntArrayCreate(4);
-    // logits_out_shape = add_out_shape
-    // mha/gqa: [logits_out[0], logits_out[1], logits_out[2], permute_v[2]]
-    scratch_buffer_size->data[0] = add_out_shape[0];
-    scratch_buffer_size->data[1] = add_out_shape[1];
-    scratch_buffer_size->data[2] = add_out_shape[2];
-    scratch_buffer_size->data[3] = v_tensor->dims->data[3];
-
-    scratch_buffer->type = kTfLiteFloat32;
-    scratch_buffer->allocation_type = kTfLiteArenaRw;
-    TF_LITE_ENSURE_OK(context, context->ResizeTensor(context, scratch_buffer,
-                                                     scratch_buffer_size));
-  }
-
-  // Temp tensor for Reshape K / Transpose Q;
-  {
-    node->temporaries->data[kReshape1TempTensorIndex] =
-        op_data->scratch_tensor_index + kReshape1TempTensorIndex;
-    TfLiteTensor* scratch_buffer;
-    TF_LITE_ENSURE_OK(
-        context,
-        GetTemporarySafe(context, node,
-                         /*index=*/kReshape1TempTensorIndex, &scratch_buffer));
-    TfLiteIntArray* scratch_buffer_size;
-    if (mqa)
-      scratch_buffer_size = TfLiteIntArrayCreate(2);
-    else
-      scratch_buffer_size = TfLiteIntArrayCreate(4);
-    if (mqa) {
-      scratch_buffer_size->data[0] = k_tensor->dims->data[1];
-      scratch_buffer_size->data[1] = k_tensor->dims->data[3];
-    } else {
-      scratch_buffer_size->data[0] = q_tensor->dims->data[0];
-      scratch_buffer_size->data[1] = q_tensor->dims->data[2];
-      scratch_buffer_size->data[2] = q_tensor->dims->data[3];
-      scratch_buffer_size->data[3] = q_tensor->dims->data[1];
-    }
-
-    scratch_buffer->type = kTfLiteFloat32;
-    scratch_buffer->allocation_type = kTfLiteArenaRw;
-    TF_LITE_ENSURE_OK(context, context->ResizeTensor(context, scratch_buffer,
-                                                     scratch_buffer_size));
-  }
-
-  // Temp tensor for Reshape V / Add_out (softmax_out);
-  {
-    node->temporaries->data[kReshape2TempTensorIndex] =
-        op_data->scratch_tensor_index + kReshape2TempTensorIndex;
-    TfLiteTensor* scratch_buffer;
-    TF_LITE_ENSURE_OK(
-        context,
-        GetTemporarySafe(context, node,
-                         /*index=*/kReshape2TempTensorIndex, &scratch_buffer));
-    TfLiteIntArray* scratch_buffer_size;
-    if (mqa)
-      scratch_buffer_size = TfLiteIntArrayCreate(2);
-    else
-      scratch_buffer_size = TfLiteIntArrayCreate(4);
-    if (mqa) {
-      scratch_buffer_size->data[0] = v_tensor->dims->data[3];
-      scratch_buffer_size->data[1] = v_tensor->dims->data[1];
-    } else {
-      scratch_buffer_size->data[0] = add_out_shape[0];
-      scratch_buffer_size->data[1] = add_out_shape[1];
-      scratch_buffer_size->data[2] = add_out_shape[3];
-      scratch_buffer_size->data[3] = add_out_shape[2];
-    }
-
-    scratch_buffer->type = kTfLiteFloat32;
-    scratch_buffer->allocation_type = kTfLiteArenaRw;
-    TF_LITE_ENSURE_OK(context, context->ResizeTensor(context, scratch_buffer,
-                                                     scratch_buffer_size));
-  }
-
-  // Temp tensor for Broadcast K
-  {
-    node->temporaries->data[kBroadcastKTempTensorIndex] =
-        op_data->scratch_tensor_index + kBroadcastKTempTensorIndex;
-    TfLiteTensor* scratch_buffer;
-    TF_LITE_ENSURE_OK(context,
-                      GetTemporarySafe(context, node,
-                                       /*index=*/kBroadcastKTempTensorIndex,
-                                       &scratch_buffer));
-    TfLiteIntArray* scratch_buffer_size = TfLiteIntArrayCreate(4);
-
-    scratch_buffer_size->data[0] = k_tensor->dims->data[0];
-    scratch_buffer_size->data[1] = q_tensor->dims->data[2];  // num_heads
-    scratch_buffer_size->data[2] = k_tensor->dims->data[1];
-    scratch_buffer_size->data[3] = k_tensor->dims->data[3];
-
-    scratch_buffer->type = kTfLiteFloat32;
-    scratch_buffer->allocation_type = kTfLiteArenaRw;
-    TF_LITE_ENSURE_OK(context, context->ResizeTensor(context, scratch_buffer,
-                                                     scratch_buffer_size));
-  }
-
-  // Temp tensor for Broadcast V
-  {
-    node->temporaries->data[kBroadcastVTempTensorIndex] =
-        op_data->scratch_tensor_index + kBroadcastVTempTensorIndex;
-    TfLiteTensor* scratch_buffer;
-    TF_LITE_ENSURE_OK(context,
-                      GetTemporarySafe(context, node,
-                                       /*index=*/kBroadcastVTempTensorIndex,
-                                       &scratch_buffer));
-    TfLiteIntArray* scratch_buffer_size = TfLiteIntArrayCreate(4);
-
-    scratch_buffer_size->data[0] = v_tensor->dims->data[0];
-    scratch_buffer_size->data[1] = q_tensor->dims->data[2];  // num_heads
-    scratch_buffer_size->data[2] = v_tensor->dims->data[3];
-    scratch_buffer_size->data[3] = v_tensor->dims->data[1];
-
-    scratch_buffer->type = kTfLiteFloat32;
-    scratch_buffer->allocation_type = kTfLiteArenaRw;
-    TF_LITE_ENSURE_OK(context, context->ResizeTensor(context, scratch_buffer,
-                                                     scratch_buffer_size));
-  }
-
   return kTfLiteOk;
 }
 
@@ -360,304 +378,79 @@ void SDPAFree(TfLiteContext* context, void* buffer) {
 
 TfLiteStatus SDPAEval(TfLiteContext* context, TfLiteNode* node) {
   /*
-  Simple implementation of Scaled Dot Product Attention.
+  Tiled implementation of Scaled Dot Product Attention.
   Takes query_proj, key_proj, value_proj, mask tensors as inputs, and
   outputs the attention result.
 
   Notes:
   Scale is computed using 1/sqrt(head_dim),
   head_dim = q[-1] = embedding_dim // num_q_heads
-  Only support for FLOAT32 inputs for now.
+  The queries, mask and output are FLOAT32, the keys and values FLOAT32,
+  FLOAT16 or INT8.
   Only support static tensors for now (k/v[1] = max sequence length)
   */
 
   const TfLiteTensor* query_tensor;
   TF_LITE_ENSURE_OK(context,
                     GetInputSafe(context, node, kQueryTensor, &query_tensor));
-  auto query_shape = GetTensorShape(query_tensor);
-  auto query_data = GetTensorData<float>(query_tensor);
   const TfLiteTensor* key_tensor;
   TF_LITE_ENSURE_OK(context,
                     GetInputSafe(context, node, kKeyTensor, &key_tensor));
-  auto key_shape = GetTensorShape(key_tensor);
-  auto key_data = GetTensorData<float>(key_tensor);
   const TfLiteTensor* value_tensor;
   TF_LITE_ENSURE_OK(context,
                     GetInputSafe(context, node, kValueTensor, &value_tensor));
-  auto value_shape = GetTensorShape(value_tensor);
-  auto value_data = GetTensorData<float>(value_tensor);
   const TfLiteTensor* attention_mask_tensor;
   TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, kAttentionMaskTensor,
                                           &attention_mask_tensor));
-  auto attention_mask_shape = GetTensorShape(attention_mask_tensor);
-  auto attention_mask_data = GetTensorData<float>(attention_mask_tensor);
   TfLiteTensor* output_tensor;
   TF_LITE_ENSURE_OK(
       context, GetOutputSafe(context, node, kOutputTensor, &output_tensor));
-  auto output_shape = GetTensorShape(output_tensor);
-  auto output_data = GetTensorData<float>(output_tensor);
-
-  // temporaries
-  TfLiteTensor* transpose_q_out_tensor;
-  TF_LITE_ENSURE_OK(
-      context,
-      GetTemporarySafe(context, node, /*index=*/kTransposeQueryTempTensorIndex,
-                       &transpose_q_out_tensor));
-  auto transpose_q_out_shape = GetTensorShape(transpose_q_out_tensor);
-  auto transpose_q_out_data = GetTensorData<float>(transpose_q_out_tensor);
-  TfLiteTensor* transpose_k_out_tensor;
-  TF_LITE_ENSURE_OK(
-      context,
-      GetTemporarySafe(context, node, /*index=*/kTransposeKeyTempTensorIndex,
-                       &transpose_k_out_tensor));
-  auto transpose_k_out_shape = GetTensorShape(transpose_k_out_tensor);
-  auto transpose_k_out_data = GetTensorData<float>(transpose_k_out_tensor);
-  TfLiteTensor* matmul1_out_tensor;
-  TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node,
-                                              /*index=*/kMatMul1TempTensorIndex,
-                                              &matmul1_out_tensor));
-  auto matmul1_out_shape = GetTensorShape(matmul1_out_tensor);
-  auto matmul1_out_data = GetTensorData<float>(matmul1_out_tensor);
-  TfLiteTensor* add_out_tensor;
-  TF_LITE_ENSURE_OK(
-      context, GetTemporarySafe(context, node, /*index=*/kAddTempTensorIndex,
-                                &add_out_tensor));
-  auto add_out_shape = GetTensorShape(add_out_tensor);
-  auto add_out_data = GetTensorData<float>(add_out_tensor);
-  TfLiteTensor* transpose_v_out_tensor;
-  TF_LITE_ENSURE_OK(
-      context,
-      GetTemporarySafe(context, node, /*index=*/kTransposeValueTempTensorIndex,
-                       &transpose_v_out_tensor));
-  auto transpose_v_out_shape = GetTensorShape(transpose_v_out_tensor);
-  auto transpose_v_out_data = GetTensorData<float>(transpose_v_out_tensor);
-  TfLiteTensor* matmul2_out_tensor;
-  TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node,
-                                              /*index=*/kMatMul2TempTensorIndex,
-                                              &matmul2_out_tensor));
-  auto matmul2_out_shape = GetTensorShape(matmul2_out_tensor);
-  auto matmul2_out_data = GetTensorData<float>(matmul2_out_tensor);
-  TfLiteTensor* reshape_k_or_q_out_tensor;
-  TF_LITE_ENSURE_OK(
-      context,
-      GetTemporarySafe(context, node, /*index=*/kReshape1TempTensorIndex,
-                       &reshape_k_or_q_out_tensor));
-  auto reshape_k_or_q_out_shape = GetTensorShape(reshape_k_or_q_out_tensor);
-  auto reshape_k_or_q_out_data =
-      GetTensorData<float>(reshape_k_or_q_out_tensor);
-  TfLiteTensor* reshape_v_or_add_out_tensor;
-  TF_LITE_ENSURE_OK(
-      context,
-      GetTemporarySafe(context, node, /*index=*/kReshape2TempTensorIndex,
-                       &reshape_v_or_add_out_tensor));
-  auto reshape_v_or_add_out_shape = GetTensorShape(reshape_v_or_add_out_tensor);
-  auto reshape_v_or_add_out_data =
-      GetTensorData<float>(reshape_v_or_add_out_tensor);
-  TfLiteTensor* broadcast_k_out_tensor;
-  TF_LITE_ENSURE_OK(
-      context,
-      GetTemporarySafe(context, node, /*index=*/kBroadcastKTempTensorIndex,
-                       &broadcast_k_out_tensor));
-  auto broadcast_k_out_shape = GetTensorShape(broadcast_k_out_tensor);
-  auto broadcast_k_out_data = GetTensorData<float>(broadcast_k_out_tensor);
-  TfLiteTensor* broadcast_v_out_tensor;
-  TF_LITE_ENSURE_OK(
-      context,
-      GetTemporarySafe(context, node, /*index=*/kBroadcastVTempTensorIndex,
-                       &broadcast_v_out_tensor));
-  auto broadcast_v_out_shape = GetTensorShape(broadcast_v_out_tensor);
-  auto broadcast_v_out_data = GetTensorData<float>(broadcast_v_out_tensor);
-
   OpData* op_data = reinterpret_cast<OpData*>(node->user_data);
 
-  bool mqa = key_tensor->dims->data[2] == 1;
-  bool gqa = !mqa && (key_tensor->dims->data[2] != query_tensor->dims->data[2]);
-
-  // scale * q
-  float scale = op_data->scale;
-  int flat_size = query_shape.FlatSize();
-  float output_min = -std::numeric_limits<float>::infinity();
-  float output_max = std::numeric_limits<float>::infinity();
-  for (int i = 0; i < flat_size; ++i) {
-    query_tensor->data.f[i] = ActivationFunctionWithMinMax(
-        query_tensor->data.f[i] * scale, output_min, output_max);
+  SDPAParams params;
+  params.batch_size = query_tensor->dims->data[0];
+  params.query_length = query_tensor->dims->data[1];
+  params.num_heads = query_tensor->dims->data[2];
+  params.head_dim = query_tensor->dims->data[3];
+  params.key_length = key_tensor->dims->data[1];
+  params.num_kv_heads = key_tensor->dims->data[2];
+  params.value_head_dim = value_tensor->dims->data[3];
+  params.scale = op_data->scale;
+  int64_t mask_stride = 1;
+  for (int i = 3; i >= 0; --i) {
+    const int dim = attention_mask_tensor->dims->data[i];
+    params.mask_strides[i] = dim == 1 ? 0 : mask_stride;
+    mask_stride *= dim;
   }
-
-  // permute q {0, 2, 1, 3}
-  tflite::TransposeParams transpose_q_params;
-  transpose_q_params.perm_count = 4;
-  transpose_q_params.perm[0] = 0;
-  transpose_q_params.perm[1] = 2;
-  transpose_q_params.perm[2] = 1;
-  transpose_q_params.perm[3] = 3;
-  reference_ops::Transpose(transpose_q_params, query_shape, query_data,
-                           transpose_q_out_shape, transpose_q_out_data);
-
-  // permute k {0, 2, 1, 3}
-  tflite::TransposeParams transpose_k_params;
-  transpose_k_params.perm_count = 4;
-  transpose_k_params.perm[0] = 0;
-  transpose_k_params.perm[1] = 2;
-  transpose_k_params.perm[2] = 1;
-  transpose_k_params.perm[3] = 3;
-  reference_ops::Transpose(transpose_k_params, key_shape, key_data,
-                           transpose_k_out_shape, transpose_k_out_data);
-
-  // broadcast k to match num_heads
-  // broadcasting similar to torch.repeat_interleave
-  if (gqa) {
-    float* transpose_k_ptr = transpose_k_out_data;
-    float* broadcast_k_ptr = broadcast_k_out_data;
-    int num_elements =
-        transpose_k_out_shape.Dims(2) * transpose_k_out_shape.Dims(3);
-    int num_repeat =
-        broadcast_k_out_shape.Dims(1) / transpose_k_out_shape.Dims(1);
-    for (int i = 0; i < transpose_k_out_shape.Dims(0); ++i) {
-      for (int j = 0; j < transpose_k_out_shape.Dims(1); ++j) {
-        for (int k = 0; k < num_repeat; ++k) {
-          memcpy(broadcast_k_ptr, transpose_k_ptr,
-                 num_elements * sizeof(float));
-          broadcast_k_ptr += num_elements;
-        }
-        transpose_k_ptr += num_elements;
-      }
-    }
-  }
-
-  // reshape k for MQA, or transpose q for MHA
-  if (mqa) {
-    TF_LITE_ENSURE_EQ(context, transpose_k_out_tensor->bytes,
-                      reshape_k_or_q_out_tensor->bytes);
-    memcpy(reshape_k_or_q_out_tensor->data.data,
-           transpose_k_out_tensor->data.data, transpose_k_out_tensor->bytes);
-  } else {
-    // permute q2 {0, 1, 3, 2}
-    tflite::TransposeParams transpose_q2_params;
-    transpose_q2_params.perm_count = 4;
-    transpose_q2_params.perm[0] = 0;
-    transpose_q2_params.perm[1] = 1;
-    transpose_q2_params.perm[2] = 3;
-    transpose_q2_params.perm[3] = 2;
-    reference_ops::Transpose(transpose_q2_params, transpose_q_out_shape,
-                             transpose_q_out_data, reshape_k_or_q_out_shape,
-                             reshape_k_or_q_out_data);
-  }
-
-  // mqa FC (q, squeezed_k)
-  // mha BMM(q, k) transpose_b = true
-  if (mqa) {
-    tflite::FullyConnectedParams fc_params;
-    fc_params.float_activation_min = output_min;
-    fc_params.float_activation_max = output_max;
-    reference_ops::FullyConnected(
-        fc_params, transpose_q_out_shape, transpose_q_out_data,
-        reshape_k_or_q_out_shape, reshape_k_or_q_out_data, RuntimeShape(),
-        nullptr, matmul1_out_shape, matmul1_out_data);
-  } else if (gqa) {
-    // pass rhs first (this is why we transpose q above)
-    reference_ops::BatchMatMul(
-        broadcast_k_out_shape, broadcast_k_out_data, reshape_k_or_q_out_shape,
-        reshape_k_or_q_out_data, matmul1_out_shape, matmul1_out_data);
-  } else {
-    reference_ops::BatchMatMul(
-        transpose_k_out_shape, transpose_k_out_data, reshape_k_or_q_out_shape,
-        reshape_k_or_q_out_data, matmul1_out_shape, matmul1_out_data);
+  TF_LITE_ENSURE_EQ(context, NumElements(output_tensor),
+                    static_cast<int64_t>(params.batch_size) *
+                        params.query_length * params.num_heads *
+                        params.value_head_dim);
+
+  const float* query = GetTensorData<float>(query_tensor);
+  const float* mask = GetTensorData<float>(attention_mask_tensor);
+  float* output = GetTensorData<float>(output_tensor);
+  CpuBackendContext* cpu_backend_context =
+      CpuBackendContext::GetFromContext(context);
+  switch (key_tensor->type) {
+    case kTfLiteFloat32:
+      RunSDPA<float>(params, query, key_tensor, value_tensor, mask, output,
+                     cpu_backend_context);
+      break;
+    case kTfLiteFloat16:
+      RunSDPA<uint16_t>(params, query, key_tensor, value_tensor, mask, output,
+                        cpu_backend_context);
+      break;
+    case kTfLiteInt8:
+      RunSDPA<int8_t>(params, query, key_tensor, value_tensor, mask, output,
+                      cpu_backend_context);
+      break;
+    default:
+      TF_LITE_KERNEL_LOG(context, "Unsupported key and value type %s.",
+                         TfLiteTypeGetName(key_tensor->type));
+      return kTfLiteError;
   }
 
-  // add matmul_out + mask
-  tflite::ArithmeticParams add_params;
-  SetActivationParams(output_min, output_max, &add_params);
-  reference_ops::BroadcastAdd6DSlow(
-      add_params, attention_mask_shape, attention_mask_data, matmul1_out_shape,
-      matmul1_out_data, add_out_shape, add_out_data);
-
-  // softmax, can do in-place
-  tflite::SoftmaxParams softmax_params;
-  softmax_params.beta = 1.0f;
-  reference_ops::Softmax(softmax_params, add_out_shape, add_out_data,
-                         add_out_shape, add_out_data);
-
-  // permute v {0, 2, 3, 1}
-  tflite::TransposeParams transpose_v_params;
-  transpose_v_params.perm_count = 4;
-  transpose_v_params.perm[0] = 0;
-  transpose_v_params.perm[1] = 2;
-  transpose_v_params.perm[2] = 3;
-  transpose_v_params.perm[3] = 1;
-  reference_ops::Transpose(transpose_v_params, value_shape, value_data,
-                           transpose_v_out_shape, transpose_v_out_data);
-
-  // broadcast v to match num_heads
-  // broadcasting similar to torch.repeat_interleave
-  if (gqa) {
-    float* transpose_v_ptr = transpose_v_out_data;
-    float* broadcast_v_ptr = broadcast_v_out_data;
-    int num_elements =
-        transpose_v_out_shape.Dims(2) * transpose_v_out_shape.Dims(3);
-    int num_repeat =
-        broadcast_v_out_shape.Dims(1) / transpose_v_out_shape.Dims(1);
-    for (int i = 0; i < transpose_v_out_shape.Dims(0); ++i) {
-      for (int j = 0; j < transpose_v_out_shape.Dims(1); ++j) {
-        for (int k = 0; k < num_repeat; ++k) {
-          memcpy(broadcast_v_ptr, transpose_v_ptr,
-                 num_elements * sizeof(float));
-          broadcast_v_ptr += num_elements;
-        }
-        transpose_v_ptr += num_elements;
-      }
-    }
-  }
-
-  // reshape v for MQA, or add_out (softmax_out)
-  if (mqa) {
-    TF_LITE_ENSURE_EQ(context, transpose_v_out_tensor->bytes,
-                      reshape_v_or_add_out_tensor->bytes);
-    memcpy(reshape_v_or_add_out_tensor->data.data,
-           transpose_v_out_tensor->data.data, transpose_v_out_tensor->bytes);
-  } else {
-    // permute softmax_out {0, 1, 3, 2}
-    tflite::TransposeParams transpose_softmax_out_params;
-    transpose_softmax_out_params.perm_count = 4;
-    transpose_softmax_out_params.perm[0] = 0;
-    transpose_softmax_out_params.perm[1] = 1;
-    transpose_softmax_out_params.perm[2] = 3;
-    transpose_softmax_out_params.perm[3] = 2;
-    reference_ops::Transpose(transpose_softmax_out_params, add_out_shape,
-                             add_out_data, reshape_v_or_add_out_shape,
-                             reshape_v_or_add_out_data);
-  }
-
-  // mqa FC (softmax_out, squeezed_v)
-  // mha BMM(softmax_out, v) transpose_b = true
-  if (mqa) {
-    tflite::FullyConnectedParams fc_params;
-    fc_params.float_activation_min = output_min;
-    fc_params.float_activation_max = output_max;
-    reference_ops::FullyConnected(fc_params, add_out_shape, add_out_data,
-                                  reshape_v_or_add_out_shape,
-                                  reshape_v_or_add_out_data, RuntimeShape(),
-                                  nullptr, matmul2_out_shape, matmul2_out_data);
-  } else if (gqa) {
-    // pass rhs first (this is why we transpose add_out above)
-    reference_ops::BatchMatMul(
-        broadcast_v_out_shape, broadcast_v_out_data, reshape_v_or_add_out_shape,
-        reshape_v_or_add_out_data, matmul2_out_shape, matmul2_out_data);
-  } else {
-    reference_ops::BatchMatMul(
-        transpose_v_out_shape, transpose_v_out_data, reshape_v_or_add_out_shape,
-        reshape_v_or_add_out_data, matmul2_out_shape, matmul2_out_data);
-  }
-
-  // permute out {0, 2, 1, 3}
-  tflite::TransposeParams transpose_out_params;
-  transpose_out_params.perm_count = 4;
-  transpose_out_params.perm[0] = 0;
-  transpose_out_params.perm[1] = 2;
-  transpose_out_params.perm[2] = 1;
-  transpose_out_params.perm[3] = 3;
-  reference_ops::Transpose(transpose_out_params, matmul2_out_shape,
-                           matmul2_out_data, output_shape, output_data);
-
   return kTfLiteOk;
 }
 
@@ -0,0 +1,236 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "flatbuffers/flexbuffers.h"
+#include "tflite/experimental/genai/genai_ops.h"
+#include "tflite/kernels/test_util.h"
+#include "tflite/schema/schema_generated.h"
+
+namespace tflite {
+namespace {
+
+using ::testing::FloatNear;
+using ::testing::Pointwise;
+
+class SDPAOpModel : public SingleOpModel {
+ public:
+  SDPAOpModel(const TensorData& query, const TensorData& key,
+              const TensorData& value, const TensorData& mask) {
+    query_ = AddInput(query);
+    key_ = AddInput(key);
+    value_ = AddInput(value);
+    mask_ = AddInput(mask);
+    // The output is (B, T, N, H_v).
+    output_ = AddOutput({TensorType_FLOAT32,
+                         {query.shape[0], query.shape[1], query.shape[2],
+                          value.shape[3]}});
+
+    flexbuffers::Builder fbb;
+    fbb.Map([&]() { fbb.Float("scale", 0.0f); });
+    fbb.Finish();
+    SetCustomOp("SDPA", fbb.GetBuffer(), ops::custom::Register_SDPA);
+    BuildInterpreter({GetShape(query_), GetShape(key_), GetShape(value_),
+                      GetShape(mask_)});
+  }
+
+  int query() const { return query_; }
+  int key() const { return key_; }
+  int value() const { return value_; }
+  int mask() const { return mask_; }
+  std::vector<float> GetOutput() { return ExtractVector<float>(output_); }
+
+ private:
+  int query_;
+  int key_;
+  int value_;
+  int mask_;
+  int output_;
+};
+
+std::vector<float> RandomValues(int size, int seed) {
+  std::mt19937 random_engine(seed);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  std::vector<float> values(size);
+  for (float& value : values) {
+    value = distribution(random_engine);
+  }
+  return values;
+}
+
+// Computes the attention of q (B, T, N, H) over k (B, S, N_kv, H) and
+// v (B, S, N_kv, H) with a (1, 1, T, S) mask, materializing the scores.
+std::vector<float> ReferenceSDPA(const std::vector<float>& q,
+                                 const std::vector<float>& k,
+                                 const std::vector<float>& v,
+                                 const std::vector<float>& mask, int batch,
+                                 int query_length, int key_length,
+                                 int num_heads, int num_kv_heads,
+                                 int head_dim) {
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_dim));
+  const int heads_per_kv_head = num_heads / num_kv_heads;
+  std::vector<float> output(batch * query_length * num_heads * head_dim);
+  std::vector<float> scores(key_length);
+  for (int b = 0; b < batch; ++b) {
+    for (int t = 0; t < query_length; ++t) {
+      for (int h = 0; h < num_heads; ++h) {
+        const int kv_h = h / heads_per_kv_head;
+        float max_score = -std::numeric_limits<float>::infinity();
+        for (int s = 0; s < key_length; ++s) {
+          float dot = 0.0f;
+          for (int d = 0; d < head_dim; ++d) {
+            dot += q[((b * query_length + t) * num_heads + h) * head_dim + d] *
+                   k[((b * key_length + s) * num_kv_heads + kv_h) * head_dim +
+                     d];
+          }
+          scores[s] = dot * scale + mask[t * key_length + s];
+          max_score = std::max(max_score, scores[s]);
+        }
+        float sum = 0.0f;
+        for (float& score : scores) {
+          score = std::exp(score - max_score);
+          sum += score;
+        }
+        for (int d = 0; d < head_dim; ++d) {
+          float result = 0.0f;
+          for (int s = 0; s < key_length; ++s) {
+            result +=
+                scores[s] / sum *
+                v[((b * key_length + s) * num_kv_heads + kv_h) * head_dim + d];
+          }
+          output[((b * query_length + t) * num_heads + h) * head_dim + d] =
+              result;
+        }
+      }
+    }
+  }
+  return output;
+}
+
+// A causal mask for the last `query_length` positions of `key_length` ones.
+std::vector<float> CausalMask(int query_length, int key_length) {
+  std::vector<float> mask(query_length * key_length, 0.0f);
+  for (int t = 0; t < query_length; ++t) {
+    for (int s = key_length - query_length + t + 1; s < key_length; ++s) {
+      mask[t * key_length + s] = -std::numeric_limits<float>::infinity();
+    }
+  }
+  return mask;
+}
+
+struct SDPATestParams {
+  int batch;
+  int query_length;
+  int key_length;
+  int num_heads;
+  int num_kv_heads;
+  int head_dim;
+};
+
+class SDPAOpTest : public ::testing::TestWithParam<SDPATestParams> {};
+
+TEST_P(SDPAOpTest, MatchesReference) {
+  const SDPATestParams& p = GetParam();
+  const std::vector<int> query_shape = {p.batch, p.query_length, p.num_heads,
+                                        p.head_dim};
+  const std::vector<int> kv_shape = {p.batch, p.key_length, p.num_kv_heads,
+                                     p.head_dim};
+  const std::vector<int> mask_shape = {1, 1, p.query_length, p.key_length};
+  SDPAOpModel m({TensorType_FLOAT32, query_shape},
+                {TensorType_FLOAT32, kv_shape},
+                {TensorType_FLOAT32, kv_shape},
+                {TensorType_FLOAT32, mask_shape});
+  const std::vector<float> q = RandomValues(
+      p.batch * p.query_length * p.num_heads * p.head_dim, /*seed=*/1);
+  const std::vector<float> k = RandomValues(
+      p.batch * p.key_length * p.num_kv_heads * p.head_dim, /*seed=*/2);
+  const std::vector<float> v = RandomValues(
+      p.batch * p.key_length * p.num_kv_heads * p.head_dim, /*seed=*/3);
+  const std::vector<float> mask = CausalMask(p.query_length, p.key_length);
+  m.PopulateTensor(m.query(), q);
+  m.PopulateTensor(m.key(), k);
+  m.PopulateTensor(m.value(), v);
+  m.PopulateTensor(m.mask(), mask);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutput(),
+              Pointwise(FloatNear(1e-5),
+                        ReferenceSDPA(q, k, v, mask, p.batch, p.query_length,
+                                      p.key_length, p.num_heads,
+                                      p.num_kv_heads, p.head_dim)));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SDPAOpTests, SDPAOpTest,
+    testing::ValuesIn({
+        // Multi-head attention, decode.
+        SDPATestParams{/*batch=*/1, /*query_length=*/1, /*key_length=*/300,
+                       /*num_heads=*/4, /*num_kv_heads=*/4, /*head_dim=*/8},
+        // Grouped-query attention, prefill over several key blocks.
+        SDPATestParams{/*batch=*/2, /*query_length=*/40, /*key_length=*/260,
+                       /*num_heads=*/8, /*num_kv_heads=*/2, /*head_dim=*/16},
+        // Multi-query attention.
+        SDPATestParams{/*batch=*/1, /*query_length=*/17, /*key_length=*/64,
+                       /*num_heads=*/4, /*num_kv_heads=*/1, /*head_dim=*/8},
+    }));
+
+TEST(SDPAOpTest, Int8KeysAndValues) {
+  constexpr int kKeyLength = 130;
+  constexpr int kNumHeads = 2;
+  constexpr int kHeadDim = 4;
+  constexpr float kScale = 0.01f;
+  constexpr int32_t kZeroPoint = 5;
+  const std::vector<int> query_shape = {1, 3, kNumHeads, kHeadDim};
+  const std::vector<int> kv_shape = {1, kKeyLength, kNumHeads, kHeadDim};
+  SDPAOpModel m({TensorType_FLOAT32, query_shape},
+                {TensorType_INT8, kv_shape, 0.0f, 0.0f, kScale, kZeroPoint},
+                {TensorType_INT8, kv_shape, 0.0f, 0.0f, kScale, kZeroPoint},
+                {TensorType_FLOAT32, {1, 1, 3, kKeyLength}});
+  const int kv_size = kKeyLength * kNumHeads * kHeadDim;
+  std::vector<int8_t> k_quantized(kv_size);
+  std::vector<int8_t> v_quantized(kv_size);
+  std::vector<float> k(kv_size);
+  std::vector<float> v(kv_size);
+  for (int i = 0; i < kv_size; ++i) {
+    k_quantized[i] = static_cast<int8_t>(i * 7 % 200 - 100);
+    v_quantized[i] = static_cast<int8_t>(i * 13 % 200 - 100);
+    k[i] = kScale * (k_quantized[i] - kZeroPoint);
+    v[i] = kScale * (v_quantized[i] - kZeroPoint);
+  }
+  const std::vector<float> q =
+      RandomValues(3 * kNumHeads * kHeadDim, /*seed=*/4);
+  const std::vector<float> mask = CausalMask(3, kKeyLength);
+  m.PopulateTensor(m.query(), q);
+  m.PopulateTensor(m.key(), k_quantized);
+  m.PopulateTensor(m.value(), v_quantized);
+  m.PopulateTensor(m.mask(), mask);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutput(),
+              Pointwise(FloatNear(1e-5),
+                        ReferenceSDPA(q, k, v, mask, /*batch=*/1,
+                                      /*query_length=*/3, kKeyLength,
+                                      kNumHeads, kNumHeads, kHeadDim)));
+}
+
+}  // namespace
+}  // namespace tflite
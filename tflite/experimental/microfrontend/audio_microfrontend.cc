@@ -42,6 +42,10 @@ typedef struct {
   bool zero_padding;
   int out_scale;
   bool out_float;
+  // If true, the frontend state is kept between invocations, so that each
+  // one continues the signal of the previous one and outputs the frames
+  // completed by its samples.
+  bool streaming;
 } TfLiteAudioMicrofrontendParams;
 
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
@@ -79,6 +83,7 @@ void* Init(TfLiteContext* context, const char* buffer, size_t length) {
   data->zero_padding = m["zero_padding"].AsBool();
   data->out_scale = m["out_scale"].AsInt32();
   data->out_float = m["out_float"].AsBool();
+  data->streaming = m["streaming"].AsBool();
 
   return data;
 }
@@ -111,6 +116,16 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
     output->type = kTfLiteFloat32;
   }
 
+  if (data->streaming) {
+    // Frames are not stacked across invocations, and their number depends
+    // on the samples buffered by the previous ones.
+    TF_LITE_ENSURE_EQ(context, data->left_context, 0);
+    TF_LITE_ENSURE_EQ(context, data->right_context, 0);
+    TF_LITE_ENSURE_EQ(context, data->frame_stride, 1);
+    SetTensorToDynamic(output);
+    return kTfLiteOk;
+  }
+
   TfLiteIntArray* output_size = TfLiteIntArrayCreate(2);
   int num_frames = 0;
   if (input->dims->data[0] >= data->state->window.size) {
@@ -126,22 +141,22 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
 }
 
 template <typename T>
-void GenerateFeatures(TfLiteAudioMicrofrontendParams* data,
-                      const TfLiteTensor* input, TfLiteTensor* output) {
+TfLiteStatus GenerateFeatures(TfLiteContext* context,
+                              TfLiteAudioMicrofrontendParams* data,
+                              const TfLiteTensor* input,
+                              TfLiteTensor* output) {
   const int16_t* audio_data = GetTensorData<int16_t>(input);
   int64_t audio_size = input->dims->data[0];
 
-  T* filterbanks_flat = GetTensorData<T>(output);
-
   int num_frames = 0;
   if (audio_size >= data->state->window.size) {
     num_frames = (input->dims->data[0] - data->state->window.size) /
                      data->state->window.step +
                  1;
   }
-  std::vector<std::vector<T>> frame_buffer(num_frames);
+  std::vector<std::vector<T>> frame_buffer;
+  frame_buffer.reserve(num_frames);
 
-  int frame_index = 0;
   while (audio_size > 0) {
     size_t num_samples_read;
     struct FrontendOutput output = FrontendProcessSamples(
@@ -150,16 +165,25 @@ void GenerateFeatures(TfLiteAudioMicrofrontendParams* data,
     audio_size -= num_samples_read;
 
     if (output.values != nullptr) {
-      frame_buffer[frame_index].reserve(output.size);
+      frame_buffer.emplace_back();
+      frame_buffer.back().reserve(output.size);
       int i;
       for (i = 0; i < output.size; ++i) {
-        frame_buffer[frame_index].push_back(static_cast<T>(output.values[i]) /
-                                            data->out_scale);
+        frame_buffer.back().push_back(static_cast<T>(output.values[i]) /
+                                      data->out_scale);
       }
-      ++frame_index;
     }
   }
 
+  if (data->streaming) {
+    TfLiteIntArray* output_size = TfLiteIntArrayCreate(2);
+    output_size->data[0] = frame_buffer.size();
+    output_size->data[1] = data->state->filterbank.num_channels;
+    TF_LITE_ENSURE_OK(context,
+                      context->ResizeTensor(context, output, output_size));
+  }
+  T* filterbanks_flat = GetTensorData<T>(output);
+
   int index = 0;
   std::vector<T> pad(data->state->filterbank.num_channels, 0);
   int anchor;
@@ -182,12 +206,15 @@ void GenerateFeatures(TfLiteAudioMicrofrontendParams* data,
       }
     }
   }
+  return kTfLiteOk;
 }
 
 TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   auto* data =
       reinterpret_cast<TfLiteAudioMicrofrontendParams*>(node->user_data);
-  FrontendReset(data->state);
+  if (!data->streaming) {
+    FrontendReset(data->state);
+  }
 
   const TfLiteTensor* input;
   TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, kInputTensor, &input));
@@ -196,12 +223,9 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
                     GetOutputSafe(context, node, kOutputTensor, &output));
 
   if (data->out_float) {
-    GenerateFeatures<float>(data, input, output);
-  } else {
-    GenerateFeatures<int32>(data, input, output);
+    return GenerateFeatures<float>(context, data, input, output);
   }
-
-  return kTfLiteOk;
+  return GenerateFeatures<int32>(context, data, input, output);
 }
 
 }  // namespace audio_microfrontend
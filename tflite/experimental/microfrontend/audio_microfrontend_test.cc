@@ -38,7 +38,8 @@ class MicroFrontendOpModel : public SingleOpModel {
   MicroFrontendOpModel(int n_input, int n_frame, int n_frequency_per_frame,
                        int n_left_context, int n_right_context,
                        int n_frame_stride,
-                       const std::vector<std::vector<int>>& input_shapes)
+                       const std::vector<std::vector<int>>& input_shapes,
+                       bool streaming = false)
       : n_input_(n_input),
         n_frame_(n_frame),
         n_frequency_per_frame_(n_frequency_per_frame),
@@ -76,6 +77,7 @@ class MicroFrontendOpModel : public SingleOpModel {
       fbb.Bool("zero_padding", true);
       fbb.Int("out_scale", 1);
       fbb.Bool("out_float", false);
+      fbb.Bool("streaming", streaming);
     });
     fbb.Finish();
     SetCustomOp("MICRO_FRONTEND", fbb.GetBuffer(),
@@ -88,6 +90,7 @@ class MicroFrontendOpModel : public SingleOpModel {
   }
 
   std::vector<int> GetOutput() { return ExtractVector<int>(output_); }
+  std::vector<int> GetOutputShape() { return GetTensorShape(output_); }
 
   int num_inputs() { return n_input_; }
   int num_frmes() { return n_frame_; }
@@ -193,6 +196,29 @@ TEST_F(TwoConsecutive36InputsMicroFrontendTest, MicroFrontendBlackBoxTest) {
                 &micro_frontend);
 }
 
+TEST_F(TwoConsecutive36InputsMicroFrontendTest, StreamingTest) {
+  const int n_input = 18;
+  MicroFrontendOpModel micro_frontend(n_input, 0, 2, 0, 0, 1,
+                                      {
+                                          {n_input},
+                                      },
+                                      /*streaming=*/true);
+
+  // The first half does not fill a window yet.
+  micro_frontend.SetInput(std::vector<int16_t>(
+      micro_frontend_input_.begin(), micro_frontend_input_.begin() + n_input));
+  ASSERT_EQ(micro_frontend.Invoke(), kTfLiteOk);
+  EXPECT_THAT(micro_frontend.GetOutputShape(), ElementsAreArray({0, 2}));
+
+  // The second half completes the same frames as the whole input does.
+  micro_frontend.SetInput(std::vector<int16_t>(
+      micro_frontend_input_.begin() + n_input, micro_frontend_input_.end()));
+  ASSERT_EQ(micro_frontend.Invoke(), kTfLiteOk);
+  EXPECT_THAT(micro_frontend.GetOutputShape(), ElementsAreArray({2, 2}));
+  EXPECT_THAT(micro_frontend.GetOutput(),
+              ElementsAreArray({479, 425, 436, 378}));
+}
+
 }  // namespace
 }  // namespace custom
 }  // namespace ops
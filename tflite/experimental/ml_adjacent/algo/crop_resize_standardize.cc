@@ -0,0 +1,300 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/experimental/ml_adjacent/algo/crop_resize_standardize.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "tflite/experimental/ml_adjacent/lib.h"
+#include "tflite/kernels/internal/compatibility.h"
+
+namespace ml_adj {
+namespace crop_resize_standardize {
+namespace {
+
+using ::ml_adj::algo::Algo;
+using ::ml_adj::algo::InputPack;
+using ::ml_adj::algo::OutputPack;
+using ::ml_adj::data::DataRef;
+using ::ml_adj::data::MutableDataRef;
+
+constexpr float kYuv2RgbKernel[] = {1.0f,         0.0f,
+                                    1.13988303f,  //
+                                    1.0f,         -0.394642334f,
+                                    -0.58062185f,  //
+                                    1.0f,         2.03206185f,   0.0f};
+
+// Calculates the bilinear interpolation bounds of `value` and the weight of
+// the upper one, as `Resize` does.
+inline void ComputeInterpolationValues(dim_t value, float scale,
+                                       dim_t input_size, float& frac,
+                                       dim_t& lower_bound,
+                                       dim_t& upper_bound) {
+  const float scaled_value = value * scale;
+  const float scaled_value_floor = std::floor(scaled_value);
+  lower_bound = static_cast<dim_t>(scaled_value_floor);
+  upper_bound =
+      std::min(static_cast<dim_t>(std::ceil(scaled_value)), input_size - 1);
+  frac = scaled_value - scaled_value_floor;
+}
+
+// The offsets in a source row of the two pixels each output column is
+// interpolated from, and the weight of the second one. They are the same for
+// all the rows, so they are computed once.
+struct ColumnTaps {
+  std::vector<dim_t> lower_offset;
+  std::vector<dim_t> upper_offset;
+  std::vector<float> frac;
+};
+
+ColumnTaps ComputeColumnTaps(dim_t target_width, dim_t new_width,
+                             dim_t num_channels) {
+  const float width_scale = static_cast<float>(target_width) / new_width;
+  ColumnTaps taps;
+  taps.lower_offset.resize(new_width);
+  taps.upper_offset.resize(new_width);
+  taps.frac.resize(new_width);
+  for (dim_t x = 0; x < new_width; ++x) {
+    dim_t x0 = 0;
+    dim_t x1 = 0;
+    ComputeInterpolationValues(x, width_scale, target_width, taps.frac[x], x0,
+                               x1);
+    taps.lower_offset[x] = x0 * num_channels;
+    taps.upper_offset[x] = x1 * num_channels;
+  }
+  return taps;
+}
+
+// Interpolates one source row to the output width.
+inline void ResizeRow(const float* row, dim_t num_channels, dim_t new_width,
+                      const ColumnTaps& taps, float* output_row) {
+  for (dim_t x = 0; x < new_width; ++x) {
+    const float* lower = row + taps.lower_offset[x];
+    const float* upper = row + taps.upper_offset[x];
+    const float frac = taps.frac[x];
+    for (dim_t c = 0; c < num_channels; ++c) {
+      output_row[c] = lower[c] + (upper[c] - lower[c]) * frac;
+    }
+    output_row += num_channels;
+  }
+}
+
+// Crops and resizes one image to `output_data`, converting it to RGB if
+// `kYuvToRgb`, and accumulates the sum and the sum of squares of the output
+// values.
+//
+// Each source row is interpolated horizontally once, into one of the two
+// rows of `row_buffer`, and consecutive output rows reuse them. Each output
+// row is then a contiguous blend of two of them.
+template <bool kYuvToRgb>
+void CropResizeImage(const float* img_data, dim_t img_width,
+                     dim_t num_channels, dim_t offset_height,
+                     dim_t offset_width, dim_t target_height,
+                     dim_t new_height, dim_t new_width, const ColumnTaps& taps,
+                     float* row_buffer, float* output_data, double& sum,
+                     double& sum_squares) {
+  const float height_scale = static_cast<float>(target_height) / new_height;
+  const dim_t in_row_size = img_width * num_channels;
+  const dim_t row_size = new_width * num_channels;
+  const float* crop_data =
+      img_data + offset_height * in_row_size + offset_width * num_channels;
+
+  float* rows[2] = {row_buffer, row_buffer + row_size};
+  int64_t cached_rows[2] = {-1, -1};
+
+  for (dim_t y = 0; y < new_height; ++y) {
+    float frac = 0.0f;
+    dim_t y0 = 0;
+    dim_t y1 = 0;
+    ComputeInterpolationValues(y, height_scale, target_height, frac, y0, y1);
+
+    if (cached_rows[0] != y0) {
+      if (cached_rows[1] == y0) {
+        std::swap(rows[0], rows[1]);
+        std::swap(cached_rows[0], cached_rows[1]);
+      } else {
+        ResizeRow(crop_data + y0 * in_row_size, num_channels, new_width, taps,
+                  rows[0]);
+        cached_rows[0] = y0;
+      }
+    }
+    if (y1 != y0 && cached_rows[1] != y1) {
+      ResizeRow(crop_data + y1 * in_row_size, num_channels, new_width, taps,
+                rows[1]);
+      cached_rows[1] = y1;
+    }
+    const float* top = rows[0];
+    const float* bottom = y1 == y0 ? rows[0] : rows[1];
+
+    float* output_row = output_data + y * row_size;
+    for (dim_t i = 0; i < row_size; ++i) {
+      output_row[i] = top[i] + (bottom[i] - top[i]) * frac;
+    }
+
+    if (kYuvToRgb) {
+      const float* k = kYuv2RgbKernel;
+      for (dim_t i = 0; i < row_size; i += 3) {
+        const float y_value = output_row[i];
+        const float u_value = output_row[i + 1];
+        const float v_value = output_row[i + 2];
+        output_row[i] = k[0] * y_value + k[1] * u_value + k[2] * v_value;
+        output_row[i + 1] = k[3] * y_value + k[4] * u_value + k[5] * v_value;
+        output_row[i + 2] = k[6] * y_value + k[7] * u_value + k[8] * v_value;
+      }
+    }
+
+    float row_sum = 0.0f;
+    float row_sum_squares = 0.0f;
+    for (dim_t i = 0; i < row_size; ++i) {
+      row_sum += output_row[i];
+      row_sum_squares += output_row[i] * output_row[i];
+    }
+    sum += row_sum;
+    sum_squares += row_sum_squares;
+  }
+}
+
+// Returns the mean of the image values and the inverse of their adjusted
+// standard deviation, as `PerImageStandardization` does.
+inline std::pair<float, float> ComputeMoments(double sum, double sum_squares,
+                                              dim_t num_values) {
+  const double mean = sum / num_values;
+  const double variance =
+      std::max(0.0, sum_squares / num_values - mean * mean);
+  const float inv_adjusted_stddev =
+      fmin(num_values, 1.0f / std::sqrt(static_cast<float>(variance)));
+  return {static_cast<float>(mean), inv_adjusted_stddev};
+}
+
+template <typename T>
+void Quantize(const float* input_data, ind_t num_values, float mean,
+              float multiplier, int32_t zero_point, T* output_data) {
+  const float min = std::numeric_limits<T>::min();
+  const float max = std::numeric_limits<T>::max();
+  for (ind_t i = 0; i < num_values; ++i) {
+    const float value =
+        std::round((input_data[i] - mean) * multiplier) + zero_point;
+    output_data[i] = static_cast<T>(std::min(std::max(value, min), max));
+  }
+}
+
+// Crops, resizes and standardizes given input. Supports `float` input and
+// `float`, `int8` or `uint8` output.
+template <bool kYuvToRgb>
+void ComputeCropResizeStandardize(const InputPack& inputs,
+                                  const OutputPack& outputs) {
+  TFLITE_DCHECK(inputs.size() == 6 || inputs.size() == 8);
+  TFLITE_DCHECK(outputs.size() == 1);
+
+  // Extract input image data.
+  const DataRef* img = inputs[0];
+  const float* img_data = reinterpret_cast<const float*>(img->Data());
+  const dim_t img_num_batches = img->Dims()[0];
+  const dim_t img_height = img->Dims()[1];
+  const dim_t img_width = img->Dims()[2];
+  const dim_t img_num_channels = img->Dims()[3];
+  TFLITE_DCHECK(!kYuvToRgb || img_num_channels == 3);
+
+  // Extract bounding box.
+  const dim_t offset_height =
+      *reinterpret_cast<const dim_t*>(inputs[1]->Data());
+  const dim_t offset_width = *reinterpret_cast<const dim_t*>(inputs[2]->Data());
+  const dim_t target_height =
+      *reinterpret_cast<const dim_t*>(inputs[3]->Data());
+  const dim_t target_width = *reinterpret_cast<const dim_t*>(inputs[4]->Data());
+  TFLITE_DCHECK(offset_height + target_height <= img_height);
+  TFLITE_DCHECK(offset_width + target_width <= img_width);
+
+  // Extract new image size.
+  const dim_t* size_data = reinterpret_cast<const dim_t*>(inputs[5]->Data());
+  const dim_t new_height = size_data[0];
+  const dim_t new_width = size_data[1];
+
+  // Resize output buffer.
+  MutableDataRef* output = outputs[0];
+  output->Resize({img_num_batches, new_height, new_width, img_num_channels});
+
+  const bool quantize = output->Type() != etype_t::f32;
+  float scale = 1.0f;
+  int32_t zero_point = 0;
+  if (quantize) {
+    TFLITE_DCHECK(inputs.size() == 8);
+    scale = *reinterpret_cast<const float*>(inputs[6]->Data());
+    zero_point = *reinterpret_cast<const int32_t*>(inputs[7]->Data());
+  }
+
+  const ColumnTaps taps =
+      ComputeColumnTaps(target_width, new_width, img_num_channels);
+  const dim_t img_size = img_height * img_width * img_num_channels;
+  const dim_t output_size = new_height * new_width * img_num_channels;
+  std::vector<float> row_buffer(2 * new_width * img_num_channels);
+  // Quantized outputs are computed in float first, since standardization
+  // needs the moments of the whole image.
+  std::vector<float> float_buffer(quantize ? output_size : 0);
+
+  for (dim_t b = 0; b < img_num_batches; ++b) {
+    float* float_data =
+        quantize ? float_buffer.data()
+                 : reinterpret_cast<float*>(output->Data()) + b * output_size;
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    CropResizeImage<kYuvToRgb>(img_data + b * img_size, img_width,
+                               img_num_channels, offset_height, offset_width,
+                               target_height, new_height, new_width, taps,
+                               row_buffer.data(), float_data, sum,
+                               sum_squares);
+
+    const auto [mean, inv_adjusted_stddev] =
+        ComputeMoments(sum, sum_squares, output_size);
+    switch (output->Type()) {
+      case etype_t::i8:
+        Quantize(float_data, output_size, mean, inv_adjusted_stddev / scale,
+                 zero_point,
+                 reinterpret_cast<int8_t*>(output->Data()) + b * output_size);
+        break;
+      case etype_t::u8:
+        Quantize(float_data, output_size, mean, inv_adjusted_stddev / scale,
+                 zero_point,
+                 reinterpret_cast<uint8_t*>(output->Data()) + b * output_size);
+        break;
+      default:
+        for (dim_t i = 0; i < output_size; ++i) {
+          float_data[i] = (float_data[i] - mean) * inv_adjusted_stddev;
+        }
+        break;
+    }
+  }
+}
+
+}  // namespace
+
+const Algo* Impl_CropResizeStandardize() {
+  static const Algo crop_resize_standardize = {
+      &ComputeCropResizeStandardize</*kYuvToRgb=*/false>, nullptr};
+  return &crop_resize_standardize;
+}
+
+const Algo* Impl_YuvToRgbCropResizeStandardize() {
+  static const Algo yuv_to_rgb_crop_resize_standardize = {
+      &ComputeCropResizeStandardize</*kYuvToRgb=*/true>, nullptr};
+  return &yuv_to_rgb_crop_resize_standardize;
+}
+
+}  // namespace crop_resize_standardize
+}  // namespace ml_adj
@@ -0,0 +1,53 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_ML_ADJACENT_ALGO_CROP_RESIZE_STANDARDIZE_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_ML_ADJACENT_ALGO_CROP_RESIZE_STANDARDIZE_H_
+
+#include "tflite/experimental/ml_adjacent/lib.h"
+
+namespace ml_adj {
+namespace crop_resize_standardize {
+
+// Crop, Resize and Standardize
+//
+// Inputs: [img: float, offset_height: unsigned, offset_width: unsigned,
+//          target_height: unsigned, target_width: unsigned,
+//          new size: vector<unsigned>, (scale: scalar<float>,
+//          zero_point: scalar<int>)]
+// Ouputs: [img: float, int8 or uint8]
+//
+// Computes the same image as `CropToBoundingBox`, then `Resize` to
+// `new size`, then `PerImageStandardization` in a single pass over the
+// source pixels, without materializing the intermediate images. If the
+// output is int8 or uint8, the standardized values are quantized with
+// `scale` and `zero_point`, which must then be given.
+
+const algo::Algo* Impl_CropResizeStandardize();
+
+// YUV to RGB, Crop, Resize and Standardize
+//
+// Inputs: same as `CropResizeStandardize`, with a 3-channel YUV image.
+// Ouputs: [img: float, int8 or uint8]
+//
+// Same as `CropResizeStandardize` on the image converted to RGB as by
+// `YuvToRgb`. The conversion is applied to the resized pixels, which gives
+// the same result since both are linear.
+
+const algo::Algo* Impl_YuvToRgbCropResizeStandardize();
+
+}  // namespace crop_resize_standardize
+}  // namespace ml_adj
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_ML_ADJACENT_ALGO_CROP_RESIZE_STANDARDIZE_H_
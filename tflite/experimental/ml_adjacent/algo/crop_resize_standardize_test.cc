@@ -0,0 +1,197 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/experimental/ml_adjacent/algo/crop_resize_standardize.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/experimental/ml_adjacent/algo/crop.h"
+#include "tflite/experimental/ml_adjacent/algo/per_image_standardization.h"
+#include "tflite/experimental/ml_adjacent/algo/resize.h"
+#include "tflite/experimental/ml_adjacent/algo/yuv_to_rgb.h"
+#include "tflite/experimental/ml_adjacent/data/owning_vector_ref.h"
+#include "tflite/experimental/ml_adjacent/lib.h"
+
+using ::ml_adj::algo::Algo;
+using ::ml_adj::data::DataRef;
+using ::ml_adj::data::OwningVectorRef;
+
+namespace ml_adj {
+namespace crop_resize_standardize {
+namespace {
+
+struct CropResizeStandardizeTestParams {
+  const std::vector<dim_t> img_dims;
+  const dim_t offset_height;
+  const dim_t offset_width;
+  const dim_t target_height;
+  const dim_t target_width;
+  const std::vector<dim_t> size;
+  const bool yuv_to_rgb;
+};
+
+class CropResizeStandardizeTest
+    : public ::testing::TestWithParam<CropResizeStandardizeTestParams> {
+ protected:
+  void SetUp() override {
+    const CropResizeStandardizeTestParams& params = GetParam();
+    img_.Resize(dims_t(params.img_dims));
+    std::mt19937 random_engine(img_.NumElements());
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    float* img_data = reinterpret_cast<float*>(img_.Data());
+    for (int i = 0; i < img_.NumElements(); ++i) {
+      img_data[i] = distribution(random_engine);
+    }
+    SetScalar(params.offset_height, offset_height_);
+    SetScalar(params.offset_width, offset_width_);
+    SetScalar(params.target_height, target_height_);
+    SetScalar(params.target_width, target_width_);
+    size_.Resize({2});
+    std::memcpy(size_.Data(), params.size.data(), size_.Bytes());
+  }
+
+  static void SetScalar(dim_t value, OwningVectorRef& ref) {
+    ref.Resize({1});
+    std::memcpy(ref.Data(), &value, sizeof(value));
+  }
+
+  // Runs the algos the fused one replaces one after the other.
+  void RunUnfused(OwningVectorRef& output) {
+    OwningVectorRef rgb(etype_t::f32);
+    DataRef* img = &img_;
+    if (GetParam().yuv_to_rgb) {
+      yuv_to_rgb::Impl_YuvToRgb()->process({&img_}, {&rgb});
+      img = &rgb;
+    }
+    OwningVectorRef cropped(etype_t::f32);
+    crop::Impl_CropToBoundingBox()->process(
+        {img, &offset_height_, &offset_width_,
+         &target_height_, &target_width_},
+        {&cropped});
+    OwningVectorRef resized(etype_t::f32);
+    resize::Impl_Resize()->process({&cropped, &size_}, {&resized});
+    per_image_standardization::Impl_PerImageStandardization()->process(
+        {&resized}, {&output});
+  }
+
+  const Algo* GetAlgo() {
+    return GetParam().yuv_to_rgb ? Impl_YuvToRgbCropResizeStandardize()
+                                 : Impl_CropResizeStandardize();
+  }
+
+  OwningVectorRef img_{etype_t::f32};
+  OwningVectorRef offset_height_{etype_t::i32};
+  OwningVectorRef offset_width_{etype_t::i32};
+  OwningVectorRef target_height_{etype_t::i32};
+  OwningVectorRef target_width_{etype_t::i32};
+  OwningVectorRef size_{etype_t::i32};
+};
+
+TEST_P(CropResizeStandardizeTest, FloatPixelType) {
+  OwningVectorRef expected(etype_t::f32);
+  RunUnfused(expected);
+
+  OwningVectorRef output(etype_t::f32);
+  GetAlgo()->process({&img_, &offset_height_, &offset_width_, &target_height_,
+                      &target_width_, &size_},
+                     {&output});
+
+  ASSERT_EQ(output.Dims(), expected.Dims());
+  constexpr float kAbsError = 1e-3f;
+  const float* out_data = reinterpret_cast<const float*>(output.Data());
+  const float* expected_data = reinterpret_cast<const float*>(expected.Data());
+  for (int i = 0; i < output.NumElements(); ++i) {
+    EXPECT_NEAR(out_data[i], expected_data[i], kAbsError)
+        << "out_data[" << i << "] = " << out_data[i] << ", expected_data[" << i
+        << "] = " << expected_data[i];
+  }
+}
+
+TEST_P(CropResizeStandardizeTest, Int8PixelType) {
+  OwningVectorRef expected(etype_t::f32);
+  RunUnfused(expected);
+
+  constexpr float kScale = 0.05f;
+  constexpr int32_t kZeroPoint = -3;
+  OwningVectorRef scale(etype_t::f32);
+  scale.Resize({1});
+  std::memcpy(scale.Data(), &kScale, sizeof(kScale));
+  OwningVectorRef zero_point(etype_t::i32);
+  zero_point.Resize({1});
+  std::memcpy(zero_point.Data(), &kZeroPoint, sizeof(kZeroPoint));
+
+  OwningVectorRef output(etype_t::i8);
+  GetAlgo()->process({&img_, &offset_height_, &offset_width_, &target_height_,
+                      &target_width_, &size_, &scale, &zero_point},
+                     {&output});
+
+  ASSERT_EQ(output.Dims(), expected.Dims());
+  const int8_t* out_data = reinterpret_cast<const int8_t*>(output.Data());
+  const float* expected_data = reinterpret_cast<const float*>(expected.Data());
+  for (int i = 0; i < output.NumElements(); ++i) {
+    const float quantized =
+        std::fmin(127.0f, std::fmax(-128.0f, std::round(expected_data[i] /
+                                                        kScale) +
+                                                 kZeroPoint));
+    EXPECT_NEAR(out_data[i], quantized, 1) << "i = " << i;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    CropResizeStandardizeTests, CropResizeStandardizeTest,
+    testing::ValuesIn({
+        // 4-D Tensor of shape [batch, height, width, channels] is used below.
+
+        // Downscale the whole image.
+        CropResizeStandardizeTestParams{/*img_dims=*/{1, 16, 12, 3},
+                                        /*offset_height=*/0,
+                                        /*offset_width=*/0,
+                                        /*target_height=*/16,
+                                        /*target_width=*/12,
+                                        /*size=*/{5, 7},
+                                        /*yuv_to_rgb=*/false},
+        // Crop then downscale.
+        CropResizeStandardizeTestParams{/*img_dims=*/{1, 20, 18, 3},
+                                        /*offset_height=*/3,
+                                        /*offset_width=*/5,
+                                        /*target_height=*/13,
+                                        /*target_width=*/9,
+                                        /*size=*/{4, 4},
+                                        /*yuv_to_rgb=*/true},
+        // Crop then upscale 2x, 2 images in the batch.
+        CropResizeStandardizeTestParams{/*img_dims=*/{2, 8, 8, 3},
+                                        /*offset_height=*/2,
+                                        /*offset_width=*/1,
+                                        /*target_height=*/4,
+                                        /*target_width=*/6,
+                                        /*size=*/{8, 12},
+                                        /*yuv_to_rgb=*/true},
+        // Single channel, non integer upscale.
+        CropResizeStandardizeTestParams{/*img_dims=*/{1, 9, 7, 1},
+                                        /*offset_height=*/1,
+                                        /*offset_width=*/1,
+                                        /*target_height=*/7,
+                                        /*target_width=*/5,
+                                        /*size=*/{10, 11},
+                                        /*yuv_to_rgb=*/false},
+    }));
+
+}  // namespace
+}  // namespace crop_resize_standardize
+}  // namespace ml_adj
@@ -37,6 +37,8 @@ enum etype_t : uint8_t {
   i32 = 0,
   f32 = 1,
   f64 = 2,
+  i8 = 3,
+  u8 = 4,
 };
 
 // Size in bytes of data element.
@@ -53,6 +55,10 @@ inline width_t TypeWidth(etype_t type) {
       return sizeof(float);
     case etype_t::f64:
       return sizeof(double);
+    case etype_t::i8:
+      return sizeof(int8_t);
+    case etype_t::u8:
+      return sizeof(uint8_t);
   }
 }
 
@@ -40,6 +40,10 @@ etype_t TflToLibType(const TfLiteType tfl_type) {
       return etype_t::i32;
     case kTfLiteFloat64:
       return etype_t::f64;
+    case kTfLiteInt8:
+      return etype_t::i8;
+    case kTfLiteUInt8:
+      return etype_t::u8;
     default:
       return etype_t::i32;
   }
@@ -30,8 +30,13 @@ TfLiteStatus CacheBuffer::Initialize(const TfLiteIntArray& shape) {
   // Set the dims and allocate the memory.
   dims_ = TfLiteIntArrayCopy(&shape);
   const size_t buf_size = NumElements(&shape);
-  buffer_.reset(new float[buf_size]);
-  memset(buffer_.get(), 0, sizeof(float) * buf_size);
+  // Lazily commit the memory: large calloc allocations are backed by zero
+  // pages that are only committed when written, unlike a memset of the whole
+  // buffer.
+  buffer_.reset(static_cast<float*>(std::calloc(buf_size, sizeof(float))));
+  if (buffer_ == nullptr) {
+    return kTfLiteError;
+  }
 
   num_entries_.reset(new size_t[shape.data[1]]);
   memset(num_entries_.get(), 0, sizeof(size_t) * shape.data[1]);
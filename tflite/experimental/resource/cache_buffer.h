@@ -16,6 +16,7 @@ limitations under the License.
 #define TENSORFLOW_LITE_EXPERIMENTAL_RESOURCE_CACHE_BUFFER_H_
 
 #include <cstddef>
+#include <cstdlib>
 #include <memory>
 #include <unordered_map>
 
@@ -49,7 +50,10 @@ class CacheBuffer : public ResourceVariable {
   std::unique_ptr<size_t[]> num_entries_;
   // The float buffer for storage. Has shape:
   // <batch, num layers, seq length, num heads, head dim>
-  std::unique_ptr<float[]> buffer_;
+  // It is zero initialized by calloc, so its pages are committed lazily, as
+  // entries are written, rather than for the whole sequence length up front.
+  // The address space of the whole sequence length is still reserved.
+  std::unique_ptr<float, decltype(&std::free)> buffer_{nullptr, &std::free};
   TfLiteIntArray *dims_;
 };
 
@@ -40,5 +40,24 @@ TEST(CacheBufferTest, Initialize) {
   TfLiteIntArrayFree(shape);
 }
 
+TEST(CacheBufferTest, InitializeZeroesBuffer) {
+  TfLiteIntArray* shape = TfLiteIntArrayCreate(5);
+  shape->data[0] = 1;
+  shape->data[1] = 2;
+  shape->data[2] = 64;
+  shape->data[3] = 4;
+  shape->data[4] = 8;
+
+  CacheBuffer cache_buffer;
+  ASSERT_EQ(cache_buffer.Initialize(*shape), kTfLiteOk);
+
+  const float* buffer = cache_buffer.GetBuffer();
+  ASSERT_NE(buffer, nullptr);
+  for (int i = 0; i < 2 * 64 * 4 * 8; ++i) {
+    EXPECT_EQ(buffer[i], 0.0f) << "i = " << i;
+  }
+  TfLiteIntArrayFree(shape);
+}
+
 }  // namespace resource
 }  // namespace tflite
@@ -16,6 +16,7 @@ limitations under the License.
 #define TENSORFLOW_LITE_EXPERIMENTAL_RESOURCE_LOOKUP_UTIL_H_
 
 #include <string>
+#include <string_view>
 
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/string_util.h"
@@ -72,7 +73,9 @@ class TensorWriter {
   // Sets the given value to the given index position of the tensor storage.
   // In here, it does not check the validity of the index should be guaranteed
   // in order not to harm the performance. Caller should take care of it.
-  void SetData(int index, ValueType& value) { output_data_[index] = value; }
+  void SetData(int index, const ValueType& value) {
+    output_data_[index] = value;
+  }
 
   // Commit updates. In this case, it does nothing since the SetData method
   // writes data directly.
@@ -99,6 +102,9 @@ class TensorWriter<std::string> {
   void SetData(int index, const std::string& value) {
     buf_.AddString(value.data(), value.length());
   }
+  void SetData(int index, std::string_view value) {
+    buf_.AddString(value.data(), value.length());
+  }
 
   // Commit updates. The stored data in DynamicBuffer will be written into the
   // tensor storage.
@@ -18,6 +18,7 @@ limitations under the License.
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <utility>
 
 #include "tflite/c/common.h"
 #include "tflite/core/c/c_api_types.h"
@@ -32,9 +33,13 @@ ResourceVariable::ResourceVariable() {
 
 ResourceVariable::ResourceVariable(ResourceVariable&& other) {
   tensor_ = other.tensor_;
+  back_buffer_ = other.back_buffer_;
+  back_buffer_bytes_ = other.back_buffer_bytes_;
   is_initialized_ = other.is_initialized_;
 
   memset(&other.tensor_, 0, sizeof(TfLiteTensor));
+  other.back_buffer_ = nullptr;
+  other.back_buffer_bytes_ = 0;
   other.is_initialized_ = false;
 }
 
@@ -45,9 +50,21 @@ ResourceVariable::~ResourceVariable() {
       TfLiteIntArrayFree(tensor_.dims);
     }
   }
+  free(back_buffer_);
 }
 
 TfLiteStatus ResourceVariable::AssignFrom(const TfLiteTensor* tensor) {
+  return Assign(tensor, /*movable=*/nullptr);
+}
+
+TfLiteStatus ResourceVariable::MoveFrom(TfLiteTensor* tensor) {
+  const bool is_movable =
+      tensor->allocation_type == kTfLiteDynamic && tensor->data.raw != nullptr;
+  return Assign(tensor, is_movable ? tensor : nullptr);
+}
+
+TfLiteStatus ResourceVariable::Assign(const TfLiteTensor* tensor,
+                                      TfLiteTensor* movable) {
   // Save the old allocated resources and attributes that we might use.
   char* old_raw = tensor_.data.raw;
   size_t old_bytes = tensor_.bytes;
@@ -69,18 +86,30 @@ TfLiteStatus ResourceVariable::AssignFrom(const TfLiteTensor* tensor) {
     tensor_.dims = TfLiteIntArrayCopy(tensor->dims);
   }
 
-  // Reuse the same buffer if possible otherwise allocate a new one.
-  tensor_.data.raw = old_raw;
-  if (old_bytes != tensor->bytes) {
-    TfLiteTensorRealloc(tensor->bytes, &tensor_);
-  } else {
-    tensor_.bytes = old_bytes;
+  // Write the new value to the back buffer, and keep the old value in place
+  // for the reads that point to it. Reuse the back buffer if possible
+  // otherwise allocate a new one.
+  tensor_.data.raw = back_buffer_;
+  tensor_.bytes = back_buffer_bytes_;
+  back_buffer_ = old_raw;
+  back_buffer_bytes_ = old_bytes;
+  is_initialized_ = true;
+  TfLiteStatus status = kTfLiteOk;
+  if (tensor_.bytes != tensor->bytes) {
+    status = TfLiteTensorResizeMaybeCopy(tensor->bytes, &tensor_,
+                                         /*preserve_data=*/false);
+  }
+  if (status != kTfLiteOk) {
+    return status;
   }
 
-  if (tensor->data.raw) {
+  if (movable != nullptr) {
+    // Swap the buffers instead of copying, both are allocated like the buffers
+    // of dynamic tensors.
+    std::swap(tensor_.data.raw, movable->data.raw);
+  } else if (tensor->data.raw) {
     memcpy(tensor_.data.raw, tensor->data.raw, tensor_.bytes);
   }
-  is_initialized_ = true;
 
   return kTfLiteOk;
 }
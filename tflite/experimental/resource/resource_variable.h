@@ -38,8 +38,17 @@ class ResourceVariable : public ResourceBase {
   ~ResourceVariable() override;
 
   // Assigns data from a tensor. Copies its type, shape and data over.
+  // The data is written to the buffer of the value before the previous one,
+  // so the previous value stays in place until the next assignment. Reads can
+  // point to the buffer of the variable instead of copying it as long as the
+  // variable is assigned at most once while they are in use.
   TfLiteStatus AssignFrom(const TfLiteTensor* tensor);
 
+  // Like `AssignFrom`, for a `tensor` that is not read after the assignment.
+  // If `tensor` is dynamic, the variable takes its buffer instead of copying
+  // it and leaves `tensor` with the buffer of an older value.
+  TfLiteStatus MoveFrom(TfLiteTensor* tensor);
+
   // Get the data tensor stored in the resource variable.
   // Returns `nullptr` if the variable is never initialized by calling
   // `AssignFrom`.
@@ -49,16 +58,25 @@ class ResourceVariable : public ResourceBase {
   bool IsInitialized() override { return is_initialized_; }
 
   size_t GetMemoryUsage() override {
-    return is_initialized_ ? tensor_.bytes : 0;
+    return is_initialized_ ? tensor_.bytes + back_buffer_bytes_ : 0;
   }
 
  protected:
   // The tensor (and its buffer stored in `tensor_.data` is fully owned by
   // the `ResourceVariable` object.
   TfLiteTensor tensor_;
+  // The buffer of the value before the current one, which the next
+  // assignment writes to. It is owned by the `ResourceVariable` object too.
+  char* back_buffer_ = nullptr;
+  size_t back_buffer_bytes_ = 0;
   // True if `AssignFrom` function is every called.
   // False if and only if `tensor_` is filled with zeros.
   bool is_initialized_ = false;
+
+ private:
+  // Assigns the type, shape and data of `tensor`, taking the buffer of
+  // `movable` if it is not null.
+  TfLiteStatus Assign(const TfLiteTensor* tensor, TfLiteTensor* movable);
 };
 
 // Creates a resource variable, shared among all the subgraphs with the given
@@ -169,6 +169,81 @@ TEST(ResourceTest, AssignDifferentSizeTensor) {
   TfLiteTensorFree(&tensor_b);
 }
 
+TEST(ResourceTest, AssignKeepsPreviousValueInPlace) {
+  ResourceVariable var;
+
+  TfLiteTensor tensor_a, tensor_b, tensor_c;
+  std::vector<int> shape = {2};
+  InitTensor(shape, kTfLiteDynamic, 1.0, &tensor_a);
+  InitTensor(shape, kTfLiteDynamic, 2.0, &tensor_b);
+  InitTensor(shape, kTfLiteDynamic, 3.0, &tensor_c);
+
+  EXPECT_EQ(kTfLiteOk, var.AssignFrom(&tensor_a));
+  const float* first_value = var.GetTensor()->data.f;
+
+  // The second value is written to another buffer.
+  EXPECT_EQ(kTfLiteOk, var.AssignFrom(&tensor_b));
+  EXPECT_NE(first_value, var.GetTensor()->data.f);
+  EXPECT_EQ(2.0f, var.GetTensor()->data.f[0]);
+  EXPECT_EQ(1.0f, first_value[0]);
+  EXPECT_EQ(2 * 2 * sizeof(float), var.GetMemoryUsage());
+
+  // The third one reuses the buffer of the first one.
+  EXPECT_EQ(kTfLiteOk, var.AssignFrom(&tensor_c));
+  EXPECT_EQ(first_value, var.GetTensor()->data.f);
+  EXPECT_EQ(3.0f, var.GetTensor()->data.f[1]);
+
+  // Cleanup
+  TfLiteTensorFree(&tensor_a);
+  TfLiteTensorFree(&tensor_b);
+  TfLiteTensorFree(&tensor_c);
+}
+
+TEST(ResourceTest, MoveFromTakesDynamicTensorBuffer) {
+  ResourceVariable var;
+
+  TfLiteTensor tensor_a, tensor_b;
+  std::vector<int> shape = {2};
+  InitTensor(shape, kTfLiteDynamic, 1.0, &tensor_a);
+  InitTensor(shape, kTfLiteDynamic, 4.0, &tensor_b);
+
+  EXPECT_EQ(kTfLiteOk, var.AssignFrom(&tensor_a));
+  const float* first_value = var.GetTensor()->data.f;
+  float* moved_buffer = tensor_b.data.f;
+
+  EXPECT_EQ(kTfLiteOk, var.MoveFrom(&tensor_b));
+  auto* value = var.GetTensor();
+  EXPECT_EQ(moved_buffer, value->data.f);
+  EXPECT_EQ(4.0f, value->data.f[1]);
+  ASSERT_THAT(value, DimsAre({2}));
+  // The tensor got a buffer of its size, and the previous value is kept.
+  EXPECT_NE(nullptr, tensor_b.data.raw);
+  EXPECT_NE(first_value, tensor_b.data.f);
+  EXPECT_EQ(2 * sizeof(float), tensor_b.bytes);
+  EXPECT_EQ(1.0f, first_value[0]);
+
+  // Cleanup
+  TfLiteTensorFree(&tensor_a);
+  TfLiteTensorFree(&tensor_b);
+}
+
+TEST(ResourceTest, MoveFromCopiesNonDynamicTensor) {
+  ResourceVariable var;
+
+  TfLiteTensor tensor;
+  std::vector<int> shape = {2};
+  InitTensor(shape, kTfLiteArenaRw, 1.0f, &tensor);
+
+  EXPECT_EQ(kTfLiteOk, var.MoveFrom(&tensor));
+  EXPECT_NE(tensor.data.f, var.GetTensor()->data.f);
+  EXPECT_EQ(1.0f, var.GetTensor()->data.f[1]);
+
+  // Cleanup
+  // For non dynamic tensors we need to delete the buffers manually.
+  free(tensor.data.raw);
+  TfLiteTensorFree(&tensor);
+}
+
 TEST(IsBuiltinResource, IsBuiltinResourceTest) {
   TfLiteTensor tensor;
   tensor.type = kTfLiteResource;
@@ -15,9 +15,13 @@ limitations under the License.
 
 #include "tflite/experimental/resource/static_hashtable.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "tflite/c/c_api_types.h"
 #include "tflite/c/common.h"
@@ -31,6 +35,54 @@ namespace tflite {
 namespace resource {
 namespace internal {
 
+namespace {
+
+// Keys are looked up in batches of this many: the first slots of all of them
+// are prefetched before the first one is probed, so that their cache misses
+// overlap.
+constexpr int kLookupBatchSize = 16;
+
+inline uint64_t MixHash(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+inline uint64_t HashKey(std::int64_t key) {
+  return MixHash(static_cast<uint64_t>(key));
+}
+
+inline uint64_t HashKey(std::string_view key) {
+  return MixHash(std::hash<std::string_view>()(key));
+}
+
+template <typename T>
+inline void PrefetchForRead(const T* ptr) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(ptr, /*rw=*/0, /*locality=*/3);
+#endif
+}
+
+}  // namespace
+
+template <typename KeyType, typename ValueType>
+int32_t StaticHashtable<KeyType, ValueType>::FindEntry(KeyView key,
+                                                       uint64_t hash) const {
+  const uint32_t hash_tag = hash >> 32;
+  for (uint64_t i = hash & slot_mask_;; i = (i + 1) & slot_mask_) {
+    const Slot& slot = slots_[i];
+    if (slot.entry == kEmptySlot) {
+      return kEmptySlot;
+    }
+    if (slot.hash_tag == hash_tag && keys_.Get(slot.entry) == key) {
+      return slot.entry;
+    }
+  }
+}
+
 template <typename KeyType, typename ValueType>
 TfLiteStatus StaticHashtable<KeyType, ValueType>::Lookup(
     TfLiteContext* context, const TfLiteTensor* keys, TfLiteTensor* values,
@@ -43,17 +95,25 @@ TfLiteStatus StaticHashtable<KeyType, ValueType>::Lookup(
   const int size =
       MatchingFlatSize(GetTensorShape(keys), GetTensorShape(values));
 
-  auto key_tensor_reader = TensorReader<KeyType>(keys);
   auto value_tensor_writer = TensorWriter<ValueType>(values);
-  auto default_value_tensor_reader = TensorReader<ValueType>(default_value);
-  ValueType first_default_value = default_value_tensor_reader.GetData(0);
-
-  for (int i = 0; i < size; ++i) {
-    auto result = map_.find(key_tensor_reader.GetData(i));
-    if (result != map_.end()) {
-      value_tensor_writer.SetData(i, result->second);
-    } else {
-      value_tensor_writer.SetData(i, first_default_value);
+  const auto first_default_value =
+      FlatArray<ValueType>::Read(default_value, 0);
+
+  uint64_t hashes[kLookupBatchSize];
+  for (int start = 0; start < size; start += kLookupBatchSize) {
+    const int batch_size = std::min(kLookupBatchSize, size - start);
+    for (int i = 0; i < batch_size; ++i) {
+      hashes[i] = HashKey(FlatArray<KeyType>::Read(keys, start + i));
+      PrefetchForRead(&slots_[hashes[i] & slot_mask_]);
+    }
+    for (int i = 0; i < batch_size; ++i) {
+      const int32_t entry =
+          FindEntry(FlatArray<KeyType>::Read(keys, start + i), hashes[i]);
+      if (entry != kEmptySlot) {
+        value_tensor_writer.SetData(start + i, values_.Get(entry));
+      } else {
+        value_tensor_writer.SetData(start + i, first_default_value);
+      }
     }
   }
 
@@ -79,10 +139,36 @@ TfLiteStatus StaticHashtable<KeyType, ValueType>::Import(
   const int size =
       MatchingFlatSize(GetTensorShape(keys), GetTensorShape(values));
 
-  auto key_tensor_reader = TensorReader<KeyType>(keys);
-  auto value_tensor_writer = TensorReader<ValueType>(values);
+  uint64_t num_slots = 1;
+  while (num_slots < 2 * static_cast<uint64_t>(size)) {
+    num_slots <<= 1;
+  }
+  slots_.assign(num_slots, Slot{0, kEmptySlot});
+  slot_mask_ = num_slots - 1;
+  keys_.Reserve(size, keys->bytes);
+  values_.Reserve(size, values->bytes);
+
   for (int i = 0; i < size; ++i) {
-    map_.insert({key_tensor_reader.GetData(i), value_tensor_writer.GetData(i)});
+    const KeyView key = FlatArray<KeyType>::Read(keys, i);
+    const uint64_t hash = HashKey(key);
+    const uint32_t hash_tag = hash >> 32;
+    uint64_t slot = hash & slot_mask_;
+    bool is_duplicate = false;
+    while (slots_[slot].entry != kEmptySlot) {
+      if (slots_[slot].hash_tag == hash_tag &&
+          keys_.Get(slots_[slot].entry) == key) {
+        is_duplicate = true;
+        break;
+      }
+      slot = (slot + 1) & slot_mask_;
+    }
+    // Like std::unordered_map::insert, the first value of a key is kept.
+    if (is_duplicate) {
+      continue;
+    }
+    slots_[slot] = Slot{hash_tag, keys_.Size()};
+    keys_.Add(key);
+    values_.Add(FlatArray<ValueType>::Read(values, i));
   }
 
   is_initialized_ = true;
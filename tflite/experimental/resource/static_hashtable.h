@@ -16,7 +16,10 @@ limitations under the License.
 #define TENSORFLOW_LITE_EXPERIMENTAL_RESOURCE_STATIC_HASHTABLE_H_
 
 #include <cstddef>
-#include <unordered_map>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "tflite/core/c/common.h"
 #include "tflite/experimental/resource/lookup_interfaces.h"
@@ -29,6 +32,61 @@ namespace tflite {
 namespace resource {
 namespace internal {
 
+// Contiguous storage for the keys or the values of a StaticHashtable.
+template <typename T>
+class FlatArray {
+ public:
+  using View = T;
+
+  // Returns the element of `tensor` at `index`.
+  static View Read(const TfLiteTensor* tensor, int index) {
+    return GetTensorData<T>(tensor)[index];
+  }
+
+  void Reserve(int size, size_t bytes) { data_.reserve(size); }
+  void Add(View value) { data_.push_back(value); }
+  View Get(int index) const { return data_[index]; }
+  int Size() const { return data_.size(); }
+  size_t GetMemoryUsage() const { return data_.capacity() * sizeof(T); }
+
+ private:
+  std::vector<T> data_;
+};
+
+// Strings are stored back to back in one buffer, instead of one allocation
+// per string.
+template <>
+class FlatArray<std::string> {
+ public:
+  using View = std::string_view;
+
+  static View Read(const TfLiteTensor* tensor, int index) {
+    const StringRef string_ref = GetString(tensor, index);
+    return View(string_ref.str, string_ref.len);
+  }
+
+  void Reserve(int size, size_t bytes) {
+    offsets_.reserve(size + 1);
+    buffer_.reserve(bytes);
+  }
+  void Add(View value) {
+    buffer_.append(value.data(), value.size());
+    offsets_.push_back(buffer_.size());
+  }
+  View Get(int index) const {
+    return View(buffer_.data() + offsets_[index],
+                offsets_[index + 1] - offsets_[index]);
+  }
+  int Size() const { return offsets_.size() - 1; }
+  size_t GetMemoryUsage() const {
+    return buffer_.capacity() + offsets_.capacity() * sizeof(size_t);
+  }
+
+ private:
+  std::string buffer_;
+  std::vector<size_t> offsets_ = {0};
+};
+
 // A static hash table class. This hash table allows initialization one time in
 // its life cycle. This hash table implements Tensorflow core's HashTableV2 op.
 template <typename KeyType, typename ValueType>
@@ -50,7 +108,7 @@ class StaticHashtable : public tflite::resource::LookupInterface {
                       const TfLiteTensor* values) override;
 
   // Returns the item size of the hash table.
-  size_t Size() override { return map_.size(); }
+  size_t Size() override { return keys_.Size(); }
 
   TfLiteType GetKeyType() const override { return key_type_; }
   TfLiteType GetValueType() const override { return value_type_; }
@@ -66,13 +124,36 @@ class StaticHashtable : public tflite::resource::LookupInterface {
   // Returns true if the hash table is initialized.
   bool IsInitialized() override { return is_initialized_; }
 
-  size_t GetMemoryUsage() override { return map_.size() * sizeof(ValueType); }
+  size_t GetMemoryUsage() override {
+    return slots_.capacity() * sizeof(Slot) + keys_.GetMemoryUsage() +
+           values_.GetMemoryUsage();
+  }
 
  private:
+  using KeyView = typename FlatArray<KeyType>::View;
+
+  // A slot of the open addressing table, which refers to the entry of
+  // `keys_` and `values_` it holds, if any, and caches the upper bits of the
+  // hash of its key so that most mismatching keys are not compared.
+  struct Slot {
+    uint32_t hash_tag;
+    int32_t entry;
+  };
+  static constexpr int32_t kEmptySlot = -1;
+
+  // Returns the entry of `key`, or kEmptySlot if it is not in the table.
+  int32_t FindEntry(KeyView key, uint64_t hash) const;
+
   TfLiteType key_type_;
   TfLiteType value_type_;
 
-  std::unordered_map<KeyType, ValueType> map_;
+  // The slots, probed linearly from the hash of the key. Their number is a
+  // power of two at least twice the number of keys, so that probe sequences
+  // stay short and always end on an empty slot.
+  std::vector<Slot> slots_;
+  uint64_t slot_mask_ = 0;
+  FlatArray<KeyType> keys_;
+  FlatArray<ValueType> values_;
   bool is_initialized_ = false;
 };
 
@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_EXPERIMENTAL_SHLO_OPS_BINARY_ELEMENTWISE_H_
 #define TENSORFLOW_LITE_EXPERIMENTAL_SHLO_OPS_BINARY_ELEMENTWISE_H_
 
+#include <algorithm>
+
 #include "tflite/experimental/shlo/data_type.h"
 #include "tflite/experimental/shlo/quantize.h"
 #include "tflite/experimental/shlo/quantized_tensor_element_type.h"
@@ -48,15 +50,26 @@ void DequantizeOpQuantizePerTensor(F&& func, const Tensor& lhs,
   const StorageT* rhs_data = rhs.GetDataAs<storage_type>();
   StorageT* output_data = output.GetDataAs<storage_type>();
   const ExpressedT inv_scale = static_cast<ExpressedT>(1) / output_scale;
-  for (DimensionSize i = 0; i < num_elements;
-       ++i, ++lhs_data, ++rhs_data, ++output_data) {
-    const ExpressedT dequantized_lhs =
-        Dequantize(*lhs_data, lhs_zero_point, lhs_scale);
-    const ExpressedT dequantized_rhs =
-        Dequantize(*rhs_data, rhs_zero_point, rhs_scale);
-    const ExpressedT dequantized_res = func(dequantized_lhs, dequantized_rhs);
-    *output_data = Quantize<storage_type, expressed_type>(
-        dequantized_res, output_zero_point, inv_scale);
+  // The elements are dequantized, computed and quantized by blocks so that
+  // each step is a simple loop that the compiler can vectorize.
+  constexpr DimensionSize kBlockSize = 256;
+  ExpressedT lhs_block[kBlockSize];
+  ExpressedT rhs_block[kBlockSize];
+  for (DimensionSize start = 0; start < num_elements; start += kBlockSize) {
+    const DimensionSize size = std::min(kBlockSize, num_elements - start);
+    for (DimensionSize i = 0; i < size; ++i) {
+      lhs_block[i] = Dequantize(lhs_data[start + i], lhs_zero_point, lhs_scale);
+    }
+    for (DimensionSize i = 0; i < size; ++i) {
+      rhs_block[i] = Dequantize(rhs_data[start + i], rhs_zero_point, rhs_scale);
+    }
+    for (DimensionSize i = 0; i < size; ++i) {
+      lhs_block[i] = func(lhs_block[i], rhs_block[i]);
+    }
+    for (DimensionSize i = 0; i < size; ++i) {
+      output_data[start + i] = Quantize<storage_type, expressed_type>(
+          lhs_block[i], output_zero_point, inv_scale);
+    }
   }
 }
 
@@ -0,0 +1,147 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include <cstddef>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "benchmark/benchmark.h"  // from @com_google_benchmark
+#include "tflite/experimental/shlo/data_type.h"
+#include "tflite/experimental/shlo/ops/and.h"
+#include "tflite/experimental/shlo/ops/benchmark_util.h"
+#include "tflite/experimental/shlo/ops/compare.h"
+#include "tflite/experimental/shlo/ops/divide.h"
+#include "tflite/experimental/shlo/ops/maximum.h"
+#include "tflite/experimental/shlo/ops/minimum.h"
+#include "tflite/experimental/shlo/ops/multiply.h"
+#include "tflite/experimental/shlo/ops/or.h"
+#include "tflite/experimental/shlo/ops/subtract.h"
+#include "tflite/experimental/shlo/ops/xor.h"
+#include "tflite/experimental/shlo/shape.h"
+#include "tflite/experimental/shlo/tensor.h"
+#include "tflite/experimental/shlo/tensor_with_data.h"
+
+namespace shlo_ref {
+namespace {
+
+template <class Op>
+void BM_BinaryOp(benchmark::State& state, Op op, const Tensor& lhs,
+                 const Tensor& rhs, Tensor result) {
+  ABSL_CHECK_OK(Prepare(op, lhs, rhs, result));
+
+  std::vector<std::byte> result_values(result.SizeInBytes());
+  result.data = result_values.data();
+
+  for (auto _ : state) {
+    ABSL_CHECK_OK(Evaluate(op, lhs, rhs, result));
+  }
+  state.SetItemsProcessed(state.iterations() * lhs.NumElements());
+}
+
+template <class Op, DataType data_type>
+void BM_BinaryOp(benchmark::State& state) {
+  const DimensionSize num_elements = state.range(0);
+
+  auto lhs_values = GenerateRandomVector<data_type>(num_elements);
+  auto rhs_values = GenerateRandomVector<data_type>(num_elements);
+  auto lhs =
+      TensorWithData::Create<data_type>(Shape{{num_elements}}, lhs_values);
+  auto rhs =
+      TensorWithData::Create<data_type>(Shape{{num_elements}}, rhs_values);
+
+  BM_BinaryOp(state, Create(typename Op::Attributes{}), lhs.tensor(),
+              rhs.tensor(), lhs.tensor());
+}
+
+template <class Op, DataType storage_type, DataType expressed_type>
+void BM_BinaryOpQuantized(benchmark::State& state) {
+  const DimensionSize num_elements = state.range(0);
+
+  auto lhs_values = GenerateRandomVector<expressed_type>(num_elements);
+  auto rhs_values = GenerateRandomVector<expressed_type>(num_elements);
+  auto lhs = TensorWithData::Create<storage_type, expressed_type>(
+      Shape{{num_elements}}, lhs_values, 0.01, 0);
+  auto rhs = TensorWithData::Create<storage_type, expressed_type>(
+      Shape{{num_elements}}, rhs_values, 0.01, 0);
+
+  BM_BinaryOp(state, Create(typename Op::Attributes{}), lhs.tensor(),
+              rhs.tensor(), lhs.tensor());
+}
+
+template <DataType data_type>
+void BM_Compare(benchmark::State& state) {
+  const DimensionSize num_elements = state.range(0);
+
+  auto lhs_values = GenerateRandomVector<data_type>(num_elements);
+  auto rhs_values = GenerateRandomVector<data_type>(num_elements);
+  auto lhs =
+      TensorWithData::Create<data_type>(Shape{{num_elements}}, lhs_values);
+  auto rhs =
+      TensorWithData::Create<data_type>(Shape{{num_elements}}, rhs_values);
+  Tensor result = Tensor{.type = TensorType{.shape = Shape{{num_elements}},
+                                            .element_type = DataType::kI1}};
+
+  BM_BinaryOp(state,
+              Create(CompareOp::Attributes{
+                  .comparison_direction =
+                      CompareOp::ComparisonDirection::kLt}),
+              lhs.tensor(), rhs.tensor(), result);
+}
+
+#define BENCHMARK_BINARY_OP(OP, ...)      \
+  BENCHMARK(BM_BinaryOp<OP, __VA_ARGS__>) \
+      ->RangeMultiplier(2)                \
+      ->Range(KiB(8), KiB(64))
+
+#define BENCHMARK_BINARY_OP_QUANTIZED(OP, ...)     \
+  BENCHMARK(BM_BinaryOpQuantized<OP, __VA_ARGS__>) \
+      ->RangeMultiplier(2)                         \
+      ->Range(KiB(8), KiB(64))
+
+#define BENCHMARK_FLOAT_BINARY_OP(OP)                                \
+  BENCHMARK_BINARY_OP(OP, DataType::kBF16);                          \
+  BENCHMARK_BINARY_OP(OP, DataType::kF16);                           \
+  BENCHMARK_BINARY_OP(OP, DataType::kF32);                           \
+  BENCHMARK_BINARY_OP_QUANTIZED(OP, DataType::kSI8, DataType::kF32); \
+  BENCHMARK_BINARY_OP_QUANTIZED(OP, DataType::kSI16, DataType::kF32)
+
+#define BENCHMARK_INT_BINARY_OP(OP)        \
+  BENCHMARK_BINARY_OP(OP, DataType::kSI16); \
+  BENCHMARK_BINARY_OP(OP, DataType::kSI32)
+
+BENCHMARK_FLOAT_BINARY_OP(DivideOp);
+BENCHMARK_FLOAT_BINARY_OP(MaximumOp);
+BENCHMARK_FLOAT_BINARY_OP(MinimumOp);
+BENCHMARK_FLOAT_BINARY_OP(MultiplyOp);
+BENCHMARK_FLOAT_BINARY_OP(SubtractOp);
+
+// The int benchmarks avoid the ops that can divide by zero or overflow on
+// random operands.
+BENCHMARK_INT_BINARY_OP(AndOp);
+BENCHMARK_INT_BINARY_OP(MaximumOp);
+BENCHMARK_INT_BINARY_OP(MinimumOp);
+BENCHMARK_INT_BINARY_OP(OrOp);
+BENCHMARK_INT_BINARY_OP(XorOp);
+
+BENCHMARK(BM_Compare<DataType::kF32>)
+    ->RangeMultiplier(2)
+    ->Range(KiB(8), KiB(64));
+BENCHMARK(BM_Compare<DataType::kSI32>)
+    ->RangeMultiplier(2)
+    ->Range(KiB(8), KiB(64));
+
+}  // namespace
+}  // namespace shlo_ref
+
+BENCHMARK_MAIN();
@@ -15,13 +15,17 @@ limitations under the License.
 
 #include "tflite/experimental/shlo/ops/multiply.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <optional>
 
 #include "absl/status/status.h"
 #include "tflite/experimental/shlo/data_type.h"
 #include "tflite/experimental/shlo/dispatch.h"
 #include "tflite/experimental/shlo/ops/binary_elementwise.h"
 #include "tflite/experimental/shlo/ops/util.h"
+#include "tflite/experimental/shlo/quantize.h"
 #include "tflite/experimental/shlo/tensor.h"
 
 namespace shlo_ref {
@@ -37,6 +41,59 @@ struct Multiply<DataType::kI1> {
   }
 };
 
+namespace {
+
+std::optional<MultiplyOp::IntegerParams> GetIntegerParams(
+    const Tensor& lhs, const Tensor& rhs, const Tensor& output) {
+  if (!IsQuantizedPerTensorTensor(lhs) ||
+      lhs.quantized_per_tensor_element_type().StorageType() != DataType::kSI8 ||
+      lhs.quantized_per_tensor_element_type().ExpressedType() !=
+          DataType::kF32) {
+    return std::nullopt;
+  }
+  const double lhs_scale =
+      lhs.quantized_per_tensor_element_type().ScaleAs<DataType::kF32>();
+  const double rhs_scale =
+      rhs.quantized_per_tensor_element_type().ScaleAs<DataType::kF32>();
+  const double output_scale =
+      output.quantized_per_tensor_element_type().ScaleAs<DataType::kF32>();
+  MultiplyOp::IntegerParams params;
+  params.output_multiplier =
+      QuantizeMultiplier(lhs_scale * rhs_scale / output_scale);
+  if (!IsSupportedQuantizedMultiplier(params.output_multiplier)) {
+    return std::nullopt;
+  }
+  return params;
+}
+
+// Multiplies 8-bit quantized tensors in fixed point, in the style of TFLite's
+// reference integer kernels, without dequantizing them.
+void EvaluateInteger(const MultiplyOp::IntegerParams& params,
+                     const Tensor& lhs, const Tensor& rhs, Tensor& output) {
+  const int32_t lhs_zero_point =
+      lhs.quantized_per_tensor_element_type().ZeroPointAs<DataType::kSI8>();
+  const int32_t rhs_zero_point =
+      rhs.quantized_per_tensor_element_type().ZeroPointAs<DataType::kSI8>();
+  const int32_t output_zero_point =
+      output.quantized_per_tensor_element_type().ZeroPointAs<DataType::kSI8>();
+  const int8_t* lhs_data = lhs.GetDataAs<DataType::kSI8>();
+  const int8_t* rhs_data = rhs.GetDataAs<DataType::kSI8>();
+  int8_t* output_data = output.GetDataAs<DataType::kSI8>();
+  const DimensionSize num_elements = lhs.NumElements();
+  for (DimensionSize i = 0; i < num_elements; ++i) {
+    const int32_t product =
+        (lhs_data[i] - lhs_zero_point) * (rhs_data[i] - rhs_zero_point);
+    const int32_t result =
+        MultiplyByQuantizedMultiplier(product, params.output_multiplier) +
+        output_zero_point;
+    output_data[i] = static_cast<int8_t>(
+        std::clamp<int32_t>(result, Storage<DataType::kSI8>::kMinValue,
+                            Storage<DataType::kSI8>::kMaxValue));
+  }
+}
+
+}  // namespace
+
 MultiplyOp Create(MultiplyOp::Attributes) { return {}; }
 
 absl::Status Prepare(MultiplyOp& op, const Tensor& lhs, const Tensor& rhs,
@@ -49,6 +106,7 @@ absl::Status Prepare(MultiplyOp& op, const Tensor& lhs, const Tensor& rhs,
       CheckSameBaselineType(CheckCtx("multiply"), lhs, output));
   SHLO_REF_RETURN_ON_ERROR(
       CheckSameBaselineType(CheckCtx("multiply"), rhs, output));
+  op.integer_params = GetIntegerParams(lhs, rhs, output);
   return absl::OkStatus();
 }
 
@@ -64,6 +122,10 @@ absl::Status Evaluate(MultiplyOp& op, const Tensor& lhs, const Tensor& rhs,
     DISPATCH_INT_FLOAT(detail::EvaluateNoQuantization,
                        lhs.tensor_element_type(), multiply, lhs, rhs, output);
   } else if (IsQuantizedPerTensorTensor(lhs)) {
+    if (op.integer_params.has_value()) {
+      EvaluateInteger(*op.integer_params, lhs, rhs, output);
+      return absl::OkStatus();
+    }
     Multiply<DataType::kF32> multiply;
     DISPATCH_QUANTIZED(detail::DequantizeOpQuantizePerTensor,
                        lhs.quantized_per_tensor_element_type().StorageType(),
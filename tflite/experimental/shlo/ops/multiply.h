@@ -16,13 +16,23 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_EXPERIMENTAL_SHLO_OPS_MULTIPLY_H_
 #define TENSORFLOW_LITE_EXPERIMENTAL_SHLO_OPS_MULTIPLY_H_
 
+#include <optional>
+
 #include "absl/status/status.h"
+#include "tflite/experimental/shlo/quantize.h"
 #include "tflite/experimental/shlo/tensor.h"
 
 namespace shlo_ref {
 
 struct MultiplyOp {
   struct Attributes {};
+
+  // The fixed-point parameters of the integer kernel, set by `Prepare` for
+  // 8-bit quantized tensors.
+  struct IntegerParams {
+    QuantizedMultiplier output_multiplier;
+  };
+  std::optional<IntegerParams> integer_params;
 };
 
 MultiplyOp Create(MultiplyOp::Attributes);
@@ -15,11 +15,13 @@ limitations under the License.
 
 #include "tflite/experimental/shlo/ops/multiply.h"
 
+#include <cstdint>
 #include <functional>
 #include <string>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/algorithm/container.h"
 #include "tflite/experimental/shlo/data_type.h"
 #include "tflite/experimental/shlo/ops/binary_elementwise_test_util.h"
 #include "tflite/experimental/shlo/ops/test_util.h"
@@ -30,6 +32,7 @@ limitations under the License.
 #include "tflite/experimental/shlo/tensor.h"
 
 using testing::FloatEq;
+using testing::FloatNear;
 using testing::Pointwise;
 
 namespace shlo_ref {
@@ -157,5 +160,51 @@ TYPED_TEST(QuantizedMultiplyTest, PerTensorWorks) {
   ASSERT_OK(Evaluate(op, lhs_tensor, rhs_tensor, output_tensor));
   EXPECT_THAT(output_data, Pointwise(FloatEq(), expected_data));
 }
+
+TEST(QuantizedMultiplyTest, Int8WithDifferentScalesUsesIntegerKernel) {
+  const Shape shape({2, 3, 4});
+  Vector<int8_t> lhs_data =
+      RandomBuffer<DataType::kSI8>(shape, /*min=*/-50, /*max=*/50);
+  Vector<int8_t> rhs_data =
+      RandomBuffer<DataType::kSI8>(shape, /*min=*/-50, /*max=*/50);
+  Vector<int8_t> output_data(shape.NumElements());
+  const QuantizedElementTypePerTensor lhs_type(DataType::kSI8, 3,
+                                               DataType::kF32, 0.5f);
+  const QuantizedElementTypePerTensor rhs_type(DataType::kSI8, -2,
+                                               DataType::kF32, 0.3f);
+  const QuantizedElementTypePerTensor output_type(DataType::kSI8, 1,
+                                                  DataType::kF32, 7.f);
+  Tensor lhs_tensor{
+      .type = QuantizedPerTensorTensorType{.shape = shape,
+                                           .element_type = lhs_type},
+      .data = lhs_data.data()};
+  Tensor rhs_tensor{
+      .type = QuantizedPerTensorTensorType{.shape = shape,
+                                           .element_type = rhs_type},
+      .data = rhs_data.data()};
+  Tensor output_tensor{
+      .type = QuantizedPerTensorTensorType{.shape = shape,
+                                           .element_type = output_type},
+      .data = output_data.data()};
+
+  Vector<float> expected_data(shape.NumElements());
+  absl::c_transform(
+      lhs_data, rhs_data, expected_data.begin(), [](auto lhs, auto rhs) {
+        const float dequantized_lhs = Dequantize<int8_t, float>(lhs, 3, 0.5f);
+        const float dequantized_rhs = Dequantize<int8_t, float>(rhs, -2, 0.3f);
+        const float dequantized_res =
+            Multiply<DataType::kF32>()(dequantized_lhs, dequantized_rhs);
+        return Quantize<DataType::kSI8, DataType::kF32>(dequantized_res, 1,
+                                                        1.f / 7.f);
+      });
+
+  auto op = Create(MultiplyOp::Attributes{});
+  ASSERT_OK(Prepare(op, lhs_tensor, rhs_tensor, output_tensor));
+  EXPECT_TRUE(op.integer_params.has_value());
+  ASSERT_OK(Evaluate(op, lhs_tensor, rhs_tensor, output_tensor));
+  // The fixed-point arithmetic rounds differently from the float one.
+  EXPECT_THAT(output_data, Pointwise(FloatNear(1), expected_data));
+}
+
 }  // namespace
 }  // namespace shlo_ref
@@ -15,18 +15,95 @@ limitations under the License.
 
 #include "tflite/experimental/shlo/ops/subtract.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <optional>
 
 #include "absl/status/status.h"
+#include "tflite/experimental/shlo/data_type.h"
 #include "tflite/experimental/shlo/dispatch.h"
 #include "tflite/experimental/shlo/ops/binary_elementwise.h"
 #include "tflite/experimental/shlo/ops/util.h"
+#include "tflite/experimental/shlo/quantize.h"
 #include "tflite/experimental/shlo/tensor.h"
 
 namespace shlo_ref {
 
 struct Subtract : std::minus<void> {};
 
+namespace {
+
+// The operands are shifted left before they are rescaled to a common scale to
+// keep the precision of the fixed-point arithmetic, as in TFLite.
+constexpr int kLeftShift = 20;
+
+std::optional<SubtractOp::IntegerParams> GetIntegerParams(
+    const Tensor& lhs, const Tensor& rhs, const Tensor& output) {
+  if (!IsQuantizedPerTensorTensor(lhs) ||
+      lhs.quantized_per_tensor_element_type().StorageType() != DataType::kSI8 ||
+      lhs.quantized_per_tensor_element_type().ExpressedType() !=
+          DataType::kF32) {
+    return std::nullopt;
+  }
+  const double lhs_scale =
+      lhs.quantized_per_tensor_element_type().ScaleAs<DataType::kF32>();
+  const double rhs_scale =
+      rhs.quantized_per_tensor_element_type().ScaleAs<DataType::kF32>();
+  const double output_scale =
+      output.quantized_per_tensor_element_type().ScaleAs<DataType::kF32>();
+  const double twice_max_input_scale = 2 * std::max(lhs_scale, rhs_scale);
+  SubtractOp::IntegerParams params;
+  params.output_multiplier = QuantizeMultiplier(
+      twice_max_input_scale / ((1 << kLeftShift) * output_scale));
+  if (!IsSupportedQuantizedMultiplier(params.output_multiplier)) {
+    return std::nullopt;
+  }
+  const QuantizedMultiplier lhs_multiplier =
+      QuantizeMultiplier(lhs_scale / twice_max_input_scale);
+  const QuantizedMultiplier rhs_multiplier =
+      QuantizeMultiplier(rhs_scale / twice_max_input_scale);
+  const int32_t lhs_zero_point =
+      lhs.quantized_per_tensor_element_type().ZeroPointAs<DataType::kSI8>();
+  const int32_t rhs_zero_point =
+      rhs.quantized_per_tensor_element_type().ZeroPointAs<DataType::kSI8>();
+  for (int i = 0; i < 256; ++i) {
+    const int32_t value = static_cast<int8_t>(i);
+    params.lhs_table[i] = MultiplyByQuantizedMultiplier(
+        (value - lhs_zero_point) * (1 << kLeftShift), lhs_multiplier);
+    params.rhs_table[i] = MultiplyByQuantizedMultiplier(
+        (value - rhs_zero_point) * (1 << kLeftShift), rhs_multiplier);
+  }
+  return params;
+}
+
+// Subtracts 8-bit quantized tensors in fixed point, in the style of TFLite's
+// reference integer kernels, without dequantizing them.
+void EvaluateInteger(const SubtractOp::IntegerParams& params,
+                     const Tensor& lhs, const Tensor& rhs, Tensor& output) {
+  const int32_t output_zero_point =
+      output.quantized_per_tensor_element_type().ZeroPointAs<DataType::kSI8>();
+  const int8_t* lhs_data = lhs.GetDataAs<DataType::kSI8>();
+  const int8_t* rhs_data = rhs.GetDataAs<DataType::kSI8>();
+  int8_t* output_data = output.GetDataAs<DataType::kSI8>();
+  const DimensionSize num_elements = lhs.NumElements();
+  for (DimensionSize i = 0; i < num_elements; ++i) {
+    const int32_t scaled_lhs =
+        params.lhs_table[static_cast<uint8_t>(lhs_data[i])];
+    const int32_t scaled_rhs =
+        params.rhs_table[static_cast<uint8_t>(rhs_data[i])];
+    const int32_t result =
+        MultiplyByQuantizedMultiplier(scaled_lhs - scaled_rhs,
+                                      params.output_multiplier) +
+        output_zero_point;
+    output_data[i] = static_cast<int8_t>(
+        std::clamp<int32_t>(result, Storage<DataType::kSI8>::kMinValue,
+                            Storage<DataType::kSI8>::kMaxValue));
+  }
+}
+
+}  // namespace
+
 SubtractOp Create(SubtractOp::Attributes) { return {}; }
 
 absl::Status Prepare(SubtractOp& op, const Tensor& lhs, const Tensor& rhs,
@@ -39,6 +116,7 @@ absl::Status Prepare(SubtractOp& op, const Tensor& lhs, const Tensor& rhs,
       CheckSameBaselineType(CheckCtx("subtract"), lhs, output));
   SHLO_REF_RETURN_ON_ERROR(
       CheckSameBaselineType(CheckCtx("subtract"), rhs, output));
+  op.integer_params = GetIntegerParams(lhs, rhs, output);
   return absl::OkStatus();
 }
 
@@ -50,6 +128,10 @@ absl::Status Evaluate(SubtractOp& op, const Tensor& lhs, const Tensor& rhs,
     DISPATCH_INT_FLOAT(detail::EvaluateNoQuantization,
                        lhs.tensor_element_type(), subtract, lhs, rhs, output);
   } else if (IsQuantizedPerTensorTensor(lhs)) {
+    if (op.integer_params.has_value()) {
+      EvaluateInteger(*op.integer_params, lhs, rhs, output);
+      return absl::OkStatus();
+    }
     DISPATCH_QUANTIZED(detail::DequantizeOpQuantizePerTensor,
                        lhs.quantized_per_tensor_element_type().StorageType(),
                        lhs.quantized_per_tensor_element_type().ExpressedType(),
@@ -16,13 +16,29 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_EXPERIMENTAL_SHLO_OPS_SUBTRACT_H_
 #define TENSORFLOW_LITE_EXPERIMENTAL_SHLO_OPS_SUBTRACT_H_
 
+#include <array>
+#include <cstdint>
+#include <optional>
+
 #include "absl/status/status.h"
+#include "tflite/experimental/shlo/quantize.h"
 #include "tflite/experimental/shlo/tensor.h"
 
 namespace shlo_ref {
 
 struct SubtractOp {
   struct Attributes {};
+
+  // The fixed-point parameters of the integer kernel, set by `Prepare` for
+  // 8-bit quantized tensors.
+  struct IntegerParams {
+    // The operands rescaled to a common scale in fixed point, indexed by their
+    // storage value.
+    std::array<int32_t, 256> lhs_table;
+    std::array<int32_t, 256> rhs_table;
+    QuantizedMultiplier output_multiplier;
+  };
+  std::optional<IntegerParams> integer_params;
 };
 
 SubtractOp Create(SubtractOp::Attributes);
@@ -16,7 +16,12 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_EXPERIMENTAL_SHLO_OPS_UNARY_ELEMENTWISE_H_
 #define TENSORFLOW_LITE_EXPERIMENTAL_SHLO_OPS_UNARY_ELEMENTWISE_H_
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
 
 #include "absl/algorithm/container.h"
 #include "absl/status/status.h"
@@ -40,9 +45,9 @@ void DequantizeOpQuantizePerAxisImpl(
     const absl::Span<const StorageT> input_zero_points,
     const absl::Span<const ExpressedT> input_scales,
     const absl::Span<const StorageT> output_zero_points,
-    const absl::Span<const ExpressedT> output_scales, const Strides& strides,
-    const StorageT* input_data, StorageT* output_data, const size_t depth,
-    size_t quantization_index) {
+    const absl::Span<const ExpressedT> output_scales_inv,
+    const Strides& strides, const StorageT* input_data, StorageT* output_data,
+    const size_t depth, size_t quantization_index) {
   const DimensionSize dim = shape.Dim(depth);
   if (depth + 1 >= shape.Rank()) {
     for (DimensionSize i = 0; i < dim; ++i) {
@@ -55,8 +60,8 @@ void DequantizeOpQuantizePerAxisImpl(
       const ExpressedT dequantized_res = op(dequantized_input);
       *output_data = Quantize<StorageT, ExpressedT>(
           dequantized_res, output_zero_points[quantization_index],
-          static_cast<ExpressedT>(1) / output_scales[quantization_index],
-          quantization_min, quantization_max);
+          output_scales_inv[quantization_index], quantization_min,
+          quantization_max);
       output_data += strides[depth];
       input_data += strides[depth];
     }
@@ -67,8 +72,9 @@ void DequantizeOpQuantizePerAxisImpl(
       }
       DequantizeOpQuantizePerAxisImpl(
           op, shape, quantization_dimension, quantization_min, quantization_max,
-          input_zero_points, input_scales, output_zero_points, output_scales,
-          strides, input_data, output_data, depth + 1, quantization_index);
+          input_zero_points, input_scales, output_zero_points,
+          output_scales_inv, strides, input_data, output_data, depth + 1,
+          quantization_index);
       output_data += strides[depth];
       input_data += strides[depth];
     }
@@ -91,16 +97,27 @@ void DequantizeOpQuantizePerAxis(F&& func, const Tensor& input,
       output.quantized_per_axis_element_type().ZeroPointsAs<storage_type>();
   const absl::Span<const ExpressedT> output_scales =
       output.quantized_per_axis_element_type().ScalesAs<expressed_type>();
+  // The inverse scales are computed once instead of for every element.
+  std::vector<ExpressedT> output_scales_inv(output_scales.size());
+  absl::c_transform(output_scales, output_scales_inv.begin(),
+                    [](ExpressedT scale) {
+                      return static_cast<ExpressedT>(1) / scale;
+                    });
   const Strides& strides = ComputeStrides(shape);
   const StorageT* input_data = input.GetDataAs<storage_type>();
   StorageT* output_data = output.GetDataAs<storage_type>();
   DequantizeOpQuantizePerAxisImpl(
       func, shape, quantization_dimension, Storage<storage_type>::kMinValue,
       Storage<storage_type>::kMaxValue, input_zero_points, input_scales,
-      output_zero_points, output_scales, strides, input_data, output_data,
-      /*depth=*/0, /*quantization_index=*/0);
+      output_zero_points, absl::MakeConstSpan(output_scales_inv), strides,
+      input_data, output_data, /*depth=*/0, /*quantization_index=*/0);
 }
 
+// The number of elements that the quantized kernels dequantize, compute and
+// quantize at a time. Each step is then a simple loop over a small buffer that
+// the compiler can vectorize.
+inline constexpr DimensionSize kElementwiseBlockSize = 256;
+
 template <DataType storage_type, DataType expressed_type, typename F>
 void DequantizeOpQuantizePerTensor(F& func, const Tensor& input,
                                    Tensor& output) {
@@ -118,13 +135,43 @@ void DequantizeOpQuantizePerTensor(F& func, const Tensor& input,
   const StorageT* input_data = input.GetDataAs<storage_type>();
   StorageT* output_data = output.GetDataAs<storage_type>();
   const ExpressedT inv_scale = static_cast<ExpressedT>(1) / output_scale;
-  for (DimensionSize i = 0; i < num_elements;
-       ++i, ++input_data, ++output_data) {
+  const auto dequantize_op_quantize = [&](StorageT value) {
     const ExpressedT dequantized_input =
-        Dequantize(*input_data, input_zero_point, input_scale);
+        Dequantize(value, input_zero_point, input_scale);
     const ExpressedT dequantized_res = func(dequantized_input);
-    *output_data = Quantize<storage_type, expressed_type>(
+    return Quantize<storage_type, expressed_type>(
         dequantized_res, output_zero_point, inv_scale);
+  };
+  if constexpr (std::is_same_v<StorageT, int8_t>) {
+    // An 8-bit input only has 256 values: tabulate the op over them once and
+    // look the results up.
+    if (num_elements > 256) {
+      std::array<StorageT, 256> table;
+      for (int i = 0; i < 256; ++i) {
+        table[i] = dequantize_op_quantize(static_cast<StorageT>(i));
+      }
+      for (DimensionSize i = 0; i < num_elements; ++i) {
+        output_data[i] = table[static_cast<uint8_t>(input_data[i])];
+      }
+      return;
+    }
+  }
+  ExpressedT block[kElementwiseBlockSize];
+  for (DimensionSize start = 0; start < num_elements;
+       start += kElementwiseBlockSize) {
+    const DimensionSize size =
+        std::min(kElementwiseBlockSize, num_elements - start);
+    for (DimensionSize i = 0; i < size; ++i) {
+      block[i] = Dequantize(input_data[start + i], input_zero_point,
+                            input_scale);
+    }
+    for (DimensionSize i = 0; i < size; ++i) {
+      block[i] = func(block[i]);
+    }
+    for (DimensionSize i = 0; i < size; ++i) {
+      output_data[start + i] = Quantize<storage_type, expressed_type>(
+          block[i], output_zero_point, inv_scale);
+    }
   }
 }
 
@@ -0,0 +1,135 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include <cstddef>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "benchmark/benchmark.h"  // from @com_google_benchmark
+#include "tflite/experimental/shlo/data_type.h"
+#include "tflite/experimental/shlo/ops/abs.h"
+#include "tflite/experimental/shlo/ops/benchmark_util.h"
+#include "tflite/experimental/shlo/ops/cbrt.h"
+#include "tflite/experimental/shlo/ops/ceil.h"
+#include "tflite/experimental/shlo/ops/cosine.h"
+#include "tflite/experimental/shlo/ops/count_leading_zeros.h"
+#include "tflite/experimental/shlo/ops/exponential.h"
+#include "tflite/experimental/shlo/ops/exponential_minus_one.h"
+#include "tflite/experimental/shlo/ops/floor.h"
+#include "tflite/experimental/shlo/ops/log.h"
+#include "tflite/experimental/shlo/ops/log_plus_one.h"
+#include "tflite/experimental/shlo/ops/logistic.h"
+#include "tflite/experimental/shlo/ops/negate.h"
+#include "tflite/experimental/shlo/ops/not.h"
+#include "tflite/experimental/shlo/ops/popcnt.h"
+#include "tflite/experimental/shlo/ops/sign.h"
+#include "tflite/experimental/shlo/ops/sine.h"
+#include "tflite/experimental/shlo/ops/sqrt.h"
+#include "tflite/experimental/shlo/ops/tanh.h"
+#include "tflite/experimental/shlo/shape.h"
+#include "tflite/experimental/shlo/tensor.h"
+#include "tflite/experimental/shlo/tensor_with_data.h"
+
+namespace shlo_ref {
+namespace {
+
+// The result has the same type as the operand for all the benchmarked ops.
+template <class Op>
+void BM_UnaryOp(benchmark::State& state, const Tensor& operand) {
+  Op op = Create(typename Op::Attributes{});
+
+  Tensor result = operand;
+  ABSL_CHECK_OK(Prepare(op, operand, result));
+
+  std::vector<std::byte> result_values(result.SizeInBytes());
+  result.data = result_values.data();
+
+  for (auto _ : state) {
+    ABSL_CHECK_OK(Evaluate(op, operand, result));
+  }
+  state.SetItemsProcessed(state.iterations() * operand.NumElements());
+}
+
+template <class Op, DataType data_type>
+void BM_UnaryOp(benchmark::State& state) {
+  const DimensionSize num_elements = state.range(0);
+
+  auto operand_values = GenerateRandomVector<data_type>(num_elements);
+  auto operand =
+      TensorWithData::Create<data_type>(Shape{{num_elements}}, operand_values);
+
+  BM_UnaryOp<Op>(state, operand.tensor());
+}
+
+template <class Op, DataType storage_type, DataType expressed_type>
+void BM_UnaryOpQuantized(benchmark::State& state) {
+  const DimensionSize num_elements = state.range(0);
+
+  auto operand_values = GenerateRandomVector<expressed_type>(num_elements);
+  auto operand = TensorWithData::Create<storage_type, expressed_type>(
+      Shape{{num_elements}}, operand_values, 0.01, 0);
+
+  BM_UnaryOp<Op>(state, operand.tensor());
+}
+
+#define BENCHMARK_UNARY_OP(OP, ...)      \
+  BENCHMARK(BM_UnaryOp<OP, __VA_ARGS__>) \
+      ->RangeMultiplier(2)               \
+      ->Range(KiB(8), KiB(64))
+
+#define BENCHMARK_UNARY_OP_QUANTIZED(OP, ...)     \
+  BENCHMARK(BM_UnaryOpQuantized<OP, __VA_ARGS__>) \
+      ->RangeMultiplier(2)                        \
+      ->Range(KiB(8), KiB(64))
+
+// Float ops, benchmarked for every float type and for the 8 and 16 bit
+// quantized types, which take different paths.
+#define BENCHMARK_FLOAT_UNARY_OP(OP)                                \
+  BENCHMARK_UNARY_OP(OP, DataType::kBF16);                          \
+  BENCHMARK_UNARY_OP(OP, DataType::kF16);                           \
+  BENCHMARK_UNARY_OP(OP, DataType::kF32);                           \
+  BENCHMARK_UNARY_OP_QUANTIZED(OP, DataType::kSI8, DataType::kF32); \
+  BENCHMARK_UNARY_OP_QUANTIZED(OP, DataType::kSI16, DataType::kF32)
+
+#define BENCHMARK_INT_UNARY_OP(OP)        \
+  BENCHMARK_UNARY_OP(OP, DataType::kSI16); \
+  BENCHMARK_UNARY_OP(OP, DataType::kSI32)
+
+BENCHMARK_FLOAT_UNARY_OP(AbsOp);
+BENCHMARK_FLOAT_UNARY_OP(CbrtOp);
+BENCHMARK_FLOAT_UNARY_OP(CeilOp);
+BENCHMARK_FLOAT_UNARY_OP(CosineOp);
+BENCHMARK_FLOAT_UNARY_OP(ExponentialOp);
+BENCHMARK_FLOAT_UNARY_OP(ExponentialMinusOneOp);
+BENCHMARK_FLOAT_UNARY_OP(FloorOp);
+BENCHMARK_FLOAT_UNARY_OP(LogOp);
+BENCHMARK_FLOAT_UNARY_OP(LogPlusOneOp);
+BENCHMARK_FLOAT_UNARY_OP(LogisticOp);
+BENCHMARK_FLOAT_UNARY_OP(NegateOp);
+BENCHMARK_FLOAT_UNARY_OP(SignOp);
+BENCHMARK_FLOAT_UNARY_OP(SineOp);
+BENCHMARK_FLOAT_UNARY_OP(SqrtOp);
+BENCHMARK_FLOAT_UNARY_OP(TanhOp);
+
+BENCHMARK_INT_UNARY_OP(AbsOp);
+BENCHMARK_INT_UNARY_OP(CountLeadingZerosOp);
+BENCHMARK_INT_UNARY_OP(NegateOp);
+BENCHMARK_INT_UNARY_OP(NotOp);
+BENCHMARK_INT_UNARY_OP(PopcntOp);
+BENCHMARK_INT_UNARY_OP(SignOp);
+
+}  // namespace
+}  // namespace shlo_ref
+
+BENCHMARK_MAIN();
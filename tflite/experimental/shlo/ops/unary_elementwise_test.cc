@@ -117,6 +117,44 @@ TYPED_TEST(QuantizedUnaryElementWiseTest, QuantizedPerTensorWithAbs) {
   EXPECT_THAT(output_data, ElementsAreArray(expected_data));
 }
 
+TYPED_TEST(QuantizedUnaryElementWiseTest, QuantizedPerTensorWithAbsOverSeveralBlocks) {
+  // Spans several blocks, the last one partial, and looks 8-bit inputs up in a
+  // table.
+  using StorageT = typename TypeParam::StorageT;
+  using ExpressedT = typename TypeParam::ExpressedT;
+
+  const Shape shape({3, 10, 20});
+  Vector<StorageT> input_data = RandomBuffer<TypeParam::kStorage>(shape);
+  Vector<StorageT> output_data(shape.NumElements());
+  const ExpressedT scale = static_cast<ExpressedT>(1.5);
+  const StorageT zero_point = static_cast<StorageT>(5);
+  const QuantizedElementTypePerTensor tensor_type =
+      QuantizedElementTypePerTensor(TypeParam::kStorage, zero_point,
+                                    TypeParam::kExpressed, scale);
+  Tensor input_tensor{
+      .type = QuantizedPerTensorTensorType{.shape = shape,
+                                           .element_type = tensor_type},
+      .data = input_data.data()};
+  Tensor output_tensor{
+      .type = QuantizedPerTensorTensorType{.shape = shape,
+                                           .element_type = tensor_type},
+      .data = output_data.data()};
+
+  Vector<StorageT> expected_data(shape.NumElements());
+  absl::c_transform(
+      input_data, expected_data.begin(), [zero_point, scale](auto v) {
+        const ExpressedT dequantized_input = Dequantize(v, zero_point, scale);
+        const ExpressedT dequantized_res = Abs()(dequantized_input);
+        return Quantize<TypeParam::kStorage, TypeParam::kExpressed>(
+            dequantized_res, zero_point, static_cast<ExpressedT>(1.) / scale);
+      });
+
+  auto op = Create(UnaryElementwiseOp<Abs>::Attributes{}, Abs());
+  ASSERT_OK(Prepare(op, input_tensor, output_tensor));
+  ASSERT_OK(Evaluate(op, input_tensor, output_tensor));
+  EXPECT_THAT(output_data, ElementsAreArray(expected_data));
+}
+
 TYPED_TEST(QuantizedUnaryElementWiseTest, QuantizedPerAxisWithAbs) {
   using StorageT = typename TypeParam::StorageT;
   using ExpressedT = typename TypeParam::ExpressedT;
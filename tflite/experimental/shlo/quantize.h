@@ -16,6 +16,8 @@ limitations under the License.
 #define TENSORFLOW_LITE_EXPERIMENTAL_SHLO_QUANTIZE_H_
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 
 #include "tflite/experimental/shlo/data_type.h"
 
@@ -65,6 +67,52 @@ inline constexpr ExpressedT Dequantize(StorageT quantized_value,
   auto sub = quantized_value - zero_point;
   return static_cast<ExpressedT>(sub) * scale;
 }
+
+// A real multiplier in fixed point, as used by the integer kernels of TFLite:
+// `multiplier` * 2^(`shift` - 31), where `multiplier` is in [2^30, 2^31) or 0.
+struct QuantizedMultiplier {
+  int32_t multiplier = 0;
+  int shift = 0;
+};
+
+// Converts a positive real multiplier to fixed point. Multipliers too small to
+// be represented are flushed to zero.
+inline QuantizedMultiplier QuantizeMultiplier(double real_multiplier) {
+  QuantizedMultiplier result;
+  if (real_multiplier <= 0) {
+    return result;
+  }
+  const double q = std::frexp(real_multiplier, &result.shift);
+  int64_t q_fixed = static_cast<int64_t>(std::round(q * (int64_t{1} << 31)));
+  if (q_fixed == (int64_t{1} << 31)) {
+    q_fixed /= 2;
+    ++result.shift;
+  }
+  if (result.shift < -31) {
+    return QuantizedMultiplier();
+  }
+  result.multiplier = static_cast<int32_t>(q_fixed);
+  return result;
+}
+
+// Returns whether `MultiplyByQuantizedMultiplier` can apply the multiplier,
+// i.e. whether it is smaller than 2^30.
+inline constexpr bool IsSupportedQuantizedMultiplier(
+    QuantizedMultiplier multiplier) {
+  return multiplier.shift <= 30;
+}
+
+// Multiplies `value` by the fixed-point `multiplier`, rounding half away from
+// zero like `Quantize` does.
+inline constexpr int32_t MultiplyByQuantizedMultiplier(
+    int32_t value, QuantizedMultiplier multiplier) {
+  const int total_shift = 31 - multiplier.shift;
+  const int64_t round = int64_t{1} << (total_shift - 1);
+  const int64_t product = int64_t{value} * multiplier.multiplier;
+  const int64_t magnitude =
+      ((product < 0 ? -product : product) + round) >> total_shift;
+  return static_cast<int32_t>(product < 0 ? -magnitude : magnitude);
+}
 }  // namespace shlo_ref
 
 #endif  // TENSORFLOW_LITE_EXPERIMENTAL_SHLO_QUANTIZE_H_
@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "tflite/experimental/shlo/quantize.h"
 
+#include <cstdint>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "tflite/experimental/shlo/data_type.h"
@@ -128,5 +130,24 @@ TEST(QuantizeTest, QuantizedValueRoundUp) {
               Eq(expected_value));
 }
 
+TEST(QuantizeMultiplierTest, RepresentsMultiplierInFixedPoint) {
+  const QuantizedMultiplier multiplier = QuantizeMultiplier(0.75);
+  EXPECT_THAT(multiplier.multiplier, Eq(int32_t{3} << 29));
+  EXPECT_THAT(multiplier.shift, Eq(0));
+  EXPECT_THAT(QuantizeMultiplier(6).shift, Eq(3));
+  EXPECT_THAT(QuantizeMultiplier(0x1p-40).multiplier, Eq(0));
+  EXPECT_TRUE(IsSupportedQuantizedMultiplier(QuantizeMultiplier(0x1p29)));
+  EXPECT_FALSE(IsSupportedQuantizedMultiplier(QuantizeMultiplier(0x1p30)));
+}
+
+TEST(QuantizeMultiplierTest, RoundsHalfAwayFromZero) {
+  const QuantizedMultiplier multiplier = QuantizeMultiplier(1.5);
+  EXPECT_THAT(MultiplyByQuantizedMultiplier(3, multiplier), Eq(5));
+  EXPECT_THAT(MultiplyByQuantizedMultiplier(-3, multiplier), Eq(-5));
+  EXPECT_THAT(MultiplyByQuantizedMultiplier(-4, multiplier), Eq(-6));
+  EXPECT_THAT(MultiplyByQuantizedMultiplier(7, QuantizeMultiplier(0.1)),
+              Eq(1));
+}
+
 }  // namespace
 }  // namespace shlo_ref
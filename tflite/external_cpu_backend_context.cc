@@ -14,6 +14,9 @@ limitations under the License.
 ==============================================================================*/
 #include "tflite/external_cpu_backend_context.h"
 
+#include <memory>
+#include <utility>
+
 #include "tflite/core/c/common.h"
 
 namespace tflite {
@@ -37,4 +40,14 @@ ExternalCpuBackendContext::ExternalCpuBackendContext()
   this->Refresh = RefreshExternalCpuBackendContext;
 }
 
+void ExternalCpuBackendContext::set_shared_thread_pool(
+    std::shared_ptr<TfLiteCpuThreadPool> thread_pool, int priority) {
+  shared_thread_pool_ = std::move(thread_pool);
+  shared_thread_pool_priority_ = priority;
+  if (internal_backend_context_) {
+    internal_backend_context_->SetSharedThreadPool(shared_thread_pool_,
+                                                   priority);
+  }
+}
+
 }  // namespace tflite
@@ -15,6 +15,7 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_EXTERNAL_CPU_BACKEND_CONTEXT_H_
 #define TENSORFLOW_LITE_EXTERNAL_CPU_BACKEND_CONTEXT_H_
 
+#include <functional>
 #include <memory>
 #include <utility>
 
@@ -22,6 +23,23 @@ limitations under the License.
 
 namespace tflite {
 
+// A pool of threads shared by the cpu backend contexts of the interpreters of
+// a process, so that running several models doesn't create several sets of
+// threads competing for the cores.
+//
+// WARNING: This is an experimental API and subject to change.
+class TfLiteCpuThreadPool {
+ public:
+  virtual ~TfLiteCpuThreadPool() {}
+
+  // Calls `task(i)` for each i in [0, tasks_count) on the threads of the pool,
+  // and returns once all the calls returned. It can be called from several
+  // threads at the same time: the callers with the highest `priority` are
+  // served first, and those with the same priority in order.
+  virtual void Execute(int tasks_count, const std::function<void(int)>& task,
+                       int priority) = 0;
+};
+
 // This is the base class for TF Lite internal backend contexts (like a
 // RUY-based cpu backend context class). A derived internal backend context is
 // generally a collection of utilities (i.e. a thread pool etc.) for TF Lite to
@@ -38,6 +56,11 @@ class TfLiteInternalBackendContext {
   // A context may internally cache prepacked versions of constant tensors for
   // faster computation. This function will clear any caches on the context.
   virtual void ClearCaches() = 0;
+
+  // Runs the parallel tasks of the context on `thread_pool` with `priority`,
+  // or on the threads of the context if `thread_pool` is nullptr.
+  virtual void SetSharedThreadPool(
+      std::shared_ptr<TfLiteCpuThreadPool> thread_pool, int priority) {}
 };
 
 // This TfLiteExternalContext-derived class is the default
@@ -73,6 +96,17 @@ class TfLiteInternalBackendContext {
 // interpreters, don't call 'SetNumThreads' consecutively but call it
 // separately between each interpreter's invocation as illustrated above.
 //
+// To run several interpreters at the same time without oversubscribing the
+// cores, give each one its own context, sharing a TfLiteCpuThreadPool instead:
+//
+//  auto pool = std::make_shared<SharedCpuThreadPool>(options);
+//  auto* ctxt1 = new ExternalCpuBackendContext();
+//  ctxt1->set_shared_thread_pool(pool, /*priority=*/1);
+//  interpreter1->SetExternalContext(kTfLiteCpuBackendContext, ctxt1);
+//  auto* ctxt2 = new ExternalCpuBackendContext();
+//  ctxt2->set_shared_thread_pool(pool, /*priority=*/0);
+//  interpreter2->SetExternalContext(kTfLiteCpuBackendContext, ctxt2);
+//
 // Note: it is the responsibility of the user of this context (i.e. a
 // TFLiteInterpreter) to clear any state from the internal backend
 // context if/when the interpreter no longer needs the shared context.
@@ -86,16 +120,34 @@ class ExternalCpuBackendContext : public TfLiteExternalContext {
   void set_internal_backend_context(
       std::unique_ptr<TfLiteInternalBackendContext> internal_backend_context) {
     internal_backend_context_ = std::move(internal_backend_context);
+    if (internal_backend_context_ && shared_thread_pool_) {
+      internal_backend_context_->SetSharedThreadPool(
+          shared_thread_pool_, shared_thread_pool_priority_);
+    }
   }
 
   TfLiteInternalBackendContext* internal_backend_context() const {
     return internal_backend_context_.get();
   }
 
+  // Runs the parallel tasks of the interpreters using this context on
+  // `thread_pool`, with `priority` among the other users of the pool.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void set_shared_thread_pool(std::shared_ptr<TfLiteCpuThreadPool> thread_pool,
+                              int priority = 0);
+
+  TfLiteCpuThreadPool* shared_thread_pool() const {
+    return shared_thread_pool_.get();
+  }
+
  private:
   // Note the actual internal backend context object is lazily initialized.
   std::unique_ptr<TfLiteInternalBackendContext> internal_backend_context_;
 
+  std::shared_ptr<TfLiteCpuThreadPool> shared_thread_pool_;
+  int shared_thread_pool_priority_ = 0;
+
   ExternalCpuBackendContext(const ExternalCpuBackendContext&) = delete;
   ExternalCpuBackendContext& operator=(const ExternalCpuBackendContext&) =
       delete;
@@ -294,4 +294,47 @@ TfLiteStatus PartitionGraphIntoIndependentNodeSubsets(
   return kTfLiteOk;
 }
 
+int AssignNodeLevels(const GraphInfo* info, const std::vector<bool>& exclusive,
+                     const ControlEdges& control_edges,
+                     std::vector<int>* levels) {
+  const int num_nodes = info->num_execution_nodes();
+  levels->assign(num_nodes, 0);
+  // The level of the node producing each tensor, or -1 for the tensors which
+  // are always ready.
+  std::vector<int> tensor_levels(info->num_tensors(), -1);
+  std::vector<std::vector<int>> incoming_control_edges(num_nodes);
+  for (const auto& edge : control_edges) {
+    if (edge.first >= 0 && edge.first < edge.second &&
+        edge.second < num_nodes) {
+      incoming_control_edges[edge.second].push_back(edge.first);
+    }
+  }
+  int num_levels = 0;
+  // The level of the last exclusive node, which all the later nodes follow.
+  int barrier_level = -1;
+  for (int node_index = 0; node_index < num_nodes; ++node_index) {
+    const TfLiteNode& node = info->node(node_index);
+    int level = barrier_level + 1;
+    if (node_index < exclusive.size() && exclusive[node_index]) {
+      level = num_levels;
+      barrier_level = level;
+    } else {
+      for (int input_tensor_index : TfLiteIntArrayView(node.inputs)) {
+        if (input_tensor_index == kTfLiteOptionalTensor) continue;
+        level = std::max(level, tensor_levels[input_tensor_index] + 1);
+      }
+      for (const int dependency : incoming_control_edges[node_index]) {
+        level = std::max(level, (*levels)[dependency] + 1);
+      }
+    }
+    (*levels)[node_index] = level;
+    num_levels = std::max(num_levels, level + 1);
+    for (int output_tensor_index : TfLiteIntArrayView(node.outputs)) {
+      if (output_tensor_index == kTfLiteOptionalTensor) continue;
+      tensor_levels[output_tensor_index] = level;
+    }
+  }
+  return num_levels;
+}
+
 }  // namespace tflite
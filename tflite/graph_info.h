@@ -157,6 +157,23 @@ TfLiteStatus PartitionGraphIntoIndependentNodeSubsets(
     const ControlEdges* control_edges = nullptr,
     bool disable_node_fusion = false);
 
+// Assigns each node of the execution plan of `info` a level, in `levels`, by
+// execution plan index, such that the nodes of a level don't depend on each
+// other and can run at the same time, once the nodes of the lower levels ran.
+// The level of a node is higher than those of the nodes producing its inputs,
+// and of the nodes it depends on through `control_edges`, given by execution
+// plan index. The nodes for which `exclusive` is true get a level of their
+// own, higher than those of the nodes before them in the execution plan, and
+// lower than those of the nodes after them. The function assumes that the
+// nodes of the graph represented in *info are in dependency order, and
+// returns the number of levels.
+//
+// (Example: the graph 0 --> 1 --> 3, 0 --> 2 --> 3 gets the levels
+// {0, 1, 1, 2}. If node 2 is exclusive, the levels are {0, 1, 2, 3}.)
+int AssignNodeLevels(const GraphInfo* info, const std::vector<bool>& exclusive,
+                     const ControlEdges& control_edges,
+                     std::vector<int>* levels);
+
 }  // namespace tflite
 
 #endif  // TENSORFLOW_LITE_GRAPH_INFO_H_
@@ -692,5 +692,47 @@ TEST(PartitionTest, ComplexNonGreedily) {
                                 })));
 }
 
+TEST(AssignNodeLevelsTest, IndependentNodesShareLevel) {
+  // 0 --> 1 --> 3
+  // |           ^
+  // ▲--> 2 -----▲
+  SimpleTestGraph graph(
+      /*inputs=*/{0}, /*outputs=*/{4},
+      /*nodes=*/
+      {
+          {{0}, {1}, false},
+          {{1}, {2}, false},
+          {{1}, {3}, false},
+          {{2, 3}, {4}, false},
+      });
+  std::vector<int> levels;
+  EXPECT_EQ(AssignNodeLevels(&graph, {}, {}, &levels), 3);
+  EXPECT_EQ(levels, std::vector<int>({0, 1, 1, 2}));
+
+  // Node 2 runs alone, after node 1.
+  EXPECT_EQ(AssignNodeLevels(&graph, {false, false, true, false}, {}, &levels),
+            4);
+  EXPECT_EQ(levels, std::vector<int>({0, 1, 2, 3}));
+
+  // Node 2 depends on node 1.
+  EXPECT_EQ(AssignNodeLevels(&graph, {}, {{1, 2}}, &levels), 4);
+  EXPECT_EQ(levels, std::vector<int>({0, 1, 2, 3}));
+}
+
+TEST(AssignNodeLevelsTest, NodesAfterExclusiveNodeFollowIt) {
+  // Node 1 reads a graph input but comes after the exclusive node 0.
+  SimpleTestGraph graph(
+      /*inputs=*/{0, 1}, /*outputs=*/{2, 3, 4},
+      /*nodes=*/
+      {
+          {{0}, {2}, true},
+          {{1}, {3}, false},
+          {{1}, {4}, false},
+      });
+  std::vector<int> levels;
+  EXPECT_EQ(AssignNodeLevels(&graph, {true, false, false}, {}, &levels), 2);
+  EXPECT_EQ(levels, std::vector<int>({0, 1, 1}));
+}
+
 }  // namespace
 }  // namespace tflite
@@ -19,12 +19,26 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_INTERPRETER_OPTIONS_H_
 #define TENSORFLOW_LITE_INTERPRETER_OPTIONS_H_
 
+#include <cstddef>
+
 namespace tflite {
 
 /// Options class for `Interpreter`.
 /// WARNING: This is an experimental API and subject to change.
 class InterpreterOptions {
  public:
+  /// How the memory of the tensor arenas is backed.
+  /// WARNING: This is an experimental API and subject to change.
+  enum class ArenaHugePages {
+    /// Regular pages.
+    kNone,
+    /// Transparent huge pages, if the kernel supports them.
+    kTransparent,
+    /// Huge pages from the reserved pool, or transparent huge pages when the
+    /// pool is exhausted.
+    kExplicit,
+  };
+
   /// Preserving all intermediates tensors for debugging.
   /// WARNING: This is an experimental API and subject to change.
   void SetPreserveAllTensors(bool value = true) {
@@ -133,6 +147,141 @@ class InterpreterOptions {
     return experimental_use_signature_tensor_names_;
   }
 
+  // If set to `true`, the arenas of the subgraphs called by control flow ops
+  // (WHILE, IF and STABLEHLO_CASE) are planned into the arena of the calling
+  // subgraph, in the memory its tensors don't use while the op runs, instead
+  // of being allocated separately. This only applies to subgraphs called by a
+  // single op, which must not be invoked on their own. It has no effect when
+  // all tensors are preserved.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetShareSubgraphArenas(bool value = true) {
+    experimental_share_subgraph_arenas_ = value;
+  }
+
+  // If `true`, the arenas of called subgraphs are planned into the arena of
+  // their caller.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  bool GetShareSubgraphArenas() const {
+    return experimental_share_subgraph_arenas_;
+  }
+
+  // If set to `true`, re-planning the arenas after `ResizeInputTensor()` keeps
+  // the tensors that still fit in place and only plans the others, as long as
+  // the arena doesn't have to grow. The arena grows in size classes instead
+  // of to the exact size it needs, so that shapes changing on every call, e.g.
+  // the sequence length, don't reallocate it every time. This trades some
+  // memory, at most what the largest shapes seen so far need, for faster
+  // `AllocateTensors()` calls.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetIncrementalArenaPlanning(bool value = true) {
+    experimental_incremental_arena_planning_ = value;
+  }
+
+  // If `true`, the arenas are re-planned incrementally after a resize.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  bool GetIncrementalArenaPlanning() const {
+    return experimental_incremental_arena_planning_;
+  }
+
+  // Sets whether the tensor arenas are backed by huge pages, to reduce the TLB
+  // misses of large arenas. Only supported on Linux.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetArenaHugePages(ArenaHugePages value) {
+    experimental_arena_huge_pages_ = value;
+  }
+
+  // WARNING: This is an experimental API and subject to change.
+  ArenaHugePages GetArenaHugePages() const {
+    return experimental_arena_huge_pages_;
+  }
+
+  // Sets the NUMA node the memory of the tensor arenas preferably comes from,
+  // e.g. the node of the threads running the interpreter, or -1 to leave it to
+  // the system. Only supported on Linux.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetArenaNumaNode(int value) { experimental_arena_numa_node_ = value; }
+
+  // WARNING: This is an experimental API and subject to change.
+  int GetArenaNumaNode() const { return experimental_arena_numa_node_; }
+
+  // If set to `true`, the pages of the tensor arenas are touched when they are
+  // allocated in `AllocateTensors()`, rather than faulted in by the first
+  // inference.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetArenaPrefault(bool value = true) {
+    experimental_arena_prefault_ = value;
+  }
+
+  // WARNING: This is an experimental API and subject to change.
+  bool GetArenaPrefault() const { return experimental_arena_prefault_; }
+
+  // Sets the number of threads running independent nodes of the subgraphs at
+  // the same time, including the thread calling `Invoke()`. The nodes are
+  // grouped in levels whose nodes don't depend on each other, and the levels
+  // run one after the other. Only the builtin ops known to be safe to run
+  // concurrently, without delegates, are grouped; the others run alone. The
+  // nodes also run one at a time while profiling or with dynamic tensors.
+  // Values below 2 disable it, which is the default.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetInterOpThreads(int value) { experimental_inter_op_threads_ = value; }
+
+  // WARNING: This is an experimental API and subject to change.
+  int GetInterOpThreads() const { return experimental_inter_op_threads_; }
+
+  // If set to `true` and the model is memory mapped, the constant tensors are
+  // streamed following the execution plan: the weights of the next nodes are
+  // prefetched with `madvise()` before they run, and the least recently used
+  // ones are released beyond the weight streaming budget. The subgraphs then
+  // run their nodes one at a time. Only supported on POSIX platforms.
+  //
+  // Independently of this option, on Linux, the operators stalled by major
+  // page faults are followed by a `PageFaults` runtime instrumentation event
+  // in the profiler, with the duration of the operator and the number of
+  // faults as its first metadata.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetWeightStreaming(bool value = true) {
+    experimental_weight_streaming_ = value;
+  }
+
+  // WARNING: This is an experimental API and subject to change.
+  bool GetWeightStreaming() const { return experimental_weight_streaming_; }
+
+  // Sets the size of the weights kept in memory by weight streaming, or 0 for
+  // no limit, which is the default. The weights of the nodes about to run are
+  // kept even when they exceed it.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetWeightStreamingBudget(size_t bytes) {
+    experimental_weight_streaming_budget_ = bytes;
+  }
+
+  // WARNING: This is an experimental API and subject to change.
+  size_t GetWeightStreamingBudget() const {
+    return experimental_weight_streaming_budget_;
+  }
+
+  // Sets the number of nodes whose weights are prefetched ahead of their run
+  // by weight streaming. Defaults to 2.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetWeightStreamingLookahead(int value) {
+    experimental_weight_streaming_lookahead_ = value;
+  }
+
+  // WARNING: This is an experimental API and subject to change.
+  int GetWeightStreamingLookahead() const {
+    return experimental_weight_streaming_lookahead_;
+  }
+
  private:
   bool experimental_preserve_all_tensors_ = false;
   bool experimental_ensure_dynamic_tensors_are_released_ = false;
@@ -141,6 +290,15 @@ class InterpreterOptions {
   bool experimental_cache_constant_cast_op_ = false;
   bool experimental_shlo_composite_inlining_ = false;
   bool experimental_use_signature_tensor_names_ = false;
+  bool experimental_share_subgraph_arenas_ = false;
+  bool experimental_incremental_arena_planning_ = false;
+  ArenaHugePages experimental_arena_huge_pages_ = ArenaHugePages::kNone;
+  int experimental_arena_numa_node_ = -1;
+  bool experimental_arena_prefault_ = false;
+  int experimental_inter_op_threads_ = 1;
+  bool experimental_weight_streaming_ = false;
+  size_t experimental_weight_streaming_budget_ = 0;
+  int experimental_weight_streaming_lookahead_ = 2;
 };
 
 }  // namespace tflite
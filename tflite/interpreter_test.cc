@@ -20,6 +20,7 @@ limitations under the License.
 #include <stdlib.h>
 #include <string.h>
 
+#include <cmath>
 #include <map>
 #include <memory>
 #include <string>
@@ -1129,6 +1130,154 @@ TEST(BasicInterpreter, ReleaseDynamicTensors) {
   ASSERT_EQ(interpreter.tensor(3)->bytes, sizeof(float) * 6 * 6);
 }
 
+TEST(BasicInterpreter, InterOpThreadsRunIndependentNodesTogether) {
+  // Two chains of negations of the input, added together.
+  Interpreter interpreter;
+  InterpreterOptions options;
+  options.SetInterOpThreads(2);
+  interpreter.ApplyOptions(&options);
+  interpreter.AddTensors(6);
+  interpreter.SetInputs({0});
+  interpreter.SetOutputs({5});
+  TfLiteQuantizationParams quant;
+  for (int i = 0; i < 6; ++i) {
+    interpreter.SetTensorParametersReadWrite(i, kTfLiteFloat32, "", {256},
+                                             quant);
+  }
+  TfLiteRegistration* neg_op = ops::builtin::Register_NEG();
+  TfLiteRegistration* add_op = ops::builtin::Register_ADD();
+  interpreter.AddNodeWithParameters({0}, {1}, nullptr, 0, nullptr, neg_op);
+  interpreter.AddNodeWithParameters({1}, {2}, nullptr, 0, nullptr, neg_op);
+  interpreter.AddNodeWithParameters({0}, {3}, nullptr, 0, nullptr, neg_op);
+  interpreter.AddNodeWithParameters({3}, {4}, nullptr, 0, nullptr, neg_op);
+  auto* add_params =
+      reinterpret_cast<TfLiteAddParams*>(malloc(sizeof(TfLiteAddParams)));
+  add_params->activation = kTfLiteActNone;
+  interpreter.AddNodeWithParameters({2, 4}, {5}, nullptr, 0, add_params,
+                                    add_op);
+  ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+
+  // The first nodes of the chains run together, and so do the second ones.
+  EXPECT_THAT(interpreter.execution_plan(), ElementsAre(0, 2, 1, 3, 4));
+  // So the tensors they write don't share memory with those they read.
+  for (const auto& [a, b] : std::vector<std::pair<int, int>>{
+           {1, 3}, {1, 2}, {1, 4}, {3, 2}, {3, 4}, {2, 4}}) {
+    EXPECT_NE(interpreter.tensor(a)->data.raw, interpreter.tensor(b)->data.raw);
+  }
+
+  for (int iteration = 0; iteration < 10; ++iteration) {
+    float* input = interpreter.typed_tensor<float>(0);
+    for (int i = 0; i < 256; ++i) {
+      input[i] = i + iteration;
+    }
+    ASSERT_EQ(interpreter.Invoke(), kTfLiteOk);
+    const float* output = interpreter.typed_tensor<float>(5);
+    for (int i = 0; i < 256; ++i) {
+      ASSERT_EQ(output[i], 2 * (i + iteration));
+    }
+  }
+}
+
+TEST(BasicInterpreter, InterOpThreadsKeepCpuBackendContextUsersApart) {
+  // Two softmaxes of the input, added together. The softmax kernels share the
+  // lazily created CPU backend context, so they must not run together.
+  Interpreter interpreter;
+  InterpreterOptions options;
+  options.SetInterOpThreads(2);
+  interpreter.ApplyOptions(&options);
+  interpreter.AddTensors(4);
+  interpreter.SetInputs({0});
+  interpreter.SetOutputs({3});
+  TfLiteQuantizationParams quant;
+  for (int i = 0; i < 4; ++i) {
+    interpreter.SetTensorParametersReadWrite(i, kTfLiteFloat32, "", {1, 256},
+                                             quant);
+  }
+  TfLiteRegistration* softmax_op = ops::builtin::Register_SOFTMAX();
+  TfLiteRegistration* add_op = ops::builtin::Register_ADD();
+  for (int output : {1, 2}) {
+    auto* softmax_params = reinterpret_cast<TfLiteSoftmaxParams*>(
+        malloc(sizeof(TfLiteSoftmaxParams)));
+    softmax_params->beta = 1.0f;
+    interpreter.AddNodeWithParameters({0}, {output}, nullptr, 0,
+                                      softmax_params, softmax_op);
+  }
+  auto* add_params =
+      reinterpret_cast<TfLiteAddParams*>(malloc(sizeof(TfLiteAddParams)));
+  add_params->activation = kTfLiteActNone;
+  interpreter.AddNodeWithParameters({1, 2}, {3}, nullptr, 0, add_params,
+                                    add_op);
+  ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+
+  // Each softmax runs in a level of its own.
+  EXPECT_THAT(interpreter.execution_plan(), ElementsAre(0, 1, 2));
+
+  for (int iteration = 0; iteration < 10; ++iteration) {
+    float* input = interpreter.typed_tensor<float>(0);
+    float sum = 0.0f;
+    for (int i = 0; i < 256; ++i) {
+      input[i] = (i % 16 + iteration) / 16.0f;
+      sum += std::exp(input[i]);
+    }
+    ASSERT_EQ(interpreter.Invoke(), kTfLiteOk);
+    const float* output = interpreter.typed_tensor<float>(3);
+    for (int i = 0; i < 256; ++i) {
+      ASSERT_NEAR(output[i], 2 * std::exp(input[i]) / sum, 1e-6);
+    }
+  }
+}
+
+TEST(BasicInterpreter, AllocateTensorsSkipsPrepareWhenInputsAreUnchanged) {
+  static int num_prepares = 0;
+  num_prepares = 0;
+  Interpreter interpreter;
+  interpreter.AddTensors(2);
+  interpreter.SetInputs({0});
+  interpreter.SetOutputs({1});
+  TfLiteQuantizationParams quant;
+  interpreter.SetTensorParametersReadWrite(0, kTfLiteFloat32, "", {3}, quant);
+  interpreter.SetTensorParametersReadWrite(1, kTfLiteFloat32, "", {3}, quant);
+  TfLiteRegistration registration = {nullptr, nullptr, nullptr, nullptr};
+  registration.prepare = [](TfLiteContext* context, TfLiteNode* node) {
+    ++num_prepares;
+    const TfLiteTensor* input = &context->tensors[node->inputs->data[0]];
+    TfLiteTensor* output = &context->tensors[node->outputs->data[0]];
+    return context->ResizeTensor(context, output,
+                                 TfLiteIntArrayCopy(input->dims));
+  };
+  ASSERT_EQ(interpreter.AddNodeWithParameters({0}, {1}, nullptr, 0, nullptr,
+                                              &registration),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+  EXPECT_EQ(num_prepares, 1);
+
+  // Releasing the non-persistent memory doesn't change what the node was
+  // prepared for.
+  ASSERT_EQ(interpreter.ReleaseNonPersistentMemory(), kTfLiteOk);
+  ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+  EXPECT_EQ(num_prepares, 1);
+  EXPECT_NE(interpreter.tensor(1)->data.raw, nullptr);
+
+  // Neither does resizing the input to another shape and back.
+  ASSERT_EQ(interpreter.ResizeInputTensor(0, {5}), kTfLiteOk);
+  ASSERT_EQ(interpreter.ResizeInputTensor(0, {3}), kTfLiteOk);
+  ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+  EXPECT_EQ(num_prepares, 1);
+
+  ASSERT_EQ(interpreter.ResizeInputTensor(0, {5}), kTfLiteOk);
+  ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+  EXPECT_EQ(num_prepares, 2);
+  EXPECT_EQ(interpreter.tensor(1)->bytes, 5 * sizeof(float));
+
+  // Changing the graph prepares the node again.
+  ASSERT_EQ(
+      interpreter.SetTensorParametersReadWrite(1, kTfLiteFloat32, "", {5},
+                                               quant),
+      kTfLiteOk);
+  ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+  EXPECT_EQ(num_prepares, 3);
+}
+
 TEST(InterpreterTensorsCapacityTest, TestWithinHeadroom) {
   Interpreter interpreter;
   ASSERT_EQ(interpreter.AddTensors(Interpreter::kTensorsReservedCapacity),
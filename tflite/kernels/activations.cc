@@ -1179,9 +1179,15 @@ TfLiteStatus SoftmaxQuantized(TfLiteContext* context, const TfLiteTensor* input,
                            GetTensorData<In>(input), GetTensorShape(output),
                            GetTensorData<Out>(output));
   } else {
-    optimized_ops::Softmax(data->params, GetTensorShape(input),
-                           GetTensorData<In>(input), GetTensorShape(output),
-                           GetTensorData<Out>(output));
+    const SoftmaxParams& params = data->params;
+    optimized_ops::SoftmaxByRows(
+        GetTensorShape(input), GetTensorData<In>(input), GetTensorShape(output),
+        GetTensorData<Out>(output), CpuBackendContext::GetFromContext(context),
+        [&params](const RuntimeShape& shape, const In* input_data,
+                  Out* output_data) {
+          optimized_ops::Softmax(params, shape, input_data, shape,
+                                 output_data);
+        });
   }
   return kTfLiteOk;
 }
@@ -1197,15 +1203,21 @@ TfLiteStatus SoftmaxQuantized<int8_t, int8_t>(TfLiteContext* context,
                            GetTensorData<int8_t>(input), GetTensorShape(output),
                            GetTensorData<int8_t>(output));
   } else {
+    const SoftmaxParams& params = data->params;
+    optimized_ops::SoftmaxByRows(
+        GetTensorShape(input), GetTensorData<int8_t>(input),
+        GetTensorShape(output), GetTensorData<int8_t>(output),
+        CpuBackendContext::GetFromContext(context),
+        [&params](const RuntimeShape& shape, const int8_t* input_data,
+                  int8_t* output_data) {
 #ifdef TFLITE_SOFTMAX_USE_UINT16_LUT
-    optimized_ops::SoftmaxInt8LUT(
-        data->params, GetTensorShape(input), GetTensorData<int8_t>(input),
-        GetTensorShape(output), GetTensorData<int8_t>(output));
+          optimized_ops::SoftmaxInt8LUT(params, shape, input_data, shape,
+                                        output_data);
 #else
-    optimized_ops::Softmax(data->params, GetTensorShape(input),
-                           GetTensorData<int8_t>(input), GetTensorShape(output),
-                           GetTensorData<int8_t>(output));
+          optimized_ops::Softmax(params, shape, input_data, shape,
+                                 output_data);
 #endif
+        });
   }
   return kTfLiteOk;
 }
@@ -1221,15 +1233,21 @@ TfLiteStatus SoftmaxQuantized<uint8_t, uint8_t>(TfLiteContext* context,
         data->params, GetTensorShape(input), GetTensorData<uint8_t>(input),
         GetTensorShape(output), GetTensorData<uint8_t>(output));
   } else {
+    const SoftmaxParams& params = data->params;
+    optimized_ops::SoftmaxByRows(
+        GetTensorShape(input), GetTensorData<uint8_t>(input),
+        GetTensorShape(output), GetTensorData<uint8_t>(output),
+        CpuBackendContext::GetFromContext(context),
+        [&params](const RuntimeShape& shape, const uint8_t* input_data,
+                  uint8_t* output_data) {
 #ifdef TFLITE_SOFTMAX_USE_UINT16_LUT
-    optimized_ops::SoftmaxInt8LUT(
-        data->params, GetTensorShape(input), GetTensorData<uint8_t>(input),
-        GetTensorShape(output), GetTensorData<uint8_t>(output));
+          optimized_ops::SoftmaxInt8LUT(params, shape, input_data, shape,
+                                        output_data);
 #else
-    optimized_ops::Softmax(
-        data->params, GetTensorShape(input), GetTensorData<uint8_t>(input),
-        GetTensorShape(output), GetTensorData<uint8_t>(output));
+          optimized_ops::Softmax(params, shape, input_data, shape,
+                                 output_data);
 #endif
+        });
   }
   return kTfLiteOk;
 }
@@ -1241,9 +1259,16 @@ TfLiteStatus SoftmaxQuantized<int16, int16>(TfLiteContext* context,
                                             SoftmaxOpData* data,
                                             KernelType kernel_type) {
   if (NumDimensions(input) >= 1 && NumDimensions(input) <= 4) {
-    reference_ops::SoftmaxInt16(
-        data->params, GetTensorShape(input), GetTensorData<int16_t>(input),
-        GetTensorShape(output), GetTensorData<int16_t>(output));
+    if (kernel_type == kReference) {
+      reference_ops::SoftmaxInt16(
+          data->params, GetTensorShape(input), GetTensorData<int16_t>(input),
+          GetTensorShape(output), GetTensorData<int16_t>(output));
+    } else {
+      optimized_ops::SoftmaxInt16(
+          data->params, GetTensorShape(input), GetTensorData<int16_t>(input),
+          GetTensorShape(output), GetTensorData<int16_t>(output),
+          CpuBackendContext::GetFromContext(context));
+    }
     return kTfLiteOk;
   } else {
     TF_LITE_KERNEL_LOG(context,
@@ -1339,10 +1364,17 @@ TfLiteStatus LogSoftmaxEval(TfLiteContext* context, TfLiteNode* node) {
     case kTfLiteUInt8: {
       const SoftmaxParams& op_params = data->params;
       if (kernel_type == kGenericOptimized) {
-        optimized_ops::LogSoftmax(
-            op_params, input->params.scale, GetTensorShape(input),
-            GetTensorData<uint8_t>(input), GetTensorShape(output),
-            GetTensorData<uint8_t>(output));
+        const float input_scale = input->params.scale;
+        optimized_ops::SoftmaxByRows(
+            GetTensorShape(input), GetTensorData<uint8_t>(input),
+            GetTensorShape(output), GetTensorData<uint8_t>(output),
+            CpuBackendContext::GetFromContext(context),
+            [&op_params, input_scale](const RuntimeShape& shape,
+                                      const uint8_t* input_data,
+                                      uint8_t* output_data) {
+              optimized_ops::LogSoftmax(op_params, input_scale, shape,
+                                        input_data, shape, output_data);
+            });
       } else {
         reference_ops::LogSoftmax(
             op_params, GetTensorShape(input), GetTensorData<uint8_t>(input),
@@ -1353,10 +1385,17 @@ TfLiteStatus LogSoftmaxEval(TfLiteContext* context, TfLiteNode* node) {
     case kTfLiteInt8: {
       const SoftmaxParams& op_params = data->params;
       if (kernel_type == kGenericOptimized) {
-        optimized_ops::LogSoftmax(
-            op_params, input->params.scale, GetTensorShape(input),
-            GetTensorData<int8_t>(input), GetTensorShape(output),
-            GetTensorData<int8_t>(output));
+        const float input_scale = input->params.scale;
+        optimized_ops::SoftmaxByRows(
+            GetTensorShape(input), GetTensorData<int8_t>(input),
+            GetTensorShape(output), GetTensorData<int8_t>(output),
+            CpuBackendContext::GetFromContext(context),
+            [&op_params, input_scale](const RuntimeShape& shape,
+                                      const int8_t* input_data,
+                                      int8_t* output_data) {
+              optimized_ops::LogSoftmax(op_params, input_scale, shape,
+                                        input_data, shape, output_data);
+            });
       } else {
         const auto input_shape = GetTensorShape(input);
         const auto output_shape = GetTensorShape(output);
@@ -2345,6 +2345,34 @@ TEST_P(SoftmaxOpTest, Softmax2DMultithreading) {
                               })));
 }
 
+TEST_P(SoftmaxOpTest, Softmax2DInt16Multithreading) {
+  const float kMin = -1;
+  const float kMax = 32767.f / 32768.f;
+  // Large enough for the rows to be split between threads.
+  constexpr int kRows = 512;
+  constexpr int kDepth = 64;
+  std::vector<float> input(kRows * kDepth);
+  for (int i = 0; i < kRows * kDepth; ++i) {
+    input[i] = (i * 7 % 23 - 11) / 11.f;
+  }
+  QuantizedActivationsOpModel single_threaded(
+      GetRegistration(), 1,
+      /*input=*/{TensorType_INT16, {kRows, kDepth}, 3 * kMin, 3 * kMax},
+      /*output_type-*/ TensorType_INT16);
+  single_threaded.SetInput<int16_t>(input);
+  single_threaded.SetNumThreads(1);
+  ASSERT_EQ(single_threaded.Invoke(), kTfLiteOk);
+
+  QuantizedActivationsOpModel m(
+      GetRegistration(), 1,
+      /*input=*/{TensorType_INT16, {kRows, kDepth}, 3 * kMin, 3 * kMax},
+      /*output_type-*/ TensorType_INT16);
+  m.SetInput<int16_t>(input);
+  m.SetNumThreads(4);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_EQ(m.GetOutput<int16_t>(), single_threaded.GetOutput<int16_t>());
+}
+
 TEST_P(SoftmaxOpTest, Softmax2DUint8) {
   QuantizedActivationsOpModel m(GetRegistration(), 0.1f,
                                 {TensorType_UINT8, {2, 4}, -10, 10},
@@ -2513,6 +2541,32 @@ TEST_P(LogSoftmaxOpTest, LogSoftmaxInt8) {
                                      }));
 }
 
+TEST_P(LogSoftmaxOpTest, LogSoftmaxInt8Multithreading) {
+  // Large enough for the rows to be split between threads.
+  constexpr int kRows = 512;
+  constexpr int kDepth = 64;
+  std::vector<float> input(kRows * kDepth);
+  for (int i = 0; i < kRows * kDepth; ++i) {
+    input[i] = i * 7 % 21 - 10;
+  }
+  QuantizedActivationsOpModel single_threaded(
+      GetRegistration(), BuiltinOperator_LOG_SOFTMAX,
+      /*input=*/{TensorType_INT8, {kRows, kDepth}, -10, 10},
+      /*output=*/{TensorType_INT8, {}, 0, 0, 16. / 256, 127});
+  single_threaded.SetInput<int8_t>(input);
+  single_threaded.SetNumThreads(1);
+  ASSERT_EQ(single_threaded.Invoke(), kTfLiteOk);
+
+  QuantizedActivationsOpModel m(
+      GetRegistration(), BuiltinOperator_LOG_SOFTMAX,
+      /*input=*/{TensorType_INT8, {kRows, kDepth}, -10, 10},
+      /*output=*/{TensorType_INT8, {}, 0, 0, 16. / 256, 127});
+  m.SetInput<int8_t>(input);
+  m.SetNumThreads(4);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_EQ(m.GetOutput<int8_t>(), single_threaded.GetOutput<int8_t>());
+}
+
 TEST(QuantizedActivationsOpTest, LogSoftmaxInt8LargeNegativeNumber) {
   const float kLogSoftmaxQuantizedTolerance = 0.06355;
   QuantizedActivationsOpModel m(
@@ -0,0 +1,207 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/kernels/affinity_thread_pool.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <mutex>  // NOLINT(build/c++11)
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+namespace tflite {
+namespace {
+
+// How many times `done()` is polled between reading the clock while spinning.
+constexpr int kSpinChecksPerClockRead = 64;
+
+void PinCurrentThreadToCpu(int cpu) {
+#if defined(__linux__)
+  if (cpu < 0 || cpu >= CPU_SETSIZE) {
+    return;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+  // Failures leave the thread on any CPU.
+  sched_setaffinity(0, sizeof(cpu_set), &cpu_set);
+#endif
+}
+
+}  // namespace
+
+AffinityThreadPool::AffinityThreadPool(const Options& options)
+    : options_(options) {
+  if (options_.cpus.empty()) {
+    for (int i = 0; i + 1 < options_.num_threads; ++i) {
+      threads_.emplace_back([this, i] { WorkerLoop(i, /*cpu=*/-1); });
+    }
+  } else {
+    caller_runs_tasks_ = false;
+    for (int i = 0; i < static_cast<int>(options_.cpus.size()); ++i) {
+      const int cpu = options_.cpus[i];
+      threads_.emplace_back([this, i, cpu] { WorkerLoop(i, cpu); });
+    }
+  }
+  if (options_.collect_task_timings) {
+    task_timings_.resize(threads_.size() + (caller_runs_tasks_ ? 1 : 0));
+  }
+}
+
+AffinityThreadPool::~AffinityThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+    // Stops the spinning workers too.
+    generation_.fetch_add(1, std::memory_order_release);
+  }
+  work_available_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void AffinityThreadPool::Execute(int tasks_count,
+                                 const std::function<void(int)>& task) {
+  if (tasks_count <= 0) {
+    return;
+  }
+  task_ = &task;
+  tasks_count_ = tasks_count;
+  next_task_.store(0, std::memory_order_relaxed);
+  if (threads_.empty() || (tasks_count == 1 && caller_runs_tasks_)) {
+    RunTasks(threads_.size());
+    task_ = nullptr;
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    num_busy_workers_.store(threads_.size(), std::memory_order_relaxed);
+    generation_.fetch_add(1, std::memory_order_release);
+  }
+  work_available_.notify_all();
+  if (caller_runs_tasks_) {
+    RunTasks(threads_.size());
+  }
+  auto workers_done = [this] {
+    return num_busy_workers_.load(std::memory_order_acquire) == 0;
+  };
+  if (!Spin(workers_done)) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_done_.wait(lock, workers_done);
+  }
+  task_ = nullptr;
+}
+
+void AffinityThreadPool::ResetTaskTimings() {
+  std::fill(task_timings_.begin(), task_timings_.end(), TaskTimings());
+}
+
+std::vector<int> AffinityThreadPool::GetCpusByMaxFrequency() {
+  std::vector<std::pair<int64_t, int>> frequencies_and_cpus;
+  const int num_cpus = std::thread::hardware_concurrency();
+  for (int cpu = 0; cpu < num_cpus; ++cpu) {
+    std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                       "/cpufreq/cpuinfo_max_freq");
+    int64_t frequency = 0;
+    if (file >> frequency) {
+      frequencies_and_cpus.emplace_back(-frequency, cpu);
+    }
+  }
+  std::sort(frequencies_and_cpus.begin(), frequencies_and_cpus.end());
+  std::vector<int> cpus;
+  cpus.reserve(frequencies_and_cpus.size());
+  for (const auto& frequency_and_cpu : frequencies_and_cpus) {
+    cpus.push_back(frequency_and_cpu.second);
+  }
+  return cpus;
+}
+
+void AffinityThreadPool::RunTasks(int thread_index) {
+  TaskTimings* timings = options_.collect_task_timings
+                             ? &task_timings_[thread_index]
+                             : nullptr;
+  for (int i = next_task_.fetch_add(1, std::memory_order_relaxed);
+       i < tasks_count_;
+       i = next_task_.fetch_add(1, std::memory_order_relaxed)) {
+    if (timings == nullptr) {
+      (*task_)(i);
+      continue;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    (*task_)(i);
+    const int64_t duration_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+    ++timings->num_tasks;
+    timings->total_duration_us += duration_us;
+    timings->max_duration_us = std::max(timings->max_duration_us, duration_us);
+  }
+}
+
+void AffinityThreadPool::WorkerLoop(int thread_index, int cpu) {
+  if (cpu >= 0) {
+    PinCurrentThreadToCpu(cpu);
+  }
+  uint64_t generation = 0;
+  while (true) {
+    Spin([&] {
+      return generation_.load(std::memory_order_acquire) != generation;
+    });
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_available_.wait(lock, [&] {
+        return stop_ ||
+               generation_.load(std::memory_order_relaxed) != generation;
+      });
+      if (stop_) {
+        return;
+      }
+      generation = generation_.load(std::memory_order_relaxed);
+    }
+    RunTasks(thread_index);
+    if (num_busy_workers_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      work_done_.notify_one();
+    }
+  }
+}
+
+bool AffinityThreadPool::Spin(const std::function<bool()>& done) const {
+  if (options_.spin_duration_us <= 0) {
+    return done();
+  }
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::microseconds(options_.spin_duration_us);
+  do {
+    for (int i = 0; i < kSpinChecksPerClockRead; ++i) {
+      if (done()) {
+        return true;
+      }
+    }
+  } while (std::chrono::steady_clock::now() < deadline);
+  return done();
+}
+
+}  // namespace tflite
@@ -0,0 +1,127 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_KERNELS_AFFINITY_THREAD_POOL_H_
+#define TENSORFLOW_LITE_KERNELS_AFFINITY_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <cstdint>
+#include <functional>
+#include <mutex>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+namespace tflite {
+
+// A pool of threads running the tasks of cpu_backend_threadpool::Execute(),
+// which can be pinned to chosen CPUs, e.g. to the big cores of big.LITTLE
+// CPUs.
+//
+// The threads take the tasks one at a time, in order, from a shared counter,
+// so that the threads on faster cores take over the remaining tasks instead
+// of waiting for the slower ones.
+//
+// WARNING: This is an experimental API and subject to change.
+class AffinityThreadPool {
+ public:
+  struct Options {
+    // The number of threads running the tasks, including the calling thread.
+    // Ignored if `cpus` is not empty.
+    int num_threads = 1;
+    // If not empty, one thread is created for each of these CPUs and pinned
+    // to it, and the calling thread only waits for the tasks, since it may
+    // run on a slower core. The threads which fail to be pinned, e.g. because
+    // their CPU is offline, run on any CPU.
+    std::vector<int> cpus;
+    // How long the idle threads, and the calling thread waiting for the
+    // tasks, keep polling before sleeping. Polling saves the latency of waking
+    // them up between close calls to Execute(), at the cost of power.
+    int spin_duration_us = 0;
+    // Whether to count the tasks each thread runs, and the time they take.
+    bool collect_task_timings = false;
+  };
+
+  // The tasks run by a thread, since the last ResetTaskTimings().
+  struct TaskTimings {
+    int64_t num_tasks = 0;
+    int64_t total_duration_us = 0;
+    int64_t max_duration_us = 0;
+  };
+
+  explicit AffinityThreadPool(const Options& options);
+  ~AffinityThreadPool();
+  AffinityThreadPool(const AffinityThreadPool&) = delete;
+  AffinityThreadPool& operator=(const AffinityThreadPool&) = delete;
+
+  const Options& options() const { return options_; }
+
+  // Calls `task(i)` for each i in [0, tasks_count), and returns once all the
+  // calls returned. It must not be called from the tasks, nor from several
+  // threads at the same time.
+  void Execute(int tasks_count, const std::function<void(int)>& task);
+
+  // Returns the timings of each thread of the pool, the calling thread being
+  // the last one unless `cpus` are set. They are empty unless
+  // `collect_task_timings` is set.
+  const std::vector<TaskTimings>& task_timings() const {
+    return task_timings_;
+  }
+  void ResetTaskTimings();
+
+  // Returns the CPUs from the highest maximum frequency to the lowest, i.e.
+  // the prime cores first, then the big cores and the little cores, or an
+  // empty vector if the frequencies are unknown.
+  static std::vector<int> GetCpusByMaxFrequency();
+
+ private:
+  // Runs the tasks of the current Execute() until there are none left, and
+  // accounts for them in `task_timings_[thread_index]`.
+  void RunTasks(int thread_index);
+
+  void WorkerLoop(int thread_index, int cpu);
+
+  // Returns true if `done()` held while polling for `spin_duration_us`.
+  bool Spin(const std::function<bool()>& done) const;
+
+  const Options options_;
+  std::vector<std::thread> threads_;
+  // Whether the calling thread runs tasks too.
+  bool caller_runs_tasks_ = true;
+
+  std::mutex mutex_;
+  // Signaled when an Execute() starts, or the pool stops.
+  std::condition_variable work_available_;
+  // Signaled when the last worker is done with the tasks.
+  std::condition_variable work_done_;
+  // Incremented by each Execute(), for the workers to tell when there are new
+  // tasks. Only changed with `mutex_` held.
+  std::atomic<uint64_t> generation_{0};
+  // Number of workers yet to finish the tasks of the current generation.
+  std::atomic<int> num_busy_workers_{0};
+  bool stop_ = false;
+
+  // The tasks of the current Execute().
+  const std::function<void(int)>* task_ = nullptr;
+  int tasks_count_ = 0;
+  std::atomic<int> next_task_{0};
+
+  // Each thread only updates its own timings, and Execute() returning makes
+  // them visible to the caller.
+  std::vector<TaskTimings> task_timings_;
+};
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_KERNELS_AFFINITY_THREAD_POOL_H_
@@ -0,0 +1,110 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/kernels/affinity_thread_pool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace tflite {
+namespace {
+
+void ExpectAllTasksRun(AffinityThreadPool* pool, int tasks_count) {
+  for (int iteration = 0; iteration < 100; ++iteration) {
+    std::vector<int> buffer(tasks_count, 0);
+    pool->Execute(tasks_count, [&](int i) { buffer[i] += i + iteration; });
+    for (int i = 0; i < tasks_count; ++i) {
+      ASSERT_EQ(buffer[i], i + iteration);
+    }
+  }
+}
+
+TEST(AffinityThreadPoolTest, RunsAllTasks) {
+  for (const int num_threads : {1, 2, 4}) {
+    AffinityThreadPool::Options options;
+    options.num_threads = num_threads;
+    AffinityThreadPool pool(options);
+    for (const int tasks_count : {0, 1, 3, 17}) {
+      ExpectAllTasksRun(&pool, tasks_count);
+    }
+  }
+}
+
+TEST(AffinityThreadPoolTest, Spins) {
+  AffinityThreadPool::Options options;
+  options.num_threads = 3;
+  options.spin_duration_us = 100;
+  AffinityThreadPool pool(options);
+  ExpectAllTasksRun(&pool, 7);
+}
+
+TEST(AffinityThreadPoolTest, PinsThreadsToCpus) {
+  AffinityThreadPool::Options options;
+  options.cpus = {0, 0};
+  options.collect_task_timings = true;
+  AffinityThreadPool pool(options);
+  ExpectAllTasksRun(&pool, 5);
+  // The calling thread doesn't run tasks.
+  ASSERT_EQ(pool.task_timings().size(), 2);
+  int64_t num_tasks = 0;
+  for (const auto& timings : pool.task_timings()) {
+    num_tasks += timings.num_tasks;
+    EXPECT_LE(timings.max_duration_us, timings.total_duration_us);
+  }
+  EXPECT_EQ(num_tasks, 100 * 5);
+
+  pool.ResetTaskTimings();
+  for (const auto& timings : pool.task_timings()) {
+    EXPECT_EQ(timings.num_tasks, 0);
+  }
+}
+
+TEST(AffinityThreadPoolTest, FasterThreadsRunMoreTasks) {
+  AffinityThreadPool::Options options;
+  options.num_threads = 2;
+  options.collect_task_timings = true;
+  AffinityThreadPool pool(options);
+  std::atomic<bool> first_task_done{false};
+  // The first task blocks its thread until the other one ran all the others.
+  std::atomic<int> num_other_tasks_done{0};
+  pool.Execute(10, [&](int i) {
+    if (i == 0) {
+      while (num_other_tasks_done.load() < 9) {
+      }
+      first_task_done = true;
+    } else {
+      ++num_other_tasks_done;
+    }
+  });
+  EXPECT_TRUE(first_task_done);
+  ASSERT_EQ(pool.task_timings().size(), 2);
+  EXPECT_EQ(pool.task_timings()[0].num_tasks +
+                pool.task_timings()[1].num_tasks,
+            10);
+  EXPECT_TRUE(pool.task_timings()[0].num_tasks == 9 ||
+              pool.task_timings()[1].num_tasks == 9);
+}
+
+TEST(AffinityThreadPoolTest, GetCpusByMaxFrequency) {
+  const std::vector<int> cpus = AffinityThreadPool::GetCpusByMaxFrequency();
+  for (const int cpu : cpus) {
+    EXPECT_GE(cpu, 0);
+  }
+}
+
+}  // namespace
+}  // namespace tflite
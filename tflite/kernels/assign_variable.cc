@@ -13,8 +13,12 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "tflite/core/c/common.h"
 #include "tflite/core/subgraph.h"
 #include "tflite/experimental/resource/resource_variable.h"
@@ -29,6 +33,50 @@ namespace assign_variable {
 constexpr int kInputVariableId = 0;
 constexpr int kInputValue = 1;
 
+struct OpData {
+  // True if no later node in the execution plan reads the value, which is
+  // not a subgraph input or output either, so the variable can take its
+  // buffer.
+  bool value_is_movable = false;
+};
+
+void* Init(TfLiteContext* context, const char* buffer, size_t length) {
+  return new OpData;
+}
+
+void Free(TfLiteContext* context, void* buffer) {
+  delete reinterpret_cast<OpData*>(buffer);
+}
+
+bool Contains(const std::vector<int>& tensors, int tensor_index) {
+  return std::find(tensors.begin(), tensors.end(), tensor_index) !=
+         tensors.end();
+}
+
+bool IsValueMovable(const Subgraph& subgraph, const TfLiteNode* node) {
+  const int value_index = node->inputs->data[kInputValue];
+  if (Contains(subgraph.inputs(), value_index) ||
+      Contains(subgraph.outputs(), value_index)) {
+    return false;
+  }
+  const std::vector<int>& execution_plan = subgraph.execution_plan();
+  bool found_node = false;
+  for (int node_index : execution_plan) {
+    const TfLiteNode& other_node =
+        subgraph.node_and_registration(node_index)->first;
+    if (!found_node) {
+      found_node = &other_node == node;
+      continue;
+    }
+    for (int i = 0; i < other_node.inputs->size; ++i) {
+      if (other_node.inputs->data[i] == value_index) {
+        return false;
+      }
+    }
+  }
+  return found_node;
+}
+
 TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   TF_LITE_ENSURE_EQ(context, NumInputs(node), 2);
   TF_LITE_ENSURE_EQ(context, NumOutputs(node), 0);
@@ -40,6 +88,10 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
                            input_resource_id_tensor->type == kTfLiteInt32));
   TF_LITE_ENSURE_EQ(context, NumElements(input_resource_id_tensor), 1);
 
+  auto* op_data = reinterpret_cast<OpData*>(node->user_data);
+  const Subgraph* subgraph = reinterpret_cast<Subgraph*>(context->impl_);
+  op_data->value_is_movable = IsValueMovable(*subgraph, node);
+
   return kTfLiteOk;
 }
 
@@ -49,16 +101,21 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   const TfLiteTensor* input_resource_id_tensor;
   TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, kInputVariableId,
                                           &input_resource_id_tensor));
-  const TfLiteTensor* input_value_tensor;
-  TF_LITE_ENSURE_OK(
-      context, GetInputSafe(context, node, kInputValue, &input_value_tensor));
+  TfLiteTensor* input_value_tensor =
+      &context->tensors[node->inputs->data[kInputValue]];
 
   int resource_id = input_resource_id_tensor->data.i32[0];
   auto& resources = subgraph->resources();
   resource::CreateResourceVariableIfNotAvailable(&resources, resource_id);
   auto* variable = resource::GetResourceVariable(&resources, resource_id);
   TF_LITE_ENSURE(context, variable != nullptr);
-  variable->AssignFrom(input_value_tensor);
+  // A dynamic value at the end of its life swaps buffers with the variable
+  // instead of being copied.
+  if (reinterpret_cast<OpData*>(node->user_data)->value_is_movable) {
+    TF_LITE_ENSURE_OK(context, variable->MoveFrom(input_value_tensor));
+  } else {
+    TF_LITE_ENSURE_OK(context, variable->AssignFrom(input_value_tensor));
+  }
 
   return kTfLiteOk;
 }
@@ -66,7 +123,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 }  // namespace assign_variable
 
 TfLiteRegistration* Register_ASSIGN_VARIABLE() {
-  static TfLiteRegistration r = {nullptr, nullptr, assign_variable::Prepare,
+  static TfLiteRegistration r = {assign_variable::Init, assign_variable::Free,
+                                 assign_variable::Prepare,
                                  assign_variable::Eval};
   return &r;
 }
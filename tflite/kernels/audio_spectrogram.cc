@@ -44,8 +44,14 @@ typedef struct {
   int window_size;
   int stride;
   bool magnitude_squared;
+  // If true, each invocation continues the signal of the previous one: the
+  // samples that did not complete a window yet are kept per channel and the
+  // output holds the frames completed by the new samples only.
+  bool streaming;
   int output_height;
   internal::Spectrogram* spectrogram;
+  // The state of each channel when streaming.
+  std::vector<internal::Spectrogram> channel_spectrograms;
 } TfLiteAudioSpectrogramParams;
 
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
@@ -57,6 +63,7 @@ void* Init(TfLiteContext* context, const char* buffer, size_t length) {
   data->window_size = m["window_size"].AsInt64();
   data->stride = m["stride"].AsInt64();
   data->magnitude_squared = m["magnitude_squared"].AsBool();
+  data->streaming = m["streaming"].AsBool();
 
   data->spectrogram = new internal::Spectrogram;
 
@@ -89,6 +96,22 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
 
   TF_LITE_ENSURE(context, params->spectrogram->Initialize(params->window_size,
                                                           params->stride));
+  if (params->streaming) {
+    // The number of frames depends on the samples buffered by the previous
+    // invocations, the output is resized in Eval.
+    const size_t channel_count = input->dims->data[1];
+    if (params->channel_spectrograms.size() != channel_count) {
+      params->channel_spectrograms.assign(channel_count,
+                                          internal::Spectrogram());
+      for (internal::Spectrogram& spectrogram :
+           params->channel_spectrograms) {
+        TF_LITE_ENSURE(context, spectrogram.Initialize(params->window_size,
+                                                       params->stride));
+      }
+    }
+    SetTensorToDynamic(output);
+    return kTfLiteOk;
+  }
   const int64_t sample_count = input->dims->data[0];
   const int64_t length_minus_window = (sample_count - params->window_size);
   if (length_minus_window < 0) {
@@ -104,6 +127,29 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   return context->ResizeTensor(context, output, output_size);
 }
 
+// Writes the frames of one channel to `output_slice`.
+TfLiteStatus CopyFrames(TfLiteContext* context,
+                        const TfLiteAudioSpectrogramParams* params,
+                        const std::vector<std::vector<float>>& frames,
+                        int64_t output_width, float* output_slice) {
+  TF_LITE_ENSURE_EQ(context, frames.size(), params->output_height);
+  for (int row_index = 0; row_index < params->output_height; ++row_index) {
+    const std::vector<float>& spectrogram_row = frames[row_index];
+    TF_LITE_ENSURE_EQ(context, spectrogram_row.size(), output_width);
+    float* output_row = output_slice + (row_index * output_width);
+    if (params->magnitude_squared) {
+      for (int i = 0; i < output_width; ++i) {
+        output_row[i] = spectrogram_row[i];
+      }
+    } else {
+      for (int i = 0; i < output_width; ++i) {
+        output_row[i] = sqrtf(spectrogram_row[i]);
+      }
+    }
+  }
+  return kTfLiteOk;
+}
+
 template <KernelType kernel_type>
 TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   auto* params =
@@ -122,39 +168,36 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 
   const int64_t output_width = params->spectrogram->output_frequency_channels();
 
-  float* output_flat = GetTensorData<float>(output);
-
   std::vector<float> input_for_channel(sample_count);
+  std::vector<std::vector<float>> spectrogram_output;
   for (int64_t channel = 0; channel < channel_count; ++channel) {
-    float* output_slice =
-        output_flat + (channel * params->output_height * output_width);
     for (int i = 0; i < sample_count; ++i) {
       input_for_channel[i] = input_data[i * channel_count + channel];
     }
-    std::vector<std::vector<float>> spectrogram_output;
-    TF_LITE_ENSURE(context, params->spectrogram->Initialize(params->window_size,
-                                                            params->stride));
-    TF_LITE_ENSURE(context,
-                   params->spectrogram->ComputeSquaredMagnitudeSpectrogram(
-                       input_for_channel, &spectrogram_output));
-    TF_LITE_ENSURE_EQ(context, spectrogram_output.size(),
-                      params->output_height);
-    TF_LITE_ENSURE(context, spectrogram_output.empty() ||
-                                (spectrogram_output[0].size() == output_width));
-    for (int row_index = 0; row_index < params->output_height; ++row_index) {
-      const std::vector<float>& spectrogram_row = spectrogram_output[row_index];
-      TF_LITE_ENSURE_EQ(context, spectrogram_row.size(), output_width);
-      float* output_row = output_slice + (row_index * output_width);
-      if (params->magnitude_squared) {
-        for (int i = 0; i < output_width; ++i) {
-          output_row[i] = spectrogram_row[i];
-        }
-      } else {
-        for (int i = 0; i < output_width; ++i) {
-          output_row[i] = sqrtf(spectrogram_row[i]);
-        }
-      }
+    internal::Spectrogram* spectrogram = params->spectrogram;
+    if (params->streaming) {
+      spectrogram = &params->channel_spectrograms[channel];
+    } else {
+      spectrogram->Reset();
+    }
+    TF_LITE_ENSURE(context, spectrogram->ComputeSquaredMagnitudeSpectrogram(
+                                input_for_channel, &spectrogram_output));
+    if (params->streaming && channel == 0) {
+      // All the channels buffered the same number of samples, so they
+      // complete the same number of frames.
+      params->output_height = spectrogram_output.size();
+      TfLiteIntArray* output_size = TfLiteIntArrayCreate(3);
+      output_size->data[0] = channel_count;
+      output_size->data[1] = params->output_height;
+      output_size->data[2] = output_width;
+      TF_LITE_ENSURE_OK(context,
+                        context->ResizeTensor(context, output, output_size));
     }
+    float* output_slice = GetTensorData<float>(output) +
+                          (channel * params->output_height * output_width);
+    TF_LITE_ENSURE_OK(context,
+                      CopyFrames(context, params, spectrogram_output,
+                                 output_width, output_slice));
   }
   return kTfLiteOk;
 }
@@ -36,7 +36,8 @@ class BaseAudioSpectrogramOpModel : public SingleOpModel {
  public:
   BaseAudioSpectrogramOpModel(const TensorData& input1,
                               const TensorData& output, int window_size,
-                              int stride, bool magnitude_squared) {
+                              int stride, bool magnitude_squared,
+                              bool streaming = false) {
     input1_ = AddInput(input1);
     output_ = AddOutput(output);
 
@@ -45,6 +46,7 @@ class BaseAudioSpectrogramOpModel : public SingleOpModel {
       fbb.Int("window_size", window_size);
       fbb.Int("stride", stride);
       fbb.Bool("magnitude_squared", magnitude_squared);
+      fbb.Bool("streaming", streaming);
     });
     fbb.Finish();
     SetCustomOp("AudioSpectrogram", fbb.GetBuffer(),
@@ -107,6 +109,42 @@ TEST(SpectrogramOpTest, StrideTest) {
                                  {0, 1, 4, 1, 0, 1, 2, 1, 2, 1}, 1e-3)));
 }
 
+TEST(SpectrogramOpTest, StreamingTest) {
+  BaseAudioSpectrogramOpModel m({TensorType_FLOAT32, {5, 1}},
+                                {TensorType_FLOAT32, {}}, 8, 2, true,
+                                /*streaming=*/true);
+  m.PopulateTensor<float>(m.input1(), {-1.0f, 0.0f, 1.0f, 0.0f, -1.0f});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(1, 0, 5));
+
+  // The first 5 samples are kept, so the second invocation sees the same
+  // signal as StrideTest.
+  m.PopulateTensor<float>(m.input1(), {0.0f, 1.0f, 0.0f, 1.0f, 0.0f});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(1, 2, 5));
+  EXPECT_THAT(m.GetOutput(), ElementsAreArray(ArrayFloatNear(
+                                 {0, 1, 4, 1, 0, 1, 2, 1, 2, 1}, 1e-3)));
+
+  // Then each stride of new samples completes one frame.
+  m.PopulateTensor<float>(m.input1(), {1.0f, 0.0f, -1.0f, 0.0f, 1.0f});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(1, 2, 5));
+}
+
+TEST(SpectrogramOpTest, NonStreamingInvokesAreIndependent) {
+  BaseAudioSpectrogramOpModel m({TensorType_FLOAT32, {10, 1}},
+                                {TensorType_FLOAT32, {}}, 8, 2, true);
+  const std::vector<float> input = {-1.0f, 0.0f, 1.0f, 0.0f, -1.0f,
+                                    0.0f,  1.0f, 0.0f, 1.0f, 0.0f};
+  for (int i = 0; i < 2; ++i) {
+    m.PopulateTensor<float>(m.input1(), input);
+    ASSERT_EQ(m.Invoke(), kTfLiteOk);
+    EXPECT_THAT(m.GetOutputShape(), ElementsAre(1, 2, 5));
+    EXPECT_THAT(m.GetOutput(), ElementsAreArray(ArrayFloatNear(
+                                   {0, 1, 4, 1, 0, 1, 2, 1, 2, 1}, 1e-3)));
+  }
+}
+
 }  // namespace
 }  // namespace custom
 }  // namespace ops
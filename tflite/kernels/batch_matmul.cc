@@ -25,7 +25,9 @@ limitations under the License.
 
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/kernels/internal/compatibility.h"
+#include "tflite/kernels/internal/optimized/batch_matmul.h"
 #include "tflite/kernels/internal/optimized/optimized_ops.h"
 #include "tflite/kernels/internal/portable_tensor_utils.h"
 #include "tflite/kernels/internal/quantization_util.h"
@@ -43,6 +45,12 @@ static const int kInputLHSTensor = 0;
 static const int kInputRHSTensor = 1;
 static const int kOutputTensor = 0;
 
+// This file has two implementations of BatchMatMul.
+enum KernelType {
+  kReference,
+  kGenericOptimized,
+};
+
 static const int kNumTempTensorsForAdjoints = 2;
 static const int kNumTempTensorsForHybrid = 5;
 
@@ -59,6 +67,11 @@ struct OpData {
   int scratch_tensor_index;
   bool rhs_transposed;
   bool compute_row_sums = false;
+  // Whether the packed forms of the rhs of the op, the transposed copy of
+  // which is persistent when it is constant, and of the lhs of the op can be
+  // cached by the optimized kernels across invocations.
+  bool rhs_cacheable = false;
+  bool lhs_cacheable = false;
 };
 
 struct OpContext {
@@ -523,6 +536,7 @@ TfLiteStatus EvalHybrid(TfLiteContext* context, TfLiteNode* node, OpData* data,
   return kTfLiteOk;
 }
 
+template <KernelType kernel_type>
 TfLiteStatus EvalInt8Int8(TfLiteContext* context, const OpData* data,
                           const RuntimeShape& lhs_shape,
                           const TfLiteTensor* lhs,
@@ -542,14 +556,22 @@ TfLiteStatus EvalInt8Int8(TfLiteContext* context, const OpData* data,
   op_params.output_shift = data->output_shift;
   op_params.quantized_activation_min = data->output_activation_min;
   op_params.quantized_activation_max = data->output_activation_max;
-  op_params.lhs_cacheable = IsConstantTensor(lhs);
-  op_params.rhs_cacheable = IsConstantTensor(rhs);
-
-  reference_ops::BatchMatMul<int8_t, int32_t>(
-      op_params, rhs_shape, GetTensorData<int8_t>(rhs), lhs_shape,
-      GetTensorData<int8_t>(lhs), GetTensorShape(output),
-      GetTensorData<int8_t>(output));
-
+  // The lhs of the kernel is the rhs of the op, and vice versa.
+  op_params.lhs_cacheable = data->rhs_cacheable;
+  op_params.rhs_cacheable = data->lhs_cacheable;
+
+  if (kernel_type == kReference) {
+    reference_ops::BatchMatMul<int8_t, int32_t>(
+        op_params, rhs_shape, GetTensorData<int8_t>(rhs), lhs_shape,
+        GetTensorData<int8_t>(lhs), GetTensorShape(output),
+        GetTensorData<int8_t>(output));
+  } else {
+    optimized_ops::BatchMatMul(
+        op_params, rhs_shape, GetTensorData<int8_t>(rhs), lhs_shape,
+        GetTensorData<int8_t>(lhs), GetTensorShape(output),
+        GetTensorData<int8_t>(output),
+        CpuBackendContext::GetFromContext(context));
+  }
   return kTfLiteOk;
 }
 
@@ -592,6 +614,7 @@ TfLiteStatus EvalInt16(TfLiteContext* context, const OpData* data,
   return kTfLiteOk;
 }
 
+template <KernelType kernel_type>
 TfLiteStatus EvalQuantized(TfLiteContext* context, TfLiteNode* node,
                            OpData* data, const RuntimeShape& lhs_shape,
                            const TfLiteTensor* lhs,
@@ -618,8 +641,9 @@ TfLiteStatus EvalQuantized(TfLiteContext* context, TfLiteNode* node,
                       input_offsets, output);
   } else if (lhs->type == kTfLiteInt8 && rhs->type == kTfLiteInt8) {
     if (output->type == kTfLiteInt8) {
-      return EvalInt8Int8(context, data, lhs_shape, lhs, rhs_shape, rhs,
-                          GetTensorShape(output), output);
+      return EvalInt8Int8<kernel_type>(context, data, lhs_shape, lhs,
+                                       rhs_shape, rhs, GetTensorShape(output),
+                                       output);
     } else {
       return EvalInt8Int32(context, data, lhs_shape, lhs, rhs_shape, rhs,
                            GetTensorShape(output), output);
@@ -711,6 +735,7 @@ TfLiteTensor* GetTempLhs(TfLiteContext* context, TfLiteNode* node,
 // RHS <..., C, B> X LHS <..., B, A>
 // where output is a C X A column-oriented, which is equivalent to
 // A X C row-oriented.
+template <KernelType kernel_type>
 TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   OpContext op_context(context, node);
   OpData* op_data = reinterpret_cast<OpData*>(node->user_data);
@@ -765,6 +790,9 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   if (adj_x) {
     TransposeRowsColumns(context, lhs, GetTemporary(context, node, 0));
   }
+  // The transposed lhs is rewritten in the arena at every invocation.
+  op_data->rhs_cacheable = IsConstantTensor(rhs);
+  op_data->lhs_cacheable = IsConstantTensor(lhs) && !adj_x;
   RuntimeShape rhs_shape =
       adj_y ? orig_rhs_shape : SwapRowColumnDims(orig_rhs_shape);
   RuntimeShape lhs_shape =
@@ -773,15 +801,26 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   switch (rhs->type) {
     case kTfLiteFloat32:
       // Note we pass RHS args first, LHS args second. See note above.
-      reference_ops::BatchMatMul(rhs_shape, GetTensorData<float>(rhs_tensor),
-                                 lhs_shape, GetTensorData<float>(lhs_tensor),
-                                 GetTensorShape(output),
-                                 GetTensorData<float>(output));
+      if (kernel_type == kReference) {
+        reference_ops::BatchMatMul(rhs_shape, GetTensorData<float>(rhs_tensor),
+                                   lhs_shape, GetTensorData<float>(lhs_tensor),
+                                   GetTensorShape(output),
+                                   GetTensorData<float>(output));
+      } else {
+        FullyConnectedParams op_params;
+        op_params.lhs_cacheable = op_data->rhs_cacheable;
+        op_params.rhs_cacheable = op_data->lhs_cacheable;
+        optimized_ops::BatchMatMul(
+            op_params, rhs_shape, GetTensorData<float>(rhs_tensor), lhs_shape,
+            GetTensorData<float>(lhs_tensor), GetTensorShape(output),
+            GetTensorData<float>(output),
+            CpuBackendContext::GetFromContext(context));
+      }
       break;
     case kTfLiteInt8:
     case kTfLiteInt16:
-      EvalQuantized(context, node, op_data, lhs_shape, lhs_tensor, rhs_shape,
-                    rhs_tensor, output);
+      EvalQuantized<kernel_type>(context, node, op_data, lhs_shape, lhs_tensor,
+                                 rhs_shape, rhs_tensor, output);
       break;
     default:
       TF_LITE_KERNEL_LOG(context,
@@ -795,13 +834,21 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 }  // namespace batch_matmul
 
 TfLiteRegistration* Register_BATCH_MATMUL_REF() {
-  static TfLiteRegistration r = {batch_matmul::Init, batch_matmul::Free,
-                                 batch_matmul::Prepare, batch_matmul::Eval};
+  static TfLiteRegistration r = {
+      batch_matmul::Init, batch_matmul::Free, batch_matmul::Prepare,
+      batch_matmul::Eval<batch_matmul::kReference>};
+  return &r;
+}
+
+TfLiteRegistration* Register_BATCH_MATMUL_GENERIC_OPT() {
+  static TfLiteRegistration r = {
+      batch_matmul::Init, batch_matmul::Free, batch_matmul::Prepare,
+      batch_matmul::Eval<batch_matmul::kGenericOptimized>};
   return &r;
 }
 
 TfLiteRegistration* Register_BATCH_MATMUL() {
-  return Register_BATCH_MATMUL_REF();
+  return Register_BATCH_MATMUL_GENERIC_OPT();
 }
 
 }  // namespace builtin
@@ -15,6 +15,7 @@ limitations under the License.
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <initializer_list>
 #include <limits>
 #include <map>
@@ -346,6 +347,107 @@ TEST(BatchMatMulOpTest, Float32Test_BroadcastFromRHS) {
   EXPECT_THAT(model.GetOutputShape(), ElementsAreArray({3, 1, 4, 2}));
 }
 
+// Computes the batch matrix multiply of row major `lhs` and `rhs` of rank 4
+// shapes, broadcast over the batch dimensions.
+std::vector<float> NaiveBatchMatMul(const std::vector<float>& lhs,
+                                    const std::vector<int>& lhs_shape,
+                                    const std::vector<float>& rhs,
+                                    const std::vector<int>& rhs_shape) {
+  const int rows = lhs_shape[2];
+  const int depth = lhs_shape[3];
+  const int cols = rhs_shape[3];
+  const int batches0 = std::max(lhs_shape[0], rhs_shape[0]);
+  const int batches1 = std::max(lhs_shape[1], rhs_shape[1]);
+  std::vector<float> output;
+  for (int b0 = 0; b0 < batches0; ++b0) {
+    for (int b1 = 0; b1 < batches1; ++b1) {
+      const float* lhs_data =
+          lhs.data() + ((lhs_shape[0] == 1 ? 0 : b0) * lhs_shape[1] +
+                        (lhs_shape[1] == 1 ? 0 : b1)) *
+                           rows * depth;
+      const float* rhs_data =
+          rhs.data() + ((rhs_shape[0] == 1 ? 0 : b0) * rhs_shape[1] +
+                        (rhs_shape[1] == 1 ? 0 : b1)) *
+                           depth * cols;
+      for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+          float total = 0;
+          for (int k = 0; k < depth; ++k) {
+            total += lhs_data[i * depth + k] * rhs_data[k * cols + j];
+          }
+          output.push_back(total);
+        }
+      }
+    }
+  }
+  return output;
+}
+
+// Values in [-3, 3], for which all the products are computed exactly.
+std::vector<float> TestValues(int size, int seed) {
+  std::vector<float> values(size);
+  for (int i = 0; i < size; ++i) {
+    values[i] = (i * 5 + seed) % 7 - 3;
+  }
+  return values;
+}
+
+TEST(BatchMatMulOpTest, Float32Test_BroadcastRank2RHS) {
+  BatchMatMulOpModel<float> model({TensorType_FLOAT32, {2, 3, 4, 5}},
+                                  {TensorType_FLOAT32, {5, 6}});
+  const std::vector<float> lhs = TestValues(2 * 3 * 4 * 5, 1);
+  const std::vector<float> rhs = TestValues(5 * 6, 2);
+  model.PopulateTensor<float>(model.lhs(), lhs);
+  model.PopulateTensor<float>(model.rhs(), rhs);
+  ASSERT_EQ(model.Invoke(), kTfLiteOk);
+  const std::vector<float> expected =
+      NaiveBatchMatMul(lhs, {2, 3, 4, 5}, rhs, {1, 1, 5, 6});
+  EXPECT_THAT(model.GetOutput(), Pointwise(FloatingPointEq(), expected));
+  EXPECT_THAT(model.GetOutputShape(), ElementsAreArray({2, 3, 4, 6}));
+}
+
+TEST(BatchMatMulOpTest, Float32Test_BroadcastOuterRHS) {
+  BatchMatMulOpModel<float> model({TensorType_FLOAT32, {2, 3, 4, 5}},
+                                  {TensorType_FLOAT32, {1, 1, 5, 6}});
+  const std::vector<float> lhs = TestValues(2 * 3 * 4 * 5, 3);
+  const std::vector<float> rhs = TestValues(5 * 6, 4);
+  model.PopulateTensor<float>(model.lhs(), lhs);
+  model.PopulateTensor<float>(model.rhs(), rhs);
+  ASSERT_EQ(model.Invoke(), kTfLiteOk);
+  const std::vector<float> expected =
+      NaiveBatchMatMul(lhs, {2, 3, 4, 5}, rhs, {1, 1, 5, 6});
+  EXPECT_THAT(model.GetOutput(), Pointwise(FloatingPointEq(), expected));
+  EXPECT_THAT(model.GetOutputShape(), ElementsAreArray({2, 3, 4, 6}));
+}
+
+TEST(BatchMatMulOpTest, Float32Test_ManySmallHeads) {
+  BatchMatMulOpModel<float> model({TensorType_FLOAT32, {2, 8, 6, 20}},
+                                  {TensorType_FLOAT32, {1, 8, 20, 7}});
+  const std::vector<float> lhs = TestValues(2 * 8 * 6 * 20, 5);
+  const std::vector<float> rhs = TestValues(8 * 20 * 7, 6);
+  model.PopulateTensor<float>(model.lhs(), lhs);
+  model.PopulateTensor<float>(model.rhs(), rhs);
+  ASSERT_EQ(model.Invoke(), kTfLiteOk);
+  const std::vector<float> expected =
+      NaiveBatchMatMul(lhs, {2, 8, 6, 20}, rhs, {1, 8, 20, 7});
+  EXPECT_THAT(model.GetOutput(), Pointwise(FloatingPointEq(), expected));
+  EXPECT_THAT(model.GetOutputShape(), ElementsAreArray({2, 8, 6, 7}));
+}
+
+TEST(BatchMatMulOpTest, Float32Test_LargeBatches) {
+  BatchMatMulOpModel<float> model({TensorType_FLOAT32, {1, 2, 40, 64}},
+                                  {TensorType_FLOAT32, {1, 2, 64, 48}});
+  const std::vector<float> lhs = TestValues(2 * 40 * 64, 0);
+  const std::vector<float> rhs = TestValues(2 * 64 * 48, 1);
+  model.PopulateTensor<float>(model.lhs(), lhs);
+  model.PopulateTensor<float>(model.rhs(), rhs);
+  ASSERT_EQ(model.Invoke(), kTfLiteOk);
+  const std::vector<float> expected =
+      NaiveBatchMatMul(lhs, {1, 2, 40, 64}, rhs, {1, 2, 64, 48});
+  EXPECT_THAT(model.GetOutput(), Pointwise(FloatingPointEq(), expected));
+  EXPECT_THAT(model.GetOutputShape(), ElementsAreArray({1, 2, 40, 48}));
+}
+
 class ConstRHSBatchMatMulOpModel : public MultiOpModel {
  public:
   ConstRHSBatchMatMulOpModel(const TensorData& lhs,
@@ -1077,6 +1179,33 @@ TEST(QuantizedBatchMatMulOpTest, SimpleTestQuantizedInt8AdjRHS) {
   EXPECT_THAT(m.GetOutput<int8_t>(), ElementsAre(13, 64, 127, 19, 94, 127));
 }
 
+TEST(QuantizedBatchMatMulOpTest, BroadcastTestQuantizedInt8) {
+  QuantizedBatchMatMulOpModel m(
+      /*units=*/3, /*batches*/ 4,
+      /*lhs=*/{TensorType_INT8, {2, 2, 10}, -63.5, 64},
+      /*output=*/{TensorType_INT8, {}, -127, 128});
+
+  m.SetWeights<int8_t>({
+      1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5,  5,  5,
+      6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10, 10,
+  });
+
+  m.SetInput<int8_t>({
+      1, 2, 3, 4, 5, 6, 7, 8,  -9, -10,  // b = 0
+      1, 2, 3, 4, 5, 6, 7, -8, 9,  -10,  // b = 1
+      1, 2, 3, 4, 5, 6, 7, -8, 9,  -10,  // b = 2
+      1, 2, 3, 4, 5, 6, 7, 8,  -9, -10,  // b = 3
+  });
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetDequantizedOutput<int8_t>(),
+              ElementsAreArray(ArrayFloatNear(
+                  {23, 23, 23, 57, 57, 57, 57, 57, 57, 23, 23, 23})));
+  EXPECT_THAT(m.GetOutput<int8_t>(),
+              ElementsAre(22, 22, 22, 56, 56, 56, 56, 56, 56, 22, 22, 22));
+}
+
 TEST(QuantizedBatchMatMulOpTest, SimpleTestQuantizedInt16) {
   const float inputs_scale = 10.0 / std::numeric_limits<int16_t>::max();
   const float output_scale = 1.0;
@@ -25,6 +25,8 @@ limitations under the License.
 #include "tflite/core/c/common.h"
 #include "tflite/core/subgraph.h"
 #include "tflite/interpreter_options.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/cpu_backend_threadpool.h"
 #include "tflite/kernels/internal/portable_tensor_utils.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/kernel_util.h"
@@ -404,6 +406,105 @@ TfLiteStatus EvalImpl(TfLiteContext* context, const TfLiteTensor* input,
   return kTfLiteError;
 }
 
+// Casts are split in tasks converting at least this many elements.
+constexpr int kMinElementsPerTask = 65536;
+
+// Returns the size of the elements of `type` when they can be cast in parts,
+// 0 for the packed and unsupported types.
+size_t GetUnpackedElementSize(TfLiteType type) {
+  switch (type) {
+    case kTfLiteInt64:
+      return sizeof(int64_t);
+    case kTfLiteInt32:
+      return sizeof(int32_t);
+    case kTfLiteUInt32:
+      return sizeof(uint32_t);
+    case kTfLiteInt16:
+      return sizeof(int16_t);
+    case kTfLiteUInt16:
+      return sizeof(uint16_t);
+    case kTfLiteUInt8:
+      return sizeof(uint8_t);
+    case kTfLiteInt8:
+      return sizeof(int8_t);
+    case kTfLiteFloat16:
+      return sizeof(Eigen::half);
+    case kTfLiteBFloat16:
+      return sizeof(Eigen::bfloat16);
+    case kTfLiteFloat32:
+      return sizeof(float);
+    case kTfLiteFloat64:
+      return sizeof(double);
+    case kTfLiteBool:
+      return sizeof(bool);
+    case kTfLiteComplex64:
+      return sizeof(std::complex<float>);
+    default:
+      return 0;
+  }
+}
+
+// Casts the elements [begin, end) of `input` into `output`.
+struct CastTask : cpu_backend_threadpool::Task {
+  CastTask(TfLiteContext* context, const TfLiteTensor* input,
+           TfLiteTensor* output, int begin, int end)
+      : context(context),
+        input(input),
+        output(output),
+        begin(begin),
+        end(end) {}
+
+  void Run() override {
+    TfLiteTensor input_part = *input;
+    input_part.data.raw =
+        input->data.raw + begin * GetUnpackedElementSize(input->type);
+    TfLiteTensor output_part = *output;
+    output_part.data.raw =
+        output->data.raw + begin * GetUnpackedElementSize(output->type);
+    status = EvalImpl(context, &input_part, &output_part, end - begin);
+  }
+
+  TfLiteContext* context;
+  const TfLiteTensor* input;
+  TfLiteTensor* output;
+  const int begin;
+  const int end;
+  TfLiteStatus status = kTfLiteOk;
+};
+
+// Same as EvalImpl(), with large casts between unpacked types split among the
+// threads of the CPU backend context.
+TfLiteStatus EvalMultithreaded(TfLiteContext* context,
+                               const TfLiteTensor* input, TfLiteTensor* output,
+                               const int num_elements) {
+  if (num_elements < 2 * kMinElementsPerTask ||
+      GetUnpackedElementSize(input->type) == 0 ||
+      GetUnpackedElementSize(output->type) == 0) {
+    return EvalImpl(context, input, output, num_elements);
+  }
+  CpuBackendContext* cpu_backend_context =
+      CpuBackendContext::GetFromContext(context);
+  const int num_tasks = std::min(cpu_backend_context->max_num_threads(),
+                                 num_elements / kMinElementsPerTask);
+  if (num_tasks <= 1) {
+    return EvalImpl(context, input, output, num_elements);
+  }
+  std::vector<CastTask> tasks;
+  tasks.reserve(num_tasks);
+  int begin = 0;
+  for (int i = 0; i < num_tasks; ++i) {
+    const int end = begin + (num_elements - begin) / (num_tasks - i);
+    tasks.emplace_back(context, input, output, begin, end);
+    begin = end;
+  }
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                  cpu_backend_context);
+  for (const CastTask& task : tasks) {
+    TF_LITE_ENSURE_OK(context, task.status);
+  }
+  return kTfLiteOk;
+}
+
 struct OpData {
   bool cached_output = false;
 };
@@ -476,7 +577,7 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
     }
     op_data.cached_output = true;
   }
-  return EvalImpl(context, input, output, num_elements);
+  return EvalMultithreaded(context, input, output, num_elements);
 }
 
 }  // namespace
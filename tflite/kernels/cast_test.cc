@@ -488,5 +488,24 @@ TEST(CastOpModel, CastConstInputCachingWorks) {
               ElementsAreArray({11, 21, 31, 41, 51, 61}));
 }
 
+TEST(CastOpModel, CastLargeInt32ToFloatMultithreaded) {
+  // Large enough for the cast to be split among the threads.
+  const int num_elements = 1000003;
+  std::vector<int32_t> input(num_elements);
+  for (int i = 0; i < num_elements; ++i) {
+    input[i] = i - num_elements / 2;
+  }
+  CastOpModel m({TensorType_INT32, {num_elements}},
+                {TensorType_FLOAT32, {num_elements}});
+  m.SetNumThreads(4);
+  m.PopulateTensor<int32_t>(m.input(), input);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  const std::vector<float> output = m.ExtractVector<float>(m.output());
+  ASSERT_EQ(output.size(), static_cast<size_t>(num_elements));
+  for (int i = 0; i < num_elements; ++i) {
+    ASSERT_EQ(output[i], static_cast<float>(input[i]));
+  }
+}
+
 }  // namespace
 }  // namespace tflite
@@ -21,6 +21,7 @@ limitations under the License.
 #include <limits>
 
 #include "Eigen/Core"  // from @eigen_archive
+#include "tflite/builtin_ops.h"
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
 #include "tflite/kernels/internal/compatibility.h"
@@ -30,6 +31,7 @@ limitations under the License.
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/internal/types.h"
 #include "tflite/kernels/kernel_util.h"
+#include "tflite/tensor_views.h"
 #include "tflite/util.h"
 
 namespace tflite {
@@ -264,6 +266,10 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
     // Output is computed in Prepare.
     return kTfLiteOk;
   }
+  // The inputs are already in the output if they are views of it.
+  if (HasPlannedTensorViews(kTfLiteBuiltinConcatenation, *context, *node)) {
+    return kTfLiteOk;
+  }
   if (axis < 0) axis += output->dims->size;
 
   return EvalImpl<kernel_type>(context, node, axis, output);
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tflite/kernels/internal/reference/conv3d.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <vector>
@@ -22,7 +23,9 @@ limitations under the License.
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
 #include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/internal/optimized/integer_ops/conv3d.h"
 #include "tflite/kernels/internal/optimized/optimized_ops.h"
+#include "tflite/kernels/internal/reference/integer_ops/conv3d.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/internal/types.h"
 #include "tflite/kernels/kernel_util.h"
@@ -41,7 +44,10 @@ enum KernelType {
 
 // Struct to carry data from Prepare to Eval.
 const int kTensorNotAllocated = -1;
-static constexpr size_t kMaxIm2colBufferSizeMobile = 1024 * 1024 * 1024;  // 1GB
+// The im2col tensor holds the patches of as many rows of output pixels as fit
+// in this many bytes, and of at least one row, the optimized kernel streaming
+// over the rows rather than materializing the patches of the whole output.
+static constexpr size_t kMaxIm2colBufferSize = 8 * 1024 * 1024;  // 8MB
 
 struct OpData {
   Padding3DValues padding;
@@ -49,11 +55,13 @@ struct OpData {
 
   bool need_im2col = false;
 
-  // Disable im2col if the temporary im2col tensor requires too much memory
-  // (i.e. >= kMaxIm2colBufferSizeMobile).
-  bool im2col_oversized = false;
-
   int32_t im2col_index;
+
+  // Per channel output multiplier and shift of the int8 kernels.
+  std::vector<int32_t> per_channel_output_multiplier;
+  std::vector<int32_t> per_channel_output_shift;
+  int32_t output_activation_min;
+  int32_t output_activation_max;
 };
 
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
@@ -67,8 +75,7 @@ void Free(TfLiteContext* context, void* buffer) {
 
 TfLiteStatus AllocateTemporaryTensorsIfRequired(
     KernelType kernel_type, TfLiteContext* context, TfLiteNode* node,
-    OpData* opdata, TfLiteConv3DParams* params, const TfLiteTensor* filter,
-    size_t im2col_bytes) {
+    OpData* opdata, TfLiteConv3DParams* params, const TfLiteTensor* filter) {
   int temporaries_count = 0;
   const bool need_dilated_im2col = params->dilation_width_factor != 1 ||
                                    params->dilation_height_factor != 1 ||
@@ -81,14 +88,6 @@ TfLiteStatus AllocateTemporaryTensorsIfRequired(
   opdata->need_im2col = (kernel_type == kGenericOptimized) &&
                         (need_dilated_im2col || need_non_dilated_im2col);
 
-  // On mobile platforms, the generic optimized kernel will not be used if the
-  // temporary im2col tensor requires too much memory.
-  if (IsMobilePlatform() && opdata->need_im2col &&
-      im2col_bytes >= kMaxIm2colBufferSizeMobile) {
-    opdata->need_im2col = false;
-    opdata->im2col_oversized = true;
-  }
-
   if (opdata->need_im2col) {
     if (opdata->im2col_tensor_id == kTensorNotAllocated) {
       TF_LITE_ENSURE_OK(
@@ -126,14 +125,17 @@ TfLiteStatus Prepare(KernelType kernel_type, TfLiteContext* context,
 
   // Check types.
   TfLiteType input_type = input->type;
-  TF_LITE_ENSURE_TYPES_EQ(context, input_type, kTfLiteFloat32);
-  TF_LITE_ENSURE_TYPES_EQ(context, filter->type, kTfLiteFloat32);
+  TF_LITE_ENSURE(context,
+                 input_type == kTfLiteFloat32 || input_type == kTfLiteInt8);
+  TF_LITE_ENSURE_TYPES_EQ(context, filter->type, input_type);
   TF_LITE_ENSURE_TYPES_EQ(context, output->type, input_type);
 
   // Check bias.
   const TfLiteTensor* bias = GetInput(context, node, 2);
   if (bias) {
-    TF_LITE_ENSURE_TYPES_EQ(context, bias->type, input_type);
+    TF_LITE_ENSURE_TYPES_EQ(
+        context, bias->type,
+        input_type == kTfLiteInt8 ? kTfLiteInt32 : input_type);
     TF_LITE_ENSURE_EQ(context, NumElements(bias), SizeOfDimension(filter, 4));
   }
 
@@ -158,6 +160,35 @@ TfLiteStatus Prepare(KernelType kernel_type, TfLiteContext* context,
       filter_width, filter_depth, params->padding, &out_height, &out_width,
       &out_depth);
 
+  // Filter must have zero zero-points in per-channel quantization.
+  if (input_type == kTfLiteInt8) {
+    TF_LITE_ENSURE_EQ(context, filter->quantization.type,
+                      kTfLiteAffineQuantization);
+    const auto* affine_quantization =
+        reinterpret_cast<TfLiteAffineQuantization*>(
+            filter->quantization.params);
+    TF_LITE_ENSURE(context, affine_quantization);
+    TF_LITE_ENSURE(context, affine_quantization->scale);
+    TF_LITE_ENSURE(context, (affine_quantization->scale->size == 1 ||
+                             affine_quantization->scale->size == channels_out));
+    if (affine_quantization->zero_point) {
+      for (int i = 0; i < affine_quantization->zero_point->size; ++i) {
+        TF_LITE_ENSURE_EQ(context, affine_quantization->zero_point->data[i], 0);
+      }
+    }
+
+    opdata->per_channel_output_multiplier.resize(channels_out);
+    opdata->per_channel_output_shift.resize(channels_out);
+    int32_t unused_output_multiplier;
+    int unused_output_shift;
+    TF_LITE_ENSURE_STATUS(tflite::PopulateConvolutionQuantizationParams(
+        context, input, filter, bias, output, params->activation,
+        &unused_output_multiplier, &unused_output_shift,
+        &opdata->output_activation_min, &opdata->output_activation_max,
+        opdata->per_channel_output_multiplier.data(),
+        opdata->per_channel_output_shift.data(), channels_out));
+  }
+
   TfLiteIntArray* output_size = TfLiteIntArrayCreate(5);
   output_size->data[0] = batches;
   output_size->data[1] = out_depth;
@@ -168,23 +199,28 @@ TfLiteStatus Prepare(KernelType kernel_type, TfLiteContext* context,
                     context->ResizeTensor(context, output, output_size));
 
   // Allocate temporary tensors.
-  size_t input_type_size;
-  TF_LITE_ENSURE_STATUS(GetSizeOfType(context, input->type, &input_type_size));
-  const size_t im2col_bytes = batches * out_depth * out_height * out_width *
-                              input_channel * filter_depth * filter_height *
-                              filter_width * input_type_size;
-  TF_LITE_ENSURE_OK(context, AllocateTemporaryTensorsIfRequired(
-                                 kernel_type, context, node, opdata, params,
-                                 filter, im2col_bytes));
+  TF_LITE_ENSURE_OK(context,
+                    AllocateTemporaryTensorsIfRequired(
+                        kernel_type, context, node, opdata, params, filter));
 
   if (opdata->need_im2col) {
-    TfLiteIntArray* im2col_size = TfLiteIntArrayCreate(5);
-    im2col_size->data[0] = output_size->data[0];
-    im2col_size->data[1] = output_size->data[1];
-    im2col_size->data[2] = output_size->data[2];
-    im2col_size->data[3] = output_size->data[3];
-    im2col_size->data[4] =
+    size_t input_type_size;
+    TF_LITE_ENSURE_STATUS(
+        GetSizeOfType(context, input->type, &input_type_size));
+    const int patch_size =
         input_channel * filter_depth * filter_height * filter_width;
+    const size_t row_bytes = std::max<size_t>(
+        1, static_cast<size_t>(out_width) * patch_size * input_type_size);
+    const size_t num_rows =
+        static_cast<size_t>(batches) * out_depth * out_height;
+    const int chunk_rows = static_cast<int>(std::max<size_t>(
+        1, std::min(num_rows, kMaxIm2colBufferSize / row_bytes)));
+    TfLiteIntArray* im2col_size = TfLiteIntArrayCreate(5);
+    im2col_size->data[0] = 1;
+    im2col_size->data[1] = 1;
+    im2col_size->data[2] = chunk_rows;
+    im2col_size->data[3] = out_width;
+    im2col_size->data[4] = patch_size;
 
     TfLiteTensor* im2col;
     node->temporaries->data[opdata->im2col_index] = opdata->im2col_tensor_id;
@@ -204,6 +240,17 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   return Prepare(kernel_type, context, node);
 }
 
+void FillRuntimeParams(const TfLiteConv3DParams* params, const OpData* opdata,
+                       Conv3DParams* runtime_params) {
+  runtime_params->padding_values = opdata->padding;
+  runtime_params->stride_depth = params->stride_depth;
+  runtime_params->stride_height = params->stride_height;
+  runtime_params->stride_width = params->stride_width;
+  runtime_params->dilation_depth = params->dilation_depth_factor;
+  runtime_params->dilation_height = params->dilation_height_factor;
+  runtime_params->dilation_width = params->dilation_width_factor;
+}
+
 TfLiteStatus EvalFloat(KernelType kernel_type, TfLiteContext* context,
                        TfLiteNode* node, TfLiteConv3DParams* params,
                        OpData* opdata, const TfLiteTensor* input,
@@ -214,13 +261,7 @@ TfLiteStatus EvalFloat(KernelType kernel_type, TfLiteContext* context,
                            &output_activation_max);
 
   Conv3DParams runtime_params;
-  runtime_params.padding_values = opdata->padding;
-  runtime_params.stride_depth = params->stride_depth;
-  runtime_params.stride_height = params->stride_height;
-  runtime_params.stride_width = params->stride_width;
-  runtime_params.dilation_depth = params->dilation_depth_factor;
-  runtime_params.dilation_height = params->dilation_height_factor;
-  runtime_params.dilation_width = params->dilation_width_factor;
+  FillRuntimeParams(params, opdata, &runtime_params);
   runtime_params.float_activation_min = output_activation_min;
   runtime_params.float_activation_max = output_activation_max;
   switch (kernel_type) {
@@ -244,6 +285,43 @@ TfLiteStatus EvalFloat(KernelType kernel_type, TfLiteContext* context,
   }
 }
 
+TfLiteStatus EvalQuantizedPerChannel(
+    KernelType kernel_type, TfLiteContext* context, TfLiteNode* node,
+    TfLiteConv3DParams* params, OpData* opdata, const TfLiteTensor* input,
+    const TfLiteTensor* filter, const TfLiteTensor* bias, TfLiteTensor* im2col,
+    TfLiteTensor* output) {
+  Conv3DParams runtime_params;
+  FillRuntimeParams(params, opdata, &runtime_params);
+  runtime_params.input_offset = -input->params.zero_point;
+  runtime_params.output_offset = output->params.zero_point;
+  runtime_params.quantized_activation_min = opdata->output_activation_min;
+  runtime_params.quantized_activation_max = opdata->output_activation_max;
+  switch (kernel_type) {
+    case kReference: {
+      reference_integer_ops::Conv3DPerChannel(
+          runtime_params, opdata->per_channel_output_multiplier.data(),
+          opdata->per_channel_output_shift.data(), GetTensorShape(input),
+          GetTensorData<int8_t>(input), GetTensorShape(filter),
+          GetTensorData<int8_t>(filter), GetTensorShape(bias),
+          GetTensorData<int32_t>(bias), GetTensorShape(output),
+          GetTensorData<int8_t>(output));
+      return kTfLiteOk;
+    }
+    case kGenericOptimized: {
+      optimized_integer_ops::Conv3DPerChannel(
+          runtime_params, opdata->per_channel_output_multiplier.data(),
+          opdata->per_channel_output_shift.data(), GetTensorShape(input),
+          GetTensorData<int8_t>(input), GetTensorShape(filter),
+          GetTensorData<int8_t>(filter), GetTensorShape(bias),
+          GetTensorData<int32_t>(bias), GetTensorShape(output),
+          GetTensorData<int8_t>(output), GetTensorShape(im2col),
+          GetTensorData<int8_t>(im2col),
+          CpuBackendContext::GetFromContext(context));
+      return kTfLiteOk;
+    }
+  }
+}
+
 TfLiteStatus Eval(KernelType kernel_type, TfLiteContext* context,
                   TfLiteNode* node) {
   auto* params = reinterpret_cast<TfLiteConv3DParams*>(node->builtin_data);
@@ -260,15 +338,15 @@ TfLiteStatus Eval(KernelType kernel_type, TfLiteContext* context,
   TfLiteTensor* im2col = opdata->need_im2col
                              ? &context->tensors[opdata->im2col_tensor_id]
                              : nullptr;
-  // Fallback to reference execution path when im2col is needed but disabled.
-  if (opdata->im2col_oversized) {
-    kernel_type = kReference;
-  }
 
   switch (input->type) {
     case kTfLiteFloat32:
       return EvalFloat(kernel_type, context, node, params, opdata, input,
                        filter, bias, im2col, output);
+    case kTfLiteInt8:
+      return EvalQuantizedPerChannel(kernel_type, context, node, params,
+                                     opdata, input, filter, bias, im2col,
+                                     output);
     default:
       TF_LITE_KERNEL_LOG(context, "Type %s currently not supported.",
                          TfLiteTypeGetName(input->type));
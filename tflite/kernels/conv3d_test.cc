@@ -14,14 +14,25 @@ limitations under the License.
 ==============================================================================*/
 #include <cstdint>
 #include <initializer_list>
+#include <memory>
 #include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "tflite/core/c/common.h"
 #include "tflite/kernels/test_util.h"
 #include "tflite/schema/schema_generated.h"
 
 namespace tflite {
+namespace ops {
+namespace builtin {
+
+TfLiteRegistration* Register_CONV_3D_REF();
+TfLiteRegistration* Register_CONV_3D_GENERIC_OPT();
+
+}  // namespace builtin
+}  // namespace ops
+
 namespace {
 
 using ::testing::ElementsAre;
@@ -35,7 +46,8 @@ class Conv3dOpModel : public SingleOpModel {
                 int32_t stride_width = 1, int32_t stride_height = 1,
                 ActivationFunctionType activation = ActivationFunctionType_NONE,
                 int32_t dilation_depth = 1, int32_t dilation_width = 1,
-                int32_t dilation_height = 1) {
+                int32_t dilation_height = 1,
+                TfLiteRegistration* registration = nullptr) {
     input_ = AddInput(input);
     filter_ = AddInput(filter);
     bias_ = AddInput(bias);
@@ -46,6 +58,10 @@ class Conv3dOpModel : public SingleOpModel {
                             stride_height, activation, dilation_depth,
                             dilation_width, dilation_height)
             .Union());
+    if (registration != nullptr) {
+      SetResolver(std::make_unique<SingleOpResolver>(BuiltinOperator_CONV_3D,
+                                                     registration));
+    }
     BuildInterpreter({GetShape(input_), GetShape(filter_), GetShape(bias_)});
   }
 
@@ -74,7 +90,26 @@ class Conv3dOpModel : public SingleOpModel {
 
   void SetInput(std::vector<float> data) { PopulateTensor(input_, data); }
 
+  void SetQuantizedInput(const std::vector<float>& data) {
+    QuantizeAndPopulate<int8_t>(input_, data);
+  }
+
+  void SetPerChannelQuantizedFilter(const std::vector<float>& data) {
+    PerChannelSymmetricQuantizeAndPopulate(filter_, data);
+  }
+
+  void SetPerChannelQuantizedBias(const std::vector<float>& data) {
+    PerChannelQuantizeBias(bias_, data);
+  }
+
   std::vector<float> GetOutput() { return ExtractVector<float>(output_); }
+  std::vector<int8_t> GetQuantizedOutput() {
+    return ExtractVector<int8_t>(output_);
+  }
+  std::vector<float> GetDequantizedOutput() {
+    return Dequantize<int8_t>(ExtractVector<int8_t>(output_),
+                              GetScale(output_), GetZeroPoint(output_));
+  }
   std::vector<int> GetOutputShape() { return GetTensorShape(output_); }
 
  private:
@@ -91,6 +126,13 @@ std::vector<T> CreateRangeVector(int N) {
   return result;
 }
 
+// Returns N values in [-1, 1] without any particular pattern.
+std::vector<float> CreateMixedVector(int N) {
+  std::vector<float> result;
+  for (int i = 0; i < N; ++i) result.push_back(((i * 37) % 101) / 50.f - 1.f);
+  return result;
+}
+
 TEST(Conv3dOpModel, InvalidInputDimsTest) {
   EXPECT_DEATH_IF_SUPPORTED(Conv3dOpModel m({TensorType_FLOAT32, {2, 2, 4, 1}},
                                             {TensorType_FLOAT32, {3, 2, 2, 1}},
@@ -269,5 +311,140 @@ TEST(Conv3dOpModel, NoIm2ColTensorTest) {
                         708, 794, 632, 734, 836, 938, 728, 846, 964, 1082}));
 }
 
+TEST(Conv3dOpModel, Int8PerChannelTest) {
+  Conv3dOpModel m({TensorType_INT8, {1, 2, 2, 4, 2}, -63.5, 64, 0.5, -1},
+                  {TensorType_INT8,
+                   {2, 2, 2, 2, 2},
+                   0,
+                   0,
+                   0,
+                   0,
+                   /*per_channel_quantization=*/true,
+                   /*per_channel_quantization_scales=*/{1, 0.5},
+                   /*per_channel_quantization_offsets=*/{0, 0},
+                   /*channel_index=*/4},
+                  {TensorType_INT8, {}, -63.5, 64, 0.5, -1});
+
+  m.SetQuantizedInput(CreateRangeVector<float>(32));
+  m.SetPerChannelQuantizedFilter(
+      {-1, -1, -1, -1, -1, 1, -1, 1, -1, 1,  1,  1, 1, 1,  -1, -1,
+       1,  -1, 1,  1,  1,  1, -1, 1, -1, -1, -1, 1, 1, -1, 1,  -1});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(1, 1, 1, 3, 2));
+  EXPECT_THAT(m.GetDequantizedOutput(),
+              ElementsAreArray(ArrayFloatNear({30, 6, 26, 10, 22, 14})));
+}
+
+TEST(Conv3dOpModel, Int8PerChannelBiasTest) {
+  Conv3dOpModel m({TensorType_INT8, {2, 2, 3, 4, 2}, 0, 127.5, 0.5, -128},
+                  {TensorType_INT8,
+                   {2, 2, 2, 2, 2},
+                   0,
+                   0,
+                   0,
+                   0,
+                   /*per_channel_quantization=*/true,
+                   /*per_channel_quantization_scales=*/{1, 0.5},
+                   /*per_channel_quantization_offsets=*/{0, 0},
+                   /*channel_index=*/4},
+                  {TensorType_INT32,
+                   {2},
+                   0,
+                   0,
+                   0,
+                   0,
+                   /*per_channel_quantization=*/true,
+                   /*per_channel_quantization_scales=*/{0.5, 0.25},
+                   /*per_channel_quantization_offsets=*/{0, 0},
+                   /*channel_index=*/0},
+                  {TensorType_INT8, {}, 0, 510, 2, -128}, Padding_VALID,
+                  /*stride_depth=*/2, /*stride_width=*/2, /*stride_height=*/2);
+
+  m.SetQuantizedInput(CreateRangeVector<float>(96));
+  m.SetPerChannelQuantizedFilter(
+      {1, -1, 1, 1, -1, 1, 1, -1, 1, -1, -1, -1, -1, 1, 1, 1,
+       1, -1, 1, 1, -1, 1, 1, -1, 1, -1, -1, -1, -1, 1, 1, 1});
+  m.SetPerChannelQuantizedBias({1, 2});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(2, 1, 1, 2, 2));
+  EXPECT_THAT(m.GetDequantizedOutput(),
+              ElementsAreArray(ArrayFloatNear(
+                  {53, 10, 69, 10, 245, 10, 261, 10}, /*max_abs_err=*/1)));
+}
+
+// The im2col matrix of these convolutions is larger than the im2col tensor,
+// which holds its rows by chunks.
+TEST(Conv3dOpModel, LargeFloat32InputMatchesReference) {
+  const std::vector<float> input = CreateMixedVector(1 * 8 * 16 * 64 * 32);
+  const std::vector<float> filter = CreateMixedVector(3 * 3 * 3 * 32 * 2);
+  std::vector<std::vector<float>> outputs;
+  for (TfLiteRegistration* registration :
+       {ops::builtin::Register_CONV_3D_REF(),
+        ops::builtin::Register_CONV_3D_GENERIC_OPT()}) {
+    Conv3dOpModel m({TensorType_FLOAT32, {1, 8, 16, 64, 32}},
+                    {TensorType_FLOAT32, {3, 3, 3, 32, 2}},
+                    {TensorType_FLOAT32, {2}}, {TensorType_FLOAT32, {}},
+                    Padding_SAME, /*stride_depth=*/1, /*stride_width=*/1,
+                    /*stride_height=*/1, ActivationFunctionType_NONE,
+                    /*dilation_depth=*/1, /*dilation_width=*/1,
+                    /*dilation_height=*/2, registration);
+    m.SetNumThreads(4);
+    m.SetInput(input);
+    m.SetFilter(filter);
+    m.SetBias({0.5, -0.5});
+    ASSERT_EQ(m.Invoke(), kTfLiteOk);
+    EXPECT_THAT(m.GetOutputShape(), ElementsAre(1, 8, 16, 64, 2));
+    outputs.push_back(m.GetOutput());
+  }
+  EXPECT_THAT(outputs[1], ElementsAreArray(ArrayFloatNear(outputs[0], 1e-3)));
+}
+
+TEST(Conv3dOpModel, LargeInt8InputMatchesReference) {
+  const std::vector<float> input = CreateMixedVector(1 * 8 * 16 * 128 * 32);
+  const std::vector<float> filter = CreateMixedVector(3 * 3 * 3 * 32 * 2);
+  std::vector<std::vector<int8_t>> outputs;
+  for (TfLiteRegistration* registration :
+       {ops::builtin::Register_CONV_3D_REF(),
+        ops::builtin::Register_CONV_3D_GENERIC_OPT()}) {
+    Conv3dOpModel m({TensorType_INT8, {1, 8, 16, 128, 32}, -1, 1},
+                    {TensorType_INT8,
+                     {3, 3, 3, 32, 2},
+                     0,
+                     0,
+                     0,
+                     0,
+                     /*per_channel_quantization=*/true,
+                     /*per_channel_quantization_scales=*/{1 / 127.f, 1 / 64.f},
+                     /*per_channel_quantization_offsets=*/{0, 0},
+                     /*channel_index=*/4},
+                    {TensorType_INT32,
+                     {2},
+                     0,
+                     0,
+                     0,
+                     0,
+                     /*per_channel_quantization=*/true,
+                     /*per_channel_quantization_scales=*/
+                     {1 / (127.5f * 127), 1 / (127.5f * 64)},
+                     /*per_channel_quantization_offsets=*/{0, 0},
+                     /*channel_index=*/0},
+                    {TensorType_INT8, {}, -40, 40}, Padding_SAME,
+                    /*stride_depth=*/1, /*stride_width=*/1,
+                    /*stride_height=*/1, ActivationFunctionType_RELU,
+                    /*dilation_depth=*/1, /*dilation_width=*/1,
+                    /*dilation_height=*/1, registration);
+    m.SetNumThreads(4);
+    m.SetQuantizedInput(input);
+    m.SetPerChannelQuantizedFilter(filter);
+    m.SetPerChannelQuantizedBias({0.5, -0.5});
+    ASSERT_EQ(m.Invoke(), kTfLiteOk);
+    EXPECT_THAT(m.GetOutputShape(), ElementsAre(1, 8, 16, 128, 2));
+    outputs.push_back(m.GetQuantizedOutput());
+  }
+  EXPECT_EQ(outputs[1], outputs[0]);
+}
+
 }  // namespace
 }  // namespace tflite
@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tflite/kernels/internal/reference/conv3d_transpose.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 
@@ -37,6 +38,9 @@ enum KernelType {
 };
 
 const int kTensorNotAllocated = -1;
+// The col2im tensor holds the patches of as many input planes as fit in this
+// many bytes, and of at least one plane.
+static constexpr size_t kMaxCol2imBufferSize = 8 * 1024 * 1024;  // 8MB
 
 struct OpData {
   Padding3DValues padding;
@@ -122,10 +126,16 @@ TfLiteStatus ResizeOutputAndTemporaryTensors(
   if (opdata->need_col2im) {
     TfLiteIntArray* col2im_shape_array = TfLiteIntArrayCreate(2);
     const RuntimeShape& input_shape = GetTensorShape(input);
-    col2im_shape_array->data[0] =
-        input_shape.Dims(1) * input_shape.Dims(2) * input_shape.Dims(3);
-    col2im_shape_array->data[1] =
+    const int input_plane_size = input_shape.Dims(2) * input_shape.Dims(3);
+    const int patch_size =
         filter_depth * filter_height * filter_width * filter_shape.Dims(3);
+    const size_t plane_bytes = std::max<size_t>(
+        1, static_cast<size_t>(input_plane_size) * patch_size * sizeof(float));
+    const int chunk_planes = static_cast<int>(std::max<size_t>(
+        1, std::min<size_t>(input_shape.Dims(1),
+                            kMaxCol2imBufferSize / plane_bytes)));
+    col2im_shape_array->data[0] = chunk_planes * input_plane_size;
+    col2im_shape_array->data[1] = patch_size;
 
     col2im->type = kTfLiteFloat32;
     col2im->allocation_type = kTfLiteDynamic;
@@ -16,6 +16,7 @@ limitations under the License.
 #include "tflite/kernels/cpu_backend_context.h"
 
 #include <memory>
+#include <utility>
 
 #ifdef TFLITE_KERNEL_USE_XNNPACK
 #include "pthreadpool.h"  // from @pthreadpool
@@ -31,6 +32,7 @@ limitations under the License.
 #include "tflite/core/c/common.h"
 #include "tflite/core/macros.h"
 #include "tflite/external_cpu_backend_context.h"
+#include "tflite/kernels/affinity_thread_pool.h"
 #include "tflite/kernels/internal/compatibility.h"
 #include "tflite/kernels/op_macros.h"
 
@@ -147,10 +149,29 @@ void CpuBackendContext::SetMaxNumThreads(int max_num_threads) {
   max_num_threads_ = target_num_threads;
   ruy_context_->set_max_num_threads(target_num_threads);
   gemmlowp_context_->set_max_num_threads(target_num_threads);
+  if (thread_pool_ && thread_pool_->options().cpus.empty() &&
+      thread_pool_->options().num_threads != target_num_threads) {
+    SetThreadPoolOptions(thread_pool_->options());
+  }
 }
 
 void CpuBackendContext::SetUseCaching(bool flag) { use_caching_ = flag; }
 
+void CpuBackendContext::SetThreadPoolOptions(
+    const AffinityThreadPool::Options& options) {
+  AffinityThreadPool::Options pool_options = options;
+  pool_options.num_threads = max_num_threads_;
+  // The threads of the previous pool are joined first.
+  thread_pool_.reset();
+  thread_pool_ = std::make_unique<AffinityThreadPool>(pool_options);
+}
+
+void CpuBackendContext::SetSharedThreadPool(
+    std::shared_ptr<TfLiteCpuThreadPool> thread_pool, int priority) {
+  shared_thread_pool_ = std::move(thread_pool);
+  shared_thread_pool_priority_ = priority;
+}
+
 #ifdef TFLITE_KERNEL_USE_XNNPACK
 pthreadpool_t CpuBackendContext::get_xnnpack_threadpool() {
   if (!xnnpack_threadpool_ && max_num_threads_ > 1) {
@@ -30,6 +30,7 @@ limitations under the License.
 #include "ruy/context.h"  // from @ruy
 #include "tflite/core/c/common.h"
 #include "tflite/external_cpu_backend_context.h"
+#include "tflite/kernels/affinity_thread_pool.h"
 
 namespace tflite {
 
@@ -56,6 +57,31 @@ class CpuBackendContext final : public TfLiteInternalBackendContext {
 
   bool use_caching() const { return use_caching_; }
 
+  // Runs the tasks of cpu_backend_threadpool::Execute() on an
+  // AffinityThreadPool with `options` instead of on ruy's or gemmlowp's thread
+  // pool. Unless `options.cpus` are set, the pool has max_num_threads()
+  // threads, whatever `options.num_threads`.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetThreadPoolOptions(const AffinityThreadPool::Options& options);
+
+  // Returns nullptr unless SetThreadPoolOptions() was called.
+  AffinityThreadPool* thread_pool() const { return thread_pool_.get(); }
+
+  // Runs the tasks of cpu_backend_threadpool::Execute() on `thread_pool`,
+  // shared with other contexts, in place of the pool of thread_pool(). It is
+  // called by ExternalCpuBackendContext::set_shared_thread_pool().
+  void SetSharedThreadPool(std::shared_ptr<TfLiteCpuThreadPool> thread_pool,
+                           int priority) override;
+
+  TfLiteCpuThreadPool* shared_thread_pool() const {
+    return shared_thread_pool_.get();
+  }
+
+  int shared_thread_pool_priority() const {
+    return shared_thread_pool_priority_;
+  }
+
 #ifdef TFLITE_KERNEL_USE_XNNPACK
   pthreadpool_t get_xnnpack_threadpool();
 #endif
@@ -122,6 +148,14 @@ class CpuBackendContext final : public TfLiteInternalBackendContext {
   // (currently the Ruy library only).
   bool use_caching_;
 
+  // Runs the tasks of cpu_backend_threadpool::Execute() if set.
+  std::unique_ptr<AffinityThreadPool> thread_pool_;
+
+  // Runs the tasks of cpu_backend_threadpool::Execute() if set, before
+  // `thread_pool_`.
+  std::shared_ptr<TfLiteCpuThreadPool> shared_thread_pool_;
+  int shared_thread_pool_priority_ = 0;
+
 #ifdef TFLITE_KERNEL_USE_XNNPACK
   // A smart pointer for the xnnpack threadpool. Is created by a call from the
   // interpreter, and then consumed by xnnpack, possibly via a TFLite kernel.
@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_KERNELS_CPU_BACKEND_THREADPOOL_H_
 #define TENSORFLOW_LITE_KERNELS_CPU_BACKEND_THREADPOOL_H_
 
+#include "tflite/kernels/affinity_thread_pool.h"
+#include "tflite/external_cpu_backend_context.h"
 #include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/kernels/internal/compatibility.h"
 
@@ -28,6 +30,29 @@ limitations under the License.
 
 namespace tflite {
 namespace cpu_backend_threadpool {
+namespace internal {
+
+// Runs the tasks on the shared thread pool, or the affinity thread pool, of
+// `cpu_backend_context`, and returns false if it has neither.
+template <typename TaskType>
+bool ExecuteOnContextThreadPool(int tasks_count, TaskType* tasks,
+                                CpuBackendContext* cpu_backend_context) {
+  auto run_task = [tasks](int i) { tasks[i].Run(); };
+  if (TfLiteCpuThreadPool* shared_thread_pool =
+          cpu_backend_context->shared_thread_pool()) {
+    shared_thread_pool->Execute(
+        tasks_count, run_task,
+        cpu_backend_context->shared_thread_pool_priority());
+    return true;
+  }
+  if (AffinityThreadPool* thread_pool = cpu_backend_context->thread_pool()) {
+    thread_pool->Execute(tasks_count, run_task);
+    return true;
+  }
+  return false;
+}
+
+}  // namespace internal
 
 #ifdef TFLITE_WITH_RUY
 
@@ -37,6 +62,10 @@ template <typename TaskType>
 void Execute(int tasks_count, TaskType* tasks,
              CpuBackendContext* cpu_backend_context) {
   TFLITE_DCHECK_LE(tasks_count, cpu_backend_context->max_num_threads());
+  if (internal::ExecuteOnContextThreadPool(tasks_count, tasks,
+                                           cpu_backend_context)) {
+    return;
+  }
   cpu_backend_context->ruy_context()->mutable_thread_pool()->Execute(
       tasks_count, tasks);
 }
@@ -49,6 +78,10 @@ template <typename TaskType>
 void Execute(int tasks_count, TaskType* tasks,
              CpuBackendContext* cpu_backend_context) {
   TFLITE_DCHECK_LE(tasks_count, cpu_backend_context->max_num_threads());
+  if (internal::ExecuteOnContextThreadPool(tasks_count, tasks,
+                                           cpu_backend_context)) {
+    return;
+  }
   cpu_backend_context->gemmlowp_context()->workers_pool()->Execute(tasks_count,
                                                                    tasks);
 }
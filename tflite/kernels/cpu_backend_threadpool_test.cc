@@ -18,6 +18,7 @@ limitations under the License.
 #include <vector>
 
 #include <gtest/gtest.h>
+#include "tflite/kernels/affinity_thread_pool.h"
 #include "tflite/kernels/cpu_backend_context.h"
 
 namespace tflite {
@@ -42,7 +43,8 @@ class TestGenerateArrayOfIncrementingIntsTask
   int end_;
 };
 
-void TestGenerateArrayOfIncrementingInts(int num_threads, int size) {
+void TestGenerateArrayOfIncrementingInts(
+    int num_threads, int size, bool use_affinity_thread_pool = false) {
   // The buffer that our threads will write to.
   std::vector<int> buffer(size);
 
@@ -67,6 +69,11 @@ void TestGenerateArrayOfIncrementingInts(int num_threads, int size) {
   // What actually determines the number of threads used is the parameter
   // passed to Execute, since Execute does 1:1 mapping of tasks to threads.
   context.SetMaxNumThreads(num_threads);
+  if (use_affinity_thread_pool) {
+    AffinityThreadPool::Options options;
+    options.collect_task_timings = true;
+    context.SetThreadPoolOptions(options);
+  }
 
   // Execute tasks on the threadpool.
   cpu_backend_threadpool::Execute(tasks.size(), tasks.data(), &context);
@@ -75,6 +82,15 @@ void TestGenerateArrayOfIncrementingInts(int num_threads, int size) {
   for (int i = 0; i < size; i++) {
     ASSERT_EQ(buffer[i], i);
   }
+
+  if (use_affinity_thread_pool) {
+    ASSERT_NE(context.thread_pool(), nullptr);
+    int num_tasks = 0;
+    for (const auto& timings : context.thread_pool()->task_timings()) {
+      num_tasks += timings.num_tasks;
+    }
+    EXPECT_EQ(num_tasks, num_threads);
+  }
 }
 
 TEST(CpuBackendThreadpoolTest, OneThreadSize100) {
@@ -89,6 +105,11 @@ TEST(CpuBackendThreadpoolTest, TenThreadsSize1234567) {
   TestGenerateArrayOfIncrementingInts(10, 1234567);
 }
 
+TEST(CpuBackendThreadpoolTest, AffinityThreadPoolThreeThreadsSize1000000) {
+  TestGenerateArrayOfIncrementingInts(3, 1000000,
+                                      /*use_affinity_thread_pool=*/true);
+}
+
 }  // namespace
 
 }  // namespace tflite
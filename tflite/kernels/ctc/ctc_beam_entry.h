@@ -19,8 +19,9 @@ limitations under the License.
 #define TENSORFLOW_LITE_KERNELS_CTC_CTC_BEAM_ENTRY_H_
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <unordered_map>
 #include <vector>
 
 #include "Eigen/Core"  // from @eigen_archive
@@ -57,21 +58,12 @@ class BeamRoot;
 
 template <class CTCBeamState = EmptyBeamState>
 struct BeamEntry {
-  // BeamRoot<CTCBeamState>::AddEntry() serves as the factory method.
-  friend BeamEntry<CTCBeamState>* BeamRoot<CTCBeamState>::AddEntry(
-      BeamEntry<CTCBeamState>* p, int l);
+  // BeamRoot<CTCBeamState> serves as the factory.
+  friend class BeamRoot<CTCBeamState>;
   inline bool Active() const { return newp.total != kLogZero; }
   // Return the child at the given index, or construct a new one in-place if
   // none was found.
-  BeamEntry& GetChild(int ind) {
-    auto entry = children.emplace(ind, nullptr);
-    auto& child_entry = entry.first->second;
-    // If this is a new child, populate the BeamEntry<CTCBeamState>*.
-    if (entry.second) {
-      child_entry = beam_root->AddEntry(this, ind);
-    }
-    return *child_entry;
-  }
+  BeamEntry& GetChild(int ind) { return *beam_root->GetChild(this, ind); }
   std::vector<int> LabelSeq(bool merge_repeated) const {
     std::vector<int> labels;
     int prev_label = -1;
@@ -89,8 +81,6 @@ struct BeamEntry {
 
   BeamEntry<CTCBeamState>* parent;
   int label;
-  // All instances of child BeamEntry are owned by *beam_root.
-  std::unordered_map<int, BeamEntry<CTCBeamState>*> children;
   BeamProbability oldp;
   BeamProbability newp;
   CTCBeamState state;
@@ -111,23 +101,95 @@ struct BeamEntry {
 
 // This class owns all instances of BeamEntry.  This is used to avoid recursive
 // destructor call during destruction.
+//
+// The entries are kept in a pool that Reset() recycles, and the children of
+// the entries are found in an open addressing hash table of their parent and
+// label, so that once the pool and the table are large enough, decoding more
+// sequences doesn't allocate memory.
 template <class CTCBeamState = EmptyBeamState>
 class BeamRoot {
  public:
-  BeamRoot(BeamEntry<CTCBeamState>* p, int l) { root_entry_ = AddEntry(p, l); }
+  BeamRoot(BeamEntry<CTCBeamState>* p, int l) { Reset(p, l); }
   BeamRoot(const BeamRoot&) = delete;
   BeamRoot& operator=(const BeamRoot&) = delete;
 
+  // Releases all the entries to the pool, and adds a new root entry.
+  void Reset(BeamEntry<CTCBeamState>* p, int l) {
+    num_entries_ = 0;
+    num_children_ = 0;
+    std::fill(children_.begin(), children_.end(), nullptr);
+    root_entry_ = AddEntry(p, l);
+  }
+
   BeamEntry<CTCBeamState>* AddEntry(BeamEntry<CTCBeamState>* p, int l) {
-    auto* new_entry = new BeamEntry<CTCBeamState>(p, l, this);
-    beam_entries_.emplace_back(new_entry);
-    return new_entry;
+    if (num_entries_ == beam_entries_.size()) {
+      beam_entries_.emplace_back(new BeamEntry<CTCBeamState>(p, l, this));
+    } else {
+      BeamEntry<CTCBeamState>* entry = beam_entries_[num_entries_].get();
+      entry->parent = p;
+      entry->label = l;
+      entry->oldp.Reset();
+      entry->newp.Reset();
+      entry->state = CTCBeamState();
+    }
+    return beam_entries_[num_entries_++].get();
   }
+
+  // Returns the child of `p` with label `l`, adding it if none was found.
+  BeamEntry<CTCBeamState>* GetChild(BeamEntry<CTCBeamState>* p, int l) {
+    // Keep the table at most half full.
+    if (2 * (num_children_ + 1) > children_.size()) {
+      Rehash(std::max<size_t>(kMinChildrenTableSize, 2 * children_.size()));
+    }
+    BeamEntry<CTCBeamState>** slot = FindSlot(p, l);
+    if (*slot == nullptr) {
+      *slot = AddEntry(p, l);
+      ++num_children_;
+    }
+    return *slot;
+  }
+
   BeamEntry<CTCBeamState>* RootEntry() const { return root_entry_; }
 
  private:
+  static constexpr size_t kMinChildrenTableSize = 64;
+
+  static size_t Hash(const BeamEntry<CTCBeamState>* p, int l) {
+    uint64_t hash = reinterpret_cast<uintptr_t>(p) ^
+                    (static_cast<uint64_t>(static_cast<uint32_t>(l)) << 32);
+    hash *= 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash ^ (hash >> 32));
+  }
+
+  // Returns the slot of the child of `p` with label `l`, or the empty slot
+  // where to add it.
+  BeamEntry<CTCBeamState>** FindSlot(const BeamEntry<CTCBeamState>* p, int l) {
+    const size_t mask = children_.size() - 1;
+    for (size_t i = Hash(p, l) & mask;; i = (i + 1) & mask) {
+      BeamEntry<CTCBeamState>*& child = children_[i];
+      if (child == nullptr || (child->parent == p && child->label == l)) {
+        return &child;
+      }
+    }
+  }
+
+  void Rehash(size_t size) {
+    std::vector<BeamEntry<CTCBeamState>*> children(size, nullptr);
+    children.swap(children_);
+    for (BeamEntry<CTCBeamState>* child : children) {
+      if (child != nullptr) {
+        *FindSlot(child->parent, child->label) = child;
+      }
+    }
+  }
+
   BeamEntry<CTCBeamState>* root_entry_ = nullptr;
   std::vector<std::unique_ptr<BeamEntry<CTCBeamState>>> beam_entries_;
+  // The number of entries of the pool in use.
+  size_t num_entries_ = 0;
+  // The children of the entries, a power of 2 sized hash table.
+  std::vector<BeamEntry<CTCBeamState>*> children_;
+  size_t num_children_ = 0;
 };
 
 // BeamComparer is the default beam comparer provided in CTCBeamSearch.
@@ -15,14 +15,13 @@ limitations under the License.
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <cstdlib>
 #include <initializer_list>
+#include <memory>
 #include <vector>
 
 #include "flatbuffers/flexbuffers.h"  // from @flatbuffers
 #include "tflite/core/c/common.h"
 #include "tflite/kernels/ctc/ctc_beam_search.h"
-#include "tflite/kernels/internal/optimized/optimized_ops.h"
 #include "tflite/kernels/internal/tensor.h"
 #include "tflite/kernels/kernel_util.h"
 #include "tflite/kernels/op_macros.h"
@@ -41,26 +40,35 @@ typedef struct {
   bool merge_repeated;
 } CTCBeamSearchDecoderParams;
 
+struct OpData {
+  CTCBeamSearchDecoderParams params;
+  ::tflite::custom::ctc::CTCBeamSearchDecoder<>::DefaultBeamScorer beam_scorer;
+  // Kept across invocations with the same number of classes, so that the beam
+  // pool of the decoder is reused rather than reallocated.
+  std::unique_ptr<::tflite::custom::ctc::CTCBeamSearchDecoder<>> beam_search;
+};
+
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
   TFLITE_CHECK(buffer != nullptr);
   const uint8_t* buffer_t = reinterpret_cast<const uint8_t*>(buffer);
   const flexbuffers::Map& m = flexbuffers::GetRoot(buffer_t, length).AsMap();
 
-  CTCBeamSearchDecoderParams* option = new CTCBeamSearchDecoderParams;
+  OpData* op_data = new OpData;
+  CTCBeamSearchDecoderParams* option = &op_data->params;
   option->beam_width = m["beam_width"].AsInt32();
   option->top_paths = m["top_paths"].AsInt32();
   option->merge_repeated = m["merge_repeated"].AsBool();
 
-  return option;
+  return op_data;
 }
 
 void Free(TfLiteContext* context, void* buffer) {
-  delete reinterpret_cast<CTCBeamSearchDecoderParams*>(buffer);
+  delete reinterpret_cast<OpData*>(buffer);
 }
 
 TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   const CTCBeamSearchDecoderParams* option =
-      reinterpret_cast<CTCBeamSearchDecoderParams*>(node->user_data);
+      &reinterpret_cast<OpData*>(node->user_data)->params;
   const int top_paths = option->top_paths;
   TF_LITE_ENSURE(context, option->beam_width >= top_paths);
   TF_LITE_ENSURE_EQ(context, NumInputs(node), 2);
@@ -186,8 +194,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   const TfLiteTensor* sequence_length;
   TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, kSequenceLengthTensor,
                                           &sequence_length));
-  const CTCBeamSearchDecoderParams* option =
-      reinterpret_cast<CTCBeamSearchDecoderParams*>(node->user_data);
+  OpData* op_data = reinterpret_cast<OpData*>(node->user_data);
+  const CTCBeamSearchDecoderParams* option = &op_data->params;
 
   const int max_time = SizeOfDimension(inputs, 0);
   const int batch_size = SizeOfDimension(inputs, 1);
@@ -205,26 +213,16 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 
   // The following logic is implemented like
   // tensorflow/core/kernels/ctc_decoder_ops.cc
-  std::vector<optimized_ops::TTypes<float>::UnalignedConstMatrix> input_list_t;
-
-  input_list_t.reserve(max_time);
-  for (std::size_t t = 0; t < max_time; ++t) {
-    input_list_t.emplace_back(
-        GetTensorData<float>(inputs) + t * batch_size * num_classes, batch_size,
-        num_classes);
+  if (op_data->beam_search == nullptr ||
+      op_data->beam_search->num_classes() != num_classes) {
+    op_data->beam_search =
+        std::make_unique<::tflite::custom::ctc::CTCBeamSearchDecoder<>>(
+            num_classes, beam_width, &op_data->beam_scorer,
+            1 /* batch_size */, merge_repeated);
   }
-
-  ::tflite::custom::ctc::CTCBeamSearchDecoder<>::DefaultBeamScorer beam_scorer;
-  ::tflite::custom::ctc::CTCBeamSearchDecoder<> beam_search(
-      num_classes, beam_width, &beam_scorer, 1 /* batch_size */,
-      merge_repeated);
-
-  // Allocate temporary memory for holding chip operation data.
-  float* input_chip_t_data =
-      static_cast<float*>(malloc(num_classes * sizeof(float)));
-  Eigen::array<Eigen::DenseIndex, 1> dims;
-  dims[0] = num_classes;
-  optimized_ops::TTypes<float>::Flat input_chip_t(input_chip_t_data, dims);
+  ::tflite::custom::ctc::CTCBeamSearchDecoder<>& beam_search =
+      *op_data->beam_search;
+  beam_search.Reset();
 
   std::vector<std::vector<std::vector<int>>> best_paths(batch_size);
   std::vector<float> log_probs;
@@ -239,9 +237,10 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
     auto& best_paths_b = best_paths[b];
     best_paths_b.resize(top_paths);
     for (int t = 0; t < GetTensorData<int32_t>(sequence_length)[b]; ++t) {
-      input_chip_t = input_list_t[t].chip(b, 0);
-      auto input_bi =
-          Eigen::Map<const Eigen::ArrayXf>(input_chip_t.data(), num_classes);
+      // The logits of the batch at time t are contiguous.
+      auto input_bi = Eigen::Map<const Eigen::ArrayXf>(
+          GetTensorData<float>(inputs) + (t * batch_size + b) * num_classes,
+          num_classes);
       beam_search.Step(input_bi);
     }
     TF_LITE_ENSURE(context, beam_search.TopPaths(top_paths, &best_paths_b,
@@ -254,7 +253,6 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
     }
   }
 
-  free(input_chip_t_data);
   return StoreAllDecodedSequences(context, best_paths, node, top_paths);
 }
 
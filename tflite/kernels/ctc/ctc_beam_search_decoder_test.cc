@@ -226,6 +226,33 @@ TEST(CTCBeamSearchTest, NonEqualSequencesTest) {
               ElementsAreArray(ArrayFloatNear({-0.97322, -1.16334, -2.15553})));
 }
 
+TEST(CTCBeamSearchTest, ReusesDecoderAcrossInvocations) {
+  CTCBeamSearchDecoderOpModel m({3, 3, 4}, {3}, 3, 1, true);
+  m.PopulateTensor<float>(
+      m.inputs(),
+      {-1.26658163, -0.25760023, -0.03917975, -0.63772235, -0.03794756,
+       -0.45063099, -0.27706473, -0.01569179, -0.59940385, -0.35700127,
+       -0.48920721, -1.42635476, -1.3462478,  -0.02565498, -0.30179568,
+       -0.6491698,  -0.55017719, -2.92291466, -0.92522973, -0.47592022,
+       -0.07099135, -0.31575624, -0.86345281, -0.36017021, -0.79208612,
+       -1.75306124, -0.65089224, -0.00912786, -0.42915003, -1.72606203,
+       -1.66337589, -0.70800793, -2.52272352, -0.67329562, -2.49145522,
+       -0.49786342});
+  m.PopulateTensor<int>(m.sequence_length(), {3, 3, 3});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  // The beams of the previous invocation must not leak into the next one.
+  m.PopulateTensor<int>(m.sequence_length(), {1, 2, 3});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  const std::vector<std::vector<int>>& decoded_outputs = m.GetDecodedOutpus();
+  EXPECT_EQ(decoded_outputs.size(), 3);
+  EXPECT_THAT(decoded_outputs[0], ElementsAre(0, 0, 1, 0, 2, 0));
+  EXPECT_THAT(decoded_outputs[1], ElementsAre(2, 0, 1));
+  EXPECT_THAT(decoded_outputs[2], ElementsAre(3, 1));
+  EXPECT_THAT(m.GetLogProbabilitiesOutput(),
+              ElementsAreArray(ArrayFloatNear({-0.97322, -1.16334, -2.15553})));
+}
+
 }  // namespace
 }  // namespace custom
 }  // namespace ops
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/kernels/internal/optimized/optimized_ops.h"
 #include "tflite/kernels/internal/tensor.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
@@ -67,23 +68,26 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
     return kTfLiteError;
   }
 
+  CpuBackendContext* cpu_backend_context =
+      CpuBackendContext::GetFromContext(context);
   switch (input->type) {
     case kTfLiteInt32: {
       optimized_ops::CumSum(GetTensorData<int>(input), GetTensorShape(input),
                             axis, params->exclusive, params->reverse,
-                            GetTensorData<int>(output));
+                            GetTensorData<int>(output), cpu_backend_context);
       break;
     }
     case kTfLiteInt64: {
-      optimized_ops::CumSum(GetTensorData<int64_t>(input),
-                            GetTensorShape(input), axis, params->exclusive,
-                            params->reverse, GetTensorData<int64_t>(output));
+      optimized_ops::CumSum(
+          GetTensorData<int64_t>(input), GetTensorShape(input), axis,
+          params->exclusive, params->reverse, GetTensorData<int64_t>(output),
+          cpu_backend_context);
       break;
     }
     case kTfLiteFloat32: {
       optimized_ops::CumSum(GetTensorData<float>(input), GetTensorShape(input),
                             axis, params->exclusive, params->reverse,
-                            GetTensorData<float>(output));
+                            GetTensorData<float>(output), cpu_backend_context);
       break;
     }
     default: {
@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <cstdint>
 #include <vector>
 
 #include <gmock/gmock.h>
@@ -32,7 +33,7 @@ template <typename T>
 class CumsumOpModel : public SingleOpModel {
  public:
   CumsumOpModel(const TensorData& input, const TensorData& output,
-                bool exclusive, bool reverse) {
+                bool exclusive, bool reverse, int num_threads = -1) {
     input_ = AddInput(input);
     axis_ = AddInput({TensorType_INT32, {1}});
 
@@ -41,7 +42,9 @@ class CumsumOpModel : public SingleOpModel {
     SetBuiltinOp(BuiltinOperator_CUMSUM, BuiltinOptions_CumsumOptions,
                  CreateCumsumOptions(builder_, exclusive, reverse).Union());
 
-    BuildInterpreter({GetShape(input_), GetShape(axis_)});
+    BuildInterpreter({GetShape(input_), GetShape(axis_)}, num_threads,
+                     /*allow_fp32_relax_to_fp16=*/false,
+                     /*apply_delegate=*/true);
   }
 
   int input() { return input_; }
@@ -150,6 +153,69 @@ TEST(CumsumOpTest, SimpleFloatTest) {
                                  ArrayFloatNear({1, 3, 6, 10, 5, 11, 18, 26})));
 }
 
+TEST(CumsumOpTest, LargeIntTestOnThreads) {
+  constexpr int kSize = 100000;
+  for (const bool exclusive : {false, true}) {
+    for (const bool reverse : {false, true}) {
+      CumsumOpModel<int32_t> m({TensorType_INT32, {1, kSize}},
+                               {TensorType_INT32, {}}, exclusive, reverse,
+                               /*num_threads=*/4);
+      std::vector<int32_t> input(kSize);
+      for (int i = 0; i < kSize; ++i) {
+        input[i] = i % 7 - 3;
+      }
+      m.PopulateTensor<int32_t>(m.input(), input);
+      m.PopulateTensor<int>(m.axis(), {1});
+
+      ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+      std::vector<int32_t> expected(kSize);
+      int32_t sum = 0;
+      for (int j = 0; j < kSize; ++j) {
+        const int i = reverse ? kSize - 1 - j : j;
+        if (exclusive) {
+          expected[i] = sum;
+          sum += input[i];
+        } else {
+          sum += input[i];
+          expected[i] = sum;
+        }
+      }
+      EXPECT_EQ(m.GetOutput(), expected);
+    }
+  }
+}
+
+TEST(CumsumOpTest, LargeIntAxis1TestOnThreads) {
+  constexpr int kOuter = 64;
+  constexpr int kAxis = 512;
+  constexpr int kInner = 3;
+  CumsumOpModel<int32_t> m({TensorType_INT32, {kOuter, kAxis, kInner}},
+                           {TensorType_INT32, {}}, false, false,
+                           /*num_threads=*/4);
+  std::vector<int32_t> input(kOuter * kAxis * kInner);
+  for (int i = 0; i < kOuter * kAxis * kInner; ++i) {
+    input[i] = i % 5;
+  }
+  m.PopulateTensor<int32_t>(m.input(), input);
+  m.PopulateTensor<int>(m.axis(), {1});
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  std::vector<int32_t> expected(input.size());
+  for (int o = 0; o < kOuter; ++o) {
+    for (int k = 0; k < kInner; ++k) {
+      int32_t sum = 0;
+      for (int a = 0; a < kAxis; ++a) {
+        const int i = (o * kAxis + a) * kInner + k;
+        sum += input[i];
+        expected[i] = sum;
+      }
+    }
+  }
+  EXPECT_EQ(m.GetOutput(), expected);
+}
+
 }  // namespace
 }  // namespace builtin
 }  // namespace ops
@@ -116,11 +116,7 @@ TfLiteRegistration* Register_DEQUANTIZE_REF() {
 }
 
 TfLiteRegistration* Register_DEQUANTIZE() {
-#ifdef USE_NEON
   return Register_DEQUANTIZE_OPT();
-#else
-  return Register_DEQUANTIZE_REF();
-#endif
 }
 
 }  // namespace builtin
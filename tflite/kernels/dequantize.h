@@ -21,6 +21,7 @@ limitations under the License.
 
 #include "Eigen/Core"  // from @eigen_archive
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/kernels/internal/optimized/optimized_ops.h"
 #include "tflite/kernels/internal/portable_tensor_utils.h"
 #include "tflite/kernels/internal/reference/dequantize.h"
@@ -51,10 +52,10 @@ inline bool IsQuantizedPerChannel(const TfLiteTensor* input) {
   return false;
 }
 
-inline TfLiteStatus PerChannelDequantizeImpl(TfLiteContext* context,
-                                             TfLiteNode* node,
-                                             const TfLiteTensor* input,
-                                             TfLiteTensor* output) {
+template <KernelType kernel_type>
+TfLiteStatus PerChannelDequantizeImpl(TfLiteContext* context, TfLiteNode* node,
+                                      const TfLiteTensor* input,
+                                      TfLiteTensor* output) {
   const auto* quantization_params =
       reinterpret_cast<const TfLiteAffineQuantization*>(
           input->quantization.params);
@@ -96,17 +97,32 @@ inline TfLiteStatus PerChannelDequantizeImpl(TfLiteContext* context,
 
   switch (input->type) {
     case kTfLiteUInt8:
-      reference_ops::PerChannelDequantize<uint8_t>(
-          per_channel_op_params, GetTensorShape(input),
-          GetTensorData<uint8_t>(input), GetTensorShape(output),
-          GetTensorData<float>(output));
+      if (kernel_type == kReference) {
+        reference_ops::PerChannelDequantize<uint8_t>(
+            per_channel_op_params, GetTensorShape(input),
+            GetTensorData<uint8_t>(input), GetTensorShape(output),
+            GetTensorData<float>(output));
+      } else {
+        optimized_ops::PerChannelDequantize<uint8_t>(
+            per_channel_op_params, GetTensorShape(input),
+            GetTensorData<uint8_t>(input), GetTensorShape(output),
+            GetTensorData<float>(output),
+            CpuBackendContext::GetFromContext(context));
+      }
       break;
     case kTfLiteInt2:
     case kTfLiteInt4:
     case kTfLiteInt8:
-      reference_ops::PerChannelDequantize<int8_t>(
-          per_channel_op_params, GetTensorShape(input), input_data,
-          GetTensorShape(output), GetTensorData<float>(output));
+      if (kernel_type == kReference) {
+        reference_ops::PerChannelDequantize<int8_t>(
+            per_channel_op_params, GetTensorShape(input), input_data,
+            GetTensorShape(output), GetTensorData<float>(output));
+      } else {
+        optimized_ops::PerChannelDequantize<int8_t>(
+            per_channel_op_params, GetTensorShape(input), input_data,
+            GetTensorShape(output), GetTensorData<float>(output),
+            CpuBackendContext::GetFromContext(context));
+      }
       break;
     default:
       TF_LITE_KERNEL_LOG(context, "Type %d not supported for per-channel.",
@@ -120,11 +136,14 @@ template <KernelType kernel_type>
 TfLiteStatus DequantizeImpl(TfLiteContext* context, TfLiteNode* node,
                             const TfLiteTensor* input, TfLiteTensor* output) {
   if (IsQuantizedPerChannel(input)) {
-    return PerChannelDequantizeImpl(context, node, input, output);
+    return PerChannelDequantizeImpl<kernel_type>(context, node, input, output);
   }
   DequantizationParams op_params;
   op_params.zero_point = input->params.zero_point;
   op_params.scale = input->params.scale;
+  CpuBackendContext* cpu_backend_context =
+      kernel_type == kReference ? nullptr
+                                : CpuBackendContext::GetFromContext(context);
   const int8_t* input_data;
   size_t bytes_unpacked;
   if (input->type == kTfLiteInt2) {
@@ -159,7 +178,8 @@ TfLiteStatus DequantizeImpl(TfLiteContext* context, TfLiteNode* node,
       } else {
         optimized_ops::Dequantize(
             op_params, GetTensorShape(input), GetTensorData<uint8_t>(input),
-            GetTensorShape(output), GetTensorData<float>(output));
+            GetTensorShape(output), GetTensorData<float>(output),
+            cpu_backend_context);
       }
       break;
     case kTfLiteInt2:
@@ -172,7 +192,8 @@ TfLiteStatus DequantizeImpl(TfLiteContext* context, TfLiteNode* node,
       } else {
         optimized_ops::Dequantize(op_params, GetTensorShape(input), input_data,
                                   GetTensorShape(output),
-                                  GetTensorData<float>(output));
+                                  GetTensorData<float>(output),
+                                  cpu_backend_context);
       }
       break;
     case kTfLiteInt16:
@@ -183,15 +204,23 @@ TfLiteStatus DequantizeImpl(TfLiteContext* context, TfLiteNode* node,
       } else {
         optimized_ops::Dequantize(
             op_params, GetTensorShape(input), GetTensorData<int16_t>(input),
-            GetTensorShape(output), GetTensorData<float>(output));
+            GetTensorShape(output), GetTensorData<float>(output),
+            cpu_backend_context);
       }
       break;
     case kTfLiteFloat16: {
       const Eigen::half* half_data = reinterpret_cast<const Eigen::half*>(
           GetTensorData<TfLiteFloat16>(input));
-      reference_ops::Dequantize(GetTensorShape(input), half_data,
-                                GetTensorShape(output),
-                                GetTensorData<float>(output));
+      if (kernel_type == kReference) {
+        reference_ops::Dequantize(GetTensorShape(input), half_data,
+                                  GetTensorShape(output),
+                                  GetTensorData<float>(output));
+      } else {
+        optimized_ops::Dequantize(GetTensorShape(input), half_data,
+                                  GetTensorShape(output),
+                                  GetTensorData<float>(output),
+                                  cpu_backend_context);
+      }
       break;
     }
     default:
@@ -377,6 +377,8 @@ void SelectDetectionsAboveScoreThreshold(const std::vector<float>& values,
                                          const float threshold,
                                          std::vector<float>* keep_values,
                                          std::vector<int>* keep_indices) {
+  keep_values->reserve(values.size());
+  keep_indices->reserve(values.size());
   for (int i = 0; i < values.size(); i++) {
     if (values[i] >= threshold) {
       keep_values->emplace_back(values[i]);
@@ -388,7 +390,7 @@ void SelectDetectionsAboveScoreThreshold(const std::vector<float>& values,
 bool ValidateBoxes(const TfLiteTensor* decoded_boxes, const int num_boxes) {
   for (int i = 0; i < num_boxes; ++i) {
     auto& box = ReInterpretTensor<const BoxCornerEncoding*>(decoded_boxes)[i];
-    // Note: `ComputeIntersectionOverUnion` properly handles degenerated boxes
+    // Note: `SuppressOverlappingBoxes` properly handles degenerated boxes
     // (xmin == xmax and/or ymin == ymax) as it just returns 0 in case the box
     // area is <= 0.
     if (box.ymin > box.ymax || box.xmin > box.xmax) {
@@ -398,21 +400,59 @@ bool ValidateBoxes(const TfLiteTensor* decoded_boxes, const int num_boxes) {
   return true;
 }
 
-float ComputeIntersectionOverUnion(const TfLiteTensor* decoded_boxes,
-                                   const int i, const int j) {
-  auto& box_i = ReInterpretTensor<const BoxCornerEncoding*>(decoded_boxes)[i];
-  auto& box_j = ReInterpretTensor<const BoxCornerEncoding*>(decoded_boxes)[j];
-  const float area_i = (box_i.ymax - box_i.ymin) * (box_i.xmax - box_i.xmin);
-  const float area_j = (box_j.ymax - box_j.ymin) * (box_j.xmax - box_j.xmin);
-  if (area_i <= 0 || area_j <= 0) return 0.0;
-  const float intersection_ymin = std::max<float>(box_i.ymin, box_j.ymin);
-  const float intersection_xmin = std::max<float>(box_i.xmin, box_j.xmin);
-  const float intersection_ymax = std::min<float>(box_i.ymax, box_j.ymax);
-  const float intersection_xmax = std::min<float>(box_i.xmax, box_j.xmax);
-  const float intersection_area =
-      std::max<float>(intersection_ymax - intersection_ymin, 0.0) *
-      std::max<float>(intersection_xmax - intersection_xmin, 0.0);
-  return intersection_area / (area_i + area_j - intersection_area);
+// The boxes kept by NonMaxSuppressionSingleClassHelper(), in decreasing score
+// order, with one array per coordinate for the loop of
+// SuppressOverlappingBoxes() to be vectorized.
+struct SortedBoxes {
+  explicit SortedBoxes(int num_boxes)
+      : ymin(num_boxes),
+        xmin(num_boxes),
+        ymax(num_boxes),
+        xmax(num_boxes),
+        area(num_boxes) {}
+
+  std::vector<float> ymin;
+  std::vector<float> xmin;
+  std::vector<float> ymax;
+  std::vector<float> xmax;
+  std::vector<float> area;
+};
+
+// Deactivates the boxes after `i` whose intersection over union with box `i`
+// is above `threshold`, and returns how many were deactivated.
+// Box `i` must have a positive area.
+int SuppressOverlappingBoxes(const SortedBoxes& boxes, const int i,
+                             const int num_boxes, const float threshold,
+                             uint8_t* active) {
+  const float* ymin = boxes.ymin.data();
+  const float* xmin = boxes.xmin.data();
+  const float* ymax = boxes.ymax.data();
+  const float* xmax = boxes.xmax.data();
+  const float* area = boxes.area.data();
+  const float ymin_i = ymin[i];
+  const float xmin_i = xmin[i];
+  const float ymax_i = ymax[i];
+  const float xmax_i = xmax[i];
+  const float area_i = area[i];
+  int num_suppressed = 0;
+  // Computes the IoU of the inactive boxes too, to avoid branches.
+  for (int j = i + 1; j < num_boxes; ++j) {
+    const float intersection_area =
+        std::max<float>(std::min<float>(ymax_i, ymax[j]) -
+                            std::max<float>(ymin_i, ymin[j]),
+                        0.0) *
+        std::max<float>(std::min<float>(xmax_i, xmax[j]) -
+                            std::max<float>(xmin_i, xmin[j]),
+                        0.0);
+    const float intersection_over_union =
+        intersection_area / (area_i + area[j] - intersection_area);
+    const uint8_t suppress =
+        active[j] & static_cast<uint8_t>((area[j] > 0) &
+                                         (intersection_over_union > threshold));
+    active[j] -= suppress;
+    num_suppressed += suppress;
+  }
+  return num_suppressed;
 }
 
 // NonMaxSuppressionSingleClass() prunes out the box locations with high overlap
@@ -421,17 +461,13 @@ float ComputeIntersectionOverUnion(const TfLiteTensor* decoded_boxes,
 // If lower-scoring box has too much overlap with a higher-scoring box,
 // we get rid of the lower-scoring box.
 // Complexity is O(N^2) pairwise comparison between boxes
+// The boxes must have been checked by ValidateBoxes().
 TfLiteStatus NonMaxSuppressionSingleClassHelper(
     TfLiteContext* context, TfLiteNode* node, OpData* op_data,
     const std::vector<float>& scores, int max_detections,
     std::vector<int>* selected) {
-  const TfLiteTensor* input_box_encodings;
-  TF_LITE_ENSURE_OK(context,
-                    GetInputSafe(context, node, kInputTensorBoxEncodings,
-                                 &input_box_encodings));
   const TfLiteTensor* decoded_boxes =
       &context->tensors[op_data->decoded_boxes_index];
-  const int num_boxes = input_box_encodings->dims->data[1];
   const float non_max_suppression_score_threshold =
       op_data->non_max_suppression_score_threshold;
   const float intersection_over_union_threshold =
@@ -442,9 +478,6 @@ TfLiteStatus NonMaxSuppressionSingleClassHelper(
   // and should be less than 1.
   TF_LITE_ENSURE(context, (intersection_over_union_threshold > 0.0f) &&
                               (intersection_over_union_threshold <= 1.0f));
-  // Validate boxes
-  TF_LITE_ENSURE_EQ(context, decoded_boxes->type, kTfLiteFloat32);
-  TF_LITE_ENSURE(context, ValidateBoxes(decoded_boxes, num_boxes));
 
   // threshold scores
   std::vector<int> keep_indices;
@@ -462,9 +495,26 @@ TfLiteStatus NonMaxSuppressionSingleClassHelper(
   const int num_boxes_kept = num_scores_kept;
   const int output_size = std::min(num_boxes_kept, max_detections);
   selected->clear();
+  if (output_size == 0) {
+    return kTfLiteOk;
+  }
   int num_active_candidate = num_boxes_kept;
   std::vector<uint8_t> active_box_candidate(num_boxes_kept, 1);
 
+  // Gathers the kept boxes in score order, so that the boxes compared with a
+  // selected one are read sequentially.
+  SortedBoxes sorted_boxes(num_boxes_kept);
+  const BoxCornerEncoding* boxes =
+      ReInterpretTensor<const BoxCornerEncoding*>(decoded_boxes);
+  for (int i = 0; i < num_boxes_kept; ++i) {
+    const BoxCornerEncoding& box = boxes[keep_indices[sorted_indices[i]]];
+    sorted_boxes.ymin[i] = box.ymin;
+    sorted_boxes.xmin[i] = box.xmin;
+    sorted_boxes.ymax[i] = box.ymax;
+    sorted_boxes.xmax[i] = box.xmax;
+    sorted_boxes.area[i] = (box.ymax - box.ymin) * (box.xmax - box.xmin);
+  }
+
   for (int i = 0; i < num_boxes_kept; ++i) {
     if (num_active_candidate == 0 || selected->size() >= output_size) break;
     if (active_box_candidate[i] == 1) {
@@ -474,19 +524,13 @@ TfLiteStatus NonMaxSuppressionSingleClassHelper(
     } else {
       continue;
     }
-    for (int j = i + 1; j < num_boxes_kept; ++j) {
-      if (active_box_candidate[j] == 1) {
-        TF_LITE_ENSURE_EQ(context, decoded_boxes->type, kTfLiteFloat32);
-        float intersection_over_union = ComputeIntersectionOverUnion(
-            decoded_boxes, keep_indices[sorted_indices[i]],
-            keep_indices[sorted_indices[j]]);
-
-        if (intersection_over_union > intersection_over_union_threshold) {
-          active_box_candidate[j] = 0;
-          num_active_candidate--;
-        }
-      }
+    // A degenerate box overlaps no other box.
+    if (sorted_boxes.area[i] <= 0) {
+      continue;
     }
+    num_active_candidate -= SuppressOverlappingBoxes(
+        sorted_boxes, i, num_boxes_kept, intersection_over_union_threshold,
+        active_box_candidate.data());
   }
   return kTfLiteOk;
 }
@@ -879,6 +923,13 @@ TfLiteStatus NonMaxSuppressionMultiClass(TfLiteContext* context,
       // Unsupported type.
       return kTfLiteError;
   }
+
+  // Validate boxes once for all the classes.
+  const TfLiteTensor* decoded_boxes =
+      &context->tensors[op_data->decoded_boxes_index];
+  TF_LITE_ENSURE_EQ(context, decoded_boxes->type, kTfLiteFloat32);
+  TF_LITE_ENSURE(context, ValidateBoxes(decoded_boxes, num_boxes));
+
   if (op_data->use_regular_non_max_suppression)
     TF_LITE_ENSURE_STATUS(NonMaxSuppressionMultiClassRegularHelper(
         context, node, op_data, GetTensorData<float>(scores)));
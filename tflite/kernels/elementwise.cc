@@ -517,25 +517,54 @@ GENERIC_PREPARE(PrepareAbs, elementwise::IsAbsSupportedType,
                 elementwise::kAbsName)
 
 TfLiteRegistration* Register_ABS() {
-  static TfLiteRegistration r = {elementwise::ElementWiseQuantizedInit,
-                                 elementwise::ElementWiseQuantizedFree,
-                                 PrepareAbs, elementwise::AbsEval};
+  static TfLiteRegistration r = {
+      elementwise::ElementWiseQuantizedInit,
+      elementwise::ElementWiseQuantizedFree,
+      PrepareAbs,
+      elementwise::AbsEval,
+      /*profiling_string=*/nullptr,
+      /*builtin_code=*/0,
+      /*custom_name=*/nullptr,
+      /*version=*/0,
+      /*registration_external=*/nullptr,
+      /*async_kernel=*/nullptr,
+      kTfLiteInplaceOpInput0Shared};
   return &r;
 }
 
 GENERIC_PREPARE(PrepareSin, elementwise::IsNumericSupportedType, "Sin")
 
 TfLiteRegistration* Register_SIN() {
-  static TfLiteRegistration r = {/*init=*/nullptr, /*free=*/nullptr, PrepareSin,
-                                 elementwise::SinEval};
+  static TfLiteRegistration r = {
+      /*init=*/nullptr,
+      /*free=*/nullptr,
+      PrepareSin,
+      elementwise::SinEval,
+      /*profiling_string=*/nullptr,
+      /*builtin_code=*/0,
+      /*custom_name=*/nullptr,
+      /*version=*/0,
+      /*registration_external=*/nullptr,
+      /*async_kernel=*/nullptr,
+      kTfLiteInplaceOpInput0Shared};
   return &r;
 }
 
 GENERIC_PREPARE(PrepareCos, elementwise::IsNumericSupportedType, "Cos")
 
 TfLiteRegistration* Register_COS() {
-  static TfLiteRegistration r = {/*init=*/nullptr, /*free=*/nullptr, PrepareCos,
-                                 elementwise::CosEval};
+  static TfLiteRegistration r = {
+      /*init=*/nullptr,
+      /*free=*/nullptr,
+      PrepareCos,
+      elementwise::CosEval,
+      /*profiling_string=*/nullptr,
+      /*builtin_code=*/0,
+      /*custom_name=*/nullptr,
+      /*version=*/0,
+      /*registration_external=*/nullptr,
+      /*async_kernel=*/nullptr,
+      kTfLiteInplaceOpInput0Shared};
   return &r;
 }
 
@@ -543,18 +572,36 @@ GENERIC_PREPARE(PrepareLog, elementwise::IsLogSupportedType,
                 elementwise::kLogName)
 
 TfLiteRegistration* Register_LOG() {
-  static TfLiteRegistration r = {elementwise::ElementWiseQuantizedInit,
-                                 elementwise::ElementWiseQuantizedFree,
-                                 PrepareLog, elementwise::LogEval};
+  static TfLiteRegistration r = {
+      elementwise::ElementWiseQuantizedInit,
+      elementwise::ElementWiseQuantizedFree,
+      PrepareLog,
+      elementwise::LogEval,
+      /*profiling_string=*/nullptr,
+      /*builtin_code=*/0,
+      /*custom_name=*/nullptr,
+      /*version=*/0,
+      /*registration_external=*/nullptr,
+      /*async_kernel=*/nullptr,
+      kTfLiteInplaceOpInput0Shared};
   return &r;
 }
 
 GENERIC_PREPARE(PrepareSqrt, elementwise::IsSqrtSupportedType, "Sqrt")
 
 TfLiteRegistration* Register_SQRT() {
-  static TfLiteRegistration r = {elementwise::ElementWiseQuantizedInit,
-                                 elementwise::ElementWiseQuantizedFree,
-                                 PrepareSqrt, elementwise::SqrtEval};
+  static TfLiteRegistration r = {
+      elementwise::ElementWiseQuantizedInit,
+      elementwise::ElementWiseQuantizedFree,
+      PrepareSqrt,
+      elementwise::SqrtEval,
+      /*profiling_string=*/nullptr,
+      /*builtin_code=*/0,
+      /*custom_name=*/nullptr,
+      /*version=*/0,
+      /*registration_external=*/nullptr,
+      /*async_kernel=*/nullptr,
+      kTfLiteInplaceOpInput0Shared};
   return &r;
 }
 
@@ -562,25 +609,54 @@ GENERIC_PREPARE(PrepareRsqrt, elementwise::IsRsqrtSupportedType,
                 elementwise::kRsqrtName)
 
 TfLiteRegistration* Register_RSQRT() {
-  static TfLiteRegistration r = {elementwise::ElementWiseQuantizedInit,
-                                 elementwise::ElementWiseQuantizedFree,
-                                 PrepareRsqrt, elementwise::RsqrtEval};
+  static TfLiteRegistration r = {
+      elementwise::ElementWiseQuantizedInit,
+      elementwise::ElementWiseQuantizedFree,
+      PrepareRsqrt,
+      elementwise::RsqrtEval,
+      /*profiling_string=*/nullptr,
+      /*builtin_code=*/0,
+      /*custom_name=*/nullptr,
+      /*version=*/0,
+      /*registration_external=*/nullptr,
+      /*async_kernel=*/nullptr,
+      kTfLiteInplaceOpInput0Shared};
   return &r;
 }
 
 GENERIC_PREPARE(PrepareSquare, elementwise::IsNumericSupportedType, "Square")
 
 TfLiteRegistration* Register_SQUARE() {
-  static TfLiteRegistration r = {/*init=*/nullptr, /*free=*/nullptr,
-                                 PrepareSquare, elementwise::SquareEval};
+  static TfLiteRegistration r = {
+      /*init=*/nullptr,
+      /*free=*/nullptr,
+      PrepareSquare,
+      elementwise::SquareEval,
+      /*profiling_string=*/nullptr,
+      /*builtin_code=*/0,
+      /*custom_name=*/nullptr,
+      /*version=*/0,
+      /*registration_external=*/nullptr,
+      /*async_kernel=*/nullptr,
+      kTfLiteInplaceOpInput0Shared};
   return &r;
 }
 
 GENERIC_PREPARE(PrepareNot, elementwise::IsLogicalSupportedType, "Not")
 
 TfLiteRegistration* Register_LOGICAL_NOT() {
-  static TfLiteRegistration r = {/*init=*/nullptr, /*free=*/nullptr, PrepareNot,
-                                 elementwise::LogicalNotEval};
+  static TfLiteRegistration r = {
+      /*init=*/nullptr,
+      /*free=*/nullptr,
+      PrepareNot,
+      elementwise::LogicalNotEval,
+      /*profiling_string=*/nullptr,
+      /*builtin_code=*/0,
+      /*custom_name=*/nullptr,
+      /*version=*/0,
+      /*registration_external=*/nullptr,
+      /*async_kernel=*/nullptr,
+      kTfLiteInplaceOpInput0Shared};
   return &r;
 }
 
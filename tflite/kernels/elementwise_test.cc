@@ -244,6 +244,36 @@ TEST(ElementWise, Abs) {
                                            }));
 }
 
+TEST(ElementWise, AbsInplace) {
+  ElementWiseOpFloatModel m(BuiltinOperator_ABS, {1, 2, 4, 1});
+  m.PopulateTensor<float>(m.input(), {
+                                         0.f, -6.2f, 2.f, 4.f,  //
+                                         3.f, -2.f, 10.f, 1.f,  //
+                                     });
+  const TfLiteTensor* input_tensor = m.GetInputTensor(0);
+  TfLiteTensor* output_tensor = m.GetOutputTensor(0);
+  output_tensor->data.data = input_tensor->data.data;
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.ExtractVector<float>(m.output()),
+              Pointwise(FloatingPointEq(), {
+                                               0.f, 6.2f, 2.f, 4.f,  //
+                                               3.f, 2.f, 10.f, 1.f,  //
+                                           }));
+  EXPECT_EQ(output_tensor->data.data, input_tensor->data.data);
+}
+
+TEST(ElementWise, SqrtInplace) {
+  ElementWiseOpFloatModel m(BuiltinOperator_SQRT, {1, 1, 4, 1});
+  m.PopulateTensor<float>(m.input(), {0, 1, 2, 4});
+  const TfLiteTensor* input_tensor = m.GetInputTensor(0);
+  TfLiteTensor* output_tensor = m.GetOutputTensor(0);
+  output_tensor->data.data = input_tensor->data.data;
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.ExtractVector<float>(m.output()),
+              ElementsAreArray(ArrayFloatNear({0, 1, 1.41421, 2})));
+  EXPECT_EQ(output_tensor->data.data, input_tensor->data.data);
+}
+
 TEST(ElementWise, AbsInt32) {
   ElementWiseOpIntModel m(BuiltinOperator_ABS, {1, 2, 4, 1});
   m.PopulateTensor<int32_t>(m.input(), {
@@ -25,17 +25,23 @@ limitations under the License.
 //   Output.dim[0] == Tensor[0].dim[0], num of lookups
 //   Output.dim[1] == Tensor[1].dim[1],  num of items per row
 //   Each item in output is a raw bytes copy of the corresponding item in input,
-//   or a dequantized value in the case of a uint8 input.
+//   or a dequantized value in the case of a uint8 input. Int4 and per-axis
+//   quantized int8 inputs may also be requantized to an int8 output.
 //   When indices are out of bound, the ops will not succeed.
 //
 
+#include <algorithm>
 #include <cinttypes>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 
 #include "fp16/fp16.h"  // from @FP16
 #include "tflite/c/c_api_types.h"
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/internal/optimized/gather.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/kernel_util.h"
 
@@ -44,6 +50,77 @@ namespace ops {
 namespace builtin {
 namespace embedding_lookup {
 
+// Returns the scale of the `row`th row of a quantized `value`.
+float RowScale(const TfLiteTensor* value, int row) {
+  if (value->quantization.type == kTfLiteAffineQuantization) {
+    const auto qparams = static_cast<const TfLiteAffineQuantization*>(
+        value->quantization.params);
+    if (qparams->scale->size > 1) {
+      // get this row's scale for per-axis quantization
+      return qparams->scale->data[row];
+    }
+  }
+  return value->params.scale;
+}
+
+// Returns whether the rows of `value` are requantized to the scale of an int8
+// `output`. Only the int4 and per-axis quantized int8 inputs are, the other
+// int8 inputs being copied as is.
+bool IsRequantized(const TfLiteTensor* value, const TfLiteTensor* output) {
+  if (output->type != kTfLiteInt8) {
+    return false;
+  }
+  if (value->type == kTfLiteInt4) {
+    return true;
+  }
+  if (value->type != kTfLiteInt8 ||
+      value->quantization.type != kTfLiteAffineQuantization) {
+    return false;
+  }
+  const auto qparams = static_cast<const TfLiteAffineQuantization*>(
+      value->quantization.params);
+  return qparams->scale != nullptr && qparams->scale->size > 1;
+}
+
+// Checks all the lookups first, for the rows to be gathered without failing.
+TfLiteStatus CheckLookups(TfLiteContext* context, const TfLiteTensor* lookup,
+                          int row_size) {
+  const int32_t* lookup_data = GetTensorData<int32_t>(lookup);
+  for (int i = 0; i < SizeOfDimension(lookup, 0); i++) {
+    const int32_t idx = lookup_data[i];
+    if (idx >= row_size || idx < 0) {
+      TF_LITE_KERNEL_LOG(context,
+                         "Embedding Lookup: index out of bounds. "
+                         "Got %" PRId32 ", and bounds are [0, %d]",
+                         idx, row_size - 1);
+      return kTfLiteError;
+    }
+  }
+  return kTfLiteOk;
+}
+
+// Calls `row_fn(i)` for each lookup, from the threads of the context when
+// there are enough rows.
+template <typename RowFn>
+void ForEachLookup(TfLiteContext* context, const TfLiteTensor* lookup,
+                   size_t row_bytes, const RowFn& row_fn) {
+  optimized_ops::gather_internal::ForEachRow(
+      SizeOfDimension(lookup, 0), row_bytes,
+      CpuBackendContext::GetFromContext(context), row_fn);
+}
+
+// Prefetches the row of the lookup coming `kPrefetchDistance` after the `i`th.
+void PrefetchLookup(const TfLiteTensor* lookup, int i, const char* value_raw,
+                    size_t row_bytes) {
+  constexpr int kPrefetchDistance =
+      optimized_ops::gather_internal::kPrefetchDistance;
+  if (i + kPrefetchDistance < SizeOfDimension(lookup, 0)) {
+    const int32_t idx = GetTensorData<int32_t>(lookup)[i + kPrefetchDistance];
+    optimized_ops::gather_internal::PrefetchRow(value_raw + idx * row_bytes,
+                                                row_bytes);
+  }
+}
+
 TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   TF_LITE_ENSURE_EQ(context, NumInputs(node), 2);
   TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
@@ -70,12 +147,19 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
       // EvalHybrid supports only symmetric quantization for now.
       TF_LITE_ENSURE(context, qparams->zero_point->data[0] == 0);
     }
+    if (IsRequantized(value, output)) {
+      // EvalRequantize supports only symmetric inputs, and per-tensor outputs.
+      TF_LITE_ENSURE(context, qparams->zero_point->data[0] == 0);
+      TF_LITE_ENSURE(context, output->params.scale > 0.0f);
+    }
     if (qparams->scale->size > 1) {
-      // Per-axis quantization is supported by EvalHybrid only.
+      // Per-axis quantization is supported by EvalHybrid and EvalRequantize
+      // only.
       TF_LITE_ENSURE(context, value->type == kTfLiteUInt8 ||
                                   value->type == kTfLiteInt8 ||
                                   value->type == kTfLiteInt4);
-      TF_LITE_ENSURE(context, output->type == kTfLiteFloat32);
+      TF_LITE_ENSURE(context, output->type == kTfLiteFloat32 ||
+                                  IsRequantized(value, output));
       // Per-axis quantization must have quantized_dimension == 0 and correct
       // sizes for scale and zero_point.
       TF_LITE_ENSURE(context, qparams->quantized_dimension == 0);
@@ -108,35 +192,43 @@ TfLiteStatus EvalSimple(TfLiteContext* context, TfLiteNode* node,
   }
   const size_t row_bytes = value->bytes / row_size;
 
+  TF_LITE_ENSURE_OK(context, CheckLookups(context, lookup, row_size));
+
   char* output_raw = GetTensorData<char>(output);
   const char* value_raw = GetTensorData<char>(value);
   const int32_t* lookup_data = GetTensorData<int32_t>(lookup);
-  for (int i = 0; i < SizeOfDimension(lookup, 0); i++) {
-    const int32_t idx = lookup_data[i];
-    if (idx >= row_size || idx < 0) {
-      TF_LITE_KERNEL_LOG(context,
-                         "Embedding Lookup: index out of bounds. "
-                         "Got %" PRId32 ", and bounds are [0, %d]",
-                         idx, row_size - 1);
-      return kTfLiteError;
-    } else {
-      std::memcpy(output_raw + i * row_bytes, value_raw + idx * row_bytes,
-                  row_bytes);
-    }
-  }
-
+  ForEachLookup(context, lookup, row_bytes, [&](int i) {
+    PrefetchLookup(lookup, i, value_raw, row_bytes);
+    std::memcpy(output_raw + i * row_bytes,
+                value_raw + lookup_data[i] * row_bytes, row_bytes);
+  });
   return kTfLiteOk;
 }
 
-void Unpack4Bit(double scaling_factor, int col_size, const int8_t* value_ptr,
-                float* output_ptr) {
+// Dequantizes `col_size` int8 values.
+void Dequantize8Bit(float scaling_factor, int col_size,
+                    const int8_t* value_ptr, float* output_ptr) {
   for (int j = 0; j < col_size; j++) {
-    int i8_idx = j;
-    int i4_idx = i8_idx / 2;
-    bool even = i8_idx % 2 == 0;
-    int8_t i4_val = value_ptr[i4_idx];
-    int8_t i8_val = even ? static_cast<int8_t>(i4_val << 4) >> 4 : i4_val >> 4;
-    output_ptr[j] = i8_val * scaling_factor;
+    output_ptr[j] = value_ptr[j] * scaling_factor;
+  }
+}
+
+// Dequantizes `col_size` int4 values, packed two per byte with the first one
+// in the low nibble.
+void Unpack4Bit(float scaling_factor, int col_size, const int8_t* value_ptr,
+                float* output_ptr) {
+  // Each byte is unpacked at once, for the loop to be vectorized.
+  const int num_pairs = col_size / 2;
+  for (int j = 0; j < num_pairs; j++) {
+    const int8_t i4_val = value_ptr[j];
+    output_ptr[2 * j] =
+        (static_cast<int8_t>(i4_val << 4) >> 4) * scaling_factor;
+    output_ptr[2 * j + 1] = (i4_val >> 4) * scaling_factor;
+  }
+  if (col_size % 2 != 0) {
+    const int8_t i4_val = value_ptr[num_pairs];
+    output_ptr[col_size - 1] =
+        (static_cast<int8_t>(i4_val << 4) >> 4) * scaling_factor;
   }
 }
 
@@ -172,7 +264,6 @@ TfLiteStatus EvalBlockwise(TfLiteContext* context, TfLiteNode* node,
           value->quantization.params);
   const TfLiteTensor& scale = context->tensors[quantization_params->scale];
   const int blocksize = quantization_params->blocksize;
-  const int dimension_size = SizeOfDimension(lookup, 0);
   if (col_size % blocksize != 0) {
     TF_LITE_KERNEL_LOG(context,
                        "Embedding Lookup: lookup dimension %d must be "
@@ -181,26 +272,18 @@ TfLiteStatus EvalBlockwise(TfLiteContext* context, TfLiteNode* node,
     return kTfLiteError;
   }
   int num_blocks = col_size / blocksize;
-  for (int i = 0; i < dimension_size; i++) {
-    int idx = lookup_data[i];
-    if (idx >= row_size || idx < 0) {
-      TF_LITE_KERNEL_LOG(context,
-                         "Embedding Lookup: index out of bounds. "
-                         "Got %d, and bounds are [0, %d]",
-                         idx, row_size - 1);
-      return kTfLiteError;
-    }
+  TF_LITE_ENSURE_OK(context, CheckLookups(context, lookup, row_size));
+  const uint16_t* scale_data = GetTensorData<uint16_t>(&scale);
+  ForEachLookup(context, lookup, col_size * sizeof(float), [&](int i) {
+    const int idx = lookup_data[i];
     for (int j = 0; j < num_blocks; ++j) {
-      uint16_t raw_scaling_factor =
-          GetTensorData<uint16_t>(&scale)[j + idx * num_blocks];
-      uint32_t fp32_scaling_factor = fp16_ieee_to_fp32_bits(raw_scaling_factor);
-      double scaling_factor = *reinterpret_cast<float*>(&fp32_scaling_factor);
-
+      const float scaling_factor =
+          fp16_ieee_to_fp32_value(scale_data[j + idx * num_blocks]);
       Unpack4Bit(scaling_factor, blocksize,
                  &value_ptr[(j * blocksize + idx * col_size) / 2],
                  &output_ptr[j * blocksize + i * col_size]);
     }
-  }
+  });
   return kTfLiteOk;
 }
 
@@ -222,40 +305,73 @@ TfLiteStatus EvalHybrid(TfLiteContext* context, TfLiteNode* node,
   const int8_t* value_ptr = GetTensorData<int8_t>(value);
   const int32_t* lookup_data = GetTensorData<int32_t>(lookup);
 
-  for (int i = 0; i < SizeOfDimension(lookup, 0); i++) {
+  TF_LITE_ENSURE_OK(context, CheckLookups(context, lookup, row_size));
+  const bool is_int4 = value->type == kTfLiteInt4;
+  const size_t row_bytes = is_int4 ? (col_size + 1) / 2 : col_size;
+  ForEachLookup(context, lookup, col_size * sizeof(float), [&](int i) {
+    PrefetchLookup(lookup, i, reinterpret_cast<const char*>(value_ptr),
+                   row_bytes);
     const int32_t idx = lookup_data[i];
-    if (idx >= row_size || idx < 0) {
-      TF_LITE_KERNEL_LOG(context,
-                         "Embedding Lookup: index out of bounds. "
-                         "Got %" PRId32 ", and bounds are [0, %d]",
-                         idx, row_size - 1);
-      return kTfLiteError;
+    const float scaling_factor = RowScale(value, idx);
+    if (is_int4) {
+      Unpack4Bit(scaling_factor, col_size, &value_ptr[idx * col_size / 2],
+                 &output_ptr[i * col_size]);
     } else {
-      // Dequantize embedding values.
-      // TODO(alanchiao): refactor scalar multiply into separate function
-      // for ease of adding a neon equivalent if ever necessary.
-      double scaling_factor = value->params.scale;
-      if (value->quantization.type == kTfLiteAffineQuantization) {
-        const auto qparams = static_cast<const TfLiteAffineQuantization*>(
-            value->quantization.params);
-        if (qparams->scale->size > 1) {
-          // get this row's scale for per-axis quantization
-          scaling_factor = qparams->scale->data[idx];
-        }
-      }
-
-      if (value->type == kTfLiteInt4) {
-        Unpack4Bit(scaling_factor, col_size, &value_ptr[idx * col_size / 2],
-                   &output_ptr[i * col_size]);
-      } else {
-        for (int j = 0; j < col_size; j++) {
-          output_ptr[j + i * col_size] =
-              value_ptr[j + idx * col_size] * scaling_factor;
-        }
-      }
+      Dequantize8Bit(scaling_factor, col_size, &value_ptr[idx * col_size],
+                     &output_ptr[i * col_size]);
     }
+  });
+  return kTfLiteOk;
+}
+
+// Requantizes the rows of an int4 or a per-axis quantized int8 `value` to the
+// scale and zero point of an int8 `output`, without float intermediates.
+TfLiteStatus EvalRequantize(TfLiteContext* context, TfLiteNode* node,
+                            const TfLiteTensor* lookup,
+                            const TfLiteTensor* value, TfLiteTensor* output) {
+  const int row_size = SizeOfDimension(value, 0);
+
+  // col_size after we flatten tensor into 2D.
+  int col_size = 1;
+  for (int i = 1; i < NumDimensions(value); i++) {
+    col_size *= SizeOfDimension(value, i);
   }
 
+  int8_t* output_ptr = GetTensorData<int8_t>(output);
+  const int8_t* value_ptr = GetTensorData<int8_t>(value);
+  const int32_t* lookup_data = GetTensorData<int32_t>(lookup);
+  const float inverse_output_scale = 1.0f / output->params.scale;
+  const int32_t output_zero_point = output->params.zero_point;
+
+  TF_LITE_ENSURE_OK(context, CheckLookups(context, lookup, row_size));
+  const bool is_int4 = value->type == kTfLiteInt4;
+  const size_t row_bytes = is_int4 ? (col_size + 1) / 2 : col_size;
+  ForEachLookup(context, lookup, col_size, [&](int i) {
+    PrefetchLookup(lookup, i, reinterpret_cast<const char*>(value_ptr),
+                   row_bytes);
+    const int32_t idx = lookup_data[i];
+    const float multiplier = RowScale(value, idx) * inverse_output_scale;
+    int8_t* output_row = &output_ptr[i * col_size];
+    const auto requantize = [&](int32_t q) {
+      const int32_t requantized =
+          static_cast<int32_t>(std::round(q * multiplier)) + output_zero_point;
+      return static_cast<int8_t>(std::min<int32_t>(
+          std::max<int32_t>(requantized, INT8_MIN), INT8_MAX));
+    };
+    if (is_int4) {
+      const int8_t* value_row = &value_ptr[idx * col_size / 2];
+      for (int j = 0; j < col_size; j++) {
+        const int8_t i4_val = value_row[j / 2];
+        output_row[j] = requantize(
+            j % 2 == 0 ? static_cast<int8_t>(i4_val << 4) >> 4 : i4_val >> 4);
+      }
+    } else {
+      const int8_t* value_row = &value_ptr[idx * col_size];
+      for (int j = 0; j < col_size; j++) {
+        output_row[j] = requantize(value_row[j]);
+      }
+    }
+  });
   return kTfLiteOk;
 }
 
@@ -270,11 +386,16 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
     case kTfLiteFloat32:
       return EvalSimple(context, node, lookup, value, output);
     case kTfLiteInt4:
+      if (IsRequantized(value, output)) {
+        return EvalRequantize(context, node, lookup, value, output);
+      }
       return EvalHybrid(context, node, lookup, value, output);
     case kTfLiteUInt8:
     case kTfLiteInt8:
       if (output->type == kTfLiteFloat32) {
         return EvalHybrid(context, node, lookup, value, output);
+      } else if (IsRequantized(value, output)) {
+        return EvalRequantize(context, node, lookup, value, output);
       } else {
         return EvalSimple(context, node, lookup, value, output);
       }
@@ -43,7 +43,8 @@ class BaseEmbeddingLookupOpModel : public SingleOpModel {
       TensorType weight_type = TensorType_FLOAT32,
       TensorType output_type = TensorType_FLOAT32,
       const std::vector<float>& per_channel_quantization_scales = {},
-      int blocksize = 0) {
+      int blocksize = 0, float output_scale = 0.0f,
+      int32_t output_zero_point = 0) {
     input_ = AddInput(TensorType_INT32);
     if (per_channel_quantization_scales.empty()) {
       weight_ = AddInput(weight_type);
@@ -67,7 +68,8 @@ class BaseEmbeddingLookupOpModel : public SingleOpModel {
                           /*shape_signature=*/{},
                           /*per_block_quantization=*/blocksize});
     }
-    output_ = AddOutput(output_type);
+    output_ = AddOutput({output_type, {}, 0.0f, 0.0f, output_scale,
+                         output_zero_point});
     SetBuiltinOp(BuiltinOperator_EMBEDDING_LOOKUP, BuiltinOptions_NONE, 0);
     BuildInterpreter({index_shape, weight_shape});
   }
@@ -76,6 +78,8 @@ class BaseEmbeddingLookupOpModel : public SingleOpModel {
     PopulateTensor(input_, data);
   }
 
+  void SetInput(const std::vector<int>& data) { PopulateTensor(input_, data); }
+
   template <typename T>
   std::vector<T> GetOutput() {
     return ExtractVector<T>(output_);
@@ -166,6 +170,24 @@ class PerBlockHybridEmbeddingLookupOpModel : public BaseEmbeddingLookupOpModel {
   }
 };
 
+class RequantizedEmbeddingLookupOpModel : public BaseEmbeddingLookupOpModel {
+ public:
+  RequantizedEmbeddingLookupOpModel(
+      std::initializer_list<int> index_shape,
+      std::initializer_list<int> weight_shape,
+      const std::vector<float>& per_channel_quantization_scales,
+      TensorType type, float output_scale, int32_t output_zero_point)
+      : BaseEmbeddingLookupOpModel(index_shape, weight_shape, type,
+                                   TensorType_INT8,
+                                   per_channel_quantization_scales,
+                                   /*blocksize=*/0, output_scale,
+                                   output_zero_point) {}
+
+  void SetSignedWeight(std::initializer_list<float> data) {
+    PerChannelSymmetricQuantizeAndPopulate(weight_, data);
+  }
+};
+
 // TODO(ahentz): write more tests that exercise the details of the op, such as
 // lookup errors and variable input shapes.
 TEST(EmbeddingLookupOpTest, SimpleTest) {
@@ -512,5 +534,70 @@ TEST(PerAxisHybridEmbeddingLookupHybridOpTest, PerAxisSimple4DTestInt4) {
           kTestTolerance)));
 }
 
+TEST(RequantizedEmbeddingLookupOpTest, PerAxisInt8ToInt8) {
+  RequantizedEmbeddingLookupOpModel m(
+      /*index_shape=*/{3}, /*weight_shape=*/{3, 4},
+      /*per_channel_quantization_scales=*/{0.01, 0.02, 0.04},
+      /*type=*/TensorType_INT8, /*output_scale=*/0.02,
+      /*output_zero_point=*/-10);
+  m.SetInput({1, 0, 2});
+  m.SetSignedWeight({
+      0.00, 0.10, -0.20, 1.00,  // Row 0
+      0.02, -0.40, 0.80, 2.54,  // Row 1
+      0.04, 1.20, -2.00, 5.08,  // Row 2
+  });
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  // The values are divided by the output scale and shifted by its zero point,
+  // saturating at the int8 bounds.
+  EXPECT_THAT(m.GetOutput<int8_t>(), ElementsAreArray({
+                                         -9, -30, 30, 117,   // Row 1
+                                         -10, -5, -20, 40,   // Row 0
+                                         -8, 50, -110, 127,  // Row 2
+                                     }));
+}
+
+TEST(RequantizedEmbeddingLookupOpTest, PerAxisInt4ToInt8) {
+  RequantizedEmbeddingLookupOpModel m(
+      /*index_shape=*/{2}, /*weight_shape=*/{2, 4},
+      /*per_channel_quantization_scales=*/{0.1, 1.0},
+      /*type=*/TensorType_INT4, /*output_scale=*/0.1,
+      /*output_zero_point=*/0);
+  m.SetInput({1, 0});
+  m.SetSignedWeight({
+      0.1, -0.2, 0.3, 0.7,  // Row 0
+      1.0, -2.0, 7.0, -7.0,  // Row 1
+  });
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutput<int8_t>(), ElementsAreArray({
+                                         10, -20, 70, -70,  // Row 1
+                                         1, -2, 3, 7,       // Row 0
+                                     }));
+}
+
+TEST(EmbeddingLookupOpTest, ManyLookupsOfLargeRows) {
+  EmbeddingLookupOpModel m({256}, {64, 1024});
+  std::vector<int> lookups(256);
+  for (int i = 0; i < lookups.size(); i++) {
+    lookups[i] = (i * 37) % 64;
+  }
+  m.SetInput(lookups);
+  m.Set2DWeightMatrix<float>(
+      [](int i, int j) -> float { return i * 1024 + j; });
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  std::vector<float> expected;
+  for (const int lookup : lookups) {
+    for (int j = 0; j < 1024; j++) {
+      expected.push_back(lookup * 1024 + j);
+    }
+  }
+  EXPECT_THAT(m.GetOutput<float>(), ElementsAreArray(expected));
+}
+
 }  // namespace
 }  // namespace tflite
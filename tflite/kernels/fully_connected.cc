@@ -19,6 +19,7 @@ limitations under the License.
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -68,6 +69,34 @@ bool SupportedSparsityFormat(const TfLiteSparsity& sparsity) {
 static const int kDimMetadataSizeRandomSparse = 2;
 static const int kDimMetadataSizeBlockSparse = 3;
 
+// Returns in `block_rows` and `block_cols` the size of the blocks of the
+// block sparse `sparsity`, the blocks being along the dimension of its block
+// map, and whether they tile weights of `rows` x `cols` values. A missing block
+// map stands for blocks along the columns.
+bool GetSparseBlockSize(const TfLiteSparsity& sparsity, int rows, int cols,
+                        int* block_rows, int* block_cols) {
+  if (sparsity.dim_metadata_size != kDimMetadataSizeBlockSparse) return false;
+  const int block_size = sparsity.dim_metadata[2].dense_size;
+  const bool blocked_rows = sparsity.block_map != nullptr &&
+                            sparsity.block_map->size == 1 &&
+                            sparsity.block_map->data[0] == 0;
+  *block_rows = blocked_rows ? block_size : 1;
+  *block_cols = blocked_rows ? 1 : block_size;
+  if (block_size <= 0 ||
+      sparsity.dim_metadata[0].dense_size * *block_rows != rows ||
+      sparsity.dim_metadata[1].array_segments->size !=
+          sparsity.dim_metadata[0].dense_size + 1) {
+    return false;
+  }
+  const TfLiteIntArray* indices = sparsity.dim_metadata[1].array_indices;
+  for (int i = 0; i < indices->size; ++i) {
+    if (indices->data[i] < 0 || (indices->data[i] + 1) * *block_cols > cols) {
+      return false;
+    }
+  }
+  return true;
+}
+
 TfLiteStatus CreateLedgerTensor(const TfLiteSparsity* sparsity,
                                 TfLiteContext* context, TfLiteTensor* ledger) {
   TF_LITE_ENSURE(context, sparsity != nullptr);
@@ -357,6 +386,32 @@ TfLiteStatus PrepareImpl4Bit(TfLiteContext* context, TfLiteNode* node,
                           cols);
 }
 
+// Checks the parameters of int4 weights quantized in blocks along the input
+// channels, with a float16 scale per block of each output channel.
+TfLiteStatus CheckBlockwiseQuantization(TfLiteContext* context,
+                                        const TfLiteTensor* input,
+                                        const TfLiteTensor* filter) {
+  const auto* quantization_params =
+      reinterpret_cast<const TfLiteBlockwiseQuantization*>(
+          filter->quantization.params);
+  TF_LITE_ENSURE(context, quantization_params);
+  TF_LITE_ENSURE_TYPES_EQ(context, input->type, kTfLiteFloat32);
+  TF_LITE_ENSURE_TYPES_EQ(context, filter->type, kTfLiteInt4);
+  const int blocksize = quantization_params->blocksize;
+  const int input_channels = SizeOfDimension(filter, 1);
+  // Blocks of an even size keep each packed row byte aligned.
+  TF_LITE_ENSURE(context, blocksize > 0 && blocksize % 2 == 0);
+  TF_LITE_ENSURE_EQ(context, input_channels % blocksize, 0);
+  TF_LITE_ENSURE(context, quantization_params->scale >= 0 &&
+                              quantization_params->scale <
+                                  static_cast<int>(context->tensors_size));
+  const TfLiteTensor& scale = context->tensors[quantization_params->scale];
+  TF_LITE_ENSURE_TYPES_EQ(context, scale.type, kTfLiteFloat16);
+  TF_LITE_ENSURE_EQ(context, NumElements(&scale),
+                    SizeOfDimension(filter, 0) * (input_channels / blocksize));
+  return kTfLiteOk;
+}
+
 TfLiteStatus PrepareImpl(TfLiteContext* context, TfLiteNode* node,
                          KernelType kernel_type) {
   auto* params =
@@ -426,6 +481,10 @@ TfLiteStatus PrepareImpl(TfLiteContext* context, TfLiteNode* node,
     TF_LITE_ENSURE_EQ(context, NumElements(bias), SizeOfDimension(filter, 0));
   }
 
+  if (filter->quantization.type == kTfLiteBlockwiseQuantization) {
+    TF_LITE_ENSURE_STATUS(CheckBlockwiseQuantization(context, input, filter));
+  }
+
   // Note that quantized inference requires that all tensors have their
   // parameters set. This is usually done during quantized training.
   if (input->type == kTfLiteUInt8 || input->type == kTfLiteInt8 ||
@@ -1121,6 +1180,62 @@ TfLiteStatus EvalHybridDense4Bit(
   return kTfLiteOk;
 }
 
+// Evaluates the hybrid fully connected layer with int8 weights block sparse
+// with blocks of BlockRows x BlockCols values. The input is quantized at once,
+// and the multi-threaded kernel slices the workload along the block rows of
+// the weights, which also splits a single batch.
+template <int BlockRows, int BlockCols>
+TfLiteStatus EvalSparseHybridBlock(
+    TfLiteContext* context, TfLiteFullyConnectedParams* params,
+    const TfLiteTensor* input, const TfLiteTensor* filter,
+    const TfLiteTensor* bias, TfLiteTensor* input_quantized,
+    TfLiteTensor* scaling_factors, TfLiteTensor* input_offsets,
+    TfLiteTensor* output) {
+  TF_LITE_ENSURE_TYPES_EQ(context, filter->type, kTfLiteInt8);
+  const auto& input_shape = GetTensorShape(input);
+  const auto& output_shape = GetTensorShape(output);
+  const auto& filter_shape = GetTensorShape(filter);
+  const int batch_size =
+      FlatSizeSkipDim(output_shape, output_shape.DimensionsCount() - 1);
+  const int input_depth = filter_shape.Dims(1);
+  float* scaling_factors_ptr = GetTensorData<float>(scaling_factors);
+  int32_t* input_offset_ptr = nullptr;
+  if (params->asymmetric_quantize_inputs) {
+    input_offset_ptr = GetTensorData<int32_t>(input_offsets);
+  }
+  int8_t* quant_data = GetTensorData<int8_t>(input_quantized);
+  tensor_utils::BatchQuantizeFloats(GetTensorData<float>(input), batch_size,
+                                    input_depth, quant_data,
+                                    scaling_factors_ptr, input_offset_ptr,
+                                    params->asymmetric_quantize_inputs);
+  const float* per_channel_scale_ptr = nullptr;
+  if (VerifyPerChannelQuantization(context, filter) == kTfLiteOk) {
+    const auto* affine_quantization =
+        reinterpret_cast<TfLiteAffineQuantization*>(
+            filter->quantization.params);
+    per_channel_scale_ptr = affine_quantization->scale->data;
+  } else {
+    for (int b = 0; b < batch_size; ++b) {
+      scaling_factors_ptr[b] *= filter->params.scale;
+    }
+  }
+
+  FullyConnectedParams op_params;
+  op_params.float_activation_min = std::numeric_limits<float>::lowest();
+  op_params.float_activation_max = std::numeric_limits<float>::max();
+  optimized_ops::FullyConnectedSparseWeightBlockHybrid<BlockRows, BlockCols>(
+      *filter->sparsity, op_params, input_shape, quant_data,
+      scaling_factors_ptr, input_offset_ptr, filter_shape,
+      GetTensorData<int8_t>(filter), per_channel_scale_ptr,
+      GetTensorShape(bias), GetTensorData<float>(bias), output_shape,
+      GetTensorData<float>(output),
+      CpuBackendContext::GetFromContext(context));
+  tensor_utils::ApplyActivationToVector(
+      GetTensorData<float>(output), batch_size * filter_shape.Dims(0),
+      params->activation, GetTensorData<float>(output));
+  return kTfLiteOk;
+}
+
 TfLiteStatus EvalHybrid(TfLiteContext* context, TfLiteNode* node,
                         TfLiteFullyConnectedParams* params, OpData* data,
                         const TfLiteTensor* input, const TfLiteTensor* filter,
@@ -1138,6 +1253,22 @@ TfLiteStatus EvalHybrid(TfLiteContext* context, TfLiteNode* node,
                            row_sums, input_offsets, output);
   }
 
+  int block_rows = 0;
+  int block_cols = 0;
+  if (GetSparseBlockSize(*filter->sparsity, filter->dims->data[0],
+                         filter->dims->data[1], &block_rows, &block_cols)) {
+    if (block_rows == 1 && block_cols == 4) {
+      return EvalSparseHybridBlock<1, 4>(context, params, input, filter, bias,
+                                         input_quantized, scaling_factors,
+                                         input_offsets, output);
+    }
+    if (block_rows == 4 && block_cols == 1) {
+      return EvalSparseHybridBlock<4, 1>(context, params, input, filter, bias,
+                                         input_quantized, scaling_factors,
+                                         input_offsets, output);
+    }
+  }
+
   TfLiteTensor* filter_ledger = &context->tensors[node->temporaries->data[5]];
   if (!data->ledger_initialized) {
     PopulateLedgerData(filter->sparsity, context,
@@ -1386,16 +1517,19 @@ TfLiteStatus EvalQuantized(TfLiteContext* context, TfLiteNode* node,
     TfLiteTensor* input_offsets;
     TF_LITE_ENSURE_OK(
         context, GetTemporarySafe(context, node, /*index=*/3, &input_offsets));
+    // Blockwise weights run the same kernel whether or not the shapes suit
+    // the optimized 4bit path.
+    if (filter->quantization.type == kTfLiteBlockwiseQuantization) {
+      return EvalBlockwise4Bit(context, node, params, data, input, filter,
+                               bias, input_quantized, scaling_factors,
+                               accum_scratch, input_offsets, output);
+    }
     if (data->op_data_4bit) {
       switch (filter->quantization.type) {
         case kTfLiteAffineQuantization:
           return EvalHybridDense4Bit(context, node, params, data, input, filter,
                                      bias, input_quantized, scaling_factors,
                                      accum_scratch, input_offsets, output);
-        case kTfLiteBlockwiseQuantization:
-          return EvalBlockwise4Bit(context, node, params, data, input, filter,
-                                   bias, input_quantized, scaling_factors,
-                                   accum_scratch, input_offsets, output);
         default:
           return kTfLiteError;
       }
@@ -1462,8 +1596,16 @@ TfLiteStatus EvalQuantized(TfLiteContext* context, TfLiteNode* node,
           // supported
           TF_LITE_ENSURE(context, filter->type != kTfLiteInt4);
           TF_LITE_ENSURE(context, filter->type != kTfLiteInt2);
-          if (sparsity.dim_metadata_size == kDimMetadataSizeBlockSparse &&
-              sparsity.dim_metadata[2].dense_size == 16) {
+          int block_rows = 0;
+          int block_cols = 0;
+          if (!GetSparseBlockSize(sparsity, filter_shape.Dims(0),
+                                  filter_shape.Dims(1), &block_rows,
+                                  &block_cols)) {
+            TF_LITE_KERNEL_LOG(
+                context, "Unsupported sparse fully-connected weight format.");
+            return kTfLiteError;
+          }
+          if (block_rows == 1 && block_cols == 16) {
             // Block sparse with block size of 1x16.
             optimized_ops::FullyConnectedSparseWeight1x16(
                 sparsity, op_params, input_shape, GetTensorData<int8_t>(input),
@@ -1473,6 +1615,26 @@ TfLiteStatus EvalQuantized(TfLiteContext* context, TfLiteNode* node,
                 GetTensorData<int32_t>(bias), output_shape,
                 GetTensorData<int8_t>(output),
                 CpuBackendContext::GetFromContext(context));
+          } else if (block_rows == 1 && block_cols == 4) {
+            // Block sparse with block size of 1x4.
+            optimized_ops::FullyConnectedSparseWeightBlock<1, 4>(
+                sparsity, op_params, input_shape, GetTensorData<int8_t>(input),
+                filter_shape, GetTensorData<int8_t>(filter),
+                data->per_channel_output_multiplier.data(),
+                data->per_channel_output_shift.data(), bias_shape,
+                GetTensorData<int32_t>(bias), output_shape,
+                GetTensorData<int8_t>(output),
+                CpuBackendContext::GetFromContext(context));
+          } else if (block_rows == 4 && block_cols == 1) {
+            // Block sparse with block size of 4x1.
+            optimized_ops::FullyConnectedSparseWeightBlock<4, 1>(
+                sparsity, op_params, input_shape, GetTensorData<int8_t>(input),
+                filter_shape, GetTensorData<int8_t>(filter),
+                data->per_channel_output_multiplier.data(),
+                data->per_channel_output_shift.data(), bias_shape,
+                GetTensorData<int32_t>(bias), output_shape,
+                GetTensorData<int8_t>(output),
+                CpuBackendContext::GetFromContext(context));
           } else {
             TF_LITE_KERNEL_LOG(
                 context, "Unsupported sparse fully-connected weight format.");
@@ -1692,6 +1854,8 @@ TfLiteStatus EvalFloat(TfLiteContext* context, TfLiteNode* node,
         return kTfLiteError;
       }
 
+      int block_rows = 0;
+      int block_cols = 0;
       if (sparsity.dim_metadata_size == kDimMetadataSizeRandomSparse) {
         // Random sparse.
         optimized_ops::FullyConnectedSparseWeight(
@@ -1700,8 +1864,10 @@ TfLiteStatus EvalFloat(TfLiteContext* context, TfLiteNode* node,
             filter_shape, GetTensorData<float>(filter),  // Disable formatting
             bias_shape, GetTensorData<float>(bias),      // Disable formatting
             output_shape, GetTensorData<float>(output));
-      } else if (sparsity.dim_metadata_size == kDimMetadataSizeBlockSparse &&
-                 sparsity.dim_metadata[2].dense_size == 4) {
+      } else if (GetSparseBlockSize(sparsity, filter_shape.Dims(0),
+                                    filter_shape.Dims(1), &block_rows,
+                                    &block_cols) &&
+                 block_rows == 1 && block_cols == 4) {
         // Block sparse with block size of 1x4.
         optimized_ops::FullyConnectedSparseWeight1x4(
             sparsity, op_params,                         // Disable formatting
@@ -1710,6 +1876,15 @@ TfLiteStatus EvalFloat(TfLiteContext* context, TfLiteNode* node,
             bias_shape, GetTensorData<float>(bias),      // Disable formatting
             output_shape, GetTensorData<float>(output),
             CpuBackendContext::GetFromContext(context));
+      } else if (block_rows == 4 && block_cols == 1) {
+        // Block sparse with block size of 4x1.
+        optimized_ops::FullyConnectedSparseWeightBlock<4, 1>(
+            sparsity, op_params,                         // Disable formatting
+            input_shape, GetTensorData<float>(input),    // Disable formatting
+            filter_shape, GetTensorData<float>(filter),  // Disable formatting
+            bias_shape, GetTensorData<float>(bias),      // Disable formatting
+            output_shape, GetTensorData<float>(output),
+            CpuBackendContext::GetFromContext(context));
       } else {
         TF_LITE_KERNEL_LOG(context,
                            "Unsupported sparse fully-connected weight format.");
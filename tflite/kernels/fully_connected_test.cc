@@ -2315,6 +2315,98 @@ TEST_P(SparseFullyConnectedOpTest, Simple1x4TestMultiThreadedMoreBatches) {
   }
 }
 
+TEST_P(SparseFullyConnectedOpTest, Simple4x1Test) {
+  std::initializer_list<float> weight_data = {
+      127, 0, 3,  4,  5, 0, 7,  8,  // u = 0
+      -1,  0, 2,  -3, 4, 0, -5, 6,  // u = 1
+      2,   0, 2,  2,  2, 0, 2,  2,  // u = 2
+      0,   0, 0,  0,  0, 0, 0,  1,  // u = 3
+  };
+  TensorData weight = {};
+  weight.type = TensorType_FLOAT32;
+  weight.shape = {4, 8};
+  weight.traversal_order = {0, 1, 2};
+  weight.format = {kTfLiteDimDense, kTfLiteDimSparseCSR};
+  weight.block_map = {0};
+  weight.block_size = {4};
+  SparseFullyConnectedOpModel<float> m(GetRegistration(),
+                                       /*units=*/4, /*batches=*/2,
+                                       /*input=*/{TensorType_FLOAT32, {2, 8}},
+                                       weight, weight_data);
+  m.SetBias({1, 2, 3, 4});
+
+  m.SetInput({
+      1,    2,  3,  4,  -1, -2, -3, 127,  // b = 0
+      -127, 10, 20, 30, 40, 0,  -5, 1,    // b = 1
+  });
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(2, 4));
+  EXPECT_THAT(m.GetOutput(), ElementsAre(1143, 768, 265, 131, 0, 270, 0, 5));
+}
+
+TEST_P(SparseFullyConnectedOpTest, BlockSparseTestMultiThreaded) {
+  // Large enough for the block sparse kernels to split the rows of the
+  // weights across threads.
+  const int units = 64;
+  const int input_depth = 256;
+  const int batches = 8;
+  for (const int block_rows : {1, 4}) {
+    const int block_cols = 4 / block_rows;
+    std::vector<float> weight_data(units * input_depth);
+    for (int u = 0; u < units; ++u) {
+      for (int i = 0; i < input_depth; ++i) {
+        const bool zero_block = (u / block_rows + i / block_cols) % 3 == 0;
+        weight_data[u * input_depth + i] =
+            zero_block ? 0 : (u * 7 + i * 3) % 11 - 5;
+      }
+    }
+    std::vector<float> input_data(batches * input_depth);
+    for (int b = 0; b < batches; ++b) {
+      for (int i = 0; i < input_depth; ++i) {
+        input_data[b * input_depth + i] = ((b * 5 + i) % 7 - 3) * 0.5f;
+      }
+    }
+    std::vector<float> bias_data(units);
+    for (int u = 0; u < units; ++u) bias_data[u] = u % 5 - 2;
+    std::vector<float> expected(batches * units);
+    for (int b = 0; b < batches; ++b) {
+      for (int u = 0; u < units; ++u) {
+        float sum = bias_data[u];
+        for (int i = 0; i < input_depth; ++i) {
+          sum += weight_data[u * input_depth + i] *
+                 input_data[b * input_depth + i];
+        }
+        expected[b * units + u] = std::max(sum, 0.0f);
+      }
+    }
+
+    TensorData weight = {};
+    weight.type = TensorType_FLOAT32;
+    weight.shape = {units, input_depth};
+    weight.traversal_order = {0, 1, 2};
+    weight.format = {kTfLiteDimDense, kTfLiteDimSparseCSR};
+    weight.block_map = {block_rows == 1 ? 1 : 0};
+    weight.block_size = {4};
+    for (int num_threads = 1; num_threads <= 4; ++num_threads) {
+      SparseFullyConnectedOpModel<float> m(
+          GetRegistration(), units, batches,
+          /*input=*/{TensorType_FLOAT32, {batches, input_depth}}, weight,
+          weight_data,
+          /*output=*/{TensorType_FLOAT32},
+          /*bias_tensor_optional=*/false, /*num_threads=*/num_threads);
+      m.SetBias(bias_data);
+      m.SetInput(input_data);
+
+      ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+      EXPECT_THAT(m.GetOutputShape(), ElementsAre(batches, units));
+      EXPECT_THAT(m.GetOutput(), ElementsAreArray(expected));
+    }
+  }
+}
+
 TEST_P(SparseHybridFullyConnectedOpTest, SparseHybrid1x16Test) {
   std::initializer_list<float> weight_data = {
       /* 1st row */
@@ -2493,6 +2585,84 @@ TEST_P(SparseHybridFullyConnectedOpTest, SparseHybrid1x16PerChannelTest) {
   EXPECT_THAT(m.GetOutput(), ElementsAreArray(ArrayFloatNear(
                                  {10.9061, 2, 25.0938, 0, 2, 20.9691}, 1e-3)));
 }
+TEST_P(SparseHybridFullyConnectedOpTest, SparseHybrid1x4Test) {
+  std::initializer_list<float> weight_data = {
+      127, 2, -3, 4, 0,  0,  0,  0,   // u = 0
+      0,   0, 0,  0, 5,  -6, 7,  8,   // u = 1
+      1,   1, 1,  1, -1, -1, -1, -1,  // u = 2
+      0,   0, 0,  0, 0,  0,  0,  0,   // u = 3
+  };
+  TensorData weight = {};
+  weight.type = TensorType_FLOAT32;
+  weight.shape = {4, 8};
+  weight.traversal_order = {0, 1, 2};
+  weight.format = {kTfLiteDimDense, kTfLiteDimSparseCSR};
+  weight.block_map = {1};
+  weight.block_size = {4};
+  SparseFullyConnectedOpModel<float> m(
+      GetRegistration(),
+      /*units=*/4, /*batches=*/2,
+      /*input=*/{TensorType_FLOAT32, {2, 8}}, weight, weight_data,
+      /*output=*/{TensorType_FLOAT32},
+      /*bias_tensor_optional=*/false, /*num_threads=*/1,
+      /*symmetric_quantize_weights=*/true,
+      /*asymmetric_quantize_inputs=*/GetParam().asymmetric_quantize_input);
+  m.SetBias({1, 2, 3, 4});
+  m.SetInput({
+      1,    2,  3,  4,  -1, -2, -3, 127,  // b = 0
+      -127, 10, 20, 30, 40, 0,  -5, 1,    // b = 1
+  });
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(2, 4));
+  std::vector<float> expected = {139, 1004, 0, 4, 0, 175, 0, 4};
+  if (GetParam().asymmetric_quantize_input) {
+    expected = {141.7059, 1003.2549, 0, 4, 0, 175.5490, 0, 4};
+  }
+  EXPECT_THAT(m.GetOutput(), ElementsAreArray(ArrayFloatNear(expected, 1e-3)));
+}
+
+TEST_P(SparseHybridFullyConnectedOpTest, SparseHybrid4x1Test) {
+  std::initializer_list<float> weight_data = {
+      127, 0, 3,  4,  5, 0, 7,  8,  // u = 0
+      -1,  0, 2,  -3, 4, 0, -5, 6,  // u = 1
+      2,   0, 2,  2,  2, 0, 2,  2,  // u = 2
+      0,   0, 0,  0,  0, 0, 0,  1,  // u = 3
+  };
+  TensorData weight = {};
+  weight.type = TensorType_FLOAT32;
+  weight.shape = {4, 8};
+  weight.traversal_order = {0, 1, 2};
+  weight.format = {kTfLiteDimDense, kTfLiteDimSparseCSR};
+  weight.block_map = {0};
+  weight.block_size = {4};
+  for (int num_threads = 1; num_threads <= 4; ++num_threads) {
+    SparseFullyConnectedOpModel<float> m(
+        GetRegistration(),
+        /*units=*/4, /*batches=*/2,
+        /*input=*/{TensorType_FLOAT32, {2, 8}}, weight, weight_data,
+        /*output=*/{TensorType_FLOAT32},
+        /*bias_tensor_optional=*/false, /*num_threads=*/num_threads,
+        /*symmetric_quantize_weights=*/true,
+        /*asymmetric_quantize_inputs=*/GetParam().asymmetric_quantize_input);
+    m.SetBias({1, 2, 3, 4});
+    m.SetInput({
+        1,    2,  3,  4,  -1, -2, -3, 127,  // b = 0
+        -127, 10, 20, 30, 40, 0,  -5, 1,    // b = 1
+    });
+
+    ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+    EXPECT_THAT(m.GetOutputShape(), ElementsAre(2, 4));
+    std::vector<float> expected = {1143, 768, 265, 131, 0, 270, 0, 5};
+    if (GetParam().asymmetric_quantize_input) {
+      expected = {1145, 767.7255, 265.0392, 130.9412, 0, 273.1294, 0, 5.3098};
+    }
+    EXPECT_THAT(m.GetOutput(),
+                ElementsAreArray(ArrayFloatNear(expected, 1e-3)));
+  }
+}
 // TODO(b/148391360): Add tests for unsupported sparsity format.
 // TEST_P(SparseFullyConnectedOpTest, TestUnsupportedSparsityFormat)
 
@@ -2676,6 +2846,70 @@ TEST_P(SparseQuantizedFullyConnectedOpTest,
   EXPECT_THAT(m.GetOutput(), ElementsAre(11, 1, 25, 0, 1, 21));
 }
 
+TEST_P(SparseQuantizedFullyConnectedOpTest, Simple1x4Test) {
+  std::vector<float> weight_data = {
+      1, 2, -3, 4, 0,  0,  0,  0,   // u = 0
+      0, 0, 0,  0, 5,  -6, 7,  8,   // u = 1
+      1, 1, 1,  1, -1, -1, -1, -1,  // u = 2
+      0, 0, 0,  0, 0,  0,  0,  0,   // u = 3
+  };
+  TensorData weight = {TensorType_INT8, {4, 8}, 0, 0, 1};
+  weight.traversal_order = {0, 1, 2};
+  weight.format = {kTfLiteDimDense, kTfLiteDimSparseCSR};
+  weight.block_map = {1};
+  weight.block_size = {4};
+  SparseQuantizedFullyConnectedOpModel m(
+      GetRegistration(),
+      /*units=*/4, /*batches=*/2,
+      /*input=*/{TensorType_INT8, {2, 8}, 0, 0, 1}, weight, weight_data,
+      /*output=*/{TensorType_INT8, {}, 0, 0, 1});
+
+  m.SetBias({1, 2, 3, 4});
+  m.SetInput({
+      1,  2, 3, 4, -1, -2, -3, 5,  // b = 0
+      -6, 1, 2, 3, 4,  0,  -5, 1,  // b = 1
+  });
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(2, 4));
+  EXPECT_THAT(m.GetOutput(), ElementsAre(13, 28, 14, 4, 3, 0, 3, 4));
+}
+
+TEST_P(SparseQuantizedFullyConnectedOpTest, Simple4x1TestInputZeroPoint) {
+  std::vector<float> weight_data = {
+      1,  0, 3, 4,  5, 0, 7,  8,  // u = 0
+      -1, 0, 2, -3, 4, 0, -5, 6,  // u = 1
+      2,  0, 2, 2,  2, 0, 2,  2,  // u = 2
+      0,  0, 0, 0,  0, 0, 0,  1,  // u = 3
+  };
+  TensorData weight = {TensorType_INT8, {4, 8}, 0, 0, 1};
+  weight.traversal_order = {0, 1, 2};
+  weight.format = {kTfLiteDimDense, kTfLiteDimSparseCSR};
+  weight.block_map = {0};
+  weight.block_size = {4};
+  for (int num_threads = 1; num_threads <= 4; ++num_threads) {
+    SparseQuantizedFullyConnectedOpModel m(
+        GetRegistration(),
+        /*units=*/4, /*batches=*/2,
+        /*input=*/{TensorType_INT8, {2, 8}, 0, 0, 1, -10}, weight,
+        weight_data,
+        /*output=*/{TensorType_INT8, {}, 0, 0, 1},
+        /*bias_tensor_optional=*/false, /*num_threads=*/num_threads);
+
+    m.SetBias({1, 2, 3, 4});
+    m.SetInput({
+        1,  2, 3, 4, -1, -2, -3, 5,  // b = 0
+        -6, 1, 2, 3, 4,  0,  -5, 1,  // b = 1
+    });
+
+    ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+    EXPECT_THAT(m.GetOutputShape(), ElementsAre(2, 4));
+    EXPECT_THAT(m.GetOutput(), ElementsAre(41, 36, 21, 9, 6, 50, 1, 5));
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     SparseQuantizedFullyConnectedOpTest, SparseQuantizedFullyConnectedOpTest,
     ::testing::ValuesIn(SingleOpTest::GetKernelTags(*kKernelMapNoPie)));
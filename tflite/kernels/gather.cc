@@ -16,6 +16,7 @@ limitations under the License.
 
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/kernels/internal/optimized/optimized_ops.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/internal/types.h"
@@ -166,7 +167,8 @@ TfLiteStatus Gather(TfLiteContext* context, const TfLiteGatherParams& params,
       op_params, GetTensorShape(input), GetTensorData<InputT>(input),
       GetTensorShape(positions), GetTensorData<PositionsT>(positions),
       GetTensorShape(output), GetTensorData<InputT>(output),
-      (input->type == kTfLiteInt4));
+      (input->type == kTfLiteInt4),
+      CpuBackendContext::GetFromContext(context));
 }
 
 template <typename PositionT>
@@ -16,6 +16,7 @@ limitations under the License.
 
 #include "tflite/core/c/c_api_types.h"
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/kernels/internal/optimized/optimized_ops.h"
 #include "tflite/kernels/internal/reference/reference_ops.h"
 #include "tflite/kernels/internal/tensor.h"
@@ -107,12 +108,13 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
 }
 
 template <typename ParamsT, typename IndicesT>
-TfLiteStatus GatherNd(const TfLiteTensor* params, const TfLiteTensor* indices,
-                      TfLiteTensor* output) {
-  return reference_ops::GatherNd(
+TfLiteStatus GatherNd(TfLiteContext* context, const TfLiteTensor* params,
+                      const TfLiteTensor* indices, TfLiteTensor* output) {
+  return optimized_ops::GatherNd(
       GetTensorShape(params), GetTensorData<ParamsT>(params),
       GetTensorShape(indices), GetTensorData<IndicesT>(indices),
-      GetTensorShape(output), GetTensorData<ParamsT>(output));
+      GetTensorShape(output), GetTensorData<ParamsT>(output),
+      CpuBackendContext::GetFromContext(context));
 }
 
 template <typename IndicesT>
@@ -140,34 +142,36 @@ TfLiteStatus EvalGatherNd(TfLiteContext* context, const TfLiteTensor* params,
   TfLiteStatus status = kTfLiteError;
   switch (params->type) {
     case kTfLiteBFloat16:
-      status = GatherNd<Eigen::bfloat16, IndicesT>(params, indices, output);
+      status =
+          GatherNd<Eigen::bfloat16, IndicesT>(context, params, indices, output);
       break;
     case kTfLiteFloat16:
-      status = GatherNd<Eigen::half, IndicesT>(params, indices, output);
+      status =
+          GatherNd<Eigen::half, IndicesT>(context, params, indices, output);
       break;
     case kTfLiteFloat32:
-      status = GatherNd<float, IndicesT>(params, indices, output);
+      status = GatherNd<float, IndicesT>(context, params, indices, output);
       break;
     case kTfLiteUInt8:
-      status = GatherNd<uint8_t, IndicesT>(params, indices, output);
+      status = GatherNd<uint8_t, IndicesT>(context, params, indices, output);
       break;
     case kTfLiteInt8:
-      status = GatherNd<int8_t, IndicesT>(params, indices, output);
+      status = GatherNd<int8_t, IndicesT>(context, params, indices, output);
       break;
     case kTfLiteInt16:
-      status = GatherNd<int16_t, IndicesT>(params, indices, output);
+      status = GatherNd<int16_t, IndicesT>(context, params, indices, output);
       break;
     case kTfLiteInt32:
-      status = GatherNd<int32_t, IndicesT>(params, indices, output);
+      status = GatherNd<int32_t, IndicesT>(context, params, indices, output);
       break;
     case kTfLiteInt64:
-      status = GatherNd<int64_t, IndicesT>(params, indices, output);
+      status = GatherNd<int64_t, IndicesT>(context, params, indices, output);
       break;
     case kTfLiteString:
       status = GatherNdString<IndicesT>(params, indices, output);
       break;
     case kTfLiteBool:
-      status = GatherNd<bool, IndicesT>(params, indices, output);
+      status = GatherNd<bool, IndicesT>(context, params, indices, output);
       break;
     default:
       TF_LITE_KERNEL_LOG(context,
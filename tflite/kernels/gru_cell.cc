@@ -15,8 +15,6 @@ limitations under the License.
 
 #include "tflite/kernels/gru_cell.h"
 
-#include <vector>
-
 #include "tflite/kernels/internal/optimized/optimized_ops.h"
 
 namespace tflite {
@@ -47,17 +45,13 @@ void GruCell(const RuntimeShape& input_shape, const float* input,
   const int n_output = state_shape.Dims(1);
 
   // [x h] = concat(input, state)
-  std::vector<float const*> concat_arrays_data;
-  std::vector<RuntimeShape const*> concat_arrays_shapes;
-  concat_arrays_data.push_back(input);
-  concat_arrays_data.push_back(input_state);
-  concat_arrays_shapes.push_back(&input_shape);
-  concat_arrays_shapes.push_back(&state_shape);
+  float const* concat_arrays_data[] = {input, input_state};
+  RuntimeShape const* concat_arrays_shapes[] = {&input_shape, &state_shape};
   tflite::ConcatenationParams concat_params;
   concat_params.axis = 1;
-  concat_params.inputs_count = concat_arrays_data.size();
-  Concatenation(concat_params, &(concat_arrays_shapes[0]),
-                &(concat_arrays_data[0]), concat_shape, concat);
+  concat_params.inputs_count = 2;
+  Concatenation(concat_params, concat_arrays_shapes, concat_arrays_data,
+                concat_shape, concat);
 
   // [r u] = [x h] * gate_weight + gate_bias
   FullyConnected(fc_params, concat_shape, concat, gate_weight_shape,
@@ -13,16 +13,20 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
-#include <cstring>
-#include <iostream>
+#include <initializer_list>
 #include <vector>
 
 #include "flatbuffers/flexbuffers.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/internal/optimized/gather.h"
+#include "tflite/kernels/internal/tensor_ctypes.h"
+#include "tflite/kernels/internal/tensor_utils.h"
 #include "tflite/kernels/kernel_util.h"
 
 namespace tflite {
@@ -31,12 +35,25 @@ namespace custom {
 namespace aeq_hadamard_rotation {
 
 static const int kInputTensor = 0;
+static const int kFilterTensor = 1;
+static const int kBiasTensor = 2;
 static const int kOutputTensor = 0;
 
+// Temporaries of the fused fully connected layer.
+enum Temporary {
+  kInputQuantized,
+  kScalingFactors,
+  kAccumScratch,
+  kRotatedRow,
+  kNumTemporaries,
+};
+
 struct OpData {
   bool is_initialized = false;
   int hadamard_size = 0;
   std::vector<int> random_binary_vector;
+  // Index of the first temporary of the fused fully connected layer.
+  int scratch_tensor_index = -1;
 };
 
 // FWHT implementation for fixed bounds.
@@ -57,57 +74,85 @@ void FWHTStaticSize(float* data) {
   }
 }
 
-// Fast Walsh Hadamard Transform. Updates `data` in place.
-template <size_t kUnrollThreshold = 64>
-void FWHTFast(float* data, int hadamard_size) {
-  if ((hadamard_size & (hadamard_size - 1)) != 0) {
-    std::cerr << "hadamard_size needs to be a power of 2\n";
-    return;
-  }
-  if (hadamard_size < kUnrollThreshold) {
-    // For small sizes, we run an "unoptimized" loop. This avoids unrolling the
-    // loops for every valid size under kUnrollSize.
-    for (size_t h = 1; h < hadamard_size; h *= 2) {
-      for (size_t i = 0; i < hadamard_size; i += 2 * h) {
-        for (size_t j = i; j < i + h; ++j) {
-          const float x = data[j];
-          const float y = data[j + h];
-          data[j] = x + y;
-          data[j + h] = x - y;
-        }
-      }
-    }
-  } else {
-    const int num_chunks = hadamard_size / kUnrollThreshold;
-    float* in = data;
-    // Use general, iterative loops algorithm for sizes up to kUnrollLimit.
-    for (int chunk = 0; chunk < num_chunks; ++chunk, in += kUnrollThreshold) {
-      FWHTStaticSize<kUnrollThreshold, 1>(in);
-    }
-    // Finish the bigger butterflies manually.
-    for (int chunk_size = kUnrollThreshold; chunk_size < hadamard_size;
-         chunk_size *= 2) {
-      float* in1 = &data[0];
-      float* in2 = &data[chunk_size];
-      for (int i = 0; i < hadamard_size;
-           i += chunk_size * 2, in1 += chunk_size, in2 += chunk_size) {
-        for (int j = i; j < i + chunk_size; j += kUnrollThreshold) {
-          // Compiler will unroll this fixed size loop easily.
-          for (int k = 0; k < kUnrollThreshold; k++) {
-            float x = *in1;
-            float y = *in2;
-            *in1++ = x + y;
-            *in2++ = x - y;
-          }
-        }
+// Butterflies of span `h` over the `size` values of `data`. The outputs are
+// multiplied by `scale` if kScale, so that the last stage normalizes them.
+template <bool kScale>
+void FWHTStage(float* data, int size, int h, float scale) {
+  for (int i = 0; i < size; i += 2 * h) {
+    float* in1 = data + i;
+    float* in2 = in1 + h;
+    for (int j = 0; j < h; ++j) {
+      const float x = in1[j];
+      const float y = in2[j];
+      if (kScale) {
+        in1[j] = (x + y) * scale;
+        in2[j] = (x - y) * scale;
+      } else {
+        in1[j] = x + y;
+        in2[j] = x - y;
       }
     }
   }
+}
 
+// Normalized Fast Walsh Hadamard Transform of the `hadamard_size` values of
+// `input` into `output`, which may be `input`. `hadamard_size` must be a
+// power of 2.
+//
+// The first two stages are radix-4 butterflies reading `input`, so that the
+// values are not copied to `output` beforehand, and the normalization is
+// folded into the last stage.
+template <int kUnrollThreshold = 64>
+void FWHTFast(const float* input, float* output, int hadamard_size) {
   // Calculate the inverse square root once.
   const float norm_factor = 1.0f / std::sqrt(hadamard_size);
-  for (int i = 0; i < hadamard_size; ++i) {
-    data[i] *= norm_factor;
+  if (hadamard_size < 4) {
+    if (hadamard_size == 1) {
+      output[0] = input[0] * norm_factor;
+    } else {
+      const float x = input[0];
+      const float y = input[1];
+      output[0] = (x + y) * norm_factor;
+      output[1] = (x - y) * norm_factor;
+    }
+    return;
+  }
+  for (int i = 0; i < hadamard_size; i += 4) {
+    const float sum0 = input[i] + input[i + 1];
+    const float diff0 = input[i] - input[i + 1];
+    const float sum1 = input[i + 2] + input[i + 3];
+    const float diff1 = input[i + 2] - input[i + 3];
+    output[i] = sum0 + sum1;
+    output[i + 1] = diff0 + diff1;
+    output[i + 2] = sum0 - sum1;
+    output[i + 3] = diff0 - diff1;
+  }
+  int h = 4;
+  if (hadamard_size >= kUnrollThreshold) {
+    // Use the unrolled butterflies up to kUnrollThreshold.
+    for (int chunk = 0; chunk < hadamard_size; chunk += kUnrollThreshold) {
+      FWHTStaticSize<kUnrollThreshold, 4>(output + chunk);
+    }
+    h = kUnrollThreshold;
+  }
+  if (h == hadamard_size) {
+    for (int i = 0; i < hadamard_size; ++i) {
+      output[i] *= norm_factor;
+    }
+    return;
+  }
+  for (; 2 * h < hadamard_size; h *= 2) {
+    FWHTStage</*kScale=*/false>(output, hadamard_size, h, 1.0f);
+  }
+  FWHTStage</*kScale=*/true>(output, hadamard_size, h, norm_factor);
+}
+
+// Rotates the `size` values of `input` into `output` by chunks of
+// `hadamard_size`.
+void RotateRow(const float* input, float* output, int size,
+               int hadamard_size) {
+  for (int i = 0; i < size; i += hadamard_size) {
+    FWHTFast(input + i, output + i, hadamard_size);
   }
 }
 
@@ -117,8 +162,76 @@ void* Init(TfLiteContext* context, const char* buffer, size_t length) {
   return op_data;
 }
 
+// Whether the op is fused with the hybrid fully connected layer consuming
+// its rotated input.
+bool IsFusedWithFullyConnected(TfLiteNode* node) {
+  return NumInputs(node) > kFilterTensor;
+}
+
+// Sets up the temporary `index` of `type` and shape `dims`.
+TfLiteStatus PrepareTemporary(TfLiteContext* context, TfLiteNode* node,
+                              int index, TfLiteType type,
+                              std::initializer_list<int> dims) {
+  const OpData* op_data = reinterpret_cast<const OpData*>(node->user_data);
+  node->temporaries->data[index] = op_data->scratch_tensor_index + index;
+  TfLiteTensor* temporary;
+  TF_LITE_ENSURE_OK(context,
+                    GetTemporarySafe(context, node, index, &temporary));
+  temporary->type = type;
+  temporary->allocation_type = kTfLiteArenaRw;
+  if (!TfLiteIntArrayEqualsArray(temporary->dims, dims.size(), dims.begin())) {
+    TfLiteIntArray* size = TfLiteIntArrayCreate(dims.size());
+    std::copy(dims.begin(), dims.end(), size->data);
+    TF_LITE_ENSURE_OK(context, context->ResizeTensor(context, temporary, size));
+  }
+  return kTfLiteOk;
+}
+
+// Prepares the computation of the hybrid fully connected layer of the rotated
+// `input`, whose output has `input`'s outer dimensions.
+TfLiteStatus PrepareFullyConnected(TfLiteContext* context, TfLiteNode* node,
+                                   const TfLiteTensor* input,
+                                   TfLiteTensor* output) {
+  OpData* op_data = reinterpret_cast<OpData*>(node->user_data);
+  const TfLiteTensor* filter;
+  TF_LITE_ENSURE_OK(context,
+                    GetInputSafe(context, node, kFilterTensor, &filter));
+  TF_LITE_ENSURE_TYPES_EQ(context, input->type, kTfLiteFloat32);
+  TF_LITE_ENSURE_TYPES_EQ(context, filter->type, kTfLiteInt8);
+  TF_LITE_ENSURE_EQ(context, NumDimensions(filter), 2);
+  const int depth = SizeOfDimension(input, NumDimensions(input) - 1);
+  TF_LITE_ENSURE_EQ(context, SizeOfDimension(filter, 1), depth);
+  const int num_units = SizeOfDimension(filter, 0);
+  const TfLiteTensor* bias = GetOptionalInputTensor(context, node, kBiasTensor);
+  if (bias != nullptr) {
+    TF_LITE_ENSURE_TYPES_EQ(context, bias->type, kTfLiteFloat32);
+    TF_LITE_ENSURE_EQ(context, NumElements(bias), num_units);
+  }
+  const int rows = depth == 0 ? 0 : NumElements(input) / depth;
+
+  if (op_data->scratch_tensor_index == -1) {
+    context->AddTensors(context, kNumTemporaries,
+                        &op_data->scratch_tensor_index);
+  }
+  TfLiteIntArrayFree(node->temporaries);
+  node->temporaries = TfLiteIntArrayCreate(kNumTemporaries);
+  TF_LITE_ENSURE_OK(context, PrepareTemporary(context, node, kInputQuantized,
+                                              kTfLiteInt8, {rows, depth}));
+  TF_LITE_ENSURE_OK(context, PrepareTemporary(context, node, kScalingFactors,
+                                              kTfLiteFloat32, {rows}));
+  TF_LITE_ENSURE_OK(context, PrepareTemporary(context, node, kAccumScratch,
+                                              kTfLiteInt32, {num_units, rows}));
+  TF_LITE_ENSURE_OK(context, PrepareTemporary(context, node, kRotatedRow,
+                                              kTfLiteFloat32, {depth}));
+
+  output->type = kTfLiteFloat32;
+  TfLiteIntArray* output_size = TfLiteIntArrayCopy(input->dims);
+  output_size->data[output_size->size - 1] = num_units;
+  return context->ResizeTensor(context, output, output_size);
+}
+
 TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
-  TF_LITE_ENSURE_EQ(context, NumInputs(node), 1);
+  TF_LITE_ENSURE(context, NumInputs(node) >= 1 && NumInputs(node) <= 3);
   TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
 
   OpData* op_data = reinterpret_cast<OpData*>(node->user_data);
@@ -139,6 +252,10 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
     op_data->random_binary_vector = vec;
     op_data->is_initialized = true;
   }
+  const int hadamard_size = op_data->hadamard_size;
+  // hadamard_size needs to be a power of 2.
+  TF_LITE_ENSURE(context, hadamard_size > 0 &&
+                              (hadamard_size & (hadamard_size - 1)) == 0);
 
   // Prepare the inputs.
   const TfLiteTensor* input_tensor;
@@ -147,14 +264,84 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
 
   TF_LITE_ENSURE(context, input_tensor->type == kTfLiteFloat32 ||
                               input_tensor->type == kTfLiteInt32);
+  TF_LITE_ENSURE(context, NumDimensions(input_tensor) >= 1);
+  TF_LITE_ENSURE_EQ(
+      context,
+      SizeOfDimension(input_tensor, NumDimensions(input_tensor) - 1) %
+          hadamard_size,
+      0);
 
-  return kTfLiteOk;
+  TfLiteTensor* output;
+  TF_LITE_ENSURE_OK(context,
+                    GetOutputSafe(context, node, kOutputTensor, &output));
+  if (IsFusedWithFullyConnected(node)) {
+    return PrepareFullyConnected(context, node, input_tensor, output);
+  }
+  return context->ResizeTensor(context, output,
+                               TfLiteIntArrayCopy(input_tensor->dims));
 }
 
 void Free(TfLiteContext* context, void* buffer) {
   delete static_cast<OpData*>(buffer);
 }
 
+// Computes the hybrid fully connected layer of the rotated `input`. Each row
+// is rotated into a scratch row and quantized from there as
+// FULLY_CONNECTED quantizes its float inputs, so that the rotated input is
+// never written out in float.
+TfLiteStatus EvalFullyConnected(TfLiteContext* context, TfLiteNode* node,
+                                const TfLiteTensor* input,
+                                TfLiteTensor* output) {
+  const OpData* op_data = reinterpret_cast<const OpData*>(node->user_data);
+  const TfLiteTensor* filter;
+  TF_LITE_ENSURE_OK(context,
+                    GetInputSafe(context, node, kFilterTensor, &filter));
+  const TfLiteTensor* bias = GetOptionalInputTensor(context, node, kBiasTensor);
+  TfLiteTensor* input_quantized;
+  TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node, kInputQuantized,
+                                              &input_quantized));
+  TfLiteTensor* scaling_factors;
+  TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node, kScalingFactors,
+                                              &scaling_factors));
+  TfLiteTensor* accum_scratch;
+  TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node, kAccumScratch,
+                                              &accum_scratch));
+  TfLiteTensor* rotated_row;
+  TF_LITE_ENSURE_OK(
+      context, GetTemporarySafe(context, node, kRotatedRow, &rotated_row));
+
+  const int depth = SizeOfDimension(filter, 1);
+  const int num_units = SizeOfDimension(filter, 0);
+  const int rows = depth == 0 ? 0 : NumElements(input) / depth;
+  const float* input_data = GetTensorData<float>(input);
+  float* rotated_data = GetTensorData<float>(rotated_row);
+  int8_t* quantized_data = GetTensorData<int8_t>(input_quantized);
+  float* scaling_factors_data = GetTensorData<float>(scaling_factors);
+  for (int row = 0; row < rows; ++row) {
+    RotateRow(input_data + row * depth, rotated_data, depth,
+              op_data->hadamard_size);
+    float unused_min, unused_max;
+    tensor_utils::SymmetricQuantizeFloats(
+        rotated_data, depth, quantized_data + row * depth, &unused_min,
+        &unused_max, &scaling_factors_data[row]);
+    // Incorporate scaling of the filter.
+    scaling_factors_data[row] *= filter->params.scale;
+  }
+
+  float* output_data = GetTensorData<float>(output);
+  if (bias) {
+    tensor_utils::VectorBatchVectorAssign(GetTensorData<float>(bias),
+                                          num_units, rows, output_data);
+  } else {
+    std::fill_n(output_data, rows * num_units, 0.0f);
+  }
+  tensor_utils::MatrixBatchVectorMultiplyAccumulate(
+      GetTensorData<int8_t>(filter), num_units, depth, quantized_data,
+      scaling_factors_data, rows, GetTensorData<int32_t>(accum_scratch),
+      output_data, CpuBackendContext::GetFromContext(context));
+  return kTfLiteOk;
+}
+
 TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   const TfLiteTensor* input_tensor;
   TF_LITE_ENSURE_OK(context,
@@ -162,28 +349,22 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   TfLiteTensor* output;
   TF_LITE_ENSURE_OK(context,
                     GetOutputSafe(context, node, kOutputTensor, &output));
+  if (IsFusedWithFullyConnected(node)) {
+    return EvalFullyConnected(context, node, input_tensor, output);
+  }
 
   OpData* op_data = reinterpret_cast<OpData*>(node->user_data);
-  int hadamard_size = op_data->hadamard_size;
-  int input_batch = 1;
-  int input_features = input_tensor->dims->data[0];
-  int input_feature_size = input_tensor->dims->data[1];
-  if (input_tensor->dims->size == 3) {
-    input_batch = input_tensor->dims->data[0];
-    input_features = input_tensor->dims->data[1];
-    input_feature_size = input_tensor->dims->data[2];
-  }
-
-  memcpy(output->data.f, input_tensor->data.f, input_tensor->bytes);
-
-  const int num_hadamards_per_feature = input_feature_size / hadamard_size;
-  const int total_transforms =
-      input_batch * input_features * num_hadamards_per_feature;
-  for (int i = 0; i < total_transforms; ++i) {
-    int chunk_start = i * hadamard_size;
-    // Update output->data.f in place.
-    FWHTFast(&output->data.f[chunk_start], hadamard_size);
-  }
+  const int hadamard_size = op_data->hadamard_size;
+  const int total_transforms = NumElements(input_tensor) / hadamard_size;
+  const float* input_data = input_tensor->data.f;
+  float* output_data = output->data.f;
+  optimized_ops::gather_internal::ForEachRow(
+      total_transforms, hadamard_size * sizeof(float),
+      CpuBackendContext::GetFromContext(context), [&](int i) {
+        const int chunk_start = i * hadamard_size;
+        FWHTFast(input_data + chunk_start, output_data + chunk_start,
+                 hadamard_size);
+      });
 
   return kTfLiteOk;
 }
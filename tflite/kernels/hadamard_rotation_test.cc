@@ -13,7 +13,9 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <initializer_list>
 #include <random>
 #include <vector>
@@ -34,28 +36,34 @@ TfLiteRegistration* Register_HADAMARD_ROTATION();
 namespace {
 
 using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
 using ::testing::Values;
 
+std::vector<uint8_t> HadamardRotationOptions(int size) {
+  flexbuffers::Builder fbb;
+  fbb.Map([&]() {
+    fbb.Int("hadamard_size", size);
+    auto start = fbb.StartVector("random_binary_vector");
+    for (int i = 0; i < size; ++i) {
+      fbb.Add(1);
+    }
+    fbb.EndVector(start, false, false);
+  });
+  fbb.Finish();
+  return fbb.GetBuffer();
+}
+
 class BaseHadamardRotationOpModel : public SingleOpModel {
  public:
   BaseHadamardRotationOpModel(const int size, const TensorData& input,
-                              const TensorData& output) {
+                              const TensorData& output, int num_threads = -1) {
     input1_ = AddInput(input);
     output1_ = AddOutput(output);
-
-    flexbuffers::Builder fbb;
-    fbb.Map([&]() {
-      fbb.Int("hadamard_size", size);
-      auto start = fbb.StartVector("random_binary_vector");
-      for (int i = 0; i < size; ++i) {
-        fbb.Add(1);
-      }
-      fbb.EndVector(start, false, false);
-    });
-    fbb.Finish();
-    SetCustomOp("aeq.hadamard_rotation", fbb.GetBuffer(),
+    SetCustomOp("aeq.hadamard_rotation", HadamardRotationOptions(size),
                 Register_HADAMARD_ROTATION);
-    BuildInterpreter({GetShape(input1_)});
+    BuildInterpreter({GetShape(input1_)}, num_threads,
+                     /*allow_fp32_relax_to_fp16=*/false,
+                     /*apply_delegate=*/true);
   }
 
   int input1() { return input1_; }
@@ -77,6 +85,41 @@ class BaseHadamardRotationOpModel : public SingleOpModel {
   int output1_;
 };
 
+// The rotation fused with the hybrid fully connected layer of `filter` and
+// `bias` consuming its output.
+class HadamardFullyConnectedOpModel : public SingleOpModel {
+ public:
+  HadamardFullyConnectedOpModel(const int size, const TensorData& input,
+                                const TensorData& filter,
+                                const TensorData& bias) {
+    input_ = AddInput(input);
+    filter_ = AddInput(filter);
+    bias_ = AddInput(bias);
+    output_ = AddOutput({TensorType_FLOAT32, {}});
+    SetCustomOp("aeq.hadamard_rotation", HadamardRotationOptions(size),
+                Register_HADAMARD_ROTATION);
+    BuildInterpreter({GetShape(input_), GetShape(filter_), GetShape(bias_)});
+  }
+
+  void SetInput(const std::vector<float>& data) {
+    PopulateTensor(input_, data);
+  }
+  void SetFilter(const std::vector<float>& data) {
+    SymmetricQuantizeAndPopulate(filter_, data);
+  }
+  void SetBias(const std::vector<float>& data) { PopulateTensor(bias_, data); }
+  float GetFilterScale() { return interpreter_->tensor(filter_)->params.scale; }
+
+  std::vector<float> GetOutput() { return ExtractVector<float>(output_); }
+  std::vector<int> GetOutputShape() { return GetTensorShape(output_); }
+
+ private:
+  int input_;
+  int filter_;
+  int bias_;
+  int output_;
+};
+
 class HadamardRotationOpTest : public ::testing::TestWithParam<int> {};
 
 TEST_P(HadamardRotationOpTest, BasicTest) {
@@ -164,6 +207,86 @@ TEST_P(HadamardRotationOpTest, RandomInputTest) {
   }
 }
 
+TEST_P(HadamardRotationOpTest, ThreadedRowsMatchSingleThreadedRows) {
+  int size = GetParam();
+  const int rows = 4096;
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<> dist(-1.0, 1.0);
+  std::vector<float> randoms;
+  for (int i = 0; i < rows * size; ++i) {
+    randoms.push_back(dist(gen));
+  }
+
+  BaseHadamardRotationOpModel single_threaded(
+      size, {TensorType_FLOAT32, {rows, size}},
+      {TensorType_FLOAT32, {rows, size}}, /*num_threads=*/1);
+  single_threaded.SetInput1<float>(randoms);
+  ASSERT_EQ(single_threaded.Invoke(), kTfLiteOk);
+  BaseHadamardRotationOpModel threaded(size, {TensorType_FLOAT32, {rows, size}},
+                                       {TensorType_FLOAT32, {rows, size}},
+                                       /*num_threads=*/4);
+  threaded.SetInput1<float>(randoms);
+  ASSERT_EQ(threaded.Invoke(), kTfLiteOk);
+  EXPECT_THAT(threaded.GetOutput1<float>(),
+              ElementsAreArray(single_threaded.GetOutput1<float>()));
+}
+
+TEST_P(HadamardRotationOpTest, FusedFullyConnectedMatchesRotatedInput) {
+  int size = GetParam();
+  // Rotate 3 rows of 2 vectors each, and multiply them by 5 units.
+  const int rows = 3;
+  const int depth = size * 2;
+  const int num_units = 5;
+  HadamardFullyConnectedOpModel m(size, {TensorType_FLOAT32, {1, rows, depth}},
+                                  {TensorType_INT8, {num_units, depth}},
+                                  {TensorType_FLOAT32, {num_units}});
+
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<> dist(-1.0, 1.0);
+  std::vector<float> input;
+  for (int i = 0; i < rows * depth; ++i) {
+    input.push_back(dist(gen));
+  }
+  std::vector<float> filter;
+  for (int i = 0; i < num_units * depth; ++i) {
+    filter.push_back(dist(gen));
+  }
+  const std::vector<float> bias = {0.5, -0.25, 0.0, 1.0, -1.0};
+  m.SetInput(input);
+  m.SetFilter(filter);
+  m.SetBias(bias);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(1, rows, num_units));
+
+  // Rotate the rows, then quantize them symmetrically like the hybrid fully
+  // connected layer does.
+  std::vector<float> expected;
+  const float filter_scale = m.GetFilterScale();
+  for (int row = 0; row < rows; ++row) {
+    float* rotated = input.data() + row * depth;
+    for (int i = 0; i < depth; i += size) {
+      recursive_FWHT(rotated + i, size);
+    }
+    float range = 0;
+    for (int i = 0; i < depth; ++i) {
+      range = std::max(range, std::abs(rotated[i]));
+    }
+    const float scale = range / 127;
+    for (int unit = 0; unit < num_units; ++unit) {
+      int32_t acc = 0;
+      for (int i = 0; i < depth; ++i) {
+        const int32_t quantized_input = std::round(rotated[i] / scale);
+        const int32_t quantized_filter =
+            std::round(filter[unit * depth + i] / filter_scale);
+        acc += quantized_input * quantized_filter;
+      }
+      expected.push_back(bias[unit] + acc * scale * filter_scale);
+    }
+  }
+  // Allow an off-by-one quantized input.
+  EXPECT_THAT(m.GetOutput(), ElementsAreArray(ArrayFloatNear(expected, 0.02)));
+}
+
 INSTANTIATE_TEST_SUITE_P(HadamardSizes, HadamardRotationOpTest,
                          Values(4, 16, 64));
 
@@ -714,8 +714,8 @@ TfLiteTensor CreateTensor(TfLiteType type,
 template <typename KeyType, typename ValueType>
 void InitHashtableResource(resource::ResourceMap* resources, int resource_id,
                            TfLiteType key_type, TfLiteType value_type,
-                           std::initializer_list<KeyType> keys,
-                           std::initializer_list<ValueType> values) {
+                           const std::vector<KeyType>& keys,
+                           const std::vector<ValueType>& values) {
   resource::CreateHashtableResourceIfNotAvailable(resources, resource_id,
                                                   key_type, value_type);
   auto lookup = resource::GetHashtableResource(resources, resource_id);
@@ -859,6 +859,62 @@ TEST(HashtableOpsTest, TestHashtableLookupInt64ToString) {
   EXPECT_THAT(m.GetOutputShape(), ElementsAreArray({3}));
 }
 
+TEST(HashtableOpsTest, TestHashtableLookupManyKeys) {
+  const int kResourceId = 42;
+  const int kNumKeys = 2000;
+  const int kNumLookups = 4001;
+  HashtableFindOpModel<std::int64_t, std::string> m(
+      TensorType_INT64, TensorType_STRING, kNumLookups);
+
+  std::vector<std::int64_t> keys;
+  std::vector<std::string> values;
+  for (int i = 0; i < kNumKeys; ++i) {
+    keys.push_back(i * 3 - 1000);
+    values.push_back(std::to_string(i));
+  }
+  // Every third lookup key is in the table.
+  std::vector<std::int64_t> lookup;
+  std::vector<std::string> expected;
+  for (int i = 0; i < kNumLookups; ++i) {
+    lookup.push_back(i - 1000);
+    expected.push_back(i % 3 == 0 && i / 3 < kNumKeys ? std::to_string(i / 3)
+                                                      : "default");
+  }
+
+  m.SetResourceId(kResourceId);
+  m.SetLookup(lookup);
+  m.SetStringDefaultValue({"default"});
+
+  InitHashtableResource<std::int64_t, std::string>(
+      &m.GetResources(), kResourceId, kTfLiteInt64, kTfLiteString, keys,
+      values);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutput<std::string>(), ElementsAreArray(expected));
+  EXPECT_THAT(m.GetOutputShape(), ElementsAreArray({kNumLookups}));
+}
+
+TEST(HashtableOpsTest, TestHashtableLookupDuplicateKeys) {
+  const int kResourceId = 42;
+  HashtableFindOpModel<std::string, std::int64_t> m(TensorType_STRING,
+                                                    TensorType_INT64, 3);
+
+  m.SetResourceId(kResourceId);
+  m.SetStringLookup({"5", "4", ""});
+  m.SetDefaultValue({-1});
+
+  // The first value of a key is kept.
+  InitHashtableResource<std::string, std::int64_t>(
+      &m.GetResources(), kResourceId, kTfLiteString, kTfLiteInt64,
+      {"4", "5", "4", ""}, {1, 2, 3, 4});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutput<std::int64_t>(), ElementsAreArray({2, 1, 4}));
+  EXPECT_EQ(resource::GetHashtableResource(&m.GetResources(), kResourceId)
+                ->Size(),
+            3u);
+}
+
 // HashtableImportOpModel creates a model with a HashtableImport op.
 template <typename KeyType, typename ValueType>
 class HashtableImportOpModel : public BaseHashtableOpModel {
@@ -26,6 +26,7 @@ limitations under the License.
 #include <cstring>
 #include <vector>
 
+#include "include/cpuinfo.h"
 #include "tflite/kernels/internal/cppmath.h"
 #include "tflite/kernels/internal/optimized/4bit/fully_connected_common.h"
 #include "tflite/kernels/internal/optimized/4bit/sse_fully_connected_impl.h"
@@ -34,6 +35,30 @@ namespace tflite {
 namespace optimized_4bit {
 #define is_aligned(ptr, bytes) ((((size_t)(ptr)) & (bytes - 1)) == 0)
 
+bool SseHasAvx2() {
+#ifdef FC_4BIT_SSE_AVX
+  static const bool has_avx2 = cpuinfo_initialize() && cpuinfo_has_x86_avx2();
+  return has_avx2;
+#else
+  return false;
+#endif
+}
+
+bool SseHasAvx512Vnni() {
+#ifdef FC_4BIT_SSE_AVX
+  static const bool has_avx512_vnni =
+      cpuinfo_initialize() && cpuinfo_has_x86_avx512f() &&
+      cpuinfo_has_x86_avx512bw() && cpuinfo_has_x86_avx512vnni();
+  return has_avx512_vnni;
+#else
+  return false;
+#endif
+}
+
+// The AVX-512 VNNI kernel keeps one accumulator per rhs row, which leaves
+// room for a wider tile of rhs rows.
+int SseGetMaxSupportedRows() { return SseHasAvx512Vnni() ? 8 : 4; }
+
 void SsePackInner(const int8_t* src, uint8_t* box, int src_rows, int src_cols,
                   int outer_row, int outer_col, int outer_rows, int outer_cols,
                   int inner_rows, int inner_cols) {
@@ -311,83 +336,115 @@ inline __m128i ReduceInt32x4x4(__m128i a, __m128i b, __m128i c, __m128i d) {
 }
 
 template <int RowsLeft, int RowsRight, int Cols>
-void SseRunKernel(const uint8_t* lhs, const int8_t* rhs, int32_t* dst,
-                  int lhs_layout_rows, int lhs_layout_cols, int rhs_layout_rows,
-                  int rhs_layout_cols, int dst_layout_rows,
-                  int dst_layout_cols) {
+void SseRunKernelSsse3(const uint8_t* lhs, const int8_t* rhs, int32_t* dst,
+                       int lhs_layout_rows, int lhs_layout_cols,
+                       int rhs_layout_rows, int rhs_layout_cols,
+                       int dst_layout_rows, int dst_layout_cols) {
   const int start_row = 0;
   const int start_col = 0;
   const int end_row = lhs_layout_rows;
   const int end_col = rhs_layout_rows;
   const int clamped_end_row = std::min(end_row, dst_layout_cols);
   const int clamped_end_col = std::min(end_col, dst_layout_rows);
-  int32_t* elementPtr = dst;
   const int outer_rows = (clamped_end_row + RowsLeft - 1) / RowsLeft;
   const int outer_cols = (clamped_end_col + RowsRight - 1) / RowsRight;
+  const int block_cols = SseRhsBlockRows(RowsRight, rhs_layout_cols);
   const int depth = std::min(lhs_layout_cols / Cols, rhs_layout_cols / Cols);
   const __m128i bitmask = _mm_set1_epi8(15);
   const uintptr_t padding = 15;
-  std::vector<uint8_t> lhs_vec_data((RowsLeft * lhs_layout_cols / 2) + padding);
-  uint8_t* lhs_vec = lhs_vec_data.data();
-  for (int i = start_row; i < outer_rows; ++i) {
-    int left_index = i * RowsLeft * lhs_layout_cols / 2;
-    const uint8_t* lhs_val_data = lhs + left_index;
-    if (!is_aligned(lhs_val_data, 16)) {
-      size_t size = RowsLeft * lhs_layout_cols / 2;
-      uintptr_t aligned =
-          (reinterpret_cast<uintptr_t>(lhs_vec) + padding) & ~(padding);
-      lhs_vec = reinterpret_cast<uint8_t*>(aligned);
-      memcpy(lhs_vec, lhs_val_data, size);
-      lhs_val_data = lhs_vec;
-    }
-    for (int j = start_col; j < outer_cols; ++j) {
-      const uint8_t* lhs_val = lhs_val_data;
-      int right_index = j * RowsRight * rhs_layout_cols;
-      const int8_t* rhs_val = rhs + right_index;
-      __m128i accum[RowsRight * RowsLeft];
-      for (int m = 0; m < (RowsLeft * RowsRight); ++m) {
-        accum[m] = _mm_set1_epi8(0);
+  std::vector<uint8_t> lhs_vec_data;
+  // For large batches, run all of lhs over one block of rhs at a time.
+  for (int block_col = start_col; block_col < outer_cols;
+       block_col += block_cols) {
+    const int end_block_col = std::min(outer_cols, block_col + block_cols);
+    for (int i = start_row; i < outer_rows; ++i) {
+      int left_index = i * RowsLeft * lhs_layout_cols / 2;
+      const uint8_t* lhs_val_data = lhs + left_index;
+      if (!is_aligned(lhs_val_data, 16)) {
+        size_t size = RowsLeft * lhs_layout_cols / 2;
+        lhs_vec_data.resize(size + padding);
+        uintptr_t aligned =
+            (reinterpret_cast<uintptr_t>(lhs_vec_data.data()) + padding) &
+            ~(padding);
+        uint8_t* lhs_vec = reinterpret_cast<uint8_t*>(aligned);
+        memcpy(lhs_vec, lhs_val_data, size);
+        lhs_val_data = lhs_vec;
       }
-      for (int k = 0; k < depth; ++k) {
-        __m128i lhs_row[RowsLeft];
-        for (int m = 0; m < RowsLeft; ++m) {
-          lhs_row[m] = _mm_load_si128((__m128i*)(lhs_val));
-          lhs_val += 16;
+      int32_t* elementPtr =
+          dst + (i * outer_cols + block_col) * RowsRight * RowsLeft;
+      for (int j = block_col; j < end_block_col; ++j) {
+        const uint8_t* lhs_val = lhs_val_data;
+        int right_index = j * RowsRight * rhs_layout_cols;
+        const int8_t* rhs_val = rhs + right_index;
+        __m128i accum[RowsRight * RowsLeft];
+        for (int m = 0; m < (RowsLeft * RowsRight); ++m) {
+          accum[m] = _mm_set1_epi8(0);
         }
-        __m128i rhs[RowsRight][2];
-        for (int m = 0; m < RowsRight; ++m) {
-          for (int n = 0; n < 2; ++n) {
-            rhs[m][n] = _mm_loadu_si128((__m128i*)(rhs_val));
-            rhs_val += 16;
+        for (int k = 0; k < depth; ++k) {
+          __m128i lhs_row[RowsLeft];
+          for (int m = 0; m < RowsLeft; ++m) {
+            lhs_row[m] = _mm_load_si128((__m128i*)(lhs_val));
+            lhs_val += 16;
           }
-        }
-        __m128i lhs_row_8[RowsLeft][2];
-        for (int m = 0; m < RowsLeft; ++m) {
-          lhs_row_8[m][0] = _mm_srli_epi16(lhs_row[m], 4);
-          lhs_row_8[m][1] = _mm_and_si128(lhs_row[m], bitmask);
-        }
-        for (int m = 0; m < RowsLeft; ++m) {
-          lhs_row_8[m][0] = _mm_and_si128(lhs_row_8[m][0], bitmask);
-        }
-        for (int i = 0; i < 2; ++i) {
-          for (int r = 0; r < RowsRight; ++r) {
-            for (int l = 0; l < RowsLeft; ++l) {
-              accum[r * RowsLeft + l] = DotProdInt8x4x4(
-                  accum[r * RowsLeft + l], lhs_row_8[l][i], rhs[r][i]);
+          __m128i rhs[RowsRight][2];
+          for (int m = 0; m < RowsRight; ++m) {
+            for (int n = 0; n < 2; ++n) {
+              rhs[m][n] = _mm_loadu_si128((__m128i*)(rhs_val));
+              rhs_val += 16;
+            }
+          }
+          __m128i lhs_row_8[RowsLeft][2];
+          for (int m = 0; m < RowsLeft; ++m) {
+            lhs_row_8[m][0] = _mm_srli_epi16(lhs_row[m], 4);
+            lhs_row_8[m][1] = _mm_and_si128(lhs_row[m], bitmask);
+          }
+          for (int m = 0; m < RowsLeft; ++m) {
+            lhs_row_8[m][0] = _mm_and_si128(lhs_row_8[m][0], bitmask);
+          }
+          for (int i = 0; i < 2; ++i) {
+            for (int r = 0; r < RowsRight; ++r) {
+              for (int l = 0; l < RowsLeft; ++l) {
+                accum[r * RowsLeft + l] = DotProdInt8x4x4(
+                    accum[r * RowsLeft + l], lhs_row_8[l][i], rhs[r][i]);
+              }
             }
           }
         }
-      }
-      for (int r = 0; r < RowsRight; ++r) {
-        __m128i sum =
-            ReduceInt32x4x4(accum[r * RowsLeft], accum[r * RowsLeft + 1],
-                            accum[r * RowsLeft + 2], accum[r * RowsLeft + 3]);
-        _mm_storeu_si128((__m128i*)elementPtr, sum);
-        elementPtr += 4;
+        for (int r = 0; r < RowsRight; ++r) {
+          __m128i sum =
+              ReduceInt32x4x4(accum[r * RowsLeft], accum[r * RowsLeft + 1],
+                              accum[r * RowsLeft + 2], accum[r * RowsLeft + 3]);
+          _mm_storeu_si128((__m128i*)elementPtr, sum);
+          elementPtr += 4;
+        }
       }
     }
   }
 }
+
+template <int RowsLeft, int RowsRight, int Cols>
+void SseRunKernel(const uint8_t* lhs, const int8_t* rhs, int32_t* dst,
+                  int lhs_layout_rows, int lhs_layout_cols, int rhs_layout_rows,
+                  int rhs_layout_cols, int dst_layout_rows,
+                  int dst_layout_cols) {
+#ifdef FC_4BIT_SSE_AVX
+  if (SseHasAvx512Vnni()) {
+    SseRunKernelAvx512Vnni<RowsLeft, RowsRight, Cols>(
+        lhs, rhs, dst, lhs_layout_rows, lhs_layout_cols, rhs_layout_rows,
+        rhs_layout_cols, dst_layout_rows, dst_layout_cols);
+    return;
+  }
+  if (SseHasAvx2()) {
+    SseRunKernelAvx2<RowsLeft, RowsRight, Cols>(
+        lhs, rhs, dst, lhs_layout_rows, lhs_layout_cols, rhs_layout_rows,
+        rhs_layout_cols, dst_layout_rows, dst_layout_cols);
+    return;
+  }
+#endif
+  SseRunKernelSsse3<RowsLeft, RowsRight, Cols>(
+      lhs, rhs, dst, lhs_layout_rows, lhs_layout_cols, rhs_layout_rows,
+      rhs_layout_cols, dst_layout_rows, dst_layout_cols);
+}
 // NOLINTEND
 
 template void SseUnpack<4, 1>(float* output_ptr, const int32_t* dst,
@@ -408,6 +465,12 @@ template void SseUnpack<4, 4>(float* output_ptr, const int32_t* dst,
                               const float* filter_scales, int dst_layout_rows,
                               int dst_layout_cols);
 
+template void SseUnpack<4, 8>(float* output_ptr, const int32_t* dst,
+                              int batch_size, int num_units,
+                              const float* scaling_factors,
+                              const float* filter_scales, int dst_layout_rows,
+                              int dst_layout_cols);
+
 template void SseRunKernel<4, 1, 32>(const uint8_t* lhs, const int8_t* rhs,
                                      int32_t* dst, int lhs_layout_rows,
                                      int lhs_layout_cols, int rhs_layout_rows,
@@ -426,6 +489,12 @@ template void SseRunKernel<4, 4, 32>(const uint8_t* lhs, const int8_t* rhs,
                                      int rhs_layout_cols, int dst_layout_rows,
                                      int dst_layout_cols);
 
+template void SseRunKernel<4, 8, 32>(const uint8_t* lhs, const int8_t* rhs,
+                                     int32_t* dst, int lhs_layout_rows,
+                                     int lhs_layout_cols, int rhs_layout_rows,
+                                     int rhs_layout_cols, int dst_layout_rows,
+                                     int dst_layout_cols);
+
 }  // namespace optimized_4bit
 }  // namespace tflite
 
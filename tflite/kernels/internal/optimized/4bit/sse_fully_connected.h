@@ -24,8 +24,8 @@ limitations under the License.
 namespace tflite {
 namespace optimized_4bit {
 
-// Maximum RowsRight compiled RunKernel implementations.
-inline int GetMaxSupportedRows() { return 4; }
+// Maximum RowsRight compiled RunKernel implementations, for this CPU.
+inline int GetMaxSupportedRows() { return SseGetMaxSupportedRows(); }
 
 // Pack a 4bit inner_rows x inner_cols array from src.
 inline void PackInner(const int8_t* src, uint8_t* box, int src_rows,
@@ -147,6 +147,26 @@ inline void RunKernel<4, 4, 32>(const uint8_t* lhs, const int8_t* rhs,
                          dst_layout_cols);
 }
 
+template <>
+inline void Unpack<4, 8>(float* output_ptr, const int32_t* dst, int batch_size,
+                         int num_units, const float* scaling_factors,
+                         const float* filter_scales, int dst_layout_rows,
+                         int dst_layout_cols) {
+  SseUnpack<4, 8>(output_ptr, dst, batch_size, num_units, scaling_factors,
+                  filter_scales, dst_layout_rows, dst_layout_cols);
+}
+
+template <>
+inline void RunKernel<4, 8, 32>(const uint8_t* lhs, const int8_t* rhs,
+                                int32_t* dst, int lhs_layout_rows,
+                                int lhs_layout_cols, int rhs_layout_rows,
+                                int rhs_layout_cols, int dst_layout_rows,
+                                int dst_layout_cols) {
+  SseRunKernel<4, 8, 32>(lhs, rhs, dst, lhs_layout_rows, lhs_layout_cols,
+                         rhs_layout_rows, rhs_layout_cols, dst_layout_rows,
+                         dst_layout_cols);
+}
+
 // Compute sum of lhs * rhs columnwise and write output to output_ptr.
 inline void RunAndUnpack(int rhs_width, const uint8_t* lhs, const int8_t* rhs,
                          int32_t* dst, int output_depth, int batch_size,
@@ -155,6 +175,14 @@ inline void RunAndUnpack(int rhs_width, const uint8_t* lhs, const int8_t* rhs,
                          int dst_layout_rows, int dst_layout_cols,
                          float* output_ptr, const float* scaling_factors,
                          const float* filter_scales) {
+  if (rhs_width >= 8) {
+    SseRunKernel<4, 8, 32>(lhs, rhs, dst, lhs_layout_rows, lhs_layout_cols,
+                           rhs_layout_rows, rhs_layout_cols, dst_layout_rows,
+                           dst_layout_cols);
+    SseUnpack<4, 8>(output_ptr, dst, batch_size, output_depth, scaling_factors,
+                    filter_scales, dst_layout_rows, dst_layout_cols);
+    return;
+  }
   if (rhs_width >= 4) {
     SseRunKernel<4, 4, 32>(lhs, rhs, dst, lhs_layout_rows, lhs_layout_cols,
                            rhs_layout_rows, rhs_layout_cols, dst_layout_rows,
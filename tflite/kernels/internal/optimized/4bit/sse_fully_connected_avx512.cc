@@ -0,0 +1,135 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/kernels/internal/optimized/4bit/sse_fully_connected_impl.h"
+
+#if defined(FC_4BIT_SSE) && defined(__SSSE3__) && defined(FC_4BIT_SSE_AVX)
+
+#include <stdint.h>
+
+// NOLINTBEGIN
+#include <immintrin.h>
+
+#include <algorithm>
+
+namespace tflite {
+namespace optimized_4bit {
+
+namespace {
+
+// Returns [a0123, b0123, c0123, d0123] from the 4 lanes of a, b, c and d.
+FC_4BIT_AVX512_VNNI inline __m128i ReduceInt32x4x4Avx512(__m128i a, __m128i b,
+                                                          __m128i c,
+                                                          __m128i d) {
+  const __m128i a_plus_b =
+      _mm_add_epi32(_mm_unpacklo_epi32(a, b), _mm_unpackhi_epi32(a, b));
+  const __m128i c_plus_d =
+      _mm_add_epi32(_mm_unpacklo_epi32(c, d), _mm_unpackhi_epi32(c, d));
+  return _mm_add_epi32(_mm_unpacklo_epi64(a_plus_b, c_plus_d),
+                       _mm_unpackhi_epi64(a_plus_b, c_plus_d));
+}
+
+}  // namespace
+
+// Same as SseRunKernel, with one 512-bit register holding the 4 lhs rows of
+// a 32-value block, multiplied by a rhs row broadcast to the 4 128-bit lanes
+// and accumulated by _mm512_dpbusd_epi32. Each rhs row needs only two
+// accumulators, on which the lane l holds the partial sums of lhs row l.
+template <int RowsLeft, int RowsRight, int Cols>
+FC_4BIT_AVX512_VNNI void SseRunKernelAvx512Vnni(
+    const uint8_t* lhs, const int8_t* rhs, int32_t* dst, int lhs_layout_rows,
+    int lhs_layout_cols, int rhs_layout_rows, int rhs_layout_cols,
+    int dst_layout_rows, int dst_layout_cols) {
+  static_assert(RowsLeft == 4, "The lhs rows are read 4 at a time");
+  const int clamped_end_row = std::min(lhs_layout_rows, dst_layout_cols);
+  const int clamped_end_col = std::min(rhs_layout_rows, dst_layout_rows);
+  const int outer_rows = (clamped_end_row + RowsLeft - 1) / RowsLeft;
+  const int outer_cols = (clamped_end_col + RowsRight - 1) / RowsRight;
+  const int block_cols = SseRhsBlockRows(RowsRight, rhs_layout_cols);
+  const int depth = std::min(lhs_layout_cols / Cols, rhs_layout_cols / Cols);
+  const __m512i bitmask = _mm512_set1_epi8(15);
+  for (int block_col = 0; block_col < outer_cols; block_col += block_cols) {
+    const int end_block_col = std::min(outer_cols, block_col + block_cols);
+    for (int i = 0; i < outer_rows; ++i) {
+      const uint8_t* lhs_val_data = lhs + i * RowsLeft * lhs_layout_cols / 2;
+      int32_t* element_ptr =
+          dst + (i * outer_cols + block_col) * RowsRight * RowsLeft;
+      for (int j = block_col; j < end_block_col; ++j) {
+        const uint8_t* lhs_val = lhs_val_data;
+        const int8_t* rhs_val = rhs + j * RowsRight * rhs_layout_cols;
+        // The products of the upper and the lower 4 bits are accumulated
+        // separately, for two independent chains of additions.
+        __m512i accum[RowsRight][2];
+        for (int r = 0; r < RowsRight; ++r) {
+          accum[r][0] = _mm512_setzero_si512();
+          accum[r][1] = _mm512_setzero_si512();
+        }
+        for (int k = 0; k < depth; ++k) {
+          const __m512i lhs_rows = _mm512_loadu_si512(lhs_val);
+          lhs_val += 64;
+          const __m512i lhs_upper =
+              _mm512_and_si512(_mm512_srli_epi16(lhs_rows, 4), bitmask);
+          const __m512i lhs_lower = _mm512_and_si512(lhs_rows, bitmask);
+          for (int r = 0; r < RowsRight; ++r) {
+            const __m512i rhs_upper = _mm512_broadcast_i32x4(
+                _mm_loadu_si128((const __m128i*)(rhs_val)));
+            const __m512i rhs_lower = _mm512_broadcast_i32x4(
+                _mm_loadu_si128((const __m128i*)(rhs_val + 16)));
+            rhs_val += 32;
+            accum[r][0] =
+                _mm512_dpbusd_epi32(accum[r][0], lhs_upper, rhs_upper);
+            accum[r][1] =
+                _mm512_dpbusd_epi32(accum[r][1], lhs_lower, rhs_lower);
+          }
+        }
+        for (int r = 0; r < RowsRight; ++r) {
+          const __m512i accum_r = _mm512_add_epi32(accum[r][0], accum[r][1]);
+          const __m128i sum =
+              ReduceInt32x4x4Avx512(_mm512_extracti32x4_epi32(accum_r, 0),
+                                    _mm512_extracti32x4_epi32(accum_r, 1),
+                                    _mm512_extracti32x4_epi32(accum_r, 2),
+                                    _mm512_extracti32x4_epi32(accum_r, 3));
+          _mm_storeu_si128((__m128i*)element_ptr, sum);
+          element_ptr += 4;
+        }
+      }
+    }
+  }
+}
+// NOLINTEND
+
+template void SseRunKernelAvx512Vnni<4, 1, 32>(
+    const uint8_t* lhs, const int8_t* rhs, int32_t* dst, int lhs_layout_rows,
+    int lhs_layout_cols, int rhs_layout_rows, int rhs_layout_cols,
+    int dst_layout_rows, int dst_layout_cols);
+
+template void SseRunKernelAvx512Vnni<4, 2, 32>(
+    const uint8_t* lhs, const int8_t* rhs, int32_t* dst, int lhs_layout_rows,
+    int lhs_layout_cols, int rhs_layout_rows, int rhs_layout_cols,
+    int dst_layout_rows, int dst_layout_cols);
+
+template void SseRunKernelAvx512Vnni<4, 4, 32>(
+    const uint8_t* lhs, const int8_t* rhs, int32_t* dst, int lhs_layout_rows,
+    int lhs_layout_cols, int rhs_layout_rows, int rhs_layout_cols,
+    int dst_layout_rows, int dst_layout_cols);
+
+template void SseRunKernelAvx512Vnni<4, 8, 32>(
+    const uint8_t* lhs, const int8_t* rhs, int32_t* dst, int lhs_layout_rows,
+    int lhs_layout_cols, int rhs_layout_rows, int rhs_layout_cols,
+    int dst_layout_rows, int dst_layout_cols);
+
+}  // namespace optimized_4bit
+}  // namespace tflite
+
+#endif  // defined(FC_4BIT_SSE) && defined(__SSSE3__) && ...
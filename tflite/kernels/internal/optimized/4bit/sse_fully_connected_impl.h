@@ -23,9 +23,35 @@ limitations under the License.
 #define EIGEN_MAX_ALIGN_BYTES 64
 #endif
 
+// The AVX2 and AVX-512 VNNI kernels are compiled with function target
+// attributes, and chosen at runtime when the CPU supports them.
+#if defined(__GNUC__) || defined(__clang__)
+#define FC_4BIT_SSE_AVX
+#define FC_4BIT_AVX2 __attribute__((target("avx2")))
+#define FC_4BIT_AVX512_VNNI \
+  __attribute__((target("avx512f,avx512bw,avx512vnni")))
+#endif
+
 namespace tflite {
 namespace optimized_4bit {
 
+// The kernels iterate over blocks of rhs rows of at most this many bytes, so
+// that a block stays in the L2 cache while all of lhs is streamed over it.
+constexpr int kSseRhsBlockSize = 128 * 1024;
+
+// Returns the number of rhs rows of RowsRight batches in a block.
+inline int SseRhsBlockRows(int rows_right, int rhs_layout_cols) {
+  const int rows = kSseRhsBlockSize / (rows_right * rhs_layout_cols);
+  return rows > 0 ? rows : 1;
+}
+
+// Returns whether the CPU supports the AVX2 and AVX-512 VNNI kernels.
+bool SseHasAvx2();
+bool SseHasAvx512Vnni();
+
+// Maximum RowsRight of the kernels chosen for this CPU.
+int SseGetMaxSupportedRows();
+
 void SsePackInner(const int8_t* src, uint8_t* box, int src_rows, int src_cols,
                   int outer_row, int outer_col, int outer_rows, int outer_cols,
                   int inner_rows, int inner_cols);
@@ -57,6 +83,20 @@ extern void SseRunKernel(const uint8_t* lhs, const int8_t* rhs, int32_t* dst,
                          int rhs_layout_rows, int rhs_layout_cols,
                          int dst_layout_rows, int dst_layout_cols);
 
+#ifdef FC_4BIT_SSE_AVX
+template <int RowsLeft, int RowsRight, int Cols>
+extern FC_4BIT_AVX2 void SseRunKernelAvx2(
+    const uint8_t* lhs, const int8_t* rhs, int32_t* dst, int lhs_layout_rows,
+    int lhs_layout_cols, int rhs_layout_rows, int rhs_layout_cols,
+    int dst_layout_rows, int dst_layout_cols);
+
+template <int RowsLeft, int RowsRight, int Cols>
+extern FC_4BIT_AVX512_VNNI void SseRunKernelAvx512Vnni(
+    const uint8_t* lhs, const int8_t* rhs, int32_t* dst, int lhs_layout_rows,
+    int lhs_layout_cols, int rhs_layout_rows, int rhs_layout_cols,
+    int dst_layout_rows, int dst_layout_cols);
+#endif  // FC_4BIT_SSE_AVX
+
 }  // namespace optimized_4bit
 }  // namespace tflite
 
@@ -0,0 +1,322 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_BATCH_MATMUL_H_
+#define TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_BATCH_MATMUL_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "ruy/profiler/instrumentation.h"  // from @ruy
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/cpu_backend_gemm.h"
+#include "tflite/kernels/cpu_backend_gemm_params.h"
+#include "tflite/kernels/cpu_backend_threadpool.h"
+#include "tflite/kernels/internal/common.h"
+#include "tflite/kernels/internal/compatibility.h"
+#include "tflite/kernels/internal/runtime_shape.h"
+#include "tflite/kernels/internal/types.h"
+
+namespace tflite {
+namespace optimized_ops {
+namespace batch_matmul_internal {
+
+// Matrix multiplies of at most this many multiply-adds are computed directly
+// instead of through cpu_backend_gemm, whose packing and dispatch cost about
+// as much as such small products, e.g. those of attention heads over short
+// sequences.
+constexpr int kMaxSmallMatMulSize = 16384;
+// The small matrix multiplies are split in tasks of at least this many
+// multiply-adds.
+constexpr int kMinSmallMatMulTaskSize = 65536;
+// Number of independent accumulators of the dot products, for the compiler to
+// vectorize them.
+constexpr int kLanes = 8;
+
+// The matrix multiplies of a batch matrix multiply with the parameters of
+// reference_ops::BatchMatMul: `lhs_rows` x `accum_depth` row major lhs
+// matrices, `accum_depth` x `rhs_cols` column major rhs matrices, and
+// `lhs_rows` x `rhs_cols` column major output matrices, broadcast over three
+// batch dimensions.
+//
+// The innermost batch dimensions over which the lhs is broadcast are folded
+// into the columns of the rhs and of the output, which are contiguous across
+// these batches: each distinct lhs matrix is then multiplied, and packed, once
+// for all the rhs matrices it applies to.
+struct BatchMatMulBatches {
+  BatchMatMulBatches(const RuntimeShape& lhs_shape,
+                     const RuntimeShape& rhs_shape) {
+    const RuntimeShape extended_lhs_shape =
+        RuntimeShape::ExtendedShape(5, lhs_shape);
+    const RuntimeShape extended_rhs_shape =
+        RuntimeShape::ExtendedShape(5, rhs_shape);
+    lhs_rows = extended_lhs_shape.Dims(3);
+    rhs_cols = extended_rhs_shape.Dims(4);
+    accum_depth = extended_lhs_shape.Dims(4);
+    int lhs_size = lhs_rows * accum_depth;
+    int rhs_size = rhs_cols * accum_depth;
+    bool fold = true;
+    for (int i = 2; i >= 0; --i) {
+      const int lhs_dim = extended_lhs_shape.Dims(i);
+      const int rhs_dim = extended_rhs_shape.Dims(i);
+      fold = fold && lhs_dim == 1;
+      if (fold) {
+        rhs_cols *= rhs_dim;
+        rhs_size *= rhs_dim;
+        dims[i] = 1;
+        lhs_strides[i] = 0;
+        rhs_strides[i] = 0;
+        continue;
+      }
+      dims[i] = std::max(lhs_dim, rhs_dim);
+      lhs_strides[i] = lhs_dim == 1 ? 0 : lhs_size;
+      rhs_strides[i] = rhs_dim == 1 ? 0 : rhs_size;
+      lhs_size *= lhs_dim;
+      rhs_size *= rhs_dim;
+    }
+  }
+
+  int num_batches() const { return dims[0] * dims[1] * dims[2]; }
+  int OutputSize() const { return lhs_rows * rhs_cols; }
+  int64_t MatMulSize() const {
+    return static_cast<int64_t>(lhs_rows) * rhs_cols * accum_depth;
+  }
+  int LhsOffset(int batch) const {
+    return (batch / (dims[1] * dims[2])) * lhs_strides[0] +
+           (batch / dims[2] % dims[1]) * lhs_strides[1] +
+           (batch % dims[2]) * lhs_strides[2];
+  }
+  int RhsOffset(int batch) const {
+    return (batch / (dims[1] * dims[2])) * rhs_strides[0] +
+           (batch / dims[2] % dims[1]) * rhs_strides[1] +
+           (batch % dims[2]) * rhs_strides[2];
+  }
+
+  int lhs_rows;
+  int rhs_cols;
+  int accum_depth;
+  int dims[3];
+  int lhs_strides[3];
+  int rhs_strides[3];
+};
+
+inline float Dot(const float* lhs, const float* rhs, int size) {
+  float lanes[kLanes] = {};
+  int k = 0;
+  for (; k + kLanes <= size; k += kLanes) {
+    for (int lane = 0; lane < kLanes; ++lane) {
+      lanes[lane] += lhs[k + lane] * rhs[k + lane];
+    }
+  }
+  float total = 0.0f;
+  for (int lane = 0; lane < kLanes; ++lane) total += lanes[lane];
+  for (; k < size; ++k) total += lhs[k] * rhs[k];
+  return total;
+}
+
+inline int32_t Dot(const int8_t* lhs, const int8_t* rhs, int size,
+                   int32_t lhs_offset, int32_t rhs_offset) {
+  int32_t lanes[kLanes] = {};
+  int k = 0;
+  for (; k + kLanes <= size; k += kLanes) {
+    for (int lane = 0; lane < kLanes; ++lane) {
+      lanes[lane] +=
+          (lhs[k + lane] + lhs_offset) * (rhs[k + lane] + rhs_offset);
+    }
+  }
+  int32_t total = 0;
+  for (int lane = 0; lane < kLanes; ++lane) total += lanes[lane];
+  for (; k < size; ++k) total += (lhs[k] + lhs_offset) * (rhs[k] + rhs_offset);
+  return total;
+}
+
+template <typename Work>
+struct SmallMatMulTask : cpu_backend_threadpool::Task {
+  SmallMatMulTask(const Work& work, int begin, int end)
+      : work(work), begin(begin), end(end) {}
+  void Run() override { work(begin, end); }
+
+  const Work& work;
+  int begin;
+  int end;
+};
+
+// Runs `work(begin, end)` over the batches [0, num_batches) of small matrix
+// multiplies, split across the threads of `cpu_backend_context`.
+template <typename Work>
+void ForEachSmallMatMul(const BatchMatMulBatches& batches,
+                        CpuBackendContext* cpu_backend_context,
+                        const Work& work) {
+  const int num_batches = batches.num_batches();
+  const int num_tasks = static_cast<int>(std::min<int64_t>(
+      {cpu_backend_context->max_num_threads(), num_batches,
+       batches.MatMulSize() * num_batches / kMinSmallMatMulTaskSize}));
+  if (num_tasks <= 1) {
+    work(0, num_batches);
+    return;
+  }
+  std::vector<SmallMatMulTask<Work>> tasks;
+  tasks.reserve(num_tasks);
+  for (int i = 0; i < num_tasks; ++i) {
+    tasks.emplace_back(work, static_cast<int64_t>(num_batches) * i / num_tasks,
+                       static_cast<int64_t>(num_batches) * (i + 1) / num_tasks);
+  }
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                  cpu_backend_context);
+}
+
+// Whether to compute the matrix multiplies directly: they are small, and there
+// are several of them to amortize the dispatch of the threads over.
+inline bool UseSmallMatMul(const BatchMatMulBatches& batches) {
+  return batches.num_batches() > 1 &&
+         batches.MatMulSize() <= kMaxSmallMatMulSize;
+}
+
+}  // namespace batch_matmul_internal
+
+// Same as reference_ops::BatchMatMul, computed with cpu_backend_gemm. The lhs
+// is typically the weights of the op, and its packed form is cached across
+// invocations if `params.lhs_cacheable`.
+inline void BatchMatMul(const FullyConnectedParams& params,
+                        const RuntimeShape& lhs_shape, const float* lhs_data,
+                        const RuntimeShape& rhs_shape, const float* rhs_data,
+                        const RuntimeShape& output_shape, float* output_data,
+                        CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("BatchMatMul");
+  const batch_matmul_internal::BatchMatMulBatches batches(lhs_shape,
+                                                          rhs_shape);
+  const int lhs_rows = batches.lhs_rows;
+  const int rhs_cols = batches.rhs_cols;
+  const int accum_depth = batches.accum_depth;
+  if (batch_matmul_internal::UseSmallMatMul(batches)) {
+    batch_matmul_internal::ForEachSmallMatMul(
+        batches, cpu_backend_context, [&](int begin, int end) {
+          for (int b = begin; b < end; ++b) {
+            const float* lhs = lhs_data + batches.LhsOffset(b);
+            const float* rhs = rhs_data + batches.RhsOffset(b);
+            float* output = output_data + b * batches.OutputSize();
+            for (int j = 0; j < rhs_cols; ++j) {
+              for (int i = 0; i < lhs_rows; ++i) {
+                output[j * lhs_rows + i] = batch_matmul_internal::Dot(
+                    lhs + i * accum_depth, rhs + j * accum_depth, accum_depth);
+              }
+            }
+          }
+        });
+    return;
+  }
+
+  cpu_backend_gemm::MatrixParams<float> lhs_params;
+  lhs_params.order = cpu_backend_gemm::Order::kRowMajor;
+  lhs_params.rows = lhs_rows;
+  lhs_params.cols = accum_depth;
+  lhs_params.cache_policy =
+      cpu_backend_gemm::DefaultCachePolicy(params.lhs_cacheable);
+  cpu_backend_gemm::MatrixParams<float> rhs_params;
+  rhs_params.order = cpu_backend_gemm::Order::kColMajor;
+  rhs_params.rows = accum_depth;
+  rhs_params.cols = rhs_cols;
+  rhs_params.cache_policy =
+      cpu_backend_gemm::DefaultCachePolicy(params.rhs_cacheable);
+  cpu_backend_gemm::MatrixParams<float> dst_params;
+  dst_params.order = cpu_backend_gemm::Order::kColMajor;
+  dst_params.rows = lhs_rows;
+  dst_params.cols = rhs_cols;
+  cpu_backend_gemm::GemmParams<float, float> gemm_params;
+  for (int b = 0; b < batches.num_batches(); ++b) {
+    cpu_backend_gemm::Gemm(lhs_params, lhs_data + batches.LhsOffset(b),
+                           rhs_params, rhs_data + batches.RhsOffset(b),
+                           dst_params, output_data + b * batches.OutputSize(),
+                           gemm_params, cpu_backend_context);
+  }
+}
+
+// Same as above, on int8 matrices quantized per tensor as described by
+// `params`, as in reference_ops::BatchMatMul.
+inline void BatchMatMul(const FullyConnectedParams& params,
+                        const RuntimeShape& lhs_shape, const int8_t* lhs_data,
+                        const RuntimeShape& rhs_shape, const int8_t* rhs_data,
+                        const RuntimeShape& output_shape, int8_t* output_data,
+                        CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("BatchMatMul/Int8");
+  const batch_matmul_internal::BatchMatMulBatches batches(lhs_shape,
+                                                          rhs_shape);
+  const int lhs_rows = batches.lhs_rows;
+  const int rhs_cols = batches.rhs_cols;
+  const int accum_depth = batches.accum_depth;
+  const int32_t output_activation_min = params.quantized_activation_min;
+  const int32_t output_activation_max = params.quantized_activation_max;
+  TFLITE_DCHECK_LE(output_activation_min, output_activation_max);
+  if (batch_matmul_internal::UseSmallMatMul(batches)) {
+    batch_matmul_internal::ForEachSmallMatMul(
+        batches, cpu_backend_context, [&](int begin, int end) {
+          for (int b = begin; b < end; ++b) {
+            const int8_t* lhs = lhs_data + batches.LhsOffset(b);
+            const int8_t* rhs = rhs_data + batches.RhsOffset(b);
+            int8_t* output = output_data + b * batches.OutputSize();
+            for (int j = 0; j < rhs_cols; ++j) {
+              for (int i = 0; i < lhs_rows; ++i) {
+                const int32_t total = batch_matmul_internal::Dot(
+                    lhs + i * accum_depth, rhs + j * accum_depth, accum_depth,
+                    params.weights_offset, params.input_offset);
+                int32_t total_scaled = MultiplyByQuantizedMultiplier(
+                    total, params.output_multiplier, params.output_shift);
+                total_scaled += params.output_offset;
+                total_scaled = std::max(total_scaled, output_activation_min);
+                total_scaled = std::min(total_scaled, output_activation_max);
+                output[j * lhs_rows + i] = static_cast<int8_t>(total_scaled);
+              }
+            }
+          }
+        });
+    return;
+  }
+
+  cpu_backend_gemm::MatrixParams<int8_t> lhs_params;
+  lhs_params.order = cpu_backend_gemm::Order::kRowMajor;
+  lhs_params.rows = lhs_rows;
+  lhs_params.cols = accum_depth;
+  lhs_params.zero_point = -params.weights_offset;
+  lhs_params.cache_policy =
+      cpu_backend_gemm::DefaultCachePolicy(params.lhs_cacheable);
+  cpu_backend_gemm::MatrixParams<int8_t> rhs_params;
+  rhs_params.order = cpu_backend_gemm::Order::kColMajor;
+  rhs_params.rows = accum_depth;
+  rhs_params.cols = rhs_cols;
+  rhs_params.zero_point = -params.input_offset;
+  rhs_params.cache_policy =
+      cpu_backend_gemm::DefaultCachePolicy(params.rhs_cacheable);
+  cpu_backend_gemm::MatrixParams<int8_t> dst_params;
+  dst_params.order = cpu_backend_gemm::Order::kColMajor;
+  dst_params.rows = lhs_rows;
+  dst_params.cols = rhs_cols;
+  dst_params.zero_point = params.output_offset;
+  cpu_backend_gemm::GemmParams<int32_t, int8_t> gemm_params;
+  gemm_params.clamp_min = output_activation_min;
+  gemm_params.clamp_max = output_activation_max;
+  gemm_params.multiplier_fixedpoint = params.output_multiplier;
+  gemm_params.multiplier_exponent = params.output_shift;
+  for (int b = 0; b < batches.num_batches(); ++b) {
+    cpu_backend_gemm::Gemm(lhs_params, lhs_data + batches.LhsOffset(b),
+                           rhs_params, rhs_data + batches.RhsOffset(b),
+                           dst_params, output_data + b * batches.OutputSize(),
+                           gemm_params, cpu_backend_context);
+  }
+}
+
+}  // namespace optimized_ops
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_BATCH_MATMUL_H_
@@ -0,0 +1,196 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_FUSED_RESIDUAL_H_
+#define TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_FUSED_RESIDUAL_H_
+
+#include <algorithm>
+#include <cstdint>
+
+#include "ruy/profiler/instrumentation.h"  // from @ruy
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/cpu_backend_gemm.h"
+#include "tflite/kernels/cpu_backend_gemm_params.h"
+#include "tflite/kernels/internal/compatibility.h"
+#include "tflite/kernels/internal/cppmath.h"
+#include "tflite/kernels/internal/runtime_shape.h"
+#include "tflite/kernels/internal/types.h"
+
+namespace tflite {
+namespace optimized_ops {
+namespace fused_residual_internal {
+
+// The matrix multiply is computed in blocks of rows of the output of about
+// this many values, which the residual is added to while they are still in
+// the cache.
+constexpr int kBlockSize = 32768;
+constexpr int kMinBlockRows = 16;
+
+inline int BlockRows(int num_rows, int output_depth) {
+  return std::min(num_rows, std::max(kMinBlockRows, kBlockSize / output_depth));
+}
+
+// Returns `filter_shape` as the [output_depth, accum_depth] matrix it is
+// multiplied by, and the number of rows of the input and output matrices.
+inline void GetResidualGemmShape(const RuntimeShape& input_shape,
+                                 const RuntimeShape& filter_shape,
+                                 const RuntimeShape& output_shape,
+                                 int* output_depth, int* accum_depth,
+                                 int* num_rows) {
+  *output_depth = filter_shape.Dims(0);
+  *accum_depth = filter_shape.FlatSize() / *output_depth;
+  *num_rows = input_shape.FlatSize() / *accum_depth;
+  TFLITE_DCHECK_EQ(input_shape.FlatSize(), *num_rows * *accum_depth);
+  TFLITE_DCHECK_EQ(output_shape.FlatSize(), *num_rows * *output_depth);
+}
+
+}  // namespace fused_residual_internal
+
+// Returns the number of int32_t values of the scratch buffer of the int8_t
+// FullyConnectedResidualAdd.
+inline int FullyConnectedResidualAddScratchSize(
+    const RuntimeShape& filter_shape, const RuntimeShape& output_shape) {
+  const int output_depth = filter_shape.Dims(0);
+  const int num_rows = output_shape.FlatSize() / output_depth;
+  return fused_residual_internal::BlockRows(num_rows, output_depth) *
+         output_depth;
+}
+
+// Computes the rows of `input_data` multiplied by the [output_depth, ...]
+// filter, as a fully connected layer or a pointwise convolution over the
+// innermost dimension does, adds the residual to them, and clamps the sums:
+//
+//   output = clamp(clamp(input * filter^T + bias, product_min, product_max)
+//                  + residual, activation_min, activation_max)
+//
+// without writing the products to memory first.
+inline void FullyConnectedResidualAdd(
+    const FusedResidualParams& params, const RuntimeShape& input_shape,
+    const float* input_data, const RuntimeShape& filter_shape,
+    const float* filter_data, const float* bias_data,
+    const float* residual_data, const RuntimeShape& output_shape,
+    float* output_data, CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("FullyConnectedResidualAdd");
+  int output_depth;
+  int accum_depth;
+  int num_rows;
+  fused_residual_internal::GetResidualGemmShape(input_shape, filter_shape,
+                                                output_shape, &output_depth,
+                                                &accum_depth, &num_rows);
+  const int block_rows =
+      fused_residual_internal::BlockRows(num_rows, output_depth);
+
+  cpu_backend_gemm::MatrixParams<float> lhs_params;
+  lhs_params.order = cpu_backend_gemm::Order::kRowMajor;
+  lhs_params.rows = output_depth;
+  lhs_params.cols = accum_depth;
+  lhs_params.cache_policy = cpu_backend_gemm::CachePolicy::kCacheIfLargeSpeedup;
+  cpu_backend_gemm::MatrixParams<float> rhs_params;
+  rhs_params.order = cpu_backend_gemm::Order::kColMajor;
+  rhs_params.rows = accum_depth;
+  cpu_backend_gemm::MatrixParams<float> dst_params;
+  dst_params.order = cpu_backend_gemm::Order::kColMajor;
+  dst_params.rows = output_depth;
+  cpu_backend_gemm::GemmParams<float, float> gemm_params;
+  gemm_params.bias = bias_data;
+  gemm_params.clamp_min = params.product_min;
+  gemm_params.clamp_max = params.product_max;
+  for (int row = 0; row < num_rows; row += block_rows) {
+    const int rows = std::min(block_rows, num_rows - row);
+    rhs_params.cols = rows;
+    dst_params.cols = rows;
+    float* output = output_data + row * output_depth;
+    const float* residual = residual_data + row * output_depth;
+    cpu_backend_gemm::Gemm(lhs_params, filter_data, rhs_params,
+                           input_data + row * accum_depth, dst_params, output,
+                           gemm_params, cpu_backend_context);
+    for (int i = 0; i < rows * output_depth; ++i) {
+      output[i] = std::min(
+          std::max(output[i] + residual[i], params.float_activation_min),
+          params.float_activation_max);
+    }
+  }
+}
+
+// Same as above on quantized tensors. The products are not requantized to
+// int8_t before they are added, their accumulators are scaled by
+// `params.product_scales` and summed with the residual as real values, then
+// quantized once. `scratch` holds FullyConnectedResidualAddScratchSize()
+// accumulators.
+inline void FullyConnectedResidualAdd(
+    const FusedResidualParams& params, const RuntimeShape& input_shape,
+    const int8_t* input_data, const RuntimeShape& filter_shape,
+    const int8_t* filter_data, const int32_t* bias_data,
+    const int8_t* residual_data, const RuntimeShape& output_shape,
+    int8_t* output_data, int32_t* scratch,
+    CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("FullyConnectedResidualAdd/Int8");
+  int output_depth;
+  int accum_depth;
+  int num_rows;
+  fused_residual_internal::GetResidualGemmShape(input_shape, filter_shape,
+                                                output_shape, &output_depth,
+                                                &accum_depth, &num_rows);
+  const int block_rows =
+      fused_residual_internal::BlockRows(num_rows, output_depth);
+
+  cpu_backend_gemm::MatrixParams<int8_t> lhs_params;
+  lhs_params.order = cpu_backend_gemm::Order::kRowMajor;
+  lhs_params.rows = output_depth;
+  lhs_params.cols = accum_depth;
+  lhs_params.cache_policy = cpu_backend_gemm::CachePolicy::kCacheIfLargeSpeedup;
+  cpu_backend_gemm::MatrixParams<int8_t> rhs_params;
+  rhs_params.order = cpu_backend_gemm::Order::kColMajor;
+  rhs_params.rows = accum_depth;
+  rhs_params.zero_point = params.input_zero_point;
+  cpu_backend_gemm::MatrixParams<int32_t> dst_params;
+  dst_params.order = cpu_backend_gemm::Order::kColMajor;
+  dst_params.rows = output_depth;
+  cpu_backend_gemm::GemmParams<int32_t, int32_t> gemm_params;
+  gemm_params.bias = bias_data;
+  const float inverse_output_scale = 1.0f / params.output_scale;
+  const float activation_min = params.quantized_activation_min;
+  const float activation_max = params.quantized_activation_max;
+  for (int row = 0; row < num_rows; row += block_rows) {
+    const int rows = std::min(block_rows, num_rows - row);
+    rhs_params.cols = rows;
+    dst_params.cols = rows;
+    cpu_backend_gemm::Gemm(lhs_params, filter_data, rhs_params,
+                           input_data + row * accum_depth, dst_params, scratch,
+                           gemm_params, cpu_backend_context);
+    const int8_t* residual = residual_data + row * output_depth;
+    int8_t* output = output_data + row * output_depth;
+    for (int r = 0; r < rows; ++r) {
+      const int offset = r * output_depth;
+      for (int c = 0; c < output_depth; ++c) {
+        const float product = std::min(
+            std::max(scratch[offset + c] * params.product_scales[c],
+                     params.product_min),
+            params.product_max);
+        const float sum =
+            product + (residual[offset + c] - params.residual_zero_point) *
+                          params.residual_scale;
+        const float quantized =
+            TfLiteRound(sum * inverse_output_scale) + params.output_zero_point;
+        output[offset + c] = static_cast<int8_t>(
+            std::min(std::max(quantized, activation_min), activation_max));
+      }
+    }
+  }
+}
+
+}  // namespace optimized_ops
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_FUSED_RESIDUAL_H_
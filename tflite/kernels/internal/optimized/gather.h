@@ -0,0 +1,226 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_GATHER_H_
+#define TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_GATHER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "ruy/profiler/instrumentation.h"  // from @ruy
+#include "tflite/core/c/c_api_types.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/cpu_backend_threadpool.h"
+#include "tflite/kernels/internal/common.h"
+#include "tflite/kernels/internal/compatibility.h"
+#include "tflite/kernels/internal/reference/reference_ops.h"
+#include "tflite/kernels/internal/runtime_shape.h"
+#include "tflite/kernels/internal/types.h"
+
+namespace tflite {
+namespace optimized_ops {
+namespace gather_internal {
+
+// Gathers are split in tasks copying at least this many bytes.
+constexpr size_t kMinBytesPerTask = 64 * 1024;
+// How many rows ahead of the one being copied are prefetched, since the rows
+// are usually not contiguous.
+constexpr int kPrefetchDistance = 4;
+// How many bytes of each row are prefetched, the hardware prefetcher taking
+// over for longer rows.
+constexpr size_t kMaxPrefetchBytes = 512;
+
+template <typename RowFn>
+struct RowsTask : cpu_backend_threadpool::Task {
+  RowsTask(const RowFn& row_fn, int begin, int end)
+      : row_fn(row_fn), begin(begin), end(end) {}
+  void Run() override {
+    for (int row = begin; row < end; ++row) row_fn(row);
+  }
+
+  const RowFn& row_fn;
+  int begin;
+  int end;
+};
+
+// Calls `row_fn(row)` for each row of [0, num_rows), from several threads of
+// `cpu_backend_context` if it is set and the rows add up to enough bytes.
+// `row_fn` must not fail.
+//
+// WARNING: This is an experimental API and subject to change.
+template <typename RowFn>
+void ForEachRow(int num_rows, size_t row_bytes,
+                CpuBackendContext* cpu_backend_context, const RowFn& row_fn) {
+  int num_tasks = 1;
+  if (cpu_backend_context != nullptr && num_rows > 1) {
+    const size_t total_bytes = static_cast<size_t>(num_rows) * row_bytes;
+    num_tasks = static_cast<int>(std::min<size_t>(
+        {static_cast<size_t>(cpu_backend_context->max_num_threads()),
+         static_cast<size_t>(num_rows), total_bytes / kMinBytesPerTask}));
+  }
+  if (num_tasks <= 1) {
+    for (int row = 0; row < num_rows; ++row) row_fn(row);
+    return;
+  }
+  std::vector<RowsTask<RowFn>> tasks;
+  tasks.reserve(num_tasks);
+  for (int i = 0; i < num_tasks; ++i) {
+    tasks.emplace_back(
+        row_fn, static_cast<int64_t>(num_rows) * i / num_tasks,
+        static_cast<int64_t>(num_rows) * (i + 1) / num_tasks);
+  }
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                  cpu_backend_context);
+}
+
+// Prefetches the first bytes of a row which is about to be read.
+inline void PrefetchRow(const void* row, size_t row_bytes) {
+  const char* bytes = static_cast<const char*>(row);
+  const size_t prefetch_bytes = std::min(row_bytes, kMaxPrefetchBytes);
+  for (size_t offset = 0; offset < prefetch_bytes; offset += 64) {
+    optimized_ops_preload_l1_keep(bytes + offset);
+  }
+}
+
+}  // namespace gather_internal
+
+// Same as reference_ops::Gather(), with the rows copied from the threads of
+// `cpu_backend_context`, and prefetched.
+template <typename T, typename CoordsT = int32_t>
+inline TfLiteStatus Gather(const tflite::GatherParams& op_params,
+                           const RuntimeShape& input_shape, const T* input_data,
+                           const RuntimeShape& coords_shape,
+                           const CoordsT* coords_data,
+                           const RuntimeShape& output_shape, T* output_data,
+                           bool int4_input,
+                           CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("Gather");
+  int axis = op_params.axis;
+  if (axis < 0) {
+    axis += input_shape.DimensionsCount();
+  }
+  TFLITE_DCHECK_GE(axis, 0);
+  TFLITE_DCHECK_LT(axis, input_shape.DimensionsCount());
+
+  int batch_dims = op_params.batch_dims;
+  if (batch_dims < 0) {
+    batch_dims += coords_shape.DimensionsCount();
+  }
+  TFLITE_DCHECK_GE(batch_dims, 0);
+  TFLITE_DCHECK_LT(batch_dims, input_shape.DimensionsCount());
+  TFLITE_DCHECK_LE(batch_dims, coords_shape.DimensionsCount());
+  TFLITE_DCHECK_GE(axis, batch_dims);
+
+  const int axis_size = input_shape.Dims(axis);
+  int batch_size = 1;
+  for (int i = 0; i < batch_dims; ++i) {
+    batch_size *= input_shape.Dims(i);
+  }
+  int outer_size = 1;
+  for (int i = batch_dims; i < axis; ++i) {
+    outer_size *= input_shape.Dims(i);
+  }
+  int inner_size = 1;
+  for (int i = axis + 1; i < input_shape.DimensionsCount(); ++i) {
+    inner_size *= input_shape.Dims(i);
+  }
+  if (int4_input) {
+    TFLITE_DCHECK_EQ(inner_size % 2, 0);
+    inner_size /= 2;
+  }
+  int coord_size = 1;
+  for (int i = batch_dims; i < coords_shape.DimensionsCount(); ++i) {
+    coord_size *= coords_shape.Dims(i);
+  }
+
+  // Checks the coordinates first, for the copies not to fail.
+  for (int i = 0; i < batch_size * coord_size; ++i) {
+    if (coords_data[i] < 0 || coords_data[i] >= axis_size) {
+      return kTfLiteError;
+    }
+  }
+
+  const size_t row_bytes = sizeof(T) * inner_size;
+  const int num_rows = batch_size * outer_size * coord_size;
+  auto source_row = [&](int row) {
+    const int i = row % coord_size;
+    const int batch_outer = row / coord_size;
+    const int batch = batch_outer / outer_size;
+    const int64_t coord = coords_data[batch * coord_size + i];
+    return input_data +
+           (static_cast<int64_t>(batch_outer) * axis_size + coord) *
+               inner_size;
+  };
+  gather_internal::ForEachRow(
+      num_rows, row_bytes, cpu_backend_context, [&](int row) {
+        if (row + gather_internal::kPrefetchDistance < num_rows) {
+          gather_internal::PrefetchRow(
+              source_row(row + gather_internal::kPrefetchDistance), row_bytes);
+        }
+        std::memcpy(output_data + static_cast<int64_t>(row) * inner_size,
+                    source_row(row), row_bytes);
+      });
+  return kTfLiteOk;
+}
+
+// Same as reference_ops::GatherNd(), with the slices copied from the threads
+// of `cpu_backend_context`, and prefetched.
+template <typename ParamsT, typename IndicesT = int32_t>
+inline TfLiteStatus GatherNd(const RuntimeShape& params_shape,
+                             const ParamsT* params_data,
+                             const RuntimeShape& indices_shape,
+                             const IndicesT* indices_data,
+                             const RuntimeShape& output_shape,
+                             ParamsT* output_data,
+                             CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("GatherNd");
+
+  const reference_ops::GatherNdHelperResult res =
+      reference_ops::GatherNdHelper(params_shape, indices_shape);
+  // Computes and checks the offsets of all the slices first, for the copies
+  // not to fail.
+  std::vector<int64_t> from_positions(res.n_slices);
+  for (int i = 0; i < res.n_slices; ++i) {
+    int64_t from_pos = 0;
+    for (int j = 0; j < res.indices_nd; ++j) {
+      from_pos += indices_data[i * res.indices_nd + j] * res.dims_to_count[j];
+    }
+    if (from_pos < 0 || from_pos + res.slice_size > params_shape.FlatSize()) {
+      return kTfLiteError;
+    }
+    from_positions[i] = from_pos;
+  }
+
+  const size_t slice_bytes = sizeof(ParamsT) * res.slice_size;
+  gather_internal::ForEachRow(
+      res.n_slices, slice_bytes, cpu_backend_context, [&](int i) {
+        if (i + gather_internal::kPrefetchDistance < res.n_slices) {
+          gather_internal::PrefetchRow(
+              params_data +
+                  from_positions[i + gather_internal::kPrefetchDistance],
+              slice_bytes);
+        }
+        std::memcpy(output_data + static_cast<int64_t>(i) * res.slice_size,
+                    params_data + from_positions[i], slice_bytes);
+      });
+  return kTfLiteOk;
+}
+
+}  // namespace optimized_ops
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_GATHER_H_
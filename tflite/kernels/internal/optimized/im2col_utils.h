@@ -476,10 +476,10 @@ inline void DilatedIm2col3D(const Conv3DParams& params, int filter_depth,
                       // Filter pixel is within the input, copy the input data.
                       T const* src = input_data + Offset(input_shape, batch,
                                                          in_d, in_y, in_x, 0);
-                      memcpy(dst, src, input_depth * sizeof(T));
+                      memcpy(dst, src, input_channels * sizeof(T));
                     } else {
                       // Filter pixel is outside the input, zero it out.
-                      memset(dst, zero_byte, input_depth * sizeof(T));
+                      memset(dst, zero_byte, input_channels * sizeof(T));
                     }
                   }
                 } else {
@@ -488,15 +488,16 @@ inline void DilatedIm2col3D(const Conv3DParams& params, int filter_depth,
                   T* dst = im2col_data + Offset(im2col_reshaped, 0, 0,
                                                 row_offset, col_offset);
                   memset(dst, zero_byte,
-                         filter_width * input_depth * sizeof(T));
+                         filter_width * input_channels * sizeof(T));
                 }
               }
             } else {
               const int col_offset = Offset(col_shape, 0, filter_d, 0, 0, 0);
               T* dst = im2col_data +
                        Offset(im2col_reshaped, 0, 0, row_offset, col_offset);
-              memset(dst, zero_byte,
-                     filter_height * filter_width * input_depth * sizeof(T));
+              memset(
+                  dst, zero_byte,
+                  filter_height * filter_width * input_channels * sizeof(T));
             }
           }
         }
@@ -505,6 +506,68 @@ inline void DilatedIm2col3D(const Conv3DParams& params, int filter_depth,
   }
 }
 
+// Fills the `output_width` rows of the im2col matrix of the output pixels of
+// row `out_y` of depth slice `out_d` of `batch`, each row holding the
+// filter_depth x filter_height x filter_width x input_channels patch of the
+// input seen by the pixel. This lets the 3D convolution stream over rows of
+// output pixels instead of materializing the whole im2col matrix.
+template <typename T>
+inline void Im2col3DRow(const Conv3DParams& params, int filter_depth,
+                        int filter_height, int filter_width, uint8_t zero_byte,
+                        const RuntimeShape& input_shape, const T* input_data,
+                        int batch, int out_d, int out_y, int output_width,
+                        T* im2col_data) {
+  TFLITE_DCHECK_EQ(input_shape.DimensionsCount(), 5);
+  const int input_depth = input_shape.Dims(1);
+  const int input_height = input_shape.Dims(2);
+  const int input_width = input_shape.Dims(3);
+  const int input_channels = input_shape.Dims(4);
+  const int patch_size =
+      filter_depth * filter_height * filter_width * input_channels;
+
+  if (params.dilation_depth == 1 && params.dilation_height == 1 &&
+      params.dilation_width == 1) {
+    for (int out_x = 0; out_x < output_width; ++out_x) {
+      ExtractPatchIntoBufferColumn3D(
+          batch, out_d, out_y, out_x, filter_depth, filter_height,
+          filter_width, params.stride_depth, params.stride_height,
+          params.stride_width, params.padding_values.depth,
+          params.padding_values.height, params.padding_values.width,
+          input_depth, input_height, input_width, input_channels,
+          out_x * patch_size, input_data, im2col_data, zero_byte);
+    }
+    return;
+  }
+
+  const int in_d_origin =
+      out_d * params.stride_depth - params.padding_values.depth;
+  const int in_y_origin =
+      out_y * params.stride_height - params.padding_values.height;
+  for (int out_x = 0; out_x < output_width; ++out_x) {
+    const int in_x_origin =
+        out_x * params.stride_width - params.padding_values.width;
+    T* dst = im2col_data + out_x * patch_size;
+    for (int filter_d = 0; filter_d < filter_depth; ++filter_d) {
+      const int in_d = in_d_origin + params.dilation_depth * filter_d;
+      for (int filter_y = 0; filter_y < filter_height; ++filter_y) {
+        const int in_y = in_y_origin + params.dilation_height * filter_y;
+        for (int filter_x = 0; filter_x < filter_width; ++filter_x) {
+          const int in_x = in_x_origin + params.dilation_width * filter_x;
+          if (in_d >= 0 && in_d < input_depth && in_y >= 0 &&
+              in_y < input_height && in_x >= 0 && in_x < input_width) {
+            memcpy(dst,
+                   input_data + Offset(input_shape, batch, in_d, in_y, in_x, 0),
+                   input_channels * sizeof(T));
+          } else {
+            memset(dst, zero_byte, input_channels * sizeof(T));
+          }
+          dst += input_channels;
+        }
+      }
+    }
+  }
+}
+
 }  // namespace optimized_ops
 }  // namespace tflite
 
@@ -0,0 +1,96 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_INTEGER_OPS_CONV3D_H_
+#define TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_INTEGER_OPS_CONV3D_H_
+
+#include <cstdint>
+
+#include "ruy/profiler/instrumentation.h"  // from @ruy
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/cpu_backend_gemm.h"
+#include "tflite/kernels/cpu_backend_gemm_params.h"
+#include "tflite/kernels/internal/compatibility.h"
+#include "tflite/kernels/internal/optimized/optimized_ops.h"
+#include "tflite/kernels/internal/runtime_shape.h"
+#include "tflite/kernels/internal/types.h"
+
+namespace tflite {
+namespace optimized_integer_ops {
+
+// Fixed-point per-channel-quantization 3D convolution, computed as
+// optimized_ops::Conv3D() by chunks of rows of output pixels in `im2col_data`.
+inline void Conv3DPerChannel(
+    const Conv3DParams& params, const int32_t* output_multiplier,
+    const int32_t* output_shift, const RuntimeShape& input_shape,
+    const int8_t* input_data, const RuntimeShape& filter_shape,
+    const int8_t* filter_data, const RuntimeShape& bias_shape,
+    const int32_t* bias_data, const RuntimeShape& output_shape,
+    int8_t* output_data, const RuntimeShape& im2col_shape,
+    int8_t* im2col_data, CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("Conv3D/8bit");
+  TFLITE_DCHECK_EQ(input_shape.DimensionsCount(), 5);
+  TFLITE_DCHECK_EQ(filter_shape.DimensionsCount(), 5);
+  TFLITE_DCHECK_EQ(output_shape.DimensionsCount(), 5);
+
+  const int n = MatchingDim(filter_shape, 4, output_shape, 4);
+  const int k = FlatSizeSkipDim(filter_shape, 4);
+  if (bias_data) {
+    TFLITE_DCHECK_EQ(bias_shape.FlatSize(), n);
+  }
+
+  cpu_backend_gemm::MatrixParams<int8_t> lhs_params;
+  lhs_params.order = cpu_backend_gemm::Order::kColMajor;
+  lhs_params.rows = n;
+  lhs_params.cols = k;
+  lhs_params.zero_point = 0;  // filter is symmetric-quantized
+  cpu_backend_gemm::MatrixParams<int8_t> rhs_params;
+  rhs_params.order = cpu_backend_gemm::Order::kColMajor;
+  rhs_params.rows = k;
+  rhs_params.zero_point = -params.input_offset;
+  cpu_backend_gemm::MatrixParams<int8_t> dst_params;
+  dst_params.order = cpu_backend_gemm::Order::kColMajor;
+  dst_params.rows = n;
+  dst_params.zero_point = params.output_offset;
+  cpu_backend_gemm::GemmParams<
+      int32_t, int8_t,
+      cpu_backend_gemm::QuantizationFlavor::kIntegerWithPerRowMultiplier>
+      gemm_params;
+  gemm_params.bias = bias_data;
+  gemm_params.clamp_min = params.quantized_activation_min;
+  gemm_params.clamp_max = params.quantized_activation_max;
+  gemm_params.multiplier_fixedpoint_perchannel = output_multiplier;
+  gemm_params.multiplier_exponent_perchannel = output_shift;
+
+  // The padding of the input is its zero point.
+  const int8_t input_zero_point = -params.input_offset;
+  const uint8_t zero_point_byte =
+      *reinterpret_cast<const uint8_t*>(&input_zero_point);
+  optimized_ops::conv3d_internal::ForEachIm2colChunk(
+      params, input_shape, input_data, filter_shape, output_shape,
+      im2col_shape, im2col_data, zero_point_byte, cpu_backend_context,
+      [&](const int8_t* gemm_input_data, int first_pixel, int num_pixels) {
+        rhs_params.cols = num_pixels;
+        dst_params.cols = num_pixels;
+        cpu_backend_gemm::Gemm(lhs_params, filter_data, rhs_params,
+                               gemm_input_data, dst_params,
+                               output_data + first_pixel * n, gemm_params,
+                               cpu_backend_context);
+      });
+}
+
+}  // namespace optimized_integer_ops
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_INTEGER_OPS_CONV3D_H_
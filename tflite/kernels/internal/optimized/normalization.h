@@ -0,0 +1,296 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_NORMALIZATION_H_
+#define TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_NORMALIZATION_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "ruy/profiler/instrumentation.h"  // from @ruy
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/cpu_backend_threadpool.h"
+#include "tflite/kernels/internal/cppmath.h"
+#include "tflite/kernels/internal/runtime_shape.h"
+#include "tflite/kernels/internal/types.h"
+
+namespace tflite {
+namespace optimized_ops {
+namespace normalization_internal {
+
+// Normalizations are split in tasks of at least this many elements.
+constexpr int kMinElementsPerTask = 16384;
+// Number of independent accumulators of the float reductions, for the
+// compiler to vectorize them.
+constexpr int kLanes = 8;
+// The float mean and variance are computed per chunk of this many elements,
+// which stays in the L1 cache, and the chunks merged with Welford's update.
+constexpr int kChunkSize = 256;
+
+template <typename Work>
+struct NormalizationTask : cpu_backend_threadpool::Task {
+  NormalizationTask(const Work& work, int begin, int end)
+      : work(work), begin(begin), end(end) {}
+  void Run() override { work(begin, end); }
+
+  const Work& work;
+  int begin;
+  int end;
+};
+
+// Runs `work(begin, end)` over the rows [0, num_rows), split across the
+// threads of `cpu_backend_context` if it is set and the rows are large enough.
+template <typename Work>
+void ForEachRows(int num_rows, int row_size,
+                 CpuBackendContext* cpu_backend_context, const Work& work) {
+  int num_tasks = 1;
+  if (cpu_backend_context != nullptr) {
+    const int64_t num_elements = static_cast<int64_t>(num_rows) * row_size;
+    num_tasks = static_cast<int>(std::min<int64_t>(
+        {cpu_backend_context->max_num_threads(), num_rows,
+         num_elements / kMinElementsPerTask}));
+  }
+  if (num_tasks <= 1) {
+    work(0, num_rows);
+    return;
+  }
+  std::vector<NormalizationTask<Work>> tasks;
+  tasks.reserve(num_tasks);
+  for (int i = 0; i < num_tasks; ++i) {
+    tasks.emplace_back(work, static_cast<int64_t>(num_rows) * i / num_tasks,
+                       static_cast<int64_t>(num_rows) * (i + 1) / num_tasks);
+  }
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                  cpu_backend_context);
+}
+
+inline float SumLanes(const float* lanes) {
+  float sum = 0.0f;
+  for (int lane = 0; lane < kLanes; ++lane) sum += lanes[lane];
+  return sum;
+}
+
+// Returns the sum of `values[0, size)` minus `shift`, squared if `square`.
+template <bool square>
+inline float ShiftedSum(const float* values, int size, float shift) {
+  float lanes[kLanes] = {};
+  int i = 0;
+  for (; i + kLanes <= size; i += kLanes) {
+    for (int lane = 0; lane < kLanes; ++lane) {
+      const float value = values[i + lane] - shift;
+      lanes[lane] += square ? value * value : value;
+    }
+  }
+  float sum = SumLanes(lanes);
+  for (; i < size; ++i) {
+    const float value = values[i] - shift;
+    sum += square ? value * value : value;
+  }
+  return sum;
+}
+
+// Computes the mean and the variance of a row in one pass over the memory.
+inline void RowMoments(const float* row, int size, float* mean,
+                       float* variance) {
+  float row_mean = 0.0f;
+  float m2 = 0.0f;
+  for (int begin = 0; begin < size; begin += kChunkSize) {
+    const int chunk_size = std::min(kChunkSize, size - begin);
+    const float* chunk = row + begin;
+    const float chunk_mean =
+        ShiftedSum</*square=*/false>(chunk, chunk_size, 0.0f) / chunk_size;
+    const float chunk_m2 =
+        ShiftedSum</*square=*/true>(chunk, chunk_size, chunk_mean);
+    const float count = begin + chunk_size;
+    const float delta = chunk_mean - row_mean;
+    row_mean += delta * chunk_size / count;
+    m2 += chunk_m2 + delta * delta * begin * chunk_size / count;
+  }
+  *mean = row_mean;
+  *variance = m2 / size;
+}
+
+inline int8_t QuantizeToInt8(float value) {
+  const float rounded = TfLiteRound(value);
+  return static_cast<int8_t>(std::min<float>(
+      std::max<float>(rounded, std::numeric_limits<int8_t>::min()),
+      std::numeric_limits<int8_t>::max()));
+}
+
+}  // namespace normalization_internal
+
+// Normalizes each row of the last dimension of the input to zero mean and
+// unit variance, then scales it by `gamma_data` and offsets it by
+// `beta_data`, which are one value per column, or null to skip them:
+//
+//   output = (input - mean) / sqrt(variance + epsilon) * gamma + beta
+//
+// The statistics of a row are computed in a single pass.
+inline void LayerNorm(const LayerNormalizationParams& params,
+                      const RuntimeShape& input_shape, const float* input_data,
+                      const float* gamma_data, const float* beta_data,
+                      float* output_data,
+                      CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("LayerNorm");
+  const int row_size = input_shape.Dims(input_shape.DimensionsCount() - 1);
+  if (row_size == 0) return;
+  const int num_rows = input_shape.FlatSize() / row_size;
+  normalization_internal::ForEachRows(
+      num_rows, row_size, cpu_backend_context, [&](int begin, int end) {
+        for (int row = begin; row < end; ++row) {
+          const float* input =
+              input_data + static_cast<int64_t>(row) * row_size;
+          float* output = output_data + static_cast<int64_t>(row) * row_size;
+          float mean;
+          float variance;
+          normalization_internal::RowMoments(input, row_size, &mean,
+                                             &variance);
+          const float inv_stddev = 1.0f / std::sqrt(variance + params.epsilon);
+          for (int i = 0; i < row_size; ++i) {
+            float value = (input[i] - mean) * inv_stddev;
+            if (gamma_data != nullptr) value *= gamma_data[i];
+            if (beta_data != nullptr) value += beta_data[i];
+            output[i] = value;
+          }
+        }
+      });
+}
+
+// Same as above, on int8 tensors quantized by `params`. The statistics are
+// computed exactly in the integer domain.
+inline void LayerNorm(const LayerNormalizationParams& params,
+                      const RuntimeShape& input_shape, const int8_t* input_data,
+                      const float* gamma_data, const float* beta_data,
+                      int8_t* output_data,
+                      CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("LayerNorm/Int8");
+  const int row_size = input_shape.Dims(input_shape.DimensionsCount() - 1);
+  if (row_size == 0) return;
+  const int num_rows = input_shape.FlatSize() / row_size;
+  const float inv_output_scale = 1.0f / params.output_scale;
+  normalization_internal::ForEachRows(
+      num_rows, row_size, cpu_backend_context, [&](int begin, int end) {
+        for (int row = begin; row < end; ++row) {
+          const int8_t* input =
+              input_data + static_cast<int64_t>(row) * row_size;
+          int8_t* output = output_data + static_cast<int64_t>(row) * row_size;
+          int64_t sum = 0;
+          int64_t sum_of_squares = 0;
+          for (int i = 0; i < row_size; ++i) {
+            const int32_t value = input[i];
+            sum += value;
+            sum_of_squares += value * value;
+          }
+          const double mean = static_cast<double>(sum) / row_size;
+          const double variance =
+              static_cast<double>(row_size * sum_of_squares - sum * sum) /
+              (static_cast<double>(row_size) * row_size);
+          const float input_variance =
+              static_cast<float>(variance) * params.input_scale *
+              params.input_scale;
+          const float multiplier = params.input_scale * inv_output_scale /
+                                   std::sqrt(input_variance + params.epsilon);
+          const float input_mean = static_cast<float>(mean);
+          for (int i = 0; i < row_size; ++i) {
+            float value = (input[i] - input_mean) * multiplier;
+            if (gamma_data != nullptr) value *= gamma_data[i];
+            if (beta_data != nullptr) value += beta_data[i] * inv_output_scale;
+            output[i] = normalization_internal::QuantizeToInt8(
+                value + params.output_zero_point);
+          }
+        }
+      });
+}
+
+// Divides each row of the last dimension of the input by its root mean
+// square, then scales it by `gamma_data`, which is one value per column, or
+// null to skip it, and offsets it by `beta_data`, likewise:
+//
+//   output = input / sqrt(mean(input^2) + epsilon) * gamma + beta
+inline void RmsNorm(const LayerNormalizationParams& params,
+                    const RuntimeShape& input_shape, const float* input_data,
+                    const float* gamma_data, const float* beta_data,
+                    float* output_data,
+                    CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("RmsNorm");
+  const int row_size = input_shape.Dims(input_shape.DimensionsCount() - 1);
+  if (row_size == 0) return;
+  const int num_rows = input_shape.FlatSize() / row_size;
+  normalization_internal::ForEachRows(
+      num_rows, row_size, cpu_backend_context, [&](int begin, int end) {
+        for (int row = begin; row < end; ++row) {
+          const float* input =
+              input_data + static_cast<int64_t>(row) * row_size;
+          float* output = output_data + static_cast<int64_t>(row) * row_size;
+          const float mean_square =
+              normalization_internal::ShiftedSum</*square=*/true>(
+                  input, row_size, 0.0f) /
+              row_size;
+          const float inv_rms = 1.0f / std::sqrt(mean_square + params.epsilon);
+          for (int i = 0; i < row_size; ++i) {
+            float value = input[i] * inv_rms;
+            if (gamma_data != nullptr) value *= gamma_data[i];
+            if (beta_data != nullptr) value += beta_data[i];
+            output[i] = value;
+          }
+        }
+      });
+}
+
+// Same as above, on int8 tensors quantized by `params`.
+inline void RmsNorm(const LayerNormalizationParams& params,
+                    const RuntimeShape& input_shape, const int8_t* input_data,
+                    const float* gamma_data, const float* beta_data,
+                    int8_t* output_data,
+                    CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("RmsNorm/Int8");
+  const int row_size = input_shape.Dims(input_shape.DimensionsCount() - 1);
+  if (row_size == 0) return;
+  const int num_rows = input_shape.FlatSize() / row_size;
+  const float inv_output_scale = 1.0f / params.output_scale;
+  normalization_internal::ForEachRows(
+      num_rows, row_size, cpu_backend_context, [&](int begin, int end) {
+        for (int row = begin; row < end; ++row) {
+          const int8_t* input =
+              input_data + static_cast<int64_t>(row) * row_size;
+          int8_t* output = output_data + static_cast<int64_t>(row) * row_size;
+          int64_t sum_of_squares = 0;
+          for (int i = 0; i < row_size; ++i) {
+            const int32_t value = input[i] - params.input_zero_point;
+            sum_of_squares += value * value;
+          }
+          const float mean_square =
+              static_cast<float>(static_cast<double>(sum_of_squares) /
+                                 row_size) *
+              params.input_scale * params.input_scale;
+          const float multiplier = params.input_scale * inv_output_scale /
+                                   std::sqrt(mean_square + params.epsilon);
+          for (int i = 0; i < row_size; ++i) {
+            float value = (input[i] - params.input_zero_point) * multiplier;
+            if (gamma_data != nullptr) value *= gamma_data[i];
+            if (beta_data != nullptr) value += beta_data[i] * inv_output_scale;
+            output[i] = normalization_internal::QuantizeToInt8(
+                value + params.output_zero_point);
+          }
+        }
+      });
+}
+
+}  // namespace optimized_ops
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_NORMALIZATION_H_
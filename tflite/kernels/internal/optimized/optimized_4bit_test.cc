@@ -22,6 +22,10 @@ limitations under the License.
 #include <gtest/gtest.h>
 #include "tflite/kernels/internal/optimized/fully_connected_4bit.h"
 
+#ifdef OPTIMIZED_4BIT_BENCHMARKS
+#include "testing/base/public/benchmark.h"
+#endif  // OPTIMIZED_4BIT_BENCHMARKS
+
 namespace tflite {
 namespace {
 
@@ -502,7 +506,17 @@ TEST_P(RunKernelTests, RunKernelTests) {
 
   index = 0;
   switch (rhs_width) {
-#if defined(FC_4BIT_NEON) && defined(__aarch64__)
+#if defined(FC_4BIT_SSE) && defined(__SSSE3__)
+    case 8:
+      optimized_4bit::RunKernel<optimized_4bit::FilterWidth, 8,
+                                optimized_4bit::FilterDepth>(
+          test_lhs.data(), test_rhs.data(), test_accum.data(), lhs_layout_rows,
+          lhs_layout_cols, rhs_layout_rows, rhs_layout_cols, rhs_layout_rows,
+          lhs_layout_rows);
+      break;
+#endif
+#if (defined(FC_4BIT_NEON) && defined(__aarch64__)) || \
+    (defined(FC_4BIT_SSE) && defined(__SSSE3__))
     case 4:
       optimized_4bit::RunKernel<optimized_4bit::FilterWidth, 4,
                                 optimized_4bit::FilterDepth>(
@@ -543,7 +557,8 @@ INSTANTIATE_TEST_SUITE_P(
           std::make_tuple(1, 8, 1, 64), std::make_tuple(1, 16, 1, 64),
           std::make_tuple(1, 4, 5, 64), std::make_tuple(1, 8, 9, 64),
           std::make_tuple(1, 16, 17, 64),
-#if defined(FC_4BIT_NEON) && defined(__aarch64__)
+#if (defined(FC_4BIT_NEON) && defined(__aarch64__)) || \
+    (defined(FC_4BIT_SSE) && defined(__SSSE3__))
           std::make_tuple(2, 8, 2, 32), std::make_tuple(2, 16, 2, 32),
           std::make_tuple(2, 4, 4, 64), std::make_tuple(2, 8, 4, 64),
           std::make_tuple(2, 16, 4, 64), std::make_tuple(2, 4, 4, 64),
@@ -553,7 +568,91 @@ INSTANTIATE_TEST_SUITE_P(
           std::make_tuple(4, 8, 8, 64), std::make_tuple(4, 16, 8, 64),
           std::make_tuple(4, 4, 8, 64), std::make_tuple(4, 8, 12, 64),
           std::make_tuple(4, 16, 32, 64),
+#endif
+#if defined(FC_4BIT_SSE) && defined(__SSSE3__)
+          std::make_tuple(8, 4, 8, 64), std::make_tuple(8, 16, 24, 64),
+          // Large batches, running over several blocks of rhs rows.
+          std::make_tuple(1, 8, 160, 1024), std::make_tuple(4, 8, 192, 1024),
+          std::make_tuple(8, 8, 256, 1024),
 #endif
     }));
 }  // namespace
 }  // namespace tflite
+
+#ifdef OPTIMIZED_4BIT_BENCHMARKS
+
+// Compile with --copt="-DGOOGLE_COMMANDLINEFLAGS_FULL_API=1" and
+// --copt="-DOPTIMIZED_4BIT_BENCHMARKS"
+// Run with --benchmark_filter=all
+//
+// Runs a 4-bit fully connected layer the way the FULLY_CONNECTED kernel
+// does, the arguments being the batch size, the input depth and the number of
+// output units.
+void BM_FullyConnected4Bit(benchmark::State& state) {
+  const int batch_size = state.range(0);
+  const int cols = state.range(1);
+  const int units = state.range(2);
+  int rhs_width = 1;
+  for (int packed_rows = tflite::optimized_4bit::GetMaxSupportedRows();
+       packed_rows > 0; packed_rows /= 2) {
+    if (batch_size >= packed_rows) {
+      rhs_width = packed_rows;
+      break;
+    }
+  }
+  const int depth = tflite::optimized_4bit::FilterDepth;
+  const int lhs_width = tflite::optimized_4bit::FilterWidth;
+  const int lhs_layout_rows = (units + (lhs_width - 1)) & ~(lhs_width - 1);
+  const int lhs_layout_cols = (cols + (depth - 1)) & ~(depth - 1);
+  const int rhs_layout_rows = (batch_size + (rhs_width - 1)) & ~(rhs_width - 1);
+  const int rhs_layout_cols = lhs_layout_cols;
+  const int dst_layout_rows = rhs_layout_rows;
+  const int dst_layout_cols = lhs_layout_rows;
+
+  std::vector<int8_t> filter(units * cols / 2);
+  for (int8_t& value : filter) {
+    value = static_cast<int8_t>((tflite::int_dist(tflite::random_engine) << 4) |
+                                (tflite::int_dist(tflite::random_engine) & 15));
+  }
+  tflite::optimized_4bit::OpData4Bit op_data;
+  op_data.AllocatePackedRegion(
+      tflite::optimized_4bit::kDefaultAlignmentPadding +
+      lhs_layout_rows * lhs_layout_cols / 2);
+  tflite::optimized_4bit::api::Prepack(op_data.prepacked_cache, filter.data(),
+                                       lhs_layout_rows, lhs_layout_cols, units,
+                                       cols, lhs_width, depth);
+  std::vector<float> input(batch_size * cols);
+  for (float& value : input) {
+    value = tflite::real_dist(tflite::random_engine);
+  }
+  std::vector<float> filter_scales(lhs_layout_rows, 0.01f);
+  std::vector<int8_t> quantized_input(rhs_layout_rows * rhs_layout_cols);
+  std::vector<float> scaling_factors(rhs_layout_rows);
+  std::vector<int32_t> input_offsets(rhs_layout_rows);
+  std::vector<int32_t> accum(dst_layout_rows * dst_layout_cols);
+  std::vector<float> output(batch_size * units);
+  for (auto _ : state) {
+    tflite::optimized_4bit::api::BatchQuantizeFloats4Bit(
+        input.data(), batch_size, cols, quantized_input.data(),
+        scaling_factors.data(), rhs_width, depth, input_offsets.data());
+    tflite::optimized_4bit::api::AssignBiasAndComputeOffsets(
+        input_offsets.data(), scaling_factors.data(), filter_scales.data(),
+        nullptr, output.data(), units, batch_size);
+    tflite::optimized_4bit::api::RunAndUnpack(
+        rhs_width, op_data.prepacked_cache, quantized_input.data(),
+        accum.data(), units, batch_size, lhs_layout_rows, lhs_layout_cols,
+        rhs_layout_rows, rhs_layout_cols, dst_layout_rows, dst_layout_cols,
+        output.data(), scaling_factors.data(), filter_scales.data());
+    testing::DoNotOptimize(output[0]);
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size * cols * units);
+}
+BENCHMARK(BM_FullyConnected4Bit)
+    ->Args({1, 2048, 2048})
+    ->Args({4, 2048, 2048})
+    ->Args({16, 2048, 2048})
+    ->Args({128, 2048, 2048})
+    ->Args({512, 2048, 2048})
+    ->Args({512, 4096, 11008});
+
+#endif  // OPTIMIZED_4BIT_BENCHMARKS
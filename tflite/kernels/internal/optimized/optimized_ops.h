@@ -55,6 +55,8 @@ limitations under the License.
 #include "tflite/kernels/internal/optimized/im2col_utils.h"
 #include "tflite/kernels/internal/optimized/neon_check.h"
 #include "tflite/kernels/internal/optimized/optimized_ops_utils.h"
+#include "tflite/kernels/internal/optimized/gather.h"
+#include "tflite/kernels/internal/optimized/transpose.h"
 #include "tflite/kernels/internal/quantization_util.h"
 #include "tflite/kernels/internal/reference/reference_ops.h"
 #include "tflite/kernels/internal/strided_slice_logic.h"
@@ -3540,6 +3542,87 @@ inline void Softmax(const SoftmaxParams& params,
   }
 }
 
+template <typename In, typename Out, typename SoftmaxRows>
+struct SoftmaxRowsWorkerTask : cpu_backend_threadpool::Task {
+  SoftmaxRowsWorkerTask(const SoftmaxRows& softmax_rows, const In* input_data,
+                        Out* output_data, int depth, int start_row,
+                        int end_row)
+      : softmax_rows(softmax_rows),
+        input_data(input_data),
+        output_data(output_data),
+        depth(depth),
+        start_row(start_row),
+        end_row(end_row) {}
+  void Run() override {
+    const RuntimeShape rows_shape({end_row - start_row, depth});
+    softmax_rows(rows_shape, input_data + start_row * depth,
+                 output_data + start_row * depth);
+  }
+
+ private:
+  const SoftmaxRows& softmax_rows;
+  const In* input_data;
+  Out* output_data;
+  int depth;
+  int start_row;
+  int end_row;
+};
+
+// Runs `softmax_rows(shape, input_data, output_data)`, which computes a softmax
+// like op along the last dimension of `shape`, on ranges of the rows of the
+// input split between the threads of `cpu_backend_context`.
+template <typename In, typename Out, typename SoftmaxRows>
+inline void SoftmaxByRows(const RuntimeShape& input_shape, const In* input_data,
+                          const RuntimeShape& output_shape, Out* output_data,
+                          CpuBackendContext* cpu_backend_context,
+                          const SoftmaxRows& softmax_rows) {
+  const int trailing_dim = input_shape.DimensionsCount() - 1;
+  const int outer_size =
+      MatchingFlatSizeSkipDim(input_shape, trailing_dim, output_shape);
+  const int depth =
+      MatchingDim(input_shape, trailing_dim, output_shape, trailing_dim);
+  // Quantized rows are cheap, so only split large inputs.
+  constexpr int kMinElementsPerThread = 8192;
+  const int thread_count =
+      cpu_backend_context == nullptr
+          ? 1
+          : std::min({outer_size, outer_size * depth / kMinElementsPerThread,
+                      cpu_backend_context->max_num_threads()});
+  if (thread_count <= 1) {
+    softmax_rows(input_shape, input_data, output_data);
+    return;
+  }
+  std::vector<SoftmaxRowsWorkerTask<In, Out, SoftmaxRows>> tasks;
+  tasks.reserve(thread_count);
+  int row_start = 0;
+  for (int i = 0; i < thread_count; ++i) {
+    const int row_end =
+        row_start + (outer_size - row_start) / (thread_count - i);
+    tasks.emplace_back(softmax_rows, input_data, output_data, depth, row_start,
+                       row_end);
+    row_start = row_end;
+  }
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                  cpu_backend_context);
+}
+
+// Quantized softmax with int16_t input and output, with the rows of the input
+// split between the threads of `cpu_backend_context`.
+inline void SoftmaxInt16(const SoftmaxParams& params,
+                         const RuntimeShape& input_shape,
+                         const int16_t* input_data,
+                         const RuntimeShape& output_shape, int16_t* output_data,
+                         CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("SoftmaxInt16");
+  SoftmaxByRows(input_shape, input_data, output_shape, output_data,
+                cpu_backend_context,
+                [&params](const RuntimeShape& shape, const int16_t* input,
+                          int16_t* output) {
+                  reference_ops::SoftmaxInt16(params, shape, input, shape,
+                                              output);
+                });
+}
+
 template <typename T>
 inline int32_t QuantizeSoftmaxOutput(float prob_rescaled, int32_t zero_point) {
   const int32_t prob_rnd = static_cast<int32_t>(std::round(prob_rescaled));
@@ -5637,24 +5720,65 @@ inline void TransposeConvV2(
            output_activation_max, scratch_data, output_data);
 }
 
-// Integer-only version of ResizeNearestNeighbor. Since scales are represented
-// in fixed-point and thus approximated, |in_x| or |in_y| may differ from the
-// reference version. Debug checks are in place to test if this occurs.
-// NOTE: If align_corners or half_pixel_centers is true, we use the reference
-// version.
+template <typename T>
+struct ResizeNearestNeighborWorkerTask : cpu_backend_threadpool::Task {
+  ResizeNearestNeighborWorkerTask(const T* input_data,
+                                  const int32_t* input_row_offsets,
+                                  const int32_t* input_col_offsets,
+                                  int output_width, int depth, T* output_data,
+                                  int start_row, int end_row)
+      : input_data(input_data),
+        input_row_offsets(input_row_offsets),
+        input_col_offsets(input_col_offsets),
+        output_width(output_width),
+        depth(depth),
+        output_data(output_data),
+        start_row(start_row),
+        end_row(end_row) {}
+
+  void Run() override {
+    const int output_row_size = output_width * depth;
+    T* output_ptr = output_data + start_row * output_row_size;
+    for (int row = start_row; row < end_row; ++row) {
+      // Upsampled rows repeat the previous output row.
+      if (row > start_row &&
+          input_row_offsets[row] == input_row_offsets[row - 1]) {
+        memcpy(output_ptr, output_ptr - output_row_size,
+               output_row_size * sizeof(T));
+        output_ptr += output_row_size;
+        continue;
+      }
+      const T* input_row = input_data + input_row_offsets[row];
+      for (int x = 0; x < output_width; ++x) {
+        memcpy(output_ptr, input_row + input_col_offsets[x], depth * sizeof(T));
+        output_ptr += depth;
+      }
+    }
+  }
+
+ private:
+  const T* input_data;
+  const int32_t* input_row_offsets;
+  const int32_t* input_col_offsets;
+  int output_width;
+  int depth;
+  T* output_data;
+  int start_row;
+  int end_row;
+};
+
+// Same results as reference_ops::ResizeNearestNeighbor. The nearest input
+// rows and columns are computed once for each output row and column, rather
+// than for each output pixel, and the output rows are split between the
+// threads of `cpu_backend_context`.
+template <typename T>
 inline void ResizeNearestNeighbor(
     const tflite::ResizeNearestNeighborParams& op_params,
-    const RuntimeShape& unextended_input_shape, const uint8_t* input_data,
+    const RuntimeShape& unextended_input_shape, const T* input_data,
     const RuntimeShape& output_size_shape, const int32_t* output_size_data,
-    const RuntimeShape& unextended_output_shape, uint8_t* output_data) {
-  if (op_params.align_corners || op_params.half_pixel_centers) {
-    // TODO(b/149823713): Add support for align_corners & half_pixel_centers in
-    // this kernel.
-    reference_ops::ResizeNearestNeighbor(
-        op_params, unextended_input_shape, input_data, output_size_shape,
-        output_size_data, unextended_output_shape, output_data);
-    return;
-  }
+    const RuntimeShape& unextended_output_shape, T* output_data,
+    CpuBackendContext* cpu_backend_context = nullptr) {
+  ruy::profiler::ScopeLabel label("ResizeNearestNeighbor");
   TFLITE_DCHECK_LE(unextended_input_shape.DimensionsCount(), 4);
   TFLITE_DCHECK_LE(unextended_output_shape.DimensionsCount(), 4);
 
@@ -5674,45 +5798,62 @@ inline void ResizeNearestNeighbor(
   int32_t output_height = output_size_data[0];
   int32_t output_width = output_size_data[1];
 
-  // Convert scales to fixed-point with 16 fractional bits. We add 1 as an
-  // error factor and to avoid zero scales. For example, with input_height = 1,
-  // output_height = 3, the float scaling factor would be non-zero at 1/3.
-  // With fixed-point, this is zero.
-  int32_t height_scale = (input_height << 16) / output_height + 1;
-  int32_t width_scale = (input_width << 16) / output_width + 1;
-
   const int col_offset = input_shape.Dims(3);
   const int row_offset = input_shape.Dims(2) * col_offset;
   const int batch_offset = input_shape.Dims(1) * row_offset;
 
-  const uint8_t* input_ptr = input_data;
-  uint8_t* output_ptr = output_data;
-  for (int b = 0; b < batches; ++b) {
-    for (int y = 0; y < output_height; ++y) {
-      int32_t in_y = std::min((y * height_scale) >> 16, input_height - 1);
-      // Check offset calculation is the same as the reference version. See
-      // function comment for details. We check using a non-float version of:
-      // TFLITE_DCHECK_EQ(in_y, std::floor(y * (static_cast<float>(input_height)
-      //                                            / output_height)));
-      TFLITE_DCHECK_LT(y * input_height, output_height + in_y * output_height);
-      TFLITE_DCHECK_GE(y * input_height, in_y * output_height);
-      const uint8_t* y_input_ptr = input_ptr + in_y * row_offset;
-      for (int x = 0; x < output_width; ++x) {
-        int32_t in_x = std::min((x * width_scale) >> 16, input_width - 1);
-        // Check offset calculation is the same as the reference version. See
-        // function comment for details. We check using a non-float version of:
-        // TFLITE_DCHECK_EQ(in_y,
-        //                  std::floor(y * (static_cast<float>(input_width)
-        //                                      / output_width)));
-        TFLITE_DCHECK_LT(x * input_width, output_width + in_x * output_width);
-        TFLITE_DCHECK_GE(x * input_width, in_x * output_width);
-        const uint8_t* x_input_ptr = y_input_ptr + in_x * col_offset;
-        memcpy(output_ptr, x_input_ptr, depth);
-        output_ptr += depth;
-      }
+  // The offsets of the nearest input row of each of the batches *
+  // output_height output rows, and of the nearest input column of each output
+  // column in an input row.
+  const int num_rows = batches * output_height;
+  std::vector<int32_t> input_row_offsets(num_rows);
+  for (int y = 0; y < output_height; ++y) {
+    const int32_t in_y = reference_ops::GetNearestNeighbor(
+        y, input_height, output_height, op_params.align_corners,
+        op_params.half_pixel_centers);
+    for (int b = 0; b < batches; ++b) {
+      input_row_offsets[b * output_height + y] =
+          b * batch_offset + in_y * row_offset;
     }
-    input_ptr += batch_offset;
   }
+  std::vector<int32_t> input_col_offsets(output_width);
+  for (int x = 0; x < output_width; ++x) {
+    input_col_offsets[x] =
+        reference_ops::GetNearestNeighbor(x, input_width, output_width,
+                                          op_params.align_corners,
+                                          op_params.half_pixel_centers) *
+        col_offset;
+  }
+
+  // Copies are cheap, so only split large outputs.
+  constexpr int kMinElementsPerThread = 65536;
+  const int thread_count =
+      cpu_backend_context == nullptr
+          ? 1
+          : std::max(1, static_cast<int>(std::min<int64_t>(
+                            {num_rows,
+                             static_cast<int64_t>(num_rows) * output_width *
+                                 depth / kMinElementsPerThread,
+                             cpu_backend_context->max_num_threads()})));
+  if (thread_count == 1) {
+    ResizeNearestNeighborWorkerTask<T>(
+        input_data, input_row_offsets.data(), input_col_offsets.data(),
+        output_width, depth, output_data, 0, num_rows)
+        .Run();
+    return;
+  }
+  std::vector<ResizeNearestNeighborWorkerTask<T>> tasks;
+  tasks.reserve(thread_count);
+  int start_row = 0;
+  for (int i = 0; i < thread_count; ++i) {
+    const int end_row = start_row + (num_rows - start_row) / (thread_count - i);
+    tasks.emplace_back(input_data, input_row_offsets.data(),
+                       input_col_offsets.data(), output_width, depth,
+                       output_data, start_row, end_row);
+    start_row = end_row;
+  }
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                  cpu_backend_context);
 }
 
 template <typename input_type, typename output_type>
@@ -6054,6 +6195,81 @@ inline void Requantize<uint8_t, uint8_t>(
   }
 }
 
+namespace quantize_internal {
+
+// Element-wise conversions are split in blocks of this many elements, each
+// converted by the single-threaded kernel.
+constexpr int kBlockSize = 16384;
+
+// Calls `convert_block(start, size)` for the consecutive blocks of
+// [0, flat_size), from several threads of `cpu_backend_context` if it is set
+// and the blocks add up to enough bytes of `OutputT`.
+template <typename OutputT, typename ConvertBlockFn>
+void ForEachBlock(int flat_size, CpuBackendContext* cpu_backend_context,
+                  const ConvertBlockFn& convert_block) {
+  const int num_blocks = (flat_size + kBlockSize - 1) / kBlockSize;
+  gather_internal::ForEachRow(
+      num_blocks, kBlockSize * sizeof(OutputT), cpu_backend_context,
+      [&](int block) {
+        const int start = block * kBlockSize;
+        convert_block(start, std::min(kBlockSize, flat_size - start));
+      });
+}
+
+// Per-channel conversions of channels with fewer contiguous elements than
+// this are split in rows holding all the channels instead of one.
+constexpr int kMinChannelRowSize = 16;
+
+// Calls `convert_row(row, channel, size)` for the rows of `size` elements of
+// a tensor of `shape` which share the channel of `quantized_dimension`, from
+// several threads of `cpu_backend_context` if it is set. When the channels are
+// shorter than kMinChannelRowSize, e.g. when quantized along the innermost
+// dimension, each row holds all the channels instead and `channel` is -1.
+template <typename OutputT, typename ConvertRowFn>
+void ForEachChannelRow(const RuntimeShape& shape, int quantized_dimension,
+                       CpuBackendContext* cpu_backend_context,
+                       const ConvertRowFn& convert_row) {
+  const int num_channels = shape.Dims(quantized_dimension);
+  int outer_size = 1;
+  for (int i = 0; i < quantized_dimension; ++i) {
+    outer_size *= shape.Dims(i);
+  }
+  int inner_size = 1;
+  for (int i = quantized_dimension + 1; i < shape.DimensionsCount(); ++i) {
+    inner_size *= shape.Dims(i);
+  }
+  if (inner_size >= kMinChannelRowSize) {
+    gather_internal::ForEachRow(
+        outer_size * num_channels, inner_size * sizeof(OutputT),
+        cpu_backend_context, [&](int row) {
+          convert_row(row, row % num_channels, inner_size);
+        });
+    return;
+  }
+  const int row_size = num_channels * inner_size;
+  gather_internal::ForEachRow(
+      outer_size, row_size * sizeof(OutputT), cpu_backend_context,
+      [&](int row) { convert_row(row, -1, row_size); });
+}
+
+}  // namespace quantize_internal
+
+// Same as Requantize() above, on several threads of `cpu_backend_context` for
+// large tensors.
+template <typename input_type, typename output_type>
+inline void Requantize(const input_type* input_data, int32_t size,
+                       int32_t effective_scale_multiplier,
+                       int32_t effective_scale_shift, int32_t input_zeropoint,
+                       int32_t output_zeropoint, output_type* output_data,
+                       CpuBackendContext* cpu_backend_context) {
+  quantize_internal::ForEachBlock<output_type>(
+      size, cpu_backend_context, [&](int start, int block_size) {
+        Requantize(input_data + start, block_size, effective_scale_multiplier,
+                   effective_scale_shift, input_zeropoint, output_zeropoint,
+                   output_data + start);
+      });
+}
+
 inline void HardSwish(const RuntimeShape& input_shape, const float* input_data,
                       const RuntimeShape& output_shape, float* output_data) {
   ruy::profiler::ScopeLabel label("HardSwish/Float");
@@ -6669,6 +6885,130 @@ inline void AffineQuantize(const tflite::QuantizationParams& op_params,
   }
 }
 
+// Same as Dequantize() above, on several threads of `cpu_backend_context` for
+// large tensors.
+template <typename T>
+inline void Dequantize(const tflite::DequantizationParams& op_params,
+                       const RuntimeShape& input_shape, const T* input_data,
+                       const RuntimeShape& output_shape, float* output_data,
+                       CpuBackendContext* cpu_backend_context) {
+  const int flat_size = MatchingFlatSize(input_shape, output_shape);
+  quantize_internal::ForEachBlock<float>(
+      flat_size, cpu_backend_context, [&](int start, int size) {
+        const RuntimeShape block_shape({size});
+        Dequantize(op_params, block_shape, input_data + start, block_shape,
+                   output_data + start);
+      });
+}
+
+inline void Dequantize(const RuntimeShape& input_shape,
+                       const Eigen::half* input_data,
+                       const RuntimeShape& output_shape, float* output_data,
+                       CpuBackendContext* cpu_backend_context) {
+  const int flat_size = MatchingFlatSize(input_shape, output_shape);
+  quantize_internal::ForEachBlock<float>(
+      flat_size, cpu_backend_context, [&](int start, int size) {
+        const RuntimeShape block_shape({size});
+        Dequantize(block_shape, input_data + start, block_shape,
+                   output_data + start);
+      });
+}
+
+// Same as AffineQuantize() above, on several threads of `cpu_backend_context`
+// for large tensors.
+template <typename T>
+inline void AffineQuantize(const tflite::QuantizationParams& op_params,
+                           const RuntimeShape& input_shape,
+                           const float* input_data,
+                           const RuntimeShape& output_shape, T* output_data,
+                           CpuBackendContext* cpu_backend_context) {
+  const int flat_size = MatchingFlatSize(input_shape, output_shape);
+  quantize_internal::ForEachBlock<T>(
+      flat_size, cpu_backend_context, [&](int start, int size) {
+        const RuntimeShape block_shape({size});
+        AffineQuantize(op_params, block_shape, input_data + start,
+                       block_shape, output_data + start);
+      });
+}
+
+// Same as reference_ops::PerChannelQuantize(), with the scale and zero point
+// of each channel applied to its contiguous elements, and the channels split
+// among the threads of `cpu_backend_context` if it is set.
+template <typename T>
+inline void PerChannelQuantize(
+    const tflite::PerChannelQuantizationParams& op_params,
+    const RuntimeShape& input_shape, const float* input_data,
+    const RuntimeShape& output_shape, T* output_data,
+    CpuBackendContext* cpu_backend_context = nullptr) {
+  ruy::profiler::ScopeLabel label("PerChannelQuantize");
+  MatchingFlatSize(input_shape, output_shape);
+  static constexpr int32_t min_val = std::numeric_limits<T>::min();
+  static constexpr int32_t max_val = std::numeric_limits<T>::max();
+  const int quantized_dimension = op_params.quantized_dimension;
+  const int num_channels = input_shape.Dims(quantized_dimension);
+  const float* scale = op_params.scale;
+  const int32_t* zero_point = op_params.zero_point;
+  quantize_internal::ForEachChannelRow<T>(
+      input_shape, quantized_dimension, cpu_backend_context,
+      [&](int row, int channel, int size) {
+        const float* input = input_data + static_cast<int64_t>(row) * size;
+        T* output = output_data + static_cast<int64_t>(row) * size;
+        const int channel_size = channel >= 0 ? size : size / num_channels;
+        const int begin_channel = channel >= 0 ? channel : 0;
+        const int end_channel = channel >= 0 ? channel + 1 : num_channels;
+        for (int c = begin_channel; c < end_channel; ++c) {
+          const float channel_scale = scale[c];
+          const int32_t channel_zero_point = zero_point[c];
+          for (int i = 0; i < channel_size; ++i) {
+            const int32_t unclamped =
+                static_cast<int32_t>(TfLiteRound(input[i] / channel_scale)) +
+                channel_zero_point;
+            output[i] =
+                static_cast<T>(std::min(std::max(unclamped, min_val), max_val));
+          }
+          input += channel_size;
+          output += channel_size;
+        }
+      });
+}
+
+// Same as reference_ops::PerChannelDequantize(), with the scale and zero
+// point of each channel applied to its contiguous elements, and the channels
+// split among the threads of `cpu_backend_context` if it is set.
+template <typename T>
+inline void PerChannelDequantize(
+    const tflite::PerChannelDequantizationParams& op_params,
+    const RuntimeShape& input_shape, const T* input_data,
+    const RuntimeShape& output_shape, float* output_data,
+    CpuBackendContext* cpu_backend_context = nullptr) {
+  ruy::profiler::ScopeLabel label("PerChannelDequantize");
+  MatchingFlatSize(input_shape, output_shape);
+  const int quantized_dimension = op_params.quantized_dimension;
+  const int num_channels = input_shape.Dims(quantized_dimension);
+  const float* scale = op_params.scale;
+  const int32_t* zero_point = op_params.zero_point;
+  quantize_internal::ForEachChannelRow<float>(
+      input_shape, quantized_dimension, cpu_backend_context,
+      [&](int row, int channel, int size) {
+        const T* input = input_data + static_cast<int64_t>(row) * size;
+        float* output = output_data + static_cast<int64_t>(row) * size;
+        const int channel_size = channel >= 0 ? size : size / num_channels;
+        const int begin_channel = channel >= 0 ? channel : 0;
+        const int end_channel = channel >= 0 ? channel + 1 : num_channels;
+        for (int c = begin_channel; c < end_channel; ++c) {
+          const float channel_scale = scale[c];
+          const int32_t channel_zero_point = zero_point[c];
+          for (int i = 0; i < channel_size; ++i) {
+            const int32_t val = input[i];
+            output[i] =
+                static_cast<float>(channel_scale * (val - channel_zero_point));
+          }
+          input += channel_size;
+          output += channel_size;
+        }
+      });
+}
+
 // TODO(b/139252020): Replace GEMMLOWP_NEON with USE_NEON when the bug is fixed.
 // The converted versions of gemmlowp::tanh and gemmlowp::logistic, done by
 // arm_sse_2_neon.h, produce incorrect results with int16x8_t data types.
@@ -7222,8 +7562,8 @@ template <typename T, int N = 6>
 void Transpose(const TransposeParams& params, const RuntimeShape& input_shape,
                const T* input_data, const RuntimeShape& output_shape,
                T* output_data) {
-  return reference_ops::Transpose(params, input_shape, input_data, output_shape,
-                                  output_data);
+  return Transpose(params, input_shape, input_data, output_shape, output_data,
+                   /*cpu_backend_context=*/nullptr);
 }
 
 // Assume input1 & input2 have the same scale & zero point.
@@ -7352,25 +7692,19 @@ inline void BroadcastMinimumDispatch(const ArithmeticParams& params,
                           MinimumElementwise, MinimumScalarBroadcast);
 }
 
+// Computes the cumulative sum of the {outer, axis, inner} tensor `input_data`
+// along its middle axis.
 template <typename T>
-void CumsumImpl(const T* input_data, const RuntimeShape& shape, int axis,
-                bool exclusive, bool reverse, T* output_data) {
-  Eigen::array<Eigen::DenseIndex, 3> dims = {1, 1, 1};
-
-  for (int i = 0; i < axis; ++i) {
-    dims[0] *= shape.Dims(i);
-  }
-  dims[1] = shape.Dims(axis);
-  for (int i = axis + 1; i < shape.DimensionsCount(); ++i) {
-    dims[2] *= shape.Dims(i);
-  }
-
+void CumsumImpl(const T* input_data,
+                const Eigen::array<Eigen::DenseIndex, 3>& dims, bool exclusive,
+                bool reverse, T* output_data) {
   typedef Eigen::TensorMap<
       Eigen::Tensor<const T, 3, Eigen::RowMajor, Eigen::DenseIndex>,
-      Eigen::Aligned>
+      Eigen::Unaligned>
       ConstTensor;
   typedef Eigen::TensorMap<
-      Eigen::Tensor<T, 3, Eigen::RowMajor, Eigen::DenseIndex>, Eigen::Aligned>
+      Eigen::Tensor<T, 3, Eigen::RowMajor, Eigen::DenseIndex>,
+      Eigen::Unaligned>
       Tensor;
   ConstTensor input(input_data, dims);
   Tensor output(output_data, dims);
@@ -7384,12 +7718,194 @@ void CumsumImpl(const T* input_data, const RuntimeShape& shape, int axis,
   }
 }
 
+// Cumulative sum of the rows [start_row, end_row) of the axis of each of the
+// `outer` {axis, inner} matrices of the input, as if the rows before, or after
+// when reversed, were zero. With `totals`, also stores the sum of the rows of
+// each matrix in `inner` values at `totals + outer_index * inner`.
+template <typename T>
+struct CumsumWorkerTask : cpu_backend_threadpool::Task {
+  CumsumWorkerTask(const T* input_data, int outer, int axis, int inner,
+                   int start_row, int end_row, bool exclusive, bool reverse,
+                   T* output_data, T* totals)
+      : input_data(input_data),
+        outer(outer),
+        axis(axis),
+        inner(inner),
+        start_row(start_row),
+        end_row(end_row),
+        exclusive(exclusive),
+        reverse(reverse),
+        output_data(output_data),
+        totals(totals) {}
+
+  void Run() override {
+    const Eigen::array<Eigen::DenseIndex, 3> dims = {1, end_row - start_row,
+                                                     inner};
+    for (int o = 0; o < outer; ++o) {
+      const int offset = (o * axis + start_row) * inner;
+      CumsumImpl(input_data + offset, dims, exclusive, reverse,
+                 output_data + offset);
+      if (totals == nullptr) {
+        continue;
+      }
+      T* total = totals + o * inner;
+      std::fill(total, total + inner, T(0));
+      for (int row = start_row; row < end_row; ++row) {
+        const T* input_row = input_data + (o * axis + row) * inner;
+        for (int i = 0; i < inner; ++i) {
+          total[i] += input_row[i];
+        }
+      }
+    }
+  }
+
+  const T* input_data;
+  int outer;
+  int axis;
+  int inner;
+  int start_row;
+  int end_row;
+  bool exclusive;
+  bool reverse;
+  T* output_data;
+  T* totals;
+};
+
+// Adds `inner` values at `offsets + outer_index * inner` to the rows
+// [start_row, end_row) of each of the `outer` {axis, inner} matrices of the
+// output.
+template <typename T>
+struct CumsumAddOffsetsWorkerTask : cpu_backend_threadpool::Task {
+  CumsumAddOffsetsWorkerTask(const T* offsets, int outer, int axis, int inner,
+                             int start_row, int end_row, T* output_data)
+      : offsets(offsets),
+        outer(outer),
+        axis(axis),
+        inner(inner),
+        start_row(start_row),
+        end_row(end_row),
+        output_data(output_data) {}
+
+  void Run() override {
+    for (int o = 0; o < outer; ++o) {
+      const T* offset = offsets + o * inner;
+      for (int row = start_row; row < end_row; ++row) {
+        T* output_row = output_data + (o * axis + row) * inner;
+        for (int i = 0; i < inner; ++i) {
+          output_row[i] += offset[i];
+        }
+      }
+    }
+  }
+
+  const T* offsets;
+  int outer;
+  int axis;
+  int inner;
+  int start_row;
+  int end_row;
+  T* output_data;
+};
+
+// Large cumulative sums are split between the threads of `cpu_backend_context`:
+// - when there are enough independent scans, by ranges of the dimensions
+//   before the axis,
+// - otherwise by blocks of the axis, which are scanned in parallel on their
+//   own, then offset in parallel by the sums of the blocks before them.
 template <typename T>
 void CumSum(const T* input_data, const RuntimeShape& shape, int axis,
-            bool exclusive, bool reverse, T* output_data) {
+            bool exclusive, bool reverse, T* output_data,
+            CpuBackendContext* cpu_backend_context = nullptr) {
+  ruy::profiler::ScopeLabel label("CumSum");
   const int dim = shape.DimensionsCount();
   TFLITE_DCHECK_GE(dim, 1);
-  CumsumImpl<T>(input_data, shape, axis, exclusive, reverse, output_data);
+  int outer = 1;
+  for (int i = 0; i < axis; ++i) {
+    outer *= shape.Dims(i);
+  }
+  const int axis_size = shape.Dims(axis);
+  int inner = 1;
+  for (int i = axis + 1; i < dim; ++i) {
+    inner *= shape.Dims(i);
+  }
+
+  constexpr int kMinElementsPerThread = 16384;
+  const int flat_size = outer * axis_size * inner;
+  const int max_thread_count =
+      cpu_backend_context == nullptr ? 1
+                                     : cpu_backend_context->max_num_threads();
+  const int thread_count =
+      std::min(max_thread_count, flat_size / kMinElementsPerThread);
+  if (thread_count <= 1 || (outer < thread_count && axis_size < thread_count)) {
+    CumsumImpl<T>(input_data, {outer, axis_size, inner}, exclusive, reverse,
+                  output_data);
+    return;
+  }
+
+  if (outer >= thread_count) {
+    std::vector<CumsumWorkerTask<T>> tasks;
+    tasks.reserve(thread_count);
+    int outer_start = 0;
+    for (int i = 0; i < thread_count; ++i) {
+      const int outer_end =
+          outer_start + (outer - outer_start) / (thread_count - i);
+      const int offset = outer_start * axis_size * inner;
+      tasks.emplace_back(input_data + offset, outer_end - outer_start,
+                         axis_size, inner, /*start_row=*/0, axis_size,
+                         exclusive, reverse, output_data + offset,
+                         /*totals=*/nullptr);
+      outer_start = outer_end;
+    }
+    cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                    cpu_backend_context);
+    return;
+  }
+
+  // Scans each block of the axis, and sums it in `block_sums`.
+  std::vector<T> block_sums(thread_count * outer * inner);
+  std::vector<int> block_starts(thread_count + 1);
+  for (int i = 0; i < thread_count; ++i) {
+    block_starts[i + 1] =
+        block_starts[i] + (axis_size - block_starts[i]) / (thread_count - i);
+  }
+  std::vector<CumsumWorkerTask<T>> scan_tasks;
+  scan_tasks.reserve(thread_count);
+  for (int i = 0; i < thread_count; ++i) {
+    scan_tasks.emplace_back(input_data, outer, axis_size, inner,
+                            block_starts[i], block_starts[i + 1], exclusive,
+                            reverse, output_data,
+                            block_sums.data() + i * outer * inner);
+  }
+  cpu_backend_threadpool::Execute(scan_tasks.size(), scan_tasks.data(),
+                                  cpu_backend_context);
+
+  // Turns `block_sums` into the sums of the blocks before each block, in scan
+  // order, in place.
+  const int block_size = outer * inner;
+  std::vector<T> running_sum(block_size, T(0));
+  for (int b = 0; b < thread_count; ++b) {
+    T* block_sum =
+        block_sums.data() + (reverse ? thread_count - 1 - b : b) * block_size;
+    for (int i = 0; i < block_size; ++i) {
+      const T sum = block_sum[i];
+      block_sum[i] = running_sum[i];
+      running_sum[i] += sum;
+    }
+  }
+
+  // The first block in scan order has no offset.
+  std::vector<CumsumAddOffsetsWorkerTask<T>> offset_tasks;
+  offset_tasks.reserve(thread_count - 1);
+  for (int i = 0; i < thread_count; ++i) {
+    if (i == (reverse ? thread_count - 1 : 0)) {
+      continue;
+    }
+    offset_tasks.emplace_back(block_sums.data() + i * block_size, outer,
+                              axis_size, inner, block_starts[i],
+                              block_starts[i + 1], output_data);
+  }
+  cpu_backend_threadpool::Execute(offset_tasks.size(), offset_tasks.data(),
+                                  cpu_backend_context);
 }
 
 inline void PReluScalarBroadcast(int size, const ArithmeticParams& params,
@@ -7844,6 +8360,77 @@ inline void ArgMax(const RuntimeShape& input1_shape, const T1* input1_data,
   ArgMax(input1_shape, input1_data, input2_data, output_shape, output_data);
 }
 
+namespace conv3d_internal {
+
+// Whether the 3D convolution needs an im2col matrix, i.e. it is not a 1x1x1
+// convolution with unit strides and dilations whose input is its im2col
+// matrix already.
+inline bool NeedIm2col(const Conv3DParams& params,
+                       const RuntimeShape& filter_shape) {
+  return params.stride_depth != 1 || params.stride_height != 1 ||
+         params.stride_width != 1 || params.dilation_depth != 1 ||
+         params.dilation_height != 1 || params.dilation_width != 1 ||
+         filter_shape.Dims(0) != 1 || filter_shape.Dims(1) != 1 ||
+         filter_shape.Dims(2) != 1;
+}
+
+// Calls `gemm(gemm_input_data, first_pixel, num_pixels)` for consecutive
+// ranges of the output pixels of the 3D convolution, `gemm_input_data` being
+// their rows of the im2col matrix. Rather than the whole matrix, `im2col_data`
+// holds the rows of as many rows of output pixels as fit in `im2col_shape`,
+// built from the threads of `cpu_backend_context`, so that the scratch memory
+// stays bounded however long the input video is.
+template <typename T, typename GemmFn>
+inline void ForEachIm2colChunk(const Conv3DParams& params,
+                               const RuntimeShape& input_shape,
+                               const T* input_data,
+                               const RuntimeShape& filter_shape,
+                               const RuntimeShape& output_shape,
+                               const RuntimeShape& im2col_shape, T* im2col_data,
+                               uint8_t zero_byte,
+                               CpuBackendContext* cpu_backend_context,
+                               const GemmFn& gemm) {
+  if (!NeedIm2col(params, filter_shape)) {
+    TFLITE_DCHECK(!im2col_data);
+    gemm(input_data, 0, FlatSizeSkipDim(input_shape, 4));
+    return;
+  }
+  TFLITE_DCHECK(im2col_data);
+  const int filter_depth = filter_shape.Dims(0);
+  const int filter_height = filter_shape.Dims(1);
+  const int filter_width = filter_shape.Dims(2);
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  const int output_depth = output_shape.Dims(1);
+  const int output_height = output_shape.Dims(2);
+  const int output_width = output_shape.Dims(3);
+  const int row_size = output_width * filter_depth * filter_height *
+                       filter_width * input_shape.Dims(4);
+  const int num_rows = batches * output_depth * output_height;
+  TFLITE_DCHECK_GE(im2col_shape.FlatSize(), row_size);
+  const int chunk_rows = std::max(1, im2col_shape.FlatSize() / row_size);
+
+  for (int chunk_begin = 0; chunk_begin < num_rows;
+       chunk_begin += chunk_rows) {
+    const int chunk_size = std::min(chunk_rows, num_rows - chunk_begin);
+    gather_internal::ForEachRow(
+        chunk_size, row_size * sizeof(T), cpu_backend_context, [&](int i) {
+          const int row = chunk_begin + i;
+          const int out_y = row % output_height;
+          const int out_d = (row / output_height) % output_depth;
+          const int batch = row / (output_height * output_depth);
+          Im2col3DRow(params, filter_depth, filter_height, filter_width,
+                      zero_byte, input_shape, input_data, batch, out_d, out_y,
+                      output_width, im2col_data + i * row_size);
+        });
+    gemm(static_cast<const T*>(im2col_data), chunk_begin * output_width,
+         chunk_size * output_width);
+  }
+}
+
+}  // namespace conv3d_internal
+
+// The im2col matrix is built by chunks of rows of output pixels in
+// `im2col_data`, see conv3d_internal::ForEachIm2colChunk().
 inline TfLiteStatus Conv3D(
     const Conv3DParams& params, const RuntimeShape& input_shape,
     const float* input_data, const RuntimeShape& filter_shape,
@@ -7851,56 +8438,14 @@ inline TfLiteStatus Conv3D(
     const float* bias_data, const RuntimeShape& output_shape,
     float* output_data, const RuntimeShape& im2col_shape, float* im2col_data,
     CpuBackendContext* cpu_backend_context) {
-  const int stride_depth = params.stride_depth;
-  const int stride_height = params.stride_height;
-  const int stride_width = params.stride_width;
-  const int dilation_depth_factor = params.dilation_depth;
-  const int dilation_height_factor = params.dilation_height;
-  const int dilation_width_factor = params.dilation_width;
-  const float output_activation_min = params.float_activation_min;
-  const float output_activation_max = params.float_activation_max;
   TFLITE_DCHECK_EQ(input_shape.DimensionsCount(), 5);
   TFLITE_DCHECK_EQ(filter_shape.DimensionsCount(), 5);
   TFLITE_DCHECK_EQ(output_shape.DimensionsCount(), 5);
 
   ruy::profiler::ScopeLabel label("Conv3D");
 
-  // NB: the float 0.0f value is represented by all zero bytes.
-  const uint8_t float_zero_byte = 0x00;
-  const float* gemm_input_data = nullptr;
-  const RuntimeShape* gemm_input_shape = nullptr;
-  const int filter_width = filter_shape.Dims(2);
-  const int filter_height = filter_shape.Dims(1);
-  const int filter_depth = filter_shape.Dims(0);
-  const bool need_dilated_im2col = dilation_width_factor != 1 ||
-                                   dilation_height_factor != 1 ||
-                                   dilation_depth_factor != 1;
-  const bool need_im2col = stride_depth != 1 || stride_height != 1 ||
-                           stride_width != 1 || filter_depth != 1 ||
-                           filter_height != 1 || filter_width != 1;
-
-  if (need_dilated_im2col) {
-    DilatedIm2col3D(params, filter_depth, filter_height, filter_width,
-                    float_zero_byte, input_shape, input_data, im2col_shape,
-                    im2col_data);
-    gemm_input_data = im2col_data;
-    gemm_input_shape = &im2col_shape;
-  } else if (need_im2col) {
-    TFLITE_DCHECK(im2col_data);
-    Im2col3D(params, filter_depth, filter_height, filter_width, float_zero_byte,
-             input_shape, input_data, im2col_shape, im2col_data);
-    gemm_input_data = im2col_data;
-    gemm_input_shape = &im2col_shape;
-  } else {
-    TFLITE_DCHECK(!im2col_data);
-    gemm_input_data = input_data;
-    gemm_input_shape = &input_shape;
-  }
-
-  const int gemm_input_dims = gemm_input_shape->DimensionsCount();
-  int m = FlatSizeSkipDim(*gemm_input_shape, gemm_input_dims - 1);
-  int n = output_shape.Dims(4);
-  int k = gemm_input_shape->Dims(gemm_input_dims - 1);
+  const int n = output_shape.Dims(4);
+  const int k = FlatSizeSkipDim(filter_shape, 4);
 
   cpu_backend_gemm::MatrixParams<float> lhs_params;
   lhs_params.order = cpu_backend_gemm::Order::kColMajor;
@@ -7909,18 +8454,27 @@ inline TfLiteStatus Conv3D(
   cpu_backend_gemm::MatrixParams<float> rhs_params;
   rhs_params.order = cpu_backend_gemm::Order::kColMajor;
   rhs_params.rows = k;
-  rhs_params.cols = m;
   cpu_backend_gemm::MatrixParams<float> dst_params;
   dst_params.order = cpu_backend_gemm::Order::kColMajor;
   dst_params.rows = n;
-  dst_params.cols = m;
   cpu_backend_gemm::GemmParams<float, float> gemm_params;
   gemm_params.bias = bias_data;
-  gemm_params.clamp_min = output_activation_min;
-  gemm_params.clamp_max = output_activation_max;
-  cpu_backend_gemm::Gemm(lhs_params, filter_data, rhs_params, gemm_input_data,
-                         dst_params, output_data, gemm_params,
-                         cpu_backend_context);
+  gemm_params.clamp_min = params.float_activation_min;
+  gemm_params.clamp_max = params.float_activation_max;
+
+  // NB: the float 0.0f value is represented by all zero bytes.
+  const uint8_t float_zero_byte = 0x00;
+  conv3d_internal::ForEachIm2colChunk(
+      params, input_shape, input_data, filter_shape, output_shape,
+      im2col_shape, im2col_data, float_zero_byte, cpu_backend_context,
+      [&](const float* gemm_input_data, int first_pixel, int num_pixels) {
+        rhs_params.cols = num_pixels;
+        dst_params.cols = num_pixels;
+        cpu_backend_gemm::Gemm(lhs_params, filter_data, rhs_params,
+                               gemm_input_data, dst_params,
+                               output_data + first_pixel * n, gemm_params,
+                               cpu_backend_context);
+      });
   return kTfLiteOk;
 }
 
@@ -7928,6 +8482,8 @@ inline TfLiteStatus Conv3D(
 // order (planes, height, width, channel), constructed from patches in
 // 'col_data', which is required to be in storage order (out_planes * out_height
 // * out_width, filter_planes, filter_height, filter_width, in_channel).
+// Only the patches of the out planes [col_plane_begin, col_plane_end) are
+// accumulated, 'col_data' starting with those of col_plane_begin.
 //
 // This function is copied from tensorflow/core/kernels/conv_grad_ops_3d.cc
 // authored by Eugene Zhulenev(ezhulenev).
@@ -7937,12 +8493,13 @@ void Col2im(const T* col_data, const int channel, const int planes,
             const int filter_h, const int filter_w, const int pad_pt,
             const int pad_t, const int pad_l, const int pad_pb, const int pad_b,
             const int pad_r, const int stride_p, const int stride_h,
-            const int stride_w, T* im_data) {
+            const int stride_w, const int col_plane_begin,
+            const int col_plane_end, T* im_data) {
   const int planes_col = (planes + pad_pt + pad_pb - filter_p) / stride_p + 1;
   const int height_col = (height + pad_t + pad_b - filter_h) / stride_h + 1;
   const int width_col = (width + pad_l + pad_r - filter_w) / stride_w + 1;
-  int p_pad = -pad_pt;
-  for (int p = 0; p < planes_col; ++p) {
+  int p_pad = -pad_pt + col_plane_begin * stride_p;
+  for (int p = col_plane_begin; p < std::min(col_plane_end, planes_col); ++p) {
     int h_pad = -pad_t;
     for (int h = 0; h < height_col; ++h) {
       int w_pad = -pad_l;
@@ -8000,6 +8557,8 @@ void BiasAdd3D(T* im_data, const T* bias_data, const RuntimeShape& input_shape,
   }
 }
 
+// The patches are computed by chunks of input planes in `col2im_data`, which
+// holds as many planes of patches as fit in `col2im_shape`.
 inline void Conv3DTranspose(
     const Conv3DTransposeParams& params, const RuntimeShape& input_shape,
     const float* input_data, const RuntimeShape& filter_shape,
@@ -8050,30 +8609,43 @@ inline void Conv3DTranspose(
   lhs_params.order = cpu_backend_gemm::Order::kRowMajor;
   lhs_params.rows = filter_total_size;
   lhs_params.cols = input_channel;
+  const int input_planes = input_shape.Dims(1);
+  const int input_plane_size = input_shape.Dims(2) * input_shape.Dims(3);
+  TFLITE_DCHECK_GE(col2im_shape.FlatSize(),
+                   input_plane_size * filter_total_size);
+  const int chunk_planes = std::max(
+      1, col2im_shape.FlatSize() / (input_plane_size * filter_total_size));
   float* output_data_p = output_data;
   std::fill_n(output_data, output_offset * batch_size, 0.0f);
   for (int i = 0; i < batch_size; ++i) {
-    cpu_backend_gemm::MatrixParams<float> rhs_params;
-    rhs_params.order = cpu_backend_gemm::Order::kColMajor;
-    rhs_params.rows = input_channel;
-    rhs_params.cols = input_spatial_size;
-    cpu_backend_gemm::MatrixParams<float> dst_params;
-    dst_params.order = cpu_backend_gemm::Order::kColMajor;
-    dst_params.rows = filter_total_size;
-    dst_params.cols = input_spatial_size;
-    cpu_backend_gemm::GemmParams<float, float> gemm_params;
-    cpu_backend_gemm::Gemm(lhs_params, filter_data, rhs_params,
-                           input_data + input_offset * i, dst_params,
-                           col2im_data, gemm_params, cpu_backend_context);
-
-    Col2im(col2im_data, output_channel, output_spatial_dim_1,
-           output_spatial_dim_2, output_spatial_dim_3, filter_spatial_dim_1,
-           filter_spatial_dim_2, filter_spatial_dim_3,
-           spatial_dim_1_padding_before, spatial_dim_2_padding_before,
-           spatial_dim_3_padding_before, spatial_dim_1_padding_after,
-           spatial_dim_2_padding_after, spatial_dim_3_padding_after,
-           spatial_dim_1_stride, spatial_dim_2_stride, spatial_dim_3_stride,
-           output_data_p);
+    for (int plane_begin = 0; plane_begin < input_planes;
+         plane_begin += chunk_planes) {
+      const int plane_end = std::min(plane_begin + chunk_planes, input_planes);
+      const int num_cols = (plane_end - plane_begin) * input_plane_size;
+      cpu_backend_gemm::MatrixParams<float> rhs_params;
+      rhs_params.order = cpu_backend_gemm::Order::kColMajor;
+      rhs_params.rows = input_channel;
+      rhs_params.cols = num_cols;
+      cpu_backend_gemm::MatrixParams<float> dst_params;
+      dst_params.order = cpu_backend_gemm::Order::kColMajor;
+      dst_params.rows = filter_total_size;
+      dst_params.cols = num_cols;
+      cpu_backend_gemm::GemmParams<float, float> gemm_params;
+      cpu_backend_gemm::Gemm(
+          lhs_params, filter_data, rhs_params,
+          input_data + input_offset * i +
+              plane_begin * input_plane_size * input_channel,
+          dst_params, col2im_data, gemm_params, cpu_backend_context);
+
+      Col2im(col2im_data, output_channel, output_spatial_dim_1,
+             output_spatial_dim_2, output_spatial_dim_3, filter_spatial_dim_1,
+             filter_spatial_dim_2, filter_spatial_dim_3,
+             spatial_dim_1_padding_before, spatial_dim_2_padding_before,
+             spatial_dim_3_padding_before, spatial_dim_1_padding_after,
+             spatial_dim_2_padding_after, spatial_dim_3_padding_after,
+             spatial_dim_1_stride, spatial_dim_2_stride, spatial_dim_3_stride,
+             plane_begin, plane_end, output_data_p);
+    }
     output_data_p += output_offset;
   }
   output_data_p = output_data;
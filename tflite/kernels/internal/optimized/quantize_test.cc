@@ -0,0 +1,330 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/internal/optimized/optimized_ops.h"
+#include "tflite/kernels/internal/reference/dequantize.h"
+#include "tflite/kernels/internal/reference/quantize.h"
+#include "tflite/kernels/internal/reference/requantize.h"
+#include "tflite/kernels/internal/runtime_shape.h"
+#include "tflite/kernels/internal/types.h"
+
+#ifdef QUANTIZE_BENCHMARKS
+#include "testing/base/public/benchmark.h"
+#endif  // QUANTIZE_BENCHMARKS
+
+namespace tflite {
+namespace {
+
+std::vector<float> RandomFloats(int size, float min, float max) {
+  std::mt19937 random_engine(size);
+  std::uniform_real_distribution<float> distribution(min, max);
+  std::vector<float> values(size);
+  for (float& value : values) {
+    value = distribution(random_engine);
+  }
+  return values;
+}
+
+template <typename T>
+std::vector<T> RandomInts(int size) {
+  std::mt19937 random_engine(size);
+  std::uniform_int_distribution<int32_t> distribution(
+      std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+  std::vector<T> values(size);
+  for (T& value : values) {
+    value = static_cast<T>(distribution(random_engine));
+  }
+  return values;
+}
+
+// Scales and zero points of the channels, different for each channel.
+struct ChannelParams {
+  explicit ChannelParams(int num_channels) {
+    for (int c = 0; c < num_channels; ++c) {
+      scales.push_back(0.01f * (c % 7 + 1));
+      zero_points.push_back(c % 5 - 2);
+    }
+  }
+
+  std::vector<float> scales;
+  std::vector<int32_t> zero_points;
+};
+
+template <typename T>
+void ExpectPerChannelQuantizeMatchesReference(const RuntimeShape& shape,
+                                              int quantized_dimension,
+                                              int num_threads) {
+  const ChannelParams channel_params(shape.Dims(quantized_dimension));
+  PerChannelQuantizationParams op_params;
+  op_params.quantized_dimension = quantized_dimension;
+  op_params.scale = channel_params.scales.data();
+  op_params.zero_point = channel_params.zero_points.data();
+  // Some of the values are out of range of the most scaled channels.
+  const std::vector<float> input =
+      RandomFloats(shape.FlatSize(), -400.0f, 400.0f);
+  std::vector<T> expected(input.size());
+  reference_ops::PerChannelQuantize(op_params, shape, input.data(), shape,
+                                    expected.data());
+
+  CpuBackendContext cpu_backend_context;
+  cpu_backend_context.SetMaxNumThreads(num_threads);
+  std::vector<T> output(input.size());
+  optimized_ops::PerChannelQuantize(op_params, shape, input.data(), shape,
+                                    output.data(), &cpu_backend_context);
+  EXPECT_EQ(output, expected);
+}
+
+template <typename T>
+void ExpectPerChannelDequantizeMatchesReference(const RuntimeShape& shape,
+                                                int quantized_dimension,
+                                                int num_threads) {
+  const ChannelParams channel_params(shape.Dims(quantized_dimension));
+  PerChannelDequantizationParams op_params;
+  op_params.quantized_dimension = quantized_dimension;
+  op_params.scale = channel_params.scales.data();
+  op_params.zero_point = channel_params.zero_points.data();
+  const std::vector<T> input = RandomInts<T>(shape.FlatSize());
+  std::vector<float> expected(input.size());
+  reference_ops::PerChannelDequantize(op_params, shape, input.data(), shape,
+                                      expected.data());
+
+  CpuBackendContext cpu_backend_context;
+  cpu_backend_context.SetMaxNumThreads(num_threads);
+  std::vector<float> output(input.size());
+  optimized_ops::PerChannelDequantize(op_params, shape, input.data(), shape,
+                                      output.data(), &cpu_backend_context);
+  EXPECT_EQ(output, expected);
+}
+
+TEST(PerChannelQuantizeTest, MatchesReferenceAlongEachDimension) {
+  const RuntimeShape shape({2, 3, 17, 5});
+  for (int quantized_dimension = 0; quantized_dimension < 4;
+       ++quantized_dimension) {
+    ExpectPerChannelQuantizeMatchesReference<int8_t>(shape,
+                                                     quantized_dimension, 1);
+    ExpectPerChannelQuantizeMatchesReference<uint8_t>(shape,
+                                                      quantized_dimension, 1);
+    ExpectPerChannelQuantizeMatchesReference<int16_t>(shape,
+                                                      quantized_dimension, 1);
+  }
+}
+
+TEST(PerChannelQuantizeTest, MultithreadedMatchesReference) {
+  // The channels are long enough to be split among the threads, or all held
+  // by each row split among them when quantized along the innermost axis.
+  const RuntimeShape shape({4, 64, 1024});
+  ExpectPerChannelQuantizeMatchesReference<int8_t>(shape, 1, 4);
+  ExpectPerChannelQuantizeMatchesReference<int16_t>(shape, 2, 4);
+}
+
+TEST(PerChannelDequantizeTest, MatchesReferenceAlongEachDimension) {
+  const RuntimeShape shape({2, 3, 17, 5});
+  for (int quantized_dimension = 0; quantized_dimension < 4;
+       ++quantized_dimension) {
+    ExpectPerChannelDequantizeMatchesReference<int8_t>(shape,
+                                                       quantized_dimension, 1);
+    ExpectPerChannelDequantizeMatchesReference<uint8_t>(
+        shape, quantized_dimension, 1);
+  }
+}
+
+TEST(PerChannelDequantizeTest, MultithreadedMatchesReference) {
+  const RuntimeShape shape({4, 64, 1024});
+  ExpectPerChannelDequantizeMatchesReference<int8_t>(shape, 1, 4);
+  ExpectPerChannelDequantizeMatchesReference<uint8_t>(shape, 2, 4);
+}
+
+// The size of the tensors converted by several threads, not a multiple of
+// the blocks they are split in.
+constexpr int kMultithreadedSize = 1000003;
+
+template <typename T>
+void ExpectMultithreadedAffineQuantizeMatchesSingleThreaded() {
+  QuantizationParams op_params;
+  op_params.zero_point = 3;
+  op_params.scale = 0.02f;
+  const RuntimeShape shape({kMultithreadedSize});
+  const std::vector<float> input =
+      RandomFloats(kMultithreadedSize, -1000.0f, 1000.0f);
+  std::vector<T> expected(kMultithreadedSize);
+  optimized_ops::AffineQuantize(op_params, shape, input.data(), shape,
+                                expected.data());
+
+  CpuBackendContext cpu_backend_context;
+  cpu_backend_context.SetMaxNumThreads(4);
+  std::vector<T> output(kMultithreadedSize);
+  optimized_ops::AffineQuantize(op_params, shape, input.data(), shape,
+                                output.data(), &cpu_backend_context);
+  EXPECT_EQ(output, expected);
+}
+
+TEST(AffineQuantizeTest, MultithreadedMatchesSingleThreaded) {
+  ExpectMultithreadedAffineQuantizeMatchesSingleThreaded<int8_t>();
+  ExpectMultithreadedAffineQuantizeMatchesSingleThreaded<uint8_t>();
+  ExpectMultithreadedAffineQuantizeMatchesSingleThreaded<int16_t>();
+}
+
+template <typename T>
+void ExpectMultithreadedDequantizeMatchesSingleThreaded() {
+  DequantizationParams op_params;
+  op_params.zero_point = -1;
+  op_params.scale = 0.25;
+  const RuntimeShape shape({kMultithreadedSize});
+  const std::vector<T> input = RandomInts<T>(kMultithreadedSize);
+  std::vector<float> expected(kMultithreadedSize);
+  optimized_ops::Dequantize(op_params, shape, input.data(), shape,
+                            expected.data());
+
+  CpuBackendContext cpu_backend_context;
+  cpu_backend_context.SetMaxNumThreads(4);
+  std::vector<float> output(kMultithreadedSize);
+  optimized_ops::Dequantize(op_params, shape, input.data(), shape,
+                            output.data(), &cpu_backend_context);
+  EXPECT_EQ(output, expected);
+}
+
+TEST(DequantizeTest, MultithreadedMatchesSingleThreaded) {
+  ExpectMultithreadedDequantizeMatchesSingleThreaded<int8_t>();
+  ExpectMultithreadedDequantizeMatchesSingleThreaded<uint8_t>();
+  ExpectMultithreadedDequantizeMatchesSingleThreaded<int16_t>();
+}
+
+TEST(DequantizeTest, MultithreadedFloat16MatchesReference) {
+  const RuntimeShape shape({kMultithreadedSize});
+  const std::vector<float> values =
+      RandomFloats(kMultithreadedSize, -100.0f, 100.0f);
+  std::vector<Eigen::half> input(values.begin(), values.end());
+  std::vector<float> expected(kMultithreadedSize);
+  reference_ops::Dequantize(shape, input.data(), shape, expected.data());
+
+  CpuBackendContext cpu_backend_context;
+  cpu_backend_context.SetMaxNumThreads(4);
+  std::vector<float> output(kMultithreadedSize);
+  optimized_ops::Dequantize(shape, input.data(), shape, output.data(),
+                            &cpu_backend_context);
+  EXPECT_EQ(output, expected);
+}
+
+TEST(RequantizeTest, MultithreadedMatchesReference) {
+  const std::vector<int16_t> input = RandomInts<int16_t>(kMultithreadedSize);
+  const int32_t multiplier = 1 << 30;
+  const int32_t shift = -6;
+  std::vector<int8_t> expected(kMultithreadedSize);
+  reference_ops::Requantize(input.data(), kMultithreadedSize, multiplier,
+                            shift, /*input_zeropoint=*/2,
+                            /*output_zeropoint=*/-3, expected.data());
+
+  CpuBackendContext cpu_backend_context;
+  cpu_backend_context.SetMaxNumThreads(4);
+  std::vector<int8_t> output(kMultithreadedSize);
+  optimized_ops::Requantize(input.data(), kMultithreadedSize, multiplier,
+                            shift, /*input_zeropoint=*/2,
+                            /*output_zeropoint=*/-3, output.data(),
+                            &cpu_backend_context);
+  EXPECT_EQ(output, expected);
+}
+
+#ifdef QUANTIZE_BENCHMARKS
+
+// Compile with --copt="-DGOOGLE_COMMANDLINEFLAGS_FULL_API=1" and
+// --copt="-DQUANTIZE_BENCHMARKS"
+// Run with --benchmark_filter=all
+//
+// Quantizes a float tensor to int8, the arguments being the number of elements
+// and of threads.
+void BM_AffineQuantizeInt8(benchmark::State& state) {
+  const int size = state.range(0);
+  tflite::CpuBackendContext cpu_backend_context;
+  cpu_backend_context.SetMaxNumThreads(state.range(1));
+  QuantizationParams op_params;
+  op_params.zero_point = 0;
+  op_params.scale = 0.1f;
+  const RuntimeShape shape({size});
+  std::vector<float> input(size, 1.0f);
+  std::vector<int8_t> output(size);
+  for (auto _ : state) {
+    optimized_ops::AffineQuantize(op_params, shape, input.data(), shape,
+                                  output.data(), &cpu_backend_context);
+    testing::DoNotOptimize(output[0]);
+  }
+  state.SetBytesProcessed(state.iterations() * size * sizeof(float));
+}
+BENCHMARK(BM_AffineQuantizeInt8)
+    ->Args({1 << 16, 1})
+    ->Args({1 << 22, 1})
+    ->Args({1 << 22, 4});
+
+// Dequantizes an int8 tensor, the arguments being the number of elements and
+// of threads.
+void BM_DequantizeInt8(benchmark::State& state) {
+  const int size = state.range(0);
+  tflite::CpuBackendContext cpu_backend_context;
+  cpu_backend_context.SetMaxNumThreads(state.range(1));
+  DequantizationParams op_params;
+  op_params.zero_point = 0;
+  op_params.scale = 0.1;
+  const RuntimeShape shape({size});
+  std::vector<int8_t> input(size, 1);
+  std::vector<float> output(size);
+  for (auto _ : state) {
+    optimized_ops::Dequantize(op_params, shape, input.data(), shape,
+                              output.data(), &cpu_backend_context);
+    testing::DoNotOptimize(output[0]);
+  }
+  state.SetBytesProcessed(state.iterations() * size * sizeof(float));
+}
+BENCHMARK(BM_DequantizeInt8)
+    ->Args({1 << 16, 1})
+    ->Args({1 << 22, 1})
+    ->Args({1 << 22, 4});
+
+// Quantizes a [rows, channels] float tensor per channel to int8, the arguments
+// being rows, channels, the quantized dimension and the number of threads.
+void BM_PerChannelQuantizeInt8(benchmark::State& state) {
+  const RuntimeShape shape(
+      {static_cast<int>(state.range(0)), static_cast<int>(state.range(1))});
+  const int quantized_dimension = state.range(2);
+  tflite::CpuBackendContext cpu_backend_context;
+  cpu_backend_context.SetMaxNumThreads(state.range(3));
+  const ChannelParams channel_params(shape.Dims(quantized_dimension));
+  PerChannelQuantizationParams op_params;
+  op_params.quantized_dimension = quantized_dimension;
+  op_params.scale = channel_params.scales.data();
+  op_params.zero_point = channel_params.zero_points.data();
+  std::vector<float> input(shape.FlatSize(), 1.0f);
+  std::vector<int8_t> output(shape.FlatSize());
+  for (auto _ : state) {
+    optimized_ops::PerChannelQuantize(op_params, shape, input.data(), shape,
+                                      output.data(), &cpu_backend_context);
+    testing::DoNotOptimize(output[0]);
+  }
+  state.SetBytesProcessed(state.iterations() * input.size() * sizeof(float));
+}
+BENCHMARK(BM_PerChannelQuantizeInt8)
+    ->Args({1024, 4096, 0, 1})
+    ->Args({1024, 4096, 1, 1})
+    ->Args({1024, 4096, 0, 4})
+    ->Args({1024, 4096, 1, 4});
+
+#endif  // QUANTIZE_BENCHMARKS
+
+}  // namespace
+}  // namespace tflite
@@ -18,10 +18,15 @@ limitations under the License.
 #include <stdint.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "ruy/profiler/instrumentation.h"  // from @ruy
+#include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/kernels/cpu_backend_threadpool.h"
 #include "tflite/kernels/internal/optimized/optimized_ops_utils.h"
 #include "tflite/kernels/internal/optimized/reduce_utils.h"
@@ -263,6 +268,7 @@ template <typename T>
 struct SumOp {
   inline T operator()(const T& a) const { return a; }
   inline T operator()(const T& a, const T& b) const { return a + b; }
+  inline T Combine(const T& a, const T& b) const { return a + b; }
   static constexpr T kNeutralElement = T(0);
 };
 
@@ -272,6 +278,7 @@ struct CastSumOp {
   inline U operator()(const U& a, const T& b) const {
     return a + static_cast<U>(b);
   }
+  inline U Combine(const U& a, const U& b) const { return a + b; }
   static constexpr U kNeutralElement = U(0);
 };
 
@@ -279,6 +286,7 @@ template <typename T>
 struct ProdOp {
   inline T operator()(const T& a) const { return a; }
   inline T operator()(const T& a, const T& b) const { return a * b; }
+  inline T Combine(const T& a, const T& b) const { return a * b; }
   static constexpr T kNeutralElement = T(1);
 };
 
@@ -286,6 +294,7 @@ template <typename T>
 struct MaxOp {
   inline T operator()(const T& a) const { return a; }
   inline T operator()(const T& a, const T& b) const { return (a > b) ? a : b; }
+  inline T Combine(const T& a, const T& b) const { return (a > b) ? a : b; }
   static constexpr T kNeutralElement = std::numeric_limits<T>::lowest();
 };
 
@@ -293,21 +302,77 @@ template <typename T>
 struct MinOp {
   inline T operator()(const T& a) const { return a; }
   inline T operator()(const T& a, const T& b) const { return (a < b) ? a : b; }
+  inline T Combine(const T& a, const T& b) const { return (a < b) ? a : b; }
   static constexpr T kNeutralElement = std::numeric_limits<T>::max();
 };
 
 struct AndOp {
   inline bool operator()(bool a) const { return a; }
   inline bool operator()(bool a, bool b) const { return a && b; }
+  inline bool Combine(bool a, bool b) const { return a && b; }
   static constexpr bool kNeutralElement = true;
 };
 
 struct OrOp {
   inline bool operator()(bool a) const { return a; }
   inline bool operator()(bool a, bool b) const { return a || b; }
+  inline bool Combine(bool a, bool b) const { return a || b; }
   static constexpr bool kNeutralElement = false;
 };
 
+// Whether the partial results of a reducer can be combined with its
+// `Combine()` method, in which case a reduction can be split in independent
+// parts. The reducers rescaling each step, like the quantized product, can't.
+template <typename Reducer, typename = void>
+struct IsCombinable : std::false_type {};
+
+template <typename Reducer>
+struct IsCombinable<Reducer, std::void_t<decltype(&Reducer::Combine)>>
+    : std::true_type {};
+
+// How many bytes of independent partial results ReduceRun() keeps, which is
+// the width of the widest vector registers it is vectorized for.
+constexpr int kReduceLanesBytes = 32;
+
+// Reduces the `size` > 0 contiguous inputs into one value. Combinable reducers
+// keep one partial result per lane, which the compiler vectorizes and which
+// breaks the dependency between consecutive floating point operations.
+template <typename T, typename U, typename ReducerFirst, typename ReducerNext>
+inline U ReduceRun(const T* input_data, int size,
+                   const ReducerFirst& reducer_first,
+                   const ReducerNext& reducer_next) {
+  if constexpr (IsCombinable<ReducerNext>::value) {
+    constexpr int kLanes = std::max<int>(4, kReduceLanesBytes / sizeof(U));
+    if (size >= 2 * kLanes) {
+      U lanes[kLanes];
+      for (int j = 0; j < kLanes; ++j) {
+        lanes[j] = reducer_first(input_data[j]);
+      }
+      int i = kLanes;
+      for (; i + kLanes <= size; i += kLanes) {
+        for (int j = 0; j < kLanes; ++j) {
+          lanes[j] = reducer_next(lanes[j], input_data[i + j]);
+        }
+      }
+      for (int width = kLanes / 2; width > 0; width /= 2) {
+        for (int j = 0; j < width; ++j) {
+          lanes[j] = reducer_next.Combine(lanes[j], lanes[j + width]);
+        }
+      }
+      U res = lanes[0];
+      for (; i < size; ++i) {
+        res = reducer_next(res, input_data[i]);
+      }
+      return res;
+    }
+  }
+  U res = reducer_first(input_data[0]);
+  for (int i = 1; i < size; ++i) {
+    res = reducer_next(res, input_data[i]);
+  }
+  return res;
+}
+
 // When the number of axis is zero, the reduction is simply a copy.
 template <typename T>
 void ReduceIsCopy(const T* input_data, const int* input_dims,
@@ -353,10 +418,20 @@ inline std::pair<const T*, U*> ReduceImpl(const T* input_data,
     if (parity) {
       // Reduce the even dimension. The entire dimension is reduced into one
       // value.
-      U res = next ? reducer_next(*output_data, *input_data++)
+      U res;
+      if constexpr (IsCombinable<ReducerNext>::value) {
+        res = ReduceRun<T, U>(input_data, input_dims[0], reducer_first,
+                              reducer_next);
+        if (next) {
+          res = reducer_next.Combine(*output_data, res);
+        }
+        input_data += input_dims[0];
+      } else {
+        res = next ? reducer_next(*output_data, *input_data++)
                    : reducer_first(*input_data++);
-      for (int i = 1; i < input_dims[0]; ++i) {
-        res = reducer_next(res, *input_data++);
+        for (int i = 1; i < input_dims[0]; ++i) {
+          res = reducer_next(res, *input_data++);
+        }
       }
       *output_data++ = res;
     } else {
@@ -379,18 +454,152 @@ inline std::pair<const T*, U*> ReduceImpl(const T* input_data,
   return {input_data, output_data};
 }
 
+// Reductions are split in tasks of at least this many input elements.
+constexpr size_t kMinReduceElementsPerTask = 16384;
+
+template <typename Work>
+struct ReduceWorkTask : cpu_backend_threadpool::Task {
+  ReduceWorkTask(const Work& work, int task, int begin, int end)
+      : work(work), task(task), begin(begin), end(end) {}
+  void Run() override { work(task, begin, end); }
+
+  const Work& work;
+  int task;
+  int begin;
+  int end;
+};
+
+// Runs `work(task, begin, end)` over [0, size) split in `num_tasks` tasks.
+template <typename Work>
+void RunReduceWork(int size, int num_tasks,
+                   CpuBackendContext* cpu_backend_context, const Work& work) {
+  std::vector<ReduceWorkTask<Work>> tasks;
+  tasks.reserve(num_tasks);
+  for (int i = 0; i < num_tasks; ++i) {
+    tasks.emplace_back(work, i, static_cast<int64_t>(size) * i / num_tasks,
+                       static_cast<int64_t>(size) * (i + 1) / num_tasks);
+  }
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                  cpu_backend_context);
+}
+
+// Splits the reduction of ReduceImpl() across the threads of
+// `cpu_backend_context`, over the outermost kept dimension of the normalized
+// `input_dims`, whose kept and reduced dimensions alternate. Returns false if
+// the reduction is too small to be split.
+template <typename In, typename Out, typename ReducerFirst,
+          typename ReducerNext>
+inline bool ReduceMultithreaded(const In* input_data, const int* input_dims,
+                                const int input_num_dims, int parity,
+                                Out* output_data,
+                                const ReducerFirst& reducer_first,
+                                const ReducerNext& reducer_next,
+                                CpuBackendContext* cpu_backend_context) {
+  if (cpu_backend_context == nullptr ||
+      cpu_backend_context->max_num_threads() <= 1) {
+    return false;
+  }
+  const size_t num_elements = NumElements(input_dims, input_num_dims);
+  const int max_tasks = static_cast<int>(std::min<size_t>(
+      cpu_backend_context->max_num_threads(),
+      num_elements / kMinReduceElementsPerTask));
+  const int depth = input_num_dims - 1;
+  // The dimension at depth `d` is kept if (d % 2) == parity.
+  const bool outer_is_kept = (depth % 2) == parity;
+
+  if (outer_is_kept && input_dims[0] > 1) {
+    // Each task reduces some of the outermost slices into their own outputs.
+    const int num_tasks = std::min(max_tasks, input_dims[0]);
+    if (num_tasks <= 1) return false;
+    const size_t input_stride = num_elements / input_dims[0];
+    size_t output_stride = 1;
+    for (int i = 2; i < input_num_dims; i += 2) {
+      output_stride *= input_dims[i];
+    }
+    RunReduceWork(input_dims[0], num_tasks, cpu_backend_context,
+                  [&](int, int begin, int end) {
+                    std::vector<int> dims(input_dims,
+                                          input_dims + input_num_dims);
+                    dims[0] = end - begin;
+                    ReduceImpl(input_data + begin * input_stride, dims.data(),
+                               output_data + begin * output_stride, depth,
+                               parity, /*next=*/false, reducer_first,
+                               reducer_next);
+                  });
+    return true;
+  }
+
+  if (!outer_is_kept && input_num_dims > 1 && input_dims[1] > 1) {
+    // Each task reduces some of the columns of the second, kept, dimension,
+    // over all the rows of the outermost, reduced, one.
+    const int num_tasks = std::min(max_tasks, input_dims[1]);
+    if (num_tasks <= 1) return false;
+    const size_t row_stride = num_elements / input_dims[0];
+    const size_t column_stride = row_stride / input_dims[1];
+    size_t output_stride = 1;
+    for (int i = 3; i < input_num_dims; i += 2) {
+      output_stride *= input_dims[i];
+    }
+    RunReduceWork(
+        input_dims[1], num_tasks, cpu_backend_context,
+        [&](int, int begin, int end) {
+          std::vector<int> dims(input_dims + 1, input_dims + input_num_dims);
+          dims[0] = end - begin;
+          for (int row = 0; row < input_dims[0]; ++row) {
+            ReduceImpl(input_data + row * row_stride + begin * column_stride,
+                       dims.data(), output_data + begin * output_stride,
+                       depth - 1, parity, /*next=*/row > 0, reducer_first,
+                       reducer_next);
+          }
+        });
+    return true;
+  }
+
+  if constexpr (IsCombinable<ReducerNext>::value) {
+    if (input_num_dims == 1) {
+      // Everything is reduced into one value: each task reduces a part of the
+      // input, and the partial results are combined.
+      const int num_tasks = std::min(max_tasks, input_dims[0]);
+      if (num_tasks <= 1) return false;
+      // Not a vector, which packs bools.
+      std::unique_ptr<Out[]> partial_results(new Out[num_tasks]);
+      RunReduceWork(input_dims[0], num_tasks, cpu_backend_context,
+                    [&](int task, int begin, int end) {
+                      partial_results[task] =
+                          ReduceRun<In, Out>(input_data + begin, end - begin,
+                                             reducer_first, reducer_next);
+                    });
+      Out res = partial_results[0];
+      for (int i = 1; i < num_tasks; ++i) {
+        res = reducer_next.Combine(res, partial_results[i]);
+      }
+      *output_data = res;
+      return true;
+    }
+  }
+  return false;
+}
+
 // A generic reduce method that can be used for reduce_sum, reduce_mean, etc.
 // This method iterates through input data and reduce elements along the
 // dimensions given in axis. ReducerFirst is used the first time each output
 // element is written and ReducerNext is used for all subsequent writes.
+// The reduction is split across the threads of `cpu_backend_context` if it is
+// set and the input is large enough.
 template <typename In, typename Out, typename ReducerFirst,
           typename ReducerNext>
 inline bool Reduce(const In* input_data, const int* input_dims,
                    const int input_num_dims, const int* axis,
                    const int num_axis, Out* output_data,
                    const ReducerFirst& reducer_first,
-                   const ReducerNext& reducer_next) {
+                   const ReducerNext& reducer_next,
+                   CpuBackendContext* cpu_backend_context = nullptr) {
   const int parity = (axis[num_axis - 1] == input_num_dims - 1) ? 1 : 0;
+  if (ReduceMultithreaded(input_data, input_dims, input_num_dims, parity,
+                          output_data, reducer_first, reducer_next,
+                          cpu_backend_context)) {
+    return true;
+  }
   ReduceImpl(input_data, input_dims, output_data, input_num_dims - 1, parity,
              /*next=*/false, reducer_first, reducer_next);
   return true;
@@ -407,7 +616,8 @@ bool QuantizedMeanOrSum(const T* input_data, int32_t input_zero_point,
                         const int* output_dims, const int output_num_dims,
                         const int* axis, const int num_axis_dimensions,
                         bool keep_dims, int* normalized_dims,
-                        int* resolved_axis, U* temp_sum, bool compute_sum) {
+                        int* resolved_axis, U* temp_sum, bool compute_sum,
+                        CpuBackendContext* cpu_backend_context = nullptr) {
   const int32_t kMinValue = std::numeric_limits<T>::min();
   const int32_t kMaxValue = std::numeric_limits<T>::max();
   ruy::profiler::ScopeLabel label(compute_sum ? "QuantizedSum"
@@ -448,8 +658,8 @@ bool QuantizedMeanOrSum(const T* input_data, int32_t input_zero_point,
   } else {
     if (!Reduce<T, U, CastSumOp<T, U>, CastSumOp<T, U>>(
             input_data, normalized_dims, normalized_num_dims, resolved_axis,
-            num_resolved_axis, temp_sum, CastSumOp<T, U>(),
-            CastSumOp<T, U>())) {
+            num_resolved_axis, temp_sum, CastSumOp<T, U>(), CastSumOp<T, U>(),
+            cpu_backend_context)) {
       return false;
     }
   }
@@ -499,7 +709,8 @@ inline bool ReduceDispatcher(const T* input_data, const int* input_dims,
                              const int input_num_dims, const int* output_dims,
                              int output_num_dims, T* output_data,
                              const int* axis, const int64_t num_axis_dimensions,
-                             ReduceType reduce_type) {
+                             ReduceType reduce_type,
+                             CpuBackendContext* cpu_backend_context) {
   T init_value;
   switch (reduce_type) {
     case ReduceType::kProd:
@@ -532,19 +743,19 @@ inline bool ReduceDispatcher(const T* input_data, const int* input_dims,
     case ReduceType::kProd:
       return Reduce<T, T, ProdOp<T>, ProdOp<T>>(
           input_data, input_dims, input_num_dims, axis, num_axis_dimensions,
-          output_data, ProdOp<T>(), ProdOp<T>());
+          output_data, ProdOp<T>(), ProdOp<T>(), cpu_backend_context);
     case ReduceType::kSum:
       return Reduce<T, T, SumOp<T>, SumOp<T>>(
           input_data, input_dims, input_num_dims, axis, num_axis_dimensions,
-          output_data, SumOp<T>(), SumOp<T>());
+          output_data, SumOp<T>(), SumOp<T>(), cpu_backend_context);
     case ReduceType::kMin:
       return Reduce<T, T, MinOp<T>, MinOp<T>>(
           input_data, input_dims, input_num_dims, axis, num_axis_dimensions,
-          output_data, MinOp<T>(), MinOp<T>());
+          output_data, MinOp<T>(), MinOp<T>(), cpu_backend_context);
     case ReduceType::kMax:
       return Reduce<T, T, MaxOp<T>, MaxOp<T>>(
           input_data, input_dims, input_num_dims, axis, num_axis_dimensions,
-          output_data, MaxOp<T>(), MaxOp<T>());
+          output_data, MaxOp<T>(), MaxOp<T>(), cpu_backend_context);
     default:
       return false;
   }
@@ -557,7 +768,8 @@ inline bool ReduceDispatcher<bool>(const bool* input_data,
                                    const int* output_dims, int output_num_dims,
                                    bool* output_data, const int* axis,
                                    const int64_t num_axis_dimensions,
-                                   ReduceType reduce_type) {
+                                   ReduceType reduce_type,
+                                   CpuBackendContext* cpu_backend_context) {
   bool init_value;
   switch (reduce_type) {
     case ReduceType::kAny:
@@ -583,11 +795,11 @@ inline bool ReduceDispatcher<bool>(const bool* input_data,
     case ReduceType::kAll:
       return Reduce<bool, bool, AndOp, AndOp>(
           input_data, input_dims, input_num_dims, axis, num_axis_dimensions,
-          output_data, AndOp(), AndOp());
+          output_data, AndOp(), AndOp(), cpu_backend_context);
     case ReduceType::kAny:
       return Reduce<bool, bool, OrOp, OrOp>(
           input_data, input_dims, input_num_dims, axis, num_axis_dimensions,
-          output_data, OrOp(), OrOp());
+          output_data, OrOp(), OrOp(), cpu_backend_context);
     default:
       return false;
   }
@@ -784,7 +996,8 @@ inline bool ReduceGeneric(const T* input_data, const int* input_dims,
                           const int* output_dims, const int output_num_dims,
                           const int* axis, const int64_t num_axis_dimensions,
                           int* resolved_axis, int* normalized_dims,
-                          ReduceType reduce_type) {
+                          ReduceType reduce_type,
+                          CpuBackendContext* cpu_backend_context = nullptr) {
   int num_resolved_axis = 0;
   int normalized_num_dims = 0;
   if (!reduce_utils::ResolveAxis(input_num_dims, axis, num_axis_dimensions,
@@ -799,7 +1012,8 @@ inline bool ReduceGeneric(const T* input_data, const int* input_dims,
   }
   return ReduceDispatcher(input_data, normalized_dims, normalized_num_dims,
                           output_dims, output_num_dims, output_data,
-                          resolved_axis, num_resolved_axis, reduce_type);
+                          resolved_axis, num_resolved_axis, reduce_type,
+                          cpu_backend_context);
 }
 
 }  // namespace optimized_ops
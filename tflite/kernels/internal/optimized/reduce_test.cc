@@ -0,0 +1,220 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/kernels/internal/optimized/reduce.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/internal/reference/reduce.h"
+#include "tflite/kernels/internal/reduce_common.h"
+
+#ifdef REDUCE_BENCHMARKS
+#include "testing/base/public/benchmark.h"
+#endif  // REDUCE_BENCHMARKS
+
+namespace tflite {
+namespace {
+
+using ops::builtin::reduce::ReduceType;
+
+template <ReduceType reduce_type, typename T>
+T ReferenceReducer(const T current, const T in) {
+  switch (reduce_type) {
+    case ReduceType::kSum:
+      return current + in;
+    case ReduceType::kProd:
+      return current * in;
+    case ReduceType::kMax:
+      return in > current ? in : current;
+    default:
+      return in < current ? in : current;
+  }
+}
+
+template <typename T>
+T InitValue(ReduceType reduce_type) {
+  switch (reduce_type) {
+    case ReduceType::kProd:
+      return 1;
+    case ReduceType::kMax:
+      return std::numeric_limits<T>::lowest();
+    case ReduceType::kMin:
+      return std::numeric_limits<T>::max();
+    default:
+      return 0;
+  }
+}
+
+// Reduces `input` over `axis` with optimized_ops::ReduceGeneric() and checks
+// the result against reference_ops::ReduceGeneric().
+template <typename T>
+void ExpectReduceMatchesReference(const std::vector<int>& shape,
+                                  const std::vector<int>& axis,
+                                  const std::vector<T>& input,
+                                  ReduceType reduce_type,
+                                  CpuBackendContext* cpu_backend_context) {
+  std::vector<int> output_shape;
+  int output_size = 1;
+  for (int i = 0; i < shape.size(); ++i) {
+    if (std::find(axis.begin(), axis.end(), i) == axis.end()) {
+      output_shape.push_back(shape[i]);
+      output_size *= shape[i];
+    }
+  }
+  const int num_dims = shape.size();
+  std::vector<int> temp_index(num_dims);
+  std::vector<int> resolved_axis(num_dims);
+  std::vector<int> normalized_dims(num_dims);
+
+  std::vector<T> expected(output_size);
+  T (*reducer)(const T, const T);
+  switch (reduce_type) {
+    case ReduceType::kSum:
+      reducer = ReferenceReducer<ReduceType::kSum, T>;
+      break;
+    case ReduceType::kProd:
+      reducer = ReferenceReducer<ReduceType::kProd, T>;
+      break;
+    case ReduceType::kMax:
+      reducer = ReferenceReducer<ReduceType::kMax, T>;
+      break;
+    default:
+      reducer = ReferenceReducer<ReduceType::kMin, T>;
+      break;
+  }
+  ASSERT_TRUE(reference_ops::ReduceGeneric<T>(
+      input.data(), shape.data(), num_dims, expected.data(),
+      output_shape.data(), output_shape.size(), axis.data(), axis.size(),
+      /*keep_dims=*/false, temp_index.data(), resolved_axis.data(),
+      InitValue<T>(reduce_type), reducer));
+
+  std::vector<T> output(output_size);
+  ASSERT_TRUE(optimized_ops::ReduceGeneric<T>(
+      input.data(), shape.data(), num_dims, output.data(), output_shape.data(),
+      output_shape.size(), axis.data(), axis.size(), resolved_axis.data(),
+      normalized_dims.data(), reduce_type, cpu_backend_context));
+  ASSERT_EQ(output, expected);
+}
+
+// Returns small non zero integers, which floats sum exactly in any order, and
+// only -1 and 1 for products not to overflow.
+template <typename T>
+std::vector<T> RandomInput(int size, ReduceType reduce_type,
+                           std::mt19937* random_engine) {
+  const int max_value = reduce_type == ReduceType::kProd ? 1 : 3;
+  std::uniform_int_distribution<int> distribution(-max_value, max_value);
+  std::vector<T> input(size);
+  for (T& value : input) {
+    value = distribution(*random_engine);
+    if (value == 0) value = 1;
+  }
+  return input;
+}
+
+template <typename T>
+class OptimizedReduceTest : public ::testing::Test {};
+
+using ElementTypes = ::testing::Types<float, int8_t, int16_t, int32_t>;
+TYPED_TEST_SUITE(OptimizedReduceTest, ElementTypes);
+
+TYPED_TEST(OptimizedReduceTest, AllAxesCombinations) {
+  std::mt19937 random_engine(42);
+  const std::vector<int> shape = {3, 5, 2, 37};
+  for (int mask = 1; mask < (1 << shape.size()); ++mask) {
+    std::vector<int> axis;
+    for (int i = 0; i < shape.size(); ++i) {
+      if (mask & (1 << i)) axis.push_back(i);
+    }
+    for (ReduceType reduce_type : {ReduceType::kSum, ReduceType::kMax,
+                                   ReduceType::kMin, ReduceType::kProd}) {
+      ExpectReduceMatchesReference<TypeParam>(
+          shape, axis,
+          RandomInput<TypeParam>(3 * 5 * 2 * 37, reduce_type, &random_engine),
+          reduce_type, nullptr);
+    }
+  }
+}
+
+TYPED_TEST(OptimizedReduceTest, MultipleThreads) {
+  std::mt19937 random_engine(42);
+  CpuBackendContext cpu_backend_context;
+  cpu_backend_context.SetMaxNumThreads(4);
+  // The kept outermost dimension, the kept second dimension and the single
+  // output are split across the threads.
+  const std::vector<std::pair<std::vector<int>, std::vector<int>>> cases = {
+      {{64, 1031}, {1}},
+      {{1031, 64}, {0}},
+      {{131072}, {0}},
+      {{8, 130, 3, 17}, {1, 3}},
+  };
+  for (const auto& [shape, axis] : cases) {
+    int size = 1;
+    for (int dim : shape) size *= dim;
+    for (ReduceType reduce_type : {ReduceType::kSum, ReduceType::kMax,
+                                   ReduceType::kMin, ReduceType::kProd}) {
+      ExpectReduceMatchesReference<TypeParam>(
+          shape, axis,
+          RandomInput<TypeParam>(size, reduce_type, &random_engine),
+          reduce_type, &cpu_backend_context);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace tflite
+
+#ifdef REDUCE_BENCHMARKS
+
+// Compile with --copt="-DGOOGLE_COMMANDLINEFLAGS_FULL_API=1" and
+// --copt="-DREDUCE_BENCHMARKS"
+// Run with --benchmark_filter=all
+//
+// Sums a [rows, cols] float tensor, the arguments being rows, cols, the
+// reduced axis and the number of threads.
+void BM_ReduceSum(benchmark::State& state) {
+  const int shape[] = {static_cast<int>(state.range(0)),
+                       static_cast<int>(state.range(1))};
+  const int axis[] = {static_cast<int>(state.range(2))};
+  const int output_shape[] = {shape[1 - axis[0]]};
+  tflite::CpuBackendContext cpu_backend_context;
+  cpu_backend_context.SetMaxNumThreads(state.range(3));
+  std::vector<float> input(shape[0] * shape[1], 1.0f);
+  std::vector<float> output(output_shape[0]);
+  int resolved_axis[2];
+  int normalized_dims[2];
+  for (auto _ : state) {
+    tflite::optimized_ops::ReduceGeneric<float>(
+        input.data(), shape, 2, output.data(), output_shape, 1, axis, 1,
+        resolved_axis, normalized_dims, tflite::ops::builtin::reduce::kSum,
+        &cpu_backend_context);
+    testing::DoNotOptimize(output[0]);
+  }
+  state.SetBytesProcessed(state.iterations() * input.size() * sizeof(float));
+}
+BENCHMARK(BM_ReduceSum)
+    ->Args({1024, 4096, 1, 1})
+    ->Args({1024, 4096, 0, 1})
+    ->Args({1024, 4096, 1, 4})
+    ->Args({1024, 4096, 0, 4})
+    ->Args({64, 50257, 1, 1})
+    ->Args({64, 50257, 1, 4});
+
+#endif  // REDUCE_BENCHMARKS
@@ -23,9 +23,12 @@ limitations under the License.
 #include <limits>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include "ruy/profiler/instrumentation.h"  // from @ruy
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/cpu_backend_threadpool.h"
 #include "tflite/kernels/internal/common.h"
 #include "tflite/kernels/internal/compatibility.h"
 #include "tflite/kernels/internal/quantization_util.h"
@@ -1224,6 +1227,53 @@ inline void ResizeBilinear888Uint8(int32_t batches, int32_t input_height,
   }
 }  // NOLINT(readability/fn_size)
 
+template <typename ResizeRows>
+struct ResizeRowsWorkerTask : cpu_backend_threadpool::Task {
+  ResizeRowsWorkerTask(const ResizeRows& resize_rows, int start_row,
+                       int end_row)
+      : resize_rows(resize_rows), start_row(start_row), end_row(end_row) {}
+
+  void Run() override { resize_rows(start_row, end_row); }
+
+ private:
+  const ResizeRows& resize_rows;
+  int start_row;
+  int end_row;
+};
+
+// Runs `resize_rows(start_row, end_row)`, which computes the output rows in
+// [start_row, end_row) of the `num_rows` rows of batches * output_height
+// rows, on ranges of the rows split between the threads of
+// `cpu_backend_context`.
+template <typename ResizeRows>
+inline void ResizeByRows(int num_rows, int row_size,
+                         CpuBackendContext* cpu_backend_context,
+                         const ResizeRows& resize_rows) {
+  constexpr int kMinElementsPerThread = 16384;
+  const int thread_count =
+      cpu_backend_context == nullptr
+          ? 1
+          : static_cast<int>(std::min<int64_t>(
+                {num_rows,
+                 static_cast<int64_t>(num_rows) * row_size /
+                     kMinElementsPerThread,
+                 cpu_backend_context->max_num_threads()}));
+  if (thread_count <= 1) {
+    resize_rows(0, num_rows);
+    return;
+  }
+  std::vector<ResizeRowsWorkerTask<ResizeRows>> tasks;
+  tasks.reserve(thread_count);
+  int start_row = 0;
+  for (int i = 0; i < thread_count; ++i) {
+    const int end_row = start_row + (num_rows - start_row) / (thread_count - i);
+    tasks.emplace_back(resize_rows, start_row, end_row);
+    start_row = end_row;
+  }
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                  cpu_backend_context);
+}
+
 }  // namespace resize_bilinear
 
 #ifdef USE_NEON
@@ -1514,51 +1564,63 @@ inline void ResizeBilinearGeneric(
     int32_t output_height, int32_t output_width, float height_scale,
     float width_scale, const RuntimeShape& input_shape, const float* input_data,
     const RuntimeShape& output_shape, float* output_data,
-    const bool half_pixel_centers) {
-  memset(output_data, 0,
-         batches * output_height * output_width * depth * sizeof(float));
-
-  int32_t output_offset = 0;
-  for (int b = 0; b < batches; ++b) {
-    for (int y = 0; y < output_height; ++y) {
-      float input_y;
-      int32_t y0, y1;
-      reference_ops::ComputeInterpolationValues(
-          y, height_scale, half_pixel_centers, input_height, &input_y, &y0,
-          &y1);
-      for (int x = 0; x < output_width; ++x) {
-        float input_x;
-        int32_t x0, x1;
-        reference_ops::ComputeInterpolationValues(
-            x, width_scale, half_pixel_centers, input_width, &input_x, &x0,
-            &x1);
-        float* output_ptr = &output_data[output_offset];
-
-        // Run kernel on the 4 corners of the bilinear resize algorithm.
-        int32_t input_offset = Offset(input_shape, b, y0, x0, 0);
-        float scale = (1 - (input_y - y0)) * (1 - (input_x - x0));
-        const float* input_ptr = &input_data[input_offset];
-        ResizeBilinearKernel(input_ptr, depth, scale, output_ptr);
-
-        input_offset = Offset(input_shape, b, y0, x1, 0);
-        scale = (1 - (input_y - y0)) * (input_x - x0);
-        input_ptr = &input_data[input_offset];
-        ResizeBilinearKernel(input_ptr, depth, scale, output_ptr);
-
-        input_offset = Offset(input_shape, b, y1, x0, 0);
-        scale = (input_y - y0) * (1 - (input_x - x0));
-        input_ptr = &input_data[input_offset];
-        ResizeBilinearKernel(input_ptr, depth, scale, output_ptr);
-
-        input_offset = Offset(input_shape, b, y1, x1, 0);
-        scale = (input_y - y0) * (input_x - x0);
-        input_ptr = &input_data[input_offset];
-        ResizeBilinearKernel(input_ptr, depth, scale, output_ptr);
-
-        output_offset += depth;
-      }
-    }
+    const bool half_pixel_centers,
+    CpuBackendContext* cpu_backend_context = nullptr) {
+  // The interpolation values of the columns are the same for all rows.
+  std::vector<float> input_xs(output_width);
+  std::vector<int32_t> x0s(output_width);
+  std::vector<int32_t> x1s(output_width);
+  for (int x = 0; x < output_width; ++x) {
+    reference_ops::ComputeInterpolationValues(x, width_scale,
+                                              half_pixel_centers, input_width,
+                                              &input_xs[x], &x0s[x], &x1s[x]);
   }
+
+  const int32_t row_size = output_width * depth;
+  resize_bilinear::ResizeByRows(
+      batches * output_height, row_size, cpu_backend_context,
+      [&](int start_row, int end_row) {
+        memset(output_data + start_row * row_size, 0,
+               (end_row - start_row) * row_size * sizeof(float));
+        for (int row = start_row; row < end_row; ++row) {
+          const int b = row / output_height;
+          const int y = row % output_height;
+          float input_y;
+          int32_t y0, y1;
+          reference_ops::ComputeInterpolationValues(
+              y, height_scale, half_pixel_centers, input_height, &input_y,
+              &y0, &y1);
+          float* output_ptr = output_data + row * row_size;
+          for (int x = 0; x < output_width; ++x) {
+            const float input_x = input_xs[x];
+            const int32_t x0 = x0s[x];
+            const int32_t x1 = x1s[x];
+
+            // Run kernel on the 4 corners of the bilinear resize algorithm.
+            int32_t input_offset = Offset(input_shape, b, y0, x0, 0);
+            float scale = (1 - (input_y - y0)) * (1 - (input_x - x0));
+            const float* input_ptr = &input_data[input_offset];
+            ResizeBilinearKernel(input_ptr, depth, scale, output_ptr);
+
+            input_offset = Offset(input_shape, b, y0, x1, 0);
+            scale = (1 - (input_y - y0)) * (input_x - x0);
+            input_ptr = &input_data[input_offset];
+            ResizeBilinearKernel(input_ptr, depth, scale, output_ptr);
+
+            input_offset = Offset(input_shape, b, y1, x0, 0);
+            scale = (input_y - y0) * (1 - (input_x - x0));
+            input_ptr = &input_data[input_offset];
+            ResizeBilinearKernel(input_ptr, depth, scale, output_ptr);
+
+            input_offset = Offset(input_shape, b, y1, x1, 0);
+            scale = (input_y - y0) * (input_x - x0);
+            input_ptr = &input_data[input_offset];
+            ResizeBilinearKernel(input_ptr, depth, scale, output_ptr);
+
+            output_ptr += depth;
+          }
+        }
+      });
 }
 
 template <typename T>
@@ -1567,44 +1629,58 @@ inline void ResizeBilinearGenericSmallChannel(
     int32_t output_height, int32_t output_width, float height_scale,
     float width_scale, const RuntimeShape& input_shape, const T* input_data,
     const RuntimeShape& output_shape, T* output_data,
-    const bool half_pixel_centers) {
-  T* output_ptr = &output_data[0];
+    const bool half_pixel_centers,
+    CpuBackendContext* cpu_backend_context = nullptr) {
   const float rounding_offset = std::numeric_limits<T>::is_integer ? .5f : .0f;
 
-  for (int b = 0; b < batches; ++b) {
-    for (int y = 0; y < output_height; ++y) {
-      float input_y;
-      int32_t y0, y1;
-      reference_ops::ComputeInterpolationValues(
-          y, height_scale, half_pixel_centers, input_height, &input_y, &y0,
-          &y1);
-      for (int x = 0; x < output_width; ++x) {
-        float input_x;
-        int32_t x0, x1;
-        reference_ops::ComputeInterpolationValues(
-            x, width_scale, half_pixel_centers, input_width, &input_x, &x0,
-            &x1);
-
-        int32_t input_offset[4] = {Offset(input_shape, b, y0, x0, 0),
-                                   Offset(input_shape, b, y0, x1, 0),
-                                   Offset(input_shape, b, y1, x0, 0),
-                                   Offset(input_shape, b, y1, x1, 0)};
-        float scale[4] = {(1 - (input_y - y0)) * (1 - (input_x - x0)),
-                          (1 - (input_y - y0)) * (input_x - x0),
-                          (input_y - y0) * (1 - (input_x - x0)),
-                          (input_y - y0) * (input_x - x0)};
-
-        for (int d = 0; d < depth; d++) {
-          const T* input_ptr = &input_data[d];
-          *output_ptr++ = static_cast<T>(input_ptr[input_offset[0]] * scale[0] +
-                                         input_ptr[input_offset[1]] * scale[1] +
-                                         input_ptr[input_offset[2]] * scale[2] +
-                                         input_ptr[input_offset[3]] * scale[3] +
-                                         rounding_offset);
-        }
-      }
-    }
+  // The interpolation values of the columns are the same for all rows.
+  std::vector<float> input_xs(output_width);
+  std::vector<int32_t> x0s(output_width);
+  std::vector<int32_t> x1s(output_width);
+  for (int x = 0; x < output_width; ++x) {
+    reference_ops::ComputeInterpolationValues(x, width_scale,
+                                              half_pixel_centers, input_width,
+                                              &input_xs[x], &x0s[x], &x1s[x]);
   }
+
+  const int32_t row_size = output_width * depth;
+  resize_bilinear::ResizeByRows(
+      batches * output_height, row_size, cpu_backend_context,
+      [&](int start_row, int end_row) {
+        T* output_ptr = output_data + start_row * row_size;
+        for (int row = start_row; row < end_row; ++row) {
+          const int b = row / output_height;
+          const int y = row % output_height;
+          float input_y;
+          int32_t y0, y1;
+          reference_ops::ComputeInterpolationValues(
+              y, height_scale, half_pixel_centers, input_height, &input_y,
+              &y0, &y1);
+          for (int x = 0; x < output_width; ++x) {
+            const float input_x = input_xs[x];
+            const int32_t x0 = x0s[x];
+            const int32_t x1 = x1s[x];
+
+            int32_t input_offset[4] = {Offset(input_shape, b, y0, x0, 0),
+                                       Offset(input_shape, b, y0, x1, 0),
+                                       Offset(input_shape, b, y1, x0, 0),
+                                       Offset(input_shape, b, y1, x1, 0)};
+            float scale[4] = {(1 - (input_y - y0)) * (1 - (input_x - x0)),
+                              (1 - (input_y - y0)) * (input_x - x0),
+                              (input_y - y0) * (1 - (input_x - x0)),
+                              (input_y - y0) * (input_x - x0)};
+
+            for (int d = 0; d < depth; d++) {
+              const T* input_ptr = &input_data[d];
+              *output_ptr++ = static_cast<T>(
+                  input_ptr[input_offset[0]] * scale[0] +
+                  input_ptr[input_offset[1]] * scale[1] +
+                  input_ptr[input_offset[2]] * scale[2] +
+                  input_ptr[input_offset[3]] * scale[3] + rounding_offset);
+            }
+          }
+        }
+      });
 }
 
 inline void ResizeBilinear(const tflite::ResizeBilinearParams& op_params,
@@ -1613,7 +1689,8 @@ inline void ResizeBilinear(const tflite::ResizeBilinearParams& op_params,
                            const RuntimeShape& output_size_shape,
                            const int32_t* output_size_data,
                            const RuntimeShape& unextended_output_shape,
-                           float* output_data) {
+                           float* output_data,
+                           CpuBackendContext* cpu_backend_context = nullptr) {
   ruy::profiler::ScopeLabel label("ResizeBilinear");
   // If half_pixel_centers is True, align_corners must be False.
   TFLITE_DCHECK(!op_params.half_pixel_centers || !op_params.align_corners);
@@ -1652,7 +1729,8 @@ inline void ResizeBilinear(const tflite::ResizeBilinearParams& op_params,
     ResizeBilinearGeneric(batches, input_height, input_width, depth,
                           output_height, output_width, height_scale,
                           width_scale, input_shape, input_data, output_shape,
-                          output_data, op_params.half_pixel_centers);
+                          output_data, op_params.half_pixel_centers,
+                          cpu_backend_context);
   }
 }
 
@@ -1664,7 +1742,8 @@ inline void ResizeBilinear(const tflite::ResizeBilinearParams& op_params,
                            const RuntimeShape& output_size_shape,
                            const int32_t* output_size_data,
                            const RuntimeShape& unextended_output_shape,
-                           uint8_t* output_data) {
+                           uint8_t* output_data,
+                           CpuBackendContext* cpu_backend_context = nullptr) {
   ruy::profiler::ScopeLabel label("ResizeBilinearUint8");
   // If half_pixel_centers is True, align_corners must be False.
   TFLITE_DCHECK(!op_params.half_pixel_centers || !op_params.align_corners);
@@ -1713,21 +1792,148 @@ inline void ResizeBilinear(const tflite::ResizeBilinearParams& op_params,
   ResizeBilinearGenericSmallChannel<uint8_t>(
       batches, input_height, input_width, depth, output_height, output_width,
       height_scale, width_scale, input_shape, input_data, output_shape,
-      output_data, op_params.half_pixel_centers);
+      output_data, op_params.half_pixel_centers, cpu_backend_context);
+}
+
+// Same results as reference_ops::ResizeBilinearInteger, for int8_t and
+// int16_t. Each output row interpolates two input rows into a row of 32-bit
+// values first, which is reused by the next output rows with the same input
+// rows, then interpolates that row along the columns, whose input columns and
+// weights are computed once. Both passes are loops over contiguous channels.
+template <typename T>
+inline void ResizeBilinearInteger(
+    const tflite::ResizeBilinearParams& op_params,
+    const RuntimeShape& unextended_input_shape, const T* input_data,
+    const RuntimeShape& output_size_shape, const int32_t* output_size_data,
+    const RuntimeShape& unextended_output_shape, T* output_data,
+    CpuBackendContext* cpu_backend_context = nullptr) {
+  static_assert(sizeof(T) <= 2, "Only 8-bit and 16-bit types are supported.");
+  ruy::profiler::ScopeLabel label("ResizeBilinearInteger");
+  // If half_pixel_centers is True, align_corners must be False.
+  TFLITE_DCHECK(!op_params.half_pixel_centers || !op_params.align_corners);
+  TFLITE_DCHECK_LE(unextended_input_shape.DimensionsCount(), 4);
+  TFLITE_DCHECK_LE(unextended_output_shape.DimensionsCount(), 4);
+  const RuntimeShape input_shape =
+      RuntimeShape::ExtendedShape(4, unextended_input_shape);
+  const RuntimeShape output_shape =
+      RuntimeShape::ExtendedShape(4, unextended_output_shape);
+
+  const int32_t batches = MatchingDim(input_shape, 0, output_shape, 0);
+  const int32_t input_height = input_shape.Dims(1);
+  const int32_t input_width = input_shape.Dims(2);
+  const int32_t depth = MatchingDim(input_shape, 3, output_shape, 3);
+
+  TFLITE_DCHECK_EQ(output_size_shape.FlatSize(), 2);
+  const int32_t output_height = output_size_data[0];
+  const int32_t output_width = output_size_data[1];
+
+  int32_t height_scale_10 =
+      ((1 << 10) * input_height + output_height / 2) / output_height;
+  int32_t width_scale_10 =
+      ((1 << 10) * input_width + output_width / 2) / output_width;
+  if (op_params.align_corners && output_height > 1) {
+    height_scale_10 =
+        ((1 << 10) * (input_height - 1) + (output_height - 1) / 2) /
+        (output_height - 1);
+  }
+  if (op_params.align_corners && output_width > 1) {
+    width_scale_10 = ((1 << 10) * (input_width - 1) + (output_width - 1) / 2) /
+                     (output_width - 1);
+  }
+
+  // The offsets of the left and right input columns of each output column in
+  // an input row, and the weight of the right one with 10 fractional bits.
+  std::vector<int32_t> x0_offsets(output_width);
+  std::vector<int32_t> x1_offsets(output_width);
+  std::vector<int32_t> x_weights(output_width);
+  for (int x = 0; x < output_width; ++x) {
+    int32_t input_x, x0, x1;
+    reference_ops::ComputeInterpolationValuesInteger(
+        x, width_scale_10, op_params.half_pixel_centers, input_width, &input_x,
+        &x0, &x1);
+    // The rounded scale can put the last columns past the input, whose
+    // interpolation is then the last input column.
+    x0 = std::min(x0, input_width - 1);
+    x0_offsets[x] = x0 * depth;
+    x1_offsets[x] = x1 * depth;
+    x_weights[x] = input_x - (1 << 10) * x0;
+  }
+
+  // The sums of the 4 weighted inputs have 20 fractional bits, and fit in 32
+  // bits for 8-bit inputs.
+  using Accum = typename std::conditional<sizeof(T) == 1, int32_t,
+                                          int64_t>::type;
+  const int32_t input_row_size = input_width * depth;
+  const int32_t output_row_size = output_width * depth;
+  resize_bilinear::ResizeByRows(
+      batches * output_height, output_row_size, cpu_backend_context,
+      [&](int start_row, int end_row) {
+        // The input rows of the last output row, interpolated vertically with
+        // 10 fractional bits.
+        std::vector<int32_t> row_values(input_row_size);
+        int32_t row_values_offset0 = -1;
+        int32_t row_values_offset1 = -1;
+        int32_t row_values_weight = 0;
+        for (int row = start_row; row < end_row; ++row) {
+          const int b = row / output_height;
+          const int y = row % output_height;
+          int32_t input_y, y0, y1;
+          reference_ops::ComputeInterpolationValuesInteger(
+              y, height_scale_10, op_params.half_pixel_centers, input_height,
+              &input_y, &y0, &y1);
+          y0 = std::min(y0, input_height - 1);
+          const int32_t y_weight = input_y - (1 << 10) * y0;
+          const int32_t offset0 = Offset(input_shape, b, y0, 0, 0);
+          const int32_t offset1 = Offset(input_shape, b, y1, 0, 0);
+          if (offset0 != row_values_offset0 || offset1 != row_values_offset1 ||
+              y_weight != row_values_weight) {
+            const T* input_row0 = input_data + offset0;
+            const T* input_row1 = input_data + offset1;
+            const int32_t y0_weight = (1 << 10) - y_weight;
+            for (int i = 0; i < input_row_size; ++i) {
+              row_values[i] =
+                  input_row0[i] * y0_weight + input_row1[i] * y_weight;
+            }
+            row_values_offset0 = offset0;
+            row_values_offset1 = offset1;
+            row_values_weight = y_weight;
+          }
+
+          T* output_ptr = output_data + row * output_row_size;
+          for (int x = 0; x < output_width; ++x) {
+            const int32_t* values0 = row_values.data() + x0_offsets[x];
+            const int32_t* values1 = row_values.data() + x1_offsets[x];
+            const Accum x1_weight = x_weights[x];
+            const Accum x0_weight = (1 << 10) - x1_weight;
+            for (int c = 0; c < depth; ++c) {
+              const Accum output_20 =
+                  values0[c] * x0_weight + values1[c] * x1_weight;
+#if TFLITE_SINGLE_ROUNDING
+              const Accum round = 1 << 19;
+              output_ptr[c] = static_cast<T>((output_20 + round) >> 20);
+#else
+              const Accum round = (output_20 > 0) ? (1 << 19) : -(1 << 19);
+              output_ptr[c] = static_cast<T>((output_20 + round) / (1 << 20));
+#endif  // TFLITE_SINGLE_ROUNDING
+            }
+            output_ptr += depth;
+          }
+        }
+      });
 }
 
-// TODO(b/180609127) Create optimized int8 version from uint8. Call from here.
 inline void ResizeBilinear(const tflite::ResizeBilinearParams& op_params,
                            const RuntimeShape& unextended_input_shape,
                            const int8_t* input_data,
                            const RuntimeShape& unextended_output_size_shape,
                            const int32_t* output_size_data,
                            const RuntimeShape& unextended_output_shape,
-                           int8_t* output_data) {
-  reference_ops::ResizeBilinearInteger(op_params, unextended_input_shape,
-                                       input_data, unextended_output_size_shape,
-                                       output_size_data,
-                                       unextended_output_shape, output_data);
+                           int8_t* output_data,
+                           CpuBackendContext* cpu_backend_context = nullptr) {
+  ResizeBilinearInteger(op_params, unextended_input_shape, input_data,
+                        unextended_output_size_shape, output_size_data,
+                        unextended_output_shape, output_data,
+                        cpu_backend_context);
 }
 
 }  // namespace optimized_ops
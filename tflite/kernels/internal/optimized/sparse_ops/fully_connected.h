@@ -17,6 +17,8 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <vector>
 
 #include "ruy/profiler/instrumentation.h"  // from @ruy
 #include "tflite/core/c/common.h"
@@ -198,6 +200,59 @@ struct FullyConnectedSparseWeight1x4Task : cpu_backend_threadpool::Task {
   const CpuBackendContext& cpu_backend_context;
 };
 
+struct FullyConnectedSparseWeight1x16Task : cpu_backend_threadpool::Task {
+  FullyConnectedSparseWeight1x16Task(
+      const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
+      const RuntimeShape& input_shape, const int8_t* input_data,
+      const RuntimeShape& weights_shape, const int8_t* weights_data,
+      const int32_t* per_channel_scale, const int32_t* per_channel_shift,
+      const RuntimeShape& bias_shape, const int32_t* bias_data,
+      const RuntimeShape& output_shape, int8_t* output_data, int thread_start,
+      int thread_end, const CpuBackendContext& cpu_backend_context_x)
+      : sparsity(sparsity),
+        params(params),
+        input_shape(input_shape),
+        input_data(input_data),
+        weights_shape(weights_shape),
+        weights_data(weights_data),
+        per_channel_scale(per_channel_scale),
+        per_channel_shift(per_channel_shift),
+        bias_shape(bias_shape),
+        bias_data(bias_data),
+        output_shape(output_shape),
+        output_data(output_data),
+        thread_start(thread_start),
+        thread_end(thread_end),
+        cpu_backend_context(cpu_backend_context_x) {}
+
+  void Run() override {
+    FullyConnectedSparseWeight1x16Impl(
+        sparsity, params, input_shape, input_data, weights_shape, weights_data,
+        per_channel_scale, per_channel_shift, bias_shape, bias_data,
+        output_shape, output_data, thread_start, thread_end,
+        cpu_backend_context);
+  }
+
+ private:
+  const TfLiteSparsity& sparsity;
+  const FullyConnectedParams& params;
+  const RuntimeShape& input_shape;
+  const int8_t* input_data;
+  const RuntimeShape& weights_shape;
+  const int8_t* weights_data;
+  const int32_t* per_channel_scale;
+  const int32_t* per_channel_shift;
+  const RuntimeShape& bias_shape;
+  const int32_t* bias_data;
+  const RuntimeShape& output_shape;
+  int8_t* output_data;
+  int thread_start;
+  int thread_end;
+  const CpuBackendContext& cpu_backend_context;
+};
+
+// The multi-threaded kernel slices the workload along the batch dimension, as
+// FullyConnectedSparseWeight1x4 does.
 inline void FullyConnectedSparseWeight1x16(
     const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
     const RuntimeShape& input_shape, const int8_t* input_data,
@@ -209,14 +264,31 @@ inline void FullyConnectedSparseWeight1x16(
   const int output_elements = output_shape.FlatSize();
   memset(output_data, 0, output_elements * sizeof(int8_t));
 
+  const int max_threads = cpu_backend_context->max_num_threads();
   const int batches =
       FlatSizeSkipDim(output_shape, output_shape.DimensionsCount() - 1);
+  const int thread_count = std::max(1, std::min(batches, max_threads));
+  if (thread_count == 1) {
+    return FullyConnectedSparseWeight1x16Impl(
+        sparsity, params, input_shape, input_data, weights_shape, weights_data,
+        per_channel_scale, per_channel_shift, bias_shape, bias_data,
+        output_shape, output_data, 0, batches, *cpu_backend_context);
+  }
+  std::vector<FullyConnectedSparseWeight1x16Task> tasks;
+  tasks.reserve(thread_count);
+  int thread_start = 0;
+  for (int i = 0; i < thread_count; ++i) {
+    int thread_end = thread_start + batches / thread_count;
+    if (i < batches % thread_count) thread_end++;
 
-  // TODO(b/220851507): Add multi-thread support for quantized sparse kernel.
-  return FullyConnectedSparseWeight1x16Impl(
-      sparsity, params, input_shape, input_data, weights_shape, weights_data,
-      per_channel_scale, per_channel_shift, bias_shape, bias_data, output_shape,
-      output_data, 0, batches, *cpu_backend_context);
+    tasks.emplace_back(sparsity, params, input_shape, input_data, weights_shape,
+                       weights_data, per_channel_scale, per_channel_shift,
+                       bias_shape, bias_data, output_shape, output_data,
+                       thread_start, thread_end, *cpu_backend_context);
+    thread_start = thread_end;
+  }
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                  cpu_backend_context);
 }
 
 // The multi-threaded kernel slices the workload along the batch dimension. If
@@ -263,6 +335,249 @@ inline void FullyConnectedSparseWeight1x4(
                                   cpu_backend_context);
 }
 
+// Multiplies the rows [block_row_start * BlockRows, block_row_end * BlockRows)
+// of the weights, block sparse with blocks of BlockRows x BlockCols values
+// along a Dense and a SparseCSR dimension, by the `batches` input vectors of
+// `input_depth` values. For each of the rows r and the batches b, calls
+// `output(b, r, dot_product, weights_sum)`, the sum of the weights of the row
+// being what an input offset adds to the dot product, times that offset.
+template <int BlockRows, int BlockCols, typename T, typename AccumT,
+          typename Output>
+inline void SparseBlockMatrixBatchVectorMultiply(
+    const TfLiteSparsity& sparsity, const T* weights_data, const T* input_data,
+    int input_depth, int batches, int block_row_start, int block_row_end,
+    const Output& output) {
+  constexpr int kBlockSize = BlockRows * BlockCols;
+  const int* segments = sparsity.dim_metadata[1].array_segments->data;
+  const int* indices = sparsity.dim_metadata[1].array_indices->data;
+  for (int block_row = block_row_start; block_row < block_row_end;
+       ++block_row) {
+    const int blocks_start = segments[block_row];
+    const int blocks_end = segments[block_row + 1];
+    AccumT weights_sums[BlockRows] = {};
+    for (int block = blocks_start; block < blocks_end; ++block) {
+      const T* weights = weights_data + block * kBlockSize;
+      for (int i = 0; i < BlockRows; ++i) {
+        for (int j = 0; j < BlockCols; ++j) {
+          weights_sums[i] += weights[i * BlockCols + j];
+        }
+      }
+    }
+    // The weights of the block row stay in the L1 cache across the batches.
+    for (int b = 0; b < batches; ++b) {
+      const T* input = input_data + b * input_depth;
+      AccumT accum[BlockRows] = {};
+      for (int block = blocks_start; block < blocks_end; ++block) {
+        const T* weights = weights_data + block * kBlockSize;
+        const T* block_input = input + indices[block] * BlockCols;
+        for (int i = 0; i < BlockRows; ++i) {
+          for (int j = 0; j < BlockCols; ++j) {
+            accum[i] += static_cast<AccumT>(weights[i * BlockCols + j]) *
+                        static_cast<AccumT>(block_input[j]);
+          }
+        }
+      }
+      for (int i = 0; i < BlockRows; ++i) {
+        output(b, block_row * BlockRows + i, accum[i], weights_sums[i]);
+      }
+    }
+  }
+}
+
+template <typename Work>
+struct FullyConnectedSparseBlockTask : cpu_backend_threadpool::Task {
+  FullyConnectedSparseBlockTask(const Work& work, int block_row_start,
+                                int block_row_end)
+      : work(work),
+        block_row_start(block_row_start),
+        block_row_end(block_row_end) {}
+
+  void Run() override { work(block_row_start, block_row_end); }
+
+ private:
+  const Work& work;
+  int block_row_start;
+  int block_row_end;
+};
+
+// Runs `work(block_row_start, block_row_end)` over the block rows of the
+// sparse weights, split across the threads of `cpu_backend_context` in ranges
+// of about the same number of nonzero blocks. Unlike the slicing along the
+// batch dimension above, this also uses all threads for a single batch.
+template <typename Work>
+inline void ForEachSparseBlockRows(const TfLiteSparsity& sparsity,
+                                   int block_size, int batches,
+                                   CpuBackendContext* cpu_backend_context,
+                                   const Work& work) {
+  // Minimum number of multiply-adds per task.
+  constexpr int64_t kMinTaskSize = 32768;
+  const int num_block_rows = sparsity.dim_metadata[0].dense_size;
+  const int* segments = sparsity.dim_metadata[1].array_segments->data;
+  const int num_blocks = segments[num_block_rows];
+  const int64_t work_size =
+      static_cast<int64_t>(num_blocks) * block_size * batches;
+  const int thread_count = static_cast<int>(
+      std::min<int64_t>({cpu_backend_context->max_num_threads(),
+                         num_block_rows, work_size / kMinTaskSize}));
+  if (thread_count <= 1) {
+    work(0, num_block_rows);
+    return;
+  }
+  std::vector<FullyConnectedSparseBlockTask<Work>> tasks;
+  tasks.reserve(thread_count);
+  int block_row_start = 0;
+  for (int i = 1; i <= thread_count; ++i) {
+    const int64_t blocks_end =
+        static_cast<int64_t>(num_blocks) * i / thread_count;
+    int block_row_end =
+        std::lower_bound(segments + block_row_start,
+                         segments + num_block_rows, blocks_end) -
+        segments;
+    if (i == thread_count) block_row_end = num_block_rows;
+    if (block_row_end > block_row_start) {
+      tasks.emplace_back(work, block_row_start, block_row_end);
+      block_row_start = block_row_end;
+    }
+  }
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                  cpu_backend_context);
+}
+
+// Fully connected layer with float weights, block sparse with blocks of
+// BlockRows x BlockCols values, e.g. 4x1 blocks of 4 consecutive output rows.
+template <int BlockRows, int BlockCols>
+inline void FullyConnectedSparseWeightBlock(
+    const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
+    const RuntimeShape& input_shape, const float* input_data,
+    const RuntimeShape& weights_shape, const float* weights_data,
+    const RuntimeShape& bias_shape, const float* bias_data,
+    const RuntimeShape& output_shape, float* output_data,
+    CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("FullyConnected");
+  ruy::profiler::ScopeLabel inner_label("Block Sparse");
+  const float output_activation_min = params.float_activation_min;
+  const float output_activation_max = params.float_activation_max;
+  const int output_dims_count = output_shape.DimensionsCount();
+  const int weights_dims_count = weights_shape.DimensionsCount();
+  const int batches = FlatSizeSkipDim(output_shape, output_dims_count - 1);
+  const int input_depth =
+      MatchingDim(weights_shape, weights_dims_count - 1, input_shape,
+                  input_shape.DimensionsCount() - 1);
+  const int output_depth = MatchingDim(weights_shape, weights_dims_count - 2,
+                                       output_shape, output_dims_count - 1);
+  ForEachSparseBlockRows(
+      sparsity, BlockRows * BlockCols, batches, cpu_backend_context,
+      [&](int block_row_start, int block_row_end) {
+        SparseBlockMatrixBatchVectorMultiply<BlockRows, BlockCols, float,
+                                             float>(
+            sparsity, weights_data, input_data, input_depth, batches,
+            block_row_start, block_row_end,
+            [&](int b, int row, float dot_product, float) {
+              const float bias_value = bias_data ? bias_data[row] : 0;
+              output_data[b * output_depth + row] =
+                  ActivationFunctionWithMinMax(dot_product + bias_value,
+                                               output_activation_min,
+                                               output_activation_max);
+            });
+      });
+}
+
+// Same as above, with int8 weights symmetrically quantized per tensor or per
+// channel, and int8 input and output.
+template <int BlockRows, int BlockCols>
+inline void FullyConnectedSparseWeightBlock(
+    const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
+    const RuntimeShape& input_shape, const int8_t* input_data,
+    const RuntimeShape& weights_shape, const int8_t* weights_data,
+    const int32_t* per_channel_scale, const int32_t* per_channel_shift,
+    const RuntimeShape& bias_shape, const int32_t* bias_data,
+    const RuntimeShape& output_shape, int8_t* output_data,
+    CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("FullyConnected");
+  ruy::profiler::ScopeLabel inner_label("Block Sparse");
+  const int output_dims_count = output_shape.DimensionsCount();
+  const int weights_dims_count = weights_shape.DimensionsCount();
+  const int batches = FlatSizeSkipDim(output_shape, output_dims_count - 1);
+  const int input_depth =
+      MatchingDim(weights_shape, weights_dims_count - 1, input_shape,
+                  input_shape.DimensionsCount() - 1);
+  const int output_depth = MatchingDim(weights_shape, weights_dims_count - 2,
+                                       output_shape, output_dims_count - 1);
+  const int32_t input_offset = params.input_offset;
+  const int32_t output_offset = params.output_offset;
+  const int32_t output_multiplier = params.output_multiplier;
+  const int32_t output_shift = params.output_shift;
+  const int32_t output_activation_min = params.quantized_activation_min;
+  const int32_t output_activation_max = params.quantized_activation_max;
+  ForEachSparseBlockRows(
+      sparsity, BlockRows * BlockCols, batches, cpu_backend_context,
+      [&](int block_row_start, int block_row_end) {
+        SparseBlockMatrixBatchVectorMultiply<BlockRows, BlockCols, int8_t,
+                                             int32_t>(
+            sparsity, weights_data, input_data, input_depth, batches,
+            block_row_start, block_row_end,
+            [&](int b, int row, int32_t dot_product, int32_t weights_sum) {
+              int32_t acc = dot_product + input_offset * weights_sum;
+              if (bias_data) acc += bias_data[row];
+              acc = MultiplyByQuantizedMultiplier(
+                  acc,
+                  per_channel_scale ? per_channel_scale[row]
+                                    : output_multiplier,
+                  per_channel_shift ? per_channel_shift[row] : output_shift);
+              acc += output_offset;
+              output_data[b * output_depth + row] =
+                  static_cast<int8_t>(ActivationFunctionWithMinMax(
+                      acc, output_activation_min, output_activation_max));
+            });
+      });
+}
+
+// Hybrid fully connected layer with int8 block sparse weights and float input
+// and output. `quantized_input_data` holds the input quantized per batch with
+// `scaling_factors`, already multiplied by the scale of the weights if they
+// are quantized per tensor, else by `per_channel_scale`, and the zero points
+// `input_offsets` if not null.
+template <int BlockRows, int BlockCols>
+inline void FullyConnectedSparseWeightBlockHybrid(
+    const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
+    const RuntimeShape& input_shape, const int8_t* quantized_input_data,
+    const float* scaling_factors, const int32_t* input_offsets,
+    const RuntimeShape& weights_shape, const int8_t* weights_data,
+    const float* per_channel_scale, const RuntimeShape& bias_shape,
+    const float* bias_data, const RuntimeShape& output_shape,
+    float* output_data, CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("FullyConnected");
+  ruy::profiler::ScopeLabel inner_label("Block Sparse Hybrid");
+  const float output_activation_min = params.float_activation_min;
+  const float output_activation_max = params.float_activation_max;
+  const int output_dims_count = output_shape.DimensionsCount();
+  const int weights_dims_count = weights_shape.DimensionsCount();
+  const int batches = FlatSizeSkipDim(output_shape, output_dims_count - 1);
+  const int input_depth =
+      MatchingDim(weights_shape, weights_dims_count - 1, input_shape,
+                  input_shape.DimensionsCount() - 1);
+  const int output_depth = MatchingDim(weights_shape, weights_dims_count - 2,
+                                       output_shape, output_dims_count - 1);
+  ForEachSparseBlockRows(
+      sparsity, BlockRows * BlockCols, batches, cpu_backend_context,
+      [&](int block_row_start, int block_row_end) {
+        SparseBlockMatrixBatchVectorMultiply<BlockRows, BlockCols, int8_t,
+                                             int32_t>(
+            sparsity, weights_data, quantized_input_data, input_depth,
+            batches, block_row_start, block_row_end,
+            [&](int b, int row, int32_t dot_product, int32_t weights_sum) {
+              if (input_offsets) dot_product -= input_offsets[b] * weights_sum;
+              float scale = scaling_factors[b];
+              if (per_channel_scale) scale *= per_channel_scale[row];
+              const float bias_value = bias_data ? bias_data[row] : 0;
+              output_data[b * output_depth + row] =
+                  ActivationFunctionWithMinMax(dot_product * scale + bias_value,
+                                               output_activation_min,
+                                               output_activation_max);
+            });
+      });
+}
+
 }  // namespace optimized_ops
 }  // namespace tflite
 #endif  // TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_SPARSE_OPS_FULLY_CONNECTED_H_
@@ -0,0 +1,280 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_TRANSPOSE_H_
+#define TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_TRANSPOSE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/cpu_backend_threadpool.h"
+#include "tflite/kernels/internal/reference/transpose.h"
+#include "tflite/kernels/internal/transpose_utils.h"
+#include "tflite/kernels/internal/types.h"
+
+namespace tflite {
+namespace optimized_ops {
+namespace transpose_internal {
+
+// Transposes are split in tasks of at least this many elements.
+constexpr int kMinElementsPerTask = 16384;
+
+// The loops around the innermost copy of a transpose, in output order, and
+// where they are in the input and the output.
+struct OuterLoops {
+  int count = 0;
+  int size[kTransposeMaxDimensions];
+  size_t input_stride[kTransposeMaxDimensions];
+  size_t output_stride[kTransposeMaxDimensions];
+
+  void Add(int loop_size, size_t loop_input_stride,
+           size_t loop_output_stride) {
+    size[count] = loop_size;
+    input_stride[count] = loop_input_stride;
+    output_stride[count] = loop_output_stride;
+    ++count;
+  }
+
+  size_t NumIterations() const {
+    size_t num_iterations = 1;
+    for (int i = 0; i < count; ++i) num_iterations *= size[i];
+    return num_iterations;
+  }
+};
+
+// Calls `body(iteration, input_offset, output_offset)` for the iterations
+// [begin, end) of `loops`, the last loop being the innermost one.
+template <typename Body>
+void RunOuterLoops(const OuterLoops& loops, size_t begin, size_t end,
+                   const Body& body) {
+  int index[kTransposeMaxDimensions];
+  size_t input_offset = 0;
+  size_t output_offset = 0;
+  size_t remainder = begin;
+  for (int i = loops.count - 1; i >= 0; --i) {
+    index[i] = remainder % loops.size[i];
+    remainder /= loops.size[i];
+    input_offset += index[i] * loops.input_stride[i];
+    output_offset += index[i] * loops.output_stride[i];
+  }
+  for (size_t iteration = begin; iteration < end; ++iteration) {
+    body(index[loops.count - 1], input_offset, output_offset);
+    // Increments the indices like an odometer.
+    for (int i = loops.count - 1; i >= 0; --i) {
+      input_offset += loops.input_stride[i];
+      output_offset += loops.output_stride[i];
+      if (++index[i] < loops.size[i]) break;
+      input_offset -= loops.size[i] * loops.input_stride[i];
+      output_offset -= loops.size[i] * loops.output_stride[i];
+      index[i] = 0;
+    }
+  }
+}
+
+// Transposes a `rows` x `cols` block of the input, whose rows are
+// `input_stride` apart, into a `cols` x `rows` block of the output, whose rows
+// are `output_stride` apart. Full tiles have compile-time sizes for the
+// compiler to unroll and vectorize them.
+template <int kTileSize, typename T>
+void TransposeTile(const T* input, size_t input_stride, int rows, int cols,
+                   T* output, size_t output_stride) {
+  if (rows == kTileSize && cols == kTileSize) {
+    for (int j = 0; j < kTileSize; ++j) {
+      for (int i = 0; i < kTileSize; ++i) {
+        output[j * output_stride + i] = input[i * input_stride + j];
+      }
+    }
+    return;
+  }
+  for (int j = 0; j < cols; ++j) {
+    for (int i = 0; i < rows; ++i) {
+      output[j * output_stride + i] = input[i * input_stride + j];
+    }
+  }
+}
+
+// Copies the contiguous runs of `run_size` elements of the iterations
+// [begin, end) of `loops`.
+template <typename T>
+void CopyRuns(const OuterLoops& loops, size_t begin, size_t end,
+              int run_size, const T* input_data, T* output_data) {
+  RunOuterLoops(loops, begin, end,
+                [&](int, size_t input_offset, size_t output_offset) {
+                  std::memcpy(output_data + output_offset,
+                              input_data + input_offset, run_size * sizeof(T));
+                });
+}
+
+// Transposes stripes of `kTileSize` rows of the [rows, cols] matrices of the
+// iterations [begin, end) of `loops`, whose last loop runs over the stripes.
+template <int kTileSize, typename T>
+void TransposeStripes(const OuterLoops& loops, size_t begin, size_t end,
+                      int rows, int cols, size_t input_row_stride,
+                      size_t output_row_stride, const T* input_data,
+                      T* output_data) {
+  RunOuterLoops(
+      loops, begin, end,
+      [&](int stripe, size_t input_offset, size_t output_offset) {
+        const int stripe_rows = std::min(kTileSize, rows - stripe * kTileSize);
+        for (int col = 0; col < cols; col += kTileSize) {
+          TransposeTile<kTileSize>(
+              input_data + input_offset + col, input_row_stride, stripe_rows,
+              std::min(kTileSize, cols - col),
+              output_data + output_offset + col * output_row_stride,
+              output_row_stride);
+        }
+      });
+}
+
+template <typename Work>
+struct TransposeTask : cpu_backend_threadpool::Task {
+  TransposeTask(const Work& work, size_t begin, size_t end)
+      : work(work), begin(begin), end(end) {}
+  void Run() override { work(begin, end); }
+
+  const Work& work;
+  size_t begin;
+  size_t end;
+};
+
+// Runs `work(begin, end)` over [0, num_iterations), split across the threads
+// of `cpu_backend_context` if it is set and the transpose is large enough.
+template <typename Work>
+void RunTransposeWork(size_t num_iterations, size_t num_elements,
+                      CpuBackendContext* cpu_backend_context,
+                      const Work& work) {
+  size_t num_tasks = 1;
+  if (cpu_backend_context != nullptr) {
+    num_tasks = std::min<size_t>(
+        {static_cast<size_t>(cpu_backend_context->max_num_threads()),
+         num_iterations, num_elements / kMinElementsPerTask});
+  }
+  if (num_tasks <= 1) {
+    work(0, num_iterations);
+    return;
+  }
+  std::vector<TransposeTask<Work>> tasks;
+  tasks.reserve(num_tasks);
+  for (size_t i = 0; i < num_tasks; ++i) {
+    tasks.emplace_back(work, num_iterations * i / num_tasks,
+                       num_iterations * (i + 1) / num_tasks);
+  }
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                  cpu_backend_context);
+}
+
+template <typename T>
+void TransposeImpl(const TransposeParams& params,
+                   const RuntimeShape& input_shape, const T* input_data,
+                   T* output_data, CpuBackendContext* cpu_backend_context) {
+  const int dims = params.perm_count;
+  const size_t num_elements = input_shape.FlatSize();
+  if (dims == 1) {
+    std::memcpy(output_data, input_data, num_elements * sizeof(T));
+    return;
+  }
+  size_t input_stride[kTransposeMaxDimensions];
+  input_stride[dims - 1] = 1;
+  for (int i = dims - 2; i >= 0; --i) {
+    input_stride[i] = input_stride[i + 1] * input_shape.Dims(i + 1);
+  }
+  size_t output_stride[kTransposeMaxDimensions];
+  output_stride[dims - 1] = 1;
+  for (int i = dims - 2; i >= 0; --i) {
+    output_stride[i] =
+        output_stride[i + 1] * input_shape.Dims(params.perm[i + 1]);
+  }
+
+  // Once the dimensions are collapsed, the innermost input dimension stays
+  // innermost in the output only if the input had one block of contiguous
+  // elements permuted, e.g. [B, H, S, D] -> [B, S, H, D]. These blocks are
+  // copied whole.
+  if (params.perm[dims - 1] == dims - 1) {
+    OuterLoops loops;
+    for (int i = 0; i < dims - 1; ++i) {
+      loops.Add(input_shape.Dims(params.perm[i]),
+                input_stride[params.perm[i]], output_stride[i]);
+    }
+    const int run_size = input_shape.Dims(dims - 1);
+    RunTransposeWork(loops.NumIterations(), num_elements, cpu_backend_context,
+                     [&](size_t begin, size_t end) {
+                       CopyRuns(loops, begin, end, run_size, input_data,
+                                output_data);
+                     });
+    return;
+  }
+
+  // Otherwise, the input dimension which becomes innermost, and the innermost
+  // input dimension, form matrices which are transposed by tiles of one cache
+  // line per row, in the input and the output.
+  constexpr int kTileSize = 64 / sizeof(T);
+  const int row_dim = params.perm[dims - 1];
+  const int rows = input_shape.Dims(row_dim);
+  const int cols = input_shape.Dims(dims - 1);
+  const size_t input_row_stride = input_stride[row_dim];
+  size_t output_row_stride = 0;
+  OuterLoops loops;
+  for (int i = 0; i < dims - 1; ++i) {
+    if (params.perm[i] == dims - 1) {
+      output_row_stride = output_stride[i];
+      continue;
+    }
+    loops.Add(input_shape.Dims(params.perm[i]), input_stride[params.perm[i]],
+              output_stride[i]);
+  }
+  loops.Add((rows + kTileSize - 1) / kTileSize, kTileSize * input_row_stride,
+            kTileSize);
+  RunTransposeWork(loops.NumIterations(), num_elements, cpu_backend_context,
+                   [&](size_t begin, size_t end) {
+                     TransposeStripes<kTileSize>(
+                         loops, begin, end, rows, cols, input_row_stride,
+                         output_row_stride, input_data, output_data);
+                   });
+}
+
+}  // namespace transpose_internal
+
+// Copies a tensor to an other buffer and permutes its dimensions, like
+// reference_ops::Transpose(), by blocks which fit in the cache, and split
+// across the threads of `cpu_backend_context` if it is not null.
+template <typename T>
+void Transpose(const TransposeParams& params, const RuntimeShape& input_shape,
+               const T* input_data, const RuntimeShape& output_shape,
+               T* output_data, CpuBackendContext* cpu_backend_context) {
+  using StorageType =
+      typename reference_ops::transpose_internal::TransposeStorageType<
+          sizeof(T)>::type;
+  if (input_shape.FlatSize() == 0) {
+    return;
+  }
+  RuntimeShape collapsed_input_shape(input_shape);
+  RuntimeShape collapsed_output_shape(output_shape);
+  TransposeParams collapsed_params = params;
+  transpose_utils::CollapseDimensions(&collapsed_input_shape,
+                                      &collapsed_output_shape,
+                                      &collapsed_params);
+  transpose_internal::TransposeImpl(
+      collapsed_params, collapsed_input_shape,
+      reinterpret_cast<const StorageType*>(input_data),
+      reinterpret_cast<StorageType*>(output_data), cpu_backend_context);
+}
+
+}  // namespace optimized_ops
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_TRANSPOSE_H_
@@ -17,8 +17,9 @@ limitations under the License.
 
 #include <algorithm>
 #include <cmath>
-#include <deque>
 #include <queue>
+#include <utility>
+#include <vector>
 
 namespace tflite {
 namespace reference_ops {
@@ -101,14 +102,16 @@ inline void NonMaxSuppression(const float* boxes, const int num_boxes,
   auto cmp = [](const Candidate bs_i, const Candidate bs_j) {
     return bs_i.score < bs_j.score;
   };
-  std::priority_queue<Candidate, std::deque<Candidate>, decltype(cmp)>
-      candidate_priority_queue(cmp);
-  // Populate queue with candidates above the score threshold.
+  // Populate queue with candidates above the score threshold. Building the
+  // heap from all of them at once takes linear time.
+  std::vector<Candidate> candidates;
   for (int i = 0; i < num_boxes; ++i) {
     if (scores[i] > score_threshold) {
-      candidate_priority_queue.emplace(Candidate({i, scores[i], 0}));
+      candidates.push_back(Candidate({i, scores[i], 0}));
     }
   }
+  std::priority_queue<Candidate, std::vector<Candidate>, decltype(cmp)>
+      candidate_priority_queue(cmp, std::move(candidates));
 
   *num_selected_indices = 0;
   int num_outputs = std::min(static_cast<int>(candidate_priority_queue.size()),
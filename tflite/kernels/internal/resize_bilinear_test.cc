@@ -22,6 +22,7 @@ limitations under the License.
 #include <vector>
 
 #include <gtest/gtest.h>
+#include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/kernels/internal/optimized/optimized_ops.h"
 #include "tflite/kernels/internal/reference/reference_ops.h"
 #include "tflite/kernels/internal/test_util.h"
@@ -372,6 +373,51 @@ TEST(ResizeBilinear, TestResizeBilinearHalfPixelCenters_2x2to4x6_Int16) {
   TestResizeBilinearHalfPixelCenters_2x2to4x6<int16_t>();
 }
 
+// Tests that the optimized integer version, with any scale and on several
+// threads, gives the same results as the reference one.
+template <typename T>
+void TestResizeBilinearIntegerParity(
+    const tflite::ResizeBilinearParams& op_params) {
+  CpuBackendContext cpu_backend_context;
+  cpu_backend_context.SetMaxNumThreads(4);
+  const int kTestsToRun = 100;
+  for (int i = 0; i < kTestsToRun; i++) {
+    const int batch = UniformRandomInt(1, 2);
+    const int depth = UniformRandomInt(1, 70);
+    const int input_width = UniformRandomInt(1, 40);
+    const int input_height = UniformRandomInt(1, 40);
+    const int output_width = UniformRandomInt(1, 40);
+    const int output_height = UniformRandomInt(1, 40);
+    RuntimeShape input_shape({batch, input_height, input_width, depth});
+    RuntimeShape output_shape({batch, output_height, output_width, depth});
+    RuntimeShape output_size_shape({1, 1, 1, 2});
+    std::vector<int32_t> output_size_data = {output_height, output_width};
+
+    std::vector<T> input_data(input_shape.FlatSize(), 0);
+    FillRandom(&input_data);
+    std::vector<T> reference_output_data(output_shape.FlatSize(), 0);
+    std::vector<T> output_data(output_shape.FlatSize(), 3);
+    reference_ops::ResizeBilinearInteger(
+        op_params, input_shape, input_data.data(), output_size_shape,
+        output_size_data.data(), output_shape, reference_output_data.data());
+    optimized_ops::ResizeBilinearInteger(
+        op_params, input_shape, input_data.data(), output_size_shape,
+        output_size_data.data(), output_shape, output_data.data(),
+        &cpu_backend_context);
+    ASSERT_EQ(reference_output_data, output_data);
+  }
+}
+
+TEST_P(ResizeBilinearImplTest, TestResizeBilinearIntegerParityInt8) {
+  RandomEngine().seed(38521);
+  TestResizeBilinearIntegerParity<int8_t>(GetParam());
+}
+
+TEST_P(ResizeBilinearImplTest, TestResizeBilinearIntegerParityInt16) {
+  RandomEngine().seed(90163);
+  TestResizeBilinearIntegerParity<int16_t>(GetParam());
+}
+
 class ResizeBilinearImplX8ChannelTest
     : public ::testing::Test,
       public ::testing::WithParamInterface<tflite::ResizeBilinearParams> {};
@@ -12,11 +12,10 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
-#include <algorithm>
-#include <cmath>
 #include <vector>
 
 #include <gtest/gtest.h>
+#include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/kernels/internal/optimized/optimized_ops.h"
 #include "tflite/kernels/internal/reference/reference_ops.h"
 #include "tflite/kernels/internal/test_util.h"
@@ -343,9 +342,9 @@ TEST(ResizeNearestNeighborReference,
       /*align_corners=*/true, /*half_pixel_centers=*/true);
 }
 
-void TestOptimizedResizeNearestNeighbor(int batch, int depth, int input_width,
-                                        int input_height, int output_width,
-                                        int output_height) {
+void TestOptimizedResizeNearestNeighbor(
+    int batch, int depth, int input_width, int input_height, int output_width,
+    int output_height, CpuBackendContext* cpu_backend_context = nullptr) {
   RuntimeShape output_size_shape({1, 1, 1, 2});
 
   RuntimeShape input_shape({batch, input_height, input_width, depth});
@@ -369,7 +368,8 @@ void TestOptimizedResizeNearestNeighbor(int batch, int depth, int input_width,
       output_size_data.data(), output_shape, reference_output_data.data());
   optimized_ops::ResizeNearestNeighbor(
       op_params, input_shape, input_data.data(), output_size_shape,
-      output_size_data.data(), output_shape, output_data.data());
+      output_size_data.data(), output_shape, output_data.data(),
+      cpu_backend_context);
   ASSERT_EQ(reference_output_data, output_data);
 
   op_params.align_corners = true;
@@ -378,7 +378,8 @@ void TestOptimizedResizeNearestNeighbor(int batch, int depth, int input_width,
       output_size_data.data(), output_shape, reference_output_data.data());
   optimized_ops::ResizeNearestNeighbor(
       op_params, input_shape, input_data.data(), output_size_shape,
-      output_size_data.data(), output_shape, output_data.data());
+      output_size_data.data(), output_shape, output_data.data(),
+      cpu_backend_context);
   ASSERT_EQ(reference_output_data, output_data);
 
   op_params.align_corners = false;
@@ -388,7 +389,8 @@ void TestOptimizedResizeNearestNeighbor(int batch, int depth, int input_width,
       output_size_data.data(), output_shape, reference_output_data.data());
   optimized_ops::ResizeNearestNeighbor(
       op_params, input_shape, input_data.data(), output_size_shape,
-      output_size_data.data(), output_shape, output_data.data());
+      output_size_data.data(), output_shape, output_data.data(),
+      cpu_backend_context);
   ASSERT_EQ(reference_output_data, output_data);
 
   op_params.align_corners = true;
@@ -398,47 +400,30 @@ void TestOptimizedResizeNearestNeighbor(int batch, int depth, int input_width,
       output_size_data.data(), output_shape, reference_output_data.data());
   optimized_ops::ResizeNearestNeighbor(
       op_params, input_shape, input_data.data(), output_size_shape,
-      output_size_data.data(), output_shape, output_data.data());
+      output_size_data.data(), output_shape, output_data.data(),
+      cpu_backend_context);
   ASSERT_EQ(reference_output_data, output_data);
 }
 
-// Since the optimized version uses fixed-point and the reference version uses
-// float, offsets may differ. Test if the input/output image combination results
-// in the same offsets before running parity tests.
-bool is_valid_scale(int input_width, int input_height, int output_width,
-                    int output_height) {
-  const float height_scale_float =
-      static_cast<float>(input_height) / output_height;
-  const float width_scale_float =
-      static_cast<float>(input_width) / output_width;
-
-  int32_t height_scale_int = (input_height << 16) / output_height + 1;
-  int32_t width_scale_int = (input_width << 16) / output_width + 1;
-
-  for (int y = 0; y < output_height; ++y) {
-    int32_t in_y_float =
-        std::min(static_cast<int32_t>(std::floor(y * height_scale_float)),
-                 input_height - 1);
-    int32_t in_y_int = std::min((y * height_scale_int) >> 16, input_height - 1);
-    if (in_y_int != in_y_float) {
-      return false;
-    }
-    for (int x = 0; x < output_width; ++x) {
-      int32_t in_x_float =
-          std::min(static_cast<int32_t>(std::floor(x * width_scale_float)),
-                   input_width - 1);
-      int32_t in_x_int = std::min((x * width_scale_int) >> 16, input_width - 1);
-      if (in_x_int != in_x_float) {
-        return false;
-      }
-    }
+TEST(ResizeNearestNeighborOptimized, TestReferenceParity) {
+  const int kTestsToRun = 10000;
+  for (int i = 0; i < kTestsToRun; i++) {
+    const int batch = ExponentialRandomPositiveInt(0.9f, 3, 20);
+    const int depth = ExponentialRandomPositiveInt(0.9f, 6, 50);
+    const int input_width = ExponentialRandomPositiveInt(0.9f, 20, 200);
+    const int input_height = ExponentialRandomPositiveInt(0.9f, 20, 200);
+    const int output_width = ExponentialRandomPositiveInt(0.9f, 20, 200);
+    const int output_height = ExponentialRandomPositiveInt(0.9f, 20, 200);
+
+    TestOptimizedResizeNearestNeighbor(batch, depth, input_width, input_height,
+                                       output_width, output_height);
   }
-  return true;
 }
 
-TEST(ResizeNearestNeighborOptimized, TestReferenceParity) {
-  int invalid_count = 0;
-  const int kTestsToRun = 10000;
+TEST(ResizeNearestNeighborOptimized, TestReferenceParityMultithreaded) {
+  CpuBackendContext cpu_backend_context;
+  cpu_backend_context.SetMaxNumThreads(4);
+  const int kTestsToRun = 100;
   for (int i = 0; i < kTestsToRun; i++) {
     const int batch = ExponentialRandomPositiveInt(0.9f, 3, 20);
     const int depth = ExponentialRandomPositiveInt(0.9f, 6, 50);
@@ -447,16 +432,10 @@ TEST(ResizeNearestNeighborOptimized, TestReferenceParity) {
     const int output_width = ExponentialRandomPositiveInt(0.9f, 20, 200);
     const int output_height = ExponentialRandomPositiveInt(0.9f, 20, 200);
 
-    if (is_valid_scale(input_width, input_height, output_width,
-                       output_height)) {
-      TestOptimizedResizeNearestNeighbor(
-          batch, depth, input_width, input_height, output_width, output_height);
-    } else {
-      invalid_count++;
-    }
+    TestOptimizedResizeNearestNeighbor(batch, depth, input_width, input_height,
+                                       output_width, output_height,
+                                       &cpu_backend_context);
   }
-  // Test that the total number of invalid tests are a small percentage.
-  ASSERT_LT(static_cast<float>(invalid_count) / kTestsToRun, 0.001f);
 }
 
 }  // namespace
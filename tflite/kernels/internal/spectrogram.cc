@@ -106,11 +106,17 @@ bool Spectrogram::Initialize(const std::vector<double>& window,
   // but keep it as a reminder.
   fft_integer_working_area_[0] = 0;
   input_queue_.clear();
+  input_queue_.reserve(window_length_ + step_length_);
   samples_to_next_step_ = window_length_;
   initialized_ = true;
   return true;
 }
 
+void Spectrogram::Reset() {
+  input_queue_.clear();
+  samples_to_next_step_ = window_length_;
+}
+
 template <class InputSample, class OutputSample>
 bool Spectrogram::ComputeComplexSpectrogram(
     const std::vector<InputSample>& input,
@@ -223,8 +229,11 @@ bool Spectrogram::GetNextWindowOfSamples(const std::vector<InputSample>& input,
 }
 
 void Spectrogram::ProcessCoreFFT() {
+  const double* samples = input_queue_.data();
+  const double* window = window_.data();
+  double* fft_input = fft_input_output_.data();
   for (int j = 0; j < window_length_; ++j) {
-    fft_input_output_[j] = input_queue_[j] * window_[j];
+    fft_input[j] = samples[j] * window[j];
   }
   // Zero-pad the rest of the input buffer.
   for (int j = window_length_; j < fft_length_; ++j) {
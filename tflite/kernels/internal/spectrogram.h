@@ -32,7 +32,6 @@ limitations under the License.
 #define TENSORFLOW_LITE_KERNELS_INTERNAL_SPECTROGRAM_H_
 
 #include <complex>
-#include <deque>
 #include <vector>
 
 #include "third_party/fft2d/fft.h"
@@ -55,6 +54,10 @@ class Spectrogram {
   // Initialize with an explicit window instead of a length.
   bool Initialize(const std::vector<double>& window, int step_length);
 
+  // Discards the buffered audio so that the next Compute*() call starts a
+  // new signal, keeping the window and the FFT tables of Initialize().
+  void Reset();
+
   // Processes an arbitrary amount of audio data (contained in input)
   // to yield complex spectrogram frames. After a successful call to
   // Initialize(), Process() may be called repeatedly with new input data
@@ -97,7 +100,10 @@ class Spectrogram {
 
   std::vector<double> window_;
   std::vector<double> fft_input_output_;
-  std::deque<double> input_queue_;
+  // The last samples of the input, at most window_length_ of them once a
+  // window is complete, stored contiguously so that the windowing
+  // vectorizes.
+  std::vector<double> input_queue_;
 
   // Working data areas for the FFT routines.
   std::vector<int> fft_integer_working_area_;
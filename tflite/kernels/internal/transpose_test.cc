@@ -0,0 +1,160 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/kernels/internal/optimized/transpose.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/internal/types.h"
+#include "tflite/kernels/transpose_test_utils.h"
+
+#ifdef TRANSPOSE_BENCHMARKS
+#include "testing/base/public/benchmark.h"
+#endif  // TRANSPOSE_BENCHMARKS
+
+namespace tflite {
+namespace {
+
+// Transposes the same data as RunTestPermutation() with
+// optimized_ops::Transpose().
+template <typename T>
+std::vector<T> RunOptimizedPermutation(const std::vector<int>& shape,
+                                       const std::vector<int>& perm,
+                                       CpuBackendContext* cpu_backend_context) {
+  const int count =
+      std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<>{});
+  std::vector<T> input(count);
+  std::iota(input.begin(), input.end(), static_cast<T>(0));
+  std::vector<T> output(count);
+
+  const RuntimeShape input_shape(shape.size(), shape.data());
+  RuntimeShape output_shape(perm.size());
+  TransposeParams params{};
+  params.perm_count = perm.size();
+  for (int i = 0; i < perm.size(); ++i) {
+    output_shape.SetDim(i, input_shape.Dims(perm[i]));
+    params.perm[i] = perm[i];
+  }
+  optimized_ops::Transpose(params, input_shape, input.data(), output_shape,
+                           output.data(), cpu_backend_context);
+  return output;
+}
+
+// Checks all the permutations of `shape` against the reference transpose.
+template <typename T>
+void ExpectAllPermutationsMatchReference(
+    const std::vector<int>& shape, CpuBackendContext* cpu_backend_context) {
+  std::vector<int> perm(shape.size());
+  std::iota(perm.begin(), perm.end(), 0);
+  do {
+    ASSERT_EQ(RunOptimizedPermutation<T>(shape, perm, cpu_backend_context),
+              RunTestPermutation<T>(shape, perm))
+        << "perm: " << ::testing::PrintToString(perm)
+        << " shape: " << ::testing::PrintToString(shape);
+  } while (std::next_permutation(perm.begin(), perm.end()));
+}
+
+template <typename T>
+class OptimizedTransposeTest : public ::testing::Test {};
+
+using ElementTypes = ::testing::Types<int8_t, int16_t, int32_t, int64_t>;
+TYPED_TEST_SUITE(OptimizedTransposeTest, ElementTypes);
+
+TYPED_TEST(OptimizedTransposeTest, SmallShapes) {
+  for (const auto& shape : std::vector<std::vector<int>>{{7},
+                                                         {3, 5},
+                                                         {2, 3, 4},
+                                                         {1, 3, 1, 5},
+                                                         {2, 3, 4, 5},
+                                                         {2, 1, 3, 2, 3},
+                                                         {2, 3, 2, 2, 2, 3}}) {
+    ExpectAllPermutationsMatchReference<TypeParam>(shape, nullptr);
+  }
+}
+
+TYPED_TEST(OptimizedTransposeTest, ShapesLargerThanTiles) {
+  for (const auto& shape :
+       std::vector<std::vector<int>>{{67, 131}, {3, 70, 65}, {2, 9, 66, 3}}) {
+    ExpectAllPermutationsMatchReference<TypeParam>(shape, nullptr);
+  }
+}
+
+TYPED_TEST(OptimizedTransposeTest, MultipleThreads) {
+  CpuBackendContext cpu_backend_context;
+  cpu_backend_context.SetMaxNumThreads(4);
+  for (const auto& shape :
+       std::vector<std::vector<int>>{{257, 300}, {2, 8, 100, 64}}) {
+    ExpectAllPermutationsMatchReference<TypeParam>(shape,
+                                                   &cpu_backend_context);
+  }
+}
+
+}  // namespace
+}  // namespace tflite
+
+#ifdef TRANSPOSE_BENCHMARKS
+
+// Compile with --copt="-DGOOGLE_COMMANDLINEFLAGS_FULL_API=1" and
+// --copt="-DTRANSPOSE_BENCHMARKS"
+// Run with --benchmark_filter=all
+//
+// Transposes [B, H, S, D] float tensors, the arguments being B, H, S, D, the
+// permutation index (0: [B, S, H, D], 1: [B, H, D, S], 2: [B, D, S, H]) and
+// the number of threads.
+void BM_TransposeAttention(benchmark::State& state) {
+  const std::vector<int> shape = {
+      static_cast<int>(state.range(0)), static_cast<int>(state.range(1)),
+      static_cast<int>(state.range(2)), static_cast<int>(state.range(3))};
+  static const int kPerms[][4] = {{0, 2, 1, 3}, {0, 1, 3, 2}, {0, 3, 2, 1}};
+  const int* perm = kPerms[state.range(4)];
+  tflite::CpuBackendContext cpu_backend_context;
+  cpu_backend_context.SetMaxNumThreads(state.range(5));
+
+  const tflite::RuntimeShape input_shape(shape.size(), shape.data());
+  tflite::RuntimeShape output_shape(4);
+  tflite::TransposeParams params{};
+  params.perm_count = 4;
+  for (int i = 0; i < 4; ++i) {
+    output_shape.SetDim(i, input_shape.Dims(perm[i]));
+    params.perm[i] = perm[i];
+  }
+  std::vector<float> input(input_shape.FlatSize(), 1.0f);
+  std::vector<float> output(input.size());
+  for (auto _ : state) {
+    tflite::optimized_ops::Transpose(params, input_shape, input.data(),
+                                     output_shape, output.data(),
+                                     &cpu_backend_context);
+    testing::DoNotOptimize(output[0]);
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * input.size() *
+                          sizeof(float));
+}
+BENCHMARK(BM_TransposeAttention)
+    ->Args({1, 12, 197, 64, 0, 1})
+    ->Args({1, 12, 197, 64, 1, 1})
+    ->Args({1, 12, 197, 64, 2, 1})
+    ->Args({1, 12, 197, 64, 0, 4})
+    ->Args({1, 12, 197, 64, 1, 4})
+    ->Args({1, 12, 197, 64, 2, 4})
+    ->Args({8, 16, 256, 64, 0, 1})
+    ->Args({8, 16, 256, 64, 1, 1})
+    ->Args({8, 16, 256, 64, 0, 4})
+    ->Args({8, 16, 256, 64, 1, 4});
+
+#endif  // TRANSPOSE_BENCHMARKS
@@ -150,6 +150,51 @@ size_t Flatten(const RuntimeShape& input_shape,
   return flat_size;
 }
 
+void CollapseDimensions(RuntimeShape* input_shape, RuntimeShape* output_shape,
+                        TransposeParams* params) {
+  RemoveOneSizeDimensions(input_shape, output_shape, params);
+  const int dims_cnt = params->perm_count;
+
+  // The output dimensions starting a run of consecutive input dimensions.
+  bool starts_run[kTransposeMaxDimensions];
+  int new_dims_cnt = 0;
+  for (int i = 0; i < dims_cnt; ++i) {
+    starts_run[i] = i == 0 || params->perm[i] != params->perm[i - 1] + 1;
+    if (starts_run[i]) ++new_dims_cnt;
+  }
+  if (new_dims_cnt == dims_cnt) return;
+
+  // Merges the runs in the output shape, and numbers them by the input
+  // dimension they start with.
+  int run_of_input_dim[kTransposeMaxDimensions];
+  int run_size[kTransposeMaxDimensions];
+  int run = -1;
+  for (int i = 0; i < dims_cnt; ++i) {
+    if (starts_run[i]) {
+      ++run;
+      run_size[run] = 1;
+    }
+    run_of_input_dim[params->perm[i]] = starts_run[i] ? run : -1;
+    run_size[run] *= output_shape->Dims(i);
+  }
+  TransposeParams new_params;
+  new_params.perm_count = new_dims_cnt;
+  int new_input_dim = 0;
+  for (int i = 0; i < dims_cnt; ++i) {
+    if (run_of_input_dim[i] == -1) continue;
+    const int run = run_of_input_dim[i];
+    input_shape->SetDim(new_input_dim, run_size[run]);
+    new_params.perm[run] = new_input_dim;
+    ++new_input_dim;
+  }
+  input_shape->Resize(new_dims_cnt);
+  output_shape->Resize(new_dims_cnt);
+  for (int i = 0; i < new_dims_cnt; ++i) {
+    output_shape->SetDim(i, input_shape->Dims(new_params.perm[i]));
+  }
+  *params = new_params;
+}
+
 }  // namespace transpose_utils
 
 }  // namespace tflite
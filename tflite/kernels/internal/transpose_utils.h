@@ -45,6 +45,16 @@ size_t Flatten(const RuntimeShape& input_shape,
                RuntimeShape* non_flatten_output_shape,
                TransposeParams* non_flatten_params);
 
+// CollapseDimensions removes one size dimensions, then merges the input
+// dimensions which stay next to each other in the output, adjusting the
+// shapes and the perm parameter.
+//
+// E.g, perm [0, 2, 3, 1] of a [B, H, S, D] input becomes perm [0, 2, 1] of a
+// [B, H, S * D] input, and perm [1, 2, 0] of a [A, B, C] input becomes perm
+// [1, 0] of a [A, B * C] input.
+void CollapseDimensions(RuntimeShape* input_shape, RuntimeShape* output_shape,
+                        TransposeParams* params);
+
 }  // namespace transpose_utils
 
 }  // namespace tflite
@@ -496,5 +496,89 @@ TEST(TransposeUtilsTest, IsTranspose2DApplicable4DNotApplicable) {
   EXPECT_FALSE(applicable);
 }
 
+TEST(TransposeUtilsTest, CollapseDimensions_NoChanges) {
+  RuntimeShape input_shape({4, 5, 6});
+  RuntimeShape output_shape({6, 5, 4});
+
+  TransposeParams params;
+  params.perm_count = 3;
+  params.perm[0] = 2;
+  params.perm[1] = 1;
+  params.perm[2] = 0;
+
+  transpose_utils::CollapseDimensions(&input_shape, &output_shape, &params);
+
+  EXPECT_EQ(input_shape, RuntimeShape({4, 5, 6}));
+  EXPECT_EQ(output_shape, RuntimeShape({6, 5, 4}));
+
+  EXPECT_EQ(params.perm_count, 3);
+  EXPECT_EQ(params.perm[0], 2);
+  EXPECT_EQ(params.perm[1], 1);
+  EXPECT_EQ(params.perm[2], 0);
+}
+
+TEST(TransposeUtilsTest, CollapseDimensions_4DTo3D) {
+  RuntimeShape input_shape({2, 3, 4, 5});
+  RuntimeShape output_shape({2, 4, 5, 3});
+
+  TransposeParams params;
+  params.perm_count = 4;
+  params.perm[0] = 0;
+  params.perm[1] = 2;
+  params.perm[2] = 3;
+  params.perm[3] = 1;
+
+  transpose_utils::CollapseDimensions(&input_shape, &output_shape, &params);
+
+  EXPECT_EQ(input_shape, RuntimeShape({2, 3, 20}));
+  EXPECT_EQ(output_shape, RuntimeShape({2, 20, 3}));
+
+  EXPECT_EQ(params.perm_count, 3);
+  EXPECT_EQ(params.perm[0], 0);
+  EXPECT_EQ(params.perm[1], 2);
+  EXPECT_EQ(params.perm[2], 1);
+}
+
+TEST(TransposeUtilsTest, CollapseDimensions_5DTo2DWithOneSizeDimension) {
+  RuntimeShape input_shape({2, 3, 1, 4, 5});
+  RuntimeShape output_shape({4, 1, 5, 2, 3});
+
+  TransposeParams params;
+  params.perm_count = 5;
+  params.perm[0] = 3;
+  params.perm[1] = 2;
+  params.perm[2] = 4;
+  params.perm[3] = 0;
+  params.perm[4] = 1;
+
+  transpose_utils::CollapseDimensions(&input_shape, &output_shape, &params);
+
+  EXPECT_EQ(input_shape, RuntimeShape({6, 20}));
+  EXPECT_EQ(output_shape, RuntimeShape({20, 6}));
+
+  EXPECT_EQ(params.perm_count, 2);
+  EXPECT_EQ(params.perm[0], 1);
+  EXPECT_EQ(params.perm[1], 0);
+}
+
+TEST(TransposeUtilsTest, CollapseDimensions_IdentityTo1D) {
+  RuntimeShape input_shape({2, 3, 4});
+  RuntimeShape output_shape({2, 3, 4});
+
+  TransposeParams params;
+  params.perm_count = 3;
+  params.perm[0] = 0;
+  params.perm[1] = 1;
+  params.perm[2] = 2;
+
+  transpose_utils::CollapseDimensions(&input_shape, &output_shape, &params);
+
+  EXPECT_EQ(input_shape, RuntimeShape({24}));
+  EXPECT_EQ(output_shape, RuntimeShape({24}));
+
+  EXPECT_EQ(params.perm_count, 1);
+  EXPECT_EQ(params.perm[0], 0);
+}
+
 }  // namespace
 }  // namespace tflite
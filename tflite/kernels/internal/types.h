@@ -733,6 +733,11 @@ struct Conv3DParams {
   // float activation params.
   float float_activation_min;
   float float_activation_max;
+  // int8_t inference params, the multipliers being per output channel.
+  int32_t input_offset;
+  int32_t output_offset;
+  int32_t quantized_activation_min;
+  int32_t quantized_activation_max;
 };
 
 typedef Conv3DParams Conv3DTransposeParams;
@@ -802,6 +807,30 @@ struct FullyConnectedParams {
   FullyConnectedWeightsFormat weights_format;
 };
 
+// Parameters of a matrix multiply whose result is added to a residual tensor,
+// as computed by a pointwise convolution or a fully connected layer followed
+// by an ADD.
+struct FusedResidualParams {
+  // The range of the products, i.e. the fused activation of the matrix
+  // multiply and, for int8_t, the range of its quantized output.
+  float product_min;
+  float product_max;
+  // The range of the sums, i.e. the fused activation of the addition.
+  float float_activation_min;
+  float float_activation_max;
+  // int8_t inference params.
+  int32_t input_zero_point;
+  // The scale of the accumulators of each output channel, i.e. the input
+  // scale times the filter scale of the channel.
+  const float* product_scales;
+  int32_t residual_zero_point;
+  float residual_scale;
+  int32_t output_zero_point;
+  float output_scale;
+  int32_t quantized_activation_min;
+  int32_t quantized_activation_max;
+};
+
 struct GatherParams {
   int16_t axis;
   int16_t batch_dims;
@@ -812,6 +841,15 @@ struct L2NormalizationParams {
   int32_t input_zero_point;
 };
 
+struct LayerNormalizationParams {
+  float epsilon;
+  // int8_t inference params.
+  int32_t input_zero_point;
+  float input_scale;
+  int32_t output_zero_point;
+  float output_scale;
+};
+
 struct LocalResponseNormalizationParams {
   int32_t range;
   double bias;
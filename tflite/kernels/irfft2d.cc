@@ -20,10 +20,13 @@ limitations under the License.
 
 #include <algorithm>
 #include <complex>
+#include <vector>
 
 #include "third_party/fft2d/fft2d.h"
 #include "ruy/profiler/instrumentation.h"  // from @ruy
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/cpu_backend_threadpool.h"
 #include "tflite/kernels/internal/tensor.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/internal/types.h"
@@ -39,15 +42,22 @@ using std::complex;
 constexpr int kInputTensor = 0;
 constexpr int kFftLengthTensor = 1;
 constexpr int kOutputTensor = 0;
-constexpr int kFftIntegerWorkingAreaTensor = 0;
-constexpr int kFftDoubleWorkingAreaTensor = 1;
+constexpr int kFftBufferTensor = 0;
 constexpr int kTensorNotAllocated = -1;
+// The slices are split in tasks transforming at least this many elements.
+constexpr int kMinFftElementsPerTask = 1 << 14;
 
 struct OpData {
   // IDs are the arbitrary identifiers used by TF Lite to identify and access
   // memory buffers.
-  int fft_integer_working_area_id = kTensorNotAllocated;
-  int fft_double_working_area_id = kTensorNotAllocated;
+  int fft_buffer_id = kTensorNotAllocated;
+  // The plan of fft2d for `fft_height` x `fft_width` transforms, i.e. its
+  // bit-reversal orders and twiddle tables, which is computed once per shape
+  // and read by the transforms of all the slices.
+  int fft_height = 0;
+  int fft_width = 0;
+  std::vector<int> fft_integer_working_area;
+  std::vector<double> fft_double_working_area;
 };
 
 bool IsPowerOfTwo(uint32_t v) { return v && !(v & (v - 1)); }
@@ -57,51 +67,57 @@ static TfLiteStatus InitTemporaryTensors(TfLiteContext* context,
   OpData* data = reinterpret_cast<OpData*>(node->user_data);
   // The prepare function may be executed multiple times. But temporary tensors
   // only need to be initiated once.
-  if (data->fft_integer_working_area_id != kTensorNotAllocated &&
-      data->fft_double_working_area_id != kTensorNotAllocated) {
+  if (data->fft_buffer_id != kTensorNotAllocated) {
     return kTfLiteOk;
   }
 
   TfLiteIntArrayFree(node->temporaries);
-  // Create two temporary tensors.
-  node->temporaries = TfLiteIntArrayCreate(2);
+  // Create one temporary tensor, holding the FFT buffer of every task.
+  node->temporaries = TfLiteIntArrayCreate(1);
   int first_new_index;
-  TF_LITE_ENSURE_STATUS(context->AddTensors(context, 2, &first_new_index));
-  node->temporaries->data[kFftIntegerWorkingAreaTensor] = first_new_index;
-  data->fft_integer_working_area_id = first_new_index;
-  node->temporaries->data[kFftDoubleWorkingAreaTensor] = first_new_index + 1;
-  data->fft_double_working_area_id = first_new_index + 1;
-
-  // Set up FFT integer working area buffer.
-  TfLiteTensor* fft_integer_working_area;
+  TF_LITE_ENSURE_STATUS(context->AddTensors(context, 1, &first_new_index));
+  node->temporaries->data[kFftBufferTensor] = first_new_index;
+  data->fft_buffer_id = first_new_index;
+
+  // Set up FFT buffer.
+  TfLiteTensor* fft_buffer;
   TF_LITE_ENSURE_OK(
-      context, GetTemporarySafe(context, node, kFftIntegerWorkingAreaTensor,
-                                &fft_integer_working_area));
-  fft_integer_working_area->type = kTfLiteInt32;
-  // If fft_length is not a constant tensor, fft_integer_working_area will be
-  // set to dynamic later in Prepare.
-  fft_integer_working_area->allocation_type = kTfLiteArenaRw;
-
-  // Set up FFT double working area buffer.
-  TfLiteTensor* fft_double_working_area;
-  TF_LITE_ENSURE_OK(context,
-                    GetTemporarySafe(context, node, kFftDoubleWorkingAreaTensor,
-                                     &fft_double_working_area));
-  // fft_double_working_area is a double tensor. Ideally, double should be
-  // added into tflite data types. However, since fft_double_working_area is a
-  // temporary tensor, and there are no ops having double input/output tensors
-  // in tflite at this point, adding double as a tflite data type may confuse
-  // users that double is supported. As a results, kTfLiteInt64 is used here
-  // for memory allocation. And it will be cast into double in Eval when being
-  // used.
-  fft_double_working_area->type = kTfLiteInt64;
-  // If fft_length is not a constant tensor, fft_double_working_area will be
-  // set to dynamic later in Prepare.
-  fft_double_working_area->allocation_type = kTfLiteArenaRw;
+      context, GetTemporarySafe(context, node, kFftBufferTensor, &fft_buffer));
+  // fft_buffer is a double tensor. Ideally, double should be added into tflite
+  // data types. However, since fft_buffer is a temporary tensor, and there are
+  // no ops having double input/output tensors in tflite at this point, adding
+  // double as a tflite data type may confuse users that double is supported.
+  // As a results, kTfLiteInt64 is used here for memory allocation. And it will
+  // be cast into double in Eval when being used.
+  fft_buffer->type = kTfLiteInt64;
+  // If fft_length is not a constant tensor, fft_buffer will be set to dynamic
+  // later in Prepare.
+  fft_buffer->allocation_type = kTfLiteArenaRw;
 
   return kTfLiteOk;
 }
 
+// Returns the number of slices of the input, transformed one after the other
+// on the innermost 2 dimensions.
+int GetNumSlices(const TfLiteTensor* input) {
+  int num_slices = 1;
+  for (int i = 0; i < NumDimensions(input) - 2; ++i) {
+    num_slices *= SizeOfDimension(input, i);
+  }
+  return num_slices;
+}
+
+// Returns the number of tasks between which the slices are split.
+int GetNumTasks(TfLiteContext* context, int num_slices, int fft_height,
+                int fft_width) {
+  const int64_t num_elements =
+      static_cast<int64_t>(num_slices) * fft_height * fft_width;
+  return static_cast<int>(std::max<int64_t>(
+      1, std::min<int64_t>(
+             {CpuBackendContext::GetFromContext(context)->max_num_threads(),
+              num_slices, num_elements / kMinFftElementsPerTask})));
+}
+
 TfLiteStatus ResizeOutputandTemporaryTensors(TfLiteContext* context,
                                              TfLiteNode* node) {
   const TfLiteTensor* input;
@@ -119,8 +135,6 @@ TfLiteStatus ResizeOutputandTemporaryTensors(TfLiteContext* context,
   int fft_height, fft_width;
   fft_height = fft_length_data[0];
   fft_width = fft_length_data[1];
-  int fft_working_length = std::max(fft_height, fft_width / 2);
-  int half_fft_working_length = fft_working_length / 2;
 
   // Resize output tensor.
   TfLiteTensor* output;
@@ -131,27 +145,16 @@ TfLiteStatus ResizeOutputandTemporaryTensors(TfLiteContext* context,
   output_shape->data[num_dims - 1] = fft_length_data[1];
   TF_LITE_ENSURE_STATUS(context->ResizeTensor(context, output, output_shape));
 
-  // Resize temporary tensors, fft_integer_working_area.
-  TfLiteTensor* fft_integer_working_area;
+  // Resize temporary tensors, fft_buffer, to the rows of one slice per task.
+  TfLiteTensor* fft_buffer;
   TF_LITE_ENSURE_OK(
-      context, GetTemporarySafe(context, node, kFftIntegerWorkingAreaTensor,
-                                &fft_integer_working_area));
-  TfLiteIntArray* fft_integer_working_area_shape = TfLiteIntArrayCreate(1);
-  fft_integer_working_area_shape->data[0] =
-      2 + static_cast<int>(sqrt(fft_working_length));
-  TF_LITE_ENSURE_STATUS(context->ResizeTensor(context, fft_integer_working_area,
-                                              fft_integer_working_area_shape));
-
-  // Resize temporary tensors, fft_double_working_area.
-  TfLiteTensor* fft_double_working_area;
-  TF_LITE_ENSURE_OK(context,
-                    GetTemporarySafe(context, node, kFftDoubleWorkingAreaTensor,
-                                     &fft_double_working_area));
-  TfLiteIntArray* fft_double_working_area_shape = TfLiteIntArrayCreate(1);
-  fft_double_working_area_shape->data[0] =
-      half_fft_working_length + fft_width / 4;
-  TF_LITE_ENSURE_STATUS(context->ResizeTensor(context, fft_double_working_area,
-                                              fft_double_working_area_shape));
+      context, GetTemporarySafe(context, node, kFftBufferTensor, &fft_buffer));
+  TfLiteIntArray* fft_buffer_shape = TfLiteIntArrayCreate(1);
+  fft_buffer_shape->data[0] =
+      GetNumTasks(context, GetNumSlices(input), fft_height, fft_width) *
+      fft_height * (fft_width + 2);
+  TF_LITE_ENSURE_STATUS(
+      context->ResizeTensor(context, fft_buffer, fft_buffer_shape));
 
   return kTfLiteOk;
 }
@@ -208,16 +211,10 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   // temporary tensors to dynamic, so that their tensor sizes can be determined
   // in Eval.
   if (!IsConstantOrPersistentTensor(fft_length)) {
-    TfLiteTensor* fft_integer_working_area;
-    TF_LITE_ENSURE_OK(
-        context, GetTemporarySafe(context, node, kFftIntegerWorkingAreaTensor,
-                                  &fft_integer_working_area));
-    TfLiteTensor* fft_double_working_area;
-    TF_LITE_ENSURE_OK(
-        context, GetTemporarySafe(context, node, kFftDoubleWorkingAreaTensor,
-                                  &fft_double_working_area));
-    SetTensorToDynamic(fft_integer_working_area);
-    SetTensorToDynamic(fft_double_working_area);
+    TfLiteTensor* fft_buffer;
+    TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node,
+                                                kFftBufferTensor, &fft_buffer));
+    SetTensorToDynamic(fft_buffer);
     SetTensorToDynamic(output);
     return kTfLiteOk;
   }
@@ -294,7 +291,87 @@ void PrepareOutputBuffer(float* output_data, int fft_height, int fft_width,
   }
 }
 
+// Computes the plan of `data` for `fft_height` x `fft_width` transforms, if it
+// isn't already, by transforming zeros in `fft_buffer`.
+void EnsureFftPlan(OpData* data, int fft_height, int fft_width,
+                   double* fft_buffer) {
+  if (data->fft_height == fft_height && data->fft_width == fft_width) {
+    return;
+  }
+  ruy::profiler::ScopeLabel label("Irfft2dPlan");
+  const int fft_working_length = std::max(fft_height, fft_width / 2);
+  const int half_fft_working_length = fft_working_length / 2;
+  // fft2d computes its tables when the working areas start with zeros.
+  data->fft_integer_working_area.assign(
+      2 + static_cast<int>(sqrt(fft_working_length)), 0);
+  data->fft_double_working_area.assign(
+      half_fft_working_length + fft_width / 4, 0);
+  std::vector<double*> fft_input_output(fft_height);
+  for (int i = 0; i < fft_height; ++i) {
+    fft_input_output[i] = fft_buffer + i * (fft_width + 2);
+    std::fill_n(fft_input_output[i], fft_width + 2, 0.0);
+  }
+  Irfft2dImpl(fft_height, fft_width, fft_input_output.data(),
+              data->fft_integer_working_area.data(),
+              data->fft_double_working_area.data());
+  data->fft_height = fft_height;
+  data->fft_width = fft_width;
+}
+
+// Transforms the slices [begin_slice, end_slice) with the rows of
+// `fft_buffer`, the plan of fft2d being only read.
+struct Irfft2dTask : cpu_backend_threadpool::Task {
+  Irfft2dTask(const complex<float>* input_data, int input_height,
+              int input_width, float* output_data, int fft_height,
+              int fft_width, int begin_slice, int end_slice, double* fft_buffer,
+              int* fft_integer_working_area_data,
+              double* fft_double_working_area_data)
+      : input_data(input_data),
+        input_height(input_height),
+        input_width(input_width),
+        output_data(output_data),
+        fft_height(fft_height),
+        fft_width(fft_width),
+        begin_slice(begin_slice),
+        end_slice(end_slice),
+        fft_buffer(fft_buffer),
+        fft_integer_working_area_data(fft_integer_working_area_data),
+        fft_double_working_area_data(fft_double_working_area_data) {}
+
+  void Run() override {
+    std::vector<double*> fft_input_output(fft_height);
+    for (int i = 0; i < fft_height; ++i) {
+      fft_input_output[i] = fft_buffer + i * (fft_width + 2);
+    }
+    const int input_slice_size = input_height * input_width;
+    const int output_slice_size = fft_height * fft_width;
+    for (int slice = begin_slice; slice < end_slice; ++slice) {
+      PrepareInputBuffer(input_data + slice * input_slice_size, input_height,
+                         input_width, fft_height, fft_width,
+                         fft_input_output.data());
+      Irfft2dImpl(fft_height, fft_width, fft_input_output.data(),
+                  fft_integer_working_area_data,
+                  fft_double_working_area_data);
+      PrepareOutputBuffer(output_data + slice * output_slice_size, fft_height,
+                          fft_width, fft_input_output.data());
+    }
+  }
+
+  const complex<float>* input_data;
+  const int input_height;
+  const int input_width;
+  float* output_data;
+  const int fft_height;
+  const int fft_width;
+  const int begin_slice;
+  const int end_slice;
+  double* fft_buffer;
+  int* fft_integer_working_area_data;
+  double* fft_double_working_area_data;
+};
+
 TfLiteStatus Irfft2dHelper(TfLiteContext* context, TfLiteNode* node) {
+  OpData* data = reinterpret_cast<OpData*>(node->user_data);
   const TfLiteTensor* input;
   TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, kInputTensor, &input));
   const complex<float>* input_data = GetTensorData<complex<float>>(input);
@@ -312,61 +389,47 @@ TfLiteStatus Irfft2dHelper(TfLiteContext* context, TfLiteNode* node) {
   fft_width = fft_length_data[1];
 
   // FFT is processed for every slice on the inner most 2 dimensions.
-  // Count the number of slices in the input tensor.
-  const RuntimeShape input_shape = GetTensorShape(input);
-  const int input_dims_count = input_shape.DimensionsCount();
-  const auto* input_dims_data = input_shape.DimsData();
-  int num_slices = 1;
-  for (int i = 0; i < input_dims_count - 2; ++i) {
-    num_slices *= input_dims_data[i];
-  }
-
-  int input_height = input_dims_data[input_dims_count - 2];
-  int input_width = input_dims_data[input_dims_count - 1];
-  int input_slice_size = input_height * input_width;
-  int output_slice_size = fft_height * fft_width;
+  const int num_slices = GetNumSlices(input);
+  const int input_height = SizeOfDimension(input, NumDimensions(input) - 2);
+  const int input_width = SizeOfDimension(input, NumDimensions(input) - 1);
 
-  // Create input/output buffer for FFT
-  double** fft_input_output = new double*[fft_height];
-  for (int i = 0; i < fft_height; ++i) {
-    fft_input_output[i] = new double[fft_width + 2];
-  }
-
-  // Get buffer for integer working area.
-  TfLiteTensor* fft_integer_working_area;
+  // Get the buffer holding the rows of the slice of every task, as doubles
+  // out of the memory of fft_buffer.
+  TfLiteTensor* fft_buffer;
   TF_LITE_ENSURE_OK(
-      context, GetTemporarySafe(context, node, kFftIntegerWorkingAreaTensor,
-                                &fft_integer_working_area));
-  int* fft_integer_working_area_data =
-      GetTensorData<int>(fft_integer_working_area);
-
-  // Get buffer for double working area.
-  TfLiteTensor* fft_double_working_area;
-  TF_LITE_ENSURE_OK(context,
-                    GetTemporarySafe(context, node, kFftDoubleWorkingAreaTensor,
-                                     &fft_double_working_area));
-  // Get double value out of the memory of fft_double_working_area_data.
-  double* fft_double_working_area_data = reinterpret_cast<double*>(
-      GetTensorData<int64_t>(fft_double_working_area));
-
-  // Process every slice in the input buffer
-  for (int i = 0; i < num_slices; ++i) {
-    PrepareInputBuffer(input_data, input_height, input_width, fft_height,
-                       fft_width, fft_input_output);
-    memset(fft_integer_working_area_data, 0, fft_integer_working_area->bytes);
-    memset(fft_double_working_area_data, 0, fft_double_working_area->bytes);
-    Irfft2dImpl(fft_height, fft_width, fft_input_output,
-                fft_integer_working_area_data, fft_double_working_area_data);
-    PrepareOutputBuffer(output_data, fft_height, fft_width, fft_input_output);
-    input_data += input_slice_size;
-    output_data += output_slice_size;
+      context, GetTemporarySafe(context, node, kFftBufferTensor, &fft_buffer));
+  double* fft_buffer_data =
+      reinterpret_cast<double*>(GetTensorData<int64_t>(fft_buffer));
+  const int64_t slice_buffer_size =
+      static_cast<int64_t>(fft_height) * (fft_width + 2);
+  const int num_tasks = static_cast<int>(std::min<int64_t>(
+      GetNumTasks(context, num_slices, fft_height, fft_width),
+      NumElements(fft_buffer) / slice_buffer_size));
+  TF_LITE_ENSURE(context, num_tasks >= 1);
+
+  EnsureFftPlan(data, fft_height, fft_width, fft_buffer_data);
+
+  // Process every slice in the input buffer, from the threads of the context
+  // when there is enough of them.
+  std::vector<Irfft2dTask> tasks;
+  tasks.reserve(num_tasks);
+  int begin_slice = 0;
+  for (int i = 0; i < num_tasks; ++i) {
+    const int end_slice =
+        begin_slice + (num_slices - begin_slice) / (num_tasks - i);
+    tasks.emplace_back(input_data, input_height, input_width, output_data,
+                       fft_height, fft_width, begin_slice, end_slice,
+                       fft_buffer_data + i * slice_buffer_size,
+                       data->fft_integer_working_area.data(),
+                       data->fft_double_working_area.data());
+    begin_slice = end_slice;
   }
-
-  // Delete the input buffer
-  for (int i = 0; i < fft_height; ++i) {
-    delete[] fft_input_output[i];
+  if (num_tasks == 1) {
+    tasks[0].Run();
+  } else {
+    cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                    CpuBackendContext::GetFromContext(context));
   }
-  delete[] fft_input_output;
 
   return kTfLiteOk;
 }
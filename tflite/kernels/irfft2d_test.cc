@@ -35,7 +35,8 @@ using ::testing::ElementsAreArray;
 
 class Irfft2dOpModel : public SingleOpModel {
  public:
-  Irfft2dOpModel(const TensorData& input, const TensorData& fft_lengths) {
+  Irfft2dOpModel(const TensorData& input, const TensorData& fft_lengths,
+                 int num_threads = -1) {
     input_ = AddInput(input);
     fft_lengths_ = AddInput(fft_lengths);
     TensorType output_type = TensorType_FLOAT32;
@@ -43,7 +44,9 @@ class Irfft2dOpModel : public SingleOpModel {
 
     const std::vector<uint8_t> custom_option;
     SetCustomOp("Irfft2d", custom_option, Register_IRFFT2D);
-    BuildInterpreter({GetShape(input_)});
+    BuildInterpreter({GetShape(input_)}, num_threads,
+                     /*allow_fp32_relax_to_fp16=*/false,
+                     /*apply_delegate=*/true);
   }
 
   int input() { return input_; }
@@ -129,6 +132,44 @@ TEST(Irfft2dOpTest, InputDimsGreaterThan2) {
   EXPECT_THAT(model.GetOutput(), ElementsAreArray(expected_result));
 }
 
+TEST(Irfft2dOpTest, ThreadedSlicesMatchSingleSlices) {
+  constexpr int kNumSlices = 32;
+  constexpr int kHeight = 32;
+  constexpr int kWidth = 64;
+  constexpr int kInputWidth = kWidth / 2 + 1;
+  constexpr int kInputSliceSize = kHeight * kInputWidth;
+  std::vector<std::complex<float>> input(kNumSlices * kInputSliceSize);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = {static_cast<float>((i * 7919) % 101) / 10.0f - 5.0f,
+                static_cast<float>((i * 104729) % 103) / 10.0f - 5.0f};
+  }
+  Irfft2dOpModel model(
+      {TensorType_COMPLEX64, {kNumSlices, kHeight, kInputWidth}},
+      {TensorType_INT32, {2}}, /*num_threads=*/4);
+  model.PopulateTensor<std::complex<float>>(model.input(), input);
+  model.PopulateTensor<int32_t>(model.fft_lengths(), {kHeight, kWidth});
+  ASSERT_EQ(model.Invoke(), kTfLiteOk);
+  const std::vector<float> output = model.GetOutput();
+  ASSERT_EQ(output.size(), kNumSlices * kHeight * kWidth);
+
+  for (const int slice : {0, kNumSlices / 2, kNumSlices - 1}) {
+    Irfft2dOpModel slice_model({TensorType_COMPLEX64, {kHeight, kInputWidth}},
+                               {TensorType_INT32, {2}});
+    slice_model.PopulateTensor<std::complex<float>>(
+        slice_model.input(),
+        std::vector<std::complex<float>>(
+            input.begin() + slice * kInputSliceSize,
+            input.begin() + (slice + 1) * kInputSliceSize));
+    slice_model.PopulateTensor<int32_t>(slice_model.fft_lengths(),
+                                        {kHeight, kWidth});
+    ASSERT_EQ(slice_model.Invoke(), kTfLiteOk);
+    EXPECT_THAT(
+        std::vector<float>(output.begin() + slice * kHeight * kWidth,
+                           output.begin() + (slice + 1) * kHeight * kWidth),
+        ElementsAreArray(slice_model.GetOutput()));
+  }
+}
+
 }  // namespace
 }  // namespace custom
 }  // namespace ops
@@ -69,6 +69,43 @@ void MatrixBatchVectorMultiplyAccumulate(
   }
 }
 
+// Computes input_to_gate_weights * input + gate_bias for the 'n_rows' input
+// vectors of 'input', i.e. for all the batches of several time steps, with one
+// matrix multiplication. The bias is skipped when null, for layer norm LSTM.
+void CalculateLstmInputToGateFloat(const float* input,
+                                   const float* input_to_gate_weights,
+                                   const float* gate_bias, int n_rows,
+                                   int n_input, int n_cell, float* product,
+                                   CpuBackendContext* cpu_backend_context) {
+  tflite::FullyConnectedParams float_fc_params;
+  float_fc_params.float_activation_min = std::numeric_limits<float>::lowest();
+  float_fc_params.float_activation_max = std::numeric_limits<float>::max();
+  float_fc_params.lhs_cacheable = true;
+  float_fc_params.rhs_cacheable = false;
+
+  tflite::RuntimeShape weight_shape({n_cell, n_input});
+  tflite::RuntimeShape input_shape({n_rows, n_input});
+  tflite::RuntimeShape bias_shape({n_cell});
+  tflite::RuntimeShape output_shape({n_rows, n_cell});
+  tflite::optimized_ops::FullyConnected(
+      float_fc_params, input_shape, input, weight_shape, input_to_gate_weights,
+      bias_shape, gate_bias, output_shape, product, cpu_backend_context);
+}
+
+// Fully quantized version of the above for the 8x8_16 LSTM, which leaves the
+// gate bias to layer normalization. 'scratch' holds n_rows * n_cell values.
+void CalculateLstmInputToGateInteger8x8_16(
+    const int8_t* input, const int8_t* input_to_gate_weights,
+    const int32_t* input_to_gate_bias, int32_t input_to_gate_scale_a,
+    int32_t input_to_gate_scale_b, int n_rows, int n_input, int n_cell,
+    int16_t* product, int32_t* scratch, CpuBackendContext* context) {
+  std::fill_n(product, n_rows * n_cell, 0);
+  tensor_utils::MatrixBatchVectorMultiplyAccumulate(
+      input, input_to_gate_bias, input_to_gate_weights, input_to_gate_scale_a,
+      input_to_gate_scale_b, n_rows, n_input, n_cell, 0, scratch, product,
+      context);
+}
+
 void ComputeRowSums(
     int32_t* input_to_input_row_sums, int32_t* input_to_forget_row_sums,
     int32_t* input_to_cell_row_sums, int32_t* input_to_output_row_sums,
@@ -181,6 +218,8 @@ inline float GetTensorScale(const TfLiteTensor* tensor) {
 //   cell_to_gate_weights      | n_cell               | y (peephole)
 //   gate_bias                 | n_cell               |
 //   layer_norm_coefficients   | n_cell               | y (layer norm)
+// Precomputed inputs:
+//   input_to_gate_product     | n_cell               | y (time blocks)
 // Output vector:
 //   gate                      | n_cell               |
 // Scalar parameters:
@@ -189,6 +228,10 @@ inline float GetTensorScale(const TfLiteTensor* tensor) {
 //   activation                                 - activation to use.
 //   is_input_all_zeros, is_aux_input_all_zeros - if input vectors are all zero.
 //   use_layer_norm                             - if doing layer norm LSTM.
+//
+// If input_to_gate_product is set, it holds W_input * input + bias (without
+// the bias with layer norm) computed ahead for a block of time steps, which
+// replaces the input matrix multiplication. It is overwritten.
 inline void CalculateLstmGateFloat(
     const float* input, const float* input_to_gate_weights,
     const float* aux_input, const float* aux_input_to_gate_weights,
@@ -199,25 +242,31 @@ inline void CalculateLstmGateFloat(
     const int n_output, const int n_cell,
     const TfLiteFusedActivation activation, float* gate,
     const bool is_input_all_zeros, const bool is_aux_input_all_zeros,
-    float* output, bool recurrent_is_diag, CpuBackendContext* context) {
+    float* output, bool recurrent_is_diag, CpuBackendContext* context,
+    float* input_to_gate_product) {
   const bool use_peephole = (cell_to_gate_weights != nullptr);
   const bool use_layer_norm = (layer_norm_coefficients != nullptr);
 
-  // Initialize scratch buffers with bias for regular lstm or initialize with
-  // zero for layer norm lstm.
-  if (use_layer_norm) {
-    std::fill_n(gate, n_cell * n_batch, 0.0f);
-  } else {
-    tensor_utils::VectorBatchVectorAssign(gate_bias, n_cell, n_batch, gate);
-  }
-  // For each batch and cell: compute input_weight * input.
-  // Skip if input is all zeros.
   float* accumulation_buffer = gate;
-  if (!is_input_all_zeros) {
-    MatrixBatchVectorMultiplyAccumulate(input_to_gate_weights, input,
-                                        accumulation_buffer, output, n_cell,
-                                        n_input, n_batch, context);
-    std::swap(accumulation_buffer, output);
+  if (input_to_gate_product != nullptr) {
+    // The bias and input_weight * input are already accumulated.
+    accumulation_buffer = input_to_gate_product;
+  } else {
+    // Initialize scratch buffers with bias for regular lstm or initialize with
+    // zero for layer norm lstm.
+    if (use_layer_norm) {
+      std::fill_n(gate, n_cell * n_batch, 0.0f);
+    } else {
+      tensor_utils::VectorBatchVectorAssign(gate_bias, n_cell, n_batch, gate);
+    }
+    // For each batch and cell: compute input_weight * input.
+    // Skip if input is all zeros.
+    if (!is_input_all_zeros) {
+      MatrixBatchVectorMultiplyAccumulate(input_to_gate_weights, input,
+                                          accumulation_buffer, output, n_cell,
+                                          n_input, n_batch, context);
+      std::swap(accumulation_buffer, output);
+    }
   }
   // For each batch and cell: compute aux_input_weight * aux_input.
   // Skip if auxiliary input is not available or all zeros.
@@ -550,7 +599,8 @@ void CalculateLstmOutputHybrid(
 }
 
 // Calculates a single LSTM gate, int8x8_16 version.
-// Implements the same functionality as CalculateLstmGateFloat.
+// Implements the same functionality as CalculateLstmGateFloat, including the
+// optional input_to_gate_product computed ahead, which is left unchanged.
 void CalculateLstmGateInteger8x8_16(
     // Input and weights
     const int8_t* input, const int8_t* input_to_gate_weights,
@@ -577,18 +627,24 @@ void CalculateLstmGateInteger8x8_16(
     // Parameters for performance optimizations
     CpuBackendContext* context,
     // Scratch arrays
-    int32_t* scratch5) {
+    int32_t* scratch5,
+    // Precomputed input_weight * input
+    const int16_t* input_to_gate_product) {
   const bool use_peephole = (cell_to_gate_weights != nullptr);
   const bool use_layer_norm = (layer_norm_coefficients != nullptr);
 
-  // Initialize scratch buffers with zeros. Note that unlike float and hybrid
-  // versions, bias is only used in layer normalization.
-  std::fill_n(gate, n_batch * n_cell, 0);
-  // For each batch and cell: compute input_weight * input.
-  tensor_utils::MatrixBatchVectorMultiplyAccumulate(
-      input, input_to_gate_bias, input_to_gate_weights, input_to_gate_scale_a,
-      input_to_gate_scale_b, n_batch, n_input, n_cell, 0, scratch5, gate,
-      context);
+  if (input_to_gate_product != nullptr) {
+    std::copy_n(input_to_gate_product, n_batch * n_cell, gate);
+  } else {
+    // Initialize scratch buffers with zeros. Note that unlike float and hybrid
+    // versions, bias is only used in layer normalization.
+    std::fill_n(gate, n_batch * n_cell, 0);
+    // For each batch and cell: compute input_weight * input.
+    tensor_utils::MatrixBatchVectorMultiplyAccumulate(
+        input, input_to_gate_bias, input_to_gate_weights, input_to_gate_scale_a,
+        input_to_gate_scale_b, n_batch, n_input, n_cell, 0, scratch5, gate,
+        context);
+  }
   // Note: no aux_input.
 
   // For each batch and cell: compute recurrent_weight * output_state.
@@ -863,6 +919,14 @@ void CalculateLstmOutputInteger8x8_8(
 //   cell_layer_norm_coefficients_ptr   - optional
 //   output_layer_norm_coefficients_ptr - optional
 //
+// Products of the input weights by input_ptr, plus the gate biases without
+// layer norm, of size 'n_batch * n_cell', computed ahead for a block of time
+// steps. They are optional (all or none), and overwritten:
+//   input_to_input_product_ptr         - optional
+//   input_to_forget_product_ptr        - optional
+//   input_to_cell_product_ptr          - optional
+//   input_to_output_product_ptr        - optional
+//
 // The pointers to the cell and output state and the output are updated.
 //
 // The pointers input_ptr, aux_input_ptr, and output_ptr point to data aligned
@@ -905,7 +969,11 @@ inline void LstmStepFloat(
     float* scratch1, float* scratch2, float* scratch3, float* scratch4,
     float* output_ptr, bool recurrent_to_input_is_diag,
     bool recurrent_to_forget_is_diag, bool recurrent_to_cell_is_diag,
-    bool recurrent_to_output_is_diag, CpuBackendContext* context) {
+    bool recurrent_to_output_is_diag, CpuBackendContext* context,
+    float* input_to_input_product_ptr = nullptr,
+    float* input_to_forget_product_ptr = nullptr,
+    float* input_to_cell_product_ptr = nullptr,
+    float* input_to_output_product_ptr = nullptr) {
   ruy::profiler::ScopeLabel label("LstmStepFloat");
   // Since we have already checked that weights are all there or none, we can
   // check the existence of only one to the get the condition.
@@ -918,8 +986,10 @@ inline void LstmStepFloat(
   float* output_gate_scratch = scratch3;
   float* accumulation_scratch_buffer = scratch4;
 
-  // Check if inputs are all zeros so we can skip some computations.
+  // Check if inputs are all zeros so we can skip some computations. This is
+  // moot when the input products are computed ahead.
   const bool is_input_all_zeros =
+      input_to_forget_product_ptr == nullptr &&
       tensor_utils::IsZeroVector(input_ptr, n_batch * n_input);
   const bool is_aux_input_all_zeros =
       (aux_input_ptr == nullptr ||
@@ -937,7 +1007,7 @@ inline void LstmStepFloat(
         n_input, n_aux_input, n_output, n_cell,
         /*activation=*/kTfLiteActSigmoid, input_gate_scratch,
         is_input_all_zeros, is_aux_input_all_zeros, accumulation_scratch_buffer,
-        recurrent_to_input_is_diag, context);
+        recurrent_to_input_is_diag, context, input_to_input_product_ptr);
   }
   // Calculate the forget gate.
   CalculateLstmGateFloat(
@@ -950,7 +1020,7 @@ inline void LstmStepFloat(
       n_input, n_aux_input, n_output, n_cell,
       /*activation=*/kTfLiteActSigmoid, forget_gate_scratch, is_input_all_zeros,
       is_aux_input_all_zeros, accumulation_scratch_buffer,
-      recurrent_to_forget_is_diag, context);
+      recurrent_to_forget_is_diag, context, input_to_forget_product_ptr);
   // Calculate the cell update gate.
   CalculateLstmGateFloat(
       input_ptr, input_to_cell_weights_ptr, aux_input_ptr,
@@ -962,7 +1032,7 @@ inline void LstmStepFloat(
       cell_gate_bias_ptr, n_batch, n_input, n_aux_input, n_output, n_cell,
       params->activation, cell_gate_scratch, is_input_all_zeros,
       is_aux_input_all_zeros, accumulation_scratch_buffer,
-      recurrent_to_cell_is_diag, context);
+      recurrent_to_cell_is_diag, context, input_to_cell_product_ptr);
   // Update the cell state.
   UpdateLstmCellFloat(n_batch, n_cell, cell_state_ptr, input_gate_scratch,
                       forget_gate_scratch, cell_gate_scratch, use_cifg,
@@ -978,7 +1048,7 @@ inline void LstmStepFloat(
       n_input, n_aux_input, n_output, n_cell,
       /*activation=*/kTfLiteActSigmoid, output_gate_scratch, is_input_all_zeros,
       is_aux_input_all_zeros, accumulation_scratch_buffer,
-      recurrent_to_output_is_diag, context);
+      recurrent_to_output_is_diag, context, input_to_output_product_ptr);
   // Update the output state.
   CalculateLstmOutputFloat(n_batch, n_cell, n_output, cell_state_ptr,
                            output_gate_scratch, params->activation,
@@ -1412,6 +1482,13 @@ inline void LstmStepHybrid(
 //   scratch5: this scratch buffer is created purely for optimizing the
 //              MatrixBatchVectorMultiplyAccumulate.
 //
+// Products of the input weights by input_ptr, of size 'n_batch * n_cell',
+// computed ahead for a block of time steps. They are optional (all or none):
+//   input_to_input_product_ptr         - optional
+//   input_to_forget_product_ptr        - optional
+//   input_to_cell_product_ptr          - optional
+//   input_to_output_product_ptr        - optional
+//
 // Outputs:
 //   output_state_ptr - size 'n_batch * n_output'
 //   cell_state_ptr   - size 'n_batch * n_cell'
@@ -1480,7 +1557,11 @@ inline void LstmStepInteger8x8_16(
     int n_input, int n_output, int8_t* output_state_ptr,
     int32_t output_state_zp, int16_t* cell_state_ptr, int8_t* output_ptr,
     int16_t* scratch0, int16_t* scratch1, int16_t* scratch2, int16_t* scratch3,
-    int8_t* scratch4, int32_t* scratch5, CpuBackendContext* context) {
+    int8_t* scratch4, int32_t* scratch5, CpuBackendContext* context,
+    const int16_t* input_to_input_product_ptr = nullptr,
+    const int16_t* input_to_forget_product_ptr = nullptr,
+    const int16_t* input_to_cell_product_ptr = nullptr,
+    const int16_t* input_to_output_product_ptr = nullptr) {
   ruy::profiler::ScopeLabel label("LstmStepInteger8x8_16");
   // Make named scratch buffers for the different gates.
   int16_t* input_gate_scratch = scratch0;
@@ -1519,7 +1600,8 @@ inline void LstmStepInteger8x8_16(
         effective_cell_to_input_scale_b, layer_norm_input_weight_ptr,
         input_gate_bias_ptr, layer_norm_input_scale_a, layer_norm_input_scale_b,
         input_variance_guard, n_batch, n_input, n_output, n_cell,
-        kTfLiteActSigmoid, input_gate_scratch, context, scratch5);
+        kTfLiteActSigmoid, input_gate_scratch, context, scratch5,
+        input_to_input_product_ptr);
   }
   // Calculate the forget gate.
   CalculateLstmGateInteger8x8_16(
@@ -1533,7 +1615,7 @@ inline void LstmStepInteger8x8_16(
       forget_gate_bias_ptr, layer_norm_forget_scale_a,
       layer_norm_forget_scale_b, forget_variance_guard, n_batch, n_input,
       n_output, n_cell, kTfLiteActSigmoid, forget_gate_scratch, context,
-      scratch5);
+      scratch5, input_to_forget_product_ptr);
   // Calculate the cell update gate.
   CalculateLstmGateInteger8x8_16(
       input_ptr, input_to_cell_weight_ptr, input_to_cell_effective_bias,
@@ -1545,7 +1627,7 @@ inline void LstmStepInteger8x8_16(
       /*cell_to_gate_scale_b=*/0, layer_norm_cell_weight_ptr,
       cell_gate_bias_ptr, layer_norm_cell_scale_a, layer_norm_cell_scale_b,
       cell_variance_guard, n_batch, n_input, n_output, n_cell, kTfLiteActTanh,
-      cell_gate_scratch, context, scratch5);
+      cell_gate_scratch, context, scratch5, input_to_cell_product_ptr);
   // Update the cell state.
   UpdateLstmCellInteger(n_batch, n_cell, cell_state_ptr, cell_state_scale,
                         input_gate_scratch, forget_gate_scratch,
@@ -1562,7 +1644,7 @@ inline void LstmStepInteger8x8_16(
       output_gate_bias_ptr, layer_norm_output_scale_a,
       layer_norm_output_scale_b, output_variance_guard, n_batch, n_input,
       n_output, n_cell, kTfLiteActSigmoid, output_gate_scratch, context,
-      scratch5);
+      scratch5, input_to_output_product_ptr);
   // Update the output state.
   CalculateLstmOutputInteger8x8_16(
       n_batch, n_cell, n_output, cell_state_ptr, cell_state_scale,
@@ -1819,7 +1901,7 @@ TfLiteStatus EvalFloat(
     TfLiteTensor* cell_state, TfLiteTensor* output,
     bool recurrent_to_input_is_diag, bool recurrent_to_forget_is_diag,
     bool recurrent_to_cell_is_diag, bool recurrent_to_output_is_diag,
-    CpuBackendContext* context) {
+    CpuBackendContext* context, TfLiteTensor* input_products) {
   TF_LITE_ASSERT(input->dims->size >= 2 && input->dims->size <= 3);
 
   int max_time, n_batch;
@@ -1864,16 +1946,78 @@ TfLiteStatus EvalFloat(
     accumulation_scratch_buffer = scratch_buffer_ptr + 4 * n_cell * n_batch;
   }
 
+  // Index the input products pointers, one block of 'block_rows' input
+  // vectors per gate, if they are computed ahead.
+  int block_rows = 0;
+  float* input_to_input_product = nullptr;
+  float* input_to_forget_product = nullptr;
+  float* input_to_cell_product = nullptr;
+  float* input_to_output_product = nullptr;
+  if (input_products != nullptr && aux_input == nullptr) {
+    block_rows = input_products->dims->data[1];
+    TF_LITE_ASSERT(block_rows >= n_batch);
+    const int gate_size = block_rows * n_cell;
+    float* input_products_ptr = GetTensorData<float>(input_products);
+    if (!use_cifg) {
+      input_to_input_product = input_products_ptr;
+      input_products_ptr += gate_size;
+    }
+    input_to_forget_product = input_products_ptr;
+    input_to_cell_product = input_products_ptr + gate_size;
+    input_to_output_product = input_products_ptr + 2 * gate_size;
+  }
+  // The gate biases are added after the normalization with layer norm.
+  const bool use_layer_norm = (forget_layer_norm_coefficients != nullptr);
+  // Computes the input products of 'n_rows' consecutive input vectors.
+  auto calculate_input_products = [&](const float* input_ptr, int n_rows) {
+    ruy::profiler::ScopeLabel label("LstmInputToGateFloat");
+    if (!use_cifg) {
+      CalculateLstmInputToGateFloat(
+          input_ptr, GetTensorData<float>(input_to_input_weights),
+          use_layer_norm ? nullptr : GetTensorData<float>(input_gate_bias),
+          n_rows, n_input, n_cell, input_to_input_product, context);
+    }
+    CalculateLstmInputToGateFloat(
+        input_ptr, GetTensorData<float>(input_to_forget_weights),
+        use_layer_norm ? nullptr : GetTensorData<float>(forget_gate_bias),
+        n_rows, n_input, n_cell, input_to_forget_product, context);
+    CalculateLstmInputToGateFloat(
+        input_ptr, GetTensorData<float>(input_to_cell_weights),
+        use_layer_norm ? nullptr : GetTensorData<float>(cell_gate_bias), n_rows,
+        n_input, n_cell, input_to_cell_product, context);
+    CalculateLstmInputToGateFloat(
+        input_ptr, GetTensorData<float>(input_to_output_weights),
+        use_layer_norm ? nullptr : GetTensorData<float>(output_gate_bias),
+        n_rows, n_input, n_cell, input_to_output_product, context);
+  };
+  auto product_at = [](float* product, int offset) {
+    return product == nullptr ? nullptr : product + offset;
+  };
+
   const int output_batch_leading_dim =
       output->dims->data[output->dims->size - 1];
   if (time_major) {
     // Loop through the sequence.
     const int input_step = n_batch * n_input;
     const int output_step = n_batch * output_batch_leading_dim;
+    const int block_steps = block_rows / n_batch;
+    // The first t_rel of the current block.
+    int block_begin = 0;
     for (int t = 0; t < max_time; t++) {
       // If this is the forward_sequence, step forward, otherwise step
       // backwards.
       const int t_rel = forward_sequence ? t : max_time - t - 1;
+      int product_offset = 0;
+      if (block_steps > 0) {
+        if (t % block_steps == 0) {
+          const int num_steps = std::min(block_steps, max_time - t);
+          block_begin = forward_sequence ? t : max_time - t - num_steps;
+          calculate_input_products(
+              GetTensorData<float>(input) + block_begin * input_step,
+              num_steps * n_batch);
+        }
+        product_offset = (t_rel - block_begin) * n_batch * n_cell;
+      }
       const float* input_ptr = GetTensorData<float>(input) + t_rel * input_step;
       const float* aux_input_ptr = nullptr;
       if (aux_input) {
@@ -1913,17 +2057,35 @@ TfLiteStatus EvalFloat(
           input_gate_scratch, forget_gate_scratch, cell_gate_scratch,
           output_gate_scratch, accumulation_scratch_buffer, output_ptr,
           recurrent_to_input_is_diag, recurrent_to_forget_is_diag,
-          recurrent_to_cell_is_diag, recurrent_to_output_is_diag, context);
+          recurrent_to_cell_is_diag, recurrent_to_output_is_diag, context,
+          product_at(input_to_input_product, product_offset),
+          product_at(input_to_forget_product, product_offset),
+          product_at(input_to_cell_product, product_offset),
+          product_at(input_to_output_product, product_offset));
     }
   } else {
     for (int b = 0; b < n_batch; b++) {
       const int input_step = n_input;
       const int output_step = output_batch_leading_dim;
+      // The first t_rel of the current block.
+      int block_begin = 0;
       for (int t = 0; t < max_time; t++) {
         // If this is the forward_sequence, step forward, otherwise step
         // backwards.
         const int t_rel = forward_sequence ? t : max_time - t - 1;
         const int time_offset = b * max_time + t_rel;
+        int product_offset = 0;
+        if (block_rows > 0) {
+          if (t % block_rows == 0) {
+            const int num_steps = std::min(block_rows, max_time - t);
+            block_begin = forward_sequence ? t : max_time - t - num_steps;
+            calculate_input_products(
+                GetTensorData<float>(input) +
+                    (b * max_time + block_begin) * input_step,
+                num_steps);
+          }
+          product_offset = (t_rel - block_begin) * n_cell;
+        }
         const float* input_ptr =
             GetTensorData<float>(input) + time_offset * input_step;
         const float* aux_input_ptr = nullptr;
@@ -1976,7 +2138,11 @@ TfLiteStatus EvalFloat(
             forget_gate_scratch_ptr, cell_gate_scratch_ptr,
             output_gate_scratch_ptr, accumulation_scratch_buffer, output_ptr,
             recurrent_to_input_is_diag, recurrent_to_forget_is_diag,
-            recurrent_to_cell_is_diag, recurrent_to_output_is_diag, context);
+            recurrent_to_cell_is_diag, recurrent_to_output_is_diag, context,
+            product_at(input_to_input_product, product_offset),
+            product_at(input_to_forget_product, product_offset),
+            product_at(input_to_cell_product, product_offset),
+            product_at(input_to_output_product, product_offset));
       }
     }
   }
@@ -2305,7 +2471,8 @@ TfLiteStatus EvalInteger8x8_16(
     TfLiteTensor* output_state, TfLiteTensor* cell_state, TfLiteTensor* output,
     TfLiteTensor* scratch0, TfLiteTensor* scratch1, TfLiteTensor* scratch2,
     TfLiteTensor* scratch3, TfLiteTensor* scratch4, TfLiteTensor* scratch5,
-    CpuBackendContext* context) {
+    CpuBackendContext* context, TfLiteTensor* input_products,
+    TfLiteTensor* input_products_scratch) {
   TF_LITE_ASSERT(input->dims->size >= 2 && input->dims->size <= 3);
   const int n_input = input->dims->data[input->dims->size - 1];
   int max_time, n_batch;
@@ -2324,6 +2491,62 @@ TfLiteStatus EvalInteger8x8_16(
   // Activation zero point
   int output_state_zp = output_state->params.zero_point;
 
+  // Index the input products pointers, one block of 'block_rows' input
+  // vectors per gate, if they are computed ahead.
+  const bool use_cifg = (input_to_input_weights == nullptr);
+  int block_rows = 0;
+  int16_t* input_to_input_product = nullptr;
+  int16_t* input_to_forget_product = nullptr;
+  int16_t* input_to_cell_product = nullptr;
+  int16_t* input_to_output_product = nullptr;
+  if (input_products != nullptr) {
+    block_rows = input_products->dims->data[1];
+    TF_LITE_ASSERT(block_rows >= n_batch);
+    const int gate_size = block_rows * n_cell;
+    int16_t* input_products_ptr = GetTensorData<int16_t>(input_products);
+    if (!use_cifg) {
+      input_to_input_product = input_products_ptr;
+      input_products_ptr += gate_size;
+    }
+    input_to_forget_product = input_products_ptr;
+    input_to_cell_product = input_products_ptr + gate_size;
+    input_to_output_product = input_products_ptr + 2 * gate_size;
+  }
+  // Computes the input products of 'n_rows' consecutive input vectors.
+  auto calculate_input_products = [&](const int8_t* input_ptr, int n_rows) {
+    ruy::profiler::ScopeLabel label("LstmInputToGateInteger8x8_16");
+    int32_t* scratch = GetTensorData<int32_t>(input_products_scratch);
+    if (!use_cifg) {
+      CalculateLstmInputToGateInteger8x8_16(
+          input_ptr, GetTensorData<int8_t>(input_to_input_weights),
+          integer_lstm_param->input_to_input_effective_bias.get(),
+          integer_lstm_param->effective_input_to_input_scale_a,
+          integer_lstm_param->effective_input_to_input_scale_b, n_rows,
+          n_input, n_cell, input_to_input_product, scratch, context);
+    }
+    CalculateLstmInputToGateInteger8x8_16(
+        input_ptr, GetTensorData<int8_t>(input_to_forget_weights),
+        integer_lstm_param->input_to_forget_effective_bias.get(),
+        integer_lstm_param->effective_input_to_forget_scale_a,
+        integer_lstm_param->effective_input_to_forget_scale_b, n_rows, n_input,
+        n_cell, input_to_forget_product, scratch, context);
+    CalculateLstmInputToGateInteger8x8_16(
+        input_ptr, GetTensorData<int8_t>(input_to_cell_weights),
+        integer_lstm_param->input_to_cell_effective_bias.get(),
+        integer_lstm_param->effective_input_to_cell_scale_a,
+        integer_lstm_param->effective_input_to_cell_scale_b, n_rows, n_input,
+        n_cell, input_to_cell_product, scratch, context);
+    CalculateLstmInputToGateInteger8x8_16(
+        input_ptr, GetTensorData<int8_t>(input_to_output_weights),
+        integer_lstm_param->input_to_output_effective_bias.get(),
+        integer_lstm_param->effective_input_to_output_scale_a,
+        integer_lstm_param->effective_input_to_output_scale_b, n_rows, n_input,
+        n_cell, input_to_output_product, scratch, context);
+  };
+  auto product_at = [](const int16_t* product, int offset) {
+    return product == nullptr ? nullptr : product + offset;
+  };
+
   // Get params for time/batch/sequence.
   const int output_batch_leading_dim =
       output->dims->data[output->dims->size - 1];
@@ -2331,8 +2554,18 @@ TfLiteStatus EvalInteger8x8_16(
   if (time_major) {
     const int input_step = n_batch * n_input;
     const int output_step = n_batch * output_batch_leading_dim;
+    const int block_steps = block_rows / n_batch;
     for (int t = 0; t < max_time; t++) {
       const int t_rel = t;
+      int product_offset = 0;
+      if (block_steps > 0) {
+        if (t % block_steps == 0) {
+          calculate_input_products(
+              GetTensorData<int8_t>(input) + t * input_step,
+              std::min(block_steps, max_time - t) * n_batch);
+        }
+        product_offset = (t % block_steps) * n_batch * n_cell;
+      }
       int8_t* output_ptr = GetTensorData<int8_t>(output) + t_rel * output_step;
       const int8_t* input_ptr =
           GetTensorData<int8_t>(input) + t_rel * input_step;
@@ -2413,17 +2646,34 @@ TfLiteStatus EvalInteger8x8_16(
           GetTensorData<int16_t>(scratch0), GetTensorData<int16_t>(scratch1),
           GetTensorData<int16_t>(scratch2), GetTensorData<int16_t>(scratch3),
           GetTensorData<int8_t>(scratch4), GetTensorData<int32_t>(scratch5),
-          context);
+          context, product_at(input_to_input_product, product_offset),
+          product_at(input_to_forget_product, product_offset),
+          product_at(input_to_cell_product, product_offset),
+          product_at(input_to_output_product, product_offset));
     }
   } else {
     for (int b = 0; b < n_batch; b++) {
       const int input_step = n_input;
       const int output_step = output_batch_leading_dim;
+      // The first t_rel of the current block.
+      int block_begin = 0;
       for (int t = 0; t < max_time; t++) {
         // If this is the forward_sequence, step forward, otherwise step
         // backwards.
         const int t_rel = forward_sequence ? t : max_time - t - 1;
         const int time_offset = b * max_time + t_rel;
+        int product_offset = 0;
+        if (block_rows > 0) {
+          if (t % block_rows == 0) {
+            const int num_steps = std::min(block_rows, max_time - t);
+            block_begin = forward_sequence ? t : max_time - t - num_steps;
+            calculate_input_products(
+                GetTensorData<int8_t>(input) +
+                    (b * max_time + block_begin) * input_step,
+                num_steps);
+          }
+          product_offset = (t_rel - block_begin) * n_cell;
+        }
         const int8_t* input_ptr =
             GetTensorData<int8_t>(input) + time_offset * input_step;
         int8_t* output_ptr =
@@ -2511,7 +2761,11 @@ TfLiteStatus EvalInteger8x8_16(
             cell_state_ptr, output_ptr, GetTensorData<int16_t>(scratch0),
             GetTensorData<int16_t>(scratch1), GetTensorData<int16_t>(scratch2),
             GetTensorData<int16_t>(scratch3), GetTensorData<int8_t>(scratch4),
-            GetTensorData<int32_t>(scratch5), context);
+            GetTensorData<int32_t>(scratch5), context,
+            product_at(input_to_input_product, product_offset),
+            product_at(input_to_forget_product, product_offset),
+            product_at(input_to_cell_product, product_offset),
+            product_at(input_to_output_product, product_offset));
       }
     }
   }
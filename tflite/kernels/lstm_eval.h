@@ -95,6 +95,13 @@ struct IntegerLstmParameter {
   int32_t intermediate_zp[12];
 };
 
+// If input_products is set, the products of the input weights by the inputs
+// are computed with one matrix multiplication per gate for blocks of
+// consecutive time steps, instead of one matrix-vector product per gate and
+// time step, as the input, unlike the output state, does not depend on the
+// previous steps. It is a [num_gates, block_rows, n_cell] float tensor, where
+// num_gates is 3 with CIFG and 4 otherwise, and block_rows is at least n_batch.
+// It is not used with aux_input.
 TfLiteStatus EvalFloat(
     const TfLiteTensor* input, const TfLiteTensor* input_to_input_weights,
     const TfLiteTensor* input_to_forget_weights,
@@ -124,7 +131,7 @@ TfLiteStatus EvalFloat(
     TfLiteTensor* cell_state, TfLiteTensor* output,
     bool recurrent_to_input_is_diag, bool recurrent_to_forget_is_diag,
     bool recurrent_to_cell_is_diag, bool recurrent_to_output_is_diag,
-    CpuBackendContext* context);
+    CpuBackendContext* context, TfLiteTensor* input_products = nullptr);
 
 TfLiteStatus EvalHybrid(
     const TfLiteTensor* input, const TfLiteTensor* input_to_input_weights,
@@ -174,6 +181,8 @@ TfLiteStatus EvalHybrid(
     bool recurrent_to_forget_is_diag, bool recurrent_to_cell_is_diag,
     bool recurrent_to_output_is_diag, CpuBackendContext* context);
 
+// Same as EvalFloat for input_products, which is an int16 tensor here, with
+// input_products_scratch an int32 tensor of block_rows * n_cell elements.
 TfLiteStatus EvalInteger8x8_16(
     const TfLiteTensor* input, const TfLiteTensor* input_to_input_weights,
     const TfLiteTensor* input_to_forget_weights,
@@ -198,7 +207,8 @@ TfLiteStatus EvalInteger8x8_16(
     TfLiteTensor* output_state, TfLiteTensor* cell_state, TfLiteTensor* output,
     TfLiteTensor* scratch0, TfLiteTensor* scratch1, TfLiteTensor* scratch2,
     TfLiteTensor* scratch3, TfLiteTensor* scratch4, TfLiteTensor* scratch5,
-    CpuBackendContext* context);
+    CpuBackendContext* context, TfLiteTensor* input_products = nullptr,
+    TfLiteTensor* input_products_scratch = nullptr);
 
 TfLiteStatus EvalInteger8x8_8(
     const TfLiteTensor* input, const TfLiteTensor* input_to_input_weights,
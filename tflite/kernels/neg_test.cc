@@ -65,6 +65,19 @@ TEST(NegOpModel, NegFloat32) {
       Pointwise(FloatingPointEq(), {2.0f, 1.0f, 0.f, -1.0f, -2.0f, -3.0f}));
 }
 
+TEST(NegOpModel, NegFloat32Inplace) {
+  NegOpModel m({TensorType_FLOAT32, {2, 3}}, {TensorType_FLOAT32, {2, 3}});
+  m.SetInput<float>({-2.0f, -1.0f, 0.f, 1.0f, 2.0f, 3.0f});
+  const TfLiteTensor* input_tensor = m.GetInputTensor(0);
+  TfLiteTensor* output_tensor = m.GetOutputTensor(0);
+  output_tensor->data.data = input_tensor->data.data;
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(
+      m.GetOutput<float>(),
+      Pointwise(FloatingPointEq(), {2.0f, 1.0f, 0.f, -1.0f, -2.0f, -3.0f}));
+  EXPECT_EQ(output_tensor->data.data, input_tensor->data.data);
+}
+
 TEST(NegOpModel, NegFloat16) {
   NegOpModel m({TensorType_FLOAT16, {6}}, {TensorType_FLOAT16, {6}});
   m.SetInput<Eigen::half>({Eigen::half(-2.0f), Eigen::half(-1.0f),
@@ -19,6 +19,7 @@ limitations under the License.
 
 #include "absl/base/casts.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
 #include "tensorflow/core/example/example.pb.h"
 #include "tensorflow/core/example/feature.pb.h"
 #include "tensorflow/core/framework/allocator.h"
@@ -170,6 +171,17 @@ class Feature {
   tstring* construct_at_end(SmallVector<tstring>* bytes_list) {
     return &bytes_list->emplace_back();
   }
+  absl::string_view* construct_at_end(
+      LimitedArraySlice<absl::string_view>* bytes_list) {
+    if (bytes_list->EndDistance() <= 0) {
+      return nullptr;
+    }
+    return &bytes_list->construct_at_end();
+  }
+  absl::string_view* construct_at_end(
+      std::vector<absl::string_view>* bytes_list) {
+    return &bytes_list->emplace_back();
+  }
 
   template <typename Result>
   bool ParseBytesList(Result* bytes_list) {
@@ -198,6 +210,36 @@ class Feature {
     return true;
   }
 
+  // Same as ParseBytesList(), but stores views of the strings in the
+  // serialized feature instead of copies of them.
+  template <typename Result>
+  bool ParseBytesViewList(Result* bytes_list) {
+    DCHECK(bytes_list != nullptr);
+
+    protobuf::io::CodedInputStream stream(
+        reinterpret_cast<const uint8*>(serialized_.data()), serialized_.size());
+
+    EnableAliasing(&stream);
+
+    uint32 length;
+    if (!stream.ReadVarint32(&length)) return false;
+    auto limit = stream.PushLimit(length);
+
+    while (!stream.ExpectAtEnd()) {
+      if (!stream.ExpectTag(kDelimitedTag(1))) return false;
+      // parse string
+      uint32 bytes_length;
+      if (!stream.ReadVarint32(&bytes_length)) return false;
+      absl::string_view* bytes = construct_at_end(bytes_list);
+      if (bytes == nullptr) return false;
+      const int position = stream.CurrentPosition();
+      if (!stream.Skip(bytes_length)) return false;
+      *bytes = serialized_.substr(position, bytes_length);
+    }
+    stream.PopLimit(limit);
+    return true;
+  }
+
   template <typename Result>
   bool ParseFloatList(Result* float_list) {
     DCHECK(float_list != nullptr);
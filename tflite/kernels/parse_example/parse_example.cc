@@ -19,7 +19,7 @@ limitations under the License.
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
-#include <map>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -44,6 +44,8 @@ limitations under the License.
 #include "tensorflow/core/util/example_proto_fast_parsing.h"
 #include "tensorflow/core/util/presized_cuckoo_map.h"
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/cpu_backend_threadpool.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/kernel_util.h"
 #include "tflite/kernels/parse_example/example_proto_fast_parsing.h"
@@ -59,32 +61,84 @@ namespace {
 namespace tf = ::tensorflow;
 using tf::StringPiece;
 using tf::tstring;
-using tf::example::CopyOrMoveBlock;
 using tf::example::FastParseExampleConfig;
-using tf::example::GetListFromBuffer;
 using tf::example::LimitedArraySlice;
 using tf::example::ParseExample;
 using tf::example::SeededHasher;
-using tf::example::SmallVector;
-using tf::example::SparseBuffer;
 using tf::example::Type;
 using tf::example::parsed::Example;
 
 using ConfigIndex = tf::PresizedCuckooMap<std::pair<int32_t, Type>>;
 
+// Minimum number of examples parsed by each thread.
+constexpr int kMinExamplesPerShard = 16;
+
 struct TfLiteResult {
   std::vector<TfLiteTensor*> dense_values;
   std::vector<TfLiteTensor*> sparse_values;
   std::vector<TfLiteTensor*> sparse_indices;
   std::vector<TfLiteTensor*> sparse_shapes;
-  std::map<int, tf::Tensor> dense_tensors;
+};
+
+// Values of a sparse or variable length dense feature parsed from a shard of
+// the batch. The strings are views of the serialized examples or of the
+// default values, and are only copied once, into the output tensor.
+struct FeatureBuffer {
+  std::vector<absl::string_view> bytes_list;
+  std::vector<float> float_list;
+  std::vector<int64_t> int64_list;
+  std::vector<size_t> example_end_indices;
+
+  void Clear() {
+    bytes_list.clear();
+    float_list.clear();
+    int64_list.clear();
+    example_end_indices.clear();
+  }
+};
+
+template <typename T>
+const std::vector<T>& GetListFromBuffer(const FeatureBuffer& buffer);
+
+template <>
+const std::vector<int64_t>& GetListFromBuffer<int64_t>(
+    const FeatureBuffer& buffer) {
+  return buffer.int64_list;
+}
+
+template <>
+const std::vector<float>& GetListFromBuffer<float>(
+    const FeatureBuffer& buffer) {
+  return buffer.float_list;
+}
+
+// The state of the parsing of the examples [begin, end) of the batch.
+struct ShardBuffers {
+  size_t begin = 0;
+  size_t end = 0;
+  std::vector<FeatureBuffer> sparse;
+  std::vector<FeatureBuffer> varlen_dense;
+  Example parsed_example;
+  std::vector<int64_t> dense_feature_last_example;
+  std::vector<int64_t> sparse_feature_last_example;
+  absl::Status status;
+};
+
+// Buffers of the op kept across invocations, so that they only allocate when
+// the batch or its features grow.
+struct ParseArena {
+  std::vector<ShardBuffers> shards;
+  // Views of the fixed length dense string features, by dense feature.
+  std::vector<std::vector<absl::string_view>> dense_strings;
+  // Views of the strings being written to a sparse values tensor.
+  std::vector<absl::string_view> strings;
 };
 
 template <typename T>
 void FillAndCopyVarLen(const int d, const size_t num_elements,
                        const size_t num_elements_per_minibatch,
                        const FastParseExampleConfig& config,
-                       std::vector<SparseBuffer>& varlen_dense_buffers,
+                       absl::Span<const ShardBuffers> shards,
                        TfLiteTensor* values) {
   const tf::Tensor& default_value = config.dense[d].default_value;
 
@@ -93,29 +147,33 @@ void FillAndCopyVarLen(const int d, const size_t num_elements,
             reinterpret_cast<T*>(values->data.raw) + num_elements,
             default_value.flat<T>()(0));
 
-  auto data = reinterpret_cast<T*>(values->data.raw);
-
-  const SparseBuffer& buffer = varlen_dense_buffers[d];
-  // Number of examples being stored in this buffer
-  const auto& end_indices = buffer.example_end_indices;
-  const size_t examples_in_buffer = end_indices.size();
-
-  const auto& list = GetListFromBuffer<T>(buffer);
-  auto list_ptr = list.begin();
-
-  size_t elements_tally = 0;
-  // Iterate through all the examples stored in this buffer.
-  for (size_t j = 0; j < examples_in_buffer; ++j) {
-    // Number of elements stored for this example.
-    const size_t num_elems = end_indices[j] - elements_tally;
-    CopyOrMoveBlock(list_ptr, list_ptr + num_elems, data);
-    // Move forward this many elements in the varlen buffer.
-    list_ptr += num_elems;
-    // Move forward to the next minibatch entry in the values output.
-    data += num_elements_per_minibatch;
-    elements_tally = end_indices[j];
+  for (const ShardBuffers& shard : shards) {
+    auto data = reinterpret_cast<T*>(values->data.raw) +
+                shard.begin * num_elements_per_minibatch;
+
+    const FeatureBuffer& buffer = shard.varlen_dense[d];
+    // Number of examples being stored in this buffer
+    const auto& end_indices = buffer.example_end_indices;
+    const size_t examples_in_buffer = end_indices.size();
+
+    const auto& list = GetListFromBuffer<T>(buffer);
+    auto list_ptr = list.begin();
+
+    size_t elements_tally = 0;
+    // Iterate through all the examples stored in this buffer.
+    for (size_t j = 0; j < examples_in_buffer; ++j) {
+      // Number of elements stored for this example.
+      const size_t num_elems = end_indices[j] - elements_tally;
+      std::copy_n(list_ptr, std::min(num_elems, num_elements_per_minibatch),
+                  data);
+      // Move forward this many elements in the varlen buffer.
+      list_ptr += num_elems;
+      // Move forward to the next minibatch entry in the values output.
+      data += num_elements_per_minibatch;
+      elements_tally = end_indices[j];
+    }
+    DCHECK(elements_tally == list.size());
   }
-  DCHECK(elements_tally == list.size());
 }
 
 bool ParseExample(StringRef serialized, Example* example) {
@@ -129,19 +187,21 @@ bool ParseExample(StringRef serialized, Example* example) {
 absl::Status FastParseSerializedExample(
     StringRef serialized_example, const tstring& example_name,
     const size_t example_index, const FastParseExampleConfig& config,
-    bool* quick_filter, int quick_filter_size,
-    const std::unique_ptr<ConfigIndex>& config_index, int config_index_size,
-    SeededHasher* hasher, std::vector<TfLiteTensor*>* output_dense,
-    std::vector<SparseBuffer>* output_varlen_dense,
-    std::vector<SparseBuffer>* output_sparse,
-    std::map<absl::string_view, int>& stats, TfLiteResult* result) {
-  DCHECK(output_dense != nullptr);
-  tensorflow::example::parsed::Example parsed_example;
+    const bool* quick_filter, int quick_filter_size,
+    const ConfigIndex& config_index, const SeededHasher& hasher,
+    const std::vector<TfLiteTensor*>& output_dense,
+    std::vector<std::vector<absl::string_view>>* output_dense_strings,
+    ShardBuffers* shard) {
+  DCHECK(output_dense_strings != nullptr);
+  Example& parsed_example = shard->parsed_example;
+  parsed_example.clear();
   if (!ParseExample(serialized_example, &parsed_example)) {
     return tf::errors::Internal("Failed to parse example");
   }
-  std::vector<int64_t> dense_feature_last_example(config.dense.size(), -1);
-  std::vector<int64_t> sparse_feature_last_example(config.sparse.size(), -1);
+  std::vector<int64_t>& dense_feature_last_example =
+      shard->dense_feature_last_example;
+  std::vector<int64_t>& sparse_feature_last_example =
+      shard->sparse_feature_last_example;
   // Handle features present in the example.
   const size_t parsed_example_size = parsed_example.size();
   for (size_t i = 0; i < parsed_example_size; ++i) {
@@ -155,9 +215,9 @@ absl::Status FastParseSerializedExample(
         !quick_filter[feature_name.length()]) {
       continue;
     }
-    const uint64_t h = (*hasher)(feature_name);
+    const uint64_t h = hasher(feature_name);
     std::pair<int32_t, Type> d_and_type;
-    if (!config_index->Find(h, &d_and_type)) {
+    if (!config_index.Find(h, &d_and_type)) {
       continue;
     }
     size_t d = d_and_type.first;
@@ -189,7 +249,7 @@ absl::Status FastParseSerializedExample(
             " but expected type: ", DataTypeString(config.dense[d].dtype)));
       }
       if (!config.dense[d].variable_length) {
-        TfLiteTensor* out = (*output_dense)[d];
+        TfLiteTensor* out = output_dense[d];
 
         const std::size_t num_elements = config.dense[d].elements_per_stride;
         const std::size_t offset = example_index * num_elements;
@@ -223,10 +283,9 @@ absl::Status FastParseSerializedExample(
             break;
           }
           case tf::DT_STRING: {
-            auto& out_tensor = result->dense_tensors[d];
-            auto out_p = out_tensor.flat<tstring>().data() + offset;
-            LimitedArraySlice<tstring> slice(out_p, num_elements);
-            if (!feature.ParseBytesList(&slice)) return parse_error();
+            auto out_p = (*output_dense_strings)[d].data() + offset;
+            LimitedArraySlice<absl::string_view> slice(out_p, num_elements);
+            if (!feature.ParseBytesViewList(&slice)) return parse_error();
             if (slice.EndDistance() != 0) {
               return shape_error(num_elements - slice.EndDistance(), "bytes");
             }
@@ -237,7 +296,7 @@ absl::Status FastParseSerializedExample(
                                         config.dense[d].dtype);
         }
       } else {  // if dense variable length
-        SparseBuffer& out = (*output_varlen_dense)[d];
+        FeatureBuffer& out = shard->varlen_dense[d];
 
         const std::size_t num_elements = config.dense[d].elements_per_stride;
 
@@ -283,7 +342,7 @@ absl::Status FastParseSerializedExample(
           }
           case tf::DT_STRING: {
             if (example_dtype != tf::DT_INVALID) {
-              if (!feature.ParseBytesList(&out.bytes_list)) {
+              if (!feature.ParseBytesViewList(&out.bytes_list)) {
                 return parse_error();
               }
               if (out.bytes_list.size() % num_elements != 0) {
@@ -305,7 +364,7 @@ absl::Status FastParseSerializedExample(
         continue;
       }
       last_example[d] = example_index;
-      SparseBuffer& out = (*output_sparse)[d];
+      FeatureBuffer& out = shard->sparse[d];
       tf::DataType feature_dtype = config.sparse[d].dtype;
       if (example_dtype != tf::DT_INVALID && example_dtype != feature_dtype) {
         return tf::errors::Internal("Data types don't match:", example_dtype,
@@ -332,7 +391,7 @@ absl::Status FastParseSerializedExample(
         }
         case tf::DT_STRING: {
           if (example_dtype != tf::DT_INVALID) {
-            if (!feature.ParseBytesList(&out.bytes_list)) {
+            if (!feature.ParseBytesViewList(&out.bytes_list)) {
               return parse_error();
             }
           }
@@ -355,7 +414,7 @@ absl::Status FastParseSerializedExample(
           " is required but could not be found.");
     }
     const tf::Tensor& in = config.dense[d].default_value;
-    TfLiteTensor* out = result->dense_values[d];
+    TfLiteTensor* out = output_dense[d];
     const std::size_t num_elements = in.shape().num_elements();
     const std::size_t offset = example_index * num_elements;
     switch (config.dense[d].dtype) {
@@ -370,9 +429,11 @@ absl::Status FastParseSerializedExample(
         break;
       }
       case tf::DT_STRING: {
-        auto& out_tensor = result->dense_tensors[d];
-        std::copy_n(in.flat<tstring>().data(), num_elements,
-                    out_tensor.flat<tstring>().data() + offset);
+        const tstring* in_p = in.flat<tstring>().data();
+        absl::string_view* out_p = (*output_dense_strings)[d].data() + offset;
+        for (size_t k = 0; k < num_elements; ++k) {
+          out_p[k] = absl::string_view(in_p[k].data(), in_p[k].size());
+        }
         break;
       }
       default:
@@ -383,7 +444,7 @@ absl::Status FastParseSerializedExample(
   for (size_t d = 0; d < config.dense.size(); ++d) {
     if (!config.dense[d].variable_length) continue;
     if (dense_feature_last_example[d] == example_index) continue;
-    SparseBuffer& out = (*output_varlen_dense)[d];
+    FeatureBuffer& out = shard->varlen_dense[d];
     size_t prev_example_end_index =
         out.example_end_indices.empty() ? 0 : out.example_end_indices.back();
     out.example_end_indices.push_back(prev_example_end_index);
@@ -391,7 +452,7 @@ absl::Status FastParseSerializedExample(
 
   for (size_t d = 0; d < config.sparse.size(); ++d) {
     if (sparse_feature_last_example[d] == example_index) continue;
-    SparseBuffer& out = (*output_sparse)[d];
+    FeatureBuffer& out = shard->sparse[d];
     size_t prev_example_end_index =
         out.example_end_indices.empty() ? 0 : out.example_end_indices.back();
     out.example_end_indices.push_back(prev_example_end_index);
@@ -400,103 +461,146 @@ absl::Status FastParseSerializedExample(
   return absl::OkStatus();
 }
 
-void CountSparseFeatures(const SparseBuffer& sparse_buffer,
+void CountSparseFeatures(const FeatureBuffer& sparse_buffer,
                          size_t* total_num_features, size_t* max_num_features) {
   const std::vector<size_t>& end_indices = sparse_buffer.example_end_indices;
-  *total_num_features += end_indices.back();
-  *max_num_features = std::max(*max_num_features, end_indices[0]);
-  for (size_t i = 1; i < end_indices.size(); ++i) {
-    size_t example_size = end_indices[i] - end_indices[i - 1];
-    *max_num_features = std::max(*max_num_features, example_size);
+  size_t prev_end_index = 0;
+  for (size_t end_index : end_indices) {
+    *max_num_features = std::max(*max_num_features, end_index - prev_end_index);
+    prev_end_index = end_index;
   }
+  *total_num_features += prev_end_index;
 }
 
-void CopySparseBufferToTensor(tf::DataType dtype, size_t offset,
-                              SparseBuffer* src, TfLiteTensor* dst) {
-  switch (dtype) {
-    case tf::DT_INT64: {
-      std::copy(src->int64_list.begin(), src->int64_list.end(),
-                reinterpret_cast<int64_t*>(dst->data.raw) + offset);
-      break;
-    }
-    case tf::DT_FLOAT: {
-      std::copy(src->float_list.begin(), src->float_list.end(),
-                reinterpret_cast<float*>(dst->data.raw) + offset);
-      break;
-    }
-    case tf::DT_STRING: {
-      DynamicBuffer buffer;
-      for (auto* begin = src->bytes_list.begin();
-           begin != src->bytes_list.end(); begin++) {
-        buffer.AddString(begin->c_str(), begin->size());
-      }
-      buffer.WriteToTensor(dst, nullptr);
-      break;
-    }
-    default:
-      DCHECK(false) << "Encountered unexpected DataType "
-                    << DataTypeString(dtype)
-                    << "in variable that should have been checked.";
+// Writes `strings`, padded with empty strings up to `num_strings` strings, to
+// the dynamic string tensor `tensor`, without any intermediate copy.
+absl::Status WriteStringsToTensor(absl::Span<const absl::string_view> strings,
+                                  size_t num_strings, TfLiteTensor* tensor) {
+  DCHECK_LE(strings.size(), num_strings);
+  size_t total_size = 0;
+  for (absl::string_view s : strings) {
+    total_size += s.size();
   }
-}
-
-inline void CopyToBuffer(absl::Span<const tstring> vec, char* tensor_buffer,
-                         int num_examples, int batch_size,
-                         int elements_per_stride) {
-  int i = 0, k = 0;
-  int start = 0;
-  for (; i < num_examples; ++i) {
-    for (int j = 0; j < elements_per_stride; ++j) {
-      memcpy(tensor_buffer + start, vec[k].c_str(), vec[k].size());
-      start += vec[k].size();
-      k++;
-    }
+  const size_t start = sizeof(int32_t) * (num_strings + 2);
+  const size_t required_bytes = start + total_size;
+  if (required_bytes > std::numeric_limits<int32_t>::max()) {
+    return tf::errors::Internal("String tensor of ", required_bytes,
+                                " bytes is too large.");
   }
-  // Will happen if the number of examples is less than the desired batch size.
-  for (; i < batch_size; ++i) {
-    for (int j = 0; j < elements_per_stride; ++j) {
-      memcpy(tensor_buffer + start, vec[k].c_str(), vec[k].size());
-      start += vec[k].size();
-      k++;
+  if (TfLiteTensorResizeMaybeCopy(required_bytes, tensor,
+                                  /*preserve_data=*/false) != kTfLiteOk ||
+      tensor->data.raw == nullptr) {
+    return tf::errors::Internal("Failed to allocate the string tensor.");
+  }
+  char* tensor_buffer = tensor->data.raw;
+  const int32_t count = num_strings;
+  memcpy(tensor_buffer, &count, sizeof(int32_t));
+  int32_t offset = start;
+  for (size_t i = 0; i < num_strings; ++i) {
+    memcpy(tensor_buffer + sizeof(int32_t) * (i + 1), &offset,
+           sizeof(int32_t));
+    if (i < strings.size() && !strings[i].empty()) {
+      memcpy(tensor_buffer + offset, strings[i].data(), strings[i].size());
+      offset += strings[i].size();
     }
   }
+  memcpy(tensor_buffer + sizeof(int32_t) * (num_strings + 1), &offset,
+         sizeof(int32_t));
+  return absl::OkStatus();
 }
 
+// Runs `parse` on the buffers of a shard of the batch.
+template <typename ParseFn>
+struct ParseShardTask : cpu_backend_threadpool::Task {
+  ParseShardTask(const ParseFn& parse, ShardBuffers* shard)
+      : parse(parse), shard(shard) {}
+
+  void Run() override { parse(shard); }
+
+  const ParseFn& parse;
+  ShardBuffers* shard;
+};
+
 absl::Status FastParseExampleLite(
     const FastParseExampleConfig& config, const TfLiteTensor* serialized,
-    absl::Span<const tstring> example_names, bool* quick_filter,
+    absl::Span<const tstring> example_names, const bool* quick_filter,
     int quick_filter_size, const std::unique_ptr<ConfigIndex>& config_index,
-    int config_index_size, SeededHasher* hasher, TfLiteResult* result,
-    std::map<absl::string_view, int>& stats, TfLiteContext* context) {
+    const SeededHasher& hasher, TfLiteResult* result, ParseArena* arena,
+    CpuBackendContext* cpu_backend_context, TfLiteContext* context) {
   if (result == nullptr) {
     return tf::errors::Internal("Result is null");
   }
   const int count = GetStringCount(serialized);
-  std::vector<tf::Tensor> fixed_dense_values(config.dense.size());
-  std::vector<SparseBuffer> sparse_buffers(config.sparse.size());
-  std::vector<SparseBuffer> varlen_dense_buffers(config.dense.size());
-  absl::Status status_of_minibatch;
-  for (size_t e = 0; e < count; ++e) {
-    status_of_minibatch = FastParseSerializedExample(
-        GetString(serialized, e),
-        (!example_names.empty() ? example_names[e] : "<unknown>"), e, config,
-        quick_filter, quick_filter_size, config_index, config_index_size,
-        hasher, &result->dense_values, &varlen_dense_buffers, &sparse_buffers,
-        /*arena,*/ stats, result);
-    if (!status_of_minibatch.ok()) break;
+
+  // The fixed length dense string features are parsed as views, which are
+  // written to their tensor once the whole batch is parsed.
+  arena->dense_strings.resize(config.dense.size());
+  for (size_t d = 0; d < config.dense.size(); ++d) {
+    if (!config.dense[d].variable_length &&
+        config.dense[d].dtype == tf::DT_STRING) {
+      arena->dense_strings[d].resize(count *
+                                     config.dense[d].elements_per_stride);
+    }
+  }
+
+  // Split the batch in contiguous shards of examples. The fixed length dense
+  // features of every example are written in place, the other features are
+  // buffered by shard and merged in the order of the examples.
+  const int num_shards = std::max(
+      1, std::min(cpu_backend_context->max_num_threads(),
+                  (count + kMinExamplesPerShard - 1) / kMinExamplesPerShard));
+  if (arena->shards.size() < static_cast<size_t>(num_shards)) {
+    arena->shards.resize(num_shards);
+  }
+  absl::Span<ShardBuffers> shards(arena->shards.data(), num_shards);
+  for (int s = 0; s < num_shards; ++s) {
+    ShardBuffers& shard = shards[s];
+    shard.begin = static_cast<size_t>(count) * s / num_shards;
+    shard.end = static_cast<size_t>(count) * (s + 1) / num_shards;
+    shard.sparse.resize(config.sparse.size());
+    for (FeatureBuffer& buffer : shard.sparse) buffer.Clear();
+    shard.varlen_dense.resize(config.dense.size());
+    for (FeatureBuffer& buffer : shard.varlen_dense) buffer.Clear();
+    shard.dense_feature_last_example.assign(config.dense.size(), -1);
+    shard.sparse_feature_last_example.assign(config.sparse.size(), -1);
+  }
+
+  auto parse_shard = [&](ShardBuffers* shard) {
+    for (size_t e = shard->begin; e < shard->end; ++e) {
+      shard->status = FastParseSerializedExample(
+          GetString(serialized, e),
+          (!example_names.empty() ? example_names[e] : "<unknown>"), e, config,
+          quick_filter, quick_filter_size, *config_index, hasher,
+          result->dense_values, &arena->dense_strings, shard);
+      if (!shard->status.ok()) break;
+    }
+  };
+  if (num_shards == 1) {
+    parse_shard(&shards[0]);
+  } else {
+    std::vector<ParseShardTask<decltype(parse_shard)>> tasks;
+    tasks.reserve(num_shards);
+    for (ShardBuffers& shard : shards) {
+      tasks.emplace_back(parse_shard, &shard);
+    }
+    cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                    cpu_backend_context);
   }
-  if (!status_of_minibatch.ok()) {
-    return status_of_minibatch;
+  // Report the error of the first example that failed to parse.
+  for (const ShardBuffers& shard : shards) {
+    if (!shard.status.ok()) {
+      return shard.status;
+    }
   }
-  // Merge SparseBuffers from all minibatches for every config.sparse.
-  // auto MergeSparseMinibatches = [&](size_t d) {
-  // Loop over minibatches
+
+  // Merge the sparse features of all shards for every config.sparse.
   for (size_t d = 0; d < config.sparse.size(); ++d) {
     size_t total_num_features = 0;
     size_t max_num_features = 0;
-    CountSparseFeatures(sparse_buffers[d], &total_num_features,
-                        &max_num_features);
-    tf::TensorShape indices_shape;
+    for (const ShardBuffers& shard : shards) {
+      CountSparseFeatures(shard.sparse[d], &total_num_features,
+                          &max_num_features);
+    }
     TfLiteTensor* indices = result->sparse_indices[d];
     TfLiteTensor* values = result->sparse_values[d];
 
@@ -513,69 +617,87 @@ absl::Status FastParseExampleLite(
     output_shape->data[0] = total_num_features;
     context->ResizeTensor(context, values, output_shape);
 
-    SparseBuffer& buffer = sparse_buffers[d];
-
     // Update indices.
     auto* indices_p = reinterpret_cast<int64_t*>(indices->data.raw);
     if (!indices_p) {
       return tf::errors::Internal("Indices tensor not allocated!");
     }
 
-    if (total_num_features > 0) {
-      int64_t* ix_p = indices_p;
-      size_t example_index = 0;
-      int idx0 = 0;
+    if (total_num_features == 0) {
+      continue;
+    }
+    int64_t* ix_p = indices_p;
+    for (const ShardBuffers& shard : shards) {
+      size_t example_index = shard.begin;
       size_t delta = 0;
-      for (size_t example_end_index : buffer.example_end_indices) {
+      for (size_t example_end_index : shard.sparse[d].example_end_indices) {
         size_t feature_index = 0;
         for (; delta < example_end_index; ++delta) {
           // Column 0: example index
-          if (idx0 < total_num_features) {
-            *ix_p = example_index;
-            // Column 1: the feature index buffer example
-            *(ix_p + 1) = feature_index;
-            ix_p += 2;
-          }
+          *ix_p = example_index;
+          // Column 1: the feature index buffer example
+          *(ix_p + 1) = feature_index;
+          ix_p += 2;
           ++feature_index;
-          ++idx0;
         }
         ++example_index;
       }
-      CopySparseBufferToTensor(config.sparse[d].dtype, 0, &buffer, values);
+    }
+
+    switch (config.sparse[d].dtype) {
+      case tf::DT_INT64: {
+        auto* values_p = reinterpret_cast<int64_t*>(values->data.raw);
+        for (const ShardBuffers& shard : shards) {
+          values_p = std::copy(shard.sparse[d].int64_list.begin(),
+                               shard.sparse[d].int64_list.end(), values_p);
+        }
+        break;
+      }
+      case tf::DT_FLOAT: {
+        auto* values_p = reinterpret_cast<float*>(values->data.raw);
+        for (const ShardBuffers& shard : shards) {
+          values_p = std::copy(shard.sparse[d].float_list.begin(),
+                               shard.sparse[d].float_list.end(), values_p);
+        }
+        break;
+      }
+      case tf::DT_STRING: {
+        arena->strings.clear();
+        for (const ShardBuffers& shard : shards) {
+          arena->strings.insert(arena->strings.end(),
+                                shard.sparse[d].bytes_list.begin(),
+                                shard.sparse[d].bytes_list.end());
+        }
+        TF_RETURN_IF_ERROR(WriteStringsToTensor(
+            arena->strings, arena->strings.size(), values));
+        break;
+      }
+      default:
+        DCHECK(false) << "Encountered unexpected DataType "
+                      << DataTypeString(config.sparse[d].dtype)
+                      << "in variable that should have been checked.";
     }
   }
 
-  // Merge SparseBuffers from all minibatches for every config.dense having
+  // Merge the features of all shards for every config.dense having
   // variable_length.
   for (size_t d = 0; d < config.dense.size(); ++d) {
     if (!config.dense[d].variable_length) {
       continue;
     }
+    size_t total_num_features = 0;
     size_t max_num_features = 0;
-    std::vector<size_t>& end_indices =
-        varlen_dense_buffers[d].example_end_indices;
-    max_num_features = std::max(max_num_features, end_indices[0]);
-    for (size_t i = 1; i < end_indices.size(); ++i) {
-      size_t example_size = end_indices[i] - end_indices[i - 1];
-      max_num_features = std::max(max_num_features, example_size);
+    for (const ShardBuffers& shard : shards) {
+      CountSparseFeatures(shard.varlen_dense[d], &total_num_features,
+                          &max_num_features);
     }
-
-    const size_t stride_size = config.dense[d].elements_per_stride;
-    const size_t max_num_elements = max_num_features / stride_size;
-    tf::TensorShape values_shape;
     DCHECK_EQ(max_num_features % config.dense[d].elements_per_stride, 0);
-    const size_t batch_size = GetStringCount(serialized);
-    TF_RETURN_IF_ERROR(values_shape.AddDimWithStatus(batch_size));
-    TF_RETURN_IF_ERROR(values_shape.AddDimWithStatus(max_num_elements));
-    for (int i = 1; i < config.dense[d].shape.dims(); ++i) {
-      TF_RETURN_IF_ERROR(
-          values_shape.AddDimWithStatus(config.dense[d].shape.dim_size(i)));
-    }
+    const size_t batch_size = count;
     TfLiteTensor* values = result->dense_values[d];
     const size_t num_elements = GetTensorShape(values).FlatSize();
 
     // Nothing to write, exit early.
-    if (num_elements == 0) {
+    if (num_elements == 0 || batch_size == 0) {
       continue;
     }
 
@@ -583,12 +705,12 @@ absl::Status FastParseExampleLite(
     switch (config.dense[d].dtype) {
       case tf::DT_INT64: {
         FillAndCopyVarLen<int64_t>(d, num_elements, num_elements_per_minibatch,
-                                   config, varlen_dense_buffers, values);
+                                   config, shards, values);
         break;
       }
       case tf::DT_FLOAT: {
         FillAndCopyVarLen<float>(d, num_elements, num_elements_per_minibatch,
-                                 config, varlen_dense_buffers, values);
+                                 config, shards, values);
         break;
       }
       default:
@@ -598,54 +720,20 @@ absl::Status FastParseExampleLite(
     }
   }
 
-  // Merge tflite string buffers if necessary.
+  // Write the fixed length dense string features to their tensors.
   for (size_t d = 0; d < config.dense.size(); ++d) {
     if (config.dense[d].variable_length) {
       continue;
     }
     if (result->dense_values[d]->type == kTfLiteString) {
-      auto& in = result->dense_tensors[d];
-      auto vec = in.vec<tstring>();
       const int batch_size = result->dense_values[d]->dims->data[0];
-      const int elements_per_stride = config.dense[d].elements_per_stride;
-      int total_size = 0;
-      std::vector<int32_t> offsets;
-      offsets.reserve(vec.size() + 1);
-      offsets.push_back(0);
-      int k = 0;
-      for (int i = 0; i < batch_size; ++i) {
-        for (int j = 0; j < elements_per_stride; ++j) {
-          if (i < count) {
-            total_size += vec(k++).size();
-            offsets.push_back(total_size);
-          } else {
-            offsets.push_back(total_size);
-          }
-        }
-      }
-      const int32_t num_strings = offsets.size() - 1;
-      const size_t required_bytes = sizeof(int32_t) * (num_strings + 2) +
-          total_size;
-      char* tensor_buffer =
-          reinterpret_cast<char*>(result->dense_values[d]->data.raw);
-      if (result->dense_values[d]->bytes < required_bytes) {
-        if (result->dense_values[d]->data.raw) {
-          free(result->dense_values[d]->data.raw);
-        }
-        tensor_buffer = reinterpret_cast<char*>(malloc(required_bytes));
-        result->dense_values[d]->data.raw = tensor_buffer;
-        result->dense_values[d]->bytes = required_bytes;
-      }
-      const int32_t start = sizeof(int32_t) * (num_strings + 2);
-      memcpy(tensor_buffer, &num_strings, sizeof(int32_t));
-      for (size_t i = 0; i < offsets.size(); i++) {
-        int32_t offset_i = start + offsets[i];
-        memcpy(tensor_buffer + sizeof(int32_t) * (i + 1), &offset_i,
-               sizeof(int32_t));
-      }
-      absl::Span<const tstring> slice(vec.data(), vec.size());
-      CopyToBuffer(slice, tensor_buffer + start, count, batch_size,
-                   elements_per_stride);
+      const size_t num_strings =
+          static_cast<size_t>(batch_size) * config.dense[d].elements_per_stride;
+      const std::vector<absl::string_view>& strings = arena->dense_strings[d];
+      TF_RETURN_IF_ERROR(WriteStringsToTensor(
+          absl::MakeConstSpan(strings.data(),
+                              std::min(strings.size(), num_strings)),
+          num_strings, result->dense_values[d]));
     }
   }
   return absl::OkStatus();
@@ -670,6 +758,7 @@ struct OpData {
   int config_index_size;
   SeededHasher hasher;
   TfLiteResult got;
+  ParseArena arena;
   bool* quick_filter = nullptr;
   int quick_filter_size;
   bool created = false;
@@ -908,16 +997,6 @@ TfLiteStatus EvalParseExample(TfLiteContext* context, TfLiteNode* node) {
     for (int i = 0; i < data->dense_size; i++) {
       auto* parse_output = GetOutput(context, node, i + offset);
       data->got.dense_values.push_back(parse_output);
-      if (parse_output->type == kTfLiteString) {
-        tf::TensorShape shape;
-        if (parse_output->dims->size == 1) {
-          shape.AddDim(parse_output->dims->data[0]);
-        } else {
-          shape.AddDim(GetTensorShape(parse_output).FlatSize());
-        }
-        data->got.dense_tensors[i] =
-            tf::Tensor(tf::DataTypeToEnum<tstring>::value, shape);
-      }
     }
 
     size_t config_size = data->config.dense.size();
@@ -976,11 +1055,10 @@ TfLiteStatus EvalParseExample(TfLiteContext* context, TfLiteNode* node) {
 
   const TfLiteTensor* serialized = GetInput(context, node, kExampleTensor);
 
-  std::map<absl::string_view, int> stats;
   const auto status = FastParseExampleLite(
       data->config, serialized, {}, data->quick_filter, data->quick_filter_size,
-      data->config_index, data->config_index_size, &data->hasher, &data->got,
-      stats, context);
+      data->config_index, data->hasher, &data->got, &data->arena,
+      CpuBackendContext::GetFromContext(context), context);
   if (!status.ok()) {
     TF_LITE_KERNEL_LOG(context, "%s", status.ToString().c_str());
     return kTfLiteError;
@@ -17,6 +17,7 @@ limitations under the License.
 #include <cstdint>
 #include <initializer_list>
 #include <string>
+#include <vector>
 
 #include "flatbuffers/flexbuffers.h"  // from @flatbuffers
 #include "tensorflow/core/example/feature_util.h"
@@ -190,7 +191,8 @@ class ParseExampleOpModel : public SingleOpModel {
                       std::initializer_list<DefaultType> dense_defaults,
                       std::vector<TensorType> dense_types,
                       std::vector<TensorType> sparse_types,
-                      const char* text_def, int dense_size = 2) {
+                      const char* text_def, int dense_size = 2,
+                      int num_threads = -1) {
     // Example
     const int input_size = serialized_examples.size();
     auto input_tensor_data = TensorData(TensorType_STRING, {input_size});
@@ -239,7 +241,9 @@ class ParseExampleOpModel : public SingleOpModel {
     fbb.Finish();
     const auto buffer = fbb.GetBuffer();
     SetCustomOp("ParseExample", buffer, Register_PARSE_EXAMPLE);
-    BuildInterpreter({{input_size}});
+    BuildInterpreter({{input_size}}, num_threads,
+                     /*allow_fp32_relax_to_fp16=*/false,
+                     /*apply_delegate=*/true);
     int idx = 0;
     PopulateStringTensor(string_indices_[idx++], serialized_examples);
     PopulateStringTensor(string_indices_[idx++], {""});
@@ -368,6 +372,35 @@ TEST(ParseExampleOpsTest, SparseBytesTest) {
               testing::ElementsAreArray({1, 2}));
 }
 
+TEST(ParseExampleOpsTest, ThreadedSparseBytesTest) {
+  const int num_examples = 100;
+  std::vector<std::string> inputs;
+  std::vector<int64_t> expected_indices;
+  std::vector<std::string> expected_values;
+  for (int i = 0; i < num_examples; ++i) {
+    tf::Example example;
+    std::vector<tensorflow::tstring> values;
+    for (int j = 0; j < i % 3; ++j) {
+      values.emplace_back("example" + std::to_string(i) + "_" +
+                          std::to_string(j));
+      expected_indices.insert(expected_indices.end(), {i, j});
+      expected_values.emplace_back(values.back());
+    }
+    tf::AppendFeatureValues<tensorflow::tstring>(values, "time", &example);
+    inputs.push_back(example.SerializeAsString());
+  }
+  ParseExampleOpModel<std::string> m(inputs, {"time"}, {}, {}, {},
+                                     {TensorType_STRING}, kNodeDefTxt4, 0,
+                                     /*num_threads=*/4);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetSparseIndicesOutput<int64_t>(0),
+              ElementsAreArray(expected_indices));
+  EXPECT_THAT(m.GetStringOutput(m.SparseValuesOutputs(0)),
+              ElementsAreArray(expected_values));
+  EXPECT_THAT(m.GetSparseShapesOutput<int64_t>(0),
+              testing::ElementsAreArray({num_examples, 2}));
+}
+
 TEST(ParseExampleOpsTest, ResizeTest) {
   const int num_tests = 3;
   std::vector<tf::Example> examples(num_tests);
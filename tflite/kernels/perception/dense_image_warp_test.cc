@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -34,14 +35,16 @@ using testing::ElementsAreArray;
 class DenseImageWarpOpModel : public SingleOpModel {
  public:
   DenseImageWarpOpModel(const TensorData& input, const TensorData& flow,
-                        const TensorData& output) {
+                        const TensorData& output, int num_threads = -1) {
     input_ = AddInput(input);
     flow_ = AddInput(flow);
     output_ = AddOutput(output);
 
     std::vector<uint8_t> custom_option;
     SetCustomOp("DenseImageWarp", custom_option, RegisterDenseImageWarp);
-    BuildInterpreter({GetShape(input_), GetShape(flow_)});
+    BuildInterpreter({GetShape(input_), GetShape(flow_)}, num_threads,
+                     /*allow_fp32_relax_to_fp16=*/false,
+                     /*apply_delegate=*/true);
   }
 
   void SetInput(const std::vector<float>& data) {
@@ -134,6 +137,37 @@ TEST(DenseImageWarpOpTest, WithBatchandChannelTest) {
                         49, 50, 48, 49, 50, 48, 49, 50, 48, 49, 50, 48, 49, 50,
                         57, 58, 59, 69, 70, 71, 48, 49, 50, 57, 58, 59}));
 }
+
+TEST(DenseImageWarpOpTest, ThreadedShiftTest) {
+  const int height = 128;
+  const int width = 128;
+  const int channels = 4;
+  DenseImageWarpOpModel model(
+      /*input=*/{TensorType_FLOAT32, {1, height, width, channels}},
+      /*flow=*/{TensorType_FLOAT32, {1, height, width, 2}},
+      /*output=*/{TensorType_FLOAT32, {}}, /*num_threads=*/4);
+
+  std::vector<float> input_data;
+  for (int i = 0; i < height * width * channels; ++i) input_data.push_back(i);
+  model.SetInput(input_data);
+  // Each pixel samples its top left neighbor, clamped to the image.
+  model.SetFlow(std::vector<float>(height * width * 2, 1));
+  ASSERT_EQ(model.Invoke(), kTfLiteOk);
+
+  std::vector<float> expected;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      for (int c = 0; c < channels; ++c) {
+        expected.push_back(input_data[(std::max(y - 1, 0) * width +
+                                       std::max(x - 1, 0)) *
+                                          channels +
+                                      c]);
+      }
+    }
+  }
+  EXPECT_THAT(model.GetOutput(), ElementsAreArray(expected));
+}
+
 }  // namespace
 }  // namespace custom
 }  // namespace ops
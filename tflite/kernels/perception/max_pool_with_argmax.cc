@@ -21,8 +21,10 @@ limitations under the License.
 #include "flatbuffers/flexbuffers.h"  // from @flatbuffers
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/kernels/internal/common.h"
 #include "tflite/kernels/internal/compatibility.h"
+#include "tflite/kernels/internal/optimized/gather.h"
 #include "tflite/kernels/internal/runtime_shape.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/internal/types.h"
@@ -36,10 +38,14 @@ namespace max_pool_with_argmax {
 namespace {
 // TODO(b/175003241): Move this logic to lite/kernels/internal when promoting
 // this op to a builtin op.
+// Computes the max and argmax of all the channels of an output pixel at once,
+// one contiguous run of channels of the pooling window at a time. The rows of
+// output pixels are split over the threads of `cpu_backend_context`.
 template <typename T>
 inline void MaxPool(const PoolParams& params, const RuntimeShape& input_shape,
                     const RuntimeShape& output_shape, const T* input_data,
-                    T* output_data, int32_t* indices_data) {
+                    T* output_data, int32_t* indices_data,
+                    CpuBackendContext* cpu_backend_context) {
   TFLITE_DCHECK_EQ(input_shape.DimensionsCount(), 4);
   TFLITE_DCHECK_EQ(output_shape.DimensionsCount(), 4);
 
@@ -51,25 +57,37 @@ inline void MaxPool(const PoolParams& params, const RuntimeShape& input_shape,
   const int32_t output_width = output_shape.Dims(2);
   const int32_t stride_height = params.stride_height;
   const int32_t stride_width = params.stride_width;
-  for (int32_t batch = 0; batch < batches; ++batch) {
-    for (int32_t out_y = 0; out_y < output_height; ++out_y) {
-      for (int32_t out_x = 0; out_x < output_width; ++out_x) {
-        for (int32_t channel = 0; channel < depth; ++channel) {
+  const int32_t output_row_size = output_width * depth;
+  const int64_t input_batch_size =
+      static_cast<int64_t>(input_height) * input_width * depth;
+  optimized_ops::gather_internal::ForEachRow(
+      batches * output_height,
+      output_row_size * params.filter_height * params.filter_width * sizeof(T),
+      cpu_backend_context, [&](int row) {
+        const int32_t batch = row / output_height;
+        const int32_t out_y = row % output_height;
+        const T* image = input_data + batch * input_batch_size;
+        const int32_t in_y_origin =
+            (out_y * stride_height) - params.padding_values.height;
+        // Compute the boundaries of the filter region clamped so as to
+        // ensure that the filter window fits in the input array.
+        const int32_t filter_y_start = std::max(0, -in_y_origin);
+        const int32_t filter_y_end =
+            std::min(params.filter_height, input_height - in_y_origin);
+        for (int32_t out_x = 0; out_x < output_width; ++out_x) {
           const int32_t in_x_origin =
               (out_x * stride_width) - params.padding_values.width;
-          const int32_t in_y_origin =
-              (out_y * stride_height) - params.padding_values.height;
-          // Compute the boundaries of the filter region clamped so as to
-          // ensure that the filter window fits in the input array.
           const int32_t filter_x_start = std::max(0, -in_x_origin);
           const int32_t filter_x_end =
               std::min(params.filter_width, input_width - in_x_origin);
-          const int32_t filter_y_start = std::max(0, -in_y_origin);
-          const int32_t filter_y_end =
-              std::min(params.filter_height, input_height - in_y_origin);
-          float max = std::numeric_limits<float>::lowest();
-          int32_t max_x = 0;
-          int32_t max_y = 0;
+          const int64_t output_offset =
+              static_cast<int64_t>(row) * output_row_size + out_x * depth;
+          T* max = output_data + output_offset;
+          int32_t* argmax = indices_data + output_offset;
+          for (int32_t channel = 0; channel < depth; ++channel) {
+            max[channel] = std::numeric_limits<T>::lowest();
+            argmax[channel] = channel;
+          }
 
           for (int32_t filter_y = filter_y_start; filter_y < filter_y_end;
                ++filter_y) {
@@ -77,25 +95,22 @@ inline void MaxPool(const PoolParams& params, const RuntimeShape& input_shape,
                  ++filter_x) {
               const int32_t in_x = in_x_origin + filter_x;
               const int32_t in_y = in_y_origin + filter_y;
-              float cur =
-                  input_data[Offset(input_shape, batch, in_y, in_x, channel)];
-              if (cur > max) {
-                max = cur;
-                max_x = in_x;
-                max_y = in_y;
+              const int32_t index = (in_y * input_width + in_x) * depth;
+              const T* cur = image + index;
+              for (int32_t channel = 0; channel < depth; ++channel) {
+                const bool is_max = cur[channel] > max[channel];
+                max[channel] = is_max ? cur[channel] : max[channel];
+                argmax[channel] = is_max ? index + channel : argmax[channel];
               }
             }
           }
-          int32_t output_idx =
-              Offset(output_shape, batch, out_y, out_x, channel);
-          output_data[output_idx] = ActivationFunctionWithMinMax(
-              max, params.float_activation_min, params.float_activation_max);
-          indices_data[output_idx] =
-              (max_y * input_width + max_x) * depth + channel;
+          for (int32_t channel = 0; channel < depth; ++channel) {
+            max[channel] = ActivationFunctionWithMinMax(
+                max[channel], params.float_activation_min,
+                params.float_activation_max);
+          }
         }
-      }
-    }
-  }
+      });
 }
 
 }  // namespace
@@ -233,7 +248,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
     case kTfLiteFloat32:
       MaxPool<float>(op_params, GetTensorShape(input), GetTensorShape(output),
                      GetTensorData<float>(input), GetTensorData<float>(output),
-                     GetTensorData<int32_t>(indices));
+                     GetTensorData<int32_t>(indices),
+                     CpuBackendContext::GetFromContext(context));
       break;
     default:
       TF_LITE_KERNEL_LOG(context, "Type %s not currently supported.",
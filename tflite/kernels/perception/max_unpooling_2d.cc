@@ -17,10 +17,14 @@ limitations under the License.
 
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/internal/compatibility.h"
+#include "tflite/kernels/internal/optimized/gather.h"
 #include "tflite/kernels/internal/runtime_shape.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/internal/types.h"
 #include "tflite/kernels/kernel_util.h"
+
 namespace tflite {
 namespace ops {
 namespace custom {
@@ -33,26 +37,31 @@ constexpr int kOutputTensor = 0;
 
 // TODO(b/175003241): Move this logic to lite/kernels/internal when promoting
 // this op to a builtin op.
+// The batches, whose indices only address their own output, are split over the
+// threads of `cpu_backend_context`.
 inline void MaxUnpooling(const RuntimeShape& input_shape,
                          const float* input_data, const int32_t* indices_data,
-                         const RuntimeShape& output_shape, float* output_data) {
+                         const RuntimeShape& output_shape, float* output_data,
+                         CpuBackendContext* cpu_backend_context) {
   std::memset(output_data, 0, output_shape.FlatSize() * sizeof(float));
   const int batches = MatchingDim(input_shape, 0, output_shape, 0);
-  const int depth = MatchingDim(input_shape, 3, output_shape, 3);
+  TFLITE_DCHECK_EQ(input_shape.Dims(3), output_shape.Dims(3));
+  const int input_batch_size = FlatSizeSkipDim(input_shape, 0);
   const int batch_stride =
       output_shape.Dims(1) * output_shape.Dims(2) * output_shape.Dims(3);
-  for (int batch = 0; batch < batches; ++batch) {
-    for (int in_y = 0; in_y < input_shape.Dims(1); ++in_y) {
-      for (int in_x = 0; in_x < input_shape.Dims(2); ++in_x) {
-        for (int channel = 0; channel < depth; ++channel) {
-          const auto input_offset =
-              Offset(input_shape, batch, in_y, in_x, channel);
-          int idx = indices_data[input_offset];
-          output_data[batch * batch_stride + idx] = input_data[input_offset];
+  optimized_ops::gather_internal::ForEachRow(
+      batches, input_batch_size * sizeof(float), cpu_backend_context,
+      [&](int batch) {
+        const int64_t input_offset =
+            static_cast<int64_t>(batch) * input_batch_size;
+        const float* input = input_data + input_offset;
+        const int32_t* indices = indices_data + input_offset;
+        float* output =
+            output_data + static_cast<int64_t>(batch) * batch_stride;
+        for (int i = 0; i < input_batch_size; ++i) {
+          output[indices[i]] = input[i];
         }
-      }
-    }
-  }
+      });
 }
 
 TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
@@ -117,7 +126,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 
   MaxUnpooling(GetTensorShape(input), GetTensorData<float>(input),
                GetTensorData<int32_t>(indices), GetTensorShape(output),
-               GetTensorData<float>(output));
+               GetTensorData<float>(output),
+               CpuBackendContext::GetFromContext(context));
   return kTfLiteOk;
 }
 
@@ -19,6 +19,7 @@ limitations under the License.
 #include <vector>
 
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/kernels/internal/optimized/optimized_ops.h"
 #include "tflite/kernels/internal/portable_tensor_utils.h"
 #include "tflite/kernels/internal/quantization_util.h"
@@ -62,13 +63,31 @@ static inline void AffineQuantize(const tflite::QuantizationParams& op_params,
                                   const RuntimeShape& input_shape,
                                   const float* input_data,
                                   const RuntimeShape& output_shape,
-                                  output_type* output_data) {
+                                  output_type* output_data,
+                                  CpuBackendContext* cpu_backend_context) {
   if (kernel_type == kReference) {
     reference_ops::AffineQuantize(op_params, input_shape, input_data,
                                   output_shape, output_data);
   } else {
     optimized_ops::AffineQuantize(op_params, input_shape, input_data,
-                                  output_shape, output_data);
+                                  output_shape, output_data,
+                                  cpu_backend_context);
+  }
+}
+
+template <KernelType kernel_type, typename output_type>
+static inline void PerChannelQuantize(
+    const tflite::PerChannelQuantizationParams& op_params,
+    const RuntimeShape& input_shape, const float* input_data,
+    const RuntimeShape& output_shape, output_type* output_data,
+    CpuBackendContext* cpu_backend_context) {
+  if (kernel_type == kReference) {
+    reference_ops::PerChannelQuantize(op_params, input_shape, input_data,
+                                      output_shape, output_data);
+  } else {
+    optimized_ops::PerChannelQuantize(op_params, input_shape, input_data,
+                                      output_shape, output_data,
+                                      cpu_backend_context);
   }
 }
 
@@ -77,7 +96,8 @@ static inline void Requantize(const input_type* input_data, int32_t size,
                               int32_t effective_scale_multiplier,
                               int32_t effective_scale_shift,
                               int32_t input_zeropoint, int32_t output_zeropoint,
-                              output_type* output_data) {
+                              output_type* output_data,
+                              CpuBackendContext* cpu_backend_context) {
   if (kernel_type == kReference) {
     reference_ops::Requantize(input_data, size, effective_scale_multiplier,
                               effective_scale_shift, input_zeropoint,
@@ -85,7 +105,8 @@ static inline void Requantize(const input_type* input_data, int32_t size,
   } else {
     optimized_ops::Requantize(input_data, size, effective_scale_multiplier,
                               effective_scale_shift, input_zeropoint,
-                              output_zeropoint, output_data);
+                              output_zeropoint, output_data,
+                              cpu_backend_context);
   }
 }
 
@@ -192,6 +213,9 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 
   const RuntimeShape input_shape = GetTensorShape(input);
   const RuntimeShape output_shape = GetTensorShape(output);
+  CpuBackendContext* cpu_backend_context =
+      kernel_type == kReference ? nullptr
+                                : CpuBackendContext::GetFromContext(context);
 
   switch (input->type) {
     case kTfLiteFloat32: {
@@ -220,19 +244,19 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 
         switch (output->type) {
           case kTfLiteInt8:
-            reference_ops::PerChannelQuantize(
+            PerChannelQuantize<kernel_type>(
                 per_channel_op_params, input_shape, input_data, output_shape,
-                GetTensorData<int8_t>(output));
+                GetTensorData<int8_t>(output), cpu_backend_context);
             return kTfLiteOk;
           case kTfLiteUInt8:
-            reference_ops::PerChannelQuantize(
+            PerChannelQuantize<kernel_type>(
                 per_channel_op_params, input_shape, input_data, output_shape,
-                GetTensorData<uint8_t>(output));
+                GetTensorData<uint8_t>(output), cpu_backend_context);
             return kTfLiteOk;
           case kTfLiteInt16:
-            reference_ops::PerChannelQuantize(
+            PerChannelQuantize<kernel_type>(
                 per_channel_op_params, input_shape, input_data, output_shape,
-                GetTensorData<int16_t>(output));
+                GetTensorData<int16_t>(output), cpu_backend_context);
             return kTfLiteOk;
           default:
             ReportError(context, input->type, output->type);
@@ -253,17 +277,20 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
           case kTfLiteInt8:
             AffineQuantize<kernel_type>(op_params, input_shape, input_data,
                                         output_shape,
-                                        GetTensorData<int8_t>(output));
+                                        GetTensorData<int8_t>(output),
+                                        cpu_backend_context);
             return kTfLiteOk;
           case kTfLiteUInt8:
             AffineQuantize<kernel_type>(op_params, input_shape, input_data,
                                         output_shape,
-                                        GetTensorData<uint8_t>(output));
+                                        GetTensorData<uint8_t>(output),
+                                        cpu_backend_context);
             return kTfLiteOk;
           case kTfLiteInt16:
             AffineQuantize<kernel_type>(op_params, input_shape, input_data,
                                         output_shape,
-                                        GetTensorData<int16_t>(output));
+                                        GetTensorData<int16_t>(output),
+                                        cpu_backend_context);
             return kTfLiteOk;
           default:
             ReportError(context, input->type, output->type);
@@ -283,7 +310,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
                                   data->output_multiplier, data->output_shift,
                                   input->params.zero_point,
                                   output->params.zero_point,
-                                  GetTensorData<int8_t>(output));
+                                  GetTensorData<int8_t>(output),
+                                  cpu_backend_context);
           return kTfLiteOk;
         case kTfLiteInt16:
           Requantize<kernel_type>(GetTensorData<int32_t>(input),
@@ -291,7 +319,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
                                   data->output_multiplier, data->output_shift,
                                   input->params.zero_point,
                                   output->params.zero_point,
-                                  GetTensorData<int16_t>(output));
+                                  GetTensorData<int16_t>(output),
+                                  cpu_backend_context);
           return kTfLiteOk;
         default:
           ReportError(context, input->type, output->type);
@@ -307,7 +336,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
                                   data->output_multiplier, data->output_shift,
                                   input->params.zero_point,
                                   output->params.zero_point,
-                                  GetTensorData<int8_t>(output));
+                                  GetTensorData<int8_t>(output),
+                                  cpu_backend_context);
           return kTfLiteOk;
         case kTfLiteInt16:
           Requantize<kernel_type>(GetTensorData<int16_t>(input),
@@ -315,7 +345,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
                                   data->output_multiplier, data->output_shift,
                                   input->params.zero_point,
                                   output->params.zero_point,
-                                  GetTensorData<int16_t>(output));
+                                  GetTensorData<int16_t>(output),
+                                  cpu_backend_context);
           return kTfLiteOk;
         case kTfLiteInt32:
           // This case is not supported by the converter or other TFLite tools.
@@ -326,7 +357,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
                                   data->output_multiplier, data->output_shift,
                                   input->params.zero_point,
                                   output->params.zero_point,
-                                  GetTensorData<int32_t>(output));
+                                  GetTensorData<int32_t>(output),
+                                  cpu_backend_context);
           return kTfLiteOk;
         default:
           ReportError(context, input->type, output->type);
@@ -342,13 +374,15 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
           Requantize<kernel_type>(input_data, size, data->output_multiplier,
                                   data->output_shift, input->params.zero_point,
                                   output->params.zero_point,
-                                  GetTensorData<int8_t>(output));
+                                  GetTensorData<int8_t>(output),
+                                  cpu_backend_context);
           return kTfLiteOk;
         case kTfLiteUInt8:
           Requantize<kernel_type>(input_data, size, data->output_multiplier,
                                   data->output_shift, input->params.zero_point,
                                   output->params.zero_point,
-                                  GetTensorData<uint8_t>(output));
+                                  GetTensorData<uint8_t>(output),
+                                  cpu_backend_context);
           return kTfLiteOk;
         default:
           ReportError(context, input->type, output->type);
@@ -364,13 +398,15 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
           Requantize<kernel_type>(input_data, size, data->output_multiplier,
                                   data->output_shift, input->params.zero_point,
                                   output->params.zero_point,
-                                  GetTensorData<int8_t>(output));
+                                  GetTensorData<int8_t>(output),
+                                  cpu_backend_context);
           return kTfLiteOk;
         case kTfLiteUInt8:
           Requantize<kernel_type>(input_data, size, data->output_multiplier,
                                   data->output_shift, input->params.zero_point,
                                   output->params.zero_point,
-                                  GetTensorData<uint8_t>(output));
+                                  GetTensorData<uint8_t>(output),
+                                  cpu_backend_context);
           return kTfLiteOk;
         default:
           ReportError(context, input->type, output->type);
@@ -13,9 +13,13 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
+#include <vector>
+
+#include "tflite/builtin_ops.h"
 #include "tflite/core/c/common.h"
 #include "tflite/core/subgraph.h"
 #include "tflite/experimental/resource/resource_variable.h"
@@ -30,6 +34,96 @@ namespace read_variable {
 constexpr int kInputVariableId = 0;
 constexpr int kOutputValue = 0;
 
+struct OpData {
+  // True if the output points to the buffer of the variable instead of
+  // holding a copy of it.
+  bool alias_output = false;
+};
+
+void* Init(TfLiteContext* context, const char* buffer, size_t length) {
+  return new OpData;
+}
+
+void Free(TfLiteContext* context, void* buffer) {
+  delete reinterpret_cast<OpData*>(buffer);
+}
+
+bool IsSubgraphOutput(const Subgraph& subgraph, int tensor_index) {
+  for (int output : subgraph.outputs()) {
+    if (output == tensor_index) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns true if the node may assign variables without being an
+// ASSIGN_VARIABLE node, e.g. by invoking other subgraphs.
+bool MayAssignVariablesIndirectly(const TfLiteRegistration& registration) {
+  switch (registration.builtin_code) {
+    case kTfLiteBuiltinAssignVariable:
+      return false;
+    case kTfLiteBuiltinCallOnce:
+    case kTfLiteBuiltinCustom:
+    case kTfLiteBuiltinDelegate:
+    case kTfLiteBuiltinIf:
+    case kTfLiteBuiltinStablehloCase:
+    case kTfLiteBuiltinStablehloComposite:
+    case kTfLiteBuiltinStablehloWhile:
+    case kTfLiteBuiltinWhile:
+      return true;
+    default:
+      return registration.registration_external != nullptr;
+  }
+}
+
+// Returns true if the output of `node` keeps its value while it's in use when
+// it points to the buffer of the variable. The variable keeps its previous
+// value in place until the next assignment, so at most one assignment may run
+// from the read to the last use of the output. Any ASSIGN_VARIABLE node counts,
+// whatever its variable, as resource ids are only known when they run, and
+// nodes which may assign variables in other subgraphs rule out the alias.
+bool CanAliasOutput(const Subgraph& subgraph, const TfLiteNode* node) {
+  const int output_index = node->outputs->data[kOutputValue];
+  if (IsSubgraphOutput(subgraph, output_index)) {
+    return false;
+  }
+  const std::vector<int>& execution_plan = subgraph.execution_plan();
+  auto it = execution_plan.begin();
+  while (it != execution_plan.end() &&
+         &subgraph.node_and_registration(*it)->first != node) {
+    ++it;
+  }
+  if (it == execution_plan.end()) {
+    return false;
+  }
+  // Find the last node which reads the output.
+  auto last_use = it;
+  for (auto other = it + 1; other != execution_plan.end(); ++other) {
+    const TfLiteIntArray* inputs =
+        subgraph.node_and_registration(*other)->first.inputs;
+    for (int i = 0; i < inputs->size; ++i) {
+      if (inputs->data[i] == output_index) {
+        last_use = other;
+        break;
+      }
+    }
+  }
+  int num_assignments = 0;
+  for (auto other = it + 1; other <= last_use; ++other) {
+    const TfLiteRegistration& registration =
+        subgraph.node_and_registration(*other)->second;
+    if (MayAssignVariablesIndirectly(registration)) {
+      return false;
+    }
+    if (registration.builtin_code == kTfLiteBuiltinAssignVariable &&
+        ++num_assignments > 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
 TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   TF_LITE_ENSURE_EQ(context, node->inputs->size, 1);
   TF_LITE_ENSURE_EQ(context, node->outputs->size, 1);
@@ -50,6 +144,23 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
     // unranked tensor, so we set the tensor's allocation type to dynamic in
     // both cases.
     SetTensorToDynamic(output);
+  } else {
+    // Outputs of known shape point to the buffer of the variable when it
+    // keeps their value while they're in use. Custom tensors are not
+    // allocated in the arena, and ops which work in place don't share them
+    // with arena tensors. Subgraph outputs are copied, as their allocation
+    // belongs to the caller. The execution plan may have changed since the
+    // last preparation, e.g. by delegation, so the choice is made again.
+    auto* op_data = reinterpret_cast<OpData*>(node->user_data);
+    const Subgraph* subgraph = reinterpret_cast<Subgraph*>(context->impl_);
+    const bool alias_output =
+        (op_data->alias_output || output->allocation_type == kTfLiteArenaRw) &&
+        CanAliasOutput(*subgraph, node);
+    if (alias_output != op_data->alias_output) {
+      op_data->alias_output = alias_output;
+      output->allocation_type = alias_output ? kTfLiteCustom : kTfLiteArenaRw;
+      output->data.raw = nullptr;
+    }
   }
 
   return kTfLiteOk;
@@ -72,6 +183,11 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
                     GetOutputSafe(context, node, kOutputValue, &output));
 
   TF_LITE_ENSURE_TYPES_EQ(context, variable_tensor->type, output->type);
+  if (reinterpret_cast<OpData*>(node->user_data)->alias_output) {
+    TF_LITE_ENSURE_EQ(context, variable_tensor->bytes, output->bytes);
+    output->data.raw = variable_tensor->data.raw;
+    return kTfLiteOk;
+  }
   // Only resize the output if the op produces dynamic output.
   if (IsDynamicTensor(output)) {
     TF_LITE_ENSURE_OK(context, context->ResizeTensor(
@@ -86,8 +202,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 }  // namespace read_variable
 
 TfLiteRegistration* Register_READ_VARIABLE() {
-  static TfLiteRegistration r = {nullptr, nullptr, read_variable::Prepare,
-                                 read_variable::Eval};
+  static TfLiteRegistration r = {read_variable::Init, read_variable::Free,
+                                 read_variable::Prepare, read_variable::Eval};
   return &r;
 }
 
@@ -472,7 +472,8 @@ TfLiteStatus QuantizedMeanOrSum(TfLiteContext* context,
             op_context.output->dims->size, GetTensorData<int>(op_context.axis),
             num_axis, op_context.params->keep_dims,
             GetTensorData<int>(temp_index), GetTensorData<int>(resolved_axis),
-            GetTensorData<int32_t>(temp_sum), compute_sum));
+            GetTensorData<int32_t>(temp_sum), compute_sum,
+            CpuBackendContext::GetFromContext(context)));
   } else {
     TF_LITE_ENSURE(
         context,
@@ -866,7 +867,8 @@ TfLiteStatus EvalType(TfLiteContext* context, TfLiteNode* node,
             op_context->output->dims->data, op_context->output->dims->size,
             GetTensorData<int>(op_context->axis), num_axis,
             GetTensorData<int>(resolved_axis),
-            GetTensorData<int>(normalized_dims), reduce_type));
+            GetTensorData<int>(normalized_dims), reduce_type,
+            CpuBackendContext::GetFromContext(context)));
     return kTfLiteOk;
   }
 }
@@ -16,6 +16,7 @@ limitations under the License.
 
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/kernels/internal/compatibility.h"
 #include "tflite/kernels/internal/optimized/neon_check.h"
 #include "tflite/kernels/internal/optimized/optimized_ops.h"
@@ -115,35 +116,47 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
                       ResizeOutputTensor(context, input, size, output));
   }
 
-  if (output->type == kTfLiteFloat32) {
+  tflite::ResizeBilinearParams op_params;
+  op_params.align_corners = params->align_corners;
+  op_params.half_pixel_centers = params->half_pixel_centers;
+
 #define TF_LITE_RESIZE_BILINEAR(type, opname, datatype)              \
-  tflite::ResizeBilinearParams op_params;                            \
-  op_params.align_corners = params->align_corners;                   \
-  op_params.half_pixel_centers = params->half_pixel_centers;         \
   type::opname(op_params, GetTensorShape(input),                     \
                GetTensorData<datatype>(input), GetTensorShape(size), \
                GetTensorData<int32>(size), GetTensorShape(output),   \
                GetTensorData<datatype>(output))
+#define TF_LITE_RESIZE_BILINEAR_OPTIMIZED(opname, datatype)                   \
+  optimized_ops::opname(op_params, GetTensorShape(input),                     \
+                        GetTensorData<datatype>(input), GetTensorShape(size), \
+                        GetTensorData<int32>(size), GetTensorShape(output),   \
+                        GetTensorData<datatype>(output),                      \
+                        CpuBackendContext::GetFromContext(context))
 
+  if (output->type == kTfLiteFloat32) {
     if (kernel_type == kReference) {
       TF_LITE_RESIZE_BILINEAR(reference_ops, ResizeBilinear, float);
     } else if (kernel_type == kOptimized) {
-      TF_LITE_RESIZE_BILINEAR(optimized_ops, ResizeBilinear, float);
+      TF_LITE_RESIZE_BILINEAR_OPTIMIZED(ResizeBilinear, float);
     }
   } else if (output->type == kTfLiteUInt8) {
     if (kernel_type == kReference) {
       TF_LITE_RESIZE_BILINEAR(reference_ops, ResizeBilinear, uint8_t);
     } else if (kernel_type == kOptimized) {
-      TF_LITE_RESIZE_BILINEAR(optimized_ops, ResizeBilinear, uint8_t);
+      TF_LITE_RESIZE_BILINEAR_OPTIMIZED(ResizeBilinear, uint8_t);
     }
   } else if (output->type == kTfLiteInt8) {
     if (kernel_type == kReference) {
       TF_LITE_RESIZE_BILINEAR(reference_ops, ResizeBilinearInteger, int8_t);
     } else if (kernel_type == kOptimized) {
-      TF_LITE_RESIZE_BILINEAR(optimized_ops, ResizeBilinear, int8_t);
+      TF_LITE_RESIZE_BILINEAR_OPTIMIZED(ResizeBilinearInteger, int8_t);
     }
   } else if (output->type == kTfLiteInt16) {
-    TF_LITE_RESIZE_BILINEAR(reference_ops, ResizeBilinearInteger, int16_t);
+    if (kernel_type == kReference) {
+      TF_LITE_RESIZE_BILINEAR(reference_ops, ResizeBilinearInteger, int16_t);
+    } else if (kernel_type == kOptimized) {
+      TF_LITE_RESIZE_BILINEAR_OPTIMIZED(ResizeBilinearInteger, int16_t);
+    }
+#undef TF_LITE_RESIZE_BILINEAR_OPTIMIZED
 #undef TF_LITE_RESIZE_BILINEAR
   } else {
     TF_LITE_KERNEL_LOG(context, "Output type is %d, requires float.",
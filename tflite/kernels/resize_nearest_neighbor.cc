@@ -18,6 +18,7 @@ limitations under the License.
 
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/kernels/internal/compatibility.h"
 #include "tflite/kernels/internal/optimized/neon_check.h"
 #include "tflite/kernels/internal/optimized/optimized_ops.h"
@@ -84,6 +85,25 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   return ResizeOutputTensor(context, input, size, output);
 }
 
+template <KernelType kernel_type, typename T>
+void ResizeNearestNeighbor(TfLiteContext* context,
+                           const tflite::ResizeNearestNeighborParams& op_params,
+                           const TfLiteTensor* input, const TfLiteTensor* size,
+                           TfLiteTensor* output) {
+  if (kernel_type == kReference) {
+    reference_ops::ResizeNearestNeighbor(
+        op_params, GetTensorShape(input), GetTensorData<T>(input),
+        GetTensorShape(size), GetTensorData<int32>(size),
+        GetTensorShape(output), GetTensorData<T>(output));
+  } else {
+    optimized_ops::ResizeNearestNeighbor(
+        op_params, GetTensorShape(input), GetTensorData<T>(input),
+        GetTensorShape(size), GetTensorData<int32>(size),
+        GetTensorShape(output), GetTensorData<T>(output),
+        CpuBackendContext::GetFromContext(context));
+  }
+}
+
 template <KernelType kernel_type>
 TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   auto* params =
@@ -106,34 +126,19 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   op_params.align_corners = params->align_corners;
   op_params.half_pixel_centers = params->half_pixel_centers;
 
+  // Copies float32 data as int32 data of the same size.
   if (output->type == kTfLiteFloat32) {
-    reference_ops::ResizeNearestNeighbor(
-        op_params, GetTensorShape(input), GetTensorData<int32>(input),
-        GetTensorShape(size), GetTensorData<int32>(size),
-        GetTensorShape(output), GetTensorData<int32>(output));
+    ResizeNearestNeighbor<kernel_type, int32_t>(context, op_params, input,
+                                                size, output);
   } else if (output->type == kTfLiteUInt8) {
-    if (kernel_type == kReference) {
-      reference_ops::ResizeNearestNeighbor(
-          op_params, GetTensorShape(input), GetTensorData<uint8_t>(input),
-          GetTensorShape(size), GetTensorData<int32>(size),
-          GetTensorShape(output), GetTensorData<uint8_t>(output));
-    }
-    if (kernel_type == kGenericOptimized || kernel_type == kNeonOptimized) {
-      optimized_ops::ResizeNearestNeighbor(
-          op_params, GetTensorShape(input), GetTensorData<uint8_t>(input),
-          GetTensorShape(size), GetTensorData<int32>(size),
-          GetTensorShape(output), GetTensorData<uint8_t>(output));
-    }
+    ResizeNearestNeighbor<kernel_type, uint8_t>(context, op_params, input,
+                                                size, output);
   } else if (output->type == kTfLiteInt8) {
-    reference_ops::ResizeNearestNeighbor(
-        op_params, GetTensorShape(input), GetTensorData<int8_t>(input),
-        GetTensorShape(size), GetTensorData<int32>(size),
-        GetTensorShape(output), GetTensorData<int8_t>(output));
+    ResizeNearestNeighbor<kernel_type, int8_t>(context, op_params, input,
+                                               size, output);
   } else if (output->type == kTfLiteInt16) {
-    reference_ops::ResizeNearestNeighbor(
-        op_params, GetTensorShape(input), GetTensorData<int16_t>(input),
-        GetTensorShape(size), GetTensorData<int32>(size),
-        GetTensorShape(output), GetTensorData<int16_t>(output));
+    ResizeNearestNeighbor<kernel_type, int16_t>(context, op_params, input,
+                                                size, output);
   } else {
     TF_LITE_KERNEL_LOG(
         context, "Output type is %s, requires float, uint8, int8 or int16.",
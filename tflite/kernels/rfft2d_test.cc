@@ -33,7 +33,8 @@ using ::testing::ElementsAreArray;
 
 class Rfft2dOpModel : public SingleOpModel {
  public:
-  Rfft2dOpModel(const TensorData& input, const TensorData& fft_lengths) {
+  Rfft2dOpModel(const TensorData& input, const TensorData& fft_lengths,
+                int num_threads = -1) {
     input_ = AddInput(input);
     fft_lengths_ = AddInput(fft_lengths);
     TensorType output_type = TensorType_COMPLEX64;
@@ -41,7 +42,9 @@ class Rfft2dOpModel : public SingleOpModel {
 
     SetBuiltinOp(BuiltinOperator_RFFT2D, BuiltinOptions_Rfft2dOptions,
                  CreateRfft2dOptions(builder_).Union());
-    BuildInterpreter({GetShape(input_)});
+    BuildInterpreter({GetShape(input_)}, num_threads,
+                     /*allow_fp32_relax_to_fp16=*/false,
+                     /*apply_delegate=*/true);
   }
 
   int input() { return input_; }
@@ -141,6 +144,43 @@ TEST(Rfft2dOpTest, InputDimsGreaterThan2) {
   EXPECT_THAT(model.GetOutput(), ElementsAreArray(expected_result));
 }
 
+TEST(Rfft2dOpTest, ThreadedSlicesMatchSingleSlices) {
+  constexpr int kNumSlices = 32;
+  constexpr int kHeight = 32;
+  constexpr int kWidth = 64;
+  std::vector<float> input(kNumSlices * kHeight * kWidth);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>((i * 7919) % 101) / 10.0f - 5.0f;
+  }
+  Rfft2dOpModel model({TensorType_FLOAT32, {kNumSlices, kHeight, kWidth}},
+                      {TensorType_INT32, {2}}, /*num_threads=*/4);
+  model.PopulateTensor<float>(model.input(), input);
+
+  // The plan of each FFT length is reused by the following invocations.
+  for (const int fft_height : {kHeight, kHeight / 2, kHeight / 2}) {
+    model.PopulateTensor<int32_t>(model.fft_lengths(), {fft_height, kWidth});
+    ASSERT_EQ(model.Invoke(), kTfLiteOk);
+    const std::vector<complex<float>> output = model.GetOutput();
+    const int output_slice_size = fft_height * (kWidth / 2 + 1);
+    ASSERT_EQ(output.size(), kNumSlices * output_slice_size);
+    for (const int slice : {0, kNumSlices / 2, kNumSlices - 1}) {
+      Rfft2dOpModel slice_model({TensorType_FLOAT32, {kHeight, kWidth}},
+                                {TensorType_INT32, {2}});
+      slice_model.PopulateTensor<float>(
+          slice_model.input(),
+          std::vector<float>(input.begin() + slice * kHeight * kWidth,
+                             input.begin() + (slice + 1) * kHeight * kWidth));
+      slice_model.PopulateTensor<int32_t>(slice_model.fft_lengths(),
+                                          {fft_height, kWidth});
+      ASSERT_EQ(slice_model.Invoke(), kTfLiteOk);
+      EXPECT_THAT(std::vector<complex<float>>(
+                      output.begin() + slice * output_slice_size,
+                      output.begin() + (slice + 1) * output_slice_size),
+                  ElementsAreArray(slice_model.GetOutput()));
+    }
+  }
+}
+
 }  // namespace
 }  // namespace builtin
 }  // namespace ops
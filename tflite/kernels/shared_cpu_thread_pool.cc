@@ -0,0 +1,54 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/kernels/shared_cpu_thread_pool.h"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "tflite/kernels/affinity_thread_pool.h"
+
+namespace tflite {
+
+SharedCpuThreadPool::SharedCpuThreadPool(
+    const AffinityThreadPool::Options& options)
+    : pool_(options) {}
+
+void SharedCpuThreadPool::Execute(int tasks_count,
+                                  const std::function<void(int)>& task,
+                                  int priority) {
+  if (tasks_count <= 0) {
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const std::pair<int, int64_t> caller(priority, -next_ticket_++);
+    waiting_callers_.push(caller);
+    pool_available_.wait(lock, [&] {
+      return !pool_busy_ && waiting_callers_.top() == caller;
+    });
+    waiting_callers_.pop();
+    pool_busy_ = true;
+  }
+  pool_.Execute(tasks_count, task);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_busy_ = false;
+  }
+  pool_available_.notify_all();
+}
+
+}  // namespace tflite
@@ -0,0 +1,56 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_KERNELS_SHARED_CPU_THREAD_POOL_H_
+#define TENSORFLOW_LITE_KERNELS_SHARED_CPU_THREAD_POOL_H_
+
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <cstdint>
+#include <functional>
+#include <mutex>  // NOLINT(build/c++11)
+#include <queue>
+#include <utility>
+
+#include "tflite/external_cpu_backend_context.h"
+#include "tflite/kernels/affinity_thread_pool.h"
+
+namespace tflite {
+
+// A TfLiteCpuThreadPool running the tasks of one caller at a time on an
+// AffinityThreadPool, the other callers waiting for their turn by priority.
+//
+// WARNING: This is an experimental API and subject to change.
+class SharedCpuThreadPool : public TfLiteCpuThreadPool {
+ public:
+  explicit SharedCpuThreadPool(const AffinityThreadPool::Options& options);
+
+  void Execute(int tasks_count, const std::function<void(int)>& task,
+               int priority) override;
+
+ private:
+  std::mutex mutex_;
+  // Signaled when `pool_` is done with the tasks of a caller.
+  std::condition_variable pool_available_;
+  bool pool_busy_ = false;
+  // The priorities and tickets of the waiting callers, the one to serve next
+  // on top. Tickets are negated so that earlier callers come first.
+  std::priority_queue<std::pair<int, int64_t>> waiting_callers_;
+  int64_t next_ticket_ = 0;
+
+  AffinityThreadPool pool_;
+};
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_KERNELS_SHARED_CPU_THREAD_POOL_H_
@@ -0,0 +1,101 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/kernels/shared_cpu_thread_pool.h"
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <mutex>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tflite/kernels/affinity_thread_pool.h"
+
+namespace tflite {
+namespace {
+
+using ::testing::ElementsAre;
+
+AffinityThreadPool::Options MakeOptions(int num_threads) {
+  AffinityThreadPool::Options options;
+  options.num_threads = num_threads;
+  return options;
+}
+
+TEST(SharedCpuThreadPoolTest, RunsTasksOfConcurrentCallers) {
+  SharedCpuThreadPool pool(MakeOptions(3));
+  std::vector<std::thread> callers;
+  std::vector<std::vector<int>> buffers(4, std::vector<int>(100));
+  for (int c = 0; c < static_cast<int>(buffers.size()); ++c) {
+    callers.emplace_back([&, c] {
+      for (int iteration = 0; iteration < 50; ++iteration) {
+        pool.Execute(
+            buffers[c].size(), [&](int i) { buffers[c][i] += i; },
+            /*priority=*/c % 2);
+      }
+    });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+  for (const auto& buffer : buffers) {
+    for (int i = 0; i < static_cast<int>(buffer.size()); ++i) {
+      ASSERT_EQ(buffer[i], 50 * i);
+    }
+  }
+}
+
+TEST(SharedCpuThreadPoolTest, ServesHigherPrioritiesFirst) {
+  SharedCpuThreadPool pool(MakeOptions(2));
+  std::atomic<bool> release{false};
+  std::thread blocker([&] {
+    pool.Execute(
+        1,
+        [&](int) {
+          while (!release) {
+            std::this_thread::yield();
+          }
+        },
+        /*priority=*/0);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  std::mutex mutex;
+  std::vector<int> served;
+  std::vector<std::thread> callers;
+  for (const int priority : {0, 2, 1}) {
+    callers.emplace_back([&, priority] {
+      pool.Execute(
+          1,
+          [&](int) {
+            std::lock_guard<std::mutex> lock(mutex);
+            served.push_back(priority);
+          },
+          priority);
+    });
+    // Lets the caller wait for its turn before the next one.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  release = true;
+  blocker.join();
+  for (auto& caller : callers) {
+    caller.join();
+  }
+  EXPECT_THAT(served, ElementsAre(2, 1, 0));
+}
+
+}  // namespace
+}  // namespace tflite
@@ -22,6 +22,7 @@ limitations under the License.
 #include <vector>
 
 #include "Eigen/Core"
+#include "tflite/builtin_ops.h"
 #include "tflite/context_util.h"
 #include "tflite/core/c/common.h"
 #include "tflite/kernels/internal/compatibility.h"
@@ -32,6 +33,7 @@ limitations under the License.
 #include "tflite/kernels/internal/types.h"
 #include "tflite/kernels/kernel_util.h"
 #include "tflite/string_type.h"
+#include "tflite/tensor_views.h"
 
 namespace tflite {
 namespace ops {
@@ -179,6 +181,10 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
     TF_LITE_ENSURE_OK(context,
                       ResizeOutputShape(context, input, begin, size, output));
   }
+  // The output is already in the input if it is a view of it.
+  if (HasPlannedTensorViews(kTfLiteBuiltinSlice, *context, *node)) {
+    return kTfLiteOk;
+  }
 
   std::vector<int> begins;
   begins.reserve(kMaxDim);
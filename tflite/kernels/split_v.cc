@@ -16,6 +16,7 @@ limitations under the License.
 
 #include <vector>
 
+#include "tflite/builtin_ops.h"
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
 #include "tflite/kernels/internal/optimized/optimized_ops.h"
@@ -24,6 +25,7 @@ limitations under the License.
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/internal/types.h"
 #include "tflite/kernels/kernel_util.h"
+#include "tflite/tensor_views.h"
 
 namespace tflite {
 namespace ops {
@@ -176,6 +178,11 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 
   int axis_value = GetTensorData<int>(op_context.axis)[0];
 
+  // The outputs are already in the input if they are views of it.
+  if (HasPlannedTensorViews(kTfLiteBuiltinSplitV, *context, *node)) {
+    return kTfLiteOk;
+  }
+
   // Use split function to build the outputs since they share the same logic.
 #define TF_LITE_SPLIT_V(scalar)                                     \
   VectorOfTensors<scalar> all_outputs(*context, *node->outputs);    \
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <vector>
 
@@ -22,6 +23,8 @@ limitations under the License.
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/c_api_types.h"
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/internal/optimized/gather.h"
 #include "tflite/kernels/internal/runtime_shape.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/internal/types.h"
@@ -144,6 +147,124 @@ TfLiteStatus SetBatchAndOffsetIndices(const Index<IndexType>& result_index,
   return kTfLiteOk;
 }
 
+// Whether the gather copies one slice of the operand per index vector, the
+// index vectors being the innermost dimension of the start indices and the
+// offset dimensions being the innermost dimensions of the result. Each slice
+// is then contiguous in the result, in the order of the index vectors.
+bool IsSliceGather(const TfLiteStablehloGatherParams* data,
+                   const RuntimeShape& start_indices_shape, int result_rank) {
+  const int start_indices_rank = start_indices_shape.DimensionsCount();
+  if (data->index_vector_dim < start_indices_rank - 1 ||
+      data->index_vector_dim > start_indices_rank) {
+    return false;
+  }
+  for (int i = 0; i < data->num_offset_dims; ++i) {
+    if (data->offset_dims[i] != result_rank - data->num_offset_dims + i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Gathers the slices of a gather for which IsSliceGather() holds, copying the
+// contiguous runs of each slice from the threads of the context.
+template <typename IndexType, typename DataType>
+TfLiteStatus EvalSliceGather(TfLiteContext* context,
+                             const TfLiteStablehloGatherParams* data,
+                             const TfLiteTensor* operand,
+                             const TfLiteTensor* start_indices,
+                             TfLiteTensor* output) {
+  const RuntimeShape operand_shape = GetTensorShape(operand);
+  const RuntimeShape start_indices_shape = GetTensorShape(start_indices);
+  const int rank = operand_shape.DimensionsCount();
+  TF_LITE_ENSURE_EQ(context, data->num_slice_sizes, rank);
+  TF_LITE_ENSURE(context,
+                 rank <= TFLITE_STABLEHLO_GATHER_PARAMS_MAX_DIMENSION_COUNT);
+  const int index_vector_size =
+      data->index_vector_dim < start_indices_shape.DimensionsCount()
+          ? start_indices_shape.Dims(data->index_vector_dim)
+          : 1;
+  TF_LITE_ENSURE_EQ(context, index_vector_size, data->num_start_index_map);
+  for (int i = 0; i < data->num_start_index_map; ++i) {
+    TF_LITE_ENSURE(context, data->start_index_map[i] >= 0 &&
+                                data->start_index_map[i] < rank);
+  }
+
+  int64_t slice_size = 1;
+  int64_t operand_strides[TFLITE_STABLEHLO_GATHER_PARAMS_MAX_DIMENSION_COUNT];
+  for (int dim = rank - 1; dim >= 0; --dim) {
+    TF_LITE_ENSURE(context, data->slice_sizes[dim] >= 0 &&
+                                data->slice_sizes[dim] <=
+                                    operand_shape.Dims(dim));
+    operand_strides[dim] =
+        dim == rank - 1
+            ? 1
+            : operand_strides[dim + 1] * operand_shape.Dims(dim + 1);
+    slice_size *= data->slice_sizes[dim];
+  }
+  int num_slices = 1;
+  for (int dim = 0; dim < start_indices_shape.DimensionsCount(); ++dim) {
+    if (dim != data->index_vector_dim) {
+      num_slices *= start_indices_shape.Dims(dim);
+    }
+  }
+  if (slice_size == 0 || num_slices == 0) {
+    return kTfLiteOk;
+  }
+  TF_LITE_ENSURE_EQ(context, NumElements(output), num_slices * slice_size);
+
+  // A slice is a sequence of contiguous runs of the operand, each spanning the
+  // dimensions from `run_dim` in.
+  int run_dim = 0;
+  for (int dim = rank - 1; dim > 0; --dim) {
+    if (data->slice_sizes[dim] != operand_shape.Dims(dim)) {
+      run_dim = dim;
+      break;
+    }
+  }
+  int64_t run_size = 1;
+  for (int dim = run_dim; dim < rank; ++dim) {
+    run_size *= data->slice_sizes[dim];
+  }
+
+  const DataType* operand_data = GetTensorData<DataType>(operand);
+  const IndexType* start_indices_data = GetTensorData<IndexType>(start_indices);
+  DataType* output_data = GetTensorData<DataType>(output);
+  optimized_ops::gather_internal::ForEachRow(
+      num_slices, slice_size * sizeof(DataType),
+      CpuBackendContext::GetFromContext(context), [&](int slice) {
+        // The start of the slice, clipped so that the slice fits in the
+        // operand.
+        int64_t start[TFLITE_STABLEHLO_GATHER_PARAMS_MAX_DIMENSION_COUNT] = {};
+        const IndexType* index_vector =
+            start_indices_data + slice * index_vector_size;
+        for (int i = 0; i < index_vector_size; ++i) {
+          const int dim = data->start_index_map[i];
+          start[dim] = std::clamp<int64_t>(
+              index_vector[i], 0,
+              operand_shape.Dims(dim) - data->slice_sizes[dim]);
+        }
+        DataType* slice_output = output_data + slice * slice_size;
+        // Index of the current run in the dimensions before `run_dim`.
+        int64_t run_index[TFLITE_STABLEHLO_GATHER_PARAMS_MAX_DIMENSION_COUNT] =
+            {};
+        for (int64_t offset = 0; offset < slice_size; offset += run_size) {
+          int64_t operand_offset = 0;
+          for (int dim = 0; dim < rank; ++dim) {
+            operand_offset +=
+                (start[dim] + run_index[dim]) * operand_strides[dim];
+          }
+          std::memcpy(slice_output + offset, operand_data + operand_offset,
+                      run_size * sizeof(DataType));
+          for (int dim = run_dim - 1; dim >= 0; --dim) {
+            if (++run_index[dim] < data->slice_sizes[dim]) break;
+            run_index[dim] = 0;
+          }
+        }
+      });
+  return kTfLiteOk;
+}
+
 // Evaluates this node given the type of the elements in the start_indices
 // and the type of the elements in the operand tensor.
 template <typename IndexType, typename DataType>
@@ -170,6 +291,10 @@ TfLiteStatus EvalWithTypes(TfLiteContext* context, TfLiteNode* node) {
 
   RuntimeShape start_indices_shape = GetTensorShape(start_indices);
   int result_rank = output->dims->size;
+  if (IsSliceGather(data, start_indices_shape, result_rank)) {
+    return EvalSliceGather<IndexType, DataType>(context, data, operand,
+                                                start_indices, output);
+  }
   RuntimeShape result_runtime_shape(result_rank, output->dims->data);
   Index<IndexType> result_index = Index<IndexType>(result_rank, 0);
 
@@ -107,6 +107,33 @@ TEST(StablehloScatterOpTest, GathersSlices) {
   EXPECT_THAT(model.GetOutput<float>(), ElementsAreArray(expected_values));
 }
 
+TEST(StablehloScatterOpTest, GathersSlicesIntoLeadingOffsetDims) {
+  TfLiteStablehloGatherParams params = {
+      {0, 1},     // offset_dims
+      2,          // num_offset_dims;
+      {0},        // collapsed_slice_dims
+      1,          // num_collapsed_slice_dims;
+      {1, 0},     // start_index_map
+      2,          // num_start_index_map;
+      2,          // index_vector_dim;
+      {1, 2, 2},  // slice_sizes
+      3,          // num_slice_sizes;
+      false       // indices_are_sorted;
+  };
+  StablehloGatherOpModel model({TensorType_FLOAT32, {3, 4, 2}},
+                               {TensorType_INT64, {2, 3, 2}}, params);
+
+  model.SetInput<float>({1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12,
+                         13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24});
+  model.SetIndices<int64_t>({0, 0, 1, 0, 2, 1, 0, 1, 1, 1, 0, 2});
+
+  ASSERT_EQ(model.Invoke(), kTfLiteOk);
+  std::vector<float> expected_values = {1, 3,  13, 9,  11, 17, 2, 4,
+                                        14, 10, 12, 18, 3,  5,  15, 11,
+                                        13, 19, 4,  6,  16, 12, 14, 20};
+  EXPECT_THAT(model.GetOutput<float>(), ElementsAreArray(expected_values));
+}
+
 TEST(StablehloScatterOpTest, ClipsStartingIndices) {
   TfLiteStablehloGatherParams params = {
       {2, 3},     // offset_dims
@@ -30,6 +30,8 @@ limitations under the License.
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
 #include "tflite/core/subgraph.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/internal/optimized/gather.h"
 #include "tflite/kernels/kernel_util.h"
 #include "tflite/util.h"
 
@@ -457,13 +459,95 @@ struct ReduceWindowData {
   int64_t output_strides[kMaxReduceWindowRank] = {};
 };
 
+// Reduces the window starting at `input` over the dimensions before `inner`
+// into each element of `output`, the elements of the `run_size` contiguous
+// windows being contiguous too.
+template <class Op, class Type>
+void ReduceWindowRuns(const Type* input, Type* output,
+                      const int64_t* const window_shape,
+                      const int64_t* const window_reduce_strides,
+                      const int64_t run_size, const int inner,
+                      const int depth) {
+  if (depth == inner) {
+    const Op op;
+    for (int64_t i = 0; i < run_size; ++i) {
+      output[i] = op(output[i], input[i]);
+    }
+  } else {
+    for (int64_t i = 0; i < window_shape[depth]; ++i) {
+      ReduceWindowRuns<Op, Type>(input, output, window_shape,
+                                 window_reduce_strides, run_size, inner,
+                                 depth + 1);
+      input += window_reduce_strides[depth];
+    }
+  }
+}
+
+// Computes the reduction from the threads of `cpu_backend_context`.
+//
+// When the window spans a single element with a unit stride along the
+// innermost dimensions, the outputs along these dimensions are contiguous runs
+// which are reduced with vectorizable loops, in the same order as
+// ReduceWindowImpl() does.
 template <class Op, class Type>
 void ReduceWindow(const ReduceWindowData& ctx, const Type* const input,
-                  const Type init, Type* output) {
-  ReduceWindowImpl<Op, Type>(input, output, ctx.output_shape,
-                             ctx.output_strides, ctx.window_offset_strides,
-                             ctx.window_shape, ctx.window_reduce_strides, init,
-                             ctx.rank, /*depth=*/0);
+                  const Type init, Type* output,
+                  CpuBackendContext* cpu_backend_context) {
+  const int rank = ctx.rank;
+  int64_t window_size = 1;
+  for (int i = 0; i < rank; ++i) {
+    window_size *= ctx.window_shape[i];
+  }
+  // The dimensions from `inner` in are the ones reduced as runs.
+  int inner = rank;
+  while (inner > 0 && ctx.window_shape[inner - 1] == 1 &&
+         ctx.window_strides[inner - 1] == 1) {
+    --inner;
+  }
+  if (inner < rank) {
+    const int64_t run_size = inner > 0 ? ctx.output_strides[inner - 1]
+                                       : ctx.output_strides[0] *
+                                             ctx.output_shape[0];
+    int64_t num_runs = 1;
+    for (int i = 0; i < inner; ++i) {
+      num_runs *= ctx.output_shape[i];
+    }
+    optimized_ops::gather_internal::ForEachRow(
+        num_runs, run_size * window_size * sizeof(Type), cpu_backend_context,
+        [&](int run) {
+          int64_t input_offset = 0;
+          int64_t index = run;
+          for (int i = inner - 1; i >= 0; --i) {
+            input_offset +=
+                index % ctx.output_shape[i] * ctx.window_offset_strides[i];
+            index /= ctx.output_shape[i];
+          }
+          Type* run_output = output + run * run_size;
+          std::fill_n(run_output, run_size, init);
+          ReduceWindowRuns<Op, Type>(input + input_offset, run_output,
+                                     ctx.window_shape,
+                                     ctx.window_reduce_strides, run_size,
+                                     inner, /*depth=*/0);
+        });
+    return;
+  }
+  if (rank == 1) {
+    ReduceWindowImpl<Op, Type>(input, output, ctx.output_shape,
+                               ctx.output_strides, ctx.window_offset_strides,
+                               ctx.window_shape, ctx.window_reduce_strides,
+                               init, ctx.rank, /*depth=*/0);
+    return;
+  }
+  // Each slice of the outermost dimension of the output is a row.
+  optimized_ops::gather_internal::ForEachRow(
+      ctx.output_shape[0], ctx.output_strides[0] * window_size * sizeof(Type),
+      cpu_backend_context, [&](int row) {
+        ReduceWindowImpl<Op, Type>(
+            input + row * ctx.window_offset_strides[0],
+            output + row * ctx.output_strides[0], ctx.output_shape,
+            ctx.output_strides, ctx.window_offset_strides, ctx.window_shape,
+            ctx.window_reduce_strides, init, ctx.rank, /*depth=*/1);
+      });
 }
 
 }  // namespace
@@ -824,7 +908,8 @@ void PadCropReduceWindow(const OpData& op_ctx) {
   reduce_window::ReduceWindow<Op, Type>(
       node_data.reduce_window_ctx, reinterpret_cast<const Type*>(input),
       *reinterpret_cast<const Type*>(op_ctx.init_value),
-      reinterpret_cast<Type*>(op_ctx.output));
+      reinterpret_cast<Type*>(op_ctx.output),
+      CpuBackendContext::GetFromContext(op_ctx.context));
 }
 
 // Dispatches to the template implementation according to the tensor type.
@@ -199,6 +199,8 @@ class ReduceWindowOpModel : public SingleOpModel {
 
   void SetBody(const BodyFunction func) { body_function_ = func; }
 
+  void SetNumThreads(const int num_threads) { num_threads_ = num_threads; }
+
   TfLiteStatus Build() {
     constexpr int kBodySubGraphIndex = 1;
 
@@ -230,7 +232,7 @@ class ReduceWindowOpModel : public SingleOpModel {
     BuildInterpreter(
         /*input_shapes=*/{std::vector<int>(input_shape_.begin(),
                                            input_shape_.end())},
-        /*num_threads=*/-1, /*allow_fp32_relax_to_fp16=*/false,
+        /*num_threads=*/num_threads_, /*allow_fp32_relax_to_fp16=*/false,
         /*apply_delegate=*/true, /*allocate_and_delegate=*/false,
         /*use_simple_allocator=*/false);
 
@@ -356,6 +358,7 @@ class ReduceWindowOpModel : public SingleOpModel {
   std::vector<int64_t> window_dilations_;
   std::vector<int64_t> padding_;
   BodyFunction body_function_{};
+  int num_threads_ = -1;
   subgraph_test_util::SubgraphBuilder subgraph_builder_;
 };
 
@@ -797,6 +800,50 @@ TYPED_TEST(StablehloReduceWindowTest, FuzzyTest) {
   }
 }
 
+// Checks the reductions of large tensors over their outer dimensions only,
+// which are computed from several threads.
+TYPED_TEST(StablehloReduceWindowTest, LargeFuzzyTestWithUnitInnerWindow) {
+  absl::BitGen bitgen;
+
+  for (size_t iteration = 0; iteration < 10; ++iteration) {
+    ReduceWindowOpModel<TypeParam> model;
+    Body body = Body::GetRandomSupported(
+        bitgen, /*allow_mul=*/std::is_floating_point<TypeParam>::value);
+    model.SetInput(
+        /*shape=*/{absl::Uniform(absl::IntervalClosed, bitgen, 1, 3),
+                   absl::Uniform(absl::IntervalClosed, bitgen, 16, 48),
+                   absl::Uniform(absl::IntervalClosed, bitgen, 16, 48),
+                   absl::Uniform(absl::IntervalClosed, bitgen, 16, 64)},
+        bitgen, /*min=*/-5, /*max=*/5);
+    model.SetBaseDilations({1, 1, 1, 1});
+    model.SetPadding({0, 0, 0, 0, 0, 0, 0, 0});
+    model.SetWindowDimensions(
+        {1, absl::Uniform(absl::IntervalClosed, bitgen, 1, 3),
+         absl::Uniform(absl::IntervalClosed, bitgen, 1, 3), 1});
+    model.SetWindowStrides(
+        {1, absl::Uniform(absl::IntervalClosed, bitgen, 1, 2),
+         absl::Uniform(absl::IntervalClosed, bitgen, 1, 2), 1});
+    model.SetWindowDilations(
+        RandomVector<int64_t>(bitgen, 4, /*min=*/1, /*max=*/2));
+    model.SetInitValue(body.init_value<TypeParam>());
+    model.SetBody(body.func);
+    model.SetNumThreads(4);
+
+    const reference::Tensor<TypeParam> expected = reference::ReduceWindow(
+        reference::Tensor<TypeParam>{/*shape=*/model.GetInputShape(),
+                                     /*data=*/model.GetInput()},
+        model.GetBaseDilations(), model.GetPadding(), model.GetInitValue(),
+        model.GetWindowDimensions(), model.GetWindowDilations(),
+        model.GetWindowStrides(), body);
+
+    ASSERT_EQ(model.BuildAndInvoke(), kTfLiteOk);
+    EXPECT_THAT(model.GetOutputShape(), ElementsAreArray(expected.shape))
+        << model;
+    EXPECT_THAT(model.GetOutputData(), ElementsAreArray(expected.data))
+        << model;
+  }
+}
+
 }  // namespace
 }  // namespace reduce_window
 }  // namespace tflite
@@ -26,6 +26,8 @@ limitations under the License.
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
 #include "tflite/core/subgraph.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/internal/optimized/gather.h"
 #include "tflite/kernels/internal/runtime_shape.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/internal/types.h"
@@ -193,6 +195,196 @@ static TfLiteStatus ApplyComputation(TfLiteTensor* tensor,
   return kTfLiteOk;
 }
 
+// Applies the computation of type `kComputationType` to `input_value` and
+// `update_value`, like ApplyComputation() does.
+template <ComputationType kComputationType, typename DataType>
+inline DataType Combine(DataType input_value, DataType update_value) {
+  if constexpr (kComputationType == ComputationType::kUpdate) {
+    return update_value;
+  } else if constexpr (kComputationType == ComputationType::kAdd) {
+    return input_value + update_value;
+  } else if constexpr (kComputationType == ComputationType::kMultiply) {
+    return input_value * update_value;
+  } else if constexpr (kComputationType == ComputationType::kMaximum) {
+    return std::max(input_value, update_value);
+  } else {
+    return std::min(input_value, update_value);
+  }
+}
+
+// Whether the scatter applies one window of the updates per index vector, the
+// index vectors being the innermost dimension of the scatter indices and the
+// update window dimensions being the innermost dimensions of the updates. Each
+// window is then contiguous in the updates, in the order of the index vectors.
+bool IsWindowScatter(const TfLiteStablehloScatterParams* data,
+                     const RuntimeShape& scatter_indices_shape,
+                     int updates_rank) {
+  const int scatter_indices_rank = scatter_indices_shape.DimensionsCount();
+  if (data->index_vector_dim < scatter_indices_rank - 1 ||
+      data->index_vector_dim > scatter_indices_rank) {
+    return false;
+  }
+  for (int i = 0; i < data->num_update_window_dims; ++i) {
+    if (data->update_window_dims[i] !=
+        updates_rank - data->num_update_window_dims + i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Scatters the windows of a scatter for which IsWindowScatter() holds into
+// `output`, which already holds the inputs. The output is split in blocks of
+// its innermost dimension, each block getting all its updates from a single
+// thread so that the updates hitting the same elements apply in order.
+template <ComputationType kComputationType, typename IndexType,
+          typename DataType>
+TfLiteStatus EvalWindowScatter(TfLiteContext* context,
+                               const TfLiteStablehloScatterParams* data,
+                               const TfLiteTensor* scatter_indices,
+                               const TfLiteTensor* updates,
+                               TfLiteTensor* output) {
+  constexpr int kMaxDims = TFLITE_STABLEHLO_SCATTER_PARAMS_MAX_DIMENSION_COUNT;
+  // The smallest number of columns of the innermost dimension of the output
+  // updated by a thread.
+  constexpr int64_t kMinColumnsPerBlock = 16;
+
+  const RuntimeShape output_shape = GetTensorShape(output);
+  const RuntimeShape scatter_indices_shape = GetTensorShape(scatter_indices);
+  const RuntimeShape updates_shape = GetTensorShape(updates);
+  const int rank = output_shape.DimensionsCount();
+  const int updates_rank = updates_shape.DimensionsCount();
+  const int num_scatter_dims = updates_rank - data->num_update_window_dims;
+  TF_LITE_ENSURE(context, rank >= 1 && rank <= kMaxDims);
+  TF_LITE_ENSURE_EQ(
+      context, data->num_update_window_dims + data->num_inserted_window_dims,
+      rank);
+  TF_LITE_ENSURE(context, num_scatter_dims >= 0);
+
+  // The shape of the windows in the output, and their strides.
+  int64_t window_shape[kMaxDims];
+  int64_t window_strides[kMaxDims];
+  int64_t output_strides[kMaxDims];
+  int update_window_dim = num_scatter_dims;
+  for (int dim = 0; dim < rank; ++dim) {
+    if (ArrayContains(data->inserted_window_dims,
+                      data->num_inserted_window_dims, dim)) {
+      window_shape[dim] = 1;
+    } else {
+      TF_LITE_ENSURE(context, update_window_dim < updates_rank);
+      window_shape[dim] = updates_shape.Dims(update_window_dim++);
+    }
+  }
+  TF_LITE_ENSURE_EQ(context, update_window_dim, updates_rank);
+  int64_t window_size = 1;
+  int64_t output_size = 1;
+  for (int dim = rank - 1; dim >= 0; --dim) {
+    window_strides[dim] = window_size;
+    output_strides[dim] = output_size;
+    window_size *= window_shape[dim];
+    output_size *= output_shape.Dims(dim);
+  }
+
+  const int index_vector_size =
+      data->index_vector_dim < scatter_indices_shape.DimensionsCount()
+          ? scatter_indices_shape.Dims(data->index_vector_dim)
+          : 1;
+  TF_LITE_ENSURE_EQ(context, index_vector_size,
+                    data->num_scatter_dims_to_operand_dims);
+  for (int i = 0; i < data->num_scatter_dims_to_operand_dims; ++i) {
+    TF_LITE_ENSURE(context, data->scatter_dims_to_operand_dims[i] >= 0 &&
+                                data->scatter_dims_to_operand_dims[i] < rank);
+  }
+  int64_t num_updates = 1;
+  for (int dim = 0; dim < num_scatter_dims; ++dim) {
+    num_updates *= updates_shape.Dims(dim);
+  }
+  int64_t num_index_vectors = 1;
+  for (int dim = 0; dim < scatter_indices_shape.DimensionsCount(); ++dim) {
+    if (dim != data->index_vector_dim) {
+      num_index_vectors *= scatter_indices_shape.Dims(dim);
+    }
+  }
+  TF_LITE_ENSURE_EQ(context, num_updates, num_index_vectors);
+  if (num_updates == 0 || window_size == 0 || output_size == 0) {
+    return kTfLiteOk;
+  }
+
+  CpuBackendContext* cpu_backend_context =
+      CpuBackendContext::GetFromContext(context);
+  const int64_t num_columns = output_shape.Dims(rank - 1);
+  const int num_blocks = static_cast<int>(std::max<int64_t>(
+      1, std::min<int64_t>(
+             {cpu_backend_context->max_num_threads(),
+              num_columns / kMinColumnsPerBlock,
+              static_cast<int64_t>(
+                  updates->bytes /
+                  optimized_ops::gather_internal::kMinBytesPerTask)})));
+
+  const IndexType* scatter_indices_data =
+      GetTensorData<IndexType>(scatter_indices);
+  const DataType* updates_data = GetTensorData<DataType>(updates);
+  DataType* output_data = GetTensorData<DataType>(output);
+  optimized_ops::gather_internal::ForEachRow(
+      num_blocks, updates->bytes / num_blocks, cpu_backend_context,
+      [&](int block) {
+        const int64_t block_begin = num_columns * block / num_blocks;
+        const int64_t block_end = num_columns * (block + 1) / num_blocks;
+        for (int64_t update = 0; update < num_updates; ++update) {
+          int64_t start[kMaxDims] = {};
+          const IndexType* index_vector =
+              scatter_indices_data + update * index_vector_size;
+          for (int i = 0; i < index_vector_size; ++i) {
+            start[data->scatter_dims_to_operand_dims[i]] = index_vector[i];
+          }
+          // The part of the window in the output, out of bounds updates being
+          // ignored as in the reference interpreter.
+          int64_t begin[kMaxDims];
+          int64_t end[kMaxDims];
+          bool is_empty = false;
+          for (int dim = 0; dim < rank; ++dim) {
+            int64_t dim_begin = 0;
+            int64_t dim_end = output_shape.Dims(dim);
+            if (dim == rank - 1) {
+              dim_begin = block_begin;
+              dim_end = block_end;
+            }
+            begin[dim] = std::max<int64_t>(0, dim_begin - start[dim]);
+            end[dim] = std::min(window_shape[dim], dim_end - start[dim]);
+            is_empty |= begin[dim] >= end[dim];
+          }
+          if (is_empty) continue;
+
+          const DataType* window_data = updates_data + update * window_size;
+          const int64_t run_size = end[rank - 1] - begin[rank - 1];
+          int64_t position[kMaxDims];
+          std::copy(begin, begin + rank, position);
+          while (true) {
+            int64_t output_offset = 0;
+            int64_t window_offset = 0;
+            for (int dim = 0; dim < rank; ++dim) {
+              output_offset +=
+                  (start[dim] + position[dim]) * output_strides[dim];
+              window_offset += position[dim] * window_strides[dim];
+            }
+            DataType* output_run = output_data + output_offset;
+            const DataType* update_run = window_data + window_offset;
+            for (int64_t i = 0; i < run_size; ++i) {
+              output_run[i] =
+                  Combine<kComputationType>(output_run[i], update_run[i]);
+            }
+            int dim = rank - 2;
+            for (; dim >= 0; --dim) {
+              if (++position[dim] < end[dim]) break;
+              position[dim] = begin[dim];
+            }
+            if (dim < 0) break;
+          }
+        }
+      });
+  return kTfLiteOk;
+}
+
 // Evaluates this node given the type of the elements in the scatter_indices
 // and the type of the elements in the input/updates tensors.
 template <typename IndexType, typename DataType>
@@ -222,10 +414,36 @@ TfLiteStatus EvalWithTypes(TfLiteContext* context, TfLiteNode* node) {
   RuntimeShape input_shape = GetTensorShape(input);
   int input_rank = input_shape.DimensionsCount();
 
-  const DataType* output_data = GetTensorData<DataType>(output);
   RuntimeShape scatter_indices_shape = GetTensorShape(scatter_indices);
   RuntimeShape updates_shape = GetTensorShape(updates);
   int64_t updates_rank = updates_shape.DimensionsCount();
+  if (IsWindowScatter(data, scatter_indices_shape, updates_rank)) {
+    switch (op_data->computation_type) {
+      case ComputationType::kUpdate:
+        return EvalWindowScatter<ComputationType::kUpdate, IndexType,
+                                 DataType>(context, data, scatter_indices,
+                                           updates, output);
+      case ComputationType::kAdd:
+        return EvalWindowScatter<ComputationType::kAdd, IndexType, DataType>(
+            context, data, scatter_indices, updates, output);
+      case ComputationType::kMultiply:
+        return EvalWindowScatter<ComputationType::kMultiply, IndexType,
+                                 DataType>(context, data, scatter_indices,
+                                           updates, output);
+      case ComputationType::kMaximum:
+        return EvalWindowScatter<ComputationType::kMaximum, IndexType,
+                                 DataType>(context, data, scatter_indices,
+                                           updates, output);
+      case ComputationType::kMinimum:
+        return EvalWindowScatter<ComputationType::kMinimum, IndexType,
+                                 DataType>(context, data, scatter_indices,
+                                           updates, output);
+      case ComputationType::kOther:
+        break;
+    }
+  }
+
+  const DataType* output_data = GetTensorData<DataType>(output);
   Index<IndexType> update_index = Index<IndexType>(updates_rank, 0);
   const DataType* updates_data = GetTensorData<DataType>(updates);
 
@@ -149,6 +149,37 @@ TEST(StablehloScatterOpTest, PerformsAddition) {
   EXPECT_THAT(model.GetOutput<float>(), ElementsAreArray(expected_values));
 }
 
+TEST(StablehloScatterOpTest, PerformsAdditionWithLeadingUpdateWindowDims) {
+  StablehloScatterOpType op_type = StablehloScatterOpType::kAdd;
+
+  TfLiteStablehloScatterParams params = {
+      false,   // indices_are_sorted
+      {0, 1},  // std::vector<update_window_dims>
+      2,       // num_update_window_dims
+      {0},     // std::vector<inserted_window_dims>
+      1,       // num_inserted_window_dims
+      {1, 0},  // std::vector<scatter_dims_to_operand_dims>
+      2,       // num_scatter_dims_to_operand_dims
+      2,       // index_vector_dim
+      false,   // unique_indices
+      1        // update_computation_subgraph_index
+  };
+  StablehloScatterOpModel model(
+      {TensorType_FLOAT32, {3, 4, 2}}, {TensorType_INT64, {2, 3, 2}},
+      {TensorType_FLOAT32, {2, 2, 2, 3}}, params, op_type);
+  model.SetInput<float>({1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12,
+                         13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24});
+  model.SetIndices<int64_t>({0, 2, 1, 0, 2, 1, 0, 1, 1, 0, 0, 9});
+  model.SetUpdates<float>(
+      {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2});
+
+  ASSERT_EQ(model.Invoke(), kTfLiteOk);
+  std::vector<float> expected_values = {1,  2,  7,  8,  9,  10, 7,  8,
+                                        11, 12, 13, 14, 15, 16, 17, 18,
+                                        19, 20, 21, 22, 21, 22, 23, 24};
+  EXPECT_THAT(model.GetOutput<float>(), ElementsAreArray(expected_values));
+}
+
 TEST(StablehloScatterOpTest, PerformsMultiplication) {
   StablehloScatterOpType op_type = StablehloScatterOpType::kMul;
 
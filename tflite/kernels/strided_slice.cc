@@ -23,6 +23,7 @@ limitations under the License.
 #include <vector>
 
 #include "Eigen/Core"
+#include "tflite/builtin_ops.h"
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
 #include "tflite/kernels/internal/compatibility.h"
@@ -31,6 +32,7 @@ limitations under the License.
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/internal/types.h"
 #include "tflite/kernels/kernel_util.h"
+#include "tflite/tensor_views.h"
 
 namespace tflite {
 namespace ops {
@@ -368,6 +370,11 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   if (op_data->noop) {
     return kTfLiteOk;
   }
+  // The output is already in the input if it is a view of it.
+  if (!IsDynamicTensor(op_context.output) &&
+      HasPlannedTensorViews(kTfLiteBuiltinStridedSlice, *context, *node)) {
+    return kTfLiteOk;
+  }
   return EvalImpl<kernel_type>(context, node);
 }
 
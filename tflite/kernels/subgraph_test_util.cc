@@ -1745,6 +1745,72 @@ void SubgraphBuilder::BuildWhileSubgraph(Subgraph* subgraph) {
                                   while_reg, &node_index);
 }
 
+void SubgraphBuilder::BuildWhileAfterIntermediateSubgraph(
+    Subgraph* subgraph) {
+  const int kInput = 0;
+  const int kInputCounter = 1;
+  const int kInputValue = 2;
+  const int kIntermediateTensor = 3;
+  const int kOutput = 4;
+  const int kOutputCounter = 5;
+  const int kOutputValue = 6;
+  const int kTensorCount = 7;
+
+  // kInput(0) --> +-----+ --> kIntermediateTensor(3) --> +-----+
+  //               | ADD |                                | ADD |
+  // kInput(0) --> +-----+                   kInput(0) --> +-----+
+  //                                                          |
+  //                                                          v
+  //                                                      kOutput(4)
+  //
+  // kInputCounter(1) --> +-------+ --> kOutputCounter(5)
+  //                      | WHILE |
+  // kInputValue(2)   --> +-------+ --> kOutputValue(6)
+
+  int first_new_tensor_index;
+  ASSERT_EQ(subgraph->AddTensors(kTensorCount, &first_new_tensor_index),
+            kTfLiteOk);
+  ASSERT_EQ(first_new_tensor_index, 0);
+  ASSERT_EQ(subgraph->SetInputs({kInput, kInputCounter, kInputValue}),
+            kTfLiteOk);
+  ASSERT_EQ(subgraph->SetOutputs({kOutput, kOutputCounter, kOutputValue}),
+            kTfLiteOk);
+
+  for (int i = 0; i < kTensorCount; ++i) {
+    SetupTensor(subgraph, i, kTfLiteInt32);
+  }
+
+  int node_index;
+  auto* add_reg0 = ops::builtin::Register_ADD();
+  add_reg0->builtin_code = kTfLiteBuiltinAdd;
+  TfLiteAddParams* add_params =
+      reinterpret_cast<TfLiteAddParams*>(malloc(sizeof(TfLiteAddParams)));
+  add_params->activation = kTfLiteActNone;
+  add_params->pot_scale_int16 = false;
+  subgraph->AddNodeWithParameters({kInput, kInput}, {kIntermediateTensor}, {},
+                                  nullptr, 0, add_params, add_reg0,
+                                  &node_index);
+  auto* add_reg1 = ops::builtin::Register_ADD();
+  add_reg1->builtin_code = kTfLiteBuiltinAdd;
+  add_params =
+      reinterpret_cast<TfLiteAddParams*>(malloc(sizeof(TfLiteAddParams)));
+  add_params->activation = kTfLiteActNone;
+  add_params->pot_scale_int16 = false;
+  subgraph->AddNodeWithParameters({kIntermediateTensor, kInput}, {kOutput},
+                                  {}, nullptr, 0, add_params, add_reg1,
+                                  &node_index);
+
+  TfLiteWhileParams* while_params =
+      reinterpret_cast<TfLiteWhileParams*>(malloc(sizeof(TfLiteWhileParams)));
+  while_params->cond_subgraph_index = 1;
+  while_params->body_subgraph_index = 2;
+  auto* while_reg = ops::builtin::Register_WHILE();
+  while_reg->builtin_code = kTfLiteBuiltinWhile;
+  subgraph->AddNodeWithParameters({kInputCounter, kInputValue},
+                                  {kOutputCounter, kOutputValue}, {}, nullptr,
+                                  0, while_params, while_reg, &node_index);
+}
+
 void SubgraphBuilder::BuildAssignRandomValueToVariableSubgraph(
     Subgraph* subgraph) {
   const int kConstResourceId = 0;
@@ -247,6 +247,13 @@ class SubgraphBuilder {
   // 2 inputs, 2 outputs.
   void BuildWhileSubgraph(Subgraph* subgraph);
 
+  // Build a subgraph with two Add ops followed by a While op, so that the
+  // intermediate tensor of the Add ops is free while the While op runs.
+  // 3 inputs, 3 outputs.
+  //   Equivalent to (x, counter, value) ->
+  //                 (x + x + x, While(counter, value)).
+  void BuildWhileAfterIntermediateSubgraph(Subgraph* subgraph);
+
   // Build a subgraph that assigns a random value to a variable.
   // No input/output.
   void BuildAssignRandomValueToVariableSubgraph(Subgraph* graph);
@@ -20,6 +20,8 @@ limitations under the License.
 
 #include "tflite/core/c/c_api_types.h"
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/cpu_backend_threadpool.h"
 #include "tflite/kernels/internal/compatibility.h"
 #include "tflite/kernels/internal/tensor.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
@@ -95,111 +97,218 @@ TfLiteStatus ResizeOutput(TfLiteContext* context, TfLiteNode* node) {
   return kTfLiteOk;
 }
 
-// Class that collects indices of top k values.  Based on template
-// tensorflow::gtl::TopN<> but, for optimization, it re-uses the same container.
-template <typename T, typename Tidx>
-class TopContainer {
- public:
-  TopContainer() = delete;
-  TopContainer(int32 k, int32 row_size) : k_(k) {
-    container_.reserve(std::min(k, row_size) + 1);
-  }
+// Keys ordering the values of a row like the values themselves.
+template <typename T>
+struct ValueKey {
+  T operator()(T value) const { return value; }
+};
 
-  void start_collecting(const T* values) {
-    values_ = values;
-    container_.clear();
-    is_heap_ = false;
+// float16 and bfloat16 values are compared through their bits, without
+// converting them to float.
+struct HalfKey {
+  // Maps the sign and magnitude of the bits to a signed integer, -0 and +0
+  // both mapping to 0.
+  int32_t operator()(uint16_t bits) const {
+    const int32_t magnitude = bits & 0x7fff;
+    return (bits & 0x8000) ? -magnitude : magnitude;
   }
+};
 
-  void push(Tidx a) {
-    auto comparator = [this](Tidx a, Tidx b) { return compare_fun(a, b); };
-    if (!is_heap_) {
-      container_.push_back(a);
-      if (container_.size() == k_ + 1) {
-        std::make_heap(container_.begin(), container_.end(), comparator);
-        std::pop_heap(container_.begin(), container_.end(), comparator);
-        container_.pop_back();
-        is_heap_ = true;
+// Values are checked against the selection threshold by blocks, with a loop
+// the compiler can vectorize, before the few values above it are collected.
+constexpr int kBlockSize = 64;
+// The capacity of the candidates kept while selecting, at least 2 * k, so that
+// they are narrowed down at most once every k new candidates.
+constexpr int kMinCandidates = 256;
+// The minimum number of values searched by each task of the thread pool.
+constexpr int kMinValuesPerTask = 65536;
+
+// Collects into `top` the indices of the (up to) k largest values of
+// values[begin, end), from the largest to the smallest, ties being broken in
+// favor of earlier indices.
+//
+// The candidates are the values above a threshold, the smallest of the top k
+// values among the candidates so far. When there are too many of them, they
+// are narrowed down to the top k with nth_element(), which raises the
+// threshold. Later values equal to the threshold lose their ties.
+template <typename T, typename Tidx, typename GetKey>
+void SelectTopK(const T* values, int32 begin, int32 end, int32 k,
+                GetKey get_key, std::vector<Tidx>* top) {
+  using Key = decltype(get_key(values[0]));
+  auto comparator = [&](Tidx a, Tidx b) {
+    const Key key_a = get_key(values[a]);
+    const Key key_b = get_key(values[b]);
+    return key_b < key_a || (!(key_a < key_b) && a < b);
+  };
+  top->clear();
+  if (k <= 0 || begin >= end) {
+    return;
+  }
+  const size_t capacity = std::max(2 * k, kMinCandidates);
+  top->reserve(capacity);
+  bool has_threshold = false;
+  Key threshold{};
+  auto narrow_down = [&]() {
+    std::nth_element(top->begin(), top->begin() + (k - 1), top->end(),
+                     comparator);
+    top->resize(k);
+    threshold = get_key(values[top->back()]);
+    has_threshold = true;
+  };
+  for (int32 i = begin; i < end;) {
+    const int32 block_end = std::min(end, i + kBlockSize);
+    if (has_threshold) {
+      // Full blocks have a constant trip count, for the loop to be vectorized
+      // without an epilogue.
+      int num_above_threshold = 0;
+      if (block_end - i == kBlockSize) {
+        const T* block = values + i;
+        for (int j = 0; j < kBlockSize; ++j) {
+          num_above_threshold += threshold < get_key(block[j]);
+        }
+      } else {
+        for (int32 j = i; j < block_end; ++j) {
+          num_above_threshold += threshold < get_key(values[j]);
+        }
+      }
+      if (num_above_threshold == 0) {
+        i = block_end;
+        continue;
       }
-    } else if (comparator(a, container_.front())) {
-      // Due to how we defined comparator / compare_fun, container_.front()
-      // contains the index of the smallest of the top-k elements seen so far.
-      //
-      // If control reaches this point, we know that the current index a
-      // corresponds to an element which is bigger than the smallest of the
-      // top-k elements seen so far.  Hence, we have to update the indices of
-      // the top-k elements, by removing the index of the smallest top-k
-      // element, adding a, and making sure container_[0:k] is still a heap.
-      std::pop_heap(container_.begin(), container_.end(), comparator);
-      container_.back() = a;
-      std::push_heap(container_.begin(), container_.end(), comparator);
     }
-  }
-
-  const std::vector<Tidx>& sorted_result() {
-    auto comparator = [this](Tidx a, Tidx b) { return compare_fun(a, b); };
-    if (!is_heap_) {
-      // Note: due to the way we defined compare_fun (see comments for that
-      // function) std::sort puts the indices from container_ in decreasing
-      // order of the corresponding elements.
-      std::sort(container_.begin(), container_.end(), comparator);
-    } else {
-      std::sort_heap(container_.begin(), container_.end(), comparator);
+    for (; i < block_end; ++i) {
+      if (!has_threshold || threshold < get_key(values[i])) {
+        top->push_back(i);
+        if (top->size() == capacity) {
+          narrow_down();
+        }
+      }
     }
-    return container_;
   }
+  if (top->size() > static_cast<size_t>(k)) {
+    narrow_down();
+  }
+  std::sort(top->begin(), top->end(), comparator);
+}
 
- private:
-  const int32 k_;
-
-  // container_[0,k) holds the indices of the largest k elements from values_
-  // seen so far.  If more than k elements are pushed, then elements are
-  // maintained in a min-heap order: container_.front() is
-  // the index of the smallest of the top-k elements see so far.
-  std::vector<Tidx> container_;
-
-  // Once more than k elements are pushed, the container becomes a min heap,
-  // and is_heap_ becomes true.
-  bool is_heap_ = false;
-
-  const T* values_ = nullptr;
-
-  // Compares indices a and b based on the corresponding elements from values_.
-  //
-  // Intuitively, compare_fun(a, b) returns true iff values_[b] < values_[a]
-  // (notice the inversion of direction, not a typo); ties (==) are broken in
-  // favor of earlier elements (i.e., a < b).
-  bool compare_fun(Tidx a, Tidx b) const {
-    if (values_[b] < values_[a]) {
-      return true;
-    } else if (values_[b] > values_[a]) {
-      return false;
-    } else {
-      return a < b;
+// Selects the top k values of rows [begin_row, end_row).
+template <typename T, typename Tidx, typename GetKey>
+struct TopKRowsTask : cpu_backend_threadpool::Task {
+  TopKRowsTask(int32 row_size, const T* data, int32 k, Tidx* output_indexes,
+               T* output_values, int begin_row, int end_row)
+      : row_size(row_size),
+        data(data),
+        k(k),
+        output_indexes(output_indexes),
+        output_values(output_values),
+        begin_row(begin_row),
+        end_row(end_row) {}
+
+  void Run() override {
+    std::vector<Tidx> top;
+    for (int row = begin_row; row < end_row; ++row) {
+      const T* values_row = data + static_cast<int64_t>(row) * row_size;
+      SelectTopK(values_row, 0, row_size, k, GetKey(), &top);
+      std::copy(top.begin(), top.end(), output_indexes + row * k);
+      std::transform(top.begin(), top.end(), output_values + row * k,
+                     [values_row](const Tidx loc) { return values_row[loc]; });
     }
   }
+
+  const int32 row_size;
+  const T* data;
+  const int32 k;
+  Tidx* output_indexes;
+  T* output_values;
+  const int begin_row;
+  const int end_row;
+};
+
+// Selects the top k values of the part [begin, end) of a row, to be merged
+// with those of the other parts.
+template <typename T, typename Tidx, typename GetKey>
+struct TopKPartTask : cpu_backend_threadpool::Task {
+  TopKPartTask(const T* values, int32 k, int32 begin, int32 end)
+      : values(values), k(k), begin(begin), end(end) {}
+
+  void Run() override { SelectTopK(values, begin, end, k, GetKey(), &top); }
+
+  const T* values;
+  const int32 k;
+  const int32 begin;
+  const int32 end;
+  std::vector<Tidx> top;
 };
 
 // Mostly modeled on tensorflow/core/kernels/topk_op.cc for CPU.
-template <typename T, typename Tidx = int32>
+//
+// The rows are split among the threads of `cpu_backend_context`. When there
+// are fewer rows than threads, e.g. for the logits of a single decoding step,
+// the rows are split into parts instead, whose top k values are merged.
+template <typename T, typename Tidx = int32, typename GetKey = ValueKey<T>>
 void TopK(int32 row_size, int32 num_rows, const T* data, int32 k,
-          Tidx* output_indexes, T* output_values) {
-  TopContainer<T, Tidx> topc(k, row_size);
-  for (int row = 0; row < num_rows; ++row) {
-    const T* values_row = data + row * row_size;
-    topc.start_collecting(values_row);
-    for (int32 c = 0; c < row_size; ++c) {
-      topc.push(c);
+          Tidx* output_indexes, T* output_values,
+          CpuBackendContext* cpu_backend_context) {
+  const int64_t num_values = static_cast<int64_t>(row_size) * num_rows;
+  const int max_tasks = static_cast<int>(
+      std::min<int64_t>(cpu_backend_context->max_num_threads(),
+                        num_values / kMinValuesPerTask));
+  if (max_tasks <= 1 || num_rows >= max_tasks) {
+    const int num_tasks = std::max(1, std::min(max_tasks, num_rows));
+    std::vector<TopKRowsTask<T, Tidx, GetKey>> tasks;
+    tasks.reserve(num_tasks);
+    int begin_row = 0;
+    for (int i = 0; i < num_tasks; ++i) {
+      const int end_row = begin_row + (num_rows - begin_row) / (num_tasks - i);
+      tasks.emplace_back(row_size, data, k, output_indexes, output_values,
+                         begin_row, end_row);
+      begin_row = end_row;
+    }
+    if (num_tasks == 1) {
+      tasks[0].Run();
+    } else {
+      cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                      cpu_backend_context);
     }
+    return;
+  }
 
-    // Prepare output buffers.
+  const int num_parts = max_tasks;
+  std::vector<TopKPartTask<T, Tidx, GetKey>> tasks;
+  tasks.reserve(num_parts);
+  std::vector<Tidx> candidates;
+  std::vector<T> candidate_values;
+  std::vector<Tidx> top;
+  for (int row = 0; row < num_rows; ++row) {
+    const T* values_row = data + static_cast<int64_t>(row) * row_size;
+    tasks.clear();
+    int32 begin = 0;
+    for (int i = 0; i < num_parts; ++i) {
+      const int32 end = begin + (row_size - begin) / (num_parts - i);
+      tasks.emplace_back(values_row, k, begin, end);
+      begin = end;
+    }
+    cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                    cpu_backend_context);
+    // The candidates of the parts are sorted, so equal values come in the
+    // order of their indices in the row, and the ties among them are broken
+    // the same way.
+    candidates.clear();
+    candidate_values.clear();
+    for (const auto& task : tasks) {
+      for (const Tidx index : task.top) {
+        candidates.push_back(index);
+        candidate_values.push_back(values_row[index]);
+      }
+    }
+    SelectTopK(candidate_values.data(), 0,
+               static_cast<int32>(candidate_values.size()), k, GetKey(), &top);
     Tidx* indexes_row = output_indexes + row * k;
     T* output_row = output_values + row * k;
-    // We always assume that the output is sorted.
-    const auto& top_k = topc.sorted_result();
-    std::copy(top_k.begin(), top_k.end(), indexes_row);
-    std::transform(top_k.begin(), top_k.end(), output_row,
-                   [values_row](const int32 loc) { return values_row[loc]; });
+    for (int i = 0; i < static_cast<int>(top.size()); ++i) {
+      indexes_row[i] = candidates[top[i]];
+      output_row[i] = values_row[indexes_row[i]];
+    }
   }
 }
 
@@ -256,30 +365,41 @@ TfLiteStatus TopKImpl(TfLiteContext* context, TfLiteNode* node, int32_t k,
   for (int i = 0; i < input->dims->size - 1; ++i) {
     num_rows *= input->dims->data[i];
   }
+  CpuBackendContext* cpu_backend_context =
+      CpuBackendContext::GetFromContext(context);
   switch (output_values->type) {
     case kTfLiteFloat32:
       TopK(row_size, num_rows, GetTensorData<float>(input), k, output_indexes,
-           GetTensorData<float>(output_values));
+           GetTensorData<float>(output_values), cpu_backend_context);
       break;
     case kTfLiteUInt8:
       TopK(row_size, num_rows, GetTensorData<uint8_t>(input), k, output_indexes,
-           output_values->data.uint8);
+           output_values->data.uint8, cpu_backend_context);
       break;
     case kTfLiteInt8:
       TopK(row_size, num_rows, GetTensorData<int8_t>(input), k, output_indexes,
-           output_values->data.int8);
+           output_values->data.int8, cpu_backend_context);
       break;
     case kTfLiteInt16:
       TopK(row_size, num_rows, GetTensorData<int16_t>(input), k, output_indexes,
-           output_values->data.i16);
+           output_values->data.i16, cpu_backend_context);
       break;
     case kTfLiteInt32:
       TopK(row_size, num_rows, GetTensorData<int32_t>(input), k, output_indexes,
-           output_values->data.i32);
+           output_values->data.i32, cpu_backend_context);
       break;
     case kTfLiteInt64:
       TopK(row_size, num_rows, GetTensorData<int64_t>(input), k, output_indexes,
-           output_values->data.i64);
+           output_values->data.i64, cpu_backend_context);
+      break;
+    case kTfLiteFloat16:
+    case kTfLiteBFloat16:
+      TopK<uint16_t, idx_type, HalfKey>(
+          row_size, num_rows,
+          reinterpret_cast<const uint16_t*>(input->data.raw), k,
+          output_indexes,
+          reinterpret_cast<uint16_t*>(output_values->data.raw),
+          cpu_backend_context);
       break;
     default:
       TF_LITE_KERNEL_LOG(context, "Type %s is currently not supported by TopK.",
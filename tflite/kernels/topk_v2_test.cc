@@ -36,8 +36,8 @@ template <typename InputType>
 class TopKV2OpModel : public SingleOpModel {
  public:
   TopKV2OpModel(int top_k, std::initializer_list<int> input_shape,
-                std::initializer_list<InputType> input_data,
-                TestType input_tensor_types) {
+                const std::vector<InputType>& input_data,
+                TestType input_tensor_types, int num_threads = -1) {
     input_ = AddInput(GetTensorType<InputType>());
     if (input_tensor_types == TestType::kDynamic) {
       top_k_ = AddInput(TensorType_INT32);
@@ -47,7 +47,9 @@ class TopKV2OpModel : public SingleOpModel {
     output_values_ = AddOutput(GetTensorType<InputType>());
     output_indexes_ = AddOutput(TensorType_INT32);
     SetBuiltinOp(BuiltinOperator_TOPK_V2, BuiltinOptions_TopKV2Options, 0);
-    BuildInterpreter({input_shape, {1}});
+    BuildInterpreter({input_shape, {1}}, num_threads,
+                     /*allow_fp32_relax_to_fp16=*/false,
+                     /*apply_delegate=*/true);
 
     PopulateTensor<InputType>(input_, input_data);
     if (input_tensor_types == TestType::kDynamic) {
@@ -145,5 +147,64 @@ TEST_P(TopKV2OpTest, TypeInt64) {
   EXPECT_THAT(m.GetValues(), ElementsAreArray({3, 2, -1, -2}));
 }
 
+template <typename T>
+std::vector<T> ToHalf(std::initializer_list<float> values) {
+  std::vector<T> result;
+  for (const float value : values) {
+    result.push_back(static_cast<T>(value));
+  }
+  return result;
+}
+
+template <typename T>
+std::vector<float> ToFloat(const std::vector<T>& values) {
+  return std::vector<float>(values.begin(), values.end());
+}
+
+TEST_P(TopKV2OpTest, TypeFloat16) {
+  TopKV2OpModel<Eigen::half> m(
+      3, {2, 4},
+      ToHalf<Eigen::half>({-2.0, 0.0, -0.0, 1.5, 3.0, -1.0, 2.0, 3.0}),
+      GetParam());
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetIndexes(), ElementsAreArray({3, 1, 2, 0, 3, 2}));
+  EXPECT_THAT(ToFloat(m.GetValues()),
+              ElementsAreArray({1.5, 0.0, 0.0, 3.0, 3.0, 2.0}));
+}
+
+TEST_P(TopKV2OpTest, TypeBFloat16) {
+  TopKV2OpModel<Eigen::bfloat16> m(
+      2, {2, 3}, ToHalf<Eigen::bfloat16>({-2.0, -3.0, -1.0, 8.0, 0.5, 64.0}),
+      GetParam());
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetIndexes(), ElementsAreArray({2, 0, 2, 0}));
+  EXPECT_THAT(ToFloat(m.GetValues()),
+              ElementsAreArray({-1.0, -2.0, 64.0, 8.0}));
+}
+
+// Large rows are split among the threads, so equal values must keep their
+// order across the parts.
+TEST_P(TopKV2OpTest, LargeRowsWithThreads) {
+  constexpr int kRowSize = 300000;
+  for (const int num_rows : {1, 3}) {
+    std::vector<float> input(num_rows * kRowSize);
+    for (int i = 0; i < static_cast<int>(input.size()); ++i) {
+      input[i] = (i % kRowSize) % 97;
+    }
+    TopKV2OpModel<float> m(10, {num_rows, kRowSize}, input, GetParam(),
+                           /*num_threads=*/4);
+    ASSERT_EQ(m.Invoke(), kTfLiteOk);
+    std::vector<int32_t> expected_indexes;
+    for (int row = 0; row < num_rows; ++row) {
+      for (int i = 0; i < 10; ++i) {
+        expected_indexes.push_back(96 + 97 * i);
+      }
+    }
+    EXPECT_THAT(m.GetIndexes(), ElementsAreArray(expected_indexes));
+    EXPECT_THAT(m.GetValues(),
+                ElementsAreArray(std::vector<float>(num_rows * 10, 96)));
+  }
+}
+
 }  // namespace
 }  // namespace tflite
@@ -20,6 +20,8 @@ limitations under the License.
 #include <memory>
 
 #include "tflite/core/c/common.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/internal/optimized/transpose.h"
 #include "tflite/kernels/internal/portable_tensor_utils.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/internal/types.h"
@@ -30,6 +32,12 @@ namespace ops {
 namespace builtin {
 namespace transpose {
 
+// This file has two implementations of Transpose.
+enum KernelType {
+  kReference,
+  kGenericOptimized,
+};
+
 struct TransposeContext {
   TransposeContext(TfLiteContext* context, TfLiteNode* node) {
     input = GetInput(context, node, 0);
@@ -88,6 +96,23 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   return ResizeOutputTensor(context, &op_context);
 }
 
+// Transposes with the reference kernel, or the optimized kernel spread over
+// the threads of the context.
+template <KernelType kernel_type, typename T>
+void TransposeData(TfLiteContext* context, const TransposeParams& params,
+                   const RuntimeShape& input_shape, const T* input_data,
+                   const RuntimeShape& output_shape, T* output_data) {
+  if (kernel_type == kReference) {
+    reference_ops::Transpose(params, input_shape, input_data, output_shape,
+                             output_data);
+  } else {
+    optimized_ops::Transpose(params, input_shape, input_data, output_shape,
+                             output_data,
+                             CpuBackendContext::GetFromContext(context));
+  }
+}
+
+template <KernelType kernel_type>
 TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   TransposeContext op_context(context, node);
 
@@ -105,11 +130,12 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
     if (perm < 0) perm += size;
     params.perm[i] = perm;
   }
-#define TF_LITE_TRANSPOSE(type, scalar)                     \
-  type::Transpose(params, GetTensorShape(op_context.input), \
-                  GetTensorData<scalar>(op_context.input),  \
-                  GetTensorShape(op_context.output),        \
-                  GetTensorData<scalar>(op_context.output))
+#define TF_LITE_TRANSPOSE(scalar)                                 \
+  TransposeData<kernel_type>(                                     \
+      context, params, GetTensorShape(op_context.input),          \
+      GetTensorData<scalar>(op_context.input),                    \
+      GetTensorShape(op_context.output),                          \
+      GetTensorData<scalar>(op_context.output))
 
   // Transpose kernel only does rearranging values not numeric evaluations on
   // each cell. It's safe to implement per size of scalar type and this trick
@@ -117,17 +143,17 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   switch (op_context.input->type) {
     case kTfLiteFloat32:
     case kTfLiteInt32:
-      TF_LITE_TRANSPOSE(reference_ops, int32_t);
+      TF_LITE_TRANSPOSE(int32_t);
       break;
     case kTfLiteBool:
       if (sizeof(bool) != 1) {
-        TF_LITE_TRANSPOSE(reference_ops, bool);
+        TF_LITE_TRANSPOSE(bool);
         break;
       }
       [[fallthrough]];
     case kTfLiteUInt8:
     case kTfLiteInt8:
-      TF_LITE_TRANSPOSE(reference_ops, int8_t);
+      TF_LITE_TRANSPOSE(int8_t);
       break;
     case kTfLiteInt4: {
       const size_t bytes_unpacked = op_context.input->bytes * 2;
@@ -138,9 +164,10 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
           GetTensorData<int8_t>(op_context.input),
           GetTensorShape(op_context.input).FlatSize(),
           /*bit_width=*/4, unpacked_input_data.get());
-      reference_ops::Transpose(
-          params, GetTensorShape(op_context.input), unpacked_input_data.get(),
-          GetTensorShape(op_context.output), unpacked_output_data.get());
+      TransposeData<kernel_type>(
+          context, params, GetTensorShape(op_context.input),
+          unpacked_input_data.get(), GetTensorShape(op_context.output),
+          unpacked_output_data.get());
       // Pack the output back to int4.
       tflite::tensor_utils::PackInt8IntoDenseInt(
           unpacked_output_data.get(),
@@ -149,10 +176,10 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
       break;
     }
     case kTfLiteInt16:
-      TF_LITE_TRANSPOSE(reference_ops, int16_t);
+      TF_LITE_TRANSPOSE(int16_t);
       break;
     case kTfLiteInt64:
-      TF_LITE_TRANSPOSE(reference_ops, int64_t);
+      TF_LITE_TRANSPOSE(int64_t);
       break;
     default:
       TF_LITE_KERNEL_LOG(context,
@@ -169,11 +196,19 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 
 TfLiteRegistration* Register_TRANSPOSE_REF() {
   static TfLiteRegistration r = {nullptr, nullptr, transpose::Prepare,
-                                 transpose::Eval};
+                                 transpose::Eval<transpose::kReference>};
   return &r;
 }
 
-TfLiteRegistration* Register_TRANSPOSE() { return Register_TRANSPOSE_REF(); }
+TfLiteRegistration* Register_TRANSPOSE_GENERIC_OPT() {
+  static TfLiteRegistration r = {nullptr, nullptr, transpose::Prepare,
+                                 transpose::Eval<transpose::kGenericOptimized>};
+  return &r;
+}
+
+TfLiteRegistration* Register_TRANSPOSE() {
+  return Register_TRANSPOSE_GENERIC_OPT();
+}
 
 }  // namespace builtin
 }  // namespace ops
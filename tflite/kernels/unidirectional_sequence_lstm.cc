@@ -54,6 +54,9 @@ struct OpData {
   bool recurrent_to_cell_is_diag = false;
   bool recurrent_to_output_is_diag = false;
 
+  // If the input products of blocks of time steps are computed ahead.
+  bool use_input_products = false;
+
   lstm_eval::IntegerLstmParameter integer_lstm_param;
 };
 
@@ -413,6 +416,18 @@ enum TemporaryTensor {
   kNumTemporaryTensors = 12,
 };
 
+// Temporary tensors of the float and the integer kernels, after their scratch
+// buffers, which reuse the first indices above.
+enum InputProductsTemporaryTensor {
+  kFloatInputProducts = 1,
+  kIntegerInputProducts = 6,
+  kIntegerInputProductsScratch = 7,
+};
+
+// Number of time steps whose products of the input weights by the inputs are
+// computed with one matrix multiplication per gate.
+constexpr int kInputProductsTimeSteps = 32;
+
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
   auto* op_data = new OpData();
   context->AddTensors(context, kNumTemporaryTensors,
@@ -924,6 +939,7 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
       reinterpret_cast<TfLiteUnidirectionalSequenceLSTMParams*>(
           node->builtin_data);
   const bool time_major = params->time_major;
+  const int max_time = time_major ? input->dims->data[0] : input->dims->data[1];
   const int n_batch = time_major ? input->dims->data[1] : input->dims->data[0];
   const int n_input = input->dims->data[2];
 
@@ -990,13 +1006,21 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
     TF_LITE_ENSURE(context, num_intermediate_tensors == 5);
   }
 
+  // The float and integer kernels compute the input products ahead, unless
+  // there is a single time step.
+  op_data->use_input_products =
+      max_time > 1 &&
+      (is_integer || input_to_output_weights->type == kTfLiteFloat32);
+
   TfLiteIntArrayFree(node->temporaries);
   if (IsHybridOp(input, input_to_output_weights)) {
     node->temporaries = TfLiteIntArrayCreate(kNumTemporaryTensors);
   } else if (is_integer) {
-    node->temporaries = TfLiteIntArrayCreate(6);
+    node->temporaries = TfLiteIntArrayCreate(
+        op_data->use_input_products ? kIntegerInputProductsScratch + 1 : 6);
   } else {
-    node->temporaries = TfLiteIntArrayCreate(1);
+    node->temporaries = TfLiteIntArrayCreate(
+        op_data->use_input_products ? kFloatInputProducts + 1 : 1);
   }
   node->temporaries->data[kScratchBuffer] =
       scratch_tensor_index + kScratchBuffer;
@@ -1254,6 +1278,55 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
                                    context, op_data, node));
   }
 
+  if (op_data->use_input_products) {
+    // Allocate the input products of kInputProductsTimeSteps time steps for
+    // each gate, and for the integer kernel a 32bit buffer to compute them.
+    const int num_gates = use_cifg ? 3 : 4;
+    const int block_rows =
+        std::min(max_time, kInputProductsTimeSteps) * n_batch;
+    const int input_products_index =
+        is_integer ? kIntegerInputProducts : kFloatInputProducts;
+    node->temporaries->data[input_products_index] =
+        scratch_tensor_index + input_products_index;
+    TfLiteTensor* input_products;
+    TF_LITE_ENSURE_OK(context,
+                      GetTemporarySafe(context, node, input_products_index,
+                                       &input_products));
+    input_products->type = is_integer ? kTfLiteInt16 : kTfLiteFloat32;
+    input_products->allocation_type = kTfLiteArenaRw;
+    const int input_products_dimension[3] = {num_gates, block_rows, n_cell};
+    if (!TfLiteIntArrayEqualsArray(input_products->dims, 3,
+                                   input_products_dimension)) {
+      TfLiteIntArray* input_products_size = TfLiteIntArrayCreate(3);
+      input_products_size->data[0] = num_gates;
+      input_products_size->data[1] = block_rows;
+      input_products_size->data[2] = n_cell;
+      TF_LITE_ENSURE_OK(context,
+                        context->ResizeTensor(context, input_products,
+                                              input_products_size));
+    }
+    if (is_integer) {
+      node->temporaries->data[kIntegerInputProductsScratch] =
+          scratch_tensor_index + kIntegerInputProductsScratch;
+      TfLiteTensor* input_products_scratch;
+      TF_LITE_ENSURE_OK(
+          context, GetTemporarySafe(context, node, kIntegerInputProductsScratch,
+                                    &input_products_scratch));
+      input_products_scratch->type = kTfLiteInt32;
+      input_products_scratch->allocation_type = kTfLiteArenaRw;
+      const int scratch_dimension[2] = {block_rows, n_cell};
+      if (!TfLiteIntArrayEqualsArray(input_products_scratch->dims, 2,
+                                     scratch_dimension)) {
+        TfLiteIntArray* scratch_size = TfLiteIntArrayCreate(2);
+        scratch_size->data[0] = block_rows;
+        scratch_size->data[1] = n_cell;
+        TF_LITE_ENSURE_OK(context,
+                          context->ResizeTensor(context, input_products_scratch,
+                                                scratch_size));
+      }
+    }
+  }
+
   return kTfLiteOk;
 }
 
@@ -1372,6 +1445,12 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
       TfLiteTensor* scratch_buffer;
       TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node, kScratchBuffer,
                                                   &scratch_buffer));
+      TfLiteTensor* input_products = nullptr;
+      if (op_data->use_input_products) {
+        TF_LITE_ENSURE_OK(context,
+                          GetTemporarySafe(context, node, kFloatInputProducts,
+                                           &input_products));
+      }
       return lstm_eval::EvalFloat(
           input, input_to_input_weights, input_to_forget_weights,
           input_to_cell_weights, input_to_output_weights,
@@ -1398,7 +1477,7 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
           (recurrent_to_cell_weights->dims->size == 1),
           /*recurrent_to_output_is_diag=*/
           (recurrent_to_output_weights->dims->size == 1),
-          CpuBackendContext::GetFromContext(context));
+          CpuBackendContext::GetFromContext(context), input_products);
     }
     case kTfLiteUInt8:
     case kTfLiteInt8: {
@@ -1485,6 +1564,17 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
         TfLiteTensor* scratch5;
         TF_LITE_ENSURE_OK(context,
                           GetTemporarySafe(context, node, 5, &scratch5));
+        TfLiteTensor* input_products = nullptr;
+        TfLiteTensor* input_products_scratch = nullptr;
+        if (op_data->use_input_products) {
+          TF_LITE_ENSURE_OK(
+              context, GetTemporarySafe(context, node, kIntegerInputProducts,
+                                        &input_products));
+          TF_LITE_ENSURE_OK(context, GetTemporarySafe(
+                                         context, node,
+                                         kIntegerInputProductsScratch,
+                                         &input_products_scratch));
+        }
         return lstm_eval::EvalInteger8x8_16(
             input, input_to_input_weights, input_to_forget_weights,
             input_to_cell_weights, input_to_output_weights,
@@ -1498,7 +1588,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
             projection_bias, &lstm_params, /*forward_sequence=*/true,
             time_major, &op_data->integer_lstm_param, output_state, cell_state,
             output, scratch0, scratch1, scratch2, scratch3, scratch4, scratch5,
-            CpuBackendContext::GetFromContext(context));
+            CpuBackendContext::GetFromContext(context), input_products,
+            input_products_scratch);
       }
     }
     default:
@@ -14,6 +14,8 @@ limitations under the License.
 ==============================================================================*/
 // Unit test for TFLite Sequential LSTM op.
 
+#include <cmath>
+#include <memory>
 #include <tuple>
 #include <vector>
 
@@ -229,6 +231,93 @@ TEST_F(NoCifgNoPeepholeNoProjectionNoClippingUnidirectionalLstmTest,
   VerifyGoldens(lstm_input_, lstm_golden_output_, &lstm);
 }
 
+// The input products of a sequence are computed ahead for blocks of time
+// steps, which must not change the outputs of a sequence longer than a block.
+TEST_F(NoCifgNoPeepholeNoProjectionNoClippingUnidirectionalLstmTest,
+       LongSequenceMatchesStepByStep) {
+  const int n_batch = 2;
+  const int n_input = 2;
+  // n_cell and n_output have the same size when there is no projection.
+  const int n_cell = 4;
+  const int n_output = 4;
+  const int sequence_length = 75;
+
+  auto make_lstm = [&](int num_steps) {
+    auto lstm = std::make_unique<UnidirectionalLSTMOpModel>(
+        n_batch, n_input, n_cell, n_output, num_steps,
+        /*time_major=*/true, /*use_cifg=*/false, /*use_peephole=*/false,
+        /*use_projection_weights=*/false,
+        /*use_projection_bias=*/false,
+        /*cell_clip=*/0.0, /*proj_clip=*/0.0,
+        std::vector<std::vector<int>>{
+            {num_steps, n_batch, n_input},  // input tensor
+
+            {n_cell, n_input},  // input_to_input_weight tensor
+            {n_cell, n_input},  // input_to_forget_weight tensor
+            {n_cell, n_input},  // input_to_cell_weight tensor
+            {n_cell, n_input},  // input_to_output_weight tensor
+
+            {n_cell, n_output},  // recurrent_to_input_weight tensor
+            {n_cell, n_output},  // recurrent_to_forget_weight tensor
+            {n_cell, n_output},  // recurrent_to_cell_weight tensor
+            {n_cell, n_output},  // recurrent_to_output_weight tensor
+
+            {0},  // cell_to_input_weight tensor
+            {0},  // cell_to_forget_weight tensor
+            {0},  // cell_to_output_weight tensor
+
+            {n_cell},  // input_gate_bias tensor
+            {n_cell},  // forget_gate_bias tensor
+            {n_cell},  // cell_gate_bias tensor
+            {n_cell},  // output_gate_bias tensor
+
+            {0, 0},  // projection_weight tensor
+            {0},     // projection_bias tensor
+
+            {n_batch, n_output},  // output_state tensor
+            {n_batch, n_cell},    // cell_state tensor
+        });
+    lstm->SetInputToInputWeights(input_to_input_weights_);
+    lstm->SetInputToCellWeights(input_to_cell_weights_);
+    lstm->SetInputToForgetWeights(input_to_forget_weights_);
+    lstm->SetInputToOutputWeights(input_to_output_weights_);
+
+    lstm->SetInputGateBias(input_gate_bias_);
+    lstm->SetCellBias(cell_gate_bias_);
+    lstm->SetForgetGateBias(forget_gate_bias_);
+    lstm->SetOutputGateBias(output_gate_bias_);
+
+    lstm->SetRecurrentToInputWeights(recurrent_to_input_weights_);
+    lstm->SetRecurrentToCellWeights(recurrent_to_cell_weights_);
+    lstm->SetRecurrentToForgetWeights(recurrent_to_forget_weights_);
+    lstm->SetRecurrentToOutputWeights(recurrent_to_output_weights_);
+    return lstm;
+  };
+
+  std::vector<float> input(sequence_length * n_batch * n_input);
+  for (int i = 0; i < sequence_length * n_batch * n_input; ++i) {
+    input[i] = std::sin(0.37f * i);
+  }
+
+  auto sequence_lstm = make_lstm(sequence_length);
+  sequence_lstm->SetInput(0, input.data(), input.data() + input.size());
+  ASSERT_EQ(sequence_lstm->Invoke(), kTfLiteOk);
+
+  // The state tensors carry the state of a step to the next invocation.
+  auto step_lstm = make_lstm(/*sequence_length=*/1);
+  std::vector<float> expected;
+  for (int t = 0; t < sequence_length; ++t) {
+    const float* step_input = input.data() + t * n_batch * n_input;
+    step_lstm->SetInput(0, step_input, step_input + n_batch * n_input);
+    ASSERT_EQ(step_lstm->Invoke(), kTfLiteOk);
+    const std::vector<float> step_output = step_lstm->GetOutput();
+    expected.insert(expected.end(), step_output.begin(), step_output.end());
+  }
+
+  EXPECT_THAT(sequence_lstm->GetOutput(),
+              ElementsAreArray(ArrayFloatNear(expected, 1e-5)));
+}
+
 TEST_F(NoCifgNoPeepholeNoProjectionNoClippingUnidirectionalLstmTest,
        LstmBlackBoxTestBatchMajor) {
   const int n_batch = 1;
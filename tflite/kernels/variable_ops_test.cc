@@ -37,6 +37,8 @@ class VariableOpsTest : public ::testing::Test {
     ASSERT_NE(read_registration_, nullptr);
     var_handle_registration_ = ::tflite::ops::builtin::Register_VAR_HANDLE();
     ASSERT_NE(var_handle_registration_, nullptr);
+    add_registration_ = ::tflite::ops::builtin::Register_ADD();
+    ASSERT_NE(add_registration_, nullptr);
 
     ConstructGraph();
   }
@@ -140,9 +142,63 @@ class VariableOpsTest : public ::testing::Test {
                                         read_registration_, &node_index);
   }
 
+  // Reads the variable after an assignment, and uses the value read after
+  // `num_later_assigns` more.
+  void ConstructGraphWithReadBetweenAssigns(int num_later_assigns = 1) {
+    interpreter_ = std::make_unique<Interpreter>();
+    // Construct a graph like this:
+    //   Input: %0
+    //   Output: %4
+    //   %1 = var_handle()
+    //   variable_assign(%1, %0)
+    //   %2 = read(%1)
+    //   %3 = add(%0, %0)
+    //   variable_assign(%1, %3)  // `num_later_assigns` times
+    //   %4 = add(%2, %0)
+
+    int first_new_tensor_index;
+    ASSERT_EQ(interpreter_->AddTensors(5, &first_new_tensor_index), kTfLiteOk);
+    ASSERT_EQ(interpreter_->SetInputs({0}), kTfLiteOk);
+    ASSERT_EQ(interpreter_->SetOutputs({4}), kTfLiteOk);
+    interpreter_->SetTensorParametersReadWrite(1, kTfLiteResource, "", 0,
+                                               nullptr, {}, false);
+    for (int i : {0, 2, 3, 4}) {
+      interpreter_->SetTensorParametersReadWrite(i, kTfLiteFloat32, "", {2},
+                                                 TfLiteQuantization());
+    }
+    int node_index;
+
+    TfLiteVarHandleParams* var_handle_params = GetVarHandleParams();
+    interpreter_->AddNodeWithParameters({}, {1}, nullptr, 0, var_handle_params,
+                                        var_handle_registration_, &node_index);
+    interpreter_->AddNodeWithParameters({1, 0}, {}, nullptr, 0, nullptr,
+                                        assign_registration_, &node_index);
+    interpreter_->AddNodeWithParameters({1}, {2}, nullptr, 0, nullptr,
+                                        read_registration_, &node_index);
+    interpreter_->AddNodeWithParameters({0, 0}, {3}, nullptr, 0,
+                                        GetAddParams(), add_registration_,
+                                        &node_index);
+    for (int i = 0; i < num_later_assigns; ++i) {
+      interpreter_->AddNodeWithParameters({1, 3}, {}, nullptr, 0, nullptr,
+                                          assign_registration_, &node_index);
+    }
+    interpreter_->AddNodeWithParameters({2, 0}, {4}, nullptr, 0,
+                                        GetAddParams(), add_registration_,
+                                        &node_index);
+  }
+
+  TfLiteAddParams* GetAddParams() {
+    TfLiteAddParams* add_params =
+        reinterpret_cast<TfLiteAddParams*>(malloc(sizeof(TfLiteAddParams)));
+    *add_params = {};
+    add_params->activation = kTfLiteActNone;
+    return add_params;
+  }
+
   TfLiteRegistration* assign_registration_;
   TfLiteRegistration* read_registration_;
   TfLiteRegistration* var_handle_registration_;
+  TfLiteRegistration* add_registration_;
   std::unique_ptr<Interpreter> interpreter_;
 };
 
@@ -221,5 +277,41 @@ TEST_F(VariableOpsTest, TestReassignToDifferentSize) {
   }
 }
 
+TEST_F(VariableOpsTest, TestReadAliasesVariableUntilNextAssign) {
+  ConstructGraphWithReadBetweenAssigns();
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  for (int i = 0; i < 2; ++i) {
+    TfLiteTensor* input_data_index = interpreter_->tensor(0);
+    GetTensorData<float>(input_data_index)[0] = 1.0 + i;
+    GetTensorData<float>(input_data_index)[1] = 2.0 + i;
+    ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+
+    // The read points to the variable, and still holds the first value after
+    // the second assignment.
+    EXPECT_EQ(interpreter_->tensor(2)->allocation_type, kTfLiteCustom);
+    TfLiteTensor* output = interpreter_->tensor(4);
+    EXPECT_EQ(GetTensorData<float>(output)[0], 2 * (1.0 + i));
+    EXPECT_EQ(GetTensorData<float>(output)[1], 2 * (2.0 + i));
+  }
+}
+
+TEST_F(VariableOpsTest, TestReadCopiesVariableAssignedTwiceBeforeUse) {
+  ConstructGraphWithReadBetweenAssigns(/*num_later_assigns=*/2);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  for (int i = 0; i < 2; ++i) {
+    TfLiteTensor* input_data_index = interpreter_->tensor(0);
+    GetTensorData<float>(input_data_index)[0] = 1.0 + i;
+    GetTensorData<float>(input_data_index)[1] = 2.0 + i;
+    ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+
+    // The second assignment reuses the buffer of the value read, so the read
+    // holds a copy.
+    EXPECT_EQ(interpreter_->tensor(2)->allocation_type, kTfLiteArenaRw);
+    TfLiteTensor* output = interpreter_->tensor(4);
+    EXPECT_EQ(GetTensorData<float>(output)[0], 2 * (1.0 + i));
+    EXPECT_EQ(GetTensorData<float>(output)[1], 2 * (2.0 + i));
+  }
+}
+
 }  // namespace
 }  // namespace tflite
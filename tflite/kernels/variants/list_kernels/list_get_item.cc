@@ -32,6 +32,20 @@ namespace {
 
 constexpr int kListInput = 0;
 
+struct OpData {
+  // Whether the list input is only read by this node, so that it can be
+  // emptied once copied to the list output.
+  bool list_input_read_once = false;
+};
+
+void* Init(TfLiteContext* ctx, const char* buffer, size_t length) {
+  return new OpData();
+}
+
+void Free(TfLiteContext* ctx, void* buffer) {
+  delete static_cast<OpData*>(buffer);
+}
+
 class GetItemSemantic {
  public:
   GetItemSemantic(TfLiteContext* ctx, TfLiteNode* node)
@@ -85,6 +99,9 @@ class PopBackSemantic {
                       GetOutputSafe(ctx_, node_, kListOutputIdx, &list_output));
     TF_LITE_ENSURE_TYPES_EQ(ctx_, list_output->type, kTfLiteVariant);
     list_output->allocation_type = kTfLiteVariantObject;
+    auto* op_data = static_cast<OpData*>(node_->user_data);
+    op_data->list_input_read_once =
+        IsIntermediateReadOnce(ctx_, node_->inputs->data[kListInput]);
     return kTfLiteOk;
   }
 
@@ -100,8 +117,18 @@ class PopBackSemantic {
                       GetOutputSafe(ctx_, node_, kListOutputIdx, &list_output));
     TensorArray* output_arr = static_cast<TensorArray*>(
         arr->CloneTo(static_cast<VariantData*>(list_output->data.data)));
-    output_arr->Resize(output_arr->NumElements() - 1);
     list_output->data.data = output_arr;
+    // Empty the input if it is not read again, so that the output owns the
+    // elements and drops the last one.
+    if (static_cast<const OpData*>(node_->user_data)->list_input_read_once) {
+      const TfLiteTensor* list_input;
+      TF_LITE_ENSURE_OK(ctx_,
+                        GetInputSafe(ctx_, node_, kListInput, &list_input));
+      auto* input_arr = static_cast<TensorArray*>(
+          static_cast<VariantData*>(list_input->data.data));
+      input_arr->Resize(0);
+    }
+    output_arr->Resize(output_arr->NumElements() - 1);
     return kTfLiteOk;
   }
 
@@ -222,7 +249,7 @@ TfLiteRegistration* Register_LIST_GET_ITEM() {
 }
 
 TfLiteRegistration* Register_LIST_POP_BACK() {
-  static TfLiteRegistration r = {nullptr, nullptr, Prepare<PopBackSemantic>,
+  static TfLiteRegistration r = {Init, Free, Prepare<PopBackSemantic>,
                                  Eval<PopBackSemantic>};
   return &r;
 }
@@ -12,6 +12,7 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
+#include <cstddef>
 #include <utility>
 
 #include "tflite/array.h"
@@ -19,6 +20,7 @@ limitations under the License.
 #include "tflite/core/c/common.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/kernel_util.h"
+#include "tflite/kernels/variants/list_ops_util.h"
 #include "tflite/kernels/variants/tensor_array.h"
 #include "tflite/util.h"
 
@@ -31,6 +33,20 @@ constexpr int kListInputIdx = 0;
 constexpr int kIndexInputIdx = 1;
 constexpr int kListOutputIdx = 0;
 
+struct OpData {
+  // Whether the list input is only read by this node, so that it can be
+  // emptied once copied to the output.
+  bool list_input_read_once = false;
+};
+
+void* Init(TfLiteContext* ctx, const char* buffer, size_t length) {
+  return new OpData();
+}
+
+void Free(TfLiteContext* ctx, void* buffer) {
+  delete static_cast<OpData*>(buffer);
+}
+
 class SetItemSemantic {
  public:
   SetItemSemantic(TfLiteContext* ctx, TfLiteNode* node)
@@ -88,6 +104,10 @@ TfLiteStatus Prepare(TfLiteContext* ctx, TfLiteNode* node) {
 
   TF_LITE_ENSURE_OK(ctx, semantic.CheckIndexInput());
 
+  auto* op_data = static_cast<OpData*>(node->user_data);
+  op_data->list_input_read_once =
+      IsIntermediateReadOnce(ctx, node->inputs->data[kListInputIdx]);
+
   TfLiteTensor* output;
   TF_LITE_ENSURE_OK(ctx, GetOutputSafe(ctx, node, kListOutputIdx, &output));
   TF_LITE_ENSURE_TYPES_EQ(ctx, output->type, kTfLiteVariant);
@@ -118,31 +138,46 @@ TfLiteStatus Eval(TfLiteContext* ctx, TfLiteNode* node) {
   TfLiteTensor* output;
   TF_LITE_ENSURE_OK(ctx, GetOutputSafe(ctx, node, kListOutputIdx, &output));
 
+  // The output shares the buffer of elements of the input. The input is
+  // emptied if it is not read again, so that the output owns the buffer and
+  // updates it in place.
   TensorArray* output_arr = static_cast<TensorArray*>(
       input_arr->CloneTo(static_cast<VariantData*>(output->data.data)));
+  output->data.data = static_cast<VariantData*>(output_arr);
+  if (static_cast<const OpData*>(node->user_data)->list_input_read_once) {
+    input_arr->Resize(0);
+  }
+
+  if (index >= output_arr->NumElements()) {
+    output_arr->Resize(index + 1);
+  }
+
+  // Reuse the element being replaced if nothing else references it and it
+  // has the shape of the item.
+  TfLiteTensor* element = output_arr->MutableAt(index);
+  if (element != nullptr && element->type == item_input->type &&
+      TfLiteIntArrayEqual(element->dims, item_input->dims)) {
+    TF_LITE_ENSURE_OK(ctx, TfLiteTensorCopy(item_input, element));
+    return kTfLiteOk;
+  }
 
   // TODO(b/288302706) Skip copy when tensor is used only once.
   TensorUniquePtr item_copy = BuildTfLiteTensor(
       item_input->type, BuildTfLiteArray(*item_input->dims), kTfLiteDynamic);
   TfLiteTensorCopy(item_input, item_copy.get());
-
-  if (index >= output_arr->NumElements()) {
-    output_arr->Resize(index + 1);
-  }
   TF_LITE_ENSURE(ctx, output_arr->Set(index, std::move(item_copy)));
-  output->data.data = static_cast<VariantData*>(output_arr);
   return kTfLiteOk;
 }
 
 }  // namespace
 TfLiteRegistration* Register_LIST_SET_ITEM() {
-  static TfLiteRegistration r = {nullptr, nullptr, Prepare<SetItemSemantic>,
+  static TfLiteRegistration r = {Init, Free, Prepare<SetItemSemantic>,
                                  Eval<SetItemSemantic>};
   return &r;
 }
 
 TfLiteRegistration* Register_LIST_PUSH_BACK() {
-  static TfLiteRegistration r = {nullptr, nullptr, Prepare<PushBackSemantic>,
+  static TfLiteRegistration r = {Init, Free, Prepare<PushBackSemantic>,
                                  Eval<PushBackSemantic>};
   return &r;
 }
@@ -14,11 +14,14 @@ limitations under the License.
 ==============================================================================*/
 #include "tflite/kernels/variants/list_ops_util.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "tflite/array.h"
 #include "tflite/c/c_api_types.h"
+#include "tflite/context_util.h"
 #include "tflite/core/c/common.h"
+#include "tflite/core/subgraph.h"
 #include "tflite/kernels/variants/tensor_array.h"
 
 namespace tflite {
@@ -98,5 +101,28 @@ TfLiteStatus GetShapeIfAllEqual(const TensorArray& arr,
   return kTfLiteOk;
 }
 
+bool IsIntermediateReadOnce(TfLiteContext* context, int tensor_index) {
+  const auto* subgraph = reinterpret_cast<const Subgraph*>(context->impl_);
+  if (subgraph == nullptr || subgraph->ShouldPreserveAllTensors()) {
+    return false;
+  }
+  for (const std::vector<int>* tensors :
+       {&subgraph->inputs(), &subgraph->outputs(), &subgraph->variables()}) {
+    if (std::find(tensors->begin(), tensors->end(), tensor_index) !=
+        tensors->end()) {
+      return false;
+    }
+  }
+  int num_reads = 0;
+  for (const auto& node_and_registration :
+       subgraph->nodes_and_registration()) {
+    for (const int input :
+         TfLiteIntArrayView(node_and_registration.first.inputs)) {
+      num_reads += input == tensor_index;
+    }
+  }
+  return num_reads == 1;
+}
+
 }  // namespace variants
 }  // namespace tflite
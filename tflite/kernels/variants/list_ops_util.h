@@ -53,6 +53,11 @@ bool IsShapeFullyDefined(const TfLiteIntArray& shape);
 TfLiteStatus GetShapeIfAllEqual(const TensorArray& arr,
                                 IntArrayUniquePtr& result);
 
+// Returns whether tensor `tensor_index` of the subgraph of `context` is an
+// intermediate tensor read by a single node, which may then move its data
+// instead of copying it.
+bool IsIntermediateReadOnce(TfLiteContext* context, int tensor_index);
+
 }  // namespace variants
 }  // namespace tflite
 
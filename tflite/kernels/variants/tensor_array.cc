@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tflite/kernels/variants/tensor_array.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
@@ -29,104 +30,174 @@ TensorArray::TensorArray(const TensorArray& other) {
   element_shape_ = IntArrayUniquePtr(copied_shape);
   element_type_ = other.element_type_;
   num_elements_ = other.num_elements_;
-  elements_ =
-      (RefCountedTensor*)malloc(sizeof(RefCountedTensor) * other.num_elements_);
-  other.AssignBuffer(elements_);
+  buffer_ = other.buffer_;
+  if (buffer_ != nullptr) {
+    // Like the rest of this class, copying `other` needs to update the buffer
+    // of `const other`, so beware.
+    ++buffer_->ref_count;
+    buffer_->num_shared = std::max(buffer_->num_shared, num_elements_);
+  }
 }
 
 TensorArray& TensorArray::operator=(const TensorArray& other) {
+  if (this == &other) return *this;
+  Release();
   TfLiteIntArray* copied_shape = TfLiteIntArrayCopy(other.element_shape_.get());
   element_shape_ = IntArrayUniquePtr(copied_shape);
-  Resize(other.num_elements_);
-  Clear();
-  other.AssignBuffer(elements_);
+  num_elements_ = other.num_elements_;
+  buffer_ = other.buffer_;
+  if (buffer_ != nullptr) {
+    ++buffer_->ref_count;
+    buffer_->num_shared = std::max(buffer_->num_shared, num_elements_);
+  }
   return *this;
 }
 
 void TensorArray::Resize(int num_elements) {
   if (num_elements == NumElements() || num_elements < 0) return;
+  if (buffer_ != nullptr && buffer_->ref_count == 1) {
+    // The buffer is only used by this array, drop the elements it holds past
+    // the new length, or past the old length if growing.
+    const int size = std::min(num_elements, NumElements());
+    for (int i = size; i < buffer_->size; ++i) {
+      Drop(buffer_->elements[i]);
+    }
+    buffer_->size = size;
+  } else if (num_elements == 0) {
+    Release();
+    return;
+  }
   if (num_elements > NumElements()) {
-    // The length of the array is being increased. Reallocate the buffer
-    // to the appropriate size and setup the new `RefCountedTensors`.
-    elements_ = (RefCountedTensor*)realloc(
-        elements_, num_elements * sizeof(RefCountedTensor));
-    for (int i = NumElements(); i < num_elements; ++i) {
-      elements_[i].count = nullptr;
-      elements_[i].tensor = nullptr;
+    // The length of the array is being increased. The new elements are
+    // appended in place if no other array has grown the buffer past this one.
+    if (buffer_ == nullptr || buffer_->size != NumElements()) {
+      Detach(num_elements);
     }
-  } else {
-    // The length of the array is being decreased, update each of the
-    // references that we will no longer keep before reallocating.
-    for (int i = num_elements; i < NumElements(); ++i) {
-      Drop(i);
+    Reserve(num_elements);
+    for (int i = NumElements(); i < num_elements; ++i) {
+      buffer_->elements[i] = RefCountedTensor();
     }
-    elements_ = (RefCountedTensor*)realloc(
-        elements_, num_elements * sizeof(RefCountedTensor));
+    buffer_->size = num_elements;
   }
+  // The elements past the new length of a shared buffer are kept for the
+  // other arrays.
   num_elements_ = num_elements;
 }
 
+void TensorArray::Reserve(int capacity) {
+  if (capacity <= 0) return;
+  if (buffer_ == nullptr) {
+    Detach(capacity);
+    return;
+  }
+  if (capacity <= buffer_->capacity) return;
+  // Grow geometrically so that appending elements one at a time takes
+  // amortized constant time. Arrays sharing the buffer reach the elements
+  // through it, so it can be reallocated in place.
+  buffer_->capacity = std::max(capacity, 2 * buffer_->capacity);
+  buffer_->elements = static_cast<RefCountedTensor*>(realloc(
+      buffer_->elements, buffer_->capacity * sizeof(RefCountedTensor)));
+}
+
 const TfLiteTensor* TensorArray::At(int index) const {
   if (index < 0 || index >= NumElements()) {
     return nullptr;
   }
-  return elements_[index].tensor;
+  return buffer_->elements[index].tensor;
+}
+
+TfLiteTensor* TensorArray::MutableAt(int index) {
+  if (index < 0 || index >= NumElements() || !IsWritable(index)) {
+    return nullptr;
+  }
+  const RefCountedTensor& t = buffer_->elements[index];
+  if (t.count == nullptr || *t.count != 1) {
+    return nullptr;
+  }
+  return t.tensor;
 }
 
 bool TensorArray::Set(int index, TensorUniquePtr tensor) {
   if (index < 0 || index >= NumElements()) {
     return false;
   }
+  if (!IsWritable(index)) {
+    Detach(NumElements());
+  }
+  RefCountedTensor& t = buffer_->elements[index];
   // Drop element if it exists.
-  Drop(index);
+  Drop(t);
   // Setup the `RefCountedTensor` at given index to wrap the given tensor.
   int* c = (int*)malloc(sizeof(int));
   *c = 1;
-  elements_[index].tensor = tensor.release();
-  elements_[index].count = c;
+  t.tensor = tensor.release();
+  t.count = c;
   return true;
 }
 
-TensorArray::~TensorArray() {
-  Clear();
-  free(elements_);
-  elements_ = nullptr;
-}
+TensorArray::~TensorArray() { Release(); }
 
-void TensorArray::Drop(int i) {
-  RefCountedTensor* t = elements_ + i;
-  int* count = t->count;
+void TensorArray::Drop(RefCountedTensor& t) {
+  int* count = t.count;
   if (count == nullptr) {
     return;
   }
   if (*count == 1) {
-    TfLiteTensorFree(t->tensor);
-    free(t->tensor);
-    free(t->count);
-    t->tensor = nullptr;
-    t->count = nullptr;
+    TfLiteTensorFree(t.tensor);
+    free(t.tensor);
+    free(t.count);
+    t.tensor = nullptr;
+    t.count = nullptr;
     return;
   }
   (*count)--;
 }
 
-// `Drop`s each element in the list.
-void TensorArray::Clear() {
-  for (int i = 0; i < num_elements_; ++i) {
-    Drop(i);
+void TensorArray::Release() {
+  if (buffer_ != nullptr) {
+    if (--buffer_->ref_count == 0) {
+      for (int i = 0; i < buffer_->size; ++i) {
+        Drop(buffer_->elements[i]);
+      }
+      free(buffer_->elements);
+      delete buffer_;
+    } else if (buffer_->ref_count == 1) {
+      // The remaining array can write to any element.
+      buffer_->num_shared = 0;
+    }
   }
+  buffer_ = nullptr;
+  num_elements_ = 0;
+}
+
+bool TensorArray::IsWritable(int index) const {
+  return buffer_->ref_count == 1 || index >= buffer_->num_shared;
 }
 
-void TensorArray::AssignBuffer(RefCountedTensor* dst) const {
-  // Copy `this` underlying buffer.
-  std::memcpy(dst, elements_, sizeof(RefCountedTensor) * num_elements_);
-  // Increment the reference count for each copied tensor.
-  for (int i = 0; i < num_elements_; ++i) {
-    if (dst[i].count == nullptr) {
-      continue;
+void TensorArray::Detach(int capacity) {
+  Buffer* buffer = new Buffer();
+  buffer->capacity = std::max(capacity, NumElements());
+  buffer->size = NumElements();
+  if (buffer->capacity > 0) {
+    buffer->elements = static_cast<RefCountedTensor*>(
+        malloc(buffer->capacity * sizeof(RefCountedTensor)));
+  }
+  if (NumElements() > 0) {
+    // Copy the references to the current elements, and increment their
+    // reference counts.
+    std::memcpy(buffer->elements, buffer_->elements,
+                sizeof(RefCountedTensor) * NumElements());
+    for (int i = 0; i < NumElements(); ++i) {
+      if (buffer->elements[i].count == nullptr) {
+        continue;
+      }
+      (*buffer->elements[i].count)++;
     }
-    (*dst[i].count)++;
   }
+  const int num_elements = NumElements();
+  Release();
+  buffer_ = buffer;
+  num_elements_ = num_elements;
 }
 
 }  // namespace variants
@@ -26,6 +26,13 @@ namespace variants {
 
 // `VariantData` implementation for a dynamically sized array of `TfLiteTensor`.
 // Each element of the array is a lightweight `RefCountedTensor`.
+//
+// Copies of a `TensorArray` share its buffer of elements, which is reference
+// counted, until one of them writes to an element that the others may read.
+// That copy then takes its own buffer (copy-on-write). A copy can always
+// append elements in place to a shared buffer which no other copy has grown,
+// so that loops building a list by pushing to the back of copies of it take
+// amortized constant time per element.
 // --- WARNING ---
 // This is intended to be used in a single-threaded manner
 // and users must take care when calling non-const methods, even on different
@@ -42,8 +49,7 @@ class TensorArray : public AbstractVariantData<TensorArray> {
   TensorArray(TfLiteType element_type, IntArrayUniquePtr element_shape)
       : element_shape_(std::move(element_shape)), element_type_(element_type) {}
 
-  // Copying a `TensorArray` copies the sources underlying array of
-  // `RefCountedTensor` in one `memcpy` and increments each of the ref counts.
+  // Copying a `TensorArray` shares the buffer of `other` in constant time.
   TensorArray(const TensorArray& other);
 
   // Drops the references of `this` and assigns members in the same way
@@ -59,9 +65,17 @@ class TensorArray : public AbstractVariantData<TensorArray> {
   // longer be in the array. If index is out of bounds, no effect.
   void Resize(int num_elements);
 
+  // Preallocates room for `capacity` elements, so that growing the array up
+  // to that size does not reallocate its buffer.
+  void Reserve(int capacity);
+
   // Retrieve the tensor at the given index.
   const TfLiteTensor* At(int index) const;
 
+  // Returns the tensor at the given index if it is only referenced by this
+  // array, so that it can be updated in place, or nullptr otherwise.
+  TfLiteTensor* MutableAt(int index);
+
   TfLiteType ElementType() const { return element_type_; }
 
   // Set the item at the given index with the given tensor. Takes ownership
@@ -80,22 +94,38 @@ class TensorArray : public AbstractVariantData<TensorArray> {
     int* count = nullptr;
   };
 
-  // "Drops" the reference at the given index because it will no longer be held
-  // in this array. Decrements the reference count, if this array holds the only
-  // reference than free the underlying tensor.
-  void Drop(int i);
+  // Buffer of elements shared by copies of a `TensorArray`.
+  struct Buffer {
+    // Number of arrays using the buffer.
+    int ref_count = 1;
+    // Number of elements held by the buffer, which is the size of the array
+    // that grew it the most.
+    int size = 0;
+    int capacity = 0;
+    // The elements before this index may be read by several arrays.
+    int num_shared = 0;
+    RefCountedTensor* elements = nullptr;
+  };
+
+  // "Drops" the reference `t` because it will no longer be held in a buffer.
+  // Decrements the reference count, if this buffer holds the only reference
+  // than free the underlying tensor.
+  static void Drop(RefCountedTensor& t);
+
+  // Drops this array's reference to its buffer, and frees the buffer if it was
+  // the last one. Empties the array.
+  void Release();
 
-  // `Drop`s each element in the list.
-  void Clear();
+  // Whether the element at `index` can be written without being seen by the
+  // other arrays sharing the buffer.
+  bool IsWritable(int index) const;
 
-  // Assigns this `elements_` buffer to `dst`. Requires that the size
-  // of this elements buffer be the same as `dst` and that `dst` has
-  // been `Clear`ed. Like the rest of this class, copying `this` buffer
-  // needs to increment references of `const this`, so beware.
-  void AssignBuffer(RefCountedTensor* dst) const;
+  // Moves this array to a buffer of its own with room for `capacity` elements,
+  // which references the current elements.
+  void Detach(int capacity);
 
-  // elements_ is nullptr iff num_elements is 0.
-  RefCountedTensor* elements_ = nullptr;
+  // buffer_ is nullptr if the array is empty and has no reserved capacity.
+  Buffer* buffer_ = nullptr;
   int num_elements_ = 0;
 
   IntArrayUniquePtr element_shape_;
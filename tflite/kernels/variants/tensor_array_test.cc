@@ -208,6 +208,81 @@ TEST(TensorArrayTest, DeleteResizedEmptyTensorArray) {
   delete arr;
 }
 
+TEST(TensorArrayTest, SetOnCopyDoesNotChangeOriginal) {
+  auto arr = MakeTensorArrayForTest({});
+  arr.Resize(2);
+  ASSERT_TRUE(arr.Set(0, MakeTensorWithData<int>({2}, {3, 4})));
+
+  TensorArray arr2{arr};
+  ASSERT_TRUE(arr2.Set(0, MakeTensorWithData<int>({3}, {3, 4, 5})));
+  ASSERT_TRUE(arr2.Set(1, MakeTensorWithData<int>({1}, {6})));
+
+  EXPECT_THAT(arr.At(0), DimsAre({2}));
+  EXPECT_FALSE(arr.At(1));
+  EXPECT_THAT(arr2.At(0), DimsAre({3}));
+  EXPECT_THAT(arr2.At(1), DimsAre({1}));
+}
+
+TEST(TensorArrayTest, PushBackOnCopiesOfCopies) {
+  auto arr = MakeTensorArrayForTest({});
+  std::vector<TensorArray> copies;
+  for (int i = 0; i < 10; ++i) {
+    TensorArray next{arr};
+    next.Resize(i + 1);
+    ASSERT_TRUE(next.Set(i, MakeTensorWithData<int>({1}, {i})));
+    copies.push_back(arr);
+    arr = next;
+  }
+  ASSERT_EQ(arr.NumElements(), 10);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(arr.At(i)->data.i32[0], i);
+    EXPECT_EQ(copies[i].NumElements(), i);
+  }
+  // A shorter copy pushing to the back doesn't change the longer ones.
+  copies[5].Resize(6);
+  ASSERT_TRUE(copies[5].Set(5, MakeTensorWithData<int>({1}, {-1})));
+  EXPECT_EQ(copies[5].At(5)->data.i32[0], -1);
+  EXPECT_EQ(copies[5].At(4), arr.At(4));
+  EXPECT_EQ(arr.At(5)->data.i32[0], 5);
+}
+
+TEST(TensorArrayTest, ResizeUpAfterResizeDownOnCopy) {
+  auto arr = MakeTensorArrayForTest({});
+  arr.Resize(2);
+  ASSERT_TRUE(arr.Set(1, MakeTensorWithData<int>({2}, {3, 4})));
+  TensorArray arr2{arr};
+  arr2.Resize(1);
+  arr2.Resize(2);
+  EXPECT_FALSE(arr2.At(1));
+  EXPECT_THAT(arr.At(1), DimsAre({2}));
+}
+
+TEST(TensorArrayTest, MutableAtOnlyReturnsUnsharedElements) {
+  auto arr = MakeTensorArrayForTest({});
+  arr.Resize(2);
+  ASSERT_TRUE(arr.Set(0, MakeTensorWithData<int>({2}, {3, 4})));
+  EXPECT_EQ(arr.MutableAt(0), arr.At(0));
+  EXPECT_FALSE(arr.MutableAt(1));
+  EXPECT_FALSE(arr.MutableAt(2));
+
+  std::optional<TensorArray> arr2 = arr;
+  EXPECT_FALSE(arr.MutableAt(0));
+  EXPECT_FALSE(arr2->MutableAt(0));
+  arr2.reset();
+  EXPECT_EQ(arr.MutableAt(0), arr.At(0));
+}
+
+TEST(TensorArrayTest, ReserveKeepsElements) {
+  auto arr = MakeTensorArrayForTest({});
+  arr.Reserve(4);
+  EXPECT_EQ(arr.NumElements(), 0);
+  arr.Resize(1);
+  ASSERT_TRUE(arr.Set(0, MakeTensorWithData<int>({2}, {3, 4})));
+  arr.Reserve(16);
+  EXPECT_EQ(arr.NumElements(), 1);
+  EXPECT_THAT(arr.At(0), DimsAre({2}));
+}
+
 // OpaqueVariantTensorArrayDataTest(s) test usage of the `TensorArray` through
 // the generic interface methods defined in
 // `third_party/tensorflow/lite/core/c/common.h`. While appearing slightly
@@ -16,6 +16,8 @@ limitations under the License.
 #include <stddef.h>
 
 #include <cstring>
+#include <memory>
+#include <new>
 #include <vector>
 
 #include "tflite/context_util.h"
@@ -24,12 +26,26 @@ limitations under the License.
 #include "tflite/core/subgraph.h"
 #include "tflite/kernels/control_flow_common.h"
 #include "tflite/kernels/kernel_util.h"
+#include "tflite/util.h"
 
 namespace tflite {
 namespace ops {
 namespace builtin {
 namespace while_kernel {
 
+// A buffer the body subgraph writes the value of a loop variable to on every
+// other iteration, so that it is never written to the buffer it reads.
+struct SwapBuffer {
+  struct Deleter {
+    void operator()(char* data) const {
+      ::operator delete[](data, std::align_val_t(kDefaultTensorAlignment));
+    }
+  };
+
+  std::unique_ptr<char[], Deleter> data;
+  size_t bytes = 0;
+};
+
 struct OpData {
   int cond_subgraph_index;
   int body_subgraph_index;
@@ -37,6 +53,9 @@ struct OpData {
   bool body_has_dynamic_output_tensors;
   // set when Prepare_impl() is called.
   bool subgraphs_prepared;
+  // Indexed by loop variable, only allocated for the variables whose body
+  // output is swapped with the body input in Eval_static().
+  std::vector<SwapBuffer> swap_buffers;
 };
 
 namespace {
@@ -56,6 +75,33 @@ TfLiteStatus CheckCondOutput(TfLiteContext* context,
   return kTfLiteOk;
 }
 
+// Returns true if the body output of loop variable `i` can be written to a
+// buffer of its own, which becomes the body input of the next iteration,
+// instead of being copied to the WHILE output after each iteration. This
+// requires the body output to be a plain arena tensor that only holds this
+// variable, and the body input to be read by nothing but the body nodes.
+bool CanSwapBodyOutput(const TfLiteNode* node, Subgraph* this_subgraph,
+                       Subgraph* body_subgraph, int i) {
+  const int output_idx = node->outputs->data[i];
+  if (output_idx == kTfLiteOptionalTensor) return false;
+  const int body_input_idx = body_subgraph->inputs()[i];
+  const int body_output_idx = body_subgraph->outputs()[i];
+  for (int idx : body_subgraph->inputs()) {
+    if (idx == body_output_idx) return false;
+  }
+  int body_output_count = 0;
+  for (int idx : body_subgraph->outputs()) {
+    if (idx == body_input_idx) return false;
+    if (idx == body_output_idx) ++body_output_count;
+  }
+  if (body_output_count != 1) return false;
+  const TfLiteTensor* body_output = body_subgraph->tensor(body_output_idx);
+  if (body_output->allocation_type != kTfLiteArenaRw) return false;
+  if (body_output->type == kTfLiteString) return false;
+  if (IsResourceOrVariant(body_output)) return false;
+  return body_output->bytes == this_subgraph->tensor(output_idx)->bytes;
+}
+
 }  // namespace
 
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
@@ -419,6 +465,36 @@ TfLiteStatus Eval_static(TfLiteContext* context, TfLiteNode* node) {
 
   SetupUnconsumedOutputs(node, op_data, this_subgraph, body_subgraph);
 
+  // The loop variables whose body output can be swapped with the body input
+  // skip step 6: the body writes them alternately to the WHILE output and to
+  // a swap buffer, and the body input of the next iteration points to the
+  // buffer that was just written. The value is copied to the WHILE output at
+  // most once, after the loop. Delegated bodies may hold on to the buffers of
+  // their tensors, and the intermediate values must stay in the body tensors
+  // when all tensors are preserved, so both copy every iteration.
+  std::vector<int> swapped_vars;
+  std::vector<char*> body_output_arena_data;
+  std::vector<int> copied_output_indices(node->outputs->data,
+                                         node->outputs->data + num_inputs);
+  if (!body_subgraph->HasDelegates() &&
+      !this_subgraph->ShouldPreserveAllTensors()) {
+    op_data->swap_buffers.resize(num_inputs);
+    for (int i = 0; i < num_inputs; ++i) {
+      if (!CanSwapBodyOutput(node, this_subgraph, body_subgraph, i)) continue;
+      TfLiteTensor* body_output =
+          body_subgraph->tensor(body_subgraph->outputs()[i]);
+      SwapBuffer& swap_buffer = op_data->swap_buffers[i];
+      if (swap_buffer.bytes < body_output->bytes) {
+        swap_buffer.data.reset(static_cast<char*>(::operator new[](
+            body_output->bytes, std::align_val_t(kDefaultTensorAlignment))));
+        swap_buffer.bytes = body_output->bytes;
+      }
+      swapped_vars.push_back(i);
+      body_output_arena_data.push_back(body_output->data.raw);
+      copied_output_indices[i] = kTfLiteOptionalTensor;
+    }
+  }
+
   while (true) {
     // Step 3. Eval cond subgraph
     bool cond_subgraph_output;
@@ -431,6 +507,17 @@ TfLiteStatus Eval_static(TfLiteContext* context, TfLiteNode* node) {
     }
 
     // Step 4. Invoke body subgraph
+    for (int i : swapped_vars) {
+      TfLiteTensor* body_input =
+          body_subgraph->tensor(body_subgraph->inputs()[i]);
+      TfLiteTensor* body_output =
+          body_subgraph->tensor(body_subgraph->outputs()[i]);
+      char* this_output_data =
+          this_subgraph->tensor(node->outputs->data[i])->data.raw;
+      body_output->data.raw = body_input->data.raw == this_output_data
+                                  ? op_data->swap_buffers[i].data.get()
+                                  : this_output_data;
+    }
     TF_LITE_ENSURE_OK(context, body_subgraph->Invoke());
     for (int tensor_index : body_subgraph->outputs()) {
       body_subgraph->EnsureTensorDataIsReadable(tensor_index);
@@ -441,10 +528,31 @@ TfLiteStatus Eval_static(TfLiteContext* context, TfLiteNode* node) {
         context,
         CopyTensorsData(context, body_subgraph, body_subgraph->outputs(),
                         cond_subgraph, cond_subgraph->inputs()));
+    // Step 6. body->outputs -> node->outputs, except for the swapped ones.
     TF_LITE_ENSURE_OK(
         context,
         CopyTensorsData(context, body_subgraph, body_subgraph->outputs(),
-                        this_subgraph, TfLiteIntArrayView(node->outputs)));
+                        this_subgraph, copied_output_indices));
+    for (int i : swapped_vars) {
+      TfLiteTensor* body_input =
+          body_subgraph->tensor(body_subgraph->inputs()[i]);
+      body_input->data.raw =
+          body_subgraph->tensor(body_subgraph->outputs()[i])->data.raw;
+    }
+  }
+
+  for (size_t j = 0; j < swapped_vars.size(); ++j) {
+    const int i = swapped_vars[j];
+    TfLiteTensor* body_input =
+        body_subgraph->tensor(body_subgraph->inputs()[i]);
+    TfLiteTensor* this_output = this_subgraph->tensor(node->outputs->data[i]);
+    if (body_input->data.raw != this_output->data.raw) {
+      std::memcpy(this_output->data.raw, body_input->data.raw,
+                  this_output->bytes);
+      body_input->data.raw = this_output->data.raw;
+    }
+    body_subgraph->tensor(body_subgraph->outputs()[i])->data.raw =
+        body_output_arena_data[j];
   }
 
   return kTfLiteOk;
@@ -349,6 +349,36 @@ TEST_F(WhileTest, TestStaticInPlaceLarge) {
   ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
 }
 
+// The body outputs that are written to their own buffer alternate between
+// the WHILE output and a swap buffer, so both odd and even iteration counts
+// must leave the final value in the WHILE output.
+TEST_F(WhileTest, TestStaticSwappedOutputs) {
+  for (int num_iterations = 1; num_iterations <= 4; ++num_iterations) {
+    interpreter_ = std::make_unique<Interpreter>();
+    AddSubgraphs(2);
+    builder_->BuildLessEqualCondSubgraph(interpreter_->subgraph(1),
+                                         num_iterations);
+    builder_->BuildAccumulateLoopBodySubgraph(interpreter_->subgraph(2));
+    builder_->BuildWhileSubgraph(&interpreter_->primary_subgraph());
+
+    ASSERT_EQ(interpreter_->ResizeInputTensor(interpreter_->inputs()[0], {1}),
+              kTfLiteOk);
+    ASSERT_EQ(interpreter_->ResizeInputTensor(interpreter_->inputs()[1], {1}),
+              kTfLiteOk);
+    ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+    for (int invoke = 0; invoke < 2; ++invoke) {
+      FillIntTensor(interpreter_->tensor(interpreter_->inputs()[0]), {1});
+      FillIntTensor(interpreter_->tensor(interpreter_->inputs()[1]), {1});
+      ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+      TfLiteTensor* output1 = interpreter_->tensor(interpreter_->outputs()[0]);
+      CheckIntTensor(output1, {1}, {num_iterations + 1});
+      TfLiteTensor* output2 = interpreter_->tensor(interpreter_->outputs()[1]);
+      CheckIntTensor(output2, {1},
+                     {(num_iterations + 1) * (num_iterations + 2) / 2});
+    }
+  }
+}
+
 // The test builds a model that produces the i-th number of
 // triangular number sequence.
 TEST_F(WhileTest, TestTriangularNumberSequence) {
@@ -15,8 +15,10 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_MEMORY_PLANNER_H_
 #define TENSORFLOW_LITE_MEMORY_PLANNER_H_
 
+#include <cstddef>
 #include <vector>
 
+#include "tflite/arena_plan.h"
 #include "tflite/core/c/common.h"
 
 namespace tflite {
@@ -69,6 +71,67 @@ class MemoryPlanner {
   // Returns a map of allocation information. It's only used for debugging.
   virtual void GetAllocInfo(size_t *arena_size,
                             size_t *arena_persist_size) const = 0;
+
+  // The following methods let the subgraphs called by a node, such as the
+  // branches and bodies of control flow ops, place their non-persistent memory
+  // in the non-persistent memory of the caller while the node runs. The
+  // default implementations don't support it.
+
+  // Returns the size of the non-persistent memory of the current plan.
+  virtual size_t GetNonPersistentMemorySize() const { return 0; }
+
+  // Reserves `size` bytes of non-persistent memory for the duration of the
+  // node at execution plan index `node`, from its next ExecuteAllocations() on.
+  // Returns false if reservations are not supported.
+  virtual bool ReserveNodeMemory(int node, size_t size) { return false; }
+
+  // Returns the memory reserved for `node`, or nullptr if there is none or the
+  // non-persistent memory is not available. The pointer is invalidated when
+  // the memory is allocated again.
+  virtual char* GetNodeMemory(int node) { return nullptr; }
+
+  // Makes the non-persistent memory use the `size` bytes at `offset` of the
+  // memory `caller` reserved for `node`, whenever it is acquired and the plan
+  // fits, instead of memory of its own. Pass a null `caller` to stop.
+  virtual void ShareNodeMemory(MemoryPlanner* caller, int node, size_t offset,
+                               size_t size) {}
+
+  // Returns how many of the reserved bytes overlap the memory of the tensors
+  // rather than adding to the non-persistent memory.
+  virtual size_t GetNodeMemorySavings() const { return 0; }
+
+  // The following methods let the placement of the non-persistent tensors be
+  // computed offline and cached. The default implementations don't support
+  // it.
+
+  // Exports the placement of the non-persistent tensors of the current plan.
+  // Returns false if it is not available.
+  virtual bool GetArenaPlan(SubgraphArenaPlan* plan) const { return false; }
+
+  // Makes the next allocations of all the nodes at once use `plan`, if it
+  // matches the tensors to allocate, instead of planning them. `plan` must
+  // outlive the planner. Pass nullptr to stop.
+  virtual void SetArenaPlan(const SubgraphArenaPlan* plan) {}
+
+  // Makes the allocations of all the nodes after ResetAllocations(), e.g. after
+  // an input was resized, keep the place of the non-persistent tensors that
+  // still fit in it, and only plan the others, as long as the non-persistent
+  // memory doesn't have to grow. The default implementation doesn't support
+  // it.
+  virtual void SetIncrementalPlanning(bool incremental_planning) {}
+
+  // The following methods let the nodes of a level, given by execution plan
+  // index, run at the same time, by keeping the tensors of each node from the
+  // first to the last node of its level. The levels must be contiguous in the
+  // execution plan. The default implementations don't support it.
+
+  // Sets the level of each node, from the next PlanAllocations() on. Pass an
+  // empty vector to stop.
+  virtual void SetNodeLevels(const std::vector<int>& levels) {}
+
+  // Returns true if the tensors of all the nodes are allocated for the levels,
+  // so that the nodes of a level can run at the same time.
+  virtual bool IsPlannedForNodeLevels() const { return false; }
 };
 
 }  // namespace tflite
@@ -58,6 +58,13 @@ typedef NS_ENUM(NSUInteger, TFLCoreMLDelegateEnabledDevices) {
  */
 @property(nonatomic) NSUInteger minNodesPerPartition;
 
+/**
+ * The directory where compiled Core ML models are cached across runs, so that later runs skip the
+ * model compilation. The directory must already exist. The default value is `nil`, indicating
+ * that compiled models are not cached.
+ */
+@property(nonatomic, copy, nullable) NSString *cacheDirectory;
+
 @end
 
 /** A delegate that uses the Core ML framework for performing TensorFlow Lite graph operations. */
@@ -63,6 +63,7 @@ NS_ASSUME_NONNULL_BEGIN
     cOptions.coreml_version = options.coreMLVersion;
     cOptions.max_delegated_partitions = options.maxDelegatedPartitions;
     cOptions.min_nodes_per_partition = options.minNodesPerPartition;
+    cOptions.cache_dir = options.cacheDirectory.UTF8String;
 
     switch (options.enabledDevices) {
       case TFLCoreMLDelegateEnabledDevicesNeuralEngine:
@@ -0,0 +1,281 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/profiling/memory_traffic_profiler.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tflite/core/c/common.h"
+#include "tflite/core/subgraph.h"
+#include "tflite/interpreter.h"
+#include "tflite/profiling/memory_info.h"
+#include "tflite/profiling/time.h"
+
+namespace tflite::profiling {
+namespace {
+
+uint64_t SumTensorBytes(const Subgraph& subgraph,
+                        const TfLiteIntArray* tensors) {
+  uint64_t bytes = 0;
+  for (int i = 0; i < tensors->size; ++i) {
+    if (tensors->data[i] == kTfLiteOptionalTensor) continue;
+    const TfLiteTensor* tensor = subgraph.tensor(tensors->data[i]);
+    if (tensor != nullptr) bytes += tensor->bytes;
+  }
+  return bytes;
+}
+
+// Appends the data and size of the dynamic tensors of `tensors`.
+void GetDynamicTensors(const Subgraph& subgraph, const TfLiteIntArray* tensors,
+                       std::vector<std::pair<const void*, size_t>>& result) {
+  for (int i = 0; i < tensors->size; ++i) {
+    if (tensors->data[i] == kTfLiteOptionalTensor) continue;
+    const TfLiteTensor* tensor = subgraph.tensor(tensors->data[i]);
+    if (tensor != nullptr && tensor->allocation_type == kTfLiteDynamic) {
+      result.emplace_back(tensor->data.raw, tensor->bytes);
+    }
+  }
+}
+
+size_t GetHeapBytesInUse() {
+  return memory::GetMemoryUsage().in_use_allocated_bytes;
+}
+
+}  // namespace
+
+MemoryTrafficProfiler::MemoryTrafficProfiler(const Interpreter& interpreter,
+                                             const Options& options)
+    : interpreter_(interpreter),
+      options_([&options] {
+        Options result = options;
+        result.track_heap =
+            result.track_heap && memory::MemoryUsage::IsSupported();
+        return result;
+      }()),
+      start_time_us_(time::NowMicros()) {}
+
+uint32_t MemoryTrafficProfiler::BeginEvent(const char* tag,
+                                           EventType event_type,
+                                           int64_t event_metadata1,
+                                           int64_t event_metadata2) {
+  ActiveEvent event;
+  if (event_type == EventType::OPERATOR_INVOKE_EVENT) {
+    if (event_metadata1 < 0) return 0;
+    event.node_index = static_cast<int>(event_metadata1);
+  } else if (event_type != EventType::DEFAULT || strcmp(tag, "Invoke") != 0) {
+    // Only the nodes and the "Invoke" events of Subgraph::Invoke() are
+    // tracked.
+    return 0;
+  }
+  if (event_metadata2 < 0 ||
+      event_metadata2 >= static_cast<int64_t>(interpreter_.subgraphs_size())) {
+    return 0;
+  }
+  event.subgraph_index = static_cast<int>(event_metadata2);
+  event.tag = tag;
+  if (event.node_index >= 0) {
+    BeginNode(event);
+  }
+  active_events_.push_back(std::move(event));
+  return active_events_.size();
+}
+
+void MemoryTrafficProfiler::EndEvent(uint32_t event_handle) {
+  if (event_handle == 0 || event_handle > active_events_.size()) {
+    return;
+  }
+  // The events of a failed node may not have ended.
+  active_events_.resize(event_handle);
+  const ActiveEvent event = std::move(active_events_.back());
+  active_events_.pop_back();
+  if (event.node_index >= 0) {
+    EndNode(event);
+  } else {
+    EndSubgraph(event);
+  }
+}
+
+void MemoryTrafficProfiler::BeginNode(ActiveEvent& event) {
+  const Subgraph& subgraph = *interpreter_.subgraph(event.subgraph_index);
+  const auto* node_and_registration =
+      subgraph.node_and_registration(event.node_index);
+  if (node_and_registration == nullptr) {
+    event.subgraph_index = -1;
+    return;
+  }
+  const TfLiteNode& node = node_and_registration->first;
+  GetDynamicTensors(subgraph, node.outputs, event.dynamic_tensors);
+  if (node.temporaries != nullptr) {
+    GetDynamicTensors(subgraph, node.temporaries, event.dynamic_tensors);
+  }
+  // Last, so that the profiler's own allocations are not counted.
+  if (options_.track_heap) {
+    event.heap_bytes = GetHeapBytesInUse();
+  }
+}
+
+void MemoryTrafficProfiler::EndNode(const ActiveEvent& event) {
+  if (event.subgraph_index < 0) {
+    return;
+  }
+  const size_t heap_bytes = options_.track_heap ? GetHeapBytesInUse() : 0;
+
+  const Subgraph& subgraph = *interpreter_.subgraph(event.subgraph_index);
+  const TfLiteNode& node =
+      subgraph.node_and_registration(event.node_index)->first;
+  NodeMemoryTraffic& traffic =
+      nodes_[{event.subgraph_index, event.node_index}];
+  if (traffic.invocations == 0) {
+    traffic.op_name = event.tag != nullptr ? event.tag : "";
+    traffic.subgraph_index = event.subgraph_index;
+    traffic.node_index = event.node_index;
+  }
+  ++traffic.invocations;
+  traffic.bytes_read += SumTensorBytes(subgraph, node.inputs);
+  traffic.bytes_written += SumTensorBytes(subgraph, node.outputs);
+  if (node.temporaries != nullptr) {
+    traffic.scratch_bytes += SumTensorBytes(subgraph, node.temporaries);
+  }
+
+  std::vector<std::pair<const void*, size_t>> dynamic_tensors;
+  dynamic_tensors.reserve(event.dynamic_tensors.size());
+  GetDynamicTensors(subgraph, node.outputs, dynamic_tensors);
+  if (node.temporaries != nullptr) {
+    GetDynamicTensors(subgraph, node.temporaries, dynamic_tensors);
+  }
+  // A node can't change the allocation types of its tensors, so the tensors
+  // are in the same order as when the node began.
+  if (dynamic_tensors.size() == event.dynamic_tensors.size()) {
+    for (size_t i = 0; i < dynamic_tensors.size(); ++i) {
+      const auto& [data, bytes] = dynamic_tensors[i];
+      if (data != nullptr && dynamic_tensors[i] != event.dynamic_tensors[i]) {
+        traffic.dynamic_bytes_allocated += bytes;
+        ++traffic.dynamic_allocations;
+      }
+    }
+  }
+
+  if (options_.track_heap && heap_bytes > event.heap_bytes) {
+    traffic.heap_bytes_allocated += heap_bytes - event.heap_bytes;
+  }
+}
+
+void MemoryTrafficProfiler::EndSubgraph(const ActiveEvent& event) {
+  Subgraph::SubgraphAllocInfo alloc_info;
+  interpreter_.subgraph(event.subgraph_index)->GetMemoryAllocInfo(&alloc_info);
+
+  SubgraphMemorySample sample;
+  sample.time_us = static_cast<int64_t>(time::NowMicros()) - start_time_us_;
+  sample.subgraph_index = event.subgraph_index;
+  sample.arena_bytes = alloc_info.arena_size;
+  sample.persistent_arena_bytes = alloc_info.arena_persist_size;
+  sample.dynamic_bytes = alloc_info.dynamic_size;
+
+  size_t& high_water_bytes = high_water_bytes_[event.subgraph_index];
+  high_water_bytes =
+      std::max(high_water_bytes, sample.arena_bytes +
+                                     sample.persistent_arena_bytes +
+                                     sample.dynamic_bytes);
+
+  if (options_.max_samples == 0) {
+    return;
+  }
+  if (samples_.size() < options_.max_samples) {
+    samples_.push_back(sample);
+  } else {
+    samples_[next_sample_] = sample;
+    next_sample_ = (next_sample_ + 1) % samples_.size();
+  }
+}
+
+std::vector<NodeMemoryTraffic> MemoryTrafficProfiler::GetNodeTraffic() const {
+  std::vector<NodeMemoryTraffic> result;
+  result.reserve(nodes_.size());
+  for (const auto& [key, traffic] : nodes_) {
+    result.push_back(traffic);
+  }
+  return result;
+}
+
+std::vector<SubgraphMemorySample> MemoryTrafficProfiler::GetSamples() const {
+  std::vector<SubgraphMemorySample> result(samples_.begin() + next_sample_,
+                                           samples_.end());
+  result.insert(result.end(), samples_.begin(),
+                samples_.begin() + next_sample_);
+  return result;
+}
+
+size_t MemoryTrafficProfiler::GetHighWaterBytes(int subgraph_index) const {
+  const auto it = high_water_bytes_.find(subgraph_index);
+  return it == high_water_bytes_.end() ? 0 : it->second;
+}
+
+std::string MemoryTrafficProfiler::Summarize() const {
+  std::vector<NodeMemoryTraffic> nodes = GetNodeTraffic();
+  std::stable_sort(nodes.begin(), nodes.end(),
+                   [](const NodeMemoryTraffic& a, const NodeMemoryTraffic& b) {
+                     return a.bytes_read + a.bytes_written >
+                            b.bytes_read + b.bytes_written;
+                   });
+
+  // Bytes per invocation.
+  const auto per_invocation = [](uint64_t bytes, int64_t invocations) {
+    return invocations > 0 ? bytes / invocations : 0;
+  };
+
+  std::stringstream stream;
+  stream << "Memory traffic per invocation, by bytes moved:\n"
+         << std::setw(9) << "subgraph" << std::setw(7) << "node"
+         << std::setw(26) << "op" << std::setw(14) << "read" << std::setw(14)
+         << "written" << std::setw(12) << "scratch" << std::setw(14)
+         << "dynamic" << std::setw(14) << "heap"
+         << "\n";
+  for (const NodeMemoryTraffic& node : nodes) {
+    stream << std::setw(9) << node.subgraph_index << std::setw(7)
+           << node.node_index << std::setw(26) << node.op_name.substr(0, 25)
+           << std::setw(14) << per_invocation(node.bytes_read, node.invocations)
+           << std::setw(14)
+           << per_invocation(node.bytes_written, node.invocations)
+           << std::setw(12)
+           << per_invocation(node.scratch_bytes, node.invocations)
+           << std::setw(14)
+           << per_invocation(node.dynamic_bytes_allocated, node.invocations)
+           << std::setw(14)
+           << per_invocation(node.heap_bytes_allocated, node.invocations)
+           << "\n";
+  }
+  stream << "Arena high-water mark:\n";
+  for (const auto& [subgraph_index, bytes] : high_water_bytes_) {
+    stream << "  subgraph " << subgraph_index << ": " << bytes << " bytes\n";
+  }
+  return stream.str();
+}
+
+void MemoryTrafficProfiler::Reset() {
+  active_events_.clear();
+  nodes_.clear();
+  samples_.clear();
+  next_sample_ = 0;
+  high_water_bytes_.clear();
+}
+
+}  // namespace tflite::profiling
@@ -0,0 +1,147 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_PROFILING_MEMORY_TRAFFIC_PROFILER_H_
+#define TENSORFLOW_LITE_PROFILING_MEMORY_TRAFFIC_PROFILER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tflite/core/api/profiler.h"
+#include "tflite/interpreter.h"
+
+namespace tflite::profiling {
+
+// The memory traffic of a node, accumulated over its invocations.
+struct NodeMemoryTraffic {
+  std::string op_name;
+  int subgraph_index = 0;
+  int node_index = 0;
+  int64_t invocations = 0;
+
+  // Bytes of the input and output tensors of the node, i.e. the bytes its
+  // kernel reads and writes at least once.
+  uint64_t bytes_read = 0;
+  uint64_t bytes_written = 0;
+
+  // Bytes of the temporaries of the node, i.e. the scratch of its kernel.
+  uint64_t scratch_bytes = 0;
+
+  // Bytes and number of the dynamic tensors the node allocated on the heap,
+  // outside of the arena, e.g. outputs whose shape is only known at run time.
+  uint64_t dynamic_bytes_allocated = 0;
+  int64_t dynamic_allocations = 0;
+
+  // Growth of the heap bytes in use during the node, e.g. buffers the kernel
+  // allocates itself. Only set if Options::track_heap is set, and includes
+  // the subgraphs called by control flow nodes.
+  uint64_t heap_bytes_allocated = 0;
+};
+
+// The memory of a subgraph at the end of one of its invocations.
+struct SubgraphMemorySample {
+  // Microseconds since the creation of the profiler.
+  int64_t time_us = 0;
+  int subgraph_index = 0;
+  size_t arena_bytes = 0;
+  size_t persistent_arena_bytes = 0;
+  size_t dynamic_bytes = 0;
+};
+
+// A profiler that reports the memory traffic of each node: the bytes it
+// reads and writes, its scratch and the allocations it makes outside of the
+// arenas, and samples the occupancy of the arenas of each subgraph after each
+// of their invocations.
+//
+// Install it with Interpreter::AddProfiler() to use it next to a timing
+// profiler. It is not thread-safe, like the interpreter.
+class MemoryTrafficProfiler : public tflite::Profiler {
+ public:
+  struct Options {
+    // Measures the heap bytes in use before and after each node, which finds
+    // the allocations of the kernels on the hot path but takes a lock of the
+    // allocator twice per node.
+    bool track_heap = false;
+    // The maximum number of samples of the arenas that are kept, the oldest
+    // are dropped first.
+    size_t max_samples = 4096;
+  };
+
+  explicit MemoryTrafficProfiler(const Interpreter& interpreter)
+      : MemoryTrafficProfiler(interpreter, Options()) {}
+  MemoryTrafficProfiler(const Interpreter& interpreter, const Options& options);
+
+  uint32_t BeginEvent(const char* tag, EventType event_type,
+                      int64_t event_metadata1,
+                      int64_t event_metadata2) override;
+
+  void EndEvent(uint32_t event_handle) override;
+
+  // Returns the traffic of the nodes that ran, ordered by subgraph and node.
+  std::vector<NodeMemoryTraffic> GetNodeTraffic() const;
+
+  // Returns the samples of the arenas, oldest first.
+  std::vector<SubgraphMemorySample> GetSamples() const;
+
+  // Returns the largest arena, persistent arena and dynamic bytes of the
+  // subgraph that were sampled, or 0 if it never ran.
+  size_t GetHighWaterBytes(int subgraph_index) const;
+
+  // Returns a table of the nodes by bytes moved, and the high-water mark of
+  // each subgraph.
+  std::string Summarize() const;
+
+  void Reset();
+
+ private:
+  // An event that began and didn't end.
+  struct ActiveEvent {
+    // -1 for the events that are ignored.
+    int subgraph_index = -1;
+    // -1 for the invocations of a subgraph.
+    int node_index = -1;
+    const char* tag = nullptr;
+    size_t heap_bytes = 0;
+    // The data and size of the dynamic outputs and temporaries of the node.
+    std::vector<std::pair<const void*, size_t>> dynamic_tensors;
+  };
+
+  void BeginNode(ActiveEvent& event);
+  void EndNode(const ActiveEvent& event);
+  void EndSubgraph(const ActiveEvent& event);
+
+  const Interpreter& interpreter_;
+  const Options options_;
+  const int64_t start_time_us_;
+
+  // Nested events, innermost last.
+  std::vector<ActiveEvent> active_events_;
+
+  std::map<std::pair<int, int>, NodeMemoryTraffic> nodes_;
+
+  // A ring of at most `options_.max_samples` samples, `next_sample_` is the
+  // oldest once it is full.
+  std::vector<SubgraphMemorySample> samples_;
+  size_t next_sample_ = 0;
+
+  std::map<int, size_t> high_water_bytes_;
+};
+
+}  // namespace tflite::profiling
+
+#endif  // TENSORFLOW_LITE_PROFILING_MEMORY_TRAFFIC_PROFILER_H_
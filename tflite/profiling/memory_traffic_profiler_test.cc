@@ -0,0 +1,137 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/profiling/memory_traffic_profiler.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tflite/core/api/profiler.h"
+#include "tflite/core/c/common.h"
+#include "tflite/kernels/subgraph_test_util.h"
+
+namespace tflite::profiling {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::Gt;
+using ::testing::HasSubstr;
+
+// `cond ? a + b : a * b`, with a bool `cond`, an int32 `a` of shape [2] and an
+// int32 `b` of shape [1, 2].
+class MemoryTrafficProfilerTest : public subgraph_test_util::ControlFlowOpTest {
+ protected:
+  void SetUp() override {
+    AddSubgraphs(2);
+    builder_->BuildAddSubgraph(interpreter_->subgraph(1));
+    builder_->BuildMulSubgraph(interpreter_->subgraph(2));
+    builder_->BuildIfSubgraph(&interpreter_->primary_subgraph());
+
+    interpreter_->ResizeInputTensor(interpreter_->inputs()[0], {1});
+    interpreter_->ResizeInputTensor(interpreter_->inputs()[1], {2});
+    interpreter_->ResizeInputTensor(interpreter_->inputs()[2], {1, 2});
+    ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+
+    subgraph_test_util::FillIntTensor(
+        interpreter_->tensor(interpreter_->inputs()[1]), {5, 7});
+    subgraph_test_util::FillIntTensor(
+        interpreter_->tensor(interpreter_->inputs()[2]), {1, 2});
+  }
+};
+
+TEST_F(MemoryTrafficProfilerTest, ReportsTheTensorBytesOfTheNodesThatRan) {
+  MemoryTrafficProfiler profiler(*interpreter_);
+  interpreter_->AddProfiler(&profiler);
+  interpreter_->typed_input_tensor<bool>(0)[0] = true;
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+
+  const std::vector<NodeMemoryTraffic> nodes = profiler.GetNodeTraffic();
+  ASSERT_EQ(nodes.size(), 2);
+
+  // The IF node reads the condition and both operands.
+  EXPECT_EQ(nodes[0].subgraph_index, 0);
+  EXPECT_EQ(nodes[0].node_index, 0);
+  EXPECT_EQ(nodes[0].invocations, 2);
+  EXPECT_EQ(nodes[0].bytes_read, 2 * (sizeof(bool) + 4 * sizeof(int32_t)));
+  EXPECT_EQ(nodes[0].bytes_written, 2 * 2 * sizeof(int32_t));
+
+  // The ADD node of the then branch.
+  EXPECT_EQ(nodes[1].subgraph_index, 1);
+  EXPECT_EQ(nodes[1].node_index, 0);
+  EXPECT_EQ(nodes[1].invocations, 2);
+  EXPECT_EQ(nodes[1].bytes_read, 2 * 4 * sizeof(int32_t));
+  EXPECT_EQ(nodes[1].bytes_written, 2 * 2 * sizeof(int32_t));
+  EXPECT_EQ(nodes[1].heap_bytes_allocated, 0);
+
+  EXPECT_THAT(profiler.Summarize(), HasSubstr("Arena high-water mark"));
+}
+
+TEST_F(MemoryTrafficProfilerTest, SamplesTheArenasOfTheSubgraphsThatRan) {
+  MemoryTrafficProfiler profiler(*interpreter_);
+  interpreter_->AddProfiler(&profiler);
+  interpreter_->typed_input_tensor<bool>(0)[0] = false;
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+
+  // The called subgraph ends first.
+  EXPECT_THAT(profiler.GetSamples(),
+              ElementsAre(Field(&SubgraphMemorySample::subgraph_index, 2),
+                          Field(&SubgraphMemorySample::subgraph_index, 0)));
+  EXPECT_THAT(profiler.GetHighWaterBytes(0), Gt(0));
+  EXPECT_EQ(profiler.GetHighWaterBytes(1), 0);
+}
+
+TEST_F(MemoryTrafficProfilerTest, KeepsTheLatestSamples) {
+  MemoryTrafficProfiler::Options options;
+  options.max_samples = 3;
+  MemoryTrafficProfiler profiler(*interpreter_, options);
+  interpreter_->AddProfiler(&profiler);
+  interpreter_->typed_input_tensor<bool>(0)[0] = true;
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+
+  const std::vector<SubgraphMemorySample> samples = profiler.GetSamples();
+  EXPECT_THAT(samples,
+              ElementsAre(Field(&SubgraphMemorySample::subgraph_index, 0),
+                          Field(&SubgraphMemorySample::subgraph_index, 1),
+                          Field(&SubgraphMemorySample::subgraph_index, 0)));
+  EXPECT_LE(samples[0].time_us, samples[1].time_us);
+  EXPECT_LE(samples[1].time_us, samples[2].time_us);
+
+  profiler.Reset();
+  EXPECT_TRUE(profiler.GetSamples().empty());
+  EXPECT_TRUE(profiler.GetNodeTraffic().empty());
+}
+
+TEST_F(MemoryTrafficProfilerTest, IgnoresOtherEvents) {
+  MemoryTrafficProfiler profiler(*interpreter_);
+  EXPECT_EQ(profiler.BeginEvent("AllocateTensors",
+                                Profiler::EventType::DEFAULT, 0, 0),
+            0);
+  EXPECT_EQ(profiler.BeginEvent("Invoke", Profiler::EventType::DEFAULT, 0,
+                                /*subgraph_index=*/3),
+            0);
+  EXPECT_EQ(
+      profiler.BeginEvent(
+          "ADD", Profiler::EventType::DELEGATE_OPERATOR_INVOKE_EVENT, 0, 0),
+      0);
+  profiler.EndEvent(0);
+  EXPECT_TRUE(profiler.GetNodeTraffic().empty());
+}
+
+}  // namespace
+}  // namespace tflite::profiling
@@ -15,11 +15,14 @@ limitations under the License.
 
 #include "tflite/profiling/model_runtime_info.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <fstream>
 #include <ios>
 #include <iostream>
+#include <map>
 #include <string>
 #include <utility>
 #include <vector>
@@ -30,6 +33,8 @@ limitations under the License.
 #include "tflite/core/subgraph.h"
 #include "tflite/interpreter.h"
 #include "tflite/optional_debug_tools.h"
+#include "tflite/profiling/profile_buffer.h"
+#include "tflite/profiling/proto/profiling_info.pb.h"
 #include "tflite/profiling/proto/model_runtime_info.pb.h"
 #include "tflite/schema/schema_generated.h"
 #include "tflite/tools/logging.h"
@@ -161,12 +166,222 @@ TfLiteStatus TfliteNodeToNode(const TfLiteNode& node,
 
   return kTfLiteOk;
 }
+
+// Dimension `dim` of the tensor, counted from the end if negative. 0 if the
+// tensor is missing or the dimension unknown.
+uint64_t Dim(const TfLiteTensor* tensor, int dim) {
+  if (tensor == nullptr || tensor->dims == nullptr) {
+    return 0;
+  }
+  const int rank = tensor->dims->size;
+  if (dim < 0) {
+    dim += rank;
+  }
+  if (dim < 0 || dim >= rank || tensor->dims->data[dim] < 0) {
+    return 0;
+  }
+  return tensor->dims->data[dim];
+}
+
+uint64_t NumElements(const TfLiteTensor* tensor) {
+  if (tensor == nullptr || tensor->dims == nullptr) {
+    return 0;
+  }
+  uint64_t num_elements = 1;
+  for (int i = 0; i < tensor->dims->size; ++i) {
+    num_elements *= std::max(tensor->dims->data[i], 0);
+  }
+  return num_elements;
+}
+
+const TfLiteTensor* NodeTensor(const Subgraph& subgraph,
+                               const TfLiteIntArray* indices, int index) {
+  if (indices == nullptr || index >= indices->size ||
+      indices->data[index] < 0) {
+    return nullptr;
+  }
+  return subgraph.tensor(indices->data[index]);
+}
+
+// Same rules as the static estimates of litert/tools/model_estimates.cc.
+uint64_t EstimateFlops(const Subgraph& subgraph, const TfLiteNode& node,
+                       const TfLiteRegistration& reg) {
+  const TfLiteTensor* output = NodeTensor(subgraph, node.outputs, 0);
+  const uint64_t output_elements = NumElements(output);
+  switch (reg.builtin_code) {
+    case BuiltinOperator_CONV_2D: {
+      // Filter is [out_channels, kh, kw, in_channels / groups].
+      const TfLiteTensor* filter = NodeTensor(subgraph, node.inputs, 1);
+      return 2 * output_elements * Dim(filter, 1) * Dim(filter, 2) *
+             Dim(filter, 3);
+    }
+    case BuiltinOperator_DEPTHWISE_CONV_2D: {
+      // Filter is [1, kh, kw, out_channels].
+      const TfLiteTensor* filter = NodeTensor(subgraph, node.inputs, 1);
+      return 2 * output_elements * Dim(filter, 1) * Dim(filter, 2);
+    }
+    case BuiltinOperator_TRANSPOSE_CONV: {
+      // Each input element is scattered through the [out_channels, kh, kw,
+      // in_channels] filter.
+      const TfLiteTensor* filter = NodeTensor(subgraph, node.inputs, 1);
+      const TfLiteTensor* input = NodeTensor(subgraph, node.inputs, 2);
+      return 2 * NumElements(input) * Dim(filter, 0) * Dim(filter, 1) *
+             Dim(filter, 2);
+    }
+    case BuiltinOperator_FULLY_CONNECTED:
+      // Weights are [out_channels, depth].
+      return 2 * output_elements *
+             Dim(NodeTensor(subgraph, node.inputs, 1), -1);
+    case BuiltinOperator_BATCH_MATMUL: {
+      // The depth is whatever of the lhs is not in the output.
+      const uint64_t n = Dim(output, -1);
+      if (n == 0 || output_elements == 0) {
+        return 0;
+      }
+      const uint64_t depth =
+          NumElements(NodeTensor(subgraph, node.inputs, 0)) * n /
+          output_elements;
+      return 2 * output_elements * depth;
+    }
+    default:
+      return output_elements;
+  }
+}
+
+uint64_t TensorBytes(const Subgraph& subgraph, const TfLiteIntArray* indices) {
+  uint64_t bytes = 0;
+  for (int i = 0; indices != nullptr && i < indices->size; ++i) {
+    if (const TfLiteTensor* tensor = NodeTensor(subgraph, indices, i)) {
+      bytes += tensor->bytes;
+    }
+  }
+  return bytes;
+}
+
+// The operator invoke events of a node.
+struct NodeTime {
+  int64_t first = 0;
+  int64_t last = 0;
+  int64_t min = 0;
+  int64_t max = 0;
+  int64_t sum = 0;
+  int64_t count = 0;
+};
+
+// Keyed by subgraph and node index.
+using NodeTimes = std::map<std::pair<int64_t, int64_t>, NodeTime>;
+
+NodeTimes GetNodeTimes(const std::vector<const ProfileEvent*>& events) {
+  NodeTimes node_times;
+  for (const ProfileEvent* event : events) {
+    if (event == nullptr ||
+        event->event_type != ProfileEvent::EventType::OPERATOR_INVOKE_EVENT) {
+      continue;
+    }
+    NodeTime& time =
+        node_times[{event->extra_event_metadata, event->event_metadata}];
+    const int64_t elapsed = event->elapsed_time;
+    if (time.count == 0) {
+      time.first = time.min = time.max = elapsed;
+    }
+    time.last = elapsed;
+    time.min = std::min(time.min, elapsed);
+    time.max = std::max(time.max, elapsed);
+    time.sum += elapsed;
+    ++time.count;
+  }
+  return node_times;
+}
+
+void SetMeasuredTime(const NodeTime& time, Node& node_proto) {
+  OpProfileData* op_profile_data = node_proto.mutable_op_profile_data();
+  op_profile_data->set_node_type(node_proto.type());
+  op_profile_data->set_name(node_proto.name());
+  op_profile_data->set_times_called(time.count);
+  OpProfilingStat* stat = op_profile_data->mutable_inference_microseconds();
+  stat->set_first(time.first);
+  stat->set_last(time.last);
+  stat->set_min(time.min);
+  stat->set_max(time.max);
+  stat->set_sum(time.sum);
+  stat->set_count(time.count);
+  stat->set_avg(time.sum / time.count);
+
+  NodeCost* cost = node_proto.mutable_cost();
+  const double time_us = static_cast<double>(time.sum) / time.count;
+  cost->set_measured_time_us(time_us);
+  if (time_us > 0) {
+    // Per microsecond, so 1e3 per giga per second.
+    cost->set_achieved_gflops_per_second(cost->estimated_flops() /
+                                         (time_us * 1e3));
+    cost->set_achieved_gb_per_second(cost->estimated_bytes() /
+                                     (time_us * 1e3));
+  }
+}
+
+// Sets the cost of the nodes of `subgraph`, whose protos are `nodes`.
+void SetNodeCosts(const Subgraph& subgraph, int subgraph_index,
+                  const NodeTimes& node_times,
+                  google::protobuf::RepeatedPtrField<Node>& nodes) {
+  for (size_t node_index = 0; node_index < subgraph.nodes_size();
+       ++node_index) {
+    const auto* node_and_reg =
+        subgraph.node_and_registration(static_cast<int>(node_index));
+    const TfLiteNode& node = node_and_reg->first;
+    Node& node_proto = nodes[node_index];
+    NodeCost* cost = node_proto.mutable_cost();
+    cost->set_estimated_flops(
+        EstimateFlops(subgraph, node, node_and_reg->second));
+    cost->set_estimated_bytes(TensorBytes(subgraph, node.inputs) +
+                              TensorBytes(subgraph, node.outputs));
+    cost->set_partition_id(node_proto.has_delegated_to_node_id()
+                               ? node_proto.delegated_to_node_id()
+                               : node_index);
+  }
+
+  // A delegate node does the work of the nodes it replaced.
+  for (Node& node : nodes) {
+    if (!node.has_delegate_node_details()) {
+      continue;
+    }
+    int64_t flops = 0;
+    for (int replaced :
+         node.delegate_node_details().tflite_node_ids_replaced()) {
+      if (replaced >= 0 && replaced < nodes.size()) {
+        flops += nodes[replaced].cost().estimated_flops();
+      }
+    }
+    node.mutable_cost()->set_estimated_flops(flops);
+  }
+
+  for (Node& node : nodes) {
+    NodeCost* cost = node.mutable_cost();
+    if (cost->estimated_bytes() > 0) {
+      cost->set_arithmetic_intensity(
+          static_cast<double>(cost->estimated_flops()) /
+          cost->estimated_bytes());
+    }
+    const auto time = node_times.find({subgraph_index, node.id()});
+    if (time != node_times.end()) {
+      SetMeasuredTime(time->second, node);
+    }
+  }
+}
 }  // namespace
 
 TfLiteStatus GenerateModelRuntimeInfo(
     const tflite::Interpreter& interpreter,
     ModelRuntimeDetails& model_runtime_details) {
+  return GenerateModelRuntimeInfo(interpreter, /*profile_events=*/{},
+                                  model_runtime_details);
+}
+
+TfLiteStatus GenerateModelRuntimeInfo(
+    const tflite::Interpreter& interpreter,
+    const std::vector<const ProfileEvent*>& profile_events,
+    ModelRuntimeDetails& model_runtime_details) {
   const size_t num_subgraphs = interpreter.subgraphs_size();
+  const NodeTimes node_times = GetNodeTimes(profile_events);
 
   for (int i = 0; i < num_subgraphs; ++i) {
     RuntimeSubgraph* runtime_subgraph = model_runtime_details.add_subgraphs();
@@ -220,6 +435,8 @@ TfLiteStatus GenerateModelRuntimeInfo(
       }
     }
 
+    SetNodeCosts(subgraph, i, node_times, *runtime_subgraph->mutable_nodes());
+
     // Save the execution plan to runtime subgraph.
     runtime_subgraph->mutable_execution_plan()->Add(
         subgraph.execution_plan().begin(), subgraph.execution_plan().end());
@@ -229,8 +446,17 @@ TfLiteStatus GenerateModelRuntimeInfo(
 
 TfLiteStatus GenerateModelRuntimeInfo(const tflite::Interpreter& interpreter,
                                       absl::string_view output_file_path) {
+  return GenerateModelRuntimeInfo(interpreter, /*profile_events=*/{},
+                                  output_file_path);
+}
+
+TfLiteStatus GenerateModelRuntimeInfo(
+    const tflite::Interpreter& interpreter,
+    const std::vector<const ProfileEvent*>& profile_events,
+    absl::string_view output_file_path) {
   ModelRuntimeDetails model_runtime_details;
-  auto status = GenerateModelRuntimeInfo(interpreter, model_runtime_details);
+  auto status = GenerateModelRuntimeInfo(interpreter, profile_events,
+                                         model_runtime_details);
   if (status != kTfLiteOk) {
     TFLITE_LOG(ERROR) << "Failed to generate model runtime info: " << status;
     return status;
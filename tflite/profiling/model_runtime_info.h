@@ -16,8 +16,11 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_PROFILING_MODEL_RUNTIME_INFO_H_
 #define TENSORFLOW_LITE_PROFILING_MODEL_RUNTIME_INFO_H_
 
+#include <vector>
+
 #include "absl/strings/string_view.h"
 #include "tflite/core/interpreter.h"
+#include "tflite/profiling/profile_buffer.h"
 #include "tflite/profiling/proto/model_runtime_info.pb.h"
 
 namespace tflite {
@@ -32,6 +35,18 @@ TfLiteStatus GenerateModelRuntimeInfo(const Interpreter &interpreter,
 // the given model_runtime_details proto.
 TfLiteStatus GenerateModelRuntimeInfo(
     const Interpreter &interpreter, ModelRuntimeDetails &model_runtime_details);
+
+// Same as above, with the measured time of the nodes and their achieved
+// throughput. `profile_events` are those of the profiled runs, of which only
+// the operator invoke events are used.
+TfLiteStatus GenerateModelRuntimeInfo(
+    const Interpreter &interpreter,
+    const std::vector<const ProfileEvent *> &profile_events,
+    absl::string_view output_file_path);
+TfLiteStatus GenerateModelRuntimeInfo(
+    const Interpreter &interpreter,
+    const std::vector<const ProfileEvent *> &profile_events,
+    ModelRuntimeDetails &model_runtime_details);
 }  // namespace profiling
 }  // namespace tflite
 
@@ -386,5 +386,77 @@ TEST(MODEL_RUNTIME_INFO_TEST, PadAndConv2DWithXnnpackDelegate) {
                                           expected_model_runtime_details));
 }
 
+TEST(MODEL_RUNTIME_INFO_TEST, PadAndConv2DNodeCosts) {
+  auto profiler = std::make_unique<profiling::BufferedProfiler>(1024, false);
+
+  PadAndConv2DModel model(nullptr);
+  model.Initialize(profiler.get());
+  model.ResetProfilerAndInvoke(profiler.get());
+
+  ModelRuntimeDetails model_runtime_details;
+  ASSERT_EQ(GenerateModelRuntimeInfo(*model.interpreter(),
+                                     profiler->GetProfileEvents(),
+                                     model_runtime_details),
+            kTfLiteOk);
+  ASSERT_EQ(model_runtime_details.subgraphs_size(), 1);
+  const RuntimeSubgraph& subgraph = model_runtime_details.subgraphs(0);
+  ASSERT_EQ(subgraph.nodes_size(), 2);
+
+  // One per element of the [1, 5, 5, 1] output.
+  const NodeCost& pad = subgraph.nodes(0).cost();
+  EXPECT_EQ(pad.estimated_flops(), 25);
+  EXPECT_EQ(pad.estimated_bytes(), 36 + 32 + 100);
+  EXPECT_EQ(pad.partition_id(), 0);
+
+  // Two per multiply-accumulate of the [1, 2, 2, 1] filter.
+  const NodeCost& conv = subgraph.nodes(1).cost();
+  EXPECT_EQ(conv.estimated_flops(), 2 * 25 * 4);
+  EXPECT_EQ(conv.estimated_bytes(), 100 + 16 + 4 + 100);
+  EXPECT_DOUBLE_EQ(conv.arithmetic_intensity(), 200.0 / 220);
+  EXPECT_EQ(conv.partition_id(), 1);
+
+  for (const Node& node : subgraph.nodes()) {
+    EXPECT_EQ(node.op_profile_data().times_called(), 1);
+    EXPECT_EQ(node.op_profile_data().inference_microseconds().count(), 1);
+    EXPECT_GE(node.cost().measured_time_us(), 0);
+  }
+}
+
+TEST(MODEL_RUNTIME_INFO_TEST, PadAndConv2DNodeCostsWithXnnpackDelegate) {
+  auto profiler = std::make_unique<profiling::BufferedProfiler>(1024, false);
+
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  PadAndConv2DModel xnnpack_model(xnnpack_delegate.get());
+  xnnpack_model.Initialize(profiler.get());
+  xnnpack_model.ResetProfilerAndInvoke(profiler.get());
+
+  ModelRuntimeDetails model_runtime_details;
+  ASSERT_EQ(GenerateModelRuntimeInfo(*xnnpack_model.interpreter(),
+                                     profiler->GetProfileEvents(),
+                                     model_runtime_details),
+            kTfLiteOk);
+  const RuntimeSubgraph& subgraph = model_runtime_details.subgraphs(0);
+  ASSERT_EQ(subgraph.nodes_size(), 3);
+
+  // The delegated nodes don't run on their own.
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(subgraph.nodes(i).cost().partition_id(), 2);
+    EXPECT_FALSE(subgraph.nodes(i).cost().has_measured_time_us());
+    EXPECT_FALSE(subgraph.nodes(i).has_op_profile_data());
+  }
+
+  // The delegate node does the work of both, and only moves the tensors
+  // crossing its boundary.
+  const Node& delegate_node = subgraph.nodes(2);
+  EXPECT_EQ(delegate_node.cost().estimated_flops(), 25 + 200);
+  EXPECT_EQ(delegate_node.cost().estimated_bytes(), 36 + 32 + 16 + 4 + 100);
+  EXPECT_EQ(delegate_node.cost().partition_id(), 2);
+  EXPECT_TRUE(delegate_node.cost().has_measured_time_us());
+  EXPECT_EQ(delegate_node.op_profile_data().times_called(), 1);
+}
+
 }  // namespace profiling
 }  // namespace tflite
@@ -448,6 +448,10 @@ def build_conversion_flags(
     canonicalizing_inf_as_min_max_float=True,
     serialize_debug_metadata=False,
     unsafe_fuse_dynamic_shaped_broadcast=False,
+    lift_state_to_variables=False,
+    minimize_peak_memory=False,
+    peak_memory_locality_penalty=0,
+    constant_folding_budget_bytes=-1,
     **_,
 ):
   """Builds protocol buffer describing a conversion of a model.
@@ -586,6 +590,17 @@ def build_conversion_flags(
       when output shape has dynamic dimensions, but it may cause incorrect
       results when broadcasting ops are introduced by explicit broadcasting in
       the source model.
+    lift_state_to_variables: When set to true, converts signature inputs that
+      are returned, updated, by an output of the same name, such as KV caches,
+      into resource variables shared by the signatures.
+    minimize_peak_memory: When set to true, reorders the operations to reduce
+      the peak memory of the activations.
+    peak_memory_locality_penalty: Bytes of memory that keeping Flex delegated
+      operations together is worth when `minimize_peak_memory` is set.
+    constant_folding_budget_bytes: Size in bytes below which constant folding
+      always creates constants. Larger constants, such as broadcasts of shared
+      weights, are kept as runtime ops unless folding at most doubles the
+      constants it replaces. The default of the converter applies if negative.
 
   Returns:
     conversion_flags: protocol buffer describing the conversion process.
@@ -719,6 +734,12 @@ def build_conversion_flags(
   conversion_flags.unsafe_fuse_dynamic_shaped_broadcast = (
       unsafe_fuse_dynamic_shaped_broadcast
   )
+  conversion_flags.lift_state_to_variables = lift_state_to_variables
+  conversion_flags.minimize_peak_memory = minimize_peak_memory
+  conversion_flags.peak_memory_locality_penalty = peak_memory_locality_penalty
+  conversion_flags.constant_folding_budget_bytes = (
+      constant_folding_budget_bytes
+  )
 
   return conversion_flags
 
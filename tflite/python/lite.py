@@ -686,6 +686,10 @@ class TFLiteConverterBase:
     self.canonicalizing_inf_as_min_max_float = True
     self._experimental_strict_qdq = False
     self._experimental_unsafe_fuse_dynamic_shaped_broadcast = False
+    self._experimental_lift_state_to_variables = False
+    self._experimental_minimize_peak_memory = False
+    self._experimental_peak_memory_locality_penalty = 0
+    self._experimental_constant_folding_budget_bytes = -1
 
     # Debug parameters
     self.ir_dump_dir = None
@@ -858,6 +862,16 @@ class TFLiteConverterBase:
         "unsafe_fuse_dynamic_shaped_broadcast": (
             self._experimental_unsafe_fuse_dynamic_shaped_broadcast
         ),
+        "lift_state_to_variables": (
+            self._experimental_lift_state_to_variables
+        ),
+        "minimize_peak_memory": self._experimental_minimize_peak_memory,
+        "peak_memory_locality_penalty": (
+            self._experimental_peak_memory_locality_penalty
+        ),
+        "constant_folding_budget_bytes": (
+            self._experimental_constant_folding_budget_bytes
+        ),
     }
 
     if self.saved_model_dir:
@@ -31,6 +31,13 @@ limitations under the License.
 #include "tflite/tensorflow_profiler_logger.h"
 #endif  // TF_LITE_TENSORFLOW_PROFILER
 
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // defined(__linux__)
+
 #if defined(__ANDROID__)
 // Android has C11 aligned_alloc only with API 28 or newer, even with C++17 or
 // C11 compilation (this is a non-standard behavior).
@@ -58,6 +65,16 @@ T AlignTo(size_t alignment, T offset) {
                                  : offset + (alignment - offset % alignment);
 }
 
+// Rounds `size` up to a multiple of the largest power of two at most a quarter
+// of it, i.e. to one of four size classes per power of two.
+size_t GetSizeClass(size_t size) {
+  size_t step = 1;
+  while (step <= size / 8) {
+    step *= 2;
+  }
+  return AlignTo(step, size);
+}
+
 // Allocates memory and aligns it to the specified size. Returns a pair of the
 // allocation pointer and the aligned pointer.
 tflite::PointerAlignedPointerPair AlignedAlloc(size_t size, size_t alignment);
@@ -145,6 +162,93 @@ tflite::PointerAlignedPointerPair AlignedRealloc(
   return new_buffer;
 }
 #endif
+
+size_t GetPageSize() {
+#if defined(__linux__)
+  static const size_t page_size = sysconf(_SC_PAGESIZE);
+  return page_size;
+#else
+  return 4096;
+#endif
+}
+
+#if defined(__linux__)
+constexpr size_t kHugePageSize = size_t{2} << 20;
+
+// Maps at least `size` bytes as `options` ask, and returns the size of the
+// mapping in `mapped_size`. Leaves `mapped_size` at 0, and returns null
+// pointers, if the options don't need a mapping or it fails.
+tflite::PointerAlignedPointerPair MappedAlloc(
+    size_t size, size_t alignment, const tflite::ArenaBufferOptions& options,
+    size_t* mapped_size) {
+  using HugePages = tflite::ArenaBufferOptions::HugePages;
+  *mapped_size = 0;
+  if ((options.huge_pages == HugePages::kNone && options.numa_node < 0) ||
+      alignment > GetPageSize()) {
+    return {nullptr, nullptr};
+  }
+  const bool huge_pages = options.huge_pages != HugePages::kNone;
+  const size_t length =
+      AlignTo(huge_pages ? kHugePageSize : GetPageSize(), size);
+  void* pointer = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  if (options.huge_pages == HugePages::kExplicit) {
+    pointer = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  }
+#endif
+  if (pointer == MAP_FAILED) {
+    pointer = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pointer == MAP_FAILED) {
+      return {nullptr, nullptr};
+    }
+#ifdef MADV_HUGEPAGE
+    if (huge_pages) {
+      madvise(pointer, length, MADV_HUGEPAGE);
+    }
+#endif
+  }
+  if (options.numa_node >= 0) {
+    // The node is preferred rather than required, so that running out of
+    // memory on it doesn't fail the allocation. Like the huge pages advice,
+    // this is best effort.
+    constexpr int kBitsPerMask = 8 * sizeof(unsigned long);  // NOLINT
+    std::vector<unsigned long> node_mask(  // NOLINT
+        options.numa_node / kBitsPerMask + 1, 0);
+    node_mask[options.numa_node / kBitsPerMask] |=
+        1UL << (options.numa_node % kBitsPerMask);
+    syscall(SYS_mbind, pointer, length, MPOL_PREFERRED, node_mask.data(),
+            node_mask.size() * kBitsPerMask + 1, 0);
+  }
+  *mapped_size = length;
+  char* mapped_pointer = static_cast<char*>(pointer);
+  return {mapped_pointer, mapped_pointer};
+}
+#endif  // defined(__linux__)
+
+// Frees the buffer from MappedAlloc() if `mapped_size` isn't 0, or from
+// AlignedAlloc() otherwise.
+void FreeBuffer(const tflite::PointerAlignedPointerPair& buffer,
+                size_t mapped_size) {
+#if defined(__linux__)
+  if (mapped_size > 0) {
+    munmap(buffer.pointer, mapped_size);
+    return;
+  }
+#endif
+  AlignedFree(buffer);
+}
+
+// Writes to each page of the `size` bytes at `data`, so that they are backed
+// by memory.
+void Prefault(char* data, size_t size) {
+  const size_t page_size = GetPageSize();
+  volatile char* pages = data;
+  for (size_t i = 0; i < size; i += page_size) {
+    pages[i] = 0;
+  }
+}
 }  // namespace
 
 namespace tflite {
@@ -163,10 +267,34 @@ bool ResizableAlignedBuffer::Resize(size_t new_size) {
                          reinterpret_cast<std::uintptr_t>(this), data_size_);
   }
 #endif
-  auto new_buffer = AlignedRealloc(buffer_, data_size_, new_size, alignment_);
+  PointerAlignedPointerPair new_buffer = buffer_;
+  size_t new_mapped_size = mapped_size_;
+  // The mapping is rounded up to whole pages, which may leave room to grow.
+  if (new_size > mapped_size_) {
+    new_mapped_size = 0;
+#if defined(__linux__)
+    new_buffer = MappedAlloc(new_size, alignment_, options_, &new_mapped_size);
+#endif
+    if (new_mapped_size == 0 && mapped_size_ == 0) {
+      new_buffer = AlignedRealloc(buffer_, data_size_, new_size, alignment_);
+    } else {
+      if (new_mapped_size == 0) {
+        new_buffer = AlignedAlloc(new_size, alignment_);
+      }
+      if (data_size_ > 0) {
+        std::memcpy(new_buffer.aligned_pointer, buffer_.aligned_pointer,
+                    data_size_);
+      }
+      FreeBuffer(buffer_, mapped_size_);
+    }
+  }
+  if (options_.prefault) {
+    Prefault(new_buffer.aligned_pointer + data_size_, new_size - data_size_);
+  }
   bool reallocated = (new_buffer.aligned_pointer != buffer_.aligned_pointer);
   buffer_ = new_buffer;
   data_size_ = new_size;
+  mapped_size_ = new_mapped_size;
 #ifdef TF_LITE_TENSORFLOW_PROFILER
   PauseHeapMonitoring(/*pause=*/false);
 #endif
@@ -181,10 +309,11 @@ void ResizableAlignedBuffer::Release() {
   OnTfLiteArenaDealloc(subgraph_index_, reinterpret_cast<std::uintptr_t>(this),
                        data_size_);
 #endif
-  AlignedFree(buffer_);
+  FreeBuffer(buffer_, mapped_size_);
   buffer_.pointer = nullptr;
   buffer_.aligned_pointer = nullptr;
   data_size_ = 0;
+  mapped_size_ = 0;
 }
 
 void SimpleMemoryArena::PurgeAfter(int32_t node) {
@@ -284,11 +413,57 @@ TfLiteStatus SimpleMemoryArena::Allocate(
   return kTfLiteOk;
 }
 
+TfLiteStatus SimpleMemoryArena::AllocateAt(
+    TfLiteContext* context, size_t alignment, size_t offset, size_t size,
+    int32_t tensor, int32_t first_node, int32_t last_node,
+    ArenaAllocWithUsageInterval* new_alloc) {
+  TF_LITE_ENSURE(context, alignment <= underlying_buffer_.GetAlignment());
+  TF_LITE_ENSURE(context, alignment > 0 && offset % alignment == 0);
+  if (size == 0) {
+    return Allocate(context, alignment, size, tensor, first_node, last_node,
+                    new_alloc);
+  }
+  for (const auto& alloc : active_allocs_) {
+    if (alloc.last_node < first_node || alloc.first_node > last_node) {
+      continue;
+    }
+    TF_LITE_ENSURE(context, alloc.offset + alloc.size <= offset ||
+                                offset + size <= alloc.offset);
+  }
+  new_alloc->tensor = tensor;
+  new_alloc->first_node = first_node;
+  new_alloc->last_node = last_node;
+  new_alloc->size = size;
+  new_alloc->offset = offset;
+
+  high_water_mark_ = std::max(high_water_mark_, offset + size);
+  auto insertion_it = std::upper_bound(active_allocs_.begin(),
+                                       active_allocs_.end(), *new_alloc);
+  active_allocs_.insert(insertion_it, *new_alloc);
+  return kTfLiteOk;
+}
+
 TfLiteStatus SimpleMemoryArena::Commit(bool* arena_reallocated) {
-  // Resize the arena to the high water mark (calculated by Allocate), retaining
-  // old contents and alignment in the process. Since Alloc pointers are offset
-  // based, they will remain valid in the new memory block.
-  *arena_reallocated = underlying_buffer_.Resize(high_water_mark_);
+  char* previous_ptr = GetPtr();
+  if (external_buffer_ != nullptr &&
+      high_water_mark_ <= external_buffer_size_) {
+    // The contents are not retained when moving to the external buffer: it
+    // only hands out memory for the time the owner doesn't use it.
+    underlying_buffer_.Release();
+    uses_external_buffer_ = true;
+  } else {
+    // Resize the arena to the high water mark (calculated by Allocate),
+    // retaining old contents and alignment in the process. Since Alloc
+    // pointers are offset based, they will remain valid in the new memory
+    // block.
+    uses_external_buffer_ = false;
+    size_t new_size = high_water_mark_;
+    if (grow_in_size_classes_ && new_size > underlying_buffer_.GetSize()) {
+      new_size = GetSizeClass(new_size);
+    }
+    underlying_buffer_.Resize(new_size);
+  }
+  *arena_reallocated = GetPtr() != previous_ptr;
   committed_ = true;
   return kTfLiteOk;
 }
@@ -298,12 +473,11 @@ TfLiteStatus SimpleMemoryArena::ResolveAlloc(
     char** output_ptr) {
   TF_LITE_ENSURE(context, committed_);
   TF_LITE_ENSURE(context, output_ptr != nullptr);
-  TF_LITE_ENSURE(context,
-                 underlying_buffer_.GetSize() >= (alloc.offset + alloc.size));
+  TF_LITE_ENSURE(context, GetSize() >= (alloc.offset + alloc.size));
   if (alloc.size == 0) {
     *output_ptr = nullptr;
   } else {
-    *output_ptr = underlying_buffer_.GetPtr() + alloc.offset;
+    *output_ptr = GetPtr() + alloc.offset;
   }
   return kTfLiteOk;
 }
@@ -317,6 +491,7 @@ TfLiteStatus SimpleMemoryArena::ClearPlan() {
 
 TfLiteStatus SimpleMemoryArena::ReleaseBuffer() {
   committed_ = false;
+  uses_external_buffer_ = false;
   underlying_buffer_.Release();
   return kTfLiteOk;
 }
@@ -329,8 +504,7 @@ TFLITE_ATTRIBUTE_WEAK void DumpArenaInfo(
 
 void SimpleMemoryArena::DumpDebugInfo(
     const std::string& name, const std::vector<int>& execution_plan) const {
-  tflite::DumpArenaInfo(name, execution_plan, underlying_buffer_.GetSize(),
-                        active_allocs_);
+  tflite::DumpArenaInfo(name, execution_plan, GetSize(), active_allocs_);
 }
 
 }  // namespace tflite
@@ -53,6 +53,26 @@ struct ArenaAllocWithUsageInterval {
   }
 };
 
+// How the memory of an arena buffer is backed. By default it comes from
+// aligned malloc. Huge pages and NUMA placement are only supported on Linux,
+// and ignored elsewhere.
+struct ArenaBufferOptions {
+  enum class HugePages {
+    kNone,
+    // Advises the kernel to back the buffer with transparent huge pages.
+    kTransparent,
+    // Maps the buffer from the reserved huge page pool, or with transparent
+    // huge pages if the pool is exhausted.
+    kExplicit,
+  };
+  HugePages huge_pages = HugePages::kNone;
+  // NUMA node the memory of the buffer should preferably come from, or -1.
+  int numa_node = -1;
+  // Touches all the pages of the buffer when it is allocated, so that the
+  // page faults don't happen during inference.
+  bool prefault = false;
+};
+
 struct PointerAlignedPointerPair {
   char* pointer;
   char* aligned_pointer;
@@ -63,6 +83,7 @@ class ResizableAlignedBuffer {
   ResizableAlignedBuffer(size_t alignment, int subgraph_index)
       : buffer_{nullptr, nullptr},
         data_size_(0),
+        mapped_size_(0),
         alignment_(alignment),
         subgraph_index_(subgraph_index) {
     // To silence unused private member warning, only used with
@@ -87,6 +108,9 @@ class ResizableAlignedBuffer {
   // Alignment of the data array.
   size_t GetAlignment() const { return alignment_; }
 
+  // Sets how the memory is backed, from the next time it is allocated.
+  void SetOptions(const ArenaBufferOptions& options) { options_ = options; }
+
  private:
   ResizableAlignedBuffer(const ResizableAlignedBuffer&) = delete;
   ResizableAlignedBuffer& operator=(const ResizableAlignedBuffer&) = delete;
@@ -95,7 +119,11 @@ class ResizableAlignedBuffer {
 
   PointerAlignedPointerPair buffer_;
   size_t data_size_;
+  // Size of the mapping holding the data array if it was mapped rather than
+  // allocated with malloc, 0 otherwise.
+  size_t mapped_size_;
   size_t alignment_;
+  ArenaBufferOptions options_;
 
   int subgraph_index_;
 };
@@ -111,6 +139,10 @@ class SimpleMemoryArena {
       : committed_(false),
         high_water_mark_(0),
         underlying_buffer_(arena_alignment, subgraph_index),
+        external_buffer_(nullptr),
+        external_buffer_size_(0),
+        uses_external_buffer_(false),
+        grow_in_size_classes_(false),
         active_allocs_() {}
 
   // Delete all allocs. This should be called when allocating the first node of
@@ -144,6 +176,45 @@ class SimpleMemoryArena {
 
   TfLiteStatus Commit(bool* arena_reallocated);
 
+  // Schedule memory allocation for a tensor like Allocate(), but at the given
+  // `offset` instead of at the best fit. Fails, without allocating, if the
+  // offset is not aligned or overlaps an alloc with an intersecting usage
+  // interval.
+  TfLiteStatus AllocateAt(TfLiteContext* context, size_t alignment,
+                          size_t offset, size_t size, int32_t tensor,
+                          int32_t first_node, int32_t last_node,
+                          ArenaAllocWithUsageInterval* new_alloc);
+
+  // Makes the next Commit() place the arena in the `size` bytes at `buffer`,
+  // owned by someone else, instead of in its own buffer, if the allocations
+  // fit. `buffer` must be aligned to the arena alignment. Pass nullptr to go
+  // back to the own buffer.
+  void SetExternalBuffer(char* buffer, size_t size) {
+    external_buffer_ = buffer;
+    external_buffer_size_ = size;
+  }
+
+  // Size the allocations require, as of the last Allocate().
+  size_t GetHighWaterMark() const { return high_water_mark_; }
+
+  // Makes Commit() grow the own buffer to the next size class, with at most
+  // 25% of slack, instead of to the exact high water mark. Since the buffer
+  // never shrinks, this keeps allocations whose size keeps changing, e.g. with
+  // the sequence length, from reallocating the buffer each time.
+  void SetGrowInSizeClasses(bool grow_in_size_classes) {
+    grow_in_size_classes_ = grow_in_size_classes;
+  }
+
+  // Sets how the memory of the own buffer is backed, from the next time it
+  // grows.
+  void SetBufferOptions(const ArenaBufferOptions& options) {
+    underlying_buffer_.SetOptions(options);
+  }
+
+  // Size of the buffer the arena was last committed to, whether its own or an
+  // external one.
+  size_t GetCommittedSize() const { return GetSize(); }
+
   TfLiteStatus ResolveAlloc(TfLiteContext* context,
                             const ArenaAllocWithUsageInterval& alloc,
                             char** output_ptr);
@@ -158,10 +229,12 @@ class SimpleMemoryArena {
   // again until Commit() is called & tensor allocations are resolved.
   TfLiteStatus ReleaseBuffer();
 
+  // Size of the buffer owned by the arena, which is 0 while it is placed in an
+  // external buffer.
   size_t GetBufferSize() const { return underlying_buffer_.GetSize(); }
 
   std::intptr_t BasePointer() const {
-    return reinterpret_cast<std::intptr_t>(underlying_buffer_.GetPtr());
+    return reinterpret_cast<std::intptr_t>(GetPtr());
   }
 
   // Dumps the memory allocation information of this memory arena (which could
@@ -182,9 +255,23 @@ class SimpleMemoryArena {
                      const std::vector<int>& execution_plan) const;
 
  private:
+  char* GetPtr() const {
+    return uses_external_buffer_ ? external_buffer_
+                                 : underlying_buffer_.GetPtr();
+  }
+  size_t GetSize() const {
+    return uses_external_buffer_ ? external_buffer_size_
+                                 : underlying_buffer_.GetSize();
+  }
+
   bool committed_;
   size_t high_water_mark_;
   ResizableAlignedBuffer underlying_buffer_;
+  char* external_buffer_;
+  size_t external_buffer_size_;
+  // True when the last Commit() placed the arena in `external_buffer_`.
+  bool uses_external_buffer_;
+  bool grow_in_size_classes_;
   std::vector<ArenaAllocWithUsageInterval> active_allocs_;
 };
 
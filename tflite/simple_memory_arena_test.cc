@@ -14,6 +14,9 @@ limitations under the License.
 ==============================================================================*/
 #include "tflite/simple_memory_arena.h"
 
+#include <cstdint>
+#include <cstring>
+
 #include <gtest/gtest.h>
 #include "tflite/core/c/common.h"
 
@@ -321,6 +324,111 @@ TEST(SimpleMemoryArenaTest, TestClearBuffer) {
   EXPECT_NE(resolved_ptr, nullptr);
 }
 
+TEST(SimpleMemoryArenaTest, TestExternalBuffer) {
+  TfLiteContext context;
+  context.ReportError = ReportError;
+  SimpleMemoryArena arena(64);
+  ArenaAllocWithUsageInterval allocs[2];
+  alignas(64) char external_buffer[4096];
+
+  arena.Allocate(&context, 32, 2047, 0, 0, 2, &allocs[0]);
+  arena.Allocate(&context, 32, 2047, 1, 1, 2, &allocs[1]);
+  EXPECT_EQ(arena.GetHighWaterMark(), 4095);
+
+  // The allocations fit in the external buffer.
+  arena.SetExternalBuffer(external_buffer, sizeof(external_buffer));
+  bool reallocated = false;
+  ASSERT_EQ(arena.Commit(&reallocated), kTfLiteOk);
+  EXPECT_TRUE(reallocated);
+  EXPECT_EQ(arena.BasePointer(),
+            reinterpret_cast<std::intptr_t>(external_buffer));
+  EXPECT_EQ(arena.GetBufferSize(), 0);
+  char* resolved_ptr = nullptr;
+  ASSERT_EQ(arena.ResolveAlloc(&context, allocs[1], &resolved_ptr), kTfLiteOk);
+  EXPECT_EQ(resolved_ptr, external_buffer + 2048);
+
+  // They no longer fit, so the arena goes back to its own buffer.
+  arena.Allocate(&context, 32, 2047, 2, 1, 2, &allocs[0]);
+  ASSERT_EQ(arena.Commit(&reallocated), kTfLiteOk);
+  EXPECT_TRUE(reallocated);
+  EXPECT_NE(arena.BasePointer(),
+            reinterpret_cast<std::intptr_t>(external_buffer));
+  EXPECT_EQ(arena.GetBufferSize(), 6143);
+
+  // Without an external buffer, the arena keeps its own buffer.
+  arena.SetExternalBuffer(nullptr, 0);
+  ASSERT_EQ(arena.Commit(&reallocated), kTfLiteOk);
+  EXPECT_FALSE(reallocated);
+}
+
+TEST(SimpleMemoryArenaTest, TestGrowInSizeClasses) {
+  TfLiteContext context;
+  context.ReportError = ReportError;
+  SimpleMemoryArena arena(64);
+  arena.SetGrowInSizeClasses(true);
+  ArenaAllocWithUsageInterval alloc;
+  bool reallocated = false;
+
+  arena.Allocate(&context, 32, 1000, 0, 0, 2, &alloc);
+  ASSERT_EQ(arena.Commit(&reallocated), kTfLiteOk);
+  // The size classes between 512 and 1024 are 128 bytes apart.
+  EXPECT_EQ(arena.GetBufferSize(), 1024);
+
+  // Growing within the size class doesn't reallocate.
+  arena.ClearPlan();
+  arena.Allocate(&context, 32, 1010, 0, 0, 2, &alloc);
+  ASSERT_EQ(arena.Commit(&reallocated), kTfLiteOk);
+  EXPECT_FALSE(reallocated);
+  EXPECT_EQ(arena.GetBufferSize(), 1024);
+
+  // Nor does shrinking.
+  arena.ClearPlan();
+  arena.Allocate(&context, 32, 100, 0, 0, 2, &alloc);
+  ASSERT_EQ(arena.Commit(&reallocated), kTfLiteOk);
+  EXPECT_FALSE(reallocated);
+  EXPECT_EQ(arena.GetBufferSize(), 1024);
+
+  arena.ClearPlan();
+  arena.Allocate(&context, 32, 1100, 0, 0, 2, &alloc);
+  ASSERT_EQ(arena.Commit(&reallocated), kTfLiteOk);
+  EXPECT_EQ(arena.GetBufferSize(), 1280);
+}
+
+TEST(SimpleMemoryArenaTest, TestBufferOptions) {
+  TfLiteContext context;
+  context.ReportError = ReportError;
+  for (const auto huge_pages : {ArenaBufferOptions::HugePages::kNone,
+                                ArenaBufferOptions::HugePages::kTransparent,
+                                ArenaBufferOptions::HugePages::kExplicit}) {
+    SimpleMemoryArena arena(64);
+    ArenaBufferOptions options;
+    options.huge_pages = huge_pages;
+    options.numa_node = 0;
+    options.prefault = true;
+    arena.SetBufferOptions(options);
+    ArenaAllocWithUsageInterval allocs[2];
+    arena.Allocate(&context, 64, 3 << 20, 0, 0, 2, &allocs[0]);
+    bool reallocated = false;
+    ASSERT_EQ(arena.Commit(&reallocated), kTfLiteOk);
+    EXPECT_EQ(arena.BasePointer() % 64, 0);
+    EXPECT_EQ(arena.GetBufferSize(), 3 << 20);
+    char* ptr = nullptr;
+    ASSERT_EQ(arena.ResolveAlloc(&context, allocs[0], &ptr), kTfLiteOk);
+    std::memset(ptr, 42, 3 << 20);
+
+    // Growing the arena keeps its contents.
+    arena.Allocate(&context, 64, 2 << 20, 1, 1, 2, &allocs[1]);
+    ASSERT_EQ(arena.Commit(&reallocated), kTfLiteOk);
+    EXPECT_EQ(arena.GetBufferSize(), 5 << 20);
+    ASSERT_EQ(arena.ResolveAlloc(&context, allocs[0], &ptr), kTfLiteOk);
+    EXPECT_EQ(ptr[0], 42);
+    EXPECT_EQ(ptr[(3 << 20) - 1], 42);
+    ASSERT_EQ(arena.ResolveAlloc(&context, allocs[1], &ptr), kTfLiteOk);
+    std::memset(ptr, 0, 2 << 20);
+    EXPECT_EQ(arena.ReleaseBuffer(), kTfLiteOk);
+  }
+}
+
 // Test parameterized by whether ClearBuffer() is called before ClearPlan(), or
 // vice versa.
 class BufferAndPlanClearingTest : public ::testing::Test,
@@ -0,0 +1,331 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/tensor_views.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "tflite/builtin_ops.h"
+#include "tflite/core/c/builtin_op_data.h"
+#include "tflite/core/c/common.h"
+
+namespace tflite {
+namespace {
+
+// Whether the elements of `a` and `b` have the same type and quantization, so
+// that copying them doesn't change them.
+bool HaveSameElements(const TfLiteTensor& a, const TfLiteTensor& b) {
+  if (a.type != b.type || a.type == kTfLiteString ||
+      a.type == kTfLiteResource || a.type == kTfLiteVariant ||
+      a.type == kTfLiteNoType) {
+    return false;
+  }
+  if (a.params.scale != b.params.scale ||
+      a.params.zero_point != b.params.zero_point ||
+      a.quantization.type != b.quantization.type) {
+    return false;
+  }
+  if (a.quantization.type == kTfLiteAffineQuantization) {
+    // Per-channel quantizations are not compared.
+    for (const TfLiteTensor* tensor : {&a, &b}) {
+      const auto* quantization = static_cast<const TfLiteAffineQuantization*>(
+          tensor->quantization.params);
+      if (quantization == nullptr || quantization->scale == nullptr ||
+          quantization->scale->size != 1) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool HaveSameRank(const TfLiteTensor& a, const TfLiteTensor& b) {
+  return a.dims != nullptr && b.dims != nullptr && a.dims->size == b.dims->size;
+}
+
+// Returns the number of bytes of an element of `tensor`, or 0 if the tensor
+// is empty or its size is inconsistent with its shape.
+size_t GetElementSize(const TfLiteTensor& tensor) {
+  size_t num_elements = 1;
+  for (int d = 0; d < tensor.dims->size; ++d) {
+    if (tensor.dims->data[d] < 0) {
+      return 0;
+    }
+    num_elements *= tensor.dims->data[d];
+  }
+  if (num_elements == 0 || tensor.bytes % num_elements != 0) {
+    return 0;
+  }
+  return tensor.bytes / num_elements;
+}
+
+// Reads the values of the constant 1D int32 or int64 tensor `tensor_index`.
+bool GetConstantValues(const TfLiteTensor* tensors, int32_t tensor_index,
+                       std::vector<int64_t>* values) {
+  if (tensor_index == kTfLiteOptionalTensor) {
+    return false;
+  }
+  const TfLiteTensor& tensor = tensors[tensor_index];
+  if ((tensor.allocation_type != kTfLiteMmapRo &&
+       tensor.allocation_type != kTfLitePersistentRo) ||
+      tensor.data.raw == nullptr || tensor.dims == nullptr ||
+      tensor.dims->size != 1) {
+    return false;
+  }
+  const int size = tensor.dims->data[0];
+  if (size < 0) {
+    return false;
+  }
+  values->resize(size);
+  for (int i = 0; i < size; ++i) {
+    if (tensor.type == kTfLiteInt32) {
+      (*values)[i] = tensor.data.i32[i];
+    } else if (tensor.type == kTfLiteInt64) {
+      (*values)[i] = tensor.data.i64[i];
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Appends the views of the `parts` in `whole`, if `whole` is `parts` laid out
+// one after the other along its outermost axis of size greater than 1.
+bool AppendPartitionViews(const TfLiteIntArray& parts, int32_t whole_index,
+                          const TfLiteTensor* tensors,
+                          std::vector<TensorView>* views) {
+  if (parts.size < 1 || whole_index == kTfLiteOptionalTensor) {
+    return false;
+  }
+  const TfLiteTensor& whole = tensors[whole_index];
+  const int rank = whole.dims == nullptr ? 0 : whole.dims->size;
+  // The axis along which the parts differ from the whole.
+  int axis = rank;
+  for (int i = 0; i < parts.size; ++i) {
+    if (parts.data[i] == kTfLiteOptionalTensor ||
+        parts.data[i] == whole_index) {
+      return false;
+    }
+    for (int j = 0; j < i; ++j) {
+      if (parts.data[j] == parts.data[i]) {
+        return false;
+      }
+    }
+    const TfLiteTensor& part = tensors[parts.data[i]];
+    if (!HaveSameRank(part, whole) || !HaveSameElements(part, whole)) {
+      return false;
+    }
+    for (int d = 0; d < axis; ++d) {
+      if (part.dims->data[d] != whole.dims->data[d]) {
+        axis = d;
+        break;
+      }
+    }
+  }
+  if (axis == rank && parts.size != 1) {
+    return false;
+  }
+  for (int d = 0; d < axis; ++d) {
+    if (whole.dims->data[d] != 1) {
+      return false;
+    }
+  }
+  int axis_size = 0;
+  for (int i = 0; i < parts.size; ++i) {
+    const TfLiteTensor& part = tensors[parts.data[i]];
+    for (int d = axis + 1; d < rank; ++d) {
+      if (part.dims->data[d] != whole.dims->data[d]) {
+        return false;
+      }
+    }
+    axis_size += axis < rank ? part.dims->data[axis] : 1;
+  }
+  if (axis < rank && axis_size != whole.dims->data[axis]) {
+    return false;
+  }
+  size_t offset = 0;
+  for (int i = 0; i < parts.size; ++i) {
+    offset += tensors[parts.data[i]].bytes;
+  }
+  if (offset != whole.bytes) {
+    return false;
+  }
+  offset = 0;
+  for (int i = 0; i < parts.size; ++i) {
+    views->push_back({parts.data[i], whole_index, offset});
+    offset += tensors[parts.data[i]].bytes;
+  }
+  return true;
+}
+
+// Appends the view of `slice_index` in `input_index`, if the slice starting at
+// `begin` is contiguous in the input.
+bool AppendSliceView(int32_t slice_index, int32_t input_index,
+                     const std::vector<int64_t>& begin,
+                     const TfLiteTensor* tensors,
+                     std::vector<TensorView>* views) {
+  if (slice_index == kTfLiteOptionalTensor ||
+      input_index == kTfLiteOptionalTensor || slice_index == input_index) {
+    return false;
+  }
+  const TfLiteTensor& slice = tensors[slice_index];
+  const TfLiteTensor& input = tensors[input_index];
+  if (!HaveSameRank(slice, input) || !HaveSameElements(slice, input) ||
+      begin.size() != static_cast<size_t>(input.dims->size)) {
+    return false;
+  }
+  const int rank = input.dims->size;
+  // The innermost axis along which the slice is smaller than the input. The
+  // slice is contiguous if it has a single element along the outer axes.
+  int axis = -1;
+  for (int d = 0; d < rank; ++d) {
+    if (slice.dims->data[d] != input.dims->data[d]) {
+      axis = d;
+    }
+  }
+  for (int d = 0; d < axis; ++d) {
+    if (slice.dims->data[d] != 1) {
+      return false;
+    }
+  }
+  const size_t element_size = GetElementSize(input);
+  if (element_size == 0 || slice.bytes > input.bytes) {
+    return false;
+  }
+  size_t offset = 0;
+  size_t stride = element_size;
+  for (int d = rank - 1; d >= 0; --d) {
+    if (begin[d] < 0 ||
+        begin[d] + slice.dims->data[d] > input.dims->data[d]) {
+      return false;
+    }
+    offset += begin[d] * stride;
+    stride *= input.dims->data[d];
+  }
+  views->push_back({slice_index, input_index, offset});
+  return true;
+}
+
+bool AppendStridedSliceView(const TfLiteNode& node,
+                            const TfLiteTensor* tensors,
+                            std::vector<TensorView>* views) {
+  const auto* params =
+      static_cast<const TfLiteStridedSliceParams*>(node.builtin_data);
+  if (params == nullptr || params->ellipsis_mask != 0 ||
+      params->new_axis_mask != 0 || params->shrink_axis_mask != 0 ||
+      node.inputs->size != 4 || node.outputs->size != 1) {
+    return false;
+  }
+  if (node.inputs->data[0] == kTfLiteOptionalTensor) {
+    return false;
+  }
+  const TfLiteTensor& input = tensors[node.inputs->data[0]];
+  std::vector<int64_t> begin;
+  std::vector<int64_t> strides;
+  if (input.dims == nullptr ||
+      !GetConstantValues(tensors, node.inputs->data[1], &begin) ||
+      !GetConstantValues(tensors, node.inputs->data[3], &strides) ||
+      begin.size() != strides.size() ||
+      begin.size() > static_cast<size_t>(input.dims->size)) {
+    return false;
+  }
+  for (const int64_t stride : strides) {
+    if (stride != 1) {
+      return false;
+    }
+  }
+  // Dimensions past the given begins are kept whole.
+  begin.resize(input.dims->size, 0);
+  for (int d = 0; d < static_cast<int>(begin.size()); ++d) {
+    const int64_t size = input.dims->data[d];
+    if (params->begin_mask & (1 << d)) {
+      begin[d] = 0;
+    } else if (begin[d] < 0) {
+      begin[d] = begin[d] + size < 0 ? 0 : begin[d] + size;
+    } else if (begin[d] > size) {
+      begin[d] = size;
+    }
+  }
+  return AppendSliceView(node.outputs->data[0], node.inputs->data[0], begin,
+                         tensors, views);
+}
+
+}  // namespace
+
+bool GetTensorViews(int32_t builtin_code, const TfLiteNode& node,
+                    const TfLiteTensor* tensors,
+                    std::vector<TensorView>* views) {
+  if (node.inputs == nullptr || node.outputs == nullptr) {
+    return false;
+  }
+  switch (builtin_code) {
+    case kTfLiteBuiltinConcatenation: {
+      const auto* params =
+          static_cast<const TfLiteConcatenationParams*>(node.builtin_data);
+      if (params == nullptr || params->activation != kTfLiteActNone ||
+          node.outputs->size != 1) {
+        return false;
+      }
+      return AppendPartitionViews(*node.inputs, node.outputs->data[0],
+                                  tensors, views);
+    }
+    case kTfLiteBuiltinSplit:
+      if (node.inputs->size != 2) {
+        return false;
+      }
+      return AppendPartitionViews(*node.outputs, node.inputs->data[1],
+                                  tensors, views);
+    case kTfLiteBuiltinSplitV:
+      if (node.inputs->size != 3) {
+        return false;
+      }
+      return AppendPartitionViews(*node.outputs, node.inputs->data[0],
+                                  tensors, views);
+    case kTfLiteBuiltinSlice: {
+      std::vector<int64_t> begin;
+      if (node.inputs->size != 3 || node.outputs->size != 1 ||
+          !GetConstantValues(tensors, node.inputs->data[1], &begin)) {
+        return false;
+      }
+      return AppendSliceView(node.outputs->data[0], node.inputs->data[0],
+                             begin, tensors, views);
+    }
+    case kTfLiteBuiltinStridedSlice:
+      return AppendStridedSliceView(node, tensors, views);
+    default:
+      return false;
+  }
+}
+
+bool HasPlannedTensorViews(int32_t builtin_code, const TfLiteContext& context,
+                           const TfLiteNode& node) {
+  if (context.tensors == nullptr) {
+    return false;
+  }
+  std::vector<TensorView> views;
+  if (!GetTensorViews(builtin_code, node, context.tensors, &views)) {
+    return false;
+  }
+  for (const TensorView& view : views) {
+    if (!IsTensorViewOf(context.tensors[view.tensor],
+                        context.tensors[view.base], view.offset)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace tflite
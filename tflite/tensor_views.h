@@ -0,0 +1,69 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_TENSOR_VIEWS_H_
+#define TENSORFLOW_LITE_TENSOR_VIEWS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "tflite/core/c/common.h"
+
+namespace tflite {
+
+// A tensor whose data is the contiguous range of the data of `base` starting
+// `offset` bytes after the start of it.
+struct TensorView {
+  int32_t tensor;
+  int32_t base;
+  size_t offset;
+};
+
+// Appends to `views` the tensors of `node` that can be views of another of its
+// tensors, given their current shapes, and returns true, if the op of
+// `builtin_code` only copies them:
+// - the inputs of CONCATENATION, views of its output,
+// - the outputs of SPLIT and SPLIT_V, views of their input,
+// - the output of SLICE and STRIDED_SLICE, a view of their input.
+// This is the case when the tensors are cut along the outermost axis of size
+// greater than 1, e.g. QKV splits and batch slices, and when SLICE and
+// STRIDED_SLICE have constant begins and unit strides. Returns false, leaving
+// `views` untouched, otherwise.
+bool GetTensorViews(int32_t builtin_code, const TfLiteNode& node,
+                    const TfLiteTensor* tensors,
+                    std::vector<TensorView>* views);
+
+// Returns whether the data of `tensor` is the range of the data of `base`
+// starting `offset` bytes after the start of it. Empty tensors are views of
+// any tensor.
+inline bool IsTensorViewOf(const TfLiteTensor& tensor, const TfLiteTensor& base,
+                           size_t offset) {
+  if (tensor.bytes == 0) {
+    return true;
+  }
+  return tensor.data.raw != nullptr && base.data.raw != nullptr &&
+         tensor.data.raw == base.data.raw + offset &&
+         offset + tensor.bytes <= base.bytes;
+}
+
+// Returns whether the memory planner placed every tensor of `node` that
+// GetTensorViews() finds for the op of `builtin_code` at the exact offset of
+// its view, so that the op can skip the copy.
+bool HasPlannedTensorViews(int32_t builtin_code, const TfLiteContext& context,
+                           const TfLiteNode& node);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_TENSOR_VIEWS_H_
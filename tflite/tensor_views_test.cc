@@ -0,0 +1,282 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/tensor_views.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tflite/builtin_ops.h"
+#include "tflite/core/c/builtin_op_data.h"
+#include "tflite/core/c/common.h"
+
+namespace tflite {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::FieldsAre;
+
+class TensorViewsTest : public ::testing::Test {
+ protected:
+  ~TensorViewsTest() override {
+    for (TfLiteTensor& tensor : tensors_) {
+      TfLiteIntArrayFree(tensor.dims);
+    }
+    for (TfLiteNode& node : nodes_) {
+      TfLiteIntArrayFree(node.inputs);
+      TfLiteIntArrayFree(node.outputs);
+    }
+  }
+
+  // Adds a float32 tensor of shape `dims`, and returns its index.
+  int AddTensor(std::initializer_list<int> dims) {
+    TfLiteTensor& tensor = tensors_.emplace_back();
+    tensor.type = kTfLiteFloat32;
+    tensor.allocation_type = kTfLiteArenaRw;
+    tensor.dims = TfLiteIntArrayCreate(dims.size());
+    tensor.bytes = sizeof(float);
+    int d = 0;
+    for (int dim : dims) {
+      tensor.dims->data[d++] = dim;
+      tensor.bytes *= dim;
+    }
+    return tensors_.size() - 1;
+  }
+
+  // Adds a constant 1D int32 tensor of `values`, and returns its index.
+  int AddConstant(std::initializer_list<int32_t> values) {
+    const int index = AddTensor({static_cast<int>(values.size())});
+    TfLiteTensor& tensor = tensors_[index];
+    tensor.type = kTfLiteInt32;
+    tensor.allocation_type = kTfLiteMmapRo;
+    tensor.data.raw = reinterpret_cast<char*>(
+        constants_.emplace_back(values.begin(), values.end()).data());
+    return index;
+  }
+
+  const TfLiteNode& AddNode(std::initializer_list<int> inputs,
+                            std::initializer_list<int> outputs,
+                            void* builtin_data = nullptr) {
+    TfLiteNode& node = nodes_.emplace_back();
+    node.inputs = TfLiteIntArrayCreate(inputs.size());
+    int i = 0;
+    for (int input : inputs) {
+      node.inputs->data[i++] = input;
+    }
+    node.outputs = TfLiteIntArrayCreate(outputs.size());
+    i = 0;
+    for (int output : outputs) {
+      node.outputs->data[i++] = output;
+    }
+    node.builtin_data = builtin_data;
+    return node;
+  }
+
+  bool GetViews(int32_t builtin_code, const TfLiteNode& node,
+                std::vector<TensorView>* views) {
+    return GetTensorViews(builtin_code, node, tensors_.data(), views);
+  }
+
+  std::vector<TfLiteTensor> tensors_;
+  std::deque<std::vector<int32_t>> constants_;
+  std::deque<TfLiteNode> nodes_;
+};
+
+TEST_F(TensorViewsTest, SplitAlongOutermostAxis) {
+  const int axis = AddConstant({1});
+  const int input = AddTensor({1, 6, 4});
+  const int output0 = AddTensor({1, 2, 4});
+  const int output1 = AddTensor({1, 2, 4});
+  const int output2 = AddTensor({1, 2, 4});
+  const TfLiteNode& node =
+      AddNode({axis, input}, {output0, output1, output2});
+
+  std::vector<TensorView> views;
+  ASSERT_TRUE(GetViews(kTfLiteBuiltinSplit, node, &views));
+  EXPECT_THAT(views, ElementsAre(FieldsAre(output0, input, 0),
+                                 FieldsAre(output1, input, 32),
+                                 FieldsAre(output2, input, 64)));
+}
+
+TEST_F(TensorViewsTest, SplitVWithUnevenSizes) {
+  const int input = AddTensor({5, 2});
+  const int size_splits = AddConstant({2, 3});
+  const int axis = AddConstant({0});
+  const int output0 = AddTensor({2, 2});
+  const int output1 = AddTensor({3, 2});
+  const TfLiteNode& node =
+      AddNode({input, size_splits, axis}, {output0, output1});
+
+  std::vector<TensorView> views;
+  ASSERT_TRUE(GetViews(kTfLiteBuiltinSplitV, node, &views));
+  EXPECT_THAT(views, ElementsAre(FieldsAre(output0, input, 0),
+                                 FieldsAre(output1, input, 16)));
+}
+
+TEST_F(TensorViewsTest, SplitAlongInnerAxisHasNoViews) {
+  const int axis = AddConstant({1});
+  const int input = AddTensor({2, 6});
+  const int output0 = AddTensor({2, 3});
+  const int output1 = AddTensor({2, 3});
+  const TfLiteNode& node = AddNode({axis, input}, {output0, output1});
+
+  std::vector<TensorView> views;
+  EXPECT_FALSE(GetViews(kTfLiteBuiltinSplit, node, &views));
+  EXPECT_TRUE(views.empty());
+}
+
+TEST_F(TensorViewsTest, ConcatenationInputsAreViewsOfOutput) {
+  const int input0 = AddTensor({2, 3});
+  const int input1 = AddTensor({1, 3});
+  const int output = AddTensor({3, 3});
+  TfLiteConcatenationParams params = {/*axis=*/0, kTfLiteActNone};
+  const TfLiteNode& node = AddNode({input0, input1}, {output}, &params);
+
+  std::vector<TensorView> views;
+  ASSERT_TRUE(GetViews(kTfLiteBuiltinConcatenation, node, &views));
+  EXPECT_THAT(views, ElementsAre(FieldsAre(input0, output, 0),
+                                 FieldsAre(input1, output, 24)));
+}
+
+TEST_F(TensorViewsTest, ConcatenationOfSameInputOrWithActivationHasNoViews) {
+  const int input = AddTensor({1, 3});
+  const int output = AddTensor({2, 3});
+  TfLiteConcatenationParams params = {/*axis=*/0, kTfLiteActNone};
+  std::vector<TensorView> views;
+  EXPECT_FALSE(GetViews(kTfLiteBuiltinConcatenation,
+                        AddNode({input, input}, {output}, &params), &views));
+
+  const int other_input = AddTensor({1, 3});
+  params.activation = kTfLiteActRelu;
+  EXPECT_FALSE(GetViews(kTfLiteBuiltinConcatenation,
+                        AddNode({input, other_input}, {output}, &params),
+                        &views));
+}
+
+TEST_F(TensorViewsTest, ConcatenationRequantizingHasNoViews) {
+  const int input0 = AddTensor({1, 3});
+  const int input1 = AddTensor({1, 3});
+  const int output = AddTensor({2, 3});
+  tensors_[input1].params.scale = 0.5f;
+  TfLiteConcatenationParams params = {/*axis=*/0, kTfLiteActNone};
+
+  std::vector<TensorView> views;
+  EXPECT_FALSE(GetViews(kTfLiteBuiltinConcatenation,
+                        AddNode({input0, input1}, {output}, &params), &views));
+}
+
+TEST_F(TensorViewsTest, SliceOfBatch) {
+  const int input = AddTensor({4, 3});
+  const int begin = AddConstant({2, 0});
+  const int size = AddConstant({1, 3});
+  const int output = AddTensor({1, 3});
+  const TfLiteNode& node = AddNode({input, begin, size}, {output});
+
+  std::vector<TensorView> views;
+  ASSERT_TRUE(GetViews(kTfLiteBuiltinSlice, node, &views));
+  EXPECT_THAT(views, ElementsAre(FieldsAre(output, input, 24)));
+}
+
+TEST_F(TensorViewsTest, SliceOfInnerAxisHasNoViews) {
+  const int input = AddTensor({4, 3});
+  const int begin = AddConstant({0, 1});
+  const int size = AddConstant({4, 2});
+  const int output = AddTensor({4, 2});
+  const TfLiteNode& node = AddNode({input, begin, size}, {output});
+
+  std::vector<TensorView> views;
+  EXPECT_FALSE(GetViews(kTfLiteBuiltinSlice, node, &views));
+}
+
+TEST_F(TensorViewsTest, StridedSliceWithNegativeBegin) {
+  const int input = AddTensor({4, 3});
+  const int begin = AddConstant({-3, 0});
+  const int end = AddConstant({3, 3});
+  const int strides = AddConstant({1, 1});
+  const int output = AddTensor({2, 3});
+  TfLiteStridedSliceParams params = {};
+  const TfLiteNode& node =
+      AddNode({input, begin, end, strides}, {output}, &params);
+
+  std::vector<TensorView> views;
+  ASSERT_TRUE(GetViews(kTfLiteBuiltinStridedSlice, node, &views));
+  EXPECT_THAT(views, ElementsAre(FieldsAre(output, input, 12)));
+}
+
+TEST_F(TensorViewsTest, StridedSliceWithStridesHasNoViews) {
+  const int input = AddTensor({4, 3});
+  const int begin = AddConstant({0, 0});
+  const int end = AddConstant({4, 3});
+  const int strides = AddConstant({2, 1});
+  const int output = AddTensor({2, 3});
+  TfLiteStridedSliceParams params = {};
+  const TfLiteNode& node =
+      AddNode({input, begin, end, strides}, {output}, &params);
+
+  std::vector<TensorView> views;
+  EXPECT_FALSE(GetViews(kTfLiteBuiltinStridedSlice, node, &views));
+}
+
+TEST(IsTensorViewOfTest, ChecksTheDataIsAtTheOffsetInTheBase) {
+  char data[16];
+  TfLiteTensor base = {};
+  base.data.raw = data;
+  base.bytes = 16;
+  TfLiteTensor tensor = {};
+  tensor.data.raw = data + 8;
+  tensor.bytes = 8;
+  EXPECT_TRUE(IsTensorViewOf(tensor, base, /*offset=*/8));
+  // Overlapping the base is not enough.
+  EXPECT_FALSE(IsTensorViewOf(tensor, base, /*offset=*/4));
+  tensor.bytes = 4;
+  EXPECT_FALSE(IsTensorViewOf(tensor, base, /*offset=*/4));
+  tensor.bytes = 12;
+  EXPECT_FALSE(IsTensorViewOf(tensor, base, /*offset=*/8));
+  tensor.data.raw = nullptr;
+  EXPECT_FALSE(IsTensorViewOf(tensor, base, /*offset=*/8));
+  tensor.bytes = 0;
+  EXPECT_TRUE(IsTensorViewOf(tensor, base, /*offset=*/8));
+}
+
+TEST_F(TensorViewsTest, HasPlannedTensorViewsChecksEveryOffset) {
+  const int axis = AddConstant({0});
+  const int input = AddTensor({2, 2});
+  const int output0 = AddTensor({1, 2});
+  const int output1 = AddTensor({1, 2});
+  const TfLiteNode& node = AddNode({axis, input}, {output0, output1});
+  float data[4];
+  tensors_[input].data.f = data;
+  TfLiteContext context = {};
+  context.tensors = tensors_.data();
+
+  tensors_[output0].data.f = data;
+  tensors_[output1].data.f = data + 2;
+  EXPECT_TRUE(HasPlannedTensorViews(kTfLiteBuiltinSplit, context, node));
+
+  // The outputs lie in the input, but swapped: the split must copy.
+  tensors_[output0].data.f = data + 2;
+  tensors_[output1].data.f = data;
+  EXPECT_FALSE(HasPlannedTensorViews(kTfLiteBuiltinSplit, context, node));
+
+  context.tensors = nullptr;
+  EXPECT_FALSE(HasPlannedTensorViews(kTfLiteBuiltinSplit, context, node));
+}
+
+}  // namespace
+}  // namespace tflite
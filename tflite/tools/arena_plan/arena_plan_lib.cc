@@ -0,0 +1,213 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/tools/arena_plan/arena_plan_lib.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "flatbuffers/flatbuffer_builder.h"  // from @flatbuffers
+#include "tflite/arena_plan.h"
+#include "tflite/core/c/common.h"
+#include "tflite/core/interpreter.h"
+#include "tflite/core/interpreter_builder.h"
+#include "tflite/core/kernels/register.h"
+#include "tflite/core/subgraph.h"
+#include "tflite/delegates/gpu/common/memory_management.h"
+#include "tflite/delegates/gpu/common/memory_management/types.h"
+#include "tflite/model_builder.h"
+#include "tflite/schema/schema_generated.h"
+#include "tflite/util.h"
+
+namespace tflite {
+namespace arena_plan {
+namespace {
+
+size_t AlignTo(size_t alignment, size_t offset) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+// Returns the usage records of the allocs of `plan`, with their sizes aligned
+// so that the offsets of the strategies placing shared objects one after the
+// other stay aligned.
+std::vector<gpu::TensorUsageRecord<size_t>> GetUsageRecords(
+    const SubgraphArenaPlan& plan, size_t alignment) {
+  // Graph outputs are never deallocated. They last until the last node.
+  int32_t last_node = 0;
+  for (const auto& alloc : plan.allocs) {
+    last_node = std::max(last_node, alloc.first_node);
+    if (alloc.last_node != std::numeric_limits<int32_t>::max()) {
+      last_node = std::max(last_node, alloc.last_node);
+    }
+  }
+  std::vector<gpu::TensorUsageRecord<size_t>> records;
+  records.reserve(plan.allocs.size());
+  for (const auto& alloc : plan.allocs) {
+    records.emplace_back(AlignTo(alignment, alloc.size), alloc.first_node,
+                         std::min(alloc.last_node, last_node));
+  }
+  return records;
+}
+
+}  // namespace
+
+const char* GetStrategyName(ArenaPlanStrategy strategy) {
+  switch (strategy) {
+    case ArenaPlanStrategy::kArenaPlanner:
+      return "arena_planner";
+    case ArenaPlanStrategy::kGreedyBySize:
+      return "greedy_by_size";
+    case ArenaPlanStrategy::kGreedyByBreadth:
+      return "greedy_by_breadth";
+    case ArenaPlanStrategy::kMinCostFlow:
+      return "min_cost_flow";
+  }
+  return "unknown";
+}
+
+absl::Status ApplyStrategy(ArenaPlanStrategy strategy, size_t alignment,
+                           SubgraphArenaPlan* plan) {
+  gpu::MemoryStrategy gpu_strategy;
+  switch (strategy) {
+    case ArenaPlanStrategy::kGreedyBySize:
+      gpu_strategy = gpu::MemoryStrategy::GREEDY_BY_SIZE;
+      break;
+    case ArenaPlanStrategy::kGreedyByBreadth:
+      gpu_strategy = gpu::MemoryStrategy::GREEDY_BY_BREADTH;
+      break;
+    case ArenaPlanStrategy::kMinCostFlow:
+      gpu_strategy = gpu::MemoryStrategy::MINCOSTFLOW;
+      break;
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrCat("Can't apply strategy ", GetStrategyName(strategy)));
+  }
+  if (plan->allocs.empty()) {
+    return absl::OkStatus();
+  }
+  gpu::OffsetsAssignment assignment;
+  absl::Status status = gpu::AssignOffsetsToTensors(
+      GetUsageRecords(*plan, alignment), gpu_strategy, &assignment, alignment);
+  if (!status.ok()) {
+    return status;
+  }
+  if (assignment.offsets.size() != plan->allocs.size()) {
+    return absl::InternalError("Not all the tensors were placed.");
+  }
+  for (size_t i = 0; i < plan->allocs.size(); ++i) {
+    if (assignment.offsets[i] % alignment != 0) {
+      return absl::InternalError("The offsets are not aligned.");
+    }
+    plan->allocs[i].offset = assignment.offsets[i];
+  }
+  plan->arena_size = GetArenaPlanSize(*plan);
+  return absl::OkStatus();
+}
+
+StrategyChoice ChooseSmallestArena(size_t alignment, SubgraphArenaPlan* plan) {
+  StrategyChoice choice;
+  plan->arena_size = GetArenaPlanSize(*plan);
+  choice.arena_sizes.emplace_back(ArenaPlanStrategy::kArenaPlanner,
+                                  plan->arena_size);
+  for (const ArenaPlanStrategy strategy :
+       {ArenaPlanStrategy::kGreedyBySize, ArenaPlanStrategy::kGreedyByBreadth,
+        ArenaPlanStrategy::kMinCostFlow}) {
+    SubgraphArenaPlan candidate = *plan;
+    if (!ApplyStrategy(strategy, alignment, &candidate).ok()) {
+      continue;
+    }
+    choice.arena_sizes.emplace_back(strategy, candidate.arena_size);
+    if (candidate.arena_size < plan->arena_size) {
+      *plan = std::move(candidate);
+      choice.chosen = strategy;
+    }
+  }
+  return choice;
+}
+
+absl::Status ComputeModelArenaPlan(const FlatBufferModel& model,
+                                   ModelArenaPlan* plan,
+                                   std::vector<StrategyChoice>* choices) {
+  // The default delegates would change the execution plan, so the plan would
+  // only apply with the same delegates.
+  ops::builtin::BuiltinOpResolverWithoutDefaultDelegates resolver;
+  std::unique_ptr<Interpreter> interpreter;
+  if (InterpreterBuilder(model, resolver)(&interpreter) != kTfLiteOk ||
+      interpreter == nullptr) {
+    return absl::InvalidArgumentError("Failed to build the interpreter.");
+  }
+  if (interpreter->AllocateTensors() != kTfLiteOk) {
+    return absl::InvalidArgumentError("Failed to allocate the tensors.");
+  }
+  plan->assign(interpreter->subgraphs_size(), {});
+  choices->assign(interpreter->subgraphs_size(), {});
+  for (int i = 0; i < static_cast<int>(interpreter->subgraphs_size()); ++i) {
+    Subgraph* subgraph = interpreter->subgraph(i);
+    SubgraphArenaPlan& subgraph_plan = (*plan)[i];
+    // The tensors of the subgraphs with dynamic tensors are allocated in
+    // several steps, which a plan can't describe.
+    if (subgraph->HasDynamicTensors() ||
+        !subgraph->GetArenaPlan(&subgraph_plan)) {
+      subgraph_plan = {};
+      continue;
+    }
+    (*choices)[i] =
+        ChooseSmallestArena(kDefaultTensorAlignment, &subgraph_plan);
+  }
+  return absl::OkStatus();
+}
+
+absl::Status SetModelArenaPlan(const Model* model, const ModelArenaPlan& plan,
+                               std::string* model_data) {
+  if (model == nullptr || model_data == nullptr) {
+    return absl::InvalidArgumentError("Arguments must not be nullptr.");
+  }
+  auto mutable_model = std::make_unique<ModelT>();
+  model->UnPackTo(mutable_model.get(), nullptr);
+  const std::string serialized = SerializeModelArenaPlan(plan);
+  BufferT* buffer = nullptr;
+  for (const auto& metadata : mutable_model->metadata) {
+    if (metadata->name == kModelArenaPlanMetadataKey &&
+        metadata->buffer < mutable_model->buffers.size()) {
+      buffer = mutable_model->buffers[metadata->buffer].get();
+    }
+  }
+  if (buffer == nullptr) {
+    auto metadata = std::make_unique<MetadataT>();
+    metadata->buffer = mutable_model->buffers.size();
+    metadata->name = kModelArenaPlanMetadataKey;
+    mutable_model->metadata.emplace_back(std::move(metadata));
+    mutable_model->buffers.emplace_back(std::make_unique<BufferT>());
+    buffer = mutable_model->buffers.back().get();
+  }
+  buffer->data.assign(serialized.begin(), serialized.end());
+  flatbuffers::FlatBufferBuilder builder;
+  auto packed_model = Model::Pack(builder, mutable_model.get());
+  FinishModelBuffer(builder, packed_model);
+  *model_data =
+      std::string(reinterpret_cast<const char*>(builder.GetBufferPointer()),
+                  builder.GetSize());
+  return absl::OkStatus();
+}
+
+}  // namespace arena_plan
+}  // namespace tflite
@@ -0,0 +1,75 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_TOOLS_ARENA_PLAN_ARENA_PLAN_LIB_H_
+#define TENSORFLOW_LITE_TOOLS_ARENA_PLAN_ARENA_PLAN_LIB_H_
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tflite/arena_plan.h"
+#include "tflite/model_builder.h"
+#include "tflite/schema/schema_generated.h"
+
+namespace tflite {
+namespace arena_plan {
+
+// Strategies to place the tensors of the arena of a subgraph.
+enum class ArenaPlanStrategy {
+  // The placement of ArenaPlanner: greedy by size, in the order of the nodes.
+  kArenaPlanner,
+  // The strategies of the GPU delegate, in
+  // tflite/delegates/gpu/common/memory_management.
+  kGreedyBySize,
+  kGreedyByBreadth,
+  kMinCostFlow,
+};
+
+const char* GetStrategyName(ArenaPlanStrategy strategy);
+
+// Places the allocs of `plan` with `strategy`, keeping their offsets aligned
+// to `alignment`. `strategy` can't be kArenaPlanner.
+absl::Status ApplyStrategy(ArenaPlanStrategy strategy, size_t alignment,
+                           SubgraphArenaPlan* plan);
+
+// The arena size of each strategy for a subgraph, and the one chosen.
+struct StrategyChoice {
+  ArenaPlanStrategy chosen = ArenaPlanStrategy::kArenaPlanner;
+  std::vector<std::pair<ArenaPlanStrategy, size_t>> arena_sizes;
+};
+
+// Places the allocs of `plan`, coming from ArenaPlanner, with the strategy
+// giving the smallest arena. Strategies that fail are skipped.
+StrategyChoice ChooseSmallestArena(size_t alignment, SubgraphArenaPlan* plan);
+
+// Allocates the tensors of all the subgraphs of `model`, with their default
+// shapes, and collects the smallest arena plan of each of them. Subgraphs
+// which can't be planned ahead of time, e.g. because they have dynamic
+// tensors, get an empty plan.
+absl::Status ComputeModelArenaPlan(const FlatBufferModel& model,
+                                   ModelArenaPlan* plan,
+                                   std::vector<StrategyChoice>* choices);
+
+// Writes into `model_data` a serialized copy of `model` whose metadata holds
+// `plan`, replacing the plan already there if any.
+absl::Status SetModelArenaPlan(const Model* model, const ModelArenaPlan& plan,
+                               std::string* model_data);
+
+}  // namespace arena_plan
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_TOOLS_ARENA_PLAN_ARENA_PLAN_LIB_H_
@@ -0,0 +1,123 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/tools/arena_plan/arena_plan_lib.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/arena_plan.h"
+#include "tflite/core/c/common.h"
+#include "tflite/core/interpreter.h"
+#include "tflite/core/interpreter_builder.h"
+#include "tflite/core/kernels/register.h"
+#include "tflite/model_builder.h"
+#include "tflite/core/subgraph.h"
+
+namespace tflite {
+namespace arena_plan {
+namespace {
+
+constexpr char kModelPath[] = "tflite/testdata/multi_add.bin";
+// multi_add has 7 float tensors of shape [1, 8, 8, 3].
+constexpr size_t kTensorSize = 8 * 8 * 3 * sizeof(float);
+
+// Returns the arena size of the primary subgraph of `model`.
+size_t GetArenaSize(const FlatBufferModel& model) {
+  ops::builtin::BuiltinOpResolverWithoutDefaultDelegates resolver;
+  std::unique_ptr<Interpreter> interpreter;
+  EXPECT_EQ(InterpreterBuilder(model, resolver)(&interpreter), kTfLiteOk);
+  EXPECT_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+  Subgraph::SubgraphAllocInfo alloc_info;
+  interpreter->primary_subgraph().GetMemoryAllocInfo(&alloc_info);
+  return alloc_info.arena_size;
+}
+
+TEST(ArenaPlanLibTest, ApplyStrategy) {
+  SubgraphArenaPlan plan;
+  plan.allocs = {{0, 0, 1, 0, 64},
+                 {1, 1, 2, 0, 100},
+                 {2, 2, 3, 0, 64},
+                 {3, 0, 3, 0, 192}};
+  for (const ArenaPlanStrategy strategy :
+       {ArenaPlanStrategy::kGreedyBySize, ArenaPlanStrategy::kGreedyByBreadth,
+        ArenaPlanStrategy::kMinCostFlow}) {
+    SubgraphArenaPlan placed = plan;
+    ASSERT_TRUE(ApplyStrategy(strategy, 64, &placed).ok())
+        << GetStrategyName(strategy);
+    // Tensor 3 is alive with each of the others, and tensors 1 and 2 are
+    // alive together.
+    EXPECT_EQ(placed.arena_size, 192 + 128 + 64) << GetStrategyName(strategy);
+    for (const auto& alloc : placed.allocs) {
+      EXPECT_EQ(alloc.offset % 64, 0);
+    }
+  }
+  EXPECT_FALSE(
+      ApplyStrategy(ArenaPlanStrategy::kArenaPlanner, 64, &plan).ok());
+}
+
+TEST(ArenaPlanLibTest, ChooseSmallestArena) {
+  SubgraphArenaPlan plan;
+  // Placed one after the other.
+  plan.allocs = {{0, 0, 1, 0, 64}, {1, 2, 3, 64, 64}};
+  const StrategyChoice choice = ChooseSmallestArena(64, &plan);
+  EXPECT_NE(choice.chosen, ArenaPlanStrategy::kArenaPlanner);
+  EXPECT_EQ(choice.arena_sizes.size(), 4);
+  EXPECT_EQ(choice.arena_sizes[0].second, 128);
+  EXPECT_EQ(plan.arena_size, 64);
+}
+
+TEST(ArenaPlanLibTest, ModelArenaPlan) {
+  auto model = FlatBufferModel::BuildFromFile(kModelPath);
+  ASSERT_TRUE(model);
+  ModelArenaPlan plan;
+  std::vector<StrategyChoice> choices;
+  ASSERT_TRUE(ComputeModelArenaPlan(*model, &plan, &choices).ok());
+  ASSERT_EQ(plan.size(), 1);
+  ASSERT_EQ(plan[0].allocs.size(), 7);
+  EXPECT_LE(plan[0].arena_size, GetArenaSize(*model));
+
+  // Place the tensors one after the other, to check that the cached plan is
+  // the one used.
+  for (size_t i = 0; i < plan[0].allocs.size(); ++i) {
+    plan[0].allocs[i].offset = i * kTensorSize;
+  }
+  plan[0].arena_size = GetArenaPlanSize(plan[0]);
+  std::string model_data;
+  ASSERT_TRUE(SetModelArenaPlan(model->GetModel(), plan, &model_data).ok());
+  auto planned_model =
+      FlatBufferModel::BuildFromBuffer(model_data.data(), model_data.size());
+  ASSERT_TRUE(planned_model);
+  EXPECT_EQ(GetArenaSize(*planned_model), 7 * kTensorSize);
+
+  // Setting it again replaces the plan.
+  ASSERT_TRUE(ComputeModelArenaPlan(*model, &plan, &choices).ok());
+  std::string replanned_data;
+  ASSERT_TRUE(SetModelArenaPlan(planned_model->GetModel(), plan,
+                                &replanned_data)
+                  .ok());
+  auto replanned_model = FlatBufferModel::BuildFromBuffer(
+      replanned_data.data(), replanned_data.size());
+  ASSERT_TRUE(replanned_model);
+  EXPECT_EQ(replanned_model->GetModel()->metadata()->size(),
+            planned_model->GetModel()->metadata()->size());
+  EXPECT_EQ(GetArenaSize(*replanned_model), plan[0].arena_size);
+}
+
+}  // namespace
+}  // namespace arena_plan
+}  // namespace tflite
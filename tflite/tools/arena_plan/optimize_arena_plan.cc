@@ -0,0 +1,96 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+// Binary to plan the arenas of a model with the strategy giving the smallest
+// arena, and cache the plan in the model metadata.
+#include <cstddef>
+#include <fstream>  // NOLINT
+#include <string>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "tflite/arena_plan.h"
+#include "tflite/model_builder.h"
+#include "tflite/tools/arena_plan/arena_plan_lib.h"
+#include "tflite/tools/command_line_flags.h"
+
+namespace tflite {
+namespace arena_plan {
+
+constexpr char kInputModelFlag[] = "input_model";
+constexpr char kOutputModelFlag[] = "output_model";
+
+int Main(int argc, char* argv[]) {
+  std::string input_model_path;
+  std::string output_model_path;
+  std::vector<Flag> flag_list = {
+      Flag::CreateFlag(kInputModelFlag, &input_model_path,
+                       "Path to the input TFLite model."),
+      Flag::CreateFlag(kOutputModelFlag, &output_model_path,
+                       "Path to the output TFLite model."),
+  };
+  if (!Flags::Parse(&argc, const_cast<const char**>(argv), flag_list) ||
+      input_model_path.empty() || output_model_path.empty()) {
+    LOG(ERROR) << Flags::Usage(argv[0], flag_list);
+    return 1;
+  }
+
+  auto model = FlatBufferModel::BuildFromFile(input_model_path.c_str());
+  if (!model) {
+    LOG(ERROR) << "Failed to load " << input_model_path;
+    return 1;
+  }
+  ModelArenaPlan plan;
+  std::vector<StrategyChoice> choices;
+  absl::Status status = ComputeModelArenaPlan(*model, &plan, &choices);
+  if (!status.ok()) {
+    LOG(ERROR) << status;
+    return 1;
+  }
+  for (size_t i = 0; i < choices.size(); ++i) {
+    if (plan[i].allocs.empty()) {
+      LOG(INFO) << "Subgraph " << i << ": not planned.";
+      continue;
+    }
+    for (const auto& [strategy, arena_size] : choices[i].arena_sizes) {
+      LOG(INFO) << "Subgraph " << i << ": " << GetStrategyName(strategy)
+                << " arena size " << arena_size;
+    }
+    LOG(INFO) << "Subgraph " << i << ": chose "
+              << GetStrategyName(choices[i].chosen);
+  }
+
+  std::string model_data;
+  status = SetModelArenaPlan(model->GetModel(), plan, &model_data);
+  if (!status.ok()) {
+    LOG(ERROR) << status;
+    return 1;
+  }
+  std::ofstream output_file_stream(output_model_path, std::ios::binary);
+  output_file_stream << model_data;
+  output_file_stream.close();
+  if (!output_file_stream) {
+    LOG(ERROR) << "Failed to write " << output_model_path;
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace arena_plan
+}  // namespace tflite
+
+int main(int argc, char* argv[]) {
+  return tflite::arena_plan::Main(argc, argv);
+}
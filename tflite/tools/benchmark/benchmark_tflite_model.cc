@@ -52,6 +52,7 @@ limitations under the License.
 #include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/op_resolver.h"
 #include "tflite/optional_debug_tools.h"
+#include "tflite/profiling/memory_traffic_profiler.h"
 #include "tflite/profiling/model_runtime_info.h"
 #include "tflite/profiling/profile_summary_formatter.h"
 #include "tflite/string_util.h"
@@ -266,6 +267,33 @@ class ModelRuntimeInfoListener : public BenchmarkListener {
   Interpreter* const interpreter_ = nullptr;  // not own the memory.
 };
 
+// Reports the memory traffic of each node and the arena high-water marks of
+// the benchmark runs when enable_memory_traffic_profiling is set to true.
+class MemoryTrafficListener : public BenchmarkListener {
+ public:
+  explicit MemoryTrafficListener(Interpreter* interpreter)
+      : interpreter_(interpreter), profiler_(*interpreter, GetOptions()) {}
+
+  // Next to the op profiler, if any, which was set at its creation.
+  void OnBenchmarkStart(const BenchmarkParams& params) override {
+    interpreter_->AddProfiler(&profiler_);
+  }
+
+  void OnBenchmarkEnd(const BenchmarkResults& results) override {
+    TFLITE_LOG(INFO) << profiler_.Summarize();
+  }
+
+ private:
+  static profiling::MemoryTrafficProfiler::Options GetOptions() {
+    profiling::MemoryTrafficProfiler::Options options;
+    options.track_heap = true;
+    return options;
+  }
+
+  Interpreter* const interpreter_ = nullptr;  // not own the memory.
+  profiling::MemoryTrafficProfiler profiler_;
+};
+
 // Dumps the benchmark result to a file in proto format if result_file_path is
 // set.
 class ProtoBenchmarkReporter : public BenchmarkListener {
@@ -673,6 +701,8 @@ BenchmarkParams BenchmarkTfLiteModel::DefaultParams() {
                           BenchmarkParam::Create<bool>(false));
   default_params.AddParam("model_runtime_info_output_file",
                           BenchmarkParam::Create<std::string>(""));
+  default_params.AddParam("enable_memory_traffic_profiling",
+                          BenchmarkParam::Create<bool>(false));
   default_params.AddParam("print_preinvoke_state",
                           BenchmarkParam::Create<bool>(false));
   default_params.AddParam("print_postinvoke_state",
@@ -775,6 +805,10 @@ std::vector<Flag> BenchmarkTfLiteModel::GetFlags() {
                        "Enable Model Runtime Info Export"),
       CreateFlag<std::string>("model_runtime_info_output_file", &params_,
                               "Proto File to export model runtime info to"),
+      CreateFlag<bool>(
+          "enable_memory_traffic_profiling", &params_,
+          "report the bytes each node reads and writes, its allocations "
+          "outside of the arena and the arena high-water marks"),
       CreateFlag<bool>(
           "print_preinvoke_state", &params_,
           "print out the interpreter internals just before calling Invoke. The "
@@ -873,6 +907,8 @@ void BenchmarkTfLiteModel::LogParams() {
                       "Enable Model Runtime Info Export", verbose);
   LOG_BENCHMARK_PARAM(std::string, "model_runtime_info_output_file",
                       "Proto File to export model runtime info to", verbose);
+  LOG_BENCHMARK_PARAM(bool, "enable_memory_traffic_profiling",
+                      "Enable memory traffic profiling", verbose);
   LOG_BENCHMARK_PARAM(bool, "print_preinvoke_state",
                       "Print pre-invoke interpreter state", verbose);
   LOG_BENCHMARK_PARAM(bool, "print_postinvoke_state",
@@ -1188,6 +1224,10 @@ TfLiteStatus BenchmarkTfLiteModel::Init() {
     AddOwnedListener(std::unique_ptr<BenchmarkListener>(
         new ModelRuntimeInfoListener(interpreter_.get())));
   }
+  if (params_.Get<bool>("enable_memory_traffic_profiling")) {
+    AddOwnedListener(std::unique_ptr<BenchmarkListener>(
+        new MemoryTrafficListener(interpreter_.get())));
+  }
 
   interpreter_->SetAllowFp16PrecisionForFp32(params_.Get<bool>("allow_fp16"));
 
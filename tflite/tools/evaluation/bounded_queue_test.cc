@@ -0,0 +1,91 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/tools/evaluation/bounded_queue.h"
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <optional>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace tflite {
+namespace evaluation {
+namespace {
+
+TEST(BoundedQueueTest, PopsInPushOrder) {
+  BoundedQueue<int> queue(/*capacity=*/3);
+  EXPECT_TRUE(queue.Push(1));
+  EXPECT_TRUE(queue.Push(2));
+  EXPECT_EQ(queue.Pop(), 1);
+  EXPECT_EQ(queue.Pop(), 2);
+}
+
+TEST(BoundedQueueTest, DrainsAfterClose) {
+  BoundedQueue<int> queue(/*capacity=*/2);
+  EXPECT_TRUE(queue.Push(1));
+  queue.Close();
+  EXPECT_FALSE(queue.Push(2));
+  EXPECT_EQ(queue.Pop(), 1);
+  EXPECT_EQ(queue.Pop(), std::nullopt);
+}
+
+TEST(BoundedQueueTest, BlocksProducersWhenFull) {
+  BoundedQueue<int> queue(/*capacity=*/1);
+  ASSERT_TRUE(queue.Push(0));
+  std::atomic<bool> pushed{false};
+  std::thread producer([&] {
+    queue.Push(1);
+    pushed = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_FALSE(pushed);
+  EXPECT_EQ(queue.Pop(), 0);
+  producer.join();
+  EXPECT_TRUE(pushed);
+  EXPECT_EQ(queue.Pop(), 1);
+}
+
+TEST(BoundedQueueTest, ManyProducersAndConsumers) {
+  constexpr int kNumThreads = 4;
+  constexpr int kValuesPerProducer = 1000;
+  BoundedQueue<int> queue(/*capacity=*/8);
+  std::atomic<int> num_producers{kNumThreads};
+  std::atomic<long> sum{0};
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&] {
+      for (int value = 1; value <= kValuesPerProducer; ++value) {
+        queue.Push(value);
+      }
+      if (--num_producers == 0) queue.Close();
+    });
+    threads.emplace_back([&] {
+      while (std::optional<int> value = queue.Pop()) {
+        sum += *value;
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+
+  EXPECT_EQ(sum, kNumThreads * kValuesPerProducer * (kValuesPerProducer + 1) /
+                     2);
+}
+
+}  // namespace
+}  // namespace evaluation
+}  // namespace tflite
@@ -0,0 +1,312 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/tools/evaluation/stages/pipelined_image_classification_stage.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tflite/c/c_api_types.h"
+#include "tflite/profiling/time.h"
+#include "tflite/tools/evaluation/bounded_queue.h"
+#include "tflite/tools/evaluation/evaluation_delegate_provider.h"
+#include "tflite/tools/evaluation/proto/evaluation_config.pb.h"
+#include "tflite/tools/evaluation/proto/evaluation_stages.pb.h"
+#include "tflite/tools/evaluation/stages/image_preprocessing_stage.h"
+#include "tflite/tools/evaluation/stages/tflite_inference_stage.h"
+#include "tflite/tools/evaluation/stages/topk_accuracy_eval_stage.h"
+
+namespace tflite {
+namespace evaluation {
+namespace {
+// Default cropping fraction value, as in ImageClassificationStage.
+const float kCroppingFraction = 0.875;
+// ImagePreprocessingStage pads its quantized outputs with XNN_EXTRA_BYTES,
+// which the copies of the preprocessed images keep.
+const size_t kExtraInputBytes = 16;
+
+// An image between the preprocessing and the inference, or the output of its
+// inference.
+struct Example {
+  size_t index;
+  std::vector<uint8_t> data;
+};
+
+// Merges the latencies of several stages, the i-th over counts[i] runs. The
+// standard deviation is only set if all the stages report theirs.
+LatencyMetrics MergeLatencies(const std::vector<LatencyMetrics>& latencies,
+                              const std::vector<int64_t>& counts) {
+  LatencyMetrics merged;
+  int64_t total_count = 0;
+  double sum_squares_us = 0;
+  bool has_std_deviation = true;
+  for (int i = 0; i < latencies.size(); ++i) {
+    const LatencyMetrics& latency = latencies[i];
+    if (counts[i] == 0) continue;
+    if (total_count == 0) {
+      merged.set_max_us(latency.max_us());
+      merged.set_min_us(latency.min_us());
+    } else {
+      merged.set_max_us(std::max(merged.max_us(), latency.max_us()));
+      merged.set_min_us(std::min(merged.min_us(), latency.min_us()));
+    }
+    merged.set_last_us(latency.last_us());
+    merged.set_sum_us(merged.sum_us() + latency.sum_us());
+    has_std_deviation &= latency.has_std_deviation_us();
+    // Sum of the squares of the stage, from its mean and deviation.
+    const double std_deviation_us = latency.std_deviation_us();
+    sum_squares_us += counts[i] * (std_deviation_us * std_deviation_us +
+                                   latency.avg_us() * latency.avg_us());
+    total_count += counts[i];
+  }
+  if (total_count > 0) {
+    const double avg_us = static_cast<double>(merged.sum_us()) / total_count;
+    merged.set_avg_us(avg_us);
+    if (has_std_deviation) {
+      merged.set_std_deviation_us(static_cast<int64_t>(std::sqrt(
+          std::max(0.0, sum_squares_us / total_count - avg_us * avg_us))));
+    }
+  }
+  return merged;
+}
+}  // namespace
+
+TfLiteStatus PipelinedImageClassificationStage::Init(
+    const DelegateProviders* delegate_providers) {
+  // Ensure inference params are provided.
+  if (!config_.specification().has_image_classification_params()) {
+    LOG(ERROR) << "ImageClassificationParams not provided";
+    return kTfLiteError;
+  }
+  auto& params = config_.specification().image_classification_params();
+  if (!params.has_inference_params()) {
+    LOG(ERROR) << "Inference_params not provided";
+    return kTfLiteError;
+  }
+  if (params.num_preprocessing_threads() < 1 ||
+      params.num_inference_workers() < 1) {
+    LOG(ERROR) << "At least one preprocessing thread and inference worker "
+                  "are needed";
+    return kTfLiteError;
+  }
+
+  // TfliteInferenceStages.
+  EvaluationStageConfig tflite_inference_config;
+  tflite_inference_config.set_name("tflite_inference");
+  *tflite_inference_config.mutable_specification()
+       ->mutable_tflite_inference_params() = params.inference_params();
+  for (int i = 0; i < params.num_inference_workers(); ++i) {
+    inference_stages_.push_back(
+        std::make_unique<TfliteInferenceStage>(tflite_inference_config));
+    if (inference_stages_.back()->Init(delegate_providers) != kTfLiteOk)
+      return kTfLiteError;
+  }
+
+  // Validate model inputs.
+  const TfLiteModelInfo* model_info = inference_stages_[0]->GetModelInfo();
+  if (model_info->inputs.size() != 1 || model_info->outputs.size() != 1) {
+    LOG(ERROR) << "Model must have 1 input & 1 output";
+    return kTfLiteError;
+  }
+  TfLiteType input_type = model_info->inputs[0]->type;
+  auto* input_shape = model_info->inputs[0]->dims;
+  // Input should be of the shape {1, height, width, 3}
+  if (input_shape->size != 4 || input_shape->data[0] != 1 ||
+      input_shape->data[3] != 3) {
+    LOG(ERROR) << "Invalid input shape for model";
+    return kTfLiteError;
+  }
+  input_bytes_ = model_info->inputs[0]->bytes;
+  output_bytes_ = model_info->outputs[0]->bytes;
+
+  // ImagePreprocessingStages.
+  EvaluationStageConfig preprocessing_config;
+  if (!config_.specification().has_image_preprocessing_params()) {
+    tflite::evaluation::ImagePreprocessingConfigBuilder builder(
+        "image_preprocessing", input_type);
+    builder.AddCroppingStep(kCroppingFraction, true /*square*/);
+    builder.AddResizingStep(input_shape->data[2], input_shape->data[1], false);
+    builder.AddDefaultNormalizationStep();
+    preprocessing_config = builder.build();
+  } else {
+    preprocessing_config = config_;
+  }
+  for (int i = 0; i < params.num_preprocessing_threads(); ++i) {
+    preprocessing_stages_.push_back(
+        std::make_unique<ImagePreprocessingStage>(preprocessing_config));
+    if (preprocessing_stages_.back()->Init() != kTfLiteOk) return kTfLiteError;
+  }
+
+  // TopkAccuracyEvalStage.
+  if (params.has_topk_accuracy_eval_params()) {
+    EvaluationStageConfig topk_accuracy_eval_config;
+    topk_accuracy_eval_config.set_name("topk_accuracy");
+    *topk_accuracy_eval_config.mutable_specification()
+         ->mutable_topk_accuracy_eval_params() =
+        params.topk_accuracy_eval_params();
+    if (!all_labels_) {
+      LOG(ERROR) << "all_labels not set for TopkAccuracyEvalStage";
+      return kTfLiteError;
+    }
+    accuracy_eval_stage_ =
+        std::make_unique<TopkAccuracyEvalStage>(topk_accuracy_eval_config);
+    accuracy_eval_stage_->SetTaskInfo(*all_labels_, input_type,
+                                      model_info->outputs[0]->dims);
+    if (accuracy_eval_stage_->Init() != kTfLiteOk) return kTfLiteError;
+  }
+
+  return kTfLiteOk;
+}
+
+TfLiteStatus PipelinedImageClassificationStage::Run() {
+  if (!image_labels_) {
+    LOG(ERROR) << "Input images not set";
+    return kTfLiteError;
+  }
+  const std::vector<ImageLabel>& image_labels = *image_labels_;
+  const auto& params = config_.specification().image_classification_params();
+  const int64_t start_us = profiling::time::NowMicros();
+
+  BoundedQueue<Example> preprocessed(params.queue_capacity());
+  BoundedQueue<Example> outputs(params.queue_capacity());
+  std::atomic<size_t> next_image{0};
+  std::atomic<bool> failed{false};
+  std::atomic<int> num_preprocessing_threads(preprocessing_stages_.size());
+  std::atomic<int> num_inference_workers(inference_stages_.size());
+  auto fail = [&] {
+    failed = true;
+    preprocessed.Close();
+    outputs.Close();
+  };
+
+  std::vector<std::thread> threads;
+  for (auto& stage : preprocessing_stages_) {
+    threads.emplace_back([&, stage = stage.get()] {
+      while (!failed) {
+        const size_t index = next_image++;
+        if (index >= image_labels.size()) break;
+        std::string image_path = image_labels[index].image;
+        stage->SetImagePath(&image_path);
+        if (stage->Run() != kTfLiteOk) {
+          fail();
+          break;
+        }
+        Example example{index,
+                        std::vector<uint8_t>(input_bytes_ + kExtraInputBytes)};
+        std::memcpy(example.data.data(), stage->GetPreprocessedImageData(),
+                    input_bytes_);
+        if (!preprocessed.Push(std::move(example))) break;
+      }
+      if (--num_preprocessing_threads == 0) preprocessed.Close();
+    });
+  }
+  for (auto& stage : inference_stages_) {
+    threads.emplace_back([&, stage = stage.get()] {
+      std::vector<void*> data_ptrs(1);
+      while (!failed) {
+        std::optional<Example> example = preprocessed.Pop();
+        if (!example) break;
+        data_ptrs[0] = example->data.data();
+        stage->SetInputs(data_ptrs);
+        if (stage->Run() != kTfLiteOk) {
+          fail();
+          break;
+        }
+        if (!accuracy_eval_stage_) continue;
+        Example output{example->index, std::vector<uint8_t>(output_bytes_)};
+        std::memcpy(output.data.data(), stage->GetOutputs()->at(0),
+                    output_bytes_);
+        if (!outputs.Push(std::move(output))) break;
+      }
+      if (--num_inference_workers == 0) outputs.Close();
+    });
+  }
+
+  // Accuracy Eval, as the outputs come in.
+  while (!failed) {
+    std::optional<Example> output = outputs.Pop();
+    if (!output) break;
+    std::string ground_truth_label = image_labels[output->index].label;
+    if (ground_truth_label.empty()) {
+      LOG(ERROR) << "Ground truth label not provided";
+      fail();
+      break;
+    }
+    accuracy_eval_stage_->SetEvalInputs(output->data.data(),
+                                        &ground_truth_label);
+    if (accuracy_eval_stage_->Run() != kTfLiteOk) fail();
+  }
+
+  for (std::thread& thread : threads) thread.join();
+  wall_time_us_ = profiling::time::NowMicros() - start_us;
+  return failed ? kTfLiteError : kTfLiteOk;
+}
+
+EvaluationStageMetrics PipelinedImageClassificationStage::LatestMetrics() {
+  EvaluationStageMetrics metrics;
+  auto* classification_metrics =
+      metrics.mutable_process_metrics()->mutable_image_classification_metrics();
+
+  std::vector<LatencyMetrics> latencies;
+  std::vector<int64_t> counts;
+  for (auto& stage : preprocessing_stages_) {
+    EvaluationStageMetrics stage_metrics = stage->LatestMetrics();
+    latencies.push_back(stage_metrics.process_metrics().total_latency());
+    counts.push_back(stage_metrics.num_runs());
+  }
+  *classification_metrics->mutable_pre_processing_latency() =
+      MergeLatencies(latencies, counts);
+
+  latencies.clear();
+  counts.clear();
+  int num_runs = 0;
+  int num_inferences = 0;
+  for (auto& stage : inference_stages_) {
+    EvaluationStageMetrics stage_metrics = stage->LatestMetrics();
+    const auto& inference_metrics =
+        stage_metrics.process_metrics().tflite_inference_metrics();
+    latencies.push_back(stage_metrics.process_metrics().total_latency());
+    counts.push_back(inference_metrics.num_inferences());
+    num_runs += stage_metrics.num_runs();
+    num_inferences += inference_metrics.num_inferences();
+  }
+  *classification_metrics->mutable_inference_latency() =
+      MergeLatencies(latencies, counts);
+  classification_metrics->mutable_inference_metrics()->set_num_inferences(
+      num_inferences);
+  if (accuracy_eval_stage_) {
+    *classification_metrics->mutable_topk_accuracy_metrics() =
+        accuracy_eval_stage_->LatestMetrics()
+            .process_metrics()
+            .topk_accuracy_metrics();
+  }
+  classification_metrics->set_wall_time_us(wall_time_us_);
+  metrics.set_num_runs(num_runs);
+  return metrics;
+}
+
+}  // namespace evaluation
+}  // namespace tflite
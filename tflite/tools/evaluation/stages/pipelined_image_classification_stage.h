@@ -0,0 +1,83 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_TOOLS_EVALUATION_STAGES_PIPELINED_IMAGE_CLASSIFICATION_STAGE_H_
+#define TENSORFLOW_LITE_TOOLS_EVALUATION_STAGES_PIPELINED_IMAGE_CLASSIFICATION_STAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tflite/c/c_api_types.h"
+#include "tflite/tools/evaluation/evaluation_delegate_provider.h"
+#include "tflite/tools/evaluation/evaluation_stage.h"
+#include "tflite/tools/evaluation/proto/evaluation_config.pb.h"
+#include "tflite/tools/evaluation/stages/image_classification_stage.h"
+#include "tflite/tools/evaluation/stages/image_preprocessing_stage.h"
+#include "tflite/tools/evaluation/stages/tflite_inference_stage.h"
+#include "tflite/tools/evaluation/stages/topk_accuracy_eval_stage.h"
+
+namespace tflite {
+namespace evaluation {
+
+// An EvaluationStage for the complete Image Classification task over a whole
+// dataset, with the same metrics as ImageClassificationStage. Images are
+// decoded and preprocessed by num_preprocessing_threads threads, and run by
+// num_inference_workers interpreters concurrently, with bounded queues
+// between the stages. Top-K accuracy is evaluated on the calling thread as
+// the outputs come in, in no particular order.
+class PipelinedImageClassificationStage : public EvaluationStage {
+ public:
+  explicit PipelinedImageClassificationStage(
+      const EvaluationStageConfig& config)
+      : EvaluationStage(config) {}
+
+  TfLiteStatus Init() override { return Init(nullptr); }
+  TfLiteStatus Init(const DelegateProviders* delegate_providers);
+
+  // Evaluates all the images set with SetInputs(). Stops at the first failure.
+  TfLiteStatus Run() override;
+
+  EvaluationStageMetrics LatestMetrics() override;
+
+  // Same as ImageClassificationStage::SetAllLabels().
+  void SetAllLabels(const std::vector<std::string>& all_labels) {
+    all_labels_ = &all_labels;
+  }
+
+  // Call before Run(). image_labels should outlive the call to Run().
+  // If accuracy eval is not being performed, the labels are ignored.
+  void SetInputs(const std::vector<ImageLabel>& image_labels) {
+    image_labels_ = &image_labels;
+  }
+
+ private:
+  const std::vector<std::string>* all_labels_ = nullptr;
+  const std::vector<ImageLabel>* image_labels_ = nullptr;
+  // One per thread or worker.
+  std::vector<std::unique_ptr<ImagePreprocessingStage>> preprocessing_stages_;
+  std::vector<std::unique_ptr<TfliteInferenceStage>> inference_stages_;
+  std::unique_ptr<TopkAccuracyEvalStage> accuracy_eval_stage_;
+  // Sizes of the input and output tensors.
+  size_t input_bytes_ = 0;
+  size_t output_bytes_ = 0;
+  int64_t wall_time_us_ = 0;
+};
+
+}  // namespace evaluation
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_TOOLS_EVALUATION_STAGES_PIPELINED_IMAGE_CLASSIFICATION_STAGE_H_
@@ -25,6 +25,7 @@ limitations under the License.
 #include "tflite/tools/evaluation/proto/evaluation_config.pb.h"
 #include "tflite/tools/evaluation/proto/evaluation_stages.pb.h"
 #include "tflite/tools/evaluation/stages/image_classification_stage.h"
+#include "tflite/tools/evaluation/stages/pipelined_image_classification_stage.h"
 #include "tflite/tools/evaluation/tasks/task_executor.h"
 #include "tflite/tools/evaluation/utils.h"
 #include "tflite/tools/logging.h"
@@ -41,6 +42,8 @@ constexpr char kDenylistFilePathFlag[] = "denylist_file_path";
 constexpr char kNumImagesFlag[] = "num_images";
 constexpr char kInterpreterThreadsFlag[] = "num_interpreter_threads";
 constexpr char kDelegateFlag[] = "delegate";
+constexpr char kPreprocessingThreadsFlag[] = "num_preprocessing_threads";
+constexpr char kInferenceWorkersFlag[] = "num_inference_workers";
 
 template <typename T>
 std::vector<T> GetFirstN(const std::vector<T>& v, int n) {
@@ -51,7 +54,11 @@ std::vector<T> GetFirstN(const std::vector<T>& v, int n) {
 
 class ImagenetClassification : public TaskExecutor {
  public:
-  ImagenetClassification() : num_images_(0), num_interpreter_threads_(1) {}
+  ImagenetClassification()
+      : num_images_(0),
+        num_interpreter_threads_(1),
+        num_preprocessing_threads_(1),
+        num_inference_workers_(1) {}
   ~ImagenetClassification() override {}
 
  protected:
@@ -71,6 +78,8 @@ class ImagenetClassification : public TaskExecutor {
   std::string delegate_;
   int num_images_;
   int num_interpreter_threads_;
+  int num_preprocessing_threads_;
+  int num_inference_workers_;
 };
 
 std::vector<Flag> ImagenetClassification::GetFlags() {
@@ -108,6 +117,14 @@ std::vector<Flag> ImagenetClassification::GetFlags() {
           kDelegateFlag, &delegate_,
           "Delegate to use for inference, if available. "
           "Must be one of {'nnapi', 'gpu', 'hexagon', 'xnnpack'}"),
+      tflite::Flag::CreateFlag(
+          kPreprocessingThreadsFlag, &num_preprocessing_threads_,
+          "Number of threads that decode and preprocess the images. With more "
+          "than 1 thread or inference worker, the evaluation is pipelined."),
+      tflite::Flag::CreateFlag(
+          kInferenceWorkersFlag, &num_inference_workers_,
+          "Number of interpreters that run concurrently, each with "
+          "num_interpreter_threads threads."),
   };
   return flag_list;
 }
@@ -157,6 +174,20 @@ std::optional<EvaluationStageMetrics> ImagenetClassification::RunImpl() {
   inference_params->set_delegate(ParseStringToDelegateType(delegate_));
   classification_params->mutable_topk_accuracy_eval_params()->set_k(10);
 
+  if (num_preprocessing_threads_ > 1 || num_inference_workers_ > 1) {
+    classification_params->set_num_preprocessing_threads(
+        num_preprocessing_threads_);
+    classification_params->set_num_inference_workers(num_inference_workers_);
+    PipelinedImageClassificationStage eval(eval_config);
+    eval.SetAllLabels(model_labels);
+    if (eval.Init(&delegate_providers_) != kTfLiteOk) return std::nullopt;
+    eval.SetInputs(image_labels);
+    if (eval.Run() != kTfLiteOk) return std::nullopt;
+    const auto latest_metrics = eval.LatestMetrics();
+    OutputResult(latest_metrics);
+    return std::make_optional(latest_metrics);
+  }
+
   ImageClassificationStage eval(eval_config);
 
   eval.SetAllLabels(model_labels);
@@ -196,6 +227,9 @@ void ImagenetClassification::OutputResult(
   TFLITE_LOG(INFO) << "Inference latency: avg=" << inference_latency.avg_us()
                    << "(us), std_dev=" << inference_latency.std_deviation_us()
                    << "(us)";
+  if (metrics.has_wall_time_us()) {
+    TFLITE_LOG(INFO) << "Wall time: " << metrics.wall_time_us() << "(us)";
+  }
   const auto& accuracy_metrics = metrics.topk_accuracy_metrics();
   for (int i = 0; i < accuracy_metrics.topk_accuracies_size(); ++i) {
     TFLITE_LOG(INFO) << "Top-" << i + 1
@@ -30,11 +30,12 @@ const char kNamespace[] = "namespace";
 const char kOutputRegistrationFlag[] = "output_registration";
 const char kTfLitePathFlag[] = "tflite_path";
 const char kForMicro[] = "for_micro";
+const char kBuiltinOpsOnly[] = "builtin_ops_only";
 
 void ParseFlagAndInit(int* argc, char** argv, std::string* input_models,
                       std::string* output_registration,
                       std::string* tflite_path, std::string* namespace_flag,
-                      bool* for_micro) {
+                      bool* for_micro, bool* builtin_ops_only) {
   std::vector<tflite::Flag> flag_list = {
       tflite::Flag::CreateFlag(kInputModelFlag, input_models,
                                "path to the tflite models, separated by comma"),
@@ -49,6 +50,10 @@ void ParseFlagAndInit(int* argc, char** argv, std::string* input_models,
           kForMicro, for_micro,
           "By default this script generate TFL registration file, but can "
           "also generate TFLM files when this flag is set to true"),
+      tflite::Flag::CreateFlag(
+          kBuiltinOpsOnly, builtin_ops_only,
+          "Only register the builtin ops, e.g. when the custom ops are "
+          "registered by the runtime itself"),
   };
 
   tflite::Flags::Parse(argc, const_cast<const char**>(argv), flag_list);
@@ -155,8 +160,10 @@ int main(int argc, char** argv) {
   std::string tflite_path;
   std::string namespace_flag;
   bool for_micro = false;
+  bool builtin_ops_only = false;
   ParseFlagAndInit(&argc, argv, &input_models, &output_registration,
-                   &tflite_path, &namespace_flag, &for_micro);
+                   &tflite_path, &namespace_flag, &for_micro,
+                   &builtin_ops_only);
 
   tflite::RegisteredOpMap builtin_ops;
   tflite::RegisteredOpMap custom_ops;
@@ -170,6 +177,9 @@ int main(int argc, char** argv) {
     AddOpsFromModel(argv[i], &builtin_ops, &custom_ops);
   }
 
+  if (builtin_ops_only) {
+    custom_ops.clear();
+  }
   GenerateFileContent(tflite_path, output_registration, namespace_flag,
                       builtin_ops, custom_ops, for_micro);
   return 0;
@@ -17,7 +17,15 @@ limitations under the License.
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
+#include "absl/strings/string_view.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/core/api/error_reporter.h"
 #include "tflite/logger.h"
@@ -52,6 +60,270 @@ TfLiteStatus MinMax::Update(const float* values, size_t tensor_size,
   return kTfLiteOk;
 }
 
+void MinMax::Merge(const MinMax& other) {
+  if (!other.has_values_) return;
+  if (!has_values_) {
+    *this = other;
+    return;
+  }
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+double Histogram::BinWidth() const {
+  return std::ldexp(1.0, log2_bin_width_);
+}
+
+double Histogram::BinStart(int index) const {
+  return (index - kNumBins / 2) * BinWidth();
+}
+
+void Histogram::DoubleBinWidth() {
+  // Bin j of the doubled width covers bins 2j - kNumBins / 2 and the next.
+  std::vector<int64_t> counts(kNumBins, 0);
+  for (int j = kNumBins / 4; j < 3 * kNumBins / 4; ++j) {
+    const int first = 2 * j - kNumBins / 2;
+    counts[j] = counts_[first] + counts_[first + 1];
+  }
+  counts_ = std::move(counts);
+  ++log2_bin_width_;
+}
+
+void Histogram::GrowToInclude(double value) {
+  auto fits = [&]() {
+    const double index = std::floor(value / BinWidth()) + kNumBins / 2;
+    return index >= 0 && index < kNumBins;
+  };
+  while (!fits()) {
+    if (total_count_ == 0) {
+      // Nothing to rebin yet.
+      ++log2_bin_width_;
+    } else {
+      DoubleBinWidth();
+    }
+  }
+}
+
+void Histogram::Update(const float* values, size_t tensor_size) {
+  double tensor_min = std::numeric_limits<double>::infinity();
+  double tensor_max = -std::numeric_limits<double>::infinity();
+  for (size_t i = 0; i < tensor_size; ++i) {
+    if (!std::isfinite(values[i])) continue;
+    tensor_min = std::min<double>(tensor_min, values[i]);
+    tensor_max = std::max<double>(tensor_max, values[i]);
+  }
+  if (tensor_min > tensor_max) return;
+
+  if (counts_.empty()) counts_.assign(kNumBins, 0);
+  GrowToInclude(tensor_min);
+  GrowToInclude(tensor_max);
+  const double bin_width = BinWidth();
+  for (size_t i = 0; i < tensor_size; ++i) {
+    if (!std::isfinite(values[i])) continue;
+    const int index =
+        static_cast<int>(std::floor(values[i] / bin_width)) + kNumBins / 2;
+    ++counts_[std::clamp(index, 0, kNumBins - 1)];
+  }
+  if (total_count_ == 0) {
+    min_ = tensor_min;
+    max_ = tensor_max;
+  } else {
+    min_ = std::min(min_, tensor_min);
+    max_ = std::max(max_, tensor_max);
+  }
+  for (size_t i = 0; i < tensor_size; ++i) {
+    if (std::isfinite(values[i])) ++total_count_;
+  }
+}
+
+void Histogram::Merge(const Histogram& other) {
+  if (!other.HasValues()) return;
+  if (!HasValues()) {
+    *this = other;
+    return;
+  }
+  // Both are centered on zero, so the bins line up once they are as wide.
+  Histogram coarser_other = other;
+  while (log2_bin_width_ < coarser_other.log2_bin_width_) DoubleBinWidth();
+  while (coarser_other.log2_bin_width_ < log2_bin_width_) {
+    coarser_other.DoubleBinWidth();
+  }
+  for (int i = 0; i < kNumBins; ++i) counts_[i] += coarser_other.counts_[i];
+  total_count_ += other.total_count_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+TfLiteStatus Histogram::GetRange(const RangeSelection& selection,
+                                 float* min_val, float* max_val) const {
+  if (!HasValues()) return kTfLiteError;
+  double low = min_;
+  double high = max_;
+  switch (selection.method) {
+    case RangeSelection::Method::kMinMax:
+      break;
+    case RangeSelection::Method::kPercentile: {
+      // Counts left out at each end.
+      const double tail =
+          total_count_ * (100.0 - selection.percentile) / 200.0;
+      int64_t below = 0;
+      for (int i = 0; i < kNumBins; ++i) {
+        below += counts_[i];
+        if (below > tail) {
+          low = std::max(low, BinStart(i));
+          break;
+        }
+      }
+      int64_t above = 0;
+      for (int i = kNumBins - 1; i >= 0; --i) {
+        above += counts_[i];
+        if (above > tail) {
+          high = std::min(high, BinStart(i + 1));
+          break;
+        }
+      }
+      break;
+    }
+    case RangeSelection::Method::kMse: {
+      // Tries shrinking the observed range by steps of 1%, estimating the
+      // error of each value from the center of its bin.
+      const double num_levels = std::ldexp(1.0, selection.num_bits) - 1;
+      double best_error = std::numeric_limits<double>::infinity();
+      for (int step = 100; step > 0; --step) {
+        const double candidate_low = min_ * step / 100;
+        const double candidate_high = max_ * step / 100;
+        const double scale = (candidate_high - candidate_low) / num_levels;
+        double error = 0;
+        for (int i = 0; i < kNumBins; ++i) {
+          if (counts_[i] == 0) continue;
+          const double center =
+              std::clamp(BinStart(i) + BinWidth() / 2, min_, max_);
+          double value_error = scale * scale / 12;
+          if (center < candidate_low) {
+            value_error = (candidate_low - center) * (candidate_low - center);
+          } else if (center > candidate_high) {
+            value_error = (center - candidate_high) * (center - candidate_high);
+          }
+          error += counts_[i] * value_error;
+        }
+        if (error < best_error) {
+          best_error = error;
+          low = candidate_low;
+          high = candidate_high;
+        }
+      }
+      break;
+    }
+  }
+  *min_val = static_cast<float>(low);
+  *max_val = static_cast<float>(high);
+  return kTfLiteOk;
+}
+
+std::string Histogram::Serialize() const {
+  std::ostringstream stream;
+  stream.precision(std::numeric_limits<double>::max_digits10);
+  int num_nonzero = 0;
+  for (int64_t count : counts_) num_nonzero += count != 0;
+  stream << log2_bin_width_ << " " << total_count_ << " " << min_ << " "
+         << max_ << " " << num_nonzero;
+  for (int i = 0; i < static_cast<int>(counts_.size()); ++i) {
+    if (counts_[i] != 0) stream << " " << i << " " << counts_[i];
+  }
+  return stream.str();
+}
+
+TfLiteStatus Histogram::Deserialize(absl::string_view text) {
+  std::istringstream stream{std::string(text)};
+  int num_nonzero = 0;
+  if (!(stream >> log2_bin_width_ >> total_count_ >> min_ >> max_ >>
+        num_nonzero)) {
+    return kTfLiteError;
+  }
+  counts_.assign(kNumBins, 0);
+  for (int i = 0; i < num_nonzero; ++i) {
+    int index;
+    int64_t count;
+    if (!(stream >> index >> count) || index < 0 || index >= kNumBins) {
+      return kTfLiteError;
+    }
+    counts_[index] = count;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus Logger::GetRange(const std::tuple<int, int>& key,
+                              const RangeSelection& selection, float* min_val,
+                              float* max_val) const {
+  auto histogram = tensor_id_to_histogram_map_.find(key);
+  if (histogram != tensor_id_to_histogram_map_.end() &&
+      histogram->second.HasValues()) {
+    return histogram->second.GetRange(selection, min_val, max_val);
+  }
+  auto minmax = tensor_id_to_stats_map_.find(key);
+  if (minmax == tensor_id_to_stats_map_.end()) return kTfLiteError;
+  return minmax->second.Get(min_val, max_val);
+}
+
+void Logger::Merge(const Logger& other) {
+  for (const auto& [key, minmax] : other.tensor_id_to_stats_map_) {
+    tensor_id_to_stats_map_[key].Merge(minmax);
+  }
+  for (const auto& [key, histogram] : other.tensor_id_to_histogram_map_) {
+    tensor_id_to_histogram_map_[key].Merge(histogram);
+  }
+}
+
+// The text has one line per statistic:
+//   minmax <subgraph index> <tensor index> <min> <max>
+//   histogram <subgraph index> <tensor index> <Histogram::Serialize()>
+std::string Logger::Serialize() const {
+  std::ostringstream stream;
+  stream.precision(std::numeric_limits<float>::max_digits10);
+  for (const auto& [key, minmax] : tensor_id_to_stats_map_) {
+    float min, max;
+    if (minmax.Get(&min, &max) != kTfLiteOk) continue;
+    stream << "minmax " << std::get<0>(key) << " " << std::get<1>(key) << " "
+           << min << " " << max << "\n";
+  }
+  for (const auto& [key, histogram] : tensor_id_to_histogram_map_) {
+    if (!histogram.HasValues()) continue;
+    stream << "histogram " << std::get<0>(key) << " " << std::get<1>(key)
+           << " " << histogram.Serialize() << "\n";
+  }
+  return stream.str();
+}
+
+TfLiteStatus Logger::Deserialize(absl::string_view text) {
+  tensor_id_to_stats_map_.clear();
+  tensor_id_to_histogram_map_.clear();
+  std::istringstream stream{std::string(text)};
+  std::string line;
+  while (std::getline(stream, line)) {
+    if (line.empty()) continue;
+    std::istringstream line_stream(line);
+    std::string kind;
+    int subgraph_index, tensor_index;
+    if (!(line_stream >> kind >> subgraph_index >> tensor_index)) {
+      return kTfLiteError;
+    }
+    const std::tuple<int, int> key{subgraph_index, tensor_index};
+    if (kind == "minmax") {
+      float values[2];
+      if (!(line_stream >> values[0] >> values[1])) return kTfLiteError;
+      TF_LITE_ENSURE_STATUS(tensor_id_to_stats_map_[key].Update(
+          values, /*tensor_size=*/2, /*error_reporter=*/nullptr));
+    } else if (kind == "histogram") {
+      std::string rest;
+      std::getline(line_stream, rest);
+      TF_LITE_ENSURE_STATUS(tensor_id_to_histogram_map_[key].Deserialize(rest));
+    } else {
+      return kTfLiteError;
+    }
+  }
+  return kTfLiteOk;
+}
+
 }  // namespace calibration
 }  // namespace optimize
 }  // namespace tflite
@@ -15,9 +15,15 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_TOOLS_OPTIMIZE_CALIBRATION_CALIBRATION_LOGGER_H_
 #define TENSORFLOW_LITE_TOOLS_OPTIMIZE_CALIBRATION_CALIBRATION_LOGGER_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <string>
+#include <tuple>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
 #include "tflite/core/api/error_reporter.h"
 #include "tflite/core/c/common.h"
 
@@ -30,6 +36,9 @@ class MinMax {
   TfLiteStatus Update(const float* values, size_t tensor_size,
                       ErrorReporter* error_reporter);
 
+  // Widens the range to include the values seen by |other|.
+  void Merge(const MinMax& other);
+
   bool HasValues() const { return has_values_; }
 
   TfLiteStatus Get(float* min_val, float* max_val) const {
@@ -45,14 +54,81 @@ class MinMax {
   float max_ = std::numeric_limits<float>::min();
 };
 
+// How the range of a tensor is chosen from the statistics collected for it.
+struct RangeSelection {
+  enum class Method {
+    // The observed minimum and maximum.
+    kMinMax,
+    // The range holding |percentile| percent of the values, leaving out the
+    // same share of outliers at both ends.
+    kPercentile,
+    // The range minimizing the mean squared error of quantizing the observed
+    // values to |num_bits|.
+    kMse,
+  };
+  Method method = Method::kMinMax;
+  double percentile = 99.99;
+  int num_bits = 8;
+};
+
+// A histogram of tensor values centered on zero, with bins whose width is a
+// power of two. The range doubles, merging pairs of bins, whenever a value
+// falls outside of it. Histograms of the same tensor can therefore be merged
+// exactly, whatever values each of them has seen.
+class Histogram {
+ public:
+  static constexpr int kNumBins = 2048;
+
+  void Update(const float* values, size_t tensor_size);
+
+  // Adds the counts of |other|.
+  void Merge(const Histogram& other);
+
+  bool HasValues() const { return total_count_ > 0; }
+
+  // Returns the range chosen by |selection| in |min_val| and |max_val|. The
+  // range never exceeds the observed one.
+  TfLiteStatus GetRange(const RangeSelection& selection, float* min_val,
+                        float* max_val) const;
+
+  // Writes the histogram as text, and reads back what Serialize() wrote.
+  std::string Serialize() const;
+  TfLiteStatus Deserialize(absl::string_view text);
+
+ private:
+  double BinWidth() const;
+  // Returns the lower bound of bin |index|.
+  double BinStart(int index) const;
+  // Merges pairs of bins, doubling the range.
+  void DoubleBinWidth();
+  // Doubles the width of the bins until |value| falls into one of them.
+  void GrowToInclude(double value);
+
+  int log2_bin_width_ = kMinLog2BinWidth;
+  int64_t total_count_ = 0;
+  double min_ = 0;
+  double max_ = 0;
+  std::vector<int64_t> counts_;
+
+  static constexpr int kMinLog2BinWidth = -40;
+};
+
 // Captures min max values for tensors.
 class Logger {
  public:
+  // Histograms are only collected with |collect_histograms|, as they cost
+  // memory and time for each tensor.
+  explicit Logger(bool collect_histograms = false)
+      : collect_histograms_(collect_histograms) {}
+
   // Log the value for tensor at |tensor_index| which has |tensor_values|
   TfLiteStatus LogTensorValue(int subgraph_index, int tensor_index,
                               const float* tensor_values, size_t tensor_size,
                               ErrorReporter* error_reporter) {
     std::tuple<int, int> key{subgraph_index, tensor_index};
+    if (collect_histograms_) {
+      tensor_id_to_histogram_map_[key].Update(tensor_values, tensor_size);
+    }
     return tensor_id_to_stats_map_[key].Update(tensor_values, tensor_size,
                                                error_reporter);
   }
@@ -63,8 +139,33 @@ class Logger {
     return tensor_id_to_stats_map_;
   }
 
+  // Returns a map from tensor_index -> histogram of the observed values. Empty
+  // unless histograms are collected.
+  const absl::flat_hash_map<std::tuple<int, int>, Histogram>& GetHistograms()
+      const {
+    return tensor_id_to_histogram_map_;
+  }
+
+  // Returns the range of the tensor at |key| chosen by |selection|. Falls back
+  // to the observed min max if there is no histogram for the tensor.
+  TfLiteStatus GetRange(const std::tuple<int, int>& key,
+                        const RangeSelection& selection, float* min_val,
+                        float* max_val) const;
+
+  // Adds the statistics collected by |other|, e.g. by another interpreter
+  // running on a different shard of the calibration data.
+  void Merge(const Logger& other);
+
+  // Writes the statistics as text, e.g. to checkpoint a calibration, and reads
+  // back what Serialize() wrote, replacing the current statistics.
+  std::string Serialize() const;
+  TfLiteStatus Deserialize(absl::string_view text);
+
  private:
+  bool collect_histograms_;
   absl::flat_hash_map<std::tuple<int, int>, MinMax> tensor_id_to_stats_map_;
+  absl::flat_hash_map<std::tuple<int, int>, Histogram>
+      tensor_id_to_histogram_map_;
 };
 
 }  // namespace calibration
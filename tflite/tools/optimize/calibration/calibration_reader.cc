@@ -32,9 +32,9 @@ TfLiteStatus CalibrationReader::GetTensorStatsAsMap(
         tensor_id_to_stats_map) const {
   tensor_id_to_stats_map->clear();
   for (const auto& tensorid_stat : logger_->GetCalibrationValues()) {
-    auto minmax = tensorid_stat.second;
     CalibrationReader::CalibrationStats stats;
-    TF_LITE_ENSURE_STATUS(minmax.Get(&stats.min, &stats.max));
+    TF_LITE_ENSURE_STATUS(logger_->GetRange(
+        tensorid_stat.first, range_selection_, &stats.min, &stats.max));
     tensor_id_to_stats_map->insert({tensorid_stat.first, stats});
   }
 
@@ -50,9 +50,9 @@ TfLiteStatus CalibrationReader::AddCalibrationToModel(ModelT* model,
     int subgraph_index, tensor_index;
     std::tie(subgraph_index, tensor_index) = tensorid_stat.first;
     const auto& subgraph = model->subgraphs[subgraph_index];
-    auto minmax = tensorid_stat.second;
     float min, max;
-    TfLiteStatus status = minmax.Get(&min, &max);
+    TfLiteStatus status =
+        logger_->GetRange(tensorid_stat.first, range_selection_, &min, &max);
     if (status != kTfLiteOk) continue;
     if (update) {
       auto tensor = subgraph->tensors[tensor_index].get();
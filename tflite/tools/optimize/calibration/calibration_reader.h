@@ -39,6 +39,13 @@ class CalibrationReader {
   };
   explicit CalibrationReader(const Logger* logger) : logger_(logger) {}
 
+  // Sets how the ranges are chosen from the collected statistics. Methods
+  // other than kMinMax need the histograms collected by the logger, and fall
+  // back to the min max of the tensors without one.
+  void SetRangeSelection(const RangeSelection& range_selection) {
+    range_selection_ = range_selection;
+  }
+
   // Gets a map from tensor index to recorded calibration values.
   virtual TfLiteStatus GetTensorStatsAsMap(
       absl::flat_hash_map<std::tuple<int, int>, CalibrationStats>*
@@ -50,10 +57,14 @@ class CalibrationReader {
   // being overwritten.
   virtual TfLiteStatus AddCalibrationToModel(ModelT* model, bool update) const;
 
+  // Returns the logger holding the statistics collected so far.
+  const Logger& logger() const { return *logger_; }
+
   virtual ~CalibrationReader() {}
 
  private:
   const Logger* logger_;
+  RangeSelection range_selection_;
 };
 
 }  // namespace calibration
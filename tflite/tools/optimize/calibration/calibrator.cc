@@ -23,7 +23,9 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "flatbuffers/buffer.h"  // from @flatbuffers
 #include "flatbuffers/vector.h"  // from @flatbuffers
 #include "tflite/converter/allocation.h"
@@ -66,11 +68,11 @@ class Calibrator {
   Calibrator(const std::unordered_map<const TfLiteNode*, OperatorInfo>&
                  node_ptr_opinfo_map,
              std::unique_ptr<LoggingOpResolver> logging_op_resolver,
-             ErrorReporter* error_reporter)
+             ErrorReporter* error_reporter, bool collect_histograms)
       : node_ptr_opinfo_map_(node_ptr_opinfo_map),
         logging_op_resolver_(std::move(logging_op_resolver)),
         error_reporter_(error_reporter) {
-    logger_ = std::make_unique<Logger>();
+    logger_ = std::make_unique<Logger>(collect_histograms);
   }
 
   // Returns the wrapped kernel invoke function |TfLiteRegistration.invoke|.
@@ -139,20 +141,26 @@ KernelEvalFuncPtr Calibrator::GetKernelInvoke(const TfLiteNode* node) const {
 //
 // This way the kernel invoke functions can get the access to the Calibrator
 // object associated with the |TfLiteContext|.
+//
+// Interpreters may calibrate on different threads, so the registry is guarded
+// by a mutex.
 class GlobalCalibratorRegistry {
  public:
   // Get the |Calibrator| associated with given context, returns null if no
   // calibrator is associated with the given context.
   Calibrator* GetCalibrator(const TfLiteNode* node) const {
-    if (node_to_calibrator_.find(node) == node_to_calibrator_.cend()) {
+    absl::ReaderMutexLock lock(&mutex_);
+    auto it = node_to_calibrator_.find(node);
+    if (it == node_to_calibrator_.cend()) {
       return nullptr;
     }
-    return node_to_calibrator_.at(node);
+    return it->second;
   }
 
   // Removes the association between calibrator and context.
   // Note: This deletes the calibrator as well.
   void RemoveCalibrator(const TfLiteContext* context) {
+    absl::MutexLock lock(&mutex_);
     Calibrator* calibrator = calibrator_registry_.at(context).get();
     auto nodes = calibrator->GetNodesUnderCalibration();
     for (auto node : nodes) {
@@ -168,14 +176,18 @@ class GlobalCalibratorRegistry {
       const TfLiteContext* context,
       const std::unordered_map<const TfLiteNode*, OperatorInfo>& node_to_opinfo,
       std::unique_ptr<LoggingOpResolver> logging_op_resolver,
-      Calibrator** calibrator_ptr, ErrorReporter* reporter) {
+      Calibrator** calibrator_ptr, ErrorReporter* reporter,
+      bool collect_histograms) {
+    absl::MutexLock lock(&mutex_);
     if (calibrator_registry_.find(context) != calibrator_registry_.cend()) {
       reporter->Report(
           "Failed to create calibrator, context already registered.");
       return kTfLiteError;
     }
-    auto calibrator = std::make_unique<Calibrator>(
-        node_to_opinfo, std::move(logging_op_resolver), reporter);
+    auto calibrator =
+        std::make_unique<Calibrator>(node_to_opinfo,
+                                     std::move(logging_op_resolver), reporter,
+                                     collect_histograms);
     calibrator_registry_[context] = std::move(calibrator);
     *calibrator_ptr = calibrator_registry_.at(context).get();
     for (const auto& entry : node_to_opinfo) {
@@ -185,9 +197,11 @@ class GlobalCalibratorRegistry {
   }
 
  private:
+  mutable absl::Mutex mutex_;
   absl::flat_hash_map<const TfLiteContext*, std::unique_ptr<Calibrator>>
-      calibrator_registry_;
-  absl::flat_hash_map<const TfLiteNode*, Calibrator*> node_to_calibrator_;
+      calibrator_registry_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<const TfLiteNode*, Calibrator*> node_to_calibrator_
+      ABSL_GUARDED_BY(mutex_);
 };
 
 GlobalCalibratorRegistry* GetCalibratorRegistry() {
@@ -376,17 +390,18 @@ bool HasOutputs(BuiltinOperator code) {
 TfLiteStatus BuildLoggingInterpreter(
     const FlatBufferModel& model, const OpResolver& op_resolver,
     std::unique_ptr<Interpreter>* interpreter,
-    std::unique_ptr<CalibrationReader>* calibration_reader) {
+    std::unique_ptr<CalibrationReader>* calibration_reader,
+    bool collect_histograms) {
   return BuildLoggingInterpreter(model.GetModel(), model.error_reporter(),
                                  op_resolver, interpreter, calibration_reader,
-                                 model.allocation());
+                                 model.allocation(), collect_histograms);
 }
 
 TfLiteStatus BuildLoggingInterpreter(
     const tflite::Model* tflite_model, ErrorReporter* error_reporter,
     const OpResolver& op_resolver, std::unique_ptr<Interpreter>* interpreter,
     std::unique_ptr<CalibrationReader>* calibration_reader,
-    const Allocation* allocation) {
+    const Allocation* allocation, bool collect_histograms) {
   if (error_reporter == nullptr) {
     // Make sure error_reporter is valid.
     error_reporter = DefaultErrorReporter();
@@ -485,7 +500,7 @@ TfLiteStatus BuildLoggingInterpreter(
   // during invocations by the logging kernels.
   TF_LITE_ENSURE_STATUS(GetCalibratorRegistry()->CreateCalibrator(
       context, node_ptr_opinfo_map, std::move(logging_op_resolver), &calibrator,
-      error_reporter));
+      error_reporter, collect_histograms));
   *calibration_reader = std::unique_ptr<CalibrationReader>(
       new Reader(context, calibrator->GetLogger()));
 
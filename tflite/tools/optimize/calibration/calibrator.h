@@ -58,17 +58,20 @@ namespace calibration {
 // calibration_reader->AddCalibrationToModel(original_floating_point_model,
 // false);
 //
+// With |collect_histograms|, histograms of the tensor values are collected as
+// well, from which percentile or MSE based ranges can be chosen.
 TfLiteStatus BuildLoggingInterpreter(
     const FlatBufferModel& model, const OpResolver& op_resolver,
     std::unique_ptr<Interpreter>* interpreter,
-    std::unique_ptr<CalibrationReader>* calibration_reader);
+    std::unique_ptr<CalibrationReader>* calibration_reader,
+    bool collect_histograms = false);
 
 // Same as above, except gets separate tflite::Model and ErrorReporter pointers.
 TfLiteStatus BuildLoggingInterpreter(
     const tflite::Model* model, ErrorReporter* error_reporter,
     const OpResolver& op_resolver, std::unique_ptr<Interpreter>* interpreter,
     std::unique_ptr<CalibrationReader>* calibration_reader,
-    const Allocation* allocation = nullptr);
+    const Allocation* allocation = nullptr, bool collect_histograms = false);
 
 }  // namespace calibration
 }  // namespace optimize
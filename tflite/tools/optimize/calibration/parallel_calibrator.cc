@@ -0,0 +1,185 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/tools/optimize/calibration/parallel_calibrator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "tflite/core/api/op_resolver.h"
+#include "tflite/core/c/common.h"
+#include "tflite/interpreter.h"
+#include "tflite/minimal_logging.h"
+#include "tflite/model_builder.h"
+#include "tflite/tools/optimize/calibration/calibration_logger.h"
+#include "tflite/tools/optimize/calibration/calibration_reader.h"
+#include "tflite/tools/optimize/calibration/calibrator.h"
+
+namespace tflite {
+namespace optimize {
+namespace calibration {
+namespace {
+
+// A checkpoint is the index of the next sample to run, followed by the
+// statistics of the samples before it:
+//   next_sample <index>
+//   <Logger::Serialize()>
+constexpr char kNextSample[] = "next_sample";
+
+// Reads the checkpoint at |path| into |logger| and |next_sample|. Returns
+// false if there is no checkpoint.
+bool ReadCheckpoint(const std::string& path, Logger* logger, int* next_sample,
+                    TfLiteStatus* status) {
+  std::ifstream file(path);
+  if (!file) return false;
+  std::string tag;
+  if (!(file >> tag >> *next_sample) || tag != kNextSample) {
+    TFLITE_LOG(TFLITE_LOG_ERROR, "Invalid calibration checkpoint %s",
+               path.c_str());
+    *status = kTfLiteError;
+    return true;
+  }
+  std::stringstream statistics;
+  statistics << file.rdbuf();
+  *status = logger->Deserialize(statistics.str());
+  if (*status != kTfLiteOk) {
+    TFLITE_LOG(TFLITE_LOG_ERROR, "Invalid calibration checkpoint %s",
+               path.c_str());
+  }
+  return true;
+}
+
+// Writes the checkpoint to a temporary file first, so that an interrupted
+// write leaves the previous checkpoint in place.
+TfLiteStatus WriteCheckpoint(const std::string& path, const Logger& logger,
+                             int next_sample) {
+  const std::string temp_path = path + ".tmp";
+  {
+    std::ofstream file(temp_path, std::ios::trunc);
+    file << kNextSample << " " << next_sample << "\n" << logger.Serialize();
+    if (!file.flush()) {
+      TFLITE_LOG(TFLITE_LOG_ERROR, "Failed to write calibration checkpoint %s",
+                 temp_path.c_str());
+      return kTfLiteError;
+    }
+  }
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    TFLITE_LOG(TFLITE_LOG_ERROR, "Failed to write calibration checkpoint %s",
+               path.c_str());
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+struct LoggingInterpreter {
+  std::unique_ptr<Interpreter> interpreter;
+  std::unique_ptr<CalibrationReader> reader;
+};
+
+// Runs the samples in [begin, end), sample i on interpreter i % size.
+TfLiteStatus RunSamples(const CalibrationSampleFeeder& feeder, int begin,
+                        int end,
+                        std::vector<LoggingInterpreter>& interpreters) {
+  const int num_threads = interpreters.size();
+  std::vector<TfLiteStatus> statuses(num_threads, kTfLiteOk);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t] {
+      Interpreter* interpreter = interpreters[t].interpreter.get();
+      for (int i = begin + t; i < end; i += num_threads) {
+        statuses[t] = feeder(i, interpreter);
+        if (statuses[t] == kTfLiteOk) statuses[t] = interpreter->Invoke();
+        if (statuses[t] != kTfLiteOk) {
+          TFLITE_LOG(TFLITE_LOG_ERROR, "Calibration sample %d failed", i);
+          return;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  for (TfLiteStatus status : statuses) TF_LITE_ENSURE_STATUS(status);
+  return kTfLiteOk;
+}
+
+}  // namespace
+
+TfLiteStatus CalibrateInParallel(const FlatBufferModel& model,
+                                 const OpResolver& op_resolver,
+                                 int num_samples,
+                                 const CalibrationSampleFeeder& feeder,
+                                 const ParallelCalibrationOptions& options,
+                                 Logger* logger) {
+  if (options.num_threads < 1 || options.checkpoint_interval < 0) {
+    TFLITE_LOG(TFLITE_LOG_ERROR, "Invalid parallel calibration options");
+    return kTfLiteError;
+  }
+
+  int next_sample = 0;
+  if (!options.checkpoint_path.empty()) {
+    TfLiteStatus status = kTfLiteOk;
+    if (ReadCheckpoint(options.checkpoint_path, logger, &next_sample,
+                       &status)) {
+      TF_LITE_ENSURE_STATUS(status);
+      TFLITE_LOG(TFLITE_LOG_INFO, "Resuming calibration at sample %d",
+                 next_sample);
+    }
+  }
+  if (next_sample >= num_samples) return kTfLiteOk;
+
+  // Interpreters are built one at a time, and only run concurrently.
+  const int num_threads = std::min(options.num_threads, num_samples);
+  std::vector<LoggingInterpreter> interpreters(num_threads);
+  for (LoggingInterpreter& logging_interpreter : interpreters) {
+    TF_LITE_ENSURE_STATUS(BuildLoggingInterpreter(
+        model, op_resolver, &logging_interpreter.interpreter,
+        &logging_interpreter.reader, options.collect_histograms));
+    TF_LITE_ENSURE_STATUS(logging_interpreter.interpreter->AllocateTensors());
+  }
+
+  // Each interpreter logs the statistics of its shard, which are merged into
+  // those read from the checkpoint.
+  auto merged_statistics = [&]() {
+    Logger merged = *logger;
+    for (const LoggingInterpreter& logging_interpreter : interpreters) {
+      merged.Merge(logging_interpreter.reader->logger());
+    }
+    return merged;
+  };
+
+  const int interval = options.checkpoint_interval > 0
+                           ? options.checkpoint_interval
+                           : num_samples - next_sample;
+  while (next_sample < num_samples) {
+    const int end = std::min(num_samples, next_sample + interval);
+    TF_LITE_ENSURE_STATUS(RunSamples(feeder, next_sample, end, interpreters));
+    next_sample = end;
+    if (!options.checkpoint_path.empty()) {
+      TF_LITE_ENSURE_STATUS(WriteCheckpoint(options.checkpoint_path,
+                                            merged_statistics(), next_sample));
+    }
+  }
+  *logger = merged_statistics();
+  return kTfLiteOk;
+}
+
+}  // namespace calibration
+}  // namespace optimize
+}  // namespace tflite
@@ -0,0 +1,79 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_TOOLS_OPTIMIZE_CALIBRATION_PARALLEL_CALIBRATOR_H_
+#define TENSORFLOW_LITE_TOOLS_OPTIMIZE_CALIBRATION_PARALLEL_CALIBRATOR_H_
+
+#include <functional>
+#include <string>
+
+#include "tflite/core/api/op_resolver.h"
+#include "tflite/core/c/common.h"
+#include "tflite/interpreter.h"
+#include "tflite/model_builder.h"
+#include "tflite/tools/optimize/calibration/calibration_logger.h"
+
+namespace tflite {
+namespace optimize {
+namespace calibration {
+
+// Warning: This is not a public API and subject to change.
+
+struct ParallelCalibrationOptions {
+  // The number of logging interpreters, each running on its own thread.
+  int num_threads = 1;
+  // Whether to collect histograms, from which percentile or MSE ranges can be
+  // chosen, see RangeSelection.
+  bool collect_histograms = false;
+  // If set, the statistics are written to this file every
+  // |checkpoint_interval| samples, and a calibration that finds the file
+  // resumes after the last sample it holds.
+  std::string checkpoint_path;
+  // The number of samples between checkpoints. With 0, the statistics are
+  // only written once all the samples are done.
+  int checkpoint_interval = 0;
+};
+
+// Sets the inputs of |interpreter| to the calibration sample |sample_index|.
+// Called concurrently from different threads, each with its own interpreter.
+// May resize the inputs, in which case it must allocate the tensors again.
+using CalibrationSampleFeeder =
+    std::function<TfLiteStatus(int sample_index, Interpreter* interpreter)>;
+
+// Runs |num_samples| calibration samples through |options.num_threads|
+// logging interpreters, each on a strided shard of the samples, and merges the
+// statistics they collect into |logger|.
+//
+// Example usage:
+// Logger logger(/*collect_histograms=*/true);
+// ParallelCalibrationOptions options;
+// options.num_threads = 4;
+// options.collect_histograms = true;
+// CalibrateInParallel(*model, resolver, num_samples, feeder, options,
+//                     &logger);
+// CalibrationReader reader(&logger);
+// reader.SetRangeSelection({RangeSelection::Method::kPercentile});
+// reader.AddCalibrationToModel(original_floating_point_model, false);
+TfLiteStatus CalibrateInParallel(const FlatBufferModel& model,
+                                 const OpResolver& op_resolver,
+                                 int num_samples,
+                                 const CalibrationSampleFeeder& feeder,
+                                 const ParallelCalibrationOptions& options,
+                                 Logger* logger);
+
+}  // namespace calibration
+}  // namespace optimize
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_TOOLS_OPTIMIZE_CALIBRATION_PARALLEL_CALIBRATOR_H_
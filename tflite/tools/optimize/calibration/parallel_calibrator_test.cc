@@ -0,0 +1,189 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/tools/optimize/calibration/parallel_calibrator.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/platform/init_main.h"
+#include "tensorflow/core/platform/path.h"
+#include "tensorflow/core/util/command_line_flags.h"
+#include "tflite/c/c_api_types.h"
+#include "tflite/c/common.h"
+#include "tflite/core/kernels/register.h"
+#include "tflite/interpreter.h"
+#include "tflite/model_builder.h"
+#include "tflite/tools/optimize/calibration/calibration_logger.h"
+#include "tflite/tools/optimize/calibration/calibration_reader.h"
+
+namespace {
+std::string* g_test_model_dir = nullptr;
+}  // namespace
+
+namespace tflite {
+namespace optimize {
+namespace calibration {
+namespace {
+
+constexpr int kNumSamples = 10;
+
+std::unique_ptr<FlatBufferModel> ReadModel() {
+  auto model_path =
+      tensorflow::io::JoinPath(*g_test_model_dir, "multi_add.bin");
+  return FlatBufferModel::BuildFromFile(model_path.c_str());
+}
+
+// Fills input i of the multi_add model with (i + 1) * (sample_index + 1).
+TfLiteStatus FeedSample(int sample_index, Interpreter* interpreter) {
+  for (size_t i = 0; i < interpreter->inputs().size(); i++) {
+    TfLiteTensor* tensor = interpreter->tensor(interpreter->inputs()[i]);
+    for (size_t j = 0; j < tensor->bytes / sizeof(float); j++) {
+      tensor->data.f[j] = (i + 1) * (sample_index + 1);
+    }
+  }
+  return kTfLiteOk;
+}
+
+absl::flat_hash_map<std::tuple<int, int>, CalibrationReader::CalibrationStats>
+GetStats(const Logger& logger) {
+  absl::flat_hash_map<std::tuple<int, int>, CalibrationReader::CalibrationStats>
+      stats;
+  CalibrationReader reader(&logger);
+  EXPECT_EQ(kTfLiteOk, reader.GetTensorStatsAsMap(&stats));
+  return stats;
+}
+
+void ExpectAllSamplesLogged(const Logger& logger) {
+  // Model does the following:
+  // 0        1       2        3
+  // |        |__ ____|        |
+  // |           |             |
+  // |          Add(tensor:4)  |
+  // |____ ______|______ ______|
+  //      |             |
+  //      Add          Add
+  //      |             |
+  //    Output:5      Output:6
+  const float base_values[7] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 9.0f};
+  const float eps = 1e-6f;
+  auto stats = GetStats(logger);
+  ASSERT_EQ(7, stats.size());
+  for (int tensor_idx = 0; tensor_idx < 7; tensor_idx++) {
+    EXPECT_NEAR(stats.find({0, tensor_idx})->second.min,
+                base_values[tensor_idx], eps);
+    EXPECT_NEAR(stats.find({0, tensor_idx})->second.max,
+                base_values[tensor_idx] * kNumSamples, eps);
+  }
+}
+
+TEST(ParallelCalibratorTest, MergesTheStatisticsOfAllThreads) {
+  auto model = ReadModel();
+  ASSERT_TRUE(model);
+  ParallelCalibrationOptions options;
+  options.num_threads = 3;
+  Logger logger;
+  ASSERT_EQ(kTfLiteOk, CalibrateInParallel(
+                           *model, ops::builtin::BuiltinOpResolver{},
+                           kNumSamples, FeedSample, options, &logger));
+  ExpectAllSamplesLogged(logger);
+}
+
+TEST(ParallelCalibratorTest, FailsWhenASampleFails) {
+  auto model = ReadModel();
+  ASSERT_TRUE(model);
+  ParallelCalibrationOptions options;
+  options.num_threads = 2;
+  Logger logger;
+  EXPECT_EQ(kTfLiteError,
+            CalibrateInParallel(
+                *model, ops::builtin::BuiltinOpResolver{}, kNumSamples,
+                [](int sample_index, Interpreter* interpreter) {
+                  if (sample_index == 5) return kTfLiteError;
+                  return FeedSample(sample_index, interpreter);
+                },
+                options, &logger));
+}
+
+TEST(ParallelCalibratorTest, ResumesFromTheCheckpoint) {
+  auto model = ReadModel();
+  ASSERT_TRUE(model);
+  ParallelCalibrationOptions options;
+  options.num_threads = 2;
+  options.collect_histograms = true;
+  options.checkpoint_interval = 3;
+  options.checkpoint_path = testing::TempDir() + "/calibration_checkpoint";
+  std::remove(options.checkpoint_path.c_str());
+
+  // Stops after the first half of the samples, as if interrupted.
+  Logger first_half(/*collect_histograms=*/true);
+  ASSERT_EQ(kTfLiteOk, CalibrateInParallel(
+                           *model, ops::builtin::BuiltinOpResolver{},
+                           kNumSamples / 2, FeedSample, options, &first_half));
+
+  int num_fed = 0;
+  Logger resumed(/*collect_histograms=*/true);
+  ASSERT_EQ(kTfLiteOk,
+            CalibrateInParallel(
+                *model, ops::builtin::BuiltinOpResolver{}, kNumSamples,
+                [&num_fed](int sample_index, Interpreter* interpreter) {
+                  EXPECT_GE(sample_index, kNumSamples / 2);
+                  ++num_fed;
+                  return FeedSample(sample_index, interpreter);
+                },
+                options, &resumed));
+  EXPECT_EQ(num_fed, kNumSamples - kNumSamples / 2);
+  ExpectAllSamplesLogged(resumed);
+
+  // The histograms hold all the samples, and a percentile range trims the
+  // largest ones.
+  ASSERT_EQ(7, resumed.GetHistograms().size());
+  float min, max;
+  RangeSelection selection;
+  selection.method = RangeSelection::Method::kPercentile;
+  selection.percentile = 60;
+  ASSERT_EQ(kTfLiteOk, resumed.GetRange({0, 0}, selection, &min, &max));
+  EXPECT_GE(min, 1.0f);
+  EXPECT_LT(max, 10.0f);
+  std::remove(options.checkpoint_path.c_str());
+}
+
+}  // namespace
+}  // namespace calibration
+}  // namespace optimize
+}  // namespace tflite
+
+int main(int argc, char** argv) {
+  std::string model_file;
+  const std::vector<tensorflow::Flag> flag_list = {
+      tensorflow::Flag("test_model_file", &model_file,
+                       "Path to test tflite model file."),
+  };
+
+  const bool parse_result = tensorflow::Flags::Parse(&argc, argv, flag_list);
+  if (!parse_result) {
+    std::cerr << "Required test_model_file\n";
+    std::abort();
+  }
+  g_test_model_dir = new std::string(tensorflow::io::Dirname(model_file));
+  ::tensorflow::port::InitMain(argv[0], &argc, &argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,228 @@
+# Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+"""Latency-aware mixed-precision search for TF-Lite post-training quantization.
+
+Picks, for each layer of a model calibrated by a QuantizationDebugger, whether
+it runs quantized or in float, so that the model meets an accuracy budget at
+the lowest latency measured on device.
+"""
+import dataclasses
+import math
+from typing import Callable, Dict, IO, List, Mapping, Optional
+
+from tflite.python import convert
+from tflite.tools.optimize.debugging.python import debugger as _debugger
+
+FLOAT = 'float'
+INT8 = 'int8'
+
+
+def _node_output_name(profile_name: str) -> str:
+  """Returns the first output tensor of a node named `[out0, out1]:index`."""
+  name = profile_name.strip().rsplit(':', 1)[0]
+  if name.startswith('[') and name.endswith(']'):
+    name = name[1:-1]
+  return name.split(', ', 1)[0]
+
+
+class LatencyTable:
+  """Per-node latencies measured on device, in microseconds.
+
+  Nodes are keyed by the name of their first output tensor, which is also the
+  name that the quantizer and the QuantizationDebugger use for them.
+  """
+
+  def __init__(self,
+               latencies: Optional[Mapping[str, Mapping[str, float]]] = None):
+    """Initializes the table.
+
+    Args:
+      latencies: {node_name: {precision: microseconds}}, where precision is
+        `FLOAT` or `INT8`.
+    """
+    self._latencies: Dict[str, Dict[str, float]] = {
+        name: dict(by_precision)
+        for name, by_precision in (latencies or {}).items()
+    }
+
+  @classmethod
+  def from_benchmark_csv(cls, csv_files: Mapping[str,
+                                                 IO[str]]) -> 'LatencyTable':
+    """Reads the op profiles of `benchmark_model` runs.
+
+    Each file is the output of `benchmark_model --enable_op_profiling=true
+    --op_profiling_output_mode=csv` for the model converted with one precision.
+    Only the first table, with the nodes in run order, is read.
+
+    Args:
+      csv_files: {precision: file}, where precision is `FLOAT` or `INT8`.
+
+    Returns:
+      The latencies of the nodes found in the files.
+    """
+    table = cls()
+    for precision, file in csv_files.items():
+      header = None
+      for line in file:
+        if header is None:
+          fields = [field.strip() for field in line.split(',')]
+          if 'avg_ms' in fields and fields[-1] == 'name':
+            header = fields
+          continue
+        if not line.strip():
+          break
+        # The name is the last column and may contain commas.
+        values = [value.strip() for value in line.split(',', len(header) - 1)]
+        if len(values) != len(header):
+          break
+        row = dict(zip(header, values))
+        table.add(
+            _node_output_name(row['name']), precision,
+            float(row['avg_ms']) * 1000)
+    return table
+
+  def add(self, node_name: str, precision: str, microseconds: float) -> None:
+    """Adds a latency, summing those of nodes with the same output name."""
+    by_precision = self._latencies.setdefault(node_name, {})
+    by_precision[precision] = by_precision.get(precision, 0) + microseconds
+
+  def get(self, node_name: str, precision: str) -> Optional[float]:
+    return self._latencies.get(node_name, {}).get(precision)
+
+  def total(self, denylisted_nodes: List[str]) -> float:
+    """Returns the latency of the model with `denylisted_nodes` in float."""
+    denylisted = set(denylisted_nodes)
+    total = 0.0
+    for name, by_precision in self._latencies.items():
+      precision = FLOAT if name in denylisted else INT8
+      total += by_precision.get(precision, by_precision.get(FLOAT, 0.0))
+    return total
+
+
+@dataclasses.dataclass
+class MixedPrecisionResult:
+  """The outcome of a mixed-precision search.
+
+  Attributes:
+    model: the quantized model.
+    denylisted_nodes: the nodes kept in float.
+    accuracy_loss: what `evaluate` returned for `model`.
+    estimated_latency_us: the sum of the latencies of the chosen precisions.
+    meets_budget: whether `accuracy_loss` is within the budget. False only when
+      even the model with every candidate in float does not meet it.
+  """
+  model: bytes
+  denylisted_nodes: List[str]
+  accuracy_loss: float
+  estimated_latency_us: float
+  meets_budget: bool
+
+
+def _float_cost_us(table: LatencyTable, node_name: str) -> float:
+  """Returns the latency added by running a node in float instead of int8."""
+  float_us = table.get(node_name, FLOAT)
+  int8_us = table.get(node_name, INT8)
+  if float_us is None or int8_us is None:
+    # Unmeasured nodes are only kept in float after all the measured ones.
+    return math.inf
+  return max(float_us - int8_us, 0.0)
+
+
+def search_mixed_precision(
+    quant_debugger: _debugger.QuantizationDebugger,
+    latency_table: LatencyTable,
+    evaluate: Callable[[bytes], float],
+    accuracy_budget: float,
+    layer_metric: str = 'mean_squared_error') -> MixedPrecisionResult:
+  """Finds the fastest mix of int8 and float layers within an accuracy budget.
+
+  Layers are ranked by the error that quantization adds to them, as collected
+  by the debugger, divided by the latency that running them in float costs. The
+  search then keeps the shortest prefix of that ranking in float for which the
+  model meets the budget, finding it by bisection so that only a logarithmic
+  number of candidate models is quantized and evaluated.
+
+  The quantizer picks the precision of each node between int8 and float; a
+  second activation type, such as int16, applies to the whole model through
+  the converter instead.
+
+  Args:
+    quant_debugger: a QuantizationDebugger created with a converter, so that
+      the calibrated model can be requantized.
+    latency_table: the latencies of the nodes, in float and in int8.
+    evaluate: returns the accuracy loss of a quantized model, lower is better.
+      For example, the mean error of its outputs against a float model on a
+      validation set.
+    accuracy_budget: the largest accepted accuracy loss.
+    layer_metric: the layer debug metric that ranks the layers.
+
+  Returns:
+    The chosen model and precisions.
+
+  Raises:
+    ValueError: if the debugger has no converter.
+  """
+  if quant_debugger.converter is None:
+    raise ValueError('The debugger must be created with a converter.')
+  if quant_debugger.layer_statistics is None:
+    quant_debugger.run()
+
+  errors: Dict[str, float] = {}
+  for name, metrics in quant_debugger.layer_statistics.items():
+    node_name, _ = quant_debugger._get_operand_name_and_index(name)  # pylint: disable=protected-access
+    errors[node_name] = max(errors.get(node_name, 0.0), metrics[layer_metric])
+
+  def priority(node_name: str) -> float:
+    cost = _float_cost_us(latency_table, node_name)
+    if cost == 0:
+      return math.inf
+    return errors[node_name] / cost
+
+  candidates = sorted(errors, key=priority, reverse=True)
+  base_denylist = list(quant_debugger.options.denylisted_nodes or [])
+  evaluated: Dict[int, MixedPrecisionResult] = {}
+
+  def try_prefix(length: int) -> MixedPrecisionResult:
+    if length not in evaluated:
+      denylisted_nodes = base_denylist + candidates[:length]
+      model = convert.mlir_quantize(
+          quant_debugger.calibrated_model,
+          disable_per_channel=quant_debugger.converter._experimental_disable_per_channel,  # pylint: disable=protected-access
+          fully_quantize=quant_debugger.options.fully_quantize,
+          denylisted_ops=quant_debugger.options.denylisted_ops,
+          denylisted_nodes=denylisted_nodes)
+      loss = evaluate(model)
+      evaluated[length] = MixedPrecisionResult(
+          model=model,
+          denylisted_nodes=denylisted_nodes,
+          accuracy_loss=loss,
+          estimated_latency_us=latency_table.total(denylisted_nodes),
+          meets_budget=loss <= accuracy_budget)
+    return evaluated[length]
+
+  if try_prefix(0).meets_budget:
+    return try_prefix(0)
+  if not try_prefix(len(candidates)).meets_budget:
+    return try_prefix(len(candidates))
+
+  # The loss is assumed to shrink as more layers run in float.
+  low, high = 0, len(candidates)
+  while high - low > 1:
+    middle = (low + high) // 2
+    if try_prefix(middle).meets_budget:
+      high = middle
+    else:
+      low = middle
+  return try_prefix(high)
@@ -0,0 +1,133 @@
+# Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+"""Tests for the latency-aware mixed-precision search."""
+
+import functools
+import io
+from unittest import mock
+
+from tflite.python import convert
+from tflite.tools.optimize.debugging.python import debugger
+from tflite.tools.optimize.debugging.python import mixed_precision
+from tensorflow.python.platform import test
+
+_LAYER_ERRORS = {'a': 10.0, 'b': 1.0, 'c': 5.0}
+
+
+def _fake_debugger():
+  """Returns a debugger whose layers `a`, `b` and `c` have _LAYER_ERRORS."""
+  quant_debugger = mock.Mock()
+  quant_debugger.converter = mock.Mock(_experimental_disable_per_channel=False)
+  quant_debugger.calibrated_model = b'calibrated'
+  quant_debugger.options = debugger.QuantizationDebugOptions()
+  quant_debugger.layer_statistics = {
+      f'NumericVerify/{name}:{index}': {'mean_squared_error': error}
+      for index, (name, error) in enumerate(_LAYER_ERRORS.items())
+  }
+  quant_debugger._get_operand_name_and_index.side_effect = functools.partial(
+      debugger.QuantizationDebugger._get_operand_name_and_index,
+      quant_debugger)
+  return quant_debugger
+
+
+def _fake_mlir_quantize(calibrated_model, denylisted_nodes=None, **_):
+  del calibrated_model
+  return ','.join(denylisted_nodes).encode()
+
+
+def _accuracy_loss(model):
+  """Sums the errors of the layers that the fake model quantizes."""
+  denylisted_nodes = model.decode().split(',')
+  return sum(error for name, error in _LAYER_ERRORS.items()
+             if name not in denylisted_nodes)
+
+
+class LatencyTableTest(test.TestCase):
+
+  def test_from_benchmark_csv(self):
+    int8_csv = io.StringIO(
+        'Operator-wise Profiling Info for Regular Benchmark Runs:\n'
+        'node type, first, avg_ms, %, cdf%, mem KB, times called, name\n'
+        'CONV_2D, 0.1, 0.2, 40%, 40%, 0, 1, [a]:0\n'
+        'SPLIT, 0.1, 0.3, 60%, 100%, 0, 1, [b, c]:1\n'
+        '\n'
+        'node type, first, avg_ms, %, cdf%, mem KB, times called, name\n'
+        'SPLIT, 0.1, 0.3, 60%, 60%, 0, 1, [b, c]:1\n')
+    float_csv = io.StringIO(
+        'node type, first, avg_ms, %, cdf%, mem KB, times called, name\n'
+        'CONV_2D, 0.4, 0.5, 100%, 100%, 0, 1, [a]:0\n')
+
+    table = mixed_precision.LatencyTable.from_benchmark_csv({
+        mixed_precision.INT8: int8_csv,
+        mixed_precision.FLOAT: float_csv,
+    })
+
+    self.assertAlmostEqual(table.get('a', mixed_precision.INT8), 200)
+    self.assertAlmostEqual(table.get('b', mixed_precision.INT8), 300)
+    self.assertAlmostEqual(table.get('a', mixed_precision.FLOAT), 500)
+    self.assertIsNone(table.get('c', mixed_precision.INT8))
+    self.assertAlmostEqual(table.total(['a']), 800)
+
+
+class SearchMixedPrecisionTest(test.TestCase):
+
+  def setUp(self):
+    super().setUp()
+    # Running `a` in float is cheap for its error, `c` is expensive.
+    self.latency_table = mixed_precision.LatencyTable({
+        'a': {mixed_precision.FLOAT: 2.0, mixed_precision.INT8: 1.0},
+        'b': {mixed_precision.FLOAT: 2.0, mixed_precision.INT8: 1.0},
+        'c': {mixed_precision.FLOAT: 11.0, mixed_precision.INT8: 1.0},
+    })
+    self.enter_context(
+        mock.patch.object(
+            convert, 'mlir_quantize', side_effect=_fake_mlir_quantize))
+
+  def test_keeps_the_cheapest_layers_in_float(self):
+    result = mixed_precision.search_mixed_precision(
+        _fake_debugger(),
+        self.latency_table,
+        _accuracy_loss,
+        accuracy_budget=6.0)
+
+    self.assertTrue(result.meets_budget)
+    self.assertEqual(result.denylisted_nodes, ['a'])
+    self.assertAlmostEqual(result.accuracy_loss, 6.0)
+    self.assertAlmostEqual(result.estimated_latency_us, 4.0)
+
+  def test_quantizes_everything_within_budget(self):
+    result = mixed_precision.search_mixed_precision(
+        _fake_debugger(),
+        self.latency_table,
+        _accuracy_loss,
+        accuracy_budget=20.0)
+
+    self.assertTrue(result.meets_budget)
+    self.assertEmpty(result.denylisted_nodes)
+    self.assertAlmostEqual(result.estimated_latency_us, 3.0)
+
+  def test_reports_an_unreachable_budget(self):
+    result = mixed_precision.search_mixed_precision(
+        _fake_debugger(),
+        self.latency_table,
+        _accuracy_loss,
+        accuracy_budget=-1.0)
+
+    self.assertFalse(result.meets_budget)
+    self.assertCountEqual(result.denylisted_nodes, ['a', 'b', 'c'])
+
+
+if __name__ == '__main__':
+  test.main()
@@ -680,6 +680,99 @@ TfLiteStatus SymmetricQuantizeTensorPerChannel(ModelT* model, TensorT* tensor,
 }
 // LINT.ThenChange(//tflite/converter/quantization/lite/toco_legacy/quantization_utils.cc:SymmetricQuantizeTensorPerChannel)
 
+TfLiteStatus SymmetricQuantizeTensorBlockwiseInt4(
+    ModelT* model, SubGraphT* subgraph, int32_t tensor_index,
+    int32_t block_size, ErrorReporter* error_reporter) {
+  TensorT* tensor = subgraph->tensors[tensor_index].get();
+  if (tensor->type != TensorType_FLOAT32 || tensor->shape.size() != 2) {
+    TF_LITE_REPORT_ERROR(error_reporter,
+                         "Blockwise quantization requires a 2-D float tensor, "
+                         "but %s is not one.",
+                         tensor->name.c_str());
+    return kTfLiteError;
+  }
+  const int32_t num_rows = tensor->shape[0];
+  const int32_t num_cols = tensor->shape[1];
+  // Blocks of an even size keep each row of packed values byte aligned.
+  if (block_size <= 0 || block_size % 2 != 0 || num_cols % block_size != 0) {
+    TF_LITE_REPORT_ERROR(error_reporter,
+                         "Block size %d must be even and divide the %d "
+                         "columns of tensor %s.",
+                         block_size, num_cols, tensor->name.c_str());
+    return kTfLiteError;
+  }
+  uint64_t num_elements;
+  TF_LITE_ENSURE_STATUS(NumElements(*tensor, &num_elements));
+  BufferT* buffer = model->buffers[tensor->buffer].get();
+  if (buffer == nullptr ||
+      buffer->data.size() != num_elements * sizeof(float)) {
+    TF_LITE_REPORT_ERROR(error_reporter, "Missing buffer of tensor %s.",
+                         tensor->name.c_str());
+    return kTfLiteError;
+  }
+  // Copy single byte buffer data to float vector to guard against
+  // misalignment.
+  std::vector<float> float_data(num_elements);
+  std::copy(buffer->data.begin(), buffer->data.end(),
+            reinterpret_cast<uint8_t*>(float_data.data()));
+
+  // The scales are rounded to float16 before quantizing, so that the values
+  // are quantized with the scales that the kernels dequantize them with. The
+  // kernels and XNNPACK require normal, positive scales.
+  const int32_t num_blocks = num_cols / block_size;
+  const float kMinNormalFloat16 = 6.103515625e-05f;
+  const int32_t num_scales = num_rows * num_blocks;
+  std::vector<Eigen::half> half_scales(num_scales);
+  std::vector<float> scales_inv(num_scales);
+  for (int i = 0; i < num_scales; ++i) {
+    const float* block = float_data.data() + i * block_size;
+    float max_abs = 0;
+    for (int j = 0; j < block_size; ++j) {
+      max_abs = std::max(max_abs, std::abs(block[j]));
+    }
+    half_scales[i] = static_cast<Eigen::half>(
+        std::max(max_abs / kMaxQuantizedValue4bit, kMinNormalFloat16));
+    scales_inv[i] = 1.0f / static_cast<float>(half_scales[i]);
+  }
+  std::vector<int8_t> quantized_data(num_elements);
+  SymmetricPerBlockQuantizeValues(float_data.data(), scales_inv.data(),
+                                  tensor->shape, {num_rows, num_blocks},
+                                  /*channel_dim_index=*/1, &quantized_data,
+                                  kTfLiteInt4);
+  std::vector<int8_t> packed_data((num_elements + 1) / 2);
+  tensor_utils::PackInt8IntoDenseInt(quantized_data.data(), num_elements,
+                                     /*bit_width=*/4, packed_data.data());
+  const uint8_t* packed_bytes =
+      reinterpret_cast<const uint8_t*>(packed_data.data());
+  buffer->data.assign(packed_bytes, packed_bytes + packed_data.size());
+  tensor->type = TensorType_INT4;
+
+  auto scale_buffer = std::make_unique<BufferT>();
+  const uint8_t* scale_bytes =
+      reinterpret_cast<const uint8_t*>(half_scales.data());
+  scale_buffer->data.assign(scale_bytes,
+                            scale_bytes + num_scales * sizeof(Eigen::half));
+  model->buffers.push_back(std::move(scale_buffer));
+  std::unique_ptr<TensorT> scale_tensor;
+  MakeTensor(tensor->name + "_scales", {num_rows, num_blocks}, {},
+             TensorType_FLOAT16, &scale_tensor);
+  scale_tensor->buffer = model->buffers.size() - 1;
+  const int32_t scale_tensor_index = subgraph->tensors.size();
+  subgraph->tensors.push_back(std::move(scale_tensor));
+
+  // The tensors may have moved, so the weights are looked up again.
+  tensor = subgraph->tensors[tensor_index].get();
+  BlockwiseQuantizationT blockwise_quantization;
+  blockwise_quantization.scales = scale_tensor_index;
+  // The zero points are all 0, which is written as an optional tensor.
+  blockwise_quantization.zero_points = -1;
+  blockwise_quantization.block_size = block_size;
+  tensor->quantization = std::make_unique<QuantizationParametersT>();
+  tensor->quantization->details.Set(std::move(blockwise_quantization));
+  tensor->quantization->quantized_dimension = 0;
+  return kTfLiteOk;
+}
+
 template <class BiasType>
 std::vector<BiasType> SymmetricBiasQuantize(const float* data,
                                             uint64_t num_elements,
@@ -132,6 +132,15 @@ TfLiteStatus SymmetricQuantizeTensorPerChannel(ModelT* model, TensorT* tensor,
                                                ErrorReporter* error_reporter);
 // LINT.ThenChange(//tflite/converter/quantization/lite/toco_legacy/quantization_utils.h:symmetric_quantize_tensor_per_channel)
 
+// Quantizes the 2-D float weights at |tensor_index| of |subgraph| to int4, with
+// one float16 scale per block of |block_size| consecutive elements along the
+// last dimension. The int4 values are packed two per byte, and the scales are
+// added to |subgraph| as a new constant tensor referenced by the
+// BlockwiseQuantization details of the weights.
+TfLiteStatus SymmetricQuantizeTensorBlockwiseInt4(
+    ModelT* model, SubGraphT* subgraph, int32_t tensor_index,
+    int32_t block_size, ErrorReporter* error_reporter);
+
 // Symmetrically quantizes float to 16bits.
 TfLiteStatus SymmetricQuantizeFloatsToInt16(ModelT* model, TensorT* tensor,
                                             float scaling_factor,
@@ -750,6 +750,56 @@ TEST_F(QuantizationUtilsTest, AddQuantizationParams) {
   EXPECT_EQ(model->subgraphs[0]->tensors[0]->type, TensorType_INT8);
 }
 
+TEST_F(QuantizationUtilsTest, SymmetricQuantizeTensorBlockwiseInt4) {
+  // Create data.
+  auto model = std::make_unique<ModelT>();
+  auto subgraph = std::make_unique<tflite::SubGraphT>();
+  auto tensor = std::make_unique<TensorT>();
+  auto buffer = std::make_unique<tflite::BufferT>();
+  const std::vector<float> weights = {-0.7, 0.7, 0.1, 0.2};
+  const uint8_t* weights_bytes = reinterpret_cast<const uint8_t*>(&weights[0]);
+  buffer->data.assign(weights_bytes,
+                      weights_bytes + weights.size() * sizeof(float));
+  tensor->name = "weights";
+  tensor->shape = {1, 4};
+  tensor->type = TensorType_FLOAT32;
+  tensor->buffer = 0;
+
+  // Wire the model.
+  model->subgraphs.push_back(std::move(subgraph));
+  model->subgraphs[0]->tensors.push_back(std::move(tensor));
+  model->buffers.push_back(std::move(buffer));
+
+  // Call and verify.
+  SubGraphT* quantized_subgraph = model->subgraphs[0].get();
+  // Blocks must divide the rows.
+  EXPECT_EQ(SymmetricQuantizeTensorBlockwiseInt4(
+                model.get(), quantized_subgraph, /*tensor_index=*/0,
+                /*block_size=*/3, &error_reporter_),
+            kTfLiteError);
+  ASSERT_EQ(SymmetricQuantizeTensorBlockwiseInt4(
+                model.get(), quantized_subgraph, /*tensor_index=*/0,
+                /*block_size=*/2, &error_reporter_),
+            kTfLiteOk);
+  const TensorT* quantized_tensor = quantized_subgraph->tensors[0].get();
+  EXPECT_EQ(quantized_tensor->type, TensorType_INT4);
+  // The blocks {-7, 7} and {4, 7}, packed with the first value in the low
+  // nibble.
+  EXPECT_THAT(model->buffers[quantized_tensor->buffer]->data,
+              ElementsAreArray({0x79, 0x74}));
+  const BlockwiseQuantizationT* blockwise =
+      quantized_tensor->quantization->details.AsBlockwiseQuantization();
+  ASSERT_NE(blockwise, nullptr);
+  EXPECT_EQ(blockwise->block_size, 2);
+  const TensorT* scales = quantized_subgraph->tensors[blockwise->scales].get();
+  EXPECT_EQ(scales->type, TensorType_FLOAT16);
+  EXPECT_THAT(scales->shape, ElementsAreArray({1, 2}));
+  const Eigen::half* scale_data = reinterpret_cast<const Eigen::half*>(
+      model->buffers[scales->buffer]->data.data());
+  EXPECT_NEAR(static_cast<float>(scale_data[0]), 0.1f, 1e-4);
+  EXPECT_NEAR(static_cast<float>(scale_data[1]), 0.2f / 7, 1e-4);
+}
+
 TEST_F(QuantizationUtilsTest, SymmetricQuantizeFloatsToInt16Test) {
   // Create data.
   auto model = std::make_unique<ModelT>();
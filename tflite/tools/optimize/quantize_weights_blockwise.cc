@@ -0,0 +1,118 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/tools/optimize/quantize_weights_blockwise.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "flatbuffers/flatbuffer_builder.h"  // from @flatbuffers
+#include "tflite/core/api/error_reporter.h"
+#include "tflite/core/c/c_api_types.h"
+#include "tflite/schema/schema_generated.h"
+#include "tflite/schema/schema_utils.h"
+#include "tflite/tools/optimize/model_utils.h"
+#include "tflite/tools/optimize/quantization_utils.h"
+
+namespace tflite {
+namespace optimize {
+namespace {
+
+constexpr int kWeightsIndex = 1;
+
+// Returns true if the weights at |tensor_index| can be quantized: constant
+// 2-D float tensors, not quantized yet, and only read as the weights of
+// FULLY_CONNECTED ops with float inputs.
+bool IsQuantizableWeights(const ModelT* model, const SubGraphT* subgraph,
+                          int32_t tensor_index, int32_t block_size,
+                          uint64_t weights_min_num_elements,
+                          const std::vector<int>& num_buffer_users) {
+  const TensorT* tensor = subgraph->tensors[tensor_index].get();
+  if (tensor->type != TensorType_FLOAT32 || tensor->shape.size() != 2 ||
+      tensor->sparsity != nullptr ||
+      utils::QuantizationParametersExist(tensor) ||
+      !utils::HasBuffer(model, subgraph, tensor_index) ||
+      num_buffer_users[tensor->buffer] != 1) {
+    return false;
+  }
+  uint64_t num_elements;
+  if (utils::NumElements(*tensor, &num_elements) != kTfLiteOk ||
+      num_elements < weights_min_num_elements ||
+      tensor->shape[1] % block_size != 0) {
+    return false;
+  }
+  for (const auto& op : subgraph->operators) {
+    for (int i = 0; i < op->inputs.size(); ++i) {
+      if (op->inputs[i] != tensor_index) continue;
+      const BuiltinOperator op_code =
+          GetBuiltinCode(model->operator_codes[op->opcode_index].get());
+      if (op_code != BuiltinOperator_FULLY_CONNECTED || i != kWeightsIndex ||
+          subgraph->tensors[op->inputs[0]]->type != TensorType_FLOAT32) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+TfLiteStatus QuantizeWeightsBlockwiseInt4(
+    flatbuffers::FlatBufferBuilder* builder, ModelT* model, int32_t block_size,
+    uint64_t weights_min_num_elements, ErrorReporter* error_reporter) {
+  if (block_size <= 0 || block_size % 32 != 0) {
+    TF_LITE_REPORT_ERROR(error_reporter,
+                         "Block size %d must be a positive multiple of 32.",
+                         block_size);
+    return kTfLiteError;
+  }
+
+  // Weights whose buffer is shared with other tensors are kept in float.
+  std::vector<int> num_buffer_users(model->buffers.size());
+  for (const auto& subgraph : model->subgraphs) {
+    for (const auto& tensor : subgraph->tensors) {
+      if (tensor->buffer < num_buffer_users.size()) {
+        ++num_buffer_users[tensor->buffer];
+      }
+    }
+  }
+
+  for (const auto& subgraph : model->subgraphs) {
+    for (const auto& op : subgraph->operators) {
+      const BuiltinOperator op_code =
+          GetBuiltinCode(model->operator_codes[op->opcode_index].get());
+      if (op_code != BuiltinOperator_FULLY_CONNECTED ||
+          op->inputs.size() <= kWeightsIndex || op->inputs[0] < 0 ||
+          op->inputs[kWeightsIndex] < 0) {
+        continue;
+      }
+      const int32_t weights_index = op->inputs[kWeightsIndex];
+      if (!IsQuantizableWeights(model, subgraph.get(), weights_index,
+                                block_size, weights_min_num_elements,
+                                num_buffer_users)) {
+        continue;
+      }
+      TF_LITE_ENSURE_STATUS(utils::SymmetricQuantizeTensorBlockwiseInt4(
+          model, subgraph.get(), weights_index, block_size, error_reporter));
+    }
+  }
+
+  flatbuffers::Offset<Model> output_model_location =
+      Model::Pack(*builder, model);
+  FinishModelBuffer(*builder, output_model_location);
+  return kTfLiteOk;
+}
+
+}  // namespace optimize
+}  // namespace tflite
@@ -0,0 +1,49 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_TOOLS_OPTIMIZE_QUANTIZE_WEIGHTS_BLOCKWISE_H_
+#define TENSORFLOW_LITE_TOOLS_OPTIMIZE_QUANTIZE_WEIGHTS_BLOCKWISE_H_
+
+#include <cstdint>
+
+#include "flatbuffers/flatbuffer_builder.h"  // from @flatbuffers
+#include "tflite/core/api/error_reporter.h"
+#include "tflite/core/c/c_api_types.h"
+#include "tflite/schema/schema_generated.h"
+
+namespace tflite {
+namespace optimize {
+
+// Quantizes the float weights of the FULLY_CONNECTED ops in |model| to int4,
+// with a float16 scale per block of |block_size| input channels, and
+// populates |builder| with the new model. The activations stay in float, and
+// the kernels quantize them on the fly.
+//
+// Only weights with at least |weights_min_num_elements| elements whose input
+// channels are a multiple of |block_size| are quantized, which must itself be
+// a multiple of 32 for the XNNPACK delegate to run them. Weights that other ops
+// also read are kept in float.
+//
+// Compared with per-channel int8 weights, this halves the size of the weights
+// at the cost of a scale every |block_size| values.
+//
+// Note: This is a private API, subject to change.
+TfLiteStatus QuantizeWeightsBlockwiseInt4(
+    flatbuffers::FlatBufferBuilder* builder, ModelT* model, int32_t block_size,
+    uint64_t weights_min_num_elements, ErrorReporter* error_reporter);
+
+}  // namespace optimize
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_TOOLS_OPTIMIZE_QUANTIZE_WEIGHTS_BLOCKWISE_H_
@@ -0,0 +1,194 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/tools/optimize/quantize_weights_blockwise.h"
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "flatbuffers/flatbuffer_builder.h"  // from @flatbuffers
+#include "tflite/core/interpreter.h"
+#include "tflite/core/interpreter_builder.h"
+#include "tflite/core/kernels/register.h"
+#include "tflite/core/model.h"
+#include "tflite/schema/schema_generated.h"
+#include "tflite/testing/util.h"
+
+namespace tflite {
+namespace optimize {
+namespace {
+
+constexpr int kNumUnits = 4;
+constexpr int kInputChannels = 64;
+
+// Creates a model with a FULLY_CONNECTED op on float input and weights:
+// weights[r][c] = 0.125 * (r + 1) * (c % 15 - 7), so that each block of 32
+// channels of a row spans [-7, 7] times a scale exactly representable in
+// float16.
+std::unique_ptr<ModelT> CreateFullyConnectedModel(int input_channels) {
+  auto model = std::make_unique<ModelT>();
+  model->version = 3;
+  model->buffers.push_back(std::make_unique<BufferT>());
+
+  auto fc_op_code = std::make_unique<OperatorCodeT>();
+  fc_op_code->builtin_code = BuiltinOperator_FULLY_CONNECTED;
+  fc_op_code->deprecated_builtin_code =
+      static_cast<int8_t>(BuiltinOperator_FULLY_CONNECTED);
+  fc_op_code->version = 1;
+  model->operator_codes.push_back(std::move(fc_op_code));
+
+  auto subgraph = std::make_unique<SubGraphT>();
+  auto input = std::make_unique<TensorT>();
+  input->name = "input";
+  input->shape = {1, input_channels};
+  input->type = TensorType_FLOAT32;
+
+  std::vector<float> weights_data(kNumUnits * input_channels);
+  for (int r = 0; r < kNumUnits; ++r) {
+    for (int c = 0; c < input_channels; ++c) {
+      weights_data[r * input_channels + c] = 0.125f * (r + 1) * (c % 15 - 7);
+    }
+  }
+  auto weights_buffer = std::make_unique<BufferT>();
+  const uint8_t* weights_bytes =
+      reinterpret_cast<const uint8_t*>(weights_data.data());
+  weights_buffer->data.assign(
+      weights_bytes, weights_bytes + weights_data.size() * sizeof(float));
+  model->buffers.push_back(std::move(weights_buffer));
+  auto weights = std::make_unique<TensorT>();
+  weights->name = "weights";
+  weights->shape = {kNumUnits, input_channels};
+  weights->type = TensorType_FLOAT32;
+  weights->buffer = 1;
+
+  auto output = std::make_unique<TensorT>();
+  output->name = "output";
+  output->shape = {1, kNumUnits};
+  output->type = TensorType_FLOAT32;
+
+  subgraph->tensors.push_back(std::move(input));
+  subgraph->tensors.push_back(std::move(weights));
+  subgraph->tensors.push_back(std::move(output));
+  subgraph->inputs = {0};
+  subgraph->outputs = {2};
+
+  auto fc_op = std::make_unique<OperatorT>();
+  fc_op->opcode_index = 0;
+  fc_op->inputs = {0, 1, -1};
+  fc_op->outputs = {2};
+  fc_op->builtin_options.Set(FullyConnectedOptionsT());
+  subgraph->operators.push_back(std::move(fc_op));
+  model->subgraphs.push_back(std::move(subgraph));
+  return model;
+}
+
+std::vector<float> Run(const flatbuffers::FlatBufferBuilder& builder) {
+  auto model = FlatBufferModel::BuildFromBuffer(
+      reinterpret_cast<const char*>(builder.GetBufferPointer()),
+      builder.GetSize());
+  EXPECT_TRUE(model);
+  std::unique_ptr<Interpreter> interpreter;
+  EXPECT_EQ(InterpreterBuilder(*model, ops::builtin::BuiltinOpResolver{})(
+                &interpreter),
+            kTfLiteOk);
+  EXPECT_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+  float* input = interpreter->typed_input_tensor<float>(0);
+  for (int c = 0; c < kInputChannels; ++c) {
+    input[c] = (c % 5 - 2) * 0.5f;
+  }
+  EXPECT_EQ(interpreter->Invoke(), kTfLiteOk);
+  const float* output = interpreter->typed_output_tensor<float>(0);
+  return std::vector<float>(output, output + kNumUnits);
+}
+
+class QuantizeWeightsBlockwiseTest : public testing::Test {
+ protected:
+  tflite::TestErrorReporter error_reporter_;
+};
+
+TEST_F(QuantizeWeightsBlockwiseTest, QuantizesFullyConnectedWeights) {
+  auto model = CreateFullyConnectedModel(kInputChannels);
+  flatbuffers::FlatBufferBuilder float_builder;
+  FinishModelBuffer(float_builder, Model::Pack(float_builder, model.get()));
+  const std::vector<float> float_output = Run(float_builder);
+
+  flatbuffers::FlatBufferBuilder builder;
+  ASSERT_EQ(QuantizeWeightsBlockwiseInt4(&builder, model.get(),
+                                         /*block_size=*/32,
+                                         /*weights_min_num_elements=*/0,
+                                         &error_reporter_),
+            kTfLiteOk);
+
+  const SubGraphT* subgraph = model->subgraphs[0].get();
+  const TensorT* weights = subgraph->tensors[1].get();
+  EXPECT_EQ(weights->type, TensorType_INT4);
+  EXPECT_EQ(model->buffers[weights->buffer]->data.size(),
+            kNumUnits * kInputChannels / 2);
+  ASSERT_TRUE(weights->quantization);
+  const BlockwiseQuantizationT* blockwise =
+      weights->quantization->details.AsBlockwiseQuantization();
+  ASSERT_TRUE(blockwise);
+  EXPECT_EQ(blockwise->block_size, 32);
+  EXPECT_EQ(blockwise->zero_points, -1);
+  const TensorT* scales = subgraph->tensors[blockwise->scales].get();
+  EXPECT_EQ(scales->type, TensorType_FLOAT16);
+  EXPECT_EQ(scales->shape, (std::vector<int32_t>{kNumUnits, 2}));
+
+  // The weights are exact, only the inputs quantized on the fly add errors.
+  const std::vector<float> output = Run(builder);
+  for (int i = 0; i < kNumUnits; ++i) {
+    EXPECT_NEAR(output[i], float_output[i], 0.02f * std::abs(float_output[i]));
+  }
+}
+
+TEST_F(QuantizeWeightsBlockwiseTest, KeepsWeightsNotSplitIntoBlocks) {
+  auto model = CreateFullyConnectedModel(/*input_channels=*/48);
+  flatbuffers::FlatBufferBuilder builder;
+  ASSERT_EQ(QuantizeWeightsBlockwiseInt4(&builder, model.get(),
+                                         /*block_size=*/32,
+                                         /*weights_min_num_elements=*/0,
+                                         &error_reporter_),
+            kTfLiteOk);
+  EXPECT_EQ(model->subgraphs[0]->tensors[1]->type, TensorType_FLOAT32);
+  EXPECT_EQ(model->subgraphs[0]->tensors.size(), 3);
+}
+
+TEST_F(QuantizeWeightsBlockwiseTest, KeepsSmallWeights) {
+  auto model = CreateFullyConnectedModel(kInputChannels);
+  flatbuffers::FlatBufferBuilder builder;
+  ASSERT_EQ(QuantizeWeightsBlockwiseInt4(&builder, model.get(),
+                                         /*block_size=*/64,
+                                         /*weights_min_num_elements=*/1024,
+                                         &error_reporter_),
+            kTfLiteOk);
+  EXPECT_EQ(model->subgraphs[0]->tensors[1]->type, TensorType_FLOAT32);
+}
+
+TEST_F(QuantizeWeightsBlockwiseTest, RejectsInvalidBlockSize) {
+  auto model = CreateFullyConnectedModel(kInputChannels);
+  flatbuffers::FlatBufferBuilder builder;
+  EXPECT_EQ(QuantizeWeightsBlockwiseInt4(&builder, model.get(),
+                                         /*block_size=*/16,
+                                         /*weights_min_num_elements=*/0,
+                                         &error_reporter_),
+            kTfLiteError);
+}
+
+}  // namespace
+}  // namespace optimize
+}  // namespace tflite